@@ -35,7 +35,7 @@ import re
 import sys
 import textwrap
 from abc import ABCMeta, abstractmethod
-from typing import Dict, Iterable, List, Mapping, Tuple, Union
+from typing import Dict, Iterable, List, Mapping, Optional, Tuple, Union
 
 from . import (ast, bson, common, cpp_types, enum_types, generic_field_list_types, struct_types,
                writer)
@@ -731,8 +731,7 @@ class _CppHeaderFileWriter(_CppFileWriterBase):
         self._writer.write_line(
             common.template_args('// Map: fieldName -> ${should_forward_name}',
                                  should_forward_name=field_list_info.get_should_forward_name()))
-        self._writer.write_line(
-            "static const stdx::unordered_map<std::string, bool> _genericFields;")
+        self._writer.write_line("static const StringMap<bool> _genericFields;")
         self.write_empty_line()
 
     def gen_known_fields_declaration(self):
@@ -1000,6 +999,9 @@ class _CppHeaderFileWriter(_CppFileWriterBase):
             'mongo/stdx/unordered_map.h',
         ] + spec.globals.cpp_includes
 
+        if spec.generic_argument_lists or spec.generic_reply_field_lists:
+            header_list.append('mongo/util/string_map.h')
+
         if spec.configs:
             header_list.append('mongo/util/options_parser/option_description.h')
             config_init = spec.globals.configs and spec.globals.configs.initializer
@@ -1160,6 +1162,9 @@ class _CppSourceFileWriter(_CppFileWriterBase):
         # type: (writer.IndentedTextWriter, str) -> None
         """Create a C++ .cpp file code writer."""
         self._target_arch = target_arch
+        # The object whose fields are being deserialized, when owned BSONObj fields may share its
+        # buffer instead of copying it.
+        self._bson_owner = None  # type: Optional[str]
         super(_CppSourceFileWriter, self).__init__(indented_writer)
 
     def _gen_field_deserializer_expression(self, element_name, field, ast_type):
@@ -1202,6 +1207,10 @@ class _CppSourceFileWriter(_CppFileWriterBase):
                                             (_get_field_constant_name(field)))
                     return common.template_args("${method_name}(tempContext, ${expression})",
                                                 method_name=method_name, expression=expression)
+                if self._bson_owner and method_name == 'BSONObj::getOwned':
+                    return common.template_args(
+                        "mongo::idl::getOwnedSubObject(${expression}, ${owner})",
+                        expression=expression, owner=self._bson_owner)
                 return common.template_args("${method_name}(${expression})",
                                             method_name=method_name, expression=expression)
 
@@ -1213,6 +1222,9 @@ class _CppSourceFileWriter(_CppFileWriterBase):
         # Class Class::method(const BSONElement& value)
         method_name = writer.get_method_name_from_qualified_method_name(ast_type.deserializer)
 
+        if self._bson_owner and method_name == 'parseOwnedBSON':
+            return '%s(%s, %s)' % (method_name, element_name, self._bson_owner)
+
         return '%s(%s)' % (method_name, element_name)
 
     def _gen_array_deserializer(self, field, bson_element, ast_type):
@@ -1556,13 +1568,13 @@ class _CppSourceFileWriter(_CppFileWriterBase):
         defn = field_list_info.get_has_field_method().get_definition()
         with self._block('%s {' % (defn, ), '}'):
             self._writer.write_line(
-                'return _genericFields.find(fieldName.toString()) != _genericFields.end();')
+                'return _genericFields.find(fieldName) != _genericFields.end();')
 
         self._writer.write_empty_line()
 
         defn = field_list_info.get_should_forward_method().get_definition()
         with self._block('%s {' % (defn, ), '}'):
-            self._writer.write_line('auto it = _genericFields.find(fieldName.toString());')
+            self._writer.write_line('auto it = _genericFields.find(fieldName);')
             self._writer.write_line('return (it == _genericFields.end() || it->second);')
 
         self._writer.write_empty_line()
@@ -1801,8 +1813,11 @@ class _CppSourceFileWriter(_CppFileWriterBase):
         func_def = struct_type_info.get_op_msg_request_deserializer_method().get_definition()
         with self._block('%s {' % (func_def), '}'):
 
-            # Deserialize all the fields
+            # Deserialize all the fields. The owned BSONObj fields of a request share the buffer of
+            # its body, which keeps the buffer alive, rather than copying out of it.
+            self._bson_owner = "request.body"
             field_usage_check = self._gen_fields_deserializer_common(struct, "request.body")
+            self._bson_owner = None
 
             # Iterate through the document sequences if we have any
             has_doc_sequence = len(
@@ -2248,8 +2263,8 @@ class _CppSourceFileWriter(_CppFileWriterBase):
         self._writer.write_line(
             common.template_args('// Map: fieldName -> ${should_forward_name}',
                                  should_forward_name=field_list_info.get_should_forward_name()))
-        block_name = common.template_args(
-            'const stdx::unordered_map<std::string, bool> ${klass}::_genericFields {', klass=klass)
+        block_name = common.template_args('const StringMap<bool> ${klass}::_genericFields {',
+                                          klass=klass)
         with self._block(block_name, "};"):
             sorted_entries = sorted(field_list.fields, key=lambda f: f.name)
             for entry in sorted_entries:
@@ -340,4 +340,41 @@ expectedResults = [
     {_id: 1, value: {len: 3, types: ['object', 'object', 'object'], values: [null, null, null]}},
 ];
 assert(resultsEq(res.cursor.firstBatch, expectedResults), res.cursor);
+
+// Test that several $accumulators in one $group each call their own functions, over many groups.
+assert(db.accumulator_js.drop());
+assert.commandWorked(
+    db.accumulator_js.insert(Array.from({length: 100}, (_, i) => ({key: i % 10, val: i}))));
+function sumAccumulator(accumulate) {
+    return {
+        $accumulator: {
+            init: function() {
+                return 0;
+            },
+            accumulateArgs: ["$val"],
+            accumulate: accumulate,
+            merge: function(s1, s2) {
+                return s1 + s2;
+            },
+            lang: 'js',
+        }
+    };
+}
+command.pipeline = [{
+    $group: {
+        _id: "$key",
+        once: sumAccumulator(function(state, val) {
+            return state + val;
+        }),
+        twice: sumAccumulator(function(state, val) {
+            return state + 2 * val;
+        }),
+    }
+}];
+res = assert.commandWorked(db.runCommand(command));
+expectedResults = Array.from({length: 10}, (_, key) => {
+    const total = 10 * key + 10 * 45;
+    return {_id: key, once: total, twice: 2 * total};
+});
+assert(resultsEq(res.cursor.firstBatch, expectedResults), res.cursor);
 })();
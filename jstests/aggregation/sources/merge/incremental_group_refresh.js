@@ -0,0 +1,79 @@
+// Tests that a $group result stored with $merge can be refreshed incrementally, by grouping only
+// the documents inserted since the previous refresh and folding the partial results into the
+// stored documents with a whenMatched=[<pipeline>] update. This is how an on-demand materialized
+// view over mergeable accumulators ($sum, $min, $max) is expected to be maintained.
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For assertArrayEq.
+
+const source = db[`${jsTest.name()}_source`];
+source.drop();
+const target = db[`${jsTest.name()}_target`];
+target.drop();
+
+const groupStage = {
+    $group: {
+        _id: "$key",
+        total: {$sum: "$amount"},
+        count: {$sum: 1},
+        min: {$min: "$amount"},
+        max: {$max: "$amount"},
+        lastTs: {$max: "$ts"}
+    }
+};
+
+// Fold the partial group for a key into the stored group. Each accumulator must be combined
+// using its own merge semantics.
+const foldPartialGroup = [{
+    $set: {
+        total: {$add: ["$total", "$$new.total"]},
+        count: {$add: ["$count", "$$new.count"]},
+        min: {$min: ["$min", "$$new.min"]},
+        max: {$max: ["$max", "$$new.max"]},
+        lastTs: {$max: ["$lastTs", "$$new.lastTs"]}
+    }
+}];
+
+// Process every source document whose 'ts' is above the high-water mark of the stored groups.
+function refresh() {
+    const highWaterMark = target.aggregate([{$group: {_id: null, ts: {$max: "$lastTs"}}}])
+                              .toArray()
+                              .map(doc => doc.ts);
+    const since = highWaterMark.length ? highWaterMark[0] : -1;
+    source.aggregate([
+        {$match: {ts: {$gt: since}}},
+        groupStage,
+        {$merge: {into: target.getName(), whenMatched: foldPartialGroup, whenNotMatched: "insert"}}
+    ]);
+}
+
+function assertMatchesFullRecomputation() {
+    assertArrayEq(
+        {actual: target.find().toArray(), expected: source.aggregate([groupStage]).toArray()});
+}
+
+let ts = 0;
+function insertBatch(numDocs) {
+    const docs = [];
+    for (let i = 0; i < numDocs; i++, ts++) {
+        docs.push({_id: ts, ts: ts, key: ts % 7, amount: (ts * 37) % 101});
+    }
+    assert.commandWorked(source.insert(docs));
+}
+
+insertBatch(100);
+refresh();
+assertMatchesFullRecomputation();
+
+// New documents both update existing groups and create new ones.
+insertBatch(50);
+assert.commandWorked(source.insert({_id: ts, ts: ts, key: "new", amount: -1}));
+++ts;
+refresh();
+assertMatchesFullRecomputation();
+
+// A refresh with no new documents leaves the stored groups unchanged.
+refresh();
+assertMatchesFullRecomputation();
+}());
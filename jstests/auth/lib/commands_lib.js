@@ -4958,6 +4958,31 @@ var authCommandsLib = {
               },
           ]
         },
+        {
+          testname: "analyze",
+          command: {analyze: "x", key: "a"},
+          skipSharded: true,
+          setup: function(db) {
+              assert.writeOK(db.x.save({a: 1}));
+          },
+          teardown: function(db) {
+              db.x.drop();
+          },
+          testcases: [
+              {
+                runOnDb: firstDbName,
+                roles: roles_dbAdmin,
+                privileges:
+                    [{resource: {db: firstDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+              {
+                runOnDb: secondDbName,
+                roles: roles_dbAdminAny,
+                privileges:
+                    [{resource: {db: secondDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+          ]
+        },
         {
           testname: "ping",
           command: {ping: 1},
@@ -5695,6 +5720,33 @@ var authCommandsLib = {
               {runOnDb: secondDbName, roles: {}}
           ]
         },
+        {
+          testname: "trainCompressionDictionary",
+          command: {trainCompressionDictionary: "foo", name: "auth_test"},
+          skipSharded: true,
+          setup: function(db) {
+              assert.writeOK(db.foo.save({}));
+          },
+          teardown: function(db) {
+              assert.commandWorked(db.dropDatabase());
+          },
+          testcases: [
+              {
+                runOnDb: firstDbName,
+                roles: roles_dbAdmin,
+                privileges:
+                    [{resource: {db: firstDbName, collection: "foo"}, actions: ["compact"]}],
+                expectFail: true
+              },
+              {
+                runOnDb: secondDbName,
+                roles: roles_dbAdminAny,
+                privileges:
+                    [{resource: {db: secondDbName, collection: "foo"}, actions: ["compact"]}],
+                expectFail: true
+              }
+          ]
+        },
         {
           testname: "updateRole_authenticationRestrictions",
           command: {updateRole: "testRole", authenticationRestrictions: []},
@@ -6189,6 +6241,56 @@ var authCommandsLib = {
               },
             ]
         },
+        {
+          testname: "aggregate_query_shape_metrics",
+          command: {
+              aggregate: 1,
+              pipeline: [{$queryShapeMetrics: {}}],
+              cursor: {}
+          },
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: roles_monitoring,
+                privileges: [
+                    {resource: {cluster: true}, actions: ["top"]},
+                ],
+              },
+              {
+                runOnDb: firstDbName,
+                roles: roles_monitoring,
+                privileges: [
+                    {resource: {cluster: true}, actions: ["top"]},
+                ],
+                expectFail: true,
+              },
+            ]
+        },
+        {
+          testname: "aggregate_query_stats",
+          command: {
+              aggregate: 1,
+              pipeline: [{$queryStats: {}}],
+              cursor: {}
+          },
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: roles_monitoring,
+                privileges: [
+                    {resource: {cluster: true}, actions: ["top"]},
+                ],
+              },
+              {
+                runOnDb: firstDbName,
+                roles: roles_monitoring,
+                privileges: [
+                    {resource: {cluster: true}, actions: ["top"]},
+                ],
+                expectFail: true,
+              },
+            ]
+        },
         {
           testname: "validate_db_metadata_command_specific_db",
           command: {
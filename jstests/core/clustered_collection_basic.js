@@ -0,0 +1,68 @@
+/**
+ * Tests that collections other than time-series buckets collections can be clustered by _id, that
+ * they keep no separate _id index, and that queries on _id are answered with bounded collection
+ * scans.
+ *
+ * @tags: [
+ *     assumes_against_mongod_not_mongos,
+ *     assumes_no_implicit_collection_creation_after_drop,
+ *     does_not_support_stepdowns,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const testDB = db.getSiblingDB(jsTestName());
+
+if (!assert.commandWorked(testDB.adminCommand({getParameter: 1, featureFlagClusteredIndexes: 1}))
+         .featureFlagClusteredIndexes.value) {
+    jsTestLog("Skipping test because the clustered indexes feature flag is disabled");
+    return;
+}
+
+assert.commandWorked(testDB.dropDatabase());
+const coll = testDB.clustered_collection_basic;
+
+assert.commandFailedWithCode(
+    testDB.createCollection(coll.getName(), {clusteredIndex: true, capped: true, size: 4096}),
+    ErrorCodes.InvalidOptions);
+assert.commandWorked(testDB.createCollection(coll.getName(), {clusteredIndex: true}));
+
+// Documents are keyed by _id, so no _id index exists and a duplicate _id is rejected by the
+// record store itself.
+assert.eq(0, coll.getIndexes().length);
+assert.commandWorked(coll.insert([{_id: 3, a: 3}, {_id: 1, a: 1}, {_id: 2, a: 2}, {_id: "x"}]));
+assert.commandFailedWithCode(coll.insert({_id: 2}), ErrorCodes.DuplicateKey);
+
+// Documents are returned in _id order by a collection scan.
+assert.eq([1, 2, 3, "x"], coll.find().toArray().map(doc => doc._id));
+
+// A point query on _id is answered by a collection scan bounded to a single record.
+let explain = coll.find({_id: 2}).explain("executionStats");
+let collScan = getPlanStage(getWinningPlan(explain.queryPlanner), "COLLSCAN");
+assert.neq(null, collScan, explain);
+assert.eq(collScan.minRecord, 2, explain);
+assert.eq(collScan.maxRecord, 2, explain);
+assert.eq(1, explain.executionStats.nReturned, explain);
+
+// Range queries on _id scan only the matching part of the collection.
+explain = coll.find({_id: {$gte: 2, $lt: 3}}).explain("executionStats");
+collScan = getPlanStage(getWinningPlan(explain.queryPlanner), "COLLSCAN");
+assert.eq(collScan.minRecord, 2, explain);
+assert.eq(collScan.maxRecord, 3, explain);
+assert.eq(1, explain.executionStats.nReturned, explain);
+assert.eq([2], coll.find({_id: {$gte: 2, $lt: 3}}).toArray().map(doc => doc._id));
+
+// String bounds are not derived when the query has a non-simple collation.
+explain = coll.find({_id: "X"}).collation({locale: "en", strength: 2}).explain("executionStats");
+collScan = getPlanStage(getWinningPlan(explain.queryPlanner), "COLLSCAN");
+assert(!collScan.hasOwnProperty("minRecord"), explain);
+assert.eq(1, explain.executionStats.nReturned, explain);
+
+// Secondary indexes point at the clustered RecordIds.
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.eq([{_id: 2, a: 2}], coll.find({a: 2}).hint({a: 1}).toArray());
+assert.commandFailedWithCode(coll.createIndex({_id: 1}), ErrorCodes.CannotCreateIndex);
+})();
@@ -112,4 +112,35 @@ assert.eq(0, t.find({_id: 1}).hint({_id: 1}).min({_id: 2}).itcount());
 
 explain = t.find({_id: 2}).hint({_id: 1}).min({_id: 1}).max({_id: 3}).explain();
 assertNonIdHackPlan(db, getWinningPlan(explain.queryPlanner), isSBEEnabled);
+
+//
+// ID hack for an $in on _id.
+//
+
+t.drop();
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(t.insert({_id: i, a: i}));
+}
+
+const inQuery = {
+    _id: {$in: [7, 3, 3, 42, 1]}
+};
+explain = t.find(inQuery).explain("executionStats");
+assert.eq(3, explain.executionStats.nReturned, explain);
+assertIdHackPlan(db, getWinningPlan(explain.queryPlanner), "FETCH", isSBEEnabled);
+assert.sameMembers([{_id: 1, a: 1}, {_id: 3, a: 3}, {_id: 7, a: 7}], t.find(inQuery).toArray());
+assert.sameMembers([{a: 1}, {a: 3}, {a: 7}], t.find(inQuery, {_id: 0, a: 1}).toArray());
+assert.sameMembers([{_id: 1}, {_id: 3}, {_id: 7}], t.find(inQuery).returnKey().toArray());
+
+// ID hack cannot be used for an $in with sort() or limit(), since it returns the documents in no
+// particular order.
+explain = t.find(inQuery).sort({a: 1}).explain();
+assertNonIdHackPlan(db, getWinningPlan(explain.queryPlanner), isSBEEnabled);
+assert.eq([3, 7], t.find(inQuery).sort({a: -1}).limit(2).toArray().map(doc => doc.a).reverse());
+explain = t.find(inQuery).limit(2).explain();
+assertNonIdHackPlan(db, getWinningPlan(explain.queryPlanner), isSBEEnabled);
+
+// ID hack cannot be used for an $in containing a value which is not an exact match.
+explain = t.find({_id: {$in: [1, /abc/]}}).explain();
+assertNonIdHackPlan(db, getWinningPlan(explain.queryPlanner), isSBEEnabled);
 })();
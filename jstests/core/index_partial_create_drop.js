@@ -101,4 +101,21 @@ numIndexesBefore = coll.getIndexes().length;
 assert.commandFailedWithCode(coll.dropIndex({x: 1}), ErrorCodes.AmbiguousIndexKeyPattern);
 assert.commandWorked(coll.dropIndex("partialIndex2"));
 assert.eq(coll.getIndexes().length, numIndexesBefore - 1);
+
+// Indexes built together whose filters are equivalent, and ones whose filters are not, each get
+// exactly the keys for the documents matching their own filter.
+assert.commandWorked(coll.dropIndexes());
+assert.commandWorked(db.runCommand({
+    createIndexes: coll.getName(),
+    indexes: [
+        {key: {x: 1}, name: "sharedFilter1", partialFilterExpression: {a: {$lt: 5}}},
+        {key: {a: 1}, name: "sharedFilter2", partialFilterExpression: {a: {$lt: 5}}},
+        {key: {x: 1, a: 1}, name: "otherFilter", partialFilterExpression: {a: {$gte: 7}}},
+        {key: {a: 1, x: 1}, name: "noFilter"},
+    ]
+}));
+assert.eq(5, getNumKeys("sharedFilter1"));
+assert.eq(5, getNumKeys("sharedFilter2"));
+assert.eq(3, getNumKeys("otherFilter"));
+assert.eq(10, getNumKeys("noFilter"));
 })();
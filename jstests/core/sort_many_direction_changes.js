@@ -0,0 +1,44 @@
+/**
+ * Tests that a blocking sort whose pattern changes direction more often than a KeyString can
+ * invert, with and without a limit, returns the documents in the right order.
+ */
+(function() {
+"use strict";
+
+const coll = db.sort_many_direction_changes;
+coll.drop();
+
+const numFields = 40;
+const sortPattern = {};
+for (let i = 0; i < numFields; i++) {
+    sortPattern["f" + i] = i % 2 === 0 ? 1 : -1;
+}
+
+// All documents tie on every field but the last two, which sort in opposite directions.
+let docs = [];
+for (let i = 0; i < 16; i++) {
+    let doc = {_id: i};
+    for (let f = 0; f < numFields - 2; f++) {
+        doc["f" + f] = 0;
+    }
+    doc["f" + (numFields - 2)] = i % 4;
+    doc["f" + (numFields - 1)] = Math.floor(i / 4);
+    docs.push(doc);
+}
+assert.commandWorked(coll.insert(docs));
+
+const expected = docs
+                     .slice()
+                     .sort((l, r) => {
+                         const ascending = l["f" + (numFields - 2)] - r["f" + (numFields - 2)];
+                         return ascending !== 0
+                             ? ascending
+                             : r["f" + (numFields - 1)] - l["f" + (numFields - 1)];
+                     })
+                     .map(doc => doc._id);
+
+assert.eq(coll.find().sort(sortPattern).toArray().map(doc => doc._id), expected);
+assert.eq(coll.find().sort(sortPattern).limit(5).toArray().map(doc => doc._id),
+          expected.slice(0, 5));
+assert.eq(coll.aggregate([{$sort: sortPattern}]).toArray().map(doc => doc._id), expected);
+}());
@@ -61,11 +61,17 @@ assert.commandFailedWithCode(
                             {clusteredIndex: true, idIndex: {key: {_id: 1}, name: '_id_'}}),
     ErrorCodes.InvalidOptions);
 
-// Using the 'clusteredIndex' option on any namespace other than a buckets namespace should fail.
-assert.commandFailedWithCode(testDB.createCollection(tsCollName, {clusteredIndex: true}),
-                             ErrorCodes.InvalidOptions);
-assert.commandFailedWithCode(testDB.createCollection('test', {clusteredIndex: true}),
-                             ErrorCodes.InvalidOptions);
+// Unless collections clustered by _id are generally enabled, using the 'clusteredIndex' option on
+// any namespace other than a buckets namespace should fail.
+const clusteredIndexesEnabled =
+    assert.commandWorked(testDB.adminCommand({getParameter: 1, featureFlagClusteredIndexes: 1}))
+        .featureFlagClusteredIndexes.value;
+if (!clusteredIndexesEnabled) {
+    assert.commandFailedWithCode(testDB.createCollection(tsCollName, {clusteredIndex: true}),
+                                 ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(testDB.createCollection('test', {clusteredIndex: true}),
+                                 ErrorCodes.InvalidOptions);
+}
 
 // Using the 'expireAfterSeconds' option on any namespace other than a time-series namespace or a
 // clustered time-series buckets namespace should fail.
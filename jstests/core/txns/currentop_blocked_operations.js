@@ -76,6 +76,11 @@ waitForBlockedOp({ns: testColl.getFullName(), op: "update"}, function(op) {
     return op.prepareReadConflicts > 0;
 });
 
+// While it is blocked, the time spent waiting on the current prepare conflict is reported too.
+waitForBlockedOp({ns: testColl.getFullName(), op: "update"}, function(op) {
+    return op.prepareConflictWaitMicros > 0;
+});
+
 assert.commandWorked(session.abortTransaction_forTesting());
 awaitUpdate();
 assert.eq(1, testColl.find({_id: 2222, x: 999}).itcount());
@@ -0,0 +1,69 @@
+/**
+ * Tests that the 'analyze' command stores histograms of the analyzed fields, and that with
+ * 'internalQueryPlannerUseCostModel' set, the planner uses them to leave candidate plans which are
+ * clearly more expensive than the cheapest one out of multi-planning.
+ */
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db[jsTestName()];
+
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({a: i, b: i % 2});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+assert.commandFailedWithCode(db.runCommand({analyze: "missing", key: "a"}),
+                             ErrorCodes.NamespaceNotFound);
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName(), key: ""}), 6108113);
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName(), key: "a", numberBuckets: 0}),
+                             6108114);
+
+let res = assert.commandWorked(db.runCommand({analyze: coll.getName(), key: "a"}));
+assert.eq(res.numberSampled, 1000, res);
+res = assert.commandWorked(
+    db.runCommand({analyze: coll.getName(), key: "b", numberBuckets: 10, sampleSize: 500}));
+assert.eq(res.numberSampled, 500, res);
+
+// Both fields are stored in the document of the collection.
+const uuid = db.getCollectionInfos({name: coll.getName()})[0].info.uuid;
+const stats = db.system.statistics.findOne({_id: uuid});
+assert.neq(stats, null);
+assert.eq(stats.fields.map(field => field.path).sort(), ["a", "b"], stats);
+const bHistogram = stats.fields.find(field => field.path === "b").histogram;
+assert.eq(bHistogram.totalCount, 1000, bHistogram);
+
+const filter = {
+    a: {$gte: 5, $lte: 6},
+    b: 0
+};
+const expected = coll.find(filter, {_id: 0}).sort({a: 1}).toArray();
+assert.eq(expected, [{a: 6, b: 0}]);
+
+// Without the cost model both indexes race.
+let explain = coll.find(filter).explain();
+assert.eq(explain.queryPlanner.rejectedPlans.length, 1, explain);
+
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryPlannerUseCostModel: true}));
+
+// The scan of 'b' reads half of the collection, so only the scan of 'a' is left to run.
+explain = coll.find(filter).explain();
+assert.eq(explain.queryPlanner.rejectedPlans.length, 0, explain);
+const ixscan = getPlanStage(getWinningPlan(explain.queryPlanner), "IXSCAN");
+assert.neq(ixscan, null, explain);
+assert.eq(ixscan.keyPattern, {a: 1}, explain);
+assert.eq(coll.find(filter, {_id: 0}).sort({a: 1}).toArray(), expected);
+
+// Candidates of similar cost still race.
+explain = coll.find({a: {$gte: 0}, b: 0}).explain();
+assert.eq(explain.queryPlanner.rejectedPlans.length, 1, explain);
+
+MongoRunner.stopMongod(conn);
+}());
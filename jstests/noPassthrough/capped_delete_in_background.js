@@ -0,0 +1,53 @@
+/**
+ * Tests that, with 'cappedDeleteInBackground' set, inserts into a capped collection leave deleting
+ * its oldest documents to the capped deleter thread, which brings the collection back within its
+ * limits and replicates the deletes.
+ *
+ * @tags: [
+ *   requires_capped,
+ *   requires_replication,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet({setParameter: {cappedDeleteInBackground: true}});
+rst.initiate();
+
+const primary = rst.getPrimary();
+const testDB = primary.getDB("test");
+const coll = testDB.capped_delete_in_background;
+
+const maxDocs = 100;
+assert.commandWorked(
+    testDB.createCollection(coll.getName(), {capped: true, size: 1024 * 1024, max: maxDocs}));
+
+const deletedDocuments = () =>
+    assert.commandWorked(testDB.serverStatus()).metrics.cappedDeleter.deletedDocuments;
+const initialDeleted = deletedDocuments();
+
+for (let i = 0; i < 5 * maxDocs; i++) {
+    assert.commandWorked(coll.insert({_id: i}));
+}
+
+assert.soon(() => coll.find().itcount() === maxDocs, () => tojson(coll.stats()));
+assert.gt(deletedDocuments(), initialDeleted, tojson(testDB.serverStatus().metrics));
+
+// The newest documents are the ones kept.
+assert.eq(coll.find().sort({$natural: 1}).limit(1).next()._id, 4 * maxDocs);
+
+rst.awaitReplication();
+const secondaryColl = rst.getSecondary().getDB("test")[coll.getName()];
+assert.eq(secondaryColl.find().itcount(), maxDocs);
+
+// With no overflow allowance, inserts delete inline again.
+assert.commandWorked(
+    primary.adminCommand({setParameter: 1, cappedDeleteInBackgroundOverflowPercent: 0}));
+for (let i = 5 * maxDocs; i < 6 * maxDocs; i++) {
+    assert.commandWorked(coll.insert({_id: i}));
+    assert.lte(coll.find().itcount(), maxDocs);
+}
+
+rst.stopSet();
+}());
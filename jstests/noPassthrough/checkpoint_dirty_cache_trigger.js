@@ -0,0 +1,41 @@
+/**
+ * Tests that the checkpoint thread takes a checkpoint once the cache holds more dirty data than
+ * 'checkpointDirtyCacheTriggerMB', without waiting for 'syncdelay' seconds to pass, and that the
+ * checkpoints are reported in serverStatus.
+ *
+ * @tags: [
+ *   requires_persistence,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+// A syncdelay of an hour keeps the checkpoint thread from taking checkpoints on an interval.
+const conn = MongoRunner.runMongod({syncdelay: 3600});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("test");
+const coll = testDB.checkpoint_dirty_cache_trigger;
+
+const stats = () => assert.commandWorked(testDB.serverStatus()).checkpointer;
+const initialStats = stats();
+assert.eq(initialStats.triggeredByDirtyCache, 0, tojson(initialStats));
+
+assert.commandWorked(testDB.adminCommand({setParameter: 1, checkpointDirtyCacheTriggerMB: 1}));
+
+const bigString = "x".repeat(1024);
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 4 * 1024; i++) {
+    bulk.insert({_id: i, s: bigString});
+}
+assert.commandWorked(bulk.execute());
+
+assert.soon(() => stats().triggeredByDirtyCache > 0, () => tojson(stats()));
+const finalStats = stats();
+assert.gt(finalStats.checkpoints, initialStats.checkpoints, tojson(finalStats));
+assert.gte(finalStats.lastDirtyBytes, 1024 * 1024, tojson(finalStats));
+assert.gte(finalStats.totalDurationMillis, finalStats.lastDurationMillis, tojson(finalStats));
+
+MongoRunner.stopMongod(conn);
+}());
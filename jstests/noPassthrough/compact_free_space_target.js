@@ -0,0 +1,38 @@
+/**
+ * Checks that the compact command skips the collection and index files with less space available
+ * for reuse than 'freeSpaceTargetMB'.
+ *
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({});
+const db = conn.getDB("test");
+const coll = db.getCollection(jsTest.name());
+
+assert.commandWorked(coll.createIndex({x: 1}));
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.insert({x: i}));
+}
+
+for (const freeSpaceTargetMB of [-1, "1", NumberLong("9223372036854775807")]) {
+    assert.commandFailedWithCode(db.runCommand({compact: jsTest.name(), freeSpaceTargetMB}),
+                                 ErrorCodes.InvalidOptions);
+}
+
+// None of the files of a tiny collection have a gigabyte available for reuse, so compaction skips
+// all of them and never reaches the failpoints.
+const failPoints = ["WTCompactRecordStoreEBUSY", "WTCompactIndexEBUSY"];
+for (const failPoint of failPoints) {
+    assert.commandWorked(db.adminCommand({configureFailPoint: failPoint, mode: "alwaysOn"}));
+    assert.commandWorked(db.runCommand({compact: jsTest.name(), freeSpaceTargetMB: 1024}));
+    assert.commandFailedWithCode(db.runCommand({compact: jsTest.name(), freeSpaceTargetMB: 0}),
+                                 ErrorCodes.Interrupted);
+    assert.commandWorked(db.adminCommand({configureFailPoint: failPoint, mode: "off"}));
+}
+
+assert.commandWorked(db.runCommand({compact: jsTest.name()}));
+
+MongoRunner.stopMongod(conn);
+}());
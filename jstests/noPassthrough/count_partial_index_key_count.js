@@ -0,0 +1,77 @@
+/**
+ * Tests that a count whose query is equivalent to the filter of a partial index is answered from
+ * the number of keys WiredTiger maintains for the index when
+ * 'internalQueryCountUsingPartialIndexKeyCounts' is set, and that the number stays correct as
+ * documents enter and leave the index.
+ *
+ * @tags: [
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage().
+
+const conn = MongoRunner.runMongod({});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("test");
+const coll = testDB.count_partial_index_key_count;
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 100; i++) {
+    bulk.insert({_id: i, status: i % 4 === 0 ? "open" : "closed"});
+}
+assert.commandWorked(bulk.execute());
+
+// The index is built over existing documents, so its key count starts from the bulk load.
+assert.commandWorked(
+    coll.createIndex({status: 1}, {name: "open", partialFilterExpression: {status: "open"}}));
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, internalQueryCountUsingPartialIndexKeyCounts: true}));
+
+const query = {status: "open"};
+
+function getFastCountStage(explain) {
+    return getPlanStage(explain.queryPlanner.winningPlan, "INDEX_FAST_COUNT");
+}
+
+function assertFastCount(expected, options = {}) {
+    const explain = coll.explain("executionStats").count(query, options);
+    const stage = getFastCountStage(explain);
+    assert.neq(null, stage, tojson(explain));
+    assert.eq(stage.indexName, "open", tojson(explain));
+    assert.eq(explain.executionStats.totalKeysExamined, 0, tojson(explain));
+    assert.eq(coll.count(query, options), expected);
+}
+
+assertFastCount(25);
+assertFastCount(20, {skip: 5});
+assertFastCount(10, {limit: 10});
+
+assert.commandWorked(coll.insert({_id: 100, status: "open"}));
+assert.commandWorked(coll.update({_id: 1}, {$set: {status: "open"}}));
+assertFastCount(27);
+
+assert.commandWorked(coll.remove({_id: 0}));
+assert.commandWorked(coll.update({_id: 4}, {$set: {status: "closed"}}));
+assertFastCount(25);
+
+// A query which is not equivalent to the filter scans the index as before.
+let explain = coll.explain().count({status: "closed"});
+assert.eq(null, getFastCountStage(explain), tojson(explain));
+
+// Once the index is multikey, a document may have more than one key, so the index is scanned.
+assert.commandWorked(coll.insert({_id: 103, status: ["open", "new"]}));
+explain = coll.explain().count(query);
+assert.eq(null, getFastCountStage(explain), tojson(explain));
+assert.eq(coll.count(query), 26);
+
+// Validate finds the key count correct.
+const res = assert.commandWorked(coll.validate({full: true}));
+assert(res.valid, tojson(res));
+assert.eq(res.warnings, [], tojson(res));
+
+MongoRunner.stopMongod(conn);
+}());
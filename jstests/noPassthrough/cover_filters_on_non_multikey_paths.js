@@ -0,0 +1,63 @@
+/**
+ * Tests that with 'internalQueryPlannerCoverFiltersOnNonMultikeyPaths' set, an inexact predicate
+ * on a field of a multikey index is evaluated against the index keys without a FETCH when the
+ * path-level multikey metadata shows the field is not an array, and that the results are correct.
+ */
+load("jstests/libs/analyze_plan.js");  // For isIndexOnly.
+
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db[jsTestName()];
+
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+assert.commandWorked(coll.insert([
+    {a: "foo1", b: ["x1", "y"]},
+    {a: "bar", b: ["x1", "z3"]},
+    {a: "xfoo", b: "x1"},
+    {a: "foo2", b: "w"},
+]));
+
+const filter = {
+    a: /foo/,
+    b: "x1"
+};
+const projection = {
+    _id: 0,
+    a: 1
+};
+const predicateOnMultikeyField = {
+    a: {$gte: ""},
+    b: /3/
+};
+
+function setCoverFilters(enabled) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQueryPlannerCoverFiltersOnNonMultikeyPaths: enabled}));
+}
+
+function runAndExplain(query) {
+    const results = coll.find(query, projection).sort({a: 1}).toArray();
+    const explain = coll.find(query, projection).sort({a: 1}).explain();
+    return {results, isCovered: isIndexOnly(db, getWinningPlan(explain.queryPlanner))};
+}
+
+setCoverFilters(false);
+const expected = runAndExplain(filter);
+assert.eq(expected.results, [{a: "foo1"}, {a: "xfoo"}]);
+assert(!expected.isCovered);
+
+setCoverFilters(true);
+const covered = runAndExplain(filter);
+assert.eq(covered.results, expected.results);
+assert(covered.isCovered);
+
+// 'b' is multikey, so a predicate on it still needs the documents.
+const fetched = runAndExplain(predicateOnMultikeyField);
+assert.eq(fetched.results, [{a: "bar"}]);
+assert(!fetched.isCovered);
+
+MongoRunner.stopMongod(conn);
+}());
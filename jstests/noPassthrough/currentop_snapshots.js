@@ -0,0 +1,54 @@
+/**
+ * Tests that with 'internalCurrentOpSnapshotRefreshMillis' set, $currentOp reports operations which
+ * keep yielding from their published snapshots, and falls back to the full report otherwise.
+ * @tags: [requires_scripting]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({
+    setParameter: {internalCurrentOpSnapshotRefreshMillis: 50, internalQueryExecYieldIterations: 1}
+});
+const testDB = conn.getDB('test');
+const adminDB = conn.getDB('admin');
+
+assert.commandWorked(testDB.coll.insert(Array.from({length: 1000}, (_, i) => ({_id: i}))));
+
+// A slow collection scan, which yields, and so refreshes its snapshot, after every document.
+const awaitShell = startParallelShell(() => {
+    db.getSiblingDB('test')
+        .coll.find({$where: 'sleep(10); return true;'})
+        .comment('currentop_snapshots')
+        .itcount();
+}, conn.port);
+
+const getOp = () => adminDB
+                        .aggregate([
+                            {$currentOp: {}},
+                            {$match: {'command.comment': 'currentop_snapshots', active: true}}
+                        ])
+                        .toArray()[0];
+
+// Reports served from snapshots do not include the lock state, which is only available with the
+// client locked.
+let op;
+assert.soon(() => {
+    op = getOp();
+    return op && !op.hasOwnProperty('waitingForLock');
+});
+assert.eq(op.ns, 'test.coll', tojson(op));
+
+// The running time is brought up to date for each read of the snapshot.
+assert.soon(() => getOp().microsecs_running > op.microsecs_running);
+
+// With snapshots disabled, the operation is reported in full again.
+assert.commandWorked(
+    adminDB.runCommand({setParameter: 1, internalCurrentOpSnapshotRefreshMillis: 0}));
+op = getOp();
+assert(op.hasOwnProperty('waitingForLock'), tojson(op));
+
+assert.commandWorked(adminDB.killOp(op.opid));
+awaitShell({checkExitSuccess: false});
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,83 @@
+/**
+ * Tests that multi-deletes and the TTL monitor removing several documents per storage transaction,
+ * as enabled by 'internalQueryDeleteManyWriteBatchSize' and 'ttlMonitorWriteBatchSize', delete
+ * exactly the matching documents along with all of their index keys, and log one oplog entry per
+ * document.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {
+        setParameter: {
+            internalQueryDeleteManyWriteBatchSize: 16,
+            ttlMonitorWriteBatchSize: 16,
+            ttlMonitorSleepSecs: 1
+        }
+    }
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.coll;
+const oplog = primary.getDB("local").oplog.rs;
+
+const nDocs = 250;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert({_id: i, a: i, b: i % 2, arr: [i, -i]});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1, a: -1}));
+assert.commandWorked(coll.createIndex({arr: 1}));
+
+function countDeleteOplogEntries() {
+    return oplog.find({op: "d", ns: coll.getFullName()}).itcount();
+}
+
+// Only the documents the filter matches are deleted, each with its own oplog entry, and every
+// index loses their keys.
+let res = assert.commandWorked(coll.deleteMany({b: 1}));
+assert.eq(res.deletedCount, nDocs / 2, tojson(res));
+assert.eq(coll.find().itcount(), nDocs / 2);
+assert.eq(countDeleteOplogEntries(), nDocs / 2);
+for (let index of [{a: 1}, {b: 1, a: -1}]) {
+    assert.eq(coll.find().hint(index).itcount(), nDocs / 2, tojson(index));
+}
+assert.eq(coll.find({arr: {$lte: 0}}).hint({arr: 1}).itcount(), nDocs / 2);
+let validation = assert.commandWorked(coll.validate({full: true}));
+assert(validation.valid, tojson(validation));
+
+// Deleting through an index scan of a range works the same.
+res = assert.commandWorked(coll.deleteMany({a: {$lt: 100}}, {hint: {a: 1}}));
+assert.eq(res.deletedCount, 50, tojson(res));
+assert.eq(coll.find().itcount(), nDocs / 2 - 50);
+validation = assert.commandWorked(coll.validate({full: true}));
+assert(validation.valid, tojson(validation));
+
+// The TTL monitor deletes expired documents in batches as well.
+const ttlColl = db.ttl;
+const now = new Date();
+const past = new Date(now.getTime() - 60 * 60 * 1000);
+bulk = ttlColl.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert({_id: i, x: i % 5 == 0 ? now : past, y: i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(ttlColl.createIndex({y: 1}));
+assert.commandWorked(ttlColl.createIndex({x: 1}, {expireAfterSeconds: 60}));
+
+assert.soon(() => ttlColl.find().itcount() == nDocs / 5,
+            () => "TTL monitor did not delete expired documents: " + ttlColl.find().itcount());
+assert.eq(ttlColl.find().hint({y: 1}).itcount(), nDocs / 5);
+validation = assert.commandWorked(ttlColl.validate({full: true}));
+assert(validation.valid, tojson(validation));
+
+rst.stopSet();
+})();
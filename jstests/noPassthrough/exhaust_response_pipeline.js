@@ -0,0 +1,37 @@
+/**
+ * Tests that exhaust cursors return every document in order when their responses are sent in the
+ * background while the next batch is produced ('exhaustResponsePipelineMaxBytes').
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({setParameter: {exhaustResponsePipelineMaxBytes: 16 * 1024}});
+const db = conn.getDB("test");
+const coll = db.exhaust_response_pipeline;
+
+const kDocumentCount = 1000;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < kDocumentCount; i++) {
+    bulk.insert({_id: i, padding: "x".repeat(i % 100)});
+}
+assert.commandWorked(bulk.execute());
+
+function exhaustFind(batchSize) {
+    return coll.find({}).sort({_id: 1}).batchSize(batchSize).addOption(DBQuery.Option.exhaust);
+}
+
+const expected = coll.find({}).sort({_id: 1}).toArray();
+assert.eq(expected.length, kDocumentCount);
+
+// Small batches fit within the limit and are pipelined.
+assert.eq(exhaustFind(10).toArray(), expected);
+
+// Batches larger than the limit are sent before the next one is produced, as before.
+assert.eq(exhaustFind(500).toArray(), expected);
+
+// Turning pipelining off at runtime must not disturb later exhaust cursors.
+assert.commandWorked(db.adminCommand({setParameter: 1, exhaustResponsePipelineMaxBytes: 0}));
+assert.eq(exhaustFind(10).toArray(), expected);
+
+MongoRunner.stopMongod(conn);
+}());
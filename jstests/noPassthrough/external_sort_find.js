@@ -80,6 +80,7 @@ sortStats = getFindSortStats(true);
 assert.eq(sortStats.memLimit, kMaxMemoryUsageBytes);
 assert.lt(sortStats.totalDataSizeSorted, kMaxMemoryUsageBytes);
 assert.eq(sortStats.usedDisk, false);
+assert.eq(sortStats.spilledDataStorageSize, 0, sortStats);
 
 // Add enough data to exceed the memory threshold.
 for (let i = kNumDocsWithinMemLimit; i < kNumDocsExceedingMemLimit; ++i) {
@@ -140,6 +141,7 @@ const expectedNumberOfSpills =
 const findExternalSortStats = getFindSortStats(true);
 assert.eq(findExternalSortStats.usedDisk, true, findExternalSortStats);
 assert.eq(findExternalSortStats.spills, expectedNumberOfSpills, findExternalSortStats);
+assert.gt(findExternalSortStats.spilledDataStorageSize, 0, findExternalSortStats);
 
 // Verify that performing sorting on the collection using aggregate that exceeds the memory limit
 // and can be optimized away results in 'expectedNumberOfSpills' when allowDiskUse is set to true.
@@ -161,6 +163,9 @@ assert.eq(aggregationExternalSortStatsForPipeline.usedDisk,
 assert.eq(aggregationExternalSortStatsForPipeline.spills,
           expectedNumberOfSpills,
           aggregationExternalSortStatsForPipeline);
+assert.gt(aggregationExternalSortStatsForPipeline.spilledDataStorageSize,
+          0,
+          aggregationExternalSortStatsForPipeline);
 
 MongoRunner.stopMongod(conn);
 }());
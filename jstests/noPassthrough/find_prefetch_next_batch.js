@@ -0,0 +1,83 @@
+/**
+ * Tests that a find cursor opened with 'prefetchNextBatch' returns the same results as one opened
+ * without it, that its batches after the first are produced ahead of time, and that an error hit
+ * by a prefetch is reported by the next getMore.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const conn = MongoRunner.runMongod({});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("test");
+const coll = testDB.find_prefetch_next_batch;
+
+const kNumDocs = 1000;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; i++) {
+    bulk.insert({_id: i, a: i % 10});
+}
+assert.commandWorked(bulk.execute());
+
+const prefetchedBatches = () =>
+    assert.commandWorked(testDB.serverStatus()).metrics.cursor.prefetch.batches;
+
+function readAll(findOptions, getMoreBatchSize) {
+    const findCmd = {find: coll.getName(), filter: {a: {$lt: 5}}, sort: {_id: 1}, batchSize: 50};
+    let res = assert.commandWorked(testDB.runCommand(Object.assign(findCmd, findOptions)));
+    let docs = res.cursor.firstBatch;
+    while (res.cursor.id != 0) {
+        res = assert.commandWorked(testDB.runCommand(
+            {getMore: res.cursor.id, collection: coll.getName(), batchSize: getMoreBatchSize}));
+        docs = docs.concat(res.cursor.nextBatch);
+    }
+    return docs;
+}
+
+const expected = readAll({}, 50);
+assert.eq(expected.length, kNumDocs / 2, tojson(expected));
+
+const batchesBefore = prefetchedBatches();
+assert.eq(readAll({prefetchNextBatch: true}, 50), expected);
+// Prefetching is best-effort, since a getMore may reach the cursor before the prefetch does.
+assert.gt(prefetchedBatches(), batchesBefore);
+
+// A getMore may ask for fewer or more results than were prefetched.
+assert.eq(readAll({prefetchNextBatch: true}, 20), expected);
+assert.eq(readAll({prefetchNextBatch: true}, 120), expected);
+
+// Killing a cursor which may be prefetching its next batch cleans it up.
+const res = assert.commandWorked(testDB.runCommand(
+    {find: coll.getName(), filter: {}, batchSize: 10, prefetchNextBatch: true}));
+assert.commandWorked(testDB.runCommand({killCursors: coll.getName(), cursors: [res.cursor.id]}));
+assert.commandFailedWithCode(
+    testDB.runCommand({getMore: res.cursor.id, collection: coll.getName()}),
+    ErrorCodes.CursorNotFound);
+assert.eq(0, assert.commandWorked(testDB.serverStatus()).metrics.cursor.prefetch.bufferedBytes);
+
+// Nothing is prefetched once the results buffered for all cursors hold the whole budget.
+assert.commandWorked(testDB.adminCommand({setParameter: 1, cursorPrefetchMaxBufferedBytes: 0}));
+const batchesWithoutBudget = prefetchedBatches();
+assert.eq(readAll({prefetchNextBatch: true}, 50), expected);
+assert.eq(prefetchedBatches(), batchesWithoutBudget);
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, cursorPrefetchMaxBufferedBytes: 100 * 1024 * 1024}));
+
+// Dropping the collection while a prefetch is about to read from it makes the prefetch fail, and
+// the next getMore reports that instead of a batch.
+const hangBeforePrefetch = configureFailPoint(conn, "hangBeforeCursorPrefetch");
+const droppedRes = assert.commandWorked(testDB.runCommand(
+    {find: coll.getName(), filter: {}, batchSize: 10, prefetchNextBatch: true}));
+hangBeforePrefetch.wait();
+assert(coll.drop());
+const batchesBeforeDrop = prefetchedBatches();
+hangBeforePrefetch.off();
+assert.commandFailedWithCode(
+    testDB.runCommand({getMore: droppedRes.cursor.id, collection: coll.getName()}),
+    ErrorCodes.QueryPlanKilled);
+assert.eq(prefetchedBatches(), batchesBeforeDrop);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,44 @@
+/**
+ * Tests that the high resolution FTDC collector writes its samples to its own subdirectory of
+ * diagnostic.data, and that its parameters can be changed at runtime.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        diagnosticDataCollectionHighResolutionEnabled: true,
+        diagnosticDataCollectionHighResolutionPeriodMillis: 10,
+    }
+});
+const admin = conn.getDB('admin');
+
+const ftdcPath = assert
+                     .commandWorked(admin.runCommand(
+                         {getParameter: 1, diagnosticDataCollectionDirectoryPath: 1}))
+                     .diagnosticDataCollectionDirectoryPath;
+const highResolutionPath = ftdcPath + '/highResolution';
+
+assert.soon(() => {
+    return listFiles(highResolutionPath).some(file => file.baseName.startsWith('metrics.'));
+}, () => 'no high resolution metrics in ' + tojson(listFiles(ftdcPath)));
+
+// The regular FTDC files are still written to diagnostic.data itself.
+assert(listFiles(ftdcPath).some(file => file.baseName.startsWith('metrics.')),
+       tojson(listFiles(ftdcPath)));
+
+assert.commandWorked(admin.runCommand({
+    setParameter: 1,
+    diagnosticDataCollectionHighResolutionPeriodMillis: 100,
+    diagnosticDataCollectionHighResolutionOverheadPercent: 10,
+}));
+assert.commandFailed(
+    admin.runCommand({setParameter: 1, diagnosticDataCollectionHighResolutionPeriodMillis: 1}));
+assert.commandFailed(
+    admin.runCommand({setParameter: 1, diagnosticDataCollectionHighResolutionSections: 'locks'}));
+
+assert.commandWorked(
+    admin.runCommand({setParameter: 1, diagnosticDataCollectionHighResolutionEnabled: false}));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,84 @@
+/**
+ * Tests that $graphLookup writes the documents it has visited to disk when it exceeds its memory
+ * limit, 'allowDiskUse' is set and 'internalDocumentSourceGraphLookupAllowSpilling' is enabled, and
+ * that the results are returned in the order the breadth-first search discovered them.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalDocumentSourceGraphLookupMaxMemoryBytes: 512 * 1024}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const local = db.local;
+const foreign = db.foreign;
+local.drop();
+foreign.drop();
+
+assert.commandWorked(local.insert({_id: 0, start: 0}));
+
+// Build a chain of nodes which are about 2MB in total, well over the memory limit.
+const numNodes = 100;
+const padding = "x".repeat(20 * 1024);
+const bulk = foreign.initializeUnorderedBulkOp();
+for (let i = 0; i < numNodes; i++) {
+    bulk.insert({_id: i, next: i + 1, padding: padding});
+}
+assert.commandWorked(bulk.execute());
+
+const graphLookup = {
+    $graphLookup: {
+        from: foreign.getName(),
+        startWith: "$start",
+        connectFromField: "next",
+        connectToField: "_id",
+        depthField: "depth",
+        as: "graph"
+    }
+};
+const pipeline = [graphLookup, {$project: {"graph.padding": 0}}];
+const unwindPipeline = [graphLookup, {$unwind: "$graph"}, {$project: {"graph.padding": 0}}];
+
+function setAllowSpilling(enabled) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalDocumentSourceGraphLookupAllowSpilling: enabled}));
+}
+
+function runAggregate(pipeline, allowDiskUse) {
+    return db.runCommand(
+        {aggregate: local.getName(), pipeline: pipeline, cursor: {}, allowDiskUse: allowDiskUse});
+}
+
+// Spilling is disabled by default, so the memory limit is enforced as before.
+assert.commandFailedWithCode(runAggregate(pipeline, true), 40099);
+
+setAllowSpilling(true);
+
+// Without 'allowDiskUse' the stage is still not permitted to spill.
+assert.commandFailedWithCode(runAggregate(pipeline, false), 40099);
+
+let res = runAggregate(pipeline, true);
+assert.commandWorked(res);
+let results = res.cursor.firstBatch;
+assert.eq(1, results.length, tojson(results));
+assert.eq(numNodes, results[0].graph.length, tojson(results));
+results[0].graph.forEach((node, i) => {
+    assert.eq({_id: i, next: i + 1, depth: NumberLong(i)}, node, tojson(results));
+});
+
+// An absorbed $unwind streams the visited documents in the same order.
+res = runAggregate(unwindPipeline, true);
+assert.commandWorked(res);
+results = new DBCommandCursor(db, res).toArray();
+assert.eq(numNodes, results.length, tojson(results));
+results.forEach((doc, i) => {
+    assert.eq({_id: 0, start: 0, graph: {_id: i, next: i + 1, depth: NumberLong(i)}},
+              doc,
+              tojson(results));
+});
+
+setAllowSpilling(false);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,63 @@
+/**
+ * Tests that a $group on the key of a preceding $sort streams its groups when
+ * 'internalDocumentSourceGroupStreamSortedInput' is set, and that it produces the same groups as a
+ * hashed $group, including for group keys which are missing, null or arrays.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+load("jstests/libs/analyze_plan.js");         // For getAggPlanStage.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.group_streaming_sorted_input;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 200; i++) {
+    docs.push({a: i % 20, b: i % 3, c: i});
+}
+docs.push({b: 1, c: -1}, {a: null, b: 1, c: -2}, {a: [3, 30], b: 2, c: -3}, {a: [], c: -4});
+assert.commandWorked(coll.insert(docs));
+
+function setStreaming(enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalDocumentSourceGroupStreamSortedInput: enabled}));
+}
+
+function assertSameGroups(pipeline, expectStreaming) {
+    setStreaming(false);
+    const expected = coll.aggregate(pipeline).toArray();
+
+    setStreaming(true);
+    const groupStage = getAggPlanStage(coll.explain().aggregate(pipeline), "$group");
+    assert.neq(null, groupStage, pipeline);
+    assert.eq(!!groupStage.streaming, expectStreaming, groupStage);
+    const actual = coll.aggregate(pipeline).toArray();
+    assert(arrayEq(actual, expected), tojson({actual: actual, expected: expected}));
+}
+
+const groupOnA = {$group: {_id: "$a", total: {$sum: "$c"}, n: {$sum: 1}, last: {$max: "$c"}}};
+assertSameGroups([{$sort: {a: 1}}, groupOnA], true);
+assertSameGroups([{$sort: {a: -1, c: 1}}, groupOnA], true);
+
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+assertSameGroups([{$match: {c: {$gte: -10}}}, {$sort: {a: 1}}, groupOnA], true);
+
+const groupOnAB = {$group: {_id: {b: "$b", a: "$a"}, total: {$sum: "$c"}}};
+assertSameGroups([{$sort: {a: 1, b: 1}}, groupOnAB], true);
+assertSameGroups([{$sort: {a: 1}}, groupOnAB], false);
+assertSameGroups([{$sort: {b: 1}}, groupOnA], false);
+
+// The group keys come out in sort order as soon as each group is complete.
+setStreaming(true);
+const streamed = coll.aggregate([{$match: {c: {$gte: 0}}}, {$sort: {a: 1}}, groupOnA])
+                     .toArray()
+                     .map(group => group._id);
+assert.eq(streamed, Array.from({length: 20}, (_, i) => i));
+
+setStreaming(false);
+MongoRunner.stopMongod(conn);
+}());
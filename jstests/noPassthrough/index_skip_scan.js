@@ -0,0 +1,51 @@
+/**
+ * Tests that with 'internalQueryPlannerGenerateIndexSkipScans' set, a query constraining only the
+ * trailing field of a compound index skip scans the index, seeking past each distinct value of the
+ * leading field, and returns the same results as a collection scan.
+ */
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db[jsTestName()];
+
+const kNumTenants = 5;
+const kNumTimestamps = 400;
+const docs = [];
+for (let tenant = 0; tenant < kNumTenants; tenant++) {
+    for (let ts = 0; ts < kNumTimestamps; ts++) {
+        docs.push({tenant: tenant, ts: ts});
+    }
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({tenant: 1, ts: 1}));
+
+const filter = {
+    ts: {$gte: 100, $lt: 110}
+};
+const expected = coll.find(filter, {_id: 0}).sort({tenant: 1, ts: 1}).toArray();
+assert.eq(expected.length, kNumTenants * 10, expected);
+
+// Without skip scans only a collection scan can answer the query.
+let explain = coll.find(filter).explain("executionStats");
+assert(isCollscan(db, getWinningPlan(explain.queryPlanner)), explain);
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryPlannerGenerateIndexSkipScans: true}));
+
+explain = coll.find(filter).explain("executionStats");
+const ixscan = getPlanStage(explain.executionStats.executionStages, "IXSCAN");
+assert.neq(ixscan, null, explain);
+assert.eq(ixscan.keyPattern, {tenant: 1, ts: 1}, explain);
+// Each tenant costs a seek to its first matching key and one more past its last, rather than a
+// walk through all of its keys.
+assert.lte(ixscan.keysExamined, kNumTenants * 12, explain);
+assert.eq(explain.executionStats.totalDocsExamined, kNumTenants * 10, explain);
+
+assert.eq(coll.find(filter, {_id: 0}).sort({tenant: 1, ts: 1}).toArray(), expected);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,61 @@
+/**
+ * Tests that inserts which validate the documents of each next batch while writing the current
+ * one, as enabled by 'internalInsertPipelineValidation', report the same results and errors, in
+ * the same order, as inserts which validate every document in turn.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalInsertPipelineValidation: true, internalInsertMaxBatchSize: 10}});
+const db = conn.getDB("test");
+const coll = db.coll;
+
+const nDocs = 100;
+const invalid = [15, 16, 47, 90];
+function makeDocs() {
+    let docs = [];
+    for (let i = 0; i < nDocs; i++) {
+        // Documents with an array _id fail validation.
+        docs.push({_id: invalid.includes(i) ? [i] : i, x: i});
+    }
+    return docs;
+}
+
+function runInsert(ordered) {
+    coll.drop();
+    return db.runCommand({insert: coll.getName(), documents: makeDocs(), ordered: ordered});
+}
+
+function checkResults(pipelined) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalInsertPipelineValidation: pipelined}));
+
+    // An ordered insert stops at the first invalid document.
+    let res = runInsert(true);
+    assert.eq(res.n, invalid[0], tojson(res));
+    assert.eq(res.writeErrors.length, 1, tojson(res));
+    assert.eq(res.writeErrors[0].index, invalid[0], tojson(res));
+    assert.eq(coll.find().itcount(), invalid[0]);
+
+    // An unordered insert reports every invalid document, in order, and inserts all others.
+    res = runInsert(false);
+    assert.eq(res.n, nDocs - invalid.length, tojson(res));
+    assert.eq(res.writeErrors.map(error => error.index), invalid, tojson(res));
+    assert.eq(coll.find().itcount(), nDocs - invalid.length);
+
+    // Documents without an _id, and documents whose _id is not first, are fixed the same way.
+    coll.drop();
+    let docs = [];
+    for (let i = 0; i < nDocs; i++) {
+        docs.push(i % 2 ? {x: i} : {x: i, _id: i});
+    }
+    assert.commandWorked(coll.insert(docs));
+    coll.find().forEach(doc => assert.eq(Object.keys(doc)[0], "_id", tojson(doc)));
+}
+
+checkResults(true);
+checkResults(false);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,49 @@
+/**
+ * Tests that log records reach the log file when it is written by a background thread, and that
+ * records dropped because the write buffer was full are counted in the log.
+ */
+(function() {
+'use strict';
+
+function logLines(conn) {
+    return cat(conn.fullOptions.logFile)
+        .split("\n")
+        .filter((l) => l != '')
+        .map((l) => JSON.parse(l));
+}
+
+function countLogMessages(conn, msg) {
+    return logLines(conn).filter((l) => l.id === 5060500 && l.attr.msg === msg).length;
+}
+
+// A buffer with plenty of room writes everything, in the background.
+let conn = MongoRunner.runMongod(
+    {useLogFiles: true, setParameter: {logAsyncWriteBufferBytes: 16 * 1024 * 1024}});
+let admin = conn.getDB('admin');
+
+assert.commandWorked(admin.runCommand({logMessage: "async info"}));
+assert.soon(() => countLogMessages(conn, "async info") === 1);
+
+// Errors are on disk by the time the command returns.
+assert.commandWorked(admin.runCommand({logMessage: "async error", severity: "error"}));
+assert.eq(countLogMessages(conn, "async error"), 1);
+
+assert.commandWorked(admin.runCommand({logRotate: 1}));
+assert.commandWorked(admin.runCommand({logMessage: "after rotate"}));
+assert.soon(() => countLogMessages(conn, "after rotate") === 1);
+MongoRunner.stopMongod(conn);
+
+// A buffer too small for any record drops them all, and the next error reports how many.
+conn = MongoRunner.runMongod({useLogFiles: true, setParameter: {logAsyncWriteBufferBytes: 1}});
+admin = conn.getDB('admin');
+
+assert.commandWorked(admin.runCommand({logMessage: "dropped info"}));
+assert.commandWorked(admin.runCommand({logMessage: "kept error", severity: "error"}));
+assert.eq(countLogMessages(conn, "dropped info"), 0);
+assert.eq(countLogMessages(conn, "kept error"), 1);
+
+const dropped = logLines(conn).filter((l) => l.id === 6107000);
+assert.gte(dropped.length, 1, tojson(dropped));
+assert.gte(dropped[0].attr.dropped, 1, tojson(dropped));
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,85 @@
+/**
+ * Tests that $lookup stages lowered into the SBE plan by
+ * 'internalQuerySlotBasedExecutionEnableLookupPushdown' return the same documents as the classic
+ * $lookup for local values which are regular expressions, arrays, nested arrays or empty arrays,
+ * with either join strategy.
+ */
+(function() {
+"use strict";
+
+const conn =
+    MongoRunner.runMongod({setParameter: {internalQueryEnableSlotBasedExecutionEngine: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const local = db.local;
+const foreign = db.foreign;
+local.drop();
+foreign.drop();
+
+assert.commandWorked(local.insert([
+    {_id: 0, a: /abc/},
+    {_id: 1, a: [/abc/, "b"]},
+    {_id: 2, a: "abc"},
+    {_id: 3, a: [[1, 2]]},
+    {_id: 4, a: [1, [2]]},
+    {_id: 5, a: [1, 2]},
+    {_id: 6, a: []},
+    {_id: 7, a: [[]]},
+    {_id: 8, a: null},
+    {_id: 9},
+    {_id: 10, a: 1},
+]));
+assert.commandWorked(foreign.insert([
+    {_id: 0, b: "abc"},
+    {_id: 1, b: /abc/},
+    {_id: 2, b: ["abc", "b"]},
+    {_id: 3, b: [1, 2]},
+    {_id: 4, b: [[1, 2]]},
+    {_id: 5, b: [2]},
+    {_id: 6, b: 1},
+    {_id: 7, b: []},
+    {_id: 8, b: [[]]},
+    {_id: 9, b: null},
+    {_id: 10},
+]));
+
+const pipeline = [
+    {$lookup: {from: foreign.getName(), localField: "a", foreignField: "b", as: "matches"}},
+    {$project: {matches: "$matches._id"}},
+];
+
+function runWithPushdown(enabled) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQuerySlotBasedExecutionEnableLookupPushdown: enabled}));
+    return local.aggregate(pipeline)
+        .toArray()
+        .map(doc => ({_id: doc._id, matches: doc.matches.sort((l, r) => l - r)}))
+        .sort((l, r) => l._id - r._id);
+}
+
+function assertSameResults() {
+    const expected = runWithPushdown(false);
+    assert.eq(expected.length, local.count());
+    assert.eq(runWithPushdown(true), expected);
+}
+
+// The hash join.
+assertSameResults();
+
+// An index on the foreign field which is not multikey lets the plan use the indexed nested loop
+// join.
+const foreignScalar = db.foreignScalar;
+assert.commandWorked(foreignScalar.createIndex({b: 1}));
+assert.commandWorked(foreignScalar.insert(
+    [{_id: 0, b: "abc"}, {_id: 1, b: /abc/}, {_id: 2, b: 1}, {_id: 3, b: null}, {_id: 4}]));
+pipeline[0].$lookup.from = foreignScalar.getName();
+assertSameResults();
+
+// A multikey index on the foreign field.
+pipeline[0].$lookup.from = foreign.getName();
+assert.commandWorked(foreign.createIndex({b: 1}));
+assertSameResults();
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,75 @@
+/**
+ * Tests that the node-wide $lookup result cache enabled by
+ * 'internalLookupStageResultCacheMaxSizeBytes' serves repeated lookups from other operations, and
+ * that writes to the foreign collection are visible to the lookups which follow them.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalLookupStageResultCacheMaxSizeBytes: 1024 * 1024}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const orders = db.orders;
+const currencies = db.currencies;
+orders.drop();
+currencies.drop();
+
+assert.commandWorked(currencies.insert([{_id: "EUR", rate: 1.1}, {_id: "GBP", rate: 1.3}]));
+assert.commandWorked(orders.insert([
+    {_id: 0, currency: "EUR"},
+    {_id: 1, currency: "GBP"},
+    {_id: 2, currency: "EUR"},
+    {_id: 3, currency: "JPY"}
+]));
+
+const pipeline = [
+    {$sort: {_id: 1}},
+    {$lookup: {from: currencies.getName(), localField: "currency", foreignField: "_id", as: "c"}},
+    {$project: {rate: "$c.rate"}}
+];
+
+function resultCacheMetrics() {
+    return db.serverStatus().metrics.query.lookup.resultCache;
+}
+
+function assertRates(expected) {
+    assert.eq(orders.aggregate(pipeline).toArray().map(doc => doc.rate), expected);
+}
+
+let before = resultCacheMetrics();
+assertRates([[1.1], [1.3], [1.1], []]);
+let after = resultCacheMetrics();
+// The second EUR order is served from the entry populated by the first one.
+assert.eq(after.hits - before.hits, 1, tojson({before: before, after: after}));
+assert.eq(after.misses - before.misses, 3, tojson({before: before, after: after}));
+
+// Another operation is served from the cache entirely.
+before = after;
+assertRates([[1.1], [1.3], [1.1], []]);
+after = resultCacheMetrics();
+assert.eq(after.hits - before.hits, 4, tojson({before: before, after: after}));
+
+// Writes to the foreign collection invalidate its entries.
+assert.commandWorked(currencies.update({_id: "EUR"}, {$set: {rate: 1.2}}));
+assert.commandWorked(currencies.insert({_id: "JPY", rate: 0.01}));
+assertRates([[1.2], [1.3], [1.2], [0.01]]);
+
+assert.commandWorked(currencies.remove({_id: "GBP"}));
+assertRates([[1.2], [], [1.2], [0.01]]);
+
+assert(currencies.drop());
+assertRates([[], [], [], []]);
+
+// Setting the budget to zero turns the cache off.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalLookupStageResultCacheMaxSizeBytes: 0}));
+before = resultCacheMetrics();
+assertRates([[], [], [], []]);
+after = resultCacheMetrics();
+assert.eq(after.hits, before.hits, tojson({before: before, after: after}));
+assert.eq(after.misses, before.misses, tojson({before: before, after: after}));
+
+MongoRunner.stopMongod(conn);
+}());
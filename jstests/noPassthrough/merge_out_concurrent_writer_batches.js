@@ -0,0 +1,62 @@
+/**
+ * Tests that $out and $merge produce the same results when their batches are written concurrently
+ * with 'internalQueryMaxInFlightWriterBatches', and that $merge still applies the documents for the
+ * same 'on' fields in input order.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryMaxInFlightWriterBatches: 4}});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("test");
+const source = testDB.source;
+
+// Documents of about 32KB, so that the output is split into several batches of 16MB.
+const padding = "x".repeat(32 * 1024);
+const kNumDocs = 3000;
+const kNumKeys = 10;
+let bulk = source.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; i++) {
+    bulk.insert({_id: i, key: i % kNumKeys, padding: padding});
+}
+assert.commandWorked(bulk.execute());
+
+const batches = () =>
+    assert.commandWorked(testDB.serverStatus()).metrics.query.writerPool.batches;
+const initialBatches = batches();
+
+source.aggregate([{$out: "outColl"}]);
+assert.eq(kNumDocs, testDB.outColl.countDocuments({}));
+assert.gt(batches(), initialBatches);
+
+// Every document of a key is merged into the same target document, which records the order in
+// which they were applied.
+const mergePipeline = [
+    {$sort: {_id: 1}},
+    {$project: {_id: "$key", seq: "$_id", padding: 1}},
+    {
+        $merge: {
+            into: "mergeColl",
+            whenMatched: [{
+                $set: {
+                    count: {$add: [{$ifNull: ["$count", 0]}, 1]},
+                    inOrder: {$and: [{$ifNull: ["$inOrder", true]}, {$lt: ["$seq", "$$new.seq"]}]},
+                    seq: "$$new.seq"
+                }
+            }],
+            whenNotMatched: "insert"
+        }
+    }
+];
+source.aggregate(mergePipeline, {allowDiskUse: true});
+const merged = testDB.mergeColl.find({}, {padding: 0}).toArray();
+assert.eq(kNumKeys, merged.length, tojson(merged));
+for (let doc of merged) {
+    assert.eq(kNumDocs / kNumKeys - 1, doc.count, tojson(doc));
+    assert.eq(true, doc.inOrder, tojson(doc));
+    assert.eq(kNumDocs - kNumKeys + doc._id, doc.seq, tojson(doc));
+}
+
+MongoRunner.stopMongod(conn);
+}());
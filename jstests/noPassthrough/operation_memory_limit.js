@@ -0,0 +1,60 @@
+/**
+ * Tests that the stages of an aggregation spill to disk, or fail if they cannot, once the memory
+ * they hold together exceeds 'internalQueryMaxMemoryUsageBytesPerOperation', and that the most
+ * memory held at once by the operation is reported in explain and in the profiler.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("test");
+const coll = testDB.operation_memory_limit;
+
+const bigString = "x".repeat(1024);
+const nDocs = 4 * 1024;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert({_id: i, s: bigString});
+}
+assert.commandWorked(bulk.execute());
+
+const pipeline = [{$group: {_id: "$_id", strings: {$push: "$s"}}}, {$count: "n"}];
+
+function getGroupStage(explain) {
+    const groupStages = explain.stages.filter(stage => stage.hasOwnProperty("$group"));
+    assert.eq(groupStages.length, 1, tojson(explain));
+    return groupStages[0];
+}
+
+// Without a limit for the operation, the $group holds all of its groups in memory.
+let explain = coll.explain("executionStats").aggregate(pipeline);
+assert.gt(explain.peakMemoryUsageBytes, nDocs * bigString.length, tojson(explain));
+assert.eq(getGroupStage(explain).spills, 0, tojson(explain));
+
+assert.commandWorked(testDB.setProfilingLevel(2));
+assert.eq(coll.aggregate(pipeline, {comment: "no_limit"}).toArray(), [{n: nDocs}]);
+const profileEntry = testDB.system.profile.findOne({"command.comment": "no_limit"});
+assert.neq(null, profileEntry);
+assert.gt(profileEntry.peakMemoryUsageBytes, nDocs * bigString.length, tojson(profileEntry));
+assert.commandWorked(testDB.setProfilingLevel(0));
+
+// With a limit for the operation far below the limit of the $group, the $group has to spill, or
+// fail if it is not allowed to.
+const operationLimit = 2 * 1024 * 1024;
+assert.commandWorked(testDB.adminCommand(
+    {setParameter: 1, internalQueryMaxMemoryUsageBytesPerOperation: operationLimit}));
+
+assert.commandFailedWithCode(
+    testDB.runCommand(
+        {aggregate: coll.getName(), pipeline: pipeline, cursor: {}, allowDiskUse: false}),
+    ErrorCodes.QueryExceededMemoryLimitNoDiskUseAllowed);
+
+assert.eq(coll.aggregate(pipeline, {allowDiskUse: true}).toArray(), [{n: nDocs}]);
+explain = coll.explain("executionStats").aggregate(pipeline, {allowDiskUse: true});
+assert.gt(getGroupStage(explain).spills, 0, tojson(explain));
+assert.lt(explain.peakMemoryUsageBytes, 2 * operationLimit, tojson(explain));
+
+MongoRunner.stopMongod(conn);
+}());
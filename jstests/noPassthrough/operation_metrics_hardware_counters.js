@@ -0,0 +1,42 @@
+/**
+ * Tests that $operationMetrics reports the hardware counters of each database when
+ * 'collectOperationResourceConsumptionHardwareCounters' is enabled.
+ * @tags: [
+ *   requires_replication,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+'use strict';
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {
+        setParameter: {
+            aggregateOperationResourceConsumptionMetrics: true,
+            collectOperationResourceConsumptionHardwareCounters: true,
+        }
+    }
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const adminDB = primary.getDB('admin');
+const testDB = primary.getDB('test');
+
+assert.commandWorked(testDB.coll.insert({_id: 1, a: 1}));
+assert.eq(testDB.coll.find({a: 1}).itcount(), 1);
+
+const metrics = adminDB.aggregate([{$operationMetrics: {}}]).toArray().find(m => m.db === 'test');
+assert.neq(metrics, undefined);
+
+// The counters are zero where perf events are not available to the process, so only their
+// presence is checked.
+const counters = metrics.hardwareCounters;
+assert.neq(counters, undefined, tojson(metrics));
+['instructions', 'cycles', 'cacheMisses', 'blockReadBytes', 'blockWriteBytes'].forEach(
+    (field) => assert.gte(counters[field], 0, tojson(metrics)));
+
+rst.stopSet();
+}());
@@ -0,0 +1,49 @@
+/**
+ * Tests that with 'internalQueryProjectTopLevelFieldsOfPipelineDependencies' set, the projection
+ * pushed down for the dotted-path dependencies of a pipeline keeps whole top-level fields with the
+ * simple projection implementation, and that the pipeline returns the same results.
+ */
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStage.
+
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db[jsTestName()];
+
+const docs = [];
+for (let i = 0; i < 100; i++) {
+    docs.push({_id: i, a: {b: i % 5, c: i, d: "wide"}, e: i, f: "unused"});
+}
+assert.commandWorked(coll.insert(docs));
+
+const pipeline = [
+    {$match: {e: {$gte: 10}}},
+    {$group: {_id: "$a.b", total: {$sum: "$a.c"}}},
+    {$sort: {_id: 1}}
+];
+const expected = coll.aggregate(pipeline).toArray();
+assert.eq(expected.length, 5, expected);
+
+let explain = coll.explain().aggregate(pipeline);
+assert.neq(getAggPlanStage(explain, "PROJECTION_DEFAULT"), null, explain);
+
+assert.commandWorked(db.adminCommand(
+    {setParameter: 1, internalQueryProjectTopLevelFieldsOfPipelineDependencies: true}));
+
+explain = coll.explain().aggregate(pipeline);
+const projStage = getAggPlanStage(explain, "PROJECTION_SIMPLE");
+assert.neq(projStage, null, explain);
+assert.eq(projStage.transformBy.a, true, explain);
+assert.eq(projStage.transformBy._id, false, explain);
+assert.eq(Object.keys(projStage.transformBy).length, 2, explain);
+assert.eq(coll.aggregate(pipeline).toArray(), expected);
+
+// An inclusion $project at the front of the pipeline defines the shape of the results, so it is
+// still pushed down as is.
+const projectPipeline = [{$project: {_id: 0, "a.b": 1}}, {$limit: 1}];
+assert.eq(coll.aggregate(projectPipeline).toArray(), [{a: {b: 0}}]);
+
+MongoRunner.stopMongod(conn);
+}());
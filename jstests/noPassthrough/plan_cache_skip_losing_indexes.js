@@ -0,0 +1,61 @@
+/**
+ * Tests that with 'internalQueryPlanCacheSkipIndexesAfterConsecutiveLosses' set, candidate plans
+ * using an index that has lost that many trial periods in a row for a query shape are no longer
+ * raced, and that the outcomes are reported by $indexStats and $planCacheStats.
+ */
+(function() {
+"use strict";
+
+// Index intersection would add a candidate plan using both indexes.
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryPlanCacheSkipIndexesAfterConsecutiveLosses: 2,
+        internalQueryPlannerEnableIndexIntersection: false,
+    }
+});
+const db = conn.getDB("test");
+const coll = db[jsTestName()];
+
+const docs = [];
+for (let i = 0; i < 200; i++) {
+    docs.push({a: i, b: 1});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+function getTrials(indexName) {
+    const stats = coll.aggregate([{$indexStats: {}}, {$match: {name: indexName}}]).toArray();
+    assert.eq(stats.length, 1, stats);
+    return stats[0].trials;
+}
+
+// The plan using 'a_1' wins right away because the query matches nothing, so no plan is cached
+// and every run of the query goes through a trial period until 'b_1' is left out.
+const query = {a: -1, b: 1};
+for (let i = 0; i < 4; i++) {
+    assert.eq(coll.find(query).itcount(), 0);
+}
+assert.eq(getTrials("a_1"), {wins: 2, losses: 0, skipped: 0});
+assert.eq(getTrials("b_1"), {wins: 0, losses: 2, skipped: 2});
+
+// A shape whose winner gets cached reports the outcomes with its cache entry. The projection
+// makes it a different shape, for which 'b_1' has not lost yet.
+assert.eq(coll.find({a: 5, b: 1}, {_id: 0}).itcount(), 1);
+const cacheStats = coll.aggregate([{$planCacheStats: {}}]).toArray();
+assert.eq(cacheStats.length, 1, cacheStats);
+assert.eq(cacheStats[0].indexTrialStats,
+          {
+              a_1: {wins: 1, losses: 0, consecutiveLosses: 0},
+              b_1: {wins: 0, losses: 1, consecutiveLosses: 1}
+          },
+          cacheStats);
+assert.eq(getTrials("b_1"), {wins: 0, losses: 3, skipped: 2});
+
+// Clearing the plan cache forgets the outcomes, so 'b_1' is raced again.
+assert.commandWorked(db.runCommand({planCacheClear: coll.getName()}));
+assert.eq(coll.find(query).itcount(), 0);
+assert.eq(getTrials("b_1"), {wins: 0, losses: 4, skipped: 2});
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,50 @@
+/**
+ * Tests that the latency histograms and execution totals of each query shape are reported by
+ * $queryShapeMetrics when 'internalQueryShapeMetricsMaxEntries' is set, and that serverStatus
+ * reports how many shapes are tracked.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryShapeMetricsMaxEntries: 100}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const adminDB = conn.getDB("admin");
+
+const coll = db.query_shape_metrics;
+coll.drop();
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.insert(Array.from({length: 20}, (_, i) => ({_id: i, a: i % 5}))));
+
+function shapeMetrics() {
+    return adminDB.aggregate([{$queryShapeMetrics: {}}, {$match: {ns: coll.getFullName()}}])
+        .toArray();
+}
+
+// Queries of the same shape are reported together, whatever the values they compare against.
+for (let i = 0; i < 3; ++i) {
+    assert.eq(coll.find({a: i}).itcount(), 4);
+}
+assert.eq(coll.aggregate([{$match: {a: 1}}]).itcount(), 4);
+
+const explain = coll.find({a: 1}).explain();
+const shape =
+    shapeMetrics().find(metrics => metrics.queryHash === explain.queryPlanner.queryHash);
+assert(shape, tojson(shapeMetrics()));
+assert.gte(shape.execCount, 3, tojson(shape));
+assert.gte(shape.totalKeysExamined, 12, tojson(shape));
+assert.gte(shape.totalDocsReturned, 12, tojson(shape));
+assert.gte(shape.totalPlanningTimeMicros, 0, tojson(shape));
+assert.eq(shape.latencyStats.reads.ops, shape.execCount, tojson(shape));
+assert(shape.latencyStats.reads.hasOwnProperty("histogram"), tojson(shape));
+
+const summary = adminDB.serverStatus().queryShapeMetrics;
+assert.gte(summary.numShapes, 1, tojson(summary));
+assert.eq(summary.numEvicted, 0, tojson(summary));
+
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [{$queryShapeMetrics: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,68 @@
+/**
+ * Tests that the queries sampled under 'internalQueryStatsSampleRate' are reported by $queryStats,
+ * aggregated by query shape with the statistics of each of their plan stages.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const adminDB = conn.getDB("admin");
+
+const coll = db.query_stats;
+coll.drop();
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.insert(Array.from({length: 20}, (_, i) => ({_id: i, a: i % 5}))));
+
+function queryStats() {
+    return adminDB.aggregate([{$queryStats: {}}, {$match: {ns: coll.getFullName()}}]).toArray();
+}
+
+// Sampling is off by default.
+assert.eq(coll.find({a: 1}).itcount(), 4);
+assert.eq(queryStats(), []);
+
+assert.commandWorked(adminDB.adminCommand({setParameter: 1, internalQueryStatsSampleRate: 1}));
+
+// Queries of the same shape are reported together, whatever the values they compare against.
+for (let i = 0; i < 3; ++i) {
+    assert.eq(coll.find({a: i}).itcount(), 4);
+}
+assert.eq(coll.find({_id: {$gte: 10}}, {_id: 1}).itcount(), 10);
+
+let stats = queryStats();
+assert.eq(stats.length, 2, tojson(stats));
+
+const indexedShape = stats.find(shape => shape.numSamples === 3);
+assert(indexedShape, tojson(stats));
+// Each query returned 4 documents from the root of its plan.
+const root = indexedShape.stages[0];
+assert.eq(root.path, "0", tojson(indexedShape));
+assert.eq(root.numSamples, 3, tojson(indexedShape));
+assert.eq(root.totalAdvanced, 12, tojson(indexedShape));
+assert.gt(indexedShape.stages.length, 1, tojson(indexedShape));
+
+// The query shape hash matches the one reported by explain.
+const explain = coll.find({a: 1}).explain();
+assert.eq(indexedShape.queryHash, explain.queryPlanner.queryHash, tojson(stats));
+
+// Explained queries are not sampled.
+assert.eq(queryStats().find(shape => shape.queryHash === indexedShape.queryHash).numSamples, 3);
+
+// Only the most recent samples are kept.
+assert.commandWorked(adminDB.adminCommand({setParameter: 1, internalQueryStatsMaxSamples: 1}));
+assert.eq(coll.find({a: 1}).itcount(), 4);
+stats = queryStats();
+assert.eq(stats.length, 1, tojson(stats));
+assert.eq(stats[0].numSamples, 1, tojson(stats));
+
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [{$queryStats: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+assert.commandFailedWithCode(
+    adminDB.runCommand({aggregate: 1, pipeline: [{$queryStats: {clear: true}}], cursor: {}}),
+    ErrorCodes.BadValue);
+
+MongoRunner.stopMongod(conn);
+}());
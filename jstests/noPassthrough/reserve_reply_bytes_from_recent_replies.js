@@ -0,0 +1,30 @@
+/**
+ * Tests that commands keep returning complete replies when their reply buffers are sized from the
+ * sizes of their recent replies.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {reserveReplyBytesFromRecentReplies: true}});
+const db = conn.getDB("test");
+const coll = db.reserve_reply_bytes;
+
+const bigString = "x".repeat(10 * 1024);
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 200; i++) {
+    bulk.insert({_id: i, s: bigString});
+}
+assert.commandWorked(bulk.execute());
+
+// Alternate between large and small replies from the same command, so that each is built with a
+// reservation sized for the other.
+for (let i = 0; i < 10; i++) {
+    assert.eq(coll.find().batchSize(200).itcount(), 200);
+    assert.eq(coll.find({_id: i}).itcount(), 1);
+}
+
+assert.commandWorked(db.adminCommand({setParameter: 1, reserveReplyBytesFromRecentReplies: false}));
+assert.eq(coll.find().batchSize(200).itcount(), 200);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,82 @@
+/**
+ * Tests that a resumable index build checkpoints its collection scan position and sorter state
+ * when 'resumableIndexBuildCheckpointIntervalSecs' is set, and is resumed from the checkpoint
+ * after an unclean shutdown instead of being restarted from the beginning.
+ *
+ * @tags: [
+ *   requires_majority_read_concern,
+ *   requires_persistence,
+ *   requires_replication,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+load("jstests/noPassthrough/libs/index_build.js");
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {
+        setParameter: {
+            resumableIndexBuildCheckpointIntervalSecs: 1,
+            logComponentVerbosity: tojson({index: 1}),
+        }
+    }
+});
+rst.startSet();
+rst.initiate();
+
+let primary = rst.getPrimary();
+let coll = primary.getDB("test").getCollection(jsTestName());
+
+const numDocs = 10;
+for (let i = 0; i < numDocs; i++) {
+    assert.commandWorked(coll.insert({a: i}));
+}
+
+// Hold the collection scan for longer than the checkpoint interval after the fifth document, so
+// that the checkpoint taken once it continues records that document as the scan position.
+const afterFifth = configureFailPoint(primary,
+                                      "hangIndexBuildDuringCollectionScanPhaseAfterInsertion",
+                                      {fieldsToMatch: {a: 4}});
+const beforeEighth = configureFailPoint(primary,
+                                        "hangIndexBuildDuringCollectionScanPhaseBeforeInsertion",
+                                        {fieldsToMatch: {a: 7}});
+
+const awaitCreateIndex = IndexBuildTest.startIndexBuild(primary, coll.getFullName(), {a: 1});
+afterFifth.wait();
+sleep(2000);
+afterFifth.off();
+beforeEighth.wait();
+
+checkLog.containsJson(primary, 6107500, {
+    details: function(details) {
+        return details.phase === "collection scan";
+    }
+});
+
+// Take a checkpoint so that the checkpointed state is durable, then shut down uncleanly.
+assert.commandWorked(primary.adminCommand({fsync: 1}));
+rst.stop(primary, 9, {allowedExitCode: MongoRunner.EXIT_SIGKILL}, {forRestart: true});
+awaitCreateIndex({checkExitSuccess: false});
+
+rst.start(primary, {noCleanData: true});
+primary = rst.getPrimary();
+coll = primary.getDB("test").getCollection(jsTestName());
+
+checkLog.containsJson(primary, 4841700, {
+    details: function(details) {
+        return details.phase === "collection scan";
+    }
+});
+
+// Only the documents after the checkpointed scan position are scanned again.
+checkLog.containsJson(primary, 20391, {totalRecords: numDocs - 5});
+
+IndexBuildTest.waitForIndexBuildToStop(primary.getDB("test"));
+assert.soon(() => coll.getIndexes().length === 2, () => tojson(coll.getIndexes()));
+assert.commandWorked(coll.validate({full: true}));
+
+rst.stopSet();
+})();
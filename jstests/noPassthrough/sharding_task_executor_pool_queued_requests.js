@@ -0,0 +1,71 @@
+/**
+ * Tests that with ShardingTaskExecutorPoolQueuedRequestsBeforeGrowing set, requests from mongos
+ * wait for an in-use connection to the shard to be returned rather than each opening a new one,
+ * until more than that many requests are waiting.
+ *
+ * @tags: [requires_sharding]
+ */
+load("jstests/libs/fail_point_util.js");
+load("jstests/libs/parallelTester.js");
+
+(function() {
+"use strict";
+
+const kDbName = "test";
+const kQueuedRequestsBeforeGrowing = 3;
+
+const st = new ShardingTest({
+    mongos: 1,
+    shards: 1,
+    rs: {nodes: 1},
+    mongosOptions: {
+        setParameter: {
+            ShardingTaskExecutorPoolQueuedRequestsBeforeGrowing: kQueuedRequestsBeforeGrowing,
+            ShardingTaskExecutorPoolReplicaSetMatching: "disabled",
+        }
+    },
+});
+const mongos = st.s.getDB(kDbName);
+const primary = st.rs0.getPrimary();
+
+assert.commandWorked(mongos.test.insert({x: 1}));
+
+function inUseConnections() {
+    return mongos.adminCommand({connPoolStats: 1}).hosts[primary.host].inUse;
+}
+
+const threads = [];
+function launchFinds(times) {
+    for (let i = 0; i < times; i++) {
+        const thread = new Thread(function(connStr, dbName) {
+            const client = new Mongo(connStr);
+            assert.commandWorked(client.getDB(dbName).runCommand({find: "test", limit: 1}));
+        }, st.s.host, kDbName);
+        thread.start();
+        threads.push(thread);
+    }
+}
+
+const fp = configureFailPoint(primary,
+                              "waitInFindBeforeMakingBatch",
+                              {shouldCheckForInterrupt: true, nss: kDbName + ".test"});
+
+// The first request has no connection in use to wait for, so it gets its own.
+launchFinds(1);
+assert.soon(() => inUseConnections() == 1, () => tojson(mongos.adminCommand({connPoolStats: 1})));
+
+// Up to the configured number of requests wait for it to be returned.
+launchFinds(kQueuedRequestsBeforeGrowing);
+sleep(2000);
+assert.eq(1, inUseConnections(), () => tojson(mongos.adminCommand({connPoolStats: 1})));
+
+// Any further requests open new connections.
+launchFinds(2);
+assert.soon(() => inUseConnections() == 3, () => tojson(mongos.adminCommand({connPoolStats: 1})));
+
+// Once the shard unblocks, the waiting requests are served by the returned connections.
+fp.off();
+threads.forEach((thread) => thread.join());
+
+st.stop();
+})();
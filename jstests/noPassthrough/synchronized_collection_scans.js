@@ -0,0 +1,63 @@
+/**
+ * Tests that with 'internalQueryEnableSynchronizedCollectionScans' a collection scan which starts
+ * while another one is in progress joins it at its current position, wraps around to the
+ * beginning of the collection and still returns every document exactly once.
+ */
+(function() {
+"use strict";
+
+// Synchronized scans are only implemented by the classic engine's COLLSCAN stage.
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryEnableSynchronizedCollectionScans: true,
+        internalQueryEnableSlotBasedExecutionEngine: false
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("test");
+const coll = testDB.coll;
+
+const kNumDocs = 2000;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < kNumDocs; i++) {
+    bulk.insert({_id: i});
+}
+assert.commandWorked(bulk.execute());
+
+function assertReturnsEveryDocumentOnce(docs) {
+    assert.eq(kNumDocs, docs.length);
+    const ids = docs.map(doc => doc._id).sort((a, b) => a - b);
+    for (let i = 0; i < kNumDocs; i++) {
+        assert.eq(i, ids[i]);
+    }
+}
+
+// Without any other scan in progress, the scan starts at the beginning of the collection.
+assert.eq(0, coll.find().limit(1).next()._id);
+
+// Leave a scan in the middle of the collection.
+const leader = coll.find().batchSize(500);
+for (let i = 0; i < 500; i++) {
+    leader.next();
+}
+
+const follower = coll.find().toArray();
+assert.gt(follower[0]._id, 0, tojson(follower[0]));
+assertReturnsEveryDocumentOnce(follower);
+
+let rest = [];
+while (leader.hasNext()) {
+    rest.push(leader.next());
+}
+assert.eq(kNumDocs - 500, rest.length);
+
+// The scans are not synchronized when natural order is requested.
+leader.close();
+const natural = coll.find().batchSize(500);
+natural.next();
+assert.eq(0, coll.find().hint({$natural: 1}).limit(1).next()._id);
+natural.close();
+
+MongoRunner.stopMongod(conn);
+}());
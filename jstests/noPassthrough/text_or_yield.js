@@ -0,0 +1,41 @@
+/**
+ * Tests that a TEXT_OR stage, which fetches each document only after the scores of all of the
+ * candidates are known, returns correct scores and documents when it yields between every work
+ * cycle.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStages().
+
+const conn = MongoRunner.runMongod({});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("text_or_yield");
+const coll = testDB.coll;
+
+assert.commandWorked(coll.createIndex({a: 1, t: "text"}));
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 100; i++) {
+    bulk.insert({_id: i, a: i % 2, t: (i % 3 === 0 ? "apple banana" : "apple") + " cherry " + i});
+}
+assert.commandWorked(bulk.execute());
+
+const query = {a: 1, $text: {$search: "apple banana"}};
+const projection = {score: {$meta: "textScore"}};
+const expected = coll.find(query, projection).sort({_id: 1}).toArray();
+assert.eq(expected.length, 50, tojson(expected));
+
+assert.commandWorked(testDB.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 1}));
+
+assert.eq(coll.find(query, projection).sort({_id: 1}).toArray(), expected);
+
+const explain = coll.find(query, projection).explain("executionStats");
+const textOrStages = getPlanStages(explain.executionStats.executionStages, "TEXT_OR");
+assert.eq(textOrStages.length, 1, tojson(explain));
+// Each matching document is fetched exactly once, however many of the terms it contains.
+assert.eq(textOrStages[0].fetches, 50, tojson(explain));
+assert.gt(explain.executionStats.executionStages.saveState, 0, tojson(explain));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,68 @@
+/**
+ * Tests that idle time-series buckets expired due to memory pressure are reopened by later
+ * measurements which fit in them when 'timeseriesArchiveExpiredBuckets' is enabled.
+ *
+ * @tags: [
+ *   does_not_support_stepdowns,
+ * ]
+ */
+(function() {
+'use strict';
+
+load('jstests/core/timeseries/libs/timeseries.js');
+
+const conn = MongoRunner.runMongod({
+    setParameter:
+        {timeseriesIdleBucketExpiryMemoryUsageThreshold: 1, timeseriesArchiveExpiredBuckets: true}
+});
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog('Skipping test because the time-series collection feature flag is disabled');
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const testDB = conn.getDB(jsTestName());
+
+const coll = testDB.getCollection('t');
+const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+coll.drop();
+assert.commandWorked(testDB.createCollection(
+    coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+assert.contains(bucketsColl.getName(), testDB.getCollectionNames());
+
+// Use a fixed time, so that the earlier measurement below falls in the minute its bucket starts in.
+const time = ISODate('2021-06-01T00:00:30Z');
+const docs = [
+    {_id: 0, [timeFieldName]: time, [metaFieldName]: 0, x: 1},
+    {_id: 1, [timeFieldName]: time, [metaFieldName]: 1, x: 1},
+    {_id: 2, [timeFieldName]: new Date(time.getTime() + 1000), [metaFieldName]: 0, x: 0},
+    {_id: 3, [timeFieldName]: new Date(time.getTime() - 1000), [metaFieldName]: 1, x: 2},
+];
+
+// Each insert opens a bucket, which expires the bucket of the previous insert since the memory
+// usage threshold is so low.
+for (const doc of docs) {
+    assert.commandWorked(coll.insert(doc));
+}
+
+// The measurements fitting in the expired buckets were added to them, rather than to new buckets.
+assert.docEq(coll.find().sort({_id: 1}).toArray(), docs);
+const buckets = bucketsColl.find().sort({'control.min._id': 1}).toArray();
+assert.eq(buckets.length, 2, 'Expected two buckets but found: ' + tojson(buckets));
+assert.eq(buckets[0].control.min.x, 0, tojson(buckets));
+assert.eq(buckets[0].control.max.x, 1, tojson(buckets));
+assert.eq(buckets[1].control.max.x, 2, tojson(buckets));
+
+const stats = assert.commandWorked(coll.stats()).timeseries;
+assert.eq(stats.numBucketsOpenedDueToMetadata, 2, tojson(stats));
+assert.eq(stats.numBucketsReopened, 2, tojson(stats));
+assert.eq(stats.numBucketInserts, 2, tojson(stats));
+assert.eq(stats.numBucketUpdates, 2, tojson(stats));
+
+MongoRunner.stopMongod(conn);
+})();
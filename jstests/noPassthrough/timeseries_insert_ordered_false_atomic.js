@@ -0,0 +1,77 @@
+/**
+ * Tests that {ordered: false} time-series inserts can commit all of their buckets in a single
+ * storage transaction, and fall back to committing one bucket at a time when that fails.
+ */
+(function() {
+'use strict';
+
+load('jstests/core/timeseries/libs/timeseries.js');
+load('jstests/libs/fail_point_util.js');
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {timeseriesUnorderedInsertsCommitAtomically: true}});
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog('Skipping test because the time-series collection feature flag is disabled');
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const testDB = conn.getDB(jsTestName());
+
+const coll = testDB.getCollection('t');
+const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+coll.drop();
+assert.commandWorked(testDB.createCollection(
+    coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+assert.contains(bucketsColl.getName(), testDB.getCollectionNames());
+
+const docs = [
+    {_id: 0, [timeFieldName]: ISODate(), [metaFieldName]: 0},
+    {_id: 1, [timeFieldName]: ISODate(), [metaFieldName]: 1},
+    {_id: 2, [timeFieldName]: ISODate(), [metaFieldName]: 0},
+    {_id: 3, [timeFieldName]: ISODate(), [metaFieldName]: 1},
+    {_id: 4, [timeFieldName]: ISODate(), [metaFieldName]: 2},
+];
+
+// The per-bucket write path is not taken when the buckets are committed together.
+const unorderedFp = configureFailPoint(conn, 'failUnorderedTimeseriesInsert', {metadata: 0});
+assert.commandWorked(coll.insert(docs.slice(0, 2), {ordered: false}));
+assert.docEq(coll.find().sort({_id: 1}).toArray(), docs.slice(0, 2));
+assert.eq(bucketsColl.count(),
+          2,
+          'Expected two buckets but found: ' + tojson(bucketsColl.find().toArray()));
+
+// When the combined write fails, each bucket is retried on its own and errors are only reported
+// for the measurements of the buckets which failed again.
+const atomicFp = configureFailPoint(conn, 'failAtomicTimeseriesWrites');
+const res = assert.commandFailed(coll.insert(docs.slice(2), {ordered: false}));
+
+jsTestLog('Checking insert result: ' + tojson(res));
+assert.eq(res.nInserted, 2);
+assert.eq(res.getWriteErrors().length, 1);
+assert.eq(res.getWriteErrors()[0].index, 0);
+assert.docEq(res.getWriteErrors()[0].getOperation(), docs[2]);
+
+// The aborted batches cleared their buckets, so the retried measurements went into new buckets.
+assert.docEq(coll.find().sort({_id: 1}).toArray(), [docs[0], docs[1], docs[3], docs[4]]);
+assert.eq(bucketsColl.count(),
+          4,
+          'Expected four buckets but found: ' + tojson(bucketsColl.find().toArray()));
+
+atomicFp.off();
+unorderedFp.off();
+
+// The failed measurement goes into a new bucket, as its bucket was cleared by the failed write.
+assert.commandWorked(coll.insert(docs[2], {ordered: false}));
+assert.docEq(coll.find().sort({_id: 1}).toArray(), docs);
+assert.eq(bucketsColl.count(),
+          5,
+          'Expected five buckets but found: ' + tojson(bucketsColl.find().toArray()));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,75 @@
+/**
+ * Tests that with 'timeseriesReopenBucketsForLateMeasurements' enabled, measurements which do not
+ * fit in the open bucket for their series are added to an existing bucket which covers their time,
+ * when there is an index on the metaField and timeField to find it with.
+ *
+ * @tags: [
+ *   does_not_support_stepdowns,
+ * ]
+ */
+(function() {
+'use strict';
+
+load('jstests/core/timeseries/libs/timeseries.js');
+
+const conn =
+    MongoRunner.runMongod({setParameter: {timeseriesReopenBucketsForLateMeasurements: true}});
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog('Skipping test because the time-series collection feature flag is disabled');
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const testDB = conn.getDB(jsTestName());
+
+const coll = testDB.getCollection('t');
+const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+const start = ISODate('2021-06-01T00:00:00Z');
+const minutes = (n) => new Date(start.getTime() + n * 60 * 1000);
+
+// Measurements alternate between two time ranges which are more than the maximum span of a bucket
+// apart, as when a device backfills old data while also reporting new data.
+const docs = [
+    {_id: 0, [timeFieldName]: minutes(0), [metaFieldName]: 0},
+    {_id: 1, [timeFieldName]: minutes(180), [metaFieldName]: 0},
+    {_id: 2, [timeFieldName]: minutes(10), [metaFieldName]: 0},
+    {_id: 3, [timeFieldName]: minutes(181), [metaFieldName]: 0},
+    {_id: 4, [timeFieldName]: minutes(20), [metaFieldName]: 0},
+];
+
+const runTest = function(createIndex, expectedBuckets) {
+    coll.drop();
+    assert.commandWorked(testDB.createCollection(
+        coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+    assert.contains(bucketsColl.getName(), testDB.getCollectionNames());
+    if (createIndex) {
+        assert.commandWorked(coll.createIndex({[metaFieldName]: 1, [timeFieldName]: 1}));
+    }
+
+    for (const doc of docs) {
+        assert.commandWorked(coll.insert(doc));
+    }
+
+    assert.docEq(coll.find().sort({_id: 1}).toArray(), docs);
+    const buckets = bucketsColl.find().toArray();
+    assert.eq(buckets.length,
+              expectedBuckets,
+              'Expected ' + expectedBuckets + ' buckets but found: ' + tojson(buckets));
+
+    const stats = assert.commandWorked(coll.stats()).timeseries;
+    assert.eq(stats.numBucketsReopened, createIndex ? 3 : 0, tojson(stats));
+};
+
+// Without an index, each measurement has to open a new bucket.
+runTest(false, docs.length);
+
+// With an index, the measurements reopen the bucket for their time range.
+runTest(true, 2);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,64 @@
+/**
+ * Tests that indexes on measurement fields of time-series collections are converted into indexes
+ * on the bounds of the field in each bucket, and are used for range predicates on the field.
+ */
+(function() {
+'use strict';
+
+load('jstests/core/timeseries/libs/timeseries.js');
+load('jstests/libs/analyze_plan.js');
+
+const conn = MongoRunner.runMongod({setParameter: {featureFlagTimeseriesMetricIndexes: true}});
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog('Skipping test because the time-series collection feature flag is disabled');
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const testDB = conn.getDB(jsTestName());
+
+const coll = testDB.getCollection('t');
+const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+coll.drop();
+assert.commandWorked(testDB.createCollection(
+    coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+
+const docs = [];
+for (let i = 0; i < 10; ++i) {
+    docs.push({_id: i, [timeFieldName]: ISODate(), [metaFieldName]: i, temp: i * 10});
+}
+assert.commandWorked(coll.insert(docs));
+
+assert.commandWorked(coll.createIndex({temp: 1}, {name: 'temp_1'}));
+assert.commandWorked(coll.createIndex({[metaFieldName]: 1, temp: -1}, {name: 'meta_1_temp_-1'}));
+
+// The indexes are listed on the time-series collection as they were created.
+const indexKeys = coll.getIndexes().map(index => index.key);
+assert.contains({temp: 1}, indexKeys, tojson(indexKeys));
+assert.contains({[metaFieldName]: 1, temp: -1}, indexKeys, tojson(indexKeys));
+
+// Each index holds the maximum and minimum of the field, ordered by the direction of the index.
+const bucketsIndexKeys = bucketsColl.getIndexes().map(index => index.key);
+assert.contains({'control.max.temp': 1, 'control.min.temp': 1}, bucketsIndexKeys);
+assert.contains({meta: 1, 'control.min.temp': -1, 'control.max.temp': -1}, bucketsIndexKeys);
+
+// Range predicates on the field are answered from the index leading with its maximum.
+const query = coll.find({temp: {$gte: 70}});
+assert.eq(3, query.itcount());
+const ixscan = getAggPlanStage(query.explain(), 'IXSCAN');
+assert.neq(null, ixscan);
+assert.eq('temp_1', ixscan.indexName, tojson(ixscan));
+
+// Indexes on measurement fields must be ascending or descending.
+assert.commandFailedWithCode(coll.createIndex({temp: 'hashed'}), ErrorCodes.CannotCreateIndex);
+
+assert.commandWorked(coll.dropIndex({temp: 1}));
+assert.commandWorked(coll.dropIndex('meta_1_temp_-1'));
+
+MongoRunner.stopMongod(conn);
+})();
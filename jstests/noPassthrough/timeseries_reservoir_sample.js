@@ -0,0 +1,104 @@
+/**
+ * Tests that with 'internalQueryTimeseriesReservoirSample' enabled, a $sample on a time-series
+ * collection which is not served by sampling random buckets draws its sample in a single scan of
+ * the buckets, without unpacking every measurement.
+ * @tags: [
+ *     requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/timeseries/libs/timeseries.js");
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {timeseriesBucketMaxCount: 100, internalQueryTimeseriesReservoirSample: true}});
+
+// Although this test is tagged with 'requires_wiredtiger', this is not sufficient for ensuring
+// that the parallel suite runs this test only on WT configurations.
+if (jsTest.options().storageEngine && jsTest.options().storageEngine !== "wiredTiger") {
+    jsTest.log("Skipping test on non-WT storage engine: " + jsTest.options().storageEngine);
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const testDB = conn.getDB(jsTestName());
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(testDB.getMongo())) {
+    jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const nBuckets = 40;
+const timeFieldName = "time";
+const metaFieldName = "m";
+const coll = testDB.getCollection("t");
+
+const assertUniqueDocuments = function(docs) {
+    const seen = new Set();
+    docs.forEach(doc => {
+        assert(!seen.has(doc.x), docs);
+        seen.add(doc.x);
+    });
+};
+
+const fillBuckets = function(measurementsPerBucket) {
+    coll.drop();
+    assert.commandWorked(testDB.createCollection(
+        coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+
+    const numDocs = nBuckets * measurementsPerBucket;
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; i++) {
+        bulk.insert({[timeFieldName]: ISODate(), [metaFieldName]: i % nBuckets, x: i});
+    }
+    assert.commandWorked(bulk.execute());
+    return numDocs;
+};
+
+const assertReservoirSample = function(sampleSize, expectTrial) {
+    const explain = coll.explain("executionStats").aggregate([{$sample: {size: sampleSize}}]);
+    assert.eq(aggPlanHasStage(explain, "TRIAL"), expectTrial, explain);
+    assert(!aggPlanHasStage(explain, "$_internalUnpackBucket"), explain);
+    assert(!aggPlanHasStage(explain, "$sample"), explain);
+
+    const reservoirStage = getAggPlanStage(explain, "RESERVOIR_SAMPLE_FROM_TIMESERIES_BUCKET");
+    assert.neq(reservoirStage, null, explain);
+    assert.gte(reservoirStage.nMeasurementsExtracted, sampleSize, reservoirStage);
+    assert(reservoirStage.hasOwnProperty("nBucketsSkipped"), reservoirStage);
+};
+
+// With mostly full buckets, a sample of more than 1% of the maximum number of measurements in the
+// collection is drawn by reservoir sampling without a trial.
+let numDocs = fillBuckets(90);
+let sampleSize = nBuckets + 10;
+let result = coll.aggregate([{$sample: {size: sampleSize}}]).toArray();
+assert.eq(sampleSize, result.length, result);
+assertUniqueDocuments(result);
+assertReservoirSample(sampleSize, false);
+
+// A sample larger than the collection returns every measurement.
+result = coll.aggregate([{$sample: {size: numDocs + 1}}]).toArray();
+assert.eq(numDocs, result.length);
+assertUniqueDocuments(result);
+
+// Repeated small samples cover much of the collection.
+const seen = new Set();
+for (let i = 0; i < 50; i++) {
+    coll.aggregate([{$sample: {size: 200}}]).forEach(doc => seen.add(doc.x));
+}
+assert.gt(seen.size, numDocs / 2, seen.size);
+
+// With mostly empty buckets, the trial of sampling random buckets fails, and its backup plan draws
+// the sample by reservoir sampling.
+numDocs = fillBuckets(2);
+sampleSize = 20;
+result = coll.aggregate([{$sample: {size: sampleSize}}]).toArray();
+assert.eq(sampleSize, result.length, result);
+assertUniqueDocuments(result);
+assertReservoirSample(sampleSize, true);
+
+MongoRunner.stopMongod(conn);
+})();
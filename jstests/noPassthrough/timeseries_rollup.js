@@ -0,0 +1,99 @@
+/**
+ * Tests that a time-series collection created with a rollup adds the summary of each bucket it
+ * closes to the rollup collection.
+ *
+ * @tags: [
+ *   does_not_support_stepdowns,
+ * ]
+ */
+(function() {
+'use strict';
+
+load('jstests/core/timeseries/libs/timeseries.js');
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {featureFlagTimeseriesRollups: true, timeseriesBucketMaxCount: 2}});
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog('Skipping test because the time-series collection feature flag is disabled');
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const testDB = conn.getDB(jsTestName());
+
+const coll = testDB.getCollection('t');
+const rollupColl = testDB.getCollection('t_hourly');
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+const rollup = {
+    into: rollupColl.getName(),
+    granularity: 'hour',
+    accumulators: {lo: {$min: '$temp'}, hi: {$max: '$temp'}, n: {$sum: 1}},
+};
+
+const createWithRollup = function(accumulators, into = rollup.into) {
+    return testDB.createCollection(coll.getName(), {
+        timeseries: {
+            timeField: timeFieldName,
+            metaField: metaFieldName,
+            rollup: Object.assign({}, rollup, {into: into, accumulators: accumulators}),
+        }
+    });
+};
+
+// Invalid rollups are rejected.
+assert.commandFailedWithCode(createWithRollup({lo: {$avg: '$temp'}}), ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(createWithRollup({lo: {$min: '$meta'}}), ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(createWithRollup({}), ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(createWithRollup(rollup.accumulators, coll.getName()),
+                             ErrorCodes.InvalidOptions);
+
+assert.commandWorked(testDB.createCollection(
+    rollupColl.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+assert.commandWorked(createWithRollup(rollup.accumulators));
+
+const start = ISODate('2021-06-01T00:00:00Z');
+const minutes = (n) => new Date(start.getTime() + n * 60 * 1000);
+
+// With at most two measurements per bucket, the first two buckets are closed and rolled up, while
+// the last one is still open.
+const docs = [
+    {_id: 0, [timeFieldName]: minutes(0), [metaFieldName]: 'a', temp: 10},
+    {_id: 1, [timeFieldName]: minutes(10), [metaFieldName]: 'a', temp: 12},
+    {_id: 2, [timeFieldName]: minutes(20), [metaFieldName]: 'a', temp: 8},
+    {_id: 3, [timeFieldName]: minutes(70), [metaFieldName]: 'a', temp: 20},
+    {_id: 4, [timeFieldName]: minutes(80), [metaFieldName]: 'a', temp: 30},
+    {_id: 5, [timeFieldName]: minutes(90), [metaFieldName]: 'a', temp: 40},
+];
+for (const doc of docs) {
+    assert.commandWorked(coll.insert(doc));
+}
+assert.docEq(coll.find().sort({_id: 1}).toArray(), docs);
+
+// Combining the partial summaries of each hour gives the summary of its closed measurements.
+const summaries = rollupColl
+                      .aggregate([
+                          {
+                              $group: {
+                                  _id: {[timeFieldName]: '$' + timeFieldName},
+                                  lo: {$min: '$lo'},
+                                  hi: {$max: '$hi'},
+                                  n: {$sum: '$n'},
+                              }
+                          },
+                          {$sort: {_id: 1}},
+                      ])
+                      .toArray();
+assert.docEq(summaries,
+             [
+                 {_id: {[timeFieldName]: minutes(0)}, lo: 8, hi: 12, n: 3},
+                 {_id: {[timeFieldName]: minutes(60)}, lo: 20, hi: 20, n: 1},
+             ],
+             tojson(rollupColl.find().toArray()));
+assert.eq(rollupColl.find({[metaFieldName]: 'a'}).itcount(), 3);
+
+MongoRunner.stopMongod(conn);
+})();
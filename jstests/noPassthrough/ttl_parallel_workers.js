@@ -0,0 +1,57 @@
+/**
+ * Tests that the TTL monitor deletes the expired documents of many collections with several
+ * workers, as configured by 'ttlMonitorNumWorkers', and reports what it did on each TTL index in
+ * the 'ttlMonitor' serverStatus section.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {ttlMonitorSleepSecs: 1, ttlMonitorNumWorkers: 4, ttlMonitorWriteBatchSize: 8}});
+const db = conn.getDB("test");
+
+const nColls = 10;
+const nDocs = 50;
+const now = new Date();
+const past = new Date(now.getTime() - 60 * 60 * 1000);
+for (let i = 0; i < nColls; i++) {
+    const coll = db["coll" + i];
+    let bulk = coll.initializeUnorderedBulkOp();
+    for (let j = 0; j < nDocs; j++) {
+        bulk.insert({x: j % 2 == 0 ? past : now});
+    }
+    assert.commandWorked(bulk.execute());
+    assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 60}));
+}
+
+// Wait for a pass which started after the last index was created.
+const ttlPasses = db.serverStatus().metrics.ttl.passes;
+assert.soon(() => db.serverStatus().metrics.ttl.passes >= ttlPasses + 2);
+
+for (let i = 0; i < nColls; i++) {
+    assert.eq(db["coll" + i].find().itcount(), nDocs / 2, "coll" + i);
+}
+
+// Every index is reported, and the documents left have not expired.
+const status = assert.commandWorked(db.adminCommand({serverStatus: 1, ttlMonitor: 1})).ttlMonitor;
+assert.eq(status.numWorkers, 4, tojson(status));
+for (let i = 0; i < nColls; i++) {
+    const ns = db["coll" + i].getFullName();
+    const stats = status.indexes.find(stats => stats.ns == ns);
+    assert(stats, tojson(status));
+    assert.eq(stats.index, "x_1", tojson(stats));
+    assert.gte(stats.oldestRemainingAgeMillis, 0, tojson(stats));
+    assert.lt(stats.oldestRemainingAgeMillis, 60 * 1000, tojson(stats));
+}
+const deleted = status.indexes.reduce((total, stats) => total + stats.numDeleted, 0);
+assert.lte(deleted, nColls * nDocs / 2, tojson(status));
+
+// Dropped collections are no longer reported.
+assert(db.coll0.drop());
+assert.soon(() => {
+    const status = db.adminCommand({serverStatus: 1, ttlMonitor: 1}).ttlMonitor;
+    return !status.indexes.some(stats => stats.ns == db.coll0.getFullName());
+});
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,60 @@
+/**
+ * Tests that updates taking the fixed-width fast path enabled by
+ * 'internalQueryEnableFixedWidthUpdateFastPath' produce the same documents, indexes and oplog
+ * entries as the regular path.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest(
+    {nodes: 1, nodeOptions: {setParameter: {internalQueryEnableFixedWidthUpdateFastPath: true}}});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.coll;
+const oplog = primary.getDB("local").oplog.rs;
+
+assert.commandWorked(coll.createIndex({indexed: 1}));
+assert.commandWorked(coll.insert(
+    {_id: 0, n: NumberInt(1), l: NumberLong(1), flag: false, sub: {d: 1.5}, indexed: 1, s: "x"}));
+
+function lastUpdateOplogEntry() {
+    return oplog.find({op: "u", ns: coll.getFullName()}).sort({$natural: -1}).limit(1).next();
+}
+
+// Fixed-width changes of existing values. The fast path logs them in the order of the update.
+assert.commandWorked(
+    coll.update({_id: 0}, {$inc: {n: 1, l: NumberLong(2)}, $set: {flag: true, "sub.d": 2.5}}));
+assert.docEq(coll.findOne(), {
+    _id: 0,
+    n: NumberInt(2),
+    l: NumberLong(3),
+    flag: true,
+    sub: {d: 2.5},
+    indexed: 1,
+    s: "x"
+});
+const entry = lastUpdateOplogEntry();
+const expectedDiff = {u: {n: NumberInt(2), l: NumberLong(3), flag: true}, ssub: {u: {d: 2.5}}};
+assert.eq(entry.o, {$v: 2, diff: expectedDiff}, tojson(entry));
+
+// A no-op logs nothing.
+const opTime = entry.ts;
+assert.commandWorked(coll.update({_id: 0}, {$set: {flag: true}, $inc: {n: 0}}));
+assert.eq(lastUpdateOplogEntry().ts, opTime);
+
+// Updates the fast path cannot apply in place still go through the regular path.
+assert.commandWorked(coll.update({_id: 0}, {$inc: {n: 2147483647}}));
+assert.eq(coll.findOne().n, NumberLong(2147483649));
+assert.commandWorked(coll.update({_id: 0}, {$set: {missing: 1}}));
+assert.eq(coll.findOne().missing, 1);
+assert.commandWorked(coll.update({_id: 0}, {$inc: {indexed: 1}}));
+assert.eq(coll.find({indexed: 2}).hint({indexed: 1}).itcount(), 1);
+assert.eq(coll.find({indexed: 1}).hint({indexed: 1}).itcount(), 0);
+
+rst.stopSet();
+}());
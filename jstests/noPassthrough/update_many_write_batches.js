@@ -0,0 +1,61 @@
+/**
+ * Tests that multi-updates writing several documents per storage transaction, as enabled by
+ * 'internalQueryUpdateManyWriteBatchSize', update every matching document exactly once and log one
+ * oplog entry per document.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest(
+    {nodes: 1, nodeOptions: {setParameter: {internalQueryUpdateManyWriteBatchSize: 16}}});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.coll;
+const oplog = primary.getDB("local").oplog.rs;
+
+const nDocs = 250;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert({_id: i, a: i, b: i % 2});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function countUpdateOplogEntries() {
+    return oplog.find({op: "u", ns: coll.getFullName()}).itcount();
+}
+
+// Only the documents the filter matches are updated, and each of them has its own oplog entry.
+let res = assert.commandWorked(coll.updateMany({b: 1}, {$set: {c: 1}}));
+assert.eq(res.matchedCount, nDocs / 2, tojson(res));
+assert.eq(res.modifiedCount, nDocs / 2, tojson(res));
+assert.eq(coll.find({c: 1}).itcount(), nDocs / 2);
+assert.eq(countUpdateOplogEntries(), nDocs / 2);
+
+// Moving documents forward in the index they are scanned by must not update them twice.
+res = assert.commandWorked(coll.updateMany({a: {$gte: 0}}, {$inc: {a: nDocs}}, {hint: {a: 1}}));
+assert.eq(res.matchedCount, nDocs, tojson(res));
+assert.eq(res.modifiedCount, nDocs, tojson(res));
+assert.eq(coll.find({a: {$gte: nDocs}}).itcount(), nDocs);
+assert.eq(countUpdateOplogEntries(), nDocs / 2 + nDocs);
+
+// Documents which are already up to date are matched but not modified.
+res = assert.commandWorked(coll.updateMany({}, {$set: {b: 1}}));
+assert.eq(res.matchedCount, nDocs, tojson(res));
+assert.eq(res.modifiedCount, nDocs / 2, tojson(res));
+
+// Without batching, the same updates have the same results.
+assert.commandWorked(
+    primary.adminCommand({setParameter: 1, internalQueryUpdateManyWriteBatchSize: 1}));
+res = assert.commandWorked(coll.updateMany({a: {$gte: 0}}, {$inc: {a: -nDocs}}, {hint: {a: 1}}));
+assert.eq(res.matchedCount, nDocs, tojson(res));
+assert.eq(res.modifiedCount, nDocs, tojson(res));
+assert.eq(coll.find({a: {$lt: nDocs}}).itcount(), nDocs);
+
+rst.stopSet();
+})();
@@ -0,0 +1,45 @@
+/**
+ * Tests that with 'wiredTigerCacheUsageSampleIntervalSecs' set, the cache usage of collections and
+ * indexes is reported by $collStats with storageStats.cacheUsage and by serverStatus.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {wiredTigerCacheUsageSampleIntervalSecs: 1, wiredTigerCacheUsageTopIdents: 5}});
+const db = conn.getDB("test");
+const coll = db.coll;
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.insert(Array.from({length: 1000}, (_, i) => ({a: i}))));
+assert.eq(coll.find().itcount(), 1000);
+
+function cacheUsage() {
+    return coll.aggregate([{$collStats: {storageStats: {cacheUsage: true}}}])
+        .next()
+        .storageStats.cacheUsage;
+}
+
+assert.soon(() => {
+    const usage = cacheUsage();
+    return usage.collection.bytesInCache > 0 && usage.indexes.hasOwnProperty("a_1");
+}, () => tojson(cacheUsage()));
+
+let usage = cacheUsage();
+assert.gte(usage.collection.pagesRead, 0, tojson(usage));
+assert.gte(usage.collection.pagesEvicted, 0, tojson(usage));
+assert.gt(usage.indexes._id_.bytesInCache, 0, tojson(usage));
+
+// Without the option nothing is reported.
+assert(!coll.aggregate([{$collStats: {storageStats: {}}}]).next().storageStats.hasOwnProperty(
+    "cacheUsage"));
+
+const serverStatusUsage = db.serverStatus().wiredTiger.cacheUsage;
+assert(serverStatusUsage.hasOwnProperty("sampledAt"), tojson(serverStatusUsage));
+assert.gt(Object.keys(serverStatusUsage.idents).length, 0, tojson(serverStatusUsage));
+assert.lte(Object.keys(serverStatusUsage.idents).length, 5, tojson(serverStatusUsage));
+
+MongoRunner.stopMongod(conn);
+}());
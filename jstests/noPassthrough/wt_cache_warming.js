@@ -0,0 +1,51 @@
+/**
+ * Tests that the idents sampled as using the most cache are persisted and read back into the cache
+ * after a restart when 'wiredTigerCacheWarmingMBPerSec' is set, and that the progress of the
+ * warming is reported in serverStatus.
+ *
+ * @tags: [
+ *   requires_persistence,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+let conn = MongoRunner.runMongod({setParameter: {wiredTigerCacheUsageSampleIntervalSecs: 1}});
+assert.neq(null, conn, "mongod was unable to start up");
+const dbpath = conn.dbpath;
+
+let coll = conn.getDB("test").wt_cache_warming;
+const bigString = "x".repeat(1024);
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1024; i++) {
+    bulk.insert({_id: i, s: bigString});
+}
+assert.commandWorked(bulk.execute());
+
+// Wait for a sample that persisted the collection as using the cache.
+const ident = assert.commandWorked(coll.stats()).wiredTiger.uri.replace("statistics:table:", "");
+assert.soon(() => {
+    const hotIdents = _readDumpFile(dbpath + "/WiredTigerHotIdents.bson");
+    return hotIdents.length > 0 && hotIdents[0].idents.some(entry => entry.ident === ident);
+});
+assert.eq(assert.commandWorked(conn.adminCommand({serverStatus: 1})).wiredTiger.cacheWarming, {});
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod(
+    {dbpath, noCleanData: true, setParameter: {wiredTigerCacheWarmingMBPerSec: 100}});
+assert.neq(null, conn, "mongod was unable to restart");
+
+let warming;
+assert.soon(() => {
+    warming = assert.commandWorked(conn.adminCommand({serverStatus: 1})).wiredTiger.cacheWarming;
+    return warming.state === "completed";
+}, () => tojson(warming));
+assert.gt(warming.identsToWarm, 0, tojson(warming));
+assert.eq(warming.identsWarmed, warming.identsToWarm, tojson(warming));
+assert.gt(warming.bytesRead, 0, tojson(warming));
+
+coll = conn.getDB("test").wt_cache_warming;
+assert.eq(coll.find().itcount(), 1024);
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,49 @@
+/**
+ * Tests that unique indexes still reject duplicate keys when their key filters are enabled with
+ * 'wiredTigerUniqueIndexKeyFilterBitsPerKey', both for keys inserted since the index was built and
+ * for keys the filter is rebuilt from after a restart.
+ *
+ * @tags: [
+ *   requires_persistence,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+const options = {
+    setParameter: {
+        wiredTigerUniqueIndexKeyFilterBitsPerKey: 10,
+        logComponentVerbosity: tojson({storage: 1}),
+    }
+};
+let conn = MongoRunner.runMongod(options);
+let coll = conn.getDB("test").getCollection(jsTestName());
+
+assert.commandWorked(coll.insert([{a: 0}, {a: 1}]));
+assert.commandWorked(coll.createIndex({a: 1}, {unique: true}));
+assert.commandWorked(coll.createIndex({b: 1}, {unique: true, sparse: true}));
+
+// Keys added by the index build and by later inserts are both in the filter.
+assert.commandFailedWithCode(coll.insert({a: 0}), ErrorCodes.DuplicateKey);
+assert.commandWorked(coll.insert({a: 2, b: 2}));
+assert.commandFailedWithCode(coll.insert({a: 3, b: 2}), ErrorCodes.DuplicateKey);
+
+// A key that was removed may be inserted again.
+assert.commandWorked(coll.remove({a: 1}));
+assert.commandWorked(coll.insert({a: 1}));
+
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod(Object.assign({dbpath: conn.dbpath, noCleanData: true}, options));
+coll = conn.getDB("test").getCollection(jsTestName());
+
+checkLog.containsJson(conn, 6107700, {index: "a_1", numKeys: 3});
+for (let i = 0; i < 3; i++) {
+    assert.commandFailedWithCode(coll.insert({a: i}), ErrorCodes.DuplicateKey);
+}
+assert.commandFailedWithCode(coll.insert({a: 4, b: 2}), ErrorCodes.DuplicateKey);
+assert.commandWorked(coll.insert({a: 3, b: 3}));
+assert.eq(coll.find().itcount(), 4);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,90 @@
+/**
+ * Tests that a zstd dictionary trained with 'trainCompressionDictionary' can be used as the block
+ * compressor of a collection, that its statistics are reported in collStats, and that the
+ * dictionary is registered again when the server restarts.
+ *
+ * @tags: [
+ *   requires_persistence,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+let conn = MongoRunner.runMongod({});
+assert.neq(null, conn, "mongod was unable to start up");
+
+let testDB = conn.getDB("test");
+
+function makeEvent(i) {
+    return {
+        _id: i,
+        type: ["click", "view", "purchase"][i % 3],
+        user: "user-" + (i % 97),
+        session: "session-" + (i % 1013),
+        page: "/products/category-" + (i % 11) + "/item-" + (i % 353),
+        ts: new Date(1600000000000 + i * 1000),
+        agent: "Mozilla/5.0 (X11; Linux x86_64)",
+    };
+}
+
+let bulk = testDB.events.initializeUnorderedBulkOp();
+for (let i = 0; i < 5000; i++) {
+    bulk.insert(makeEvent(i));
+}
+assert.commandWorked(bulk.execute());
+
+const res = assert.commandWorked(testDB.runCommand(
+    {trainCompressionDictionary: "events", name: "events_v1", maxDictionaryBytes: 16 * 1024}));
+assert.eq(res.blockCompressor, "zstd_dict_events_v1", tojson(res));
+assert.eq(res.samples, 5000, tojson(res));
+assert.gt(res.dictionaryBytes, 0, tojson(res));
+assert.lte(res.dictionaryBytes, 16 * 1024, tojson(res));
+
+// Dictionaries are immutable, so a name can only be used once.
+assert.commandFailedWithCode(
+    testDB.runCommand({trainCompressionDictionary: "events", name: "events_v1"}),
+    ErrorCodes.NamespaceExists);
+assert.commandFailedWithCode(
+    testDB.runCommand({trainCompressionDictionary: "events", name: "events-v2"}),
+    ErrorCodes.BadValue);
+assert.commandFailedWithCode(
+    testDB.runCommand({trainCompressionDictionary: "missing", name: "missing_v1"}),
+    ErrorCodes.NamespaceNotFound);
+
+assert.commandWorked(testDB.createCollection(
+    "events_dict",
+    {storageEngine: {wiredTiger: {configString: "block_compressor=zstd_dict_events_v1"}}}));
+bulk = testDB.events_dict.initializeUnorderedBulkOp();
+for (let i = 0; i < 5000; i++) {
+    bulk.insert(makeEvent(i));
+}
+assert.commandWorked(bulk.execute());
+
+// A checkpoint writes, and so compresses, the collection's pages.
+assert.commandWorked(testDB.adminCommand({fsync: 1}));
+
+let stats = assert.commandWorked(testDB.events_dict.stats()).wiredTiger.zstdDictionary;
+assert.eq(stats.name, "events_v1", tojson(stats));
+assert.eq(stats.dictionaryBytes, res.dictionaryBytes, tojson(stats));
+assert.gt(stats.pagesCompressed, 0, tojson(stats));
+assert.gt(stats.compressionRatio, 1, tojson(stats));
+
+// Collections compressed without a dictionary do not report one.
+assert.eq(undefined, assert.commandWorked(testDB.events.stats()).wiredTiger.zstdDictionary);
+
+const expected = testDB.events.find().sort({_id: 1}).toArray();
+
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod({dbpath: conn.dbpath, noCleanData: true});
+assert.neq(null, conn, "mongod was unable to restart");
+testDB = conn.getDB("test");
+
+// Reading the collection back after the restart decompresses its pages with the dictionary.
+assert.eq(testDB.events_dict.find().sort({_id: 1}).toArray(), expected);
+stats = assert.commandWorked(testDB.events_dict.stats()).wiredTiger.zstdDictionary;
+assert.eq(stats.name, "events_v1", tojson(stats));
+assert.gt(stats.pagesDecompressed, 0, tojson(stats));
+
+MongoRunner.stopMongod(conn);
+}());
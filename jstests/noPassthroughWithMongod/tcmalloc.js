@@ -19,5 +19,18 @@ if (hasTcSetParameter()) {
     assert.commandWorked(db.adminCommand({setParameter: 1, tcmallocReleaseRate: 0}));
     assert.commandFailed(db.adminCommand({setParameter: 1, tcmallocReleaseRate: -1.0}));
     assert.commandFailed(db.adminCommand({setParameter: 1, tcmallocReleaseRate: "foo"}));
+
+    // The background release statistics are only reported while it is enabled.
+    const threshold = 64 * 1024 * 1024;
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, tcmallocBackgroundReleaseThresholdBytes: threshold}));
+    const stats = db.serverStatus().tcmalloc.tcmalloc.background_release;
+    assert.eq(stats.threshold_bytes, threshold, tojson(stats));
+    assert.gte(stats.num_releases, 0, tojson(stats));
+    assert.commandFailed(
+        db.adminCommand({setParameter: 1, tcmallocBackgroundReleaseThresholdBytes: -1}));
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, tcmallocBackgroundReleaseThresholdBytes: 0}));
+    assert.eq(db.serverStatus().tcmalloc.tcmalloc.background_release, undefined);
 }
 }());
\ No newline at end of file
@@ -101,6 +101,7 @@ const allCommands = {
         expectFailure: true,
         expectedErrorCode: ErrorCodes.NotPrimaryOrSecondary,
     },
+    analyze: {skip: isPrimaryOnly},
     appendOplogNote: {skip: isPrimaryOnly},
     applyOps: {skip: isPrimaryOnly},
     authenticate: {skip: isNotAUserDataRead},
@@ -326,6 +327,7 @@ const allCommands = {
     testVersions1And2: {skip: isNotAUserDataRead},
     testVersion2: {skip: isNotAUserDataRead},
     top: {skip: isNotAUserDataRead},
+    trainCompressionDictionary: {skip: isNotAUserDataRead},
     update: {skip: isPrimaryOnly},
     updateRole: {skip: isPrimaryOnly},
     updateUser: {skip: isPrimaryOnly},
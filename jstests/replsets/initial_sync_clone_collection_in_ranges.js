@@ -0,0 +1,61 @@
+/**
+ * Tests that with 'collectionClonerRangeCount' set, initial sync clones a collection in ranges of
+ * _id over concurrent connections, including _ids of different types and documents written while
+ * the collection is being cloned, and reports the ranges in replSetGetStatus.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const coll = primary.getDB(jsTestName()).getCollection("coll");
+
+const numDocs = 2000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, x: i});
+    bulk.insert({_id: "str" + i, x: i});
+    bulk.insert({_id: ObjectId(), x: i});
+}
+assert.commandWorked(bulk.execute());
+
+const secondary = rst.add({
+    rsConfig: {votes: 0, priority: 0},
+    setParameter: {
+        collectionClonerRangeCount: 4,
+        collectionClonerRangeMinBytes: 0,
+        collectionClonerBatchSize: 100,
+    }
+});
+const failPoint = configureFailPoint(secondary,
+                                     "initialSyncHangDuringCollectionClone",
+                                     {namespace: coll.getFullName(), numDocsToClone: 100});
+rst.reInitiate();
+failPoint.wait();
+
+const res = assert.commandWorked(secondary.adminCommand({replSetGetStatus: 1}));
+const collRes = res.initialSyncStatus.databases[jsTestName()][coll.getFullName()];
+assert.gt(collRes.ranges.length, 1, tojson(collRes));
+
+assert.commandWorked(coll.insert({_id: "late", x: -1}));
+assert.commandWorked(coll.update({_id: 0}, {$set: {x: -1}}));
+assert.commandWorked(coll.remove({_id: 1}));
+failPoint.off();
+
+rst.awaitSecondaryNodes();
+rst.awaitReplication();
+
+const secondaryColl = secondary.getDB(jsTestName()).getCollection("coll");
+assert.eq(secondaryColl.find().itcount(), 3 * numDocs);
+assert.docEq(secondaryColl.find({_id: 0}).toArray(), [{_id: 0, x: -1}]);
+assert.eq(secondaryColl.find({_id: "late"}).itcount(), 1);
+assert.eq(secondaryColl.find({_id: 1}).itcount(), 0);
+rst.checkReplicatedDataHashes();
+
+rst.stopSet();
+})();
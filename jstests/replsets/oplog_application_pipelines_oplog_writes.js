@@ -0,0 +1,57 @@
+/**
+ * Tests that with 'oplogApplicationPipelinesOplogWrites' enabled, a secondary writes the next batch
+ * to the oplog while applying the current one, and still ends up with the same data as the
+ * primary.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const rst = new ReplSetTest({
+    nodes: [
+        {},
+        {
+            rsConfig: {priority: 0},
+            setParameter: {oplogApplicationPipelinesOplogWrites: true, replBatchLimitOperations: 10}
+        },
+    ]
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const coll = primary.getDB(jsTestName()).getCollection("coll");
+
+assert.commandWorked(coll.insert({_id: -1}));
+rst.awaitReplication();
+
+const getApplyMetrics = () =>
+    assert.commandWorked(secondary.adminCommand({serverStatus: 1})).metrics.repl;
+
+// Let oplog entries pile up on the secondary, so that once application resumes there is always a
+// next batch ready while the current one is being applied.
+const numDocs = 1000;
+const failPoint = configureFailPoint(secondary, "rsSyncApplyStop");
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, x: i});
+}
+assert.commandWorked(bulk.execute());
+for (let i = 0; i < numDocs; i += 10) {
+    assert.commandWorked(coll.update({_id: i}, {$inc: {x: 1}}));
+}
+assert.soon(() => getApplyMetrics().buffer.count >= numDocs, tojson(getApplyMetrics()));
+failPoint.off();
+
+rst.awaitReplication();
+const metrics = getApplyMetrics();
+assert.gt(metrics.apply.pipelinedBatches, 0, tojson(metrics));
+
+const secondaryColl = secondary.getDB(jsTestName()).getCollection("coll");
+assert.eq(secondaryColl.find().itcount(), numDocs + 1);
+assert.docEq(secondaryColl.find({_id: 10}).toArray(), [{_id: 10, x: 11}]);
+
+rst.stopSet();
+})();
@@ -0,0 +1,58 @@
+/**
+ * Tests that with 'oplogApplicationReordersInserts' enabled, a secondary groups inserts into a
+ * collection into bulk inserts even when they are interleaved with updates on other documents, and
+ * still ends up with the same data as the primary.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const rst = new ReplSetTest({
+    nodes: [
+        {},
+        {
+            rsConfig: {priority: 0},
+            setParameter: {oplogApplicationReordersInserts: true, replWriterThreadCount: 1}
+        },
+    ]
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const coll = primary.getDB(jsTestName()).getCollection("coll");
+
+const numDocs = 100;
+for (let i = 0; i < numDocs; i++) {
+    assert.commandWorked(coll.insert({_id: -i - 1, x: 0}));
+}
+rst.awaitReplication();
+
+const getInsertGroupMetrics = () =>
+    assert.commandWorked(secondary.adminCommand({serverStatus: 1})).metrics.repl.apply.insertGroups;
+const metricsBefore = getInsertGroupMetrics();
+
+// Interleave each insert with an update on a document which is not inserted, so that no two
+// inserts are next to each other in the oplog.
+const failPoint = configureFailPoint(secondary, "rsSyncApplyStop");
+for (let i = 0; i < numDocs; i++) {
+    assert.commandWorked(coll.insert({_id: i, x: i}));
+    assert.commandWorked(coll.update({_id: -i - 1}, {$inc: {x: 1}}));
+}
+failPoint.off();
+rst.awaitReplication();
+
+const metricsAfter = getInsertGroupMetrics();
+const numGroups = metricsAfter.num - metricsBefore.num;
+const numGroupedOps = metricsAfter.ops - metricsBefore.ops;
+assert.gt(numGroups, 0, tojson(metricsAfter));
+assert.gte(numGroupedOps, numDocs / 2, tojson(metricsAfter));
+
+const secondaryColl = secondary.getDB(jsTestName()).getCollection("coll");
+assert.eq(secondaryColl.find().itcount(), 2 * numDocs);
+assert.eq(secondaryColl.find({x: 1, _id: {$lt: 0}}).itcount(), numDocs);
+
+rst.stopSet();
+})();
@@ -0,0 +1,47 @@
+/**
+ * Tests that the operations replayed during startup recovery are reported in the
+ * repl.recovery.oplogApplication serverStatus metrics.
+ *
+ * @tags: [requires_persistence]
+ */
+
+(function() {
+"use strict";
+
+const replTest = new ReplSetTest({nodes: 1});
+replTest.startSet();
+replTest.initiate();
+
+let primary = replTest.getPrimary();
+const testDB = primary.getDB("test");
+const testColl = testDB.getCollection("startup_recovery_oplog_application_metrics");
+
+const recoveryTimestamp =
+    assert.commandWorked(testColl.runCommand("insert", {documents: [{_id: 0}]})).operationTime;
+
+// Hold back the stable timestamp so that the inserts below are replayed during startup recovery.
+assert.commandWorked(testDB.adminCommand({
+    configureFailPoint: "holdStableTimestampAtSpecificTimestamp",
+    mode: "alwaysOn",
+    data: {timestamp: recoveryTimestamp}
+}));
+
+const numDocs = 100;
+for (let i = 1; i <= numDocs; i++) {
+    assert.commandWorked(testColl.insert({_id: i}));
+}
+
+jsTestLog("Restarting node");
+replTest.stop(primary, undefined, {skipValidation: true});
+replTest.start(primary, {}, true);
+primary = replTest.getPrimary();
+
+const metrics = assert.commandWorked(primary.adminCommand({serverStatus: 1}))
+                    .metrics.repl.recovery.oplogApplication;
+jsTestLog("Recovery oplog application metrics: " + tojson(metrics));
+assert.gte(metrics.ops, numDocs, metrics);
+assert.gte(metrics.batches, 1, metrics);
+assert.eq(numDocs + 1, primary.getDB("test").startup_recovery_oplog_application_metrics.count());
+
+replTest.stopSet();
+})();
@@ -904,6 +904,7 @@ const testCases = {
     startSession: {skip: isNotRunOnUserDatabase},
     stopRecordingTraffic: {skip: isNotRunOnUserDatabase},
     top: {skip: isNotRunOnUserDatabase},
+    trainCompressionDictionary: {skip: isNotWriteCommand},
     update: {
         testInTransaction: true,
         testAsRetryableWrite: true,
@@ -0,0 +1,68 @@
+/**
+ * Tests that when 'migrateCloneDeferSecondaryIndexBuilds' is enabled, a recipient shard cloning its
+ * first chunk of a collection builds the donor's secondary indexes after the initial clone, and
+ * ends up with the same indexes and documents as it would otherwise.
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, rs: {nodes: 2}});
+const dbName = "test";
+const collName = jsTest.name();
+const ns = dbName + "." + collName;
+const coll = st.s.getDB(dbName)[collName];
+const nDocs = 1000;
+
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+assert.commandWorked(st.s.adminCommand({shardCollection: ns, key: {x: 1}}));
+assert.commandWorked(st.s.adminCommand({split: ns, middle: {x: nDocs / 2}}));
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}, {sparse: true}));
+assert.commandWorked(coll.createIndex({x: 1, a: -1}));
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert(i % 3 ? {x: i, a: i % 10, b: i} : {x: i, a: i % 10});
+}
+assert.commandWorked(bulk.execute());
+
+const recipientPrimary = st.rs1.getPrimary();
+assert.commandWorked(
+    recipientPrimary.adminCommand({setParameter: 1, migrateCloneDeferSecondaryIndexBuilds: true}));
+
+assert.commandWorked(st.s.adminCommand(
+    {moveChunk: ns, find: {x: nDocs / 2}, to: st.shard1.shardName, _waitForDelete: true}));
+
+// The recipient started out without the collection, so the secondary indexes were built from the
+// cloned documents.
+checkLog.containsJson(recipientPrimary, 6104700, {indexes: 2});
+
+function getIndexKeys(conn) {
+    return conn.getDB(dbName)[collName]
+        .getIndexes()
+        .map(index => tojson(index.key))
+        .sort();
+}
+
+const donorIndexKeys = getIndexKeys(st.rs0.getPrimary());
+st.rs1.awaitReplication();
+for (let node of st.rs1.nodes) {
+    assert.eq(donorIndexKeys, getIndexKeys(node), "indexes differ on " + node.host);
+}
+
+const recipientColl = recipientPrimary.getDB(dbName)[collName];
+assert.eq(nDocs / 2, recipientColl.find().itcount());
+assert.eq(nDocs / 2 / 10, recipientColl.find({a: 3}).hint({a: 1}).itcount());
+assert.eq(nDocs, coll.find().itcount());
+
+// Once the recipient owns data for the collection, migrations no longer defer index builds.
+assert.commandWorked(st.s.adminCommand({split: ns, middle: {x: nDocs / 4}}));
+assert.commandWorked(st.s.adminCommand(
+    {moveChunk: ns, find: {x: 0}, to: st.shard1.shardName, _waitForDelete: true}));
+assert.eq(nDocs, coll.find().itcount());
+assert.eq(nDocs * 3 / 4, recipientColl.find().itcount());
+
+st.stop();
+})();
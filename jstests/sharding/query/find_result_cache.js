@@ -0,0 +1,74 @@
+/**
+ * Tests that mongos answers repeated find commands from its find result cache when
+ * 'internalQueryFindResultCacheMaxStalenessMS' is set, and that writes routed through the same
+ * mongos are observed by subsequent queries.
+ *
+ * @tags: [requires_sharding]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, mongos: 1});
+
+const mongosDB = st.s.getDB("test_db");
+const coll = mongosDB["coll"];
+
+st.shardColl(coll, {_id: 1}, {_id: 0}, {_id: 0}, mongosDB.getName());
+
+assert.commandWorked(coll.insert([{_id: -1, x: 1}, {_id: 1, x: 1}]));
+
+const shardDBs = [st.rs0, st.rs1].map(rs => rs.getPrimary().getDB(mongosDB.getName()));
+for (let shardDB of shardDBs) {
+    assert.commandWorked(shardDB.setProfilingLevel(2));
+}
+
+// Returns the number of find commands against the collection which reached the shards.
+function numShardQueries() {
+    return shardDBs
+        .map(shardDB =>
+                 shardDB.system.profile.find({ns: coll.getFullName(), op: "query"}).itcount())
+        .reduce((total, count) => total + count, 0);
+}
+
+function setMaxStalenessMS(maxStalenessMS) {
+    assert.commandWorked(st.s.adminCommand(
+        {setParameter: 1, internalQueryFindResultCacheMaxStalenessMS: maxStalenessMS}));
+}
+
+setMaxStalenessMS(10 * 60 * 1000);
+
+assert.eq(2, coll.find({x: 1}).itcount());
+
+// The same query is now answered without contacting the shards.
+let queriesBefore = numShardQueries();
+assert.eq(2, coll.find({x: 1}).itcount());
+assert.eq(queriesBefore, numShardQueries());
+
+// A different query is not.
+assert.eq(1, coll.find({x: 1, _id: 1}).itcount());
+assert.gt(numShardQueries(), queriesBefore);
+
+// A write through this mongos is visible to the next query.
+assert.commandWorked(coll.insert({_id: 2, x: 1}));
+assert.eq(3, coll.find({x: 1}).itcount());
+
+// Queries requiring majority read concern are never cached, so both of them reach both shards.
+queriesBefore = numShardQueries();
+assert.eq(3, coll.find({x: 1}).readConcern("majority").itcount());
+assert.eq(3, coll.find({x: 1}).readConcern("majority").itcount());
+assert.eq(queriesBefore + 2 * shardDBs.length, numShardQueries());
+
+// Results which need more than one batch are never cached.
+queriesBefore = numShardQueries();
+assert.eq(3, coll.find({x: 1}).batchSize(1).itcount());
+assert.eq(3, coll.find({x: 1}).batchSize(1).itcount());
+assert.eq(queriesBefore + 2 * shardDBs.length, numShardQueries());
+
+setMaxStalenessMS(0);
+
+queriesBefore = numShardQueries();
+assert.eq(3, coll.find({x: 1}).itcount());
+assert.gt(numShardQueries(), queriesBefore);
+
+st.stop();
+}());
@@ -0,0 +1,61 @@
+/**
+ * Tests that a sharded $group can be completed by exchanging its partial groups amongst the shards
+ * when 'internalQueryEnableGroupExchange' is set, and that it produces the same results as a
+ * $group merged on a single node.
+ *
+ * @tags: [requires_sharding]
+ */
+load('jstests/aggregation/extras/utils.js');  // For arrayEq.
+
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, rs: {nodes: 1}});
+
+const mongosDB = st.s.getDB("test_db");
+const coll = mongosDB["coll"];
+
+st.shardColl(coll, {a: 1}, {a: 500}, {a: 500}, mongosDB.getName());
+
+// Every group key appears on both shards, so that its partial groups have to meet on the same
+// consumer.
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({a: i, key: i % 50, val: 1});
+    bulk.insert({a: 999 - i, key: i % 50, val: 2});
+}
+assert.commandWorked(bulk.execute());
+
+const pipeline = [
+    {$group: {_id: "$key", total: {$sum: "$val"}, count: {$sum: 1}}},
+    {$match: {count: {$gt: 0}}},
+    {$project: {total: 1}}
+];
+
+function setGroupExchange(enabled) {
+    assert.commandWorked(
+        st.s.adminCommand({setParameter: 1, internalQueryEnableGroupExchange: enabled}));
+}
+
+const expected = coll.aggregate(pipeline).toArray();
+assert.eq(expected.length, 50, tojson(expected));
+
+setGroupExchange(true);
+
+const explain = coll.explain().aggregate(pipeline);
+assert.eq(explain.mergeType, "exchange", tojson(explain));
+assert.eq(explain.splitPipeline.exchange.policy, "keyRange", tojson(explain));
+assert.eq(explain.splitPipeline.exchange.key, {_id: "hashed"}, tojson(explain));
+assert.eq(explain.splitPipeline.exchange.consumers, 2, tojson(explain));
+
+assert(arrayEq(coll.aggregate(pipeline).toArray(), expected));
+
+// A $sort after the $group needs every group, so it is merged as before.
+const sortedPipeline = pipeline.concat([{$sort: {_id: 1}}]);
+assert.neq(coll.explain().aggregate(sortedPipeline).mergeType, "exchange");
+assert.eq(coll.aggregate(sortedPipeline).toArray(), expected.sort((l, r) => l._id - r._id));
+
+setGroupExchange(false);
+
+st.stop();
+}());
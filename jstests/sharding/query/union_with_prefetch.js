@@ -0,0 +1,73 @@
+/**
+ * Tests that $unionWith returns the same results when 'internalQueryUnionWithPrefetchSubPipeline'
+ * is set, so that the cursors for its sub-pipelines are established before its input has been
+ * consumed, and that prefetched cursors are cleaned up if the sub-pipeline is never read.
+ *
+ * @tags: [requires_sharding]
+ */
+load('jstests/aggregation/extras/utils.js');  // For arrayEq.
+
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, rs: {nodes: 1}});
+
+const mongosDB = st.s.getDB(jsTestName());
+assert.commandWorked(mongosDB.adminCommand({enableSharding: mongosDB.getName()}));
+st.ensurePrimaryShard(mongosDB.getName(), st.shard0.shardName);
+
+// One collection per month, of which the odd months are sharded.
+const numMonths = 6;
+const colls = [];
+for (let month = 0; month < numMonths; month++) {
+    const coll = mongosDB["month_" + month];
+    if (month % 2 === 1) {
+        st.shardColl(coll, {_id: 1}, {_id: month * 100 + 50}, {_id: month * 100 + 50});
+    }
+    const docs = [];
+    for (let i = 0; i < 100; i++) {
+        docs.push({_id: month * 100 + i, month: month, val: i});
+    }
+    assert.commandWorked(coll.insert(docs));
+    colls.push(coll);
+}
+
+const pipeline = [];
+for (let month = 1; month < numMonths; month++) {
+    pipeline.push(
+        {$unionWith: {coll: colls[month].getName(), pipeline: [{$match: {val: {$lt: 10}}}]}});
+}
+pipeline.unshift({$match: {val: {$lt: 10}}});
+
+function setPrefetch(enabled) {
+    assert.commandWorked(st.s.adminCommand(
+        {setParameter: 1, internalQueryUnionWithPrefetchSubPipeline: enabled}));
+    for (let rs of [st.rs0, st.rs1]) {
+        assert.commandWorked(rs.getPrimary().adminCommand(
+            {setParameter: 1, internalQueryUnionWithPrefetchSubPipeline: enabled}));
+    }
+}
+
+function assertNoOpenCursors() {
+    assert.soon(() => [st.rs0, st.rs1].every(
+                    rs => rs.getPrimary().getDB("admin").serverStatus().metrics.cursor.open.total ==
+                        0));
+}
+
+const expected = colls[0].aggregate(pipeline).toArray();
+assert.eq(expected.length, numMonths * 10, tojson(expected));
+
+setPrefetch(true);
+
+assert(arrayEq(colls[0].aggregate(pipeline).toArray(), expected));
+assert(arrayEq(colls[0].aggregate(pipeline, {cursor: {batchSize: 2}}).toArray(), expected));
+
+// A $limit which is satisfied by the first collection means that none of the sub-pipelines is read.
+const limited = colls[0].aggregate(pipeline.concat([{$limit: 5}])).toArray();
+assert.eq(limited.length, 5, tojson(limited));
+assertNoOpenCursors();
+
+setPrefetch(false);
+
+st.stop();
+}());
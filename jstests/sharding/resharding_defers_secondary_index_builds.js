@@ -0,0 +1,79 @@
+/**
+ * Tests that when 'reshardingRecipientDeferSecondaryIndexBuilds' is set, the recipient shards build
+ * the secondary indexes of the temporary resharding collection once cloning has finished, and that
+ * the resharded collection ends up with the same indexes as the source collection.
+ *
+ * @tags: [
+ *   requires_fcv_49,
+ *   uses_atclustertime,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/discover_topology.js");
+load("jstests/sharding/libs/resharding_test_fixture.js");
+
+const reshardingTest = new ReshardingTest({numDonors: 2, numRecipients: 2, reshardInPlace: true});
+
+reshardingTest.setup();
+
+const donorShardNames = reshardingTest.donorShardNames;
+const inputCollection = reshardingTest.createShardedCollection({
+    ns: "reshardingDb.coll",
+    shardKeyPattern: {oldKey: 1},
+    chunks: [
+        {min: {oldKey: MinKey}, max: {oldKey: 0}, shard: donorShardNames[0]},
+        {min: {oldKey: 0}, max: {oldKey: MaxKey}, shard: donorShardNames[1]},
+    ],
+});
+
+assert.commandWorked(inputCollection.createIndex({a: 1}));
+assert.commandWorked(inputCollection.createIndex({newKey: 1, a: 1}));
+
+const docs = [];
+for (let i = -50; i < 50; i++) {
+    docs.push({_id: i, oldKey: i, newKey: -i, a: i % 7});
+}
+assert.commandWorked(inputCollection.insert(docs));
+
+const mongos = inputCollection.getMongo();
+const topology = DiscoverTopology.findConnectedNodes(mongos);
+const recipientShardNames = reshardingTest.recipientShardNames;
+const recipients =
+    recipientShardNames.map(shardName => new Mongo(topology.shards[shardName].primary));
+
+for (let recipient of recipients) {
+    assert.commandWorked(recipient.adminCommand(
+        {setParameter: 1, reshardingRecipientDeferSecondaryIndexBuilds: true}));
+}
+
+reshardingTest.withReshardingInBackground({
+    newShardKeyPattern: {newKey: 1},
+    newChunks: [
+        {min: {newKey: MinKey}, max: {newKey: 0}, shard: recipientShardNames[0]},
+        {min: {newKey: 0}, max: {newKey: MaxKey}, shard: recipientShardNames[1]},
+    ],
+});
+
+// The {newKey: 1, a: 1} index can serve as the new shard key index, so only the {a: 1} and
+// {oldKey: 1} indexes were built after cloning.
+for (let recipient of recipients) {
+    checkLog.containsJson(recipient, 6104800, {indexes: 2});
+}
+
+const expectedIndexKeys = [{_id: 1}, {a: 1}, {newKey: 1, a: 1}, {oldKey: 1}];
+for (let recipient of recipients) {
+    const indexKeys = recipient.getCollection(inputCollection.getFullName())
+                          .getIndexes()
+                          .map(index => index.key)
+                          .sort((l, r) => bsonWoCompare(l, r));
+    assert.eq(expectedIndexKeys.sort((l, r) => bsonWoCompare(l, r)), indexKeys, recipient.host);
+}
+
+assert.eq(docs.length, inputCollection.find().itcount());
+assert.eq(docs.filter(doc => doc.a === 3).length,
+          inputCollection.find({a: 3}).hint({a: 1}).itcount());
+
+reshardingTest.teardown();
+})();
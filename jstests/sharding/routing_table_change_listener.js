@@ -0,0 +1,69 @@
+/**
+ * Tests that a mongos started with 'routingTableChangeListenerEnabled' refreshes the routing table
+ * of a collection it caches as soon as one of its chunks changes, so that its next request is
+ * routed with the new routing table instead of failing with StaleConfig first.
+ *
+ * @tags: [requires_sharding, uses_change_streams]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({
+    shards: 2,
+    mongos: 2,
+    other: {mongosOptions: {setParameter: {routingTableChangeListenerEnabled: true}}}
+});
+
+const dbName = "test";
+const collName = "foo";
+const ns = dbName + "." + collName;
+
+assert.commandWorked(st.s0.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+assert.commandWorked(st.s0.adminCommand({shardCollection: ns, key: {x: 1}}));
+
+let bulk = st.s0.getCollection(ns).initializeUnorderedBulkOp();
+for (let i = -100; i < 100; i++) {
+    bulk.insert({x: i});
+}
+assert.commandWorked(bulk.execute());
+
+// The second router caches the routing table, and only changes to cached routing tables are acted
+// upon.
+assert.eq(200, st.s1.getCollection(ns).find().itcount());
+
+const catalogCacheStats = () =>
+    assert.commandWorked(st.s1.adminCommand({serverStatus: 1})).shardingStatistics.catalogCache;
+
+// The change stream is opened in the background at startup, so split until the second router
+// hears of a split.
+let splitPoint = 0;
+assert.soon(() => {
+    assert.commandWorked(st.s0.adminCommand({split: ns, middle: {x: splitPoint++}}));
+    return catalogCacheStats().countRoutingTableChangeNotifications > 0;
+}, () => tojson(catalogCacheStats()));
+
+const waitForRefreshes = () => assert.soon(() => {
+    const stats = catalogCacheStats();
+    return stats.numActiveIncrementalRefreshes === 0 && stats.numActiveFullRefreshes === 0;
+}, () => tojson(catalogCacheStats()));
+waitForRefreshes();
+
+const before = catalogCacheStats();
+assert.commandWorked(st.s0.adminCommand(
+    {moveChunk: ns, find: {x: -50}, to: st.shard1.shardName, _waitForDelete: true}));
+
+assert.soon(
+    () => catalogCacheStats().countRefreshesStartedByNotification >
+        before.countRefreshesStartedByNotification,
+    () => tojson(catalogCacheStats()));
+waitForRefreshes();
+
+// The second router already knows where the moved chunk is.
+const staleConfigErrors = catalogCacheStats().countStaleConfigErrors;
+assert.eq(1, st.s1.getCollection(ns).find({x: -50}).itcount());
+assert.eq(200, st.s1.getCollection(ns).find().itcount());
+assert.eq(staleConfigErrors, catalogCacheStats().countStaleConfigErrors);
+
+st.stop();
+}());
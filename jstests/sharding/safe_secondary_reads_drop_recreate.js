@@ -317,6 +317,7 @@ let testCases = {
     testVersions1And2: {skip: "does not return user data"},
     testVersion2: {skip: "does not return user data"},
     top: {skip: "does not return user data"},
+    trainCompressionDictionary: {skip: "does not return user data"},
     update: {skip: "primary only"},
     updateRole: {skip: "primary only"},
     updateUser: {skip: "primary only"},
@@ -0,0 +1,63 @@
+/**
+ * Tests that splitVector chooses the split points of a chunk from a random sample of its documents
+ * when 'splitVectorSampleSize' is set, and that the split points are close to those found by
+ * scanning the shard key index.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 1, rs: {nodes: 1}, other: {enableAutoSplit: false}});
+
+const dbName = "test";
+const ns = dbName + ".coll";
+const coll = st.s.getDB(dbName).coll;
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+assert.commandWorked(st.s.adminCommand({shardCollection: ns, key: {x: 1}}));
+
+const numDocs = 20000;
+const bigString = "x".repeat(100);
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({x: i, s: bigString});
+}
+assert.commandWorked(bulk.execute());
+
+const shardPrimary = st.rs0.getPrimary();
+const shardAdmin = shardPrimary.getDB("admin");
+const avgObjSize = assert.commandWorked(coll.stats()).avgObjSize;
+// Each chunk should hold about a fifth of the documents.
+const splitVectorCmd = {
+    splitVector: ns,
+    keyPattern: {x: 1},
+    min: {x: MinKey},
+    max: {x: MaxKey},
+    maxChunkSizeBytes: avgObjSize * numDocs / 5 * 2
+};
+
+const scanned = assert.commandWorked(shardAdmin.runCommand(splitVectorCmd)).splitKeys;
+assert.gte(scanned.length, 4, tojson(scanned));
+assert.lte(scanned.length, 5, tojson(scanned));
+
+assert.commandWorked(shardAdmin.runCommand({setParameter: 1, splitVectorSampleSize: 2000}));
+const sampled = assert.commandWorked(shardAdmin.runCommand(splitVectorCmd)).splitKeys;
+checkLog.containsJson(shardPrimary, 6114502, {numSplits: sampled.length});
+
+// The sampled split points should be within a few percent of the documents of the scanned ones.
+assert.lte(Math.abs(sampled.length - scanned.length), 1, tojson({sampled, scanned}));
+for (let i = 0; i < Math.min(sampled.length, scanned.length); i++) {
+    assert.lt(Math.abs(sampled[i].x - scanned[i].x), numDocs / 10, tojson({sampled, scanned}));
+}
+
+// A forced split always scans the index.
+assert.commandWorked(shardAdmin.runCommand({
+    splitVector: ns,
+    keyPattern: {x: 1},
+    min: {x: MinKey},
+    max: {x: MaxKey},
+    force: true
+}));
+
+st.stop();
+}());
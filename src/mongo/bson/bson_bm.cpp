@@ -35,6 +35,7 @@
 
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -112,8 +113,64 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+void BM_validateFieldNames(benchmark::State& state) {
+    // Flat objects of small fixed-width values, where most of the work is finding the end of each
+    // field name.
+    const std::string prefix(state.range(0), 'f');
+    BSONObjBuilder builder;
+    for (int j = 0; j < 100; j++)
+        builder.append(fmt::format("{}{}", prefix, j), j);
+    BSONObj obj = builder.obj();
+    invariant(validateBSON(obj.objdata(), obj.objsize()).isOK());
+
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize()));
+        totalSize += obj.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
+void BM_fromjson(benchmark::State& state) {
+    BSONArrayBuilder builder;
+    for (auto j = 0; j < state.range(0); j++)
+        builder.append(buildSampleObj(j));
+    const std::string json = BSON("docs" << builder.arr()).jsonString();
+
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(fromjson(json));
+        totalSize += json.size();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
+void BM_jsonStringBuffer(benchmark::State& state) {
+    BSONArrayBuilder builder;
+    for (auto j = 0; j < state.range(0); j++)
+        builder.append(buildSampleObj(j));
+    BSONObj obj = BSON("docs" << builder.arr());
+
+    // Reuse one buffer across iterations, as the log and tooling writers do.
+    fmt::memory_buffer buffer;
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        buffer.clear();
+        obj.jsonStringBuffer(JsonStringFormat::ExtendedRelaxedV2_0_0, 0, false, buffer);
+        benchmark::DoNotOptimize(buffer.data());
+        totalSize += buffer.size();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateFieldNames)->Arg(1)->Arg(8)->Arg(32);
+BENCHMARK(BM_fromjson)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_jsonStringBuffer)->Ranges({{{1}, {1'000}}});
 
 }  // namespace mongo
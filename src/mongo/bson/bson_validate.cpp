@@ -36,6 +36,7 @@
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonelement.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 
 namespace mongo {
 namespace {
@@ -147,9 +148,18 @@ private:
         }
 
         size_t strlen() const {
-            // This is actually by far the hottest code in all of BSON validation.
+            // This is actually by far the hottest code in all of BSON validation, so look for the
+            // NUL a word at a time while a whole word fits before the end of the buffer.
             dassert(ptr < end);
             size_t len = 0;
+            for (; end - (ptr + len) >= 8; len += 8) {
+                auto word = ConstDataView(ptr + len).read<LittleEndian<uint64_t>>();
+                // The lowest bit set is the high bit of the first zero byte: bytes above it may be
+                // flagged spuriously, but never one below.
+                auto zeroes = (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+                if (zeroes)
+                    return len + countTrailingZerosNonZero64(zeroes) / 8;
+            }
             while (ptr[len])
                 ++len;
             return len;
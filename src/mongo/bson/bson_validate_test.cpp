@@ -431,4 +431,24 @@ TEST(BSONValidateFast, MaxNestingDepth) {
     Status status = validateBSON(tooDeepNesting.objdata(), tooDeepNesting.objsize());
     ASSERT_EQ(status.code(), ErrorCodes::Overflow);
 }
+
+TEST(BSONValidateFast, FieldNamesOfAllLengths) {
+    // Field names are scanned a word at a time, so cover names ending at every offset of a word
+    // and names ending close to the end of the buffer.
+    for (size_t nameLen = 0; nameLen < 40; nameLen++) {
+        const std::string name(nameLen, 'n');
+        BSONObj obj = BSON(name << 0x01010101 << "re" << BSONRegEx(name, name) << name << 1);
+        ASSERT_OK(validateBSON(obj.objdata(), obj.objsize()));
+
+        BSONObj last = BSON("a" << 1 << name << 0x01010101);
+        ASSERT_OK(validateBSON(last.objdata(), last.objsize()));
+
+        // Without its NUL, the last field name runs into the value and then the EOO byte.
+        BufBuilder buffer;
+        buffer.appendBuf(last.objdata(), last.objsize());
+        buffer.buf()[last.objsize() - 1 - sizeof(int32_t) - 1] = 'x';
+        BSONObj unterminated(buffer.buf());
+        ASSERT_NOT_OK(validateBSON(unterminated.objdata(), unterminated.objsize()));
+    }
+}
 }  // namespace
@@ -1331,6 +1331,16 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
                     // TODO: check for escaped control characters
             }
             ++q;
+        } else if (allowedSet == nullptr) {
+            // Append the whole run of characters that need no unescaping at once, rather than
+            // growing the result a byte at a time.
+            const char* runEnd = q + 1;
+            while (runEnd < _input_end && *runEnd != '\\' &&
+                   !(0x00 <= *runEnd && *runEnd <= 0x1F) && !match(*runEnd, terminalSet)) {
+                ++runEnd;
+            }
+            result->append(q, runEnd - q);
+            q = runEnd;
         } else {
             result->push_back(*q++);
         }
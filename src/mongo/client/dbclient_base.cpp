@@ -149,9 +149,13 @@ const rpc::ReplyMetadataReader& DBClientBase::getReplyMetadataReader() {
     return _metadataReader;
 }
 
+std::unique_ptr<rpc::ReplyInterface> DBClientBase::_parseReply(const Message& replyMsg) {
+    return rpc::makeReply(&replyMsg);
+}
+
 rpc::UniqueReply DBClientBase::parseCommandReplyMessage(const std::string& host,
                                                         const Message& replyMsg) {
-    auto commandReply = rpc::makeReply(&replyMsg);
+    auto commandReply = _parseReply(replyMsg);
 
     if (_metadataReader) {
         auto opCtx = haveClient() ? cc().getOperationContext() : nullptr;
@@ -812,6 +812,12 @@ protected:
 
     virtual void _auth(const BSONObj& params);
 
+    /**
+     * Parses a command reply message for parseCommandReplyMessage(). Clients whose replies are
+     * built in-process may override this to skip validating the reply's BSON.
+     */
+    virtual std::unique_ptr<rpc::ReplyInterface> _parseReply(const Message& replyMsg);
+
     // should be set by subclasses during connection.
     void _setServerRPCProtocols(rpc::ProtocolSet serverProtocols);
 
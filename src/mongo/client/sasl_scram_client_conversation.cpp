@@ -38,10 +38,19 @@
 #include "mongo/platform/random.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/password_digest.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/str.h"
+#include "mongo/util/synchronized_value.h"
 #include "mongo/util/text.h"
 
 namespace mongo {
+namespace {
+
+// Shared by all conversations, so that each new connection does not allocate and fill a page of
+// entropy from the OS for its 24-byte nonce.
+StaticImmortal<synchronized_value<SecureRandom>> nonceGen;
+
+}  // namespace
 
 using std::string;
 using std::unique_ptr;
@@ -85,7 +94,7 @@ StatusWith<bool> SaslSCRAMClientConversation::_firstStep(std::string* outputData
     static constexpr size_t nonceLenQWords = 3;
     uint64_t binaryNonce[nonceLenQWords];
 
-    SecureRandom().fill(binaryNonce, sizeof(binaryNonce));
+    (*nonceGen)->fill(binaryNonce, sizeof(binaryNonce));
 
     std::string user =
         _saslClientSession->getParameter(SaslClientSession::parameterUser).toString();
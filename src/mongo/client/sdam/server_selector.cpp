@@ -142,10 +142,67 @@ void SdamServerSelector::_getCandidateServers(std::vector<ServerDescriptionPtr>*
     }
 }
 
+namespace {
+// Whether 'tagSet' keeps every server, as both [] and the default [{}] do.
+bool matchesAllServers(const TagSet& tagSet) {
+    const auto& tags = tagSet.getTagBSON();
+    if (tags.isEmpty()) {
+        return true;
+    }
+    const auto first = tags.firstElement();
+    return tags.nFields() == 1 && first.isABSONObj() && first.Obj().isEmpty();
+}
+}  // namespace
+
 boost::optional<std::vector<ServerDescriptionPtr>> SdamServerSelector::selectServers(
     const TopologyDescriptionPtr topologyDescription,
     const ReadPreferenceSetting& criteria,
     const std::vector<HostAndPort>& excludedHosts) {
+    if (const auto* candidates =
+            _findPrecomputedCandidates(topologyDescription, criteria, excludedHosts)) {
+        if (!*candidates) {
+            return boost::none;
+        }
+        auto results = **candidates;
+        std::shuffle(std::begin(results), std::end(results), _random.urbg());
+        return results;
+    }
+    return _selectServers(topologyDescription, criteria, excludedHosts);
+}
+
+void SdamServerSelector::precomputeCandidates(const TopologyDescriptionPtr& topologyDescription) {
+    // An incompatible topology makes selection throw, and the fail point leaves the latency window
+    // out; neither outcome may be stored for later selections.
+    if (!topologyDescription->isWireVersionCompatible() ||
+        MONGO_unlikely(sdamServerSelectorIgnoreLatencyWindow.shouldFail())) {
+        return;
+    }
+
+    TopologyDescription::CandidatesByReadPreference candidates;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        candidates[i] = _selectServers(
+            topologyDescription, ReadPreferenceSetting(static_cast<ReadPreference>(i)), {});
+    }
+    topologyDescription->setPrecomputedCandidates(std::move(candidates));
+}
+
+const boost::optional<std::vector<ServerDescriptionPtr>>*
+SdamServerSelector::_findPrecomputedCandidates(const TopologyDescriptionPtr& topologyDescription,
+                                               const ReadPreferenceSetting& criteria,
+                                               const std::vector<HostAndPort>& excludedHosts) {
+    const auto* candidates = topologyDescription->getPrecomputedCandidates();
+    if (!candidates || !excludedHosts.empty() || criteria.maxStalenessSeconds.count() ||
+        !criteria.minClusterTime.isNull() || !matchesAllServers(criteria.tags) ||
+        MONGO_unlikely(sdamServerSelectorIgnoreLatencyWindow.shouldFail())) {
+        return nullptr;
+    }
+    return &(*candidates)[static_cast<size_t>(criteria.pref)];
+}
+
+boost::optional<std::vector<ServerDescriptionPtr>> SdamServerSelector::_selectServers(
+    const TopologyDescriptionPtr& topologyDescription,
+    const ReadPreferenceSetting& criteria,
+    const std::vector<HostAndPort>& excludedHosts) {
     ReadPreferenceSetting effectiveCriteria = [&criteria](TopologyType topologyType) {
         if (topologyType != TopologyType::kSharded) {
             return criteria;
@@ -211,6 +268,11 @@ boost::optional<ServerDescriptionPtr> SdamServerSelector::selectServer(
     const TopologyDescriptionPtr topologyDescription,
     const ReadPreferenceSetting& criteria,
     const std::vector<HostAndPort>& excludedHosts) {
+    if (const auto* candidates =
+            _findPrecomputedCandidates(topologyDescription, criteria, excludedHosts)) {
+        return *candidates ? boost::optional<ServerDescriptionPtr>(_randomSelect(**candidates))
+                           : boost::none;
+    }
     auto servers = selectServers(topologyDescription, criteria, excludedHosts);
     return servers ? boost::optional<ServerDescriptionPtr>(_randomSelect(*servers)) : boost::none;
 }
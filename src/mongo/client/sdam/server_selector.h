@@ -82,7 +82,29 @@ public:
     // remove servers that do not match the TagSet
     void filterTags(std::vector<ServerDescriptionPtr>* servers, const TagSet& tagSet);
 
+    /**
+     * Computes the candidates of every read preference mode without tags, maxStalenessSeconds or
+     * minClusterTime and stores them in 'topologyDescription', so that selecting with such a read
+     * preference and no excluded hosts only has to pick among them. Must be called before
+     * 'topologyDescription' is published to other threads.
+     */
+    void precomputeCandidates(const TopologyDescriptionPtr& topologyDescription);
+
 private:
+    boost::optional<std::vector<ServerDescriptionPtr>> _selectServers(
+        const TopologyDescriptionPtr& topologyDescription,
+        const ReadPreferenceSetting& criteria,
+        const std::vector<HostAndPort>& excludedHosts);
+
+    /**
+     * Returns the candidates precomputed in 'topologyDescription' for 'criteria', or nullptr if
+     * they cannot be used and the servers have to be filtered.
+     */
+    const boost::optional<std::vector<ServerDescriptionPtr>>* _findPrecomputedCandidates(
+        const TopologyDescriptionPtr& topologyDescription,
+        const ReadPreferenceSetting& criteria,
+        const std::vector<HostAndPort>& excludedHosts);
+
     void _getCandidateServers(std::vector<ServerDescriptionPtr>* result,
                               const TopologyDescriptionPtr topologyDescription,
                               const ReadPreferenceSetting& criteria,
@@ -295,6 +295,70 @@ TEST_F(ServerSelectorTestFixture, ShouldSelectRandomlyWhenMultipleOptionsAreAvai
     ASSERT_FALSE(frequencyInfo[HostAndPort("s3")]);
 }
 
+TEST_F(ServerSelectorTestFixture, ShouldSelectFromPrecomputedCandidates) {
+    TopologyStateMachine stateMachine(sdamConfiguration);
+    auto topologyDescription = std::make_shared<TopologyDescription>(sdamConfiguration);
+    auto primary = ServerDescriptionBuilder()
+                       .withAddress(HostAndPort("s0"))
+                       .withType(ServerType::kRSPrimary)
+                       .withLastUpdateTime(Date_t::now())
+                       .withLastWriteDate(Date_t::now())
+                       .withRtt(Milliseconds{1})
+                       .withSetName("set")
+                       .withHost(HostAndPort("s0"))
+                       .withHost(HostAndPort("s1"))
+                       .withHost(HostAndPort("s2"))
+                       .withMinWireVersion(WireVersion::SUPPORTS_OP_MSG)
+                       .withMaxWireVersion(WireVersion::LATEST_WIRE_VERSION)
+                       .instance();
+    stateMachine.onServerDescription(*topologyDescription, primary);
+    stateMachine.onServerDescription(
+        *topologyDescription,
+        make_with_latency(Milliseconds{1}, HostAndPort("s1"), ServerType::kRSSecondary));
+    const auto tooFar = Milliseconds{1} + sdamConfiguration.getLocalThreshold() + Milliseconds{10};
+    stateMachine.onServerDescription(
+        *topologyDescription,
+        make_with_latency(tooFar, HostAndPort("s2"), ServerType::kRSSecondary));
+
+    const auto sortedHosts = [](const boost::optional<std::vector<ServerDescriptionPtr>>& servers) {
+        std::vector<HostAndPort> hosts;
+        for (const auto& server : *servers) {
+            hosts.push_back(server->getAddress());
+        }
+        std::sort(hosts.begin(), hosts.end());
+        return hosts;
+    };
+
+    std::vector<std::vector<HostAndPort>> expected;
+    for (size_t i = 0; i < kNumReadPreferenceEnum; ++i) {
+        expected.push_back(sortedHosts(selector.selectServers(
+            topologyDescription, ReadPreferenceSetting(static_cast<ReadPreference>(i)))));
+    }
+
+    ASSERT(!topologyDescription->getPrecomputedCandidates());
+    selector.precomputeCandidates(topologyDescription);
+    ASSERT(topologyDescription->getPrecomputedCandidates());
+
+    for (size_t i = 0; i < kNumReadPreferenceEnum; ++i) {
+        const auto readPref = ReadPreferenceSetting(static_cast<ReadPreference>(i));
+        ASSERT(expected[i] == sortedHosts(selector.selectServers(topologyDescription, readPref)));
+        auto server = selector.selectServer(topologyDescription, readPref);
+        ASSERT(server);
+        ASSERT(std::find(expected[i].begin(), expected[i].end(), (*server)->getAddress()) !=
+               expected[i].end());
+    }
+
+    // Excluded hosts still filter the servers.
+    auto result = selector.selectServers(topologyDescription,
+                                         ReadPreferenceSetting(ReadPreference::Nearest),
+                                         {HostAndPort("s0")});
+    ASSERT(result);
+    ASSERT(sortedHosts(result) == std::vector<HostAndPort>{HostAndPort("s1")});
+
+    // A clone does not carry the candidates of its source.
+    ASSERT(!TopologyDescription::clone(topologyDescription)->getPrecomputedCandidates());
+}
+
 TEST_F(ServerSelectorTestFixture, ShouldNotSelectExcludedHostsNearest) {
     TopologyStateMachine stateMachine(sdamConfiguration);
     auto topologyDescription = std::make_shared<TopologyDescription>(sdamConfiguration);
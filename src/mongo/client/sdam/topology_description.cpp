@@ -57,6 +57,7 @@ TopologyDescriptionPtr TopologyDescription::create(SdamConfiguration config) {
 TopologyDescriptionPtr TopologyDescription::clone(TopologyDescriptionPtr source) {
     invariant(source);
     auto result = std::make_shared<TopologyDescription>(*source);
+    result->_precomputedCandidates.reset();
     TopologyDescription::associateServerDescriptions(result);
     return result;
 }
@@ -99,6 +100,7 @@ const boost::optional<int>& TopologyDescription::getLogicalSessionTimeoutMinutes
 
 void TopologyDescription::setType(TopologyType type) {
     _type = type;
+    _precomputedCandidates.reset();
 }
 
 bool TopologyDescription::containsServerAddress(const HostAndPort& address) const {
@@ -122,6 +124,7 @@ const boost::optional<ServerDescriptionPtr> TopologyDescription::findServerByAdd
 
 boost::optional<ServerDescriptionPtr> TopologyDescription::installServerDescription(
     const ServerDescriptionPtr& newServerDescription) {
+    _precomputedCandidates.reset();
     boost::optional<ServerDescriptionPtr> previousDescription;
     if (getType() == TopologyType::kSingle) {
         // For Single, there is always one ServerDescription in TopologyDescription.servers;
@@ -160,9 +163,19 @@ void TopologyDescription::removeServerDescription(const HostAndPort& HostAndPort
         });
     if (it != _servers.end()) {
         _servers.erase(it);
+        _precomputedCandidates.reset();
     }
 }
 
+const TopologyDescription::CandidatesByReadPreference*
+TopologyDescription::getPrecomputedCandidates() const {
+    return _precomputedCandidates ? &*_precomputedCandidates : nullptr;
+}
+
+void TopologyDescription::setPrecomputedCandidates(CandidatesByReadPreference candidates) {
+    _precomputedCandidates = std::move(candidates);
+}
+
 void TopologyDescription::checkWireCompatibilityVersions() {
     const WireVersionInfo supportedWireVersion = {BATCH_COMMANDS, LATEST_WIRE_VERSION};
     std::ostringstream errorOss;
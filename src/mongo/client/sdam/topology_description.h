@@ -28,6 +28,7 @@
  */
 
 #pragma once
+#include <array>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -84,6 +85,25 @@ public:
         std::function<bool(const ServerDescriptionPtr&)> predicate) const;
     boost::optional<ServerDescriptionPtr> getPrimary();
 
+    /**
+     * The servers eligible for each read preference mode when no tags, maxStalenessSeconds or
+     * minClusterTime are given, already narrowed down to the latency window. boost::none means
+     * that no server is eligible for that mode.
+     */
+    using CandidatesByReadPreference =
+        std::array<boost::optional<std::vector<ServerDescriptionPtr>>, kNumReadPreferenceEnum>;
+
+    /**
+     * Returns the candidates stored by setPrecomputedCandidates(), or nullptr if there are none.
+     */
+    const CandidatesByReadPreference* getPrecomputedCandidates() const;
+
+    /**
+     * Stores the candidates computed from this description. This must be the last change made to
+     * the description before it is published; any later change, and clone(), discards them.
+     */
+    void setPrecomputedCandidates(CandidatesByReadPreference candidates);
+
     /**
      * Adds the given ServerDescription or swaps it with an existing one
      * using the description's HostAndPort as the lookup key. If present, the previous server
@@ -178,6 +198,9 @@ private:
     // logicalSessionTimeoutMinutes: integer or null. Default null.
     boost::optional<int> _logicalSessionTimeoutMinutes;
 
+    // Server selection candidates computed just before this description was published.
+    boost::optional<CandidatesByReadPreference> _precomputedCandidates;
+
     friend class TopologyStateMachine;
     friend class TopologyDescriptionBuilder;
 };
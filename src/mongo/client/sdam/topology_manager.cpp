@@ -68,8 +68,11 @@ TopologyManagerImpl::TopologyManagerImpl(SdamConfiguration config,
     : _config(std::move(config)),
       _clockSource(clockSource),
       _topologyDescription(TopologyDescription::create(_config)),
+      _candidateSelector(_config),
       _topologyStateMachine(std::make_unique<TopologyStateMachine>(_config)),
-      _topologyEventsPublisher(eventsPublisher) {}
+      _topologyEventsPublisher(eventsPublisher) {
+    _candidateSelector.precomputeCandidates(_topologyDescription);
+}
 
 bool TopologyManagerImpl::onServerDescription(const HelloOutcome& helloOutcome) {
     stdx::lock_guard<mongo::Mutex> lock(_mutex);
@@ -100,25 +103,25 @@ bool TopologyManagerImpl::onServerDescription(const HelloOutcome& helloOutcome)
         _clockSource, helloOutcome, lastRTT, newTopologyVersion);
 
     auto oldTopologyDescription = _topologyDescription;
-    _topologyDescription = TopologyDescription::clone(oldTopologyDescription);
+    auto newTopologyDescription = TopologyDescription::clone(oldTopologyDescription);
 
     // if we are equal to the old description, just install the new description without
     // performing any actions on the state machine.
     auto isEqualToOldServerDescription =
         (lastServerDescription && (*lastServerDescription->get()) == *newServerDescription);
     if (isEqualToOldServerDescription) {
-        _topologyDescription->installServerDescription(newServerDescription);
+        newTopologyDescription->installServerDescription(newServerDescription);
     } else {
-        _topologyStateMachine->onServerDescription(*_topologyDescription, newServerDescription);
+        _topologyStateMachine->onServerDescription(*newTopologyDescription, newServerDescription);
     }
 
-    _publishTopologyDescriptionChanged(oldTopologyDescription, _topologyDescription);
+    _installTopologyDescription(lock, newTopologyDescription);
+    _publishTopologyDescriptionChanged(oldTopologyDescription, newTopologyDescription);
     return true;
 }
 
 const std::shared_ptr<TopologyDescription> TopologyManagerImpl::getTopologyDescription() const {
-    stdx::lock_guard<mongo::Mutex> lock(_mutex);
-    return _topologyDescription;
+    return atomic_load(&_topologyDescription);
 }
 
 void TopologyManagerImpl::onServerRTTUpdated(HostAndPort hostAndPort, HelloRTT rtt) {
@@ -130,10 +133,11 @@ void TopologyManagerImpl::onServerRTTUpdated(HostAndPort hostAndPort, HelloRTT r
             auto newServerDescription = (*oldServerDescription)->cloneWithRTT(rtt);
 
             auto oldTopologyDescription = _topologyDescription;
-            _topologyDescription = TopologyDescription::clone(oldTopologyDescription);
-            _topologyDescription->installServerDescription(newServerDescription);
+            auto newTopologyDescription = TopologyDescription::clone(oldTopologyDescription);
+            newTopologyDescription->installServerDescription(newServerDescription);
 
-            _publishTopologyDescriptionChanged(oldTopologyDescription, _topologyDescription);
+            _installTopologyDescription(lock, newTopologyDescription);
+            _publishTopologyDescriptionChanged(oldTopologyDescription, newTopologyDescription);
 
             return;
         }
@@ -152,6 +156,12 @@ SemiFuture<std::vector<HostAndPort>> TopologyManagerImpl::executeWithLock(
     return func(_topologyDescription);
 }
 
+void TopologyManagerImpl::_installTopologyDescription(
+    WithLock, TopologyDescriptionPtr newTopologyDescription) {
+    _candidateSelector.precomputeCandidates(newTopologyDescription);
+    atomic_store(&_topologyDescription, std::move(newTopologyDescription));
+}
+
 void TopologyManagerImpl::_publishTopologyDescriptionChanged(
     const TopologyDescriptionPtr& oldTopologyDescription,
     const TopologyDescriptionPtr& newTopologyDescription) const {
@@ -30,9 +30,11 @@
 #include <memory>
 
 #include "mongo/client/sdam/sdam_datatypes.h"
+#include "mongo/client/sdam/server_selector.h"
 #include "mongo/client/sdam/topology_description.h"
 #include "mongo/client/sdam/topology_listener.h"
 #include "mongo/client/sdam/topology_state_machine.h"
+#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo::sdam {
 
@@ -90,7 +92,8 @@ public:
     void onServerRTTUpdated(HostAndPort hostAndPort, HelloRTT rtt) override;
 
     /**
-     * Get the current TopologyDescription. This is safe to call from multiple threads.
+     * Get the current TopologyDescription. This is safe to call from multiple threads, and does
+     * not take the mutex: each published description is immutable and swapped in atomically.
      */
     const TopologyDescriptionPtr getTopologyDescription() const override;
 
@@ -106,10 +109,18 @@ private:
         const TopologyDescriptionPtr& oldTopologyDescription,
         const TopologyDescriptionPtr& newTopologyDescription) const;
 
+    /**
+     * Precomputes the server selection candidates of 'newTopologyDescription' and makes it the
+     * current description.
+     */
+    void _installTopologyDescription(WithLock, TopologyDescriptionPtr newTopologyDescription);
+
     mutable mongo::Mutex _mutex = MONGO_MAKE_LATCH("TopologyManager");
     const SdamConfiguration _config;
     ClockSource* _clockSource;
+    // Written under '_mutex', but read with atomic_load() so that readers never block.
     TopologyDescriptionPtr _topologyDescription;
+    SdamServerSelector _candidateSelector;
     TopologyStateMachinePtr _topologyStateMachine;
     TopologyEventsPublisherPtr _topologyEventsPublisher;
 };
@@ -80,6 +80,7 @@ void AuthorizationSessionForTest::revokePrivilegesForDB(StringData dbName) {
                        _testUsers.end(),
                        [&](const auto& user) { return dbName == user->getName().getDB(); }),
         _testUsers.end());
+    _buildAuthenticatedRolesVector();
 }
 
 void AuthorizationSessionForTest::revokeAllPrivileges() {
@@ -90,5 +91,6 @@ void AuthorizationSessionForTest::revokeAllPrivileges() {
                                         return true;
                                     }),
                      _testUsers.end());
+    _buildAuthenticatedRolesVector();
 }
 }  // namespace mongo
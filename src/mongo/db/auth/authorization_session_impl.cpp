@@ -411,6 +411,10 @@ bool AuthorizationSessionImpl::isAuthorizedForActionsOnNamespace(const Namespace
 }
 
 static const int resourceSearchListCapacity = 7;
+
+// The most resources whose actions an AuthorizationSessionImpl caches at once.
+static const size_t kMaxResourceActionsCacheSize = 1024;
+
 /**
  * Builds from "target" an exhaustive list of all ResourcePatterns that match "target".
  *
@@ -559,6 +563,7 @@ bool AuthorizationSessionImpl::isAuthenticated() {
 void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx) {
     AuthorizationManager& authMan = getAuthorizationManager();
     UserSet::iterator it = _authenticatedUsers.begin();
+    bool usersChanged = false;
     auto removeUser = [&](const auto& it) {
         // Take out a lock on the client here to ensure that no one reads while
         // _authenticatedUsers is being modified.
@@ -566,6 +571,7 @@ void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx)
 
         // The user is invalid, so make sure that we erase it from _authenticateUsers.
         _authenticatedUsers.removeAt(it);
+        usersChanged = true;
     };
 
     auto replaceUser = [&](const auto& it, UserHandle updatedUser) {
@@ -573,6 +579,7 @@ void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx)
         // _authenticatedUsers is being modified.
         stdx::lock_guard<Client> lk(*opCtx->getClient());
         _authenticatedUsers.replaceAt(it, std::move(updatedUser));
+        usersChanged = true;
     };
 
     while (it != _authenticatedUsers.end()) {
@@ -645,10 +652,16 @@ void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx)
 
         ++it;
     }
-    _buildAuthenticatedRolesVector();
+
+    // The roles and cached actions only depend on the set of users, so keep them, and the
+    // actions cached by earlier requests on this session, when no user has changed.
+    if (usersChanged) {
+        _buildAuthenticatedRolesVector();
+    }
 }
 
 void AuthorizationSessionImpl::_buildAuthenticatedRolesVector() {
+    _resourceActionsCache.clear();
     _authenticatedRoleNames.clear();
     for (UserSet::iterator it = _authenticatedUsers.begin(); it != _authenticatedUsers.end();
          ++it) {
@@ -754,12 +767,20 @@ bool AuthorizationSessionImpl::_isAuthorizedForPrivilege(const Privilege& privil
 
     const ResourcePattern& target(privilege.getResourcePattern());
 
-    ResourcePattern resourceSearchList[resourceSearchListCapacity];
-    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
-
     ActionSet unmetRequirements = privilege.getActions();
+    unmetRequirements.removeAllActionsFromSet(_getAuthenticatedUsersActions(target));
+    if (unmetRequirements.empty()) {
+        return true;
+    }
 
     PrivilegeVector defaultPrivileges = _getDefaultPrivileges();
+    if (defaultPrivileges.empty()) {
+        return false;
+    }
+
+    ResourcePattern resourceSearchList[resourceSearchListCapacity];
+    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
+
     for (PrivilegeVector::iterator it = defaultPrivileges.begin(); it != defaultPrivileges.end();
          ++it) {
         for (int i = 0; i < resourceSearchListLength; ++i) {
@@ -774,18 +795,30 @@ bool AuthorizationSessionImpl::_isAuthorizedForPrivilege(const Privilege& privil
         }
     }
 
+    return false;
+}
+
+const ActionSet& AuthorizationSessionImpl::_getAuthenticatedUsersActions(
+    const ResourcePattern& target) {
+    if (auto it = _resourceActionsCache.find(target); it != _resourceActionsCache.end()) {
+        return it->second;
+    }
+
+    // Bound the cache for sessions which touch very many namespaces.
+    if (_resourceActionsCache.size() >= kMaxResourceActionsCacheSize) {
+        _resourceActionsCache.clear();
+    }
+
+    ResourcePattern resourceSearchList[resourceSearchListCapacity];
+    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
+
+    ActionSet actions;
     for (const auto& user : _authenticatedUsers) {
         for (int i = 0; i < resourceSearchListLength; ++i) {
-            ActionSet userActions = user->getActionsForResource(resourceSearchList[i]);
-            unmetRequirements.removeAllActionsFromSet(userActions);
-
-            if (unmetRequirements.empty()) {
-                return true;
-            }
+            actions.addAllActionsFromSet(user->getActionsForResource(resourceSearchList[i]));
         }
     }
-
-    return false;
+    return _resourceActionsCache.emplace(target, actions).first->second;
 }
 
 void AuthorizationSessionImpl::setImpersonatedUserData(const std::vector<UserName>& usernames,
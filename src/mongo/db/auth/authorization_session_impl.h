@@ -42,6 +42,7 @@
 #include "mongo/db/auth/user_name.h"
 #include "mongo/db/auth/user_set.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -156,6 +157,7 @@ protected:
     // Builds a vector of all roles held by users who are authenticated on this connection. The
     // vector is stored in _authenticatedRoleNames. This function is called when users are
     // logged in or logged out, as well as when the user cache is determined to be out of date.
+    // It also clears _resourceActionsCache, which depends on the same set of users.
     void _buildAuthenticatedRolesVector();
 
     // All Users who have been authenticated on this connection.
@@ -165,6 +167,11 @@ protected:
     // users set is changed.
     std::vector<RoleName> _authenticatedRoleNames;
 
+    // Maps each resource checked by _isAuthorizedForPrivilege() to all of the actions which the
+    // authenticated users may perform on it, so that repeated checks of a resource are a single
+    // lookup. Cleared, like _authenticatedRoleNames, whenever the authenticated users change.
+    stdx::unordered_map<ResourcePattern, ActionSet> _resourceActionsCache;
+
 private:
     // If any users authenticated on this session are marked as invalid this updates them with
     // up-to-date information. May require a read lock on the "admin" db to read the user data.
@@ -176,6 +183,10 @@ private:
     // lock on the admin database (to update out-of-date user privilege information).
     bool _isAuthorizedForPrivilege(const Privilege& privilege);
 
+    // Returns the actions which the authenticated users may perform on 'target', through any of
+    // the resource patterns which match it, from _resourceActionsCache if it holds them.
+    const ActionSet& _getAuthenticatedUsersActions(const ResourcePattern& target);
+
     std::tuple<std::vector<UserName>*, std::vector<RoleName>*> _getImpersonations() override {
         return std::make_tuple(&_impersonatedUserNames, &_impersonatedRoleNames);
     }
@@ -480,6 +480,54 @@ TEST_F(AuthorizationSessionTest, InvalidateUser) {
     ASSERT_FALSE(authzSession->lookupUser(UserName("spencer", "test")));
 }
 
+TEST_F(AuthorizationSessionTest, RepeatedChecksFollowChangesToAuthenticatedUsers) {
+    ASSERT_OK(managerState->insertPrivilegeDocument(_opCtx.get(),
+                                                    BSON("user"
+                                                         << "spencer"
+                                                         << "db"
+                                                         << "test"
+                                                         << "credentials" << credentials << "roles"
+                                                         << BSON_ARRAY(BSON("role"
+                                                                            << "read"
+                                                                            << "db"
+                                                                            << "test"))),
+                                                    BSONObj()));
+    ASSERT_OK(
+        managerState->insertPrivilegeDocument(_opCtx.get(),
+                                              BSON("user"
+                                                   << "admin"
+                                                   << "db"
+                                                   << "admin"
+                                                   << "credentials" << credentials << "roles"
+                                                   << BSON_ARRAY(BSON("role"
+                                                                      << "readWriteAnyDatabase"
+                                                                      << "db"
+                                                                      << "admin"))),
+                                              BSONObj()));
+    ASSERT_OK(authzSession->addAndAuthorizeUser(_opCtx.get(), UserName("spencer", "test")));
+
+    // Repeated checks on the same resource, also across requests, give the same answers.
+    for (int i = 0; i < 2; ++i) {
+        authzSession->startRequest(_opCtx.get());
+        ASSERT_TRUE(
+            authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::find));
+        ASSERT_FALSE(authzSession->isAuthorizedForActionsOnResource(testFooCollResource,
+                                                                    ActionType::insert));
+    }
+
+    // Actions granted by a newly authenticated user apply to resources checked before.
+    ASSERT_OK(authzSession->addAndAuthorizeUser(_opCtx.get(), UserName("admin", "admin")));
+    ASSERT_TRUE(
+        authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::insert));
+
+    // And they are gone once that user logs out.
+    authzSession->logoutDatabase(_client.get(), "admin", "Fire the admin!");
+    ASSERT_TRUE(
+        authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::find));
+    ASSERT_FALSE(
+        authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::insert));
+}
+
 TEST_F(AuthorizationSessionTest, UseOldUserInfoInFaceOfConnectivityProblems) {
     // Add a readWrite user
     ASSERT_OK(managerState->insertPrivilegeDocument(_opCtx.get(),
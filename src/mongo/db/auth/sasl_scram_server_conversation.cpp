@@ -47,10 +47,20 @@
 #include "mongo/platform/random.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/sequence_util.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/str.h"
+#include "mongo/util/synchronized_value.h"
 #include "mongo/util/text.h"
 
 namespace mongo {
+namespace {
+
+// All conversations draw their nonces from one generator. A SecureRandom per conversation would
+// allocate and fill a page of entropy from the OS on every connection, only to use 24 bytes of it,
+// which adds up during connection storms.
+StaticImmortal<synchronized_value<SecureRandom>> nonceGen;
+
+}  // namespace
 
 template <typename Policy>
 StatusWith<std::tuple<bool, std::string>> SaslSCRAMServerMechanism<Policy>::stepImpl(
@@ -251,7 +261,7 @@ StatusWith<std::tuple<bool, std::string>> SaslSCRAMServerMechanism<Policy>::_fir
     const int nonceLenQWords = 3;
     uint64_t binaryNonce[nonceLenQWords];
 
-    SecureRandom().fill(binaryNonce, sizeof(binaryNonce));
+    (*nonceGen)->fill(binaryNonce, sizeof(binaryNonce));
 
     _nonce = clientNonce +
         base64::encode(StringData(reinterpret_cast<char*>(binaryNonce), sizeof(binaryNonce)));
@@ -0,0 +1,162 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/capped_deleter.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+
+namespace mongo {
+namespace {
+
+const auto getCappedDeleter = ServiceContext::declareDecoration<std::unique_ptr<CappedDeleter>>();
+
+Counter64 cappedDeleterPasses;
+Counter64 cappedDeleterDeletedDocuments;
+
+ServerStatusMetricField<Counter64> cappedDeleterPassesDisplay("cappedDeleter.passes",
+                                                              &cappedDeleterPasses);
+ServerStatusMetricField<Counter64> cappedDeleterDeletedDocumentsDisplay(
+    "cappedDeleter.deletedDocuments", &cappedDeleterDeletedDocuments);
+
+}  // namespace
+
+CappedDeleter* CappedDeleter::get(ServiceContext* serviceContext) {
+    return getCappedDeleter(serviceContext).get();
+}
+
+void CappedDeleter::notifyNeedsDelete(const UUID& uuid) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_pending.insert(uuid).second) {
+        _cv.notify_one();
+    }
+}
+
+void CappedDeleter::shutdown() {
+    LOGV2(6113000, "Shutting down the capped deleter thread");
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _shuttingDown = true;
+        _cv.notify_one();
+    }
+    wait();
+    LOGV2(6113001, "Finished shutting down the capped deleter thread");
+}
+
+void CappedDeleter::run() {
+    ThreadClient tc(name(), getGlobalServiceContext());
+    AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+
+    {
+        stdx::lock_guard<Client> lk(*tc.get());
+        tc.get()->setSystemOperationKillableByStepdown(lk);
+    }
+
+    while (true) {
+        stdx::unordered_set<UUID, UUID::Hash> pending;
+        {
+            stdx::unique_lock<Latch> lk(_mutex);
+            MONGO_IDLE_THREAD_BLOCK;
+            _cv.wait(lk, [&] { return _shuttingDown || !_pending.empty(); });
+            if (_shuttingDown) {
+                return;
+            }
+            pending.swap(_pending);
+        }
+
+        for (const auto& uuid : pending) {
+            auto opCtx = cc().makeOperationContext();
+            try {
+                _deleteFromCollection(opCtx.get(), uuid);
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>& ex) {
+                LOGV2_DEBUG(6113002, 1, "Capped deleter was interrupted", "error"_attr = ex);
+            } catch (const DBException& ex) {
+                LOGV2_WARNING(6113003,
+                              "Capped deleter failed to delete from collection",
+                              "uuid"_attr = uuid,
+                              "error"_attr = ex);
+            }
+        }
+        cappedDeleterPasses.increment();
+    }
+}
+
+void CappedDeleter::_deleteFromCollection(OperationContext* opCtx, const UUID& uuid) {
+    auto nss = CollectionCatalog::get(opCtx)->lookupNSSByUUID(opCtx, uuid);
+    if (!nss) {
+        return;
+    }
+
+    AutoGetCollection coll(opCtx, *nss, MODE_IX);
+    // The collection might have been renamed before it was locked, so check it is the same one.
+    if (!coll || coll->uuid() != uuid || !coll->isCapped()) {
+        return;
+    }
+
+    // Inserts on another primary delete on their own, and replicate the deletes to this node.
+    if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, *nss)) {
+        return;
+    }
+
+    long long docsRemoved = writeConflictRetry(
+        opCtx, "cappedDelete", nss->ns(), [&] { return coll->deleteCappedOverflow(opCtx); });
+    cappedDeleterDeletedDocuments.increment(docsRemoved);
+}
+
+void startCappedDeleter(ServiceContext* serviceContext) {
+    auto& cappedDeleter = getCappedDeleter(serviceContext);
+    if (cappedDeleter) {
+        invariant(!cappedDeleter->running(),
+                  "Tried to reset the CappedDeleter without shutting down the original instance.");
+    }
+    cappedDeleter = std::make_unique<CappedDeleter>();
+    cappedDeleter->go();
+}
+
+void shutdownCappedDeleter(ServiceContext* serviceContext) {
+    // The CappedDeleter may not have been started if shutdown occurs early.
+    if (auto cappedDeleter = CappedDeleter::get(serviceContext)) {
+        cappedDeleter->shutdown();
+    }
+}
+
+}  // namespace mongo
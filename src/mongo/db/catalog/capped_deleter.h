@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/background.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Deletes the oldest documents of capped collections which inserts took past their limits, when
+ * 'cappedDeleteInBackground' lets the inserts leave that to a background thread. The deletes are
+ * the ones an insert would otherwise have made, and are replicated in the same way, so the thread
+ * only works on collections it can write to.
+ */
+class CappedDeleter : public BackgroundJob {
+public:
+    CappedDeleter() : BackgroundJob(false /* selfDelete */) {}
+
+    static CappedDeleter* get(ServiceContext* serviceContext);
+
+    std::string name() const override {
+        return "CappedDeleter";
+    }
+
+    /**
+     * Asks the thread to bring the capped collection 'uuid' back within its limits.
+     */
+    void notifyNeedsDelete(const UUID& uuid);
+
+    /**
+     * Signals the thread to quit and then waits until it does.
+     */
+    void shutdown();
+
+private:
+    void run() override;
+
+    void _deleteFromCollection(OperationContext* opCtx, const UUID& uuid);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CappedDeleter::_mutex");
+    stdx::condition_variable _cv;
+    bool _shuttingDown = false;
+
+    // The collections which inserts left over their limits since the thread last looked.
+    stdx::unordered_set<UUID, UUID::Hash> _pending;
+};
+
+/**
+ * Starts the CappedDeleter. Safe to call again after shutdownCappedDeleter() has been called.
+ */
+void startCappedDeleter(ServiceContext* serviceContext);
+
+/**
+ * Shuts down the CappedDeleter if it is running. Safe to call multiple times.
+ */
+void shutdownCappedDeleter(ServiceContext* serviceContext);
+
+}  // namespace mongo
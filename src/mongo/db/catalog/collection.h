@@ -375,6 +375,18 @@ public:
                                 const bool noWarn = false,
                                 StoreDeletedDoc storeDeletedDoc = StoreDeletedDoc::Off) const = 0;
 
+    /**
+     * Deletes all of 'bsonRecords' from the collection inside the caller's WriteUnitOfWork. Each
+     * document is logged by its own oplog entry as by deleteDocument(), but the index keys of all
+     * of them are removed together. The documents must stay valid until this returns.
+     */
+    virtual void deleteDocuments(OperationContext* const opCtx,
+                                 const std::vector<BsonRecord>& bsonRecords,
+                                 StmtId stmtId,
+                                 OpDebug* const opDebug,
+                                 const bool fromMigrate = false,
+                                 const bool noWarn = false) const = 0;
+
     /*
      * Inserts all documents inside one WUOW.
      * Caller should ensure vector is appropriately sized for this.
@@ -657,6 +669,14 @@ public:
     virtual long long getCappedMaxDocs() const = 0;
     virtual long long getCappedMaxSize() const = 0;
 
+    /**
+     * Deletes the oldest documents of this capped collection for as long as it exceeds its size or
+     * document limit, as inserts do unless they leave that to the CappedDeleter. Returns the
+     * number of documents deleted. The caller must hold the collection in MODE_IX, and must not be
+     * in a WriteUnitOfWork.
+     */
+    virtual long long deleteCappedOverflow(OperationContext* opCtx) const = 0;
+
     /**
      * Returns a pointer to a capped callback object.
      * The storage engine interacts with capped collections through a CappedCallback interface.
@@ -251,11 +251,11 @@ public:
                 case UncommittedCatalogUpdates::Entry::Action::kWritable:
                     writeJobs.push_back(
                         [collection = std::move(entry.collection)](CollectionCatalog& catalog) {
-                            catalog._collections[collection->ns()] = collection;
-                            catalog._catalog[collection->uuid()] = collection;
+                            catalog._collections.set(collection->ns(), collection);
+                            catalog._catalog.set(collection->uuid(), collection);
                             auto dbIdPair = std::make_pair(collection->ns().db().toString(),
                                                            collection->uuid());
-                            catalog._orderedCollections[dbIdPair] = collection;
+                            catalog._orderedCollections.set(dbIdPair, collection);
                         });
                     break;
                 case UncommittedCatalogUpdates::Entry::Action::kRenamed:
@@ -314,7 +314,9 @@ CollectionCatalog::iterator::iterator(OperationContext* opCtx,
     : _opCtx(opCtx), _dbName(dbName), _catalog(&catalog) {
     auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
 
-    _mapIter = _catalog->_orderedCollections.lower_bound(std::make_pair(_dbName, minUuid));
+    auto dbIdPair = std::make_pair(_dbName, minUuid);
+    _map = &_catalog->_orderedCollections.partition(dbIdPair);
+    _mapIter = _map->lower_bound(dbIdPair);
 
     // Start with the first collection that is visible outside of its transaction.
     while (!_exhausted() && !_mapIter->second->isCommitted()) {
@@ -326,11 +328,8 @@ CollectionCatalog::iterator::iterator(OperationContext* opCtx,
     }
 }
 
-CollectionCatalog::iterator::iterator(OperationContext* opCtx,
-                                      std::map<std::pair<std::string, CollectionUUID>,
-                                               std::shared_ptr<Collection>>::const_iterator mapIter,
-                                      const CollectionCatalog& catalog)
-    : _opCtx(opCtx), _mapIter(mapIter), _catalog(&catalog) {}
+CollectionCatalog::iterator::iterator(OperationContext* opCtx, const CollectionCatalog& catalog)
+    : _opCtx(opCtx), _catalog(&catalog) {}
 
 CollectionCatalog::iterator::value_type CollectionCatalog::iterator::operator*() {
     if (_exhausted()) {
@@ -361,7 +360,7 @@ CollectionCatalog::iterator CollectionCatalog::iterator::operator++() {
     if (_exhausted()) {
         // If the iterator is at the end of the map or now points to an entry that does not
         // correspond to the correct database.
-        _mapIter = _catalog->_orderedCollections.end();
+        _map = nullptr;
         _uuid = boost::none;
         return *this;
     }
@@ -378,7 +377,7 @@ CollectionCatalog::iterator CollectionCatalog::iterator::operator++(int) {
 
 bool CollectionCatalog::iterator::operator==(const iterator& other) {
     invariant(_catalog == other._catalog);
-    if (other._mapIter == _catalog->_orderedCollections.end()) {
+    if (!other._map) {
         return _uuid == boost::none;
     }
 
@@ -390,7 +389,7 @@ bool CollectionCatalog::iterator::operator!=(const iterator& other) {
 }
 
 bool CollectionCatalog::iterator::_exhausted() {
-    return _mapIter == _catalog->_orderedCollections.end() || _mapIter->first.first != _dbName;
+    return !_map || _mapIter == _map->end() || _mapIter->first.first != _dbName;
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(ServiceContext* svcCtx) {
@@ -567,8 +566,8 @@ void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
     invariant(!_shadowCatalog);
     _shadowCatalog.emplace();
-    for (auto& entry : _catalog)
-        _shadowCatalog->insert({entry.first, entry.second->ns()});
+    _catalog.forEach(
+        [&](const auto& entry) { _shadowCatalog->insert({entry.first, entry.second->ns()}); });
 }
 
 void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
@@ -658,8 +657,8 @@ bool CollectionCatalog::isCollectionAwaitingVisibility(CollectionUUID uuid) cons
 }
 
 std::shared_ptr<Collection> CollectionCatalog::_lookupCollectionByUUID(CollectionUUID uuid) const {
-    auto foundIt = _catalog.find(uuid);
-    return foundIt == _catalog.end() ? nullptr : foundIt->second;
+    auto coll = _catalog.find(uuid);
+    return coll ? *coll : nullptr;
 }
 
 std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByNamespaceForRead(
@@ -669,7 +668,7 @@ std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByNamespace
     }
 
     auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto coll = (it ? *it : nullptr);
     return (coll && coll->isCommitted()) ? coll : nullptr;
 }
 
@@ -700,7 +699,7 @@ Collection* CollectionCatalog::lookupCollectionByNamespaceForMetadataWrite(
     }
 
     auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto coll = (it ? *it : nullptr);
 
     if (!coll || !coll->isCommitted())
         return nullptr;
@@ -737,7 +736,7 @@ CollectionPtr CollectionCatalog::lookupCollectionByNamespace(OperationContext* o
     }
 
     auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto coll = (it ? *it : nullptr);
     return (coll && coll->isCommitted())
         ? CollectionPtr(opCtx, coll.get(), LookupCollectionForYieldRestore())
         : nullptr;
@@ -760,11 +759,10 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationCon
         return coll->ns();
     }
 
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end()) {
-        boost::optional<NamespaceString> ns = foundIt->second->ns();
+    if (auto coll = _catalog.find(uuid)) {
+        boost::optional<NamespaceString> ns = (*coll)->ns();
         invariant(!ns.get().isEmpty());
-        return _collections.find(ns.get())->second->isCommitted() ? ns : boost::none;
+        return (*_collections.find(ns.get()))->isCommitted() ? ns : boost::none;
     }
 
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
@@ -794,10 +792,9 @@ boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
         return boost::none;
     }
 
-    auto it = _collections.find(nss);
-    if (it != _collections.end()) {
-        boost::optional<CollectionUUID> uuid = it->second->uuid();
-        return it->second->isCommitted() ? uuid : boost::none;
+    if (auto coll = _collections.find(nss)) {
+        boost::optional<CollectionUUID> uuid = (*coll)->uuid();
+        return (*coll)->isCommitted() ? uuid : boost::none;
     }
     return boost::none;
 }
@@ -841,10 +838,12 @@ bool CollectionCatalog::checkIfCollectionSatisfiable(CollectionUUID uuid,
 std::vector<CollectionUUID> CollectionCatalog::getAllCollectionUUIDsFromDb(
     StringData dbName) const {
     auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
-    auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
+    auto dbIdPair = std::make_pair(dbName.toString(), minUuid);
+    const auto& orderedCollections = _orderedCollections.partition(dbIdPair);
+    auto it = orderedCollections.lower_bound(dbIdPair);
 
     std::vector<CollectionUUID> ret;
-    while (it != _orderedCollections.end() && it->first.first == dbName) {
+    while (it != orderedCollections.end() && it->first.first == dbName) {
         if (it->second->isCommitted()) {
             ret.push_back(it->first.second);
         }
@@ -859,9 +858,12 @@ std::vector<NamespaceString> CollectionCatalog::getAllCollectionNamesFromDb(
 
     auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
 
+    auto dbIdPair = std::make_pair(dbName.toString(), minUuid);
+    const auto& orderedCollections = _orderedCollections.partition(dbIdPair);
+
     std::vector<NamespaceString> ret;
-    for (auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
-         it != _orderedCollections.end() && it->first.first == dbName;
+    for (auto it = orderedCollections.lower_bound(dbIdPair);
+         it != orderedCollections.end() && it->first.first == dbName;
          ++it) {
         if (it->second->isCommitted()) {
             ret.push_back(it->second->ns());
@@ -871,23 +873,26 @@ std::vector<NamespaceString> CollectionCatalog::getAllCollectionNamesFromDb(
 }
 
 std::vector<std::string> CollectionCatalog::getAllDbNames() const {
-    std::vector<std::string> ret;
+    std::set<std::string> dbNames;
     auto maxUuid = UUID::parse("FFFFFFFF-FFFF-FFFF-FFFF-FFFFFFFFFFFF").getValue();
-    auto iter = _orderedCollections.upper_bound(std::make_pair("", maxUuid));
-    while (iter != _orderedCollections.end()) {
-        auto dbName = iter->first.first;
-        if (iter->second->isCommitted()) {
-            ret.push_back(dbName);
-        } else {
-            // If the first collection found for `dbName` is not yet committed, increment the
-            // iterator to find the next visible collection (possibly under a different `dbName`).
-            iter++;
-            continue;
+    _orderedCollections.forEachPartition([&](const auto& orderedCollections) {
+        auto iter = orderedCollections.upper_bound(std::make_pair("", maxUuid));
+        while (iter != orderedCollections.end()) {
+            auto dbName = iter->first.first;
+            if (iter->second->isCommitted()) {
+                dbNames.insert(dbName);
+            } else {
+                // If the first collection found for `dbName` is not yet committed, increment the
+                // iterator to find the next visible collection (possibly under a different
+                // `dbName`).
+                iter++;
+                continue;
+            }
+            // Move on to the next database after `dbName`.
+            iter = orderedCollections.upper_bound(std::make_pair(dbName, maxUuid));
         }
-        // Move on to the next database after `dbName`.
-        iter = _orderedCollections.upper_bound(std::make_pair(dbName, maxUuid));
-    }
-    return ret;
+    });
+    return {dbNames.begin(), dbNames.end()};
 }
 
 void CollectionCatalog::setDatabaseProfileSettings(
@@ -925,7 +930,7 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
                                            CollectionUUID uuid,
                                            std::shared_ptr<Collection> coll) {
     auto ns = coll->ns();
-    bool conflict = _collections.find(ns) != _collections.end();
+    bool conflict = _collections.contains(ns);
     if (!conflict) {
         auto it = _views.find(ns.db());
         if (it != _views.end()) {
@@ -960,12 +965,12 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
     auto dbIdPair = std::make_pair(dbName, uuid);
 
     // Make sure no entry related to this uuid.
-    invariant(_catalog.find(uuid) == _catalog.end());
-    invariant(_orderedCollections.find(dbIdPair) == _orderedCollections.end());
+    invariant(!_catalog.contains(uuid));
+    invariant(!_orderedCollections.contains(dbIdPair));
 
-    _catalog[uuid] = coll;
-    _collections[ns] = coll;
-    _orderedCollections[dbIdPair] = coll;
+    _catalog.set(uuid, coll);
+    _collections.set(ns, coll);
+    _orderedCollections.set(dbIdPair, coll);
 
     if (!ns.isOnInternalDb() && !ns.isSystem()) {
         _stats.userCollections += 1;
@@ -987,9 +992,9 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
 
 std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationContext* opCtx,
                                                                     CollectionUUID uuid) {
-    invariant(_catalog.find(uuid) != _catalog.end());
+    invariant(_catalog.contains(uuid));
 
-    auto coll = std::move(_catalog[uuid]);
+    auto coll = *_catalog.find(uuid);
     auto ns = coll->ns();
     auto dbName = ns.db().toString();
     auto dbIdPair = std::make_pair(dbName, uuid);
@@ -997,8 +1002,8 @@ std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationCon
     LOGV2_DEBUG(20281, 1, "Deregistering collection", "namespace"_attr = ns, "uuid"_attr = uuid);
 
     // Make sure collection object exists.
-    invariant(_collections.find(ns) != _collections.end());
-    invariant(_orderedCollections.find(dbIdPair) != _orderedCollections.end());
+    invariant(_collections.contains(ns));
+    invariant(_orderedCollections.contains(dbIdPair));
 
     _orderedCollections.erase(dbIdPair);
     _collections.erase(ns);
@@ -1025,17 +1030,13 @@ std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationCon
 
 void CollectionCatalog::deregisterAllCollectionsAndViews() {
     LOGV2(20282, "Deregistering all the collections");
-    for (auto& entry : _catalog) {
-        auto uuid = entry.first;
-        auto ns = entry.second->ns();
-        auto dbName = ns.db().toString();
-        auto dbIdPair = std::make_pair(dbName, uuid);
-
-        LOGV2_DEBUG(
-            20283, 1, "Deregistering collection", "namespace"_attr = ns, "uuid"_attr = uuid);
-
-        entry.second.reset();
-    }
+    _catalog.forEach([](const auto& entry) {
+        LOGV2_DEBUG(20283,
+                    1,
+                    "Deregistering collection",
+                    "namespace"_attr = entry.second->ns(),
+                    "uuid"_attr = entry.first);
+    });
 
     _collections.clear();
     _orderedCollections.clear();
@@ -1081,61 +1082,63 @@ CollectionCatalog::iterator CollectionCatalog::begin(OperationContext* opCtx, St
 }
 
 CollectionCatalog::iterator CollectionCatalog::end(OperationContext* opCtx) const {
-    return iterator(opCtx, _orderedCollections.end(), *this);
+    return iterator(opCtx, *this);
 }
 
 boost::optional<std::string> CollectionCatalog::lookupResourceName(const ResourceId& rid) const {
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
-    auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
+    auto namespaces = _resourceInformation.find(rid);
+    if (!namespaces) {
         return boost::none;
     }
 
-    const std::set<std::string>& namespaces = search->second;
 
     // When there are multiple namespaces mapped to the same ResourceId, return boost::none as the
     // ResourceId does not identify a single namespace.
-    if (namespaces.size() > 1) {
+    if (namespaces->size() > 1) {
         return boost::none;
     }
 
-    return *namespaces.begin();
+    return *namespaces->begin();
 }
 
 void CollectionCatalog::removeResource(const ResourceId& rid, const std::string& entry) {
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
+    if (!search || !search->count(entry)) {
         return;
     }
 
-    std::set<std::string>& namespaces = search->second;
-    namespaces.erase(entry);
-
     // Remove the map entry if this is the last namespace in the set for the ResourceId.
-    if (namespaces.size() == 0) {
-        _resourceInformation.erase(search);
+    if (search->size() == 1) {
+        _resourceInformation.erase(rid);
+        return;
     }
+
+    std::set<std::string> namespaces = *search;
+    namespaces.erase(entry);
+    _resourceInformation.set(rid, std::move(namespaces));
 }
 
 void CollectionCatalog::addResource(const ResourceId& rid, const std::string& entry) {
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
+    if (!search) {
         std::set<std::string> newSet = {entry};
-        _resourceInformation.insert(std::make_pair(rid, newSet));
+        _resourceInformation.set(rid, std::move(newSet));
         return;
     }
 
-    std::set<std::string>& namespaces = search->second;
-    if (namespaces.count(entry) > 0) {
+    if (search->count(entry) > 0) {
         return;
     }
 
+    std::set<std::string> namespaces = *search;
     namespaces.insert(entry);
+    _resourceInformation.set(rid, std::move(namespaces));
 }
 
 CollectionCatalogStasher::CollectionCatalogStasher(OperationContext* opCtx)
@@ -37,6 +37,7 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/copy_on_write_partitioned_map.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -74,10 +75,11 @@ public:
         using value_type = CollectionPtr;
 
         iterator(OperationContext* opCtx, StringData dbName, const CollectionCatalog& catalog);
-        iterator(OperationContext* opCtx,
-                 std::map<std::pair<std::string, CollectionUUID>,
-                          std::shared_ptr<Collection>>::const_iterator mapIter,
-                 const CollectionCatalog& catalog);
+
+        /**
+         * Constructs the end iterator.
+         */
+        iterator(OperationContext* opCtx, const CollectionCatalog& catalog);
         value_type operator*();
         iterator operator++();
         iterator operator++(int);
@@ -98,6 +100,11 @@ public:
         OperationContext* _opCtx;
         std::string _dbName;
         boost::optional<CollectionUUID> _uuid;
+
+        // The partition of the ordered collection map that holds '_dbName', or nullptr once the
+        // iterator is exhausted.
+        const std::map<std::pair<std::string, CollectionUUID>, std::shared_ptr<Collection>>*
+            _map = nullptr;
         std::map<std::pair<std::string, CollectionUUID>,
                  std::shared_ptr<Collection>>::const_iterator _mapIter;
         const CollectionCatalog* _catalog;
@@ -413,12 +420,30 @@ private:
         mongo::stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>>
         _shadowCatalog;
 
-    using CollectionCatalogMap =
-        stdx::unordered_map<CollectionUUID, std::shared_ptr<Collection>, CollectionUUID::Hash>;
-    using OrderedCollectionMap =
-        std::map<std::pair<std::string, CollectionUUID>, std::shared_ptr<Collection>>;
-    using NamespaceCollectionMap =
-        stdx::unordered_map<NamespaceString, std::shared_ptr<Collection>>;
+    // Collections of the same database must share a partition of the ordered map so that they can
+    // be found with a single range lookup.
+    struct DbNameHasher {
+        std::size_t operator()(const std::pair<std::string, CollectionUUID>& dbIdPair) const {
+            return absl::Hash<std::string>()(dbIdPair.first);
+        }
+    };
+    struct ResourceIdHasher {
+        std::size_t operator()(const ResourceId& rid) const {
+            return static_cast<uint64_t>(rid);
+        }
+    };
+
+    // The maps are partitioned so that the copy made by every catalog write only has to clone the
+    // partitions that the write modifies, instead of every collection in the catalog.
+    using CollectionCatalogMap = CopyOnWritePartitionedMap<
+        stdx::unordered_map<CollectionUUID, std::shared_ptr<Collection>, CollectionUUID::Hash>>;
+    using OrderedCollectionMap = CopyOnWritePartitionedMap<
+        std::map<std::pair<std::string, CollectionUUID>, std::shared_ptr<Collection>>,
+        DbNameHasher>;
+    using NamespaceCollectionMap = CopyOnWritePartitionedMap<
+        stdx::unordered_map<NamespaceString, std::shared_ptr<Collection>>>;
+    using ResourceInformationMap =
+        CopyOnWritePartitionedMap<std::map<ResourceId, std::set<std::string>>, ResourceIdHasher>;
     using DatabaseProfileSettingsMap = StringMap<ProfileSettings>;
 
     CollectionCatalogMap _catalog;
@@ -441,7 +466,7 @@ private:
     uint64_t _epoch = 0;
 
     // Mapping from ResourceId to a set of strings that contains collection and database namespaces.
-    std::map<ResourceId, std::set<std::string>> _resourceInformation;
+    ResourceInformationMap _resourceInformation;
 
     /**
      * Contains non-default database profile settings. New collections, current collections and
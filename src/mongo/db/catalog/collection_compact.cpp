@@ -33,8 +33,10 @@
 
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -68,41 +70,50 @@ CollectionPtr getCollectionForCompact(OperationContext* opCtx,
     return collection;
 }
 
+/**
+ * Returns whether an ident with an estimated 'freeBytes' bytes available for reuse has enough
+ * reclaimable space to be worth compacting.
+ */
+bool shouldCompact(long long freeBytes, long long freeSpaceTargetBytes) {
+    return freeSpaceTargetBytes == 0 || freeBytes >= freeSpaceTargetBytes;
+}
+
 }  // namespace
 
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
-                                      const NamespaceString& collectionNss) {
+                                      const NamespaceString& collectionNss,
+                                      long long freeSpaceTargetBytes) {
     AutoGetDb autoDb(opCtx, collectionNss.db(), MODE_IX);
     Database* database = autoDb.getDb();
     uassert(ErrorCodes::NamespaceNotFound, "database does not exist", database);
 
-    // The collection lock will be downgraded to an intent lock if the record store supports
-    // online compaction.
+    // Storage engines that allow online compaction do so under an intent lock on the collection,
+    // so that compacting never waits for, nor blocks, concurrent operations. Only record stores
+    // which cannot be compacted online need the collection lock to be upgraded to exclusive.
     boost::optional<Lock::CollectionLock> collLk;
-    collLk.emplace(opCtx, collectionNss, MODE_X);
+    collLk.emplace(opCtx, collectionNss, MODE_IX);
 
     CollectionPtr collection = getCollectionForCompact(opCtx, database, collectionNss);
     DisableDocumentValidation validationDisabler(opCtx);
 
     auto recordStore = collection->getRecordStore();
 
-    OldClientContext ctx(opCtx, collectionNss.ns());
-
     if (!recordStore->compactSupported())
         return Status(ErrorCodes::CommandNotSupported,
                       str::stream() << "cannot compact collection with record store: "
                                     << recordStore->name());
 
-    if (recordStore->supportsOnlineCompaction()) {
-        // Storage engines that allow online compaction should do so using an intent lock on the
-        // collection.
-        collLk.emplace(opCtx, collectionNss, MODE_IX);
+    if (!recordStore->supportsOnlineCompaction()) {
+        collLk.reset();
+        collLk.emplace(opCtx, collectionNss, MODE_X);
 
         // Ensure the collection was not dropped during the re-lock.
         collection = getCollectionForCompact(opCtx, database, collectionNss);
         recordStore = collection->getRecordStore();
     }
 
+    OldClientContext ctx(opCtx, collectionNss.ns());
+
     LOGV2_OPTIONS(20284,
                   {LogComponent::kCommand},
                   "compact {namespace} begin",
@@ -110,16 +121,52 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
                   "namespace"_attr = collectionNss);
 
     auto oldTotalSize = recordStore->storageSize(opCtx) + collection->getIndexSize(opCtx);
-    auto indexCatalog = collection->getIndexCatalog();
 
-    Status status = recordStore->compact(opCtx);
-    if (!status.isOK())
-        return status;
+    // Compact the record store and all ready indexes, skipping the idents whose estimated
+    // reclaimable space is below the target. Progress is reported per ident in $currentOp.
+    std::vector<const IndexCatalogEntry*> indexes;
+    auto indexIt = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (indexIt->more()) {
+        indexes.push_back(indexIt->next());
+    }
 
-    // Compact all indexes (not including unfinished indexes)
-    status = indexCatalog->compactIndexes(opCtx);
-    if (!status.isOK())
-        return status;
+    ProgressMeterHolder progress;
+    {
+        stdx::unique_lock<Client> lk(*opCtx->getClient());
+        progress.set(CurOp::get(opCtx)->setProgress_inlock("Compact: compacting collection files",
+                                                           indexes.size() + 1));
+    }
+
+    long long identsSkipped = 0;
+    if (shouldCompact(recordStore->freeStorageSize(opCtx), freeSpaceTargetBytes)) {
+        Status status = recordStore->compact(opCtx);
+        if (!status.isOK())
+            return status;
+    } else {
+        ++identsSkipped;
+    }
+    progress.hit();
+
+    for (auto entry : indexes) {
+        if (!shouldCompact(entry->accessMethod()->getFreeStorageBytes(opCtx),
+                           freeSpaceTargetBytes)) {
+            ++identsSkipped;
+            progress.hit();
+            continue;
+        }
+
+        LOGV2_DEBUG(20363, 1, "Compacting index", "index"_attr = *(entry->descriptor()));
+        Status status = entry->accessMethod()->compact(opCtx);
+        if (!status.isOK()) {
+            LOGV2_ERROR(20377,
+                        "Failed to compact index",
+                        "index"_attr = *(entry->descriptor()),
+                        "error"_attr = redact(status));
+            return status;
+        }
+        progress.hit();
+    }
+    progress.finished();
 
     auto totalSizeDiff =
         oldTotalSize - recordStore->storageSize(opCtx) - collection->getIndexSize(opCtx);
@@ -127,7 +174,8 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
           "compact {namespace} end, bytes freed: {freedBytes}",
           "Compact end",
           "namespace"_attr = collectionNss,
-          "freedBytes"_attr = totalSizeDiff);
+          "freedBytes"_attr = totalSizeDiff,
+          "identsSkipped"_attr = identsSkipped);
     return totalSizeDiff;
 }
 
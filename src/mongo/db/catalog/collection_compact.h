@@ -37,10 +37,14 @@ namespace mongo {
 /**
  * Compacts collection.
  *
+ * The record store and each index are only compacted if their storage engine estimates at least
+ * 'freeSpaceTargetBytes' bytes to be available for reuse. A target of zero compacts all of them.
+ *
  * Returns the number of bytes of stable storage and index size that were freed. If the total
  * size decreased, the return value is positive. Otherwise, the return value is negative.
  */
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
-                                      const NamespaceString& collectionNss);
+                                      const NamespaceString& collectionNss,
+                                      long long freeSpaceTargetBytes = 0);
 
 }  // namespace mongo
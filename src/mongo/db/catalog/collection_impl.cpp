@@ -39,6 +39,8 @@
 #include "mongo/bson/ordering.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/catalog/capped_deleter.h"
+#include "mongo/db/catalog/capped_deleter_gen.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/document_validation.h"
@@ -879,10 +881,43 @@ bool CollectionImpl::_cappedAndNeedDelete(OperationContext* opCtx) const {
     return false;
 }
 
-void CollectionImpl::_cappedDeleteAsNeeded(OperationContext* opCtx,
-                                           const RecordId& justInserted) const {
+bool CollectionImpl::_cappedWithinOverflowAllowance(OperationContext* opCtx) const {
+    const long long overflowPercent = cappedDeleteInBackgroundOverflowPercent.load();
+
+    const auto cappedMaxSize = _shared->_collectionLatest->getCollectionOptions().cappedSize;
+    if (dataSize(opCtx) > cappedMaxSize + cappedMaxSize * overflowPercent / 100) {
+        return false;
+    }
+
+    const auto cappedMaxDocs = _shared->_cappedMaxDocs;
+    if (cappedMaxDocs != 0 &&
+        numRecords(opCtx) > cappedMaxDocs + cappedMaxDocs * overflowPercent / 100) {
+        return false;
+    }
+
+    return true;
+}
+
+long long CollectionImpl::deleteCappedOverflow(OperationContext* opCtx) const {
+    invariant(isCapped());
+    invariant(!opCtx->lockState()->inAWriteUnitOfWork());
+    dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
+
+    WriteUnitOfWork wuow(opCtx);
+    if (_shared->_needCappedLock) {
+        // Serialize with inserts, which hold the capped lock until the end of their WUOW.
+        Lock::ResourceLock heldUntilEndOfWUOW{
+            opCtx->lockState(), ResourceId(RESOURCE_METADATA, _ns.ns()), MODE_X};
+    }
+    long long docsRemoved = _cappedDeleteAsNeeded(opCtx, RecordId());
+    wuow.commit();
+    return docsRemoved;
+}
+
+long long CollectionImpl::_cappedDeleteAsNeeded(OperationContext* opCtx,
+                                                const RecordId& justInserted) const {
     if (!_cappedAndNeedDelete(opCtx)) {
-        return;
+        return 0;
     }
 
     bool useOldCappedDeleteBehaviour = serverGlobalParams.featureCompatibility.isLessThan(
@@ -891,7 +926,25 @@ void CollectionImpl::_cappedDeleteAsNeeded(OperationContext* opCtx,
     if (!useOldCappedDeleteBehaviour && !opCtx->isEnforcingConstraints()) {
         // With new capped delete behavior, secondaries only delete from capped collections via
         // oplog application when there are explicit delete oplog entries.
-        return;
+        return 0;
+    }
+
+    // With new capped delete behavior, the deletes are replicated like any other, so an insert may
+    // leave them to the CappedDeleter, as long as the collection does not grow too far past its
+    // limits before the CappedDeleter catches up.
+    if (!justInserted.isNull() && !useOldCappedDeleteBehaviour && !ns().isOplog() &&
+        cappedDeleteInBackground.load()) {
+        auto cappedDeleter = CappedDeleter::get(opCtx->getServiceContext());
+        if (cappedDeleter && cappedDeleter->running() && _cappedWithinOverflowAllowance(opCtx)) {
+            opCtx->recoveryUnit()->onCommit(
+                [serviceContext = opCtx->getServiceContext(),
+                 uuid = uuid()](boost::optional<Timestamp>) {
+                    if (auto cappedDeleter = CappedDeleter::get(serviceContext)) {
+                        cappedDeleter->notifyNeedsDelete(uuid);
+                    }
+                });
+            return 0;
+        }
     }
 
     // If the collection does not need size adjustment, then we are in replication recovery and
@@ -915,7 +968,7 @@ void CollectionImpl::_cappedDeleteAsNeeded(OperationContext* opCtx,
     if (useOldCappedDeleteBehaviour &&
         !sizeRecoveryState(opCtx->getServiceContext())
              .collectionNeedsSizeAdjustment(getSharedIdent()->getIdent())) {
-        return;
+        return 0;
     }
 
     stdx::unique_lock<Latch> cappedFirstRecordMutex(_shared->_cappedFirstRecordMutex,
@@ -1020,7 +1073,7 @@ void CollectionImpl::_cappedDeleteAsNeeded(OperationContext* opCtx,
 
             invariant(cappedDeleteSideTxn);
             LOGV2(22398, "Got write conflict removing capped records, ignoring");
-            return;
+            return docsRemoved;
         }
     }
 
@@ -1032,15 +1085,18 @@ void CollectionImpl::_cappedDeleteAsNeeded(OperationContext* opCtx,
             _shared->_cappedFirstRecord = record->id;
         }
     } else {
-        // Update the next record to be deleted. The next record must exist as we're using the same
-        // snapshot the insert was performed on and we can't delete newly inserted records.
-        invariant(record);
-        opCtx->recoveryUnit()->onCommit([this, recordId = record->id](boost::optional<Timestamp>) {
-            _shared->_cappedFirstRecord = recordId;
-        });
+        // Update the next record to be deleted. After an insert, the next record must exist as
+        // we're using the same snapshot the insert was performed on and we can't delete newly
+        // inserted records. The CappedDeleter may have deleted every record.
+        invariant(record || justInserted.isNull());
+        opCtx->recoveryUnit()->onCommit(
+            [this, recordId = record ? record->id : RecordId()](boost::optional<Timestamp>) {
+                _shared->_cappedFirstRecord = recordId;
+            });
     }
 
     wuow.commit();
+    return docsRemoved;
 }
 
 void CollectionImpl::setMinimumVisibleSnapshot(Timestamp newMinimumVisibleSnapshot) {
@@ -1133,6 +1189,44 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
     }
 }
 
+void CollectionImpl::deleteDocuments(OperationContext* opCtx,
+                                     const std::vector<BsonRecord>& bsonRecords,
+                                     StmtId stmtId,
+                                     OpDebug* opDebug,
+                                     bool fromMigrate,
+                                     bool noWarn) const {
+    if (isCapped() && opCtx->isEnforcingConstraints()) {
+        LOGV2(6110300, "failing remove on a capped ns", "namespace"_attr = _ns);
+        uasserted(6110301, "cannot remove from a capped collection");
+    }
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+
+    // aboutToDelete() hands the document key over to onDelete(), so every document is observed by
+    // the two in turn.
+    auto opObserver = getGlobalServiceContext()->getOpObserver();
+    for (auto&& bsonRecord : bsonRecords) {
+        opObserver->aboutToDelete(opCtx, ns(), *bsonRecord.docPtr);
+        _shared->_recordStore->deleteRecord(opCtx, bsonRecord.id);
+
+        OpObserver::OplogDeleteEntryArgs deleteArgs{nullptr, fromMigrate, getRecordPreImages()};
+        if (getRecordPreImages()) {
+            deleteArgs.deletedDoc = bsonRecord.docPtr;
+        }
+        opObserver->onDelete(opCtx, ns(), uuid(), stmtId, deleteArgs);
+    }
+
+    int64_t keysDeleted;
+    _indexCatalog->unindexRecords(opCtx,
+                                  CollectionPtr(this, CollectionPtr::NoYieldTag{}),
+                                  bsonRecords,
+                                  noWarn,
+                                  &keysDeleted);
+
+    if (opDebug) {
+        opDebug->additiveMetrics.incrementKeysDeleted(keysDeleted);
+    }
+}
+
 Counter64 moveCounter;
 ServerStatusMetricField<Counter64> moveCounterDisplay("record.moves", &moveCounter);
 
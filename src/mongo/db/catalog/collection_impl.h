@@ -175,6 +175,13 @@ public:
         bool noWarn = false,
         Collection::StoreDeletedDoc storeDeletedDoc = Collection::StoreDeletedDoc::Off) const final;
 
+    void deleteDocuments(OperationContext* opCtx,
+                         const std::vector<BsonRecord>& bsonRecords,
+                         StmtId stmtId,
+                         OpDebug* opDebug,
+                         bool fromMigrate = false,
+                         bool noWarn = false) const final;
+
     /*
      * Inserts all documents inside one WUOW.
      * Caller should ensure vector is appropriately sized for this.
@@ -331,6 +338,8 @@ public:
     long long getCappedMaxDocs() const final;
     long long getCappedMaxSize() const final;
 
+    long long deleteCappedOverflow(OperationContext* opCtx) const final;
+
     CappedCallback* getCappedCallback() final;
     const CappedCallback* getCappedCallback() const final;
 
@@ -475,12 +484,21 @@ private:
      */
     bool _cappedAndNeedDelete(OperationContext* opCtx) const;
 
+    /**
+     * Checks whether the collection is within 'cappedDeleteInBackgroundOverflowPercent' of
+     * _cappedMaxSize and _cappedMaxDocs, so that its deletes may still be left to the
+     * CappedDeleter.
+     */
+    bool _cappedWithinOverflowAllowance(OperationContext* opCtx) const;
 
     /**
      * Deletes records from this capped collection while _cappedMaxDocs or _cappedMaxSize is
-     * exceeded. Generates oplog entries for the deleted records in FCV >= 5.0.
+     * exceeded. Generates oplog entries for the deleted records in FCV >= 5.0. Never deletes
+     * 'justInserted', which is null when called by the CappedDeleter. With
+     * 'cappedDeleteInBackground', an insert leaves the deletes to the CappedDeleter instead while
+     * the collection is within its overflow allowance. Returns the number of records deleted.
      */
-    void _cappedDeleteAsNeeded(OperationContext* opCtx, const RecordId& justInserted) const;
+    long long _cappedDeleteAsNeeded(OperationContext* opCtx, const RecordId& justInserted) const;
 
     /**
      * Writes metadata to the DurableCatalog. Func should have the function signature
@@ -138,6 +138,15 @@ public:
         std::abort();
     }
 
+    void deleteDocuments(OperationContext* opCtx,
+                         const std::vector<BsonRecord>& bsonRecords,
+                         StmtId stmtId,
+                         OpDebug* opDebug,
+                         bool fromMigrate = false,
+                         bool noWarn = false) const {
+        std::abort();
+    }
+
     Status insertDocuments(OperationContext* opCtx,
                            std::vector<InsertStatement>::const_iterator begin,
                            std::vector<InsertStatement>::const_iterator end,
@@ -266,6 +275,10 @@ public:
         std::abort();
     }
 
+    long long deleteCappedOverflow(OperationContext* opCtx) const {
+        std::abort();
+    }
+
     long long getCappedMaxSize() const {
         std::abort();
     }
@@ -35,13 +35,16 @@
 
 #include <fmt/format.h>
 
+#include "mongo/bson/bson_validate.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_consistency.h"
+#include "mongo/db/catalog/throttle_cursor.h"
 #include "mongo/db/catalog/validate_adaptor.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/storage/execution_context.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
@@ -228,6 +231,99 @@ void _gatherIndexEntryErrors(OperationContext* opCtx,
     indexConsistency->addIndexEntryErrors(result);
 }
 
+/**
+ * Checks that every index has the keys of up to 'sampleSize' distinct records picked at random,
+ * instead of traversing the whole record store and every index. Index entries which do not belong
+ * to any record are not detected.
+ */
+Status _validateSampledRecords(OperationContext* opCtx,
+                               ValidateState* validateState,
+                               long long sampleSize,
+                               ValidateResults* results,
+                               BSONObjBuilder* output) {
+    const CollectionPtr& coll = validateState->getCollection();
+    auto cursor = coll->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return {ErrorCodes::CommandNotSupported,
+                "The storage engine does not support validating a sample of the records"};
+    }
+
+    // The random cursor may return a record more than once, so give up on finding 'sampleSize'
+    // distinct records after twice as many attempts.
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+    stdx::unordered_set<RecordId, RecordId::Hasher> sampled;
+    long long numInvalidDocuments = 0;
+    std::map<std::string, long long> numMissingKeys;
+    for (long long attempts = 0;
+         static_cast<long long>(sampled.size()) < sampleSize && attempts < 2 * sampleSize;
+         ++attempts) {
+        opCtx->checkForInterrupt();
+
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        if (!sampled.insert(record->id).second) {
+            continue;
+        }
+
+        if (!validateBSON(record->data.data(), record->data.size()).isOK()) {
+            ++numInvalidDocuments;
+            continue;
+        }
+        const BSONObj recordBson = record->data.toBson();
+
+        for (const auto& index : validateState->getIndexes()) {
+            const IndexDescriptor* descriptor = index->descriptor();
+            if (descriptor->isPartial() && !index->getFilterExpression()->matchesBSON(recordBson)) {
+                continue;
+            }
+
+            auto documentKeySet = executionCtx.keys();
+            auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+            auto documentMultikeyPaths = executionCtx.multikeyPaths();
+            index->accessMethod()->getKeys(opCtx,
+                                           coll,
+                                           executionCtx.pooledBufferBuilder(),
+                                           recordBson,
+                                           IndexAccessMethod::GetKeysMode::kEnforceConstraints,
+                                           IndexAccessMethod::GetKeysContext::kAddingKeys,
+                                           documentKeySet.get(),
+                                           multikeyMetadataKeys.get(),
+                                           documentMultikeyPaths.get(),
+                                           record->id,
+                                           IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+            const auto& indexName = descriptor->indexName();
+            const auto& indexCursor = validateState->getIndexCursors().at(indexName);
+            results->indexResultsMap[indexName].keysTraversed += documentKeySet->size();
+            for (const auto& key : *documentKeySet) {
+                auto indexEntry = indexCursor->seekForKeyString(opCtx, key);
+                if (!indexEntry || indexEntry->keyString.compare(key) != 0) {
+                    ++numMissingKeys[indexName];
+                }
+            }
+        }
+    }
+
+    output->appendNumber("nSampled", static_cast<long long>(sampled.size()));
+    output->appendNumber("nInvalidDocuments", numInvalidDocuments);
+    if (numInvalidDocuments > 0) {
+        results->valid = false;
+        results->errors.push_back(str::stream() << "Detected " << numInvalidDocuments
+                                                << " invalid documents among the sampled records.");
+    }
+    for (const auto& [indexName, numMissing] : numMissingKeys) {
+        auto& indexResults = results->indexResultsMap[indexName];
+        indexResults.valid = false;
+        results->valid = false;
+        indexResults.errors.push_back(str::stream()
+                                      << "Index " << indexName << " is missing " << numMissing
+                                      << " keys of the sampled records.");
+    }
+    return Status::OK();
+}
+
 void _validateIndexKeyCount(OperationContext* opCtx,
                             ValidateState* validateState,
                             ValidateAdaptor* indexValidator,
@@ -433,7 +529,8 @@ Status validate(OperationContext* opCtx,
                 RepairMode repairMode,
                 ValidateResults* results,
                 BSONObjBuilder* output,
-                bool turnOnExtraLoggingForTest) {
+                bool turnOnExtraLoggingForTest,
+                boost::optional<long long> sampleSize) {
     invariant(!opCtx->lockState()->isLocked() || storageGlobalParams.repair);
 
     // This is deliberately outside of the try-catch block, so that any errors thrown in the
@@ -512,6 +609,20 @@ Status validate(OperationContext* opCtx,
                       "namespace"_attr = validateState.nss(),
                       "uuid"_attr = uuidString);
 
+        if (sampleSize) {
+            auto status =
+                _validateSampledRecords(opCtx, &validateState, *sampleSize, results, output);
+            if (!status.isOK()) {
+                return status;
+            }
+            if (!results->valid) {
+                _reportInvalidResults(opCtx, &validateState, results, output, uuidString);
+                return Status::OK();
+            }
+            _reportValidationResults(opCtx, &validateState, results, output);
+            return Status::OK();
+        }
+
         IndexConsistency indexConsistency(opCtx, &validateState);
         ValidateAdaptor indexValidator(&indexConsistency, &validateState);
 
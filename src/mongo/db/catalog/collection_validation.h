@@ -88,6 +88,10 @@ enum class RepairMode {
  * The combination of background = true and options of anything other than kNoFullValidation is
  * prohibited.
  *
+ * If 'sampleSize' is set, only checks that the indexes have the keys of that many records picked
+ * at random, rather than comparing every record with every index entry. This is incompatible with
+ * full validation and repair.
+ *
  * @return OK if the validate run successfully
  *         OK will be returned even if corruption is found
  *         details will be in 'results'.
@@ -98,7 +102,8 @@ Status validate(OperationContext* opCtx,
                 RepairMode repairMode,
                 ValidateResults* results,
                 BSONObjBuilder* output,
-                bool turnOnExtraLoggingForTest = false);
+                bool turnOnExtraLoggingForTest = false,
+                boost::optional<long long> sampleSize = boost::none);
 
 /**
  * Checks whether a failpoint has been hit in the above validate() code..
@@ -316,5 +316,76 @@ TEST_F(BackgroundCollectionValidationTest, BackgroundValidateRunsConcurrentlyWit
                        0);
 }
 
+/**
+ * Calls validate on collection kNss with a sample of 'sampleSize' records and returns the output.
+ */
+BSONObj sampledValidate(OperationContext* opCtx,
+                        long long sampleSize,
+                        bool valid,
+                        int numInvalidDocuments,
+                        int numErrors) {
+    ValidateResults validateResults;
+    BSONObjBuilder output;
+    ASSERT_OK(CollectionValidation::validate(opCtx,
+                                             kNss,
+                                             CollectionValidation::ValidateMode::kForeground,
+                                             CollectionValidation::RepairMode::kNone,
+                                             &validateResults,
+                                             &output,
+                                             /*turnOnExtraLoggingForTest=*/false,
+                                             sampleSize));
+    ASSERT_EQ(validateResults.valid, valid);
+    ASSERT_EQ(validateResults.errors.size(), static_cast<long unsigned int>(numErrors));
+
+    BSONObj obj = output.obj();
+    ASSERT_EQ(obj.getIntField("nInvalidDocuments"), numInvalidDocuments);
+    return obj;
+}
+
+TEST_F(BackgroundCollectionValidationTest, SampledValidate) {
+    auto opCtx = operationContext();
+    int numRecords = insertDataRange(opCtx, 0, 20);
+
+    BSONObj obj = sampledValidate(opCtx,
+                                  /*sampleSize*/ 10,
+                                  /*valid*/ true,
+                                  /*numInvalidDocuments*/ 0,
+                                  /*numErrors*/ 0);
+    ASSERT_GT(obj.getIntField("nSampled"), 0);
+    ASSERT_LTE(obj.getIntField("nSampled"), 10);
+    ASSERT_LTE(obj.getObjectField("keysPerIndex").getIntField("_id_"), numRecords);
+}
+
+TEST_F(BackgroundCollectionValidationTest, SampledValidateError) {
+    auto opCtx = operationContext();
+    setUpInvalidData(opCtx);
+
+    BSONObj obj = sampledValidate(opCtx,
+                                  /*sampleSize*/ 1,
+                                  /*valid*/ false,
+                                  /*numInvalidDocuments*/ 1,
+                                  /*numErrors*/ 1);
+    ASSERT_EQ(obj.getIntField("nSampled"), 1);
+}
+
+// The ephemeralForTest storage engine cannot pick records at random.
+TEST_F(CollectionValidationTest, SampledValidateNotSupported) {
+    auto opCtx = operationContext();
+    insertDataRange(opCtx, 0, 5);
+
+    ValidateResults validateResults;
+    BSONObjBuilder output;
+    ASSERT_EQ(CollectionValidation::validate(opCtx,
+                                             kNss,
+                                             CollectionValidation::ValidateMode::kForeground,
+                                             CollectionValidation::RepairMode::kNone,
+                                             &validateResults,
+                                             &output,
+                                             /*turnOnExtraLoggingForTest=*/false,
+                                             /*sampleSize=*/5)
+                  .code(),
+              ErrorCodes::CommandNotSupported);
+}
+
 }  // namespace
 }  // namespace mongo
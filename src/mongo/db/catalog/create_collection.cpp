@@ -52,7 +52,10 @@
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/timeseries/timeseries_options.h"
+#include "mongo/db/timeseries/timeseries_rollup.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/idl/command_generic_argument.h"
 #include "mongo/logv2/log.h"
@@ -146,6 +149,13 @@ Status _createTimeseries(OperationContext* opCtx,
                 maxSpanSeconds == options.timeseries->getBucketMaxSpanSeconds());
     options.timeseries->setBucketMaxSpanSeconds(maxSpanSeconds);
 
+    if (options.timeseries->getRollup()) {
+        uassert(ErrorCodes::InvalidOptions,
+                "Time-series rollups are not enabled",
+                feature_flags::gTimeseriesRollups.isEnabledAndIgnoreFCV());
+        uassertStatusOK(timeseries::validateRollup(ns, *options.timeseries));
+    }
+
     // Set the validator option to a JSON schema enforcing constraints on bucket documents.
     // This validation is only structural to prevent accidental corruption by users and
     // cannot cover all constraints. Leave the validationLevel and validationAction to their
@@ -395,9 +405,17 @@ Status _createCollection(OperationContext* opCtx,
         }
 
         if (collectionOptions.clusteredIndex && !nss.isTimeseriesBucketsCollection()) {
-            return Status(
-                ErrorCodes::InvalidOptions,
-                "The 'clusteredIndex' option is only supported on time-series buckets collections");
+            if (!feature_flags::gClusteredIndexes.isEnabled(
+                    serverGlobalParams.featureCompatibility)) {
+                return Status(ErrorCodes::InvalidOptions,
+                              "The 'clusteredIndex' option is only supported on time-series "
+                              "buckets collections");
+            }
+            if (collectionOptions.capped) {
+                return Status(ErrorCodes::InvalidOptions,
+                              "The 'clusteredIndex' option is not supported with the 'capped' "
+                              "option");
+            }
         }
 
         if (collectionOptions.clusteredIndex && idIndex && !idIndex->isEmpty()) {
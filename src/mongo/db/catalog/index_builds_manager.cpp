@@ -123,10 +123,12 @@ Status IndexBuildsManager::setUpIndexBuild(OperationContext* opCtx,
 Status IndexBuildsManager::startBuildingIndex(OperationContext* opCtx,
                                               const CollectionPtr& collection,
                                               const UUID& buildUUID,
-                                              boost::optional<RecordId> resumeAfterRecordId) {
+                                              boost::optional<RecordId> resumeAfterRecordId,
+                                              bool isResumable) {
     auto builder = invariant(_getBuilder(buildUUID));
 
-    return builder->insertAllDocumentsInCollection(opCtx, collection, resumeAfterRecordId);
+    return builder->insertAllDocumentsInCollection(
+        opCtx, collection, resumeAfterRecordId, isResumable);
 }
 
 Status IndexBuildsManager::resumeBuildingIndexFromBulkLoadPhase(OperationContext* opCtx,
@@ -276,6 +278,12 @@ Status IndexBuildsManager::drainBackgroundWrites(
     return builder->drainBackgroundWrites(opCtx, readSource, drainYieldPolicy);
 }
 
+int64_t IndexBuildsManager::getPendingSideWritesEstimate(OperationContext* opCtx,
+                                                         const UUID& buildUUID) {
+    auto builder = invariant(_getBuilder(buildUUID));
+    return builder->getPendingSideWritesEstimate(opCtx);
+}
+
 Status IndexBuildsManager::retrySkippedRecords(OperationContext* opCtx,
                                                const UUID& buildUUID,
                                                const CollectionPtr& collection) {
@@ -95,12 +95,14 @@ public:
     void unregisterIndexBuild(const UUID& buildUUID);
 
     /**
-     * Runs the scanning/insertion phase of the index build..
+     * Runs the scanning/insertion phase of the index build. Resumable builds checkpoint their
+     * progress on disk during the collection scan.
      */
     Status startBuildingIndex(OperationContext* opCtx,
                               const CollectionPtr& collection,
                               const UUID& buildUUID,
-                              boost::optional<RecordId> resumeAfterRecordId = boost::none);
+                              boost::optional<RecordId> resumeAfterRecordId = boost::none,
+                              bool isResumable = false);
 
     Status resumeBuildingIndexFromBulkLoadPhase(OperationContext* opCtx,
                                                 const CollectionPtr& collection,
@@ -127,6 +129,11 @@ public:
                                  RecoveryUnit::ReadSource readSource,
                                  IndexBuildInterceptor::DrainYieldPolicy drainYieldPolicy);
 
+    /**
+     * Returns an estimate of the number of side writes the build has left to drain.
+     */
+    int64_t getPendingSideWritesEstimate(OperationContext* opCtx, const UUID& buildUUID);
+
     /**
      * Retries the key generation and insertion of records that were skipped during the scanning
      * phase due to error suppression.
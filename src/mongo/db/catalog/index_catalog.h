@@ -477,11 +477,16 @@ public:
                                const bool noWarn,
                                int64_t* const keysDeletedOut) const = 0;
 
-    /*
-     * Attempt compaction on all ready indexes to regain disk space, if the storage engine's index
-     * supports compaction in-place.
+    /**
+     * Like unindexRecord(), for all of 'bsonRecords' at once. The keys of the records are removed
+     * from each ready index in key order, so that every index is walked once per call rather than
+     * once per record.
      */
-    virtual Status compactIndexes(OperationContext* opCtx) const = 0;
+    virtual void unindexRecords(OperationContext* const opCtx,
+                                const CollectionPtr& collection,
+                                const std::vector<BsonRecord>& bsonRecords,
+                                const bool noWarn,
+                                int64_t* const keysDeletedOut) const = 0;
 
     virtual std::string getAccessMethodName(const BSONObj& keyPattern) = 0;
 
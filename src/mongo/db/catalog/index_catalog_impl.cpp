@@ -1375,6 +1375,17 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
 
+    // When every record in the batch shares one commit timestamp, the keys of the whole batch can
+    // be written to the index in a single sorted pass. Hybrid builds write to the side table per
+    // record and keep the per-record path.
+    if (bsonRecords.size() > 1 && !index->isHybridBuilding() &&
+        std::all_of(bsonRecords.begin() + 1, bsonRecords.end(), [&](const BsonRecord& rec) {
+            return rec.ts == bsonRecords.front().ts;
+        })) {
+        return _indexFilteredRecordsBatched(
+            opCtx, coll, index, bsonRecords, options, keysInsertedOut);
+    }
+
     for (auto bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
 
@@ -1418,6 +1429,68 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexCatalogImpl::_indexFilteredRecordsBatched(OperationContext* opCtx,
+                                                      const CollectionPtr& coll,
+                                                      const IndexCatalogEntry* index,
+                                                      const std::vector<BsonRecord>& bsonRecords,
+                                                      const InsertDeleteOptions& options,
+                                                      int64_t* keysInsertedOut) const {
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+    auto iam = index->accessMethod();
+
+    const Timestamp& ts = bsonRecords.front().ts;
+    if (!ts.isNull()) {
+        Status status = opCtx->recoveryUnit()->setTimestamp(ts);
+        if (!status.isOK())
+            return status;
+    }
+
+    // Every key already carries its RecordId, so the keys of different records never collide and
+    // can be gathered into one set. Multikey state is still tracked per record.
+    std::vector<KeyString::Value> allKeys;
+    int64_t numMultikeyMetadataKeys = 0;
+    for (const auto& bsonRecord : bsonRecords) {
+        invariant(bsonRecord.id != RecordId());
+
+        auto keys = executionCtx.keys();
+        auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto multikeyPaths = executionCtx.multikeyPaths();
+
+        iam->getKeys(opCtx,
+                     coll,
+                     executionCtx.pooledBufferBuilder(),
+                     *bsonRecord.docPtr,
+                     options.getKeysMode,
+                     IndexAccessMethod::GetKeysContext::kAddingKeys,
+                     keys.get(),
+                     multikeyMetadataKeys.get(),
+                     multikeyPaths.get(),
+                     bsonRecord.id,
+                     IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        if (iam->shouldMarkIndexAsMultikey(keys->size(), *multikeyMetadataKeys, *multikeyPaths)) {
+            index->setMultikey(opCtx, coll, *multikeyMetadataKeys, *multikeyPaths);
+        }
+        numMultikeyMetadataKeys += multikeyMetadataKeys->size();
+        allKeys.insert(allKeys.end(), keys->begin(), keys->end());
+    }
+
+    std::sort(allKeys.begin(), allKeys.end());
+    KeyStringSet sortedKeys;
+    sortedKeys.insert(boost::container::ordered_unique_range, allKeys.begin(), allKeys.end());
+
+    int64_t numInserted;
+    Status status =
+        iam->insertKeys(opCtx, coll, sortedKeys, RecordId(), options, nullptr, &numInserted);
+    if (!status.isOK()) {
+        return status;
+    }
+    if (keysInsertedOut) {
+        *keysInsertedOut += numInserted + numMultikeyMetadataKeys;
+    }
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        const CollectionPtr& coll,
                                        const IndexCatalogEntry* index,
@@ -1585,6 +1658,53 @@ void IndexCatalogImpl::_unindexRecord(OperationContext* opCtx,
     _unindexKeys(opCtx, collection, entry, *keys, obj, loc, logIfError, keysDeletedOut);
 }
 
+void IndexCatalogImpl::_unindexRecords(OperationContext* opCtx,
+                                       const CollectionPtr& collection,
+                                       const IndexCatalogEntry* entry,
+                                       const std::vector<BsonRecord>& bsonRecords,
+                                       bool logIfError,
+                                       int64_t* keysDeletedOut) const {
+    if (auto failpoint = skipUnindexingDocumentWhenDeleted.scoped();
+        MONGO_unlikely(failpoint.isActive())) {
+        auto indexName = failpoint.getData()["indexName"].valueStringDataSafe();
+        if (indexName == entry->descriptor()->indexName()) {
+            return;
+        }
+    }
+
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+
+    // The keys of all records are sorted together, so that the index is walked once in key order.
+    KeyStringSet::sequence_type batchKeys;
+    auto keys = executionCtx.keys();
+    for (auto&& bsonRecord : bsonRecords) {
+        keys->clear();
+        entry->accessMethod()->getKeys(opCtx,
+                                       collection,
+                                       executionCtx.pooledBufferBuilder(),
+                                       *bsonRecord.docPtr,
+                                       IndexAccessMethod::GetKeysMode::kRelaxConstraintsUnfiltered,
+                                       IndexAccessMethod::GetKeysContext::kRemovingKeys,
+                                       keys.get(),
+                                       nullptr,
+                                       nullptr,
+                                       bsonRecord.id,
+                                       IndexAccessMethod::kNoopOnSuppressedErrorFn);
+        batchKeys.insert(batchKeys.end(), keys->begin(), keys->end());
+    }
+
+    KeyStringSet sortedKeys;
+    sortedKeys.adopt_sequence(std::move(batchKeys));
+    _unindexKeys(opCtx,
+                 collection,
+                 entry,
+                 sortedKeys,
+                 *bsonRecords.front().docPtr,
+                 bsonRecords.front().id,
+                 logIfError,
+                 keysDeletedOut);
+}
+
 Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
                                       const CollectionPtr& coll,
                                       const std::vector<BsonRecord>& bsonRecords,
@@ -1672,26 +1792,39 @@ void IndexCatalogImpl::unindexRecord(OperationContext* opCtx,
     }
 }
 
-Status IndexCatalogImpl::compactIndexes(OperationContext* opCtx) const {
-    for (IndexCatalogEntryContainer::const_iterator it = _readyIndexes.begin();
-         it != _readyIndexes.end();
-         ++it) {
-        IndexCatalogEntry* entry = it->get();
+void IndexCatalogImpl::unindexRecords(OperationContext* opCtx,
+                                      const CollectionPtr& collection,
+                                      const std::vector<BsonRecord>& bsonRecords,
+                                      bool noWarn,
+                                      int64_t* keysDeletedOut) const {
+    if (keysDeletedOut) {
+        *keysDeletedOut = 0;
+    }
 
-        LOGV2_DEBUG(20363,
-                    1,
-                    "compacting index: {entry_descriptor}",
-                    "entry_descriptor"_attr = *(entry->descriptor()));
-        Status status = entry->accessMethod()->compact(opCtx);
-        if (!status.isOK()) {
-            LOGV2_ERROR(20377,
-                        "Failed to compact index",
-                        "index"_attr = *(entry->descriptor()),
-                        "error"_attr = redact(status));
-            return status;
+    if (bsonRecords.empty()) {
+        return;
+    }
+
+    for (auto&& it : _readyIndexes) {
+        _unindexRecords(opCtx, collection, it.get(), bsonRecords, !noWarn, keysDeletedOut);
+    }
+
+    // Building indexes may send their keys to the side table, which takes one record at a time.
+    for (auto&& it : _buildingIndexes) {
+        IndexCatalogEntry* entry = it.get();
+
+        // If it's a background index, we DO NOT want to log anything.
+        bool logIfError = entry->isReady(opCtx, collection) ? !noWarn : false;
+        for (auto&& bsonRecord : bsonRecords) {
+            _unindexRecord(opCtx,
+                           collection,
+                           entry,
+                           *bsonRecord.docPtr,
+                           bsonRecord.id,
+                           logIfError,
+                           keysDeletedOut);
         }
     }
-    return Status::OK();
 }
 
 std::string::size_type IndexCatalogImpl::getLongestIndexNameLength(OperationContext* opCtx) const {
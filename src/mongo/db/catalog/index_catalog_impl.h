@@ -283,7 +283,11 @@ public:
                        bool noWarn,
                        int64_t* keysDeletedOut) const override;
 
-    Status compactIndexes(OperationContext* opCtx) const override;
+    void unindexRecords(OperationContext* opCtx,
+                        const CollectionPtr& collection,
+                        const std::vector<BsonRecord>& bsonRecords,
+                        bool noWarn,
+                        int64_t* keysDeletedOut) const override;
 
     inline std::string getAccessMethodName(const BSONObj& keyPattern) override {
         return _getAccessMethodName(keyPattern);
@@ -336,6 +340,17 @@ private:
                                  const std::vector<BsonRecord>& bsonRecords,
                                  int64_t* keysInsertedOut) const;
 
+    /**
+     * Inserts the keys of all 'bsonRecords', which must share one timestamp, into 'index' in
+     * KeyString order.
+     */
+    Status _indexFilteredRecordsBatched(OperationContext* opCtx,
+                                        const CollectionPtr& coll,
+                                        const IndexCatalogEntry* index,
+                                        const std::vector<BsonRecord>& bsonRecords,
+                                        const InsertDeleteOptions& options,
+                                        int64_t* keysInsertedOut) const;
+
     Status _indexRecords(OperationContext* opCtx,
                          const CollectionPtr& coll,
                          const IndexCatalogEntry* index,
@@ -368,6 +383,13 @@ private:
                         bool logIfError,
                         int64_t* keysDeletedOut) const;
 
+    void _unindexRecords(OperationContext* opCtx,
+                         const CollectionPtr& collection,
+                         const IndexCatalogEntry* entry,
+                         const std::vector<BsonRecord>& bsonRecords,
+                         bool logIfError,
+                         int64_t* keysDeletedOut) const;
+
     /**
      * Helper to remove the index from disk.
      * The index should be removed from the in-memory catalog beforehand.
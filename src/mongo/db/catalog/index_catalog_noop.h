@@ -222,10 +222,6 @@ public:
                        const bool noWarn,
                        int64_t* const keysDeletedOut) override {}
 
-    virtual Status compactIndexes(OperationContext* opCtx) override {
-        return Status::OK();
-    }
-
     std::string getAccessMethodName(const BSONObj& keyPattern) override {
         return "";
     }
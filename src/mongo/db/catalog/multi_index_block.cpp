@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/multi_index_block.h"
 
+#include <boost/container/small_vector.hpp>
 #include <ostream>
 
 #include "mongo/base/error_codes.h"
@@ -51,6 +52,7 @@
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/tenant_migration_conflict_info.h"
+#include "mongo/db/storage/storage_file_util.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
@@ -117,6 +119,7 @@ void MultiIndexBlock::abortIndexBuild(OperationContext* opCtx,
                 _indexes[i].block->finalizeTemporaryTables(
                     opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
             }
+            _dropCheckpointedState(opCtx);
 
             onCleanUp();
 
@@ -312,6 +315,14 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(
                       eachIndexBuildMaxMemoryUsageBytes / 1024 / 1024);
 
             index.filterExpression = indexCatalogEntry->getFilterExpression();
+            index.filterOwner = _indexes.size() - 1;
+            if (index.filterExpression) {
+                auto sameFilter = std::find_if(_indexes.begin(), _indexes.end() - 1, [&](auto& i) {
+                    return i.filterExpression &&
+                        i.filterExpression->equivalent(index.filterExpression);
+                });
+                index.filterOwner = sameFilter - _indexes.begin();
+            }
         }
 
         opCtx->recoveryUnit()->onCommit([ns = collection->ns(), this](auto commitTs) {
@@ -351,7 +362,8 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(
 Status MultiIndexBlock::insertAllDocumentsInCollection(
     OperationContext* opCtx,
     const CollectionPtr& collection,
-    boost::optional<RecordId> resumeAfterRecordId) {
+    boost::optional<RecordId> resumeAfterRecordId,
+    bool isResumable) {
     invariant(!_buildIsCleanedUp);
     invariant(opCtx->lockState()->isNoop() || !opCtx->lockState()->inAWriteUnitOfWork());
 
@@ -433,7 +445,8 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
             _doCollectionScan(opCtx,
                               collection,
                               numScanRestarts == 0 ? resumeAfterRecordId : boost::none,
-                              &progress);
+                              &progress,
+                              isResumable);
 
             LOGV2(20391,
                   "Index build: collection scan done",
@@ -470,6 +483,13 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
                     "error"_attr = ex);
 
                 _lastRecordIdInserted = boost::none;
+                {
+                    // The sorter files referred to by the checkpointed state go away with the
+                    // bulk builders.
+                    WriteUnitOfWork wuow(opCtx);
+                    _dropCheckpointedState(opCtx);
+                    wuow.commit();
+                }
                 for (auto& index : _indexes) {
                     index.bulk = index.real->initiateBulk(
                         getEachIndexBuildMaxMemoryUsageBytes(_indexes.size()),
@@ -544,6 +564,14 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
 
     progress.finished();
 
+    {
+        // The checkpointed state describes a collection scan, so it must not be used once keys
+        // have been loaded into the index.
+        WriteUnitOfWork wuow(opCtx);
+        _dropCheckpointedState(opCtx);
+        wuow.commit();
+    }
+
     Status ret = dumpInsertsFromBulk(opCtx, collection);
     if (!ret.isOK())
         return ret;
@@ -554,7 +582,8 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
 void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
                                         const CollectionPtr& collection,
                                         boost::optional<RecordId> resumeAfterRecordId,
-                                        ProgressMeterHolder* progress) {
+                                        ProgressMeterHolder* progress,
+                                        bool isResumable) {
     PlanYieldPolicy::YieldPolicy yieldPolicy;
     if (isBackgroundBuilding()) {
         yieldPolicy = PlanYieldPolicy::YieldPolicy::YIELD_AUTO;
@@ -572,6 +601,9 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
               IndexBuildPhase_serializer(_phase).toString());
     _phase = IndexBuildPhaseEnum::kCollectionScan;
 
+    auto clockSource = opCtx->getServiceContext()->getFastClockSource();
+    Date_t lastCheckpoint = clockSource->now();
+
     BSONObj objToIndex;
     RecordId loc;
     PlanExecutor::ExecState state;
@@ -605,6 +637,18 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
 
         // Go to the next document.
         progress->hit();
+
+        if (isResumable) {
+            const Seconds checkpointInterval{resumableIndexBuildCheckpointIntervalSecs.load()};
+            if (checkpointInterval > Seconds(0) &&
+                clockSource->now() - lastCheckpoint >= checkpointInterval) {
+                exec->saveState();
+                opCtx->recoveryUnit()->abandonSnapshot();
+                _checkpointStateToDisk(opCtx, collection);
+                exec->restoreState(&collection);
+                lastCheckpoint = clockSource->now();
+            }
+        }
     }
 }
 
@@ -621,9 +665,14 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx,
                                 const BSONObj& doc,
                                 const RecordId& loc) {
     invariant(!_buildIsCleanedUp);
+    boost::container::small_vector<bool, 8> matchesFilter(_indexes.size());
     for (size_t i = 0; i < _indexes.size(); i++) {
-        if (_indexes[i].filterExpression && !_indexes[i].filterExpression->matchesBSON(doc)) {
-            continue;
+        if (_indexes[i].filterExpression) {
+            const size_t owner = _indexes[i].filterOwner;
+            matchesFilter[i] = owner == i ? _indexes[i].filterExpression->matchesBSON(doc)
+                                          : matchesFilter[owner];
+            if (!matchesFilter[i])
+                continue;
         }
 
         Status idxStatus = Status::OK();
@@ -763,6 +812,20 @@ Status MultiIndexBlock::drainBackgroundWrites(
     return Status::OK();
 }
 
+int64_t MultiIndexBlock::getPendingSideWritesEstimate(OperationContext* opCtx) const {
+    invariant(!_buildIsCleanedUp);
+    const CollectionPtr& coll =
+        CollectionCatalog::get(opCtx)->lookupCollectionByUUID(opCtx, _collectionUUID.get());
+
+    int64_t pending = 0;
+    for (const auto& index : _indexes) {
+        if (auto interceptor = index.block->getEntry(opCtx, coll)->indexBuildInterceptor()) {
+            pending += interceptor->getPendingWritesEstimate();
+        }
+    }
+    return pending;
+}
+
 Status MultiIndexBlock::retrySkippedRecords(OperationContext* opCtx,
                                             const CollectionPtr& collection) {
     invariant(!_buildIsCleanedUp);
@@ -886,6 +949,14 @@ void MultiIndexBlock::abortWithoutCleanup(OperationContext* opCtx,
         lk.emplace(opCtx, MODE_IX);
     }
 
+    {
+        // Any state written below supersedes the checkpointed state. Remove the checkpoint first
+        // so that the two are never found together.
+        WriteUnitOfWork wuow(opCtx);
+        _dropCheckpointedState(opCtx);
+        wuow.commit();
+    }
+
     auto action = TemporaryRecordStore::FinalizationAction::kDelete;
 
     if (isResumable) {
@@ -947,8 +1018,61 @@ void MultiIndexBlock::_writeStateToDisk(OperationContext* opCtx,
     rs->finalizeTemporaryTable(opCtx, TemporaryRecordStore::FinalizationAction::kKeep);
 }
 
+void MultiIndexBlock::_checkpointStateToDisk(OperationContext* opCtx,
+                                             const CollectionPtr& collection) {
+    invariant(_phase == IndexBuildPhaseEnum::kCollectionScan);
+
+    auto obj = _constructStateObject(opCtx, collection, /*forCheckpoint=*/true);
+    if (!_checkpointStateTable) {
+        _checkpointStateTable = opCtx->getServiceContext()
+                                    ->getStorageEngine()
+                                    ->makeTemporaryRecordStoreForResumableIndexBuild(opCtx);
+    }
+    auto rs = _checkpointStateTable->rs();
+
+    WriteUnitOfWork wuow(opCtx);
+    if (_checkpointStateRecordId.isNull()) {
+        auto recordId = uassertStatusOK(
+            rs->insertRecord(opCtx, obj.objdata(), obj.objsize(), Timestamp()));
+        wuow.commit();
+        _checkpointStateRecordId = recordId;
+    } else {
+        uassertStatusOK(
+            rs->updateRecord(opCtx, _checkpointStateRecordId, obj.objdata(), obj.objsize()));
+        wuow.commit();
+    }
+
+    LOGV2_DEBUG(6107500,
+                1,
+                "Index build: checkpointed resumable state to disk",
+                "buildUUID"_attr = _buildUUID,
+                "collectionUUID"_attr = _collectionUUID,
+                logAttrs(collection->ns()),
+                "details"_attr = obj);
+}
+
+void MultiIndexBlock::_dropCheckpointedState(OperationContext* opCtx) {
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+    if (!_checkpointStateTable) {
+        return;
+    }
+
+    // Dropping the table may be deferred by the storage engine, so delete the state in this
+    // WriteUnitOfWork to guarantee that it can no longer be found.
+    if (!_checkpointStateRecordId.isNull()) {
+        _checkpointStateTable->rs()->deleteRecord(opCtx, _checkpointStateRecordId);
+    }
+    _checkpointStateTable->finalizeTemporaryTable(
+        opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
+    opCtx->recoveryUnit()->onCommit([this](boost::optional<Timestamp>) {
+        _checkpointStateTable.reset();
+        _checkpointStateRecordId = RecordId();
+    });
+}
+
 BSONObj MultiIndexBlock::_constructStateObject(OperationContext* opCtx,
-                                               const CollectionPtr& collection) const {
+                                               const CollectionPtr& collection,
+                                               bool forCheckpoint) const {
     BSONObjBuilder builder;
     _buildUUID->appendToBuilder(&builder, "_id");
     builder.append("phase", IndexBuildPhase_serializer(_phase));
@@ -970,7 +1094,15 @@ BSONObj MultiIndexBlock::_constructStateObject(OperationContext* opCtx,
         if (_phase != IndexBuildPhaseEnum::kDrainWrites) {
             // Persist the data to disk so that we see all of the data that has been inserted into
             // the Sorter.
-            auto state = index.bulk->persistDataForShutdown();
+            auto state = forCheckpoint ? index.bulk->persistDataForCheckpoint()
+                                       : index.bulk->persistDataForShutdown();
+
+            // A checkpoint is only read after an unclean shutdown, so the data it refers to must
+            // be durable before the checkpoint itself.
+            if (forCheckpoint && !state.ranges.empty()) {
+                uassertStatusOK(fsyncFile(boost::filesystem::path(storageGlobalParams.dbpath) /
+                                          "_tmp" / state.fileName));
+            }
 
             indexInfo.append("fileName", state.fileName);
             indexInfo.append("numKeys", index.bulk->getKeysInserted());
@@ -48,6 +48,7 @@
 #include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/resumable_index_builds_gen.h"
+#include "mongo/db/storage/temporary_record_store.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
 
@@ -152,11 +153,16 @@ public:
      * Can throw an exception if interrupted.
      *
      * Should not be called inside of a WriteUnitOfWork.
+     *
+     * If 'isResumable' is true, the collection scan position and sorter state are periodically
+     * written to disk, as configured by 'resumableIndexBuildCheckpointIntervalSecs', so that the
+     * build can be resumed after an unclean shutdown.
      */
     Status insertAllDocumentsInCollection(
         OperationContext* opCtx,
         const CollectionPtr& collection,
-        boost::optional<RecordId> resumeAfterRecordId = boost::none);
+        boost::optional<RecordId> resumeAfterRecordId = boost::none,
+        bool isResumable = false);
 
     /**
      * Call this after init() for each document in the collection.
@@ -201,6 +207,11 @@ public:
                                  RecoveryUnit::ReadSource readSource,
                                  IndexBuildInterceptor::DrainYieldPolicy drainYieldPolicy);
 
+    /**
+     * Returns an estimate of the number of side writes left to drain, summed across all of the
+     * indexes being built. See IndexBuildInterceptor::getPendingWritesEstimate().
+     */
+    int64_t getPendingSideWritesEstimate(OperationContext* opCtx) const;
 
     /**
      * Retries key generation and insertion for all records skipped during the collection scanning
@@ -297,6 +308,9 @@ private:
 
         IndexAccessMethod* real = nullptr;        // owned elsewhere
         const MatchExpression* filterExpression;  // might be NULL, owned elsewhere
+        // Position in '_indexes' of the first index whose filter is equivalent to this one's.
+        // Each document is matched only once against each distinct filter.
+        size_t filterOwner = 0;
         std::unique_ptr<IndexAccessMethod::BulkBuilder> bulk;
 
         InsertDeleteOptions options;
@@ -304,7 +318,24 @@ private:
 
     void _writeStateToDisk(OperationContext* opCtx, const CollectionPtr& collection) const;
 
-    BSONObj _constructStateObject(OperationContext* opCtx, const CollectionPtr& collection) const;
+    /**
+     * Builds the resumable state of this index build. Spills the sorters, and when 'forCheckpoint'
+     * is true, leaves them usable and syncs their files to disk.
+     */
+    BSONObj _constructStateObject(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  bool forCheckpoint = false) const;
+
+    /**
+     * Writes the resumable state of the collection scan in progress to disk, replacing the state
+     * written by the previous checkpoint of this index build.
+     */
+    void _checkpointStateToDisk(OperationContext* opCtx, const CollectionPtr& collection);
+
+    /**
+     * Removes the checkpointed resumable state, if any. Must be called in a WriteUnitOfWork.
+     */
+    void _dropCheckpointedState(OperationContext* opCtx);
 
     Status _failPointHangDuringBuild(OperationContext* opCtx,
                                      FailPoint* fp,
@@ -324,7 +355,8 @@ private:
     void _doCollectionScan(OperationContext* opCtx,
                            const CollectionPtr& collection,
                            boost::optional<RecordId> resumeAfterRecordId,
-                           ProgressMeterHolder* progress);
+                           ProgressMeterHolder* progress,
+                           bool isResumable);
 
     // Is set during init() and ensures subsequent function calls act on the same Collection.
     boost::optional<UUID> _collectionUUID;
@@ -349,5 +381,10 @@ private:
 
     // The current phase of the index build.
     IndexBuildPhaseEnum _phase = IndexBuildPhaseEnum::kInitialized;
+
+    // Holds the resumable state written by the latest checkpoint of the collection scan. Only used
+    // after an unclean shutdown, and removed before the build leaves the collection scan phase.
+    std::unique_ptr<TemporaryRecordStore> _checkpointStateTable;
+    RecordId _checkpointStateRecordId;
 };
 }  // namespace mongo
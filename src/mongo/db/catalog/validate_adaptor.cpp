@@ -665,5 +665,23 @@ void ValidateAdaptor::validateIndexKeyCount(OperationContext* opCtx,
             << " Please re-run the validate command with {full: true}";
         results.warnings.push_back(warning);
     }
+
+    // Correct the number of keys the storage engine maintains for the index, if any, as the fast
+    // count of the collection is corrected after traversing the records. A background validation
+    // reads a checkpoint, which need not agree with the current number of keys.
+    if (_validateState->isBackground()) {
+        return;
+    }
+    auto sortedDataInterface = index->accessMethod()->getSortedDataInterface();
+    const auto fastKeyCount = sortedDataInterface->fastKeyCount(opCtx);
+    if (fastKeyCount && *fastKeyCount != numTotalKeys) {
+        results.warnings.push_back(str::stream()
+                                   << "fast count of keys (" << *fastKeyCount
+                                   << ") does not match number of keys (" << numTotalKeys
+                                   << ") for index '" << indexName << "'");
+    }
+    if (results.valid) {
+        sortedDataInterface->updateKeyCountAfterRepair(opCtx, numTotalKeys);
+    }
 }
 }  // namespace mongo
@@ -67,6 +67,7 @@ static Counter64 cursorStatsOpenNoTimeout;  // gauge
 static Counter64 cursorStatsTimedOut;
 static Counter64 cursorStatsTotalOpened;
 static Counter64 cursorStatsMoreThanOneBatch;
+static Counter64 cursorStatsPrefetchedBytes;  // gauge
 
 static ServerStatusMetricField<Counter64> dCursorStatsOpen("cursor.open.total", &cursorStatsOpen);
 static ServerStatusMetricField<Counter64> dCursorStatsOpenPinned("cursor.open.pinned",
@@ -79,6 +80,8 @@ static ServerStatusMetricField<Counter64> dCursorStatsTotalOpened("cursor.totalO
                                                                   &cursorStatsTotalOpened);
 static ServerStatusMetricField<Counter64> dCursorStatsMoreThanOneBatch(
     "cursor.moreThanOneBatch", &cursorStatsMoreThanOneBatch);
+static ServerStatusMetricField<Counter64> dCursorStatsPrefetchedBytes(
+    "cursor.prefetch.bufferedBytes", &cursorStatsPrefetchedBytes);
 
 ClientCursor::ClientCursor(ClientCursorParams params,
                            CursorId cursorId,
@@ -126,6 +129,27 @@ ClientCursor::~ClientCursor() {
 
     if (_nBatchesReturned > 1)
         cursorStatsMoreThanOneBatch.increment();
+
+    cursorStatsPrefetchedBytes.decrement(_prefetchedBytes);
+}
+
+long long ClientCursor::getTotalPrefetchedBytes() {
+    return cursorStatsPrefetchedBytes.get();
+}
+
+void ClientCursor::popPrefetchedResult() {
+    const auto size = _prefetchedResults.front().objsize();
+    _prefetchedResults.pop_front();
+    _prefetchedBytes -= size;
+    cursorStatsPrefetchedBytes.decrement(size);
+}
+
+void ClientCursor::appendPrefetchedResult(BSONObj obj) {
+    invariant(!_prefetchReachedEOF);
+    const auto size = obj.objsize();
+    _prefetchedResults.push_back(obj.getOwned());
+    _prefetchedBytes += size;
+    cursorStatsPrefetchedBytes.increment(size);
 }
 
 void ClientCursor::markAsKilled(Status killStatus) {
@@ -30,7 +30,9 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 #include <functional>
+#include <list>
 
 #include "mongo/db/api_parameters.h"
 #include "mongo/db/auth/privilege.h"
@@ -41,6 +43,7 @@
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/repl/read_concern_level.h"
+#include "mongo/util/future.h"
 
 namespace mongo {
 
@@ -295,6 +298,46 @@ public:
         return _opKey;
     }
 
+    /**
+     * Results which a CursorPrefetcher produced for the next getMore ahead of time, in the order
+     * they must be returned. The memory they hold is charged to this cursor until they are popped.
+     * The caller must have this cursor pinned.
+     */
+    bool hasPrefetchedResults() const {
+        return !_prefetchedResults.empty();
+    }
+
+    const BSONObj& frontPrefetchedResult() const {
+        return _prefetchedResults.front();
+    }
+
+    void popPrefetchedResult();
+    void appendPrefetchedResult(BSONObj obj);
+
+    /**
+     * Returns the number of bytes held by the prefetched results.
+     */
+    std::size_t getPrefetchedBytes() const {
+        return _prefetchedBytes;
+    }
+
+    /**
+     * Returns the number of bytes held by the prefetched results of all cursors together.
+     */
+    static long long getTotalPrefetchedBytes();
+
+    /**
+     * Whether the prefetch which produced the current prefetched results ran the executor to EOF,
+     * in which case the cursor has no more results once they have been returned.
+     */
+    bool prefetchReachedEOF() const {
+        return _prefetchReachedEOF;
+    }
+
+    void setPrefetchReachedEOF() {
+        _prefetchReachedEOF = true;
+    }
+
 private:
     friend class CursorManager;
     friend class ClientCursorPin;
@@ -412,6 +455,11 @@ private:
     Date_t _lastUseDate;
     Date_t _createdDate;
 
+    // This cursor's position in its CursorManager partition's list of idle cursors, or none if the
+    // cursor is pinned or can never time out. Guarded by the same partition mutex as
+    // '_operationUsingCursor'.
+    boost::optional<std::list<ClientCursor*>::iterator> _idleListPosition;
+
     // A string with the plan summary of the cursor's query.
     std::string _planSummary;
 
@@ -421,6 +469,15 @@ private:
 
     // The client OperationKey associated with this cursor.
     boost::optional<OperationKey> _opKey;
+
+    // Results produced ahead of time by a CursorPrefetcher, and the number of bytes they hold.
+    std::deque<BSONObj> _prefetchedResults;
+    std::size_t _prefetchedBytes = 0;
+    bool _prefetchReachedEOF = false;
+
+    // Set while the cursor is pinned by a CursorPrefetcher, and ready once the prefetch has
+    // unpinned it. Guarded by the same partition mutex as '_operationUsingCursor'.
+    boost::optional<SharedSemiFuture<void>> _prefetchDone;
 };
 
 /**
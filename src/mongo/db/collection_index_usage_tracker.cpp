@@ -57,6 +57,23 @@ CollectionIndexUsageTracker::CollectionIndexUsageTracker(ClockSource* clockSourc
 }
 
 void CollectionIndexUsageTracker::recordIndexAccess(StringData indexName) {
+    _incrementIndexCounter(indexName, &IndexUsageStats::accesses);
+}
+
+void CollectionIndexUsageTracker::recordIndexTrialWin(StringData indexName) {
+    _incrementIndexCounter(indexName, &IndexUsageStats::trialWins);
+}
+
+void CollectionIndexUsageTracker::recordIndexTrialLoss(StringData indexName) {
+    _incrementIndexCounter(indexName, &IndexUsageStats::trialLosses);
+}
+
+void CollectionIndexUsageTracker::recordIndexTrialSkipped(StringData indexName) {
+    _incrementIndexCounter(indexName, &IndexUsageStats::trialsSkipped);
+}
+
+void CollectionIndexUsageTracker::_incrementIndexCounter(
+    StringData indexName, AtomicWord<long long> IndexUsageStats::*counter) {
     invariant(!indexName.empty());
 
     // The following update after fetching the map can race with the removal of this index entry
@@ -70,7 +87,7 @@ void CollectionIndexUsageTracker::recordIndexAccess(StringData indexName) {
     }
 
     // Increment the index usage atomic counter.
-    it->second->accesses.fetchAndAdd(1);
+    (it->second.get()->*counter).fetchAndAdd(1);
 }
 
 void CollectionIndexUsageTracker::recordCollectionScans(unsigned long long collectionScans) {
@@ -73,11 +73,17 @@ public:
 
         IndexUsageStats(const IndexUsageStats& other)
             : accesses(other.accesses.load()),
+              trialWins(other.trialWins.load()),
+              trialLosses(other.trialLosses.load()),
+              trialsSkipped(other.trialsSkipped.load()),
               trackerStartTime(other.trackerStartTime),
               indexKey(other.indexKey) {}
 
         IndexUsageStats& operator=(const IndexUsageStats& other) {
             accesses.store(other.accesses.load());
+            trialWins.store(other.trialWins.load());
+            trialLosses.store(other.trialLosses.load());
+            trialsSkipped.store(other.trialsSkipped.load());
             trackerStartTime = other.trackerStartTime;
             indexKey = other.indexKey;
             return *this;
@@ -86,6 +92,13 @@ public:
         // Number of operations that have used this index.
         AtomicWord<long long> accesses;
 
+        // Number of multi-planner trial periods that a candidate plan using this index won or lost,
+        // and that candidate plans using this index were left out of for losing too often. Only
+        // counted when 'internalQueryPlanCacheSkipIndexesAfterConsecutiveLosses' is positive.
+        AtomicWord<long long> trialWins;
+        AtomicWord<long long> trialLosses;
+        AtomicWord<long long> trialsSkipped;
+
         // Date/Time that we started tracking index usage.
         Date_t trackerStartTime;
 
@@ -115,6 +128,14 @@ public:
      */
     void recordIndexAccess(StringData indexName);
 
+    /**
+     * Record that a candidate plan using index 'indexName' won or lost a multi-planner trial
+     * period, or was left out of one. Safe to be called by multiple threads concurrently.
+     */
+    void recordIndexTrialWin(StringData indexName);
+    void recordIndexTrialLoss(StringData indexName);
+    void recordIndexTrialSkipped(StringData indexName);
+
     /**
      * Add map entry for 'indexName' stats collection.
      *
@@ -155,6 +176,13 @@ public:
     void recordCollectionScansNonTailable(unsigned long long collectionScansNonTailable);
 
 private:
+    /**
+     * Increments the counter selected by 'counter' in the statistics of index 'indexName', if the
+     * index is still registered.
+     */
+    void _incrementIndexCounter(StringData indexName,
+                                AtomicWord<long long> IndexUsageStats::*counter);
+
     // Maps index name to index usage statistics.
     //
     // NOTE: This map must only be accessed via atomic_load and atomic_store!
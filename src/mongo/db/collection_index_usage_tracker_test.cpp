@@ -84,6 +84,22 @@ TEST_F(CollectionIndexUsageTrackerTest, MultipleHit) {
     ASSERT_EQUALS(2, statsMap->at("foo")->accesses.loadRelaxed());
 }
 
+// Test that trial period outcomes are counted separately from accesses.
+TEST_F(CollectionIndexUsageTrackerTest, TrialOutcomes) {
+    getTracker()->registerIndex("foo", BSON("foo" << 1));
+    getTracker()->recordIndexTrialWin("foo");
+    getTracker()->recordIndexTrialLoss("foo");
+    getTracker()->recordIndexTrialLoss("foo");
+    getTracker()->recordIndexTrialSkipped("foo");
+    getTracker()->recordIndexTrialWin("bar");
+    auto statsMap = getTracker()->getUsageStats();
+    ASSERT(statsMap->find("bar") == statsMap->end());
+    ASSERT_EQUALS(0, statsMap->at("foo")->accesses.loadRelaxed());
+    ASSERT_EQUALS(1, statsMap->at("foo")->trialWins.loadRelaxed());
+    ASSERT_EQUALS(2, statsMap->at("foo")->trialLosses.loadRelaxed());
+    ASSERT_EQUALS(1, statsMap->at("foo")->trialsSkipped.loadRelaxed());
+}
+
 // Test that an index is registered correctly with indexKey.
 TEST_F(CollectionIndexUsageTrackerTest, IndexKey) {
     getTracker()->registerIndex("foo", BSON("foo" << 1));
@@ -958,6 +958,14 @@ const std::set<std::string>& Command::deprecatedApiVersions() const {
     return kNoApiVersions;
 }
 
+void Command::recordReplySize(std::size_t bytes) const {
+    // Concurrent updates may overwrite each other. That is fine for an estimate, and cheaper than
+    // making every reply contend on a compare-and-swap.
+    const long long sample = bytes;
+    const long long current = _typicalReplySize.loadRelaxed();
+    _typicalReplySize.store(current == 0 ? sample : current + (sample - current) / 8);
+}
+
 bool Command::hasAlias(const StringData& alias) const {
     return globalCommandRegistry()->findCommand(alias) == this;
 }
@@ -398,6 +398,19 @@ public:
         return 0u;
     }
 
+    /**
+     * Folds the size of a reply this command produced into a running estimate of its reply size,
+     * which the rpc system can use to size reply buffers when no hint is given.
+     */
+    void recordReplySize(std::size_t bytes) const;
+
+    /**
+     * Returns the running estimate of this command's reply size, or 0 if there is none yet.
+     */
+    std::size_t typicalReplySize() const {
+        return _typicalReplySize.loadRelaxed();
+    }
+
     /**
      * Return true if only the admin ns has privileges to run this command.
      */
@@ -600,6 +613,9 @@ private:
     // Pointers to hold the metrics tree references
     ServerStatusMetricField<Counter64> _commandsExecutedMetric;
     ServerStatusMetricField<Counter64> _commandsFailedMetric;
+
+    // Exponentially weighted moving average of the reply sizes reported to recordReplySize().
+    mutable AtomicWord<long long> _typicalReplySize{0};
 };
 
 /**
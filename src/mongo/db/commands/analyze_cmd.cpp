@@ -0,0 +1,260 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/db/query/histogram.h"
+#include "mongo/db/query/internal_plans.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+namespace {
+
+constexpr long long kDefaultNumberBuckets = 100;
+constexpr long long kMaxNumberBuckets = 1000;
+constexpr long long kDefaultSampleSize = 100000;
+
+/**
+ * Reads up to 'sampleSize' documents of 'collection' and returns the values they hold along
+ * 'path', sorted in ascending order, each as the only element of an object. Like an index, a
+ * document contributes each element of an array along the path, and a null if it has no value.
+ * Also returns the number of documents read through 'numSampled'.
+ */
+std::vector<BSONObj> sampleValues(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  StringData path,
+                                  long long sampleSize,
+                                  long long* numSampled) {
+    auto exec = InternalPlanner::collectionScan(
+        opCtx, &collection, PlanYieldPolicy::YieldPolicy::YIELD_AUTO);
+
+    std::vector<BSONObj> values;
+    BSONObj doc;
+    *numSampled = 0;
+    while (*numSampled < sampleSize && exec->getNext(&doc, nullptr) == PlanExecutor::ADVANCED) {
+        ++*numSampled;
+
+        BSONElementSet elements;
+        dotted_path_support::extractAllElementsAlongPath(doc, path, elements);
+        if (elements.empty()) {
+            values.push_back(BSON("" << BSONNULL));
+            continue;
+        }
+        for (auto&& elem : elements) {
+            BSONObjBuilder bob;
+            bob.appendAs(elem, "");
+            values.push_back(bob.obj());
+        }
+    }
+
+    std::sort(values.begin(), values.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs.woCompare(rhs, BSONObj(), false) < 0;
+    });
+    return values;
+}
+
+/**
+ * Stores 'statistics' as the document of the collection with 'uuid' in the statistics collection
+ * of its database, replacing any previous one.
+ */
+void writeStatistics(OperationContext* opCtx,
+                     const NamespaceString& nss,
+                     const UUID& uuid,
+                     const CollectionStatistics& statistics) {
+    DBDirectClient client(opCtx);
+    auto commandResponse = client.runCommand([&] {
+        write_ops::UpdateCommandRequest updateOp(
+            CollectionStatistics::getStatisticsNamespace(nss.db()));
+        write_ops::UpdateOpEntry updateEntry(
+            BSON("_id" << uuid),
+            write_ops::UpdateModification::parseFromClassicUpdate(statistics.toBSON(uuid, nss)));
+        updateEntry.setMulti(false);
+        updateEntry.setUpsert(true);
+        updateOp.setUpdates({updateEntry});
+        return updateOp.serialize({});
+    }());
+    uassertStatusOK(getStatusFromWriteCommandReply(commandResponse->getCommandReply()));
+}
+
+}  // namespace
+
+/**
+ * The 'analyze' command builds a histogram of the values of one field of a collection, from a
+ * sample of its documents, for the cost model to estimate the cardinality of predicates over that
+ * field with:
+ *
+ *    {
+ *        analyze: <collection>,
+ *        key: <field path>,
+ *        numberBuckets: <maximum number of histogram buckets, defaults to 100>,
+ *        sampleSize: <maximum number of documents to read, defaults to 100000>
+ *    }
+ */
+class AnalyzeCommand final : public BasicCommand {
+public:
+    AnalyzeCommand() : BasicCommand("analyze") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override;
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override;
+
+    std::string help() const override {
+        return "Builds a histogram of a field of a collection for the query planner's cost model.";
+    }
+} analyzeCommand;
+
+Status AnalyzeCommand::checkAuthForCommand(Client* client,
+                                           const std::string& dbname,
+                                           const BSONObj& cmdObj) const {
+    AuthorizationSession* authzSession = AuthorizationSession::get(client);
+    ResourcePattern pattern = parseResourcePattern(dbname, cmdObj);
+
+    if (authzSession->isAuthorizedForActionsOnResource(pattern, ActionType::planCacheWrite)) {
+        return Status::OK();
+    }
+
+    return Status(ErrorCodes::Unauthorized, "unauthorized");
+}
+
+bool AnalyzeCommand::run(OperationContext* opCtx,
+                         const std::string& dbname,
+                         const BSONObj& cmdObj,
+                         BSONObjBuilder& result) {
+    const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+
+    auto keyElem = cmdObj["key"];
+    uassert(6108113,
+            "'key' must be a non-empty string naming the field to analyze",
+            keyElem.type() == String && !keyElem.valueStringData().empty());
+    const std::string path = keyElem.str();
+
+    long long numberBuckets = kDefaultNumberBuckets;
+    if (auto elem = cmdObj["numberBuckets"]) {
+        uassert(6108114,
+                str::stream() << "'numberBuckets' must be a number between 1 and "
+                              << kMaxNumberBuckets,
+                elem.isNumber() && elem.safeNumberLong() >= 1 &&
+                    elem.safeNumberLong() <= kMaxNumberBuckets);
+        numberBuckets = elem.safeNumberLong();
+    }
+
+    long long sampleSize = kDefaultSampleSize;
+    if (auto elem = cmdObj["sampleSize"]) {
+        uassert(6108115,
+                "'sampleSize' must be a positive number",
+                elem.isNumber() && elem.safeNumberLong() >= 1);
+        sampleSize = elem.safeNumberLong();
+    }
+
+    boost::optional<UUID> uuid;
+    long long numSampled = 0;
+    CollectionStatistics::FieldStatistics fieldStatistics;
+    {
+        AutoGetCollectionForReadCommand ctx(opCtx, nss);
+        const auto& collection = ctx.getCollection();
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Collection " << nss << " does not exist",
+                collection);
+        uuid = collection->uuid();
+
+        const double numRecords = collection->numRecords(opCtx);
+        auto values = sampleValues(opCtx, collection, path, sampleSize, &numSampled);
+        const double scale = numSampled > 0 ? numRecords / numSampled : 1.0;
+        fieldStatistics.histogram = EquiDepthHistogram::build(values, numberBuckets, scale);
+        fieldStatistics.analyzedAt = Date_t::now();
+    }
+
+    // Merge the new histogram with those of the collection's other analyzed fields.
+    const auto statsNss = CollectionStatistics::getStatisticsNamespace(nss.db());
+    CollectionStatistics statistics;
+    {
+        DBDirectClient client(opCtx);
+        auto obj = client.findOne(statsNss.ns(), BSON("_id" << *uuid));
+        if (!obj.isEmpty()) {
+            statistics = CollectionStatistics::parse(obj);
+        }
+    }
+    statistics.fields[path] = std::move(fieldStatistics);
+    writeStatistics(opCtx, nss, *uuid, statistics);
+
+    {
+        AutoGetCollectionForReadCommand ctx(opCtx, nss);
+        const auto& collection = ctx.getCollection();
+        if (collection && collection->uuid() == *uuid) {
+            const auto& queryInfo = CollectionQueryInfo::get(collection);
+            queryInfo.setStatistics(
+                std::make_shared<const CollectionStatistics>(std::move(statistics)));
+
+            // Plans cached before the collection was analyzed would outlive the new estimates.
+            queryInfo.getPlanCache()->clear();
+        }
+    }
+
+    LOGV2_DEBUG(6108116,
+                1,
+                "Analyzed collection field",
+                "namespace"_attr = nss,
+                "path"_attr = path,
+                "numSampled"_attr = numSampled);
+
+    result.append("numberSampled", numSampled);
+    return true;
+}
+
+}  // namespace mongo
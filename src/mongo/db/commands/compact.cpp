@@ -73,8 +73,10 @@ public:
         return "compact collection\n"
                "warning: this operation locks the database and is slow. you can cancel with "
                "killOp()\n"
-               "{ compact : <collection_name>, [force:<bool>] }\n"
-               "  force - allows to run on a replica set primary\n";
+               "{ compact : <collection_name>, [force:<bool>], [freeSpaceTargetMB:<int>] }\n"
+               "  force - allows to run on a replica set primary\n"
+               "  freeSpaceTargetMB - only compacts the collection and index files with at least\n"
+               "    this many megabytes available for reuse\n";
     }
     CompactCmd() : ErrmsgCommandDeprecated("compact") {}
 
@@ -99,7 +101,18 @@ public:
             return false;
         }
 
-        StatusWith<int64_t> status = compactCollection(opCtx, nss);
+        long long freeSpaceTargetMB = 0;
+        if (auto freeSpaceTargetElem = cmdObj["freeSpaceTargetMB"]) {
+            uassert(ErrorCodes::InvalidOptions,
+                    "freeSpaceTargetMB must be a non-negative number",
+                    freeSpaceTargetElem.isNumber() && freeSpaceTargetElem.safeNumberLong() >= 0 &&
+                        freeSpaceTargetElem.safeNumberLong() <=
+                            std::numeric_limits<long long>::max() / (1024 * 1024));
+            freeSpaceTargetMB = freeSpaceTargetElem.safeNumberLong();
+        }
+
+        StatusWith<int64_t> status =
+            compactCollection(opCtx, nss, freeSpaceTargetMB * 1024 * 1024);
         uassertStatusOK(status.getStatus());
 
         int64_t bytesFreed = status.getValue();
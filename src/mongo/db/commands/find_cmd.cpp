@@ -39,6 +39,7 @@
 #include "mongo/db/commands/run_aggregate.h"
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/cursor_manager.h"
+#include "mongo/db/cursor_prefetcher.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
@@ -527,6 +528,7 @@ public:
 
             // Set up the cursor for getMore.
             CursorId cursorId = 0;
+            boost::optional<std::int64_t> prefetchBatchSize;
             if (shouldSaveCursor(opCtx, collection, state, exec.get())) {
                 ClientCursorPin pinnedCursor = CursorManager::get(opCtx)->registerCursor(
                     opCtx,
@@ -556,6 +558,9 @@ public:
                 }
                 pinnedCursor.getCursor()->setNReturnedSoFar(numResults);
                 pinnedCursor.getCursor()->incNBatches();
+                if (CursorPrefetcher::shouldPrefetch(opCtx, *pinnedCursor.getCursor())) {
+                    prefetchBatchSize = originalFC.getBatchSize().value_or(0);
+                }
 
                 // Fill out curop based on the results.
                 endQueryOp(opCtx, collection, *cursorExec, numResults, cursorId);
@@ -563,6 +568,11 @@ public:
                 endQueryOp(opCtx, collection, *exec, numResults, cursorId);
             }
 
+            // The cursor is unpinned by now, so that the prefetch can pin it.
+            if (prefetchBatchSize) {
+                CursorPrefetcher::get(opCtx)->schedule(cursorId, *prefetchBatchSize);
+            }
+
             // Generate the response object to send to the client.
             firstBatch.done(cursorId, nss.ns());
 
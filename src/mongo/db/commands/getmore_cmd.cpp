@@ -47,6 +47,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/cursor_manager.h"
+#include "mongo/db/cursor_prefetcher.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/pipeline/change_stream_invalidation_info.h"
@@ -326,7 +327,30 @@ public:
             // an interrupt point, we just continue as normal and return rather than reporting a
             // timeout to the user.
             BSONObj obj;
-            PlanExecutor::ExecState state;
+            PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+
+            // Results which a CursorPrefetcher produced ahead of time come first. The executor is
+            // only run again once all of them have been returned.
+            while (cursor->hasPrefetchedResults() &&
+                   !FindCommon::enoughForGetMore(cmd.getBatchSize().value_or(0), *numResults)) {
+                const auto& next = cursor->frontPrefetchedResult();
+                if (!FindCommon::haveSpaceForNext(next, *numResults, nextBatch->bytesUsed())) {
+                    break;
+                }
+                nextBatch->append(next);
+                (*numResults)++;
+                docUnitsReturned->observeOne(next.objsize());
+                cursor->popPrefetchedResult();
+            }
+            if (cursor->hasPrefetchedResults()) {
+                return true;
+            }
+            if (cursor->prefetchReachedEOF()) {
+                // The prefetch ran the executor to the end, and cursors which prefetch are never
+                // tailable.
+                return false;
+            }
+
             try {
                 while (!FindCommon::enoughForGetMore(cmd.getBatchSize().value_or(0), *numResults) &&
                        PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
@@ -772,6 +796,13 @@ public:
             if (getTestCommandsEnabled()) {
                 validateResult(reply);
             }
+
+            if (cursorPin.getCursor() &&
+                CursorPrefetcher::shouldPrefetch(opCtx, *cursorPin.getCursor())) {
+                // The prefetch has to pin the cursor, so unpin it first.
+                cursorPin.release();
+                CursorPrefetcher::get(opCtx)->schedule(cursorId, _cmd.getBatchSize().value_or(0));
+            }
         }
 
         void validateResult(rpc::ReplyBuilderInterface* reply) {
@@ -171,6 +171,20 @@ public:
         _sections[section->getSectionName()] = section;
     }
 
+    void appendSections(OperationContext* opCtx,
+                        const BSONObj& config,
+                        BSONObjBuilder* result) {
+        _runCalled.store(true);
+
+        for (const auto& elem : config) {
+            auto it = _sections.find(elem.fieldName());
+            if (it == _sections.end()) {
+                continue;
+            }
+            it->second->appendSection(opCtx, elem, result);
+        }
+    }
+
 private:
     const Date_t _started;
     AtomicWord<bool> _runCalled;
@@ -201,6 +215,12 @@ ServerStatusSection::ServerStatusSection(const string& sectionName) : _sectionNa
     CmdServerStatusInstantiator::getInstance().addSection(this);
 }
 
+void appendServerStatusSections(OperationContext* opCtx,
+                                const BSONObj& config,
+                                BSONObjBuilder* result) {
+    CmdServerStatusInstantiator::getInstance().appendSections(opCtx, config, result);
+}
+
 OpCounterServerStatusSection::OpCounterServerStatusSection(const string& sectionName,
                                                            OpCounters* counters)
     : ServerStatusSection(sectionName), _counters(counters) {}
@@ -121,4 +121,16 @@ public:
 private:
     const OpCounters* _counters;
 };
+
+/**
+ * Appends only the sections named in 'config' to 'result', as serverStatus would, without
+ * running the rest of the command. Each element of 'config' is passed to its section as the
+ * section's configuration element. Unknown section names are skipped, and no privilege checks are
+ * made, so this is intended for internal callers such as FTDC which sample a few sections far more
+ * often than the full command could afford.
+ */
+void appendServerStatusSections(OperationContext* opCtx,
+                                const BSONObj& config,
+                                BSONObjBuilder* result);
+
 }  // namespace mongo
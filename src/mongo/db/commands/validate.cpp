@@ -85,6 +85,8 @@ public:
                              << "\tAdd {full: true} option to do a more thorough check.\n"
                              << "\tAdd {background: true} to validate in the background.\n"
                              << "\tAdd {repair: true} to run repair mode.\n"
+                             << "\tAdd {sample: <n>} to only check n random documents against "
+                             << "the indexes.\n"
                              << "Cannot specify both {full: true, background: true}.";
     }
 
@@ -167,6 +169,20 @@ public:
                           << " performed in standalone mode.");
         }
 
+        boost::optional<long long> sampleSize;
+        if (auto sampleElem = cmdObj["sample"]) {
+            uassert(ErrorCodes::InvalidOptions,
+                    "The 'sample' option of the validate command must be a positive number",
+                    sampleElem.isNumber() && sampleElem.safeNumberLong() > 0);
+            sampleSize = sampleElem.safeNumberLong();
+        }
+        if (sampleSize && (fullValidate || enforceFastCount || repair)) {
+            uasserted(ErrorCodes::CommandNotSupported,
+                      str::stream() << "Running the validate command with { sample: <n> } and any"
+                                    << " of { full: true }, { enforceFastCount: true } or"
+                                    << " { repair: true } is not supported.");
+        }
+
         if (!serverGlobalParams.quiet.load()) {
             LOGV2(20514,
                   "CMD: validate",
@@ -174,7 +190,8 @@ public:
                   "background"_attr = background,
                   "full"_attr = fullValidate,
                   "enforceFastCount"_attr = enforceFastCount,
-                  "repair"_attr = repair);
+                  "repair"_attr = repair,
+                  "sample"_attr = sampleSize);
         }
 
         // Only one validation per collection can be in progress, the rest wait.
@@ -237,8 +254,14 @@ public:
         }
 
         ValidateResults validateResults;
-        Status status =
-            CollectionValidation::validate(opCtx, nss, mode, repairMode, &validateResults, &result);
+        Status status = CollectionValidation::validate(opCtx,
+                                                       nss,
+                                                       mode,
+                                                       repairMode,
+                                                       &validateResults,
+                                                       &result,
+                                                       /*turnOnExtraLoggingForTest=*/false,
+                                                       sampleSize);
         if (!status.isOK()) {
             return CommandHelpers::appendCommandStatusNoThrow(result, status);
         }
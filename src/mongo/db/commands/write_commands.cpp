@@ -27,18 +27,24 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/bson/mutable/element.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/update_metrics.h"
 #include "mongo/db/commands/write_commands_common.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/json.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/matcher/doc_validation_error.h"
@@ -62,10 +68,16 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/db/timeseries/timeseries_options.h"
+#include "mongo/db/timeseries/timeseries_rollup.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/db/write_concern.h"
+#include "mongo/logv2/log.h"
 #include "mongo/logv2/redaction.h"
+#include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/string_map.h"
@@ -241,9 +253,6 @@ bool updateOnlyModifiesTimeseriesMetaField(OperationContext* opCtx,
     return true;
 }
 
-// Default for control.version in time-series bucket collection.
-const int kTimeseriesControlVersion = 1;
-
 /**
  * Transforms a single time-series insert to an update request on an existing bucket.
  */
@@ -340,7 +349,8 @@ BSONObj makeTimeseriesInsertDocument(std::shared_ptr<BucketCatalog::WriteBatch>
     builder.append("_id", batch->bucket()->id());
     {
         BSONObjBuilder bucketControlBuilder(builder.subobjStart("control"));
-        bucketControlBuilder.append("version", kTimeseriesControlVersion);
+        bucketControlBuilder.append(timeseries::kBucketControlVersionFieldName,
+                                    timeseries::kTimeseriesControlDefaultVersion);
         bucketControlBuilder.append("min", batch->min());
         bucketControlBuilder.append("max", batch->max());
     }
@@ -357,6 +367,65 @@ BSONObj makeTimeseriesInsertDocument(std::shared_ptr<BucketCatalog::WriteBatch>
     return builder.obj();
 }
 
+/**
+ * Returns a bucket whose time range can hold a measurement with the given metadata and time, for
+ * the bucket catalog to reopen instead of opening a new bucket. Only looks for one when an index
+ * on the metaField and control.min.<timeField> makes it cheap to find, and returns an empty
+ * BSONObj otherwise.
+ */
+BSONObj findBucketToReopen(OperationContext* opCtx,
+                           const NamespaceString& bucketsNs,
+                           const TimeseriesOptions& options,
+                           const BSONElement& metadata,
+                           const Date_t& time) {
+    AutoGetCollectionForRead coll(opCtx, bucketsNs);
+    if (!coll) {
+        return {};
+    }
+
+    const std::string controlMinTime = str::stream()
+        << timeseries::kControlMinFieldNamePrefix << options.getTimeField();
+    auto hasIndex = [&] {
+        auto it = coll->getIndexCatalog()->getIndexIterator(opCtx, false);
+        while (it->more()) {
+            auto descriptor = it->next()->descriptor();
+            if (descriptor->hidden() || descriptor->isPartial()) {
+                continue;
+            }
+
+            BSONObjIterator keyPattern(descriptor->keyPattern());
+            if (options.getMetaField() &&
+                (!keyPattern.more() ||
+                 keyPattern.next().fieldNameStringData() != timeseries::kBucketMetaFieldName)) {
+                continue;
+            }
+            if (keyPattern.more() && keyPattern.next().fieldNameStringData() == controlMinTime) {
+                return true;
+            }
+        }
+        return false;
+    };
+    if (!hasIndex()) {
+        return {};
+    }
+
+    BSONObjBuilder filter;
+    if (options.getMetaField()) {
+        if (metadata) {
+            filter.appendAs(metadata, timeseries::kBucketMetaFieldName);
+        } else {
+            filter.append(timeseries::kBucketMetaFieldName, BSON("$exists" << false));
+        }
+    }
+    filter.append(controlMinTime,
+                  BSON("$lte" << time << "$gt"
+                              << time - Seconds(*options.getBucketMaxSpanSeconds())));
+
+    BSONObj bucketDoc;
+    Helpers::findOne(opCtx, coll.getCollection(), filter.obj(), bucketDoc, true);
+    return bucketDoc;
+}
+
 /**
  * Returns true if the time-series write is retryable.
  */
@@ -747,6 +816,134 @@ public:
                 OperationSource::kTimeseries));
         }
 
+        /**
+         * Adds the measurements of each of the closed buckets 'bucketIds' to the rollup of the
+         * time-series collection, if it has one, by inserting their partial summaries into the
+         * rollup collection. Like compression, this is done on a separate client outside of the
+         * user's session, and failures are only logged.
+         */
+        void _rollUpClosedBuckets(OperationContext* opCtx,
+                                  const std::vector<OID>& bucketIds) const {
+            if (bucketIds.empty()) {
+                return;
+            }
+
+            auto bucketsNs = ns().makeTimeseriesBucketsNamespace();
+            auto client = opCtx->getServiceContext()->makeClient("TimeseriesRollup");
+            AlternativeClientRegion acr(client);
+            auto rollupOpCtx = cc().makeOperationContext();
+
+            try {
+                boost::optional<TimeseriesOptions> options;
+                boost::optional<NamespaceString> rollupNs;
+                std::vector<BSONObj> rollupDocs;
+                {
+                    AutoGetCollectionForRead coll(rollupOpCtx.get(), bucketsNs);
+                    if (!coll || !coll->getTimeseriesOptions() ||
+                        !coll->getTimeseriesOptions()->getRollup()) {
+                        return;
+                    }
+                    options = coll->getTimeseriesOptions();
+                    rollupNs.emplace(ns().db(), options->getRollup()->getInto());
+
+                    for (auto&& bucketId : bucketIds) {
+                        auto rid = Helpers::findById(
+                            rollupOpCtx.get(), coll.getCollection(), BSON("_id" << bucketId));
+                        if (rid.isNull()) {
+                            continue;
+                        }
+                        auto docs = timeseries::rollUpBucket(
+                            coll->docFor(rollupOpCtx.get(), rid).value(),
+                            *options,
+                            coll->getDefaultCollator());
+                        rollupDocs.insert(rollupDocs.end(), docs.begin(), docs.end());
+                    }
+                }
+                if (rollupDocs.empty()) {
+                    return;
+                }
+
+                // Inserting into a missing collection would implicitly create a regular one.
+                auto rollupOptions = timeseries::getTimeseriesOptions(rollupOpCtx.get(), *rollupNs);
+                uassert(ErrorCodes::NamespaceNotFound,
+                        str::stream() << "Time-series rollup collection " << *rollupNs
+                                      << " does not exist or has different time and meta fields",
+                        rollupOptions &&
+                            rollupOptions->getTimeField() == options->getTimeField() &&
+                            rollupOptions->getMetaField() == options->getMetaField());
+
+                DBDirectClient dbClient(rollupOpCtx.get());
+                auto reply = dbClient.runCommand([&] {
+                    write_ops::InsertCommandRequest insertOp(*rollupNs);
+                    insertOp.setDocuments(std::move(rollupDocs));
+                    return insertOp.serialize({});
+                }());
+                uassertStatusOK(getStatusFromWriteCommandReply(reply->getCommandReply()));
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(6102900,
+                            1,
+                            "Failed to roll up closed time-series buckets",
+                            "namespace"_attr = ns(),
+                            "error"_attr = ex.toStatus());
+            }
+        }
+
+        /**
+         * Rewrites each of the closed buckets 'bucketIds' with a compressed data region. The bucket
+         * catalog will not write to these buckets again, so this is done on a separate client
+         * outside of the user's session, and failures are only logged.
+         */
+        void _compressClosedBuckets(OperationContext* opCtx,
+                                    const std::vector<OID>& bucketIds) const {
+            if (bucketIds.empty() || !gTimeseriesBucketCompressionOnClose.load()) {
+                return;
+            }
+
+            auto bucketsNs = ns().makeTimeseriesBucketsNamespace();
+            auto client = opCtx->getServiceContext()->makeClient("TimeseriesBucketCompression");
+            AlternativeClientRegion acr(client);
+            auto compressionOpCtx = cc().makeOperationContext();
+
+            for (auto&& bucketId : bucketIds) {
+                try {
+                    boost::optional<BSONObj> compressed;
+                    {
+                        AutoGetCollectionForRead coll(compressionOpCtx.get(), bucketsNs);
+                        if (!coll || !coll->getTimeseriesOptions()) {
+                            return;
+                        }
+                        auto rid = Helpers::findById(
+                            compressionOpCtx.get(), coll.getCollection(), BSON("_id" << bucketId));
+                        if (rid.isNull()) {
+                            continue;
+                        }
+                        compressed = timeseries::compressBucket(
+                            coll->docFor(compressionOpCtx.get(), rid).value(),
+                            coll->getTimeseriesOptions()->getTimeField());
+                    }
+                    if (!compressed) {
+                        continue;
+                    }
+
+                    write_ops::UpdateCommandRequest op(
+                        bucketsNs,
+                        {write_ops::UpdateOpEntry(
+                            BSON("_id" << bucketId),
+                            write_ops::UpdateModification::parseFromClassicUpdate(*compressed))});
+                    op.setWriteCommandRequestBase(_makeTimeseriesWriteOpBase({}));
+                    uassertStatusOK(
+                        _getTimeseriesSingleWriteResult(write_ops_exec::performUpdates(
+                            compressionOpCtx.get(), op, OperationSource::kTimeseries)));
+                } catch (const DBException& ex) {
+                    LOGV2_DEBUG(6102120,
+                                1,
+                                "Failed to compress closed time-series bucket",
+                                "bucketId"_attr = bucketId,
+                                "error"_attr = ex.toStatus());
+                }
+            }
+        }
+
         void _commitTimeseriesBucket(OperationContext* opCtx,
                                      std::shared_ptr<BucketCatalog::WriteBatch> batch,
                                      size_t start,
@@ -758,7 +955,7 @@ public:
                                      std::vector<size_t>* docsToRetry) const {
             auto& bucketCatalog = BucketCatalog::get(opCtx);
 
-            auto metadata = bucketCatalog.getMetadata(batch->bucket());
+            auto metadata = bucketCatalog.getMetadata(batch);
             bool prepared = bucketCatalog.prepareCommit(batch);
             if (!prepared) {
                 invariant(batch->finished());
@@ -808,16 +1005,27 @@ public:
 
             getOpTimeAndElectionId(opCtx, opTime, electionId);
 
-            bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+            auto closedBuckets =
+                bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
             batchGuard.dismiss();
+
+            _rollUpClosedBuckets(opCtx, closedBuckets);
+            _compressClosedBuckets(opCtx, closedBuckets);
         }
 
+        /**
+         * Commits every batch we can claim the rights to in a single storage transaction. Returns
+         * false if the batches could not be committed, in which case they have been aborted with
+         * the write error if 'abortWithWriteError' is true, or as cleared otherwise so that their
+         * measurements are retried.
+         */
         bool _commitTimeseriesBucketsAtomically(OperationContext* opCtx,
                                                 TimeseriesBatches* batches,
                                                 TimeseriesStmtIds&& stmtIds,
                                                 std::vector<BSONObj>* errors,
                                                 boost::optional<repl::OpTime>* opTime,
-                                                boost::optional<OID>* electionId) const {
+                                                boost::optional<OID>* electionId,
+                                                bool abortWithWriteError = true) const {
             auto& bucketCatalog = BucketCatalog::get(opCtx);
 
             std::vector<std::reference_wrapper<std::shared_ptr<BucketCatalog::WriteBatch>>>
@@ -842,7 +1050,7 @@ public:
             std::vector<write_ops::UpdateCommandRequest> updateOps;
 
             for (auto batch : batchesToCommit) {
-                auto metadata = bucketCatalog.getMetadata(batch.get()->bucket());
+                auto metadata = bucketCatalog.getMetadata(batch);
                 if (!bucketCatalog.prepareCommit(batch)) {
                     for (auto batchToAbort : batchesToCommit) {
                         bucketCatalog.abort(batchToAbort);
@@ -865,18 +1073,26 @@ public:
                 write_ops_exec::performAtomicTimeseriesWrites(opCtx, insertOps, updateOps);
             if (!result.isOK()) {
                 for (auto batch : batchesToCommit) {
-                    bucketCatalog.abort(batch, result);
+                    bucketCatalog.abort(batch,
+                                        abortWithWriteError ? boost::make_optional(result)
+                                                            : boost::none);
                 }
                 return false;
             }
 
             getOpTimeAndElectionId(opCtx, opTime, electionId);
 
+            std::vector<OID> closedBuckets;
             for (auto batch : batchesToCommit) {
-                bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+                auto closed =
+                    bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+                closedBuckets.insert(closedBuckets.end(), closed.begin(), closed.end());
                 batch.get().reset();
             }
 
+            _rollUpClosedBuckets(opCtx, closedBuckets);
+            _compressClosedBuckets(opCtx, closedBuckets);
+
             return true;
         }
 
@@ -904,6 +1120,16 @@ public:
             TimeseriesBatches batches;
             TimeseriesStmtIds stmtIds;
 
+            // A bucket which has been rolled up when it was closed must not be reopened, or its
+            // measurements would be rolled up again when it is closed next.
+            BucketCatalog::BucketFinder findBucket;
+            if (!bucketsColl->getTimeseriesOptions()->getRollup()) {
+                findBucket = [&](const BSONElement& metadata, const Date_t& time) {
+                    return findBucketToReopen(
+                        opCtx, bucketsNs, *bucketsColl->getTimeseriesOptions(), metadata, time);
+                };
+            }
+
             auto insert = [&](size_t index) {
                 invariant(start + index < request().getDocuments().size());
 
@@ -925,7 +1151,8 @@ public:
                                          bucketsColl->getDefaultCollator(),
                                          *bucketsColl->getTimeseriesOptions(),
                                          request().getDocuments()[start + index],
-                                         _canCombineTimeseriesInsertWithOtherClients(opCtx));
+                                         _canCombineTimeseriesInsertWithOtherClients(opCtx),
+                                         findBucket);
 
                 if (auto error = generateError(opCtx, result, start + index, errors->size())) {
                     errors->push_back(*error);
@@ -1052,6 +1279,23 @@ public:
 
             std::vector<size_t> docsToRetry;
 
+            // Try to write all the buckets in a single storage transaction first. If that fails,
+            // the batches are aborted as cleared, so their measurements get retried below one
+            // bucket at a time, which reports any errors per measurement.
+            if (indices.empty() && numDocs > 1 &&
+                gTimeseriesUnorderedInsertsCommitAtomically.load()) {
+                _commitTimeseriesBucketsAtomically(opCtx,
+                                                   &batches,
+                                                   std::move(bucketStmtIds),
+                                                   errors,
+                                                   opTime,
+                                                   electionId,
+                                                   false /* abortWithWriteError */);
+                _getTimeseriesBatchResults(
+                    opCtx, batches, 0, errors, opTime, electionId, &docsToRetry);
+                return docsToRetry;
+            }
+
             for (auto& [batch, index] : batches) {
                 if (batch->claimCommitRights()) {
                     auto stmtIds = isTimeseriesWriteRetryable(opCtx)
@@ -32,7 +32,9 @@
 #include <benchmark/benchmark.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/query/find_command_gen.h"
 #include "mongo/idl/command_generic_argument.h"
+#include "mongo/rpc/op_msg_rpc_impls.h"
 
 namespace mongo {
 namespace {
@@ -70,9 +72,54 @@ void BM_IsReplyStripArgument(benchmark::State& state) {
     }
 }
 
+// Builds a reply of about 'state.range(0)' bytes, optionally reserving that much space up front the
+// way reserveReplyBytesFromRecentReplies does.
+void BM_BuildReply(benchmark::State& state) {
+    const auto replyBytes = state.range(0);
+    const bool reserve = state.range(1);
+    const std::string value(100, 'x');
+    for (auto _ : state) {
+        rpc::OpMsgReplyBuilder replyBuilder;
+        if (reserve) {
+            replyBuilder.reserveBytes(replyBytes);
+        }
+        {
+            auto bob = replyBuilder.getBodyBuilder();
+            BSONArrayBuilder batch(bob.subarrayStart("firstBatch"));
+            while (batch.len() < replyBytes) {
+                batch.append(BSON("_id" << batch.arrSize() << "value" << value));
+            }
+        }
+        benchmark::DoNotOptimize(replyBuilder.done());
+    }
+    state.SetBytesProcessed(state.iterations() * replyBytes);
+}
+
+// Parses a point find, with the generic arguments drivers typically send, out of an OP_MSG request.
+void BM_ParseFindCommand(benchmark::State& state) {
+    const auto request = OpMsgRequest::fromDBAndBody(
+        "test",
+        BSON("find"
+             << "coll"
+             << "filter" << BSON("_id" << 1) << "projection" << BSON("a" << 1) << "limit" << 1
+             << "singleBatch" << true << "lsid" << BSON("id" << UUID::gen()) << "readConcern"
+             << BSON("level"
+                     << "local")
+             << "$readPreference"
+             << BSON("mode"
+                     << "primaryPreferred")
+             << "$clusterTime" << BSON("clusterTime" << Timestamp(1, 1))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            FindCommandRequest::parse(IDLParserErrorContext("find"), request));
+    }
+}
+
 BENCHMARK(BM_IsGeneric)->DenseRange(0, keys.size() - 1);
 BENCHMARK(BM_IsRequestStripArgument)->DenseRange(0, keys.size() - 1);
 BENCHMARK(BM_IsReplyStripArgument)->DenseRange(0, keys.size() - 1);
+BENCHMARK(BM_ParseFindCommand);
+BENCHMARK(BM_BuildReply)->ArgsProduct({{1 << 10, 64 << 10, 1 << 20}, {0, 1}});
 
 }  // namespace
 }  // namespace mongo
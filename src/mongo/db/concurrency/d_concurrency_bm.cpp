@@ -122,6 +122,23 @@ BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)(benchmark
     }
 }
 
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_OwnCollectionIntentExclusiveLock)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        makeKClientsWithLockers(state.threads);
+    }
+
+    // Every thread writes to its own collection, so only the global and database locks are shared.
+    const NamespaceString nss("test", str::stream() << "coll" << state.thread_index);
+    for (auto keepRunning : state) {
+        Lock::DBLock dlk(clients[state.thread_index].second.get(), "test", MODE_IX);
+        Lock::CollectionLock clk(clients[state.thread_index].second.get(), nss, MODE_IX);
+    }
+
+    if (state.thread_index == 0) {
+        clients.clear();
+    }
+}
+
 BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionSharedLock)(benchmark::State& state) {
     if (state.thread_index == 0) {
         makeKClientsWithLockers(state.threads);
@@ -163,6 +180,8 @@ BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentSharedLock)
     ->ThreadRange(1, kMaxPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)
     ->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_OwnCollectionIntentExclusiveLock)
+    ->ThreadRange(1, kMaxPerfThreads);
 
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionSharedLock)->ThreadRange(1, kMaxPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionExclusiveLock)->ThreadRange(1, kMaxPerfThreads);
@@ -34,6 +34,7 @@
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/time_support.h"
 
@@ -41,6 +42,8 @@ namespace mongo {
 namespace {
 const auto getFlowControlTicketholder =
     ServiceContext::declareDecoration<std::unique_ptr<FlowControlTicketholder>>();
+
+const auto getFlowControlSource = OperationContext::declareDecoration<std::string>();
 }  // namespace
 
 void FlowControlTicketholder::CurOp::writeToBuilder(BSONObjBuilder& infoBuilder) {
@@ -78,7 +81,11 @@ void FlowControlTicketholder::set(ServiceContext* service,
     globalFlow = std::move(flowControl);
 }
 
-void FlowControlTicketholder::refreshTo(int numTickets) {
+void FlowControlTicketholder::setSource(OperationContext* opCtx, StringData source) {
+    getFlowControlSource(opCtx) = source.toString();
+}
+
+void FlowControlTicketholder::refreshTo(int numTickets, StringMap<int> sourceLimits) {
     invariant(numTickets >= 0);
     stdx::lock_guard<Latch> lk(_mutex);
     LOGV2_DEBUG(20518,
@@ -87,9 +94,23 @@ void FlowControlTicketholder::refreshTo(int numTickets) {
                 "tickets"_attr = _tickets,
                 "numTickets"_attr = numTickets);
     _tickets = numTickets;
+    _sourceTickets = std::move(sourceLimits);
     _cv.notify_all();
 }
 
+StringMap<std::int64_t> FlowControlTicketholder::takeAcquisitionsBySource() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return std::exchange(_acquisitionsBySource, {});
+}
+
+void FlowControlTicketholder::setTrackSources(bool trackSources) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _trackSources = trackSources;
+    if (!trackSources) {
+        _acquisitionsBySource.clear();
+    }
+}
+
 void FlowControlTicketholder::getTicket(OperationContext* opCtx,
                                         FlowControlTicketholder::CurOp* stats) {
     stdx::unique_lock<Latch> lk(_mutex);
@@ -97,9 +118,25 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
         return;
     }
 
+    // The limit of the operation's source is looked up on each check, since a refresh replaces the
+    // limits.
+    const auto& source = getFlowControlSource(opCtx);
+    auto hasTickets = [&] {
+        if (_tickets == 0) {
+            return false;
+        }
+        if (_sourceTickets.empty() || source.empty()) {
+            return true;
+        }
+        auto it = _sourceTickets.find(source);
+        return it == _sourceTickets.end() || it->second > 0;
+    };
+
     LOGV2_DEBUG(20519, 4, "Taking ticket.", "Available"_attr = _tickets);
-    if (_tickets == 0) {
+    boost::optional<ScopedWaitEvent> waitEvent;
+    if (!hasTickets()) {
         ++stats->acquireWaitCount;
+        waitEvent.emplace(opCtx, WaitEvent::kFlowControl);
     }
 
     auto currentWaitTime = curTimeMicros64();
@@ -120,7 +157,7 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
 
     // getTicket() should block until there are tickets or the Ticketholder is in shutdown
     while (!opCtx->waitForConditionOrInterruptFor(
-        _cv, lk, Milliseconds(500), [&] { return _tickets > 0 || _inShutdown; })) {
+        _cv, lk, Milliseconds(500), [&] { return hasTickets() || _inShutdown; })) {
         updateTotalTime();
     }
 
@@ -130,6 +167,14 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
 
     ++stats->ticketsAcquired;
     --_tickets;
+    if (!source.empty()) {
+        if (auto it = _sourceTickets.find(source); it != _sourceTickets.end()) {
+            --it->second;
+        }
+        if (_trackSources) {
+            ++_acquisitionsBySource[source];
+        }
+    }
 }
 
 // Should only be called once, during shutdown.
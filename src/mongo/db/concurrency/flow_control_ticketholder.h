@@ -33,6 +33,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -79,10 +80,28 @@ public:
 
     static void set(ServiceContext* service, std::unique_ptr<FlowControlTicketholder> flowControl);
 
-    void refreshTo(int numTickets);
+    /**
+     * Attributes the tickets acquired by 'opCtx' to 'source', the database the operation runs
+     * against. Operations without a source only take tickets from the shared pool.
+     */
+    static void setSource(OperationContext* opCtx, StringData source);
+
+    /**
+     * Makes 'numTickets' available until the next refresh. Operations attributed to a source in
+     * 'sourceLimits' can acquire at most the given number of those tickets.
+     */
+    void refreshTo(int numTickets, StringMap<int> sourceLimits = {});
 
     void getTicket(OperationContext* opCtx, FlowControlTicketholder::CurOp* stats);
 
+    /**
+     * Returns the number of tickets acquired by each source since the last call, and starts
+     * counting again. Acquisitions are only counted while 'setTrackSources(true)' is in effect.
+     */
+    StringMap<std::int64_t> takeAcquisitionsBySource();
+
+    void setTrackSources(bool trackSources);
+
     std::int64_t totalTimeAcquiringMicros() const {
         return _totalTimeAcquiringMicros.load();
     }
@@ -97,6 +116,12 @@ private:
     stdx::condition_variable _cv;
     int _tickets;
 
+    // Tickets left until the next refresh for the sources that are limited.
+    StringMap<int> _sourceTickets;
+
+    bool _trackSources = false;
+    StringMap<std::int64_t> _acquisitionsBySource;
+
     bool _inShutdown;  // used to synchronize shutdown of the ticket refresher job
 };
 
@@ -42,6 +42,7 @@
 #include "mongo/platform/compiler.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/new.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
 
@@ -171,9 +172,11 @@ private:
     // The lockheads need access to the partitions
     friend struct LockHead;
 
-    // These types describe the locks hash table
+    // These types describe the locks hash table. Buckets and partitions are laid out in arrays and
+    // their mutexes are taken by every lock request, so each one gets its own cache line to keep
+    // threads working on neighbouring ones from invalidating each other's.
 
-    struct LockBucket {
+    struct alignas(stdx::hardware_destructive_interference_size) LockBucket {
         SimpleMutex mutex;
         typedef stdx::unordered_map<ResourceId, LockHead*> Map;
         Map data;
@@ -183,7 +186,7 @@ private:
     // Each locker maps to a partition that is used for resources acquired in intent modes
     // modes and potentially other modes that don't conflict with themselves. This avoids
     // contention on the regular LockHead in the lock manager.
-    struct Partition {
+    struct alignas(stdx::hardware_destructive_interference_size) Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
         typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
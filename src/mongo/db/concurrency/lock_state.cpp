@@ -40,6 +40,7 @@
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/compiler.h"
@@ -388,10 +389,14 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
-        if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
-            return false;
+        if (!holder->tryAcquire()) {
+            // Only the acquisitions which have to queue are timed.
+            ScopedWaitEvent waitEvent(opCtx, WaitEvent::kTicketQueue);
+            if (deadline == Date_t::max()) {
+                holder->waitForTicket(interruptible);
+            } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+                return false;
+            }
         }
         restoreStateOnErrorGuard.dismiss();
     }
@@ -45,11 +45,13 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/db/curop_server_parameters_gen.h"
 #include "mongo/db/json.h"
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_command_gen.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
@@ -85,6 +87,55 @@ TimerStats oplogGetMoreStats;
 ServerStatusMetricField<TimerStats> displayBatchesReceived("repl.network.oplogGetMoresProcessed",
                                                            &oplogGetMoreStats);
 
+/**
+ * An immutable currentOp report of a client's operation, published by the thread running it.
+ */
+struct CurrentOpSnapshot {
+    BSONObj report;
+
+    // When the snapshot was published, and the running time of the operation at that point if it
+    // was still running, so that readers can bring the running time up to date.
+    TickSource::Tick publishedAt = 0;
+    boost::optional<Microseconds> elapsedAtPublish;
+};
+
+/**
+ * Holds the latest snapshot of a client's operation. Readers only ever load 'snapshot'; all other
+ * members are only accessed by the thread the client is attached to.
+ */
+struct CurrentOpSnapshotSlot {
+    std::shared_ptr<const CurrentOpSnapshot> snapshot;
+    TickSource::Tick lastPublishedAt = 0;
+    bool published = false;
+};
+
+const auto getCurrentOpSnapshotSlot = Client::declareDecoration<CurrentOpSnapshotSlot>();
+
+/**
+ * Retires the snapshot of an operation with the operation itself, so that it is never reported
+ * after the operation ends.
+ */
+class CurrentOpSnapshotClientObserver final : public ServiceContext::ClientObserver {
+public:
+    void onCreateClient(Client* client) final {}
+    void onDestroyClient(Client* client) final {}
+    void onCreateOperationContext(OperationContext* opCtx) final {}
+    void onDestroyOperationContext(OperationContext* opCtx) final {
+        auto& slot = getCurrentOpSnapshotSlot(opCtx->getClient());
+        if (!slot.published) {
+            return;
+        }
+        atomic_store(&slot.snapshot, std::shared_ptr<const CurrentOpSnapshot>());
+        slot.lastPublishedAt = 0;
+        slot.published = false;
+    }
+};
+
+ServiceContext::ConstructorActionRegisterer currentOpSnapshotClientObserverRegisterer{
+    "CurrentOpSnapshotClientObserver", [](ServiceContext* service) {
+        service->registerClientObserver(std::make_unique<CurrentOpSnapshotClientObserver>());
+    }};
+
 }  // namespace
 
 BSONObj upconvertQueryEntry(const BSONObj& query,
@@ -341,6 +392,81 @@ void CurOp::reportCurrentOpForClient(OperationContext* opCtx,
 #endif
 }
 
+bool CurOp::areCurrentOpSnapshotsEnabled() {
+    return gInternalCurrentOpSnapshotRefreshMillis.load() > 0;
+}
+
+void CurOp::publishCurrentOpSnapshot(OperationContext* opCtx) {
+    const auto refreshPeriod = Milliseconds(gInternalCurrentOpSnapshotRefreshMillis.load());
+    if (refreshPeriod <= Milliseconds(0)) {
+        return;
+    }
+
+    auto client = opCtx->getClient();
+    auto& slot = getCurrentOpSnapshotSlot(client);
+    auto tickSource = SystemTickSource::get();
+    const auto now = tickSource->getTicks();
+    if (slot.published &&
+        tickSource->ticksTo<Milliseconds>(now - slot.lastPublishedAt) < refreshPeriod) {
+        return;
+    }
+
+    auto snapshot = std::make_shared<CurrentOpSnapshot>();
+    {
+        stdx::lock_guard<Client> lk(*client);
+        BSONObjBuilder builder;
+        reportCurrentOpForClient(opCtx, client, false /* truncateOps */, false, &builder);
+        snapshot->report = builder.obj();
+    }
+
+    auto curOp = CurOp::get(opCtx);
+    if (curOp->isStarted() && !curOp->isDone()) {
+        snapshot->elapsedAtPublish = curOp->elapsedTimeTotal();
+    }
+    snapshot->publishedAt = now;
+
+    slot.lastPublishedAt = now;
+    slot.published = true;
+    atomic_store(&slot.snapshot, std::shared_ptr<const CurrentOpSnapshot>(std::move(snapshot)));
+}
+
+boost::optional<BSONObj> CurOp::getCurrentOpSnapshot(OperationContext* opCtx, Client* client) {
+    const auto refreshPeriod = Milliseconds(gInternalCurrentOpSnapshotRefreshMillis.load());
+    if (refreshPeriod <= Milliseconds(0)) {
+        return boost::none;
+    }
+
+    auto snapshot = atomic_load(&getCurrentOpSnapshotSlot(client).snapshot);
+    if (!snapshot) {
+        return boost::none;
+    }
+
+    auto tickSource = SystemTickSource::get();
+    const auto age =
+        tickSource->ticksTo<Microseconds>(tickSource->getTicks() - snapshot->publishedAt);
+    if (age > refreshPeriod * 2) {
+        return boost::none;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : snapshot->report) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "currentOpTime"_sd) {
+            builder.append(
+                fieldName,
+                opCtx->getServiceContext()->getPreciseClockSource()->now().toString());
+        } else if (snapshot->elapsedAtPublish && fieldName == "secs_running"_sd) {
+            builder.append(fieldName, durationCount<Seconds>(*snapshot->elapsedAtPublish + age));
+        } else if (snapshot->elapsedAtPublish && fieldName == "microsecs_running"_sd) {
+            builder.append(fieldName,
+                           durationCount<Microseconds>(*snapshot->elapsedAtPublish + age));
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
 void CurOp::setGenericCursor_inlock(GenericCursor gc) {
     _genericCursor = std::move(gc);
 }
@@ -776,9 +902,22 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
     if (auto n = _debug.additiveMetrics.prepareReadConflicts.load(); n > 0) {
         builder->append("prepareReadConflicts", n);
     }
+    if (auto waiting =
+            PrepareConflictTracker::get(opCtx).getCurrentPrepareConflictDuration(opCtx);
+        waiting > Microseconds(0)) {
+        builder->append("prepareConflictWaitMicros", durationCount<Microseconds>(waiting));
+    }
     if (auto n = _debug.additiveMetrics.writeConflicts.load(); n > 0) {
         builder->append("writeConflicts", n);
     }
+    if (auto n = _debug.additiveMetrics.peakMemoryUsageBytes.load(); n > 0) {
+        builder->append("peakMemoryUsageBytes", n);
+    }
+
+    if (const auto& waitEvents = WaitEventStats::get(opCtx); !waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder(builder->subobjStart("waitEvents"));
+        waitEvents.append(&waitEventsBuilder, false /* includeAll */);
+    }
 
     builder->append("numYields", _numYields.load());
 
@@ -928,6 +1067,7 @@ void OpDebug::report(OperationContext* opCtx,
     OPDEBUG_TOATTR_HELP_OPTIONAL("keysDeleted", additiveMetrics.keysDeleted);
     OPDEBUG_TOATTR_HELP_ATOMIC("prepareReadConflicts", additiveMetrics.prepareReadConflicts);
     OPDEBUG_TOATTR_HELP_ATOMIC("writeConflicts", additiveMetrics.writeConflicts);
+    OPDEBUG_TOATTR_HELP_ATOMIC("peakMemoryUsageBytes", additiveMetrics.peakMemoryUsageBytes);
 
     pAttrs->add("numYields", curop.numYields());
     OPDEBUG_TOATTR_HELP(nreturned);
@@ -971,6 +1111,12 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("flowControl", flowControlObj);
     }
 
+    if (const auto& waitEvents = WaitEventStats::get(opCtx); !waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder;
+        waitEvents.append(&waitEventsBuilder, false /* includeAll */);
+        pAttrs->add("waitEvents", waitEventsBuilder.obj());
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -1075,6 +1221,7 @@ void OpDebug::append(OperationContext* opCtx,
     OPDEBUG_APPEND_OPTIONAL(b, "keysDeleted", additiveMetrics.keysDeleted);
     OPDEBUG_APPEND_ATOMIC(b, "prepareReadConflicts", additiveMetrics.prepareReadConflicts);
     OPDEBUG_APPEND_ATOMIC(b, "writeConflicts", additiveMetrics.writeConflicts);
+    OPDEBUG_APPEND_ATOMIC(b, "peakMemoryUsageBytes", additiveMetrics.peakMemoryUsageBytes);
 
     OPDEBUG_APPEND_OPTIONAL(b, "dataThroughputLastSecond", dataThroughputLastSecond);
     OPDEBUG_APPEND_OPTIONAL(b, "dataThroughputAverage", dataThroughputAverage);
@@ -1109,6 +1256,11 @@ void OpDebug::append(OperationContext* opCtx,
         flowControlBuilder.appendElements(flowControlMetrics);
     }
 
+    if (const auto& waitEvents = WaitEventStats::get(opCtx); !waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder(b.subobjStart("waitEvents"));
+        waitEvents.append(&waitEventsBuilder, false /* includeAll */);
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -1327,6 +1479,9 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
     addIfNeeded("writeConflicts", [](auto field, auto args, auto& b) {
         OPDEBUG_APPEND_ATOMIC(b, field, args.op.additiveMetrics.writeConflicts);
     });
+    addIfNeeded("peakMemoryUsageBytes", [](auto field, auto args, auto& b) {
+        OPDEBUG_APPEND_ATOMIC(b, field, args.op.additiveMetrics.peakMemoryUsageBytes);
+    });
 
     addIfNeeded("dataThroughputLastSecond", [](auto field, auto args, auto& b) {
         OPDEBUG_APPEND_OPTIONAL(b, field, args.op.dataThroughputLastSecond);
@@ -1377,6 +1532,13 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         flowControlBuilder.appendElements(flowControlMetrics);
     });
 
+    addIfNeeded("waitEvents", [](auto field, auto args, auto& b) {
+        if (const auto& waitEvents = WaitEventStats::get(args.opCtx); !waitEvents.empty()) {
+            BSONObjBuilder waitEventsBuilder(b.subobjStart(field));
+            waitEvents.append(&waitEventsBuilder, false /* includeAll */);
+        }
+    });
+
     addIfNeeded("writeConcern", [](auto field, auto args, auto& b) {
         if (args.op.writeConcern && !args.op.writeConcern->usedDefaultConstructedWC) {
             b.append(field, args.op.writeConcern->toBSON());
@@ -1479,6 +1641,7 @@ void OpDebug::setPlanSummaryMetrics(const PlanSummaryStats& planSummaryStats) {
     additiveMetrics.docsExamined = planSummaryStats.totalDocsExamined;
     hasSortStage = planSummaryStats.hasSortStage;
     usedDisk = planSummaryStats.usedDisk;
+    additiveMetrics.setPeakMemoryUsageBytes(planSummaryStats.peakMemoryUsageBytes);
     fromMultiPlanner = planSummaryStats.fromMultiPlanner;
     replanReason = planSummaryStats.replanReason;
 }
@@ -1588,6 +1751,7 @@ void OpDebug::AdditiveMetrics::add(const AdditiveMetrics& otherMetrics) {
     keysDeleted = addOptionalLongs(keysDeleted, otherMetrics.keysDeleted);
     prepareReadConflicts.fetchAndAdd(otherMetrics.prepareReadConflicts.load());
     writeConflicts.fetchAndAdd(otherMetrics.writeConflicts.load());
+    setPeakMemoryUsageBytes(otherMetrics.peakMemoryUsageBytes.load());
 }
 
 void OpDebug::AdditiveMetrics::reset() {
@@ -1602,6 +1766,7 @@ void OpDebug::AdditiveMetrics::reset() {
     keysDeleted = boost::none;
     prepareReadConflicts.store(0);
     writeConflicts.store(0);
+    peakMemoryUsageBytes.store(0);
 }
 
 bool OpDebug::AdditiveMetrics::equals(const AdditiveMetrics& otherMetrics) const {
@@ -1611,7 +1776,8 @@ bool OpDebug::AdditiveMetrics::equals(const AdditiveMetrics& otherMetrics) const
         nUpserted == otherMetrics.nUpserted && keysInserted == otherMetrics.keysInserted &&
         keysDeleted == otherMetrics.keysDeleted &&
         prepareReadConflicts.load() == otherMetrics.prepareReadConflicts.load() &&
-        writeConflicts.load() == otherMetrics.writeConflicts.load();
+        writeConflicts.load() == otherMetrics.writeConflicts.load() &&
+        peakMemoryUsageBytes.load() == otherMetrics.peakMemoryUsageBytes.load();
 }
 
 void OpDebug::AdditiveMetrics::incrementWriteConflicts(long long n) {
@@ -1650,6 +1816,13 @@ void OpDebug::AdditiveMetrics::incrementPrepareReadConflicts(long long n) {
     prepareReadConflicts.fetchAndAdd(n);
 }
 
+void OpDebug::AdditiveMetrics::setPeakMemoryUsageBytes(long long n) {
+    // Only the thread running the operation changes the value, so this can't miss a larger one.
+    if (n > peakMemoryUsageBytes.load()) {
+        peakMemoryUsageBytes.store(n);
+    }
+}
+
 string OpDebug::AdditiveMetrics::report() const {
     StringBuilder s;
 
@@ -1664,6 +1837,7 @@ string OpDebug::AdditiveMetrics::report() const {
     OPDEBUG_TOSTRING_HELP_OPTIONAL("keysDeleted", keysDeleted);
     OPDEBUG_TOSTRING_HELP_ATOMIC("prepareReadConflicts", prepareReadConflicts);
     OPDEBUG_TOSTRING_HELP_ATOMIC("writeConflicts", writeConflicts);
+    OPDEBUG_TOSTRING_HELP_ATOMIC("peakMemoryUsageBytes", peakMemoryUsageBytes);
 
     return s.str();
 }
@@ -1680,6 +1854,7 @@ void OpDebug::AdditiveMetrics::report(logv2::DynamicAttributes* pAttrs) const {
     OPDEBUG_TOATTR_HELP_OPTIONAL("keysDeleted", keysDeleted);
     OPDEBUG_TOATTR_HELP_ATOMIC("prepareReadConflicts", prepareReadConflicts);
     OPDEBUG_TOATTR_HELP_ATOMIC("writeConflicts", writeConflicts);
+    OPDEBUG_TOATTR_HELP_ATOMIC("peakMemoryUsageBytes", peakMemoryUsageBytes);
 }
 
 BSONObj OpDebug::AdditiveMetrics::reportBSON() const {
@@ -1695,6 +1870,7 @@ BSONObj OpDebug::AdditiveMetrics::reportBSON() const {
     OPDEBUG_APPEND_OPTIONAL(b, "keysDeleted", keysDeleted);
     OPDEBUG_APPEND_ATOMIC(b, "prepareReadConflicts", prepareReadConflicts);
     OPDEBUG_APPEND_ATOMIC(b, "writeConflicts", writeConflicts);
+    OPDEBUG_APPEND_ATOMIC(b, "peakMemoryUsageBytes", peakMemoryUsageBytes);
     return b.obj();
 }
 
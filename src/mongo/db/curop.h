@@ -126,6 +126,11 @@ public:
          */
         void incrementPrepareReadConflicts(long long n);
 
+        /**
+         * Raises peakMemoryUsageBytes to n if it is lower.
+         */
+        void setPeakMemoryUsageBytes(long long n);
+
         /**
          * Generates a string showing all non-empty fields. For every non-empty field field1,
          * field2, ..., with corresponding values value1, value2, ..., we will output a string in
@@ -160,6 +165,10 @@ public:
         // Number of read conflicts caused by a prepared transaction.
         AtomicWord<long long> prepareReadConflicts{0};
         AtomicWord<long long> writeConflicts{0};
+
+        // The most memory held at once by the stages of the operation. Combining metrics keeps the
+        // largest value rather than adding them up.
+        AtomicWord<long long> peakMemoryUsageBytes{0};
     };
 
     OpDebug() = default;
@@ -257,6 +266,9 @@ public:
     // Details of any error (whether from an exception or a command returning failure).
     Status errInfo = Status::OK();
 
+    // Time spent building the executor of the query, which includes choosing its plan.
+    Microseconds planningTime{0};
+
     // response info
     Microseconds executionTime{0};
     long long nreturned{-1};
@@ -338,6 +350,29 @@ public:
                                          bool backtraceMode,
                                          BSONObjBuilder* infoBuilder);
 
+    /**
+     * Returns true if operations publish snapshots of their currentOp reports, which is the case
+     * when 'internalCurrentOpSnapshotRefreshMillis' is non-zero.
+     */
+    static bool areCurrentOpSnapshotsEnabled();
+
+    /**
+     * Publishes the currentOp report of the operation, built as reportCurrentOpForClient() would,
+     * as an immutable snapshot which getCurrentOpSnapshot() reads without locking the client. Does
+     * nothing if snapshots are disabled, or if the last snapshot is younger than the refresh
+     * period. Must be called by the thread running the operation, without holding the client lock.
+     */
+    static void publishCurrentOpSnapshot(OperationContext* opCtx);
+
+    /**
+     * Returns the latest snapshot of the given client's currentOp report, with its running time and
+     * currentOpTime brought up to date. Does not lock the client. Returns boost::none if the client
+     * has not published a snapshot for its current operation, or if the snapshot is older than
+     * twice the refresh period, as an operation which stops refreshing is likely blocked and is
+     * best reported in full; the caller should then lock the client and report it as usual.
+     */
+    static boost::optional<BSONObj> getCurrentOpSnapshot(OperationContext* opCtx, Client* client);
+
     /**
      * Serializes the fields of a GenericCursor which do not appear elsewhere in the currentOp
      * output. If 'maxQuerySize' is given, truncates the cursor's originatingCommand but preserves
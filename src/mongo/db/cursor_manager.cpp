@@ -170,22 +170,37 @@ bool CursorManager::cursorShouldTimeout_inlock(const ClientCursor* cursor, Date_
     return (now - cursor->_lastUseDate) >= Milliseconds(getCursorTimeoutMillis());
 }
 
+void CursorManager::addToIdleList_inlock(ClientCursor* cursor) {
+    invariant(!cursor->_idleListPosition);
+    if (cursor->isNoTimeout() || cursor->getSessionId()) {
+        return;
+    }
+    auto& idleList = _idleLists[Partitioner<CursorId>()(cursor->cursorid(), kNumPartitions)];
+    cursor->_idleListPosition = idleList.insert(idleList.end(), cursor);
+}
+
+void CursorManager::removeFromIdleList_inlock(ClientCursor* cursor) {
+    if (!cursor->_idleListPosition) {
+        return;
+    }
+    auto& idleList = _idleLists[Partitioner<CursorId>()(cursor->cursorid(), kNumPartitions)];
+    idleList.erase(*cursor->_idleListPosition);
+    cursor->_idleListPosition = boost::none;
+}
+
 std::size_t CursorManager::timeoutCursors(OperationContext* opCtx, Date_t now) {
     std::vector<std::unique_ptr<ClientCursor, ClientCursor::Deleter>> toDisposeWithoutMutex;
 
     for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
         auto lockedPartition = _cursorMap->lockOnePartitionById(partitionId);
-        for (auto it = lockedPartition->begin(); it != lockedPartition->end();) {
-            auto* cursor = it->second;
-            if (cursorShouldTimeout_inlock(cursor, now)) {
-                toDisposeWithoutMutex.emplace_back(cursor);
-                // Advance the iterator first since erasing from the lockedPartition will
-                // invalidate any references to it.
-                ++it;
-                removeCursorFromMap(lockedPartition, cursor);
-            } else {
-                ++it;
-            }
+        auto& idleList = _idleLists[partitionId];
+        // The idle list is ordered by last use, so the first cursor which has not yet expired
+        // means that none of the cursors after it have either.
+        while (!idleList.empty() && cursorShouldTimeout_inlock(idleList.front(), now)) {
+            auto* cursor = idleList.front();
+            toDisposeWithoutMutex.emplace_back(cursor);
+            removeFromIdleList_inlock(cursor);
+            removeCursorFromMap(lockedPartition, cursor);
         }
     }
 
@@ -204,6 +219,35 @@ std::size_t CursorManager::timeoutCursors(OperationContext* opCtx, Date_t now) {
 StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
                                                      CursorId id,
                                                      AuthCheck checkSessionAuth) {
+    while (true) {
+        boost::optional<SharedSemiFuture<void>> prefetchInProgress;
+        {
+            auto lockedPartition = _cursorMap->lockOnePartition(id);
+            auto it = lockedPartition->find(id);
+            if (it != lockedPartition->end() && it->second->_operationUsingCursor) {
+                prefetchInProgress = it->second->_prefetchDone;
+            }
+        }
+        if (!prefetchInProgress) {
+            return _pinCursor(opCtx, id, checkSessionAuth, boost::none);
+        }
+
+        // The cursor is busy producing results for this operation ahead of time, so wait for it
+        // to become available again rather than report it as in use.
+        prefetchInProgress->wait(opCtx);
+    }
+}
+
+StatusWith<ClientCursorPin> CursorManager::pinCursorForPrefetch(
+    OperationContext* opCtx, CursorId id, SharedSemiFuture<void> prefetchDone) {
+    return _pinCursor(opCtx, id, kNoCheckSession, std::move(prefetchDone));
+}
+
+StatusWith<ClientCursorPin> CursorManager::_pinCursor(
+    OperationContext* opCtx,
+    CursorId id,
+    AuthCheck checkSessionAuth,
+    boost::optional<SharedSemiFuture<void>> prefetchDone) {
     auto lockedPartition = _cursorMap->lockOnePartition(id);
     auto it = lockedPartition->find(id);
     if (it == lockedPartition->end()) {
@@ -230,11 +274,14 @@ StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
         }
     }
 
+    removeFromIdleList_inlock(cursor);
     cursor->_operationUsingCursor = opCtx;
+    const bool isPrefetch = prefetchDone.has_value();
+    cursor->_prefetchDone = std::move(prefetchDone);
 
     // We use pinning of a cursor as a proxy for active, user-initiated use of a cursor.  Therefore,
     // we pass down to the logical session cache and vivify the record (updating last use).
-    if (cursor->getSessionId()) {
+    if (cursor->getSessionId() && !isPrefetch) {
         auto vivifyCursorStatus =
             LogicalSessionCache::get(opCtx)->vivify(opCtx, cursor->getSessionId().get());
         if (!vivifyCursorStatus.isOK()) {
@@ -258,6 +305,7 @@ void CursorManager::unpin(OperationContext* opCtx,
     // destroyed, and subsequent getMores with a fresh opCtx will succeed.
     auto interruptStatus = cursor->_operationUsingCursor->checkForInterruptNoAssert();
     cursor->_operationUsingCursor = nullptr;
+    cursor->_prefetchDone = boost::none;
     cursor->_lastUseDate = now;
 
     // If someone was trying to kill this cursor with a killOp or a killCursors, they are likely
@@ -277,7 +325,7 @@ void CursorManager::unpin(OperationContext* opCtx,
 
     // The cursor will stay around in '_cursorMap', so release the unique pointer to avoid deleting
     // it.
-    cursor.release();
+    addToIdleList_inlock(cursor.release());
 }
 
 void CursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
@@ -425,6 +473,8 @@ ClientCursorPin CursorManager::registerCursor(OperationContext* opCtx,
 }
 
 void CursorManager::deregisterCursor(ClientCursor* cursor) {
+    // Only pinned cursors are deregistered this way, and pinned cursors are never idle.
+    invariant(!cursor->_idleListPosition);
     removeCursorFromMap(_cursorMap, cursor);
     incrementCursorLifespanMetric(cursor->_createdDate, _preciseClockSource->now());
 }
@@ -435,6 +485,7 @@ void CursorManager::deregisterAndDestroyCursor(
     std::unique_ptr<ClientCursor, ClientCursor::Deleter> cursor) {
     {
         auto lockWithRestrictedScope = std::move(lk);
+        removeFromIdleList_inlock(cursor.get());
         removeCursorFromMap(lockWithRestrictedScope, cursor.get());
     }
 
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <array>
+#include <list>
 #include <utility>
 
 #include "mongo/db/catalog/util/partitioned.h"
@@ -44,6 +46,7 @@
 #include "mongo/util/clock_source.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/duration.h"
+#include "mongo/util/future.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -121,13 +124,24 @@ public:
      *
      * Throws a AssertionException if the cursor is already pinned. Callers need not specially
      * handle this error, as it should only happen if a misbehaving client attempts to
-     * simultaneously issue two operations against the same cursor id.
+     * simultaneously issue two operations against the same cursor id. The exception is a cursor
+     * pinned by a CursorPrefetcher, in which case this waits until the prefetch unpins it.
      */
     enum AuthCheck { kCheckSession = true, kNoCheckSession = false };
     StatusWith<ClientCursorPin> pinCursor(OperationContext* opCtx,
                                           CursorId id,
                                           AuthCheck checkSessionAuth = kCheckSession);
 
+    /**
+     * Pins the cursor 'id' on behalf of a CursorPrefetcher. 'prefetchDone' must become ready once
+     * the returned pin has been released, so that operations which try to pin the cursor in the
+     * meantime wait for it. Does not check the session's privileges, and throws CursorInUse if the
+     * cursor is already pinned.
+     */
+    StatusWith<ClientCursorPin> pinCursorForPrefetch(OperationContext* opCtx,
+                                                     CursorId id,
+                                                     SharedSemiFuture<void> prefetchDone);
+
     /**
      * Returns an OK status if the cursor was successfully killed, meaning either:
      * (1) The cursor was erased from the cursor registry
@@ -199,6 +213,11 @@ private:
 
     CursorId allocateCursorId_inlock();
 
+    StatusWith<ClientCursorPin> _pinCursor(OperationContext* opCtx,
+                                           CursorId id,
+                                           AuthCheck checkSessionAuth,
+                                           boost::optional<SharedSemiFuture<void>> prefetchDone);
+
     ClientCursorPin _registerCursor(
         OperationContext* opCtx, std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor);
 
@@ -213,6 +232,13 @@ private:
 
     bool cursorShouldTimeout_inlock(const ClientCursor* cursor, Date_t now);
 
+    /**
+     * Adds 'cursor' to the back of its partition's idle list if it is eligible to time out, or
+     * removes it from that list. The caller must hold the mutex for the cursor's partition.
+     */
+    void addToIdleList_inlock(ClientCursor* cursor);
+    void removeFromIdleList_inlock(ClientCursor* cursor);
+
     template <class T>
     void removeCursorFromMap(T& map, ClientCursor* cursor) {
         // Remove from the opKey map first since erasing from the map may free the pointer for
@@ -244,6 +270,13 @@ private:
     std::unique_ptr<Partitioned<stdx::unordered_map<CursorId, ClientCursor*>, kNumPartitions>>
         _cursorMap;
 
+    // For each partition of '_cursorMap', the unpinned cursors in that partition which may time
+    // out, in the order they were last unpinned. Since the least recently used cursor is at the
+    // front, timing out cursors only needs to look at the cursors which have actually expired
+    // rather than at every open cursor. Each list is protected by the mutex of its '_cursorMap'
+    // partition.
+    std::array<std::list<ClientCursor*>, kNumPartitions> _idleLists;
+
     // A mapping from client OperationKey to corresponding CursorID. Note that it's possible that
     // cursors in the map above are not present in this map, since OperationKey is not required when
     // registering a cursor.
@@ -0,0 +1,229 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/cursor_prefetcher.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/client.h"
+#include "mongo/db/clientcursor.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/cursor_manager.h"
+#include "mongo/db/cursor_server_params.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/query/find_common.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+MONGO_FAIL_POINT_DEFINE(hangBeforeCursorPrefetch);
+
+const auto getCursorPrefetcher = ServiceContext::declareDecoration<CursorPrefetcher>();
+
+Counter64 cursorPrefetchBatches;
+
+ServerStatusMetricField<Counter64> cursorPrefetchBatchesDisplay("cursor.prefetch.batches",
+                                                                &cursorPrefetchBatches);
+
+ThreadPool::Options makeThreadPoolOptions() {
+    ThreadPool::Options options;
+    options.poolName = "CursorPrefetcher";
+    options.minThreads = 0;
+    options.maxThreads = getCursorPrefetchMaxThreads();
+
+    // Ensure all threads have a client
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName.c_str());
+    };
+    return options;
+}
+
+}  // namespace
+
+CursorPrefetcher::CursorPrefetcher() : _threadPool(makeThreadPoolOptions()) {
+    _threadPool.startup();
+}
+
+CursorPrefetcher::~CursorPrefetcher() {
+    _threadPool.shutdown();
+    _threadPool.join();
+}
+
+CursorPrefetcher* CursorPrefetcher::get(ServiceContext* serviceContext) {
+    return &getCursorPrefetcher(serviceContext);
+}
+
+CursorPrefetcher* CursorPrefetcher::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool CursorPrefetcher::shouldPrefetch(OperationContext* opCtx, const ClientCursor& cursor) {
+    const auto* exec = cursor.getExecutor();
+    const auto* cq = exec->getCanonicalQuery();
+    if (!cq || !cq->getFindCommandRequest().getPrefetchNextBatch()) {
+        return false;
+    }
+
+    // Only plain reads of a single collection are prefetched. The prefetch has nobody to report
+    // resume tokens, awaited inserts, a deadline or a transaction's state to, and reads at the
+    // cursor's read concern only as long as that does not call for a particular timestamp.
+    const auto readConcernLevel = cursor.getReadConcernArgs().getLevel();
+    if (exec->lockPolicy() != PlanExecutor::LockPolicy::kLockExternally || cursor.isTailable() ||
+        cq->getFindCommandRequest().getRequestResumeToken() || cursor.getTxnNumber() ||
+        cursor.getLeftoverMaxTimeMicros() != Microseconds::max() ||
+        (readConcernLevel != repl::ReadConcernLevel::kLocalReadConcern &&
+         readConcernLevel != repl::ReadConcernLevel::kAvailableReadConcern)) {
+        return false;
+    }
+
+    // Exhaust cursors already send each next batch without waiting for a getMore, and cursors of a
+    // DBDirectClient are used from their original operation.
+    if (opCtx->isExhaust() || opCtx->getClient()->isInDirectClient()) {
+        return false;
+    }
+
+    // Once the results prefetched for all cursors hold the whole budget, the cursors which ask
+    // for more are left to their getMores.
+    if (ClientCursor::getTotalPrefetchedBytes() >= getCursorPrefetchMaxBufferedBytes()) {
+        return false;
+    }
+
+    return !cursor.hasPrefetchedResults() && !cursor.prefetchReachedEOF();
+}
+
+void CursorPrefetcher::schedule(CursorId cursorId, std::int64_t batchSize) {
+    _threadPool.schedule([this, cursorId, batchSize](Status status) {
+        if (!status.isOK()) {
+            // The pool is shutting down.
+            return;
+        }
+        _prefetch(cursorId, batchSize);
+    });
+}
+
+void CursorPrefetcher::_prefetch(CursorId cursorId, std::int64_t batchSize) {
+    auto opCtx = cc().makeOperationContext();
+
+    // Operations waiting to pin the cursor try again once this is ready, so it must only become
+    // ready after the pin below has been released.
+    SharedPromise<void> prefetchDone;
+    ON_BLOCK_EXIT([&] { prefetchDone.emplaceValue(); });
+
+    boost::optional<ClientCursorPin> pin;
+    try {
+        auto swPin = CursorManager::get(opCtx.get())
+                         ->pinCursorForPrefetch(opCtx.get(), cursorId, prefetchDone.getFuture());
+        if (!swPin.isOK()) {
+            // The cursor is gone, so there is nothing left to prefetch.
+            return;
+        }
+        pin.emplace(std::move(swPin.getValue()));
+    } catch (const ExceptionFor<ErrorCodes::CursorInUse>&) {
+        // The next getMore got to the cursor first, and will run the executor itself.
+        return;
+    }
+
+    _fillBuffer(opCtx.get(), *pin, batchSize);
+}
+
+void CursorPrefetcher::_fillBuffer(OperationContext* opCtx,
+                                   ClientCursorPin& pin,
+                                   std::int64_t batchSize) {
+    ClientCursor* cursor = pin.getCursor();
+    PlanExecutor* exec = cursor->getExecutor();
+
+    boost::optional<AutoGetCollectionForReadMaybeLockFree> readLock;
+    try {
+        hangBeforeCursorPrefetch.pauseWhileSet(opCtx);
+        readLock.emplace(opCtx, exec->nss());
+        uassertStatusOK(repl::ReplicationCoordinator::get(opCtx)->checkCanServeReadsFor(
+            opCtx, exec->nss(), true));
+    } catch (const DBException& ex) {
+        // Leave the cursor to the next getMore, which will run into the same problem unless it has
+        // gone away in the meantime, and report it.
+        LOGV2_DEBUG(6113600,
+                    2,
+                    "Skipping cursor prefetch",
+                    "cursorId"_attr = cursor->cursorid(),
+                    "error"_attr = ex.toStatus());
+        return;
+    }
+
+    exec->reattachToOperationContext(opCtx);
+    try {
+        exec->restoreState(&readLock->getCollection());
+
+        std::uint64_t numResults = 0;
+        BSONObj obj;
+        PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+        while (!FindCommon::enoughForGetMore(batchSize, numResults) &&
+               PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
+            // The same limits as for the batch of a getMore apply, so that the buffered results
+            // make up exactly one such batch.
+            // Prefetches running concurrently may each overshoot the budget that all cursors share
+            // by at most one result.
+            if (!FindCommon::haveSpaceForNext(obj, numResults, cursor->getPrefetchedBytes()) ||
+                ClientCursor::getTotalPrefetchedBytes() + obj.objsize() >
+                    getCursorPrefetchMaxBufferedBytes()) {
+                exec->enqueue(obj);
+                break;
+            }
+            cursor->appendPrefetchedResult(obj);
+            ++numResults;
+        }
+        if (state == PlanExecutor::IS_EOF) {
+            cursor->setPrefetchReachedEOF();
+        }
+        cursorPrefetchBatches.increment();
+
+        exec->saveState();
+    } catch (const DBException& ex) {
+        // Hand the error to the next getMore, which would otherwise have run into it itself. Once
+        // the executor is marked as killed, saving its state no longer touches the plan.
+        exec->markAsKilled(ex.toStatus());
+        try {
+            exec->saveState();
+        } catch (const DBException&) {
+            pin.deleteUnderlying();
+            return;
+        }
+    }
+    exec->detachFromOperationContext();
+}
+
+}  // namespace mongo
@@ -0,0 +1,82 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mongo/db/cursor_id.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class ClientCursor;
+class ClientCursorPin;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Produces the next batch of a find cursor which opted in with 'prefetchNextBatch' on a thread
+ * pool, while the client is still busy with the batch it was just sent. The results are buffered
+ * on the ClientCursor, and the next getMore returns them before running the executor itself.
+ *
+ * Prefetching is best-effort: if the next getMore pins the cursor first, the prefetch is skipped,
+ * and if it tries to pin the cursor while a prefetch holds it, the getMore waits for the prefetch
+ * to finish. Prefetching also stops while the results buffered for all cursors together hold the
+ * bytes allowed by 'cursorPrefetchMaxBufferedBytes'.
+ */
+class CursorPrefetcher {
+public:
+    CursorPrefetcher();
+    ~CursorPrefetcher();
+
+    static CursorPrefetcher* get(ServiceContext* serviceContext);
+    static CursorPrefetcher* get(OperationContext* opCtx);
+
+    /**
+     * Returns whether the next batch of 'cursor' should be produced ahead of time once the batch
+     * that 'opCtx' is returning has been sent. The caller must have 'cursor' pinned.
+     */
+    static bool shouldPrefetch(OperationContext* opCtx, const ClientCursor& cursor);
+
+    /**
+     * Schedules the prefetch of up to 'batchSize' results of the cursor 'cursorId', or as many
+     * results as fit in a batch if 'batchSize' is 0. The caller must have unpinned the cursor.
+     */
+    void schedule(CursorId cursorId, std::int64_t batchSize);
+
+private:
+    void _prefetch(CursorId cursorId, std::int64_t batchSize);
+
+    void _fillBuffer(OperationContext* opCtx, ClientCursorPin& pin, std::int64_t batchSize);
+
+    ThreadPool _threadPool;
+};
+
+}  // namespace mongo
@@ -47,4 +47,12 @@ Milliseconds getDefaultCursorTimeoutMillis() {
     return Milliseconds(kCursorTimeoutMillisDefault);
 }
 
+int getCursorPrefetchMaxThreads() {
+    return gCursorPrefetchMaxThreads;
+}
+
+long long getCursorPrefetchMaxBufferedBytes() {
+    return gCursorPrefetchMaxBufferedBytes.load();
+}
+
 }  // namespace mongo
@@ -41,4 +41,12 @@ long long getCursorTimeoutMillis();
 
 Milliseconds getDefaultCursorTimeoutMillis();
 
+// Maximum number of threads of the CursorPrefetcher. Configurable with server parameter
+// "cursorPrefetchMaxThreads".
+int getCursorPrefetchMaxThreads();
+
+// Maximum number of bytes held by the prefetched results of all cursors together. Configurable with
+// server parameter "cursorPrefetchMaxBufferedBytes".
+long long getCursorPrefetchMaxBufferedBytes();
+
 }  // namespace mongo
@@ -42,7 +42,9 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/wire_version.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/op_msg_rpc_impls.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/util/debug_util.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -82,6 +84,18 @@ void DBDirectClient::_auth(const BSONObj& params) {
     uasserted(2625701, "DBDirectClient should not authenticate");
 }
 
+std::unique_ptr<rpc::ReplyInterface> DBDirectClient::_parseReply(const Message& replyMsg) {
+    if (replyMsg.operation() != dbMsg) {
+        return DBClientBase::_parseReply(replyMsg);
+    }
+    // The reply was built in-process by this process's ServiceEntryPoint, from BSON which the
+    // server produced itself, and never went through the transport layer. Its BSON is trusted to
+    // be well-formed and is only validated again in debug builds, to catch a command which replies
+    // with malformed BSON.
+    return std::make_unique<rpc::OpMsgReply>(
+        OpMsg::parseOwned(replyMsg, kDebugBuild /* validateBSON */));
+}
+
 bool DBDirectClient::isFailed() const {
     return false;
 }
@@ -121,6 +121,8 @@ public:
 protected:
     void _auth(const BSONObj& params) override;
 
+    std::unique_ptr<rpc::ReplyInterface> _parseReply(const Message& replyMsg) override;
+
 private:
     OperationContext* _opCtx;
     LastError _lastError;  // This LastError will be used for all operations on this client.
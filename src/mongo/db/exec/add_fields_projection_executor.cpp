@@ -256,8 +256,9 @@ void AddFieldsProjectionExecutor::parse(const BSONObj& spec) {
 }
 
 Document AddFieldsProjectionExecutor::applyProjection(const Document& inputDoc) const {
-    // The output doc is the same as the input doc, with the added fields.
-    MutableDocument output(inputDoc);
+    // The output doc is the same as the input doc, with the added fields. Size the copy of the
+    // input for them up front, rather than growing it once they are appended.
+    MutableDocument output(inputDoc, _root->maxFieldsToAdd());
     _root->applyExpressions(inputDoc, &output);
 
     // Pass through the metadata.
@@ -40,6 +40,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo::projection_executor {
@@ -298,6 +299,39 @@ TEST(AddFieldsProjectionExecutorOptimize, ShouldOptimizeNestedExpressions) {
                        addition.serializeTransformation(ExplainOptions::Verbosity::kExecAllPlans));
 }
 
+// Verify that subexpressions shared by several computed fields are evaluated for each document.
+TEST(AddFieldsProjectionExecutorOptimize, SharesCommonSubexpressionsAcrossComputedFields) {
+    auto spec = fromjson(
+        "{total: {$multiply: ['$price', '$qty']}, 'tax.amount': {$multiply: [{$multiply: "
+        "['$price', '$qty']}, 0.5]}, big: {$cond: [{$gt: ['$qty', 2]}, {$multiply: ['$price', "
+        "'$qty']}, false]}}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    AddFieldsProjectionExecutor unshared(expCtx);
+    unshared.parse(spec);
+    unshared.optimize();
+
+    RAIIServerParameterControllerForTest controller(
+        "internalQueryProjectionShareCommonSubexpressions", true);
+    AddFieldsProjectionExecutor addition(expCtx);
+    addition.parse(spec);
+    addition.optimize();
+
+    // Sharing does not change the serialization.
+    ASSERT_DOCUMENT_EQ(unshared.serializeTransformation(boost::none),
+                       addition.serializeTransformation(boost::none));
+
+    // Each document gets its own values.
+    auto result = addition.applyProjection(Document{{"price", 2}, {"qty", 3}});
+    ASSERT_VALUE_EQ(result["total"], Value(6));
+    ASSERT_VALUE_EQ(result.getNestedField("tax.amount"), Value(3.0));
+    ASSERT_VALUE_EQ(result["big"], Value(6));
+
+    result = addition.applyProjection(Document{{"price", 5}, {"qty", 2}});
+    ASSERT_VALUE_EQ(result["total"], Value(10));
+    ASSERT_VALUE_EQ(result.getNestedField("tax.amount"), Value(5.0));
+    ASSERT_VALUE_EQ(result["big"], Value(false));
+}
+
 //
 // Top-level only.
 //
@@ -30,6 +30,8 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/bucket_unpacker.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 
 namespace mongo {
@@ -87,11 +89,19 @@ int BucketUnpacker::computeMeasurementCount(int targetTimestampObjSize) {
 
 void BucketUnpacker::reset(BSONObj&& bucket) {
     _fieldIters.clear();
+    _eventFilterIters.clear();
     _timeFieldIter = boost::none;
+    _numberOfMeasurements = 0;
 
     _bucket = std::move(bucket);
     uassert(5346510, "An empty bucket cannot be unpacked", !_bucket.isEmpty());
 
+    // Expand a compressed bucket up front so that the rest of the unpacker only needs to handle the
+    // plain data region layout.
+    if (auto decompressed = timeseries::decompressBucket(_bucket)) {
+        _bucket = std::move(*decompressed);
+    }
+
     auto&& dataRegion = _bucket.getField(timeseries::kBucketDataFieldName).Obj();
     if (dataRegion.isEmpty()) {
         // If the data field of a bucket is present but it holds an empty object, there's nothing to
@@ -148,8 +158,20 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
         }
     }
 
+    // Set up an iterator over the column each predicate of the event filter is evaluated against.
+    for (auto&& predicate : _eventFilterPredicates) {
+        auto path = predicate.expr->path();
+        if (auto column = dataRegion.getField(path); path != _spec.timeField && column) {
+            _eventFilterIters.emplace_back(BSONObjIterator{column.Obj()});
+        } else {
+            _eventFilterIters.emplace_back(boost::none);
+        }
+    }
+
     // Save the measurement count for the bucket.
     _numberOfMeasurements = computeMeasurementCount(timeFieldElem.objsize());
+
+    _skipMeasurementsNotMatchingEventFilter();
 }
 
 void BucketUnpacker::setBucketSpecAndBehavior(BucketSpec&& bucketSpec, Behavior behavior) {
@@ -178,6 +200,74 @@ void BucketUnpacker::addComputedMetaProjFields(const std::vector<StringData>& co
     }
 }
 
+void BucketUnpacker::setEventFilter(BSONObj filterBson, std::unique_ptr<MatchExpression> filter) {
+    _eventFilterPredicates.clear();
+
+    auto addPredicate = [&](const MatchExpression* expr) {
+        tassert(6102400,
+                "The event filter can only hold predicates on top-level measurement fields",
+                expr->getCategory() == MatchExpression::MatchCategory::kLeaf &&
+                    FieldRef{expr->path()}.numParts() == 1);
+        _eventFilterPredicates.push_back({expr, expr->matchesBSON(BSONObj())});
+    };
+    if (filter->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < filter->numChildren(); ++i) {
+            addPredicate(filter->getChild(i));
+        }
+    } else {
+        addPredicate(filter.get());
+    }
+
+    _eventFilterBson = std::move(filterBson);
+    _eventFilter = std::move(filter);
+}
+
+void BucketUnpacker::_skipMeasurementsNotMatchingEventFilter() {
+    if (_eventFilterPredicates.empty()) {
+        return;
+    }
+
+    auto matches = [](const EventFilterPredicate& predicate, const BSONElement& elem) {
+        if (!elem) {
+            return predicate.matchesMissing;
+        }
+        // Arrays need the full path semantics, which also consider each of their elements.
+        return elem.type() == BSONType::Array ? predicate.expr->matchesBSONElement(elem)
+                                              : predicate.expr->matchesSingleElement(elem);
+    };
+
+    while (hasNext()) {
+        auto&& timeElem = **_timeFieldIter;
+        auto currentIdx = timeElem.fieldNameStringData();
+
+        // Every filter column positioned at this measurement is advanced, even once a predicate
+        // has failed, so that the columns stay aligned with the timeField.
+        bool matched = true;
+        for (size_t i = 0; i < _eventFilterPredicates.size(); ++i) {
+            BSONElement elem;
+            if (auto& colIter = _eventFilterIters[i]) {
+                if (colIter->more() && (**colIter).fieldNameStringData() == currentIdx) {
+                    elem = colIter->next();
+                }
+            } else if (_eventFilterPredicates[i].expr->path() == _spec.timeField) {
+                elem = timeElem;
+            }
+            matched = matched && matches(_eventFilterPredicates[i], elem);
+        }
+        if (matched) {
+            return;
+        }
+
+        // Skip the measurement in the timeField and in every column which holds a value for it.
+        _timeFieldIter->advance(timeElem);
+        for (auto&& [_, colIter] : _fieldIters) {
+            if (colIter.more() && (*colIter).fieldNameStringData() == currentIdx) {
+                colIter.next();
+            }
+        }
+    }
+}
+
 Document BucketUnpacker::getNext() {
     tassert(5521503, "'getNext()' requires the bucket to be owned", _bucket.isOwned());
     tassert(5422100, "'getNext()' was called after the bucket has been exhausted", hasNext());
@@ -206,7 +296,9 @@ Document BucketUnpacker::getNext() {
         measurement.addField(name, Value{_computedMetaProjections[name]});
     }
 
-    return measurement.freeze();
+    auto result = measurement.freeze();
+    _skipMeasurementsNotMatchingEventFilter();
+    return result;
 }
 
 Document BucketUnpacker::extractSingleMeasurement(int j) {
@@ -34,6 +34,7 @@
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/matcher/expression.h"
 
 namespace mongo {
 /**
@@ -96,7 +97,8 @@ public:
 
     /**
      * This method will continue to materialize Documents until the bucket is exhausted. A
-     * precondition of this method is that 'hasNext()' must be true.
+     * precondition of this method is that 'hasNext()' must be true. Measurements which do not
+     * satisfy the event filter, if any, are skipped.
      */
     Document getNext();
 
@@ -144,7 +146,36 @@ public:
     // Add computed meta projection names to the bucket specification.
     void addComputedMetaProjFields(const std::vector<StringData>& computedFieldNames);
 
+    /**
+     * Sets a filter that measurements must satisfy to be returned by 'getNext()'. The filter is
+     * either a single predicate on a top-level measurement field, or a conjunction of them. It is
+     * evaluated directly against the columns of the bucket, so measurements which do not satisfy
+     * it are never materialized. 'filterBson' must own the BSON that 'filter' was parsed from.
+     */
+    void setEventFilter(BSONObj filterBson, std::unique_ptr<MatchExpression> filter);
+
+    const MatchExpression* eventFilter() const {
+        return _eventFilter.get();
+    }
+
+    const BSONObj& eventFilterBson() const {
+        return _eventFilterBson;
+    }
+
 private:
+    // A predicate of the event filter, along with whether it matches measurements which are missing
+    // the field it is on.
+    struct EventFilterPredicate {
+        const MatchExpression* expr;
+        bool matchesMissing;
+    };
+
+    /**
+     * Advances past the measurements which do not satisfy the event filter, so that the next
+     * measurement to be unpacked, if any, satisfies it.
+     */
+    void _skipMeasurementsNotMatchingEventFilter();
+
     BucketSpec _spec;
     Behavior _unpackerBehavior;
 
@@ -175,6 +206,17 @@ private:
 
     // The number of measurements in the bucket.
     int32_t _numberOfMeasurements = 0;
+
+    // The event filter and the BSON it was parsed from. The filter is immutable, so it is shared
+    // between copies of the unpacker.
+    BSONObj _eventFilterBson;
+    std::shared_ptr<const MatchExpression> _eventFilter;
+    std::vector<EventFilterPredicate> _eventFilterPredicates;
+
+    // Iterators over the columns that each of the '_eventFilterPredicates' is evaluated against,
+    // populated during the reset phase. Set to boost::none when the predicate is on the timeField,
+    // or when the bucket does not have the column.
+    std::vector<boost::optional<BSONObjIterator>> _eventFilterIters;
 };
 
 /**
@@ -32,6 +32,7 @@
 #include "mongo/bson/json.h"
 #include "mongo/db/exec/bucket_unpacker.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -102,6 +103,30 @@ TEST_F(BucketUnpackerTest, UnpackBasicIncludeAllMeasurementFields) {
     ASSERT_FALSE(unpacker.hasNext());
 }
 
+TEST_F(BucketUnpackerTest, UnpackCompressedBucket) {
+    std::set<std::string> fields{};
+
+    auto bucket = timeseries::compressBucket(
+        fromjson("{control: {version: 1}, meta: {'m1': 999}, data: {_id: {'0':1, '1':2}, "
+                 "time: {'0':1, '1':2}, a:{'0':1, '1':2}, b:{'1':'x'}}}"),
+        kUserDefinedTimeName);
+    ASSERT(bucket);
+    ASSERT_EQ((*bucket)["data"]["a"].type(), BSONType::BinData);
+
+    auto unpacker = makeBucketUnpacker(std::move(fields),
+                                       BucketUnpacker::Behavior::kExclude,
+                                       std::move(*bucket),
+                                       kUserDefinedMetaName.toString());
+
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker, Document{fromjson("{time: 1, myMeta: {m1: 999}, _id: 1, a: 1}")});
+
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker,
+                  Document{fromjson("{time: 2, myMeta: {m1: 999}, _id: 2, a: 2, b: 'x'}")});
+    ASSERT_FALSE(unpacker.hasNext());
+}
+
 TEST_F(BucketUnpackerTest, ExcludeASingleField) {
     std::set<std::string> fields{"b"};
 
@@ -95,6 +95,12 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
         // only support in the forward direction.
         invariant(params.direction == CollectionScanParams::FORWARD);
     }
+
+    if (params.synchronizeWithConcurrentScans) {
+        invariant(params.direction == CollectionScanParams::FORWARD);
+        invariant(!params.tailable && !params.minRecord && !params.maxRecord &&
+                  !params.resumeAfterRecordId && !params.requestResumeToken);
+    }
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -126,6 +132,9 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
 
             _cursor = collection()->getCursor(opCtx(), forward);
+            if (!_params.tailable) {
+                _cursor->enableReadAhead();
+            }
 
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
@@ -178,6 +187,16 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             record = _cursor->seekNear(*_params.maxRecord);
         }
 
+        if (_lastSeenId.isNull() && _params.synchronizeWithConcurrentScans) {
+            if (auto startPosition = registerSynchronizedScan()) {
+                // Join the other scans of the collection where they currently are.
+                record = _cursor->seekNear(*startPosition);
+                if (record) {
+                    _synchronizedStartId = record->id;
+                }
+            }
+        }
+
         if (!record) {
             record = _cursor->next();
         }
@@ -189,6 +208,19 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::NEED_YIELD;
     }
 
+    if (!record && _synchronizedStartId && !_wrappedAround) {
+        // A synchronized scan which started in the middle of the collection still has to go over
+        // the records before its start.
+        _wrappedAround = true;
+        _cursor = collection()->getCursor(opCtx(), true /* forward */);
+        _cursor->enableReadAhead();
+        return PlanStage::NEED_TIME;
+    }
+
+    if (record && _wrappedAround && record->id >= *_synchronizedStartId) {
+        record = boost::none;
+    }
+
     if (!record) {
         // We hit EOF. If we are tailable and have already seen data, leave us in a state to pick up
         // where we left off on the next call to work(). Otherwise, the EOF is permanent.
@@ -196,10 +228,17 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             _cursor.reset();
         } else {
             _commonStats.isEOF = true;
+            _synchronizedScan.reset();
         }
         return PlanStage::IS_EOF;
     }
 
+    if (_synchronizedScan &&
+        ++_recordsSinceReport >= SynchronizedCollectionScans::kReportInterval) {
+        _synchronizedScan->reportPosition(record->id);
+        _recordsSinceReport = 0;
+    }
+
     _lastSeenId = record->id;
     if (_params.assertTsHasNotFallenOffOplog) {
         assertTsHasNotFallenOffOplog(*record);
@@ -251,6 +290,17 @@ void CollectionScan::assertTsHasNotFallenOffOplog(const Record& record) {
     _params.assertTsHasNotFallenOffOplog = boost::none;
 }
 
+boost::optional<RecordId> CollectionScan::registerSynchronizedScan() {
+    if (!_synchronizedScan) {
+        auto scans = SynchronizedCollectionScans::get(collection());
+        if (!scans) {
+            return boost::none;
+        }
+        _synchronizedScan.emplace(std::move(scans));
+    }
+    return _synchronizedScan->startPosition();
+}
+
 namespace {
 bool atEndOfRangeInclusive(const CollectionScanParams& params, const WorkingSetMember& member) {
     if (params.direction == CollectionScanParams::FORWARD) {
@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/exec/synchronized_collection_scans.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 #include "mongo/s/resharding/resume_token_gen.h"
@@ -117,6 +118,12 @@ private:
      */
     void assertTsHasNotFallenOffOplog(const Record& record);
 
+    /**
+     * Registers this scan with the other synchronized scans of the collection, if it hasn't been
+     * registered yet, and returns the position at which it should start.
+     */
+    boost::optional<RecordId> registerSynchronizedScan();
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
@@ -133,6 +140,14 @@ private:
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
 
+    // Only set if _params.synchronizeWithConcurrentScans is set. If the scan started in the middle
+    // of the collection, '_synchronizedStartId' is the first record it returned and the scan ends
+    // when it gets back to it, after '_wrappedAround' to the beginning of the collection.
+    boost::optional<SynchronizedCollectionScans::Registration> _synchronizedScan;
+    boost::optional<RecordId> _synchronizedStartId;
+    bool _wrappedAround{false};
+    int _recordsSinceReport{0};
+
     // Stats
     CollectionScanStats _specificStats;
 };
@@ -85,6 +85,12 @@ struct CollectionScanParams {
 
     // Whether or not to wait for oplog visibility on oplog collection scans.
     bool shouldWaitForOplogVisibility = false;
+
+    // If true, the scan starts at the current position of the other synchronized scans of the
+    // collection, if there are any, and wraps around to the beginning of the collection to finish.
+    // May only be set on forward, non-tailable scans without bounds, which are not required to
+    // return the records in RecordId order.
+    bool synchronizeWithConcurrentScans = false;
 };
 
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/delete.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
@@ -77,7 +78,11 @@ DeleteStage::DeleteStage(ExpressionContext* expCtx,
       _params(std::move(params)),
       _ws(ws),
       _idRetrying(WorkingSet::INVALID_ID),
-      _idReturning(WorkingSet::INVALID_ID) {
+      _idReturning(WorkingSet::INVALID_ID),
+      _writeBatchSize(_params->isMulti && !_params->returnDeleted && !_params->removeSaver &&
+                              !_params->isExplain && !expCtx->opCtx->inMultiDocumentTransaction()
+                          ? std::max(size_t{1}, _params->writeBatchSize)
+                          : 1) {
     _children.emplace_back(child);
 }
 
@@ -86,7 +91,7 @@ bool DeleteStage::isEOF() {
         return true;
     }
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
-        child()->isEOF();
+        _batchIdsRetrying.empty() && child()->isEOF();
 }
 
 PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
@@ -94,6 +99,10 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_writeBatchSize > 1) {
+        return doBatchedWork(out);
+    }
+
     // It is possible that after a delete was executed, a WriteConflictException occurred
     // and prevented us from returning ADVANCED with the old version of the document.
     if (_idReturning != WorkingSet::INVALID_ID) {
@@ -181,9 +190,6 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
         uassertStatusOK(_params->removeSaver->goingToDelete(bsonObjDoc));
     }
 
-    // TODO: Do we want to buffer docs and delete them in a group rather than saving/restoring state
-    // repeatedly?
-
     try {
         child()->saveState();
     } catch (const WriteConflictException&) {
@@ -250,6 +256,106 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
     return PlanStage::NEED_TIME;
 }
 
+PlanStage::StageState DeleteStage::doBatchedWork(WorkingSetID* out) {
+    std::vector<WorkingSetID> batch;
+    batch.reserve(_writeBatchSize);
+    auto retryBatch = [&] {
+        _batchIdsRetrying.insert(_batchIdsRetrying.begin(), batch.begin(), batch.end());
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    };
+
+    // A batch does no more of our child's work than it has room for documents, so that the caller
+    // still gets to yield about as often as without batching.
+    StageState status = NEED_TIME;
+    try {
+        for (size_t works = 0; works < _writeBatchSize; ++works) {
+            WorkingSetID id;
+            if (!_batchIdsRetrying.empty()) {
+                id = _batchIdsRetrying.front();
+                _batchIdsRetrying.pop_front();
+                status = ADVANCED;
+            } else {
+                status = child()->work(&id);
+            }
+
+            if (status == NEED_TIME) {
+                continue;
+            }
+            if (status != ADVANCED) {
+                if (status == NEED_YIELD) {
+                    *out = id;
+                }
+                break;
+            }
+
+            WorkingSetMember* member = _ws->get(id);
+            invariant(member->hasRecordId());
+            invariant(member->hasObj());
+
+            // The member is part of the batch while we check it, so that it is retried if the
+            // check hits a write conflict.
+            batch.push_back(id);
+            if (!write_stage_common::ensureStillMatches(
+                    collection(), opCtx(), _ws, id, _params->canonicalQuery)) {
+                batch.pop_back();
+                _ws->free(id);
+                continue;
+            }
+
+            // saveState() may free the memory the BSONObj points to, which deleteDocuments()
+            // still needs.
+            member->makeObjOwnedIfNeeded();
+        }
+    } catch (const WriteConflictException&) {
+        return retryBatch();
+    }
+
+    if (batch.empty()) {
+        return status == ADVANCED ? NEED_TIME : status;
+    }
+
+    std::vector<BSONObj> docs;
+    std::vector<BsonRecord> bsonRecords;
+    docs.reserve(batch.size());
+    bsonRecords.reserve(batch.size());
+    for (auto&& id : batch) {
+        WorkingSetMember* member = _ws->get(id);
+        docs.push_back(member->doc.value().toBson());
+        bsonRecords.push_back({member->recordId, Timestamp(), &docs.back()});
+    }
+
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    try {
+        WriteUnitOfWork wunit(opCtx());
+        collection()->deleteDocuments(
+            opCtx(), bsonRecords, _params->stmtId, _params->opDebug, _params->fromMigrate);
+        wunit.commit();
+    } catch (const WriteConflictException&) {
+        return retryBatch();
+    }
+    _specificStats.docsDeleted += batch.size();
+
+    for (auto&& id : batch) {
+        _ws->free(id);
+    }
+
+    // Restore the state outside of the WriteUnitOfWork, as in doWork().
+    try {
+        child()->restoreState(&collection());
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    return status == ADVANCED ? NEED_TIME : status;
+}
+
 void DeleteStage::doRestoreStateRequiresCollection() {
     const NamespaceString& ns = collection()->ns();
     uassert(ErrorCodes::PrimarySteppedDown,
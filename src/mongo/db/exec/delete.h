@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/logical_session_id.h"
@@ -67,6 +69,11 @@ struct DeleteStageParams {
     // The stmtId for this particular delete.
     StmtId stmtId = kUninitializedStmtId;
 
+    // The number of documents a multi delete removes per storage transaction. Ignored unless the
+    // delete is a multi delete which returns nothing, has no removeSaver, is not explained and is
+    // not part of a multi-document transaction.
+    size_t writeBatchSize = 1;
+
     // The parsed query predicate for this delete. Not owned here.
     CanonicalQuery* canonicalQuery;
 
@@ -130,6 +137,16 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * The doWork() of multi deletes which remove '_writeBatchSize' documents per storage
+     * transaction. Collects documents until the batch is full or the child returns anything but a
+     * document, then deletes them together and returns what the child returned, or NEED_TIME.
+     *
+     * If deleting the batch hits a write conflict, all of its documents are retried after the
+     * yield.
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
     std::unique_ptr<DeleteStageParams> _params;
 
     // Not owned by us.
@@ -141,6 +158,13 @@ private:
     // If not WorkingSet::INVALID_ID, we return this member to our caller.
     WorkingSetID _idReturning;
 
+    // The number of documents deleted per storage transaction. One unless batching applies.
+    const size_t _writeBatchSize;
+
+    // The members of a batch whose delete hit a write conflict, which we use, in order, before
+    // asking our child for more.
+    std::deque<WorkingSetID> _batchIdsRetrying;
+
     // Stats
     DeleteStats _specificStats;
 };
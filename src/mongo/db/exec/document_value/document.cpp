@@ -161,10 +161,28 @@ Position DocumentStorage::findField(StringData requested, LookupPolicy policy) c
         return pos;
     }
 
-    for (auto&& bsonElement : _bson) {
+    // Every field of the backing BSON before '_bsonScanOffset' has already been brought into the
+    // cache, so a field that missed the cache can only be found at or past that point. Fields tend
+    // to be requested in the order they appear in the BSON, which makes the field looked for next
+    // the first one examined. This also leaves the first of several fields with the same name as
+    // the one that is found, just as a scan from the start of the BSON would.
+    const char* const objStart = _bson.objdata();
+    const char* const firstElement = objStart + sizeof(int32_t);
+    const char* const resumeAt = firstElement + _bsonScanOffset;
+    const char* const objEnd = objStart + _bson.objsize() - 1;
+
+    for (const char* pos = resumeAt; pos < objEnd;) {
+        BSONElement bsonElement(pos);
+        const auto elementSize = bsonElement.size();
         if (requested == bsonElement.fieldNameStringData()) {
-            return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+            auto self = const_cast<DocumentStorage*>(this);
+            if (pos == resumeAt) {
+                // Nothing was skipped over, so the fields before the new offset are all cached.
+                self->_bsonScanOffset += elementSize;
+            }
+            return self->constructInCache(bsonElement);
         }
+        pos += elementSize;
     }
 
     // if we got here, there's no such field
@@ -295,17 +313,34 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
     _cacheEnd = _cache + newSize;
 }
 
-intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
+intrusive_ptr<DocumentStorage> DocumentStorage::clone(size_t expectedAdditionalFields) const {
     auto out =
         make_intrusive<DocumentStorage>(_bson, _stripMetadata, _modified, _numBytesFromBSONInCache);
 
     if (_cache) {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
-        const size_t bufferBytes = allocatedBytes();
+        size_t bufferBytes = allocatedBytes();
+        if (expectedAdditionalFields) {
+            // Leave room for the fields the caller is about to append, so that they don't force
+            // another allocation and copy of the buffer we are making here. Like reserveFields(),
+            // this assumes short field names and allows one extra element for long ones.
+            const size_t wanted = _usedBytes +
+                (expectedAdditionalFields + 1) * ValueElement::align(sizeof(ValueElement));
+            while (bufferBytes < wanted + hashTabBytes())
+                bufferBytes *= 2;
+            uassert(6106200,
+                    "Tried to make oversized document",
+                    bufferBytes <= size_t(BufferMaxSize));
+        }
+
         out->_cache = new char[bufferBytes];
-        out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
-        memcpy(out->_cache, _cache, bufferBytes);
+        out->_cacheEnd = out->_cache + bufferBytes - hashTabBytes();
+        memcpy(out->_cache, _cache, _usedBytes);
+
+        // The bucket count is unchanged, so the hash table can be copied as is to its new place
+        // at the end of the buffer.
+        memcpy(out->_cacheEnd, _cacheEnd, hashTabBytes());
 
         out->_hashTabMask = _hashTabMask;
         out->_usedBytes = _usedBytes;
@@ -324,6 +359,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         dassert(out->_numFields == _numFields);
     }
 
+    out->_bsonScanOffset = _bsonScanOffset;
     out->_haveLazyLoadedMetadata = _haveLazyLoadedMetadata;
     out->_metadataFields = _metadataFields;
 
@@ -345,6 +381,7 @@ DocumentStorage::~DocumentStorage() {
 void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
     _bson = bson;
     _numBytesFromBSONInCache = 0;
+    _bsonScanOffset = 0;
     _stripMetadata = stripMetadata;
     _modified = false;
 
@@ -349,7 +349,10 @@ public:
         return _storage && !_storage->isShared();
     }
 
-    /// only for testing
+    /**
+     * Returns the address of the underlying storage. Two documents with the same address have the
+     * same fields and metadata, as storage is copied before a shared document is modified.
+     */
     const void* getPtr() const {
         return _storage.get();
     }
@@ -497,6 +500,17 @@ public:
         reset(std::move(d));
     }
 
+    /**
+     * Like above, but if the storage of 'd' has to be cloned on write, the clone is given room
+     * for 'expectedAdditionalFields' new fields. As with 'expectedFields', this is only a hint.
+     */
+    MutableDocument(Document d, size_t expectedAdditionalFields)
+        : _storageHolder(nullptr),
+          _storage(_storageHolder),
+          _expectedAdditionalFields(expectedAdditionalFields) {
+        reset(std::move(d));
+    }
+
     ~MutableDocument() {
         if (_storageHolder)
             intrusive_ptr_release(_storageHolder);
@@ -726,7 +740,7 @@ private:
         return const_cast<DocumentStorage&>(*storagePtr());
     }
     DocumentStorage& clonedStorage() {
-        reset(storagePtr()->clone());
+        reset(storagePtr()->clone(_expectedAdditionalFields));
         return const_cast<DocumentStorage&>(*storagePtr());
     }
 
@@ -744,6 +758,9 @@ private:
     // They always point to NULL or an object with dynamic type DocumentStorage.
     const RefCountable* _storageHolder;  // Only used in constructors and destructor
     const RefCountable*& _storage;  // references either above member or genericRCPtr in a Value
+
+    // Room to leave for new fields when the storage has to be cloned on write.
+    size_t _expectedAdditionalFields = 0;
 };
 
 /// This is the public iterator over a document
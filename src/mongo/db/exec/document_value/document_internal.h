@@ -400,8 +400,11 @@ public:
         return DocumentStorageCacheIterator(_firstElement, end());
     }
 
-    /// Shallow copy of this. Caller owns memory.
-    boost::intrusive_ptr<DocumentStorage> clone() const;
+    /**
+     * Shallow copy of this. Caller owns memory. 'expectedAdditionalFields' is a hint at how many
+     * fields the caller is going to append to the copy, used to size its buffer.
+     */
+    boost::intrusive_ptr<DocumentStorage> clone(size_t expectedAdditionalFields = 0) const;
 
     size_t allocatedBytes() const {
         return !_cache ? 0 : (_cacheEnd - _cache + hashTabBytes());
@@ -596,6 +599,10 @@ private:
     // whole backing BSON, but only the portion of backing BSON that's not already in the cache.
     uint32_t _numBytesFromBSONInCache = 0;
 
+    // Offset from the first element of '_bson' at which findField() starts its scan of the
+    // backing BSON. Every field before it has already been brought into the cache.
+    uint32_t _bsonScanOffset = 0;
+
     // If '_stripMetadata' is true, tracks whether or not the metadata has been lazy-loaded from the
     // backing '_bson' object. If so, then no attempt will be made to load the metadata again, even
     // if the metadata has been released by a call to 'releaseMetadata()'.
@@ -126,6 +126,32 @@ TEST(DocumentConstruction, FromEmptyDocumentClone) {
     ASSERT_DOCUMENT_EQ(document, documentClone3);
 }
 
+TEST(DocumentConstruction, CloneOnWriteLeavesRoomForExpectedAdditionalFields) {
+    MutableDocument original;
+    for (int i = 0; i < 10; ++i) {
+        original.addField("a" + std::to_string(i), Value(i));
+    }
+    const auto document = original.freeze();
+    const auto positionOfLast = document.positionOf("a9");
+
+    const int numAdditionalFields = 20;
+    MutableDocument md(document, numAdditionalFields);
+    md.addField("b0", Value(0));
+    const auto sizeAfterClone = md.peek().getApproximateSize();
+    for (int i = 1; i < numAdditionalFields; ++i) {
+        md.addField("b" + std::to_string(i), Value(i));
+    }
+
+    // None of the additions had to grow the cloned buffer.
+    ASSERT_EQ(sizeAfterClone, md.peek().getApproximateSize());
+
+    // Positions from the original document still refer to the same fields.
+    ASSERT_VALUE_EQ(Value(9), md.peek()[positionOfLast]);
+    ASSERT_VALUE_EQ(Value(19), md.peek()["b19"]);
+    ASSERT_EQ(10ULL, document.computeSize());
+    ASSERT_EQ(30ULL, md.peek().computeSize());
+}
+
 TEST(DocumentConstruction, FromBsonReset) {
     auto document = Document{{"a", 1}, {"b", "q"_sd}};
     auto bson = toBson(document);
@@ -176,6 +202,46 @@ TEST(DocumentSerialization, CannotSerializeDocumentThatExceedsDepthLimit) {
     throwaway.abandon();
 }
 
+TEST(DocumentGetField, FindsBsonFieldsRequestedInAnyOrder) {
+    const BSONObj bson = BSON("a" << 1 << "b" << 2 << "c" << 3 << "d" << 4 << "e" << 5);
+
+    // In order, so that each lookup resumes right where the previous one stopped.
+    Document inOrder(bson);
+    ASSERT_VALUE_EQ(Value(1), inOrder["a"]);
+    ASSERT_VALUE_EQ(Value(2), inOrder["b"]);
+    ASSERT_VALUE_EQ(Value(5), inOrder["e"]);
+    ASSERT_TRUE(inOrder["f"].missing());
+    ASSERT_VALUE_EQ(Value(3), inOrder["c"]);
+    ASSERT_VALUE_EQ(Value(4), inOrder["d"]);
+
+    // Backwards, so that no lookup can start past the fields that are already cached.
+    Document backwards(bson);
+    ASSERT_VALUE_EQ(Value(5), backwards["e"]);
+    ASSERT_VALUE_EQ(Value(4), backwards["d"]);
+    ASSERT_VALUE_EQ(Value(3), backwards.clone()["c"]);
+    ASSERT_VALUE_EQ(Value(2), backwards["b"]);
+    ASSERT_VALUE_EQ(Value(1), backwards["a"]);
+    ASSERT_TRUE(backwards[""].missing());
+
+    ASSERT_BSONOBJ_EQ(bson, inOrder.toBson());
+    ASSERT_BSONOBJ_EQ(bson, backwards.toBson());
+}
+
+TEST(DocumentGetField, FindsFirstOfDuplicateBsonFields) {
+    const BSONObj bson = BSON("a" << 1 << "b" << 2 << "a" << 3 << "c" << 4);
+
+    Document afterLaterField(bson);
+    ASSERT_VALUE_EQ(Value(2), afterLaterField["b"]);
+    ASSERT_VALUE_EQ(Value(1), afterLaterField["a"]);
+    ASSERT_VALUE_EQ(Value(4), afterLaterField["c"]);
+
+    Document inOrder(bson);
+    ASSERT_VALUE_EQ(Value(1), inOrder["a"]);
+    ASSERT_VALUE_EQ(Value(2), inOrder["b"]);
+    ASSERT_VALUE_EQ(Value(1), inOrder["a"]);
+    ASSERT_VALUE_EQ(Value(4), inOrder.clone()["c"]);
+}
+
 TEST(DocumentGetFieldNonCaching, UncachedTopLevelFields) {
     BSONObj bson = BSON("scalar" << 1 << "array" << BSON_ARRAY(1 << 2 << 3) << "scalar2" << true);
     Document document = fromBson(bson);
@@ -55,10 +55,18 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
                          const CollectionPtr& collection,
                          const IndexDescriptor* descriptor)
     : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
-      _workingSet(ws),
-      _key(query->getQueryObj()["_id"].wrap()) {
+      _workingSet(ws) {
     _specificStats.indexName = descriptor->indexName();
     _addKeyMetadata = query->getFindCommandRequest().getReturnKey();
+
+    const auto& queryObj = query->getQueryObj();
+    if (CanonicalQuery::isSimpleIdInQuery(queryObj)) {
+        for (auto&& elt : queryObj["_id"]["$in"].Obj()) {
+            _keys.push_back(BSON("_id" << elt));
+        }
+    } else {
+        _keys.push_back(queryObj["_id"].wrap());
+    }
 }
 
 IDHackStage::IDHackStage(ExpressionContext* expCtx,
@@ -68,7 +76,7 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
                          const IndexDescriptor* descriptor)
     : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
       _workingSet(ws),
-      _key(key) {
+      _keys{key} {
     _specificStats.indexName = descriptor->indexName();
 }
 
@@ -83,10 +91,14 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_keys.size() > 1) {
+        return doWorkForMultipleKeys(out);
+    }
+
     WorkingSetID id = WorkingSet::INVALID_ID;
     try {
         // Look up the key by going directly to the index.
-        auto recordId = indexAccessMethod()->findSingle(opCtx(), collection(), _key);
+        auto recordId = indexAccessMethod()->findSingle(opCtx(), collection(), _keys.front());
 
         // Key not found.
         if (recordId.isNull()) {
@@ -129,6 +141,54 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
     }
 }
 
+PlanStage::StageState IDHackStage::doWorkForMultipleKeys(WorkingSetID* out) {
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    try {
+        if (!_recordIds) {
+            // Look up all of the keys at once, so that the index is traversed only once and the
+            // documents can be fetched in the order in which they are stored.
+            _recordIds = indexAccessMethod()->findMultiple(opCtx(), collection(), _keys);
+            _specificStats.keysExamined += _recordIds->size();
+        }
+
+        if (_nextRecordId == _recordIds->size()) {
+            _done = true;
+            return PlanStage::IS_EOF;
+        }
+
+        ++_specificStats.docsExamined;
+
+        id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = (*_recordIds)[_nextRecordId];
+        _workingSet->transitionToRecordIdAndIdx(id);
+
+        const auto& coll = collection();
+        if (!_recordCursor)
+            _recordCursor = coll->getCursor(opCtx());
+
+        const bool fetched = WorkingSetCommon::fetch(
+            opCtx(), _workingSet, id, _recordCursor.get(), coll, coll->ns());
+        ++_nextRecordId;
+        if (!fetched) {
+            // The document was deleted since its key was looked up, for instance while yielding.
+            _workingSet->free(id);
+            *out = WorkingSet::INVALID_ID;
+            return NEED_TIME;
+        }
+
+        return advance(id, member, out);
+    } catch (const WriteConflictException&) {
+        // Retry the lookup or the fetch which failed.
+        _recordCursor.reset();
+        if (id != WorkingSet::INVALID_ID)
+            _workingSet->free(id);
+
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+}
+
 PlanStage::StageState IDHackStage::advance(WorkingSetID id,
                                            WorkingSetMember* member,
                                            WorkingSetID* out) {
@@ -136,10 +196,10 @@ PlanStage::StageState IDHackStage::advance(WorkingSetID id,
 
     if (_addKeyMetadata) {
         BSONObj ownedKeyObj = member->doc.value().toBson()["_id"].wrap().getOwned();
-        member->metadata().setIndexKey(IndexKeyEntry::rehydrateKey(_key, ownedKeyObj));
+        member->metadata().setIndexKey(IndexKeyEntry::rehydrateKey(_keys.front(), ownedKeyObj));
     }
 
-    _done = true;
+    _done = !_recordIds || _nextRecordId == _recordIds->size();
     *out = id;
     return PlanStage::ADVANCED;
 }
@@ -44,6 +44,10 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * For an $in on _id, all of the requested keys are looked up in a single pass over the _id index
+ * and the documents are then returned in RecordId order, rather than in the order of the _id
+ * index.
  */
 class IDHackStage final : public RequiresIndexStage {
 public:
@@ -91,15 +95,28 @@ private:
      */
     StageState advance(WorkingSetID id, WorkingSetMember* member, WorkingSetID* out);
 
+    /**
+     * Returns the next document matching one of the values of an $in, fetching the documents in
+     * the order of their RecordIds.
+     */
+    StageState doWorkForMultipleKeys(WorkingSetID* out);
+
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 
     // The WorkingSet we annotate with results.  Not owned by us.
     WorkingSet* _workingSet;
 
-    // The value to match against the _id field.
-    BSONObj _key;
+    // The values to match against the _id field. There is more than one when the query is an $in.
+    std::vector<BSONObj> _keys;
+
+    // The RecordIds of the documents matching '_keys' in increasing order, once they have been
+    // looked up in the index. Only used when the query is an $in.
+    boost::optional<std::vector<RecordId>> _recordIds;
+
+    // The position in '_recordIds' of the next document to fetch.
+    size_t _nextRecordId = 0;
 
-    // Have we returned our one document?
+    // Have we returned all of our documents?
     bool _done = false;
 
     // Do we need to add index key metadata for returnKey?
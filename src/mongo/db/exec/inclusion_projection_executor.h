@@ -76,6 +76,14 @@ public:
         return _children.size() + _projectedFields.size();
     }
 
+    /**
+     * Returns an upper bound on the number of fields this node adds to the document it is applied
+     * to, at its own level.
+     */
+    size_t maxFieldsToAdd() const {
+        return _children.size() + _expressions.size();
+    }
+
     // The following two methods extract from the InclusionNode computed projections that depend
     // only on the 'oldName' field. We need two versions for $project and $addFields, due to
     // different functionality: we need to replace the fields in $project to not lose them, and we
@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/index_fast_count.h"
+
+#include "mongo/db/index/index_access_method.h"
+
+namespace mongo {
+
+const char* IndexFastCountStage::kStageType = "INDEX_FAST_COUNT";
+
+IndexFastCountStage::IndexFastCountStage(ExpressionContext* expCtx,
+                                         const CollectionPtr& collection,
+                                         const IndexDescriptor* indexDescriptor,
+                                         WorkingSet* workingSet,
+                                         long long skip,
+                                         long long limit)
+    : RequiresIndexStage(kStageType, expCtx, collection, indexDescriptor, workingSet),
+      _skip(skip),
+      _limit(limit) {
+    invariant(_skip >= 0);
+    invariant(_limit >= 0);
+    _specificStats.indexName = indexDescriptor->indexName();
+}
+
+std::unique_ptr<PlanStageStats> IndexFastCountStage::getStats() {
+    auto planStats = std::make_unique<PlanStageStats>(_commonStats, STAGE_INDEX_FAST_COUNT);
+    planStats->specific = std::make_unique<IndexFastCountStats>(_specificStats);
+    return planStats;
+}
+
+PlanStage::StageState IndexFastCountStage::doWork(WorkingSetID* out) {
+    // This stage never returns a working set member.
+    *out = WorkingSet::INVALID_ID;
+
+    // The key count was known when the plan was chosen, and a key count is never discarded.
+    auto keyCount = indexAccessMethod()->getSortedDataInterface()->fastKeyCount(opCtx());
+    tassert(6112900, "Index no longer maintains its number of keys", keyCount);
+    long long nCounted = *keyCount;
+
+    if (_skip) {
+        nCounted -= _skip;
+        if (nCounted < 0) {
+            nCounted = 0;
+        }
+    }
+
+    if (_limit < nCounted && 0 != _limit) {
+        nCounted = _limit;
+    }
+
+    _specificStats.nCounted = nCounted;
+    _specificStats.nSkipped = _skip;
+    _commonStats.isEOF = true;
+
+    return PlanStage::IS_EOF;
+}
+
+}  // namespace mongo
@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/exec/requires_index_stage.h"
+
+namespace mongo {
+
+/**
+ * Implements "fast count" by asking the storage engine for the number of keys it maintains for a
+ * partial index, applying the skip and limit if necessary. The result is stored in
+ * '_specificStats'. Only used to answer count commands whose query is equivalent to the filter of
+ * the partial index, which must not be multikey, so that each matching document has one key.
+ */
+class IndexFastCountStage final : public RequiresIndexStage {
+public:
+    static const char* kStageType;
+
+    IndexFastCountStage(ExpressionContext* expCtx,
+                        const CollectionPtr& collection,
+                        const IndexDescriptor* indexDescriptor,
+                        WorkingSet* workingSet,
+                        long long skip,
+                        long long limit);
+
+    bool isEOF() override {
+        return _commonStats.isEOF;
+    }
+
+    StageState doWork(WorkingSetID* out) override;
+
+    StageType stageType() const override {
+        return StageType::STAGE_INDEX_FAST_COUNT;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() override;
+
+    const SpecificStats* getSpecificStats() const override {
+        return &_specificStats;
+    }
+
+protected:
+    void doSaveStateRequiresIndex() override {}
+
+    void doRestoreStateRequiresIndex() override {}
+
+private:
+    long long _skip = 0;
+    long long _limit = 0;
+
+    IndexFastCountStats _specificStats;
+};
+
+}  // namespace mongo
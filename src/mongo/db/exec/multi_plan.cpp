@@ -50,6 +50,7 @@
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/plan_ranker_util.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
@@ -174,6 +175,7 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             if (!moreToDo) {
                 break;
             }
+            abandonLosingPlans(numResults);
         }
     } catch (DBException& e) {
         return e.toStatus().withContext("error while multiplanner was selecting best plan");
@@ -289,6 +291,38 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
     return !doneWorking;
 }
 
+void MultiPlanStage::abandonLosingPlans(size_t numResults) {
+    const double abandonRatio = internalQueryPlanEvaluationAbandonRatio.load();
+    if (abandonRatio <= 0) {
+        return;
+    }
+
+    size_t mostResults = 0;
+    for (auto&& candidate : _candidates) {
+        if (candidate.status.isOK()) {
+            mostResults = std::max(mostResults, candidate.results.size());
+        }
+    }
+    if (mostResults < std::max<size_t>(numResults / 4, 1)) {
+        return;
+    }
+
+    for (auto&& candidate : _candidates) {
+        if (candidate.status.isOK() && candidate.results.size() < abandonRatio * mostResults) {
+            candidate.status =
+                Status(ErrorCodes::QueryPlanKilled,
+                       "Candidate plan was abandoned during the trial period (6108200)");
+            ++_failureCount;
+            LOGV2_DEBUG(6108201,
+                        2,
+                        "Abandoning candidate plan which fell behind during the trial period",
+                        "numResults"_attr = candidate.results.size(),
+                        "leaderNumResults"_attr = mostResults,
+                        "solution"_attr = redact(candidate.solution->toString()));
+        }
+    }
+}
+
 bool MultiPlanStage::hasBackupPlan() const {
     return kNoSuchPlan != _backupPlanIdx;
 }
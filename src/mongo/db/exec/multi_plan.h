@@ -153,6 +153,14 @@ private:
      */
     bool workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Stops working the candidates which have fallen too far behind the candidate which has
+     * returned the most results, as configured by 'internalQueryPlanEvaluationAbandonRatio'. Every
+     * candidate has been worked the same number of times, so they would rank below the leader.
+     * Abandoned candidates are marked as failed, and take no part in the ranking.
+     */
+    void abandonLosingPlans(size_t numResults);
+
     /**
      * Checks whether we need to perform either a timing-based yield or a yield for a document
      * fetch. If so, then uses 'yieldPolicy' to actually perform the yield.
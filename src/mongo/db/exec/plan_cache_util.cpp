@@ -33,7 +33,9 @@
 
 #include "mongo/db/exec/plan_cache_util.h"
 
+#include "mongo/db/query/collection_index_usage_tracker_decoration.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo::plan_cache_util {
@@ -69,4 +71,123 @@ void logNotCachingNoData(std::string&& solution) {
                 "solutions"_attr = redact(solution));
 }
 }  // namespace log_detail
+
+namespace {
+void collectIndexesUsed(const QuerySolutionNode* node, StringSet* indexes) {
+    switch (node->getType()) {
+        case STAGE_IXSCAN:
+            indexes->insert(static_cast<const IndexScanNode*>(node)->index.identifier.catalogName);
+            break;
+        case STAGE_COUNT_SCAN:
+            indexes->insert(static_cast<const CountScanNode*>(node)->index.identifier.catalogName);
+            break;
+        case STAGE_DISTINCT_SCAN:
+            indexes->insert(static_cast<const DistinctNode*>(node)->index.identifier.catalogName);
+            break;
+        case STAGE_GEO_NEAR_2D:
+            indexes->insert(
+                static_cast<const GeoNear2DNode*>(node)->index.identifier.catalogName);
+            break;
+        case STAGE_GEO_NEAR_2DSPHERE:
+            indexes->insert(
+                static_cast<const GeoNear2DSphereNode*>(node)->index.identifier.catalogName);
+            break;
+        case STAGE_TEXT_MATCH:
+            indexes->insert(
+                static_cast<const TextMatchNode*>(node)->index.identifier.catalogName);
+            break;
+        default:
+            break;
+    }
+
+    for (auto&& child : node->children) {
+        collectIndexesUsed(child, indexes);
+    }
+}
+}  // namespace
+
+StringSet getIndexesUsed(const QuerySolution& solution) {
+    StringSet indexes;
+    if (solution.root()) {
+        collectIndexesUsed(solution.root(), &indexes);
+    }
+    return indexes;
+}
+
+void recordIndexTrialOutcome(const CollectionPtr& collection,
+                             const CanonicalQuery& query,
+                             const QuerySolution& winner,
+                             const std::vector<const QuerySolution*>& losers) {
+    if (internalQueryPlanCacheSkipIndexesAfterConsecutiveLosses.load() <= 0) {
+        return;
+    }
+
+    auto winnerIndexes = getIndexesUsed(winner);
+    StringSet loserIndexes;
+    for (auto&& loser : losers) {
+        for (auto&& indexName : getIndexesUsed(*loser)) {
+            if (!winnerIndexes.contains(indexName)) {
+                loserIndexes.insert(indexName);
+            }
+        }
+    }
+
+    auto planCache = CollectionQueryInfo::get(collection).getPlanCache();
+    planCache->recordIndexTrialOutcome(planCache->computeKey(query), winnerIndexes, loserIndexes);
+
+    auto& usageTracker =
+        CollectionIndexUsageTrackerDecoration::get(collection->getSharedDecorations());
+    for (auto&& indexName : winnerIndexes) {
+        usageTracker.recordIndexTrialWin(indexName);
+    }
+    for (auto&& indexName : loserIndexes) {
+        usageTracker.recordIndexTrialLoss(indexName);
+    }
+}
+
+void removeSolutionsUsingLosingIndexes(const CollectionPtr& collection,
+                                       const CanonicalQuery& query,
+                                       std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    const auto consecutiveLosses = internalQueryPlanCacheSkipIndexesAfterConsecutiveLosses.load();
+    if (consecutiveLosses <= 0 || solutions->size() < 2 || !PlanCache::shouldCacheQuery(query)) {
+        return;
+    }
+
+    auto planCache = CollectionQueryInfo::get(collection).getPlanCache();
+    auto losingIndexes =
+        planCache->getIndexesWithConsecutiveLosses(planCache->computeKey(query), consecutiveLosses);
+    if (losingIndexes.empty()) {
+        return;
+    }
+
+    // A solution is left out if it reads at least one index, and only ones that keep losing.
+    auto isLosing = [&](const std::unique_ptr<QuerySolution>& solution) {
+        auto indexes = getIndexesUsed(*solution);
+        return !indexes.empty() &&
+            std::all_of(indexes.begin(), indexes.end(), [&](auto&& indexName) {
+                   return losingIndexes.contains(indexName);
+               });
+    };
+    auto firstLosing = std::stable_partition(
+        solutions->begin(), solutions->end(), [&](auto&& solution) { return !isLosing(solution); });
+    if (firstLosing == solutions->begin() || firstLosing == solutions->end()) {
+        return;
+    }
+
+    auto& usageTracker =
+        CollectionIndexUsageTrackerDecoration::get(collection->getSharedDecorations());
+    for (auto it = firstLosing; it != solutions->end(); ++it) {
+        for (auto&& indexName : getIndexesUsed(**it)) {
+            usageTracker.recordIndexTrialSkipped(indexName);
+        }
+    }
+
+    LOGV2_DEBUG(6107800,
+                2,
+                "Leaving candidate plans using indexes that keep losing out of the trial period",
+                "query"_attr = redact(query.toStringShort()),
+                "numSkipped"_attr = std::distance(firstLosing, solutions->end()),
+                "numRemaining"_attr = std::distance(solutions->begin(), firstLosing));
+    solutions->erase(firstLosing, solutions->end());
+}
 }  // namespace mongo::plan_cache_util
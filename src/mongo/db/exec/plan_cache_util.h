@@ -33,7 +33,9 @@
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/plan_explainer_factory.h"
+#include "mongo/db/query/query_solution.h"
 #include "mongo/db/query/sbe_plan_ranker.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 /**
@@ -69,6 +71,30 @@ void logNotCachingZeroResults(std::string&& query, double score, std::string win
 void logNotCachingNoData(std::string&& solution);
 }  // namespace log_detail
 
+/**
+ * Returns the names of the indexes read by 'solution'.
+ */
+StringSet getIndexesUsed(const QuerySolution& solution);
+
+/**
+ * If 'internalQueryPlanCacheSkipIndexesAfterConsecutiveLosses' is positive, records in the plan
+ * cache and in the index usage statistics that the indexes used by 'winner' won a trial period for
+ * 'query', and that the other indexes used by 'losers' lost it.
+ */
+void recordIndexTrialOutcome(const CollectionPtr& collection,
+                             const CanonicalQuery& query,
+                             const QuerySolution& winner,
+                             const std::vector<const QuerySolution*>& losers);
+
+/**
+ * If 'internalQueryPlanCacheSkipIndexesAfterConsecutiveLosses' is positive, removes the candidate
+ * 'solutions' for 'query' that only use indexes which have lost that many trial periods in a row,
+ * as long as at least one candidate remains.
+ */
+void removeSolutionsUsingLosingIndexes(const CollectionPtr& collection,
+                                       const CanonicalQuery& query,
+                                       std::vector<std::unique_ptr<QuerySolution>>* solutions);
+
 /**
  * Caches the best candidate plan, chosen from the given 'candidates' based on the 'ranking'
  * decision, if the 'query' is of a type that can be cached. Otherwise, does nothing.
@@ -90,6 +116,18 @@ void updatePlanCache(
     auto winnerIdx = ranking->candidateOrder[0];
     invariant(winnerIdx >= 0 && winnerIdx < candidates.size());
 
+    // A tie does not tell which of the tied plans is better, so it is not counted as a loss.
+    if (PlanCache::shouldCacheQuery(query) && !ranking->tieForBest()) {
+        std::vector<const QuerySolution*> losers;
+        for (size_t i = 1; i < ranking->candidateOrder.size(); ++i) {
+            losers.push_back(candidates[ranking->candidateOrder[i]].solution.get());
+        }
+        for (auto&& ix : ranking->failedCandidates) {
+            losers.push_back(candidates[ix].solution.get());
+        }
+        recordIndexTrialOutcome(collection, query, *candidates[winnerIdx].solution, losers);
+    }
+
     // Even if the query is of a cacheable shape, the caller might have indicated that we shouldn't
     // write to the plan cache.
     //
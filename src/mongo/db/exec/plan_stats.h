@@ -257,7 +257,7 @@ struct CollectionScanStats : public SpecificStats {
 struct CountStats : public SpecificStats {
     CountStats() : nCounted(0), nSkipped(0) {}
 
-    std::unique_ptr<SpecificStats> clone() const final {
+    std::unique_ptr<SpecificStats> clone() const override {
         return std::make_unique<CountStats>(*this);
     }
 
@@ -272,6 +272,18 @@ struct CountStats : public SpecificStats {
     long long nSkipped;
 };
 
+struct IndexFastCountStats final : public CountStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<IndexFastCountStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return indexName.capacity() + sizeof(*this);
+    }
+
+    std::string indexName;
+};
+
 struct CountScanStats : public SpecificStats {
     CountScanStats()
         : indexVersion(0),
@@ -642,6 +654,9 @@ struct SortStats : public SpecificStats {
 
     // The number of times that we spilled data to disk during the execution of this query.
     uint64_t spills = 0u;
+
+    // The number of bytes written to disk by those spills, after compression.
+    uint64_t spilledDataStorageSize = 0u;
 };
 
 struct MergeSortStats : public SpecificStats {
@@ -904,4 +919,17 @@ struct SampleFromTimeseriesBucketStats final : public SpecificStats {
     size_t dupsTested = 0u;
     size_t dupsDropped = 0u;
 };
+
+struct ReservoirSampleFromTimeseriesBucketStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<ReservoirSampleFromTimeseriesBucketStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return sizeof(*this);
+    }
+
+    size_t nBucketsSkipped = 0u;
+    size_t nMeasurementsExtracted = 0u;
+};
 }  // namespace mongo
@@ -31,6 +31,8 @@
 
 #include "mongo/db/exec/projection_node.h"
 
+#include "mongo/db/query/query_knobs_gen.h"
+
 namespace mongo::projection_executor {
 using ArrayRecursionPolicy = ProjectionPolicies::ArrayRecursionPolicy;
 using ComputedFieldsPolicy = ProjectionPolicies::ComputedFieldsPolicy;
@@ -265,9 +267,28 @@ void ProjectionNode::optimize() {
         childPair.second->optimize();
     }
 
+    // All of the computed fields are evaluated against the same input document, so the root node
+    // shares the subexpressions they have in common.
+    if (_pathToNode.empty() && internalQueryProjectionShareCommonSubexpressions.load()) {
+        std::vector<boost::intrusive_ptr<Expression>*> expressions;
+        collectExpressions(&expressions);
+        ExpressionCommonSubexpression::shareAcross(expressions);
+    }
+
     _maxFieldsToProject = maxFieldsToProject();
 }
 
+void ProjectionNode::collectExpressions(std::vector<boost::intrusive_ptr<Expression>*>* exprs) {
+    for (auto&& field : _orderToProcessAdditionsAndChildren) {
+        if (auto childIt = _children.find(field); childIt != _children.end()) {
+            childIt->second->collectExpressions(exprs);
+        } else if (auto expressionIt = _expressions.find(field);
+                   expressionIt != _expressions.end()) {
+            exprs->push_back(&expressionIt->second);
+        }
+    }
+}
+
 Document ProjectionNode::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument outputDoc;
     serialize(explain, &outputDoc);
@@ -203,6 +203,10 @@ private:
     // Returns nullptr if no such child exists.
     ProjectionNode* getChild(const std::string& field) const;
 
+    // Appends the computed fields of this node and its children to 'exprs', in the order in which
+    // they are evaluated.
+    void collectExpressions(std::vector<boost::intrusive_ptr<Expression>*>* exprs);
+
     /**
      * Indicates that metadata computed by previous calls to optimize() is now stale and must be
      * recomputed. This must be called any time the tree is updated (an expression added or child
@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/reservoir_sample_from_timeseries_bucket.h"
+
+#include <cmath>
+
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+namespace {
+// Bounds the number of measurements skipped at once, so that the conversion from double cannot
+// overflow.
+constexpr double kMaxSkip = 1e15;
+}  // namespace
+
+const char* ReservoirSampleFromTimeseriesBucket::kStageType =
+    "RESERVOIR_SAMPLE_FROM_TIMESERIES_BUCKET";
+
+ReservoirSampleFromTimeseriesBucket::ReservoirSampleFromTimeseriesBucket(
+    ExpressionContext* expCtx,
+    WorkingSet* ws,
+    std::unique_ptr<PlanStage> child,
+    BucketUnpacker bucketUnpacker,
+    long long sampleSize)
+    : PlanStage{kStageType, expCtx},
+      _ws{*ws},
+      _bucketUnpacker{std::move(bucketUnpacker)},
+      _sampleSize{sampleSize} {
+    tassert(6103000, "sampleSize must be gte to 0", sampleSize >= 0);
+
+    _children.emplace_back(std::move(child));
+}
+
+std::unique_ptr<PlanStageStats> ReservoirSampleFromTimeseriesBucket::getStats() {
+    _commonStats.isEOF = isEOF();
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, stageType());
+    ret->specific = std::make_unique<ReservoirSampleFromTimeseriesBucketStats>(_specificStats);
+    ret->children.emplace_back(child()->getStats());
+    return ret;
+}
+
+double ReservoirSampleFromTimeseriesBucket::nextUniform() {
+    // Draw from (0, 1] so that the logarithm is finite.
+    return 1.0 - expCtx()->opCtx->getClient()->getPrng().nextCanonicalDouble();
+}
+
+void ReservoirSampleFromTimeseriesBucket::skipMeasurements() {
+    _w *= std::exp(std::log(nextUniform()) / _sampleSize);
+    auto skip = std::floor(std::log(nextUniform()) / std::log(1.0 - _w));
+    _nextIndex += 1 + static_cast<long long>(std::min(skip, kMaxSkip));
+}
+
+void ReservoirSampleFromTimeseriesBucket::sampleBucket() {
+    const long long end = _numSeen + _bucketUnpacker.numberOfMeasurements();
+    if (_nextIndex >= end) {
+        ++_specificStats.nBucketsSkipped;
+    }
+
+    while (_nextIndex < end) {
+        auto measurement = _bucketUnpacker.extractSingleMeasurement(_nextIndex - _numSeen);
+        ++_specificStats.nMeasurementsExtracted;
+        _memoryUsageBytes += measurement.getApproximateSize();
+
+        if (static_cast<long long>(_reservoir.size()) < _sampleSize) {
+            // Until the reservoir is full, every measurement enters it.
+            _reservoir.push_back(std::move(measurement));
+            if (static_cast<long long>(_reservoir.size()) < _sampleSize) {
+                ++_nextIndex;
+            } else {
+                skipMeasurements();
+            }
+        } else {
+            // Otherwise the measurement replaces a random one.
+            auto& prng = expCtx()->opCtx->getClient()->getPrng();
+            auto& replaced = _reservoir[prng.nextInt64(_sampleSize)];
+            _memoryUsageBytes -= replaced.getApproximateSize();
+            replaced = std::move(measurement);
+            skipMeasurements();
+        }
+
+        uassert(6103001,
+                str::stream() << kStageType << " exceeded its memory limit of "
+                              << internalQueryMaxBlockingSortMemoryUsageBytes.load()
+                              << " bytes. Consider disabling "
+                                 "internalQueryTimeseriesReservoirSample.",
+                _memoryUsageBytes <=
+                    static_cast<size_t>(internalQueryMaxBlockingSortMemoryUsageBytes.load()));
+    }
+    _numSeen = end;
+}
+
+PlanStage::StageState ReservoirSampleFromTimeseriesBucket::doWork(WorkingSetID* out) {
+    if (isEOF()) {
+        return PlanStage::IS_EOF;
+    }
+
+    if (_childExhausted) {
+        // The reservoir has been shuffled, so it can be returned from the back.
+        auto id = _ws.allocate();
+        auto member = _ws.get(id);
+        member->keyData.clear();
+        member->recordId = {};
+        member->doc = {{}, std::move(_reservoir.back())};
+        member->transitionToOwnedObj();
+        _reservoir.pop_back();
+        *out = id;
+        return PlanStage::ADVANCED;
+    }
+
+    auto id = WorkingSet::INVALID_ID;
+    auto status = child()->work(&id);
+
+    if (PlanStage::ADVANCED == status) {
+        auto member = _ws.get(id);
+        _bucketUnpacker.reset(member->doc.value().toBson());
+        _ws.free(id);
+
+        sampleBucket();
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::IS_EOF == status) {
+        auto& prng = expCtx()->opCtx->getClient()->getPrng();
+        for (auto i = static_cast<long long>(_reservoir.size()) - 1; i > 0; --i) {
+            std::swap(_reservoir[i], _reservoir[prng.nextInt64(i + 1)]);
+        }
+        _childExhausted = true;
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::NEED_YIELD == status) {
+        *out = id;
+    }
+    return status;
+}
+}  // namespace mongo
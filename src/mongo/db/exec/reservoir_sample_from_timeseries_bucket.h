@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/exec/bucket_unpacker.h"
+#include "mongo/db/exec/plan_stage.h"
+
+namespace mongo {
+/**
+ * This stage draws a uniform random sample of measurements, without replacement, from every bucket
+ * returned by its child in a single pass, using a variation on reservoir sampling "Algorithm L"
+ * (see https://dl.acm.org/doi/10.1145/198429.198435). Rather than materializing every measurement,
+ * it uses the measurement count of each bucket to compute how many measurements to skip before the
+ * next one which enters the reservoir, so that a bucket none of whose measurements is chosen is
+ * never unpacked. Once the child is exhausted, the reservoir is returned in random order.
+ *
+ * Unlike 'SampleFromTimeseriesBucket', this stage does not depend on the buckets being full, so it
+ * serves large sample sizes where the alternative is to unpack and randomly sort every measurement.
+ * In expectation it extracts k * (1 + ln(n / k)) measurements for a sample of size k out of n.
+ */
+class ReservoirSampleFromTimeseriesBucket final : public PlanStage {
+public:
+    static const char* kStageType;
+
+    /**
+     * Constructs a 'ReservoirSampleFromTimeseriesBucket' stage which uses 'bucketUnpacker' to
+     * materialize the sampled measurements from the buckets returned by the child stage, which
+     * should scan every bucket. 'sampleSize' is the user-requested number of documents to sample.
+     */
+    ReservoirSampleFromTimeseriesBucket(ExpressionContext* expCtx,
+                                        WorkingSet* ws,
+                                        std::unique_ptr<PlanStage> child,
+                                        BucketUnpacker bucketUnpacker,
+                                        long long sampleSize);
+
+    StageType stageType() const final {
+        return STAGE_RESERVOIR_SAMPLE_FROM_TIMESERIES_BUCKET;
+    }
+
+    bool isEOF() final {
+        return _sampleSize == 0 || (_childExhausted && _reservoir.empty());
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final {
+        return &_specificStats;
+    }
+
+    PlanStage::StageState doWork(WorkingSetID* id);
+
+private:
+    /**
+     * Adds the measurements of the bucket currently held by '_bucketUnpacker' which are chosen for
+     * the reservoir to it.
+     */
+    void sampleBucket();
+
+    /**
+     * Advances '_nextIndex' past the measurements which do not enter the full reservoir.
+     */
+    void skipMeasurements();
+
+    double nextUniform();
+
+    WorkingSet& _ws;
+    BucketUnpacker _bucketUnpacker;
+    ReservoirSampleFromTimeseriesBucketStats _specificStats;
+
+    const long long _sampleSize;
+
+    // The sampled measurements, and an approximation of the memory they use.
+    std::vector<Document> _reservoir;
+    size_t _memoryUsageBytes = 0;
+
+    // The number of measurements in the buckets seen so far, and the index among them of the next
+    // measurement to enter the reservoir.
+    long long _numSeen = 0;
+    long long _nextIndex = 0;
+
+    // The running product of random variables from which Algorithm L derives the skip lengths.
+    double _w = 1.0;
+
+    bool _childExhausted = false;
+};
+}  //  namespace mongo
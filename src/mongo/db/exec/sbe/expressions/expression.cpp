@@ -456,6 +456,28 @@ static stdx::unordered_map<std::string, BuiltinFn> kBuiltinFunctions = {
     {"ftsMatch", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::ftsMatch, false}},
     {"generateSortKey",
      BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::generateSortKey, false}},
+    {"valueBlockGtScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockGtScalar, false}},
+    {"valueBlockGteScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockGteScalar, false}},
+    {"valueBlockLtScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockLtScalar, false}},
+    {"valueBlockLteScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockLteScalar, false}},
+    {"valueBlockEqScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockEqScalar, false}},
+    {"valueBlockLogicalAnd",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockLogicalAnd, false}},
+    {"valueBlockLogicalOr",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockLogicalOr, false}},
+    {"valueBlockAdd",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockAdd, false}},
+    {"valueBlockSub",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockSub, false}},
+    {"valueBlockMul",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockMul, false}},
+    {"valueBlockFillEmpty",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockFillEmpty, false}},
 };
 
 /**
@@ -888,6 +910,29 @@ std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeCopy(bool isSmp) {
     return std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
 }
 
+std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeDeepCopy() const {
+    auto env = std::make_unique<RuntimeEnvironment>();
+
+    auto& state = *env->_state;
+    state.namedSlots = _state->namedSlots;
+    state.slots = _state->slots;
+    state.owned = _state->owned;
+    state.typeTags.reserve(_state->typeTags.size());
+    state.vals.reserve(_state->vals.size());
+    for (size_t idx = 0; idx < _state->vals.size(); ++idx) {
+        auto [tag, val] = _state->owned[idx]
+            ? copyValue(_state->typeTags[idx], _state->vals[idx])
+            : std::make_pair(_state->typeTags[idx], _state->vals[idx]);
+        state.typeTags.push_back(tag);
+        state.vals.push_back(val);
+    }
+
+    for (auto&& [slotId, index] : state.slots) {
+        env->emplaceAccessor(slotId, index);
+    }
+    return env;
+}
+
 void RuntimeEnvironment::debugString(StringBuilder* builder) {
     using namespace std::literals;
 
@@ -165,6 +165,13 @@ public:
      */
     std::unique_ptr<RuntimeEnvironment> makeCopy(bool isSmp);
 
+    /**
+     * Make an independent copy of this environment. Unlike 'makeCopy()', the new environment does
+     * not share the slot values with this one: owned values are copied, so either environment can
+     * be modified or destroyed without affecting the other.
+     */
+    std::unique_ptr<RuntimeEnvironment> makeDeepCopy() const;
+
     /**
      * Dumps all the slots currently defined in this environment into the given string builder.
      */
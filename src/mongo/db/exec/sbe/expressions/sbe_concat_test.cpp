@@ -110,6 +110,32 @@ TEST_F(SBEConcatTest, ComputesStringConcat) {
     runAndAssertExpression(compiledExpr.get(), "bson string");
 }
 
+TEST_F(SBEConcatTest, ReturnsSmallStringOnlyWhenResultFits) {
+    value::OwnedValueAccessor slotAccessor1;
+    value::OwnedValueAccessor slotAccessor2;
+    auto argSlot1 = bindAccessor(&slotAccessor1);
+    auto argSlot2 = bindAccessor(&slotAccessor2);
+    auto concatExpr = sbe::makeE<sbe::EFunction>(
+        "concat", sbe::makeEs(makeE<EVariable>(argSlot1), makeE<EVariable>(argSlot2)));
+    auto compiledExpr = compileExpression(*concatExpr);
+
+    auto runAndAssertTag = [&](StringData lhs, StringData rhs, value::TypeTags expectedTag) {
+        auto [tag1, val1] = value::makeNewString(lhs);
+        auto [tag2, val2] = value::makeNewString(rhs);
+        slotAccessor1.reset(tag1, val1);
+        slotAccessor2.reset(tag2, val2);
+
+        auto [tag, val] = runCompiledExpression(compiledExpr.get());
+        value::ValueGuard guard(tag, val);
+        ASSERT_EQUALS(expectedTag, tag);
+        ASSERT_EQUALS(value::getStringView(tag, val), lhs.toString() + rhs.toString());
+    };
+
+    runAndAssertTag("abc", "defg", value::TypeTags::StringSmall);
+    runAndAssertTag("abcd", "efgh", value::TypeTags::StringBig);
+    runAndAssertTag("ab"_sd, StringData("\0c", 2), value::TypeTags::StringBig);
+}
+
 TEST_F(SBEConcatTest, ComputesManyStringsConcat) {
     value::OwnedValueAccessor slotAccessor1;
     value::OwnedValueAccessor slotAccessor2;
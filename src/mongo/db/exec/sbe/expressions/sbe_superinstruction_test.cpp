@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file contains tests for the superinstructions produced by the vm::CodeFragment peephole
+ * optimizer.
+ */
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+
+namespace mongo::sbe {
+
+class SBESuperinstructionTest : public EExpressionTestFixture {
+protected:
+    static std::pair<value::TypeTags, value::Value> makeObj(const BSONObj& obj) {
+        return value::copyValue(value::TypeTags::bsonObject,
+                                value::bitcastFrom<const char*>(obj.objdata()));
+    }
+
+    static std::unique_ptr<EExpression> makeStr(StringData str) {
+        auto [tag, val] = value::makeNewString(str);
+        return makeE<EConstant>(tag, val);
+    }
+
+    static std::unique_ptr<EExpression> makeInt(int32_t num) {
+        return makeE<EConstant>(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(num));
+    }
+
+    static std::unique_ptr<EExpression> makeGetField(std::unique_ptr<EExpression> obj,
+                                                     StringData field) {
+        return makeE<EFunction>("getField", makeEs(std::move(obj), makeStr(field)));
+    }
+
+    void assertInt32Result(const vm::CodeFragment* code, int32_t expected) {
+        auto [tag, val] = runCompiledExpression(code);
+        value::ValueGuard guard(tag, val);
+        ASSERT_EQUALS(value::TypeTags::NumberInt32, tag);
+        ASSERT_EQUALS(expected, value::bitcastTo<int32_t>(val));
+    }
+};
+
+TEST_F(SBESuperinstructionTest, GetFieldFromSlotIsFused) {
+    value::OwnedValueAccessor objAccessor;
+    auto objSlot = bindAccessor(&objAccessor);
+
+    auto expr = makeGetField(makeE<EVariable>(objSlot), "a");
+    auto compiledExpr = compileExpression(*expr);
+    ASSERT_EQUALS(1, compiledExpr->instrCount());
+
+    auto [objTag, objVal] = makeObj(BSON("b" << 1 << "a" << 2));
+    objAccessor.reset(objTag, objVal);
+    assertInt32Result(compiledExpr.get(), 2);
+
+    std::tie(objTag, objVal) = makeObj(BSON("b" << 1));
+    objAccessor.reset(objTag, objVal);
+    runAndAssertNothing(compiledExpr.get());
+
+    objAccessor.reset(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(1));
+    runAndAssertNothing(compiledExpr.get());
+}
+
+TEST_F(SBESuperinstructionTest, FilterPredicateIsFused) {
+    value::OwnedValueAccessor objAccessor;
+    auto objSlot = bindAccessor(&objAccessor);
+
+    // fillEmpty(getField(s, "a"), 0) < 5
+    auto expr = makeE<EPrimBinary>(
+        EPrimBinary::less,
+        makeE<EFunction>("fillEmpty",
+                         makeEs(makeGetField(makeE<EVariable>(objSlot), "a"), makeInt(0))),
+        makeInt(5));
+    auto compiledExpr = compileExpression(*expr);
+    ASSERT_EQUALS(3, compiledExpr->instrCount());
+
+    auto [objTag, objVal] = makeObj(BSON("a" << 4));
+    objAccessor.reset(objTag, objVal);
+    ASSERT_TRUE(runCompiledExpressionPredicate(compiledExpr.get()));
+
+    std::tie(objTag, objVal) = makeObj(BSON("a" << 5));
+    objAccessor.reset(objTag, objVal);
+    ASSERT_FALSE(runCompiledExpressionPredicate(compiledExpr.get()));
+
+    std::tie(objTag, objVal) = makeObj(BSONObj());
+    objAccessor.reset(objTag, objVal);
+    ASSERT_TRUE(runCompiledExpressionPredicate(compiledExpr.get()));
+}
+
+TEST_F(SBESuperinstructionTest, ComparisonsAgainstConstants) {
+    value::OwnedValueAccessor accessor;
+    auto slot = bindAccessor(&accessor);
+
+    struct TestCase {
+        EPrimBinary::Op op;
+        std::array<bool, 3> expected;  // For inputs 1, 2 and 3 compared against 2.
+    };
+    std::vector<TestCase> testCases{{EPrimBinary::less, {true, false, false}},
+                                    {EPrimBinary::lessEq, {true, true, false}},
+                                    {EPrimBinary::greater, {false, false, true}},
+                                    {EPrimBinary::greaterEq, {false, true, true}},
+                                    {EPrimBinary::eq, {false, true, false}},
+                                    {EPrimBinary::neq, {true, false, true}}};
+
+    for (auto&& testCase : testCases) {
+        auto expr = makeE<EPrimBinary>(testCase.op, makeE<EVariable>(slot), makeInt(2));
+        auto compiledExpr = compileExpression(*expr);
+        ASSERT_EQUALS(2, compiledExpr->instrCount());
+
+        for (int32_t input = 1; input <= 3; ++input) {
+            accessor.reset(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(input));
+            ASSERT_EQUALS(testCase.expected[input - 1],
+                          runCompiledExpressionPredicate(compiledExpr.get()));
+        }
+
+        accessor.reset(value::TypeTags::Nothing, 0);
+        runAndAssertNothing(compiledExpr.get());
+    }
+}
+
+TEST_F(SBESuperinstructionTest, NoFusionAcrossJumpTargets) {
+    value::OwnedValueAccessor condAccessor, lhsAccessor, rhsAccessor;
+    auto condSlot = bindAccessor(&condAccessor);
+    auto lhsSlot = bindAccessor(&lhsAccessor);
+    auto rhsSlot = bindAccessor(&rhsAccessor);
+
+    // getField(if cond then lhs else rhs, "a"). The push of 'lhs' is at the end of a branch and
+    // must not be folded into the field lookup, which starts at the merge point.
+    auto expr = makeGetField(makeE<EIf>(makeE<EVariable>(condSlot),
+                                        makeE<EVariable>(lhsSlot),
+                                        makeE<EVariable>(rhsSlot)),
+                             "a");
+    auto compiledExpr = compileExpression(*expr);
+
+    auto [lhsTag, lhsVal] = makeObj(BSON("a" << 1));
+    lhsAccessor.reset(lhsTag, lhsVal);
+    auto [rhsTag, rhsVal] = makeObj(BSON("a" << 2));
+    rhsAccessor.reset(rhsTag, rhsVal);
+
+    condAccessor.reset(value::TypeTags::Boolean, value::bitcastFrom<bool>(true));
+    assertInt32Result(compiledExpr.get(), 1);
+
+    condAccessor.reset(value::TypeTags::Boolean, value::bitcastFrom<bool>(false));
+    assertInt32Result(compiledExpr.get(), 2);
+}
+
+}  // namespace mongo::sbe
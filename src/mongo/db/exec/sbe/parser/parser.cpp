@@ -1131,6 +1131,7 @@ void Parser::walkGroup(AstQuery& ast) {
         lookupSlots(std::move(ast.nodes[1]->projects)),
         collatorSlotPos ? lookupSlot(std::move(ast.nodes[collatorSlotPos]->identifier))
                         : boost::none,
+        false /* allowDiskUse */,
         getCurrentPlanNodeId());
 }
 
@@ -1154,6 +1155,7 @@ void Parser::walkHashJoin(AstQuery& ast) {
                              lookupSlots(innerNode->nodes[0]->identifiers),  // inner conditions
                              lookupSlots(innerNode->nodes[1]->identifiers),  // inner projections
                              collatorSlot,                                   // collator
+                             false,                                          // allowDiskUse
                              getCurrentPlanNodeId());
 }
 
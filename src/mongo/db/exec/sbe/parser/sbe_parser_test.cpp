@@ -359,6 +359,7 @@ protected:
                             stage_builder::makeFunction(
                                 "max", sbe::makeE<sbe::EVariable>(sbe::value::SlotId{1}))),
                 boost::none, /* optional collator slot */
+                false,       /* allowDiskUse */
                 planNodeId),
             // GROUP with a collator slot.
             sbe::makeS<sbe::HashAggStage>(
@@ -371,6 +372,7 @@ protected:
                             stage_builder::makeFunction(
                                 "max", sbe::makeE<sbe::EVariable>(sbe::value::SlotId{1}))),
                 sbe::value::SlotId{4}, /* optional collator slot */
+                false,                 /* allowDiskUse */
                 planNodeId),
             // LIMIT
             sbe::makeS<sbe::LimitSkipStage>(
@@ -419,6 +421,7 @@ protected:
                                            sbe::makeSV(1, 2) /* inner conditions */,
                                            sbe::makeSV(5, 6) /* inner projections */,
                                            boost::none, /* optional collator slot */
+                                           false,       /* allowDiskUse */
                                            planNodeId),
             // HJOIN with a collator slot.
             sbe::makeS<sbe::HashJoinStage>(sbe::makeS<sbe::CoScanStage>(planNodeId),
@@ -428,6 +431,7 @@ protected:
                                            sbe::makeSV(1, 2) /* inner conditions */,
                                            sbe::makeSV(5, 6) /* inner projections */,
                                            sbe::value::SlotId{7}, /* optional collator slot */
+                                           false,                 /* allowDiskUse */
                                            planNodeId),
             // FILTER
             sbe::makeS<sbe::FilterStage<false>>(
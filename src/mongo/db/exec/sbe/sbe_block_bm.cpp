@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * Compares the row and block execution modes of SBE on a scan which is filtered by a numeric
+ * comparison.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/block_to_row.h"
+#include "mongo/db/exec/sbe/stages/filter.h"
+#include "mongo/db/exec/sbe/stages/project.h"
+#include "mongo/db/exec/sbe/stages/row_to_block.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
+
+namespace mongo::sbe {
+namespace {
+constexpr int64_t kNumDocuments = 10'000'000;
+constexpr double kThreshold = kNumDocuments / 2;
+
+/**
+ * Returns a virtual scan over 'kNumDocuments' doubles standing in for the values of the scanned
+ * field, along with the slot holding them.
+ */
+std::pair<value::SlotId, std::unique_ptr<PlanStage>> makeScan(
+    value::SlotIdGenerator* slotIdGenerator) {
+    auto [arrTag, arrVal] = value::makeNewArray();
+    auto arr = value::getArrayView(arrVal);
+    arr->reserve(kNumDocuments);
+    for (int64_t i = 0; i < kNumDocuments; ++i) {
+        arr->push_back(value::TypeTags::NumberDouble, value::bitcastFrom<double>(i));
+    }
+    return stage_builder::generateVirtualScan(slotIdGenerator, arrTag, arrVal);
+}
+
+std::unique_ptr<EExpression> makeThreshold() {
+    return makeE<EConstant>(value::TypeTags::NumberDouble, value::bitcastFrom<double>(kThreshold));
+}
+
+/**
+ * Runs the plan to completion once per iteration, counting the rows it returns.
+ */
+void runPlan(benchmark::State& state, PlanStage* root, value::SlotId outSlot) {
+    CompileCtx ctx{std::make_unique<RuntimeEnvironment>()};
+    root->prepare(ctx);
+    auto accessor = root->getAccessor(ctx, outSlot);
+
+    bool reOpen = false;
+    for (auto keepRunning : state) {
+        root->open(reOpen);
+        reOpen = true;
+
+        int64_t count = 0;
+        while (root->getNext() == PlanState::ADVANCED) {
+            benchmark::DoNotOptimize(accessor->getViewOfValue());
+            ++count;
+        }
+        invariant(count == kNumDocuments - static_cast<int64_t>(kThreshold) - 1);
+    }
+    root->close();
+    state.SetItemsProcessed(state.iterations() * kNumDocuments);
+}
+
+void BM_RowModeScanFilter(benchmark::State& state) {
+    value::SlotIdGenerator slotIdGenerator;
+    auto [scanSlot, scan] = makeScan(&slotIdGenerator);
+
+    auto filter = makeS<FilterStage<false>>(
+        std::move(scan),
+        makeE<EPrimBinary>(EPrimBinary::greater, makeE<EVariable>(scanSlot), makeThreshold()),
+        kEmptyPlanNodeId);
+    runPlan(state, filter.get(), scanSlot);
+}
+
+void BM_BlockModeScanFilter(benchmark::State& state) {
+    value::SlotIdGenerator slotIdGenerator;
+    auto [scanSlot, scan] = makeScan(&slotIdGenerator);
+
+    auto blockSlot = slotIdGenerator.generate();
+    auto bitmapSlot = slotIdGenerator.generate();
+    auto outSlot = slotIdGenerator.generate();
+    auto stage = makeProjectStage(
+        makeS<RowToBlockStage>(std::move(scan),
+                               makeSV(scanSlot),
+                               makeSV(blockSlot),
+                               static_cast<size_t>(state.range(0)),
+                               kEmptyPlanNodeId),
+        kEmptyPlanNodeId,
+        bitmapSlot,
+        makeE<EFunction>("valueBlockGtScalar"_sd,
+                         makeEs(makeE<EVariable>(blockSlot), makeThreshold())));
+    auto root = makeS<BlockToRowStage>(
+        std::move(stage), makeSV(blockSlot), makeSV(outSlot), bitmapSlot, kEmptyPlanNodeId);
+    runPlan(state, root.get(), outSlot);
+}
+}  // namespace
+
+BENCHMARK(BM_RowModeScanFilter)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BlockModeScanFilter)->Arg(128)->Arg(1024)->Arg(8192)->Unit(benchmark::kMillisecond);
+}  // namespace mongo::sbe
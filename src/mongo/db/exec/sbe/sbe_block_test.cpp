@@ -0,0 +1,178 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file contains tests for the block mode of SBE: sbe::RowToBlockStage,
+ * sbe::BlockToRowStage and the 'valueBlock*' builtins evaluated over their blocks.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/block_to_row.h"
+#include "mongo/db/exec/sbe/stages/project.h"
+#include "mongo/db/exec/sbe/stages/row_to_block.h"
+
+namespace mongo::sbe {
+
+class BlockStageTest : public PlanStageTestFixture {
+public:
+    /**
+     * Streams the input array through a RowToBlockStage with the given block size, optionally
+     * computes a bitmap over the resulting blocks with 'makeBitmap', and switches back to rows.
+     */
+    void runBlockTest(BSONArray input,
+                      BSONArray expected,
+                      size_t blockSize,
+                      std::function<std::unique_ptr<EExpression>(value::SlotId)> makeBitmap) {
+        auto [inputTag, inputVal] = stage_builder::makeValue(input);
+        auto [expectedTag, expectedVal] = stage_builder::makeValue(expected);
+
+        auto makeStageFn = [&](value::SlotId scanSlot, std::unique_ptr<PlanStage> scanStage) {
+            auto blockSlot = generateSlotId();
+            std::unique_ptr<PlanStage> stage = makeS<RowToBlockStage>(std::move(scanStage),
+                                                                      makeSV(scanSlot),
+                                                                      makeSV(blockSlot),
+                                                                      blockSize,
+                                                                      kEmptyPlanNodeId);
+
+            boost::optional<value::SlotId> bitmapSlot;
+            if (makeBitmap) {
+                bitmapSlot = generateSlotId();
+                stage = makeProjectStage(
+                    std::move(stage), kEmptyPlanNodeId, *bitmapSlot, makeBitmap(blockSlot));
+            }
+
+            auto outSlot = generateSlotId();
+            stage = makeS<BlockToRowStage>(
+                std::move(stage), makeSV(blockSlot), makeSV(outSlot), bitmapSlot, kEmptyPlanNodeId);
+            return std::make_pair(outSlot, std::move(stage));
+        };
+
+        runTest(inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
+    }
+
+    static std::unique_ptr<EExpression> makeBlockFunction(StringData name,
+                                                          value::SlotId blockSlot,
+                                                          std::unique_ptr<EExpression> arg) {
+        return makeE<EFunction>(name, makeEs(makeE<EVariable>(blockSlot), std::move(arg)));
+    }
+};
+
+TEST_F(BlockStageTest, RowsRoundTripThroughBlocks) {
+    for (size_t blockSize : {1, 3, 7, 10}) {
+        runBlockTest(BSON_ARRAY(1 << "a" << 2.5 << BSONNULL << 5 << BSON("b" << 1) << 7),
+                     BSON_ARRAY(1 << "a" << 2.5 << BSONNULL << 5 << BSON("b" << 1) << 7),
+                     blockSize,
+                     nullptr);
+    }
+}
+
+TEST_F(BlockStageTest, EmptyInputProducesNoRows) {
+    runBlockTest(BSONArray{}, BSONArray{}, 4, nullptr);
+}
+
+TEST_F(BlockStageTest, BitmapFiltersHomogeneousNumericBlocks) {
+    auto makeGt = [](value::SlotId blockSlot) {
+        return makeBlockFunction(
+            "valueBlockGtScalar"_sd,
+            blockSlot,
+            makeE<EConstant>(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(3)));
+    };
+
+    runBlockTest(BSON_ARRAY(1 << 5 << 3 << 4 << 2 << 6), BSON_ARRAY(5 << 4 << 6), 4, makeGt);
+    runBlockTest(BSON_ARRAY(1.5 << 5.5 << 3.0 << 4.5), BSON_ARRAY(5.5 << 4.5), 3, makeGt);
+    runBlockTest(BSON_ARRAY(1LL << 5LL << 3LL << 4LL), BSON_ARRAY(5LL << 4LL), 2, makeGt);
+}
+
+TEST_F(BlockStageTest, BitmapFiltersHeterogeneousBlocks) {
+    auto makeLte = [](value::SlotId blockSlot) {
+        return makeBlockFunction(
+            "valueBlockLteScalar"_sd,
+            blockSlot,
+            makeE<EConstant>(value::TypeTags::NumberDouble, value::bitcastFrom<double>(2.5)));
+    };
+
+    // Values which do not compare with a number produce Nothing in the bitmap and are dropped.
+    runBlockTest(BSON_ARRAY(1 << "a" << 2.5 << BSONNULL << 2LL << 3),
+                 BSON_ARRAY(1 << 2.5 << 2LL),
+                 4,
+                 makeLte);
+}
+
+TEST_F(BlockStageTest, LogicalAndCombinesBitmaps) {
+    auto makeRange = [](value::SlotId blockSlot) {
+        return makeE<EFunction>(
+            "valueBlockLogicalAnd"_sd,
+            makeEs(makeBlockFunction("valueBlockGteScalar"_sd,
+                                     blockSlot,
+                                     makeE<EConstant>(value::TypeTags::NumberInt32,
+                                                      value::bitcastFrom<int32_t>(2))),
+                   makeBlockFunction("valueBlockLtScalar"_sd,
+                                     blockSlot,
+                                     makeE<EConstant>(value::TypeTags::NumberInt32,
+                                                      value::bitcastFrom<int32_t>(5)))));
+    };
+
+    runBlockTest(BSON_ARRAY(1 << 2 << 3 << 4 << 5 << 6), BSON_ARRAY(2 << 3 << 4), 4, makeRange);
+}
+
+TEST_F(BlockStageTest, ArithmeticOverBlocks) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(BSON_ARRAY(1.5 << 2.5 << 3.5));
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY(3.0 << 5.0 << 7.0));
+
+    auto makeStageFn = [&](value::SlotId scanSlot, std::unique_ptr<PlanStage> scanStage) {
+        auto blockSlot = generateSlotId();
+        auto resultBlockSlot = generateSlotId();
+        auto outSlot = generateSlotId();
+        auto stage = makeProjectStage(
+            makeS<RowToBlockStage>(std::move(scanStage),
+                                   makeSV(scanSlot),
+                                   makeSV(blockSlot),
+                                   2,
+                                   kEmptyPlanNodeId),
+            kEmptyPlanNodeId,
+            resultBlockSlot,
+            makeBlockFunction(
+                "valueBlockMul"_sd,
+                blockSlot,
+                makeE<EConstant>(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(2))));
+        return std::make_pair(outSlot,
+                              makeS<BlockToRowStage>(std::move(stage),
+                                                     makeSV(resultBlockSlot),
+                                                     makeSV(outSlot),
+                                                     boost::none,
+                                                     kEmptyPlanNodeId));
+    };
+
+    runTest(inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
+}
+
+}  // namespace mongo::sbe
@@ -37,6 +37,7 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo::sbe {
 
@@ -82,6 +83,7 @@ TEST_F(HashAggStageTest, HashAggMinMaxTest) {
                    stage_builder::makeFunction(
                        "collMax", collExpr->clone(), makeE<EVariable>(scanSlot))),
             boost::none,
+            false /* allowDiskUse */,
             kEmptyPlanNodeId);
 
         auto outSlot = generateSlotId();
@@ -136,6 +138,7 @@ TEST_F(HashAggStageTest, HashAggAddToSetTest) {
                    stage_builder::makeFunction(
                        "collAddToSet", std::move(collExpr), makeE<EVariable>(scanSlot))),
             boost::none,
+            false /* allowDiskUse */,
             kEmptyPlanNodeId);
 
         return std::make_pair(hashAggSlot, std::move(hashAggStage));
@@ -220,6 +223,7 @@ TEST_F(HashAggStageTest, HashAggCollationTest) {
                                                makeE<EConstant>(value::TypeTags::NumberInt64,
                                                                 value::bitcastFrom<int64_t>(1)))),
                                     boost::optional<value::SlotId>{useCollator, collatorSlot},
+                                    false /* allowDiskUse */,
                                     kEmptyPlanNodeId);
 
             return std::make_pair(countsSlot, std::move(hashAggStage));
@@ -280,4 +284,157 @@ TEST_F(HashAggStageTest, HashAggCollationTest) {
     }
 }
 
+TEST_F(HashAggStageTest, HashAggExceedingMemoryLimitWithoutDiskUseFails) {
+    // Re-estimate the memory usage after every input row, against a budget which cannot even hold
+    // a single group.
+    RAIIServerParameterControllerForTest memoryLimitController{
+        "internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill", 1};
+    RAIIServerParameterControllerForTest memoryCheckController{
+        "internalQuerySlotBasedExecutionHashAggMemoryCheckInterval", 1};
+
+    auto [inputTag, inputVal] = stage_builder::makeValue(BSON_ARRAY("a"
+                                                                    << "b"
+                                                                    << "c"));
+
+    // Generate a mock scan from 'input' with a single output slot.
+    auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+
+    auto countsSlot = generateSlotId();
+    auto hashAggStage = makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlot),
+        makeEM(countsSlot,
+               stage_builder::makeFunction(
+                   "sum",
+                   makeE<EConstant>(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(1)))),
+        boost::none,
+        false /* allowDiskUse */,
+        kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    ASSERT_THROWS_CODE(prepareTree(ctx.get(), hashAggStage.get(), countsSlot),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+class HashAggStageSpillTest : public PlanStageSpillingTestFixture {
+public:
+    /**
+     * Builds a HashAggStage which counts the input strings "a", "b", "c", "a", "b", "a", "d" by
+     * value. Its output slots hold the group key and the count.
+     */
+    std::pair<value::SlotVector, std::unique_ptr<PlanStage>> makeCountStage(bool allowDiskUse) {
+        auto [inputTag, inputVal] = stage_builder::makeValue(BSON_ARRAY("a"
+                                                                        << "b"
+                                                                        << "c"
+                                                                        << "a"
+                                                                        << "b"
+                                                                        << "a"
+                                                                        << "d"));
+        auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+
+        auto countsSlot = generateSlotId();
+        auto stage = makeS<HashAggStage>(
+            std::move(scanStage),
+            makeSV(scanSlot),
+            makeEM(countsSlot,
+                   stage_builder::makeFunction("sum",
+                                               makeE<EConstant>(value::TypeTags::NumberInt64,
+                                                                value::bitcastFrom<int64_t>(1)))),
+            boost::none,
+            allowDiskUse,
+            kEmptyPlanNodeId);
+        return {makeSV(scanSlot, countsSlot), std::move(stage)};
+    }
+
+    /**
+     * Returns the groups produced by 'stage' as {key: <group key>, count: <count>} objects, sorted
+     * by key.
+     */
+    std::vector<BSONObj> getAllGroups(PlanStage* stage,
+                                      const std::vector<value::SlotAccessor*>& accessors) {
+        std::vector<BSONObj> groups;
+        for (auto st = stage->getNext(); st == PlanState::ADVANCED; st = stage->getNext()) {
+            BSONObjBuilder group;
+            auto [keyTag, keyVal] = accessors[0]->getViewOfValue();
+            bson::appendValueToBsonObj(group, "key", keyTag, keyVal);
+            auto [countTag, countVal] = accessors[1]->getViewOfValue();
+            bson::appendValueToBsonObj(group, "count", countTag, countVal);
+            groups.push_back(group.obj());
+        }
+        std::sort(groups.begin(), groups.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+            return lhs["key"].str() < rhs["key"].str();
+        });
+        return groups;
+    }
+
+    void assertCounts(const std::vector<BSONObj>& groups) {
+        const std::vector<BSONObj> expected = {BSON("key"
+                                                    << "a"
+                                                    << "count" << 3),
+                                               BSON("key"
+                                                    << "b"
+                                                    << "count" << 2),
+                                               BSON("key"
+                                                    << "c"
+                                                    << "count" << 1),
+                                               BSON("key"
+                                                    << "d"
+                                                    << "count" << 1)};
+        ASSERT_EQ(groups.size(), expected.size());
+        for (size_t idx = 0; idx < expected.size(); ++idx) {
+            ASSERT_BSONOBJ_EQ(groups[idx], expected[idx]);
+        }
+    }
+};
+
+TEST_F(HashAggStageSpillTest, HashAggSpillsNewGroupsOnceOverMemoryLimit) {
+    // Re-estimate the memory usage after every input row, against a budget which cannot even hold
+    // a single group. Only the first group is kept in memory, and all the others are spilled.
+    RAIIServerParameterControllerForTest memoryLimitController{
+        "internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill", 1};
+    RAIIServerParameterControllerForTest memoryCheckController{
+        "internalQuerySlotBasedExecutionHashAggMemoryCheckInterval", 1};
+
+    auto [outSlots, stage] = makeCountStage(true /* allowDiskUse */);
+    auto ctx = makeCompileCtx();
+    auto accessors = prepareTree(ctx.get(), stage.get(), outSlots);
+    assertCounts(getAllGroups(stage.get(), accessors));
+
+    // Each of "b", "c" and "d" was spilled into a record of its own, which was rewritten whenever
+    // its group was updated.
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_TRUE(stats->usedDisk);
+    ASSERT_EQ(stats->spilledRecords, 3);
+    ASSERT_GT(stats->spilledBytes, 0);
+    const auto spilledBytes = stats->spilledBytes;
+
+    // Reopening the stage drops the groups spilled by the previous run before spilling again, so
+    // that none of them is counted twice. The statistics accumulate across runs.
+    stage->open(true /* reOpen */);
+    assertCounts(getAllGroups(stage.get(), accessors));
+    ASSERT_EQ(stats->spilledRecords, 6);
+    ASSERT_EQ(stats->spilledBytes, 2 * spilledBytes);
+
+    // Closing the stage drops its spilled groups as well.
+    stage->close();
+    stage->open(false /* reOpen */);
+    assertCounts(getAllGroups(stage.get(), accessors));
+    ASSERT_EQ(stats->spilledRecords, 9);
+    ASSERT_EQ(stats->spilledBytes, 3 * spilledBytes);
+    stage->close();
+}
+
+TEST_F(HashAggStageSpillTest, HashAggWithinMemoryLimitDoesNotSpill) {
+    auto [outSlots, stage] = makeCountStage(true /* allowDiskUse */);
+    auto ctx = makeCompileCtx();
+    auto accessors = prepareTree(ctx.get(), stage.get(), outSlots);
+    assertCounts(getAllGroups(stage.get(), accessors));
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_FALSE(stats->usedDisk);
+    ASSERT_EQ(stats->spilledRecords, 0);
+    ASSERT_EQ(stats->spilledBytes, 0);
+}
+
 }  // namespace mongo::sbe
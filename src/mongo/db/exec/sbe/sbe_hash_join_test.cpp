@@ -37,6 +37,7 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_join.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo::sbe {
 
@@ -79,6 +80,7 @@ TEST_F(HashJoinStageTest, HashJoinCollationTest) {
                                      makeSV(innerCondSlot),
                                      makeSV(),
                                      boost::optional<value::SlotId>{useCollator, collatorSlot},
+                                     false /* allowDiskUse */,
                                      kEmptyPlanNodeId);
 
             return std::make_pair(makeSV(innerCondSlot, outerCondSlot), std::move(hashJoinStage));
@@ -136,4 +138,187 @@ TEST_F(HashJoinStageTest, HashJoinCollationTest) {
     }
 }
 
+TEST_F(HashJoinStageTest, HashJoinExceedingMemoryLimitWithoutDiskUseFails) {
+    // A budget which cannot even hold a single build row.
+    RAIIServerParameterControllerForTest memoryLimitController{
+        "internalQuerySlotBasedExecutionHashJoinApproxMemoryUseInBytesBeforeSpill", 1};
+
+    auto [outerTag, outerVal] = stage_builder::makeValue(BSON_ARRAY("a"
+                                                                    << "b"));
+    auto [outerCondSlot, outerStage] = generateVirtualScan(outerTag, outerVal);
+
+    auto [innerTag, innerVal] = stage_builder::makeValue(BSON_ARRAY("a"
+                                                                    << "b"));
+    auto [innerCondSlot, innerStage] = generateVirtualScan(innerTag, innerVal);
+
+    auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                      std::move(innerStage),
+                                      makeSV(outerCondSlot),
+                                      makeSV(),
+                                      makeSV(innerCondSlot),
+                                      makeSV(),
+                                      boost::none,
+                                      false /* allowDiskUse */,
+                                      kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    ASSERT_THROWS_CODE(prepareTree(ctx.get(), stage.get(), makeSV(innerCondSlot, outerCondSlot)),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+class HashJoinStageSpillTest : public PlanStageSpillingTestFixture {
+public:
+    /**
+     * Builds a HashJoinStage which joins 'outer' and 'inner', arrays of [key, id] pairs, on their
+     * keys, with disk use allowed. Its output slots hold the id of the inner row followed by the
+     * id of the outer row.
+     */
+    std::pair<value::SlotVector, std::unique_ptr<PlanStage>> makeJoinStage(
+        const BSONArray& outer,
+        const BSONArray& inner,
+        boost::optional<value::SlotId> collatorSlot) {
+        auto [outerSlots, outerStage] = generateVirtualScanMulti(2, outer);
+        auto [innerSlots, innerStage] = generateVirtualScanMulti(2, inner);
+        auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                          std::move(innerStage),
+                                          makeSV(outerSlots[0]),
+                                          makeSV(outerSlots[1]),
+                                          makeSV(innerSlots[0]),
+                                          makeSV(innerSlots[1]),
+                                          collatorSlot,
+                                          true /* allowDiskUse */,
+                                          kEmptyPlanNodeId);
+        return {makeSV(innerSlots[1], outerSlots[1]), std::move(stage)};
+    }
+
+    /**
+     * Returns the [inner id, outer id] pairs produced by 'stage', in sorted order.
+     */
+    std::vector<std::pair<int32_t, int32_t>> getAllMatches(
+        PlanStage* stage, const std::vector<value::SlotAccessor*>& accessors) {
+        std::vector<std::pair<int32_t, int32_t>> matches;
+        for (auto st = stage->getNext(); st == PlanState::ADVANCED; st = stage->getNext()) {
+            auto [innerTag, innerVal] = accessors[0]->getViewOfValue();
+            auto [outerTag, outerVal] = accessors[1]->getViewOfValue();
+            ASSERT_EQ(innerTag, value::TypeTags::NumberInt32);
+            ASSERT_EQ(outerTag, value::TypeTags::NumberInt32);
+            matches.emplace_back(value::bitcastTo<int32_t>(innerVal),
+                                 value::bitcastTo<int32_t>(outerVal));
+        }
+        std::sort(matches.begin(), matches.end());
+        return matches;
+    }
+};
+
+TEST_F(HashJoinStageSpillTest, HashJoinSpillsBothSidesOfAllPartitions) {
+    // With a single partition and a budget which cannot even hold a single build row, every row of
+    // both sides is spilled, and the whole join runs over the spilled partition.
+    RAIIServerParameterControllerForTest memoryLimitController{
+        "internalQuerySlotBasedExecutionHashJoinApproxMemoryUseInBytesBeforeSpill", 1};
+    RAIIServerParameterControllerForTest numPartitionsController{
+        "internalQuerySlotBasedExecutionHashJoinNumSpillPartitions", 1};
+
+    const auto outer = BSON_ARRAY(BSON_ARRAY("a" << 1) << BSON_ARRAY("B" << 2)
+                                                       << BSON_ARRAY("c" << 3)
+                                                       << BSON_ARRAY("a" << 4));
+    const auto inner = BSON_ARRAY(BSON_ARRAY("A" << 10) << BSON_ARRAY("b" << 20)
+                                                        << BSON_ARRAY("d" << 30)
+                                                        << BSON_ARRAY("a" << 40));
+
+    for (auto useCollator : {false, true}) {
+        std::vector<std::pair<int32_t, int32_t>> expected;
+        if (useCollator) {
+            expected = {{10, 1}, {10, 4}, {20, 2}, {40, 1}, {40, 4}};
+        } else {
+            expected = {{40, 1}, {40, 4}};
+        }
+
+        auto collatorSlot = generateSlotId();
+        auto [outputSlots, stage] =
+            makeJoinStage(outer, inner, boost::optional<value::SlotId>{useCollator, collatorSlot});
+
+        auto ctx = makeCompileCtx();
+        auto collator = std::make_unique<CollatorInterfaceMock>(
+            CollatorInterfaceMock::MockType::kToLowerString);
+        value::OwnedValueAccessor collatorAccessor;
+        ctx->pushCorrelated(collatorSlot, &collatorAccessor);
+        collatorAccessor.reset(value::TypeTags::collator,
+                               value::bitcastFrom<CollatorInterface*>(collator.get()));
+
+        auto accessors = prepareTree(ctx.get(), stage.get(), outputSlots);
+        ASSERT(getAllMatches(stage.get(), accessors) == expected);
+
+        auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+        ASSERT_TRUE(stats->usedDisk);
+        ASSERT_EQ(stats->numPartitions, 1);
+        ASSERT_EQ(stats->spilledPartitions, 1);
+        ASSERT_EQ(stats->spilledOuterRows, 4);
+        ASSERT_EQ(stats->spilledInnerRows, 4);
+        ASSERT_GT(stats->spilledBytes, 0);
+        const auto spilledBytes = stats->spilledBytes;
+
+        // Reopening the stage drops the partitions spilled by the previous run before spilling
+        // again, with or without closing it first. The statistics accumulate across runs.
+        stage->open(true /* reOpen */);
+        ASSERT(getAllMatches(stage.get(), accessors) == expected);
+        ASSERT_EQ(stats->spilledPartitions, 2);
+        ASSERT_EQ(stats->spilledOuterRows, 8);
+        ASSERT_EQ(stats->spilledInnerRows, 8);
+        ASSERT_EQ(stats->spilledBytes, 2 * spilledBytes);
+
+        stage->close();
+        stage->open(false /* reOpen */);
+        ASSERT(getAllMatches(stage.get(), accessors) == expected);
+        ASSERT_EQ(stats->spilledOuterRows, 12);
+        ASSERT_EQ(stats->spilledBytes, 3 * spilledBytes);
+        stage->close();
+    }
+}
+
+TEST_F(HashJoinStageSpillTest, HashJoinSpillsOnlyTheLargestPartition) {
+    // A budget of a few build rows. The rows keyed "b" and "c" are built first and fit into it, but
+    // the many rows keyed "a" do not. Only the partition holding them is spilled, and the rows
+    // which are built or probed after that go straight to disk if they belong to it.
+    value::MaterializedRow key{1};
+    auto [keyTag, keyVal] = value::makeSmallString("a"_sd);
+    key.reset(0, true, keyTag, keyVal);
+    value::MaterializedRow project{1};
+    project.reset(0, true, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(0));
+    RAIIServerParameterControllerForTest memoryLimitController{
+        "internalQuerySlotBasedExecutionHashJoinApproxMemoryUseInBytesBeforeSpill",
+        5 * static_cast<long long>(key.memUsageForSorter() + project.memUsageForSorter())};
+    RAIIServerParameterControllerForTest numPartitionsController{
+        "internalQuerySlotBasedExecutionHashJoinNumSpillPartitions", 16};
+
+    BSONArrayBuilder outer;
+    outer.append(BSON_ARRAY("b" << 1));
+    outer.append(BSON_ARRAY("c" << 2));
+    std::vector<std::pair<int32_t, int32_t>> expected = {{20, 1}, {30, 2}};
+    for (int32_t id = 100; id < 120; ++id) {
+        outer.append(BSON_ARRAY("a" << id));
+        expected.emplace_back(10, id);
+    }
+    std::sort(expected.begin(), expected.end());
+    const auto inner = BSON_ARRAY(BSON_ARRAY("a" << 10) << BSON_ARRAY("b" << 20)
+                                                        << BSON_ARRAY("c" << 30)
+                                                        << BSON_ARRAY("x" << 40));
+
+    auto [outputSlots, stage] = makeJoinStage(outer.arr(), inner, boost::none);
+    auto ctx = makeCompileCtx();
+    auto accessors = prepareTree(ctx.get(), stage.get(), outputSlots);
+    ASSERT(getAllMatches(stage.get(), accessors) == expected);
+
+    // The rows keyed "b" and "c" are only spilled if they happen to share the partition of "a".
+    auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+    ASSERT_TRUE(stats->usedDisk);
+    ASSERT_EQ(stats->numPartitions, 16);
+    ASSERT_EQ(stats->spilledPartitions, 1);
+    ASSERT_GTE(stats->spilledOuterRows, 20);
+    ASSERT_LTE(stats->spilledOuterRows, 22);
+    ASSERT_GTE(stats->spilledInnerRows, 1);
+    ASSERT_GT(stats->spilledBytes, 0);
+    stage->close();
+}
+
 }  // namespace mongo::sbe
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file contains tests for sbe::HashLookupStage.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_lookup.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
+
+namespace mongo::sbe {
+
+using HashLookupStageTest = PlanStageTestFixture;
+
+TEST_F(HashLookupStageTest, HashLookupFollowsLookupMatchingSemantics) {
+    for (auto useCollator : {false, true}) {
+        auto [outerTag, outerVal] = stage_builder::makeValue(BSON_ARRAY(1 << BSON_ARRAY(2 << 3)
+                                                                          << BSONNULL << 4 << "A"));
+        auto [outerSlot, outerStage] = generateVirtualScan(outerTag, outerVal);
+
+        auto [innerTag, innerVal] = stage_builder::makeValue(
+            BSON_ARRAY(1 << 2 << BSON_ARRAY(3 << 1 << 1) << BSONNULL << "a"));
+        auto [innerSlot, innerStage] = generateVirtualScan(innerTag, innerVal);
+
+        auto collatorSlot = generateSlotId();
+        auto outputSlot = generateSlotId();
+        auto stage = makeS<HashLookupStage>(std::move(outerStage),
+                                            std::move(innerStage),
+                                            outerSlot,
+                                            innerSlot,
+                                            innerSlot,
+                                            outputSlot,
+                                            boost::optional<value::SlotId>{useCollator,
+                                                                           collatorSlot},
+                                            kEmptyPlanNodeId);
+
+        auto ctx = makeCompileCtx();
+
+        auto collator = std::make_unique<CollatorInterfaceMock>(
+            CollatorInterfaceMock::MockType::kToLowerString);
+        value::OwnedValueAccessor collatorAccessor;
+        ctx->pushCorrelated(collatorSlot, &collatorAccessor);
+        collatorAccessor.reset(value::TypeTags::collator,
+                               value::bitcastFrom<CollatorInterface*>(collator.get()));
+
+        auto resultAccessors = prepareTree(ctx.get(), stage.get(), makeSV(outerSlot, outputSlot));
+        auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), resultAccessors);
+        value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+        // Every outer row is produced once, in order, with its matches in the inner order. An
+        // array on the outer side matches any of its elements, and an array on the inner side is
+        // matched by any of its elements.
+        auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY(
+            BSON_ARRAY(1 << BSON_ARRAY(1 << BSON_ARRAY(3 << 1 << 1)))
+            << BSON_ARRAY(BSON_ARRAY(2 << 3) << BSON_ARRAY(2 << BSON_ARRAY(3 << 1 << 1)))
+            << BSON_ARRAY(BSONNULL << BSON_ARRAY(BSONNULL))
+            << BSON_ARRAY(4 << BSONArray())
+            << BSON_ARRAY("A" << (useCollator ? BSON_ARRAY("a") : BSONArray()))));
+        value::ValueGuard expectedGuard{expectedTag, expectedVal};
+        assertValuesEqual(resultsTag, resultsVal, expectedTag, expectedVal);
+    }
+}
+
+TEST_F(HashLookupStageTest, HashLookupExceedingMemoryLimitFails) {
+    RAIIServerParameterControllerForTest memoryLimitController{
+        "internalQuerySlotBasedExecutionHashLookupApproxMemoryUseInBytesLimit", 1};
+
+    auto [outerTag, outerVal] = stage_builder::makeValue(BSON_ARRAY(1));
+    auto [outerSlot, outerStage] = generateVirtualScan(outerTag, outerVal);
+
+    auto [innerTag, innerVal] = stage_builder::makeValue(BSON_ARRAY(1));
+    auto [innerSlot, innerStage] = generateVirtualScan(innerTag, innerVal);
+
+    auto outputSlot = generateSlotId();
+    auto stage = makeS<HashLookupStage>(std::move(outerStage),
+                                        std::move(innerStage),
+                                        outerSlot,
+                                        innerSlot,
+                                        innerSlot,
+                                        outputSlot,
+                                        boost::none,
+                                        kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    ASSERT_THROWS_CODE(prepareTree(ctx.get(), stage.get(), makeSV(outerSlot, outputSlot)),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+}  // namespace mongo::sbe
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
+#include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 
@@ -80,7 +81,7 @@ using MakeStageFn = std::function<std::pair<T, std::unique_ptr<PlanStage>>(
  * observe 1 output slot, use runTest(). For unittests where the PlanStage has multiple input slots
  * and/or where the test needs to observe multiple output slots, use runTestMulti().
  */
-class PlanStageTestFixture : public ServiceContextTest {
+class PlanStageTestFixture : public virtual ServiceContextTest {
 public:
     PlanStageTestFixture() = default;
 
@@ -252,4 +253,16 @@ private:
     std::unique_ptr<value::SlotIdGenerator> _slotIdGenerator;
 };
 
+/**
+ * A PlanStageTestFixture whose OperationContext is backed by a storage engine, for testing stages
+ * which spill to temporary record stores.
+ */
+class PlanStageSpillingTestFixture : public PlanStageTestFixture, public ServiceContextMongoDTest {
+protected:
+    void tearDown() override {
+        PlanStageTestFixture::tearDown();
+        ServiceContextMongoDTest::tearDown();
+    }
+};
+
 }  // namespace mongo::sbe
@@ -68,4 +68,135 @@ TEST_F(SortStageTest, SortNumbersTest) {
     runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
 }
 
+TEST_F(SortStageTest, SortTopKTest) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(BSON_ARRAY(
+        BSON_ARRAY(12LL << "A") << BSON_ARRAY(2.5 << "B") << BSON_ARRAY(7 << "C")
+                                << BSON_ARRAY(Decimal128(4) << "D") << BSON_ARRAY(1 << "E")
+                                << BSON_ARRAY(9 << "F")));
+    value::ValueGuard inputGuard{inputTag, inputVal};
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(12LL << "A") << BSON_ARRAY(9 << "F") << BSON_ARRAY(7 << "C")));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    auto makeStageFn = [](value::SlotVector scanSlots, std::unique_ptr<PlanStage> scanStage) {
+        // Create a SortStage that returns the three largest values of slot0.
+        auto sortStage =
+            makeS<SortStage>(std::move(scanStage),
+                             makeSV(scanSlots[0]),
+                             std::vector<value::SortDirection>{value::SortDirection::Descending},
+                             makeSV(scanSlots[1]),
+                             3,
+                             204857600,
+                             false,
+                             kEmptyPlanNodeId);
+
+        return std::make_pair(scanSlots, std::move(sortStage));
+    };
+
+    inputGuard.reset();
+    expectedGuard.reset();
+    runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
+}
+
+TEST_F(SortStageTest, SortTopKWithMissingKeysTest) {
+    // The row which is missing the sort key arrives once the heap is full, and sorts before the
+    // worst row held by then.
+    auto [inputTag, inputVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(BSON("a" << 3) << 0)
+                   << BSON_ARRAY(BSON("a" << 2) << 1) << BSON_ARRAY(BSON("a" << 5) << 2)
+                   << BSON_ARRAY(BSONObj() << 3) << BSON_ARRAY(BSON("a" << 1) << 4)));
+    value::ValueGuard inputGuard{inputTag, inputVal};
+
+    auto [expectedTag, expectedVal] =
+        stage_builder::makeValue(BSON_ARRAY(BSON_ARRAY(3) << BSON_ARRAY(4)));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    auto makeStageFn = [this](value::SlotVector scanSlots, std::unique_ptr<PlanStage> scanStage) {
+        // Create a SortStage that returns the two smallest values of field 'a' of slot0, which is
+        // Nothing where 'a' is missing.
+        auto keySlot = generateSlotId();
+        auto projectStage = makeProjectStage(
+            std::move(scanStage),
+            kEmptyPlanNodeId,
+            keySlot,
+            stage_builder::makeFunction(
+                "getField", makeE<EVariable>(scanSlots[0]), makeE<EConstant>("a"_sd)));
+
+        auto sortStage =
+            makeS<SortStage>(std::move(projectStage),
+                             makeSV(keySlot),
+                             std::vector<value::SortDirection>{value::SortDirection::Ascending},
+                             makeSV(scanSlots[1]),
+                             2,
+                             204857600,
+                             false,
+                             kEmptyPlanNodeId);
+
+        return std::make_pair(makeSV(scanSlots[1]), std::move(sortStage));
+    };
+
+    inputGuard.reset();
+    expectedGuard.reset();
+    runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
+}
+
+TEST_F(SortStageTest, SortTopKDataSizeOnlyCountsKeptRows) {
+    // Returns the data size which a sort keeping the two smallest values of slot0 reports for
+    // 'input'.
+    auto sortDataSize = [this](const BSONArray& input) {
+        auto [inputTag, inputVal] = stage_builder::makeValue(input);
+        auto [scanSlots, scanStage] = generateVirtualScanMulti(2, inputTag, inputVal);
+        auto stage =
+            makeS<SortStage>(std::move(scanStage),
+                             makeSV(scanSlots[0]),
+                             std::vector<value::SortDirection>{value::SortDirection::Ascending},
+                             makeSV(scanSlots[1]),
+                             2,
+                             204857600,
+                             false,
+                             kEmptyPlanNodeId);
+
+        auto ctx = makeCompileCtx();
+        prepareTree(ctx.get(), stage.get(), scanSlots);
+        auto dataSize =
+            static_cast<const SortStats*>(stage->getSpecificStats())->totalDataSizeBytes;
+        stage->close();
+        return dataSize;
+    };
+
+    // Every row after the second evicts the worst row kept so far, and the rows kept in the end
+    // are the same as when sorting them alone.
+    auto withEvictions = sortDataSize(BSON_ARRAY(
+        BSON_ARRAY(5 << "A") << BSON_ARRAY(4 << "A") << BSON_ARRAY(3 << "A")
+                             << BSON_ARRAY(2 << "A") << BSON_ARRAY(1 << "A")));
+    auto withoutEvictions =
+        sortDataSize(BSON_ARRAY(BSON_ARRAY(2 << "A") << BSON_ARRAY(1 << "A")));
+    ASSERT_GT(withoutEvictions, 0U);
+    ASSERT_EQ(withEvictions, withoutEvictions);
+}
+
+TEST_F(SortStageTest, SortTopKExceedingMemoryLimitWithoutDiskUseFails) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON_ARRAY(12LL << "A") << BSON_ARRAY(2.5 << "B") << BSON_ARRAY(7 << "C")));
+    auto [scanSlots, scanStage] = generateVirtualScanMulti(2, inputTag, inputVal);
+
+    // A budget which cannot even hold a single row makes the heap hand its rows over to the
+    // generic sorter, which is not allowed to spill.
+    auto stage =
+        makeS<SortStage>(std::move(scanStage),
+                         makeSV(scanSlots[0]),
+                         std::vector<value::SortDirection>{value::SortDirection::Ascending},
+                         makeSV(scanSlots[1]),
+                         2,
+                         1,
+                         false,
+                         kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    ASSERT_THROWS_CODE(prepareTree(ctx.get(), stage.get(), scanSlots),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
 }  // namespace mongo::sbe
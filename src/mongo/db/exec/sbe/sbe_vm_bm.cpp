@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * Measures the SBE VM on filter-heavy expressions over documents read from a slot, reporting the
+ * number of instructions executed per document alongside the throughput.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo::sbe {
+namespace {
+constexpr int32_t kNumDocuments = 1000;
+
+std::vector<BSONObj> makeDocuments() {
+    std::vector<BSONObj> docs;
+    docs.reserve(kNumDocuments);
+    for (int32_t i = 0; i < kNumDocuments; ++i) {
+        BSONObjBuilder bob;
+        bob.append("_id", i);
+        bob.append("a", i % 100);
+        if (i % 3) {
+            bob.append("b", i % 7);
+        }
+        bob.append("c", "str");
+        docs.push_back(bob.obj());
+    }
+    return docs;
+}
+
+std::unique_ptr<EExpression> makeInt(int32_t num) {
+    return makeE<EConstant>(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(num));
+}
+
+std::unique_ptr<EExpression> makeGetField(value::SlotId slot, StringData field) {
+    auto [tag, val] = value::makeNewString(field);
+    return makeE<EFunction>(
+        "getField", makeEs(makeE<EVariable>(slot), makeE<EConstant>(tag, val)));
+}
+
+/**
+ * fillEmpty(getField(s, field), null) 'op' 'num', the shape the stage builders generate for
+ * simple match expression predicates.
+ */
+std::unique_ptr<EExpression> makePredicate(value::SlotId slot,
+                                           StringData field,
+                                           EPrimBinary::Op op,
+                                           int32_t num) {
+    return makeE<EPrimBinary>(
+        op,
+        makeE<EFunction>(
+            "fillEmpty",
+            makeEs(makeGetField(slot, field), makeE<EConstant>(value::TypeTags::Null, 0))),
+        makeInt(num));
+}
+
+/**
+ * Compiles the expression built by 'makeExpr' and runs it against every document once per
+ * iteration.
+ */
+template <typename MakeExprFn>
+void runFilter(benchmark::State& state, MakeExprFn makeExpr) {
+    auto docs = makeDocuments();
+
+    value::SlotIdGenerator slotIdGenerator;
+    CoScanStage emptyStage{kEmptyPlanNodeId};
+    CompileCtx ctx{std::make_unique<RuntimeEnvironment>()};
+    ctx.root = &emptyStage;
+
+    value::ViewOfValueAccessor docAccessor;
+    auto docSlot = slotIdGenerator.generate();
+    ctx.pushCorrelated(docSlot, &docAccessor);
+
+    auto expr = makeExpr(docSlot);
+    auto code = expr->compile(ctx);
+    vm::ByteCode vm;
+
+    int64_t passed = 0;
+    for (auto keepRunning : state) {
+        for (auto&& doc : docs) {
+            docAccessor.reset(value::TypeTags::bsonObject,
+                              value::bitcastFrom<const char*>(doc.objdata()));
+            passed += vm.runPredicate(code.get());
+        }
+    }
+    benchmark::DoNotOptimize(passed);
+
+    state.SetItemsProcessed(state.iterations() * kNumDocuments);
+    // This is the exact number of instructions executed per document for straight-line
+    // predicates, and an upper bound when the expression contains branches.
+    state.counters["instrsPerDoc"] = code->instrCount();
+}
+
+void BM_SingleFieldPredicate(benchmark::State& state) {
+    runFilter(state,
+              [](value::SlotId slot) { return makePredicate(slot, "a", EPrimBinary::less, 50); });
+}
+
+void BM_MissingFieldPredicate(benchmark::State& state) {
+    runFilter(state,
+              [](value::SlotId slot) { return makePredicate(slot, "b", EPrimBinary::eq, 3); });
+}
+
+void BM_ConjunctivePredicate(benchmark::State& state) {
+    runFilter(state, [](value::SlotId slot) {
+        return makeE<EPrimBinary>(
+            EPrimBinary::logicAnd,
+            makePredicate(slot, "a", EPrimBinary::greaterEq, 10),
+            makeE<EPrimBinary>(EPrimBinary::logicAnd,
+                               makePredicate(slot, "a", EPrimBinary::lessEq, 90),
+                               makePredicate(slot, "b", EPrimBinary::neq, 0)));
+    });
+}
+}  // namespace
+
+BENCHMARK(BM_SingleFieldPredicate);
+BENCHMARK(BM_MissingFieldPredicate);
+BENCHMARK(BM_ConjunctivePredicate);
+}  // namespace mongo::sbe
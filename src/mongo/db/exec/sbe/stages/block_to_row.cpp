@@ -0,0 +1,224 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/block_to_row.h"
+
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/values/block.h"
+#include "mongo/util/str.h"
+
+namespace mongo::sbe {
+BlockToRowStage::BlockToRowStage(std::unique_ptr<PlanStage> input,
+                                 value::SlotVector blockSlots,
+                                 value::SlotVector outSlots,
+                                 boost::optional<value::SlotId> bitmapSlot,
+                                 PlanNodeId planNodeId)
+    : PlanStage("block_to_row"_sd, planNodeId),
+      _blockSlots(std::move(blockSlots)),
+      _outSlots(std::move(outSlots)),
+      _bitmapSlot(bitmapSlot) {
+    _children.emplace_back(std::move(input));
+    invariant(_blockSlots.size() == _outSlots.size());
+}
+
+std::unique_ptr<PlanStage> BlockToRowStage::clone() const {
+    return std::make_unique<BlockToRowStage>(
+        _children[0]->clone(), _blockSlots, _outSlots, _bitmapSlot, _commonStats.nodeId);
+}
+
+void BlockToRowStage::prepare(CompileCtx& ctx) {
+    _children[0]->prepare(ctx);
+
+    if (_bitmapSlot) {
+        _bitmapAccessor = _children[0]->getAccessor(ctx, *_bitmapSlot);
+    }
+
+    _outAccessors.resize(_outSlots.size());
+    for (size_t idx = 0; idx < _blockSlots.size(); ++idx) {
+        _blockAccessors.push_back(_children[0]->getAccessor(ctx, _blockSlots[idx]));
+
+        auto [it, inserted] = _outAccessorsMap.emplace(_outSlots[idx], idx);
+        uassert(6100401, str::stream() << "duplicate field: " << _outSlots[idx], inserted);
+    }
+    _blocks.resize(_blockSlots.size());
+}
+
+value::SlotAccessor* BlockToRowStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    if (auto it = _outAccessorsMap.find(slot); it != _outAccessorsMap.end()) {
+        return &_outAccessors[it->second];
+    }
+
+    return ctx.getAccessor(slot);
+}
+
+void BlockToRowStage::open(bool reOpen) {
+    auto optTimer(getOptTimer(_opCtx));
+
+    _commonStats.opens++;
+    _children[0]->open(reOpen);
+    _batchSize = 0;
+    _rowIdx = 0;
+}
+
+bool BlockToRowStage::readBatch() {
+    _bitmap = nullptr;
+    if (_bitmapAccessor) {
+        auto [tag, val] = _bitmapAccessor->getViewOfValue();
+        if (tag != value::TypeTags::valueBlock) {
+            return false;
+        }
+        _bitmap = value::getValueBlockView(val);
+    }
+
+    boost::optional<size_t> batchSize;
+    if (_bitmap) {
+        batchSize = _bitmap->count();
+    }
+    for (size_t idx = 0; idx < _blockAccessors.size(); ++idx) {
+        auto [tag, val] = _blockAccessors[idx]->getViewOfValue();
+        if (tag != value::TypeTags::valueBlock) {
+            return false;
+        }
+
+        _blocks[idx] = value::getValueBlockView(val);
+        if (batchSize && *batchSize != _blocks[idx]->count()) {
+            return false;
+        }
+        batchSize = _blocks[idx]->count();
+    }
+
+    _batchSize = batchSize.value_or(0);
+    _rowIdx = 0;
+    return true;
+}
+
+bool BlockToRowStage::isRowSelected() const {
+    if (!_bitmap) {
+        return true;
+    }
+
+    auto [tag, val] = _bitmap->at(_rowIdx);
+    return tag == value::TypeTags::Boolean && value::bitcastTo<bool>(val);
+}
+
+PlanState BlockToRowStage::getNext() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    for (;;) {
+        while (_rowIdx < _batchSize) {
+            if (isRowSelected()) {
+                for (size_t idx = 0; idx < _blocks.size(); ++idx) {
+                    auto [tag, val] = _blocks[idx]->at(_rowIdx);
+                    _outAccessors[idx].reset(false, tag, val);
+                }
+                ++_rowIdx;
+                return trackPlanState(PlanState::ADVANCED);
+            }
+            ++_rowIdx;
+        }
+
+        // We are about to call getNext() on our child so do not bother saving our internal state
+        // in case it yields as the state will be completely overwritten after the getNext() call.
+        disableSlotAccess();
+        auto state = _children[0]->getNext();
+        if (state != PlanState::ADVANCED) {
+            return trackPlanState(state);
+        }
+
+        uassert(6100402,
+                "block_to_row expects value blocks of the same size in its input slots",
+                readBatch());
+    }
+}
+
+void BlockToRowStage::close() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    trackClose();
+    _children[0]->close();
+}
+
+std::unique_ptr<PlanStageStats> BlockToRowStage::getStats(bool includeDebugInfo) const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.append("blockSlots", _blockSlots);
+        bob.append("outSlots", _outSlots);
+        if (_bitmapSlot) {
+            bob.appendNumber("bitmapSlot", static_cast<long long>(*_bitmapSlot));
+        }
+        ret->debugInfo = bob.obj();
+    }
+
+    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    return ret;
+}
+
+const SpecificStats* BlockToRowStage::getSpecificStats() const {
+    return nullptr;
+}
+
+std::vector<DebugPrinter::Block> BlockToRowStage::debugPrint() const {
+    auto ret = PlanStage::debugPrint();
+
+    if (_bitmapSlot) {
+        DebugPrinter::addIdentifier(ret, *_bitmapSlot);
+    }
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _outSlots.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+
+        DebugPrinter::addIdentifier(ret, _outSlots[idx]);
+        ret.emplace_back("=");
+        DebugPrinter::addIdentifier(ret, _blockSlots[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    DebugPrinter::addNewLine(ret);
+    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    return ret;
+}
+
+void BlockToRowStage::doSaveState() {
+    if (!slotsAccessible()) {
+        return;
+    }
+
+    for (auto& accessor : _outAccessors) {
+        accessor.makeOwned();
+    }
+}
+}  // namespace mongo::sbe
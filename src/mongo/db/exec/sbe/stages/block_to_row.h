@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+
+namespace mongo::sbe {
+/**
+ * Switches the plan above it back to row mode. For every batch produced by the child stage, reads
+ * the value blocks held by the 'blockSlots' and returns their rows one by one, putting the values
+ * of each row into the corresponding 'outSlots'. If a 'bitmapSlot' is given, it must hold a block
+ * of the same size and only the rows for which it holds boolean true are returned, which is how a
+ * filter evaluated in block mode is applied.
+ *
+ * Debug string representation:
+ *
+ *  block_to_row bitmapSlot? [outSlot_1 = blockSlot_1, ..., outSlot_n = blockSlot_n] childStage
+ */
+class BlockToRowStage final : public PlanStage {
+public:
+    BlockToRowStage(std::unique_ptr<PlanStage> input,
+                    value::SlotVector blockSlots,
+                    value::SlotVector outSlots,
+                    boost::optional<value::SlotId> bitmapSlot,
+                    PlanNodeId planNodeId);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+
+protected:
+    void doSaveState() final;
+
+private:
+    /**
+     * Reads the blocks of the current batch of the child. Returns false if they do not hold value
+     * blocks of the same size.
+     */
+    bool readBatch();
+
+    /**
+     * Returns true if the row at '_rowIdx' of the current batch is selected by the bitmap.
+     */
+    bool isRowSelected() const;
+
+    const value::SlotVector _blockSlots;
+    const value::SlotVector _outSlots;
+    const boost::optional<value::SlotId> _bitmapSlot;
+
+    std::vector<value::SlotAccessor*> _blockAccessors;
+    value::SlotAccessor* _bitmapAccessor{nullptr};
+    std::vector<value::OwnedValueAccessor> _outAccessors;
+    value::SlotMap<size_t> _outAccessorsMap;
+
+    // Views of the blocks of the current batch, which are owned by the child stage.
+    std::vector<const value::ValueBlock*> _blocks;
+    const value::ValueBlock* _bitmap{nullptr};
+    size_t _batchSize{0};
+    size_t _rowIdx{0};
+};
+}  // namespace mongo::sbe
@@ -31,6 +31,12 @@
 
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/record_data.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -39,11 +45,16 @@ HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
                            value::SlotMap<std::unique_ptr<EExpression>> aggs,
                            boost::optional<value::SlotId> collatorSlot,
+                           bool allowDiskUse,
                            PlanNodeId planNodeId)
     : PlanStage("group"_sd, planNodeId),
       _gbs(std::move(gbs)),
       _aggs(std::move(aggs)),
-      _collatorSlot(collatorSlot) {
+      _collatorSlot(collatorSlot),
+      _allowDiskUse(allowDiskUse),
+      _approxMemoryUseInBytesBeforeSpill(
+          internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill.load()),
+      _memoryCheckInterval(internalQuerySlotBasedExecutionHashAggMemoryCheckInterval.load()) {
     _children.emplace_back(std::move(input));
 }
 
@@ -52,8 +63,12 @@ std::unique_ptr<PlanStage> HashAggStage::clone() const {
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
-    return std::make_unique<HashAggStage>(
-        _children[0]->clone(), _gbs, std::move(aggs), _collatorSlot, _commonStats.nodeId);
+    return std::make_unique<HashAggStage>(_children[0]->clone(),
+                                          _gbs,
+                                          std::move(aggs),
+                                          _collatorSlot,
+                                          _allowDiskUse,
+                                          _commonStats.nodeId);
 }
 
 void HashAggStage::prepare(CompileCtx& ctx) {
@@ -112,12 +127,121 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
     return ctx.getAccessor(slot);
 }
 
+void HashAggStage::accumulate() {
+    for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+        auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
+        _outAggAccessors[idx]->reset(owned, tag, val);
+    }
+}
+
+void HashAggStage::checkMemoryUsageAndSpillIfNecessary() {
+    if (++_rowsSinceMemoryCheck < _memoryCheckInterval) {
+        return;
+    }
+    _rowsSinceMemoryCheck = 0;
+
+    // Computing the size of a group is linear in the size of its values, so rather than tracking
+    // every update we sample the group which has just been updated and maintain a running average.
+    auto sampledSize = _htIt->first.memUsageForSorter() + _htIt->second.memUsageForSorter();
+    ++_numMemorySamples;
+    _avgGroupSizeInBytes += (sampledSize - _avgGroupSizeInBytes) / _numMemorySamples;
+
+    if (_avgGroupSizeInBytes * _ht->size() < _approxMemoryUseInBytesBeforeSpill) {
+        return;
+    }
+
+    uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+            "Exceeded memory limit for $group, but didn't allow external spilling. Pass "
+            "allowDiskUse:true to opt in.",
+            _allowDiskUse);
+    uassert(6100100,
+            "Cannot spill the hash table of a group stage while ignoring prepare conflicts",
+            _opCtx->recoveryUnit()->getPrepareConflictBehavior() !=
+                PrepareConflictBehavior::kIgnoreConflicts);
+
+    _recordStore =
+        _opCtx->getServiceContext()->getStorageEngine()->makeTemporaryRecordStore(_opCtx);
+    _specificStats.usedDisk = true;
+}
+
+RecordId HashAggStage::getSpilledRecordId(const value::MaterializedRow& key) const {
+    // Long RecordIds must be positive; the two top bits are dropped so that adding one can never
+    // overflow. Keys whose hashes collide share a record.
+    return RecordId(static_cast<int64_t>(static_cast<uint64_t>(_ht->hash_function()(key)) >> 2) +
+                    1);
+}
+
+void HashAggStage::readSpilledGroups(const RecordData& record) {
+    _spillTable->clear();
+
+    BufReader buf(record.data(), record.size());
+    auto numGroups = buf.read<LittleEndian<int32_t>>();
+    for (int32_t idx = 0; idx < numGroups; ++idx) {
+        auto key = value::MaterializedRow::deserializeForSorter(buf, {});
+        auto val = value::MaterializedRow::deserializeForSorter(buf, {});
+        _spillTable->emplace(std::move(key), std::move(val));
+    }
+}
+
+void HashAggStage::writeSpilledGroups(const RecordId& rid, bool update) {
+    BufBuilder buf;
+    buf.appendNum(static_cast<int32_t>(_spillTable->size()));
+    for (auto&& [key, val] : *_spillTable) {
+        key.serializeForSorter(buf);
+        val.serializeForSorter(buf);
+    }
+
+    // Take a dummy lock to avoid tripping invariants in the storage layer. This does not protect
+    // anything, the temporary record store is only ever accessed by this stage.
+    Lock::GlobalLock lk(_opCtx, MODE_IX);
+    WriteUnitOfWork wuow(_opCtx);
+    auto status = update
+        ? _recordStore->rs()->updateRecord(_opCtx, rid, buf.buf(), buf.len())
+        : _recordStore->rs()->insertRecord(_opCtx, rid, buf.buf(), buf.len(), Timestamp{})
+              .getStatus();
+    tassert(6100101,
+            str::stream() << "Failed to spill group to disk because " << status.reason(),
+            status.isOK());
+    wuow.commit();
+
+    if (!update) {
+        ++_specificStats.spilledRecords;
+    }
+    _specificStats.spilledBytes += buf.len();
+}
+
+void HashAggStage::accumulateSpilledGroup(value::MaterializedRow key) {
+    auto rid = getSpilledRecordId(key);
+
+    RecordData record;
+    bool found = _recordStore->rs()->findRecord(_opCtx, rid, &record);
+    if (found) {
+        readSpilledGroups(record);
+    } else {
+        _spillTable->clear();
+    }
+
+    auto [it, inserted] = _spillTable->try_emplace(std::move(key), value::MaterializedRow{0});
+    if (inserted) {
+        const_cast<value::MaterializedRow&>(it->first).makeOwned();
+        it->second.resize(_outAggAccessors.size());
+    }
+
+    _htIt = it;
+    accumulate();
+
+    writeSpilledGroups(rid, found);
+}
+
 void HashAggStage::open(bool reOpen) {
     auto optTimer(getOptTimer(_opCtx));
 
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
+    // Groups spilled by a previous open() must not leak into the new results.
+    dropSpilledGroups();
+
     if (_collatorAccessor) {
         auto [tag, collatorVal] = _collatorAccessor->getViewOfValue();
         uassert(5402503, "collatorSlot must be of collator type", tag == value::TypeTags::collator);
@@ -128,6 +252,7 @@ void HashAggStage::open(bool reOpen) {
     } else {
         _ht.emplace();
     }
+    _spillTable.emplace(0, _ht->hash_function(), _ht->key_eq());
 
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inKeyAccessors.size()};
@@ -138,6 +263,17 @@ void HashAggStage::open(bool reOpen) {
             key.reset(idx++, false, tag, val);
         }
 
+        if (_recordStore) {
+            // The hash table has exceeded its memory budget, so it no longer admits new groups.
+            if (auto it = _ht->find(key); it != _ht->end()) {
+                _htIt = it;
+                accumulate();
+            } else {
+                accumulateSpilledGroup(std::move(key));
+            }
+            continue;
+        }
+
         auto [it, inserted] = _ht->try_emplace(std::move(key), value::MaterializedRow{0});
         if (inserted) {
             // Copy keys.
@@ -148,28 +284,51 @@ void HashAggStage::open(bool reOpen) {
 
         // Accumulate.
         _htIt = it;
-        for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
-            auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
-            _outAggAccessors[idx]->reset(owned, tag, val);
-        }
+        accumulate();
+
+        checkMemoryUsageAndSpillIfNecessary();
     }
 
     _children[0]->close();
 
+    _spillTable->clear();
     _htIt = _ht->end();
 }
 
 PlanState HashAggStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
-    if (_htIt == _ht->end()) {
-        _htIt = _ht->begin();
+    if (!_drainingRecordStore) {
+        if (_htIt == _ht->end()) {
+            _htIt = _ht->begin();
+        } else {
+            ++_htIt;
+        }
+
+        if (_htIt != _ht->end()) {
+            return trackPlanState(PlanState::ADVANCED);
+        }
+
+        if (!_recordStore) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        // The in-memory groups are exhausted, continue with the spilled ones.
+        _drainingRecordStore = true;
+        _rsCursor = _recordStore->rs()->getCursor(_opCtx);
+        _htIt = _spillTable->end();
     } else {
         ++_htIt;
     }
 
-    if (_htIt == _ht->end()) {
-        return trackPlanState(PlanState::IS_EOF);
+    while (_htIt == _spillTable->end()) {
+        auto record = _rsCursor->next();
+        if (!record) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        readSpilledGroups(record->data);
+        _htIt = _spillTable->begin();
     }
 
     return trackPlanState(PlanState::ADVANCED);
@@ -177,6 +336,7 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
 
     if (includeDebugInfo) {
         DebugPrinter printer;
@@ -188,6 +348,9 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
                 childrenBob.append(str::stream() << slot, printer.print(expr->debugPrint()));
             }
         }
+        bob.appendBool("usedDisk", _specificStats.usedDisk);
+        bob.appendNumber("spilledRecords", static_cast<long long>(_specificStats.spilledRecords));
+        bob.appendNumber("spilledBytes", static_cast<long long>(_specificStats.spilledBytes));
         ret->debugInfo = bob.obj();
     }
 
@@ -196,7 +359,7 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
@@ -204,6 +367,49 @@ void HashAggStage::close() {
 
     trackClose();
     _ht = boost::none;
+    _spillTable = boost::none;
+
+    dropSpilledGroups();
+}
+
+void HashAggStage::dropSpilledGroups() {
+    _rsCursor.reset();
+    _drainingRecordStore = false;
+    if (_recordStore) {
+        _recordStore->finalizeTemporaryTable(_opCtx,
+                                             TemporaryRecordStore::FinalizationAction::kDelete);
+        _recordStore.reset();
+    }
+
+    _avgGroupSizeInBytes = 0;
+    _numMemorySamples = 0;
+    _rowsSinceMemoryCheck = 0;
+}
+
+void HashAggStage::doSaveState() {
+    if (_rsCursor) {
+        _rsCursor->save();
+    }
+}
+
+void HashAggStage::doRestoreState() {
+    invariant(_opCtx);
+    if (_rsCursor) {
+        auto couldRestore = _rsCursor->restore();
+        tassert(6100102, "Could not restore the cursor over the spilled groups", couldRestore);
+    }
+}
+
+void HashAggStage::doDetachFromOperationContext() {
+    if (_rsCursor) {
+        _rsCursor->detachFromOperationContext();
+    }
+}
+
+void HashAggStage::doAttachToOperationContext(OperationContext* opCtx) {
+    if (_rsCursor) {
+        _rsCursor->reattachToOperationContext(opCtx);
+    }
 }
 
 std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
@@ -32,8 +32,10 @@
 #include <unordered_map>
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/storage/temporary_record_store.h"
 #include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
@@ -53,6 +55,15 @@ namespace sbe {
  * determining whether two group-by keys are equal. For instance, the plan may require us to do a
  * case-insensitive group on a string field.
  *
+ * The hash table is only allowed to grow to approximately
+ * 'internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill' bytes. Once this limit
+ * is reached the stage throws a query-fatal exception if 'allowDiskUse' is false. Otherwise, the
+ * hash table stops admitting new groups: rows whose key is already present keep accumulating in
+ * memory, and every other group is accumulated in a temporary record store instead. Spilled groups
+ * are bucketed by the hash of their key, so updating a spilled group costs one point read and one
+ * write, and no merging of partial aggregates is ever required. The spilled groups are returned
+ * after all of the in-memory groups have been exhausted.
+ *
  * Debug string representation:
  *
  *  group [<group by slots>] [slot_1 = expr_1, ..., slot_n = expr_n] collatorSlot? childStage
@@ -63,6 +74,7 @@ public:
                  value::SlotVector gbs,
                  value::SlotMap<std::unique_ptr<EExpression>> aggs,
                  boost::optional<value::SlotId> collatorSlot,
+                 bool allowDiskUse,
                  PlanNodeId planNodeId);
 
     std::unique_ptr<PlanStage> clone() const final;
@@ -77,6 +89,12 @@ public:
     const SpecificStats* getSpecificStats() const final;
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
+protected:
+    void doSaveState() final;
+    void doRestoreState() final;
+    void doDetachFromOperationContext() final;
+    void doAttachToOperationContext(OperationContext* opCtx) final;
+
 private:
     using TableType = stdx::unordered_map<value::MaterializedRow,
                                           value::MaterializedRow,
@@ -86,9 +104,51 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    /**
+     * Runs the aggregate expressions against the group '_htIt' is currently pointing to.
+     */
+    void accumulate();
+
+    /**
+     * Periodically re-estimates the memory used by the hash table. Once the estimate crosses the
+     * configured threshold, either throws (when disk use is not allowed) or creates the temporary
+     * record store which receives all groups that are not already in the hash table.
+     */
+    void checkMemoryUsageAndSpillIfNecessary();
+
+    /**
+     * Accumulates the current input row into the spilled group identified by 'key', creating the
+     * group if it has not been seen before.
+     */
+    void accumulateSpilledGroup(value::MaterializedRow key);
+
+    /**
+     * Each record in the temporary record store holds all the spilled groups whose keys hash to
+     * the same value. This returns the RecordId of the record which would hold 'key'.
+     */
+    RecordId getSpilledRecordId(const value::MaterializedRow& key) const;
+
+    /**
+     * Replaces the contents of '_spillTable' with the groups serialized in 'record'.
+     */
+    void readSpilledGroups(const RecordData& record);
+
+    /**
+     * Serializes the contents of '_spillTable' into the record identified by 'rid'.
+     */
+    void writeSpilledGroups(const RecordId& rid, bool update);
+
+    /**
+     * Drops the temporary record store, if any, and resets the memory tracking state.
+     */
+    void dropSpilledGroups();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
     const boost::optional<value::SlotId> _collatorSlot;
+    const bool _allowDiskUse;
+    const long long _approxMemoryUseInBytesBeforeSpill;
+    const long long _memoryCheckInterval;
 
     value::SlotAccessorMap _outAccessors;
     std::vector<value::SlotAccessor*> _inKeyAccessors;
@@ -103,8 +163,25 @@ private:
     boost::optional<TableType> _ht;
     TableType::iterator _htIt;
 
+    // Holds the groups of a single record from '_recordStore'. The output accessors read from
+    // this table, through '_htIt', while the spilled groups are being returned.
+    boost::optional<TableType> _spillTable;
+
+    // Only set once the hash table has exceeded its memory budget.
+    std::unique_ptr<TemporaryRecordStore> _recordStore;
+    std::unique_ptr<SeekableRecordCursor> _rsCursor;
+    bool _drainingRecordStore{false};
+
+    // Running estimate of the memory used by a single group, sampled once every
+    // '_memoryCheckInterval' input rows.
+    double _avgGroupSizeInBytes{0};
+    long long _numMemorySamples{0};
+    long long _rowsSinceMemoryCheck{0};
+
     vm::ByteCode _bytecode;
 
+    HashAggStats _specificStats;
+
     bool _compiled{false};
 };
 }  // namespace sbe
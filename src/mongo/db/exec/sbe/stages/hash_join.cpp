@@ -31,11 +31,25 @@
 
 #include "mongo/db/exec/sbe/stages/hash_join.h"
 
+#include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 namespace sbe {
+namespace {
+// Spilled rows are written in batches of at most this many rows or bytes.
+constexpr size_t kMaxSpillBatchRecords = 1000;
+constexpr int kMaxSpillBatchBytes = 8 * 1024 * 1024;
+
+// The RecordIds of the spilled rows of a partition occupy a contiguous range of this size.
+constexpr int kSpilledRecordIdPartitionBits = 40;
+}  // namespace
+
 HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              std::unique_ptr<PlanStage> inner,
                              value::SlotVector outerCond,
@@ -43,6 +57,7 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              value::SlotVector innerCond,
                              value::SlotVector innerProjects,
                              boost::optional<value::SlotId> collatorSlot,
+                             bool allowDiskUse,
                              PlanNodeId planNodeId)
     : PlanStage("hj"_sd, planNodeId),
       _outerCond(std::move(outerCond)),
@@ -50,7 +65,11 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
       _innerCond(std::move(innerCond)),
       _innerProjects(std::move(innerProjects)),
       _collatorSlot(collatorSlot),
-      _probeKey(0) {
+      _allowDiskUse(allowDiskUse),
+      _approxMemoryUseInBytesBeforeSpill(
+          internalQuerySlotBasedExecutionHashJoinApproxMemoryUseInBytesBeforeSpill.load()),
+      _probeKey(0),
+      _partitions(internalQuerySlotBasedExecutionHashJoinNumSpillPartitions.load()) {
     if (_outerCond.size() != _innerCond.size()) {
         uasserted(4822823, "left and right size do not match");
     }
@@ -67,6 +86,7 @@ std::unique_ptr<PlanStage> HashJoinStage::clone() const {
                                            _innerCond,
                                            _innerProjects,
                                            _collatorSlot,
+                                           _allowDiskUse,
                                            _commonStats.nodeId);
 }
 
@@ -111,6 +131,35 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         _outOuterAccessors[slot] = _outOuterProjectAccessors.back().get();
     }
 
+    if (_allowDiskUse) {
+        value::SlotSet innerSlotsDupCheck;
+        for (auto& slot : _innerCond) {
+            innerSlotsDupCheck.emplace(slot);
+            _innerSlots.push_back(slot);
+        }
+        for (auto& slot : _innerProjects) {
+            if (innerSlotsDupCheck.emplace(slot).second) {
+                _innerSlots.push_back(slot);
+            }
+        }
+
+        // Both vectors are sized upfront since the switched accessors keep pointers into them.
+        _spilledInnerAccessors.resize(_innerSlots.size());
+        _outInnerAccessors.reserve(_innerSlots.size());
+        for (size_t idx = 0; idx < _innerSlots.size(); ++idx) {
+            _outInnerAccessors.emplace_back(
+                value::SwitchAccessor{{_children[1]->getAccessor(ctx, _innerSlots[idx]),
+                                       &_spilledInnerAccessors[idx]}});
+            _outInnerAccessorsMap[_innerSlots[idx]] = &_outInnerAccessors.back();
+        }
+
+        // Probe through the switched accessors, so that the same code path can join both the
+        // streamed and the spilled inner rows.
+        for (size_t idx = 0; idx < _innerCond.size(); ++idx) {
+            _inInnerKeyAccessors[idx] = &_outInnerAccessors[idx];
+        }
+    }
+
     _probeKey.resize(_inInnerKeyAccessors.size());
 
     _compiled = true;
@@ -122,12 +171,178 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
             return it->second;
         }
 
+        if (_allowDiskUse) {
+            if (auto it = _outInnerAccessorsMap.find(slot); it != _outInnerAccessorsMap.end()) {
+                return it->second;
+            }
+
+            return ctx.getAccessor(slot);
+        }
+
         return _children[1]->getAccessor(ctx, slot);
     }
 
     return ctx.getAccessor(slot);
 }
 
+size_t HashJoinStage::getPartition(const value::MaterializedRow& key) const {
+    return _ht->hash_function()(key) % _partitions.size();
+}
+
+RecordId HashJoinStage::getSpilledRecordId(size_t partition, int64_t idx) {
+    // Long RecordIds must be positive.
+    return RecordId((static_cast<int64_t>(partition) << kSpilledRecordIdPartitionBits) + idx + 1);
+}
+
+void HashJoinStage::spillRow(SpillBatch& batch, RecordId rid, const value::MaterializedRow& row) {
+    auto offset = batch.buf.len();
+    row.serializeForSorter(batch.buf);
+    batch.records.emplace_back(rid, offset, batch.buf.len() - offset);
+
+    if (batch.records.size() >= kMaxSpillBatchRecords || batch.buf.len() >= kMaxSpillBatchBytes) {
+        flushSpillBatch(batch);
+    }
+}
+
+void HashJoinStage::spillRow(SpillBatch& batch,
+                             RecordId rid,
+                             const value::MaterializedRow& key,
+                             const value::MaterializedRow& project) {
+    auto offset = batch.buf.len();
+    key.serializeForSorter(batch.buf);
+    project.serializeForSorter(batch.buf);
+    batch.records.emplace_back(rid, offset, batch.buf.len() - offset);
+
+    if (batch.records.size() >= kMaxSpillBatchRecords || batch.buf.len() >= kMaxSpillBatchBytes) {
+        flushSpillBatch(batch);
+    }
+}
+
+void HashJoinStage::flushSpillBatch(SpillBatch& batch) {
+    if (batch.records.empty()) {
+        return;
+    }
+
+    std::vector<Record> records;
+    records.reserve(batch.records.size());
+    for (auto&& [rid, offset, len] : batch.records) {
+        records.push_back(Record{rid, RecordData(batch.buf.buf() + offset, len)});
+    }
+    // By passing a vector of null timestamps, these inserts are not timestamped individually, but
+    // rather with the timestamp of the owning operation. We don't care about the timestamps.
+    std::vector<Timestamp> timestamps(records.size());
+
+    // Take a dummy lock to avoid tripping invariants in the storage layer. This does not protect
+    // anything, the temporary record stores are only ever accessed by this stage.
+    Lock::GlobalLock lk(_opCtx, MODE_IX);
+    WriteUnitOfWork wuow(_opCtx);
+    auto status = batch.rs->rs()->insertRecords(_opCtx, &records, timestamps);
+    tassert(6100200,
+            str::stream() << "Failed to spill hash join partition to disk because "
+                          << status.reason(),
+            status.isOK());
+    wuow.commit();
+
+    _specificStats.spilledBytes += batch.buf.len();
+    batch.buf.reset();
+    batch.records.clear();
+}
+
+void HashJoinStage::spillLargestPartition() {
+    if (!_outerRecordStore) {
+        uassert(6100201,
+                "Cannot spill a hash join to disk while ignoring prepare conflicts",
+                _opCtx->recoveryUnit()->getPrepareConflictBehavior() !=
+                    PrepareConflictBehavior::kIgnoreConflicts);
+
+        auto storageEngine = _opCtx->getServiceContext()->getStorageEngine();
+        _outerRecordStore = storageEngine->makeTemporaryRecordStore(_opCtx);
+        _innerRecordStore = storageEngine->makeTemporaryRecordStore(_opCtx);
+        _outerSpillBatch.rs = _outerRecordStore.get();
+        _innerSpillBatch.rs = _innerRecordStore.get();
+        _specificStats.usedDisk = true;
+    }
+
+    size_t victim = 0;
+    for (size_t idx = 1; idx < _partitions.size(); ++idx) {
+        if (_partitions[idx].memUsageBytes > _partitions[victim].memUsageBytes) {
+            victim = idx;
+        }
+    }
+    auto& partition = _partitions[victim];
+    invariant(!partition.spilled);
+
+    for (auto it = _ht->begin(); it != _ht->end();) {
+        if (getPartition(it->first) == victim) {
+            spillRow(_outerSpillBatch,
+                     getSpilledRecordId(victim, partition.numSpilledOuterRows++),
+                     it->first,
+                     it->second);
+            ++_specificStats.spilledOuterRows;
+            it = _ht->erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    _htMemUsageBytes -= partition.memUsageBytes;
+    partition.memUsageBytes = 0;
+    partition.spilled = true;
+    ++_specificStats.spilledPartitions;
+}
+
+void HashJoinStage::insertOuterRow(value::MaterializedRow key, value::MaterializedRow project) {
+    auto partitionIdx = getPartition(key);
+    auto& partition = _partitions[partitionIdx];
+    if (partition.spilled) {
+        spillRow(_outerSpillBatch,
+                 getSpilledRecordId(partitionIdx, partition.numSpilledOuterRows++),
+                 key,
+                 project);
+        ++_specificStats.spilledOuterRows;
+        return;
+    }
+
+    long long rowSize = key.memUsageForSorter() + project.memUsageForSorter();
+    _ht->emplace(std::move(key), std::move(project));
+    partition.memUsageBytes += rowSize;
+    _htMemUsageBytes += rowSize;
+
+    while (_htMemUsageBytes >= _approxMemoryUseInBytesBeforeSpill) {
+        uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                "Exceeded memory limit for hash join, but didn't allow external spilling. Pass "
+                "allowDiskUse:true to opt in.",
+                _allowDiskUse);
+        spillLargestPartition();
+    }
+}
+
+void HashJoinStage::dropSpilledPartitions() {
+    _innerCursor.reset();
+    for (auto rs : {&_outerRecordStore, &_innerRecordStore}) {
+        if (*rs) {
+            (*rs)->finalizeTemporaryTable(_opCtx,
+                                          TemporaryRecordStore::FinalizationAction::kDelete);
+            rs->reset();
+        }
+    }
+    for (auto batch : {&_outerSpillBatch, &_innerSpillBatch}) {
+        batch->rs = nullptr;
+        batch->buf.reset();
+        batch->records.clear();
+    }
+
+    _partitions.assign(_partitions.size(), Partition{});
+    _htMemUsageBytes = 0;
+
+    _joiningSpilledPartitions = false;
+    _currentPartition = 0;
+    _nextSpilledInnerRow = 0;
+    for (auto& accessor : _outInnerAccessors) {
+        accessor.setIndex(0);
+    }
+}
+
 void HashJoinStage::open(bool reOpen) {
     auto optTimer(getOptTimer(_opCtx));
 
@@ -142,6 +357,10 @@ void HashJoinStage::open(bool reOpen) {
         _ht.emplace();
     }
 
+    // Partitions spilled by a previous open() must not leak into the new results.
+    dropSpilledPartitions();
+    _specificStats.numPartitions = _partitions.size();
+
     _commonStats.opens++;
     _children[0]->open(reOpen);
     // Insert the outer side into the hash table.
@@ -163,10 +382,11 @@ void HashJoinStage::open(bool reOpen) {
             project.reset(idx++, true, tag, val);
         }
 
-        _ht->emplace(std::move(key), std::move(project));
+        insertOuterRow(std::move(key), std::move(project));
     }
 
     _children[0]->close();
+    flushSpillBatch(_outerSpillBatch);
 
     _children[1]->open(reOpen);
 
@@ -174,6 +394,81 @@ void HashJoinStage::open(bool reOpen) {
     _htItEnd = _ht->end();
 }
 
+bool HashJoinStage::loadNextSpilledPartition() {
+    for (; _currentPartition < _partitions.size(); ++_currentPartition) {
+        const auto& partition = _partitions[_currentPartition];
+        if (partition.numSpilledOuterRows > 0 && partition.numSpilledInnerRows > 0) {
+            break;
+        }
+    }
+    if (_currentPartition == _partitions.size()) {
+        return false;
+    }
+
+    _ht->clear();
+    auto cursor = _outerRecordStore->rs()->getCursor(_opCtx);
+    const auto& partition = _partitions[_currentPartition];
+    for (int64_t idx = 0; idx < partition.numSpilledOuterRows; ++idx) {
+        auto rid = getSpilledRecordId(_currentPartition, idx);
+        auto record = idx == 0 ? cursor->seekExact(rid) : cursor->next();
+        tassert(6100202, "Missing spilled hash join build row", record && record->id == rid);
+
+        BufReader buf(record->data.data(), record->data.size());
+        auto key = value::MaterializedRow::deserializeForSorter(buf, {});
+        auto project = value::MaterializedRow::deserializeForSorter(buf, {});
+        _ht->emplace(std::move(key), std::move(project));
+    }
+
+    if (!_innerCursor) {
+        _innerCursor = _innerRecordStore->rs()->getCursor(_opCtx);
+    }
+    _nextSpilledInnerRow = 0;
+    return true;
+}
+
+bool HashJoinStage::advanceInnerRow() {
+    if (!_joiningSpilledPartitions) {
+        if (_children[1]->getNext() == PlanState::ADVANCED) {
+            return true;
+        }
+
+        if (!_innerRecordStore) {
+            return false;
+        }
+
+        // The inner side is exhausted, now join the spilled partitions one at a time.
+        flushSpillBatch(_innerSpillBatch);
+        _joiningSpilledPartitions = true;
+        for (auto& accessor : _outInnerAccessors) {
+            accessor.setIndex(1);
+        }
+        _currentPartition = 0;
+        if (!loadNextSpilledPartition()) {
+            return false;
+        }
+    }
+
+    while (_nextSpilledInnerRow == _partitions[_currentPartition].numSpilledInnerRows) {
+        ++_currentPartition;
+        if (!loadNextSpilledPartition()) {
+            return false;
+        }
+    }
+
+    auto rid = getSpilledRecordId(_currentPartition, _nextSpilledInnerRow);
+    auto record = _nextSpilledInnerRow == 0 ? _innerCursor->seekExact(rid) : _innerCursor->next();
+    tassert(6100203, "Missing spilled hash join probe row", record && record->id == rid);
+    ++_nextSpilledInnerRow;
+
+    BufReader buf(record->data.data(), record->data.size());
+    auto row = value::MaterializedRow::deserializeForSorter(buf, {});
+    for (size_t idx = 0; idx < _spilledInnerAccessors.size(); ++idx) {
+        auto [tag, val] = row.copyOrMoveValue(idx);
+        _spilledInnerAccessors[idx].reset(true, tag, val);
+    }
+    return true;
+}
+
 PlanState HashJoinStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
@@ -181,27 +476,44 @@ PlanState HashJoinStage::getNext() {
         ++_htIt;
     }
 
-    if (_htIt == _htItEnd) {
-        while (_htIt == _htItEnd) {
-            auto state = _children[1]->getNext();
-            if (state == PlanState::IS_EOF) {
-                // LEFT and OUTER joins should enumerate "non-returned" rows here.
-                return trackPlanState(state);
-            }
+    while (_htIt == _htItEnd) {
+        if (!advanceInnerRow()) {
+            // LEFT and OUTER joins should enumerate "non-returned" rows here.
+            return trackPlanState(PlanState::IS_EOF);
+        }
 
-            // Copy keys in order to do the lookup.
-            size_t idx = 0;
-            for (auto& p : _inInnerKeyAccessors) {
-                auto [tag, val] = p->getViewOfValue();
-                _probeKey.reset(idx++, false, tag, val);
-            }
+        // Copy keys in order to do the lookup.
+        size_t idx = 0;
+        for (auto& p : _inInnerKeyAccessors) {
+            auto [tag, val] = p->getViewOfValue();
+            _probeKey.reset(idx++, false, tag, val);
+        }
 
-            auto [low, hi] = _ht->equal_range(_probeKey);
-            _htIt = low;
-            _htItEnd = hi;
-            // If _htIt == _htItEnd (i.e. no match) then RIGHT and OUTER joins
-            // should enumerate "non-returned" rows here.
+        if (_innerRecordStore && !_joiningSpilledPartitions) {
+            auto partitionIdx = getPartition(_probeKey);
+            auto& partition = _partitions[partitionIdx];
+            if (partition.spilled) {
+                // Defer the row until its partition is loaded back, unless it cannot match.
+                if (partition.numSpilledOuterRows > 0) {
+                    value::MaterializedRow row{_outInnerAccessors.size()};
+                    for (size_t slotIdx = 0; slotIdx < _outInnerAccessors.size(); ++slotIdx) {
+                        auto [tag, val] = _outInnerAccessors[slotIdx].getViewOfValue();
+                        row.reset(slotIdx, false, tag, val);
+                    }
+                    spillRow(_innerSpillBatch,
+                             getSpilledRecordId(partitionIdx, partition.numSpilledInnerRows++),
+                             row);
+                    ++_specificStats.spilledInnerRows;
+                }
+                continue;
+            }
         }
+
+        auto [low, hi] = _ht->equal_range(_probeKey);
+        _htIt = low;
+        _htItEnd = hi;
+        // If _htIt == _htItEnd (i.e. no match) then RIGHT and OUTER joins
+        // should enumerate "non-returned" rows here.
     }
 
     return trackPlanState(PlanState::ADVANCED);
@@ -213,17 +525,60 @@ void HashJoinStage::close() {
     trackClose();
     _children[1]->close();
     _ht = boost::none;
+    dropSpilledPartitions();
+}
+
+void HashJoinStage::doSaveState() {
+    if (_innerCursor) {
+        _innerCursor->save();
+    }
+}
+
+void HashJoinStage::doRestoreState() {
+    invariant(_opCtx);
+    if (_innerCursor) {
+        auto couldRestore = _innerCursor->restore();
+        tassert(6100204, "Could not restore the cursor over the spilled probe rows", couldRestore);
+    }
+}
+
+void HashJoinStage::doDetachFromOperationContext() {
+    if (_innerCursor) {
+        _innerCursor->detachFromOperationContext();
+    }
+}
+
+void HashJoinStage::doAttachToOperationContext(OperationContext* opCtx) {
+    if (_innerCursor) {
+        _innerCursor->reattachToOperationContext(opCtx);
+    }
 }
 
 std::unique_ptr<PlanStageStats> HashJoinStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashJoinStats>(_specificStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendBool("usedDisk", _specificStats.usedDisk);
+        bob.appendNumber("numPartitions", static_cast<long long>(_specificStats.numPartitions));
+        bob.appendNumber("spilledPartitions",
+                         static_cast<long long>(_specificStats.spilledPartitions));
+        bob.appendNumber("spilledOuterRows",
+                         static_cast<long long>(_specificStats.spilledOuterRows));
+        bob.appendNumber("spilledInnerRows",
+                         static_cast<long long>(_specificStats.spilledInnerRows));
+        bob.appendNumber("spilledBytes", static_cast<long long>(_specificStats.spilledBytes));
+        ret->debugInfo = bob.obj();
+    }
+
     ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
     ret->children.emplace_back(_children[1]->getStats(includeDebugInfo));
     return ret;
 }
 
 const SpecificStats* HashJoinStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> HashJoinStage::debugPrint() const {
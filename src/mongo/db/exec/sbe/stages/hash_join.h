@@ -31,8 +31,10 @@
 
 #include <vector>
 
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/storage/temporary_record_store.h"
 
 namespace mongo::sbe {
 /**
@@ -51,6 +53,20 @@ namespace mongo::sbe {
  * for string equality. For example, this can be used to perform a case-insensitive join on string
  * values.
  *
+ * The rows of the outer side are assigned to one of
+ * 'internalQuerySlotBasedExecutionHashJoinNumSpillPartitions' partitions by the hash of their key.
+ * Once the hash table grows beyond approximately
+ * 'internalQuerySlotBasedExecutionHashJoinApproxMemoryUseInBytesBeforeSpill' bytes, the stage
+ * throws a query-fatal exception if 'allowDiskUse' is false. Otherwise, it operates as a hybrid
+ * hash join: the largest partitions still held in memory are written to a temporary record store
+ * until the hash table fits its budget again, and outer rows of a spilled partition go straight to
+ * disk. Inner rows whose partition is in memory are joined as they stream by; the others are
+ * spilled to disk as well, and each spilled partition is joined once the inner side is exhausted,
+ * by loading its outer rows back into the hash table.
+ *
+ * Since spilled inner rows must be materialized, only the 'innerCond' and 'innerProjects' slots of
+ * the inner side are visible higher in the tree when 'allowDiskUse' is true.
+ *
  * Debug string representation:
  *
  *   hj collatorSlot?
@@ -66,6 +82,7 @@ public:
                   value::SlotVector innerCond,
                   value::SlotVector innerProjects,
                   boost::optional<value::SlotId> collatorSlot,
+                  bool allowDiskUse,
                   PlanNodeId planNodeId);
 
     std::unique_ptr<PlanStage> clone() const final;
@@ -80,7 +97,37 @@ public:
     const SpecificStats* getSpecificStats() const final;
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
+protected:
+    void doSaveState() final;
+    void doRestoreState() final;
+    void doDetachFromOperationContext() final;
+    void doAttachToOperationContext(OperationContext* opCtx) final;
+
 private:
+    /**
+     * Accumulates serialized rows destined for a temporary record store, so that they can be
+     * written in batches rather than one write unit of work at a time.
+     */
+    struct SpillBatch {
+        TemporaryRecordStore* rs{nullptr};
+        BufBuilder buf;
+        // The RecordId, offset in 'buf' and length of each row.
+        std::vector<std::tuple<RecordId, int, int>> records;
+    };
+
+    /**
+     * The state of one partition of the outer (build) side and of the inner (probe) side.
+     */
+    struct Partition {
+        // Approximate memory used by the rows of this partition which live in the hash table.
+        long long memUsageBytes{0};
+        bool spilled{false};
+        // The number of rows of each side written to disk. The RecordIds of the rows of partition
+        // 'p' are consecutive, starting at 'getSpilledRecordId(p, 0)'.
+        int64_t numSpilledOuterRows{0};
+        int64_t numSpilledInnerRows{0};
+    };
+
     using TableType = std::unordered_multimap<value::MaterializedRow,  // NOLINT
                                               value::MaterializedRow,
                                               value::MaterializedRowHasher,
@@ -89,11 +136,53 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashProjectAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    size_t getPartition(const value::MaterializedRow& key) const;
+
+    static RecordId getSpilledRecordId(size_t partition, int64_t idx);
+
+    /**
+     * Inserts a row of the outer side into the hash table or, if its partition has been spilled,
+     * into the temporary record store. Spills partitions whenever the hash table exceeds its
+     * memory budget.
+     */
+    void insertOuterRow(value::MaterializedRow key, value::MaterializedRow project);
+
+    /**
+     * Moves all the rows of the in-memory partition which uses the most memory to disk.
+     */
+    void spillLargestPartition();
+
+    void spillRow(SpillBatch& batch, RecordId rid, const value::MaterializedRow& row);
+    void spillRow(SpillBatch& batch,
+                  RecordId rid,
+                  const value::MaterializedRow& key,
+                  const value::MaterializedRow& project);
+    void flushSpillBatch(SpillBatch& batch);
+
+    /**
+     * Produces the next inner row, either from the inner child or, once the inner child is
+     * exhausted, from the spilled partitions. Returns false when there are no more rows.
+     */
+    bool advanceInnerRow();
+
+    /**
+     * Loads the outer rows of the next spilled partition matched by at least one spilled inner
+     * row into the hash table. Returns false when all spilled partitions have been processed.
+     */
+    bool loadNextSpilledPartition();
+
+    /**
+     * Drops the temporary record stores, if any, and resets all partitions to in-memory.
+     */
+    void dropSpilledPartitions();
+
     const value::SlotVector _outerCond;
     const value::SlotVector _outerProjects;
     const value::SlotVector _innerCond;
     const value::SlotVector _innerProjects;
     const boost::optional<value::SlotId> _collatorSlot;
+    const bool _allowDiskUse;
+    const long long _approxMemoryUseInBytesBeforeSpill;
 
     // All defined values from the outer side (i.e. they come from the hash table).
     value::SlotAccessorMap _outOuterAccessors;
@@ -110,9 +199,17 @@ private:
     // Accessors of output projections.
     std::vector<std::unique_ptr<HashProjectAccessor>> _outOuterProjectAccessors;
 
-    // Accessors of input condition values (keys) that are being inserted into the hash table.
+    // Accessors of input condition values (keys) that are used to probe the hash table.
     std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
 
+    // Only populated if disk use is allowed. All values visible from the inner side, in the order
+    // of '_innerCond' followed by '_innerProjects'. Each accessor switches between the inner child
+    // and '_spilledInnerAccessors' depending on whether spilled partitions are being joined.
+    std::vector<value::SlotId> _innerSlots;
+    std::vector<value::SwitchAccessor> _outInnerAccessors;
+    std::vector<value::OwnedValueAccessor> _spilledInnerAccessors;
+    value::SlotAccessorMap _outInnerAccessorsMap;
+
     // Accessor for collator. Only set if collatorSlot provided during construction.
     value::SlotAccessor* _collatorAccessor = nullptr;
 
@@ -123,8 +220,25 @@ private:
     TableType::iterator _htIt;
     TableType::iterator _htItEnd;
 
+    std::vector<Partition> _partitions;
+    long long _htMemUsageBytes{0};
+
+    // Only set once the first partition is spilled.
+    std::unique_ptr<TemporaryRecordStore> _outerRecordStore;
+    std::unique_ptr<TemporaryRecordStore> _innerRecordStore;
+    SpillBatch _outerSpillBatch;
+    SpillBatch _innerSpillBatch;
+
+    // State used while joining the spilled partitions, after the inner child is exhausted.
+    bool _joiningSpilledPartitions{false};
+    size_t _currentPartition{0};
+    int64_t _nextSpilledInnerRow{0};
+    std::unique_ptr<SeekableRecordCursor> _innerCursor;
+
     vm::ByteCode _bytecode;
 
+    HashJoinStats _specificStats;
+
     bool _compiled{false};
 };
 }  // namespace mongo::sbe
@@ -0,0 +1,287 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/hash_lookup.h"
+
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace sbe {
+HashLookupStage::HashLookupStage(std::unique_ptr<PlanStage> outer,
+                                 std::unique_ptr<PlanStage> inner,
+                                 value::SlotId outerKeySlot,
+                                 value::SlotId innerKeySlot,
+                                 value::SlotId innerProjectSlot,
+                                 value::SlotId lookupStageOutputSlot,
+                                 boost::optional<value::SlotId> collatorSlot,
+                                 PlanNodeId planNodeId)
+    : PlanStage("hash_lookup"_sd, planNodeId),
+      _outerKeySlot(outerKeySlot),
+      _innerKeySlot(innerKeySlot),
+      _innerProjectSlot(innerProjectSlot),
+      _lookupStageOutputSlot(lookupStageOutputSlot),
+      _collatorSlot(collatorSlot),
+      _approxMemoryUseInBytesLimit(
+          internalQuerySlotBasedExecutionHashLookupApproxMemoryUseInBytesLimit.load()),
+      _probeKey(1) {
+    _children.emplace_back(std::move(outer));
+    _children.emplace_back(std::move(inner));
+}
+
+std::unique_ptr<PlanStage> HashLookupStage::clone() const {
+    return std::make_unique<HashLookupStage>(_children[0]->clone(),
+                                             _children[1]->clone(),
+                                             _outerKeySlot,
+                                             _innerKeySlot,
+                                             _innerProjectSlot,
+                                             _lookupStageOutputSlot,
+                                             _collatorSlot,
+                                             _commonStats.nodeId);
+}
+
+void HashLookupStage::prepare(CompileCtx& ctx) {
+    _children[0]->prepare(ctx);
+    _children[1]->prepare(ctx);
+
+    if (_collatorSlot) {
+        _collatorAccessor = getAccessor(ctx, *_collatorSlot);
+        tassert(6100300,
+                "collator accessor should exist if collator slot provided to HashLookupStage",
+                _collatorAccessor != nullptr);
+    }
+
+    _outerKeyAccessor = _children[0]->getAccessor(ctx, _outerKeySlot);
+    _innerKeyAccessor = _children[1]->getAccessor(ctx, _innerKeySlot);
+    _innerProjectAccessor = _children[1]->getAccessor(ctx, _innerProjectSlot);
+
+    _compiled = true;
+}
+
+value::SlotAccessor* HashLookupStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    if (_compiled && slot == _lookupStageOutputSlot) {
+        return &_outAccessor;
+    }
+
+    return _children[0]->getAccessor(ctx, slot);
+}
+
+void HashLookupStage::addHashTableEntry(value::TypeTags keyTag,
+                                        value::Value keyVal,
+                                        size_t bufferIdx) {
+    _probeKey.reset(0, false, keyTag, keyVal);
+    if (auto it = _ht->find(_probeKey); it != _ht->end()) {
+        // Avoid reporting the same inner row twice when its key array contains duplicates.
+        if (it->second.back() != bufferIdx) {
+            it->second.push_back(bufferIdx);
+        }
+        return;
+    }
+
+    value::MaterializedRow key{1};
+    auto [tag, val] = value::copyValue(keyTag, keyVal);
+    key.reset(0, true, tag, val);
+    _bufferMemUsageBytes += key.memUsageForSorter();
+    _ht->emplace(std::move(key), std::vector<size_t>{bufferIdx});
+}
+
+void HashLookupStage::collectMatches(value::TypeTags keyTag, value::Value keyVal) {
+    _probeKey.reset(0, false, keyTag, keyVal);
+    if (auto it = _ht->find(_probeKey); it != _ht->end()) {
+        _matches.insert(_matches.end(), it->second.begin(), it->second.end());
+    }
+}
+
+void HashLookupStage::open(bool reOpen) {
+    auto optTimer(getOptTimer(_opCtx));
+
+    _commonStats.opens++;
+
+    if (_collatorAccessor) {
+        auto [tag, collatorVal] = _collatorAccessor->getViewOfValue();
+        uassert(6100301, "collatorSlot must be of collator type", tag == value::TypeTags::collator);
+        auto collatorView = value::getCollatorView(collatorVal);
+        const value::MaterializedRowHasher hasher(collatorView);
+        const value::MaterializedRowEq equator(collatorView);
+        _ht.emplace(0, hasher, equator);
+    } else {
+        _ht.emplace();
+    }
+    _buffer.clear();
+    _bufferMemUsageBytes = 0;
+
+    // Build the hash table from the inner side.
+    _children[1]->open(reOpen);
+    while (_children[1]->getNext() == PlanState::ADVANCED) {
+        value::MaterializedRow project{1};
+        auto [projectTag, projectVal] = _innerProjectAccessor->copyOrMoveValue();
+        project.reset(0, true, projectTag, projectVal);
+        _bufferMemUsageBytes += project.memUsageForSorter();
+        _buffer.emplace_back(std::move(project));
+
+        auto bufferIdx = _buffer.size() - 1;
+        auto [keyTag, keyVal] = _innerKeyAccessor->getViewOfValue();
+        if (keyTag == value::TypeTags::Nothing) {
+            addHashTableEntry(value::TypeTags::Null, 0, bufferIdx);
+        } else if (value::isArray(keyTag)) {
+            addHashTableEntry(keyTag, keyVal, bufferIdx);
+            for (value::ArrayEnumerator enumerator{keyTag, keyVal}; !enumerator.atEnd();
+                 enumerator.advance()) {
+                auto [elemTag, elemVal] = enumerator.getViewOfValue();
+                addHashTableEntry(elemTag, elemVal, bufferIdx);
+            }
+        } else {
+            addHashTableEntry(keyTag, keyVal, bufferIdx);
+        }
+
+        uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                str::stream() << "Exceeded memory limit of " << _approxMemoryUseInBytesLimit
+                              << " bytes for the inner side of a hash lookup",
+                _bufferMemUsageBytes < _approxMemoryUseInBytesLimit);
+    }
+    _children[1]->close();
+
+    _children[0]->open(reOpen);
+}
+
+PlanState HashLookupStage::getNext() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    auto state = _children[0]->getNext();
+    if (state != PlanState::ADVANCED) {
+        return trackPlanState(state);
+    }
+
+    _matches.clear();
+    auto [keyTag, keyVal] = _outerKeyAccessor->getViewOfValue();
+    if (keyTag == value::TypeTags::Nothing) {
+        collectMatches(value::TypeTags::Null, 0);
+    } else if (value::isArray(keyTag)) {
+        for (value::ArrayEnumerator enumerator{keyTag, keyVal}; !enumerator.atEnd();
+             enumerator.advance()) {
+            auto [elemTag, elemVal] = enumerator.getViewOfValue();
+            collectMatches(elemTag, elemVal);
+        }
+        // Different elements may match the same inner row.
+        std::sort(_matches.begin(), _matches.end());
+        _matches.erase(std::unique(_matches.begin(), _matches.end()), _matches.end());
+    } else {
+        collectMatches(keyTag, keyVal);
+    }
+
+    auto [arrTag, arrVal] = value::makeNewArray();
+    value::ValueGuard arrGuard{arrTag, arrVal};
+    auto arr = value::getArrayView(arrVal);
+    arr->reserve(_matches.size());
+    for (auto bufferIdx : _matches) {
+        auto [tag, val] = _buffer[bufferIdx].getViewOfValue(0);
+        auto [copyTag, copyVal] = value::copyValue(tag, val);
+        arr->push_back(copyTag, copyVal);
+    }
+    arrGuard.reset();
+    _outAccessor.reset(true, arrTag, arrVal);
+
+    return trackPlanState(PlanState::ADVANCED);
+}
+
+void HashLookupStage::close() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    trackClose();
+    _children[0]->close();
+    _ht = boost::none;
+    _buffer.clear();
+    _bufferMemUsageBytes = 0;
+    _outAccessor.reset();
+}
+
+std::unique_ptr<PlanStageStats> HashLookupStage::getStats(bool includeDebugInfo) const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendNumber("outerKeySlot", static_cast<long long>(_outerKeySlot));
+        bob.appendNumber("innerKeySlot", static_cast<long long>(_innerKeySlot));
+        bob.appendNumber("innerProjectSlot", static_cast<long long>(_innerProjectSlot));
+        bob.appendNumber("outputSlot", static_cast<long long>(_lookupStageOutputSlot));
+        if (_collatorSlot) {
+            bob.appendNumber("collatorSlot", static_cast<long long>(*_collatorSlot));
+        }
+        ret->debugInfo = bob.obj();
+    }
+
+    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    ret->children.emplace_back(_children[1]->getStats(includeDebugInfo));
+    return ret;
+}
+
+const SpecificStats* HashLookupStage::getSpecificStats() const {
+    return nullptr;
+}
+
+std::vector<DebugPrinter::Block> HashLookupStage::debugPrint() const {
+    auto ret = PlanStage::debugPrint();
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    DebugPrinter::addIdentifier(ret, _outerKeySlot);
+    ret.emplace_back(DebugPrinter::Block("`,"));
+    DebugPrinter::addIdentifier(ret, _lookupStageOutputSlot);
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    if (_collatorSlot) {
+        DebugPrinter::addIdentifier(ret, *_collatorSlot);
+    }
+
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+
+    DebugPrinter::addKeyword(ret, "outer");
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    DebugPrinter::addKeyword(ret, "inner");
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    DebugPrinter::addIdentifier(ret, _innerKeySlot);
+    ret.emplace_back(DebugPrinter::Block("`,"));
+    DebugPrinter::addIdentifier(ret, _innerProjectSlot);
+    ret.emplace_back(DebugPrinter::Block("`]"));
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+    DebugPrinter::addBlocks(ret, _children[1]->debugPrint());
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    return ret;
+}
+}  // namespace sbe
+}  // namespace mongo
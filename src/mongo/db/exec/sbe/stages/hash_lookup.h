@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo::sbe {
+/**
+ * Implements the equality join of $lookup with the localField/foreignField syntax: every row of
+ * the 'outer' side is produced exactly once, together with an array of the 'innerProject' values
+ * of all the rows of the 'inner' side whose key matches the key of the outer row. This is
+ * effectively a left outer hash join which groups the matches of each outer row.
+ *
+ * All rows from the 'inner' side are used to construct a hash table, which is then probed with the
+ * key of each row of the 'outer' side. The keys follow the matching semantics of $lookup: an array
+ * key on the outer side matches any of its elements, an array key on the inner side is matched by
+ * both the array itself and any of its elements, and a missing key is treated as null. The matches
+ * of each outer row are reported in the order in which the inner rows were produced.
+ *
+ * This is a binding reflector for the inner side; stages higher in the tree can only see the
+ * slots of the outer side and the 'lookupStageOutput' slot.
+ *
+ * Debug string representation:
+ *
+ *  hash_lookup [<outer key> <output>] collatorSlot?
+ *    outer childStage
+ *    inner [<inner key> <inner project>] childStage
+ */
+class HashLookupStage final : public PlanStage {
+public:
+    HashLookupStage(std::unique_ptr<PlanStage> outer,
+                    std::unique_ptr<PlanStage> inner,
+                    value::SlotId outerKeySlot,
+                    value::SlotId innerKeySlot,
+                    value::SlotId innerProjectSlot,
+                    value::SlotId lookupStageOutputSlot,
+                    boost::optional<value::SlotId> collatorSlot,
+                    PlanNodeId planNodeId);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+
+private:
+    // Maps a key to the indexes in '_buffer' of the inner rows with that key.
+    using TableType = std::unordered_map<value::MaterializedRow,  // NOLINT
+                                         std::vector<size_t>,
+                                         value::MaterializedRowHasher,
+                                         value::MaterializedRowEq>;
+
+    /**
+     * Adds the inner row at index 'bufferIdx' to the hash table under the given key.
+     */
+    void addHashTableEntry(value::TypeTags keyTag, value::Value keyVal, size_t bufferIdx);
+
+    /**
+     * Appends to '_matches' the indexes of the inner rows matching the given key.
+     */
+    void collectMatches(value::TypeTags keyTag, value::Value keyVal);
+
+    const value::SlotId _outerKeySlot;
+    const value::SlotId _innerKeySlot;
+    const value::SlotId _innerProjectSlot;
+    const value::SlotId _lookupStageOutputSlot;
+    const boost::optional<value::SlotId> _collatorSlot;
+
+    // The build is aborted with QueryExceededMemoryLimitNoDiskUseAllowed when the inner rows
+    // materialized in '_buffer' approximately exceed this size.
+    const long long _approxMemoryUseInBytesLimit;
+
+    value::SlotAccessor* _outerKeyAccessor{nullptr};
+    value::SlotAccessor* _innerKeyAccessor{nullptr};
+    value::SlotAccessor* _innerProjectAccessor{nullptr};
+    value::SlotAccessor* _collatorAccessor{nullptr};
+    value::OwnedValueAccessor _outAccessor;
+
+    // The materialized 'innerProject' values of all the inner rows, in the order they were
+    // produced.
+    std::vector<value::MaterializedRow> _buffer;
+    long long _bufferMemUsageBytes{0};
+    boost::optional<TableType> _ht;
+
+    // Scratch space for probing '_ht' and for gathering the matches of the current outer row.
+    value::MaterializedRow _probeKey;
+    std::vector<size_t> _matches;
+
+    bool _compiled{false};
+};
+}  // namespace mongo::sbe
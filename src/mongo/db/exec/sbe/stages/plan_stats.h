@@ -196,6 +196,42 @@ struct TraverseStats : public SpecificStats {
     size_t innerCloses{0};
 };
 
+struct HashAggStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashAggStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    bool usedDisk{false};
+    // The number of records inserted into the temporary record store. Each record holds all of
+    // the spilled groups whose keys share a hash value.
+    size_t spilledRecords{0};
+    // The number of bytes written to the temporary record store, including rewrites of records
+    // whose groups were updated after being spilled.
+    size_t spilledBytes{0};
+};
+
+struct HashJoinStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashJoinStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    bool usedDisk{false};
+    size_t numPartitions{0};
+    size_t spilledPartitions{0};
+    size_t spilledOuterRows{0};
+    size_t spilledInnerRows{0};
+    // The number of bytes written to the temporary record stores by both sides of the join.
+    size_t spilledBytes{0};
+};
+
 /**
  * Calculates the total number of physical reads in the given plan stats tree. If a stage can do
  * a physical read (e.g. COLLSCAN or IXSCAN), then its 'numReads' stats is added to the total.
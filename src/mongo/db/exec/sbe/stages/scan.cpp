@@ -260,6 +260,11 @@ void ScanStage::open(bool reOpen) {
 
         if (!_cursor || !_seekKeyAccessor) {
             _cursor = _coll->getCursor(_opCtx, _forward);
+            // A scan driven by a seek key fetches individual records, so reading ahead would only
+            // pollute the cache.
+            if (!_seekKeyAccessor) {
+                _cursor->enableReadAhead();
+            }
         }
     } else {
         _cursor.reset();
@@ -707,6 +712,7 @@ void ParallelScanStage::open(bool reOpen) {
         }
 
         _cursor = _coll->getCursor(_opCtx);
+        _cursor->enableReadAhead();
     }
 
     _open = true;
@@ -32,6 +32,7 @@
 #include "mongo/db/exec/sbe/stages/sort.h"
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/util/str.h"
@@ -47,6 +48,17 @@ std::string nextFileName() {
 
 namespace mongo {
 namespace sbe {
+namespace {
+SortKeyEncoder makeSortKeyEncoder(const std::vector<value::SortDirection>& dirs) {
+    std::vector<bool> isAscending;
+    isAscending.reserve(dirs.size());
+    for (auto dir : dirs) {
+        isAscending.push_back(dir == value::SortDirection::Ascending);
+    }
+    return SortKeyEncoder(isAscending);
+}
+}  // namespace
+
 SortStage::SortStage(std::unique_ptr<PlanStage> input,
                      value::SlotVector obs,
                      std::vector<value::SortDirection> dirs,
@@ -60,7 +72,7 @@ SortStage::SortStage(std::unique_ptr<PlanStage> input,
       _dirs(std::move(dirs)),
       _vals(std::move(vals)),
       _allowDiskUse(allowDiskUse),
-      _mergeData({0, 0}) {
+      _sortKeyEncoder(makeSortKeyEncoder(_dirs)) {
     _children.emplace_back(std::move(input));
 
     invariant(_obs.size() == _dirs.size());
@@ -85,19 +97,20 @@ std::unique_ptr<PlanStage> SortStage::clone() const {
 void SortStage::prepare(CompileCtx& ctx) {
     _children[0]->prepare(ctx);
 
+    // The materialized rows hold the values of the order-by slots followed by the values of the
+    // value slots.
     size_t counter = 0;
     // Process order by fields.
     for (auto& slot : _obs) {
         _inKeyAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
-        auto [it, inserted] =
-            _outAccessors.emplace(slot,
-                                  std::make_unique<value::MaterializedRowKeyAccessor<SorterData*>>(
-                                      _mergeDataIt, counter));
+        auto [it, inserted] = _outAccessors.emplace(
+            slot,
+            std::make_unique<value::MaterializedRowValueAccessor<SorterData*>>(_mergeDataIt,
+                                                                               counter));
         ++counter;
         uassert(4822812, str::stream() << "duplicate field: " << slot, inserted);
     }
 
-    counter = 0;
     // Process value fields.
     for (auto& slot : _vals) {
         _inValueAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
@@ -118,6 +131,58 @@ value::SlotAccessor* SortStage::getAccessor(CompileCtx& ctx, value::SlotId slot)
     return ctx.getAccessor(slot);
 }
 
+KeyString::Value SortStage::encodeInputKeys() const {
+    BSONObjBuilder components;
+    for (auto accessor : _inKeyAccessors) {
+        auto [tag, val] = accessor->getViewOfValue();
+        if (tag == value::TypeTags::Nothing) {
+            components.appendNull(""_sd);
+        } else {
+            tassert(6114601,
+                    str::stream() << "Cannot sort on a value of type " << tag,
+                    tag <= value::TypeTags::bsonCodeWScope);
+            bson::appendValueToBsonObj(components, ""_sd, tag, val);
+        }
+    }
+    return _sortKeyEncoder.encode(components.done());
+}
+
+void SortStage::pushToHeap(SorterData row) {
+    auto less = [this](const SorterData& lhs, const SorterData& rhs) {
+        return _sortKeyEncoder.compare(lhs.first, rhs.first) < 0;
+    };
+
+    // The memory and data size accounted to the heap are those of the rows it keeps, so an evicted
+    // row no longer counts towards either.
+    const auto rowBytes = row.first.memUsageForSorter() + row.second.memUsageForSorter();
+    _heapMemUsageBytes += rowBytes;
+    _specificStats.totalDataSizeBytes += rowBytes;
+    if (_heap.size() == _specificStats.limit) {
+        std::pop_heap(_heap.begin(), _heap.end(), less);
+        const auto evictedBytes =
+            _heap.back().first.memUsageForSorter() + _heap.back().second.memUsageForSorter();
+        _heapMemUsageBytes -= evictedBytes;
+        _specificStats.totalDataSizeBytes -= evictedBytes;
+        _heap.back() = std::move(row);
+    } else {
+        _heap.emplace_back(std::move(row));
+    }
+    std::push_heap(_heap.begin(), _heap.end(), less);
+
+    if (_heapMemUsageBytes > _specificStats.maxMemoryUsageBytes) {
+        // The kept rows do not fit into memory. Let the generic sorter deal with them, so that they
+        // can be spilled to disk.
+        _usingHeap = false;
+        _specificStats.totalDataSizeBytes -= _heapMemUsageBytes;
+        makeSorter();
+        for (auto& heapRow : _heap) {
+            _sorter->emplace(std::move(heapRow.first), std::move(heapRow.second));
+        }
+        _heap.clear();
+        _heapMemUsageBytes = 0;
+    }
+}
+
 void SortStage::makeSorter() {
     SortOptions opts;
     opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
@@ -127,25 +192,12 @@ void SortStage::makeSorter() {
         _specificStats.limit != std::numeric_limits<size_t>::max() ? _specificStats.limit : 0;
     opts.moveSortedDataIntoIterator = true;
 
-    auto comp = [&](const SorterData& lhs, const SorterData& rhs) {
-        auto size = lhs.first.size();
-        auto& left = lhs.first;
-        auto& right = rhs.first;
-        for (size_t idx = 0; idx < size; ++idx) {
-            auto [lhsTag, lhsVal] = left.getViewOfValue(idx);
-            auto [rhsTag, rhsVal] = right.getViewOfValue(idx);
-            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
-
-            auto result = value::bitcastTo<int32_t>(val);
-            if (result) {
-                return _dirs[idx] == value::SortDirection::Descending ? -result : result;
-            }
-        }
-
-        return 0;
+    auto comp = [this](const SorterData& lhs, const SorterData& rhs) {
+        return _sortKeyEncoder.compare(lhs.first, rhs.first);
     };
 
-    _sorter.reset(Sorter<value::MaterializedRow, value::MaterializedRow>::make(opts, comp, {}));
+    _sorter.reset(Sorter<KeyString::Value, value::MaterializedRow>::make(
+        opts, comp, {KeyString::Version::kLatestVersion, {}}));
     _mergeIt.reset();
 }
 
@@ -164,27 +216,50 @@ void SortStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
-    makeSorter();
+    // A limit of zero is handled by the generic sorter, which treats it as no limit at all.
+    _usingHeap = _specificStats.limit != std::numeric_limits<size_t>::max() &&
+        _specificStats.limit != 0;
+    _heap.clear();
+    _heapMemUsageBytes = 0;
+    _heapPos = 0;
+    if (_usingHeap) {
+        _sorter.reset();
+        _mergeIt.reset();
+    } else {
+        makeSorter();
+    }
 
+    uint64_t numRows = 0;
     while (_children[0]->getNext() == PlanState::ADVANCED) {
-        value::MaterializedRow keys{_inKeyAccessors.size()};
-        value::MaterializedRow vals{_inValueAccessors.size()};
-
-        size_t idx = 0;
-        for (auto accessor : _inKeyAccessors) {
-            auto [tag, val] = accessor->getViewOfValue();
-            auto [cTag, cVal] = copyValue(tag, val);
-            keys.reset(idx++, true, cTag, cVal);
-        }
+        ++numRows;
+
+        // Once the heap is full, a row which cannot make it into the result is not even copied.
+        // The heap is ordered by the encoded keys, so the row is screened by its encoded key too.
+        // Ties are resolved in favour of the row which was seen first.
+        auto key = encodeInputKeys();
+        if (!_usingHeap || _heap.size() < _specificStats.limit ||
+            _sortKeyEncoder.compare(key, _heap.front().first) < 0) {
+            value::MaterializedRow vals{_inKeyAccessors.size() + _inValueAccessors.size()};
+
+            size_t idx = 0;
+            for (auto accessor : _inKeyAccessors) {
+                auto [tag, val] = accessor->getViewOfValue();
+                auto [cTag, cVal] = copyValue(tag, val);
+                vals.reset(idx++, true, cTag, cVal);
+            }
 
-        idx = 0;
-        for (auto accessor : _inValueAccessors) {
-            auto [tag, val] = accessor->getViewOfValue();
-            auto [cTag, cVal] = copyValue(tag, val);
-            vals.reset(idx++, true, cTag, cVal);
-        }
+            for (auto accessor : _inValueAccessors) {
+                auto [tag, val] = accessor->getViewOfValue();
+                auto [cTag, cVal] = copyValue(tag, val);
+                vals.reset(idx++, true, cTag, cVal);
+            }
 
-        _sorter->emplace(std::move(keys), std::move(vals));
+            if (_usingHeap) {
+                pushToHeap({std::move(key), std::move(vals)});
+            } else {
+                _sorter->emplace(std::move(key), std::move(vals));
+            }
+        }
 
         if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumResults>(1)) {
             // If we either hit the maximum number of document to return during the trial run, or
@@ -201,13 +276,22 @@ void SortStage::open(bool reOpen) {
         }
     }
 
-    _specificStats.totalDataSizeBytes += _sorter->totalDataSizeSorted();
-    _mergeIt.reset(_sorter->done());
-    _specificStats.spills += _sorter->numSpills();
-    _specificStats.keysSorted += _sorter->numSorted();
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
-    metricsCollector.incrementKeysSorted(_sorter->numSorted());
-    metricsCollector.incrementSorterSpills(_sorter->numSpills());
+    if (_usingHeap) {
+        std::sort_heap(_heap.begin(), _heap.end(), [this](const auto& lhs, const auto& rhs) {
+            return _sortKeyEncoder.compare(lhs.first, rhs.first) < 0;
+        });
+        _specificStats.keysSorted += numRows;
+        metricsCollector.incrementKeysSorted(numRows);
+    } else {
+        _specificStats.totalDataSizeBytes += _sorter->totalDataSizeSorted();
+        _mergeIt.reset(_sorter->done());
+        _specificStats.spills += _sorter->numSpills();
+        _specificStats.spilledDataStorageSize += _sorter->spillStats().spilledDataBytes;
+        _specificStats.keysSorted += _sorter->numSorted();
+        metricsCollector.incrementKeysSorted(_sorter->numSorted());
+        metricsCollector.incrementSorterSpills(_sorter->numSpills());
+    }
 
     _children[0]->close();
 }
@@ -215,6 +299,15 @@ void SortStage::open(bool reOpen) {
 PlanState SortStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
+    if (_usingHeap) {
+        if (_heapPos == _heap.size()) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        _mergeData = std::move(_heap[_heapPos++]);
+        return trackPlanState(PlanState::ADVANCED);
+    }
+
     // When the sort spilled data to disk then read back the sorted runs.
     if (_mergeIt && _mergeIt->more()) {
         _mergeData = _mergeIt->next();
@@ -231,6 +324,8 @@ void SortStage::close() {
     trackClose();
     _mergeIt.reset();
     _sorter.reset();
+    _heap.clear();
+    _heapMemUsageBytes = 0;
 }
 
 std::unique_ptr<PlanStageStats> SortStage::getStats(bool includeDebugInfo) const {
@@ -243,7 +338,10 @@ std::unique_ptr<PlanStageStats> SortStage::getStats(bool includeDebugInfo) const
         bob.appendNumber("totalDataSizeSorted",
                          static_cast<long long>(_specificStats.totalDataSizeBytes));
         bob.appendBool("usedDisk", _specificStats.spills > 0);
+        bob.appendBool("usedTopKHeap", _usingHeap);
         bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+        bob.appendNumber("spilledDataStorageSize",
+                         static_cast<long long>(_specificStats.spilledDataStorageSize));
 
         BSONObjBuilder childrenBob(bob.subobjStart("orderBySlots"));
         for (size_t idx = 0; idx < _obs.size(); ++idx) {
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sort_key_encoder.h"
 
 namespace mongo {
 template <typename Key, typename Value>
@@ -52,7 +53,16 @@ namespace mongo::sbe {
  * materialized rows to disk.
  *
  * If 'limit' is not std::numeric_limits<size_t>::max(), then this is a top-k sort that should only
- * return the number of rows given by the limit.
+ * return the number of rows given by the limit. Such a sort keeps the best 'limit' rows in a
+ * bounded heap instead of feeding all of them to the generic sorter. Once the heap is full, an
+ * incoming row whose sort key does not beat the worst row in the heap is dropped before it is
+ * materialized. If the heap outgrows 'memoryLimit', its rows are handed over to the generic sorter,
+ * which spills them to disk if allowed.
+ *
+ * The sort key of each materialized row is encoded into a KeyString which orders like the values
+ * of the order-by slots under 'dirs', so that the rows are sorted, merged and kept in the heap by
+ * comparing KeyStrings with memcmp(). The values of the order-by slots themselves are materialized
+ * along with the values of the 'vals' slots, so that they are returned exactly as they were read.
  *
  * This stage is a binding reflector, meaning that only the 'obs' and 'vals' slots are visible to
  * nodes higher in the tree.
@@ -91,15 +101,27 @@ protected:
     void doAttachToTrialRunTracker(TrialRunTracker* tracker) override;
 
 private:
+    using SorterIterator = SortIteratorInterface<KeyString::Value, value::MaterializedRow>;
+    using SorterData = std::pair<KeyString::Value, value::MaterializedRow>;
+
     void makeSorter();
 
-    using SorterIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
-    using SorterData = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    /**
+     * Encodes the values of the order-by slots of the current input row into a KeyString.
+     */
+    KeyString::Value encodeInputKeys() const;
+
+    /**
+     * Adds a materialized row to the top-k heap, evicting the worst row if the heap is full. Hands
+     * all rows over to the generic sorter if the heap exceeds the memory limit.
+     */
+    void pushToHeap(SorterData row);
 
     const value::SlotVector _obs;
     const std::vector<value::SortDirection> _dirs;
     const value::SlotVector _vals;
     const bool _allowDiskUse;
+    const SortKeyEncoder _sortKeyEncoder;
     SortStats _specificStats;
 
     std::vector<value::SlotAccessor*> _inKeyAccessors;
@@ -110,7 +132,15 @@ private:
     std::unique_ptr<SorterIterator> _mergeIt;
     SorterData _mergeData;
     SorterData* _mergeDataIt{&_mergeData};
-    std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>> _sorter;
+    std::unique_ptr<Sorter<KeyString::Value, value::MaterializedRow>> _sorter;
+
+    // State of the bounded heap used for a top-k sort. The heap is ordered so that its front is
+    // the worst row kept so far. Once the input is consumed, the rows are sorted in place and
+    // returned in order starting from '_heapPos'.
+    bool _usingHeap{false};
+    std::vector<SorterData> _heap;
+    size_t _heapMemUsageBytes{0};
+    size_t _heapPos{0};
 
     // If provided, used during a trial run to accumulate certain execution stats. Once the trial
     // run is complete, this pointer is reset to nullptr.
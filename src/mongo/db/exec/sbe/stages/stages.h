@@ -343,7 +343,7 @@ public:
     }
 
 protected:
-    PlanYieldPolicy* const _yieldPolicy{nullptr};
+    PlanYieldPolicy* _yieldPolicy{nullptr};
 
 private:
     static const int kInterruptCheckPeriod = 128;
@@ -405,6 +405,19 @@ public:
      */
     virtual void close() = 0;
 
+    /**
+     * Replaces the yield policy of every stage in this tree which was built with one. Used to
+     * reuse a tree, e.g. a clone of a cached one, in a different operation.
+     */
+    void attachNewYieldPolicy(PlanYieldPolicy* yieldPolicy) {
+        if (_yieldPolicy) {
+            _yieldPolicy = yieldPolicy;
+        }
+        for (auto&& child : _children) {
+            child->attachNewYieldPolicy(yieldPolicy);
+        }
+    }
+
     virtual std::vector<DebugPrinter::Block> debugPrint() const {
         auto stats = getCommonStats();
         std::string str = str::stream() << '[' << stats->nodeId << "] " << stats->stageType;
@@ -60,6 +60,9 @@ void UniqueStage::open(bool reOpen) {
 
     ++_commonStats.opens;
     _children[0]->open(reOpen);
+
+    // Keys seen by a previous open() must not suppress the rows of the new one.
+    _seen.clear();
 }
 
 PlanState UniqueStage::getNext() {
@@ -0,0 +1,65 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/values/block.h"
+
+namespace mongo::sbe::value {
+ValueBlock::ValueBlock(const ValueBlock& other) {
+    reserve(other.count());
+    for (size_t idx = 0; idx < other.count(); ++idx) {
+        auto [tag, val] = copyValue(other._tags[idx], other._vals[idx]);
+        push_back(tag, val);
+    }
+}
+
+void ValueBlock::clear() noexcept {
+    for (size_t idx = 0; idx < _tags.size(); ++idx) {
+        releaseValue(_tags[idx], _vals[idx]);
+    }
+    _tags.clear();
+    _vals.clear();
+}
+
+boost::optional<TypeTags> ValueBlock::homogeneousTag() const {
+    if (_tags.empty()) {
+        return boost::none;
+    }
+
+    auto tag = _tags.front();
+    for (auto other : _tags) {
+        if (other != tag) {
+            return boost::none;
+        }
+    }
+    return tag;
+}
+}  // namespace mongo::sbe::value
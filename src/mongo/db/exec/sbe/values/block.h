@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/db/exec/sbe/values/value.h"
+
+namespace mongo::sbe::value {
+/**
+ * A ValueBlock holds the values of one slot for a batch of consecutive rows. Stages running in
+ * block mode exchange blocks instead of single values, so that expressions over a whole batch are
+ * evaluated with a single VM dispatch by the 'valueBlock*' builtins. A block owns its values.
+ */
+class ValueBlock {
+public:
+    ValueBlock() = default;
+
+    ValueBlock(std::vector<TypeTags> tags, std::vector<Value> vals)
+        : _tags(std::move(tags)), _vals(std::move(vals)) {
+        invariant(_tags.size() == _vals.size());
+    }
+
+    ValueBlock(const ValueBlock& other);
+
+    ValueBlock(ValueBlock&& other) noexcept
+        : _tags(std::move(other._tags)), _vals(std::move(other._vals)) {
+        other._tags.clear();
+        other._vals.clear();
+    }
+
+    ValueBlock& operator=(const ValueBlock&) = delete;
+    ValueBlock& operator=(ValueBlock&&) = delete;
+
+    ~ValueBlock() {
+        clear();
+    }
+
+    /**
+     * Appends a value to the block. The block takes ownership of the value.
+     */
+    void push_back(TypeTags tag, Value val) {
+        _tags.push_back(tag);
+        _vals.push_back(val);
+    }
+
+    void reserve(size_t count) {
+        _tags.reserve(count);
+        _vals.reserve(count);
+    }
+
+    void clear() noexcept;
+
+    size_t count() const {
+        return _tags.size();
+    }
+
+    const TypeTags* tags() const {
+        return _tags.data();
+    }
+
+    const Value* vals() const {
+        return _vals.data();
+    }
+
+    std::pair<TypeTags, Value> at(size_t idx) const {
+        return {_tags[idx], _vals[idx]};
+    }
+
+    /**
+     * Returns the type tag shared by all the values of the block, or boost::none if the block is
+     * empty or holds values of different types. The builtins use it to select a typed kernel
+     * which runs over the raw values without dispatching on every tag.
+     */
+    boost::optional<TypeTags> homogeneousTag() const;
+
+private:
+    std::vector<TypeTags> _tags;
+    std::vector<Value> _vals;
+};
+}  // namespace mongo::sbe::value
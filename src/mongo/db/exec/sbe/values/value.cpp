@@ -33,6 +33,7 @@
 
 #include "mongo/base/compare_numbers.h"
 #include "mongo/db/exec/js_function.h"
+#include "mongo/db/exec/sbe/values/block.h"
 #include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/exec/sbe/values/sort_spec.h"
 #include "mongo/db/exec/sbe/values/value_builder.h"
@@ -148,9 +149,17 @@ void PcreRegex::_compile() {
     int eoffset;
     _pcrePtr = pcre_compile(_pattern.c_str(), pcreOptions, &compile_error, &eoffset, nullptr);
     uassert(5073402, str::stream() << "Invalid Regex: " << compile_error, _pcrePtr != nullptr);
+    _requiredLiteral = regex_util::requiredLiteral(_pattern, _options);
 }
 
 int PcreRegex::execute(StringData stringView, int startPos, std::vector<int>& buf) {
+    // Any match lies after 'startPos' and contains the required literal, so a string without one
+    // there cannot match.
+    if (!_requiredLiteral.empty() && static_cast<size_t>(startPos) <= stringView.size() &&
+        std::string_view(stringView.rawData(), stringView.size())
+                .find(_requiredLiteral, startPos) == std::string_view::npos) {
+        return PCRE_ERROR_NOMATCH;
+    }
     return pcre_exec(_pcrePtr,
                      nullptr,
                      stringView.rawData(),
@@ -228,6 +237,11 @@ std::pair<TypeTags, Value> makeCopySortSpec(const SortSpec& ss) {
     return {TypeTags::sortSpec, ssCopy};
 }
 
+std::pair<TypeTags, Value> makeCopyValueBlock(const ValueBlock& block) {
+    auto blockCopy = bitcastFrom<ValueBlock*>(new ValueBlock(block));
+    return {TypeTags::valueBlock, blockCopy};
+}
+
 void releaseValue(TypeTags tag, Value val) noexcept {
     switch (tag) {
         case TypeTags::NumberDecimal:
@@ -277,6 +291,9 @@ void releaseValue(TypeTags tag, Value val) noexcept {
         case TypeTags::sortSpec:
             delete getSortSpecView(val);
             break;
+        case TypeTags::valueBlock:
+            delete getValueBlockView(val);
+            break;
         default:
             break;
     }
@@ -396,6 +413,9 @@ void writeTagToStream(T& stream, const TypeTags tag) {
         case TypeTags::sortSpec:
             stream << "sortSpec";
             break;
+        case TypeTags::valueBlock:
+            stream << "valueBlock";
+            break;
         default:
             stream << "unknown tag";
             break;
@@ -675,6 +695,23 @@ void writeValueToStream(T& stream, TypeTags tag, Value val, size_t depth = 1) {
             writeCollatorToStream(stream, getSortSpecView(val)->getCollator());
             stream << ')';
             break;
+        case TypeTags::valueBlock: {
+            auto block = getValueBlockView(val);
+            stream << "ValueBlock[";
+            for (size_t idx = 0; idx < block->count(); ++idx) {
+                if (idx != 0) {
+                    stream << ", ";
+                }
+                if (idx == kArrayObjectOrNestingMaxDepth) {
+                    stream << "...";
+                    break;
+                }
+                auto [tag, val] = block->at(idx);
+                writeValueToStream(stream, tag, val);
+            }
+            stream << ']';
+            break;
+        }
         default:
             MONGO_UNREACHABLE;
     }
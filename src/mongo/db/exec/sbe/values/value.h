@@ -74,6 +74,7 @@ using IndexKeysInclusionSet = std::bitset<Ordering::kMaxCompoundIndexKeys>;
 
 namespace value {
 class SortSpec;
+class ValueBlock;
 
 static constexpr size_t kStringMaxDisplayLength = 160;
 static constexpr size_t kBinDataMaxDisplayLength = 80;
@@ -149,6 +150,9 @@ enum class TypeTags : uint8_t {
 
     // Pointer to a SortSpec object.
     sortSpec,
+
+    // Pointer to a ValueBlock object holding the values of a slot for a batch of rows.
+    valueBlock,
 };
 
 inline constexpr bool isNumber(TypeTags tag) noexcept {
@@ -662,6 +666,9 @@ private:
     std::string _pattern;
     std::string _options;
 
+    // A literal that every matching string contains, or empty. See regex_util::requiredLiteral().
+    std::string _requiredLiteral;
+
     pcre* _pcrePtr = nullptr;
 };
 
@@ -842,18 +849,25 @@ inline std::pair<TypeTags, Value> makeSmallString(StringData input) {
     return {TypeTags::StringSmall, smallString};
 }
 
-inline std::pair<TypeTags, Value> makeBigString(StringData input) {
-    auto len = input.size();
-    auto ptr = input.rawData();
-
+/**
+ * Allocates a StringBig of 'len' bytes and returns it along with a pointer to its contents, which
+ * are left for the caller to fill in. This lets callers build a string in place rather than copy
+ * it in from a temporary.
+ */
+inline std::tuple<TypeTags, Value, char*> makeUninitializedBigString(size_t len) {
     invariant(len < static_cast<uint32_t>(std::numeric_limits<int32_t>::max()));
 
     auto length = static_cast<uint32_t>(len);
     auto buf = new char[length + 5];
     DataView(buf).write<LittleEndian<int32_t>>(length + 1);
-    memcpy(buf + 4, ptr, length);
     buf[length + 4] = 0;
-    return {TypeTags::StringBig, reinterpret_cast<Value>(buf)};
+    return {TypeTags::StringBig, reinterpret_cast<Value>(buf), buf + 4};
+}
+
+inline std::pair<TypeTags, Value> makeBigString(StringData input) {
+    auto [tag, val, contents] = makeUninitializedBigString(input.size());
+    memcpy(contents, input.rawData(), input.size());
+    return {tag, val};
 }
 
 inline std::pair<TypeTags, Value> makeNewString(StringData input) {
@@ -969,6 +983,10 @@ inline SortSpec* getSortSpecView(Value val) noexcept {
     return reinterpret_cast<SortSpec*>(val);
 }
 
+inline ValueBlock* getValueBlockView(Value val) noexcept {
+    return reinterpret_cast<ValueBlock*>(val);
+}
+
 /**
  * Pattern and flags of Regex are stored in BSON as two C strings written one after another.
  *
@@ -1087,6 +1105,8 @@ std::pair<TypeTags, Value> makeCopyFtsMatcher(const fts::FTSMatcher&);
 
 std::pair<TypeTags, Value> makeCopySortSpec(const SortSpec&);
 
+std::pair<TypeTags, Value> makeCopyValueBlock(const ValueBlock&);
+
 /**
  * Releases memory allocated for the value. If the value does not have any memory allocated for it,
  * does nothing.
@@ -1160,6 +1180,8 @@ inline std::pair<TypeTags, Value> copyValue(TypeTags tag, Value val) {
             return makeCopyFtsMatcher(*getFtsMatcherView(val));
         case TypeTags::sortSpec:
             return makeCopySortSpec(*getSortSpecView(val));
+        case TypeTags::valueBlock:
+            return makeCopyValueBlock(*getValueBlockView(val));
         default:
             break;
     }
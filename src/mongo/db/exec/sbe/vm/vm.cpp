@@ -135,6 +135,16 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
     0,   // jmpNothing
 
     -1,  // fail
+
+    0,  // getFieldImm
+    1,  // getFieldAccessImm
+    0,  // fillEmptyImm
+    0,  // lessImm
+    0,  // lessEqImm
+    0,  // greaterImm
+    0,  // greaterEqImm
+    0,  // eqImm
+    0,  // neqImm
 };
 
 namespace {
@@ -176,12 +186,54 @@ void CodeFragment::removeFixup(FrameId frameId) {
 }
 
 void CodeFragment::copyCodeAndFixup(const CodeFragment& from) {
+    auto base = _instrs.size();
     for (auto fixUp : from._fixUps) {
-        fixUp.offset += _instrs.size();
+        fixUp.offset += base;
         _fixUps.push_back(fixUp);
     }
 
     _instrs.insert(_instrs.end(), from._instrs.begin(), from._instrs.end());
+
+    if (!from._instrs.empty()) {
+        boost::optional<size_t> prevInstr;
+        if (from._prevInstr) {
+            prevInstr = base + *from._prevInstr;
+        } else if (from._lastInstr == size_t{0}) {
+            // A fragment consisting of a single instruction keeps our last instruction as its
+            // predecessor.
+            prevInstr = _lastInstr;
+        }
+        _lastInstr = from._lastInstr ? boost::make_optional(base + *from._lastInstr) : boost::none;
+        _prevInstr = prevInstr;
+    }
+    if (from._maxJumpTarget) {
+        _maxJumpTarget = std::max(_maxJumpTarget, base + from._maxJumpTarget);
+    }
+    _instrCount += from._instrCount;
+}
+
+const uint8_t* CodeFragment::fusableOperands(Instruction::Tags tag) const {
+    if (!_lastInstr || *_lastInstr < _maxJumpTarget) {
+        return nullptr;
+    }
+
+    auto ptr = _instrs.data() + *_lastInstr;
+    if (readFromMemory<Instruction>(ptr).tag != tag) {
+        return nullptr;
+    }
+    return ptr + sizeof(Instruction);
+}
+
+void CodeFragment::removeLastInstr() {
+    invariant(_lastInstr);
+
+    auto i = readFromMemory<Instruction>(_instrs.data() + *_lastInstr);
+    _stackSize -= Instruction::stackOffset[i.tag];
+
+    _instrs.resize(*_lastInstr);
+    _lastInstr = _prevInstr;
+    _prevInstr = boost::none;
+    --_instrCount;
 }
 
 void CodeFragment::append(std::unique_ptr<CodeFragment> code) {
@@ -307,8 +359,78 @@ void CodeFragment::appendSimpleInstruction(Instruction::Tags tag) {
     offset += writeToMemory(offset, i);
 }
 
+void CodeFragment::appendConstValImm(Instruction::Tags tag,
+                                     value::TypeTags constTag,
+                                     value::Value constVal) {
+    Instruction i;
+    i.tag = tag;
+    adjustStackSimple(i);
+
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(constTag) + sizeof(constVal));
+
+    offset += writeToMemory(offset, i);
+    offset += writeToMemory(offset, constTag);
+    offset += writeToMemory(offset, constVal);
+}
+
+void CodeFragment::appendComparison(Instruction::Tags tag, Instruction::Tags immTag) {
+    if (auto operands = fusableOperands(Instruction::pushConstVal)) {
+        auto constTag = readFromMemory<value::TypeTags>(operands);
+        auto constVal = readFromMemory<value::Value>(operands + sizeof(constTag));
+
+        removeLastInstr();
+        appendConstValImm(immTag, constTag, constVal);
+        return;
+    }
+
+    appendSimpleInstruction(tag);
+}
+
+void CodeFragment::appendFillEmpty() {
+    if (auto operands = fusableOperands(Instruction::pushConstVal)) {
+        auto constTag = readFromMemory<value::TypeTags>(operands);
+        auto constVal = readFromMemory<value::Value>(operands + sizeof(constTag));
+
+        removeLastInstr();
+        appendConstValImm(Instruction::fillEmptyImm, constTag, constVal);
+        return;
+    }
+
+    appendSimpleInstruction(Instruction::fillEmpty);
+}
+
 void CodeFragment::appendGetField() {
-    appendSimpleInstruction(Instruction::getField);
+    auto operands = fusableOperands(Instruction::pushConstVal);
+    if (!operands) {
+        appendSimpleInstruction(Instruction::getField);
+        return;
+    }
+
+    auto fieldTag = readFromMemory<value::TypeTags>(operands);
+    auto fieldVal = readFromMemory<value::Value>(operands + sizeof(fieldTag));
+    removeLastInstr();
+
+    // The object is very often read straight from a slot, in which case the push of the slot is
+    // folded in as well.
+    if (auto accessorOperand = fusableOperands(Instruction::pushAccessVal)) {
+        auto accessor = readFromMemory<value::SlotAccessor*>(accessorOperand);
+        removeLastInstr();
+
+        Instruction i;
+        i.tag = Instruction::getFieldAccessImm;
+        adjustStackSimple(i);
+
+        auto offset = allocateSpace(sizeof(Instruction) + sizeof(accessor) + sizeof(fieldTag) +
+                                    sizeof(fieldVal));
+
+        offset += writeToMemory(offset, i);
+        offset += writeToMemory(offset, accessor);
+        offset += writeToMemory(offset, fieldTag);
+        offset += writeToMemory(offset, fieldVal);
+        return;
+    }
+
+    appendConstValImm(Instruction::getFieldImm, fieldTag, fieldVal);
 }
 
 void CodeFragment::appendGetElement() {
@@ -417,37 +539,30 @@ void CodeFragment::appendFunction(Builtin f, ArityType arity) {
                            : writeToMemory(offset, arity);
 }
 
-void CodeFragment::appendJump(int jumpOffset) {
+void CodeFragment::appendJumpInstruction(Instruction::Tags tag, int jumpOffset) {
     Instruction i;
-    i.tag = Instruction::jmp;
+    i.tag = tag;
     adjustStackSimple(i);
 
     auto offset = allocateSpace(sizeof(Instruction) + sizeof(jumpOffset));
 
     offset += writeToMemory(offset, i);
     offset += writeToMemory(offset, jumpOffset);
-}
 
-void CodeFragment::appendJumpTrue(int jumpOffset) {
-    Instruction i;
-    i.tag = Instruction::jmpTrue;
-    adjustStackSimple(i);
+    // Jump offsets are relative to the end of the instruction.
+    _maxJumpTarget = std::max(_maxJumpTarget, _instrs.size() + jumpOffset);
+}
 
-    auto offset = allocateSpace(sizeof(Instruction) + sizeof(jumpOffset));
+void CodeFragment::appendJump(int jumpOffset) {
+    appendJumpInstruction(Instruction::jmp, jumpOffset);
+}
 
-    offset += writeToMemory(offset, i);
-    offset += writeToMemory(offset, jumpOffset);
+void CodeFragment::appendJumpTrue(int jumpOffset) {
+    appendJumpInstruction(Instruction::jmpTrue, jumpOffset);
 }
 
 void CodeFragment::appendJumpNothing(int jumpOffset) {
-    Instruction i;
-    i.tag = Instruction::jmpNothing;
-    adjustStackSimple(i);
-
-    auto offset = allocateSpace(sizeof(Instruction) + sizeof(jumpOffset));
-
-    offset += writeToMemory(offset, i);
-    offset += writeToMemory(offset, jumpOffset);
+    appendJumpInstruction(Instruction::jmpNothing, jumpOffset);
 }
 
 ByteCode::~ByteCode() {
@@ -995,21 +1110,27 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinNewKeyString(Ar
     auto orderingBits = value::numericCast<int32_t>(tagInOrdering, valInOrdering);
     BSONObjBuilder bb;
     for (size_t i = 0; i < Ordering::kMaxCompoundIndexKeys; ++i) {
-        bb.append(""_sd, (orderingBits & (1 << i)) ? 1 : 0);
+        bb.append(""_sd, (orderingBits & (1 << i)) ? -1 : 1);
     }
 
     KeyString::HeapBuilder kb{version, Ordering::make(bb.done())};
 
     for (size_t idx = 2; idx < arity - 1u; ++idx) {
         auto [_, tag, val] = getFromStack(idx);
-        if (value::isNumber(tag)) {
+        if (tag == value::TypeTags::NumberInt32 || tag == value::TypeTags::NumberInt64) {
             auto num = value::numericCast<int64_t>(tag, val);
             kb.appendNumberLong(num);
         } else if (value::isString(tag)) {
             auto str = value::getStringView(tag, val);
             kb.appendString(str);
+        } else if (tag == value::TypeTags::Nothing) {
+            return {false, value::TypeTags::Nothing, 0};
         } else {
-            uasserted(4822802, "unsuppored key string type");
+            // Any other type goes through its BSON representation, which KeyString knows how to
+            // encode for every BSON type.
+            BSONObjBuilder elemBuilder;
+            bson::appendValueToBsonObj(elemBuilder, ""_sd, tag, val);
+            kb.appendBSONElement(elemBuilder.done().firstElement());
         }
     }
 
@@ -1135,9 +1256,12 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAddToSet(ArityT
     invariant(ownAgg && tagAgg == value::TypeTags::ArraySet);
     auto arr = value::getArraySetView(valAgg);
 
-    // Push back the value. Note that array will ignore Nothing.
-    auto [tagCopy, valCopy] = value::copyValue(tagField, valField);
-    arr->push_back(tagCopy, valCopy);
+    // Push back the value. Note that array will ignore Nothing. Don't copy a value that needs an
+    // allocation only for the set to free it again because it already holds an equal one.
+    if (value::isShallowType(tagField) || !arr->values().contains({tagField, valField})) {
+        auto [tagCopy, valCopy] = value::copyValue(tagField, valField);
+        arr->push_back(tagCopy, valCopy);
+    }
 
     guard.reset();
     return {ownAgg, tagAgg, valAgg};
@@ -1168,9 +1292,12 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinCollAddToSet(Ar
     invariant(ownAgg && tagAgg == value::TypeTags::ArraySet);
     auto arr = value::getArraySetView(valAgg);
 
-    // Push back the value. Note that array will ignore Nothing.
-    auto [tagCopy, valCopy] = value::copyValue(tagField, valField);
-    arr->push_back(tagCopy, valCopy);
+    // Push back the value. Note that array will ignore Nothing. Don't copy a value that needs an
+    // allocation only for the set to free it again because it already holds an equal one.
+    if (value::isShallowType(tagField) || !arr->values().contains({tagField, valField})) {
+        auto [tagCopy, valCopy] = value::copyValue(tagField, valField);
+        arr->push_back(tagCopy, valCopy);
+    }
 
     guard.reset();
     return {ownAgg, tagAgg, valAgg};
@@ -1933,16 +2060,35 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinRound(ArityType
 }
 
 std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinConcat(ArityType arity) {
-    StringBuilder result;
+    // Size the result first, so that it can be written straight into the string it is returned
+    // in rather than through intermediate buffers.
+    size_t length = 0;
     for (ArityType idx = 0; idx < arity; ++idx) {
         auto [_, tag, value] = getFromStack(idx);
         if (!value::isString(tag)) {
             return {false, value::TypeTags::Nothing, 0};
         }
-        result << sbe::value::getStringView(tag, value);
+        length += value::getStringView(tag, value).size();
     }
 
-    auto [strTag, strValue] = sbe::value::makeNewString(result.str());
+    auto appendAll = [&](char* dest) {
+        for (ArityType idx = 0; idx < arity; ++idx) {
+            auto [_, tag, value] = getFromStack(idx);
+            auto str = value::getStringView(tag, value);
+            memcpy(dest, str.rawData(), str.size());
+            dest += str.size();
+        }
+    };
+
+    if (length <= value::kSmallStringMaxLength) {
+        char buf[value::kSmallStringMaxLength];
+        appendAll(buf);
+        auto [strTag, strValue] = value::makeNewString({buf, length});
+        return {true, strTag, strValue};
+    }
+
+    auto [strTag, strValue, contents] = value::makeUninitializedBigString(length);
+    appendAll(contents);
     return {true, strTag, strValue};
 }
 
@@ -3247,15 +3393,135 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builti
             return builtinFtsMatch(arity);
         case Builtin::generateSortKey:
             return builtinGenerateSortKey(arity);
+        case Builtin::valueBlockGtScalar:
+            return builtinValueBlockGtScalar(arity);
+        case Builtin::valueBlockGteScalar:
+            return builtinValueBlockGteScalar(arity);
+        case Builtin::valueBlockLtScalar:
+            return builtinValueBlockLtScalar(arity);
+        case Builtin::valueBlockLteScalar:
+            return builtinValueBlockLteScalar(arity);
+        case Builtin::valueBlockEqScalar:
+            return builtinValueBlockEqScalar(arity);
+        case Builtin::valueBlockLogicalAnd:
+            return builtinValueBlockLogicalAnd(arity);
+        case Builtin::valueBlockLogicalOr:
+            return builtinValueBlockLogicalOr(arity);
+        case Builtin::valueBlockAdd:
+            return builtinValueBlockAdd(arity);
+        case Builtin::valueBlockSub:
+            return builtinValueBlockSub(arity);
+        case Builtin::valueBlockMul:
+            return builtinValueBlockMul(arity);
+        case Builtin::valueBlockFillEmpty:
+            return builtinValueBlockFillEmpty(arity);
     }
 
     MONGO_UNREACHABLE;
 }
 
+#if defined(__GNUC__)
+// GCC and Clang support taking the address of a label, so the interpreter loop in ByteCode::run()
+// can use threaded dispatch.
+#define MONGO_SBE_VM_THREADED_DISPATCH 1
+#define INSTRUCTION_CASE(name) \
+    case Instruction::name:    \
+    instr_##name:
+#define DISPATCH_NEXT()                             \
+    if (pcPointer == pcEnd) {                       \
+        goto endOfCode;                             \
+    }                                               \
+    i = readFromMemory<Instruction>(pcPointer);     \
+    pcPointer += sizeof(i);                         \
+    goto* kDispatchTable[i.tag]
+#else
+#define MONGO_SBE_VM_THREADED_DISPATCH 0
+#define INSTRUCTION_CASE(name) case Instruction::name:
+#define DISPATCH_NEXT() break
+#endif
+
 std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragment* code) {
     auto pcPointer = code->instrs().data();
     auto pcEnd = pcPointer + code->instrs().size();
 
+#if MONGO_SBE_VM_THREADED_DISPATCH
+    // Every instruction jumps directly to the handler of its successor instead of going back
+    // through the switch below. This gives each handler its own indirect branch, which the CPU can
+    // predict far better than the single shared one. The table must follow Instruction::Tags.
+    static const void* const kDispatchTable[] = {
+        &&instr_pushConstVal,
+        &&instr_pushAccessVal,
+        &&instr_pushMoveVal,
+        &&instr_pushLocalVal,
+        &&instr_pop,
+        &&instr_swap,
+        &&instr_add,
+        &&instr_sub,
+        &&instr_mul,
+        &&instr_div,
+        &&instr_idiv,
+        &&instr_mod,
+        &&instr_negate,
+        &&instr_numConvert,
+        &&instr_logicNot,
+        &&instr_less,
+        &&instr_lessEq,
+        &&instr_greater,
+        &&instr_greaterEq,
+        &&instr_eq,
+        &&instr_neq,
+        &&instr_cmp3w,
+        &&instr_collLess,
+        &&instr_collLessEq,
+        &&instr_collGreater,
+        &&instr_collGreaterEq,
+        &&instr_collEq,
+        &&instr_collNeq,
+        &&instr_collCmp3w,
+        &&instr_fillEmpty,
+        &&instr_getField,
+        &&instr_getElement,
+        &&instr_collComparisonKey,
+        &&instr_aggSum,
+        &&instr_aggMin,
+        &&instr_aggMax,
+        &&instr_aggFirst,
+        &&instr_aggLast,
+        &&instr_aggCollMin,
+        &&instr_aggCollMax,
+        &&instr_exists,
+        &&instr_isNull,
+        &&instr_isObject,
+        &&instr_isArray,
+        &&instr_isString,
+        &&instr_isNumber,
+        &&instr_isBinData,
+        &&instr_isDate,
+        &&instr_isNaN,
+        &&instr_isRecordId,
+        &&instr_isMinKey,
+        &&instr_isMaxKey,
+        &&instr_typeMatch,
+        &&instr_function,
+        &&instr_functionSmall,
+        &&instr_jmp,
+        &&instr_jmpTrue,
+        &&instr_jmpNothing,
+        &&instr_fail,
+        &&instr_getFieldImm,
+        &&instr_getFieldAccessImm,
+        &&instr_fillEmptyImm,
+        &&instr_lessImm,
+        &&instr_lessEqImm,
+        &&instr_greaterImm,
+        &&instr_greaterEqImm,
+        &&instr_eqImm,
+        &&instr_neqImm,
+    };
+    static_assert(sizeof(kDispatchTable) / sizeof(kDispatchTable[0]) ==
+                  Instruction::lastInstruction);
+#endif
+
     for (;;) {
         if (pcPointer == pcEnd) {
             break;
@@ -3263,7 +3529,7 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
             Instruction i = readFromMemory<Instruction>(pcPointer);
             pcPointer += sizeof(i);
             switch (i.tag) {
-                case Instruction::pushConstVal: {
+                INSTRUCTION_CASE(pushConstVal) {
                     auto tag = readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
                     auto val = readFromMemory<value::Value>(pcPointer);
@@ -3271,27 +3537,27 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(false, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::pushAccessVal: {
+                INSTRUCTION_CASE(pushAccessVal) {
                     auto accessor = readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->getViewOfValue();
                     pushStack(false, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::pushMoveVal: {
+                INSTRUCTION_CASE(pushMoveVal) {
                     auto accessor = readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->copyOrMoveValue();
                     pushStack(true, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::pushLocalVal: {
+                INSTRUCTION_CASE(pushLocalVal) {
                     auto stackOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(stackOffset);
 
@@ -3299,9 +3565,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(false, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::pop: {
+                INSTRUCTION_CASE(pop) {
                     auto [owned, tag, val] = getFromStack(0);
                     popStack();
 
@@ -3309,9 +3575,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(tag, val);
                     }
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::swap: {
+                INSTRUCTION_CASE(swap) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(1);
 
@@ -3335,9 +3601,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                             !rhsOwned || isShallowType(rhsTag));
                     }
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::add: {
+                INSTRUCTION_CASE(add) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3352,9 +3618,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::sub: {
+                INSTRUCTION_CASE(sub) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3369,9 +3635,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::mul: {
+                INSTRUCTION_CASE(mul) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3386,9 +3652,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::div: {
+                INSTRUCTION_CASE(div) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3403,9 +3669,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::idiv: {
+                INSTRUCTION_CASE(idiv) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3420,9 +3686,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::mod: {
+                INSTRUCTION_CASE(mod) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3437,9 +3703,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::negate: {
+                INSTRUCTION_CASE(negate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] = genericSub(
@@ -3451,9 +3717,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(resultTag, resultVal);
                     }
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::numConvert: {
+                INSTRUCTION_CASE(numConvert) {
                     auto tag = readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
 
@@ -3467,9 +3733,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(lhsTag, lhsVal);
                     }
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::logicNot: {
+                INSTRUCTION_CASE(logicNot) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultTag, resultVal] = genericNot(tag, val);
@@ -3479,9 +3745,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::less: {
+                INSTRUCTION_CASE(less) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3496,9 +3762,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::collLess: {
+                INSTRUCTION_CASE(collLess) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3519,9 +3785,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::lessEq: {
+                INSTRUCTION_CASE(lessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3537,9 +3803,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::collLessEq: {
+                INSTRUCTION_CASE(collLessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3560,9 +3826,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::greater: {
+                INSTRUCTION_CASE(greater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3578,9 +3844,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::collGreater: {
+                INSTRUCTION_CASE(collGreater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3601,9 +3867,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::greaterEq: {
+                INSTRUCTION_CASE(greaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3619,9 +3885,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::collGreaterEq: {
+                INSTRUCTION_CASE(collGreaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3642,9 +3908,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::eq: {
+                INSTRUCTION_CASE(eq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3660,9 +3926,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::collEq: {
+                INSTRUCTION_CASE(collEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3683,9 +3949,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::neq: {
+                INSTRUCTION_CASE(neq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3702,9 +3968,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::collNeq: {
+                INSTRUCTION_CASE(collNeq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3726,9 +3992,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::cmp3w: {
+                INSTRUCTION_CASE(cmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3743,9 +4009,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::collCmp3w: {
+                INSTRUCTION_CASE(collCmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3765,9 +4031,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::fillEmpty: {
+                INSTRUCTION_CASE(fillEmpty) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3783,9 +4049,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                             value::releaseValue(rhsTag, rhsVal);
                         }
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::getField: {
+                INSTRUCTION_CASE(getField) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3800,9 +4066,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::getElement: {
+                INSTRUCTION_CASE(getElement) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3817,9 +4083,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::collComparisonKey: {
+                INSTRUCTION_CASE(collComparisonKey) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3847,9 +4113,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggSum: {
+                INSTRUCTION_CASE(aggSum) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3864,9 +4130,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggMin: {
+                INSTRUCTION_CASE(aggMin) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3881,9 +4147,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggCollMin: {
+                INSTRUCTION_CASE(aggCollMin) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [collOwned, collTag, collVal] = getFromStack(0);
@@ -3904,9 +4170,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggMax: {
+                INSTRUCTION_CASE(aggMax) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3921,9 +4187,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggCollMax: {
+                INSTRUCTION_CASE(aggCollMax) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [collOwned, collTag, collVal] = getFromStack(0);
@@ -3944,9 +4210,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggFirst: {
+                INSTRUCTION_CASE(aggFirst) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3961,9 +4227,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::aggLast: {
+                INSTRUCTION_CASE(aggLast) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3978,9 +4244,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::exists: {
+                INSTRUCTION_CASE(exists) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     topStack(false,
@@ -3990,9 +4256,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isNull: {
+                INSTRUCTION_CASE(isNull) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4004,9 +4270,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isObject: {
+                INSTRUCTION_CASE(isObject) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4018,9 +4284,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isArray: {
+                INSTRUCTION_CASE(isArray) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4032,9 +4298,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isString: {
+                INSTRUCTION_CASE(isString) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4046,9 +4312,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isNumber: {
+                INSTRUCTION_CASE(isNumber) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4060,9 +4326,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isBinData: {
+                INSTRUCTION_CASE(isBinData) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4074,9 +4340,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isDate: {
+                INSTRUCTION_CASE(isDate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4088,9 +4354,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isNaN: {
+                INSTRUCTION_CASE(isNaN) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4102,9 +4368,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isRecordId: {
+                INSTRUCTION_CASE(isRecordId) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4116,9 +4382,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isMinKey: {
+                INSTRUCTION_CASE(isMinKey) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4130,9 +4396,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::isMaxKey: {
+                INSTRUCTION_CASE(isMaxKey) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4144,9 +4410,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::typeMatch: {
+                INSTRUCTION_CASE(typeMatch) {
                     auto typeMask = readFromMemory<uint32_t>(pcPointer);
                     pcPointer += sizeof(typeMask);
 
@@ -4161,10 +4427,10 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::function:
-                case Instruction::functionSmall: {
+                INSTRUCTION_CASE(function)
+                INSTRUCTION_CASE(functionSmall) {
                     auto f = readFromMemory<Builtin>(pcPointer);
                     pcPointer += sizeof(f);
                     ArityType arity{0};
@@ -4188,16 +4454,16 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(owned, tag, val);
 
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::jmp: {
+                INSTRUCTION_CASE(jmp) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
                     pcPointer += jumpOffset;
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::jmpTrue: {
+                INSTRUCTION_CASE(jmpTrue) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -4211,9 +4477,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::jmpNothing: {
+                INSTRUCTION_CASE(jmpNothing) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -4221,9 +4487,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (tag == value::TypeTags::Nothing) {
                         pcPointer += jumpOffset;
                     }
-                    break;
+                    DISPATCH_NEXT();
                 }
-                case Instruction::fail: {
+                INSTRUCTION_CASE(fail) {
                     auto [ownedCode, tagCode, valCode] = getFromStack(1);
                     invariant(tagCode == value::TypeTags::NumberInt64);
 
@@ -4236,13 +4502,173 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     uasserted(code, message);
 
-                    break;
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(getFieldImm) {
+                    auto fieldTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(fieldTag);
+                    auto fieldVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(fieldVal);
+
+                    auto [objOwned, objTag, objVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(objTag, objVal, fieldTag, fieldVal);
+
+                    topStack(owned, tag, val);
+
+                    if (objOwned) {
+                        value::releaseValue(objTag, objVal);
+                    }
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(getFieldAccessImm) {
+                    auto accessor = readFromMemory<value::SlotAccessor*>(pcPointer);
+                    pcPointer += sizeof(accessor);
+                    auto fieldTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(fieldTag);
+                    auto fieldVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(fieldVal);
+
+                    auto [objTag, objVal] = accessor->getViewOfValue();
+
+                    auto [owned, tag, val] = getField(objTag, objVal, fieldTag, fieldVal);
+
+                    pushStack(owned, tag, val);
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(fillEmptyImm) {
+                    auto constTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(constTag);
+                    auto constVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(constVal);
+
+                    auto [owned, tag, val] = getFromStack(0);
+
+                    if (tag == value::TypeTags::Nothing) {
+                        topStack(false, constTag, constVal);
+
+                        if (owned) {
+                            value::releaseValue(tag, val);
+                        }
+                    }
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(lessImm) {
+                    auto constTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(constTag);
+                    auto constVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(constVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [tag, val] =
+                        genericCompare<std::less<>>(lhsTag, lhsVal, constTag, constVal);
+
+                    topStack(false, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(lessEqImm) {
+                    auto constTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(constTag);
+                    auto constVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(constVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [tag, val] =
+                        genericCompare<std::less_equal<>>(lhsTag, lhsVal, constTag, constVal);
+
+                    topStack(false, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(greaterImm) {
+                    auto constTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(constTag);
+                    auto constVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(constVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [tag, val] =
+                        genericCompare<std::greater<>>(lhsTag, lhsVal, constTag, constVal);
+
+                    topStack(false, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(greaterEqImm) {
+                    auto constTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(constTag);
+                    auto constVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(constVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [tag, val] =
+                        genericCompare<std::greater_equal<>>(lhsTag, lhsVal, constTag, constVal);
+
+                    topStack(false, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(eqImm) {
+                    auto constTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(constTag);
+                    auto constVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(constVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [tag, val] =
+                        genericCompare<std::equal_to<>>(lhsTag, lhsVal, constTag, constVal);
+
+                    topStack(false, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    DISPATCH_NEXT();
+                }
+                INSTRUCTION_CASE(neqImm) {
+                    auto constTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(constTag);
+                    auto constVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(constVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [tag, val] =
+                        genericCompare<std::not_equal_to<>>(lhsTag, lhsVal, constTag, constVal);
+
+                    topStack(false, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    DISPATCH_NEXT();
                 }
                 default:
                     MONGO_UNREACHABLE;
             }
         }
     }
+#if MONGO_SBE_VM_THREADED_DISPATCH
+endOfCode:
+#endif
     uassert(
         4822801, "The evaluation stack must hold only a single value", _argStackOwned.size() == 1);
 
@@ -4257,6 +4683,10 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
     return {owned, tag, val};
 }
 
+#undef DISPATCH_NEXT
+#undef INSTRUCTION_CASE
+#undef MONGO_SBE_VM_THREADED_DISPATCH
+
 bool ByteCode::runPredicate(const CodeFragment* code) {
     auto [owned, tag, val] = run(code);
 
@@ -271,6 +271,18 @@ struct Instruction {
 
         fail,
 
+        // Superinstructions. These are never emitted directly; the CodeFragment peephole optimizer
+        // produces them by folding a constant/slot push into the instruction consuming it.
+        getFieldImm,        // pushConstVal + getField
+        getFieldAccessImm,  // pushAccessVal + pushConstVal + getField
+        fillEmptyImm,       // pushConstVal + fillEmpty
+        lessImm,            // pushConstVal + less
+        lessEqImm,          // pushConstVal + lessEq
+        greaterImm,         // pushConstVal + greater
+        greaterEqImm,       // pushConstVal + greaterEq
+        eqImm,              // pushConstVal + eq
+        neqImm,             // pushConstVal + neq
+
         lastInstruction  // this is just a marker used to calculate number of instructions
     };
 
@@ -363,6 +375,19 @@ enum class Builtin : uint8_t {
     getRegexFlags,
     ftsMatch,
     generateSortKey,
+
+    // Builtins operating on value blocks, see values/block.h.
+    valueBlockGtScalar,
+    valueBlockGteScalar,
+    valueBlockLtScalar,
+    valueBlockLteScalar,
+    valueBlockEqScalar,
+    valueBlockLogicalAnd,
+    valueBlockLogicalOr,
+    valueBlockAdd,
+    valueBlockSub,
+    valueBlockMul,
+    valueBlockFillEmpty,
 };
 
 using SmallArityType = uint8_t;
@@ -379,6 +404,12 @@ public:
     auto stackSize() const {
         return _stackSize;
     }
+    /**
+     * Number of instructions in this fragment, after superinstruction fusion.
+     */
+    auto instrCount() const {
+        return _instrCount;
+    }
     void removeFixup(FrameId frameId);
 
     void append(std::unique_ptr<CodeFragment> code);
@@ -402,22 +433,22 @@ public:
     void appendNegate();
     void appendNot();
     void appendLess() {
-        appendSimpleInstruction(Instruction::less);
+        appendComparison(Instruction::less, Instruction::lessImm);
     }
     void appendLessEq() {
-        appendSimpleInstruction(Instruction::lessEq);
+        appendComparison(Instruction::lessEq, Instruction::lessEqImm);
     }
     void appendGreater() {
-        appendSimpleInstruction(Instruction::greater);
+        appendComparison(Instruction::greater, Instruction::greaterImm);
     }
     void appendGreaterEq() {
-        appendSimpleInstruction(Instruction::greaterEq);
+        appendComparison(Instruction::greaterEq, Instruction::greaterEqImm);
     }
     void appendEq() {
-        appendSimpleInstruction(Instruction::eq);
+        appendComparison(Instruction::eq, Instruction::eqImm);
     }
     void appendNeq() {
-        appendSimpleInstruction(Instruction::neq);
+        appendComparison(Instruction::neq, Instruction::neqImm);
     }
     void appendCmp3w() {
         appendSimpleInstruction(Instruction::cmp3w);
@@ -443,9 +474,7 @@ public:
     void appendCollCmp3w() {
         appendSimpleInstruction(Instruction::collCmp3w);
     }
-    void appendFillEmpty() {
-        appendSimpleInstruction(Instruction::fillEmpty);
-    }
+    void appendFillEmpty();
     void appendGetField();
     void appendGetElement();
     void appendCollComparisonKey();
@@ -484,18 +513,42 @@ public:
 
 private:
     void appendSimpleInstruction(Instruction::Tags tag);
+    void appendComparison(Instruction::Tags tag, Instruction::Tags immTag);
+    void appendConstValImm(Instruction::Tags tag, value::TypeTags constTag, value::Value constVal);
+    void appendJumpInstruction(Instruction::Tags tag, int jumpOffset);
     auto allocateSpace(size_t size) {
         auto oldSize = _instrs.size();
         _instrs.resize(oldSize + size);
+        _prevInstr = _lastInstr;
+        _lastInstr = oldSize;
+        ++_instrCount;
         return _instrs.data() + oldSize;
     }
 
+    /**
+     * Peephole optimizer support. Returns a pointer to the operands of the last instruction of
+     * this fragment if it is a 'tag' instruction that can be folded into the instruction about to
+     * be appended, i.e. no jump lands past its first byte. Returns nullptr otherwise.
+     */
+    const uint8_t* fusableOperands(Instruction::Tags tag) const;
+    void removeLastInstr();
+
     void adjustStackSimple(const Instruction& i);
     void fixup(int offset);
     void copyCodeAndFixup(const CodeFragment& from);
 
     std::vector<uint8_t> _instrs;
 
+    /**
+     * Offsets of the last two instructions in '_instrs', when known, and the furthest offset
+     * targeted by any jump in this fragment. An instruction can only be fused into its successor
+     * when no jump lands in between.
+     */
+    boost::optional<size_t> _lastInstr;
+    boost::optional<size_t> _prevInstr;
+    size_t _maxJumpTarget{0};
+    size_t _instrCount{0};
+
     /**
      * Local variables bound by the let expressions live on the stack and are accessed by knowing an
      * offset from the top of the stack. As CodeFragments are appened together the offsets must be
@@ -776,6 +829,17 @@ private:
     std::tuple<bool, value::TypeTags, value::Value> builtinGetRegexFlags(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinFtsMatch(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinGenerateSortKey(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockGtScalar(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockGteScalar(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockLtScalar(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockLteScalar(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockEqScalar(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockLogicalAnd(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockLogicalOr(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockAdd(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockSub(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockMul(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockFillEmpty(ArityType arity);
 
     std::tuple<bool, value::TypeTags, value::Value> dispatchBuiltin(Builtin f, ArityType arity);
 
@@ -0,0 +1,396 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/values/block.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo {
+namespace sbe {
+namespace vm {
+namespace {
+/**
+ * Returns the numeric type in which the values of a homogeneous block of type 'blockTag' are
+ * combined with a scalar of type 'scalarTag' without any loss, or boost::none if there is no such
+ * type and the slow path must be taken. Decimals always take the slow path.
+ */
+boost::optional<value::TypeTags> getKernelType(boost::optional<value::TypeTags> blockTag,
+                                               value::TypeTags scalarTag) {
+    if (!blockTag || !value::isNumber(*blockTag) || !value::isNumber(scalarTag)) {
+        return boost::none;
+    }
+
+    auto widest = getWidestNumericalType(*blockTag, scalarTag);
+    if (widest == value::TypeTags::NumberDecimal) {
+        return boost::none;
+    }
+    return widest;
+}
+
+/**
+ * The kernels below run over the raw values of a homogeneous block. They are kept free of any
+ * per-element type dispatch so that the compiler can turn their loops into SIMD code.
+ */
+template <typename BlockT, typename ScalarT, typename Op>
+void compareKernel(const value::Value* vals, size_t count, ScalarT scalar, value::Value* out) {
+    Op op{};
+    for (size_t idx = 0; idx < count; ++idx) {
+        auto elem = static_cast<ScalarT>(value::bitcastTo<BlockT>(vals[idx]));
+        out[idx] = value::bitcastFrom<bool>(op(elem, scalar));
+    }
+}
+
+template <typename Op>
+void doubleArithKernel(const value::Value* vals, size_t count, double scalar, value::Value* out) {
+    Op op{};
+    for (size_t idx = 0; idx < count; ++idx) {
+        out[idx] = value::bitcastFrom<double>(op(value::bitcastTo<double>(vals[idx]), scalar));
+    }
+}
+
+template <typename BlockT, typename Op>
+void compareBlockKernel(const value::ValueBlock& block,
+                        value::TypeTags kernelType,
+                        value::TypeTags scalarTag,
+                        value::Value scalarVal,
+                        value::Value* out) {
+    switch (kernelType) {
+        case value::TypeTags::NumberInt32:
+            compareKernel<BlockT, int32_t, Op>(block.vals(),
+                                               block.count(),
+                                               value::numericCast<int32_t>(scalarTag, scalarVal),
+                                               out);
+            break;
+        case value::TypeTags::NumberInt64:
+            compareKernel<BlockT, int64_t, Op>(block.vals(),
+                                               block.count(),
+                                               value::numericCast<int64_t>(scalarTag, scalarVal),
+                                               out);
+            break;
+        case value::TypeTags::NumberDouble:
+            compareKernel<BlockT, double, Op>(block.vals(),
+                                              block.count(),
+                                              value::numericCast<double>(scalarTag, scalarVal),
+                                              out);
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+/**
+ * Compares every value of 'block' with the scalar using 'Op', producing a block of booleans. The
+ * result of a comparison between values of incomparable types is Nothing, as for the row-at-a-time
+ * comparison instructions.
+ */
+template <typename Op>
+value::ValueBlock compareBlockWithScalar(const value::ValueBlock& block,
+                                         value::TypeTags scalarTag,
+                                         value::Value scalarVal) {
+    const auto count = block.count();
+    const auto blockTag = block.homogeneousTag();
+    if (auto kernelType = getKernelType(blockTag, scalarTag)) {
+        std::vector<value::Value> vals(count);
+        switch (*blockTag) {
+            case value::TypeTags::NumberInt32:
+                compareBlockKernel<int32_t, Op>(
+                    block, *kernelType, scalarTag, scalarVal, vals.data());
+                break;
+            case value::TypeTags::NumberInt64:
+                compareBlockKernel<int64_t, Op>(
+                    block, *kernelType, scalarTag, scalarVal, vals.data());
+                break;
+            case value::TypeTags::NumberDouble:
+                compareBlockKernel<double, Op>(
+                    block, *kernelType, scalarTag, scalarVal, vals.data());
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+        return {std::vector<value::TypeTags>(count, value::TypeTags::Boolean), std::move(vals)};
+    }
+
+    value::ValueBlock result;
+    result.reserve(count);
+    for (size_t idx = 0; idx < count; ++idx) {
+        auto [tag, val] = block.at(idx);
+        auto [resTag, resVal] = genericCompare<Op>(tag, val, scalarTag, scalarVal);
+        result.push_back(resTag, resVal);
+    }
+    return result;
+}
+
+/**
+ * Combines two blocks of booleans of the same size element by element. A non-boolean element on
+ * either side produces Nothing.
+ */
+template <typename Op>
+boost::optional<value::ValueBlock> combineBooleanBlocks(const value::ValueBlock& lhs,
+                                                        const value::ValueBlock& rhs) {
+    if (lhs.count() != rhs.count()) {
+        return boost::none;
+    }
+
+    Op op{};
+    value::ValueBlock result;
+    result.reserve(lhs.count());
+    for (size_t idx = 0; idx < lhs.count(); ++idx) {
+        auto [lhsTag, lhsVal] = lhs.at(idx);
+        auto [rhsTag, rhsVal] = rhs.at(idx);
+        if (lhsTag != value::TypeTags::Boolean || rhsTag != value::TypeTags::Boolean) {
+            result.push_back(value::TypeTags::Nothing, 0);
+        } else {
+            result.push_back(value::TypeTags::Boolean,
+                             value::bitcastFrom<bool>(op(value::bitcastTo<bool>(lhsVal),
+                                                         value::bitcastTo<bool>(rhsVal))));
+        }
+    }
+    return result;
+}
+
+/**
+ * Returns true if the arithmetic of 'block' with a scalar of type 'scalarTag' can run over raw
+ * doubles. Only doubles are handled this way, since integer arithmetic has to detect overflows.
+ */
+bool isDoubleKernelApplicable(const value::ValueBlock& block, value::TypeTags scalarTag) {
+    auto blockTag = block.homogeneousTag();
+    return blockTag == value::TypeTags::NumberDouble &&
+        getKernelType(blockTag, scalarTag) == value::TypeTags::NumberDouble;
+}
+
+std::tuple<bool, value::TypeTags, value::Value> makeBlockResult(value::ValueBlock block) {
+    return {true,
+            value::TypeTags::valueBlock,
+            value::bitcastFrom<value::ValueBlock*>(new value::ValueBlock(std::move(block)))};
+}
+}  // namespace
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockGtScalar(
+    ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    return makeBlockResult(compareBlockWithScalar<std::greater<>>(
+        *value::getValueBlockView(blockVal), scalarTag, scalarVal));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockGteScalar(
+    ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    return makeBlockResult(compareBlockWithScalar<std::greater_equal<>>(
+        *value::getValueBlockView(blockVal), scalarTag, scalarVal));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockLtScalar(
+    ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    return makeBlockResult(compareBlockWithScalar<std::less<>>(
+        *value::getValueBlockView(blockVal), scalarTag, scalarVal));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockLteScalar(
+    ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    return makeBlockResult(compareBlockWithScalar<std::less_equal<>>(
+        *value::getValueBlockView(blockVal), scalarTag, scalarVal));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockEqScalar(
+    ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    return makeBlockResult(compareBlockWithScalar<std::equal_to<>>(
+        *value::getValueBlockView(blockVal), scalarTag, scalarVal));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockLogicalAnd(
+    ArityType arity) {
+    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+    auto [rhsOwned, rhsTag, rhsVal] = getFromStack(1);
+    if (lhsTag != value::TypeTags::valueBlock || rhsTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    auto result = combineBooleanBlocks<std::logical_and<>>(*value::getValueBlockView(lhsVal),
+                                                           *value::getValueBlockView(rhsVal));
+    if (!result) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+    return makeBlockResult(std::move(*result));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockLogicalOr(
+    ArityType arity) {
+    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+    auto [rhsOwned, rhsTag, rhsVal] = getFromStack(1);
+    if (lhsTag != value::TypeTags::valueBlock || rhsTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    auto result = combineBooleanBlocks<std::logical_or<>>(*value::getValueBlockView(lhsVal),
+                                                          *value::getValueBlockView(rhsVal));
+    if (!result) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+    return makeBlockResult(std::move(*result));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockAdd(ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    const auto& block = *value::getValueBlockView(blockVal);
+    if (isDoubleKernelApplicable(block, scalarTag)) {
+        std::vector<value::Value> vals(block.count());
+        doubleArithKernel<std::plus<>>(block.vals(),
+                                       block.count(),
+                                       value::numericCast<double>(scalarTag, scalarVal),
+                                       vals.data());
+        return makeBlockResult(
+            {std::vector<value::TypeTags>(block.count(), value::TypeTags::NumberDouble),
+             std::move(vals)});
+    }
+
+    value::ValueBlock result;
+    result.reserve(block.count());
+    for (size_t idx = 0; idx < block.count(); ++idx) {
+        auto [tag, val] = block.at(idx);
+        auto [owned, resTag, resVal] = genericAdd(tag, val, scalarTag, scalarVal);
+        result.push_back(resTag, resVal);
+    }
+    return makeBlockResult(std::move(result));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockSub(ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    const auto& block = *value::getValueBlockView(blockVal);
+    if (isDoubleKernelApplicable(block, scalarTag)) {
+        std::vector<value::Value> vals(block.count());
+        doubleArithKernel<std::minus<>>(block.vals(),
+                                        block.count(),
+                                        value::numericCast<double>(scalarTag, scalarVal),
+                                        vals.data());
+        return makeBlockResult(
+            {std::vector<value::TypeTags>(block.count(), value::TypeTags::NumberDouble),
+             std::move(vals)});
+    }
+
+    value::ValueBlock result;
+    result.reserve(block.count());
+    for (size_t idx = 0; idx < block.count(); ++idx) {
+        auto [tag, val] = block.at(idx);
+        auto [owned, resTag, resVal] = genericSub(tag, val, scalarTag, scalarVal);
+        result.push_back(resTag, resVal);
+    }
+    return makeBlockResult(std::move(result));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockMul(ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    const auto& block = *value::getValueBlockView(blockVal);
+    if (isDoubleKernelApplicable(block, scalarTag)) {
+        std::vector<value::Value> vals(block.count());
+        doubleArithKernel<std::multiplies<>>(block.vals(),
+                                             block.count(),
+                                             value::numericCast<double>(scalarTag, scalarVal),
+                                             vals.data());
+        return makeBlockResult(
+            {std::vector<value::TypeTags>(block.count(), value::TypeTags::NumberDouble),
+             std::move(vals)});
+    }
+
+    value::ValueBlock result;
+    result.reserve(block.count());
+    for (size_t idx = 0; idx < block.count(); ++idx) {
+        auto [tag, val] = block.at(idx);
+        auto [owned, resTag, resVal] = genericMul(tag, val, scalarTag, scalarVal);
+        result.push_back(resTag, resVal);
+    }
+    return makeBlockResult(std::move(result));
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockFillEmpty(
+    ArityType arity) {
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [fillOwned, fillTag, fillVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    const auto& block = *value::getValueBlockView(blockVal);
+    value::ValueBlock result;
+    result.reserve(block.count());
+    for (size_t idx = 0; idx < block.count(); ++idx) {
+        auto [tag, val] = block.at(idx);
+        auto [resTag, resVal] = value::copyValue(tag == value::TypeTags::Nothing ? fillTag : tag,
+                                                 tag == value::TypeTags::Nothing ? fillVal : val);
+        result.push_back(resTag, resVal);
+    }
+    return makeBlockResult(std::move(result));
+}
+}  // namespace vm
+}  // namespace sbe
+}  // namespace mongo
@@ -54,10 +54,12 @@ std::string nextFileName() {
 
 #include "mongo/db/sorter/sorter.cpp"
 
-MONGO_CREATE_SORTER(mongo::Value,
+MONGO_CREATE_SORTER(mongo::KeyString::Value,
                     mongo::Document,
                     mongo::SortExecutor<mongo::Document>::Comparator);
-MONGO_CREATE_SORTER(mongo::Value,
+MONGO_CREATE_SORTER(mongo::KeyString::Value,
                     mongo::SortableWorkingSetMember,
                     mongo::SortExecutor<mongo::SortableWorkingSetMember>::Comparator);
-MONGO_CREATE_SORTER(mongo::Value, mongo::BSONObj, mongo::SortExecutor<mongo::BSONObj>::Comparator);
+MONGO_CREATE_SORTER(mongo::KeyString::Value,
+                    mongo::BSONObj,
+                    mongo::SortExecutor<mongo::BSONObj>::Comparator);
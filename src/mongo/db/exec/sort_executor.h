@@ -31,7 +31,7 @@
 
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/plan_stats.h"
-#include "mongo/db/exec/sort_key_comparator.h"
+#include "mongo/db/exec/sort_key_encoder.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/query/sort_pattern.h"
@@ -47,21 +47,27 @@ namespace mongo {
  * The template parameter is the type of data being sorted. In DocumentSource execution, we sort
  * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. The type of
  * the sort key, on the other hand, is always Value.
+ *
+ * Each sort key is encoded once, when it is added, into a KeyString which orders like the sort key
+ * under the sort pattern. Sorting, merging spilled runs and applying the limit then only compare
+ * the KeyStrings with memcmp(), and the sort keys spilled to disk are the compact KeyStrings. The
+ * sort keys are decoded back into Values as they are returned. The rare sort pattern which changes
+ * direction too often for a KeyString is still sorted by comparing the decoded sort keys.
  */
 template <typename T>
 class SortExecutor {
 public:
-    using DocumentSorter = Sorter<Value, T>;
+    using DocumentSorter = Sorter<KeyString::Value, T>;
     class Comparator {
     public:
-        Comparator(const SortPattern& sortPattern) : _sortKeyComparator(sortPattern) {}
+        Comparator(const SortKeyEncoder& sortKeyEncoder) : _sortKeyEncoder(sortKeyEncoder) {}
         int operator()(const typename DocumentSorter::Data& lhs,
                        const typename DocumentSorter::Data& rhs) const {
-            return _sortKeyComparator(lhs.first, rhs.first);
+            return _sortKeyEncoder.compare(lhs.first, rhs.first);
         }
 
     private:
-        SortKeyComparator _sortKeyComparator;
+        SortKeyEncoder _sortKeyEncoder;
     };
 
     /**
@@ -73,6 +79,7 @@ public:
                  std::string tempDir,
                  bool allowDiskUse)
         : _sortPattern(std::move(sortPattern)),
+          _sortKeyEncoder(makeSortKeyEncoder(_sortPattern)),
           _tempDir(std::move(tempDir)),
           _diskUseAllowed(allowDiskUse) {
         _stats.sortPattern =
@@ -124,9 +131,9 @@ public:
      */
     void add(const Value& sortKey, const T& data) {
         if (!_sorter) {
-            _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+            _sorter.reset(makeSorter());
         }
-        _sorter->add(sortKey, data);
+        _sorter->add(encodeSortKey(sortKey), data);
     }
 
     /**
@@ -135,11 +142,12 @@ public:
     void loadingDone() {
         // This conditional should only pass if no documents were added to the sorter.
         if (!_sorter) {
-            _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+            _sorter.reset(makeSorter());
         }
         _output.reset(_sorter->done());
         _stats.keysSorted += _sorter->numSorted();
         _stats.spills += _sorter->numSpills();
+        _stats.spilledDataStorageSize += _sorter->spillStats().spilledDataBytes;
         _stats.totalDataSizeBytes += _sorter->totalDataSizeSorted();
         _sorter.reset();
     }
@@ -168,10 +176,63 @@ public:
      * end-of-stream must be detected with 'hasNext()'.
      */
     std::pair<Value, T> getNext() {
-        return _output->next();
+        auto next = _output->next();
+        return {decodeSortKey(next.first), std::move(next.second)};
+    }
+
+    /**
+     * Like 'getNext()', but returns only the item being sorted, without decoding its sort key.
+     */
+    T getNextWithoutSortKey() {
+        return _output->next().second;
     }
 
 private:
+    static SortKeyEncoder makeSortKeyEncoder(const SortPattern& sortPattern) {
+        std::vector<bool> isAscending;
+        isAscending.reserve(sortPattern.size());
+        for (auto&& part : sortPattern) {
+            isAscending.push_back(part.isAscending);
+        }
+        return SortKeyEncoder(isAscending);
+    }
+
+    /**
+     * A sort key is a single Value for a sort pattern with one component, and an array with one
+     * Value per component otherwise.
+     */
+    KeyString::Value encodeSortKey(const Value& sortKey) const {
+        BSONObjBuilder components;
+        if (_sortKeyEncoder.numComponents() == 1) {
+            sortKey.addToBsonObj(&components, ""_sd);
+        } else {
+            for (auto&& component : sortKey.getArray()) {
+                component.addToBsonObj(&components, ""_sd);
+            }
+        }
+        return _sortKeyEncoder.encode(components.done());
+    }
+
+    Value decodeSortKey(const KeyString::Value& key) const {
+        auto components = _sortKeyEncoder.decode(key);
+        if (_sortKeyEncoder.numComponents() == 1) {
+            return Value(components.firstElement());
+        }
+
+        std::vector<Value> values;
+        values.reserve(_sortKeyEncoder.numComponents());
+        for (auto&& component : components) {
+            values.emplace_back(component);
+        }
+        return Value(std::move(values));
+    }
+
+    DocumentSorter* makeSorter() const {
+        return DocumentSorter::make(makeSortOptions(),
+                                    Comparator(_sortKeyEncoder),
+                                    {KeyString::Version::kLatestVersion, {}});
+    }
+
     SortOptions makeSortOptions() const {
         SortOptions opts;
         if (_stats.limit) {
@@ -188,6 +249,7 @@ private:
     }
 
     const SortPattern _sortPattern;
+    const SortKeyEncoder _sortKeyEncoder;
     const std::string _tempDir;
     const bool _diskUseAllowed;
 
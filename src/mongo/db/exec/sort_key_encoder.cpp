@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sort_key_encoder.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+Ordering makeOrdering(const std::vector<bool>& isAscending,
+                      std::vector<size_t>* runEnds,
+                      BSONObj* comparisonPattern) {
+    BSONObjBuilder directions;
+    if (isAscending.size() <= Ordering::kMaxCompoundIndexKeys) {
+        for (bool ascending : isAscending) {
+            directions.append(""_sd, ascending ? 1 : -1);
+        }
+        return Ordering::make(directions.done());
+    }
+
+    for (size_t idx = 0; idx < isAscending.size(); ++idx) {
+        if (idx + 1 == isAscending.size() || isAscending[idx + 1] != isAscending[idx]) {
+            runEnds->push_back(idx + 1);
+            directions.append(""_sd, isAscending[idx] ? 1 : -1);
+        }
+    }
+    if (runEnds->size() <= Ordering::kMaxCompoundIndexKeys) {
+        return Ordering::make(directions.done());
+    }
+
+    // The directions cannot be folded into the KeyStrings. Encode every component in ascending
+    // order, and compare the decoded components value by value instead.
+    runEnds->clear();
+    BSONObjBuilder pattern;
+    for (bool ascending : isAscending) {
+        pattern.append(""_sd, ascending ? 1 : -1);
+    }
+    *comparisonPattern = pattern.obj();
+    return Ordering::allAscending();
+}
+
+}  // namespace
+
+SortKeyEncoder::SortKeyEncoder(const std::vector<bool>& isAscending)
+    : _numComponents(isAscending.size()),
+      _ordering(makeOrdering(isAscending, &_runEnds, &_comparisonPattern)) {}
+
+KeyString::Value SortKeyEncoder::encode(const BSONObj& components) const {
+    KeyString::HeapBuilder builder(KeyString::Version::kLatestVersion, _ordering);
+    BSONObjIterator it(components);
+    auto appendComponent = [&](auto&& append) {
+        if (it.more()) {
+            append(it.next());
+        } else {
+            BSONObjBuilder nullBuilder;
+            nullBuilder.appendNull(""_sd);
+            append(nullBuilder.done().firstElement());
+        }
+    };
+
+    if (_runEnds.empty()) {
+        for (size_t idx = 0; idx < _numComponents; ++idx) {
+            appendComponent([&](const BSONElement& elem) { builder.appendBSONElement(elem); });
+        }
+        return builder.release();
+    }
+
+    size_t idx = 0;
+    for (auto runEnd : _runEnds) {
+        BSONObjBuilder runBuilder;
+        {
+            BSONArrayBuilder run(runBuilder.subarrayStart(""_sd));
+            for (; idx < runEnd; ++idx) {
+                appendComponent([&](const BSONElement& elem) { run.append(elem); });
+            }
+        }
+        builder.appendBSONElement(runBuilder.done().firstElement());
+    }
+    return builder.release();
+}
+
+int SortKeyEncoder::compare(const KeyString::Value& lhs, const KeyString::Value& rhs) const {
+    if (_comparisonPattern.isEmpty()) {
+        return lhs.compare(rhs);
+    }
+    return decode(lhs).woCompare(decode(rhs), _comparisonPattern, false /* considerFieldName */);
+}
+
+BSONObj SortKeyEncoder::decode(const KeyString::Value& key) const {
+    auto decoded = KeyString::toBson(key, _ordering);
+    if (_runEnds.empty()) {
+        return decoded;
+    }
+
+    BSONObjBuilder components;
+    for (auto&& run : decoded) {
+        for (auto&& component : run.Obj()) {
+            components.appendAs(component, ""_sd);
+        }
+    }
+    return components.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+/**
+ * Encodes sort keys into KeyStrings whose binary order is the order of the sort keys, so that a
+ * sort can compare, merge and spill them as plain byte strings. The direction of each component of
+ * the sort keys is folded into the encoding. Like the sort keys themselves, the components are
+ * expected to be collation comparison keys already, as KeyStrings compare strings binarily.
+ *
+ * A sort pattern can change direction too many times to be folded into a KeyString. The
+ * KeyStrings must therefore be compared with compare(), which falls back to decoding them and
+ * comparing their components value by value for such patterns.
+ *
+ * The components of a sort key are passed in and returned as the elements of a BSONObj, in the
+ * order of the sort pattern.
+ */
+class SortKeyEncoder {
+public:
+    /**
+     * 'isAscending' holds the direction of each component of the sort keys.
+     */
+    explicit SortKeyEncoder(const std::vector<bool>& isAscending);
+
+    /**
+     * Encodes the components of a sort key, one element per component. Missing trailing components
+     * are encoded as null.
+     */
+    KeyString::Value encode(const BSONObj& components) const;
+
+    /**
+     * Compares two encoded sort keys. Returns <0, 0 or >0 if 'lhs' sorts before, like or after
+     * 'rhs' respectively.
+     */
+    int compare(const KeyString::Value& lhs, const KeyString::Value& rhs) const;
+
+    /**
+     * Returns the components of the sort key that 'key' was encoded from, one element per
+     * component, with empty field names.
+     */
+    BSONObj decode(const KeyString::Value& key) const;
+
+    size_t numComponents() const {
+        return _numComponents;
+    }
+
+private:
+    const size_t _numComponents;
+
+    // KeyString can only invert the first Ordering::kMaxCompoundIndexKeys elements of a key. For
+    // sort patterns with more components than that, each run of consecutive components with the
+    // same direction is encoded as a single array element, and this holds the end of each run.
+    // Empty if each component is encoded as its own element.
+    std::vector<size_t> _runEnds;
+
+    // Holds the direction of each component when even the runs of components have too many
+    // changes of direction for KeyString. The components are then all encoded in ascending order,
+    // and compare() compares the decoded components using this pattern. Empty otherwise.
+    BSONObj _comparisonPattern;
+
+    Ordering _ordering;
+};
+
+}  // namespace mongo
@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sort_key_encoder.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+int compareEncoded(const SortKeyEncoder& encoder, const BSONObj& lhs, const BSONObj& rhs) {
+    auto result = encoder.compare(encoder.encode(lhs), encoder.encode(rhs));
+    return result < 0 ? -1 : (result > 0 ? 1 : 0);
+}
+
+TEST(SortKeyEncoderTest, OrdersLikeBSONWithDirections) {
+    SortKeyEncoder encoder({true, false});
+    const auto pattern = BSON("a" << 1 << "b" << -1);
+    const std::vector<BSONObj> keys = {
+        BSON("" << 1 << "" << 2),
+        BSON("" << 1.5 << "" << "x"),
+        BSON("" << 1LL << "" << BSONNULL),
+        BSON("" << "abc"
+                << "" << BSON_ARRAY(1 << 2)),
+        BSON("" << BSONNULL << "" << MINKEY),
+        BSON("" << MAXKEY << "" << BSON("c" << 1)),
+        BSON("" << Decimal128("1.00") << "" << 3),
+    };
+
+    for (auto&& lhs : keys) {
+        for (auto&& rhs : keys) {
+            int expected = lhs.woCompare(rhs, pattern, false);
+            expected = expected < 0 ? -1 : (expected > 0 ? 1 : 0);
+            ASSERT_EQ(compareEncoded(encoder, lhs, rhs), expected) << lhs << " " << rhs;
+        }
+    }
+}
+
+TEST(SortKeyEncoderTest, DecodeReturnsComponents) {
+    SortKeyEncoder encoder({false, true, false});
+    const auto key = BSON("" << 1 << "" << 2.5 << ""
+                             << BSON("a" << BSON_ARRAY("x" << BSONNULL)));
+    ASSERT_BSONOBJ_BINARY_EQ(encoder.decode(encoder.encode(key)), key);
+}
+
+TEST(SortKeyEncoderTest, MissingComponentsAreNull) {
+    SortKeyEncoder encoder({true, true});
+    ASSERT_EQ(
+        encoder.encode(BSON("" << 1)).compare(encoder.encode(BSON("" << 1 << "" << BSONNULL))), 0);
+}
+
+TEST(SortKeyEncoderTest, MoreComponentsThanOrderingSupports) {
+    const size_t numComponents = Ordering::kMaxCompoundIndexKeys + 8;
+    std::vector<bool> isAscending(numComponents, true);
+    isAscending.back() = false;
+    SortKeyEncoder encoder(isAscending);
+
+    BSONObjBuilder lhsBuilder;
+    BSONObjBuilder rhsBuilder;
+    for (size_t idx = 0; idx + 1 < numComponents; ++idx) {
+        lhsBuilder.append("", static_cast<int>(idx));
+        rhsBuilder.append("", static_cast<int>(idx));
+    }
+    lhsBuilder.append("", 1);
+    rhsBuilder.append("", 2);
+    const auto lhs = lhsBuilder.obj();
+    const auto rhs = rhsBuilder.obj();
+
+    // The last component is descending.
+    ASSERT_GT(encoder.compare(encoder.encode(lhs), encoder.encode(rhs)), 0);
+    ASSERT_BSONOBJ_BINARY_EQ(encoder.decode(encoder.encode(lhs)), lhs);
+}
+
+TEST(SortKeyEncoderTest, TooManyChangesOfDirectionComparesValues) {
+    const size_t numComponents = Ordering::kMaxCompoundIndexKeys + 2;
+    std::vector<bool> isAscending;
+    BSONObjBuilder patternBuilder;
+    for (size_t idx = 0; idx < numComponents; ++idx) {
+        isAscending.push_back(idx % 2 == 0);
+        patternBuilder.append("", idx % 2 == 0 ? 1 : -1);
+    }
+    SortKeyEncoder encoder(isAscending);
+    const auto pattern = patternBuilder.obj();
+
+    // Keys which differ in one ascending and in one descending component past the ones that
+    // KeyString could invert.
+    std::vector<BSONObj> keys;
+    for (int last : {1, 2}) {
+        for (int secondToLast : {1, 2}) {
+            BSONObjBuilder key;
+            for (size_t idx = 0; idx + 2 < numComponents; ++idx) {
+                key.append("", static_cast<int>(idx));
+            }
+            key.append("", secondToLast);
+            key.append("", last);
+            keys.push_back(key.obj());
+        }
+    }
+
+    // The second to last component is ascending, and the last one descending.
+    ASSERT_EQ(compareEncoded(encoder, keys[0], keys[1]), -1);
+    ASSERT_EQ(compareEncoded(encoder, keys[0], keys[2]), 1);
+
+    for (auto&& lhs : keys) {
+        for (auto&& rhs : keys) {
+            int expected = lhs.woCompare(rhs, pattern, false);
+            expected = expected < 0 ? -1 : (expected > 0 ? 1 : 0);
+            ASSERT_EQ(compareEncoded(encoder, lhs, rhs), expected) << lhs << " " << rhs;
+        }
+        ASSERT_BSONOBJ_BINARY_EQ(encoder.decode(encoder.encode(lhs)), lhs);
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+
+#include "mongo/db/record_id.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+class CollectionPtr;
+
+/**
+ * Keeps track of the position of the forward collection scans over a collection which agreed to
+ * be synchronized with each other, so that a new scan can start where the others currently are
+ * and share the working set they are pulling into the storage engine cache, rather than starting
+ * from the beginning and evicting it. A scan which started in the middle wraps around to the
+ * beginning of the collection when it reaches the end, and stops just before its first record.
+ *
+ * All Collection instances for the same collection share the same instance of this class.
+ */
+class SynchronizedCollectionScans {
+public:
+    /**
+     * Registered scans report their position once per this many records.
+     */
+    static constexpr int kReportInterval = 128;
+
+    /**
+     * Keeps a scan registered for as long as it is alive.
+     */
+    class Registration {
+    public:
+        Registration(std::shared_ptr<SynchronizedCollectionScans> scans);
+        Registration(Registration&&) = default;
+        ~Registration();
+
+        /**
+         * The position reported most recently by the other scans when this one was registered,
+         * or boost::none if this scan should start at the beginning of the collection.
+         */
+        const boost::optional<RecordId>& startPosition() const {
+            return _startPosition;
+        }
+
+        void reportPosition(const RecordId& id);
+
+    private:
+        std::shared_ptr<SynchronizedCollectionScans> _scans;
+        boost::optional<RecordId> _startPosition;
+    };
+
+    /**
+     * Returns the instance for 'collection', or nullptr if it does not have one.
+     */
+    static std::shared_ptr<SynchronizedCollectionScans> get(const CollectionPtr& collection);
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("SynchronizedCollectionScans::_mutex");
+
+    // Number of registered scans and the most recent position reported by any of them. The
+    // position is cleared once the last scan unregisters, so that a scan which doesn't have any
+    // company starts at the beginning of the collection.
+    int _numScans{0};
+    boost::optional<RecordId> _position;
+};
+
+}  // namespace mongo
@@ -61,8 +61,7 @@ TextOrStage::TextOrStage(ExpressionContext* expCtx,
       _keyPrefixSize(keyPrefixSize),
       _ws(ws),
       _scoreIterator(_scores.end()),
-      _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {}
+      _filter(filter) {}
 
 void TextOrStage::addChild(unique_ptr<PlanStage> child) {
     _children.push_back(std::move(child));
@@ -170,19 +169,11 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
     invariant(_currentChild < _children.size());
 
-    // Either retry the last WSM we worked on or get a new one from our current child.
-    WorkingSetID id;
-    StageState childState;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        childState = _children[_currentChild]->work(&id);
-    } else {
-        childState = ADVANCED;
-        id = _idRetrying;
-        _idRetrying = WorkingSet::INVALID_ID;
-    }
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    StageState childState = _children[_currentChild]->work(&id);
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        return addTerm(id);
     } else if (PlanStage::IS_EOF == childState) {
         // Done with this child.
         ++_currentChild;
@@ -211,15 +202,35 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     }
 
     // Retrieve the record that contains the text score.
-    TextRecordData textRecordData = _scoreIterator->second;
-    ++_scoreIterator;
+    const TextRecordData textRecordData = _scoreIterator->second;
 
     // Ignore non-matched documents.
     if (textRecordData.score < 0) {
         invariant(textRecordData.wsid == WorkingSet::INVALID_ID);
+        ++_scoreIterator;
         return PlanStage::NEED_TIME;
     }
 
+    // Our parent expects RID_AND_OBJ members, so we fetch the document now that its score is
+    // final. On a write conflict we stay on this record and fetch it again after the yield.
+    try {
+        if (!WorkingSetCommon::fetch(opCtx(),
+                                     _ws,
+                                     textRecordData.wsid,
+                                     _recordCursor.get(),
+                                     collection(),
+                                     collection()->ns())) {
+            _ws->free(textRecordData.wsid);
+            ++_scoreIterator;
+            return PlanStage::NEED_TIME;
+        }
+        ++_specificStats.fetches;
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+    ++_scoreIterator;
+
     WorkingSetMember* wsm = _ws->get(textRecordData.wsid);
 
     // Populate the working set member with the text score metadata and return it.
@@ -228,7 +239,7 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
-PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out) {
+PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid) {
     WorkingSetMember* wsm = _ws->get(wsid);
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
     invariant(1 == wsm->keyData.size());
@@ -252,27 +263,9 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
             return NEED_TIME;
         }
 
-        // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
-        // already.
-        try {
-            if (!WorkingSetCommon::fetch(
-                    opCtx(), _ws, wsid, _recordCursor.get(), collection(), collection()->ns())) {
-                _ws->free(wsid);
-                textRecordData->score = -1;
-                return NEED_TIME;
-            }
-            ++_specificStats.fetches;
-        } catch (const WriteConflictException&) {
-            wsm->makeObjOwnedIfNeeded();
-            _idRetrying = wsid;
-            *out = WorkingSet::INVALID_ID;
-            return NEED_YIELD;
-        }
-
+        // Keep the member, with its index key, until we return the document. The document is
+        // fetched then, so that this stage does not buffer fetched documents.
         textRecordData->wsid = wsid;
-
-        // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
-        wsm->makeObjOwnedIfNeeded();
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
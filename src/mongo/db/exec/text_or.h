@@ -46,7 +46,9 @@ class OperationContext;
  * A blocking stage that returns the set of WSMs with RecordIDs of all of the documents that contain
  * the positive terms in the search query, as well as their scores.
  *
- * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
+ * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state. Documents are fetched
+ * only once all of the terms have been scored, as their results are returned, so that the stage
+ * buffers an index key rather than a whole document for each candidate.
  */
 class TextOrStage final : public RequiresCollectionStage {
 public:
@@ -116,10 +118,11 @@ private:
      * Helper called from readFromChildren to update aggregate score with a newfound (term, score)
      * pair for this document.
      */
-    StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
+    StageState addTerm(WorkingSetID wsid);
 
     /**
-     * Worker for kReturningResults. Returns a wsm with RecordID and Score.
+     * Worker for kReturningResults. Fetches the next scored document and returns a wsm with its
+     * RecordID, document and score.
      */
     StageState returnResults(WorkingSetID* out);
 
@@ -154,7 +157,6 @@ private:
 
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
-    WorkingSetID _idRetrying;
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 };
 }  // namespace mongo
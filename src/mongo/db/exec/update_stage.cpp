@@ -46,6 +46,7 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/resharding_util.h"
@@ -130,7 +131,12 @@ UpdateStage::UpdateStage(ExpressionContext* expCtx,
       _doc(params.driver->getDocument()),
       _idRetrying(WorkingSet::INVALID_ID),
       _idReturning(WorkingSet::INVALID_ID),
-      _updatedRecordIds(params.request->isMulti() ? new RecordIdSet() : nullptr) {
+      _updatedRecordIds(params.request->isMulti() ? new RecordIdSet() : nullptr),
+      _writeBatchSize(params.request->isMulti() && !params.request->shouldReturnAnyDocs() &&
+                              !params.request->explain() &&
+                              !expCtx->opCtx->inMultiDocumentTransaction()
+                          ? std::max(1, internalQueryUpdateManyWriteBatchSize.load())
+                          : 1) {
 
     // Should the modifiers validate their embedded docs via storage_validation::storageValid()?
     // Only user updates should be checked. Any system or replication stuff should pass through.
@@ -151,17 +157,6 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
     // If asked to return new doc, default to the oldObj, in case nothing changes.
     BSONObj newObj = oldObj.value();
 
-    // Ask the driver to apply the mods. It may be that the driver can apply those "in
-    // place", that is, some values of the old document just get adjusted without any
-    // change to the binary layout on the bson layer. It may be that a whole new document
-    // is needed to accomodate the new bson layout of the resulting document. In any event,
-    // only enable in-place mutations if the underlying storage engine offers support for
-    // writing damage events.
-    _doc.reset(oldObj.value(),
-               (collection()->updateWithDamagesSupported()
-                    ? mutablebson::Document::kInPlaceEnabled
-                    : mutablebson::Document::kInPlaceDisabled));
-
     BSONObj logObj;
 
     bool docWasModified = false;
@@ -170,6 +165,14 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
     const bool isInsert = false;
     FieldRefSet immutablePaths;
 
+    // Updates which only overwrite fixed-width values can skip the mutable document altogether,
+    // when the storage engine can write damage events. The checks of shard key changes need the
+    // mutable document, and documents without _id first are rewritten with it first, so both
+    // always go through it.
+    bool mayUpdateInPlaceFromBSON = collection()->updateWithDamagesSupported() &&
+        !driver->needMatchDetails() &&
+        oldObj.value().firstElementFieldNameStringData() == idFieldName;
+
     if (_isUserInitiatedWrite) {
         // Documents coming directly from users should be validated for storage. It is safe to
         // access the CollectionShardingState in this write context and to throw SSV if the sharding
@@ -180,53 +183,80 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
             immutablePaths.fillFrom(collDesc.getKeyPatternFields());
         }
         immutablePaths.keepShortest(&idFieldRef);
-    }
-    if (!driver->needMatchDetails()) {
-        // If we don't need match details, avoid doing the rematch
-        status = driver->update(opCtx(),
-                                StringData(),
-                                &_doc,
-                                _isUserInitiatedWrite,
-                                immutablePaths,
-                                isInsert,
-                                &logObj,
-                                &docWasModified);
-    } else {
-        // If there was a matched field, obtain it.
-        MatchDetails matchDetails;
-        matchDetails.requestElemMatchKey();
-
-        dassert(cq);
-        verify(cq->root()->matchesBSON(oldObj.value(), &matchDetails));
-
-        string matchedField;
-        if (matchDetails.hasElemMatchKey())
-            matchedField = matchDetails.elemMatchKey();
-
-        status = driver->update(opCtx(),
-                                matchedField,
-                                &_doc,
-                                _isUserInitiatedWrite,
-                                immutablePaths,
-                                isInsert,
-                                &logObj,
-                                &docWasModified);
+        mayUpdateInPlaceFromBSON = mayUpdateInPlaceFromBSON && !collDesc.isSharded();
     }
 
-    if (!status.isOK()) {
-        uasserted(16837, status.reason());
+    // The damage source of the fast path, which must outlive the write of the damages.
+    boost::optional<FixedWidthUpdate::Result> fixedWidthUpdate;
+    if (mayUpdateInPlaceFromBSON) {
+        fixedWidthUpdate = driver->updateInPlace(oldObj.value(), immutablePaths);
     }
 
-    // Skip adding _id field if the collection is capped (since capped collection documents can
-    // neither grow nor shrink).
-    const auto createIdField = !collection()->isCapped();
+    const char* source = nullptr;
+    bool inPlace = true;
+    if (fixedWidthUpdate) {
+        docWasModified = !fixedWidthUpdate->noop;
+        logObj = fixedWidthUpdate->oplogEntry;
+        _damages = std::move(fixedWidthUpdate->damages);
+        source = fixedWidthUpdate->newValues.objdata();
+    } else {
+        // Ask the driver to apply the mods. It may be that the driver can apply those "in
+        // place", that is, some values of the old document just get adjusted without any
+        // change to the binary layout on the bson layer. It may be that a whole new document
+        // is needed to accomodate the new bson layout of the resulting document. In any event,
+        // only enable in-place mutations if the underlying storage engine offers support for
+        // writing damage events.
+        _doc.reset(oldObj.value(),
+                   (collection()->updateWithDamagesSupported()
+                        ? mutablebson::Document::kInPlaceEnabled
+                        : mutablebson::Document::kInPlaceDisabled));
+
+        if (!driver->needMatchDetails()) {
+            // If we don't need match details, avoid doing the rematch
+            status = driver->update(opCtx(),
+                                    StringData(),
+                                    &_doc,
+                                    _isUserInitiatedWrite,
+                                    immutablePaths,
+                                    isInsert,
+                                    &logObj,
+                                    &docWasModified);
+        } else {
+            // If there was a matched field, obtain it.
+            MatchDetails matchDetails;
+            matchDetails.requestElemMatchKey();
+
+            dassert(cq);
+            verify(cq->root()->matchesBSON(oldObj.value(), &matchDetails));
+
+            string matchedField;
+            if (matchDetails.hasElemMatchKey())
+                matchedField = matchDetails.elemMatchKey();
+
+            status = driver->update(opCtx(),
+                                    matchedField,
+                                    &_doc,
+                                    _isUserInitiatedWrite,
+                                    immutablePaths,
+                                    isInsert,
+                                    &logObj,
+                                    &docWasModified);
+        }
+
+        if (!status.isOK()) {
+            uasserted(16837, status.reason());
+        }
 
-    // Ensure _id is first if it exists, and generate a new OID if appropriate.
-    _ensureIdFieldIsFirst(&_doc, createIdField);
+        // Skip adding _id field if the collection is capped (since capped collection documents
+        // can neither grow nor shrink).
+        const auto createIdField = !collection()->isCapped();
 
-    // See if the changes were applied in place
-    const char* source = nullptr;
-    const bool inPlace = _doc.getInPlaceUpdates(&_damages, &source);
+        // Ensure _id is first if it exists, and generate a new OID if appropriate.
+        _ensureIdFieldIsFirst(&_doc, createIdField);
+
+        // See if the changes were applied in place
+        inPlace = _doc.getInPlaceUpdates(&_damages, &source);
+    }
 
     if (inPlace && _damages.empty()) {
         // An interesting edge case. A modifier didn't notice that it was really a no-op
@@ -329,9 +359,12 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // it again.  For an example, see the comment above near declaration of
         // updatedRecordIds.
         //
-        // This must be done after the wunit commits so we are sure we won't be rolling back.
+        // This must be done after the wunit commits so we are sure we won't be rolling back,
+        // unless the wunit is part of a batch, which keeps track of what to take back out.
         if (_updatedRecordIds && (newRecordId != recordId || driver->modsAffectIndices())) {
-            _updatedRecordIds->insert(newRecordId);
+            if (_updatedRecordIds->insert(newRecordId).second && _writeBatchSize > 1) {
+                _recordIdsUpdatedInBatch.push_back(newRecordId);
+            }
         }
     }
 
@@ -363,6 +396,7 @@ bool UpdateStage::isEOF() {
     // We're done updating if either the child has no more results to give us, or we've
     // already gotten a result back and we're not a multi-update.
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
+        _batchIdsRetrying.empty() &&
         (child()->isEOF() || (_specificStats.nMatched > 0 && !_params.request->isMulti()));
 }
 
@@ -371,6 +405,10 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_writeBatchSize > 1) {
+        return doBatchedWork(out);
+    }
+
     // It is possible that after an update was applied, a WriteConflictException
     // occurred and prevented us from returning ADVANCED with the requested version
     // of the document.
@@ -525,6 +563,87 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState UpdateStage::doBatchedWork(WorkingSetID* out) {
+    // The members of the documents this batch updated, which are freed once it commits.
+    std::vector<WorkingSetID> batch;
+    batch.reserve(_writeBatchSize);
+    WorkingSetID current = WorkingSet::INVALID_ID;
+    const UpdateStats statsBeforeBatch = _specificStats;
+    _recordIdsUpdatedInBatch.clear();
+
+    StageState status = NEED_TIME;
+    try {
+        WriteUnitOfWork wunit(opCtx());
+
+        // A batch does no more of our child's work than it has room for documents, so that the
+        // caller still gets to yield about as often as without batching.
+        for (size_t works = 0; works < _writeBatchSize; ++works) {
+            WorkingSetID id;
+            if (!_batchIdsRetrying.empty()) {
+                id = _batchIdsRetrying.front();
+                _batchIdsRetrying.pop_front();
+                status = ADVANCED;
+            } else {
+                status = child()->work(&id);
+            }
+
+            if (status == NEED_TIME) {
+                continue;
+            }
+            if (status != ADVANCED) {
+                if (status == NEED_YIELD) {
+                    *out = id;
+                }
+                break;
+            }
+
+            current = id;
+            WorkingSetMember* member = _ws->get(id);
+            invariant(member->hasRecordId());
+            invariant(member->hasObj());
+            RecordId recordId = member->recordId;
+
+            if (_updatedRecordIds->count(recordId) > 0 ||
+                !write_stage_common::ensureStillMatches(
+                    collection(), opCtx(), _ws, id, _params.canonicalQuery)) {
+                _ws->free(id);
+                current = WorkingSet::INVALID_ID;
+                continue;
+            }
+
+            member->makeObjOwnedIfNeeded();
+            child()->saveState();
+            transformAndUpdate({member->doc.snapshotId(), member->doc.value().toBson()}, recordId);
+            ++_specificStats.nMatched;
+            batch.push_back(id);
+            current = WorkingSet::INVALID_ID;
+            child()->restoreState(&collection());
+        }
+
+        wunit.commit();
+    } catch (const WriteConflictException&) {
+        // Everything the batch wrote rolled back, so its documents, and the one it was working on
+        // when the conflict happened, must all be updated again after the yield.
+        _specificStats = statsBeforeBatch;
+        for (auto&& recordId : _recordIdsUpdatedInBatch) {
+            _updatedRecordIds->erase(recordId);
+        }
+        _recordIdsUpdatedInBatch.clear();
+        if (current != WorkingSet::INVALID_ID) {
+            batch.push_back(current);
+        }
+        _batchIdsRetrying.insert(_batchIdsRetrying.begin(), batch.begin(), batch.end());
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    for (auto&& id : batch) {
+        _ws->free(id);
+    }
+    _recordIdsUpdatedInBatch.clear();
+    return status == ADVANCED ? NEED_TIME : status;
+}
+
 void UpdateStage::_ensureIdFieldIsFirst(mb::Document* doc, bool generateOIDIfMissing) {
     mb::Element idElem = mb::findFirstChildNamed(doc->root(), idFieldName);
 
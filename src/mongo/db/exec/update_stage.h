@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+#include <vector>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/requires_collection_stage.h"
@@ -151,6 +153,17 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * The doWork() of multi-updates which write '_writeBatchSize' documents per storage
+     * transaction. Updates documents until the batch is full or the child returns anything but a
+     * document, then commits the batch and returns what the child returned, or NEED_TIME. The
+     * caller can yield between batches, as it can between documents otherwise.
+     *
+     * If the batch hits a write conflict, all of its documents are rolled back and retried after
+     * the yield.
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
     /**
      * Returns true if the owning shard under the current key pattern would change as a result of
      * the update, or if the destined recipient under the new shard key pattern from resharding
@@ -203,6 +216,18 @@ private:
     // So, no matter what, we keep track of where the doc wound up.
     typedef stdx::unordered_set<RecordId, RecordId::Hasher> RecordIdSet;
     const std::unique_ptr<RecordIdSet> _updatedRecordIds;
+
+    // The number of documents written per storage transaction, above one only for multi-updates
+    // which return no documents and are not part of a multi-document transaction.
+    const size_t _writeBatchSize;
+
+    // The RecordIds added to '_updatedRecordIds' by the current batch, to take back out if the
+    // batch rolls back.
+    std::vector<RecordId> _recordIdsUpdatedInBatch;
+
+    // The documents of batches that rolled back, which are retried before asking our child for
+    // more.
+    std::deque<WorkingSetID> _batchIdsRetrying;
 };
 
 }  // namespace mongo
@@ -47,7 +47,8 @@ struct FTDCConfig {
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault),
+          maxCollectionOverheadPercent(kMaxCollectionOverheadPercentDefault) {}
 
     /**
      * True if FTDC is collecting data. False otherwise
@@ -84,6 +85,13 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * Upper bound on the share of each period, in percent, that collection may take on average. A
+     * collection which runs over the budget delays the following ones so that the average stays
+     * within it. Zero means no budget is enforced.
+     */
+    std::uint32_t maxCollectionOverheadPercent;
+
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
@@ -94,6 +102,8 @@ struct FTDCConfig {
 
     static const std::uint32_t kMaxSamplesPerArchiveMetricChunkDefault = 300;
     static const std::uint32_t kMaxSamplesPerInterimMetricChunkDefault = 10;
+
+    static const std::uint32_t kMaxCollectionOverheadPercentDefault = 0;
 };
 
 }  // namespace mongo
@@ -50,4 +50,7 @@ extern const char kFTDCCollectEndField[];
 
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
+// Subdirectory of the FTDC directory which the high resolution samples are written to.
+constexpr StringData kFTDCHighResolutionDirectory = "highResolution"_sd;
+
 }  // namespace mongo
@@ -94,6 +94,12 @@ void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     _condvar.notify_one();
 }
 
+void FTDCController::setMaxCollectionOverheadPercent(std::uint32_t percent) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.maxCollectionOverheadPercent = percent;
+    _condvar.notify_one();
+}
+
 Status FTDCController::setDirectory(const boost::filesystem::path& path) {
     stdx::lock_guard<Latch> lock(_mutex);
 
@@ -200,13 +206,17 @@ void FTDCController::doLoop() noexcept {
         _config = _configTemp;
     }
 
+    // Earliest time the next collection may start at so that collection stays within
+    // maxCollectionOverheadPercent of the time.
+    Date_t resumeTime;
+
     while (true) {
         // Compute the next interval to run regardless of how we were woken up
         // Skipping an interval due to a race condition with a config signal is harmless.
         auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
 
         // Get next time to run at
-        auto next_time = FTDCUtil::roundTime(now, _config.period);
+        auto next_time = FTDCUtil::roundTime(std::max(now, resumeTime), _config.period);
 
         // Wait for the next run or signal to shutdown
         {
@@ -258,6 +268,23 @@ void FTDCController::doLoop() noexcept {
                 stdx::lock_guard<Latch> lock(_mutex);
                 _mostRecentPeriodicDocument = std::get<0>(collectSample);
             }
+
+            // Skip periods after a collection which ran over its share of the period, so that the
+            // average overhead stays within budget.
+            resumeTime = Date_t();
+            const auto percent = static_cast<long long>(_config.maxCollectionOverheadPercent);
+            if (percent > 0) {
+                auto start = std::get<1>(collectSample);
+                auto elapsed = getGlobalServiceContext()->getPreciseClockSource()->now() - start;
+                if (elapsed * 100 > _config.period * percent) {
+                    resumeTime = start + elapsed * 100 / percent;
+                    LOGV2_DEBUG(6109700,
+                                2,
+                                "Full-time diagnostic data capture exceeded its overhead budget",
+                                "elapsed"_attr = elapsed,
+                                "resumeTime"_attr = resumeTime);
+                }
+            }
         }
     }
 }
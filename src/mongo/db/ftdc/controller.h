@@ -99,6 +99,12 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set the share of each period, in percent, that collection may take on average. Zero disables
+     * the budget.
+     */
+    void setMaxCollectionOverheadPercent(std::uint32_t percent);
+
     /*
      * Set the path to store FTDC files if not already set.
      *
@@ -48,6 +48,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -283,4 +284,67 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+class FTDCSlowCollectorMock : public FTDCCollectorInterface {
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
+        sleepmillis(10);
+
+        stdx::lock_guard<Latch> lck(_mutex);
+        _starts.push_back(now);
+        builder.append("count", static_cast<int>(_starts.size()));
+        _condvar.notify_all();
+    }
+
+    std::string name() const final {
+        return "slow";
+    }
+
+    std::vector<Date_t> waitForStarts(size_t count) {
+        stdx::unique_lock<Latch> lck(_mutex);
+        _condvar.wait(lck, [&] { return _starts.size() >= count; });
+        return _starts;
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("FTDCSlowCollectorMock::_mutex");
+    stdx::condition_variable _condvar;
+    std::vector<Date_t> _starts;
+};
+
+// Test that a collection which runs over the overhead budget delays the following ones
+TEST_F(FTDCControllerTest, TestOverheadBudget) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path dir(tempdir.path());
+
+    createDirectoryClean(dir);
+
+    FTDCConfig config;
+    config.enabled = true;
+    config.period = Milliseconds(1);
+    config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+    config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+    config.maxCollectionOverheadPercent = 10;
+
+    auto c1 = std::make_unique<FTDCSlowCollectorMock>();
+
+    auto c1Ptr = c1.get();
+
+    FTDCController c(dir, config);
+
+    c.addPeriodicCollector(std::move(c1));
+
+    c.start();
+
+    auto starts = c1Ptr->waitForStarts(3);
+
+    c.stop();
+
+    // Each collection takes at least 10ms, so with a 10% budget the next one may not start for
+    // another 100ms. Allow for the time between the controller's start and the collector's.
+    for (size_t i = 1; i < starts.size(); ++i) {
+        ASSERT_GTE(starts[i] - starts[i - 1], Milliseconds(90));
+    }
+}
+
 }  // namespace mongo
@@ -38,8 +38,10 @@
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_server_gen.h"
 #include "mongo/db/ftdc/ftdc_system_stats.h"
@@ -48,6 +50,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/util/synchronized_value.h"
+#include "mongo/util/text.h"
 
 namespace mongo {
 
@@ -63,6 +66,25 @@ FTDCController* getGlobalFTDCController() {
     return getFTDCController(getGlobalServiceContext()).get();
 }
 
+/**
+ * Second controller which samples a few hot metrics many times a second. It writes to its own
+ * subdirectory so that its stable schema compresses well and does not disturb the regular samples.
+ */
+const auto getHighResolutionFTDCController =
+    ServiceContext::declareDecoration<std::unique_ptr<FTDCController>>();
+
+FTDCController* getGlobalHighResolutionFTDCController() {
+    if (!hasGlobalServiceContext()) {
+        return nullptr;
+    }
+
+    return getHighResolutionFTDCController(getGlobalServiceContext()).get();
+}
+
+// Interim chunks are rewritten every N samples, so flush the high resolution samples less often
+// than the regular ones to keep the I/O proportionate.
+constexpr std::uint32_t kHighResolutionSamplesPerInterimMetricChunk = 100;
+
 /**
  * Expose diagnosticDataCollectionDirectoryPath set parameter to specify the MongoD and MongoS FTDC
  * path.
@@ -88,6 +110,15 @@ Status DiagnosticDataCollectionDirectoryPathServerParameter::setFromString(const
                 return s;
             }
         }
+
+        controller = getGlobalHighResolutionFTDCController();
+        if (controller) {
+            Status s = controller->setDirectory(boost::filesystem::path(str) /
+                                                kFTDCHighResolutionDirectory.toString());
+            if (!s.isOK()) {
+                return s;
+            }
+        }
     }
 
     ftdcDirectoryPathParameter = str;
@@ -171,6 +202,51 @@ Status onUpdateFTDCPerInterimUpdate(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCHighResolutionEnabled(const bool value) {
+    auto controller = getGlobalHighResolutionFTDCController();
+    if (controller) {
+        return controller->setEnabled(value);
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCHighResolutionPeriod(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalHighResolutionFTDCController();
+    if (controller) {
+        controller->setPeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCHighResolutionDirectorySize(const std::int32_t potentialNewValue) {
+    if (potentialNewValue < ftdcStartupParams.maxFileSizeMB.load()) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "diagnosticDataCollectionHighResolutionDirectorySizeMB must "
+                                       "be greater than or equal to '"
+                                    << ftdcStartupParams.maxFileSizeMB.load()
+                                    << "' which is the current value of "
+                                       "diagnosticDataCollectionFileSizeMB.");
+    }
+
+    auto controller = getGlobalHighResolutionFTDCController();
+    if (controller) {
+        controller->setMaxDirectorySizeBytes(potentialNewValue * 1024 * 1024);
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCHighResolutionOverheadPercent(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalHighResolutionFTDCController();
+    if (controller) {
+        controller->setMaxCollectionOverheadPercent(potentialNewValue);
+    }
+
+    return Status::OK();
+}
+
 FTDCSimpleInternalCommandCollector::FTDCSimpleInternalCommandCollector(StringData command,
                                                                        StringData name,
                                                                        StringData ns,
@@ -268,6 +344,41 @@ private:
     bool _serverShuttingDown;
 };
 
+/**
+ * A FTDC Collector for the hot metrics of the serverStatus sections listed in
+ * diagnosticDataCollectionHighResolutionSections.
+ *
+ * The sections are appended directly rather than through the serverStatus command, and each one
+ * is passed {hotMetricsOnly: true} so that sections which support it can skip their expensive
+ * parts.
+ */
+class FTDCHighResolutionCollector : public FTDCCollectorInterface {
+private:
+    constexpr static StringData kName = "serverStatus"_sd;
+
+public:
+    explicit FTDCHighResolutionCollector(StringData sections) {
+        BSONObjBuilder builder;
+        for (auto&& section : StringSplitter::split(sections.toString(), ",")) {
+            if (!section.empty()) {
+                builder.append(section, BSON("hotMetricsOnly" << true));
+            }
+        }
+        _sections = builder.obj();
+    }
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        appendServerStatusSections(opCtx, _sections, &builder);
+    }
+
+    std::string name() const final {
+        return kName.toString();
+    }
+
+private:
+    BSONObj _sections;
+};
+
 // Register the FTDC system
 // Note: This must be run before the server parameters are parsed during startup
 // so that the FTDCController is initialized.
@@ -325,6 +436,36 @@ void startFTDC(boost::filesystem::path& path,
     staticFTDC = std::move(controller);
 
     staticFTDC->start();
+
+    // The high resolution controller shares the file size with the regular one, but has its own
+    // period, directory size and overhead budget.
+    FTDCConfig highResolutionConfig = config;
+    highResolutionConfig.enabled = startupMode == FTDCStartMode::kStart &&
+        gDiagnosticDataCollectionHighResolutionEnabled.load();
+    highResolutionConfig.period =
+        Milliseconds(gDiagnosticDataCollectionHighResolutionPeriodMillis.load());
+    highResolutionConfig.maxDirectorySizeBytes =
+        gDiagnosticDataCollectionHighResolutionDirectorySizeMB.load() * 1024 * 1024;
+    highResolutionConfig.maxSamplesPerInterimMetricChunk = std::min(
+        kHighResolutionSamplesPerInterimMetricChunk, config.maxSamplesPerArchiveMetricChunk);
+    highResolutionConfig.maxCollectionOverheadPercent =
+        gDiagnosticDataCollectionHighResolutionOverheadPercent.load();
+
+    auto highResolutionPath = path;
+    if (!highResolutionPath.empty()) {
+        highResolutionPath /= kFTDCHighResolutionDirectory.toString();
+    }
+
+    auto highResolutionController =
+        std::make_unique<FTDCController>(highResolutionPath, highResolutionConfig);
+    highResolutionController->addPeriodicCollector(std::make_unique<FTDCHighResolutionCollector>(
+        gDiagnosticDataCollectionHighResolutionSections));
+
+    auto& staticHighResolutionFTDC = getHighResolutionFTDCController(getGlobalServiceContext());
+
+    staticHighResolutionFTDC = std::move(highResolutionController);
+
+    staticHighResolutionFTDC->start();
 }
 
 void stopFTDC() {
@@ -333,6 +474,12 @@ void stopFTDC() {
     if (controller) {
         controller->stop();
     }
+
+    controller = getGlobalHighResolutionFTDCController();
+
+    if (controller) {
+        controller->stop();
+    }
 }
 
 FTDCController* FTDCController::get(ServiceContext* serviceContext) {
@@ -65,7 +65,8 @@ enum class FTDCStartMode {
 
 /**
  * Start Full Time Data Capture
- * Starts 1 thread.
+ * Starts 2 threads, one for the regular collection and one for the high resolution collection of
+ * the hot metrics.
  *
  * See MongoD and MongoS specific functions.
  */
@@ -133,6 +134,10 @@ Status onUpdateFTDCDirectorySize(const std::int32_t value);
 Status onUpdateFTDCFileSize(const std::int32_t value);
 Status onUpdateFTDCSamplesPerChunk(const std::int32_t value);
 Status onUpdateFTDCPerInterimUpdate(const std::int32_t value);
+Status onUpdateFTDCHighResolutionEnabled(const bool value);
+Status onUpdateFTDCHighResolutionPeriod(const std::int32_t value);
+Status onUpdateFTDCHighResolutionDirectorySize(const std::int32_t value);
+Status onUpdateFTDCHighResolutionOverheadPercent(const std::int32_t value);
 
 /**
  * Server Parameter accessors
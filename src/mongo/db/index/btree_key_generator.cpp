@@ -29,6 +29,7 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <memory>
 
@@ -62,15 +63,15 @@ const BSONElement undefinedElt = undefinedObj.firstElement();
  * This function must only be used when there is no an array element along the 'path'. The caller is
  * responsible to ensure this invariant holds.
  */
-BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
+BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path);
+
+/**
+ * Continues the traversal of extractNonArrayElementAtPath() from 'elt', the element holding the
+ * first component of a path whose remaining components are 'tail'.
+ */
+BSONElement extractNonArrayElementBelow(const BSONElement& elt, StringData tail) {
     static const auto kEmptyElt = BSONElement{};
 
-    auto&& [elt, tail] = [&]() -> std::pair<BSONElement, StringData> {
-        if (auto dotOffset = path.find("."); dotOffset != std::string::npos) {
-            return {obj.getField(path.substr(0, dotOffset)), path.substr(dotOffset + 1)};
-        }
-        return {obj.getField(path), ""_sd};
-    }();
     invariant(elt.type() != BSONType::Array);
 
     if (elt.eoo()) {
@@ -84,6 +85,18 @@ BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
     // "a.b".
     return kEmptyElt;
 }
+
+std::pair<StringData, StringData> splitFirstPathComponent(StringData path) {
+    if (auto dotOffset = path.find("."); dotOffset != std::string::npos) {
+        return {path.substr(0, dotOffset), path.substr(dotOffset + 1)};
+    }
+    return {path, ""_sd};
+}
+
+BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
+    auto [head, tail] = splitFirstPathComponent(path);
+    return extractNonArrayElementBelow(obj.getField(head), tail);
+}
 }  // namespace
 
 BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
@@ -109,6 +122,7 @@ BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
         _pathLengths.push_back(pathLength);
         _pathsContainPositionalComponent =
             _pathsContainPositionalComponent || fieldRef.hasNumericPathComponents();
+        _splitFieldNames.push_back(splitFirstPathComponent(fieldName));
     }
 }
 
@@ -284,8 +298,26 @@ void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooled
     KeyString::PooledBuilder keyString{pooledBufferBuilder, _keyStringVersion, _ordering};
     size_t numNotFound{0};
 
-    for (auto&& fieldName : _fieldNames) {
-        auto elem = extractNonArrayElementAtPath(obj, fieldName);
+    // Find the first component of every indexed path in a single pass over the document, rather
+    // than scanning it once per indexed field. As with BSONObj::getField(), the first element with
+    // a matching name wins.
+    boost::container::small_vector<BSONElement, 8> topLevelElts(_splitFieldNames.size());
+    size_t numLeftToFind = _splitFieldNames.size();
+    for (auto&& elt : obj) {
+        const auto name = elt.fieldNameStringData();
+        for (size_t i = 0; i < _splitFieldNames.size(); ++i) {
+            if (topLevelElts[i].eoo() && _splitFieldNames[i].first == name) {
+                topLevelElts[i] = elt;
+                --numLeftToFind;
+            }
+        }
+        if (numLeftToFind == 0) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < _splitFieldNames.size(); ++i) {
+        auto elem = extractNonArrayElementBelow(topLevelElts[i], _splitFieldNames[i].second);
         if (elem.eoo()) {
             ++numNotFound;
         }
@@ -243,6 +243,11 @@ private:
     // the vector is the number of path components in the indexed field.
     std::vector<size_t> _pathLengths;
 
+    // For each indexed field, its first path component and the remainder of the path after it.
+    // Used by the non-multikey fast path to find every first component in one pass over the
+    // document.
+    std::vector<std::pair<StringData, StringData>> _splitFieldNames;
+
     // Null if this key generator orders strings according to the simple binary compare. If
     // non-null, represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* _collator;
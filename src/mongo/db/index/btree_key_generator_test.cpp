@@ -211,6 +211,17 @@ TEST(BtreeKeyGeneratorTest, GetKeysFromObjectDotted) {
     ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeysFromObjectCompoundSharingPrefixesOutOfOrder) {
+    BSONObj keyPattern = fromjson("{'a.c': 1, x: 1, 'a.b': 1, d: 1}");
+    BSONObj genKeysFrom = fromjson("{d: 'foo', a: {b: 4, c: 5}, e: 6}");
+    KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion,
+                                     fromjson("{'': 5, '': null, '': 4, '': 'foo'}"),
+                                     Ordering::make(BSONObj()));
+    KeyStringSet expectedKeys{keyString.release()};
+    MultikeyPaths expectedMultikeyPaths(keyPattern.nFields());
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
 TEST(BtreeKeyGeneratorTest, GetKeysFromArraySimple) {
     BSONObj keyPattern = fromjson("{a: 1}");
     BSONObj genKeysFrom = fromjson("{a: [1, 2, 3]}");
@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_key_generator.h"
+
+#include <algorithm>
+
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+std::string appendPathComponent(const std::string& prefix, StringData fieldName) {
+    if (prefix.empty()) {
+        return fieldName.toString();
+    }
+    return str::stream() << prefix << '.' << fieldName;
+}
+
+// Returns true if 'path' equals 'prefix' or is nested underneath it.
+bool isPathPrefixOf(StringData prefix, StringData path) {
+    return path.startsWith(prefix) && (path.size() == prefix.size() || path[prefix.size()] == '.');
+}
+
+}  // namespace
+
+ColumnKeyGenerator::ColumnKeyGenerator(std::vector<std::string> projectedPaths)
+    : _projectedPaths(std::move(projectedPaths)) {}
+
+void ColumnKeyGenerator::visitCells(const BSONObj& doc, const CellVisitor& visitor) const {
+    CellMap cells;
+    _walkObject(doc, "", false /* inArray */, &cells);
+    for (auto&& [path, cell] : cells) {
+        visitor(path, cell);
+    }
+}
+
+bool ColumnKeyGenerator::isPathIncluded(StringData path) const {
+    return _projectedPaths.empty() ||
+        std::any_of(_projectedPaths.begin(), _projectedPaths.end(), [&](const auto& projected) {
+               return isPathPrefixOf(projected, path);
+           });
+}
+
+bool ColumnKeyGenerator::_isAncestorOfIncludedPath(StringData path) const {
+    return std::any_of(_projectedPaths.begin(), _projectedPaths.end(), [&](const auto& projected) {
+        return projected.size() > path.size() && isPathPrefixOf(path, projected);
+    });
+}
+
+void ColumnKeyGenerator::_walkObject(const BSONObj& obj,
+                                     const std::string& prefix,
+                                     bool inArray,
+                                     CellMap* cells) const {
+    for (auto&& elem : obj) {
+        _walkElement(elem, appendPathComponent(prefix, elem.fieldNameStringData()), inArray, cells);
+    }
+}
+
+void ColumnKeyGenerator::_walkElement(BSONElement elem,
+                                      const std::string& path,
+                                      bool inArray,
+                                      CellMap* cells) const {
+    const bool included = isPathIncluded(path);
+    if (!included && !_isAncestorOfIncludedPath(path)) {
+        return;
+    }
+
+    switch (elem.type()) {
+        case Object: {
+            auto obj = elem.embeddedObject();
+            if (!obj.isEmpty()) {
+                _walkObject(obj, path, inArray, cells);
+            } else if (included) {
+                _addValue(elem, path, inArray, cells);
+            }
+            return;
+        }
+        case Array: {
+            auto arr = elem.embeddedObject();
+            if (arr.isEmpty()) {
+                if (included) {
+                    _addValue(elem, path, true /* inArray */, cells);
+                }
+                return;
+            }
+            // Array positions are not part of the path, so the elements share their parent's path.
+            // A nested array has no path of its own below this one and is stored whole.
+            for (auto&& child : arr) {
+                if (child.type() == Array) {
+                    if (included) {
+                        _addValue(child, path, true /* inArray */, cells);
+                    }
+                } else {
+                    _walkElement(child, path, true /* inArray */, cells);
+                }
+            }
+            return;
+        }
+        default:
+            if (included) {
+                _addValue(elem, path, inArray, cells);
+            }
+            return;
+    }
+}
+
+void ColumnKeyGenerator::_addValue(BSONElement elem,
+                                   const std::string& path,
+                                   bool inArray,
+                                   CellMap* cells) const {
+    auto& cell = (*cells)[path];
+    cell.vals.push_back(elem);
+    cell.isArray |= inArray;
+}
+
+}  // namespace mongo
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * All of the values found at a single path of a single document, in document order. The elements
+ * point into the document that was passed to ColumnKeyGenerator::visitCells() and are only valid
+ * for as long as that document is.
+ */
+struct UnencodedCellView {
+    std::vector<BSONElement> vals;
+
+    // True if an array was traversed on the way to this path, meaning the values cannot be
+    // reassembled into the original document without also consulting the parent paths.
+    bool isArray = false;
+};
+
+/**
+ * Decomposes documents into the per-path cells stored by a column store index. Every leaf of the
+ * document becomes one value in the cell for its dotted path; array positions are not part of the
+ * path, so {a: [{b: 1}, {b: 2}]} produces the single cell "a.b" => [1, 2]. Nested arrays, empty
+ * arrays and empty objects have no leaves underneath them and are stored as values themselves.
+ *
+ * A column store index keeps one column per path keyed by RecordId, so a query that projects only
+ * a handful of fields can read those columns without fetching whole documents.
+ */
+class ColumnKeyGenerator {
+public:
+    using CellVisitor = std::function<void(StringData path, const UnencodedCellView& cell)>;
+
+    /**
+     * If 'projectedPaths' is empty, every path in the document is visited. Otherwise only the
+     * listed paths and the paths nested underneath them are.
+     */
+    explicit ColumnKeyGenerator(std::vector<std::string> projectedPaths = {});
+
+    /**
+     * Calls 'visitor' once for each path in 'doc' that this generator covers, in ascending path
+     * order.
+     */
+    void visitCells(const BSONObj& doc, const CellVisitor& visitor) const;
+
+    /**
+     * Returns true if values found at 'path' belong in this index.
+     */
+    bool isPathIncluded(StringData path) const;
+
+private:
+    using CellMap = std::map<std::string, UnencodedCellView, std::less<>>;
+
+    // Returns true if 'path' is a strict prefix of one of the projected paths, meaning traversal
+    // must continue below it even though its own values are not stored.
+    bool _isAncestorOfIncludedPath(StringData path) const;
+
+    void _walkObject(const BSONObj& obj, const std::string& prefix, bool inArray, CellMap* cells)
+        const;
+    void _walkElement(BSONElement elem, const std::string& path, bool inArray, CellMap* cells)
+        const;
+    void _addValue(BSONElement elem, const std::string& path, bool inArray, CellMap* cells) const;
+
+    const std::vector<std::string> _projectedPaths;
+};
+
+}  // namespace mongo
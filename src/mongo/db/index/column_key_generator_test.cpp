@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+struct Cell {
+    BSONObj vals;
+    bool isArray;
+};
+
+// Runs the generator over 'doc' and returns each cell's values wrapped in an object so they can be
+// compared against JSON.
+std::map<std::string, Cell> cellsFor(const ColumnKeyGenerator& gen, const BSONObj& doc) {
+    std::map<std::string, Cell> out;
+    gen.visitCells(doc, [&](StringData path, const UnencodedCellView& cell) {
+        BSONArrayBuilder vals;
+        for (auto&& elem : cell.vals) {
+            vals.append(elem);
+        }
+        ASSERT_TRUE(out.emplace(path.toString(), Cell{BSON("" << vals.arr()), cell.isArray})
+                        .second);
+    });
+    return out;
+}
+
+void assertCell(const std::map<std::string, Cell>& cells,
+                const std::string& path,
+                const std::string& expectedVals,
+                bool expectedIsArray) {
+    auto it = cells.find(path);
+    ASSERT_TRUE(it != cells.end()) << path;
+    ASSERT_BSONOBJ_EQ(it->second.vals, fromjson("{'': " + expectedVals + "}"));
+    ASSERT_EQ(it->second.isArray, expectedIsArray) << path;
+}
+
+TEST(ColumnKeyGeneratorTest, ScalarAndNestedFields) {
+    ColumnKeyGenerator gen;
+    auto cells = cellsFor(gen, fromjson("{_id: 1, a: 2, b: {c: 'x', d: {e: null}}}"));
+
+    ASSERT_EQ(cells.size(), 4U);
+    assertCell(cells, "_id", "[1]", false);
+    assertCell(cells, "a", "[2]", false);
+    assertCell(cells, "b.c", "['x']", false);
+    assertCell(cells, "b.d.e", "[null]", false);
+}
+
+TEST(ColumnKeyGeneratorTest, ArrayPositionsAreNotPartOfThePath) {
+    ColumnKeyGenerator gen;
+    auto cells = cellsFor(gen, fromjson("{a: [1, {b: 2}, {b: 3, c: 4}], d: [[5, 6], 7]}"));
+
+    ASSERT_EQ(cells.size(), 4U);
+    assertCell(cells, "a", "[1]", true);
+    assertCell(cells, "a.b", "[2, 3]", true);
+    assertCell(cells, "a.c", "[4]", true);
+    assertCell(cells, "d", "[[5, 6], 7]", true);
+}
+
+TEST(ColumnKeyGeneratorTest, EmptyContainersAreStoredAsValues) {
+    ColumnKeyGenerator gen;
+    auto cells = cellsFor(gen, fromjson("{a: {}, b: [], c: [{}]}"));
+
+    ASSERT_EQ(cells.size(), 3U);
+    assertCell(cells, "a", "[{}]", false);
+    assertCell(cells, "b", "[[]]", true);
+    assertCell(cells, "c", "[{}]", true);
+}
+
+TEST(ColumnKeyGeneratorTest, ProjectionLimitsVisitedPaths) {
+    ColumnKeyGenerator gen({"a.b", "c"});
+    auto cells =
+        cellsFor(gen, fromjson("{a: {b: 1, x: 2}, ab: 3, c: {d: 4, e: [5]}, f: 6, a2: {b: 7}}"));
+
+    ASSERT_EQ(cells.size(), 3U);
+    assertCell(cells, "a.b", "[1]", false);
+    assertCell(cells, "c.d", "[4]", false);
+    assertCell(cells, "c.e", "[5]", true);
+
+    ASSERT_TRUE(gen.isPathIncluded("a.b.c"));
+    ASSERT_FALSE(gen.isPathIncluded("a"));
+    ASSERT_FALSE(gen.isPathIncluded("a.bc"));
+}
+
+TEST(ColumnKeyGeneratorTest, ProjectedAncestorValuesAreNotStored) {
+    // 'a' is only traversed to reach 'a.b', so a scalar stored directly at 'a' is not part of the
+    // index.
+    ColumnKeyGenerator gen({"a.b"});
+    auto cells = cellsFor(gen, fromjson("{a: [1, {b: 2}]}"));
+
+    ASSERT_EQ(cells.size(), 1U);
+    assertCell(cells, "a.b", "[2]", true);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -43,6 +43,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/index/index_access_method_gen.h"
 #include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
@@ -84,7 +85,8 @@ SortOptions makeSortOptions(size_t maxMemoryUsageBytes, StringData dbName) {
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
         .MaxMemoryUsageBytes(maxMemoryUsageBytes)
-        .DBName(dbName.toString());
+        .DBName(dbName.toString())
+        .SortThreads(maxIndexBuildSortThreads.load());
 }
 
 MultikeyPaths createMultikeyPaths(const std::vector<MultikeyPath>& multikeyPathsVec) {
@@ -266,39 +268,41 @@ Status AbstractIndexAccessMethod::initializeAsEmpty(OperationContext* opCtx) {
     return _newInterface->initAsEmpty(opCtx);
 }
 
+KeyString::Value AbstractIndexAccessMethod::_makeKeyForLookup(
+    OperationContext* opCtx, const CollectionPtr& collection, const BSONObj& requestedKey) const {
+    if (_indexCatalogEntry->getCollator()) {
+        // For performance, call get keys only if there is a non-simple collation.
+        auto& executionCtx = StorageExecutionContext::get(opCtx);
+        auto keys = executionCtx.keys();
+        KeyStringSet* multikeyMetadataKeys = nullptr;
+        MultikeyPaths* multikeyPaths = nullptr;
+
+        getKeys(opCtx,
+                collection,
+                executionCtx.pooledBufferBuilder(),
+                requestedKey,
+                GetKeysMode::kEnforceConstraints,
+                GetKeysContext::kAddingKeys,
+                keys.get(),
+                multikeyMetadataKeys,
+                multikeyPaths,
+                boost::none,  // loc
+                kNoopOnSuppressedErrorFn);
+        invariant(keys->size() == 1);
+        return *keys->begin();
+    }
+
+    KeyString::HeapBuilder requestedKeyString(getSortedDataInterface()->getKeyStringVersion(),
+                                              BSONObj::stripFieldNames(requestedKey),
+                                              getSortedDataInterface()->getOrdering());
+    return requestedKeyString.release();
+}
+
 RecordId AbstractIndexAccessMethod::findSingle(OperationContext* opCtx,
                                                const CollectionPtr& collection,
                                                const BSONObj& requestedKey) const {
     // Generate the key for this index.
-    KeyString::Value actualKey = [&]() {
-        if (_indexCatalogEntry->getCollator()) {
-            // For performance, call get keys only if there is a non-simple collation.
-            auto& executionCtx = StorageExecutionContext::get(opCtx);
-            auto keys = executionCtx.keys();
-            KeyStringSet* multikeyMetadataKeys = nullptr;
-            MultikeyPaths* multikeyPaths = nullptr;
-
-            getKeys(opCtx,
-                    collection,
-                    executionCtx.pooledBufferBuilder(),
-                    requestedKey,
-                    GetKeysMode::kEnforceConstraints,
-                    GetKeysContext::kAddingKeys,
-                    keys.get(),
-                    multikeyMetadataKeys,
-                    multikeyPaths,
-                    boost::none,  // loc
-                    kNoopOnSuppressedErrorFn);
-            invariant(keys->size() == 1);
-            return *keys->begin();
-        } else {
-            KeyString::HeapBuilder requestedKeyString(
-                getSortedDataInterface()->getKeyStringVersion(),
-                BSONObj::stripFieldNames(requestedKey),
-                getSortedDataInterface()->getOrdering());
-            return requestedKeyString.release();
-        }
-    }();
+    KeyString::Value actualKey = _makeKeyForLookup(opCtx, collection, requestedKey);
 
     std::unique_ptr<SortedDataInterface::Cursor> cursor(_newInterface->newCursor(opCtx));
     const auto requestedInfo = kDebugBuild ? SortedDataInterface::Cursor::kKeyAndLoc
@@ -319,6 +323,37 @@ RecordId AbstractIndexAccessMethod::findSingle(OperationContext* opCtx,
     return RecordId();
 }
 
+std::vector<RecordId> AbstractIndexAccessMethod::findMultiple(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const std::vector<BSONObj>& requestedKeys) const {
+    std::vector<KeyString::Value> actualKeys;
+    actualKeys.reserve(requestedKeys.size());
+    for (const auto& requestedKey : requestedKeys) {
+        actualKeys.push_back(_makeKeyForLookup(opCtx, collection, requestedKey));
+    }
+
+    // Seek the keys in index order, skipping the duplicates, so that the cursor only ever moves
+    // forward.
+    std::sort(actualKeys.begin(), actualKeys.end());
+    actualKeys.erase(std::unique(actualKeys.begin(), actualKeys.end()), actualKeys.end());
+
+    std::vector<RecordId> recordIds;
+    recordIds.reserve(actualKeys.size());
+    std::unique_ptr<SortedDataInterface::Cursor> cursor(_newInterface->newCursor(opCtx));
+    for (const auto& actualKey : actualKeys) {
+        if (auto kv = cursor->seekExact(actualKey, SortedDataInterface::Cursor::kWantLoc)) {
+            dassert(!kv->loc.isNull());
+            recordIds.push_back(std::move(kv->loc));
+        }
+    }
+
+    // Fetching the documents in RecordId order visits the record store in a single forward pass
+    // too.
+    std::sort(recordIds.begin(), recordIds.end());
+    return recordIds;
+}
+
 void AbstractIndexAccessMethod::validate(OperationContext* opCtx,
                                          int64_t* numKeys,
                                          IndexValidateResults* fullResults) const {
@@ -512,8 +547,14 @@ public:
 
     int64_t getKeysInserted() const final;
 
+    size_t getNumSpills() const final;
+
+    const SorterSpillStats& getSpillStats() const final;
+
     Sorter::PersistedState persistDataForShutdown() final;
 
+    Sorter::PersistedState persistDataForCheckpoint() final;
+
 private:
     void _insertMultikeyMetadataKeysIntoSorter();
 
@@ -540,6 +581,9 @@ private:
     // These are inserted into the sorter after all normal data keys have been added, just
     // before the bulk build is committed.
     KeyStringSet _multikeyMetadataKeys;
+
+    // The multikey metadata keys that have already been inserted into the sorter by a checkpoint.
+    KeyStringSet _multikeyMetadataKeysInSorter;
 };
 
 std::unique_ptr<IndexAccessMethod::BulkBuilder> AbstractIndexAccessMethod::initiateBulk(
@@ -652,14 +696,31 @@ int64_t AbstractIndexAccessMethod::BulkBuilderImpl::getKeysInserted() const {
     return _keysInserted;
 }
 
+size_t AbstractIndexAccessMethod::BulkBuilderImpl::getNumSpills() const {
+    return _sorter->numSpills();
+}
+
+const SorterSpillStats& AbstractIndexAccessMethod::BulkBuilderImpl::getSpillStats() const {
+    return _sorter->spillStats();
+}
+
 AbstractIndexAccessMethod::BulkBuilder::Sorter::PersistedState
 AbstractIndexAccessMethod::BulkBuilderImpl::persistDataForShutdown() {
     _insertMultikeyMetadataKeysIntoSorter();
     return _sorter->persistDataForShutdown();
 }
 
+AbstractIndexAccessMethod::BulkBuilder::Sorter::PersistedState
+AbstractIndexAccessMethod::BulkBuilderImpl::persistDataForCheckpoint() {
+    _insertMultikeyMetadataKeysIntoSorter();
+    return _sorter->persistDataForCheckpoint();
+}
+
 void AbstractIndexAccessMethod::BulkBuilderImpl::_insertMultikeyMetadataKeysIntoSorter() {
     for (const auto& keyString : _multikeyMetadataKeys) {
+        if (!_multikeyMetadataKeysInSorter.insert(keyString).second) {
+            continue;
+        }
         _sorter->add(keyString, mongo::NullValue());
         ++_keysInserted;
     }
@@ -803,6 +864,9 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
           "namespace"_attr = _indexCatalogEntry->getNSSFromCatalog(opCtx),
           "index"_attr = _descriptor->indexName(),
           "keysInserted"_attr = bulk->getKeysInserted(),
+          "spills"_attr = bulk->getNumSpills(),
+          "spilledDataBytes"_attr = bulk->getSpillStats().spilledDataBytes,
+          "spillDuration"_attr = duration_cast<Milliseconds>(bulk->getSpillStats().spillTime),
           "duration"_attr = Milliseconds(Seconds(timer.seconds())));
     return Status::OK();
 }
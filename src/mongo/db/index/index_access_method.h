@@ -215,6 +215,16 @@ public:
                                 const CollectionPtr& collection,
                                 const BSONObj& key) const = 0;
 
+    /**
+     * Looks up each of 'keys' in the index, as findSingle() would, and returns the RecordIds of
+     * those which were found in increasing order. The keys are sought in the order of the index in
+     * a single pass of one cursor, so that neighbouring keys are found without seeking from the
+     * root of the index again.
+     */
+    virtual std::vector<RecordId> findMultiple(OperationContext* opCtx,
+                                               const CollectionPtr& collection,
+                                               const std::vector<BSONObj>& keys) const = 0;
+
     /**
      * Attempt compaction to regain disk space if the indexed record store supports
      * compaction-in-place.
@@ -263,11 +273,27 @@ public:
          */
         virtual int64_t getKeysInserted() const = 0;
 
+        /**
+         * Returns the number of times the underlying Sorter spilled to disk.
+         */
+        virtual size_t getNumSpills() const = 0;
+
+        /**
+         * Returns how much the underlying Sorter has written to disk, and how long that took.
+         */
+        virtual const SorterSpillStats& getSpillStats() const = 0;
+
         /**
          * Persists on disk the keys that have been inserted using this BulkBuilder. Returns the
          * state of the underlying Sorter.
          */
         virtual Sorter::PersistedState persistDataForShutdown() = 0;
+
+        /**
+         * Like persistDataForShutdown(), but keys can still be inserted afterwards and the
+         * persisted data is removed with the BulkBuilder, as for an ordinary build.
+         */
+        virtual Sorter::PersistedState persistDataForCheckpoint() = 0;
     };
 
     /**
@@ -532,6 +558,10 @@ public:
                         const CollectionPtr& collection,
                         const BSONObj& key) const final;
 
+    std::vector<RecordId> findMultiple(OperationContext* opCtx,
+                                       const CollectionPtr& collection,
+                                       const std::vector<BSONObj>& keys) const final;
+
     Status compact(OperationContext* opCtx) final;
 
     void setIndexIsMultikey(OperationContext* opCtx,
@@ -598,6 +628,14 @@ protected:
 private:
     class BulkBuilderImpl;
 
+    /**
+     * Returns the key which findSingle() and findMultiple() look up in the index for
+     * 'requestedKey'.
+     */
+    KeyString::Value _makeKeyForLookup(OperationContext* opCtx,
+                                       const CollectionPtr& collection,
+                                       const BSONObj& requestedKey) const;
+
     /**
      * Removes a single key from the index.
      *
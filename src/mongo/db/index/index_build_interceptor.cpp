@@ -387,6 +387,13 @@ bool IndexBuildInterceptor::areAllWritesApplied(OperationContext* opCtx) const {
     return _checkAllWritesApplied(opCtx, false);
 }
 
+int64_t IndexBuildInterceptor::getPendingWritesEstimate() const {
+    if (_skipNumAppliedCheck) {
+        return 0;
+    }
+    return std::max<int64_t>(_sideWritesCounter->load() - _numApplied, 0);
+}
+
 void IndexBuildInterceptor::invariantAllWritesApplied(OperationContext* opCtx) const {
     _checkAllWritesApplied(opCtx, true);
 }
@@ -157,6 +157,13 @@ public:
      */
     bool areAllWritesApplied(OperationContext* opCtx) const;
 
+    /**
+     * Returns an estimate of the number of side writes recorded but not yet applied, including
+     * writes that are not yet visible. Returns 0 when the count is unknown, as it is for builds
+     * resumed after a restart.
+     */
+    int64_t getPendingWritesEstimate() const;
+
     /**
      * Invariants that there are no visible records remaining to be applied from the side writes
      * table.
@@ -71,6 +71,37 @@ void BM_KeyGenBasic(benchmark::State& state, bool skipMultikey) {
     }
 }
 
+void BM_KeyGenCompound(benchmark::State& state, bool skipMultikey) {
+    // A document with a handful of unindexed fields around the indexed ones, which include a
+    // dotted path.
+    const BSONObj obj = BSON("_id" << 1 << "name"
+                                   << "abc"
+                                   << "a" << 1 << "status"
+                                   << "active"
+                                   << "b" << 2 << "tags" << BSON("x" << 1) << "c" << BSON("d" << 3)
+                                   << "e" << 4);
+
+    const BSONObj keyPattern = BSON("a" << 1 << "b" << 1 << "c.d" << 1 << "e" << 1);
+    BtreeKeyGenerator generator({"a", "b", "c.d", "e"},
+                                {BSONElement{}, BSONElement{}, BSONElement{}, BSONElement{}},
+                                false,
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(keyPattern));
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+
+    for (auto _ : state) {
+        generator.getKeys(allocator, obj, skipMultikey, &keys, &multikeyPaths);
+        benchmark::ClobberMemory();
+        keys.clear();
+        multikeyPaths.clear();
+    }
+}
+
 void BM_KeyGenArray(benchmark::State& state, int32_t elements) {
     std::mt19937 gen(numGen());
 
@@ -168,6 +199,9 @@ void BM_KeyGenArrayOfArray(benchmark::State& state, int32_t elements) {
 BENCHMARK_CAPTURE(BM_KeyGenBasic, Generic, false);
 BENCHMARK_CAPTURE(BM_KeyGenBasic, SkipMultikey, true);
 
+BENCHMARK_CAPTURE(BM_KeyGenCompound, Generic, false);
+BENCHMARK_CAPTURE(BM_KeyGenCompound, SkipMultikey, true);
+
 BENCHMARK_CAPTURE(BM_KeyGenArray, 1K, 1000);
 BENCHMARK_CAPTURE(BM_KeyGenArray, 10K, 10000);
 BENCHMARK_CAPTURE(BM_KeyGenArray, 100K, 100000);
@@ -45,6 +45,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbhelpers.h"
+#include "mongo/db/index/index_build_interceptor_gen.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_build_entry_helpers.h"
 #include "mongo/db/op_observer.h"
@@ -2345,8 +2346,11 @@ void IndexBuildsCoordinator::_scanCollectionAndInsertSortedKeysIntoIndex(
 
         auto collection = _setUpForScanCollectionAndInsertSortedKeysIntoIndex(opCtx, replState);
 
-        uassertStatusOK(_indexBuildsManager.startBuildingIndex(
-            opCtx, collection, replState->buildUUID, resumeAfterRecordId));
+        uassertStatusOK(_indexBuildsManager.startBuildingIndex(opCtx,
+                                                               collection,
+                                                               replState->buildUUID,
+                                                               resumeAfterRecordId,
+                                                               replState->isResumable()));
     }
 
     if (MONGO_unlikely(hangAfterIndexBuildDumpsInsertsFromBulk.shouldFail())) {
@@ -2394,9 +2398,12 @@ CollectionPtr IndexBuildsCoordinator::_setUpForScanCollectionAndInsertSortedKeys
  */
 void IndexBuildsCoordinator::_insertKeysFromSideTablesWithoutBlockingWrites(
     OperationContext* opCtx, std::shared_ptr<ReplIndexBuildState> replState) {
-    // Perform the first drain while holding an intent lock.
+    // Perform the first drain while holding an intent lock. Writes keep arriving while it runs,
+    // so drain again, up to a limit, while more than a batch is left. Whatever remains has to be
+    // drained while writes to the collection are blocked.
     const NamespaceStringOrUUID dbAndUUID(replState->dbName, replState->collectionUUID);
-    {
+    const int maxPasses = maxIndexBuildDrainPassesWithoutBlockingWrites.load();
+    for (int pass = 1;; ++pass) {
         Lock::DBLock autoDb(opCtx, replState->dbName, MODE_IX);
         Lock::CollectionLock collLock(opCtx, dbAndUUID, MODE_IX);
 
@@ -2405,6 +2412,21 @@ void IndexBuildsCoordinator::_insertKeysFromSideTablesWithoutBlockingWrites(
             replState->buildUUID,
             getReadSourceForDrainBeforeCommitQuorum(*replState),
             IndexBuildInterceptor::DrainYieldPolicy::kYield));
+
+        if (pass >= maxPasses)
+            break;
+
+        const auto pending =
+            _indexBuildsManager.getPendingSideWritesEstimate(opCtx, replState->buildUUID);
+        if (pending <= maxIndexBuildDrainBatchSize.load())
+            break;
+
+        LOGV2_DEBUG(6107400,
+                    1,
+                    "Index build: draining side writes again before blocking writes",
+                    "buildUUID"_attr = replState->buildUUID,
+                    "pass"_attr = pass,
+                    "pendingWrites"_attr = pending);
     }
 
     if (MONGO_unlikely(hangAfterIndexBuildFirstDrain.shouldFail())) {
@@ -62,6 +62,10 @@ class MatchExpression {
     MatchExpression& operator=(const MatchExpression&) = delete;
 
 public:
+    // Identifies a constant of the expression tree which has been replaced by an input parameter,
+    // so that plans built for the tree can be re-bound to other values of the constant.
+    using InputParamId = int32_t;
+
     enum MatchType {
         // tree types
         AND,
@@ -328,6 +328,63 @@ std::pair<unique_ptr<MatchExpression>, unique_ptr<MatchExpression>> splitMatchEx
     }
 }
 
+/**
+ * Returns a rough rank of how expensive it is to evaluate 'expr' against a document, for ordering
+ * the children of an $and. Only the relative order of the ranks matters.
+ */
+int evaluationCost(const MatchExpression& expr) {
+    const auto pathCost = [&] {
+        auto fieldRef = expr.fieldRef();
+        return fieldRef && fieldRef->numParts() > 1 ? 1 : 0;
+    };
+
+    switch (expr.matchType()) {
+        case MatchExpression::ALWAYS_FALSE:
+        case MatchExpression::ALWAYS_TRUE:
+            return 0;
+        case MatchExpression::EQ:
+        case MatchExpression::LTE:
+        case MatchExpression::LT:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::MOD:
+        case MatchExpression::EXISTS:
+        case MatchExpression::BITS_ALL_SET:
+        case MatchExpression::BITS_ALL_CLEAR:
+        case MatchExpression::BITS_ANY_SET:
+        case MatchExpression::BITS_ANY_CLEAR:
+        case MatchExpression::TYPE_OPERATOR:
+        case MatchExpression::SIZE:
+            return pathCost();
+        case MatchExpression::MATCH_IN:
+            return checked_cast<const InMatchExpression&>(expr).getRegexes().empty() ? pathCost()
+                                                                                      : 2;
+        case MatchExpression::REGEX:
+            return 2;
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOT:
+        case MatchExpression::NOR: {
+            int cost = 0;
+            for (size_t i = 0; i < expr.numChildren(); ++i) {
+                cost = std::max(cost, evaluationCost(*expr.getChild(i)));
+            }
+            return cost;
+        }
+        case MatchExpression::WHERE:
+        case MatchExpression::EXPRESSION:
+        case MatchExpression::INTERNAL_EXPR_EQ:
+        case MatchExpression::INTERNAL_EXPR_GT:
+        case MatchExpression::INTERNAL_EXPR_GTE:
+        case MatchExpression::INTERNAL_EXPR_LT:
+        case MatchExpression::INTERNAL_EXPR_LTE:
+            return 4;
+        default:
+            // $elemMatch, geo, text and the JSON Schema expressions.
+            return 3;
+    }
+}
+
 }  // namespace
 
 namespace expression {
@@ -496,6 +553,30 @@ void mapOver(MatchExpression* expr, NodeTraversalFunc func, std::string path) {
     func(expr, path);
 }
 
+void orderAndChildrenByEvaluationCost(MatchExpression* expr) {
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        orderAndChildrenByEvaluationCost(expr->getChild(i));
+    }
+
+    if (expr->matchType() != MatchExpression::AND) {
+        return;
+    }
+
+    auto children = expr->getChildVector();
+    std::vector<std::pair<int, std::unique_ptr<MatchExpression>>> ranked;
+    ranked.reserve(children->size());
+    for (auto&& child : *children) {
+        const int cost = evaluationCost(*child);
+        ranked.emplace_back(cost, std::move(child));
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        (*children)[i] = std::move(ranked[i].second);
+    }
+}
+
 bool isPathPrefixOf(StringData first, StringData second) {
     if (first.size() >= second.size()) {
         return false;
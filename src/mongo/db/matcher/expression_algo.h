@@ -157,5 +157,13 @@ splitMatchExpressionBy(std::unique_ptr<MatchExpression> expr,
  * {new: {$gt: 3}}.
  */
 void applyRenamesToExpression(MatchExpression* expr, const StringMap<std::string>& renames);
+
+/**
+ * Reorders the children of every $and within 'expr' so that the cheaper ones are evaluated first:
+ * top-level paths before dotted ones, which need to be traversed, then regexes, array and nested
+ * matches, and $expr and $where last. Children of the same cost keep their relative order. This
+ * only changes how soon a document which does not match is rejected, not which documents match.
+ */
+void orderAndChildrenByEvaluationCost(MatchExpression* expr);
 }  // namespace expression
 }  // namespace mongo
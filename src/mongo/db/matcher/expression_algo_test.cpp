@@ -1328,6 +1328,45 @@ TEST(ApplyRenamesToExpression, ShouldNotApplyRenamesForAMatchWithExprWithNoField
         fromjson("{$expr: {$concat: [{$const: 'a'}, {$const: 'b'}, {$const: 'c'}]}}"));
 }
 
+TEST(OrderAndChildrenByEvaluationCost, PutsCheaperChildrenFirst) {
+    BSONObj matchPredicate = fromjson(
+        "{$expr: {$eq: ['$a', 1]}, b: {$elemMatch: {c: 1}}, d: /x/, 'e.f': 1, g: 1, h: {$gt: 1}}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto matcher = MatchExpressionParser::parse(matchPredicate, std::move(expCtx));
+    ASSERT_OK(matcher.getStatus());
+
+    expression::orderAndChildrenByEvaluationCost(matcher.getValue().get());
+
+    const auto root = matcher.getValue().get();
+    ASSERT_EQ(root->matchType(), MatchExpression::AND);
+    ASSERT_EQ(root->numChildren(), 6U);
+    ASSERT_EQ(root->getChild(0)->path(), "g");
+    ASSERT_EQ(root->getChild(1)->path(), "h");
+    ASSERT_EQ(root->getChild(2)->path(), "e.f");
+    ASSERT_EQ(root->getChild(3)->path(), "d");
+    ASSERT_EQ(root->getChild(4)->path(), "b");
+    ASSERT_EQ(root->getChild(5)->matchType(), MatchExpression::EXPRESSION);
+}
+
+TEST(OrderAndChildrenByEvaluationCost, OrdersNestedAndsByTheirMostExpensiveChild) {
+    BSONObj matchPredicate =
+        fromjson("{$or: [{a: /x/, b: 1}, {c: 1}], d: 1, $and: [{e: 1}, {'f.g': 1}]}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto matcher = MatchExpressionParser::parse(matchPredicate, std::move(expCtx));
+    ASSERT_OK(matcher.getStatus());
+
+    expression::orderAndChildrenByEvaluationCost(matcher.getValue().get());
+
+    const auto root = matcher.getValue().get();
+    ASSERT_EQ(root->numChildren(), 3U);
+    ASSERT_EQ(root->getChild(0)->path(), "d");
+    ASSERT_EQ(root->getChild(1)->matchType(), MatchExpression::AND);
+    ASSERT_EQ(root->getChild(1)->getChild(0)->path(), "e");
+    ASSERT_EQ(root->getChild(2)->matchType(), MatchExpression::OR);
+    ASSERT_EQ(root->getChild(2)->getChild(0)->getChild(0)->path(), "b");
+    ASSERT_EQ(root->getChild(2)->getChild(0)->getChild(1)->path(), "a");
+}
+
 TEST(MapOverMatchExpression, DoesMapOverLogicalNodes) {
     BSONObj matchPredicate = fromjson("{a: {$not: {$eq: 1}}}");
     boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
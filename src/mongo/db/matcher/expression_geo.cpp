@@ -37,6 +37,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/platform/basic.h"
 #include "mongo/util/str.h"
+#include "third_party/s2/s2regioncoverer.h"
 
 namespace mongo {
 
@@ -96,6 +97,22 @@ Status GeoExpression::parseQuery(const BSONObj& obj) {
     return Status::OK();
 }
 
+std::vector<S2CellId> GeoExpression::getS2Covering(int minLevel, int maxLevel, int maxCells) const {
+    stdx::lock_guard<Latch> lk(s2CoveringMutex);
+    if (!s2Covering || s2Covering->minLevel != minLevel || s2Covering->maxLevel != maxLevel ||
+        s2Covering->maxCells != maxCells) {
+        S2RegionCoverer coverer;
+        coverer.set_min_level(minLevel);
+        coverer.set_max_level(maxLevel);
+        coverer.set_max_cells(maxCells);
+
+        std::vector<S2CellId> cells;
+        coverer.GetCovering(geoContainer->getS2Region(), &cells);
+        s2Covering = S2Covering{minLevel, maxLevel, maxCells, std::move(cells)};
+    }
+    return s2Covering->cells;
+}
+
 Status GeoExpression::parseFrom(const BSONObj& obj) {
     // Initialize geoContainer and parse BSON object
     Status status = parseQuery(obj);
@@ -30,11 +30,15 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/db/geo/geometry_container.h"
 #include "mongo/db/geo/geoparser.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/platform/mutex.h"
+#include "third_party/s2/s2cellid.h"
 
 namespace mongo {
 
@@ -65,7 +69,21 @@ public:
         return *geoContainer;
     }
 
+    /**
+     * Returns the covering of the geometry's S2 region with the given coverer parameters. The
+     * covering is computed once and then reused while the parameters stay the same, since bounds
+     * are built from it for every candidate 2dsphere index and plan, and again on replanning.
+     */
+    std::vector<S2CellId> getS2Covering(int minLevel, int maxLevel, int maxCells) const;
+
 private:
+    struct S2Covering {
+        int minLevel;
+        int maxLevel;
+        int maxCells;
+        std::vector<S2CellId> cells;
+    };
+
     // Parse geospatial query
     // e.g.
     // { "$intersect" : { "$geometry" : { "type" : "Point", "coordinates": [ 40, 5 ] } } }
@@ -75,6 +93,10 @@ private:
     std::string field;
     std::unique_ptr<GeometryContainer> geoContainer;
     Predicate predicate;
+
+    // Guards 's2Covering', as the expression may be shared by clones of its match expression.
+    mutable Mutex s2CoveringMutex = MONGO_MAKE_LATCH("GeoExpression::s2CoveringMutex");
+    mutable boost::optional<S2Covering> s2Covering;
 };
 
 class GeoMatchExpression : public LeafMatchExpression {
@@ -182,4 +182,23 @@ TEST(ExpressionGeoTest, GeoNearNotEquivalent) {
         gne2(makeGeoNearMatchExpression(query2));
     ASSERT(!gne1->equivalent(gne2.get()));
 }
+
+TEST(ExpressionGeoTest, S2CoveringIsCachedPerCovererParams) {
+    BSONObj query = fromjson(
+        "{$within: {$geometry: {type: 'Polygon',"
+        "coordinates: [[[0, 0], [3, 6], [6, 1], [0, 0]]]}}}");
+    std::unique_ptr<GeoMatchExpression> ge(makeGeoMatchExpression(query));
+    const GeoExpression& geoExpr = ge->getGeoExpression();
+
+    const auto covering = geoExpr.getS2Covering(0, 30, 8);
+    ASSERT_FALSE(covering.empty());
+    ASSERT_LTE(covering.size(), 8U);
+    ASSERT(covering == geoExpr.getS2Covering(0, 30, 8));
+
+    // Different coverer parameters produce a new covering rather than the cached one.
+    const auto coarseCovering = geoExpr.getS2Covering(0, 30, 1);
+    ASSERT_LTE(coarseCovering.size(), 1U);
+    ASSERT(coarseCovering != covering);
+    ASSERT(covering == geoExpr.getS2Covering(0, 30, 8));
+}
 }  // namespace mongo
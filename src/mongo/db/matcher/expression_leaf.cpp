@@ -44,6 +44,7 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/path.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/regex_util.h"
 #include "mongo/util/str.h"
 
@@ -220,7 +221,8 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
     : LeafMatchExpression(REGEX, path, std::move(annotation)),
       _regex(regex.toString()),
       _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags))) {
+      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags))),
+      _requiredLiteral(regex_util::requiredLiteral(_regex, _flags)) {
 
     uassert(ErrorCodes::BadValue,
             "Regular expression cannot contain an embedded null byte",
@@ -250,6 +252,11 @@ bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetai
             // pcrecpp::StringPiece instance using the full length of the string to avoid truncating
             // 'data' early.
             pcrecpp::StringPiece data(e.valuestr(), e.valuestrsize() - 1);
+            if (!_requiredLiteral.empty() &&
+                std::string_view(data.data(), data.size()).find(_requiredLiteral) ==
+                    std::string_view::npos) {
+                return false;
+            }
             return _re->PartialMatch(data);
         }
         case RegEx:
@@ -383,8 +390,10 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasNull = _hasNull;
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
+    next->_equalityHashSet = _equalityHashSet;
     next->_originalEqualityVector = _originalEqualityVector;
     next->_equalityStorage = _equalityStorage;
+    next->_inputParamId = _inputParamId;
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
             static_cast<RegexMatchExpression*>(regex->shallowClone().release()));
@@ -394,6 +403,9 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
 }
 
 bool InMatchExpression::contains(const BSONElement& e) const {
+    if (_equalityHashSet) {
+        return _equalityHashSet->set.count(e) > 0;
+    }
     return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
 }
 
@@ -507,6 +519,7 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+    _updateEqualityHashSet();
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -540,10 +553,24 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+    _updateEqualityHashSet();
 
     return Status::OK();
 }
 
+void InMatchExpression::_updateEqualityHashSet() {
+    const auto minSize = internalQueryInHashSetMinSize.load();
+    if (minSize == 0 || _equalitySet.size() < static_cast<size_t>(minSize)) {
+        _equalityHashSet.reset();
+        return;
+    }
+
+    auto hashSet = std::make_shared<EqualityHashSet>(_collator);
+    hashSet->set.reserve(_equalitySet.size());
+    hashSet->set.insert(_equalitySet.begin(), _equalitySet.end());
+    _equalityHashSet = std::move(hashSet);
+}
+
 void InMatchExpression::setBackingBSON(BSONObj equalityStorage) {
     _equalityStorage = std::move(equalityStorage);
 }
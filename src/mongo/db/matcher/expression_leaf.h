@@ -155,6 +155,25 @@ public:
         return _collator;
     }
 
+    void setInputParamId(InputParamId paramId) {
+        _inputParamId = paramId;
+    }
+
+    boost::optional<InputParamId> getInputParamId() const {
+        return _inputParamId;
+    }
+
+    /**
+     * Replaces the RHS element of this expression with a copy of 'elem', so that, unlike with
+     * 'setData()', the expression does not depend on the lifetime of the BSON backing 'elem'.
+     */
+    void setOwnedData(const BSONElement& elem) {
+        BSONObjBuilder bob;
+        bob.appendAs(elem, path());
+        _backingBSON = bob.obj();
+        _rhs = _backingBSON.firstElement();
+    }
+
 protected:
     /**
      * 'collator' must outlive the ComparisonMatchExpression and any clones made of it.
@@ -170,6 +189,9 @@ protected:
     // Collator used to compare elements. By default, simple binary comparison will be used.
     const CollatorInterface* _collator = nullptr;
 
+    // Set when the RHS has been replaced by an input parameter by 'expression::parameterize()'.
+    boost::optional<InputParamId> _inputParamId;
+
 private:
     ExpressionOptimizerFunc getOptimizer() const final {
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
@@ -234,6 +256,9 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        if (getInputParamId()) {
+            e->setInputParamId(*getInputParamId());
+        }
         return e;
     }
 
@@ -270,6 +295,9 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        if (getInputParamId()) {
+            e->setInputParamId(*getInputParamId());
+        }
         return e;
     }
 
@@ -306,6 +334,9 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        if (getInputParamId()) {
+            e->setInputParamId(*getInputParamId());
+        }
         return e;
     }
 
@@ -347,6 +378,9 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        if (getInputParamId()) {
+            e->setInputParamId(*getInputParamId());
+        }
         return e;
     }
 
@@ -387,6 +421,9 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        if (getInputParamId()) {
+            e->setInputParamId(*getInputParamId());
+        }
         return e;
     }
 
@@ -467,6 +504,10 @@ private:
     std::string _regex;
     std::string _flags;
     std::unique_ptr<pcrecpp::RE> _re;
+
+    // A literal that every matching string contains, or empty. Checking for it first spares
+    // running the regex on strings which cannot match.
+    std::string _requiredLiteral;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -610,6 +651,14 @@ public:
         return _hasEmptyArray;
     }
 
+    void setInputParamId(InputParamId paramId) {
+        _inputParamId = paramId;
+    }
+
+    boost::optional<InputParamId> getInputParamId() const {
+        return _inputParamId;
+    }
+
     void acceptVisitor(MatchExpressionMutableVisitor* visitor) final {
         visitor->visit(this);
     }
@@ -619,8 +668,27 @@ public:
     }
 
 private:
+    /**
+     * A hash set of the equalities, along with the comparator that defines its equivalence
+     * classes, which the set refers to.
+     */
+    struct EqualityHashSet {
+        explicit EqualityHashSet(const CollatorInterface* collator)
+            : eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, collator),
+              set(eltCmp.makeBSONEltUnorderedSet()) {}
+
+        const BSONElementComparator eltCmp;
+        BSONEltUnorderedSet set;
+    };
+
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    /**
+     * Rebuilds '_equalityHashSet' from '_equalitySet', or drops it if there are too few
+     * equalities for hashing to pay off.
+     */
+    void _updateEqualityHashSet();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -644,16 +712,23 @@ private:
     // support std::binary_search. Because we need to sort the elements anyway for things like index
     // bounds building, using binary search avoids the overhead of inserting into a hash table which
     // doesn't pay for itself in the common case where lookups are done a few times if ever.
-    // TODO It may be worth dynamically creating a hashset after matchesSingleElement() has been
-    // called "many" times.
     std::vector<BSONElement> _equalitySet;
 
+    // The same equalities in a hash set, built only when there are at least
+    // 'internalQueryInHashSetMinSize' of them. Very large $in lists are typically matched against
+    // many documents, where a hash lookup beats a binary search. Clones share the set.
+    std::shared_ptr<const EqualityHashSet> _equalityHashSet;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 
     // When this $in is generated internally, e.g. via a rewrite, this is where we store the
     // data of the corresponding equality elements.
     BSONObj _equalityStorage;
+
+    // Set when the equalities have been replaced by an input parameter by
+    // 'expression::parameterize()'.
+    boost::optional<InputParamId> _inputParamId;
 };
 
 /**
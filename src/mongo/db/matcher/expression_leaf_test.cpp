@@ -37,7 +37,9 @@
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
+#include "mongo/util/regex_util.h"
 
 namespace mongo {
 
@@ -1013,6 +1015,41 @@ TEST(RegexMatchExpression, RegexAcceptsLFOption) {
                                      << "a\rb")));
 }
 
+TEST(RegexMatchExpression, RequiredLiteralIsOnlyExtractedWhenEveryMatchContainsIt) {
+    ASSERT_EQ(regex_util::requiredLiteral("error.*timeout", ""), "timeout");
+    ASSERT_EQ(regex_util::requiredLiteral("^abc", "m"), "abc");
+    ASSERT_EQ(regex_util::requiredLiteral("abcd?e", ""), "abc");
+    ASSERT_EQ(regex_util::requiredLiteral("ab+c", ""), "ab");
+    ASSERT_EQ(regex_util::requiredLiteral("xa{2,3}yz", ""), "yz");
+    ASSERT_EQ(regex_util::requiredLiteral("a\\.b(cdef)?g", ""), "a.b");
+    ASSERT_EQ(regex_util::requiredLiteral("[abcdef]x\\d", ""), "x");
+    ASSERT_EQ(regex_util::requiredLiteral("abc|def", ""), "");
+    ASSERT_EQ(regex_util::requiredLiteral("abc", "i"), "");
+    ASSERT_EQ(regex_util::requiredLiteral("a b c", "x"), "");
+    ASSERT_EQ(regex_util::requiredLiteral("(?i)abc", ""), "");
+    ASSERT_EQ(regex_util::requiredLiteral("\\Qa|b\\E", ""), "");
+}
+
+TEST(RegexMatchExpression, RequiredLiteralDoesNotChangeMatches) {
+    RegexMatchExpression regex("a", "error.*timeout", "");
+    ASSERT(regex.matchesBSON(BSON("a"
+                                  << "error: read timeout")));
+    ASSERT(!regex.matchesBSON(BSON("a"
+                                   << "error: read timed out")));
+
+    RegexMatchExpression optional("a", "colou?r", "");
+    ASSERT(optional.matchesBSON(BSON("a"
+                                     << "color")));
+    ASSERT(optional.matchesBSON(BSON("a"
+                                     << "colour")));
+
+    RegexMatchExpression multiByte("a", "x\u304C*y", "");
+    ASSERT(multiByte.matchesBSON(BSON("a"
+                                      << "xy")));
+    ASSERT(multiByte.matchesBSON(BSON("a"
+                                      << "x\u304C\u304Cy")));
+}
+
 TEST(ModMatchExpression, MatchesElement) {
     BSONObj match = BSON("a" << 1);
     BSONObj largerMatch = BSON("a" << 4.0);
@@ -1372,6 +1409,44 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, HashedEqualitiesMatchLikeSortedEqualities) {
+    RAIIServerParameterControllerForTest hashSetMinSize("internalQueryInHashSetMinSize", 2);
+    BSONArray operand = BSON_ARRAY(1 << 2.5 << "string" << BSON("x" << 1));
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities;
+    for (auto&& elem : operand) {
+        equalities.push_back(elem);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 1.0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 1LL)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 2.5)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << BSON("x" << 1.0))["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 2)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "string2")["a"]));
+
+    auto clone = in.shallowClone();
+    ASSERT(clone->matchesSingleElement(BSON("a"
+                                            << "string")["a"]));
+}
+
+TEST(InMatchExpression, HashedEqualitiesRespectCollation) {
+    RAIIServerParameterControllerForTest hashSetMinSize("internalQueryInHashSetMinSize", 1);
+    BSONObj obj1 = BSON(""
+                        << "string1");
+    BSONObj obj2 = BSON(""
+                        << "string2");
+    CollatorInterfaceMock collatorAlwaysEqual(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities{obj1.firstElement()};
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT(!in.contains(obj2.firstElement()));
+    in.setCollator(&collatorAlwaysEqual);
+    ASSERT(in.contains(obj2.firstElement()));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -0,0 +1,209 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/expression_parameterization.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/matcher/expression_leaf.h"
+
+namespace mongo::expression {
+namespace {
+using InputParamId = MatchExpression::InputParamId;
+
+/**
+ * Returns whether the children of 'expr' may hold parameterized predicates.
+ */
+bool canHoldInputParams(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+        case MatchExpression::ELEM_MATCH_OBJECT:
+        case MatchExpression::ELEM_MATCH_VALUE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isParameterizableType(const MatchExpression* expr) {
+    return ComparisonMatchExpression::isComparisonMatchExpression(expr) ||
+        expr->matchType() == MatchExpression::MATCH_IN;
+}
+
+bool isParameterizableValue(const BSONElement& elem) {
+    switch (elem.type()) {
+        case BSONType::Array:
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+        case BSONType::RegEx:
+        case BSONType::MinKey:
+        case BSONType::MaxKey:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool isParameterizable(const MatchExpression* expr) {
+    if (expr->matchType() == MatchExpression::MATCH_IN) {
+        auto inExpr = static_cast<const InMatchExpression*>(expr);
+        if (!inExpr->getRegexes().empty() || inExpr->hasNull() || inExpr->hasEmptyArray()) {
+            return false;
+        }
+        const auto& equalities = inExpr->getEqualities();
+        return std::all_of(equalities.begin(), equalities.end(), isParameterizableValue);
+    }
+    return isParameterizableValue(static_cast<const ComparisonMatchExpression*>(expr)->getData());
+}
+
+void setInputParamId(MatchExpression* expr, InputParamId paramId) {
+    if (expr->matchType() == MatchExpression::MATCH_IN) {
+        static_cast<InMatchExpression*>(expr)->setInputParamId(paramId);
+    } else {
+        static_cast<ComparisonMatchExpression*>(expr)->setInputParamId(paramId);
+    }
+}
+
+/**
+ * Calls 'fn' on every predicate of the tree rooted at 'expr' which may be parameterized.
+ */
+template <typename Expr, typename Fn>
+void walkParameterizable(Expr* expr, const Fn& fn) {
+    if (canHoldInputParams(expr)) {
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            walkParameterizable(static_cast<Expr*>(expr->getChild(i)), fn);
+        }
+    } else if (isParameterizableType(expr)) {
+        fn(expr);
+    }
+}
+}  // namespace
+
+std::vector<const MatchExpression*> parameterize(MatchExpression* tree) {
+    std::vector<const MatchExpression*> inputParams;
+    std::vector<MatchExpression*> newParams;
+    walkParameterizable(tree, [&](MatchExpression* expr) {
+        if (auto paramId = getInputParamId(expr)) {
+            if (static_cast<size_t>(*paramId) >= inputParams.size()) {
+                inputParams.resize(*paramId + 1, nullptr);
+            }
+            inputParams[*paramId] = expr;
+        } else if (isParameterizable(expr)) {
+            newParams.push_back(expr);
+        }
+    });
+
+    for (auto expr : newParams) {
+        setInputParamId(expr, static_cast<InputParamId>(inputParams.size()));
+        inputParams.push_back(expr);
+    }
+    return inputParams;
+}
+
+boost::optional<InputParamId> getInputParamId(const MatchExpression* expr) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        return static_cast<const ComparisonMatchExpression*>(expr)->getInputParamId();
+    } else if (expr->matchType() == MatchExpression::MATCH_IN) {
+        return static_cast<const InMatchExpression*>(expr)->getInputParamId();
+    }
+    return boost::none;
+}
+
+bool equivalentModuloInputParams(const MatchExpression* lhs, const MatchExpression* rhs) {
+    if (lhs->matchType() != rhs->matchType() || lhs->numChildren() != rhs->numChildren()) {
+        return false;
+    }
+
+    auto lhsParamId = getInputParamId(lhs);
+    if (lhsParamId || getInputParamId(rhs)) {
+        return lhsParamId == getInputParamId(rhs) && lhs->path() == rhs->path();
+    }
+
+    if (!canHoldInputParams(lhs)) {
+        return lhs->equivalent(rhs);
+    }
+
+    if (lhs->path() != rhs->path()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs->numChildren(); ++i) {
+        if (!equivalentModuloInputParams(lhs->getChild(i), rhs->getChild(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool bindInputParams(const std::vector<const MatchExpression*>& inputParams,
+                     MatchExpression* tree) {
+    bool bound = true;
+    walkParameterizable(tree, [&](MatchExpression* expr) {
+        auto paramId = getInputParamId(expr);
+        if (!paramId || !bound) {
+            return;
+        }
+
+        const MatchExpression* source = static_cast<size_t>(*paramId) < inputParams.size()
+            ? inputParams[*paramId]
+            : nullptr;
+        if (!source || source->matchType() != expr->matchType() ||
+            source->path() != expr->path()) {
+            bound = false;
+            return;
+        }
+
+        if (expr->matchType() == MatchExpression::MATCH_IN) {
+            BSONArrayBuilder storageBuilder;
+            for (auto&& equality : static_cast<const InMatchExpression*>(source)->getEqualities()) {
+                storageBuilder.append(equality);
+            }
+            auto storage = storageBuilder.arr();
+
+            std::vector<BSONElement> equalities;
+            for (auto&& equality : storage) {
+                equalities.push_back(equality);
+            }
+
+            auto inExpr = static_cast<InMatchExpression*>(expr);
+            invariant(inExpr->setEqualities(std::move(equalities)));
+            inExpr->setBackingBSON(std::move(storage));
+        } else {
+            static_cast<ComparisonMatchExpression*>(expr)->setOwnedData(
+                static_cast<const ComparisonMatchExpression*>(source)->getData());
+        }
+    });
+    return bound;
+}
+
+}  // namespace mongo::expression
@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo::expression {
+
+/**
+ * Assigns input parameter ids to the constants of those predicates of 'tree' which can be re-bound
+ * to other constants without changing the plans built for 'tree', and returns a vector mapping
+ * each id to the predicate holding it.
+ *
+ * The parameterized predicates are the $eq, $lt, $lte, $gt, $gte and $in predicates found under
+ * logical operators, $not and $elemMatch, except for those whose constants get special treatment in
+ * planning, namely null, undefined, arrays, regular expressions, MinKey and MaxKey.
+ *
+ * Predicates which already have an id, such as those of a tree cloned from a parameterized one,
+ * keep it, and new ids are allocated past the largest id in use. Ids which are not used by 'tree'
+ * map to nullptr.
+ */
+std::vector<const MatchExpression*> parameterize(MatchExpression* tree);
+
+/**
+ * Returns the input parameter id of 'expr', if it has been parameterized.
+ */
+boost::optional<MatchExpression::InputParamId> getInputParamId(const MatchExpression* expr);
+
+/**
+ * Returns true if 'lhs' and 'rhs' only differ by the constants of their parameterized predicates,
+ * i.e. if 'rhs' can be evaluated by re-binding the input parameters of a plan built for 'lhs'.
+ */
+bool equivalentModuloInputParams(const MatchExpression* lhs, const MatchExpression* rhs);
+
+/**
+ * Replaces the constants of the parameterized predicates of 'tree' with copies of those of the
+ * predicates with the same input parameter ids in 'inputParams', which is the result of
+ * 'parameterize()' for another query. Returns false if one of the parameterized predicates of
+ * 'tree' has no counterpart of the same kind over the same path, in which case 'tree' may have been
+ * partially re-bound.
+ */
+bool bindInputParams(const std::vector<const MatchExpression*>& inputParams,
+                     MatchExpression* tree);
+
+}  // namespace mongo::expression
@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_parameterization.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& obj) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = MatchExpressionParser::parse(obj, std::move(expCtx));
+    ASSERT_OK(expr.getStatus());
+    return MatchExpression::normalize(std::move(expr.getValue()));
+}
+
+TEST(ExpressionParameterizationTest, ParameterizesComparisonsAndIn) {
+    auto expr = parse(fromjson("{a: 1, b: {$gt: 'x'}, c: {$in: [1, 2]}, d: {$lte: 3}}"));
+    auto inputParams = expression::parameterize(expr.get());
+    ASSERT_EQ(inputParams.size(), 4U);
+
+    for (size_t i = 0; i < inputParams.size(); ++i) {
+        ASSERT(inputParams[i]);
+        auto paramId = expression::getInputParamId(inputParams[i]);
+        ASSERT(paramId);
+        ASSERT_EQ(*paramId, static_cast<MatchExpression::InputParamId>(i));
+    }
+}
+
+TEST(ExpressionParameterizationTest, DoesNotParameterizeSpecialConstants) {
+    auto expr = parse(fromjson("{a: null, b: [1, 2], c: {$lt: {$maxKey: 1}}, d: {$in: [1, null]}, "
+                               "e: {$in: [1, /x/]}, f: {$exists: true}}"));
+    ASSERT(expression::parameterize(expr.get()).empty());
+}
+
+TEST(ExpressionParameterizationTest, ParameterizesUnderLogicalAndArrayOperators) {
+    auto expr = parse(fromjson(
+        "{$or: [{a: 1}, {b: {$not: {$gt: 2}}}, {c: {$elemMatch: {$gte: 3}}}, {d: {$elemMatch: "
+        "{e: 4}}}]}"));
+    ASSERT_EQ(expression::parameterize(expr.get()).size(), 4U);
+}
+
+TEST(ExpressionParameterizationTest, ClonesKeepTheirInputParamIds) {
+    auto expr = parse(fromjson("{a: 1, b: 2}"));
+    auto inputParams = expression::parameterize(expr.get());
+    ASSERT_EQ(inputParams.size(), 2U);
+
+    // Parameterizing a subtree of a clone leaves the ids untouched, and leaves a hole for the id
+    // of the predicate which is not part of the subtree.
+    auto clone = expr->getChild(1)->shallowClone();
+    auto cloneInputParams = expression::parameterize(clone.get());
+    ASSERT_EQ(cloneInputParams.size(), 2U);
+    ASSERT_FALSE(cloneInputParams[0]);
+    ASSERT(cloneInputParams[1]);
+    ASSERT_EQ(cloneInputParams[1]->path(), "b"_sd);
+}
+
+TEST(ExpressionParameterizationTest, BindReplacesConstants) {
+    auto planned = parse(fromjson("{a: 1, b: {$in: [1, 2]}}"));
+    expression::parameterize(planned.get());
+
+    auto other = parse(fromjson("{a: 5, b: {$in: [3, 4, 5]}}"));
+    auto inputParams = expression::parameterize(other.get());
+    ASSERT_TRUE(expression::equivalentModuloInputParams(planned.get(), other.get()));
+
+    auto bound = planned->shallowClone();
+    ASSERT_TRUE(expression::bindInputParams(inputParams, bound.get()));
+    ASSERT_TRUE(bound->equivalent(other.get()));
+
+    // The bound expression owns its constants.
+    other.reset();
+    ASSERT_TRUE(bound->matchesBSON(BSON("a" << 5 << "b" << 4)));
+    ASSERT_FALSE(bound->matchesBSON(BSON("a" << 1 << "b" << 1)));
+}
+
+TEST(ExpressionParameterizationTest, BindFailsForDifferentShapes) {
+    auto planned = parse(fromjson("{a: 1}"));
+    expression::parameterize(planned.get());
+
+    auto otherPath = parse(fromjson("{b: 1}"));
+    auto inputParams = expression::parameterize(otherPath.get());
+    ASSERT_FALSE(expression::equivalentModuloInputParams(planned.get(), otherPath.get()));
+    ASSERT_FALSE(expression::bindInputParams(inputParams, planned.get()));
+
+    // A constant which is not parameterized cannot be bound.
+    auto otherNull = parse(fromjson("{a: null}"));
+    ASSERT(expression::parameterize(otherNull.get()).empty());
+    ASSERT_FALSE(expression::equivalentModuloInputParams(planned.get(), otherNull.get()));
+}
+
+TEST(ExpressionParameterizationTest, NonParameterizedConstantsMustBeEqual) {
+    auto planned = parse(fromjson("{$or: [{a: 1}, {a: null}]}"));
+    expression::parameterize(planned.get());
+
+    auto same = parse(fromjson("{$or: [{a: 2}, {a: null}]}"));
+    expression::parameterize(same.get());
+    ASSERT_TRUE(expression::equivalentModuloInputParams(planned.get(), same.get()));
+
+    auto different = parse(fromjson("{$or: [{a: 2}, {a: [1, 2]}]}"));
+    expression::parameterize(different.get());
+    ASSERT_FALSE(expression::equivalentModuloInputParams(planned.get(), different.get()));
+}
+
+}  // namespace
+}  // namespace mongo
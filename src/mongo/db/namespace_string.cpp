@@ -171,6 +171,8 @@ bool NamespaceString::isLegalClientSystemNS(
         return true;
     if (coll() == kSystemDotViewsCollectionName)
         return true;
+    if (coll() == "system.statistics")
+        return true;
     if (currentFCV.isGreaterThanOrEqualTo(
             ServerGlobalParams::FeatureCompatibility::Version::kVersion47) &&
         // While this FCV check is being added in 4.9, the namespace was allowed in 4.7 binaries
@@ -33,6 +33,7 @@
 
 #include "mongo/db/op_observer_impl.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "mongo/bson/bsonobjbuilder.h"
@@ -41,10 +42,12 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/import_collection_oplog_entry_gen.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/dbhelpers.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keys_collection_document_gen.h"
 #include "mongo/db/logical_time_validator.h"
@@ -274,9 +277,45 @@ void writeToImageCollection(OperationContext* opCtx,
     repl::UnreplicatedWritesBlock unreplicated(opCtx);
     AutoGetCollection imageCollectionRaii(
         opCtx, NamespaceString::kConfigImagesNamespace, LockMode::MODE_IX);
-    UpdateResult res = Helpers::upsert(
-        opCtx, NamespaceString::kConfigImagesNamespace.toString(), imageEntry.toBSON());
-    invariant(res.numDocsModified == 1 || !res.upsertedId.isEmpty());
+    const auto image = imageEntry.toBSON();
+    const auto& imageCollection = imageCollectionRaii.getCollection();
+    const IndexDescriptor* idIndex =
+        imageCollection ? imageCollection->getIndexCatalog()->findIdIndex(opCtx) : nullptr;
+    if (!idIndex) {
+        // Let the upsert create the collection, or deal with it having no _id index.
+        UpdateResult res =
+            Helpers::upsert(opCtx, NamespaceString::kConfigImagesNamespace.toString(), image);
+        invariant(res.numDocsModified == 1 || !res.upsertedId.isEmpty());
+        return;
+    }
+
+    // A session has one image at a time, which replaces the one it had before. The image is
+    // written directly, as the session table is, since an upsert would cost a lot more in query
+    // planning than the write itself.
+    const auto idDoc = image[repl::ImageEntry::k_idFieldName].wrap();
+    auto recordId = imageCollection->getIndexCatalog()
+                        ->getEntry(idIndex)
+                        ->accessMethod()
+                        ->findSingle(opCtx, imageCollection, idDoc);
+    if (recordId.isNull()) {
+        uassertStatusOK(
+            imageCollection->insertDocument(opCtx, InsertStatement(image), nullptr, false));
+        return;
+    }
+
+    auto startingSnapshotId = opCtx->recoveryUnit()->getSnapshotId();
+    auto originalDoc = imageCollection->getRecordStore()->dataFor(opCtx, recordId).toBson();
+    CollectionUpdateArgs args;
+    args.update = image;
+    args.criteria = idDoc;
+    imageCollection->updateDocument(
+        opCtx,
+        recordId,
+        Snapshotted<BSONObj>(startingSnapshotId, originalDoc),
+        image,
+        imageCollection->getIndexCatalog()->numIndexesTotal(opCtx) > 1,
+        nullptr,
+        &args);
 }
 
 }  // namespace
@@ -1125,6 +1164,22 @@ void OpObserverImpl::onEmptyCapped(OperationContext* opCtx,
 }
 
 namespace {
+// Returns how large the 'applyOps' array packing the given transaction statements can grow, so
+// that the builder of its oplog entry can be sized up front rather than grow while packing.
+int estimateApplyOpsSize(std::vector<repl::ReplOperation>::const_iterator stmtBegin,
+                         std::vector<repl::ReplOperation>::const_iterator stmtEnd) {
+    const size_t maxSize = BSONObjMaxUserSize;
+    size_t size = 0;
+    int numStmts = 0;
+    for (auto stmtIter = stmtBegin; stmtIter != stmtEnd && size < maxSize; ++stmtIter) {
+        if (numStmts++ == gMaxNumberOfTransactionOperationsInSingleOplogEntry) {
+            break;
+        }
+        size += DurableOplogEntry::getDurableReplOperationSize(*stmtIter);
+    }
+    return std::min(size, maxSize);
+}
+
 // Accepts an empty BSON builder and appends the given transaction statements to an 'applyOps' array
 // field. Appends as many operations as possible until either the constructed object exceeds the
 // 16MB limit or the maximum number of transaction statements allowed in one entry.
@@ -1150,7 +1205,7 @@ std::vector<repl::ReplOperation>::iterator packTransactionStatementsForApplyOps(
              (opsArray.len() + DurableOplogEntry::getDurableReplOperationSize(stmt) >
               BSONObjMaxUserSize)))
             break;
-        opsArray.append(stmt.toBSON());
+        opsArray.append(stmt.toBSONForApplyOps());
     }
     try {
         // BSONArrayBuilder will throw a BSONObjectTooLarge exception if we exceeded the max BSON
@@ -1275,6 +1330,7 @@ int logOplogEntriesForTransaction(OperationContext* opCtx,
 
             auto opTime = logOperation(opCtx, &preImageEntry);
             statement.setPreImageOpTime(opTime);
+            statement.discardSerializationForApplyOps();
         }
     }
 
@@ -1285,7 +1341,7 @@ int logOplogEntriesForTransaction(OperationContext* opCtx,
     auto stmtsIter = stmts->begin();
     while (stmtsIter != stmts->end()) {
 
-        BSONObjBuilder applyOpsBuilder;
+        BSONObjBuilder applyOpsBuilder(estimateApplyOpsSize(stmtsIter, stmts->end()));
         auto nextStmt =
             packTransactionStatementsForApplyOps(&applyOpsBuilder, stmtsIter, stmts->end());
 
@@ -1307,6 +1307,36 @@ TEST_F(OpObserverTransactionTest, TransactionalInsertTest) {
     ASSERT_FALSE(oplogEntryObj.hasField("prepare"));
 }
 
+TEST_F(OpObserverTransactionTest, TransactionalInsertSerializedAheadTest) {
+    RAIIServerParameterControllerForTest serializeAhead("transactionSerializeOperationsAhead",
+                                                        true);
+    const NamespaceString nss("testDB", "testColl");
+    auto uuid = CollectionUUID::gen();
+    auto txnParticipant = TransactionParticipant::get(opCtx());
+    txnParticipant.unstashTransactionResources(opCtx(), "insert");
+
+    std::vector<InsertStatement> inserts;
+    inserts.emplace_back(0, BSON("_id" << 0));
+    inserts.emplace_back(1, BSON("_id" << 1));
+    WriteUnitOfWork wuow(opCtx());
+    AutoGetCollection autoColl(opCtx(), nss, MODE_IX);
+    opObserver().onInserts(opCtx(), nss, uuid, inserts.begin(), inserts.end(), false);
+    auto txnOps = txnParticipant.retrieveCompletedTransactionOperations(opCtx());
+    opObserver().onUnpreparedTransactionCommit(opCtx(), &txnOps, 0);
+    auto oplogEntryObj = getSingleOplogEntry(opCtx());
+    checkCommonFields(oplogEntryObj);
+    OplogEntry oplogEntry = assertGet(OplogEntry::parse(oplogEntryObj));
+    auto oExpected = BSON(
+        "applyOps" << BSON_ARRAY(
+            BSON("op"
+                 << "i"
+                 << "ns" << nss.toString() << "ui" << uuid << "o" << BSON("_id" << 0))
+            << BSON("op"
+                    << "i"
+                    << "ns" << nss.toString() << "ui" << uuid << "o" << BSON("_id" << 1))));
+    ASSERT_BSONOBJ_EQ(oExpected, oplogEntry.getObject());
+}
+
 TEST_F(OpObserverTransactionTest, TransactionalUpdateTest) {
     const NamespaceString nss1("testDB", "testColl");
     const NamespaceString nss2("testDB2", "testColl2");
@@ -1749,6 +1779,94 @@ TEST_F(OpObserverTest, TestFundamentalOnUpdateOutputs) {
 }
 
 
+TEST_F(OpObserverTest, RetryableFindAndModifyImageReplacesTheSessionsPreviousImage) {
+    OpObserverRegistry opObserver;
+    opObserver.addObserver(std::make_unique<OpObserverImpl>());
+
+    auto opCtxRaii = cc().makeOperationContext();
+    OperationContext* opCtx = opCtxRaii.get();
+    NamespaceString nss("test", "coll");
+    CollectionUUID uuid = CollectionUUID::gen();
+
+    RAIIServerParameterControllerForTest ffRaii("featureFlagRetryableFindAndModify", true);
+    RAIIServerParameterControllerForTest sideCollectionRaii(
+        "storeFindAndModifyImagesInSideCollection", true);
+    resetOplogAndTransactions(opCtx);
+
+    const auto preImageDoc = BSON("_id" << 0 << "preImage" << true);
+    const auto postImageDoc = BSON("_id" << 0 << "postImage" << true);
+
+    // Runs a retryable findAndModify as 'txnNumber' of 'sessionId', which saves an image of the
+    // kind 'imageType'.
+    auto findAndModify = [&](const LogicalSessionId& sessionId,
+                             TxnNumber txnNumber,
+                             StoreDocOption imageType) {
+        opCtx->setLogicalSessionId(sessionId);
+        opCtx->setTxnNumber(txnNumber);
+        MongoDOperationContextSession contextSession(opCtx);
+        auto txnParticipant = TransactionParticipant::get(opCtx);
+        txnParticipant.beginOrContinue(opCtx, txnNumber, boost::none, boost::none);
+
+        CollectionUpdateArgs updateArgs;
+        updateArgs.stmtIds = {1};
+        updateArgs.preImageDoc = preImageDoc;
+        updateArgs.updatedDoc = postImageDoc;
+        updateArgs.update =
+            BSON("$set" << BSON("postImage" << true) << "$unset" << BSON("preImage" << 1));
+        updateArgs.criteria = BSON("_id" << 0);
+        updateArgs.storeDocOption = imageType;
+        OplogUpdateEntryArgs update(std::move(updateArgs), nss, uuid);
+
+        WriteUnitOfWork wuow(opCtx);
+        AutoGetCollection locks(opCtx, nss, LockMode::MODE_IX);
+        opObserver.onUpdate(opCtx, update);
+        wuow.commit();
+    };
+
+    auto numImages = [&] {
+        AutoGetCollection sideCollection(
+            opCtx, NamespaceString::kConfigImagesNamespace, LockMode::MODE_IS);
+        return sideCollection->getRecordStore()->numRecords(opCtx);
+    };
+
+    // The first image of a session is inserted.
+    const auto sessionId = makeLogicalSessionIdForTest();
+    findAndModify(sessionId, TxnNumber(0), StoreDocOption::PreImage);
+    auto imageEntry = getImageEntryFromSideCollection(opCtx, sessionId);
+    ASSERT(imageEntry.getImageKind() == repl::RetryImageEnum::kPreImage);
+    ASSERT_EQ(TxnNumber(0), imageEntry.getTxnNumber());
+    ASSERT_BSONOBJ_EQ(preImageDoc, imageEntry.getImage());
+    ASSERT_EQ(1, numImages());
+    ASSERT_EQ(TxnNumber(0), getTxnRecord(opCtx, sessionId).getTxnNum());
+
+    // The next one replaces it, along with the session's record.
+    findAndModify(sessionId, TxnNumber(1), StoreDocOption::PostImage);
+    imageEntry = getImageEntryFromSideCollection(opCtx, sessionId);
+    ASSERT(imageEntry.getImageKind() == repl::RetryImageEnum::kPostImage);
+    ASSERT_EQ(TxnNumber(1), imageEntry.getTxnNumber());
+    ASSERT_BSONOBJ_EQ(postImageDoc, imageEntry.getImage());
+    ASSERT_EQ(1, numImages());
+    ASSERT_EQ(TxnNumber(1), getTxnRecord(opCtx, sessionId).getTxnNum());
+
+    findAndModify(sessionId, TxnNumber(2), StoreDocOption::PreImage);
+    imageEntry = getImageEntryFromSideCollection(opCtx, sessionId);
+    ASSERT(imageEntry.getImageKind() == repl::RetryImageEnum::kPreImage);
+    ASSERT_EQ(TxnNumber(2), imageEntry.getTxnNumber());
+    ASSERT_BSONOBJ_EQ(preImageDoc, imageEntry.getImage());
+    ASSERT_EQ(1, numImages());
+    ASSERT_EQ(TxnNumber(2), getTxnRecord(opCtx, sessionId).getTxnNum());
+
+    // Another session gets an image of its own, and leaves the first session's alone.
+    const auto otherSessionId = makeLogicalSessionIdForTest();
+    findAndModify(otherSessionId, TxnNumber(0), StoreDocOption::PostImage);
+    ASSERT_EQ(2, numImages());
+    ASSERT_BSONOBJ_EQ(postImageDoc,
+                      getImageEntryFromSideCollection(opCtx, otherSessionId).getImage());
+    ASSERT_EQ(TxnNumber(2), getImageEntryFromSideCollection(opCtx, sessionId).getTxnNumber());
+    ASSERT_BSONOBJ_EQ(preImageDoc, getImageEntryFromSideCollection(opCtx, sessionId).getImage());
+}
+
+
 struct InsertTestCase {
     bool isRetryableWrite;
     int numDocsToInsert;
@@ -2192,6 +2310,41 @@ TEST_F(OpObserverMultiEntryTransactionTest, TransactionPreImageTest) {
                       oplogEntries[3].getObject());
 }
 
+TEST_F(OpObserverMultiEntryTransactionTest, TransactionPreImageSerializedAheadTest) {
+    RAIIServerParameterControllerForTest serializeAhead("transactionSerializeOperationsAhead",
+                                                        true);
+    const NamespaceString nss1("testDB", "testColl");
+    auto uuid1 = CollectionUUID::gen();
+    auto txnParticipant = TransactionParticipant::get(opCtx());
+    txnParticipant.unstashTransactionResources(opCtx(), "txntest");
+
+    WriteUnitOfWork wuow(opCtx());
+    AutoGetCollection autoColl1(opCtx(), nss1, MODE_IX);
+    const auto deletedDoc = BSON("_id" << 1 << "data"
+                                       << "z");
+    OpObserver::OplogDeleteEntryArgs args;
+    args.deletedDoc = &deletedDoc;
+    args.preImageRecordingEnabledForCollection = true;
+    opObserver().aboutToDelete(opCtx(), nss1, deletedDoc);
+    opObserver().onDelete(opCtx(), nss1, uuid1, 0, args);
+
+    auto txnOps = txnParticipant.retrieveCompletedTransactionOperations(opCtx());
+    opObserver().onUnpreparedTransactionCommit(opCtx(), &txnOps, 1);
+
+    // The operation was serialized before its pre-image was logged, and must still link to it.
+    auto oplogEntryObjs = getNOplogEntries(opCtx(), 2);
+    auto preImageEntry = assertGet(OplogEntry::parse(oplogEntryObjs[0]));
+    ASSERT(preImageEntry.getOpType() == repl::OpTypeEnum::kNoop);
+    ASSERT_BSONOBJ_EQ(deletedDoc, preImageEntry.getObject());
+    ASSERT_BSONOBJ_EQ(BSON("applyOps" << BSON_ARRAY(BSON("op"
+                                                         << "d"
+                                                         << "ns" << nss1.toString() << "ui"
+                                                         << uuid1 << "o" << BSON("_id" << 1)
+                                                         << "preImageOpTime"
+                                                         << preImageEntry.getOpTime()))),
+                      assertGet(OplogEntry::parse(oplogEntryObjs[1])).getObject());
+}
+
 TEST_F(OpObserverMultiEntryTransactionTest, PreparedTransactionPreImageTest) {
     const NamespaceString nss1("testDB", "testColl");
     auto uuid1 = CollectionUUID::gen();
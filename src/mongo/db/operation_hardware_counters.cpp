@@ -0,0 +1,311 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_hardware_counters.h"
+
+#include <boost/optional.hpp>
+
+#if defined(__linux__)
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // defined(__linux__)
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/errno_util.h"
+
+namespace mongo {
+
+void OperationHardwareCounters::Counts::toBson(BSONObjBuilder* builder) const {
+    builder->appendNumber("instructions", instructions);
+    builder->appendNumber("cycles", cycles);
+    builder->appendNumber("cacheMisses", cacheMisses);
+    builder->appendNumber("blockReadBytes", blockReadBytes);
+    builder->appendNumber("blockWriteBytes", blockWriteBytes);
+}
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * The hardware events of the current thread, opened as one perf event group so that they are
+ * scheduled and read together. Opening the group costs several system calls, so it is opened once
+ * per thread and kept counting for the thread's lifetime; operations read it at their boundaries.
+ */
+class ThreadEventGroup {
+public:
+    ThreadEventGroup() {
+        static constexpr std::array<std::uint64_t, kNumEvents> kEvents = {
+            PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES};
+
+        _fds.fill(-1);
+        for (size_t i = 0; i < kNumEvents; ++i) {
+            _fds[i] = _openEvent(kEvents[i], i == 0 ? -1 : _fds[0]);
+            if (_fds[i] < 0) {
+                _error = errno;
+                _close();
+                return;
+            }
+        }
+    }
+
+    ~ThreadEventGroup() {
+        _close();
+    }
+
+    bool isValid() const {
+        return _fds[0] >= 0;
+    }
+
+    int getError() const {
+        return _error;
+    }
+
+    /**
+     * Returns the events counted on this thread since the group was opened, or zeros if it could
+     * not be opened.
+     */
+    OperationHardwareCounters::Counts read() const {
+        OperationHardwareCounters::Counts counts;
+        if (!isValid()) {
+            return counts;
+        }
+
+        struct {
+            std::uint64_t nr;
+            std::uint64_t values[kNumEvents];
+        } buf;
+        if (::read(_fds[0], &buf, sizeof(buf)) != sizeof(buf) || buf.nr != kNumEvents) {
+            return counts;
+        }
+
+        counts.instructions = static_cast<long long>(buf.values[0]);
+        counts.cycles = static_cast<long long>(buf.values[1]);
+        counts.cacheMisses = static_cast<long long>(buf.values[2]);
+        return counts;
+    }
+
+private:
+    static constexpr size_t kNumEvents = 3;
+
+    static int _openEvent(std::uint64_t config, int groupFd) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        return static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+    }
+
+    void _close() {
+        for (auto& fd : _fds) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+    std::array<int, kNumEvents> _fds;
+    int _error = 0;
+};
+
+const ThreadEventGroup& getThreadEventGroup() {
+    static thread_local ThreadEventGroup group;
+    return group;
+}
+
+/**
+ * Adds the bytes this thread caused to be read from and written to the block layer, as reported
+ * by /proc/thread-self/io. The counts are left unchanged if the file is not available.
+ */
+void appendThreadBlockIO(OperationHardwareCounters::Counts* counts) {
+    int fd = ::open("/proc/thread-self/io", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+
+    char buf[512];
+    auto n = ::read(fd, buf, sizeof(buf) - 1);
+    ::close(fd);
+    if (n <= 0) {
+        return;
+    }
+    buf[n] = '\0';
+
+    auto parseField = [&](const char* name, long long* out) {
+        // Match the field at the start of a line, so that "read_bytes" does not match the tail of
+        // "cancelled_write_bytes".
+        for (const char* p = buf; (p = std::strstr(p, name)); p += std::strlen(name)) {
+            if (p == buf || p[-1] == '\n') {
+                *out += std::strtoll(p + std::strlen(name), nullptr, 10);
+                return;
+            }
+        }
+    };
+    parseField("read_bytes:", &counts->blockReadBytes);
+    parseField("write_bytes:", &counts->blockWriteBytes);
+}
+
+class PerfEventCounters final : public OperationHardwareCounters {
+public:
+    Counts getCounts() const override;
+
+    void start() override;
+    void stop() override;
+
+    void onThreadAttach() override;
+    void onThreadDetach() override;
+
+private:
+    bool _countersAreRunning() const;
+    bool _isAttachedToCurrentThread() const;
+
+    // Returns the counts observed since the creation of the current thread.
+    Counts _getThreadCounts() const;
+
+    // Holds the value returned by `_getThreadCounts()` at the time of starting/resuming counting.
+    boost::optional<Counts> _startedOn;
+    boost::optional<stdx::thread::id> _threadId;
+    Counts _countsBeforeInterrupted;
+};
+
+OperationHardwareCounters::Counts PerfEventCounters::getCounts() const {
+    invariant(_isAttachedToCurrentThread(), "Not attached to current thread");
+    auto counts = _countsBeforeInterrupted;
+    if (_countersAreRunning()) {
+        counts += _getThreadCounts();
+        counts -= _startedOn.get();
+    }
+    return counts;
+}
+
+bool PerfEventCounters::_countersAreRunning() const {
+    return _startedOn.has_value();
+}
+
+bool PerfEventCounters::_isAttachedToCurrentThread() const {
+    return _threadId.has_value() && _threadId.get() == stdx::this_thread::get_id();
+}
+
+void PerfEventCounters::start() {
+    invariant(!_countersAreRunning(), "Counters have already started");
+
+    _startedOn = _getThreadCounts();
+    _threadId = stdx::this_thread::get_id();
+    _countsBeforeInterrupted = Counts();
+}
+
+void PerfEventCounters::stop() {
+    invariant(_countersAreRunning(), "Counters are not running");
+    invariant(_isAttachedToCurrentThread());
+
+    _countsBeforeInterrupted = getCounts();
+    _startedOn.reset();
+}
+
+void PerfEventCounters::onThreadAttach() {
+    if (!_countersAreRunning())
+        return;
+
+    invariant(!_threadId.has_value(), "Counters have already been attached");
+    _threadId = stdx::this_thread::get_id();
+    _startedOn = _getThreadCounts();
+}
+
+void PerfEventCounters::onThreadDetach() {
+    if (!_countersAreRunning())
+        return;
+
+    invariant(_threadId.has_value(), "Counters are not attached");
+    _threadId.reset();
+    _countsBeforeInterrupted += _getThreadCounts();
+    _countsBeforeInterrupted -= _startedOn.get();
+}
+
+OperationHardwareCounters::Counts PerfEventCounters::_getThreadCounts() const {
+    auto counts = getThreadEventGroup().read();
+    appendThreadBlockIO(&counts);
+    return counts;
+}
+
+static auto getHardwareCounters = OperationContext::declareDecoration<PerfEventCounters>();
+
+}  // namespace
+
+OperationHardwareCounters* OperationHardwareCounters::get(OperationContext* opCtx) {
+    invariant(Client::getCurrent() && Client::getCurrent()->getOperationContext() == opCtx,
+              "Operation not attached to the current thread");
+
+    // perf_event_open(2) may be missing from the kernel, or forbidden by perf_event_paranoid or a
+    // seccomp profile, so check that the events can be opened before handing out any counters.
+    static bool isSupported = [] {
+        const auto& group = getThreadEventGroup();
+        if (!group.isValid()) {
+            LOGV2_DEBUG(6109800,
+                        1,
+                        "Hardware counters are not available for resource consumption metrics",
+                        "error"_attr = errnoWithDescription(group.getError()));
+        }
+        return group.isValid();
+    }();
+
+    if (!isSupported)
+        return nullptr;
+    return &getHardwareCounters(opCtx);
+}
+
+#else  // not defined(__linux__)
+
+OperationHardwareCounters* OperationHardwareCounters::get(OperationContext*) {
+    return nullptr;
+}
+
+#endif  // defined(__linux__)
+
+}  // namespace mongo
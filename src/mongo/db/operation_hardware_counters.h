@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+
+/**
+ * Counts the hardware events and block I/O of an operation on platforms that support it, which is
+ * Linux with perf_event_open(2) available to the process. It follows the same rules as
+ * OperationCPUTimer:
+ *
+ * All methods may only be invoked on the thread associated with the operation.
+ *
+ * The counters are initially stopped, accumulate the events between the invocations of `start()`
+ * and `stop()`, and reset on consequent invocations of `start()`.
+ *
+ * The counters are paused when the operation's client is detached from the current thread, and
+ * will not resume until the client is reattached to a thread.
+ *
+ * The hardware events are counted in user space only, so that they are available with the default
+ * perf_event_paranoid setting. Should the kernel multiplex the counters, the reported counts are
+ * the events observed while the counters were scheduled and under-report the true totals.
+ */
+class OperationHardwareCounters {
+public:
+    struct Counts {
+        Counts& operator+=(const Counts& other) {
+            instructions += other.instructions;
+            cycles += other.cycles;
+            cacheMisses += other.cacheMisses;
+            blockReadBytes += other.blockReadBytes;
+            blockWriteBytes += other.blockWriteBytes;
+            return *this;
+        }
+
+        Counts& operator-=(const Counts& other) {
+            instructions -= other.instructions;
+            cycles -= other.cycles;
+            cacheMisses -= other.cacheMisses;
+            blockReadBytes -= other.blockReadBytes;
+            blockWriteBytes -= other.blockWriteBytes;
+            return *this;
+        }
+
+        /**
+         * Reports all counts on a BSONObjBuilder.
+         */
+        void toBson(BSONObjBuilder* builder) const;
+
+        // Instructions retired.
+        long long instructions = 0;
+        // CPU cycles.
+        long long cycles = 0;
+        // Cache misses, which the kernel maps to last level cache misses where the CPU allows it.
+        long long cacheMisses = 0;
+        // Bytes the thread caused to be read from and written to the block layer.
+        long long blockReadBytes = 0;
+        long long blockWriteBytes = 0;
+    };
+
+    /**
+     * Returns `nullptr` if the platform does not support counting hardware events.
+     */
+    static OperationHardwareCounters* get(OperationContext*);
+
+    virtual Counts getCounts() const = 0;
+
+    virtual void start() = 0;
+    virtual void stop() = 0;
+
+    virtual void onThreadAttach() = 0;
+    virtual void onThreadDetach() = 0;
+};
+
+}  // namespace mongo
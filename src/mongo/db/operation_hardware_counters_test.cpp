@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_hardware_counters.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+
+class OperationHardwareCountersTest : public ServiceContextTest {
+public:
+    auto makeClient() const {
+        return getGlobalServiceContext()->makeClient("AlternativeClient");
+    }
+
+    auto getCounters() const {
+        return OperationHardwareCounters::get(_opCtx.get());
+    }
+
+    void setUp() {
+        _opCtx = getGlobalServiceContext()->makeOperationContext(Client::getCurrent());
+    }
+
+    // Does some work for the counters to observe, in a way the compiler cannot optimize away.
+    static void spin() {
+        volatile long long sink = 0;
+        for (int i = 0; i < 100000; i++) {
+            sink = sink + i;
+        }
+    }
+
+private:
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+// The counters are unavailable wherever perf events are restricted, which includes many build and
+// test hosts, so the tests only check them where they could be opened.
+TEST_F(OperationHardwareCountersTest, TestCounters) {
+    auto counters = getCounters();
+    if (!counters) {
+        return;
+    }
+
+    counters->start();
+    spin();
+    ASSERT_GT(counters->getCounts().instructions, 0);
+    counters->stop();
+
+    const auto countsAfterStop = counters->getCounts();
+    spin();
+    const auto countsAfterSpin = counters->getCounts();
+    ASSERT_EQ(countsAfterStop.instructions, countsAfterSpin.instructions);
+    ASSERT_EQ(countsAfterStop.cycles, countsAfterSpin.cycles);
+}
+
+TEST_F(OperationHardwareCountersTest, TestReset) {
+    auto counters = getCounters();
+    if (!counters) {
+        return;
+    }
+
+    counters->start();
+    spin();
+    counters->stop();
+    auto instructionsAfterStop = counters->getCounts().instructions;
+    ASSERT_GT(instructionsAfterStop, 0);
+
+    counters->start();
+    ASSERT_LT(counters->getCounts().instructions, instructionsAfterStop);
+    counters->stop();
+}
+
+TEST_F(OperationHardwareCountersTest, TestCountersSurviveDetachAndAttach) {
+    auto counters = getCounters();
+    if (!counters) {
+        return;
+    }
+
+    counters->start();
+    spin();
+    auto instructionsBeforeDetach = counters->getCounts().instructions;
+    {
+        auto client = makeClient();
+        AlternativeClientRegion acr(client);
+        spin();
+    }
+
+    // The work done on behalf of the other client is not attributed to this operation.
+    auto instructionsAfterAttach = counters->getCounts().instructions;
+    ASSERT_GTE(instructionsAfterAttach, instructionsBeforeDetach);
+    ASSERT_LT(instructionsAfterAttach - instructionsBeforeDetach, instructionsBeforeDetach);
+    counters->stop();
+}
+
+}  // namespace mongo
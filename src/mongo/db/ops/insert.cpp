@@ -38,6 +38,7 @@
 #include "mongo/db/query/dbref.h"
 #include "mongo/db/query/query_feature_flags_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/update/storage_validation.h"
 #include "mongo/db/vector_clock_mutable.h"
 #include "mongo/db/views/durable_view_catalog.h"
@@ -84,8 +85,15 @@ Status validateDepth(const BSONObj& obj) {
 StatusWith<BSONObj> fixDocumentForInsert(OperationContext* opCtx,
                                          const BSONObj& doc,
                                          bool* containsDotsAndDollarsField) {
-    bool validationDisabled = DocumentValidationSettings::get(opCtx).isInternalValidationDisabled();
+    return fixDocumentForInsert(
+        doc,
+        DocumentValidationSettings::get(opCtx).isInternalValidationDisabled(),
+        containsDotsAndDollarsField);
+}
 
+StatusWith<BSONObj> fixDocumentForInsert(const BSONObj& doc,
+                                         bool validationDisabled,
+                                         bool* containsDotsAndDollarsField) {
     if (!validationDisabled) {
         if (doc.objsize() > BSONObjMaxUserSize)
             return StatusWith<BSONObj>(ErrorCodes::BadValue,
@@ -176,7 +184,7 @@ StatusWith<BSONObj> fixDocumentForInsert(OperationContext* opCtx,
         if (hadId && e.fieldNameStringData() == "_id") {
             // no-op
         } else if (e.type() == bsonTimestamp && e.timestampValue() == 0) {
-            auto nextTime = VectorClockMutable::get(opCtx)->tickClusterTime(1);
+            auto nextTime = VectorClockMutable::get(getGlobalServiceContext())->tickClusterTime(1);
             b.append(e.fieldName(), nextTime.asTimestamp());
         } else {
             b.append(e);
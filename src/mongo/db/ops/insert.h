@@ -49,6 +49,14 @@ StatusWith<BSONObj> fixDocumentForInsert(OperationContext* opCtx,
                                          const BSONObj& doc,
                                          bool* containsDotsOrDollarsField = nullptr);
 
+/**
+ * Like fixDocumentForInsert() above, given whether the operation has internal validation disabled
+ * rather than the operation itself, so that it can run on a thread other than the operation's.
+ */
+StatusWith<BSONObj> fixDocumentForInsert(const BSONObj& doc,
+                                         bool internalValidationDisabled,
+                                         bool* containsDotsOrDollarsField = nullptr);
+
 /**
  * Returns Status::OK() if this namespace is valid for user write operations.  If not, returns
  * an error Status.
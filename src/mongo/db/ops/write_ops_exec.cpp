@@ -63,6 +63,7 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/record_id_helpers.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -83,7 +84,9 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/would_change_owning_shard_exception.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
 #include "mongo/util/log_and_backoff.h"
 #include "mongo/util/scopeguard.h"
 
@@ -570,6 +573,133 @@ SingleWriteResult makeWriteResultForInsertOrDeleteRetry() {
     return res;
 }
 
+// Validates the documents of inserts ahead of the batches which write them.
+std::unique_ptr<ThreadPool> insertValidationPool;
+MONGO_INITIALIZER(InsertValidationPool)(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "InsertValidationPool";
+    options.threadNamePrefix = "InsertValidation";
+    options.minThreads = 0;
+    options.maxThreads = 16;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    insertValidationPool = std::make_unique<ThreadPool>(options);
+    insertValidationPool->startup();
+}
+
+/**
+ * Runs fixDocumentForInsert() on the documents of an insert one slice of 'sliceSize' documents
+ * ahead of the caller, on the insert validation pool, so that the documents of the next batch are
+ * validated while the current batch is being written. The results are the same as those of
+ * calling fixDocumentForInsert() on each document in turn.
+ */
+class PipelinedDocumentFixer {
+public:
+    PipelinedDocumentFixer(OperationContext* opCtx,
+                           const std::vector<BSONObj>& docs,
+                           size_t sliceSize)
+        : _docs(docs),
+          _sliceSize(sliceSize),
+          _validationDisabled(
+              DocumentValidationSettings::get(opCtx).isInternalValidationDisabled()) {}
+
+    ~PipelinedDocumentFixer() {
+        // The slice in flight refers to the documents, which go away with the caller.
+        if (_nextSlice) {
+            std::move(*_nextSlice).getNoThrow().getStatus().ignore();
+        }
+    }
+
+    /**
+     * Returns what fixDocumentForInsert() returns for the document after the one of the previous
+     * call, or for the first document on the first call.
+     */
+    StatusWith<BSONObj> next(bool* containsDotsAndDollarsField) {
+        if (_position == _sliceBegin + _slice.size()) {
+            _sliceBegin = _position;
+            _slice = _takeSlice(_sliceBegin);
+            _scheduleSlice(_sliceBegin + _slice.size());
+        }
+
+        auto& fixed = _slice[_position++ - _sliceBegin];
+        *containsDotsAndDollarsField = fixed.containsDotsAndDollarsField;
+        return std::move(fixed.fixedDoc);
+    }
+
+private:
+    struct FixedDocument {
+        StatusWith<BSONObj> fixedDoc{BSONObj()};
+        bool containsDotsAndDollarsField = false;
+    };
+    using Slice = std::vector<FixedDocument>;
+
+    static Slice _fixSlice(const std::vector<BSONObj>& docs,
+                           size_t begin,
+                           size_t end,
+                           bool validationDisabled) {
+        Slice slice(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            auto& fixed = slice[i - begin];
+            fixed.fixedDoc = fixDocumentForInsert(
+                docs[i], validationDisabled, &fixed.containsDotsAndDollarsField);
+        }
+        return slice;
+    }
+
+    size_t _sliceEnd(size_t begin) const {
+        return std::min(begin + _sliceSize, _docs.size());
+    }
+
+    /**
+     * Returns the slice starting at 'begin', which is the one in flight, unless that failed to
+     * run, in which case it is fixed here.
+     */
+    Slice _takeSlice(size_t begin) {
+        if (_nextSlice) {
+            auto swSlice = std::move(*_nextSlice).getNoThrow();
+            _nextSlice.reset();
+            if (swSlice.isOK()) {
+                return std::move(swSlice.getValue());
+            }
+        }
+        return _fixSlice(_docs, begin, _sliceEnd(begin), _validationDisabled);
+    }
+
+    void _scheduleSlice(size_t begin) {
+        if (begin == _docs.size()) {
+            return;
+        }
+
+        auto pf = makePromiseFuture<Slice>();
+        _nextSlice.emplace(std::move(pf.future));
+        insertValidationPool->schedule([promise = std::move(pf.promise),
+                                        docs = &_docs,
+                                        begin,
+                                        end = _sliceEnd(begin),
+                                        validationDisabled = _validationDisabled](
+                                           Status status) mutable {
+            if (!status.isOK()) {
+                promise.setError(status);
+                return;
+            }
+            promise.setWith([&] { return _fixSlice(*docs, begin, end, validationDisabled); });
+        });
+    }
+
+    const std::vector<BSONObj>& _docs;
+    const size_t _sliceSize;
+    const bool _validationDisabled;
+
+    // The slice the caller is consuming, which starts at the document '_sliceBegin'.
+    Slice _slice;
+    size_t _sliceBegin = 0;
+
+    // The document the next call to next() returns the result of.
+    size_t _position = 0;
+
+    // The slice after '_slice', while it is being fixed on the pool.
+    boost::optional<Future<Slice>> _nextSlice;
+};
+
 }  // namespace
 
 WriteResult performInserts(OperationContext* opCtx,
@@ -626,10 +756,19 @@ WriteResult performInserts(OperationContext* opCtx,
     const size_t maxBatchBytes = write_ops::insertVectorMaxBytes;
     batch.reserve(std::min(wholeOp.getDocuments().size(), maxBatchSize));
 
+    // Inserts which take more than one batch validate the documents of the next batch while the
+    // current one is being written.
+    boost::optional<PipelinedDocumentFixer> pipelinedFixer;
+    if (internalInsertPipelineValidation.load() && wholeOp.getDocuments().size() > maxBatchSize) {
+        pipelinedFixer.emplace(opCtx, wholeOp.getDocuments(), maxBatchSize);
+    }
+
     for (auto&& doc : wholeOp.getDocuments()) {
         const bool isLastDoc = (&doc == &wholeOp.getDocuments().back());
         bool containsDotsAndDollarsField = false;
-        auto fixedDoc = fixDocumentForInsert(opCtx, doc, &containsDotsAndDollarsField);
+        auto fixedDoc = pipelinedFixer
+            ? pipelinedFixer->next(&containsDotsAndDollarsField)
+            : fixDocumentForInsert(opCtx, doc, &containsDotsAndDollarsField);
         const StmtId stmtId = getStmtIdForWriteOp(opCtx, wholeOp, stmtIdIndex++);
         const bool wasAlreadyExecuted = opCtx->getTxnNumber() &&
             !opCtx->inMultiDocumentTransaction() &&
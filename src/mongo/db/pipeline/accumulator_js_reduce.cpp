@@ -426,43 +426,45 @@ void AccumulatorJs::reduceMemoryConsumptionIfAble() {
     auto expCtx = getExpressionContext();
     auto jsExec = expCtx->getJsExecWithScope();
 
-    // Expose user functions.
-    if (_pendingCallsMerging) {
-        jsExec->getScope()->setFunction("__merge", _merge.c_str());
-    } else {
-        jsExec->getScope()->setFunction("__accumulate", _accumulate.c_str());
-    }
-
-    // Use a wrapper function that calls accumulate and merge in a JS loop, to cut down on the
-    // number of calls into the JS engine.
+    // Expose user functions. They are compiled once per operation rather than once per group, and
+    // so are the wrappers below, since the scope caches functions by their source.
     ScriptingFunction func;
     if (_pendingCallsMerging) {
+        const auto& merge = jsExec->getGlobalFunction(_merge);
+
+        // Use a wrapper function that calls merge in a JS loop, to cut down on the number of calls
+        // into the JS engine.
         func = makeJsFunc(expCtx,
-                          "function(state, pendingCalls) {"
-                          "  const length = pendingCalls.length;"
-                          "  for (let i=0; i<length; ++i) {"
-                          "    state = __merge(state, pendingCalls[i]);"
-                          "  }"
-                          "  return state;"
-                          "}");
+                          str::stream() << "function(state, pendingCalls) {"
+                                        << "  const length = pendingCalls.length;"
+                                        << "  for (let i=0; i<length; ++i) {"
+                                        << "    state = " << merge << "(state, pendingCalls[i]);"
+                                        << "  }"
+                                        << "  return state;"
+                                        << "}");
     } else {
+        const auto& accumulate = jsExec->getGlobalFunction(_accumulate);
+
+        // Use a wrapper function that calls accumulate in a JS loop, to cut down on the number of
+        // calls into the JS engine. Try to avoid doing an expensive argument spread by handling a
+        // few common arities as special cases.
         func = makeJsFunc(
             expCtx,
-            "function(state, pendingCalls) {"
-            "  const length = pendingCalls.length;"
-            "  for (let i=0; i<length; ++i) {"
-            "    const input = pendingCalls[i];"
-            // Try to avoid doing an expensive argument spread by handling a few common arities as
-            // special cases.
-            "    switch (input.length) {"
-            "      case 1: state = __accumulate(state, input[0]); break;"
-            "      case 2: state = __accumulate(state, input[0], input[1]); break;"
-            "      case 3: state = __accumulate(state, input[0], input[1], input[2]); break;"
-            "      default: state = __accumulate(state, ...input); break;"
-            "    }"
-            "  }"
-            "  return state;"
-            "}");
+            str::stream() << "function(state, pendingCalls) {"
+                          << "  const length = pendingCalls.length;"
+                          << "  for (let i=0; i<length; ++i) {"
+                          << "    const input = pendingCalls[i];"
+                          << "    switch (input.length) {"
+                          << "      case 1: state = " << accumulate << "(state, input[0]); break;"
+                          << "      case 2: state = " << accumulate
+                          << "(state, input[0], input[1]); break;"
+                          << "      case 3: state = " << accumulate
+                          << "(state, input[0], input[1], input[2]); break;"
+                          << "      default: state = " << accumulate << "(state, ...input); break;"
+                          << "    }"
+                          << "  }"
+                          << "  return state;"
+                          << "}");
     }
 
     for (auto it = _pendingCalls.begin(), end = _pendingCalls.end(); it != end;) {
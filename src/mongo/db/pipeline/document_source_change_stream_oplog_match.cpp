@@ -88,6 +88,19 @@ BSONObj getTxnApplyOpsFilter(BSONElement nsMatch, const NamespaceString& nss) {
     return applyOpsBuilder.obj();
 }
 
+/**
+ * Constructs a filter matching 'fieldName' against the namespaces that the change stream on 'nss'
+ * is watching. Single-collection streams compare the namespace for equality rather than through
+ * the anchored regex, which every stream would otherwise run against every oplog entry it scans.
+ */
+BSONObj getNsMatch(StringData fieldName, const NamespaceString& nss) {
+    if (DocumentSourceChangeStream::getChangeStreamType(nss) ==
+        DocumentSourceChangeStream::ChangeStreamType::kSingleCollection) {
+        return BSON(fieldName << nss.ns());
+    }
+    return BSON(fieldName << BSONRegEx(DocumentSourceChangeStream::getNsRegexForChangeStream(nss)));
+}
+
 /**
  * Produce the BSON object representing the filter for the $match stage to filter oplog entries
  * to only those relevant for this $changeStream stage.
@@ -133,8 +146,7 @@ BSONObj buildMatchFilter(const boost::intrusive_ptr<ExpressionContext>& expCtx,
         BSON("$and" << BSON_ARRAY(cmdNsFilter << BSON("$or" << relevantCommands.arr())));
 
     // 1.2) Supported commands that have arbitrary db namespaces in "ns" field.
-    auto renameDropTarget =
-        BSON("o.to" << BSONRegEx(DocumentSourceChangeStream::getNsRegexForChangeStream(nss)));
+    auto renameDropTarget = getNsMatch("o.to"_sd, nss);
 
     // 1.3) Transaction commit commands.
     auto transactionCommit = BSON("o.commitTransaction" << 1);
@@ -146,8 +158,7 @@ BSONObj buildMatchFilter(const boost::intrusive_ptr<ExpressionContext>& expCtx,
 
     // 2) Supported operations on the operation namespace, optionally including those from
     // migrations.
-    BSONObj opNsMatch =
-        BSON("ns" << BSONRegEx(DocumentSourceChangeStream::getNsRegexForChangeStream(nss)));
+    BSONObj opNsMatch = getNsMatch("ns"_sd, nss);
 
     // 2.1) Normal CRUD ops.
     auto normalOpTypeMatch = BSON("op" << NE << "n");
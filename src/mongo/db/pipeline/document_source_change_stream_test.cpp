@@ -2227,6 +2227,87 @@ TEST_F(ChangeStreamStageWithDualFeatureFlagValueTest, DSCSOplogMatchStageSeriali
         std::move(spec), stageSpecAsBSON, expCtx);
 }
 
+TEST_F(ChangeStreamStageTest, OplogMatchComparesSingleCollectionNamespacesForEquality) {
+    auto stages = DSChangeStream::createFromBson(kDefaultSpec.firstElement(), getExpCtx());
+    auto oplogMatch = dynamic_cast<DocumentSourceMatch*>(stages.front().get());
+    ASSERT(oplogMatch);
+    const auto filter = oplogMatch->getQuery();
+
+    // Every namespace of the filter is compared for equality: to the collection itself, or to the
+    // command namespace of its database.
+    std::vector<BSONElement> nsMatches;
+    std::function<void(const BSONObj&)> collectNsMatches = [&](const BSONObj& obj) {
+        for (auto&& elem : obj) {
+            ASSERT_NE(elem.type(), BSONType::RegEx) << filter;
+            const auto fieldName = elem.fieldNameStringData();
+            if (fieldName == "ns"_sd || fieldName == "o.to"_sd || fieldName == "o.applyOps.ns"_sd) {
+                nsMatches.push_back(elem);
+            }
+            if (elem.isABSONObj()) {
+                collectNsMatches(elem.Obj());
+            }
+        }
+    };
+    collectNsMatches(filter);
+    ASSERT_FALSE(nsMatches.empty());
+    for (auto&& elem : nsMatches) {
+        ASSERT_EQ(elem.type(), BSONType::String) << filter;
+        ASSERT(elem.valueStringData() == nss.ns() ||
+               elem.valueStringData() == nss.getCommandNS().ns())
+            << filter;
+    }
+
+    auto match = DocumentSourceMatch::create(filter, getExpCtx());
+    auto matchesInTxn = [&](const OplogEntry& entry) {
+        BSONObjBuilder builder(entry.getEntry().toBSON());
+        builder.append("lsid", testLsid().toBSON());
+        builder.append("txnNumber", 0LL);
+        return match->getMatchExpression()->matchesBSON(builder.obj());
+    };
+    auto matches = [&](const OplogEntry& entry) {
+        return match->getMatchExpression()->matchesBSON(entry.getEntry().toBSON());
+    };
+    const NamespaceString otherColl(nss.db(), nss.coll() + "_other");
+    const NamespaceString otherDbColl("otherDb", nss.coll());
+
+    // CRUD operations must be on the collection itself.
+    ASSERT(matches(makeOplogEntry(OpTypeEnum::kInsert, nss, BSON("_id" << 1))));
+    ASSERT_FALSE(matches(makeOplogEntry(OpTypeEnum::kInsert, otherColl, BSON("_id" << 1))));
+    ASSERT_FALSE(matches(makeOplogEntry(OpTypeEnum::kInsert, otherDbColl, BSON("_id" << 1))));
+
+    // Drops and renames of the collection, including renames into it from another database.
+    ASSERT(matches(createCommand(BSON("drop" << nss.coll()))));
+    ASSERT_FALSE(matches(createCommand(BSON("drop" << otherColl.coll()))));
+    ASSERT(matches(createCommand(BSON("renameCollection" << nss.ns() << "to" << otherColl.ns()))));
+    ASSERT(matches(createCommand(BSON("renameCollection" << otherColl.ns() << "to" << nss.ns()))));
+    auto renameFromOtherDb =
+        makeOplogEntry(OpTypeEnum::kCommand,
+                       otherDbColl.getCommandNS(),
+                       BSON("renameCollection" << otherDbColl.ns() << "to" << nss.ns()));
+    ASSERT(matches(renameFromOtherDb));
+    ASSERT_FALSE(matches(createCommand(BSON("renameCollection" << otherColl.ns() << "to"
+                                                               << nss.db() + ".third"))));
+
+    // Transactions which write to the collection, and no other single-entry transaction.
+    auto applyOps = [&](const NamespaceString& opNss) {
+        return makeOplogEntry(
+            OpTypeEnum::kCommand,
+            NamespaceString("admin.$cmd"),
+            BSON("applyOps" << BSON_ARRAY(BSON("op"
+                                               << "i"
+                                               << "ns" << opNss.ns() << "ui" << testUuid() << "o"
+                                               << BSON("_id" << 1)))),
+            boost::none,
+            boost::none,
+            boost::none,
+            boost::none,
+            {},
+            repl::OpTime());
+    };
+    ASSERT(matchesInTxn(applyOps(nss)));
+    ASSERT_FALSE(matchesInTxn(applyOps(otherColl)));
+}
+
 TEST_F(ChangeStreamStageWithDualFeatureFlagValueTest, DSCSUnwindTransactionStageSerialization) {
     auto expCtx = getExpCtx();
 
@@ -160,6 +160,14 @@ ResumeTokenData DocumentSourceChangeStreamTransform::getResumeToken(Value ts,
     return resumeTokenData;
 }
 
+Value DocumentSourceChangeStreamTransform::getNamespaceValue(const NamespaceString& nss) {
+    if (_lastEventNsValue.missing() || nss != _lastEventNss) {
+        _lastEventNss = nss;
+        _lastEventNsValue = Value(Document{{"db", nss.db()}, {"coll", nss.coll()}});
+    }
+    return _lastEventNsValue;
+}
+
 Document DocumentSourceChangeStreamTransform::applyTransformation(const Document& input) {
     // If we're executing a change stream pipeline that was forwarded from mongos, then we expect it
     // to "need merge"---we expect to be executing the shards part of a split pipeline. It is never
@@ -177,7 +185,9 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
         invariant(pExpCtx->needsMerge);
     }
 
-    MutableDocument doc;
+    // Reserve room for every field an event can have, so that building it does not reallocate.
+    const size_t kMaxEventFields = 11;
+    MutableDocument doc(kMaxEventFields);
 
     // Extract the fields we need.
     checkValueType(input[repl::OplogEntry::kOpTypeFieldName],
@@ -189,7 +199,8 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
     checkValueType(ns, repl::OplogEntry::kNssFieldName, BSONType::String);
     Value uuid = input[repl::OplogEntry::kUuidFieldName];
     Value preImageOpTime = input[repl::OplogEntry::kPreImageOpTimeFieldName];
-    std::vector<FieldPath> documentKeyFields;
+    static const std::vector<FieldPath> kNoDocumentKeyFields;
+    const std::vector<FieldPath>* documentKeyFields = &kNoDocumentKeyFields;
 
     // Deal with CRUD operations and commands.
     auto opType = repl::OpType_parse(IDLParserErrorContext("ChangeStreamEntry.op"), op);
@@ -207,12 +218,16 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
             auto docKeyFields =
                 pExpCtx->mongoProcessInterface->collectDocumentKeyFieldsForHostedCollection(
                     pExpCtx->opCtx, nss, uuid.getUuid());
-            if (it == _documentKeyCache.end() || docKeyFields.second) {
-                _documentKeyCache[uuid.getUuid()] = DocumentKeyCacheEntry(docKeyFields);
+            if (it == _documentKeyCache.end()) {
+                it = _documentKeyCache.emplace(uuid.getUuid(), DocumentKeyCacheEntry(docKeyFields))
+                         .first;
+            } else if (docKeyFields.second) {
+                it->second = DocumentKeyCacheEntry(docKeyFields);
             }
         }
 
-        documentKeyFields = _documentKeyCache.find(uuid.getUuid())->second.documentKeyFields;
+        // Refer to the cached fields instead of copying them for every event.
+        documentKeyFields = &it->second.documentKeyFields;
     }
     Value id = input.getNestedField("o._id");
     // Non-replace updates have the _id in field "o2".
@@ -226,7 +241,7 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
             operationType = DocumentSourceChangeStream::kInsertOpType;
             fullDocument = input[repl::OplogEntry::kObjectFieldName];
             documentKey = Value(document_path_support::extractPathsFromDoc(
-                fullDocument.getDocument(), documentKeyFields));
+                fullDocument.getDocument(), *documentKeyFields));
             break;
         }
         case repl::OpTypeEnum::kDelete: {
@@ -378,7 +393,7 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
     doc.addField(DocumentSourceChangeStream::kNamespaceField,
                  operationType == DocumentSourceChangeStream::kDropDatabaseOpType
                      ? Value(Document{{"db", nss.db()}})
-                     : Value(Document{{"db", nss.db()}, {"coll", nss.coll()}}));
+                     : getNamespaceValue(nss));
     doc.addField(DocumentSourceChangeStream::kDocumentKeyField, std::move(documentKey));
 
     // Note that 'updateDescription' might be the 'missing' value, in which case it will not be
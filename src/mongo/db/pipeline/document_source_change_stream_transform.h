@@ -97,6 +97,12 @@ private:
      */
     ResumeTokenData getResumeToken(Value ts, Value uuid, Value documentKey, Value txnOpIndex);
 
+    /**
+     * Returns the {db, coll} value reported as the 'ns' of an event on 'nss'. Consecutive events
+     * are usually on the same namespace, so the last value built is reused.
+     */
+    Value getNamespaceValue(const NamespaceString& nss);
+
     Value serializeLegacy(boost::optional<ExplainOptions::Verbosity> explain) const final;
     Value serializeLatest(boost::optional<ExplainOptions::Verbosity> explain) const final;
 
@@ -105,6 +111,10 @@ private:
     // Map of collection UUID to document key fields.
     std::map<UUID, DocumentKeyCacheEntry> _documentKeyCache;
 
+    // The namespace of the last event and the 'ns' value that was built for it.
+    NamespaceString _lastEventNss;
+    Value _lastEventNsValue;
+
     // Set to true if this transformation stage can be run on the collectionless namespace.
     bool _isIndependentOfAnyCollection;
 
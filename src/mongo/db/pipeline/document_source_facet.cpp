@@ -40,6 +40,7 @@
 #include "mongo/bson/bsontypes.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
@@ -209,6 +210,51 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::optimize() {
     return this;
 }
 
+Pipeline::SourceContainer::iterator DocumentSourceFacet::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    // Each sub-pipeline starts with the DocumentSourceTeeConsumer which feeds it, so the first
+    // user-specified stage is the second one.
+    auto leadingMatch = [](const FacetPipeline& facet) -> DocumentSourceMatch* {
+        const auto& sources = facet.pipeline->getSources();
+        if (sources.size() < 2) {
+            return nullptr;
+        }
+        auto second = std::next(sources.begin())->get();
+        return second->getSourceName() == DocumentSourceMatch::kStageName
+            ? static_cast<DocumentSourceMatch*>(second)
+            : nullptr;
+    };
+
+    auto firstMatch = leadingMatch(_facets.front());
+    if (!firstMatch) {
+        return std::next(itr);
+    }
+    const auto predicate = firstMatch->getQuery();
+    for (auto&& facet : _facets) {
+        auto match = leadingMatch(facet);
+        if (!match || SimpleBSONObjComparator::kInstance.evaluate(match->getQuery() != predicate)) {
+            return std::next(itr);
+        }
+    }
+
+    // Every facet would filter its input identically, so filter the input once instead.
+    intrusive_ptr<DocumentSource> hoisted = firstMatch;
+    for (auto&& facet : _facets) {
+        auto& sources = facet.pipeline->getSources();
+        auto next = sources.erase(std::next(sources.begin()));
+        if (next != sources.end()) {
+            (*next)->setSource(sources.front().get());
+        }
+    }
+
+    // Give the hoisted $match a chance to merge with the stage before it, and this stage a chance
+    // to hoist the next common $match.
+    auto matchItr = container->insert(itr, std::move(hoisted));
+    return matchItr == container->begin() ? matchItr : std::prev(matchItr);
+}
+
 void DocumentSourceFacet::detachFromOperationContext() {
     for (auto&& facet : _facets) {
         facet.pipeline->detachFromOperationContext();
@@ -102,6 +102,14 @@ public:
      */
     boost::intrusive_ptr<DocumentSource> optimize() final;
 
+    /**
+     * If every sub-pipeline begins with the same $match, moves that $match in front of this stage
+     * so that the filter is evaluated once rather than once per facet, and so that it can be
+     * optimized together with the preceding stages.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
     /**
      * Takes a union of all sub-pipelines, and adds them to 'deps'.
      */
@@ -45,6 +45,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/storage/storage_options.h"
 
 namespace mongo {
 
@@ -131,20 +132,14 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (haveVisitedDocuments()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisitedDocument()));
     }
 
     MutableDocument output(*_input);
     output.setNestedField(_as, Value(std::move(results)));
 
-    _visitedUsageBytes = 0;
-
-    invariant(_visited.empty());
-
     return output.freeze();
 }
 
@@ -154,7 +149,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!haveVisitedDocuments()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -165,12 +160,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
 
             _input = input.releaseDocument();
             performSearch();
-            _visitedUsageBytes = 0;
             _outputIndex = 0;
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!haveVisitedDocuments()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -184,23 +178,29 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisitedDocument()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
     }
 }
 
+Document DocumentSourceGraphLookUp::popVisitedDocument() {
+    const auto id = _visitedDocuments.getLowestIndex();
+    auto doc = _visitedDocuments.getDocumentById(id);
+    _visitedDocuments.freeUpTo(id);
+    return doc;
+}
+
 void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    _visitedDocuments.finalize();
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -268,6 +268,10 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
     _frontier.clear();
     _frontierUsageBytes = 0;
+
+    // The search is complete, so only the visited documents are still needed.
+    _visited.clear();
+    _visitedUsageBytes = 0;
 }
 
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
@@ -295,11 +299,12 @@ bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long lo
             _frontierUsageBytes += nextFrontierValue.getApproximateSize();
         });
 
-    // Add the object to our '_visited' list and update the size of '_visited' appropriately.
+    // Add the object to our '_visited' list and update the size of '_visited' appropriately. The
+    // document itself is accounted for by '_visitedDocuments'.
     _visitedUsageBytes += id.getApproximateSize();
-    _visitedUsageBytes += result.getApproximateSize();
+    _visited.insert(std::move(id));
 
-    _visited[id] = std::move(result);
+    _visitedDocuments.addDocument(std::move(result));
 
     // We inserted into _visited, so return true.
     return true;
@@ -373,6 +378,9 @@ void DocumentSourceGraphLookUp::performSearch() {
     // Make sure _input is set before calling performSearch().
     invariant(_input);
 
+    // Release any documents left over from the previous input, including those on disk.
+    _visitedDocuments.clear();
+
     Value startingValue = _startWith->evaluate(*_input, &pExpCtx->variables);
 
     // If _startWith evaluates to an array, treat each value as a separate starting point.
@@ -433,12 +441,27 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
     return std::next(itr);
 }
 
+bool DocumentSourceGraphLookUp::canSpillToDisk() const {
+    return pExpCtx->allowDiskUse && !storageGlobalParams.readOnly &&
+        internalDocumentSourceGraphLookupAllowSpilling.load();
+}
+
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    auto usageBytes = [&] {
+        return _visitedUsageBytes + _visitedDocuments.getApproximateSize() + _frontierUsageBytes;
+    };
+
+    // Only the visited documents can be written to disk. The '_id' values in '_visited' and the
+    // frontier are needed in memory to drive the search.
+    if (usageBytes() >= _maxMemoryUsageBytes && _visitedDocuments.getApproximateSize() > 0 &&
+        canSpillToDisk()) {
+        _visitedDocuments.spillToDisk();
+    }
+
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
-            (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
-    _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
+            usageBytes() < _maxMemoryUsageBytes);
+    _cache.evictDownTo(_maxMemoryUsageBytes - usageBytes());
 }
 
 void DocumentSourceGraphLookUp::serializeToArray(
@@ -513,7 +536,10 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _depthField(depthField),
       _maxDepth(maxDepth),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
-      _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
+      _visited(ValueComparator::kInstance.makeUnorderedValueSet()),
+      _visitedMemoryTracker(false /* allowDiskUse */, std::numeric_limits<long long>::max()),
+      _visitedDocuments(expCtx.get(), &_visitedMemoryTracker),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
       _variables(expCtx->variables),
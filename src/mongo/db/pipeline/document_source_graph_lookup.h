@@ -34,6 +34,8 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/pipeline/memory_usage_tracker.h"
+#include "mongo/db/pipeline/window_function/spillable_cache.h"
 
 namespace mongo {
 
@@ -95,7 +97,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -121,6 +123,10 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx) final;
 
+    bool usedDisk() final {
+        return _visitedDocuments.usedDisk();
+    }
+
     static boost::intrusive_ptr<DocumentSourceGraphLookUp> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         NamespaceString fromNs,
@@ -200,11 +206,28 @@ private:
     void addToCache(const Document& result, const ValueUnorderedSet& queried);
 
     /**
-     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * Assert that '_visited', '_visitedDocuments' and '_frontier' have not exceeded the maximum
+     * memory usage, and then evict from '_cache' until this source is using less than
+     * '_maxMemoryUsageBytes'. If spilling is allowed, '_visitedDocuments' is written to disk
+     * before giving up.
      */
     void checkMemoryUsage();
 
+    /**
+     * Returns whether spilling '_visitedDocuments' to disk is permitted for this operation.
+     */
+    bool canSpillToDisk() const;
+
+    /**
+     * Returns the next visited document in breadth-first order, releasing it from
+     * '_visitedDocuments'. Callers must first check that 'haveVisitedDocuments()' is true.
+     */
+    Document popVisitedDocument();
+
+    bool haveVisitedDocuments() {
+        return _visitedDocuments.getLowestIndex() <= _visitedDocuments.getHighestIndex();
+    }
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -230,19 +253,25 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
-    // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
+    // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'. '_visitedUsageBytes'
+    // only accounts for the keys of '_visited'; the documents are tracked by '_visitedDocuments'.
     size_t _visitedUsageBytes = 0;
     size_t _frontierUsageBytes = 0;
 
     // Only used during the breadth-first search, tracks the set of values on the current frontier.
     ValueUnorderedSet _frontier;
 
-    // Tracks nodes that have been discovered for a given input. Keys are the '_id' value of the
-    // document from the foreign collection, value is the document itself.  The keys are compared
-    // using the simple collation.
-    ValueUnorderedMap<Document> _visited;
+    // Tracks nodes that have been discovered for a given input by the '_id' value of the document
+    // from the foreign collection. The values are compared using the simple collation.
+    ValueUnorderedSet _visited;
+
+    // Holds the documents whose '_id' is in '_visited', in the order in which the breadth-first
+    // search discovered them. The cache never enforces a memory limit of its own; this stage
+    // decides when to spill it in 'checkMemoryUsage()'.
+    MemoryUsageTracker _visitedMemoryTracker;
+    SpillableCache _visitedDocuments;
 
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
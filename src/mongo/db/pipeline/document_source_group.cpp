@@ -38,9 +38,11 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/util/destructor_guard.h"
 
@@ -134,14 +136,11 @@ const char* DocumentSourceGroup::getSourceName() const {
 }
 
 bool DocumentSourceGroup::shouldSpillWithAttemptToSaveMemory() {
-    if (!_memoryTracker._allowDiskUse &&
-        (_memoryTracker.currentMemoryBytes() >
-         static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes))) {
+    if (!_memoryTracker._allowDiskUse && !_memoryTracker.withinMemoryLimit()) {
         freeMemory();
     }
 
-    if (_memoryTracker.currentMemoryBytes() >
-        static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes)) {
+    if (!_memoryTracker.withinMemoryLimit()) {
         uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
                 "Exceeded memory limit for $group, but didn't allow external sort."
                 " Pass allowDiskUse:true to opt in.",
@@ -169,6 +168,19 @@ void DocumentSourceGroup::freeMemory() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
+    if (!_initialized && !_streaming) {
+        // A $sort which has not been pushed down into the query layer directly precedes us.
+        if (auto sortStage = dynamic_cast<DocumentSourceSort*>(pSource)) {
+            setInputSortPattern(sortStage->getSortKeyPattern());
+        }
+    }
+
+    if (_streaming && !_doneStreaming) {
+        if (auto next = getNextStreaming()) {
+            return std::move(*next);
+        }
+    }
+
     if (!_initialized) {
         const auto initializationResult = initialize();
         if (initializationResult.isPaused()) {
@@ -188,6 +200,144 @@ DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
     }
 }
 
+boost::optional<DocumentSource::GetNextResult> DocumentSourceGroup::getNextStreaming() {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    for (auto input = pSource->getNext();; input = pSource->getNext()) {
+        if (input.isPaused()) {
+            return input;
+        }
+
+        if (input.isEOF()) {
+            _doneStreaming = true;
+            readyGroups();
+            _initialized = true;
+            if (!_streamingId) {
+                return boost::none;
+            }
+            auto out = makeDocument(*_streamingId, _streamingAccumulators, pExpCtx->needsMerge);
+            _streamingId = boost::none;
+            _streamingAccumulators.clear();
+            return GetNextResult(std::move(out));
+        }
+
+        auto rootDocument = input.releaseDocument();
+        Value id = computeId(rootDocument);
+        if (!isStreamableId(id)) {
+            addToGroups(id, rootDocument);
+            continue;
+        }
+
+        boost::optional<Document> completedGroup;
+        if (!_streamingId || !pExpCtx->getValueComparator().evaluate(id == *_streamingId)) {
+            if (_streamingId) {
+                completedGroup =
+                    makeDocument(*_streamingId, _streamingAccumulators, pExpCtx->needsMerge);
+            }
+
+            // Start the group 'id' in the accumulators.
+            Value expandedId = expandId(id);
+            Document idDoc =
+                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+            if (_streamingAccumulators.empty()) {
+                _streamingAccumulators.reserve(numAccumulators);
+                for (auto&& accumulatedField : _accumulatedFields) {
+                    _streamingAccumulators.push_back(accumulatedField.makeAccumulator());
+                }
+            }
+            for (size_t i = 0; i < numAccumulators; ++i) {
+                _memoryTracker.update(_accumulatedFields[i].fieldName,
+                                      -1 * _streamingAccumulators[i]->getMemUsage());
+                _streamingAccumulators[i]->reset();
+                _streamingAccumulators[i]->startNewGroup(
+                    _accumulatedFields[i].expr.initializer->evaluate(idDoc, &pExpCtx->variables));
+                _memoryTracker.update(_accumulatedFields[i].fieldName,
+                                      _streamingAccumulators[i]->getMemUsage());
+            }
+            _streamingId = std::move(id);
+        }
+
+        for (size_t i = 0; i < numAccumulators; ++i) {
+            _memoryTracker.update(_accumulatedFields[i].fieldName,
+                                  -1 * _streamingAccumulators[i]->getMemUsage());
+            _streamingAccumulators[i]->process(
+                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
+                _doingMerge);
+            _memoryTracker.update(_accumulatedFields[i].fieldName,
+                                  _streamingAccumulators[i]->getMemUsage());
+        }
+
+        if (!_memoryTracker.withinMemoryLimit()) {
+            // Hand the current group to the regular $group, which can spill it. A group output
+            // before is complete, so it is still returned first.
+            stopStreaming();
+            if (completedGroup) {
+                return GetNextResult(std::move(*completedGroup));
+            }
+            return boost::none;
+        }
+
+        if (completedGroup) {
+            return GetNextResult(std::move(*completedGroup));
+        }
+    }
+}
+
+bool DocumentSourceGroup::isStreamableId(const Value& id) const {
+    auto isStreamableValue = [](const Value& value) {
+        return !value.nullish() && value.getType() != BSONType::Array;
+    };
+
+    if (_idExpressions.size() == 1) {
+        return isStreamableValue(id);
+    }
+    for (auto&& value : id.getArray()) {
+        if (!isStreamableValue(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DocumentSourceGroup::stopStreaming() {
+    _doneStreaming = true;
+    if (!_streamingId) {
+        return;
+    }
+
+    // The memory of the accumulators is already accounted for, but not that of the group key.
+    _memoryTracker.set(_memoryTracker.currentMemoryBytes() + _streamingId->getApproximateSize());
+    (*_groups)[*_streamingId] = std::move(_streamingAccumulators);
+    _streamingId = boost::none;
+    _streamingAccumulators.clear();
+}
+
+void DocumentSourceGroup::setInputSortPattern(const SortPattern& sortPattern) {
+    if (!internalDocumentSourceGroupStreamSortedInput.load() || _doingMerge ||
+        _idExpressions.size() > sortPattern.size()) {
+        return;
+    }
+
+    // Every group key must be a plain field path, and together they must be the leading fields
+    // of the sort pattern, in any order and direction.
+    std::set<std::string> sortPaths;
+    for (size_t i = 0; i < _idExpressions.size(); ++i) {
+        if (!sortPattern[i].fieldPath) {
+            return;
+        }
+        sortPaths.insert(sortPattern[i].fieldPath->fullPath());
+    }
+    for (auto&& idExpression : _idExpressions) {
+        auto fieldPathExpression = dynamic_cast<ExpressionFieldPath*>(idExpression.get());
+        if (!fieldPathExpression || fieldPathExpression->isVariableReference() ||
+            fieldPathExpression->getFieldPath().getPathLength() < 2 ||
+            sortPaths.erase(fieldPathExpression->getFieldPath().tail().fullPath()) == 0) {
+            return;
+        }
+    }
+    _streaming = sortPaths.empty();
+}
+
 DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
     // We aren't streaming, and we have spilled to disk.
     if (!_sorterIterator)
@@ -250,6 +400,8 @@ void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
+    _streamingId = boost::none;
+    _streamingAccumulators.clear();
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -306,6 +458,10 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
     MutableDocument out;
     out[getSourceName()] = Value(insides.freeze());
 
+    if (explain && _streaming) {
+        out["streaming"] = Value(true);
+    }
+
     if (explain && *explain >= ExplainOptions::Verbosity::kExecStats) {
         MutableDocument md;
 
@@ -399,7 +555,8 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _memoryTracker{expCtx->allowDiskUse && !expCtx->inMongos,
                      maxMemoryUsageBytes
                          ? *maxMemoryUsageBytes
-                         : static_cast<size_t>(internalDocumentSourceGroupMaxMemoryBytes.load())},
+                         : static_cast<size_t>(internalDocumentSourceGroupMaxMemoryBytes.load()),
+                     expCtx->getOperationMemoryTracker()},
       _initialized(false),
       _groups(expCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false) {
@@ -535,73 +692,14 @@ private:
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
-    const size_t numAccumulators = _accumulatedFields.size();
-
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
 
     for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (shouldSpillWithAttemptToSaveMemory()) {
-            _sortedFiles.push_back(spill());
-        }
-
         // We release the result document here so that it does not outlive the end of this loop
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
-        Value id = computeId(rootDocument);
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        vector<uint64_t> oldAccumMemUsage(numAccumulators, 0);
-        if (inserted) {
-            _memoryTracker.set(_memoryTracker.currentMemoryBytes() + id.getApproximateSize());
-
-            // Initialize and add the accumulators
-            Value expandedId = expandId(id);
-            Document idDoc =
-                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                auto accum = accumulatedField.makeAccumulator();
-                Value initializerValue =
-                    accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
-                accum->startNewGroup(initializerValue);
-                group.push_back(accum);
-            }
-        } else {
-            for (size_t i = 0; i < group.size(); i++) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryTracker.update(_accumulatedFields[i].fieldName,
-                                      -1 * group[i]->getMemUsage());
-            }
-        }
-
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(
-                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
-                _doingMerge);
-            _memoryTracker.update(_accumulatedFields[i].fieldName, group[i]->getMemUsage());
-        }
-
-        if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&           // is a dup
-                !pExpCtx->inMongos &&  // can't spill to disk in mongos
-                !_memoryTracker
-                     ._allowDiskUse &&       // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
-
-                _sortedFiles.push_back(spill());
-            }
-        }
+        addToGroups(computeId(rootDocument), rootDocument);
     }
 
     switch (input.getStatus()) {
@@ -612,32 +710,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             return input;  // Propagate pause.
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
-            // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
-                _spilled = true;
-                if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
-                }
-
-                // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
-
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
-                _ownsFileDeletion = false;
-
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (auto&& accumulatedField : _accumulatedFields) {
-                    _currentAccumulators.push_back(accumulatedField.makeAccumulator());
-                }
-
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
-            } else {
-                // start the group iterator
-                groupsIterator = _groups->begin();
-            }
+            readyGroups();
 
             // This must happen last so that, unless control gets here, we will re-enter
             // initialization after getting a GetNextResult::ResultState::kPauseExecution.
@@ -648,6 +721,94 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+void DocumentSourceGroup::addToGroups(const Value& id, const Document& rootDocument) {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    if (shouldSpillWithAttemptToSaveMemory()) {
+        _sortedFiles.push_back(spill());
+    }
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in '_groups' multiple times.
+    const size_t oldSize = _groups->size();
+    vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
+    const bool inserted = _groups->size() != oldSize;
+
+    if (inserted) {
+        _memoryTracker.set(_memoryTracker.currentMemoryBytes() + id.getApproximateSize());
+
+        // Initialize and add the accumulators
+        Value expandedId = expandId(id);
+        Document idDoc =
+            expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+        group.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            auto accum = accumulatedField.makeAccumulator();
+            Value initializerValue =
+                accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
+            accum->startNewGroup(initializerValue);
+            group.push_back(accum);
+        }
+    } else {
+        for (size_t i = 0; i < group.size(); i++) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryTracker.update(_accumulatedFields[i].fieldName, -1 * group[i]->getMemUsage());
+        }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(
+            _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
+            _doingMerge);
+        _memoryTracker.update(_accumulatedFields[i].fieldName, group[i]->getMemUsage());
+    }
+
+    if (kDebugBuild && !storageGlobalParams.readOnly) {
+        // In debug mode, spill every time we have a duplicate id to stress merge logic.
+        if (!inserted &&                      // is a dup
+            !pExpCtx->inMongos &&             // can't spill to disk in mongos
+            !_memoryTracker._allowDiskUse &&  // don't change behavior when testing external sort
+            _sortedFiles.size() < 20) {       // don't open too many FDs
+
+            _sortedFiles.push_back(spill());
+        }
+    }
+}
+
+void DocumentSourceGroup::readyGroups() {
+    // Do any final steps necessary to prepare to output results.
+    if (!_sortedFiles.empty()) {
+        _spilled = true;
+        if (!_groups->empty()) {
+            _sortedFiles.push_back(spill());
+        }
+
+        // We won't be using groups again so free its memory.
+        _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+
+        _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
+            _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
+        _ownsFileDeletion = false;
+
+        // prepare current to accumulate data
+        const size_t numAccumulators = _accumulatedFields.size();
+        _currentAccumulators.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            _currentAccumulators.push_back(accumulatedField.makeAccumulator());
+        }
+
+        verify(_sorterIterator->more());  // we put data in, we should get something out.
+        _firstPartOfNextGroup = _sorterIterator->next();
+    } else {
+        // start the group iterator
+        groupsIterator = _groups->begin();
+    }
+}
+
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     _stats.spills++;
 
@@ -696,6 +857,11 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     for (auto accum : _accumulatedFields) {
         _memoryTracker.set(accum.fieldName, 0);
     }
+    // The group a streaming $group is accumulating is not spilled, so its memory is still in use.
+    for (size_t i = 0; i < _streamingAccumulators.size(); ++i) {
+        _memoryTracker.update(_accumulatedFields[i].fieldName,
+                              _streamingAccumulators[i]->getMemUsage());
+    }
 
     Sorter<Value, Value>::Iterator* iteratorPtr = writer.done();
     _nextSortedFileWriterOffset = writer.getFileEndOffset();
@@ -718,6 +884,10 @@ Value DocumentSourceGroup::computeId(const Document& root) {
     return Value(std::move(vals));
 }
 
+Value DocumentSourceGroup::computeGroupKey(const Document& root) {
+    return expandId(computeId(root));
+}
+
 Value DocumentSourceGroup::expandId(const Value& val) {
     // _id doesn't get wrapped in a document
     if (_idFieldNames.empty())
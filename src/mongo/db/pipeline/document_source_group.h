@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -189,6 +190,25 @@ public:
      */
     size_t getMaxMemoryUsageBytes() const;
 
+    /**
+     * Tells this stage that its input is ordered by 'sortPattern'. If every document with the same
+     * group key is then adjacent in the input, this $group streams: it outputs each group as soon
+     * as the next group key is seen instead of building a table of all groups first.
+     */
+    void setInputSortPattern(const SortPattern& sortPattern);
+
+    /**
+     * Returns true if this $group outputs groups from sorted input as it reads them.
+     */
+    bool isStreaming() const {
+        return _streaming;
+    }
+
+    /**
+     * Returns the _id of the group which 'root' belongs to, in the shape this stage outputs it.
+     */
+    Value computeGroupKey(const Document& root);
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -207,6 +227,36 @@ private:
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
 
+    /**
+     * Processes the sorted input of a streaming $group until a group is complete, and returns it.
+     * Documents whose group key is an array, null or missing may sort among other groups, so they
+     * are added to '_groups' and output once the input is exhausted. Returns boost::none once it
+     * has finished streaming, after which the remaining groups are output as in a regular $group.
+     */
+    boost::optional<GetNextResult> getNextStreaming();
+
+    /**
+     * Returns true if every document with group key 'id' is guaranteed to be adjacent in input
+     * sorted by the group key.
+     */
+    bool isStreamableId(const Value& id) const;
+
+    /**
+     * Makes the current streaming group a regular group in '_groups' and stops streaming, so that
+     * it can be spilled.
+     */
+    void stopStreaming();
+
+    /**
+     * Adds 'rootDocument', whose group key is 'id', to its group in '_groups'.
+     */
+    void addToGroups(const Value& id, const Document& rootDocument);
+
+    /**
+     * Prepares '_groups', or the spilled groups, to be output once the input is exhausted.
+     */
+    void readyGroups();
+
     /**
      * Before returning anything, this source must prepare itself. In a streaming $group,
      * initialize() requests the first document from the previous source, and uses it to prepare the
@@ -278,6 +328,14 @@ private:
     Value _currentId;
     Accumulators _currentAccumulators;
 
+    // Whether the input is ordered such that groups are output as soon as the group key changes.
+    bool _streaming = false;
+    bool _doneStreaming = false;
+
+    // The group a streaming $group is accumulating. Unset until the first streamable document.
+    boost::optional<Value> _streamingId;
+    Accumulators _streamingAccumulators;
+
     // We use boost::optional to defer initialization until the ExpressionContext containing the
     // correct comparator is injected, since the groups must be built using the comparator's
     // definition of equality.
@@ -52,6 +52,7 @@
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
@@ -245,6 +246,119 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldStreamOnlyIfSortPatternLeadsWithGroupKeys) {
+    auto expCtx = getExpCtx();
+    auto makeGroup = [&] {
+        return DocumentSourceGroup::createFromBson(
+            fromjson("{$group: {_id: {x: '$a', y: '$b.c'}}}").firstElement(), expCtx);
+    };
+    auto streamsWith = [&](intrusive_ptr<DocumentSource> source, const char* sortSpec) {
+        auto group = static_cast<DocumentSourceGroup*>(source.get());
+        group->setInputSortPattern(SortPattern(fromjson(sortSpec), expCtx));
+        return group->isStreaming();
+    };
+
+    ASSERT_FALSE(streamsWith(makeGroup(), "{a: 1, 'b.c': 1}"));
+
+    RAIIServerParameterControllerForTest controller("internalDocumentSourceGroupStreamSortedInput",
+                                                    true);
+    ASSERT_TRUE(streamsWith(makeGroup(), "{a: 1, 'b.c': 1}"));
+    ASSERT_TRUE(streamsWith(makeGroup(), "{'b.c': -1, a: 1, d: 1}"));
+    ASSERT_FALSE(streamsWith(makeGroup(), "{a: 1}"));
+    ASSERT_FALSE(streamsWith(makeGroup(), "{a: 1, d: 1, 'b.c': 1}"));
+    ASSERT_FALSE(streamsWith(makeGroup(), "{a: 1, b: 1}"));
+    ASSERT_FALSE(streamsWith(makeGroup(), "{a: 1, 'b.c': {$meta: 'textScore'}}"));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldStreamGroupsOfSortedInput) {
+    RAIIServerParameterControllerForTest controller("internalDocumentSourceGroupStreamSortedInput",
+                                                    true);
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+    auto source = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$a', count: {$sum: 1}}}").firstElement(), expCtx);
+    auto group = static_cast<DocumentSourceGroup*>(source.get());
+    group->setInputSortPattern(SortPattern(fromjson("{a: 1}"), expCtx));
+    ASSERT_TRUE(group->isStreaming());
+
+    // Documents whose group key is missing or an array sort among the others, so their groups are
+    // only output at the end.
+    auto mock =
+        DocumentSourceMock::createForTest({Document(),
+                                           Document{{"a", 1}},
+                                           Document{{"a", BSON_ARRAY(1 << 2)}},
+                                           Document{{"a", 1}},
+                                           Document{{"a", 2}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 2}},
+                                           Document{{"a", 3}}},
+                                          expCtx);
+    group->setSource(mock.get());
+
+    auto next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+    ASSERT_TRUE(group->getNext().isPaused());
+    next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 2}, {"count", 2}}));
+    next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"_id", 3}, {"count", 1}}));
+
+    std::vector<Document> remaining;
+    for (next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        remaining.push_back(next.releaseDocument());
+    }
+    ASSERT_TRUE(next.isEOF());
+    ASSERT_EQ(remaining.size(), 2UL);
+    if (remaining[0]["_id"].nullish()) {
+        std::swap(remaining[0], remaining[1]);
+    }
+    ASSERT_DOCUMENT_EQ(remaining[0], (Document{{"_id", BSON_ARRAY(1 << 2)}, {"count", 1}}));
+    ASSERT_DOCUMENT_EQ(remaining[1], (Document{{"_id", BSONNULL}, {"count", 1}}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldStopStreamingToSpillAGroupWhichIsTooLarge) {
+    RAIIServerParameterControllerForTest controller("internalDocumentSourceGroupStreamSortedInput",
+                                                    true);
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    auto&& parser = AccumulationStatement::getParser("$push", boost::none);
+    auto accumulatorArg = BSON(""
+                               << "$largeStr");
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    AccumulationStatement pushStatement{"spaceHog", accExpr};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$a", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement}, maxMemoryUsageBytes);
+    group->setInputSortPattern(SortPattern(fromjson("{a: 1}"), expCtx));
+    ASSERT_TRUE(group->isStreaming());
+
+    string largeStr(maxMemoryUsageBytes / 2, 'x');
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 1}, {"largeStr", largeStr}},
+                                                   Document{{"a", 1}, {"largeStr", largeStr}},
+                                                   Document{{"a", 1}, {"largeStr", largeStr}},
+                                                   Document{{"a", 2}, {"largeStr", largeStr}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    std::map<int, size_t> groupSizes;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        groupSizes[doc["_id"].coerceToInt()] = doc["spaceHog"].getArrayLength();
+    }
+    ASSERT_TRUE(group->usedDisk());
+    ASSERT_EQ(groupSizes.size(), 2UL);
+    ASSERT_EQ(groupSizes[1], 3UL);
+    ASSERT_EQ(groupSizes[2], 1UL);
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -38,10 +38,12 @@
 #include <type_traits>
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_internal_expr_comparison.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -51,6 +53,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/logv2/log.h"
@@ -279,6 +282,157 @@ bool fieldIsComputed(BucketSpec spec, std::string field) {
                 expression::isPathPrefixOf(s, field);
         });
 }
+
+/**
+ * Returns whether the BucketUnpacker can evaluate 'expr' against a single column of a bucket. That
+ * is the case for comparisons on top-level measurement fields, which are neither the metaField nor
+ * computed from it.
+ */
+bool isEligibleForEventFilter(const MatchExpression* expr, const BucketSpec& spec) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            break;
+        default:
+            return false;
+    }
+
+    auto path = expr->path();
+    if (path.empty() || path.find('.') != std::string::npos) {
+        return false;
+    }
+    if (spec.metaField && path == *spec.metaField) {
+        return false;
+    }
+    return !fieldIsComputed(spec, path.toString());
+}
+
+/**
+ * Returns the name of the top-level field 'expr' refers to, or boost::none if it is not a path of
+ * that form.
+ */
+boost::optional<std::string> getTopLevelFieldPath(const Expression* expr) {
+    auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expr);
+    if (!fieldPath || fieldPath->getVariableId() != Variables::kRootId ||
+        fieldPath->getFieldPath().getPathLength() != 2) {
+        return boost::none;
+    }
+    return fieldPath->getFieldPath().getFieldName(1).toString();
+}
+
+bool dependsOnTimeField(const Expression* expr, const BucketSpec& spec) {
+    return expr->getDependencies().fields.count(spec.timeField) > 0;
+}
+
+/**
+ * Returns whether 'expr' is a $dateTrunc of the timeField with constant arguments. As $dateTrunc
+ * never decreases with time, all measurements of a bucket fall into the same bin when its minimum
+ * and maximum time do.
+ */
+bool isDateTruncOnTimeField(const Expression* expr, const BucketSpec& spec) {
+    auto dateTrunc = dynamic_cast<const ExpressionDateTrunc*>(expr);
+    if (!dateTrunc) {
+        return false;
+    }
+
+    auto&& children = dateTrunc->getChildren();
+    auto date = dynamic_cast<const ExpressionFieldPath*>(children[0].get());
+    if (!date || !date->representsPath(spec.timeField)) {
+        return false;
+    }
+    return std::all_of(std::next(children.begin()), children.end(), [](auto&& child) {
+        return !child || dynamic_cast<const ExpressionConstant*>(child.get());
+    });
+}
+
+/**
+ * Returns whether $_internalUnpackBucket can compute the partial results of 'group' for each bucket
+ * on its own. That is the case when the group key depends on the timeField, and otherwise only on
+ * the metaField, and every accumulator is decomposable and accumulates a top-level measurement
+ * field or a constant.
+ */
+bool isEligibleForPartialGroup(const DocumentSourceGroup& group, const BucketSpec& spec) {
+    if (group.doingMerge()) {
+        return false;
+    }
+
+    bool keyDependsOnTime = false;
+    for (auto&& [_, idExpr] : group.getIdFields()) {
+        auto deps = idExpr->getDependencies();
+        if (deps.needWholeDocument || deps.getNeedsAnyMetadata() || !deps.vars.empty()) {
+            return false;
+        }
+        for (auto&& field : deps.fields) {
+            bool isOnMeta = spec.metaField &&
+                (field == *spec.metaField || expression::isPathPrefixOf(*spec.metaField, field));
+            if ((field != spec.timeField && !isOnMeta) || fieldIsComputed(spec, field)) {
+                return false;
+            }
+        }
+        keyDependsOnTime = keyDependsOnTime || deps.fields.count(spec.timeField);
+    }
+    if (!keyDependsOnTime) {
+        return false;
+    }
+
+    for (auto&& stmt : group.getAccumulatedFields()) {
+        auto&& op = stmt.expr.name;
+        if (op != "$min"_sd && op != "$max"_sd && op != "$sum"_sd && op != "$avg"_sd) {
+            return false;
+        }
+
+        auto arg = stmt.expr.argument.get();
+        if (dynamic_cast<const ExpressionConstant*>(arg)) {
+            continue;
+        }
+        auto field = getTopLevelFieldPath(arg);
+        if (!field || (spec.metaField && *field == *spec.metaField) ||
+            fieldIsComputed(spec, *field)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns whether the partial results of 'group' can be computed from the control fields of a
+ * bucket when all of its measurements fall into the same group. That is the case when it only has
+ * $min and $max accumulators on measurement fields other than the timeField, whose minimum is
+ * rounded down in the control fields, and the parts of the group key depending on time are
+ * $dateTrunc expressions.
+ */
+bool canComputePartialGroupFromControl(const DocumentSourceGroup& group, const BucketSpec& spec) {
+    for (auto&& [_, idExpr] : group.getIdFields()) {
+        if (dependsOnTimeField(idExpr.get(), spec) && !isDateTruncOnTimeField(idExpr.get(), spec)) {
+            return false;
+        }
+    }
+    return std::all_of(group.getAccumulatedFields().begin(),
+                       group.getAccumulatedFields().end(),
+                       [&](auto&& stmt) {
+                           auto field = getTopLevelFieldPath(stmt.expr.argument.get());
+                           return (stmt.expr.name == "$min"_sd || stmt.expr.name == "$max"_sd) &&
+                               field && *field != spec.timeField;
+                       });
+}
+
+/**
+ * Returns the predicates of the given $match expression, which are the children of a top-level
+ * $and, or the expression itself otherwise.
+ */
+std::vector<const MatchExpression*> getConjuncts(const MatchExpression* expr) {
+    if (expr->matchType() != MatchExpression::AND) {
+        return {expr};
+    }
+    std::vector<const MatchExpression*> conjuncts;
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        conjuncts.push_back(expr->getChild(i));
+    }
+    return conjuncts;
+}
 }  // namespace
 
 DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
@@ -305,6 +459,8 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
     auto hasBucketMaxSpanSeconds = false;
     auto bucketMaxSpanSeconds = 0;
     std::vector<std::string> computedMetaProjFields;
+    BSONObj eventFilterBson;
+    BSONObj partialGroupBson;
     for (auto&& elem : specElem.embeddedObject()) {
         auto fieldName = elem.fieldNameStringData();
         if (fieldName == kInclude || fieldName == kExclude) {
@@ -375,6 +531,16 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
                         field.find('.') == std::string::npos);
                 bucketSpec.computedMetaProjFields.emplace_back(field);
             }
+        } else if (fieldName == kPartialGroup) {
+            uassert(6102501,
+                    str::stream() << "partialGroup field must be an object, got: " << elem.type(),
+                    elem.type() == BSONType::Object);
+            partialGroupBson = elem.Obj().getOwned();
+        } else if (fieldName == kEventFilter) {
+            uassert(6102401,
+                    str::stream() << "eventFilter field must be an object, got: " << elem.type(),
+                    elem.type() == BSONType::Object);
+            eventFilterBson = elem.Obj().getOwned();
         } else {
             uasserted(5346506,
                       str::stream()
@@ -389,8 +555,32 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
             "The $_internalUnpackBucket stage requires a bucketMaxSpanSeconds parameter",
             hasBucketMaxSpanSeconds);
 
-    return make_intrusive<DocumentSourceInternalUnpackBucket>(
-        expCtx, BucketUnpacker{std::move(bucketSpec), unpackerBehavior}, bucketMaxSpanSeconds);
+    BucketUnpacker bucketUnpacker{bucketSpec, unpackerBehavior};
+    if (!eventFilterBson.isEmpty()) {
+        auto eventFilter = uassertStatusOK(MatchExpressionParser::parse(eventFilterBson, expCtx));
+        auto conjuncts = getConjuncts(eventFilter.get());
+        uassert(6102402,
+                "The $_internalUnpackBucket stage expects eventFilter to only hold comparisons on "
+                "top-level measurement fields",
+                std::all_of(conjuncts.begin(), conjuncts.end(), [&](auto&& expr) {
+                    return isEligibleForEventFilter(expr, bucketSpec);
+                }));
+        bucketUnpacker.setEventFilter(std::move(eventFilterBson), std::move(eventFilter));
+    }
+
+    auto unpack = make_intrusive<DocumentSourceInternalUnpackBucket>(
+        expCtx, std::move(bucketUnpacker), bucketMaxSpanSeconds);
+    if (!partialGroupBson.isEmpty()) {
+        auto group = boost::static_pointer_cast<DocumentSourceGroup>(
+            DocumentSourceGroup::createFromBson(BSON("$group" << partialGroupBson).firstElement(),
+                                                expCtx));
+        uassert(6102502,
+                "The $_internalUnpackBucket stage expects partialGroup to group on time bins with "
+                "decomposable accumulators",
+                isEligibleForPartialGroup(*group, bucketSpec));
+        unpack->setPartialGroup(std::move(group));
+    }
+    return unpack;
 }
 
 boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBsonExternal(
@@ -469,6 +659,15 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
                          return compFields;
                      }()});
 
+    if (auto&& eventFilterBson = _bucketUnpacker.eventFilterBson(); !eventFilterBson.isEmpty()) {
+        out.addField(kEventFilter, Value{eventFilterBson});
+    }
+
+    if (_partialGroup) {
+        out.addField(kPartialGroup,
+                     _partialGroup->serialize().getDocument()[_partialGroup->getSourceName()]);
+    }
+
     if (!explain) {
         array.push_back(Value(DOC(getSourceName() << out.freeze())));
         if (_sampleSize) {
@@ -487,27 +686,195 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
 DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
     tassert(5521502, "calling doGetNext() when '_sampleSize' is set is disallowed", !_sampleSize);
 
+    // When this stage took over a $group, each bucket is aggregated on its own instead of being
+    // unpacked, and the partial results are returned one group at a time.
+    if (_partialGroup) {
+        while (_partialGroupResults.empty()) {
+            auto nextResult = pSource->getNext();
+            if (!nextResult.isAdvanced()) {
+                return nextResult;
+            }
+            _bucketUnpacker.reset(nextResult.getDocument().toBson());
+            uassert(6102503,
+                    str::stream()
+                        << "A bucket with _id "
+                        << _bucketUnpacker.bucket()[timeseries::kBucketIdFieldName].toString()
+                        << " contains an empty data region",
+                    _bucketUnpacker.numberOfMeasurements() > 0);
+            accumulatePartialGroups();
+        }
+
+        auto result = std::move(_partialGroupResults.front());
+        _partialGroupResults.pop_front();
+        return result;
+    }
+
     // Otherwise, fallback to unpacking every measurement in all buckets until the child stage is
     // exhausted.
     if (_bucketUnpacker.hasNext()) {
         return _bucketUnpacker.getNext();
     }
 
+    // No measurement of a bucket may satisfy the event filter, in which case we move on to the next
+    // bucket.
     auto nextResult = pSource->getNext();
-    if (nextResult.isAdvanced()) {
+    while (nextResult.isAdvanced()) {
         auto bucket = nextResult.getDocument().toBson();
         _bucketUnpacker.reset(std::move(bucket));
         uassert(5346509,
                 str::stream() << "A bucket with _id "
                               << _bucketUnpacker.bucket()[timeseries::kBucketIdFieldName].toString()
                               << " contains an empty data region",
-                _bucketUnpacker.hasNext());
-        return _bucketUnpacker.getNext();
+                _bucketUnpacker.numberOfMeasurements() > 0);
+        if (_bucketUnpacker.hasNext()) {
+            return _bucketUnpacker.getNext();
+        }
+        nextResult = pSource->getNext();
     }
 
     return nextResult;
 }
 
+void DocumentSourceInternalUnpackBucket::setPartialGroup(
+    boost::intrusive_ptr<DocumentSourceGroup> group) {
+    auto&& spec = _bucketUnpacker.bucketSpec();
+    auto idFields = group->getIdFields();
+    _partialGroupKeyNeedsTime = std::any_of(idFields.begin(), idFields.end(), [&](auto&& idField) {
+        return dependsOnTimeField(idField.second.get(), spec);
+    });
+    // The control fields are compared without regard to the collation of the query.
+    _partialGroupFromControl =
+        !pExpCtx->getCollator() && canComputePartialGroupFromControl(*group, spec);
+    _partialGroup = std::move(group);
+}
+
+void DocumentSourceInternalUnpackBucket::accumulatePartialGroups() {
+    auto&& spec = _bucketUnpacker.bucketSpec();
+    auto&& bucket = _bucketUnpacker.bucket();
+    auto&& accumulatedFields = _partialGroup->getAccumulatedFields();
+    auto metaValue = bucket[timeseries::kBucketMetaFieldName];
+
+    // The group key only depends on the timeField and the metaField, so it is computed from a
+    // document holding just those.
+    auto computeGroupKey = [&](const BSONElement& time) {
+        MutableDocument root;
+        if (time) {
+            root.addField(spec.timeField, Value{time});
+        }
+        if (spec.metaField && metaValue) {
+            root.addField(*spec.metaField, Value{metaValue});
+        }
+        return _partialGroup->computeGroupKey(root.freeze());
+    };
+
+    auto groups = pExpCtx->getValueComparator()
+                      .makeUnorderedValueMap<std::vector<boost::intrusive_ptr<AccumulatorState>>>();
+    auto getAccumulators = [&](Value key) -> auto& {
+        auto [it, inserted] = groups.try_emplace(std::move(key));
+        if (inserted) {
+            for (auto&& stmt : accumulatedFields) {
+                it->second.push_back(stmt.makeAccumulator());
+            }
+        }
+        return it->second;
+    };
+
+    // Each group of the bucket is returned in the shape of the partial results the merging $group
+    // expects.
+    auto returnGroups = [&] {
+        for (auto&& [key, accumulators] : groups) {
+            MutableDocument out;
+            out.addField("_id"_sd, key);
+            for (size_t i = 0; i < accumulatedFields.size(); ++i) {
+                out.addField(accumulatedFields[i].fieldName,
+                             accumulators[i]->getValue(/*toBeMerged=*/true));
+            }
+            _partialGroupResults.push_back(out.freeze());
+        }
+    };
+
+    if (_partialGroupFromControl) {
+        auto controlValue = [&](StringData prefix, StringData field) {
+            return dotted_path_support::extractElementAtPath(bucket,
+                                                             str::stream() << prefix << field);
+        };
+
+        auto key = computeGroupKey(controlValue(timeseries::kControlMinFieldNamePrefix,
+                                                spec.timeField));
+        if (pExpCtx->getValueComparator().evaluate(
+                key ==
+                computeGroupKey(
+                    controlValue(timeseries::kControlMaxFieldNamePrefix, spec.timeField)))) {
+            std::vector<Value> inputs;
+            for (auto&& stmt : accumulatedFields) {
+                auto elem = controlValue(stmt.expr.name == "$min"_sd
+                                             ? timeseries::kControlMinFieldNamePrefix
+                                             : timeseries::kControlMaxFieldNamePrefix,
+                                         *getTopLevelFieldPath(stmt.expr.argument.get()));
+                // Nulls sort before every other value in the control fields while $min and $max
+                // ignore them, and the control fields hold the bounds of objects and arrays field
+                // by field.
+                if (elem.isNull() || elem.type() == BSONType::Undefined ||
+                    elem.type() == BSONType::Object || elem.type() == BSONType::Array) {
+                    break;
+                }
+                inputs.push_back(elem ? Value{elem} : Value{});
+            }
+
+            if (inputs.size() == accumulatedFields.size()) {
+                auto&& accumulators = getAccumulators(std::move(key));
+                for (size_t i = 0; i < inputs.size(); ++i) {
+                    accumulators[i]->process(inputs[i], false);
+                }
+                returnGroups();
+                return;
+            }
+        }
+    }
+
+    // Otherwise, walk the columns of the bucket. The input of each accumulator is either a column,
+    // the timeField or a constant.
+    struct AccumulatorInput {
+        boost::optional<BSONObjIterator> column;
+        bool isTime = false;
+        Value constant;
+    };
+    auto&& dataRegion = bucket.getField(timeseries::kBucketDataFieldName).Obj();
+    std::vector<AccumulatorInput> inputs(accumulatedFields.size());
+    for (size_t i = 0; i < accumulatedFields.size(); ++i) {
+        auto&& argument = accumulatedFields[i].expr.argument;
+        if (auto field = getTopLevelFieldPath(argument.get()); !field) {
+            inputs[i].constant = argument->evaluate(Document{}, &pExpCtx->variables);
+        } else if (*field == spec.timeField) {
+            inputs[i].isTime = true;
+        } else if (auto column = dataRegion.getField(*field)) {
+            inputs[i].column = BSONObjIterator{column.Obj()};
+        }
+    }
+
+    boost::optional<Value> bucketKey;
+    if (!_partialGroupKeyNeedsTime) {
+        bucketKey = computeGroupKey(BSONElement{});
+    }
+
+    for (auto&& time : dataRegion.getField(spec.timeField).Obj()) {
+        auto&& accumulators = getAccumulators(bucketKey ? *bucketKey : computeGroupKey(time));
+        auto currentIdx = time.fieldNameStringData();
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            auto&& input = inputs[i];
+            if (input.isTime) {
+                accumulators[i]->process(Value{time}, false);
+            } else if (auto&& column = input.column;
+                       column && column->more() && (**column).fieldNameStringData() == currentIdx) {
+                accumulators[i]->process(Value{column->next()}, false);
+            } else {
+                accumulators[i]->process(input.constant, false);
+            }
+        }
+    }
+    returnGroups();
+}
+
 bool DocumentSourceInternalUnpackBucket::pushDownComputedMetaProjection(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     bool nextStageWasRemoved = false;
@@ -737,6 +1104,37 @@ DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(
     return nullptr;
 }
 
+std::pair<BSONObj, boost::intrusive_ptr<DocumentSourceMatch>>
+DocumentSourceInternalUnpackBucket::splitMatchForEventFilter(DocumentSourceMatch* match) const {
+    BSONArrayBuilder eventPredicates;
+    BSONArrayBuilder remainingPredicates;
+    for (auto&& expr : getConjuncts(match->getMatchExpression())) {
+        BSONObjBuilder bob;
+        expr->serialize(&bob);
+        if (isEligibleForEventFilter(expr, _bucketUnpacker.bucketSpec())) {
+            eventPredicates.append(bob.obj());
+        } else {
+            remainingPredicates.append(bob.obj());
+        }
+    }
+
+    auto conjunction = [](BSONArray predicates) {
+        return predicates.nFields() == 1 ? predicates.firstElement().Obj().getOwned()
+                                         : BSON("$and" << predicates);
+    };
+
+    auto eventArr = eventPredicates.arr();
+    if (eventArr.isEmpty()) {
+        return {};
+    }
+
+    auto remainingArr = remainingPredicates.arr();
+    return {conjunction(eventArr),
+            remainingArr.isEmpty()
+                ? nullptr
+                : DocumentSourceMatch::create(conjunction(remainingArr), pExpCtx)};
+}
+
 std::pair<boost::intrusive_ptr<DocumentSourceMatch>, boost::intrusive_ptr<DocumentSourceMatch>>
 DocumentSourceInternalUnpackBucket::splitMatchOnMetaAndRename(
     boost::intrusive_ptr<DocumentSourceMatch> match) {
@@ -763,7 +1161,7 @@ std::pair<bool, Pipeline::SourceContainer::iterator>
 DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContainer::iterator itr,
                                                          Pipeline::SourceContainer* container) {
     const auto* groupPtr = dynamic_cast<DocumentSourceGroup*>(std::next(itr)->get());
-    if (groupPtr == nullptr) {
+    if (groupPtr == nullptr || _bucketUnpacker.eventFilter()) {
         return {};
     }
 
@@ -863,6 +1261,25 @@ DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContain
     return {};
 }
 
+std::pair<bool, Pipeline::SourceContainer::iterator>
+DocumentSourceInternalUnpackBucket::rewriteGroupByTimeBins(Pipeline::SourceContainer::iterator itr,
+                                                           Pipeline::SourceContainer* container) {
+    auto groupPtr = dynamic_cast<DocumentSourceGroup*>(std::next(itr)->get());
+    if (groupPtr == nullptr || _partialGroup || _sampleSize || _bucketUnpacker.eventFilter() ||
+        !isEligibleForPartialGroup(*groupPtr, _bucketUnpacker.bucketSpec())) {
+        return {};
+    }
+
+    // This stage produces the partial results of the $group, as a shard would, so the $group is
+    // replaced with the stage merging them.
+    auto mergingGroup = groupPtr->distributedPlanLogic()->mergingStage;
+    setPartialGroup(groupPtr);
+    *std::next(itr) = std::move(mergingGroup);
+
+    // The rest of the optimizations of this stage only concern the unpacked measurements.
+    return {true, std::next(itr)};
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
@@ -917,6 +1334,14 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         }
     }
 
+    {
+        // Check if we can aggregate each bucket on its own if we have a group stage on time bins.
+        auto [success, result] = rewriteGroupByTimeBins(itr, container);
+        if (success) {
+            return result;
+        }
+    }
+
     {
         // Check if the rest of the pipeline needs any fields. For example we might only be
         // interested in $count.
@@ -967,6 +1392,28 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         }
     }
 
+    // Attempt to evaluate the comparisons of a $match on measurement fields while unpacking, so
+    // that measurements which do not satisfy them are never materialized. This must come after the
+    // predicates on the control field were created from the entire $match.
+    if (auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+        nextMatch && !_sampleSize && !_bucketUnpacker.eventFilter() &&
+        internalQueryTimeseriesPushdownEventFilter.load()) {
+        if (auto [eventFilterBson, remainingMatch] = splitMatchForEventFilter(nextMatch);
+            !eventFilterBson.isEmpty()) {
+            auto eventFilter =
+                uassertStatusOK(MatchExpressionParser::parse(eventFilterBson, pExpCtx));
+            _bucketUnpacker.setEventFilter(std::move(eventFilterBson), std::move(eventFilter));
+
+            container->erase(std::next(itr));
+            if (remainingMatch) {
+                container->insert(std::next(itr), remainingMatch);
+            }
+
+            // Try to optimize this stage again with the stage that now follows it.
+            return itr;
+        }
+    }
+
     // Attempt to push down a $project on the metaField past $_internalUnpackBucket.
     if (!haveComputedMetaField) {
         if (auto [metaProject, deleteRemainder] = extractProjectForPushDown(std::next(itr)->get());
@@ -29,11 +29,13 @@
 
 #pragma once
 
+#include <deque>
 #include <set>
 #include <vector>
 
 #include "mongo/db/exec/bucket_unpacker.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
 
 namespace mongo {
@@ -44,6 +46,8 @@ public:
     static constexpr StringData kInclude = "include"_sd;
     static constexpr StringData kExclude = "exclude"_sd;
     static constexpr StringData kBucketMaxSpanSeconds = "bucketMaxSpanSeconds"_sd;
+    static constexpr StringData kEventFilter = "eventFilter"_sd;
+    static constexpr StringData kPartialGroup = "partialGroup"_sd;
 
     static boost::intrusive_ptr<DocumentSource> createFromBsonInternal(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
@@ -105,6 +109,10 @@ public:
         return _bucketUnpacker;
     }
 
+    const MatchExpression* eventFilter() const {
+        return _bucketUnpacker.eventFilter();
+    }
+
     Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
                                                      Pipeline::SourceContainer* container) final;
 
@@ -141,6 +149,15 @@ public:
     std::pair<boost::intrusive_ptr<DocumentSourceMatch>, boost::intrusive_ptr<DocumentSourceMatch>>
     splitMatchOnMetaAndRename(boost::intrusive_ptr<DocumentSourceMatch> match);
 
+    /**
+     * Attempts to split 'match' into a filter which the BucketUnpacker can evaluate against the
+     * columns of each bucket, made of its comparisons on top-level measurement fields, and a $match
+     * holding the rest of its predicates. Returns an empty BSONObj as the filter if no predicate is
+     * eligible, and a null pointer as the $match if every predicate is.
+     */
+    std::pair<BSONObj, boost::intrusive_ptr<DocumentSourceMatch>> splitMatchForEventFilter(
+        DocumentSourceMatch* match) const;
+
     /**
      * Takes a predicate after $_internalUnpackBucket on a bucketed field as an argument and
      * attempts to map it to a new predicate on the 'control' field. For example, the predicate
@@ -199,15 +216,50 @@ public:
     std::pair<bool, Pipeline::SourceContainer::iterator> rewriteGroupByMinMax(
         Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container);
 
+    /**
+     * Helper method which checks if the group stage following this stage groups on time bins, such
+     * as {$dateTrunc: {date: '$time', unit: 'minute'}}, and the metaField with decomposable
+     * accumulators. If so, this stage takes over the $group, which is replaced with the $group
+     * merging its partial results, and aggregates each bucket on its own without unpacking it into
+     * measurements. If a rewrite is possible, 'container' is modified, and we return the result
+     * value for 'doOptimizeAt'.
+     */
+    std::pair<bool, Pipeline::SourceContainer::iterator> rewriteGroupByTimeBins(
+        Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container);
+
+    /**
+     * Sets the $group whose partial results this stage produces for each bucket.
+     */
+    void setPartialGroup(boost::intrusive_ptr<DocumentSourceGroup> group);
+
+    const DocumentSourceGroup* partialGroup() const {
+        return _partialGroup.get();
+    }
+
 private:
     GetNextResult doGetNext() final;
 
+    /**
+     * Aggregates the bucket currently held by '_bucketUnpacker' into '_partialGroupResults', using
+     * the control fields of the bucket when all of its measurements fall into the same group.
+     */
+    void accumulatePartialGroups();
+
     BucketUnpacker _bucketUnpacker;
     int _bucketMaxSpanSeconds;
 
     int _bucketMaxCount = 0;
     boost::optional<long long> _sampleSize;
 
+    // When set, buckets are aggregated into partial results of this $group instead of being
+    // unpacked. '_partialGroupFromControl' records whether the accumulators can be computed from
+    // the control fields of a bucket, and '_partialGroupKeyNeedsTime' whether the group key needs
+    // to be computed for every measurement rather than once per bucket.
+    boost::intrusive_ptr<DocumentSourceGroup> _partialGroup;
+    bool _partialGroupFromControl = false;
+    bool _partialGroupKeyNeedsTime = false;
+    std::deque<Document> _partialGroupResults;
+
     // Used to avoid infinite loops after we step backwards to optimize a $match on bucket level
     // fields, otherwise we may do an infinite number of $match pushdowns.
     bool _triedBucketLevelFieldsPredicatesPushdown = false;
@@ -0,0 +1,184 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/bson_test_util.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketEventFilterTest = AggregationContextFixture;
+
+const auto kUnpackSpec = fromjson(
+    "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+    "bucketMaxSpanSeconds: 3600}}");
+
+TEST_F(InternalUnpackBucketEventFilterTest, SplitsComparisonsOnMeasurementFields) {
+    auto unpack =
+        DocumentSourceInternalUnpackBucket::createFromBsonInternal(kUnpackSpec.firstElement(),
+                                                                   getExpCtx());
+    auto matchToSplit = DocumentSourceMatch::create(
+        fromjson("{a: {$gt: 1}, 'b.c': 2, time: {$lt: 5}, myMeta: 3, d: {$in: [1, 2]}}"),
+        getExpCtx());
+
+    auto [eventFilter, remainingMatch] =
+        dynamic_cast<DocumentSourceInternalUnpackBucket*>(unpack.get())
+            ->splitMatchForEventFilter(matchToSplit.get());
+
+    // Dotted paths, predicates on the metaField and non-comparison predicates stay in the $match.
+    ASSERT_BSONOBJ_EQ(fromjson("{$and: [{a: {$gt: 1}}, {time: {$lt: 5}}]}"), eventFilter);
+    ASSERT_TRUE(remainingMatch);
+    ASSERT_BSONOBJ_EQ(fromjson("{$and: [{'b.c': {$eq: 2}}, {myMeta: {$eq: 3}}, {d: {$in: [1, "
+                               "2]}}]}"),
+                      remainingMatch->getQuery());
+}
+
+TEST_F(InternalUnpackBucketEventFilterTest, SplitsEntireMatch) {
+    auto unpack =
+        DocumentSourceInternalUnpackBucket::createFromBsonInternal(kUnpackSpec.firstElement(),
+                                                                   getExpCtx());
+    auto matchToSplit = DocumentSourceMatch::create(fromjson("{a: {$gte: 1}}"), getExpCtx());
+
+    auto [eventFilter, remainingMatch] =
+        dynamic_cast<DocumentSourceInternalUnpackBucket*>(unpack.get())
+            ->splitMatchForEventFilter(matchToSplit.get());
+
+    ASSERT_BSONOBJ_EQ(fromjson("{a: {$gte: 1}}"), eventFilter);
+    ASSERT_FALSE(remainingMatch);
+}
+
+TEST_F(InternalUnpackBucketEventFilterTest, DoesNotSplitComputedMetaProjFields) {
+    auto unpack = DocumentSourceInternalUnpackBucket::createFromBsonInternal(
+        fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+                 "computedMetaProjFields: ['a'], bucketMaxSpanSeconds: 3600}}")
+            .firstElement(),
+        getExpCtx());
+    auto matchToSplit = DocumentSourceMatch::create(fromjson("{a: {$gte: 1}}"), getExpCtx());
+
+    auto [eventFilter, remainingMatch] =
+        dynamic_cast<DocumentSourceInternalUnpackBucket*>(unpack.get())
+            ->splitMatchForEventFilter(matchToSplit.get());
+
+    ASSERT_TRUE(eventFilter.isEmpty());
+    ASSERT_TRUE(remainingMatch);
+    ASSERT_BSONOBJ_EQ(matchToSplit->getQuery(), remainingMatch->getQuery());
+}
+
+TEST_F(InternalUnpackBucketEventFilterTest, OptimizeAbsorbsEventFilter) {
+    RAIIServerParameterControllerForTest controller("internalQueryTimeseriesPushdownEventFilter",
+                                                    true);
+    auto pipeline = Pipeline::parse(
+        makeVector(kUnpackSpec, fromjson("{$match: {a: {$lte: 4}, b: {$in: [1, 2]}}}")),
+        getExpCtx());
+    pipeline->optimizePipeline();
+
+    // The predicates on the control fields are still created from the entire $match.
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(3u, serialized.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{$match: {'control.min.a': {$_internalExprLte: 4}}}"),
+                      serialized[0]);
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+                 "bucketMaxSpanSeconds: 3600, eventFilter: {a: {$lte: 4}}}}"),
+        serialized[1]);
+    ASSERT_BSONOBJ_EQ(fromjson("{$match: {b: {$in: [1, 2]}}}"), serialized[2]);
+}
+
+TEST_F(InternalUnpackBucketEventFilterTest, OptimizeKeepsMatchWhenDisabled) {
+    RAIIServerParameterControllerForTest controller("internalQueryTimeseriesPushdownEventFilter",
+                                                    false);
+    auto pipeline = Pipeline::parse(makeVector(kUnpackSpec, fromjson("{$match: {a: {$lte: 4}}}")),
+                                    getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(3u, serialized.size());
+    ASSERT_BSONOBJ_EQ(kUnpackSpec, serialized[1]);
+    ASSERT_BSONOBJ_EQ(fromjson("{$match: {a: {$lte: 4}}}"), serialized[2]);
+}
+
+TEST_F(InternalUnpackBucketEventFilterTest, ParseRejectsIneligibleEventFilter) {
+    ASSERT_THROWS_CODE(DocumentSourceInternalUnpackBucket::createFromBsonInternal(
+                           fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', "
+                                    "bucketMaxSpanSeconds: 3600, eventFilter: {'a.b': 1}}}")
+                               .firstElement(),
+                           getExpCtx()),
+                       AssertionException,
+                       6102402);
+    ASSERT_THROWS_CODE(DocumentSourceInternalUnpackBucket::createFromBsonInternal(
+                           fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', "
+                                    "bucketMaxSpanSeconds: 3600, eventFilter: 1}}")
+                               .firstElement(),
+                           getExpCtx()),
+                       AssertionException,
+                       6102401);
+}
+
+TEST_F(InternalUnpackBucketEventFilterTest, UnpackSkipsMeasurementsAndBuckets) {
+    auto unpack = DocumentSourceInternalUnpackBucket::createFromBsonInternal(
+        fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+                 "bucketMaxSpanSeconds: 3600, eventFilter: {$and: [{a: {$gte: 2}}, {time: {$lt: "
+                 "6}}]}}}")
+            .firstElement(),
+        getExpCtx());
+    // The second bucket has no measurement satisfying the filter, and 'a' is sparse in the third.
+    auto source = DocumentSourceMock::createForTest(
+        {"{meta: 1, data: {_id: {'0':1, '1':2}, time: {'0':1, '1':2}, a: {'0':1, '1':2}}}",
+         "{meta: 2, data: {_id: {'0':3}, time: {'0':3}, a: {'0':1}}}",
+         "{meta: 3, data: {_id: {'0':4, '1':5, '2':6}, time: {'0':4, '1':5, '2':6}, "
+         "a: {'0':[1, 3], '2':2}}}"},
+        getExpCtx());
+    unpack->setSource(source.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 2, myMeta: 1, _id: 2, a: 2}")));
+
+    // Arrays are matched element-wise, and the last measurement fails the filter on 'time'.
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 4, myMeta: 3, _id: 4, a: [1, 3]}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
+}  // namespace
+}  // namespace mongo
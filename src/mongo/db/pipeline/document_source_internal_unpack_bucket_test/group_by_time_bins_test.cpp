@@ -0,0 +1,164 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/unittest/bson_test_util.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketGroupByTimeBinsTest = AggregationContextFixture;
+
+const auto kUnpackSpec = fromjson(
+    "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+    "bucketMaxSpanSeconds: 3600}}");
+
+// The first bucket falls into a single minute, the second one spans two minutes.
+const std::vector<BSONObj> kBuckets = {
+    fromjson("{control: {min: {time: {$date: 0}, a: 1}, max: {time: {$date: 30000}, a: 5}}, "
+             "meta: 'x', data: {time: {'0': {$date: 0}, '1': {$date: 30000}}, a: {'0': 1, '1': "
+             "5}}}"),
+    fromjson("{control: {min: {time: {$date: 30000}, a: 2}, max: {time: {$date: 90000}, a: 6}}, "
+             "meta: 'x', data: {time: {'0': {$date: 30000}, '1': {$date: 90000}, '2': {$date: "
+             "60000}}, a: {'0': 6, '1': 2}}}")};
+
+std::vector<Document> runPipeline(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                  const BSONObj& groupSpec) {
+    auto pipeline = Pipeline::parse(makeVector(kUnpackSpec, groupSpec), expCtx);
+    pipeline->optimizePipeline();
+
+    std::deque<DocumentSource::GetNextResult> buckets;
+    for (auto&& bucket : kBuckets) {
+        buckets.push_back(Document{bucket});
+    }
+    pipeline->addInitialSource(DocumentSourceMock::createForTest(std::move(buckets), expCtx));
+
+    std::vector<Document> results;
+    while (auto next = pipeline->getNext()) {
+        results.push_back(*next);
+    }
+    std::sort(results.begin(), results.end(), [](auto&& lhs, auto&& rhs) {
+        return Value::compare(lhs["_id"], rhs["_id"], nullptr) < 0;
+    });
+    return results;
+}
+
+TEST_F(InternalUnpackBucketGroupByTimeBinsTest, OptimizeTakesOverGroup) {
+    auto groupSpec = fromjson(
+        "{$group: {_id: {$dateTrunc: {date: '$time', unit: 'minute'}}, avg: {$avg: '$a'}}}");
+    auto pipeline = Pipeline::parse(makeVector(kUnpackSpec, groupSpec), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto&& sources = pipeline->getSources();
+    ASSERT_EQ(2u, sources.size());
+    auto unpack = dynamic_cast<DocumentSourceInternalUnpackBucket*>(sources.front().get());
+    ASSERT_TRUE(unpack);
+    ASSERT_TRUE(unpack->partialGroup());
+    auto mergingGroup = dynamic_cast<DocumentSourceGroup*>(sources.back().get());
+    ASSERT_TRUE(mergingGroup);
+    ASSERT_TRUE(mergingGroup->doingMerge());
+
+    // The $group is serialized into the stage so that it survives being sent to the shards.
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(2u, serialized.size());
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+                 "bucketMaxSpanSeconds: 3600, partialGroup: {_id: {$dateTrunc: {date: '$time', "
+                 "unit: {$const: 'minute'}}}, avg: {$avg: '$a'}}}}"),
+        serialized[0]);
+    auto reparsed = DocumentSourceInternalUnpackBucket::createFromBsonInternal(
+        serialized[0].firstElement(), getExpCtx());
+    ASSERT_TRUE(
+        dynamic_cast<DocumentSourceInternalUnpackBucket*>(reparsed.get())->partialGroup());
+}
+
+TEST_F(InternalUnpackBucketGroupByTimeBinsTest, OptimizeDoesNotTakeOverIneligibleGroups) {
+    for (auto&& groupSpec : {
+             // The group key does not depend on time.
+             fromjson("{$group: {_id: '$myMeta', s: {$sum: '$a'}}}"),
+             // The group key depends on a measurement field.
+             fromjson("{$group: {_id: {t: {$dateTrunc: {date: '$time', unit: 'minute'}}, a: "
+                      "'$a'}, s: {$sum: 1}}}"),
+             // $first is not decomposable.
+             fromjson("{$group: {_id: {$dateTrunc: {date: '$time', unit: 'minute'}}, f: {$first: "
+                      "'$a'}}}"),
+             // Dotted paths are not columns of the bucket.
+             fromjson("{$group: {_id: {$dateTrunc: {date: '$time', unit: 'minute'}}, m: {$max: "
+                      "'$a.b'}}}"),
+         }) {
+        auto pipeline = Pipeline::parse(makeVector(kUnpackSpec, groupSpec), getExpCtx());
+        pipeline->optimizePipeline();
+
+        for (auto&& source : pipeline->getSources()) {
+            if (auto unpack = dynamic_cast<DocumentSourceInternalUnpackBucket*>(source.get())) {
+                ASSERT_FALSE(unpack->partialGroup()) << groupSpec;
+            }
+        }
+    }
+}
+
+TEST_F(InternalUnpackBucketGroupByTimeBinsTest, ComputesAccumulatorsPerTimeBin) {
+    auto results = runPipeline(getExpCtx(),
+                               fromjson("{$group: {_id: {t: {$dateTrunc: {date: '$time', unit: "
+                                        "'minute'}}, m: '$myMeta'}, avg: {$avg: '$a'}, count: "
+                                        "{$sum: 1}, lo: {$min: '$a'}, last: {$max: '$time'}}}"));
+
+    // The measurement without a value for 'a' is only counted.
+    ASSERT_EQ(2u, results.size());
+    ASSERT_DOCUMENT_EQ(results[0],
+                       Document(fromjson("{_id: {t: {$date: 0}, m: 'x'}, avg: 4, count: 3, lo: "
+                                         "1, last: {$date: 30000}}")));
+    ASSERT_DOCUMENT_EQ(results[1],
+                       Document(fromjson("{_id: {t: {$date: 60000}, m: 'x'}, avg: 2, count: 2, "
+                                         "lo: 2, last: {$date: 90000}}")));
+}
+
+TEST_F(InternalUnpackBucketGroupByTimeBinsTest, UsesControlFieldsOfAlignedBuckets) {
+    auto results = runPipeline(
+        getExpCtx(),
+        fromjson("{$group: {_id: {$dateTrunc: {date: '$time', unit: 'minute'}}, lo: {$min: "
+                 "'$a'}, hi: {$max: '$a'}}}"));
+
+    ASSERT_EQ(2u, results.size());
+    ASSERT_DOCUMENT_EQ(results[0], Document(fromjson("{_id: {$date: 0}, lo: 1, hi: 6}")));
+    ASSERT_DOCUMENT_EQ(results[1], Document(fromjson("{_id: {$date: 60000}, lo: 2, hi: 2}")));
+}
+
+}  // namespace
+}  // namespace mongo
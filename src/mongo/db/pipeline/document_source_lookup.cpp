@@ -45,6 +45,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/lookup_result_cache.h"
 #include "mongo/db/pipeline/variable_validation.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/query_knobs_gen.h"
@@ -365,6 +366,32 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
     }
 
+    std::string resultCacheKey;
+    boost::optional<LookupResultCache::Version> resultCacheVersion;
+    if (canUseResultCache()) {
+        auto& resultCache = LookupResultCache::get(pExpCtx->opCtx->getServiceContext());
+        resultCacheKey = LookupResultCache::makeKey(_fromExpCtx->ns,
+                                                    _resolvedPipeline[*_fieldMatchPipelineIdx],
+                                                    _fromExpCtx->getCollatorBSON());
+        if (auto cached = resultCache.find(_fromExpCtx->ns, resultCacheKey)) {
+            std::vector<Value> results;
+            results.reserve(cached->size());
+            for (auto&& obj : *cached) {
+                results.emplace_back(Document(obj));
+            }
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(std::move(results)));
+            return output.freeze();
+        }
+
+        // The results may only be cached if they are read from a snapshot which is opened after
+        // the version of the foreign collection has been obtained.
+        if (!pExpCtx->opCtx->lockState()->inAWriteUnitOfWork()) {
+            resultCacheVersion = resultCache.getVersion(_fromExpCtx->ns);
+            pExpCtx->opCtx->recoveryUnit()->abandonSnapshot();
+        }
+    }
+
     std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
     try {
         pipeline = buildPipeline(inputDoc);
@@ -399,12 +426,36 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         results.emplace_back(std::move(*result));
     }
 
+    if (resultCacheVersion) {
+        std::vector<BSONObj> docs;
+        docs.reserve(results.size());
+        for (auto&& result : results) {
+            docs.push_back(result.getDocument().toBson());
+        }
+        LookupResultCache::get(pExpCtx->opCtx->getServiceContext())
+            .insert(_fromExpCtx->ns,
+                    resultCacheKey,
+                    *resultCacheVersion,
+                    std::move(docs),
+                    internalLookupStageResultCacheMaxSizeBytes.load());
+    }
+
     recordPlanSummaryStats(*pipeline);
     MutableDocument output(std::move(inputDoc));
     output.setNestedField(_as, Value(std::move(results)));
     return output.freeze();
 }
 
+bool DocumentSourceLookUp::canUseResultCache() const {
+    // The cache is invalidated by the writes which this node observes, so it cannot be used when
+    // the foreign collection may live on another node. A view is resolved to a pipeline which may
+    // read other collections, so only a plain collection can be cached.
+    return !pExpCtx->inMongos && serverGlobalParams.clusterRole == ClusterRole::None &&
+        !pExpCtx->explain && hasLocalFieldForeignFieldJoin() && !hasPipeline() &&
+        _letVariables.empty() && _resolvedPipeline.size() == 1 &&
+        LookupResultCache::canUseForOperation(pExpCtx->opCtx);
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     const Document& inputDoc) {
     // Copy all 'let' variables into the foreign pipeline's expression context.
@@ -190,6 +190,38 @@ public:
         return _letVariables;
     }
 
+    const NamespaceString& getFromNs() const {
+        return _fromNs;
+    }
+
+    const FieldPath& getAsField() const {
+        return _as;
+    }
+
+    bool hasUnwindSrc() const {
+        return static_cast<bool>(_unwindSrc);
+    }
+
+    bool hasAdditionalFilter() const {
+        return static_cast<bool>(_additionalFilter);
+    }
+
+    /**
+     * Returns true if the foreign namespace is a view, i.e. the documents are looked up in a
+     * namespace other than the one named by 'from'.
+     */
+    bool isFromNsView() const {
+        return _fromNs != _resolvedNs;
+    }
+
+    /**
+     * Returns true if the join is performed using the collation of the parent pipeline.
+     */
+    bool usesParentCollation() const {
+        return CollatorInterface::collatorsMatch(pExpCtx->getCollator(),
+                                                 _fromExpCtx->getCollator());
+    }
+
     /**
      * Returns a non-executable pipeline which can be useful for introspection. In this pipeline,
      * all view definitions are resolved. This pipeline is present in both the sub-pipeline version
@@ -304,6 +336,14 @@ private:
      */
     void recordPlanSummaryStats(const Pipeline& pipeline);
 
+    /**
+     * Returns whether the foreign-side results of this stage can be shared with other operations
+     * through the node-wide LookupResultCache. This is limited to a plain join on 'localField' and
+     * 'foreignField' against a local, unsharded collection, whose results are fully determined by
+     * the $match built from the input document.
+     */
+    bool canUseResultCache() const;
+
     /**
      * Given a mutable document, appends execution stats such as 'totalDocsExamined',
      * 'totalKeysExamined', 'collectionScans', 'indexesUsed', etc. to it.
@@ -37,6 +37,7 @@
 #include <fmt/ostream.h>
 #include <map>
 
+#include "mongo/bson/bsonobj_comparator.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/pipeline/document_path_support.h"
@@ -546,19 +547,28 @@ std::pair<DocumentSourceMerge::BatchObject, int> DocumentSourceMerge::makeBatchO
     return {{std::move(mergeOnFields), std::move(mod), std::move(vars)}, modSize};
 }
 
-void DocumentSourceMerge::spill(BatchedObjects&& batch) try {
-    DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
+void DocumentSourceMerge::spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                BatchedObjects&& batch) try {
+    DocumentSourceWriteBlock writeBlock(expCtx->opCtx);
     auto targetEpoch = _targetCollectionVersion
         ? boost::optional<OID>(_targetCollectionVersion->epoch())
         : boost::none;
 
-    _descriptor.strategy(pExpCtx, _outputNs, _writeConcern, targetEpoch, std::move(batch));
+    _descriptor.strategy(expCtx, _outputNs, _writeConcern, targetEpoch, std::move(batch));
 } catch (const ExceptionFor<ErrorCodes::ImmutableField>& ex) {
     uassertStatusOKWithContext(ex.toStatus(),
                                "$merge failed to update the matching document, did you "
                                "attempt to modify the _id or the shard key?");
 }
 
+boost::optional<size_t> DocumentSourceMerge::getOrderingKeyHash(const BatchObject& obj) const {
+    // The 'on' fields are matched using the collation of the aggregation, so equal keys must hash
+    // equally under it.
+    const BSONObjComparator comparator(
+        BSONObj(), BSONObjComparator::FieldNamesMode::kConsider, pExpCtx->getCollator());
+    return comparator.hash(std::get<0>(obj));
+}
+
 void DocumentSourceMerge::waitWhileFailPointEnabled() {
     CurOpFailpointHelpers::waitWhileFailPointEnabled(
         &hangWhileBuildingDocumentSourceMergeBatch,
@@ -183,7 +183,14 @@ private:
         return bob.obj();
     }
 
-    void spill(BatchedObjects&& batch) override;
+    void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+               BatchedObjects&& batch) override;
+
+    /**
+     * Documents with the same 'on' fields may match the same target document, so they must be
+     * merged in input order.
+     */
+    boost::optional<size_t> getOrderingKeyHash(const BatchObject& obj) const override;
 
     void waitWhileFailPointEnabled() override;
 
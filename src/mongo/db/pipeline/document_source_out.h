@@ -120,12 +120,13 @@ private:
 
     void finalize() override;
 
-    void spill(BatchedObjects&& batch) override {
-        DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
+    void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+               BatchedObjects&& batch) override {
+        DocumentSourceWriteBlock writeBlock(expCtx->opCtx);
 
         auto targetEpoch = boost::none;
-        uassertStatusOK(pExpCtx->mongoProcessInterface->insert(
-            pExpCtx, _tempNs, std::move(batch), _writeConcern, targetEpoch));
+        uassertStatusOK(expCtx->mongoProcessInterface->insert(
+            expCtx, _tempNs, std::move(batch), _writeConcern, targetEpoch));
     }
 
     std::pair<BSONObj, int> makeBatchObject(Document&& doc) const override {
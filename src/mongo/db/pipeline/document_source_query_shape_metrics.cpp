@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_query_shape_metrics.h"
+
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/stats/query_shape_metrics.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_DOCUMENT_SOURCE(queryShapeMetrics,
+                         DocumentSourceQueryShapeMetrics::LiteParsed::parse,
+                         DocumentSourceQueryShapeMetrics::createFromBson,
+                         AllowedWithApiStrict::kNeverInVersion1);
+
+const char* DocumentSourceQueryShapeMetrics::getSourceName() const {
+    return kStageName.rawData();
+}
+
+DocumentSource::GetNextResult DocumentSourceQueryShapeMetrics::doGetNext() {
+    if (!_initialized) {
+        _queryShapeMetrics =
+            QueryShapeMetrics::get(pExpCtx->opCtx->getServiceContext()).getStatsByQueryShape();
+        _queryShapeMetricsIter = _queryShapeMetrics.begin();
+        _initialized = true;
+    }
+
+    if (_queryShapeMetricsIter != _queryShapeMetrics.end()) {
+        auto doc = Document(std::move(*_queryShapeMetricsIter));
+        _queryShapeMetricsIter++;
+        return doc;
+    }
+
+    return GetNextResult::makeEOF();
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceQueryShapeMetrics::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    const NamespaceString& nss = pExpCtx->ns;
+    uassert(ErrorCodes::InvalidNamespace,
+            "$queryShapeMetrics must be run against the 'admin' database with {aggregate: 1}",
+            nss.db() == NamespaceString::kAdminDb && nss.isCollectionlessAggregateNS());
+
+    uassert(ErrorCodes::BadValue,
+            "The $queryShapeMetrics stage specification must be an empty object",
+            elem.type() == Object && elem.Obj().isEmpty());
+
+    return new DocumentSourceQueryShapeMetrics(pExpCtx);
+}
+
+Value DocumentSourceQueryShapeMetrics::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    return Value(DOC(getSourceName() << Document()));
+}
+}  // namespace mongo
@@ -29,7 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
-#include "mongo/db/exec/add_fields_projection_executor.h"
+#include "mongo/db/exec/inclusion_projection_executor.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_project.h"
@@ -342,6 +342,14 @@ void DocumentSourceInternalSetWindowFields::initialize() {
         _executableOutputs[wfs.fieldName] =
             WindowFunctionExec::create(pExpCtx.get(), &_iterator, wfs, _sortBy, &_memoryTracker);
     }
+    StringSet seenOutputs;
+    for (auto& wfs : _outputFields) {
+        if (seenOutputs.insert(wfs.fieldName).second) {
+            _orderedOutputs.emplace_back(FieldPath(wfs.fieldName),
+                                         _executableOutputs[wfs.fieldName].get());
+            _hasDottedOutputPaths |= _orderedOutputs.back().first.getPathLength() > 1;
+        }
+    }
     _init = true;
 }
 
@@ -445,26 +453,42 @@ DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext()
         return DocumentSource::GetNextResult::makeEOF();
     }
 
-    // Populate the output document with the result from each window function.
-    MutableDocument addFieldsSpec;
-    for (auto&& [fieldName, function] : _executableOutputs) {
+    // Populate the output document with the result from each window function. When every output
+    // is a top-level field the results are set directly on the current document. Dotted outputs
+    // go through an $addFields-style projection tree, so that they traverse arrays the same way,
+    // but the results are bound as constants rather than re-parsed as a projection spec.
+    MutableDocument outputDoc(*curDoc);
+    boost::optional<projection_executor::InclusionNode> dottedOutputs;
+    if (_hasDottedOutputPaths) {
+        dottedOutputs.emplace(
+            ProjectionPolicies{ProjectionPolicies::DefaultIdPolicy::kIncludeId,
+                               ProjectionPolicies::ArrayRecursionPolicy::kRecurseNestedArrays,
+                               ProjectionPolicies::ComputedFieldsPolicy::kAllowComputedFields});
+    }
+    for (auto&& [outputPath, function] : _orderedOutputs) {
         try {
             // If we hit a uassert while evaluating expressions on user data, delete the temporary
             // table before aborting the operation.
-            addFieldsSpec.addField(fieldName, function->getNext());
+            auto result = function->getNext();
+            if (dottedOutputs) {
+                dottedOutputs->addExpressionForPath(
+                    outputPath, ExpressionConstant::create(pExpCtx.get(), std::move(result)));
+            } else {
+                outputDoc.setField(outputPath.fullPath(), std::move(result));
+            }
         } catch (const DBException&) {
             _iterator.finalize();
             throw;
         }
 
-        if (_memoryTracker.currentMemoryBytes() >=
-                static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes) &&
+        if ((_memoryTracker.currentMemoryBytes() >=
+                 static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes) ||
+             !_memoryTracker.withinMemoryLimit()) &&
             _memoryTracker._allowDiskUse) {
             // Attempt to spill where possible.
             _iterator.spillToDisk();
         }
-        if (_memoryTracker.currentMemoryBytes() >
-            static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes)) {
+        if (!_memoryTracker.withinMemoryLimit()) {
             _iterator.finalize();
             uasserted(5414201,
                       str::stream()
@@ -494,10 +518,10 @@ DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext()
             _iterator.finalize();
             break;
     }
-    auto projExec = projection_executor::AddFieldsProjectionExecutor::create(
-        pExpCtx, addFieldsSpec.freeze().toBson());
-
-    return projExec->applyProjection(*curDoc);
+    if (dottedOutputs) {
+        dottedOutputs->applyExpressions(*curDoc, &outputDoc);
+    }
+    return outputDoc.freeze();
 }
 
 }  // namespace mongo
@@ -112,7 +112,7 @@ public:
           _partitionBy(partitionBy),
           _sortBy(std::move(sortBy)),
           _outputFields(std::move(outputFields)),
-          _memoryTracker{expCtx->allowDiskUse, maxMemoryBytes},
+          _memoryTracker{expCtx->allowDiskUse, maxMemoryBytes, expCtx->getOperationMemoryTracker()},
           _iterator(expCtx.get(), pSource, &_memoryTracker, std::move(partitionBy), _sortBy){};
 
     GetModPathsReturn getModifiedPaths() const final {
@@ -188,6 +188,9 @@ private:
     MemoryUsageTracker _memoryTracker;
     PartitionIterator _iterator;
     StringMap<std::unique_ptr<WindowFunctionExec>> _executableOutputs;
+    // The entries of '_executableOutputs' in the order of '_outputFields'.
+    std::vector<std::pair<FieldPath, WindowFunctionExec*>> _orderedOutputs;
+    bool _hasDottedOutputPaths = false;
     bool _init = false;
     bool _eof = false;
 };
@@ -212,5 +212,43 @@ TEST_F(DocumentSourceSetWindowFieldsTest, ReportsModifiedFields) {
     ASSERT_EQUALS(modified.paths.count("b"), 1U);
     ASSERT_TRUE(modified.renames.empty());
 }
+
+TEST_F(DocumentSourceSetWindowFieldsTest, ReplacesExistingFieldWithObjectResult) {
+    auto spec = fromjson(R"(
+        {$_internalSetWindowFields: {sortBy: {_id: 1}, output: {obj:
+        {$first: '$x', window: {documents: ["unbounded", "current"]}}}}})");
+    auto parsedStage =
+        DocumentSourceInternalSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    const auto mock = DocumentSourceMock::createForTest(
+        {"{_id: 0, obj: {b: 1}, x: {a: 1}}", "{_id: 1, obj: {b: 2}, x: {$a: 2}}"}, getExpCtx());
+    parsedStage->setSource(mock.get());
+
+    auto next = parsedStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson("{_id: 0, obj: {a: 1}, x: {a: 1}}")));
+    next = parsedStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{_id: 1, obj: {a: 1}, x: {$a: 2}}")));
+    ASSERT_TRUE(parsedStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, DottedOutputFieldTraversesArrays) {
+    auto spec = fromjson(R"(
+        {$_internalSetWindowFields: {sortBy: {_id: 1}, output: {'arr.d':
+        {$first: '$_id', window: {documents: ["unbounded", "current"]}}, top:
+        {$first: '$_id', window: {documents: ["unbounded", "current"]}}}}})");
+    auto parsedStage =
+        DocumentSourceInternalSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    const auto mock =
+        DocumentSourceMock::createForTest({"{_id: 0, arr: [{c: 0}, {c: 1}]}"}, getExpCtx());
+    parsedStage->setSource(mock.get());
+
+    auto next = parsedStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{_id: 0, arr: [{c: 0, d: 0}, {c: 1, d: 0}], top: 0}")));
+    ASSERT_TRUE(parsedStage->getNext().isEOF());
+}
 }  // namespace
 }  // namespace mongo
@@ -89,7 +89,7 @@ DocumentSource::GetNextResult DocumentSourceSort::doGetNext() {
         return GetNextResult::makeEOF();
     }
 
-    return GetNextResult{_sortExecutor->getNext().second};
+    return GetNextResult{_sortExecutor->getNextWithoutSortKey()};
 }
 
 void DocumentSourceSort::serializeToArray(
@@ -124,6 +124,8 @@ void DocumentSourceSort::serializeToArray(
             Value(static_cast<long long>(stats.totalDataSizeBytes));
         mutDoc["usedDisk"] = Value(stats.spills > 0);
         mutDoc["spills"] = Value(static_cast<long long>(stats.spills));
+        mutDoc["spilledDataStorageSize"] =
+            Value(static_cast<long long>(stats.spilledDataStorageSize));
     }
 
     array.push_back(Value(mutDoc.freeze()));
@@ -37,6 +37,8 @@
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/server_options.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
 
@@ -172,6 +174,10 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kIteratingSource) {
+        if (!_subPipelineAttached && shouldPrefetchSubPipeline()) {
+            attachCursorSourceToSubPipeline();
+        }
+
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
             return nextInput;
@@ -182,6 +188,25 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kStartingSubPipeline) {
+        if (!_subPipelineAttached) {
+            attachCursorSourceToSubPipeline();
+        }
+        _executionState = ExecutionProgress::kIteratingSubPipeline;
+    }
+
+    auto res = _pipeline->getNext();
+    if (res)
+        return std::move(*res);
+
+    // Record the plan summary stats after $unionWith operation is done.
+    recordPlanSummaryStats(*_pipeline);
+
+    _executionState = ExecutionProgress::kFinished;
+    return GetNextResult::makeEOF();
+}
+
+void DocumentSourceUnionWith::attachCursorSourceToSubPipeline() {
+    while (true) {
         auto serializedPipe = _pipeline->serializeToBson();
         LOGV2_DEBUG(23869,
                     1,
@@ -190,7 +215,8 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
         try {
             _pipeline =
                 pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
-            _executionState = ExecutionProgress::kIteratingSubPipeline;
+            _subPipelineAttached = true;
+            return;
         } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
             _pipeline = buildPipelineFromViewDefinition(
                 pExpCtx,
@@ -203,19 +229,14 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
                         "ns"_attr = e->getNamespace(),
                         "pipeline"_attr = Value(e->getPipeline()),
                         "new_pipe"_attr = _pipeline->serializeToBson());
-            return doGetNext();
         }
     }
+}
 
-    auto res = _pipeline->getNext();
-    if (res)
-        return std::move(*res);
-
-    // Record the plan summary stats after $unionWith operation is done.
-    recordPlanSummaryStats(*_pipeline);
-
-    _executionState = ExecutionProgress::kFinished;
-    return GetNextResult::makeEOF();
+bool DocumentSourceUnionWith::shouldPrefetchSubPipeline() const {
+    // Explain inspects the sub-pipeline based on whether it has been started, so leave it alone.
+    return (pExpCtx->inMongos || serverGlobalParams.clusterRole == ClusterRole::ShardServer) &&
+        !pExpCtx->explain && internalQueryUnionWithPrefetchSubPipeline.load();
 }
 
 Pipeline::SourceContainer::iterator DocumentSourceUnionWith::doOptimizeAt(
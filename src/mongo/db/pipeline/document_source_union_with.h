@@ -166,9 +166,25 @@ private:
 
     void recordPlanSummaryStats(const Pipeline& pipeline);
 
+    /**
+     * Attaches a cursor source to '_pipeline', resolving the sub-pipeline against a view definition
+     * if the foreign namespace turns out to be a view.
+     */
+    void attachCursorSourceToSubPipeline();
+
+    /**
+     * Returns true if the sub-pipeline cursors should be established before 'pSource' has been
+     * exhausted. This is only done in a sharded cluster, where attaching the cursor source
+     * dispatches the sub-pipeline to the shards, which then run it while this stage is returning
+     * its input.
+     */
+    bool shouldPrefetchSubPipeline() const;
+
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     Pipeline::SourceContainer _cachedPipeline;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
+    // Whether a cursor source has already been attached to '_pipeline'.
+    bool _subPipelineAttached = false;
     UnionWithStats _stats;
 };
 
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_writer.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_time_tracker.h"
+#include "mongo/db/repl/repl_client_info.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+Counter64 writerPoolBatches;
+Counter64 writerPoolBatchMicros;
+Counter64 writerPoolBackpressureMicros;
+
+ServerStatusMetricField<Counter64> displayWriterPoolBatches("query.writerPool.batches",
+                                                            &writerPoolBatches);
+ServerStatusMetricField<Counter64> displayWriterPoolBatchMicros("query.writerPool.batchMicros",
+                                                                &writerPoolBatchMicros);
+ServerStatusMetricField<Counter64> displayWriterPoolBackpressureMicros(
+    "query.writerPool.backpressureMicros", &writerPoolBackpressureMicros);
+
+}  // namespace
+
+DocumentSourceWriterPool::DocumentSourceWriterPool(ServiceContext* service, size_t numLanes)
+    : _service(service),
+      _pool([&] {
+          ThreadPool::Options options;
+          options.poolName = "DocumentSourceWriter";
+          options.minThreads = 0;
+          options.maxThreads = numLanes;
+          return options;
+      }()),
+      _lanes(numLanes) {
+    invariant(numLanes > 0);
+    _pool.startup();
+}
+
+void DocumentSourceWriterPool::schedule(OperationContext* opCtx, size_t lane, WriteFn writeFn) {
+    auto& inFlight = _lanes[lane];
+    if (inFlight) {
+        // Only one batch per lane is written at a time, which keeps the batches of a lane in order
+        // and bounds the amount of buffered data.
+        Timer timer;
+        ON_BLOCK_EXIT([&] { writerPoolBackpressureMicros.increment(timer.micros()); });
+        auto future = std::move(*inFlight);
+        inFlight.reset();
+        future.get(opCtx);
+    }
+
+    auto [promise, future] = makePromiseFuture<void>();
+    _pool.schedule([this, writeFn = std::move(writeFn), promise = std::move(promise)](
+                       Status status) mutable {
+        promise.setWith([&] {
+            uassertStatusOK(status);
+
+            ThreadClient tc("DocumentSourceWriter", _service);
+            AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+            auto workerOpCtx = cc().makeOperationContext();
+
+            Timer timer;
+            writeFn(workerOpCtx.get());
+            writerPoolBatches.increment();
+            writerPoolBatchMicros.increment(timer.micros());
+
+            stdx::lock_guard lk(_mutex);
+            _maxLastOp = std::max(_maxLastOp, repl::ReplClientInfo::forClient(cc()).getLastOp());
+            _maxOperationTime =
+                std::max(_maxOperationTime,
+                         OperationTimeTracker::get(workerOpCtx.get())->getMaxOperationTime());
+        });
+    });
+    inFlight.emplace(std::move(future).semi());
+}
+
+void DocumentSourceWriterPool::waitForAll(OperationContext* opCtx) {
+    for (auto& inFlight : _lanes) {
+        if (inFlight) {
+            auto future = std::move(*inFlight);
+            inFlight.reset();
+            future.get(opCtx);
+        }
+    }
+
+    // The writes were performed by the clients of the worker threads, so make the client of
+    // 'opCtx' wait for write concern and report an operationTime which covers them.
+    stdx::lock_guard lk(_mutex);
+    auto& replClientInfo = repl::ReplClientInfo::forClient(opCtx->getClient());
+    if (_maxLastOp > replClientInfo.getLastOp())
+        replClientInfo.setLastOp(opCtx, _maxLastOp);
+    OperationTimeTracker::get(opCtx)->updateOperationTime(_maxOperationTime);
+}
+
+void DocumentSourceWriterPool::shutdownAndJoin() {
+    if (_joined)
+        return;
+    _pool.shutdown();
+    _pool.join();
+    _joined = true;
+}
+
+}  // namespace mongo
@@ -36,8 +36,14 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/read_concern.h"
+#include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/recovery_unit.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/functional.h"
+#include "mongo/util/future.h"
 
 namespace mongo {
 using namespace fmt::literals;
@@ -80,6 +86,61 @@ public:
     }
 };
 
+/**
+ * Writes the batches of a DocumentSourceWriter on a bounded pool of worker threads, each with its
+ * own Client and OperationContext, so that the writer can keep pulling from its source while
+ * earlier batches are being written.
+ *
+ * Batches are scheduled on one of 'numLanes' lanes. Each lane has at most one batch in flight and
+ * scheduling on a busy lane waits for the previous batch to complete, so the batches of a lane are
+ * written in the order in which they were scheduled and at most 'numLanes' batches are in flight.
+ *
+ * The methods of this class must only be called from the thread running the writer stage.
+ */
+class DocumentSourceWriterPool {
+public:
+    using WriteFn = unique_function<void(OperationContext*)>;
+
+    DocumentSourceWriterPool(ServiceContext* service, size_t numLanes);
+
+    size_t numLanes() const {
+        return _lanes.size();
+    }
+
+    /**
+     * Waits for the batch in flight on 'lane', if any, and schedules 'writeFn' to be run on a
+     * worker with an operation context of its own. Throws the error of the previous batch if it
+     * failed.
+     */
+    void schedule(OperationContext* opCtx, size_t lane, WriteFn writeFn);
+
+    /**
+     * Waits for all the batches in flight and throws the first error among them. Afterwards the
+     * client of 'opCtx' has a last optime and operation time at least as recent as those of all
+     * the batches written so far.
+     */
+    void waitForAll(OperationContext* opCtx);
+
+    /**
+     * Lets the batches in flight complete and joins the workers. No batch can be scheduled
+     * afterwards.
+     */
+    void shutdownAndJoin();
+
+private:
+    ServiceContext* const _service;
+
+    // Protects the optimes reported by the workers below
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentSourceWriterPool::_mutex");
+    repl::OpTime _maxLastOp;
+    LogicalTime _maxOperationTime;
+
+    ThreadPool _pool;
+    bool _joined{false};
+
+    std::vector<boost::optional<SemiFuture<void>>> _lanes;
+};
+
 /**
  * This is a base abstract class for all stages performing a write operation into an output
  * collection. The writes are organized in batches in which elements are objects of the templated
@@ -92,6 +153,12 @@ public:
  * Two other virtual methods exist which a subclass may override: 'initialize()' and 'finalize()',
  * which are called before the first element is read from the input source, and after the last one
  * has been read, respectively.
+ *
+ * When 'internalQueryMaxInFlightWriterBatches' is greater than one, full batches are handed to a
+ * DocumentSourceWriterPool instead of being spilled inline, so 'spill()' may run concurrently on
+ * several threads and must only read the state of the stage. Objects for which
+ * 'getOrderingKeyHash()' returns a hash are batched by it, so that objects with equal keys are
+ * written in input order.
  */
 template <typename B>
 class DocumentSourceWriter : public DocumentSource {
@@ -142,10 +209,26 @@ protected:
      */
     virtual void finalize() {}
 
+    void doDispose() override {
+        if (_writerPool)
+            _writerPool->shutdownAndJoin();
+    }
+
     /**
-     * Writes the documents in 'batch' to the output namespace.
+     * Writes the documents in 'batch' to the output namespace, using the operation context of
+     * 'expCtx'.
      */
-    virtual void spill(BatchedObjects&& batch) = 0;
+    virtual void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                       BatchedObjects&& batch) = 0;
+
+    /**
+     * A subclass whose writes must be applied in order for objects with the same key, returns a
+     * hash of that key. The default, boost::none, means the object may be written in any order
+     * relative to all other objects.
+     */
+    virtual boost::optional<size_t> getOrderingKeyHash(const B& obj) const {
+        return boost::none;
+    }
 
     /**
      * Creates a batch object from the given document and returns it to the caller along with the
@@ -170,10 +253,32 @@ protected:
     WriteConcernOptions _writeConcern;
 
 private:
+    void _spill(size_t lane, BatchedObjects&& batch);
+
     bool _initialized{false};
     bool _done{false};
+
+    // Only set when batches are written concurrently
+    std::unique_ptr<DocumentSourceWriterPool> _writerPool;
 };
 
+template <typename B>
+void DocumentSourceWriter<B>::_spill(size_t lane, BatchedObjects&& batch) {
+    if (!_writerPool) {
+        spill(pExpCtx, std::move(batch));
+        return;
+    }
+
+    _writerPool->schedule(
+        pExpCtx->opCtx,
+        lane,
+        [this, expCtx = pExpCtx->copyWith(pExpCtx->ns), batch = std::move(batch)](
+            OperationContext* opCtx) mutable {
+            expCtx->opCtx = opCtx;
+            spill(expCtx, std::move(batch));
+        });
+}
+
 template <typename B>
 DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
     if (_done) {
@@ -196,10 +301,23 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
         if (!_initialized) {
             initialize();
             _initialized = true;
+
+            const auto maxInFlightBatches = internalQueryMaxInFlightWriterBatches.load();
+            if (maxInFlightBatches > 1) {
+                _writerPool = std::make_unique<DocumentSourceWriterPool>(
+                    pExpCtx->opCtx->getServiceContext(), maxInFlightBatches);
+            }
         }
 
-        BatchedObjects batch;
-        int bufferedBytes = 0;
+        // Without a writer pool everything goes into a single batch, which is spilled inline.
+        // Otherwise the objects with an ordering key are batched per lane, so that equal keys are
+        // always written by the same lane, and the last batch collects the unordered objects and
+        // is spilled onto the lanes in turn.
+        const size_t numLanes = _writerPool ? _writerPool->numLanes() : 1;
+        const size_t unorderedBatch = _writerPool ? numLanes : 0;
+        std::vector<BatchedObjects> batches(unorderedBatch + 1);
+        std::vector<int> bufferedBytes(batches.size(), 0);
+        size_t nextUnorderedLane = 0;
 
         auto nextInput = pSource->getNext();
         for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
@@ -208,19 +326,34 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
             auto doc = nextInput.releaseDocument();
             auto [obj, objSize] = makeBatchObject(std::move(doc));
 
-            bufferedBytes += objSize;
+            const auto orderingKeyHash = _writerPool ? getOrderingKeyHash(obj) : boost::none;
+            const size_t index = orderingKeyHash ? *orderingKeyHash % numLanes : unorderedBatch;
+            auto& batch = batches[index];
+
+            bufferedBytes[index] += objSize;
             if (!batch.empty() &&
-                (bufferedBytes > BSONObjMaxUserSize ||
+                (bufferedBytes[index] > BSONObjMaxUserSize ||
                  batch.size() >= write_ops::kMaxWriteBatchSize)) {
-                spill(std::move(batch));
+                if (orderingKeyHash) {
+                    _spill(index, std::move(batch));
+                } else {
+                    _spill(nextUnorderedLane, std::move(batch));
+                    nextUnorderedLane = (nextUnorderedLane + 1) % numLanes;
+                }
                 batch.clear();
-                bufferedBytes = objSize;
+                bufferedBytes[index] = objSize;
             }
             batch.push_back(obj);
         }
-        if (!batch.empty()) {
-            spill(std::move(batch));
-            batch.clear();
+        for (size_t index = 0; index < batches.size(); ++index) {
+            if (!batches[index].empty()) {
+                _spill(index == unorderedBatch ? nextUnorderedLane : index,
+                       std::move(batches[index]));
+                batches[index].clear();
+            }
+        }
+        if (_writerPool) {
+            _writerPool->waitForAll(pExpCtx->opCtx);
         }
 
         switch (nextInput.getStatus()) {
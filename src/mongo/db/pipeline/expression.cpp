@@ -45,6 +45,8 @@
 #include "mongo/db/hasher.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/expression_function.h"
+#include "mongo/db/pipeline/expression_js_emit.h"
 #include "mongo/db/pipeline/variable_validation.h"
 #include "mongo/db/query/datetime/date_time_support.h"
 #include "mongo/db/query/sort_pattern.h"
@@ -7612,6 +7614,114 @@ REGISTER_EXPRESSION_WITH_MIN_VERSION(tsIncrement,
                                      AllowedWithClientType::kAny,
                                      ServerGlobalParams::FeatureCompatibility::Version::kVersion50);
 
+/* ------------------------- ExpressionCommonSubexpression ----------------------------- */
+
+Value ExpressionCommonSubexpression::evaluate(const Document& root, Variables* variables) const {
+    // The subexpression reads nothing but 'root', so its value is the same for as long as 'root'
+    // is the same document.
+    if (!_lastRoot || _lastRoot->getPtr() != root.getPtr()) {
+        _lastValue = _children[0]->evaluate(root, variables);
+        _lastRoot = root;
+    }
+    return _lastValue;
+}
+
+namespace {
+/**
+ * Finds the subexpressions of a set of expressions which occur more than once and may be shared.
+ */
+class CommonSubexpressionFinder {
+public:
+    void countOccurrences(const boost::intrusive_ptr<Expression>& expr) {
+        if (!expr || dynamic_cast<ExpressionCommonSubexpression*>(expr.get())) {
+            return;
+        }
+        for (auto&& child : expr->getChildren()) {
+            countOccurrences(child);
+        }
+        if (auto key = _makeKeyIfShareable(*expr)) {
+            ++_occurrences[*key];
+            _keys.emplace(expr.get(), std::move(*key));
+        }
+    }
+
+    void share(boost::intrusive_ptr<Expression>* expr) {
+        if (!*expr || dynamic_cast<ExpressionCommonSubexpression*>(expr->get())) {
+            return;
+        }
+        if (auto keyIt = _keys.find(expr->get());
+            keyIt != _keys.end() && _occurrences[keyIt->second] > 1) {
+            auto [sharedIt, inserted] = _shared.try_emplace(keyIt->second);
+            if (inserted) {
+                // The first occurrence becomes the shared subexpression. Its own repeated
+                // subexpressions may occur elsewhere too.
+                for (auto&& child : (*expr)->getChildren()) {
+                    share(&child);
+                }
+                sharedIt->second = make_intrusive<ExpressionCommonSubexpression>(
+                    (*expr)->getExpressionContext(), *expr);
+            }
+            *expr = sharedIt->second;
+            return;
+        }
+        for (auto&& child : (*expr)->getChildren()) {
+            share(&child);
+        }
+    }
+
+private:
+    // Returns the serialized form of 'expr' if all of its occurrences may share one value per
+    // document. The children of 'expr' must have been visited first.
+    boost::optional<std::string> _makeKeyIfShareable(const Expression& expr) {
+        // Constants and field paths are cheaper to evaluate than to share.
+        if (dynamic_cast<const ExpressionConstant*>(&expr) ||
+            dynamic_cast<const ExpressionFieldPath*>(&expr)) {
+            return boost::none;
+        }
+        const auto isNondeterministic = [&](auto&& child) {
+            return child && _nondeterministic.count(child.get());
+        };
+        if (dynamic_cast<const ExpressionRandom*>(&expr) ||
+            dynamic_cast<const ExpressionFunction*>(&expr) ||
+            dynamic_cast<const ExpressionInternalJsEmit*>(&expr) ||
+            std::any_of(
+                expr.getChildren().begin(), expr.getChildren().end(), isNondeterministic)) {
+            _nondeterministic.insert(&expr);
+            return boost::none;
+        }
+
+        // A subexpression which reads a variable, including a rebound $$CURRENT, may evaluate
+        // differently at each of its occurrences.
+        DepsTracker deps;
+        expr.addDependencies(&deps);
+        if (!deps.vars.empty()) {
+            return boost::none;
+        }
+
+        BSONObjBuilder bob;
+        expr.serialize(false).addToBsonObj(&bob, "");
+        auto key = bob.done();
+        return std::string(key.objdata(), key.objsize());
+    }
+
+    stdx::unordered_map<const Expression*, std::string> _keys;
+    stdx::unordered_map<std::string, int> _occurrences;
+    stdx::unordered_set<const Expression*> _nondeterministic;
+    stdx::unordered_map<std::string, boost::intrusive_ptr<Expression>> _shared;
+};
+}  // namespace
+
+void ExpressionCommonSubexpression::shareAcross(
+    const std::vector<boost::intrusive_ptr<Expression>*>& expressions) {
+    CommonSubexpressionFinder finder;
+    for (auto&& expr : expressions) {
+        finder.countOccurrences(*expr);
+    }
+    for (auto&& expr : expressions) {
+        finder.share(expr);
+    }
+}
+
 MONGO_INITIALIZER_GROUP(BeginExpressionRegistration, ("default"), ("EndExpressionRegistration"))
 MONGO_INITIALIZER_GROUP(EndExpressionRegistration, ("BeginExpressionRegistration"), ())
 }  // namespace mongo
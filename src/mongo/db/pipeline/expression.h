@@ -4073,4 +4073,60 @@ public:
     }
 };
 
+/**
+ * Stands for a subexpression which occurs more than once among a set of expressions evaluated
+ * against the same document, such as the computed fields of one projection. Every occurrence is
+ * replaced by the same ExpressionCommonSubexpression, which evaluates the subexpression the first
+ * time it is reached for a document and returns the remembered value for every later occurrence.
+ * Since the value is only computed when it is first needed, a subexpression which is reached only
+ * through a $cond branch or similar is still only evaluated when that branch is taken.
+ *
+ * Only subexpressions which read nothing but the root document are shared, so the value does not
+ * depend on where the subexpression occurs. The node serializes as the subexpression itself.
+ */
+class ExpressionCommonSubexpression final : public Expression {
+public:
+    ExpressionCommonSubexpression(ExpressionContext* const expCtx,
+                                  boost::intrusive_ptr<Expression> subexpression)
+        : Expression(expCtx, {std::move(subexpression)}) {}
+
+    /**
+     * Replaces every subexpression which occurs at least twice across 'expressions' by a shared
+     * ExpressionCommonSubexpression. Subexpressions are compared by their serialized form.
+     * Constants, field paths and subexpressions which depend on variables or are nondeterministic
+     * are never shared. The expressions should already have been optimized.
+     */
+    static void shareAcross(const std::vector<boost::intrusive_ptr<Expression>*>& expressions);
+
+    Value evaluate(const Document& root, Variables* variables) const final;
+
+    boost::intrusive_ptr<Expression> optimize() final {
+        // The subexpression was optimized before it was shared.
+        return this;
+    }
+
+    Value serialize(bool explain) const final {
+        return _children[0]->serialize(explain);
+    }
+
+    void acceptVisitor(ExpressionMutableVisitor* visitor) final {
+        return visitor->visit(this);
+    }
+
+    void acceptVisitor(ExpressionConstVisitor* visitor) const final {
+        return visitor->visit(this);
+    }
+
+protected:
+    void _doAddDependencies(DepsTracker* deps) const final {
+        _children[0]->addDependencies(deps);
+    }
+
+private:
+    // The document the subexpression was last evaluated against, and the value it produced. Holding
+    // on to the document keeps its storage from being reused for a different one.
+    mutable boost::optional<Document> _lastRoot;
+    mutable Value _lastValue;
+};
+
 }  // namespace mongo
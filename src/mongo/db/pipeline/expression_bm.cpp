@@ -31,6 +31,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include "mongo/bson/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
@@ -329,5 +330,65 @@ BENCHMARK(BM_DateTruncEvaluateMonth6UTCValue2030);
 BENCHMARK(BM_DateTruncEvaluateYear1NewYorkValue2020);
 BENCHMARK(BM_DateTruncEvaluateYear1UTCValue2020);
 BENCHMARK(BM_DateTruncEvaluateYear1NewYorkValue2100);
+
+/**
+ * Tests performance of evaluating a set of expressions which have a subexpression in common, as
+ * the computed fields of a projection do.
+ *
+ * share - whether to evaluate the common subexpression once per document.
+ * state - benchmarking state.
+ */
+void testCommonSubexpressions(bool share, benchmark::State& state) {
+    QueryTestServiceContext testServiceContext;
+    auto opContext = testServiceContext.makeOperationContext();
+    NamespaceString nss("test.bm");
+    boost::intrusive_ptr<ExpressionContextForTest> exprContext =
+        new ExpressionContextForTest(opContext.get(), nss);
+
+    // Build the expressions, each of which computes the product of 'price' and 'qty'.
+    const auto spec = fromjson(
+        "{total: {$multiply: ['$price', '$qty']}, tax: {$multiply: [{$multiply: ['$price', "
+        "'$qty']}, 0.2]}, net: {$subtract: [{$multiply: ['$price', '$qty']}, 1]}}");
+    std::vector<boost::intrusive_ptr<Expression>> expressions;
+    std::vector<boost::intrusive_ptr<Expression>*> expressionPtrs;
+    for (auto&& elem : spec) {
+        expressions.push_back(
+            Expression::parseOperand(exprContext.get(), elem, exprContext->variablesParseState)
+                ->optimize());
+    }
+    for (auto&& expression : expressions) {
+        expressionPtrs.push_back(&expression);
+    }
+    if (share) {
+        ExpressionCommonSubexpression::shareAcross(expressionPtrs);
+    }
+
+    // Alternate between two documents, so that each one is evaluated against a different document
+    // than the one before it.
+    auto variables = &(exprContext->variables);
+    const std::vector<Document> documents{Document{{"price", 2.5}, {"qty", 3}},
+                                          Document{{"price", 4.5}, {"qty", 7}}};
+
+    // Run the test.
+    size_t i = 0;
+    for (auto keepRunning : state) {
+        const auto& document = documents[i++ % documents.size()];
+        for (auto&& expression : expressions) {
+            benchmark::DoNotOptimize(expression->evaluate(document, variables));
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_CommonSubexpressionsEvaluatedSeparately(benchmark::State& state) {
+    testCommonSubexpressions(false /* share */, state);
+}
+
+void BM_CommonSubexpressionsShared(benchmark::State& state) {
+    testCommonSubexpressions(true /* share */, state);
+}
+
+BENCHMARK(BM_CommonSubexpressionsEvaluatedSeparately);
+BENCHMARK(BM_CommonSubexpressionsShared);
 }  // namespace
 }  // namespace mongo
@@ -33,9 +33,11 @@
 
 #include "mongo/db/pipeline/aggregate_command_gen.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
 #include "mongo/db/query/collation/collation_spec.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/intrusive_counter.h"
 
 namespace mongo {
@@ -180,6 +182,17 @@ std::unique_ptr<ExpressionContext::CollatorStash> ExpressionContext::temporarily
     return std::unique_ptr<CollatorStash>(new CollatorStash(this, std::move(newCollator)));
 }
 
+MemoryUsageTracker* ExpressionContext::getOperationMemoryTracker() const {
+    if (!_operationMemoryTracker) {
+        const auto maxMemoryUsageBytes = internalQueryMaxMemoryUsageBytesPerOperation.load();
+        _operationMemoryTracker = std::make_shared<MemoryUsageTracker>(
+            allowDiskUse,
+            maxMemoryUsageBytes > 0 ? static_cast<size_t>(maxMemoryUsageBytes)
+                                    : std::numeric_limits<long long>::max());
+    }
+    return _operationMemoryTracker.get();
+}
+
 intrusive_ptr<ExpressionContext> ExpressionContext::copyWith(
     NamespaceString ns,
     boost::optional<UUID> uuid,
@@ -217,6 +230,9 @@ intrusive_ptr<ExpressionContext> ExpressionContext::copyWith(
     expCtx->initialPostBatchResumeToken = initialPostBatchResumeToken.getOwned();
     expCtx->originalAggregateCommand = originalAggregateCommand.getOwned();
 
+    getOperationMemoryTracker();
+    expCtx->_operationMemoryTracker = _operationMemoryTracker;
+
     // Note that we intentionally skip copying the value of '_interruptCounter' because 'expCtx' is
     // intended to be used for executing a separate aggregation pipeline.
 
@@ -57,6 +57,7 @@
 namespace mongo {
 
 class AggregateCommandRequest;
+class MemoryUsageTracker;
 
 class ExpressionContext : public RefCountable {
 public:
@@ -271,6 +272,13 @@ public:
         _resolvedNamespaces = std::move(resolvedNamespaces);
     }
 
+    /**
+     * Returns the tracker of the memory held by all of the stages of this operation, including
+     * those of its sub-pipelines, which is the parent of the memory trackers of the stages. Its
+     * limit is 'internalQueryMaxMemoryUsageBytesPerOperation' as of the first call.
+     */
+    MemoryUsageTracker* getOperationMemoryTracker() const;
+
     /**
      * Retrieves the Javascript Scope for the current thread or creates a new one if it has not been
      * created yet. Initializes the Scope with the 'jsScope' variables from the runtimeConstants.
@@ -407,6 +415,10 @@ protected:
     StringMap<ResolvedNamespace> _resolvedNamespaces;
 
     int _interruptCounter = kInterruptCheckPeriod;
+
+    // Created on first use, and shared with the ExpressionContexts copied from this one for the
+    // sub-pipelines of the operation.
+    mutable std::shared_ptr<MemoryUsageTracker> _operationMemoryTracker;
 };
 
 }  // namespace mongo
@@ -3267,6 +3267,39 @@ TEST(ExpressionToHashedIndexKeyTest, DoesAddInputDependencies) {
 }
 }  // namespace ExpressionToHashedIndexKeyTest
 
+TEST(ExpressionCommonSubexpressionTest, SharesOnlySubexpressionsWhichReadTheRootDocument) {
+    auto expCtx = ExpressionContextForTest{};
+    auto parse = [&](const char* json) {
+        return Expression::parseExpression(&expCtx, fromjson(json), expCtx.variablesParseState);
+    };
+    auto product = parse("{$multiply: ['$a', '$b']}");
+    auto randomSum = parse("{$add: [{$multiply: ['$a', '$b']}, {$rand: {}}]}");
+    auto otherRandomSum = parse("{$add: [{$multiply: ['$a', '$b']}, {$rand: {}}]}");
+    auto letA = parse("{$let: {vars: {x: '$a'}, in: {$add: ['$$x', 1]}}}");
+    auto letB = parse("{$let: {vars: {x: '$b'}, in: {$add: ['$$x', 1]}}}");
+    ExpressionCommonSubexpression::shareAcross(
+        {&product, &randomSum, &otherRandomSum, &letA, &letB});
+
+    // Every occurrence of the product is the same node.
+    ASSERT(dynamic_cast<ExpressionCommonSubexpression*>(product.get()));
+    ASSERT_EQ(product.get(), randomSum->getChildren()[0].get());
+    ASSERT_EQ(product.get(), otherRandomSum->getChildren()[0].get());
+
+    // Subexpressions with $rand or variables are evaluated at each of their occurrences.
+    ASSERT_NE(randomSum.get(), otherRandomSum.get());
+    ASSERT_FALSE(dynamic_cast<ExpressionCommonSubexpression*>(randomSum.get()));
+    ASSERT_FALSE(dynamic_cast<ExpressionCommonSubexpression*>(letA->getChildren().back().get()));
+
+    auto doc = Document{{"a", 2}, {"b", 5}};
+    ASSERT_VALUE_EQ(product->evaluate(doc, &expCtx.variables), Value(10));
+    ASSERT_VALUE_EQ(letA->evaluate(doc, &expCtx.variables), Value(3));
+    ASSERT_VALUE_EQ(letB->evaluate(doc, &expCtx.variables), Value(6));
+    ASSERT_VALUE_EQ(product->evaluate(Document{{"a", 3}, {"b", 5}}, &expCtx.variables),
+                    Value(15));
+    ASSERT_VALUE_EQ(product->serialize(false),
+                    parse("{$multiply: ['$a', '$b']}")->serialize(false));
+}
+
 TEST(ExpressionSubtractTest, OverflowLong) {
     const auto maxLong = std::numeric_limits<long long int>::max();
     const auto minLong = std::numeric_limits<long long int>::min();
@@ -71,6 +71,7 @@ class ExpressionFieldPath;
 class ExpressionFilter;
 class ExpressionFloor;
 class ExpressionToHashedIndexKey;
+class ExpressionCommonSubexpression;
 class ExpressionHour;
 class ExpressionIfNull;
 class ExpressionIn;
@@ -336,6 +337,8 @@ public:
     virtual void visit(
         expression_walker::MaybeConstPtr<IsConst, ExpressionInternalFindElemMatch>) = 0;
     virtual void visit(expression_walker::MaybeConstPtr<IsConst, ExpressionToHashedIndexKey>) = 0;
+    virtual void visit(
+        expression_walker::MaybeConstPtr<IsConst, ExpressionCommonSubexpression>) = 0;
     virtual void visit(expression_walker::MaybeConstPtr<IsConst, ExpressionDateAdd>) = 0;
     virtual void visit(expression_walker::MaybeConstPtr<IsConst, ExpressionDateSubtract>) = 0;
     virtual void visit(expression_walker::MaybeConstPtr<IsConst, ExpressionGetField>) = 0;
@@ -63,6 +63,16 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
     return exec.get();
 }
 
+const std::string& JsExecution::getGlobalFunction(const std::string& funcCode) {
+    if (auto it = _globalFunctions.find(funcCode); it != _globalFunctions.end()) {
+        return it->second;
+    }
+
+    std::string name = str::stream() << "__globalFunction" << _globalFunctions.size();
+    _scope->setFunction(name.c_str(), funcCode.c_str());
+    return _globalFunctions.emplace(funcCode, std::move(name)).first->second;
+}
+
 Value JsExecution::callFunction(ScriptingFunction func,
                                 const BSONObj& params,
                                 const BSONObj& thisObj) {
@@ -35,6 +35,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -100,6 +101,13 @@ public:
         return _scope->createFunction(funcCode.c_str());
     };
 
+    /**
+     * Defines the function given by 'funcCode' as a global in the owned Scope and returns the
+     * global's name. The function is compiled only the first time its source is seen; later calls
+     * with the same source return the same name.
+     */
+    const std::string& getGlobalFunction(const std::string& funcCode);
+
     /**
      * Injects the given function 'emitFn' as a native JS function named 'emit', callable from
      * user-defined functions.
@@ -122,6 +130,9 @@ private:
     bool _storedProceduresLoaded = false;
     int _fnCallTimeoutMillis;
 
+    // Maps the source of each function defined by getGlobalFunction() to its global name.
+    stdx::unordered_map<std::string, std::string> _globalFunctions;
+
     Value doCallFunction(ScriptingFunction func,
                          const BSONObj& params,
                          const BSONObj& thisObj,
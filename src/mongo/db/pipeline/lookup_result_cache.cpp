@@ -0,0 +1,206 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/lookup_result_cache.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getLookupResultCache = ServiceContext::declareDecoration<LookupResultCache>();
+
+Counter64 lookupResultCacheHits;
+Counter64 lookupResultCacheMisses;
+
+ServerStatusMetricField<Counter64> displayLookupResultCacheHits(
+    "query.lookup.resultCache.hits", &lookupResultCacheHits);
+ServerStatusMetricField<Counter64> displayLookupResultCacheMisses(
+    "query.lookup.resultCache.misses", &lookupResultCacheMisses);
+
+}  // namespace
+
+LookupResultCache& LookupResultCache::get(ServiceContext* serviceContext) {
+    return getLookupResultCache(serviceContext);
+}
+
+std::string LookupResultCache::makeKey(const NamespaceString& nss,
+                                       const BSONObj& query,
+                                       const BSONObj& collation) {
+    BSONObjBuilder bob;
+    bob.append("ns", nss.ns());
+    bob.append("query", query);
+    bob.append("collation", collation);
+    auto obj = bob.done();
+    return std::string(obj.objdata(), obj.objsize());
+}
+
+bool LookupResultCache::canUseForOperation(OperationContext* opCtx) {
+    if (internalLookupStageResultCacheMaxSizeBytes.load() <= 0 ||
+        opCtx->inMultiDocumentTransaction() ||
+        opCtx->recoveryUnit()->getTimestampReadSource() !=
+            RecoveryUnit::ReadSource::kNoTimestamp) {
+        return false;
+    }
+
+    // Only reads of the latest local data may share results with other operations.
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    const auto level = readConcernArgs.getLevel();
+    return (level == repl::ReadConcernLevel::kLocalReadConcern ||
+            level == repl::ReadConcernLevel::kAvailableReadConcern) &&
+        !readConcernArgs.getArgsAfterClusterTime() && !readConcernArgs.getArgsAtClusterTime();
+}
+
+LookupResultCache::Version LookupResultCache::getVersion(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _inUse.store(true);
+    return _versions[nss];
+}
+
+boost::optional<std::vector<BSONObj>> LookupResultCache::find(const NamespaceString& nss,
+                                                               const std::string& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entriesByKey.find(key);
+    if (it == _entriesByKey.end()) {
+        lookupResultCacheMisses.increment();
+        return boost::none;
+    }
+
+    auto entry = it->second;
+    auto version = _versions.find(nss);
+    if (version == _versions.end() || version->second != entry->version) {
+        // The namespace has been written to since this entry was populated.
+        _erase(lk, entry);
+        lookupResultCacheMisses.increment();
+        return boost::none;
+    }
+
+    _entries.splice(_entries.begin(), _entries, entry);
+    lookupResultCacheHits.increment();
+    return entry->docs;
+}
+
+void LookupResultCache::insert(const NamespaceString& nss,
+                               const std::string& key,
+                               Version version,
+                               std::vector<BSONObj> docs,
+                               size_t maxSizeBytes) {
+    size_t sizeBytes = key.size();
+    for (auto&& doc : docs) {
+        sizeBytes += doc.objsize();
+    }
+    if (sizeBytes > maxSizeBytes) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto currentVersion = _versions.find(nss);
+    if (currentVersion == _versions.end() || currentVersion->second != version) {
+        // The results may not reflect a write which has since committed.
+        return;
+    }
+
+    if (auto existing = _entriesByKey.find(key); existing != _entriesByKey.end()) {
+        _erase(lk, existing->second);
+    }
+
+    _entries.push_front(Entry{key, nss, version, std::move(docs), sizeBytes});
+    _entriesByKey.emplace(key, _entries.begin());
+    _sizeBytes += sizeBytes;
+
+    while (_sizeBytes > maxSizeBytes) {
+        _erase(lk, std::prev(_entries.end()));
+    }
+}
+
+void LookupResultCache::invalidate(const NamespaceString& nss) {
+    if (!_inUse.load()) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    // A namespace without a version has never been read through the cache, so there is nothing
+    // to invalidate.
+    if (auto version = _versions.find(nss); version != _versions.end()) {
+        ++version->second;
+    }
+}
+
+void LookupResultCache::invalidateDatabase(StringData dbName) {
+    if (!_inUse.load()) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto&& [nss, version] : _versions) {
+        if (nss.db() == dbName) {
+            ++version;
+        }
+    }
+}
+
+void LookupResultCache::invalidateAll() {
+    if (!_inUse.load()) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto&& [nss, version] : _versions) {
+        ++version;
+    }
+    _entries.clear();
+    _entriesByKey.clear();
+    _sizeBytes = 0;
+}
+
+size_t LookupResultCache::getSizeBytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sizeBytes;
+}
+
+size_t LookupResultCache::getNumEntries() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+void LookupResultCache::_erase(WithLock, EntryList::iterator it) {
+    _sizeBytes -= it->sizeBytes;
+    _entriesByKey.erase(it->key);
+    _entries.erase(it);
+}
+
+}  // namespace mongo
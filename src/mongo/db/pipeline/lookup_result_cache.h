@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * A node-wide least-recently-used cache of the foreign-side results of $lookup stages, shared by
+ * all operations. Entries are keyed by an opaque string which identifies the foreign namespace,
+ * the query which was run against it and the collation, and hold the matching documents as owned
+ * BSON so that they can be handed to several threads at once.
+ *
+ * Invalidation is driven by a version number per foreign namespace. The version is bumped, through
+ * an OpObserver, once any write to the namespace has committed, and an entry is only served while
+ * the version of its namespace is the one which was observed before its results were read.
+ * Callers must therefore read the version with 'getVersion()' before opening the storage snapshot
+ * from which they compute the results that they pass to 'insert()'.
+ *
+ * This class is thread-safe.
+ */
+class LookupResultCache {
+public:
+    using Version = unsigned long long;
+
+    static LookupResultCache& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns the key identifying the results of running 'query' against 'nss' under the
+     * collation described by 'collation'.
+     */
+    static std::string makeKey(const NamespaceString& nss,
+                               const BSONObj& query,
+                               const BSONObj& collation);
+
+    /**
+     * Returns whether node-wide caching of $lookup results is enabled, and the operation is reading
+     * the latest committed data in a way which the cache can serve.
+     */
+    static bool canUseForOperation(OperationContext* opCtx);
+
+    /**
+     * Returns the current version of 'nss'. Results read from a snapshot opened after this call
+     * may be inserted with this version.
+     */
+    Version getVersion(const NamespaceString& nss);
+
+    /**
+     * Returns the documents cached for 'key' if there is an entry which is still valid for 'nss',
+     * and boost::none otherwise. Updates the hit and miss metrics.
+     */
+    boost::optional<std::vector<BSONObj>> find(const NamespaceString& nss, const std::string& key);
+
+    /**
+     * Caches 'docs' for 'key', unless 'nss' has been written to since 'version' was obtained or the
+     * entry alone would exceed 'maxSizeBytes'. Evicts the least recently used entries until the
+     * cache is no larger than 'maxSizeBytes'.
+     */
+    void insert(const NamespaceString& nss,
+                const std::string& key,
+                Version version,
+                std::vector<BSONObj> docs,
+                size_t maxSizeBytes);
+
+    /**
+     * Invalidates all entries for 'nss', or for every collection in 'dbName', or every entry.
+     * Entries which are invalidated are released lazily, when they are next looked up or evicted.
+     */
+    void invalidate(const NamespaceString& nss);
+    void invalidateDatabase(StringData dbName);
+    void invalidateAll();
+
+    size_t getSizeBytes() const;
+    size_t getNumEntries() const;
+
+private:
+    struct Entry {
+        std::string key;
+        NamespaceString nss;
+        Version version;
+        std::vector<BSONObj> docs;
+        size_t sizeBytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    void _erase(WithLock, EntryList::iterator it);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("LookupResultCache::_mutex");
+
+    // Most recently used entries are at the front.
+    EntryList _entries;
+    stdx::unordered_map<std::string, EntryList::iterator> _entriesByKey;
+    size_t _sizeBytes = 0;
+
+    // Namespaces are added when their version is first requested and are never removed, so that a
+    // version can never go backwards while a reader is holding on to it.
+    stdx::unordered_map<NamespaceString, Version> _versions;
+
+    // Set once any version has been requested. Until then writes do not need to take '_mutex'.
+    AtomicWord<bool> _inUse{false};
+};
+
+}  // namespace mongo
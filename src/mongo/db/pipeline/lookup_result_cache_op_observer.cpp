@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/lookup_result_cache_op_observer.h"
+
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/lookup_result_cache.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Bumps the version of 'nss' in the LookupResultCache once the write which is in progress on
+ * 'opCtx' has committed, so that no reader can cache results which predate the write under the new
+ * version.
+ */
+void invalidateOnCommit(OperationContext* opCtx, const NamespaceString& nss) {
+    auto& cache = LookupResultCache::get(opCtx->getServiceContext());
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        cache.invalidate(nss);
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [&cache, nss](boost::optional<Timestamp>) { cache.invalidate(nss); });
+}
+
+}  // namespace
+
+void LookupResultCacheOpObserver::onInserts(OperationContext* opCtx,
+                                            const NamespaceString& nss,
+                                            OptionalCollectionUUID uuid,
+                                            std::vector<InsertStatement>::const_iterator first,
+                                            std::vector<InsertStatement>::const_iterator last,
+                                            bool fromMigrate) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void LookupResultCacheOpObserver::onUpdate(OperationContext* opCtx,
+                                           const OplogUpdateEntryArgs& args) {
+    invalidateOnCommit(opCtx, args.nss);
+}
+
+void LookupResultCacheOpObserver::onDelete(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           OptionalCollectionUUID uuid,
+                                           StmtId stmtId,
+                                           const OplogDeleteEntryArgs& args) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void LookupResultCacheOpObserver::onCreateCollection(OperationContext* opCtx,
+                                                     const CollectionPtr& coll,
+                                                     const NamespaceString& collectionName,
+                                                     const CollectionOptions& options,
+                                                     const BSONObj& idIndex,
+                                                     const OplogSlot& createOpTime) {
+    invalidateOnCommit(opCtx, collectionName);
+}
+
+void LookupResultCacheOpObserver::onDropDatabase(OperationContext* opCtx,
+                                                 const std::string& dbName) {
+    auto& cache = LookupResultCache::get(opCtx->getServiceContext());
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        cache.invalidateDatabase(dbName);
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [&cache, dbName](boost::optional<Timestamp>) { cache.invalidateDatabase(dbName); });
+}
+
+repl::OpTime LookupResultCacheOpObserver::onDropCollection(OperationContext* opCtx,
+                                                           const NamespaceString& collectionName,
+                                                           OptionalCollectionUUID uuid,
+                                                           std::uint64_t numRecords,
+                                                           CollectionDropType dropType) {
+    invalidateOnCommit(opCtx, collectionName);
+    return {};
+}
+
+void LookupResultCacheOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                     const NamespaceString& fromCollection,
+                                                     const NamespaceString& toCollection,
+                                                     OptionalCollectionUUID uuid,
+                                                     OptionalCollectionUUID dropTargetUUID,
+                                                     std::uint64_t numRecords,
+                                                     bool stayTemp) {
+    invalidateOnCommit(opCtx, fromCollection);
+    invalidateOnCommit(opCtx, toCollection);
+}
+
+void LookupResultCacheOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                       const NamespaceString& fromCollection,
+                                                       const NamespaceString& toCollection,
+                                                       OptionalCollectionUUID uuid,
+                                                       OptionalCollectionUUID dropTargetUUID,
+                                                       bool stayTemp) {
+    invalidateOnCommit(opCtx, fromCollection);
+    invalidateOnCommit(opCtx, toCollection);
+}
+
+void LookupResultCacheOpObserver::onImportCollection(OperationContext* opCtx,
+                                                     const UUID& importUUID,
+                                                     const NamespaceString& nss,
+                                                     long long numRecords,
+                                                     long long dataSize,
+                                                     const BSONObj& catalogEntry,
+                                                     const BSONObj& storageMetadata,
+                                                     bool isDryRun) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void LookupResultCacheOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                                const NamespaceString& collectionName,
+                                                OptionalCollectionUUID uuid) {
+    invalidateOnCommit(opCtx, collectionName);
+}
+
+void LookupResultCacheOpObserver::onReplicationRollback(OperationContext* opCtx,
+                                                        const RollbackObserverInfo& rbInfo) {
+    LookupResultCache::get(opCtx->getServiceContext()).invalidateAll();
+}
+
+}  // namespace mongo
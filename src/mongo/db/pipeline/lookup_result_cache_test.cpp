@@ -0,0 +1,168 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/lookup_result_cache.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kFooNss("test.foo");
+const NamespaceString kBarNss("test.bar");
+const NamespaceString kOtherDbNss("other.foo");
+
+constexpr size_t kLargeBudget = 1024 * 1024;
+
+std::string makeKey(const NamespaceString& nss, int value) {
+    return LookupResultCache::makeKey(nss, BSON("_id" << value), BSONObj());
+}
+
+void assertCached(LookupResultCache& cache,
+                  const NamespaceString& nss,
+                  const std::string& key,
+                  const std::vector<BSONObj>& expected) {
+    auto cached = cache.find(nss, key);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(cached->size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ((*cached)[i], expected[i]);
+    }
+}
+
+TEST(LookupResultCacheTest, KeyDependsOnNamespaceQueryAndCollation) {
+    auto key = makeKey(kFooNss, 1);
+    ASSERT_EQ(key, makeKey(kFooNss, 1));
+    ASSERT_NE(key, makeKey(kBarNss, 1));
+    ASSERT_NE(key, makeKey(kFooNss, 2));
+    ASSERT_NE(key,
+              LookupResultCache::makeKey(kFooNss, BSON("_id" << 1), BSON("locale"
+                                                                         << "fr")));
+}
+
+TEST(LookupResultCacheTest, ReturnsInsertedDocuments) {
+    LookupResultCache cache;
+    const std::vector<BSONObj> docs{BSON("_id" << 1 << "a" << 1), BSON("_id" << 2 << "a" << 1)};
+    auto key = makeKey(kFooNss, 1);
+
+    ASSERT_FALSE(cache.find(kFooNss, key));
+    cache.insert(kFooNss, key, cache.getVersion(kFooNss), docs, kLargeBudget);
+    assertCached(cache, kFooNss, key, docs);
+    ASSERT_EQ(cache.getNumEntries(), 1U);
+
+    // An empty result is cached as well.
+    auto emptyKey = makeKey(kFooNss, 2);
+    cache.insert(kFooNss, emptyKey, cache.getVersion(kFooNss), {}, kLargeBudget);
+    assertCached(cache, kFooNss, emptyKey, {});
+}
+
+TEST(LookupResultCacheTest, InvalidationMakesEntriesStale) {
+    LookupResultCache cache;
+    auto fooKey = makeKey(kFooNss, 1);
+    auto barKey = makeKey(kBarNss, 1);
+    cache.insert(kFooNss, fooKey, cache.getVersion(kFooNss), {BSON("_id" << 1)}, kLargeBudget);
+    cache.insert(kBarNss, barKey, cache.getVersion(kBarNss), {BSON("_id" << 1)}, kLargeBudget);
+
+    cache.invalidate(kFooNss);
+    ASSERT_FALSE(cache.find(kFooNss, fooKey));
+    assertCached(cache, kBarNss, barKey, {BSON("_id" << 1)});
+
+    // The stale entry is released when it is looked up.
+    ASSERT_EQ(cache.getNumEntries(), 1U);
+}
+
+TEST(LookupResultCacheTest, ResultsReadBeforeAWriteAreNotCached) {
+    LookupResultCache cache;
+    auto key = makeKey(kFooNss, 1);
+
+    auto version = cache.getVersion(kFooNss);
+    cache.invalidate(kFooNss);
+    cache.insert(kFooNss, key, version, {BSON("_id" << 1)}, kLargeBudget);
+    ASSERT_FALSE(cache.find(kFooNss, key));
+    ASSERT_EQ(cache.getNumEntries(), 0U);
+}
+
+TEST(LookupResultCacheTest, InvalidateDatabaseOnlyAffectsThatDatabase) {
+    LookupResultCache cache;
+    auto fooKey = makeKey(kFooNss, 1);
+    auto otherKey = makeKey(kOtherDbNss, 1);
+    cache.insert(kFooNss, fooKey, cache.getVersion(kFooNss), {BSON("_id" << 1)}, kLargeBudget);
+    cache.insert(
+        kOtherDbNss, otherKey, cache.getVersion(kOtherDbNss), {BSON("_id" << 1)}, kLargeBudget);
+
+    cache.invalidateDatabase(kOtherDbNss.db());
+    assertCached(cache, kFooNss, fooKey, {BSON("_id" << 1)});
+    ASSERT_FALSE(cache.find(kOtherDbNss, otherKey));
+
+    cache.invalidateAll();
+    ASSERT_FALSE(cache.find(kFooNss, fooKey));
+    ASSERT_EQ(cache.getNumEntries(), 0U);
+    ASSERT_EQ(cache.getSizeBytes(), 0U);
+}
+
+TEST(LookupResultCacheTest, EvictsLeastRecentlyUsedEntriesToStayWithinBudget) {
+    LookupResultCache cache;
+    auto version = cache.getVersion(kFooNss);
+    const auto doc = BSON("_id" << 1 << "padding" << std::string(100, 'x'));
+    auto key1 = makeKey(kFooNss, 1);
+    auto key2 = makeKey(kFooNss, 2);
+    auto key3 = makeKey(kFooNss, 3);
+
+    // Each entry is slightly over 100 bytes, so only two of them fit.
+    const size_t budget = 2 * (key1.size() + doc.objsize());
+    cache.insert(kFooNss, key1, version, {doc}, budget);
+    cache.insert(kFooNss, key2, version, {doc}, budget);
+
+    // Using the first entry makes the second one the least recently used.
+    assertCached(cache, kFooNss, key1, {doc});
+    cache.insert(kFooNss, key3, version, {doc}, budget);
+
+    ASSERT_EQ(cache.getNumEntries(), 2U);
+    ASSERT_LTE(cache.getSizeBytes(), budget);
+    assertCached(cache, kFooNss, key1, {doc});
+    ASSERT_FALSE(cache.find(kFooNss, key2));
+    assertCached(cache, kFooNss, key3, {doc});
+}
+
+TEST(LookupResultCacheTest, EntryLargerThanBudgetIsNotCached) {
+    LookupResultCache cache;
+    auto key = makeKey(kFooNss, 1);
+    const auto doc = BSON("_id" << 1 << "padding" << std::string(100, 'x'));
+    cache.insert(kFooNss, key, cache.getVersion(kFooNss), {doc}, doc.objsize());
+    ASSERT_FALSE(cache.find(kFooNss, key));
+    ASSERT_EQ(cache.getSizeBytes(), 0U);
+}
+
+}  // namespace
+}  // namespace mongo
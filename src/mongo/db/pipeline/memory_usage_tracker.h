@@ -40,6 +40,9 @@ namespace mongo {
 /**
  * This is a utility class for tracking memory usage across multiple arbitrary operators or
  * functions, which are identified by their string names.
+ *
+ * A tracker may have a parent, such as the tracker of all of the memory used by an operation, which
+ * the tracker reports all of its changes in memory usage to. The parent must outlive the tracker.
  */
 class MemoryUsageTracker {
 public:
@@ -81,8 +84,22 @@ public:
         long long _currentMemoryBytes = 0;
     };
 
-    MemoryUsageTracker(bool allowDiskUse = false, size_t maxMemoryUsageBytes = 0)
-        : _allowDiskUse(allowDiskUse), _maxAllowedMemoryUsageBytes(maxMemoryUsageBytes) {}
+    MemoryUsageTracker(bool allowDiskUse = false,
+                       size_t maxMemoryUsageBytes = 0,
+                       MemoryUsageTracker* parent = nullptr)
+        : _allowDiskUse(allowDiskUse),
+          _maxAllowedMemoryUsageBytes(maxMemoryUsageBytes),
+          _parent(parent) {}
+
+    MemoryUsageTracker(const MemoryUsageTracker&) = delete;
+    MemoryUsageTracker& operator=(const MemoryUsageTracker&) = delete;
+
+    ~MemoryUsageTracker() {
+        // Give the memory still accounted to this tracker back to the parent.
+        if (_parent) {
+            _parent->update(-_memoryUsageBytes);
+        }
+    }
 
     /**
      * Sets the new total for 'name', and updates the current total memory usage.
@@ -95,6 +112,9 @@ public:
      * Sets the new current memory usage in bytes.
      */
     void set(long long total) {
+        if (_parent) {
+            _parent->update(total - _memoryUsageBytes);
+        }
         _memoryUsageBytes = total;
         if (_memoryUsageBytes > _maxMemoryUsageBytes) {
             _maxMemoryUsageBytes = _memoryUsageBytes;
@@ -109,7 +129,7 @@ public:
         for (auto& [_, funcTracker] : _functionMemoryTracker) {
             funcTracker.set(0);
         }
-        _memoryUsageBytes = 0;
+        set(0);
     }
 
     /**
@@ -158,14 +178,42 @@ public:
         return _maxMemoryUsageBytes;
     }
 
+    /**
+     * Returns false if this tracker uses more memory than it allows, or if one of its ancestors
+     * does and this tracker is responsible for enough of it that it should free some memory, for
+     * instance by spilling to disk.
+     */
+    bool withinMemoryLimit() const {
+        if (_memoryUsageBytes > static_cast<long long>(_maxAllowedMemoryUsageBytes)) {
+            return false;
+        }
+        if (_memoryUsageBytes < kMinMemoryUsageBytesToFreeForParent) {
+            return true;
+        }
+        for (auto ancestor = _parent; ancestor; ancestor = ancestor->_parent) {
+            if (ancestor->_memoryUsageBytes >
+                static_cast<long long>(ancestor->_maxAllowedMemoryUsageBytes)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     const bool _allowDiskUse;
     const size_t _maxAllowedMemoryUsageBytes;
 
 private:
+    // A tracker using less memory than this is not asked to free memory when one of its ancestors
+    // exceeds its limit, so that it does not, for instance, spill to disk for every new document
+    // while other consumers hold most of the memory.
+    static constexpr long long kMinMemoryUsageBytesToFreeForParent = 1024 * 1024;
+
     static absl::string_view _key(StringData s) {
         return {s.rawData(), s.size()};
     }
 
+    MemoryUsageTracker* const _parent;
+
     // Tracks current memory used.
     long long _memoryUsageBytes = 0;
     long long _maxMemoryUsageBytes = 0;
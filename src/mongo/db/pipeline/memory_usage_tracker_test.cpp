@@ -99,6 +99,50 @@ TEST_F(MemoryUsageTrackerTest, UpdateUsageUpdatesGlobal) {
     ASSERT_EQ(_tracker.maxMemoryBytes(), 150LL);
 }
 
+TEST_F(MemoryUsageTrackerTest, ChildUsageUpdatesParent) {
+    boost::optional<MemoryUsageTracker> child;
+    child.emplace(false /** allowDiskUse */, kDefaultMax, &_tracker);
+    _tracker.set(50LL);
+
+    child->set(100LL);
+    child->update("func", 50);
+    ASSERT_EQ(child->currentMemoryBytes(), 150LL);
+    ASSERT_EQ(_tracker.currentMemoryBytes(), 200LL);
+
+    child->resetCurrent();
+    ASSERT_EQ(_tracker.currentMemoryBytes(), 50LL);
+    ASSERT_EQ(_tracker.maxMemoryBytes(), 200LL);
+
+    // The memory still held by a child is given back to the parent when the child goes away.
+    child->set(25LL);
+    ASSERT_EQ(_tracker.currentMemoryBytes(), 75LL);
+    child.reset();
+    ASSERT_EQ(_tracker.currentMemoryBytes(), 50LL);
+}
+
+TEST_F(MemoryUsageTrackerTest, ChildExceedsLimitWhenParentDoes) {
+    constexpr long long kMB = 1024 * 1024;
+    MemoryUsageTracker parent(false /** allowDiskUse */, 4 * kMB);
+    MemoryUsageTracker bigChild(false /** allowDiskUse */, 10 * kMB, &parent);
+    MemoryUsageTracker smallChild(false /** allowDiskUse */, 10 * kMB, &parent);
+
+    bigChild.set(3 * kMB);
+    smallChild.set(kMB / 2);
+    ASSERT_TRUE(bigChild.withinMemoryLimit());
+    ASSERT_TRUE(smallChild.withinMemoryLimit());
+
+    // Only the child holding enough of the memory of the parent has to free some.
+    bigChild.set(4 * kMB);
+    ASSERT_FALSE(parent.withinMemoryLimit());
+    ASSERT_FALSE(bigChild.withinMemoryLimit());
+    ASSERT_TRUE(smallChild.withinMemoryLimit());
+
+    // A child exceeding its own limit is over it regardless of the parent.
+    bigChild.set(0);
+    smallChild.set(11 * kMB);
+    ASSERT_FALSE(smallChild.withinMemoryLimit());
+}
+
 DEATH_TEST_F(MemoryUsageTrackerTest,
              UpdateGlobalToNegativeIsDisallowed,
              "Underflow on memory tracking") {
@@ -46,6 +46,7 @@
 #include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/multi_iterator.h"
 #include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/exec/reservoir_sample_from_timeseries_bucket.h"
 #include "mongo/db/exec/sample_from_timeseries_bucket.h"
 #include "mongo/db/exec/shard_filter.h"
 #include "mongo/db/exec/trial_stage.h"
@@ -63,6 +64,7 @@
 #include "mongo/db/pipeline/document_source_geo_near_cursor.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_lookup.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
@@ -74,9 +76,12 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/record_store.h"
@@ -84,6 +89,7 @@
 #include "mongo/db/timeseries/timeseries_gen.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/s/query/document_source_merge_cursors.h"
+#include "mongo/util/string_map.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -95,6 +101,22 @@ using std::unique_ptr;
 using write_ops::InsertCommandRequest;
 
 namespace {
+/**
+ * Returns a plan which samples 'sampleSize' measurements from the time-series buckets collection
+ * 'coll' by scanning every bucket once and extracting only the measurements which are sampled.
+ */
+std::unique_ptr<PlanStage> makeTimeseriesReservoirSamplePlan(
+    const CollectionPtr& coll,
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    WorkingSet* ws,
+    const BucketUnpacker& bucketUnpacker,
+    long long sampleSize) {
+    auto collScanPlan = std::make_unique<CollectionScan>(
+        expCtx.get(), coll, CollectionScanParams{}, ws, nullptr);
+    return std::make_unique<ReservoirSampleFromTimeseriesBucket>(
+        expCtx.get(), ws, std::move(collScanPlan), bucketUnpacker, sampleSize);
+}
+
 /**
  * Returns a 'PlanExecutor' which uses a random cursor to sample documents if successful as
  * determined by the boolean. Returns {} if the storage engine doesn't support random cursors, or if
@@ -113,6 +135,8 @@ createRandomCursorExecutor(const CollectionPtr& coll,
     invariant(opCtx->lockState()->isCollectionLockedForMode(coll->ns(), MODE_IS));
 
     static const double kMaxSampleRatioForRandCursor = 0.05;
+    const bool useReservoirSample = expCtx->ns.isTimeseriesBucketsCollection() && bucketUnpacker &&
+        internalQueryTimeseriesReservoirSample.load();
     if (!expCtx->ns.isTimeseriesBucketsCollection()) {
         if (sampleSize > numRecords * kMaxSampleRatioForRandCursor || numRecords <= 100) {
             return std::pair{nullptr, false};
@@ -127,9 +151,28 @@ createRandomCursorExecutor(const CollectionPtr& coll,
         // the tipping point is roughly when the requested sample size is greater than 1% of the
         // maximum possible number of measurements in the collection (i.e. numBuckets *
         // maxMeasurementsPerBucket).
+        //
+        // If reservoir sampling is enabled, such a sample is instead drawn by a single scan which
+        // only extracts the sampled measurements from their buckets.
         static const double kCoefficient = 0.01;
         if (sampleSize > kCoefficient * numRecords * gTimeseriesBucketMaxCount) {
-            return std::pair{nullptr, false};
+            if (!useReservoirSample) {
+                return std::pair{nullptr, false};
+            }
+
+            auto ws = std::make_unique<WorkingSet>();
+            auto root = makeTimeseriesReservoirSamplePlan(
+                coll, expCtx, ws.get(), *bucketUnpacker, sampleSize);
+            auto execStatus = plan_executor_factory::make(expCtx,
+                                                          std::move(ws),
+                                                          std::move(root),
+                                                          &coll,
+                                                          PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                                          QueryPlannerParams::RETURN_OWNED_DATA);
+            if (!execStatus.isOK()) {
+                return execStatus.getStatus();
+            }
+            return std::pair{std::move(execStatus.getValue()), true};
         }
     }
 
@@ -229,16 +272,23 @@ createRandomCursorExecutor(const CollectionPtr& coll,
             sampleSize,
             gTimeseriesBucketMaxCount);
 
-        std::unique_ptr<PlanStage> collScanPlan = std::make_unique<CollectionScan>(
-            expCtx.get(), coll, CollectionScanParams{}, ws.get(), nullptr);
-
-        auto topkSortPlan = std::make_unique<UnpackTimeseriesBucket>(
-            expCtx.get(), ws.get(), std::move(collScanPlan), *bucketUnpacker);
+        // When reservoir sampling is enabled, the backup plan draws the sample by itself rather
+        // than leaving it to the top-k sort of $sample.
+        std::unique_ptr<PlanStage> backupPlan;
+        if (useReservoirSample) {
+            backupPlan = makeTimeseriesReservoirSamplePlan(
+                coll, expCtx, ws.get(), *bucketUnpacker, sampleSize);
+        } else {
+            std::unique_ptr<PlanStage> collScanPlan = std::make_unique<CollectionScan>(
+                expCtx.get(), coll, CollectionScanParams{}, ws.get(), nullptr);
+            backupPlan = std::make_unique<UnpackTimeseriesBucket>(
+                expCtx.get(), ws.get(), std::move(collScanPlan), *bucketUnpacker);
+        }
 
         root = std::make_unique<TrialStage>(expCtx.get(),
                                             ws.get(),
                                             std::move(arhashPlan),
-                                            std::move(topkSortPlan),
+                                            std::move(backupPlan),
                                             kMaxPresampleSize,
                                             minAdvancedToWorkRatio);
         trialStage = static_cast<TrialStage*>(root.get());
@@ -256,9 +306,10 @@ createRandomCursorExecutor(const CollectionPtr& coll,
 
     // For sharded collections, the root of the plan tree is a TrialStage that may have chosen
     // either a random-sampling cursor trial plan or a COLLSCAN backup plan. We can only optimize
-    // the $sample aggregation stage if the trial plan was chosen.
+    // the $sample aggregation stage if the trial plan was chosen, or if the backup plan samples
+    // time-series measurements by itself.
     return std::pair{std::move(execStatus.getValue()),
-                     !trialStage || !trialStage->pickedBackupPlan()};
+                     !trialStage || !trialStage->pickedBackupPlan() || useReservoirSample};
 }
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExecutor(
@@ -273,7 +324,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     boost::optional<std::string> groupIdForDistinctScan,
     const AggregateCommandRequest* aggRequest,
     const size_t plannerOpts,
-    const MatchExpressionParser::AllowedFeatureSet& matcherFeatures) {
+    const MatchExpressionParser::AllowedFeatureSet& matcherFeatures,
+    std::vector<EqLookupSpec> pipelineLookups) {
     auto findCommand = std::make_unique<FindCommandRequest>(nss);
     query_request_helper::setTailableMode(expCtx->tailableMode, findCommand.get());
     findCommand->setFilter(queryObj.getOwned());
@@ -323,6 +375,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
 
     // Mark the metadata that's requested by the pipeline on the CQ.
     cq.getValue()->requestAdditionalMetadata(metadataRequested);
+    cq.getValue()->setPipelineLookups(std::move(pipelineLookups));
 
     if (groupIdForDistinctScan) {
         // When the pipeline includes a $group that groups by a single field
@@ -356,6 +409,50 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
         expCtx->opCtx, &collection, std::move(cq.getValue()), permitYield, plannerOpts);
 }
 
+/**
+ * Returns the specs of the $lookup stages at the front of 'pipeline' which the query layer can
+ * execute as part of the plan, stopping at the first $lookup which it cannot. Only equality joins
+ * on top-level fields of an unsharded, non-view foreign collection which use the collation of the
+ * pipeline qualify, and only for lock-free reads, where the foreign collection can be accessed
+ * through the same catalog snapshot as the main one.
+ */
+std::vector<EqLookupSpec> findLookupsForPushdown(const intrusive_ptr<ExpressionContext>& expCtx,
+                                                 const Pipeline* pipeline,
+                                                 size_t plannerOpts) {
+    std::vector<EqLookupSpec> lookups;
+    if (!internalQuerySlotBasedExecutionEnableLookupPushdown.load() ||
+        !expCtx->opCtx->isLockFreeReadsOp() ||
+        OperationShardingState::isOperationVersioned(expCtx->opCtx) ||
+        expCtx->tailableMode != TailableModeEnum::kNormal ||
+        (plannerOpts & QueryPlannerParams::TRACK_LATEST_OPLOG_TS)) {
+        return lookups;
+    }
+
+    for (auto&& source : pipeline->getSources()) {
+        auto lookup = dynamic_cast<const DocumentSourceLookUp*>(source.get());
+        if (!lookup || !lookup->hasLocalFieldForeignFieldJoin() || lookup->hasPipeline() ||
+            !lookup->getLetVariables().empty() || lookup->hasUnwindSrc() ||
+            lookup->hasAdditionalFilter() || lookup->isFromNsView() ||
+            !lookup->usesParentCollation()) {
+            break;
+        }
+
+        auto localField = *lookup->getLocalField();
+        auto foreignField = *lookup->getForeignField();
+        const auto& asField = lookup->getAsField();
+        if (localField.getPathLength() != 1 || foreignField.getPathLength() != 1 ||
+            asField.getPathLength() != 1) {
+            break;
+        }
+
+        lookups.push_back({lookup->getFromNs(),
+                           localField.fullPath(),
+                           foreignField.fullPath(),
+                           asField.fullPath()});
+    }
+    return lookups;
+}
+
 /**
  * Examines the indexes in 'collection' and returns the field name of a geo-indexed field suitable
  * for use in $geoNear. 2d indexes are given priority over 2dsphere indexes.
@@ -425,7 +522,8 @@ std::pair<DocumentSourceSample*, DocumentSourceInternalUnpackBucket*> extractSam
         unpackStage = dynamic_cast<DocumentSourceInternalUnpackBucket*>(sourcesIt->get());
         ++sourcesIt;
 
-        if (unpackStage && sourcesIt != sources.end()) {
+        // Sampling buckets directly would bypass the event filter of the unpack stage.
+        if (unpackStage && !unpackStage->eventFilter() && sourcesIt != sources.end()) {
             sampleStage = dynamic_cast<DocumentSourceSample*>(sourcesIt->get());
             return std::pair{sampleStage, unpackStage};
         }
@@ -656,11 +754,16 @@ SkipThenLimit extractSkipAndLimitForPushdown(Pipeline* pipeline) {
  * happen in case 1). If 'allowExpressions' is false and the projection we find has expressions,
  * then we fall through to case 2 and attempt to push down a pure-inclusion projection based on its
  * dependencies.
+ *
+ * Sets 'isDependencySet' to true in case 2, where the projection only needs to return at least the
+ * fields that the rest of the pipeline depends on.
  */
 auto buildProjectionForPushdown(const DepsTracker& deps,
                                 Pipeline* pipeline,
-                                bool allowExpressions) {
+                                bool allowExpressions,
+                                bool* isDependencySet) {
     auto&& sources = pipeline->getSources();
+    *isDependencySet = false;
 
     // Short-circuit if the pipeline is empty: there is no projection and nothing to push down.
     if (sources.empty()) {
@@ -689,8 +792,45 @@ auto buildProjectionForPushdown(const DepsTracker& deps,
     // happen. This covers cases 2 and 3.
     if (deps.getNeedsAnyMetadata())
         return BSONObj();
+    *isDependencySet = true;
     return deps.toProjectionWithoutMetadata();
 }
+
+/**
+ * Returns true if the documents produced by the query layer for 'pipeline' may be read by a
+ * collection scan which is split across several threads. This is the case when they feed a $group
+ * whose result does not depend on the order of its input. Since the scanning threads run on their
+ * own operation contexts, the read must also not rely on the snapshot or transaction of the
+ * caller's operation.
+ */
+bool canUseParallelCollScan(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                            Pipeline* pipeline) {
+    if (internalQuerySlotBasedExecutionParallelCollScanDegree.load() <= 1) {
+        return false;
+    }
+
+    auto opCtx = expCtx->opCtx;
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (opCtx->inMultiDocumentTransaction() ||
+        readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern ||
+        readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime()) {
+        return false;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(pipeline->peekFront());
+    if (!groupStage) {
+        return false;
+    }
+
+    static const StringDataSet kOrderSensitiveAccumulators{
+        "$first", "$last", "$push", "$firstN", "$lastN"};
+    for (auto&& accumulator : groupStage->getAccumulatedFields()) {
+        if (kOrderSensitiveAccumulators.count(accumulator.expr.name)) {
+            return false;
+        }
+    }
+    return true;
+}
 }  // namespace
 
 std::pair<PipelineD::AttachExecutorCallback, std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
@@ -726,6 +866,11 @@ PipelineD::buildInnerQueryExecutorGeneric(const CollectionPtr& collection,
     if (groupStage) {
         rewrittenGroupStage = groupStage->rewriteGroupAsTransformOnFirstDocument();
     }
+    if (sortStage && groupStage) {
+        // The $sort is pushed down into the query layer, which returns the input of the $group in
+        // its order.
+        groupStage->setInputSortPattern(sortStage->getSortKeyPattern());
+    }
 
     // If there is a $limit or $skip stage (or multiple of them) that could be pushed down into the
     // PlanStage layer, obtain the value of the limit and skip and remove the $limit and $skip
@@ -929,8 +1074,17 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         // documents that the sort/skip/limit would have filtered out. (The sort stage can be a
         // top-k sort, which both sorts and limits.)
         bool allowExpressions = !sortStage && !skipThenLimit.getSkip() && !skipThenLimit.getLimit();
-        projObj = buildProjectionForPushdown(deps, pipeline, allowExpressions);
+        bool isDependencySet = false;
+        projObj = buildProjectionForPushdown(deps, pipeline, allowExpressions, &isDependencySet);
         plannerOpts |= QueryPlannerParams::RETURN_OWNED_DATA;
+        if (isDependencySet && internalQueryProjectTopLevelFieldsOfPipelineDependencies.load()) {
+            plannerOpts |= QueryPlannerParams::PROJECTION_IS_DEPENDENCY_SET;
+        }
+    }
+
+    // A pushed down $sort fixes the order in which the $group sees its input.
+    if (!sortStage && canUseParallelCollScan(expCtx, pipeline)) {
+        plannerOpts |= QueryPlannerParams::ALLOW_PARALLEL_COLLSCAN;
     }
 
     if (rewrittenGroupStage) {
@@ -947,7 +1101,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                                       rewrittenGroupStage->groupId(),
                                                       aggRequest,
                                                       plannerOpts,
-                                                      matcherFeatures);
+                                                      matcherFeatures,
+                                                      {} /* pipelineLookups */);
 
         if (swExecutorGrouped.isOK()) {
             // Any $limit stage before the $group stage should make the pipeline ineligible for this
@@ -976,18 +1131,31 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
-    return attemptToGetExecutor(expCtx,
-                                collection,
-                                nss,
-                                queryObj,
-                                projObj,
-                                deps.metadataDeps(),
-                                sortObj,
-                                skipThenLimit,
-                                boost::none, /* groupIdForDistinctScan */
-                                aggRequest,
-                                plannerOpts,
-                                matcherFeatures);
+    auto swExecutor = attemptToGetExecutor(expCtx,
+                                           collection,
+                                           nss,
+                                           queryObj,
+                                           projObj,
+                                           deps.metadataDeps(),
+                                           sortObj,
+                                           skipThenLimit,
+                                           boost::none, /* groupIdForDistinctScan */
+                                           aggRequest,
+                                           plannerOpts,
+                                           matcherFeatures,
+                                           findLookupsForPushdown(expCtx, pipeline, plannerOpts));
+
+    // The executor may have kept only some of the $lookup stages offered to it, or none if it runs
+    // in the classic engine. Those it kept are evaluated by the plan, so remove them from the
+    // pipeline.
+    if (swExecutor.isOK()) {
+        if (auto cq = swExecutor.getValue()->getCanonicalQuery()) {
+            for (size_t i = 0; i < cq->getPipelineLookups().size(); ++i) {
+                invariant(pipeline->popFrontWithName(DocumentSourceLookUp::kStageName));
+            }
+        }
+    }
+    return swExecutor;
 }
 
 Timestamp PipelineD::getLatestOplogTimestamp(const Pipeline* pipeline) {
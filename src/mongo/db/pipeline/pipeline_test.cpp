@@ -2946,6 +2946,61 @@ TEST(PipelineOptimizationTest, UnionWithViewsSampleUseCase) {
         " }}"
         "]");
 }
+
+TEST(PipelineOptimizationTest, MatchCommonToAllFacetsIsMovedBeforeFacet) {
+    string inputPipe =
+        "[{$facet: {"
+        "   a: [{$match: {x: 1}}, {$limit: 1}],"
+        "   b: [{$match: {x: 1}}, {$skip: 2}]"
+        "}}]";
+    string outputPipe =
+        "[{$match: {x: {$eq: 1}}},"
+        " {$facet: {"
+        "   a: [{$teeConsumer: {}}, {$limit: 1}],"
+        "   b: [{$teeConsumer: {}}, {$skip: 2}]"
+        " }}]";
+    string serializedPipe =
+        "[{$match: {x: 1}},"
+        " {$facet: {a: [{$limit: 1}], b: [{$skip: 2}]}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, SuccessiveMatchesCommonToAllFacetsAreMovedBeforeFacetAndCoalesced) {
+    string inputPipe =
+        "[{$facet: {"
+        "   a: [{$match: {x: 1}}, {$match: {y: 1}}],"
+        "   b: [{$match: {x: 1}}, {$match: {y: 1}}, {$limit: 1}]"
+        "}}]";
+    string outputPipe =
+        "[{$match: {$and: [{x: {$eq: 1}}, {y: {$eq: 1}}]}},"
+        " {$facet: {"
+        "   a: [{$teeConsumer: {}}],"
+        "   b: [{$teeConsumer: {}}, {$limit: 1}]"
+        " }}]";
+    string serializedPipe =
+        "[{$match: {$and: [{x: 1}, {y: 1}]}},"
+        " {$facet: {a: [], b: [{$limit: 1}]}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, MatchIsNotMovedBeforeFacetUnlessCommonToAllFacets) {
+    assertPipelineOptimizesAndSerializesTo(
+        "[{$facet: {"
+        "   a: [{$match: {x: 1}}],"
+        "   b: [{$match: {x: 2}}],"
+        "   c: [{$limit: 1}, {$match: {x: 1}}]"
+        "}}]",
+        "[{$facet: {"
+        "   a: [{$teeConsumer: {}}, {$match: {x: {$eq: 1}}}],"
+        "   b: [{$teeConsumer: {}}, {$match: {x: {$eq: 2}}}],"
+        "   c: [{$teeConsumer: {}}, {$limit: 1}, {$match: {x: {$eq: 1}}}]"
+        "}}]",
+        "[{$facet: {"
+        "   a: [{$match: {x: 1}}],"
+        "   b: [{$match: {x: 2}}],"
+        "   c: [{$limit: 1}, {$match: {x: 1}}]"
+        "}}]");
+}
 }  // namespace Local
 
 namespace Sharded {
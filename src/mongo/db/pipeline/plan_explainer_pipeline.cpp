@@ -35,6 +35,7 @@
 #include "mongo/db/pipeline/document_source_lookup.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
+#include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
 #include "mongo/db/query/explain.h"
 
@@ -91,6 +92,11 @@ void PlanExplainerPipeline::getSummaryStats(PlanSummaryStats* statsOut) const {
         }
     }
 
+    // The sub-pipelines share the memory tracker of the operation, so this covers them too.
+    statsOut->peakMemoryUsageBytes =
+        std::max(statsOut->peakMemoryUsageBytes,
+                 _pipeline->getContext()->getOperationMemoryTracker()->maxMemoryBytes());
+
     if (_nReturned) {
         statsOut->nReturned = _nReturned;
     }
@@ -189,6 +189,15 @@ std::vector<Document> CommonMongodProcessInterface::getIndexStats(OperationConte
         doc["accesses"]["ops"] = Value(stats->accesses.loadRelaxed());
         doc["accesses"]["since"] = Value(stats->trackerStartTime);
 
+        const auto trialWins = stats->trialWins.loadRelaxed();
+        const auto trialLosses = stats->trialLosses.loadRelaxed();
+        const auto trialsSkipped = stats->trialsSkipped.loadRelaxed();
+        if (trialWins || trialLosses || trialsSkipped) {
+            doc["trials"]["wins"] = Value(trialWins);
+            doc["trials"]["losses"] = Value(trialLosses);
+            doc["trials"]["skipped"] = Value(trialsSkipped);
+        }
+
         if (addShardName)
             doc["shard"] = Value(getShardName(opCtx));
 
@@ -73,10 +73,29 @@ std::vector<BSONObj> CommonProcessInterface::getCurrentOps(
     auto blockedOpGuard = DiagnosticInfo::maybeMakeBlockedOpForTest(opCtx->getClient());
 #endif
 
+    // Operations which publish currentOp snapshots can be reported without locking their clients,
+    // so that $currentOp neither waits on nor stalls them. Snapshots are built without truncation
+    // or backtraces, and are only used when no per-client authorization check is needed.
+    const bool useSnapshots = CurOp::areCurrentOpSnapshotsEnabled() &&
+        truncateMode == CurrentOpTruncateMode::kNoTruncation &&
+        backtraceMode == CurrentOpBacktraceMode::kExcludeBacktrace &&
+        (!ctxAuth->getAuthorizationManager().isAuthEnabled() ||
+         userMode == CurrentOpUserMode::kIncludeAll);
+
     for (ServiceContext::LockedClientsCursor cursor(opCtx->getClient()->getServiceContext());
          Client* client = cursor.next();) {
         invariant(client);
 
+        if (useSnapshots) {
+            if (auto report = CurOp::getCurrentOpSnapshot(opCtx, client)) {
+                if (connMode == CurrentOpConnectionsMode::kIncludeIdle ||
+                    (*report)["active"].trueValue()) {
+                    ops.emplace_back(std::move(*report));
+                }
+                continue;
+            }
+        }
+
         stdx::lock_guard<Client> lk(*client);
 
         // If auth is disabled, ignore the allUsers parameter.
@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_change_stream_handle_topology_change.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -45,6 +46,7 @@
 #include "mongo/db/pipeline/document_source_out.h"
 #include "mongo/db/pipeline/document_source_project.h"
 #include "mongo/db/pipeline/document_source_sequential_document_cache.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_unwind.h"
@@ -804,6 +806,67 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, cm);
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx, const Pipeline* mergePipeline, const std::set<ShardId>& shardIds) {
+    if (!internalQueryEnableGroupExchange.load() || internalQueryDisableExchange.load()) {
+        return boost::none;
+    }
+
+    if (shardIds.size() < 2 || shardIds.size() > Exchange::kMaxNumberConsumers ||
+        mergePipeline->getSources().empty() || opCtx->inMultiDocumentTransaction()) {
+        return boost::none;
+    }
+
+    // The shards partition the partial groups by hashing their group key, which only places equal
+    // keys on the same consumer when the group key comparison does not depend on a collation.
+    if (mergePipeline->getContext()->getCollator()) {
+        return boost::none;
+    }
+
+    const auto& sources = mergePipeline->getSources();
+    auto mergingGroup = dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (!mergingGroup || !mergingGroup->doingMerge()) {
+        return boost::none;
+    }
+
+    // Once the groups are partitioned across the consumers, their results are simply concatenated.
+    // Any stage after the $group must therefore produce the same results when applied to each
+    // partition separately.
+    if (!std::all_of(std::next(sources.begin()), sources.end(), [](const auto& stage) {
+            return dynamic_cast<DocumentSourceMatch*>(stage.get()) ||
+                dynamic_cast<DocumentSourceSingleDocumentTransformation*>(stage.get());
+        })) {
+        return boost::none;
+    }
+
+    // Split the space of hashed group keys into one equally sized range per targeted shard. The
+    // merging $group always takes the group key of a partial group from its '_id'.
+    const auto numConsumers = shardIds.size();
+    const auto rangeSize = std::numeric_limits<uint64_t>::max() / numConsumers;
+    std::vector<BSONObj> boundaries{BSON("_id" << MINKEY)};
+    std::vector<int> consumerIds;
+    for (size_t idx = 0; idx < numConsumers; ++idx) {
+        if (idx + 1 < numConsumers) {
+            // Offset from the smallest hash value in unsigned arithmetic to avoid overflow.
+            auto split = static_cast<uint64_t>(std::numeric_limits<long long>::min()) +
+                rangeSize * (idx + 1);
+            boundaries.emplace_back(BSON("_id" << static_cast<long long>(split)));
+        }
+        consumerIds.emplace_back(idx);
+    }
+    boundaries.emplace_back(BSON("_id" << MAXKEY));
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(std::move(boundaries));
+    exchangeSpec.setConsumers(numConsumers);
+    exchangeSpec.setConsumerIds(std::move(consumerIds));
+
+    return ShardedExchangePolicy{std::move(exchangeSpec), {shardIds.begin(), shardIds.end()}};
+}
+
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
     auto& expCtx = pipeline->getContext();
     // Re-brand 'pipeline' as the merging pipeline. We will move stages one by one from the merging
@@ -985,6 +1048,10 @@ DispatchShardPipelineResults dispatchShardPipeline(
         splitPipelines = splitPipeline(std::move(pipeline));
 
         exchangeSpec = checkIfEligibleForExchange(opCtx, splitPipelines->mergePipeline.get());
+        if (!exchangeSpec) {
+            exchangeSpec = checkIfEligibleForGroupExchange(
+                opCtx, splitPipelines->mergePipeline.get(), shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <set>
+
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/s/async_requests_sender.h"
 #include "mongo/s/catalog_cache.h"
@@ -105,6 +107,16 @@ struct DispatchShardPipelineResults {
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
 
+/**
+ * If the merging pipeline consists of a merging $group followed only by stages which transform or
+ * filter each document independently, and 'internalQueryEnableGroupExchange' is set, returns an
+ * exchange which hash-partitions the partial groups produced by 'shardIds' by their group key. Each
+ * of the shards then merges a disjoint subset of the groups, so that their results only need to be
+ * concatenated.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx, const Pipeline* mergePipeline, const std::set<ShardId>& shardIds);
+
 /**
  * Split the current Pipeline into a Pipeline for each shard, and a Pipeline that combines the
  * results within a merging process. This call also performs optimizations with the aim of reducing
@@ -30,6 +30,8 @@
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/stats/wait_events.h"
+
 namespace mongo {
 
 const OperationContext::Decoration<PrepareConflictTracker> PrepareConflictTracker::get =
@@ -40,36 +42,54 @@ bool PrepareConflictTracker::isWaitingOnPrepareConflict() const {
 }
 
 void PrepareConflictTracker::beginPrepareConflict(OperationContext* opCtx) {
+    invariant(_prepareConflictStartTime.load() == 0);
+    _prepareConflictStartTime.store(opCtx->getServiceContext()->getTickSource()->getTicks());
     // Implies that the current read operation is blocked on a prepared transaction.
     _waitOnPrepareConflict.store(true);
-    invariant(_prepareConflictStartTime == 0);
-    _prepareConflictStartTime = opCtx->getServiceContext()->getTickSource()->getTicks();
 }
 
 void PrepareConflictTracker::endPrepareConflict(OperationContext* opCtx) {
     if (_waitOnPrepareConflict.load()) {
         auto tickSource = opCtx->getServiceContext()->getTickSource();
         auto curTick = tickSource->getTicks();
+        auto startTick = _prepareConflictStartTime.load();
 
-        invariant(_prepareConflictStartTime <= curTick,
+        invariant(startTick <= curTick,
                   str::stream() << "Prepare conflict start time ("
-                                << tickSource->ticksTo<Microseconds>(_prepareConflictStartTime)
+                                << tickSource->ticksTo<Microseconds>(startTick)
                                 << ") is somehow greater than current time ("
                                 << tickSource->ticksTo<Microseconds>(curTick) << ")");
 
-        auto curConflictDuration =
-            tickSource->ticksTo<Microseconds>(curTick - _prepareConflictStartTime);
+        auto curConflictDuration = tickSource->ticksTo<Microseconds>(curTick - startTick);
         _prepareConflictDuration.store(_prepareConflictDuration.load() + curConflictDuration);
-        _prepareConflictStartTime = 0;
+        WaitEventStats::record(opCtx, WaitEvent::kPrepareConflict, curConflictDuration);
 
         // Implies that the current read operation is not blocked on a prepared transaction.
         _waitOnPrepareConflict.store(false);
+        _prepareConflictStartTime.store(0);
     }
-    invariant(_prepareConflictStartTime == 0);
+    invariant(_prepareConflictStartTime.load() == 0);
 }
 
 Microseconds PrepareConflictTracker::getPrepareConflictDuration() {
     return _prepareConflictDuration.load();
 }
 
+Microseconds PrepareConflictTracker::getCurrentPrepareConflictDuration(
+    OperationContext* opCtx) const {
+    if (!_waitOnPrepareConflict.load()) {
+        return Microseconds(0);
+    }
+    // The start time is set before the flag and reset after it is cleared, so a zero start time
+    // only means the conflict ended in between the two loads.
+    auto startTick = _prepareConflictStartTime.load();
+    if (startTick == 0) {
+        return Microseconds(0);
+    }
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    auto curTick = tickSource->getTicks();
+    return curTick > startTick ? tickSource->ticksTo<Microseconds>(curTick - startTick)
+                               : Microseconds(0);
+}
+
 }  // namespace mongo
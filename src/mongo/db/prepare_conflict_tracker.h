@@ -70,6 +70,12 @@ public:
      */
     Microseconds getPrepareConflictDuration();
 
+    /**
+     * Returns how long the operation has been blocked on its current prepare conflict, or zero if
+     * it is not blocked on one. May be called from threads other than the operation's own.
+     */
+    Microseconds getCurrentPrepareConflictDuration(OperationContext* opCtx) const;
+
 private:
     /**
      * Set to true when a read operation is currently blocked on a prepare conflict.
@@ -81,7 +87,7 @@ private:
      * tracker. _prepareConflictStartTime indicates the most recent time a block started due to a
      * prepare read conflict.
      */
-    TickSource::Tick _prepareConflictStartTime{0};
+    AtomicWord<TickSource::Tick> _prepareConflictStartTime{0};
 
     /**
      * Stores the total amount of time spent blocked on prepare read conflicts.
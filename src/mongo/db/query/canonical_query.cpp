@@ -38,6 +38,7 @@
 #include "mongo/db/cst/cst_parser.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_array.h"
+#include "mongo/db/matcher/expression_parameterization.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/canonical_query_encoder.h"
@@ -209,6 +210,7 @@ Status CanonicalQuery::init(OperationContext* opCtx,
     if (auto status = isValidNormalized(_root.get()); !status.isOK()) {
         return status;
     }
+    _inputParamIdToExpressionMap = expression::parameterize(_root.get());
 
     // Validate the projection if there is one.
     if (!_findCommand->getProjection().isEmpty()) {
@@ -318,6 +320,34 @@ bool CanonicalQuery::isSimpleIdQuery(const BSONObj& query) {
     return hasID;
 }
 
+// static
+bool CanonicalQuery::isSimpleIdInQuery(const BSONObj& query) {
+    if (query.nFields() != 1) {
+        return false;
+    }
+
+    BSONElement idElt = query.firstElement();
+    if (idElt.fieldNameStringData() != "_id" || idElt.type() != Object ||
+        idElt.Obj().nFields() != 1) {
+        return false;
+    }
+
+    BSONElement inElt = idElt.Obj().firstElement();
+    if (inElt.fieldNameStringData() != "$in" || inElt.type() != Array || inElt.Obj().isEmpty()) {
+        return false;
+    }
+
+    for (auto&& elt : inElt.Obj()) {
+        // Each value must be one which isSimpleIdQuery() accepts as the value of _id.
+        if (!Indexability::isExactBoundsGenerating(elt) ||
+            (elt.type() == Object && elt.Obj().firstElementFieldName()[0] == '$')) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 size_t CanonicalQuery::countNodes(const MatchExpression* root, MatchExpression::MatchType type) {
     size_t sum = 0;
     if (type == root->matchType()) {
@@ -35,6 +35,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/projection.h"
 #include "mongo/db/query/projection_policies.h"
@@ -45,6 +46,17 @@ namespace mongo {
 
 class OperationContext;
 
+/**
+ * A $lookup stage with the localField/foreignField syntax that has been pushed down from an
+ * aggregation pipeline into the query layer. All the fields are top-level field names.
+ */
+struct EqLookupSpec {
+    NamespaceString foreignCollection;
+    std::string localField;
+    std::string foreignField;
+    std::string asField;
+};
+
 class CanonicalQuery {
 public:
     // A type that encodes the notion of query shape. Essentialy a query's match, projection and
@@ -106,6 +118,12 @@ public:
      */
     static bool isSimpleIdQuery(const BSONObj& query);
 
+    /**
+     * Returns true if "query" is an $in on _id whose values could each be used in an exact-match
+     * query on _id, such as {_id: {$in: [1, 2, 3]}}.
+     */
+    static bool isSimpleIdInQuery(const BSONObj& query);
+
     /**
      * Validates the match expression 'root' as well as the query specified by 'request', checking
      * for illegal combinations of operators. Returns a non-OK status if any such illegal
@@ -237,6 +255,28 @@ public:
         _explain = explain;
     }
 
+    /**
+     * The $lookup stages, in pipeline order, which must be applied to the results of this query
+     * by its execution plan. Only SBE plans support them, so they are cleared when the query is
+     * executed by the classic engine, in which case the caller must keep executing them as part of
+     * the pipeline.
+     */
+    const std::vector<EqLookupSpec>& getPipelineLookups() const {
+        return _pipelineLookups;
+    }
+
+    void setPipelineLookups(std::vector<EqLookupSpec> lookups) {
+        _pipelineLookups = std::move(lookups);
+    }
+
+    /**
+     * Maps the input parameter ids assigned to the constants of the filter to the predicates
+     * holding them. See 'expression::parameterize()'.
+     */
+    const std::vector<const MatchExpression*>& getInputParamIdToExpressionMap() const {
+        return _inputParamIdToExpressionMap;
+    }
+
     auto& getExpCtx() const {
         return _expCtx;
     }
@@ -280,6 +320,10 @@ private:
 
     // Determines whether the SBE engine is enabled.
     bool _enableSlotBasedExecutionEngine = false;
+
+    std::vector<EqLookupSpec> _pipelineLookups;
+
+    std::vector<const MatchExpression*> _inputParamIdToExpressionMap;
 };
 
 }  // namespace mongo
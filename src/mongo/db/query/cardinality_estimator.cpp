@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/cardinality_estimator.h"
+
+#include <algorithm>
+
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/query/index_bounds_builder.h"
+
+namespace mongo::cardinality_estimator {
+
+namespace {
+
+/**
+ * Returns true if 'expr' is a predicate whose matching values can be described by index bounds
+ * over a single ascending field.
+ */
+bool canEstimateLeaf(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return static_cast<const ComparisonMatchExpressionBase*>(expr)->getData().type() !=
+                BSONType::Array;
+        case MatchExpression::MATCH_IN: {
+            const auto& equalities = static_cast<const InMatchExpression*>(expr)->getEqualities();
+            return std::none_of(equalities.begin(), equalities.end(), [](auto&& elt) {
+                return elt.type() == BSONType::Array;
+            });
+        }
+        default:
+            return false;
+    }
+}
+
+double estimateLeafSelectivity(const CollectionStatistics& statistics,
+                               const MatchExpression* expr) {
+    if (!canEstimateLeaf(expr) || !statistics.getHistogram(expr->path())) {
+        return 1.0;
+    }
+
+    // Build the bounds that an ascending index over the predicate's path would scan.
+    const IndexEntry index(BSON(expr->path() << 1),
+                           IndexType::INDEX_BTREE,
+                           IndexDescriptor::kLatestIndexVersion,
+                           false,  // multikey
+                           {},
+                           {},
+                           false,  // sparse
+                           false,  // unique
+                           IndexEntry::Identifier{"cardinalityEstimate"},
+                           nullptr,  // filterExpr
+                           BSONObj(),
+                           nullptr,  // collator
+                           nullptr);
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr, index.keyPattern.firstElement(), index, &oil, &tightness);
+    return estimateSelectivity(statistics, expr->path(), oil).value_or(1.0);
+}
+
+}  // namespace
+
+boost::optional<double> estimateSelectivity(const CollectionStatistics& statistics,
+                                            StringData path,
+                                            const OrderedIntervalList& oil) {
+    const auto* histogram = statistics.getHistogram(path);
+    if (!histogram) {
+        return boost::none;
+    }
+    if (histogram->getTotalCount() <= 0) {
+        return 0.0;
+    }
+    return std::min(1.0, histogram->estimate(oil) / histogram->getTotalCount());
+}
+
+boost::optional<double> estimateSelectivity(const CollectionStatistics& statistics,
+                                            const IndexEntry& index,
+                                            const IndexBounds& bounds) {
+    // The keys of other index types, and of indexes with a collation, are not the field values
+    // the histograms are built over.
+    if (index.type != IndexType::INDEX_BTREE || index.collator || bounds.isSimpleRange) {
+        return boost::none;
+    }
+
+    double selectivity = 1.0;
+    for (auto&& oil : bounds.fields) {
+        if (oil.isMinToMax()) {
+            continue;
+        }
+        auto fieldSelectivity = estimateSelectivity(statistics, oil.name, oil);
+        if (!fieldSelectivity) {
+            return boost::none;
+        }
+        selectivity *= *fieldSelectivity;
+    }
+    return selectivity;
+}
+
+double estimateSelectivity(const CollectionStatistics& statistics, const MatchExpression* expr) {
+    if (!expr) {
+        return 1.0;
+    }
+
+    switch (expr->matchType()) {
+        case MatchExpression::AND: {
+            double selectivity = 1.0;
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                selectivity *= estimateSelectivity(statistics, expr->getChild(i));
+            }
+            return selectivity;
+        }
+        case MatchExpression::OR: {
+            double selectivity = 0.0;
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                selectivity += estimateSelectivity(statistics, expr->getChild(i));
+            }
+            return std::min(1.0, selectivity);
+        }
+        default:
+            return estimateLeafSelectivity(statistics, expr);
+    }
+}
+
+}  // namespace mongo::cardinality_estimator
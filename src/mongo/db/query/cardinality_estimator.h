@@ -0,0 +1,70 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/index_entry.h"
+
+/**
+ * Estimates how many documents or index keys a predicate or a set of index bounds selects, from the
+ * histograms gathered by the 'analyze' command. Estimates are returned as fractions of the
+ * analyzed values, so that they can be applied to the current size of the collection.
+ */
+namespace mongo::cardinality_estimator {
+
+/**
+ * Returns the estimated fraction of the values of 'path' that fall within 'oil', or boost::none if
+ * 'path' has not been analyzed.
+ */
+boost::optional<double> estimateSelectivity(const CollectionStatistics& statistics,
+                                            StringData path,
+                                            const OrderedIntervalList& oil);
+
+/**
+ * Returns the estimated fraction of the keys of 'index' that fall within 'bounds', treating the
+ * fields of the index as independent. Returns boost::none if a field is bounded more narrowly than
+ * [MinKey, MaxKey] but has not been analyzed, or if the index keys are not plain field values.
+ */
+boost::optional<double> estimateSelectivity(const CollectionStatistics& statistics,
+                                            const IndexEntry& index,
+                                            const IndexBounds& bounds);
+
+/**
+ * Returns the estimated fraction of documents matching 'expr', which may be nullptr. Predicates
+ * that cannot be estimated are assumed to match every document.
+ */
+double estimateSelectivity(const CollectionStatistics& statistics, const MatchExpression* expr);
+
+}  // namespace mongo::cardinality_estimator
@@ -62,11 +62,54 @@
 #include "mongo/db/exec/text_match.h"
 #include "mongo/db/exec/text_or.h"
 #include "mongo/db/index/fts_access_method.h"
+#include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/projection_ast_util.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_request_helper.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo::stage_builder {
+namespace {
+/**
+ * Returns the filter for a scan or fetch stage, with the children of its $ands ordered by cost
+ * when 'internalQueryClassicOrderFiltersByCost' is set.
+ */
+MatchExpression* orderFilterForEvaluation(MatchExpression* filter) {
+    if (filter && internalQueryClassicOrderFiltersByCost.load()) {
+        expression::orderAndChildrenByEvaluationCost(filter);
+    }
+    return filter;
+}
+
+/**
+ * Returns whether the collection scan 'csn' may start wherever the other synchronized scans of the
+ * collection currently are, instead of at the beginning of the collection. This is the case when
+ * 'internalQueryEnableSynchronizedCollectionScans' is set and nothing can depend on the order in
+ * which the records are returned.
+ */
+bool canSynchronizeCollectionScan(const CanonicalQuery& cq,
+                                  const CollectionPtr& collection,
+                                  const CollectionScanNode* csn) {
+    if (!internalQueryEnableSynchronizedCollectionScans.load()) {
+        return false;
+    }
+
+    // Natural order is expected from capped and clustered collections and from the internal
+    // databases, and is requested explicitly with a $natural hint.
+    if (!collection || collection->isCapped() || collection->isClustered() ||
+        collection->ns().isOnInternalDb() ||
+        cq.getFindCommandRequest().getHint()[query_request_helper::kNaturalSortField]) {
+        return false;
+    }
+
+    return csn->direction == 1 && !csn->tailable && !csn->minRecord && !csn->maxRecord &&
+        !csn->requestResumeToken && !csn->resumeAfterRecordId &&
+        !csn->shouldTrackLatestOplogTimestamp;
+}
+}  // namespace
+
 // Returns a non-null pointer to the root of a plan tree, or a non-OK status if the PlanStage tree
 // could not be constructed.
 std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* root) {
@@ -87,8 +130,10 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.requestResumeToken = csn->requestResumeToken;
             params.resumeAfterRecordId = csn->resumeAfterRecordId;
             params.stopApplyingFilterAfterFirstMatch = csn->stopApplyingFilterAfterFirstMatch;
+            params.synchronizeWithConcurrentScans =
+                canSynchronizeCollectionScan(_cq, _collection, csn);
             return std::make_unique<CollectionScan>(
-                expCtx, _collection, params, _ws, csn->filter.get());
+                expCtx, _collection, params, _ws, orderFilterForEvaluation(csn->filter.get()));
         }
         case STAGE_IXSCAN: {
             const IndexScanNode* ixn = static_cast<const IndexScanNode*>(root);
@@ -112,14 +157,20 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.direction = ixn->direction;
             params.addKeyMetadata = ixn->addKeyMetadata;
             params.shouldDedup = ixn->shouldDedup;
-            return std::make_unique<IndexScan>(
-                expCtx, _collection, std::move(params), _ws, ixn->filter.get());
+            return std::make_unique<IndexScan>(expCtx,
+                                               _collection,
+                                               std::move(params),
+                                               _ws,
+                                               orderFilterForEvaluation(ixn->filter.get()));
         }
         case STAGE_FETCH: {
             const FetchNode* fn = static_cast<const FetchNode*>(root);
             auto childStage = build(fn->children[0]);
-            return std::make_unique<FetchStage>(
-                expCtx, _ws, std::move(childStage), fn->filter.get(), _collection);
+            return std::make_unique<FetchStage>(expCtx,
+                                                _ws,
+                                                std::move(childStage),
+                                                orderFilterForEvaluation(fn->filter.get()),
+                                                _collection);
         }
         case STAGE_SORT_DEFAULT: {
             auto snDefault = static_cast<const SortNodeDefault*>(root);
@@ -181,10 +232,15 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         case STAGE_PROJECTION_SIMPLE: {
             auto pn = static_cast<const ProjectionNodeSimple*>(root);
             auto childStage = build(pn->children[0]);
+            // The planner may have replaced the query's projection with one over its top-level
+            // fields.
+            const bool isQueryProjection =
+                pn->proj.getRequiredFields() == _cq.getProj()->getRequiredFields();
             return std::make_unique<ProjectionStageSimple>(
                 _cq.getExpCtxRaw(),
-                _cq.getFindCommandRequest().getProjection(),
-                _cq.getProj(),
+                isQueryProjection ? _cq.getFindCommandRequest().getProjection()
+                                  : projection_ast::astToDebugBSON(pn->proj.root()),
+                &pn->proj,
                 _ws,
                 std::move(childStage));
         }
@@ -409,12 +465,15 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         case STAGE_CACHED_PLAN:
         case STAGE_COUNT:
         case STAGE_DELETE:
+        case STAGE_EQ_LOOKUP:
         case STAGE_IDHACK:
+        case STAGE_INDEX_FAST_COUNT:
         case STAGE_MOCK:
         case STAGE_MULTI_ITERATOR:
         case STAGE_MULTI_PLAN:
         case STAGE_QUEUED_DATA:
         case STAGE_RECORD_STORE_FAST_COUNT:
+        case STAGE_RESERVOIR_SAMPLE_FROM_TIMESERIES_BUCKET:
         case STAGE_SAMPLE_FROM_TIMESERIES_BUCKET:
         case STAGE_SUBPLAN:
         case STAGE_TRIAL:
@@ -35,6 +35,7 @@
 
 #include <unicode/coll.h>
 #include <unicode/sortkey.h>
+#include <unicode/ustring.h>
 
 #include "mongo/util/assert_util.h"
 
@@ -74,22 +75,53 @@ int CollatorInterfaceICU::compare(StringData left, StringData right) const {
 
 CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     StringData stringData) const {
-    // A StringPiece is ICU's StringData. They are logically the same abstraction.
-    const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
-
+    // Strings up to this many UTF-16 code units, and sort keys up to this many bytes, are built in
+    // buffers on the stack. This spares the allocations of an icu::UnicodeString and an
+    // icu::CollationKey for each of the many short strings which sorts and index builds see.
+    constexpr int32_t kStackBufferSize = 256;
+
+    // Convert to UTF-16 exactly as icu::UnicodeString::fromUTF8() does, with invalid subsequences
+    // replaced by U+FFFD. Any sequence of bytes, even invalid UTF-8, has defined comparison
+    // behavior in ICU.
+    UChar utf16Stack[kStackBufferSize];
+    const UChar* utf16 = utf16Stack;
+    int32_t utf16Length = 0;
+    icu::UnicodeString utf16Heap;
     UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    u_strFromUTF8WithSub(utf16Stack,
+                         kStackBufferSize,
+                         &utf16Length,
+                         stringData.rawData(),
+                         stringData.size(),
+                         0xfffd,
+                         nullptr,
+                         &status);
+    if (status == U_BUFFER_OVERFLOW_ERROR) {
+        // A StringPiece is ICU's StringData. They are logically the same abstraction.
+        utf16Heap = icu::UnicodeString::fromUTF8(
+            icu::StringPiece(stringData.rawData(), stringData.size()));
+        utf16 = utf16Heap.getBuffer();
+        utf16Length = utf16Heap.length();
+        status = U_ZERO_ERROR;
+    }
 
-    // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
-    // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
+    // A non-ok error code is only expected when a memory allocation fails inside ICU, which we
+    // consider fatal to the process.
     fassert(34439, U_SUCCESS(status));
 
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    // getSortKey() writes the same bytes as getCollationKey(), and returns the length of the whole
+    // key even when it does not fit.
+    uint8_t keyStack[kStackBufferSize];
+    int32_t keyLength = _collator->getSortKey(utf16, utf16Length, keyStack, kStackBufferSize);
+    fassert(6111400, keyLength > 0);
+    const uint8_t* keyBuffer = keyStack;
+    std::unique_ptr<uint8_t[]> keyHeap;
+    if (keyLength > kStackBufferSize) {
+        keyHeap = std::make_unique<uint8_t[]>(keyLength);
+        const auto written = _collator->getSortKey(utf16, utf16Length, keyHeap.get(), keyLength);
+        fassert(6111401, written == keyLength);
+        keyBuffer = keyHeap.get();
+    }
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
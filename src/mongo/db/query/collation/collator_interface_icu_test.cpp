@@ -594,4 +594,26 @@ TEST(CollatorInterfaceICUTest, ComparisonKeysForFrCaCollatorCorrect) {
               "\x2D\x45\x4F\x31\x01\x88\x44\x8E\x06\x01\x0A");
 }
 
+TEST(CollatorInterfaceICUTest, ComparisonKeysForLongStringsCorrect) {
+    // These strings are long enough that neither their UTF-16 form nor their sort keys fit in the
+    // stack buffers used by getComparisonKey().
+    const std::string longPrefix(1000, 'a');
+    assertLessThanEnUS(longPrefix + "b", longPrefix + "c");
+    assertLessThanEnUS(longPrefix + "c\xC3\xB4t\xC3\xA9", longPrefix + "c\xC3\xB4t\xC3\xA9s");
+    assertEqualEnUS(longPrefix + "\xEF\xBF\xBD", longPrefix + "\xFF");
+
+    Collation collationSpec;
+    collationSpec.setLocale("en_US");
+    UErrorCode status = U_ZERO_ERROR;
+    std::unique_ptr<icu::Collator> coll(
+        icu::Collator::createInstance(icu::Locale("en", "US"), status));
+    ASSERT(U_SUCCESS(status));
+    CollatorInterfaceICU icuCollator(collationSpec, std::move(coll));
+
+    // Each 'a' contributes one primary weight byte, followed by the level separator.
+    const auto key = icuCollator.getComparisonKey(longPrefix).getKeyData();
+    ASSERT_GT(key.size(), 1001U);
+    ASSERT_EQ(key.substr(0, 1001), std::string(1000, '\x29') + '\x01');
+}
+
 }  // namespace
@@ -80,7 +80,9 @@ CoreIndexInfo indexInfoFromIndexCatalogEntry(const IndexCatalogEntry& ice) {
 }  // namespace
 
 CollectionQueryInfo::CollectionQueryInfo()
-    : _keysComputed(false), _planCache(std::make_shared<PlanCache>()) {}
+    : _keysComputed(false),
+      _planCache(std::make_shared<PlanCache>()),
+      _statistics(std::make_shared<StatisticsHolder>()) {}
 
 const UpdateIndexData& CollectionQueryInfo::getIndexKeys(OperationContext* opCtx) const {
     invariant(_keysComputed);
@@ -210,6 +212,22 @@ PlanCache* CollectionQueryInfo::getPlanCache() const {
     return _planCache.get();
 }
 
+boost::optional<std::shared_ptr<const CollectionStatistics>> CollectionQueryInfo::getStatistics()
+    const {
+    stdx::lock_guard<Latch> lk(_statistics->mutex);
+    if (!_statistics->loaded) {
+        return boost::none;
+    }
+    return _statistics->statistics;
+}
+
+void CollectionQueryInfo::setStatistics(
+    std::shared_ptr<const CollectionStatistics> statistics) const {
+    stdx::lock_guard<Latch> lk(_statistics->mutex);
+    _statistics->loaded = true;
+    _statistics->statistics = std::move(statistics);
+}
+
 void CollectionQueryInfo::updatePlanCacheIndexEntries(OperationContext* opCtx,
                                                       const CollectionPtr& coll) {
     std::vector<CoreIndexInfo> indexCores;
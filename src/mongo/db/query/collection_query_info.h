@@ -30,9 +30,11 @@
 #pragma once
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/collection_statistics.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
@@ -62,6 +64,20 @@ public:
      */
     PlanCache* getPlanCache() const;
 
+    /**
+     * Returns the statistics gathered by the 'analyze' command for this collection, which may be
+     * null if the collection has not been analyzed, or boost::none if they have not been loaded
+     * from the statistics collection yet.
+     */
+    boost::optional<std::shared_ptr<const CollectionStatistics>> getStatistics() const;
+
+    /**
+     * Installs the statistics for this collection, as loaded from the statistics collection or
+     * freshly gathered by the 'analyze' command. A null 'statistics' records that the collection
+     * has not been analyzed.
+     */
+    void setStatistics(std::shared_ptr<const CollectionStatistics> statistics) const;
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
@@ -108,6 +124,16 @@ private:
 
     // A cache for query plans. Shared across cloned Collection instances.
     std::shared_ptr<PlanCache> _planCache;
+
+    struct StatisticsHolder {
+        Mutex mutex = MONGO_MAKE_LATCH("CollectionQueryInfo::StatisticsHolder::mutex");
+        bool loaded = false;
+        std::shared_ptr<const CollectionStatistics> statistics;
+    };
+
+    // The statistics used by the cost model, loaded lazily on first use. Shared across cloned
+    // Collection instances.
+    std::shared_ptr<StatisticsHolder> _statistics;
 };
 
 }  // namespace mongo
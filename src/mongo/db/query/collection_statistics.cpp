@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/collection_statistics.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr auto kStatisticsCollectionName = "system.statistics"_sd;
+constexpr auto kNamespaceField = "ns"_sd;
+constexpr auto kFieldsField = "fields"_sd;
+constexpr auto kPathField = "path"_sd;
+constexpr auto kAnalyzedAtField = "analyzedAt"_sd;
+constexpr auto kHistogramField = "histogram"_sd;
+
+}  // namespace
+
+NamespaceString CollectionStatistics::getStatisticsNamespace(StringData dbName) {
+    return NamespaceString(dbName, kStatisticsCollectionName);
+}
+
+CollectionStatistics CollectionStatistics::parse(const BSONObj& obj) {
+    CollectionStatistics statistics;
+
+    auto fieldsElt = obj[kFieldsField];
+    uassert(6108106,
+            "Collection statistics field 'fields' must be an array",
+            fieldsElt.type() == Array);
+    for (auto&& fieldElt : fieldsElt.Obj()) {
+        uassert(6108107, "Collection statistics fields must be objects", fieldElt.type() == Object);
+        auto fieldObj = fieldElt.Obj();
+        auto path = fieldObj[kPathField];
+        uassert(6108108,
+                "Collection statistics field is missing its path",
+                path.type() == String && !path.valueStringData().empty());
+        auto histogram = fieldObj[kHistogramField];
+        uassert(6108109,
+                "Collection statistics field is missing its histogram",
+                histogram.type() == Object);
+
+        auto analyzedAt = fieldObj[kAnalyzedAtField];
+        uassert(6108110,
+                "Collection statistics field is missing the date it was analyzed",
+                analyzedAt.type() == Date);
+
+        FieldStatistics fieldStatistics{EquiDepthHistogram::parse(histogram.Obj()),
+                                        analyzedAt.date()};
+        statistics.fields[path.str()] = std::move(fieldStatistics);
+    }
+    return statistics;
+}
+
+BSONObj CollectionStatistics::toBSON(const UUID& uuid, const NamespaceString& nss) const {
+    BSONObjBuilder bob;
+    uuid.appendToBuilder(&bob, "_id");
+    bob.append(kNamespaceField, nss.ns());
+    BSONArrayBuilder fieldsBuilder(bob.subarrayStart(kFieldsField));
+    for (auto&& [path, fieldStatistics] : fields) {
+        BSONObjBuilder fieldBuilder(fieldsBuilder.subobjStart());
+        fieldBuilder.append(kPathField, path);
+        fieldBuilder.append(kAnalyzedAtField, fieldStatistics.analyzedAt);
+        fieldBuilder.append(kHistogramField, fieldStatistics.histogram.toBSON());
+    }
+    fieldsBuilder.doneFast();
+    return bob.obj();
+}
+
+const EquiDepthHistogram* CollectionStatistics::getHistogram(StringData path) const {
+    auto it = fields.find(path.toString());
+    return it == fields.end() ? nullptr : &it->second.histogram;
+}
+
+}  // namespace mongo
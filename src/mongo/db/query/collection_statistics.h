@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/histogram.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+/**
+ * The statistics gathered over a collection by the 'analyze' command, with a histogram for each
+ * field path that has been analyzed. They are persisted in the 'system.statistics' collection of
+ * the collection's database, in one document per collection keyed by the collection's UUID.
+ */
+struct CollectionStatistics {
+    struct FieldStatistics {
+        EquiDepthHistogram histogram;
+        Date_t analyzedAt;
+    };
+
+    /**
+     * Returns the namespace which holds the statistics of the collections in database 'dbName'.
+     */
+    static NamespaceString getStatisticsNamespace(StringData dbName);
+
+    /**
+     * Parses a document of the 'system.statistics' collection. Throws if 'obj' is malformed.
+     */
+    static CollectionStatistics parse(const BSONObj& obj);
+
+    BSONObj toBSON(const UUID& uuid, const NamespaceString& nss) const;
+
+    /**
+     * Returns the histogram of 'path', or nullptr if the path has not been analyzed.
+     */
+    const EquiDepthHistogram* getHistogram(StringData path) const;
+
+    std::map<std::string, FieldStatistics> fields;
+};
+
+}  // namespace mongo
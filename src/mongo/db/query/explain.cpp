@@ -322,6 +322,12 @@ void Explain::explainPipeline(PlanExecutor* exec,
     out->appendElements(explainVersionToBson(explainer.getVersion()));
     *out << "stages" << Value(pipelineExec->writeExplainOps(verbosity));
 
+    if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+        PlanSummaryStats stats;
+        explainer.getSummaryStats(&stats);
+        *out << "peakMemoryUsageBytes" << stats.peakMemoryUsageBytes;
+    }
+
     explain_common::generateServerInfo(out);
     explain_common::generateServerParameters(out);
 
@@ -340,12 +346,18 @@ void Explain::explainStages(PlanExecutor* exec,
     const CollectionPtr* collectionPtr = &collection;
 
     // If we need execution stats, then run the plan in order to gather the stats.
+    std::shared_ptr<StorageStats> storageStats;
     if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+        // Fetching the storage statistics resets them, so that the ones fetched after execution
+        // only cover this plan.
+        auto recoveryUnit = exec->getOpCtx()->recoveryUnit();
+        recoveryUnit->getOperationStatistics();
         try {
             executePlan(exec);
         } catch (const DBException&) {
             executePlanStatus = exceptionToStatus();
         }
+        storageStats = recoveryUnit->getOperationStatistics();
 
         // If executing the query failed, for any number of reasons other than a planning failure,
         // then the collection may no longer be valid. We conservatively set our collection pointer
@@ -364,6 +376,12 @@ void Explain::explainStages(PlanExecutor* exec,
                   command,
                   out);
 
+    // Report how much data the storage engine had to read into its cache while executing the
+    // plan, e.g. the bytes read and time spent reading on cache misses.
+    if (storageStats) {
+        out->append("storageStats", storageStats->toBSON());
+    }
+
     explain_common::generateServerInfo(out);
     explain_common::generateServerParameters(out);
 }
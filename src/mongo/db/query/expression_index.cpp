@@ -36,6 +36,7 @@
 #include "mongo/db/geo/r2_region_coverer.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
+#include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/query/expression_index_knobs_gen.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
@@ -107,7 +108,14 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
-std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+namespace {
+struct S2CovererParams {
+    int minLevel;
+    int maxLevel;
+    int maxCells;
+};
+
+S2CovererParams getS2CovererParams() {
     auto minLevel = gInternalQueryS2GeoCoarsestLevel.load();
     auto maxLevel = gInternalQueryS2GeoFinestLevel.load();
 
@@ -115,20 +123,29 @@ std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& reg
     uassert(28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
     uassert(28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
 
+    return {minLevel, maxLevel, gInternalQueryS2GeoMaxCells.load()};
+}
+}  // namespace
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+    const auto params = getS2CovererParams();
+
     S2RegionCoverer coverer;
-    coverer.set_min_level(minLevel);
-    coverer.set_max_level(maxLevel);
-    coverer.set_max_cells(gInternalQueryS2GeoMaxCells.load());
+    coverer.set_min_level(params.minLevel);
+    coverer.set_max_level(params.maxLevel);
+    coverer.set_max_cells(params.maxCells);
 
     std::vector<S2CellId> cover;
     coverer.GetCovering(region, &cover);
     return cover;
 }
 
-void ExpressionMapping::cover2dsphere(const S2Region& region,
+void ExpressionMapping::cover2dsphere(const GeoExpression& geoExpr,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
-    std::vector<S2CellId> cover = get2dsphereCovering(region);
+    const auto params = getS2CovererParams();
+    std::vector<S2CellId> cover =
+        geoExpr.getS2Covering(params.minLevel, params.maxLevel, params.maxCells);
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
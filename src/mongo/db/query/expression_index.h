@@ -42,6 +42,8 @@ class S2Region;
 
 namespace mongo {
 
+class GeoExpression;
+
 /**
  * Functions that compute expression index mappings.
  *
@@ -75,7 +77,8 @@ public:
                                                 const S2IndexingParams& indexParams,
                                                 OrderedIntervalList* out);
 
-    static void cover2dsphere(const S2Region& region,
+    // Covers the geometry of 'geoExpr', reusing the covering that 'geoExpr' caches.
+    static void cover2dsphere(const GeoExpression& geoExpr,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
 };
@@ -166,6 +166,27 @@ void generateBatch(int ntoreturn,
                    PlanExecutor::ExecState* state) {
     PlanExecutor* exec = cursor->getExecutor();
 
+    // Results which a CursorPrefetcher produced ahead of time come first.
+    while (cursor->hasPrefetchedResults() &&
+           !FindCommon::enoughForGetMore(ntoreturn, *numResults)) {
+        const auto& next = cursor->frontPrefetchedResult();
+        if (!FindCommon::haveSpaceForNext(next, *numResults, bb->len())) {
+            break;
+        }
+        bb->appendBuf((void*)next.objdata(), next.objsize());
+        (*numResults)++;
+        docUnitsReturned->observeOne(next.objsize());
+        cursor->popPrefetchedResult();
+    }
+    if (cursor->hasPrefetchedResults()) {
+        *state = PlanExecutor::ADVANCED;
+        return;
+    }
+    if (cursor->prefetchReachedEOF()) {
+        *state = PlanExecutor::IS_EOF;
+        return;
+    }
+
     try {
         BSONObj obj;
         while (!FindCommon::enoughForGetMore(ntoreturn, *numResults) &&
@@ -512,7 +533,8 @@ Message getMore(OperationContext* opCtx,
     // the pin's destructor will be invoked, which will call release() on the pin.  Because our
     // ClientCursorPin is declared after our lock is declared, this will happen under the lock if
     // any locking was necessary.
-    if (!shouldSaveCursorGetMore(exec, cursorPin->isTailable())) {
+    if (!cursorPin->hasPrefetchedResults() &&
+        !shouldSaveCursorGetMore(exec, cursorPin->isTailable())) {
         // cc is now invalid, as is the executor
         cursorid = 0;
         curOp.debug().cursorExhausted = true;
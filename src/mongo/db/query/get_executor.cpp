@@ -39,14 +39,18 @@
 
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
+#include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/eof.h"
 #include "mongo/db/exec/idhack.h"
+#include "mongo/db/exec/index_fast_count.h"
 #include "mongo/db/exec/multi_plan.h"
+#include "mongo/db/exec/plan_cache_util.h"
 #include "mongo/db/exec/projection.h"
 #include "mongo/db/exec/projection_executor_utils.h"
 #include "mongo/db/exec/record_store_fast_count.h"
@@ -68,10 +72,12 @@
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/collection_statistics.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cost_model.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
@@ -86,6 +92,7 @@
 #include "mongo/db/query/query_settings_decoration.h"
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
+#include "mongo/db/query/sbe_plan_cache.h"
 #include "mongo/db/query/sbe_sub_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
 #include "mongo/db/query/util/make_data_structure.h"
@@ -100,7 +107,9 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/logv2/log.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -147,15 +156,89 @@ bool turnIxscanIntoCount(QuerySolution* soln);
 
 /**
  * Returns 'true' if 'query' on the given 'collection' can be answered using a special IDHACK plan.
+ * An $in on _id is only eligible when the query has no sort and no limit, since an IDHACK plan
+ * returns the documents in no particular order and never stops early.
  */
 bool isIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery& query) {
     const auto& findCommand = query.getFindCommandRequest();
+    const bool isIdQuery = CanonicalQuery::isSimpleIdQuery(findCommand.getFilter()) ||
+        (CanonicalQuery::isSimpleIdInQuery(findCommand.getFilter()) &&
+         findCommand.getSort().isEmpty() && !findCommand.getLimit() &&
+         !findCommand.getNtoreturn());
     return !findCommand.getShowRecordId() && findCommand.getHint().isEmpty() &&
         findCommand.getMin().isEmpty() && findCommand.getMax().isEmpty() &&
-        !findCommand.getSkip() && CanonicalQuery::isSimpleIdQuery(findCommand.getFilter()) &&
-        !findCommand.getTailable() &&
+        !findCommand.getSkip() && isIdQuery && !findCommand.getTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Returns the statistics gathered by the 'analyze' command for 'collection', loading them from the
+ * statistics collection on first use. Returns null if the collection has not been analyzed or its
+ * statistics cannot be read.
+ */
+std::shared_ptr<const CollectionStatistics> getCollectionStatistics(
+    OperationContext* opCtx, const CollectionPtr& collection) {
+    const auto& queryInfo = CollectionQueryInfo::get(collection);
+    if (auto statistics = queryInfo.getStatistics()) {
+        return *statistics;
+    }
+
+    const auto statsNss = CollectionStatistics::getStatisticsNamespace(collection->ns().db());
+    if (collection->ns() == statsNss) {
+        return nullptr;
+    }
+
+    std::shared_ptr<const CollectionStatistics> statistics;
+    try {
+        DBDirectClient client(opCtx);
+        auto obj = client.findOne(statsNss.ns(), BSON("_id" << collection->uuid()));
+        if (!obj.isEmpty()) {
+            statistics = std::make_shared<CollectionStatistics>(CollectionStatistics::parse(obj));
+        }
+    } catch (const DBException& ex) {
+        // Leave the statistics unloaded, so that the next query tries again.
+        LOGV2_DEBUG(6108111,
+                    2,
+                    "Failed to load collection statistics",
+                    "namespace"_attr = collection->ns(),
+                    "error"_attr = redact(ex.toStatus()));
+        return nullptr;
+    }
+    queryInfo.setStatistics(statistics);
+    return statistics;
+}
+
+/**
+ * Leaves out of 'solutions' the candidates which the cost model estimates to be clearly more
+ * expensive than the cheapest one, if 'collection' has been analyzed.
+ */
+void pruneSolutionsByCost(OperationContext* opCtx,
+                          const CollectionPtr& collection,
+                          const CanonicalQuery& cq,
+                          std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    if (solutions->size() < 2) {
+        return;
+    }
+
+    auto statistics = getCollectionStatistics(opCtx, collection);
+    if (!statistics) {
+        return;
+    }
+
+    const auto numSolutions = solutions->size();
+    plan_cost_model::pruneSolutions(*statistics,
+                                    collection->numRecords(opCtx),
+                                    internalQueryCostModelPruningRatio.load(),
+                                    solutions);
+    if (solutions->size() < numSolutions) {
+        LOGV2_DEBUG(6108112,
+                    2,
+                    "Cost model left candidate plans out of multi-planning",
+                    "query"_attr = redact(cq.toStringShort()),
+                    "numCandidates"_attr = numSolutions,
+                    "numPruned"_attr = numSolutions - solutions->size());
+    }
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -297,6 +380,27 @@ void fillOutPlannerParams(OperationContext* opCtx,
             indexEntryFromIndexCatalogEntry(opCtx, collection, *ice, canonicalQuery));
     }
 
+    // Gather the indices of the foreign collections of the pushed down $lookup stages, so that the
+    // planner can choose their join strategy.
+    for (auto&& lookup : canonicalQuery->getPipelineLookups()) {
+        auto foreignColl = CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(
+            opCtx, lookup.foreignCollection);
+        if (!foreignColl) {
+            continue;
+        }
+
+        auto& foreignIndices = plannerParams->foreignCollectionIndices[lookup.foreignCollection];
+        foreignIndices.clear();
+        auto foreignIt = foreignColl->getIndexCatalog()->getIndexIterator(opCtx, false);
+        while (foreignIt->more()) {
+            const IndexCatalogEntry* ice = foreignIt->next();
+            if (ice->descriptor()->hidden()) {
+                continue;
+            }
+            foreignIndices.push_back(indexEntryFromIndexCatalogEntry(opCtx, foreignColl, *ice));
+        }
+    }
+
     // If query supports index filters, filter params.indices by indices in query settings.
     // Ignore index filters when it is possible to use the id-hack.
     applyIndexFilters(collection, *canonicalQuery, plannerParams);
@@ -351,6 +455,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
 
+    if (internalQueryPlannerGenerateIndexSkipScans.load()) {
+        plannerParams->options |= QueryPlannerParams::GENERATE_INDEX_SKIP_SCANS;
+    }
+
     plannerParams->options |= QueryPlannerParams::SPLIT_LIMITED_SORT;
 
     if (shouldWaitForOplogVisibility(
@@ -602,6 +710,14 @@ public:
             if (auto result = buildIdHackPlan(idIndexDesc, &plannerParams)) {
                 return std::move(result);
             }
+        } else if (_collection->isClustered() && isIdHackEligibleQuery(_collection, *_cq)) {
+            if (auto result = buildClusteredIdHackPlan(plannerParams)) {
+                LOGV2_DEBUG(6101400,
+                            2,
+                            "Using clustered idhack",
+                            "canonicalQuery"_attr = redact(_cq->toStringShort()));
+                return std::move(result);
+            }
         }
 
         // Tailable: If the query requests tailable the collection must be capped.
@@ -621,15 +737,26 @@ public:
             CurOp::get(_opCtx)->debug().planCacheKey =
                 canonical_query_encoder::computeHash(planCacheKey.toString());
 
+            // The version must be read before the lookup, so that state derived from the entry is
+            // never tagged with a version newer than the entry itself.
+            const auto planCacheVersion =
+                CollectionQueryInfo::get(_collection).getPlanCache()->getVersion();
+
             // Try to look up a cached solution for the query.
             if (auto cs = CollectionQueryInfo::get(_collection)
                               .getPlanCache()
                               ->getCacheEntryIfActive(planCacheKey)) {
+                if (auto result = buildCachedPlanFromExecutionCache(
+                        planCacheKey, plannerParams, planCacheVersion, cs->decisionWorks)) {
+                    return std::move(result);
+                }
+
                 // We have a CachedSolution.  Have the planner turn it into a QuerySolution.
                 auto statusWithQs = QueryPlanner::planFromCache(*_cq, plannerParams, *cs);
 
                 if (statusWithQs.isOK()) {
-                    auto querySolution = std::move(statusWithQs.getValue());
+                    auto querySolution = QueryPlanner::extendWithEqLookups(
+                        *_cq, plannerParams, std::move(statusWithQs.getValue()));
                     if ((plannerParams.options & QueryPlannerParams::IS_COUNT) &&
                         turnIxscanIntoCount(querySolution.get())) {
                         LOGV2_DEBUG(20923,
@@ -664,6 +791,10 @@ public:
         // The planner should have returned an error status if there are no solutions.
         invariant(solutions.size() > 0);
 
+        for (auto&& solution : solutions) {
+            solution = QueryPlanner::extendWithEqLookups(*_cq, plannerParams, std::move(solution));
+        }
+
         // See if one of our solutions is a fast count hack in disguise.
         if (plannerParams.options & QueryPlannerParams::IS_COUNT) {
             for (size_t i = 0; i < solutions.size(); ++i) {
@@ -682,6 +813,12 @@ public:
             }
         }
 
+        plan_cache_util::removeSolutionsUsingLosingIndexes(_collection, *_cq, &solutions);
+
+        if (internalQueryPlannerUseCostModel.load()) {
+            pruneSolutionsByCost(_opCtx, _collection, *_cq, &solutions);
+        }
+
         if (1 == solutions.size()) {
             auto result = makeResult();
             // Only one possible plan. Run it. Build the stages from the solution.
@@ -722,6 +859,34 @@ protected:
     virtual std::unique_ptr<ResultType> buildIdHackPlan(const IndexDescriptor* descriptor,
                                                         QueryPlannerParams* plannerParams) = 0;
 
+    /**
+     * Collections clustered by _id have no _id index to run an IDHACK plan against. Their
+     * documents are keyed by _id instead, so a point query on _id is answered by a collection scan
+     * bounded to that single RecordId without running the planner. Returns nullptr if the bounds
+     * cannot be derived, e.g. for a string _id under a non-simple collation.
+     */
+    std::unique_ptr<ResultType> buildClusteredIdHackPlan(const QueryPlannerParams& plannerParams) {
+        invariant(plannerParams.allowRIDRange);
+        auto collScan =
+            QueryPlannerAccess::makeCollectionScan(*_cq, false /* tailable */, plannerParams);
+        const auto* csn = static_cast<const CollectionScanNode*>(collScan.get());
+        if (!csn->minRecord || !csn->maxRecord || *csn->minRecord != *csn->maxRecord) {
+            return nullptr;
+        }
+
+        auto solution =
+            QueryPlannerAnalysis::analyzeDataAccess(*_cq, plannerParams, std::move(collScan));
+        if (!solution) {
+            return nullptr;
+        }
+        solution = QueryPlanner::extendWithEqLookups(*_cq, plannerParams, std::move(solution));
+
+        auto result = makeResult();
+        auto root = buildExecutableTree(*solution);
+        result->emplace(std::move(root), std::move(solution));
+        return result;
+    }
+
     /**
      * Constructs a PlanStage tree from a cached plan and also:
      *     * Either modifies the constructed tree to run a trial period in order to evaluate the
@@ -734,6 +899,21 @@ protected:
                                                         const QueryPlannerParams& plannerParams,
                                                         size_t decisionWorks) = 0;
 
+    /**
+     * If supported, looks up the execution tree previously built for this exact query from the
+     * cached solution 'planCacheKey' and, when it is still current as of 'planCacheVersion',
+     * constructs the result from it without going through the planner and the stage builder.
+     * Otherwise, nullptr should be returned and this helper will fall back to building the tree
+     * from the cached solution.
+     */
+    virtual std::unique_ptr<ResultType> buildCachedPlanFromExecutionCache(
+        const PlanCacheKey& planCacheKey,
+        const QueryPlannerParams& plannerParams,
+        uint64_t planCacheVersion,
+        size_t decisionWorks) {
+        return nullptr;
+    }
+
     /**
      * Constructs a special PlanStage tree for rooted $or queries. Each clause of the $or is planned
      * individually, and then an overall query plan is created based on the winning plan from each
@@ -942,10 +1122,20 @@ protected:
             auto ixScan = std::make_unique<IndexScanNode>(
                 indexEntryFromIndexCatalogEntry(_opCtx, _collection, *descriptor->getEntry(), _cq));
 
-            const auto bsonKey =
-                IndexBoundsBuilder::objFromElement(_cq->getQueryObj()["_id"], _cq->getCollator());
             OrderedIntervalList oil("_id");
-            oil.intervals.push_back(IndexBoundsBuilder::makePointInterval(bsonKey));
+            const auto& queryObj = _cq->getQueryObj();
+            if (CanonicalQuery::isSimpleIdInQuery(queryObj)) {
+                // Scan the point intervals of all of the values of the $in in index order.
+                for (auto&& elt : queryObj["_id"]["$in"].Obj()) {
+                    oil.intervals.push_back(IndexBoundsBuilder::makePointInterval(
+                        IndexBoundsBuilder::objFromElement(elt, _cq->getCollator())));
+                }
+                IndexBoundsBuilder::unionize(&oil);
+            } else {
+                const auto bsonKey =
+                    IndexBoundsBuilder::objFromElement(queryObj["_id"], _cq->getCollator());
+                oil.intervals.push_back(IndexBoundsBuilder::makePointInterval(bsonKey));
+            }
 
             ixScan->bounds.fields.push_back(std::move(oil));
             ixScan->queryCollator = _cq->getCollator();
@@ -977,6 +1167,7 @@ protected:
 
         auto soln = std::make_unique<QuerySolution>();
         soln->setRoot(std::move(root));
+        soln = QueryPlanner::extendWithEqLookups(*_cq, *plannerParams, std::move(soln));
 
         auto execTree = buildExecutableTree(*soln);
         auto result = makeResult();
@@ -991,11 +1182,47 @@ protected:
         size_t decisionWorks) final {
         auto result = makeResult();
         auto execTree = buildExecutableTree(*solution);
+        if (_executionCacheKey) {
+            sbe::PlanCache::get(_opCtx->getServiceContext())
+                .set(*_executionCacheKey,
+                     *execTree.first,
+                     execTree.second,
+                     *solution,
+                     _planCacheVersion);
+        }
         result->emplace(std::move(execTree), std::move(solution));
         result->setDecisionWorks(decisionWorks);
         return result;
     }
 
+    std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlanFromExecutionCache(
+        const PlanCacheKey& planCacheKey,
+        const QueryPlannerParams& plannerParams,
+        uint64_t planCacheVersion,
+        size_t decisionWorks) final {
+        if (!sbe::PlanCache::shouldCacheQuery(*_cq, plannerParams.options)) {
+            return nullptr;
+        }
+
+        auto key = sbe::PlanCache::computeKey(
+            _collection, *_cq, planCacheKey, plannerParams.options);
+        auto cachedPlan = sbe::PlanCache::get(_opCtx->getServiceContext())
+                              .get(_opCtx, *_cq, key, planCacheVersion, _yieldPolicy);
+        if (!cachedPlan) {
+            // Remember where to put the tree built by 'buildCachedPlan()'.
+            _executionCacheKey = std::move(key);
+            _planCacheVersion = planCacheVersion;
+            return nullptr;
+        }
+
+        // Even though the tree is reused, the trial period still has to run, as the cached
+        // solution may have become inefficient for the current data.
+        auto result = makeResult();
+        result->emplace(std::move(cachedPlan->root), std::move(cachedPlan->solution));
+        result->setDecisionWorks(decisionWorks);
+        return result;
+    }
+
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildSubPlan(
         const QueryPlannerParams& plannerParams) final {
         // Nothing do be done here, all planning and stage building will be done by a SubPlanner.
@@ -1018,6 +1245,12 @@ protected:
         }
         return result;
     }
+
+private:
+    // Key and plan cache version under which the tree built from a cached solution should be
+    // stored in the sbe::PlanCache, if the query is eligible.
+    boost::optional<std::string> _executionCacheKey;
+    uint64_t _planCacheVersion{0};
 };
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getClassicExecutor(
@@ -1203,12 +1436,21 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutor(
     std::unique_ptr<CanonicalQuery> canonicalQuery,
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     size_t plannerOptions) {
-    return canonicalQuery->getEnableSlotBasedExecutionEngine() &&
-            isQuerySbeCompatible(opCtx, canonicalQuery.get(), plannerOptions)
-        ? getSlotBasedExecutor(
-              opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions)
-        : getClassicExecutor(
-              opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions);
+    Timer planningTimer;
+    ON_BLOCK_EXIT([&] {
+        CurOp::get(opCtx)->debug().planningTime += Microseconds(planningTimer.micros());
+    });
+
+    if (canonicalQuery->getEnableSlotBasedExecutionEngine() &&
+        isQuerySbeCompatible(opCtx, canonicalQuery.get(), plannerOptions)) {
+        return getSlotBasedExecutor(
+            opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions);
+    }
+
+    // Only SBE plans can execute the pushed down $lookup stages, leave them to the pipeline.
+    canonicalQuery->setPipelineLookups({});
+    return getClassicExecutor(
+        opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions);
 }
 
 //
@@ -1346,6 +1588,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
     deleteStageParams->sort = request->getSort();
     deleteStageParams->opDebug = opDebug;
     deleteStageParams->stmtId = request->getStmtId();
+    deleteStageParams->writeBatchSize = internalQueryDeleteManyWriteBatchSize.load();
 
     std::unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
     const auto policy = parsedDelete->yieldPolicy();
@@ -1856,6 +2099,41 @@ bool getDistinctNodeIndex(const std::vector<IndexEntry>& indices,
     return minFields != std::numeric_limits<int>::max();
 }
 
+/**
+ * Returns a ready partial index whose filter is equivalent to the query of 'cq' and which holds
+ * exactly one key for each document the query matches, if the storage engine maintains the number
+ * of keys in the index. Returns nullptr if there is no such index.
+ */
+const IndexDescriptor* getIndexForFastCount(OperationContext* opCtx,
+                                            const CollectionPtr& collection,
+                                            const CanonicalQuery& cq) {
+    auto it = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (it->more()) {
+        const IndexCatalogEntry* entry = it->next();
+        const IndexDescriptor* desc = entry->descriptor();
+        if (!desc->isPartial() || desc->isSparse() || desc->hidden()) {
+            continue;
+        }
+        // Other index types may generate no key, or several keys, for a single document.
+        switch (desc->getIndexType()) {
+            case IndexType::INDEX_BTREE:
+            case IndexType::INDEX_HASHED:
+                break;
+            default:
+                continue;
+        }
+        if (entry->isMultikey(opCtx, collection) ||
+            !CollatorInterface::collatorsMatch(entry->getCollator(), cq.getCollator()) ||
+            !entry->getFilterExpression()->equivalent(cq.root())) {
+            continue;
+        }
+        if (entry->accessMethod()->getSortedDataInterface()->fastKeyCount(opCtx)) {
+            return desc;
+        }
+    }
+    return nullptr;
+}
+
 }  // namespace
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorCount(
@@ -1933,6 +2211,23 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorCoun
                                            nss);
     }
 
+    // If the query is the filter of a partial index, the storage engine may be able to tell us
+    // how many documents match it.
+    if (!isEmptyQueryPredicate && request.getHint().isEmpty() &&
+        internalQueryCountUsingPartialIndexKeyCounts.load()) {
+        if (auto desc = getIndexForFastCount(opCtx, collection, *cq)) {
+            std::unique_ptr<PlanStage> root = std::make_unique<IndexFastCountStage>(
+                expCtx.get(), collection, desc, ws.get(), skip, limit);
+            return plan_executor_factory::make(expCtx,
+                                               std::move(ws),
+                                               std::move(root),
+                                               &CollectionPtr::null,
+                                               yieldPolicy,
+                                               false, /* whether we must returned owned BSON */
+                                               nss);
+        }
+    }
+
     size_t plannerOptions = QueryPlannerParams::IS_COUNT;
     if (OperationShardingState::isOperationVersioned(opCtx)) {
         plannerOptions |= QueryPlannerParams::INCLUDE_SHARD_FILTER;
@@ -0,0 +1,235 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr auto kMinField = "min"_sd;
+constexpr auto kTotalCountField = "totalCount"_sd;
+constexpr auto kBucketsField = "buckets"_sd;
+constexpr auto kUpperField = "upper"_sd;
+constexpr auto kEqualField = "equal"_sd;
+constexpr auto kRangeField = "range"_sd;
+constexpr auto kDistinctField = "distinct"_sd;
+
+BSONObj wrapValue(const BSONElement& value) {
+    BSONObjBuilder bob;
+    bob.appendAs(value, "");
+    return bob.obj();
+}
+
+double parseCount(const BSONObj& obj, StringData fieldName) {
+    auto elt = obj[fieldName];
+    uassert(6108100,
+            str::stream() << "Histogram field '" << fieldName << "' must be a non-negative number",
+            elt.isNumber() && elt.numberDouble() >= 0);
+    return elt.numberDouble();
+}
+
+/**
+ * Returns the position of 'value' between 'lower' and 'upper' as a fraction, interpolated when all
+ * three are numbers and assumed to be the middle otherwise.
+ */
+double rangeFraction(const BSONElement& lower, const BSONElement& upper, const BSONElement& value) {
+    if (!lower.isNumber() || !upper.isNumber() || !value.isNumber()) {
+        return 0.5;
+    }
+    const double width = upper.numberDouble() - lower.numberDouble();
+    if (!(width > 0)) {
+        return 0.5;
+    }
+    const double fraction = (value.numberDouble() - lower.numberDouble()) / width;
+    return std::isnan(fraction) ? 0.5 : std::min(1.0, std::max(0.0, fraction));
+}
+
+}  // namespace
+
+EquiDepthHistogram EquiDepthHistogram::build(const std::vector<BSONObj>& sortedValues,
+                                             size_t maxBuckets,
+                                             double scale) {
+    invariant(maxBuckets > 0);
+    EquiDepthHistogram histogram;
+    if (sortedValues.empty()) {
+        return histogram;
+    }
+
+    histogram._min = sortedValues.front().getOwned();
+    histogram._totalCount = sortedValues.size() * scale;
+
+    // Values equal to one another always end up in the same bucket, so a bucket may hold more
+    // than its share when a value is frequent.
+    const size_t valuesPerBucket = (sortedValues.size() + maxBuckets - 1) / maxBuckets;
+    size_t rangeCount = 0;
+    size_t rangeDistinct = 0;
+    for (size_t runStart = 0; runStart < sortedValues.size();) {
+        const auto value = sortedValues[runStart].firstElement();
+        size_t runEnd = runStart + 1;
+        while (runEnd < sortedValues.size() &&
+               value.woCompare(sortedValues[runEnd].firstElement(), false) == 0) {
+            ++runEnd;
+        }
+        const size_t runLength = runEnd - runStart;
+
+        if (rangeCount + runLength >= valuesPerBucket || runEnd == sortedValues.size()) {
+            Bucket bucket;
+            bucket.upperBound = sortedValues[runStart].getOwned();
+            bucket.equalCount = runLength * scale;
+            bucket.rangeCount = rangeCount * scale;
+            bucket.rangeDistinct = rangeDistinct;
+            histogram._buckets.push_back(std::move(bucket));
+            rangeCount = 0;
+            rangeDistinct = 0;
+        } else {
+            rangeCount += runLength;
+            ++rangeDistinct;
+        }
+        runStart = runEnd;
+    }
+
+    return histogram;
+}
+
+EquiDepthHistogram EquiDepthHistogram::parse(const BSONObj& obj) {
+    EquiDepthHistogram histogram;
+    histogram._totalCount = parseCount(obj, kTotalCountField);
+
+    auto bucketsElt = obj[kBucketsField];
+    uassert(6108101, "Histogram field 'buckets' must be an array", bucketsElt.type() == Array);
+    for (auto&& bucketElt : bucketsElt.Obj()) {
+        uassert(6108102, "Histogram buckets must be objects", bucketElt.type() == Object);
+        auto bucketObj = bucketElt.Obj();
+        auto upper = bucketObj[kUpperField];
+        uassert(6108103, "Histogram bucket is missing its upper bound", !upper.eoo());
+
+        Bucket bucket;
+        bucket.upperBound = wrapValue(upper);
+        bucket.equalCount = parseCount(bucketObj, kEqualField);
+        bucket.rangeCount = parseCount(bucketObj, kRangeField);
+        bucket.rangeDistinct = parseCount(bucketObj, kDistinctField);
+        uassert(6108104,
+                "Histogram buckets must be in ascending order",
+                histogram._buckets.empty() ||
+                    histogram._buckets.back().upper().woCompare(bucket.upper(), false) < 0);
+        histogram._buckets.push_back(std::move(bucket));
+    }
+
+    auto min = obj[kMinField];
+    uassert(6108105,
+            "Histogram with buckets is missing its smallest value",
+            histogram._buckets.empty() || !min.eoo());
+    if (!min.eoo()) {
+        histogram._min = wrapValue(min);
+    }
+    return histogram;
+}
+
+BSONObj EquiDepthHistogram::toBSON() const {
+    BSONObjBuilder bob;
+    if (!_min.isEmpty()) {
+        bob.appendAs(_min.firstElement(), kMinField);
+    }
+    bob.append(kTotalCountField, _totalCount);
+    BSONArrayBuilder buckets(bob.subarrayStart(kBucketsField));
+    for (auto&& bucket : _buckets) {
+        BSONObjBuilder bucketBuilder(buckets.subobjStart());
+        bucketBuilder.appendAs(bucket.upper(), kUpperField);
+        bucketBuilder.append(kEqualField, bucket.equalCount);
+        bucketBuilder.append(kRangeField, bucket.rangeCount);
+        bucketBuilder.append(kDistinctField, bucket.rangeDistinct);
+    }
+    buckets.doneFast();
+    return bob.obj();
+}
+
+double EquiDepthHistogram::_countBelow(const BSONElement& value, bool inclusive) const {
+    double below = 0;
+    BSONElement lower = _min.firstElement();
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+        const auto& bucket = _buckets[i];
+        const int cmp = value.woCompare(bucket.upper(), false);
+        if (cmp > 0) {
+            below += bucket.rangeCount + bucket.equalCount;
+            lower = bucket.upper();
+            continue;
+        }
+        if (cmp == 0) {
+            return below + bucket.rangeCount + (inclusive ? bucket.equalCount : 0);
+        }
+
+        // The value falls within the range of this bucket. Only the first bucket's range includes
+        // its lower bound, which is the smallest value.
+        const int cmpLower = value.woCompare(lower, false);
+        if (cmpLower < 0 || (cmpLower == 0 && i > 0) || bucket.rangeCount == 0) {
+            return below;
+        }
+        const double averageFrequency = bucket.rangeCount / std::max(bucket.rangeDistinct, 1.0);
+        if (cmpLower == 0) {
+            return below + (inclusive ? std::min(averageFrequency, bucket.rangeCount) : 0);
+        }
+        const double inRange = rangeFraction(lower, bucket.upper(), value) * bucket.rangeCount +
+            (inclusive ? averageFrequency : 0);
+        return below + std::min(inRange, bucket.rangeCount);
+    }
+    return below;
+}
+
+double EquiDepthHistogram::estimate(const Interval& interval) const {
+    if (_buckets.empty()) {
+        return 0;
+    }
+
+    const bool descending = interval.start.woCompare(interval.end, false) > 0;
+    const auto& start = descending ? interval.end : interval.start;
+    const auto& end = descending ? interval.start : interval.end;
+    const bool startInclusive = descending ? interval.endInclusive : interval.startInclusive;
+    const bool endInclusive = descending ? interval.startInclusive : interval.endInclusive;
+
+    return std::max(0.0, _countBelow(end, endInclusive) - _countBelow(start, !startInclusive));
+}
+
+double EquiDepthHistogram::estimate(const OrderedIntervalList& oil) const {
+    double count = 0;
+    for (auto&& interval : oil.intervals) {
+        count += estimate(interval);
+    }
+    return std::min(count, _totalCount);
+}
+
+}  // namespace mongo
@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/interval.h"
+
+namespace mongo {
+
+/**
+ * An equi-depth histogram over the values of one field, as gathered by the 'analyze' command. The
+ * buckets hold about the same number of values each. A bucket records its upper bound and how
+ * many values are equal to it, and how many values, and how many distinct ones, fall strictly
+ * between the previous bucket's upper bound and its own. Values are ordered the way index keys
+ * are, so that estimates can be made directly over index bounds.
+ */
+class EquiDepthHistogram {
+public:
+    struct Bucket {
+        BSONElement upper() const {
+            return upperBound.firstElement();
+        }
+
+        // Holds the upper bound as its only element.
+        BSONObj upperBound;
+        double equalCount = 0;
+        double rangeCount = 0;
+        double rangeDistinct = 0;
+    };
+
+    /**
+     * Builds a histogram of at most 'maxBuckets' buckets over 'sortedValues', which must be sorted
+     * in ascending order and hold each value as their only element. Every count is multiplied by
+     * 'scale', so that a sample can stand for a whole collection.
+     */
+    static EquiDepthHistogram build(const std::vector<BSONObj>& sortedValues,
+                                    size_t maxBuckets,
+                                    double scale = 1.0);
+
+    /**
+     * Parses a histogram serialized by toBSON(). Throws if 'obj' is malformed.
+     */
+    static EquiDepthHistogram parse(const BSONObj& obj);
+
+    BSONObj toBSON() const;
+
+    const std::vector<Bucket>& getBuckets() const {
+        return _buckets;
+    }
+
+    double getTotalCount() const {
+        return _totalCount;
+    }
+
+    /**
+     * Returns the estimated number of values within 'interval', which may be in either direction.
+     */
+    double estimate(const Interval& interval) const;
+
+    /**
+     * Returns the estimated number of values within any of the intervals of 'oil'.
+     */
+    double estimate(const OrderedIntervalList& oil) const;
+
+private:
+    /**
+     * Returns the estimated number of values less than 'value', or at most 'value' if
+     * 'inclusive' is true.
+     */
+    double _countBelow(const BSONElement& value, bool inclusive) const;
+
+    // Holds the smallest value as its only element.
+    BSONObj _min;
+    std::vector<Bucket> _buckets;
+    double _totalCount = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,162 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::vector<BSONObj> makeValues(int begin, int end) {
+    std::vector<BSONObj> values;
+    for (int i = begin; i < end; ++i) {
+        values.push_back(BSON("" << i));
+    }
+    return values;
+}
+
+double estimate(const EquiDepthHistogram& histogram,
+                const BSONObj& bounds,
+                bool startInclusive,
+                bool endInclusive) {
+    return histogram.estimate(Interval(bounds, startInclusive, endInclusive));
+}
+
+TEST(EquiDepthHistogramTest, BuildsBucketsOfEqualDepth) {
+    auto histogram = EquiDepthHistogram::build(makeValues(1, 101), 10);
+    ASSERT_EQ(histogram.getTotalCount(), 100);
+    ASSERT_EQ(histogram.getBuckets().size(), 10U);
+    for (size_t i = 0; i < histogram.getBuckets().size(); ++i) {
+        const auto& bucket = histogram.getBuckets()[i];
+        ASSERT_EQ(bucket.upper().numberInt(), static_cast<int>(10 * (i + 1)));
+        ASSERT_EQ(bucket.equalCount, 1);
+        ASSERT_EQ(bucket.rangeCount, 9);
+        ASSERT_EQ(bucket.rangeDistinct, 9);
+    }
+}
+
+TEST(EquiDepthHistogramTest, EmptyHistogramEstimatesNothing) {
+    auto histogram = EquiDepthHistogram::build({}, 10);
+    ASSERT_EQ(histogram.getTotalCount(), 0);
+    ASSERT_EQ(estimate(histogram, BSON("" << MINKEY << "" << MAXKEY), true, true), 0);
+}
+
+TEST(EquiDepthHistogramTest, EstimatesPoints) {
+    auto histogram = EquiDepthHistogram::build(makeValues(1, 101), 10);
+    // On a bucket boundary.
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 50 << "" << 50), true, true), 1, 1e-9);
+    // Within a bucket.
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 55 << "" << 55), true, true), 1, 1e-9);
+    // Outside of the histogram.
+    ASSERT_EQ(estimate(histogram, BSON("" << 500 << "" << 500), true, true), 0);
+    ASSERT_EQ(estimate(histogram, BSON("" << -5 << "" << -5), true, true), 0);
+}
+
+TEST(EquiDepthHistogramTest, EstimatesRanges) {
+    auto histogram = EquiDepthHistogram::build(makeValues(1, 101), 10);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 1 << "" << 100), true, true), 100, 1e-9);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 20 << "" << 40), true, false), 20, 1e-9);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 20 << "" << 40), false, true), 20, 1e-9);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 25 << "" << 65), true, false), 40, 1);
+    ASSERT_APPROX_EQUAL(
+        estimate(histogram, BSON("" << MINKEY << "" << MAXKEY), true, true), 100, 1e-9);
+}
+
+TEST(EquiDepthHistogramTest, EstimatesDescendingIntervals) {
+    auto histogram = EquiDepthHistogram::build(makeValues(1, 101), 10);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 40 << "" << 20), false, true), 20, 1e-9);
+}
+
+TEST(EquiDepthHistogramTest, FrequentValueFillsItsOwnBucket) {
+    auto values = makeValues(1, 11);
+    values.insert(values.begin(), 90, BSON("" << 0));
+    auto histogram = EquiDepthHistogram::build(values, 10);
+    ASSERT_EQ(histogram.getBuckets().size(), 2U);
+    ASSERT_EQ(histogram.getBuckets()[0].equalCount, 90);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 0 << "" << 0), true, true), 90, 1e-9);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 0 << "" << 10), false, true), 10, 1e-9);
+}
+
+TEST(EquiDepthHistogramTest, ScalesCounts) {
+    auto histogram = EquiDepthHistogram::build(makeValues(1, 101), 10, 10.0);
+    ASSERT_EQ(histogram.getTotalCount(), 1000);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << 50 << "" << 50), true, true), 10, 1e-9);
+}
+
+TEST(EquiDepthHistogramTest, EstimatesNonNumericValues) {
+    std::vector<BSONObj> values;
+    for (char c = 'a'; c <= 'z'; ++c) {
+        values.push_back(BSON("" << std::string(1, c)));
+    }
+    auto histogram = EquiDepthHistogram::build(values, 5);
+    ASSERT_APPROX_EQUAL(estimate(histogram, BSON("" << "a" << "" << "z"), true, true), 26, 1e-9);
+    ASSERT_EQ(estimate(histogram, BSON("" << 1 << "" << 100), true, true), 0);
+}
+
+TEST(EquiDepthHistogramTest, EstimatesOrderedIntervalLists) {
+    auto histogram = EquiDepthHistogram::build(makeValues(1, 101), 10);
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(Interval(BSON("" << 10 << "" << 10), true, true));
+    oil.intervals.push_back(Interval(BSON("" << 20 << "" << 30), true, true));
+    ASSERT_APPROX_EQUAL(histogram.estimate(oil), 12, 1e-9);
+}
+
+TEST(EquiDepthHistogramTest, RoundTripsThroughBSON) {
+    auto histogram = EquiDepthHistogram::build(makeValues(1, 101), 10);
+    auto parsed = EquiDepthHistogram::parse(histogram.toBSON());
+    ASSERT_BSONOBJ_EQ(parsed.toBSON(), histogram.toBSON());
+    ASSERT_EQ(estimate(parsed, BSON("" << 25 << "" << 65), true, false),
+              estimate(histogram, BSON("" << 25 << "" << 65), true, false));
+}
+
+TEST(EquiDepthHistogramTest, ParseRejectsMalformedHistograms) {
+    ASSERT_THROWS_CODE(EquiDepthHistogram::parse(BSON("totalCount" << -1 << "buckets"
+                                                                   << BSONArray())),
+                       DBException,
+                       6108100);
+    ASSERT_THROWS_CODE(
+        EquiDepthHistogram::parse(BSON("totalCount" << 1 << "buckets" << 1)), DBException, 6108101);
+    const auto bucket1 = BSON("upper" << 1 << "equal" << 1 << "range" << 0 << "distinct" << 0);
+    const auto bucket2 = BSON("upper" << 2 << "equal" << 1 << "range" << 0 << "distinct" << 0);
+    ASSERT_THROWS_CODE(EquiDepthHistogram::parse(BSON("min" << 1 << "totalCount" << 2 << "buckets"
+                                                            << BSON_ARRAY(bucket2 << bucket1))),
+                       DBException,
+                       6108104);
+    ASSERT_THROWS_CODE(
+        EquiDepthHistogram::parse(BSON("totalCount" << 1 << "buckets" << BSON_ARRAY(bucket1))),
+        DBException,
+        6108105);
+}
+
+}  // namespace
+}  // namespace mongo
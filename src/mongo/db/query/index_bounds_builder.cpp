@@ -352,6 +352,40 @@ void IndexBoundsBuilder::translateAndUnion(const MatchExpression* expr,
     unionize(oilOut);
 }
 
+IndexBoundsBuilder::BoundsBuildingStep::BoundsBuildingStep(Kind kind,
+                                                           const MatchExpression* expr,
+                                                           BoundsTightness tightness)
+    : kind(kind), expr(expr->shallowClone()), tightness(tightness) {}
+
+IndexBoundsBuilder::BoundsBuildingStep IndexBoundsBuilder::BoundsBuildingStep::clone() const {
+    return {kind, expr.get(), tightness};
+}
+
+bool IndexBoundsBuilder::replayBoundsBuildingSteps(const std::vector<BoundsBuildingStep>& steps,
+                                                   const BSONElement& elt,
+                                                   const IndexEntry& index,
+                                                   OrderedIntervalList* oilOut) {
+    *oilOut = OrderedIntervalList{};
+    for (auto&& step : steps) {
+        BoundsTightness tightness;
+        switch (step.kind) {
+            case BoundsBuildingStep::Kind::kTranslate:
+                translate(step.expr.get(), elt, index, oilOut, &tightness);
+                break;
+            case BoundsBuildingStep::Kind::kIntersect:
+                translateAndIntersect(step.expr.get(), elt, index, oilOut, &tightness);
+                break;
+            case BoundsBuildingStep::Kind::kUnion:
+                translateAndUnion(step.expr.get(), elt, index, oilOut, &tightness);
+                break;
+        }
+        if (tightness != step.tightness) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool typeMatch(const BSONObj& obj) {
     BSONObjIterator it(obj);
     verify(it.more());
@@ -954,6 +988,7 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
 
         IndexBoundsBuilder::BoundsTightness tightness;
         bool arrayOrNullPresent = false;
+        oilOut->intervals.reserve(ime->getEqualities().size());
         for (auto&& equality : ime->getEqualities()) {
             translateEquality(equality, index, isHashed, oilOut, &tightness);
             // The ordering invariant of oil has been violated by the call to translateEquality.
@@ -996,10 +1031,9 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
         const GeoMatchExpression* gme = static_cast<const GeoMatchExpression*>(expr);
         if ("2dsphere" == elt.valueStringDataSafe()) {
             verify(gme->getGeoExpression().getGeometry().hasS2Region());
-            const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            ExpressionMapping::cover2dsphere(gme->getGeoExpression(), indexParams, oilOut);
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if ("2d" == elt.valueStringDataSafe()) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
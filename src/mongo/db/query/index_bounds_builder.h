@@ -119,6 +119,38 @@ public:
                                   OrderedIntervalList* oilOut,
                                   BoundsTightness* tightnessOut);
 
+    /**
+     * Records one call of 'translate()', 'translateAndIntersect()' or 'translateAndUnion()' made
+     * while building the bounds of an index field, so that the bounds can be rebuilt by
+     * 'replayBoundsBuildingSteps()' once the input parameters of the predicates have been bound to
+     * other constants.
+     */
+    struct BoundsBuildingStep {
+        enum class Kind { kTranslate, kIntersect, kUnion };
+
+        BoundsBuildingStep(Kind kind, const MatchExpression* expr, BoundsTightness tightness);
+
+        BoundsBuildingStep clone() const;
+
+        Kind kind;
+
+        // Copy of the translated predicate.
+        std::unique_ptr<MatchExpression> expr;
+
+        // Tightness of the bounds resulting from this step.
+        BoundsTightness tightness;
+    };
+
+    /**
+     * Rebuilds the bounds of the field 'elt' of 'index' into 'oilOut' by redoing 'steps' in order.
+     * Returns false if the tightness of the bounds resulting from any step differs from the one
+     * recorded, as the plan which the bounds belong to may then no longer be correct.
+     */
+    static bool replayBoundsBuildingSteps(const std::vector<BoundsBuildingStep>& steps,
+                                          const BSONElement& elt,
+                                          const IndexEntry& index,
+                                          OrderedIntervalList* oilOut);
+
     /**
      * Make a range interval from the provided object.
      * The object must have exactly two fields.  The first field is the start, the second the
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/input_params.h"
+
+#include "mongo/db/matcher/expression_parameterization.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/index_bounds_builder.h"
+
+namespace mongo::input_params {
+namespace {
+/**
+ * Rebuilds the bounds of 'node' from the re-bound predicates they were built from.
+ */
+bool bindIndexBounds(const CanonicalQuery& cq, IndexScanNode* node) {
+    const auto& inputParams = cq.getInputParamIdToExpressionMap();
+
+    // The eligibility of a non-simple index for a query depends on the types of the constants,
+    // and so does the admissibility of a partial index.
+    if (!node->boundsBuildingSteps ||
+        !CollatorInterface::collatorsMatch(node->index.collator, cq.getCollator()) ||
+        node->index.filterExpr) {
+        return false;
+    }
+
+    const auto sortsBefore = node->providedSorts();
+
+    BSONObjIterator keyPatternIt(node->index.keyPattern);
+    for (size_t field = 0; field < node->boundsBuildingSteps->size(); ++field) {
+        invariant(keyPatternIt.more());
+        auto keyElt = keyPatternIt.next();
+
+        auto& steps = (*node->boundsBuildingSteps)[field];
+        if (steps.empty()) {
+            // The field is unconstrained by the query.
+            continue;
+        }
+
+        for (auto&& step : steps) {
+            if (!expression::bindInputParams(inputParams, step.expr.get())) {
+                return false;
+            }
+        }
+
+        OrderedIntervalList oil;
+        if (!IndexBoundsBuilder::replayBoundsBuildingSteps(steps, keyElt, node->index, &oil)) {
+            return false;
+        }
+
+        // Bounds are built in increasing order, and then aligned with the scan direction.
+        const int direction = (keyElt.number() >= 0) ? 1 : -1;
+        if (direction * node->direction == -1) {
+            oil.reverse();
+        }
+        node->bounds.fields[field] = std::move(oil);
+    }
+
+    // Different bounds may provide different sort orders, which the solution may rely on.
+    node->computeProperties();
+    const auto& sortsAfter = node->providedSorts();
+    return sortsBefore.getBaseSortPattern().woCompare(sortsAfter.getBaseSortPattern()) == 0 &&
+        sortsBefore.getIgnoredFields() == sortsAfter.getIgnoredFields();
+}
+
+bool bindNode(const CanonicalQuery& cq, QuerySolutionNode* node) {
+    if (node->filter &&
+        !expression::bindInputParams(cq.getInputParamIdToExpressionMap(), node->filter.get())) {
+        return false;
+    }
+
+    switch (node->getType()) {
+        case STAGE_IXSCAN:
+            if (!bindIndexBounds(cq, static_cast<IndexScanNode*>(node))) {
+                return false;
+            }
+            break;
+        case STAGE_COUNT_SCAN:
+        case STAGE_DISTINCT_SCAN:
+        case STAGE_GEO_NEAR_2D:
+        case STAGE_GEO_NEAR_2DSPHERE:
+            // These stages carry bounds which cannot be rebuilt.
+            return false;
+        default:
+            break;
+    }
+
+    for (auto child : node->children) {
+        if (!bindNode(cq, child)) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+bool bind(const MatchExpression* plannedFilter, const CanonicalQuery& cq, QuerySolution* solution) {
+    invariant(plannedFilter);
+    invariant(solution->root());
+
+    if (!expression::equivalentModuloInputParams(plannedFilter, cq.root())) {
+        return false;
+    }
+    return bindNode(cq, solution->root());
+}
+
+}  // namespace mongo::input_params
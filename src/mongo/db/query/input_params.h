@@ -0,0 +1,51 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo::input_params {
+
+/**
+ * Re-binds 'solution', which was planned for a query with the filter 'plannedFilter', to the
+ * constants of 'cq', so that the solution answers 'cq' instead. This is possible when the filter of
+ * 'cq' only differs from 'plannedFilter' by the constants of their parameterized predicates (see
+ * 'expression::parameterize()'), and when the new constants lead to index bounds of the same
+ * tightness and to the same sort orders.
+ *
+ * Returns false if the solution cannot be re-bound, in which case 'cq' has to be planned from
+ * scratch and 'solution', which may have been partially re-bound, must be discarded.
+ */
+bool bind(const MatchExpression* plannedFilter, const CanonicalQuery& cq, QuerySolution* solution);
+
+}  // namespace mongo::input_params
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/input_params.h"
+#include "mongo/db/query/query_planner_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class InputParamsTest : public QueryPlannerTest {
+protected:
+    /**
+     * Plans 'plannedQuery', re-binds its only solution to 'query' and returns whether that
+     * succeeded. If so, asserts that the re-bound solution is the one planned for 'query'.
+     */
+    bool rebind(const BSONObj& plannedQuery, const BSONObj& query) {
+        params.options = QueryPlannerParams::DEFAULT;
+        runQuery(plannedQuery);
+        assertNumSolutions(1U);
+        auto solution = std::move(solns.front());
+        auto plannedCq = std::move(cq);
+
+        runQuery(query);
+        assertNumSolutions(1U);
+        if (!input_params::bind(plannedCq->root(), *cq, solution.get())) {
+            return false;
+        }
+
+        ASSERT_EQ(solution->toString(), solns.front()->toString());
+        return true;
+    }
+};
+
+TEST_F(InputParamsTest, RebindsPointBounds) {
+    addIndex(BSON("a" << 1));
+    ASSERT_TRUE(rebind(fromjson("{a: 5}"), fromjson("{a: 7}")));
+}
+
+TEST_F(InputParamsTest, RebindsRangeBoundsOverDescendingIndex) {
+    addIndex(BSON("a" << -1));
+    ASSERT_TRUE(rebind(fromjson("{a: {$gt: 1, $lt: 5}}"), fromjson("{a: {$gt: 10, $lt: 20}}")));
+}
+
+TEST_F(InputParamsTest, RebindsInBounds) {
+    addIndex(BSON("a" << 1));
+    ASSERT_TRUE(rebind(fromjson("{a: {$in: [1, 2]}}"), fromjson("{a: {$in: [3, 4, 5]}}")));
+}
+
+TEST_F(InputParamsTest, RebindsCompoundBoundsAndResidualFilter) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    ASSERT_TRUE(
+        rebind(fromjson("{a: 1, b: {$gte: 2}, c: 3}"), fromjson("{a: 4, b: {$gte: 5}, c: 6}")));
+}
+
+TEST_F(InputParamsTest, RebindsCollectionScanFilter) {
+    ASSERT_TRUE(rebind(fromjson("{a: 1, b: {$lt: 2}}"), fromjson("{a: 3, b: {$lt: 4}}")));
+}
+
+TEST_F(InputParamsTest, DoesNotRebindDifferentShapes) {
+    addIndex(BSON("a" << 1));
+    ASSERT_FALSE(rebind(fromjson("{a: 5}"), fromjson("{a: null}")));
+    ASSERT_FALSE(rebind(fromjson("{a: 5}"), fromjson("{a: [1, 2]}")));
+}
+}  // namespace
+}  // namespace mongo
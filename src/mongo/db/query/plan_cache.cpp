@@ -419,6 +419,10 @@ std::string SolutionCacheData::toString() const {
                                  << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
+        case SKIP_IXSCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(index skip scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
         case USE_INDEX_TAGS_SOLN:
             verify(this->tree.get());
             return str::stream() << "(index-tagged expression tree: "
@@ -431,12 +435,43 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : PlanCache(internalQueryCacheMaxEntriesPerCollection.load()) {}
+namespace {
+// Source of the versions of all PlanCache instances.
+AtomicWord<uint64_t> planCacheVersionCounter{0};
+}  // namespace
+
+PlanCache::PlanCache()
+    : PlanCache(internalQueryCacheMaxEntriesPerCollection.load(),
+                internalQueryCacheNumPartitions.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size, size_t numPartitions) {
+    invariant(numPartitions > 0);
+    // Don't create partitions which could never hold an entry.
+    numPartitions = std::max<size_t>(1, std::min(numPartitions, size));
+
+    _partitions.reserve(numPartitions);
+    for (size_t i = 0; i < numPartitions; ++i) {
+        // Hand out any remainder to the first partitions, so that the total capacity is exactly
+        // 'size'.
+        _partitions.push_back(
+            std::make_unique<Partition>(size / numPartitions + (i < size % numPartitions)));
+    }
+    bumpVersion();
+}
+
+void PlanCache::bumpVersion() {
+    _version.store(planCacheVersionCounter.addAndFetch(1));
+}
 
 PlanCache::~PlanCache() {}
 
+PlanCache::Partition& PlanCache::getPartition(const PlanCacheKey& key) const {
+    if (_partitions.size() == 1) {
+        return *_partitions.front();
+    }
+    return *_partitions[PlanCacheKeyHasher{}(key) % _partitions.size()];
+}
+
 std::unique_ptr<CachedSolution> PlanCache::getCacheEntryIfActive(const PlanCacheKey& key) const {
     PlanCache::GetResult res = get(key);
     if (res.state == PlanCache::CacheEntryState::kPresentInactive) {
@@ -586,7 +621,8 @@ Status PlanCache::set(const CanonicalQuery& query,
                                              }},
                     why->stats);
     const auto key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     bool isNewEntryActive = false;
     uint32_t queryHash;
     uint32_t planCacheKey;
@@ -597,7 +633,7 @@ Status PlanCache::set(const CanonicalQuery& query,
         queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
     } else {
         PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
+        Status cacheStatus = partition.cache.get(key, &oldEntry);
         invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
@@ -624,7 +660,8 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, newEntry.release());
+    bumpVersion();
 
     if (nullptr != evictedEntry.get()) {
         LOGV2_DEBUG(20942,
@@ -644,15 +681,17 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return;
     }
     invariant(entry);
     entry->isActive = false;
+    bumpVersion();
 }
 
 PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
@@ -661,9 +700,10 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return {CacheEntryState::kNotPresent, nullptr};
@@ -676,13 +716,24 @@ PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    PlanCacheKey key = computeKey(canonicalQuery);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
+    partition.indexTrialStats.remove(key).ignore();
+    auto status = partition.cache.remove(key);
+    if (status.isOK()) {
+        bumpVersion();
+    }
+    return status;
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        partition->cache.clear();
+        partition->indexTrialStats.clear();
+    }
+    bumpVersion();
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -698,9 +749,10 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -710,41 +762,115 @@ StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQ
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            auto entry = cacheEntry.second;
+            entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+        }
     }
 
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
     _indexabilityState.updateDiscriminators(indexCores);
+    bumpVersion();
 }
 
 std::vector<BSONObj> PlanCache::getMatchingStats(
     const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
-        if (filterFunc(serializedEntry)) {
-            results.push_back(serializedEntry);
+    // Partitions are locked one at a time, so the result is not a point-in-time snapshot of the
+    // whole cache.
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            const auto entry = cacheEntry.second;
+            auto serializedEntry = serializationFunc(*entry);
+
+            PlanCacheIndexTrialStats* indexTrialStats;
+            if (partition->indexTrialStats.get(cacheEntry.first, &indexTrialStats).isOK()) {
+                BSONObjBuilder bob;
+                bob.appendElements(serializedEntry);
+                bob.append("indexTrialStats", indexTrialStats->toBSON());
+                serializedEntry = bob.obj();
+            }
+
+            if (filterFunc(serializedEntry)) {
+                results.push_back(serializedEntry);
+            }
         }
     }
 
     return results;
 }
 
+void PlanCache::recordIndexTrialOutcome(const PlanCacheKey& key,
+                                        const StringSet& winnerIndexes,
+                                        const StringSet& loserIndexes) {
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
+
+    PlanCacheIndexTrialStats* stats;
+    if (!partition.indexTrialStats.get(key, &stats).isOK()) {
+        stats = new PlanCacheIndexTrialStats();
+        partition.indexTrialStats.add(key, stats);
+    }
+
+    for (auto&& indexName : winnerIndexes) {
+        auto& indexStats = stats->indexes[indexName];
+        ++indexStats.wins;
+        indexStats.consecutiveLosses = 0;
+    }
+    for (auto&& indexName : loserIndexes) {
+        if (!winnerIndexes.contains(indexName)) {
+            auto& indexStats = stats->indexes[indexName];
+            ++indexStats.losses;
+            ++indexStats.consecutiveLosses;
+        }
+    }
+}
+
+StringSet PlanCache::getIndexesWithConsecutiveLosses(const PlanCacheKey& key,
+                                                     long long consecutiveLosses) const {
+    StringSet indexes;
+
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
+    PlanCacheIndexTrialStats* stats;
+    if (partition.indexTrialStats.get(key, &stats).isOK()) {
+        for (auto&& [indexName, indexStats] : stats->indexes) {
+            if (indexStats.consecutiveLosses >= consecutiveLosses) {
+                indexes.insert(indexName);
+            }
+        }
+    }
+    return indexes;
+}
+
+BSONObj PlanCacheIndexTrialStats::toBSON() const {
+    BSONObjBuilder bob;
+    for (auto&& [indexName, indexStats] : indexes) {
+        BSONObjBuilder indexBob(bob.subobjStart(indexName));
+        indexBob.append("wins", indexStats.wins);
+        indexBob.append("losses", indexStats.losses);
+        indexBob.append("consecutiveLosses", indexStats.consecutiveLosses);
+    }
+    return bob.obj();
+}
+
 }  // namespace mongo
@@ -42,6 +42,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/container_size_helper.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 /**
@@ -247,7 +248,8 @@ struct SolutionCacheData {
 
     // Owned here. If 'wholeIXSoln' is false, then 'tree'
     // can be used to tag an isomorphic match expression. If 'wholeIXSoln'
-    // is true, then 'tree' is used to store the relevant IndexEntry.
+    // is true, or this is a skip scan solution, then 'tree' is used to
+    // store the relevant IndexEntry.
     // If 'collscanSoln' is true, then 'tree' should be NULL.
     std::unique_ptr<PlanCacheIndexTree> tree;
 
@@ -260,6 +262,11 @@ struct SolutionCacheData {
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
+        // The cached plan is a skip scan over the index
+        // stored in 'tree', whose leading field the query
+        // does not constrain.
+        SKIP_IXSCAN_SOLN,
+
         // Build the solution by using 'tree'
         // to tag the match expression.
         USE_INDEX_TAGS_SOLN
@@ -438,6 +445,26 @@ private:
     uint64_t _estimateObjectSizeInBytes() const;
 };
 
+/**
+ * How the indexes used by the candidate plans of a query shape fared in the multi-planner trial
+ * periods of that shape. Tracked when 'internalQueryPlanCacheSkipIndexesAfterConsecutiveLosses' is
+ * positive, so that candidate plans using only indexes which keep losing can be left out.
+ */
+struct PlanCacheIndexTrialStats {
+    struct IndexStats {
+        long long wins = 0;
+        long long losses = 0;
+
+        // Losses since the last win.
+        long long consecutiveLosses = 0;
+    };
+
+    BSONObj toBSON() const;
+
+    // Keyed by index name.
+    StringMap<IndexStats> indexes;
+};
+
 /**
  * Caches the best solution to a query.  Aside from the (CanonicalQuery -> QuerySolution)
  * mapping, the cache contains information on why that mapping was made and statistics on the
@@ -484,11 +511,17 @@ public:
     static bool shouldCacheQuery(const CanonicalQuery& query);
 
     /**
-     * If omitted, namespace set to empty string.
+     * Creates a cache sized by 'internalQueryCacheMaxEntriesPerCollection' and split into
+     * 'internalQueryCacheNumPartitions' partitions.
      */
     PlanCache();
 
-    PlanCache(size_t size);
+    /**
+     * Creates a cache of at most 'size' entries split into 'numPartitions' partitions, each locked
+     * independently and owning an equal share of the entries. Keys are assigned to partitions by
+     * hash, so the least recently used entry is only evicted exactly when 'numPartitions' is 1.
+     */
+    PlanCache(size_t size, size_t numPartitions = 1);
 
     ~PlanCache();
 
@@ -600,6 +633,33 @@ public:
         const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
         const std::function<bool(const BSONObj&)>& filterFunc) const;
 
+    /**
+     * Returns a number which changes whenever an entry is added, removed or deactivated, and
+     * whenever the indexes of the collection change. Versions are unique across all PlanCache
+     * instances, so state derived from the cache can be tagged with the version it was derived
+     * from to detect when it goes stale.
+     */
+    uint64_t getVersion() const {
+        return _version.load();
+    }
+
+    /**
+     * Records the outcome of a multi-planner trial period for the query shape 'key': each index in
+     * 'winnerIndexes' won, and each index in 'loserIndexes' that is not also in 'winnerIndexes'
+     * lost. The statistics are dropped along with the shape's cache entry by remove() and clear(),
+     * and independently evicted when there are more shapes than the cache holds entries.
+     */
+    void recordIndexTrialOutcome(const PlanCacheKey& key,
+                                 const StringSet& winnerIndexes,
+                                 const StringSet& loserIndexes);
+
+    /**
+     * Returns the indexes that have lost at least 'consecutiveLosses' trial periods in a row for
+     * the query shape 'key'.
+     */
+    StringSet getIndexesWithConsecutiveLosses(const PlanCacheKey& key,
+                                              long long consecutiveLosses) const;
+
 private:
     struct NewEntryState {
         bool shouldBeCreated = false;
@@ -613,10 +673,30 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    /**
+     * A slice of the cache with its own LRU list and lock. Spreading the entries over several
+     * partitions keeps concurrent lookups of different query shapes from serializing on a single
+     * mutex.
+     */
+    struct Partition {
+        explicit Partition(size_t size) : cache(size), indexTrialStats(size) {}
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+
+        // Kept apart from 'cache', since trial periods whose winner is not cached are counted too.
+        LRUKeyValue<PlanCacheKey, PlanCacheIndexTrialStats, PlanCacheKeyHasher> indexTrialStats;
+
+        // Protects 'cache' and 'indexTrialStats'.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Partition::mutex");
+    };
+
+    Partition& getPartition(const PlanCacheKey& key) const;
+
+    void bumpVersion();
+
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    AtomicWord<uint64_t> _version;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
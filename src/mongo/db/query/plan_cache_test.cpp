@@ -603,6 +603,53 @@ TEST(PlanCacheTest, PlanCacheLRUPolicyRemovesInactiveEntries) {
     ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+TEST(PlanCacheTest, PartitionedPlanCacheBehavesAsASingleCache) {
+    const size_t kCacheSize = 100;
+    const size_t kNumPartitions = 8;
+    PlanCache planCache(kCacheSize, kNumPartitions);
+    QueryTestServiceContext serviceContext;
+
+    // Add a few shapes which may land in any partition.
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (auto&& queryStr : {"{a: 1}", "{b: 1}", "{c: 1}", "{d: 1}", "{e: 1}", "{f: 1}"}) {
+        queries.push_back(canonicalize(queryStr));
+        addCacheEntryForShape(*queries.back(), &planCache);
+    }
+    ASSERT_EQ(planCache.size(), queries.size());
+    ASSERT_EQ(planCache.getAllEntries().size(), queries.size());
+    ASSERT_EQ(planCache
+                  .getMatchingStats([](const PlanCacheEntry& entry) { return BSONObj(); },
+                                    [](const BSONObj& obj) { return true; })
+                  .size(),
+              queries.size());
+
+    for (auto&& cq : queries) {
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+    }
+
+    ASSERT_OK(planCache.remove(*queries.front()));
+    ASSERT_EQ(planCache.get(*queries.front()).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(planCache.size(), queries.size() - 1);
+
+    planCache.clear();
+    ASSERT_EQ(planCache.size(), 0U);
+    ASSERT_EQ(planCache.getAllEntries().size(), 0U);
+}
+
+TEST(PlanCacheTest, PartitionedPlanCacheNeverExceedsItsSize) {
+    const size_t kCacheSize = 4;
+    PlanCache planCache(kCacheSize, 3);
+    QueryTestServiceContext serviceContext;
+
+    std::string queryString = "{a: 1}";
+    for (size_t i = 0; i < 10; ++i) {
+        queryString[1]++;
+        unique_ptr<CanonicalQuery> cq(canonicalize(queryString));
+        addCacheEntryForShape(*cq, &planCache);
+        ASSERT_LTE(planCache.size(), kCacheSize);
+    }
+}
+
 TEST(PlanCacheTest, PlanCacheRemoveDeletesInactiveEntries) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -900,6 +947,40 @@ TEST(PlanCacheTest, GetMatchingStatsMatchesAndSerializesCorrectly) {
     ASSERT_BSONOBJ_EQ(BSON("works" << 5), getStatsResult[0]);
 }
 
+TEST(PlanCacheTest, IndexTrialOutcomesTrackConsecutiveLosses) {
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1, b: 1}"));
+    auto key = planCache.computeKey(*cq);
+
+    ASSERT(planCache.getIndexesWithConsecutiveLosses(key, 1).empty());
+
+    planCache.recordIndexTrialOutcome(key, {"a_1"}, {"b_1", "a_1"});
+    planCache.recordIndexTrialOutcome(key, {"a_1"}, {"b_1", "c_1"});
+    ASSERT(planCache.getIndexesWithConsecutiveLosses(key, 2) == StringSet({"b_1"}));
+    ASSERT(planCache.getIndexesWithConsecutiveLosses(key, 1) == StringSet({"b_1", "c_1"}));
+
+    // A win resets the consecutive losses of an index.
+    planCache.recordIndexTrialOutcome(key, {"b_1"}, {"a_1"});
+    ASSERT(planCache.getIndexesWithConsecutiveLosses(key, 1) == StringSet({"a_1", "c_1"}));
+
+    // Other query shapes have their own outcomes.
+    unique_ptr<CanonicalQuery> otherCq(canonicalize("{c: 1}"));
+    ASSERT(planCache.getIndexesWithConsecutiveLosses(planCache.computeKey(*otherCq), 1).empty());
+
+    // The outcomes are serialized along with the shape's cache entry.
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U), Date_t{}));
+    auto stats = planCache.getMatchingStats([](const PlanCacheEntry&) { return BSONObj(); },
+                                            [](const BSONObj&) { return true; });
+    ASSERT_EQ(1U, stats.size());
+    ASSERT_BSONOBJ_EQ(stats[0]["indexTrialStats"]["b_1"].Obj(),
+                      BSON("wins" << 1LL << "losses" << 2LL << "consecutiveLosses" << 0LL));
+
+    planCache.clear();
+    ASSERT(planCache.getIndexesWithConsecutiveLosses(key, 1).empty());
+}
+
 /**
  * Each test in the CachePlanSelectionTest suite goes through
  * the following flow:
@@ -0,0 +1,190 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/query/cardinality_estimator.h"
+
+namespace mongo::plan_cost_model {
+
+namespace {
+
+// The cost of examining one index key, relative to reading one document in a collection scan.
+constexpr double kIndexKeyCost = 0.5;
+
+// The cost of positioning an index cursor on the start of an interval.
+constexpr double kIndexSeekCost = 1.0;
+
+// The cost of fetching one document by its record id, which is a random read.
+constexpr double kFetchCost = 2.0;
+
+// The cost of one comparison made by a blocking sort.
+constexpr double kSortComparisonCost = 0.05;
+
+// Below this cost the estimates are too coarse to prefer one candidate over another, and running
+// every candidate for a trial period is cheap anyway.
+constexpr double kMinCostToPrune = 100.0;
+
+/**
+ * Returns the number of intervals an index scan with 'bounds' positions its cursor on, assuming it
+ * seeks once per combination of intervals over the fields of the index.
+ */
+double estimateNumSeeks(const IndexBounds& bounds) {
+    double numSeeks = 1;
+    for (auto&& oil : bounds.fields) {
+        numSeeks *= std::max<size_t>(oil.intervals.size(), 1);
+    }
+    return numSeeks;
+}
+
+}  // namespace
+
+boost::optional<PlanCostEstimate> estimatePlanCost(const CollectionStatistics& statistics,
+                                                   double numRecords,
+                                                   const QuerySolutionNode* root) {
+    using cardinality_estimator::estimateSelectivity;
+
+    switch (root->getType()) {
+        case STAGE_COLLSCAN: {
+            auto csn = static_cast<const CollectionScanNode*>(root);
+            if (csn->minRecord || csn->maxRecord) {
+                return boost::none;
+            }
+            PlanCostEstimate estimate;
+            estimate.cost = numRecords;
+            estimate.numResults = numRecords * estimateSelectivity(statistics, root->filter.get());
+            return estimate;
+        }
+        case STAGE_IXSCAN: {
+            auto isn = static_cast<const IndexScanNode*>(root);
+            auto selectivity = estimateSelectivity(statistics, isn->index, isn->bounds);
+            if (!selectivity) {
+                return boost::none;
+            }
+            const double numKeys = *selectivity * numRecords;
+            PlanCostEstimate estimate;
+            estimate.cost = numKeys * kIndexKeyCost +
+                std::min(estimateNumSeeks(isn->bounds), numKeys + 1) * kIndexSeekCost;
+            estimate.numResults = numKeys * estimateSelectivity(statistics, root->filter.get());
+            return estimate;
+        }
+        case STAGE_FETCH: {
+            auto estimate = estimatePlanCost(statistics, numRecords, root->children[0]);
+            if (!estimate) {
+                return boost::none;
+            }
+            estimate->cost += estimate->numResults * kFetchCost;
+            estimate->numResults *= estimateSelectivity(statistics, root->filter.get());
+            return estimate;
+        }
+        case STAGE_SORT_DEFAULT:
+        case STAGE_SORT_SIMPLE: {
+            auto estimate = estimatePlanCost(statistics, numRecords, root->children[0]);
+            if (!estimate) {
+                return boost::none;
+            }
+            const double numResults = std::max(estimate->numResults, 2.0);
+            estimate->cost += numResults * std::log2(numResults) * kSortComparisonCost;
+            estimate->blocking = true;
+            if (auto limit = static_cast<const SortNode*>(root)->limit) {
+                estimate->numResults = std::min(estimate->numResults, static_cast<double>(limit));
+            }
+            return estimate;
+        }
+        case STAGE_LIMIT: {
+            auto estimate = estimatePlanCost(statistics, numRecords, root->children[0]);
+            if (!estimate) {
+                return boost::none;
+            }
+            const double limit = static_cast<const LimitNode*>(root)->limit;
+            if (estimate->numResults > limit) {
+                // A plan which streams its results stops early, after doing about the share of its
+                // work which produces the first 'limit' results.
+                if (!estimate->blocking) {
+                    estimate->cost *= limit / estimate->numResults;
+                }
+                estimate->numResults = limit;
+            }
+            return estimate;
+        }
+        case STAGE_SKIP: {
+            auto estimate = estimatePlanCost(statistics, numRecords, root->children[0]);
+            if (!estimate) {
+                return boost::none;
+            }
+            const double skip = static_cast<const SkipNode*>(root)->skip;
+            estimate->numResults = std::max(0.0, estimate->numResults - skip);
+            return estimate;
+        }
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_RETURN_KEY:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_SORT_KEY_GENERATOR:
+            return estimatePlanCost(statistics, numRecords, root->children[0]);
+        default:
+            return boost::none;
+    }
+}
+
+void pruneSolutions(const CollectionStatistics& statistics,
+                    double numRecords,
+                    double pruningRatio,
+                    std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    if (solutions->size() < 2) {
+        return;
+    }
+
+    std::vector<double> costs;
+    for (auto&& solution : *solutions) {
+        auto estimate = estimatePlanCost(statistics, numRecords, solution->root());
+        if (!estimate) {
+            return;
+        }
+        costs.push_back(estimate->cost);
+    }
+
+    const double cheapest = *std::min_element(costs.begin(), costs.end());
+    const double maxCost = std::max(cheapest, kMinCostToPrune) * pruningRatio;
+    size_t kept = 0;
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        if (costs[i] <= maxCost) {
+            (*solutions)[kept++] = std::move((*solutions)[i]);
+        }
+    }
+    solutions->resize(kept);
+}
+
+}  // namespace mongo::plan_cost_model
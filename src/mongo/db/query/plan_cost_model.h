@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/db/query/query_solution.h"
+
+/**
+ * A cost model for candidate query solutions, built on the cardinality estimates made from the
+ * histograms gathered by the 'analyze' command. It is used to leave candidates which are clearly
+ * more expensive than the others out of the multi-planner's trial period.
+ */
+namespace mongo::plan_cost_model {
+
+struct PlanCostEstimate {
+    // The estimated cost of running the plan to completion, in units of documents read by a
+    // collection scan.
+    double cost = 0;
+
+    // The estimated number of results.
+    double numResults = 0;
+
+    // Whether the plan has to consume all of its input before it returns the first result.
+    bool blocking = false;
+};
+
+/**
+ * Returns the estimated cost of the plan rooted at 'root' over a collection of 'numRecords'
+ * documents, or boost::none if the plan has a stage that is not modelled, or reads an index that
+ * the statistics cannot estimate.
+ */
+boost::optional<PlanCostEstimate> estimatePlanCost(const CollectionStatistics& statistics,
+                                                   double numRecords,
+                                                   const QuerySolutionNode* root);
+
+/**
+ * Removes from 'solutions' the candidates whose estimated cost is more than 'pruningRatio' times
+ * that of the cheapest candidate. Nothing is removed unless every candidate can be estimated, or
+ * when the cheapest one is too cheap for the estimates to tell the candidates apart.
+ */
+void pruneSolutions(const CollectionStatistics& statistics,
+                    double numRecords,
+                    double pruningRatio,
+                    std::vector<std::unique_ptr<QuerySolution>>* solutions);
+
+}  // namespace mongo::plan_cost_model
@@ -0,0 +1,214 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_model.h"
+
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/cardinality_estimator.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+constexpr double kNumRecords = 1000;
+
+IndexEntry buildSimpleIndexEntry(const BSONObj& kp) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            IndexDescriptor::kLatestIndexVersion,
+            false,
+            {},
+            {},
+            false,
+            false,
+            CoreIndexInfo::Identifier("test_foo"),
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+/**
+ * Statistics of a collection of 1000 documents, where 'a' takes the values 0 to 999 and 'b' is 0 in
+ * half of the documents and 1 in the other half.
+ */
+CollectionStatistics makeStatistics() {
+    std::vector<BSONObj> aValues;
+    std::vector<BSONObj> bValues;
+    for (int i = 0; i < kNumRecords; ++i) {
+        aValues.push_back(BSON("" << i));
+        bValues.push_back(BSON("" << (i < kNumRecords / 2 ? 0 : 1)));
+    }
+
+    CollectionStatistics statistics;
+    statistics.fields["a"] = {EquiDepthHistogram::build(aValues, 100), Date_t()};
+    statistics.fields["b"] = {EquiDepthHistogram::build(bValues, 100), Date_t()};
+    return statistics;
+}
+
+std::unique_ptr<MatchExpression> parseMatchExpression(const BSONObj& obj) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto status = MatchExpressionParser::parse(obj, expCtx);
+    ASSERT_OK(status.getStatus());
+    return std::move(status.getValue());
+}
+
+std::unique_ptr<IndexScanNode> makeIndexScan(StringData field, int start, int end) {
+    auto ixscan = std::make_unique<IndexScanNode>(buildSimpleIndexEntry(BSON(field << 1)));
+    OrderedIntervalList oil(field.toString());
+    oil.intervals.push_back(Interval(BSON("" << start << "" << end), true, true));
+    ixscan->bounds.fields.push_back(oil);
+    return ixscan;
+}
+
+std::unique_ptr<QuerySolutionNode> makeFetch(std::unique_ptr<QuerySolutionNode> child) {
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->children.push_back(child.release());
+    return fetch;
+}
+
+std::unique_ptr<QuerySolution> makeSolution(std::unique_ptr<QuerySolutionNode> root) {
+    auto solution = std::make_unique<QuerySolution>();
+    solution->setRoot(std::move(root));
+    return solution;
+}
+
+TEST(PlanCostModelTest, EstimatesIndexScanAndFetch) {
+    auto statistics = makeStatistics();
+    auto fetch = makeFetch(makeIndexScan("a", 5, 5));
+
+    auto estimate = plan_cost_model::estimatePlanCost(statistics, kNumRecords, fetch.get());
+    ASSERT(estimate);
+    ASSERT_APPROX_EQUAL(estimate->numResults, 1, 1e-6);
+    ASSERT_APPROX_EQUAL(estimate->cost, 3.5, 1e-6);
+    ASSERT_FALSE(estimate->blocking);
+}
+
+TEST(PlanCostModelTest, EstimatesCollectionScanWithFilter) {
+    auto statistics = makeStatistics();
+    auto collscan = std::make_unique<CollectionScanNode>();
+    collscan->filter = parseMatchExpression(BSON("a" << BSON("$lt" << 100) << "b" << 0));
+
+    auto estimate = plan_cost_model::estimatePlanCost(statistics, kNumRecords, collscan.get());
+    ASSERT(estimate);
+    ASSERT_APPROX_EQUAL(estimate->cost, kNumRecords, 1e-6);
+    ASSERT_APPROX_EQUAL(estimate->numResults, 50, 1);
+}
+
+TEST(PlanCostModelTest, UnestimablePredicatesMatchEveryDocument) {
+    auto statistics = makeStatistics();
+    auto expr = parseMatchExpression(BSON("c" << 1 << "a" << BSON("$exists" << true)));
+    ASSERT_EQ(cardinality_estimator::estimateSelectivity(statistics, expr.get()), 1.0);
+}
+
+TEST(PlanCostModelTest, LimitShortensStreamingPlans) {
+    auto statistics = makeStatistics();
+    auto limit = std::make_unique<LimitNode>();
+    limit->limit = 10;
+    limit->children.push_back(new CollectionScanNode());
+
+    auto estimate = plan_cost_model::estimatePlanCost(statistics, kNumRecords, limit.get());
+    ASSERT(estimate);
+    ASSERT_APPROX_EQUAL(estimate->numResults, 10, 1e-6);
+    ASSERT_APPROX_EQUAL(estimate->cost, 10, 1e-6);
+}
+
+TEST(PlanCostModelTest, LimitDoesNotShortenBlockingPlans) {
+    auto statistics = makeStatistics();
+    auto sort = std::make_unique<SortNodeDefault>();
+    sort->children.push_back(new CollectionScanNode());
+    auto limit = std::make_unique<LimitNode>();
+    limit->limit = 10;
+    limit->children.push_back(sort.release());
+
+    auto estimate = plan_cost_model::estimatePlanCost(statistics, kNumRecords, limit.get());
+    ASSERT(estimate);
+    ASSERT(estimate->blocking);
+    ASSERT_APPROX_EQUAL(estimate->numResults, 10, 1e-6);
+    ASSERT_GT(estimate->cost, kNumRecords);
+}
+
+TEST(PlanCostModelTest, CannotEstimateScansOfUnanalyzedFields) {
+    auto statistics = makeStatistics();
+    auto ixscan = makeIndexScan("c", 5, 5);
+    ASSERT_FALSE(plan_cost_model::estimatePlanCost(statistics, kNumRecords, ixscan.get()));
+}
+
+TEST(PlanCostModelTest, CannotEstimateUnsupportedStages) {
+    auto statistics = makeStatistics();
+    auto orNode = std::make_unique<OrNode>();
+    orNode->children.push_back(makeIndexScan("a", 1, 1).release());
+    orNode->children.push_back(makeIndexScan("b", 1, 1).release());
+    ASSERT_FALSE(plan_cost_model::estimatePlanCost(statistics, kNumRecords, orNode.get()));
+}
+
+TEST(PlanCostModelTest, PrunesExpensiveSolutions) {
+    auto statistics = makeStatistics();
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeSolution(makeFetch(makeIndexScan("a", 5, 5))));
+    solutions.push_back(makeSolution(makeFetch(makeIndexScan("b", 0, 0))));
+    solutions.push_back(makeSolution(std::make_unique<CollectionScanNode>()));
+
+    plan_cost_model::pruneSolutions(statistics, kNumRecords, 2.0, &solutions);
+    ASSERT_EQ(solutions.size(), 1U);
+    ASSERT_EQ(solutions[0]->root()->getType(), STAGE_FETCH);
+    ASSERT_EQ(solutions[0]->root()->children[0]->getType(), STAGE_IXSCAN);
+    ASSERT_BSONOBJ_EQ(
+        static_cast<const IndexScanNode*>(solutions[0]->root()->children[0])->index.keyPattern,
+        BSON("a" << 1));
+}
+
+TEST(PlanCostModelTest, DoesNotPruneCheapSolutions) {
+    auto statistics = makeStatistics();
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeSolution(makeIndexScan("a", 5, 5)));
+    solutions.push_back(makeSolution(makeIndexScan("a", 0, 99)));
+
+    plan_cost_model::pruneSolutions(statistics, kNumRecords, 2.0, &solutions);
+    ASSERT_EQ(solutions.size(), 2U);
+}
+
+TEST(PlanCostModelTest, DoesNotPruneWhenASolutionCannotBeEstimated) {
+    auto statistics = makeStatistics();
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeSolution(makeFetch(makeIndexScan("a", 5, 5))));
+    solutions.push_back(makeSolution(makeFetch(makeIndexScan("c", 0, 0))));
+    solutions.push_back(makeSolution(std::make_unique<CollectionScanNode>()));
+
+    plan_cost_model::pruneSolutions(statistics, kNumRecords, 2.0, &solutions);
+    ASSERT_EQ(solutions.size(), 3U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -35,12 +35,37 @@
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
+#include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/plan_executor_impl.h"
 #include "mongo/db/query/plan_executor_sbe.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo::plan_executor_factory {
+namespace {
+/**
+ * Decides whether the executor being created for 'cq' is sampled for $queryStats. If it is,
+ * returns the hash of its query shape.
+ */
+boost::optional<uint32_t> sampleForQueryStats(OperationContext* opCtx, const CanonicalQuery* cq) {
+    if (!cq || cq->getExpCtxRaw()->explain ||
+        !QueryStatsStore::get(opCtx->getServiceContext()).shouldSample()) {
+        return boost::none;
+    }
+    return canonical_query_encoder::computeHash(canonical_query_encoder::encode(*cq));
+}
+
+void markShouldCollectTimingInfoOnSubtree(PlanStage* root) {
+    // Candidate plans of a multi-planner already collect timing info, and may have run.
+    if (!root->getCommonStats()->executionTimeMillis) {
+        root->markShouldCollectTimingInfo();
+    }
+    for (auto&& child : root->getChildren()) {
+        markShouldCollectTimingInfoOnSubtree(child.get());
+    }
+}
+}  // namespace
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> make(
     std::unique_ptr<CanonicalQuery> cq,
@@ -98,6 +123,12 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> make(
     PlanYieldPolicy::YieldPolicy yieldPolicy) {
     dassert(collection);
     try {
+        // Timing must be turned on before the executor runs plan selection.
+        auto queryStatsHash = sampleForQueryStats(opCtx, cq.get());
+        if (queryStatsHash) {
+            markShouldCollectTimingInfoOnSubtree(rt.get());
+        }
+
         auto execImpl = new PlanExecutorImpl(opCtx,
                                              std::move(ws),
                                              std::move(rt),
@@ -110,6 +141,9 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> make(
                                              yieldPolicy);
         PlanExecutor::Deleter planDeleter(opCtx);
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec(execImpl, std::move(planDeleter));
+        if (queryStatsHash) {
+            execImpl->sampleForQueryStats(*queryStatsHash);
+        }
         return {std::move(exec)};
     } catch (...) {
         return {exceptionToStatus()};
@@ -136,18 +170,26 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> make(
 
     rootStage->prepare(data.ctx);
 
-    return {{new PlanExecutorSBE(
-                 opCtx,
-                 std::move(cq),
-                 {makeVector<sbe::plan_ranker::CandidatePlan>(sbe::plan_ranker::CandidatePlan{
-                      std::move(solution), std::move(rootStage), std::move(data)}),
-                  0},
-                 *collection,
-                 plannerOptions & QueryPlannerParams::RETURN_OWNED_DATA,
-                 std::move(nss),
-                 false,
-                 std::move(yieldPolicy)),
-             PlanExecutor::Deleter{opCtx}}};
+    auto queryStatsHash = sampleForQueryStats(opCtx, cq.get());
+    if (queryStatsHash && !rootStage->getCommonStats()->executionTimeMillis) {
+        rootStage->markShouldCollectTimingInfo();
+    }
+
+    auto exec = new PlanExecutorSBE(
+        opCtx,
+        std::move(cq),
+        {makeVector<sbe::plan_ranker::CandidatePlan>(sbe::plan_ranker::CandidatePlan{
+             std::move(solution), std::move(rootStage), std::move(data)}),
+         0},
+        *collection,
+        plannerOptions & QueryPlannerParams::RETURN_OWNED_DATA,
+        std::move(nss),
+        false,
+        std::move(yieldPolicy));
+    if (queryStatsHash) {
+        exec->sampleForQueryStats(*queryStatsHash);
+    }
+    return {{exec, PlanExecutor::Deleter{opCtx}}};
 }
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> make(
@@ -166,15 +208,26 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> make(
                 "slots"_attr = candidates.winner().data.debugString(),
                 "stages"_attr = sbe::DebugPrinter{}.print(*candidates.winner().root));
 
-    return {{new PlanExecutorSBE(opCtx,
-                                 std::move(cq),
-                                 std::move(candidates),
-                                 *collection,
-                                 plannerOptions & QueryPlannerParams::RETURN_OWNED_DATA,
-                                 std::move(nss),
-                                 true,
-                                 std::move(yieldPolicy)),
-             PlanExecutor::Deleter{opCtx}}};
+    // The winning plan has already run its trial period, which is only timed if the whole plan
+    // collects timing info. Otherwise it is timed from here on.
+    auto queryStatsHash = sampleForQueryStats(opCtx, cq.get());
+    auto&& winnerRoot = candidates.winner().root;
+    if (queryStatsHash && !winnerRoot->getCommonStats()->executionTimeMillis) {
+        winnerRoot->markShouldCollectTimingInfo();
+    }
+
+    auto exec = new PlanExecutorSBE(opCtx,
+                                    std::move(cq),
+                                    std::move(candidates),
+                                    *collection,
+                                    plannerOptions & QueryPlannerParams::RETURN_OWNED_DATA,
+                                    std::move(nss),
+                                    true,
+                                    std::move(yieldPolicy));
+    if (queryStatsHash) {
+        exec->sampleForQueryStats(*queryStatsHash);
+    }
+    return {{exec, PlanExecutor::Deleter{opCtx}}};
 }
 
 std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> make(
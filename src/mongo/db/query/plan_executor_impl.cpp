@@ -62,6 +62,7 @@
 #include "mongo/db/query/yield_policy_callbacks_impl.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
@@ -110,6 +111,21 @@ std::unique_ptr<PlanYieldPolicy> makeYieldPolicy(PlanExecutorImpl* exec,
             MONGO_UNREACHABLE;
     }
 }
+
+/**
+ * Appends the statistics of the stage 'stats' at 'path', followed by those of its descendants.
+ */
+void appendStageSamples(const PlanStageStats& stats,
+                        const std::string& path,
+                        std::vector<QueryStatsStore::StageSample>* stages) {
+    stages->push_back({path,
+                       stats.common.stageTypeStr,
+                       stats.common.executionTimeMillis.value_or(0),
+                       static_cast<long long>(stats.common.advanced)});
+    for (size_t i = 0; i < stats.children.size(); ++i) {
+        appendStageSamples(*stats.children[i], str::stream() << path << "." << i, stages);
+    }
+}
 }  // namespace
 
 PlanExecutorImpl::PlanExecutorImpl(OperationContext* opCtx,
@@ -470,6 +486,16 @@ void PlanExecutorImpl::markAsKilled(Status killStatus) {
 }
 
 void PlanExecutorImpl::dispose(OperationContext* opCtx) {
+    if (_queryStatsHash && _currentState != kDisposed) {
+        auto service = opCtx->getServiceContext();
+        QueryStatsStore::Sample sample;
+        sample.nss = _nss;
+        sample.queryHash = *_queryStatsHash;
+        sample.engine = QueryStatsStore::Engine::kClassic;
+        sample.time = service->getFastClockSource()->now();
+        appendStageSamples(*_root->getStats(), "0", &sample.stages);
+        QueryStatsStore::get(service).record(std::move(sample));
+    }
     _currentState = kDisposed;
 }
 
@@ -491,7 +517,8 @@ void PlanExecutorImpl::_executePlan() {
 
 long long PlanExecutorImpl::executeCount() {
     invariant(_root->stageType() == StageType::STAGE_COUNT ||
-              _root->stageType() == StageType::STAGE_RECORD_STORE_FAST_COUNT);
+              _root->stageType() == StageType::STAGE_RECORD_STORE_FAST_COUNT ||
+              _root->stageType() == StageType::STAGE_INDEX_FAST_COUNT);
 
     _executePlan();
     auto countStats = static_cast<const CountStats*>(_root->getSpecificStats());
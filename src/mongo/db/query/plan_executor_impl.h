@@ -104,6 +104,14 @@ public:
 
     PlanStage* getRootStage() const;
 
+    /**
+     * Samples this executor for $queryStats under the query shape 'queryHash': the statistics of
+     * its stages are recorded into the QueryStatsStore when it is disposed.
+     */
+    void sampleForQueryStats(uint32_t queryHash) {
+        _queryStatsHash = queryHash;
+    }
+
 private:
     /**
      *  Executes the underlying PlanStage tree until it indicates EOF. Throws an exception if the
@@ -178,6 +186,9 @@ private:
     // executor is requested to return the oplog tracking info. Since this info is provided by
     // either of these stages, the executor will simply delegate the request to the cached stage.
     const CollectionScan* _collScanStage{nullptr};
+
+    // The query shape under which this executor is sampled for $queryStats, if it is sampled.
+    boost::optional<uint32_t> _queryStatsHash;
 };
 
 }  // namespace mongo
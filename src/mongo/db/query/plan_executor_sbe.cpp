@@ -39,6 +39,7 @@
 #include "mongo/db/query/plan_explainer_factory.h"
 #include "mongo/db/query/plan_insert_listener.h"
 #include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/resharding/resume_token_gen.h"
 
@@ -46,6 +47,23 @@ namespace mongo {
 // This failpoint is defined by the classic executor but is also accessed here.
 extern FailPoint planExecutorHangBeforeShouldWaitForInserts;
 
+namespace {
+/**
+ * Appends the statistics of the stage 'stats' at 'path', followed by those of its descendants.
+ */
+void appendStageSamples(const sbe::PlanStageStats& stats,
+                        const std::string& path,
+                        std::vector<QueryStatsStore::StageSample>* stages) {
+    stages->push_back({path,
+                       stats.common.stageType.toString(),
+                       stats.common.executionTimeMillis.value_or(0),
+                       static_cast<long long>(stats.common.advances)});
+    for (size_t i = 0; i < stats.children.size(); ++i) {
+        appendStageSamples(*stats.children[i], str::stream() << path << "." << i, stages);
+    }
+}
+}  // namespace
+
 PlanExecutorSBE::PlanExecutorSBE(OperationContext* opCtx,
                                  std::unique_ptr<CanonicalQuery> cq,
                                  sbe::CandidatePlans candidates,
@@ -151,6 +169,17 @@ void PlanExecutorSBE::markAsKilled(Status killStatus) {
 }
 
 void PlanExecutorSBE::dispose(OperationContext* opCtx) {
+    if (_queryStatsHash && !_isDisposed) {
+        auto service = opCtx->getServiceContext();
+        QueryStatsStore::Sample sample;
+        sample.nss = _nss;
+        sample.queryHash = *_queryStatsHash;
+        sample.engine = QueryStatsStore::Engine::kSBE;
+        sample.time = service->getFastClockSource()->now();
+        appendStageSamples(*_root->getStats(false /* includeDebugInfo */), "0", &sample.stages);
+        QueryStatsStore::get(service).record(std::move(sample));
+    }
+
     if (_state != State::kClosed) {
         _root->close();
         _state = State::kClosed;
@@ -131,6 +131,14 @@ public:
         return *_planExplainer;
     }
 
+    /**
+     * Samples this executor for $queryStats under the query shape 'queryHash': the statistics of
+     * its stages are recorded into the QueryStatsStore when it is disposed.
+     */
+    void sampleForQueryStats(uint32_t queryHash) {
+        _queryStatsHash = queryHash;
+    }
+
 private:
     enum class State { kClosed, kOpened };
 
@@ -170,6 +178,9 @@ private:
     std::unique_ptr<PlanExplainer> _planExplainer;
 
     bool _isDisposed{false};
+
+    // The query shape under which this executor is sampled for $queryStats, if it is sampled.
+    boost::optional<uint32_t> _queryStatsHash;
 };
 
 /**
@@ -415,6 +415,14 @@ void statsToBSON(const PlanStageStats& stats,
     } else if (isProjectionStageType(stats.stageType)) {
         ProjectionStats* spec = static_cast<ProjectionStats*>(stats.specific.get());
         bob->append("transformBy", spec->projObj);
+    } else if (STAGE_INDEX_FAST_COUNT == stats.stageType) {
+        IndexFastCountStats* spec = static_cast<IndexFastCountStats*>(stats.specific.get());
+        bob->append("indexName", spec->indexName);
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("nCounted", spec->nCounted);
+            bob->appendNumber("nSkipped", spec->nSkipped);
+        }
     } else if (STAGE_RECORD_STORE_FAST_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
 
@@ -422,6 +430,15 @@ void statsToBSON(const PlanStageStats& stats,
             bob->appendNumber("nCounted", spec->nCounted);
             bob->appendNumber("nSkipped", spec->nSkipped);
         }
+    } else if (STAGE_RESERVOIR_SAMPLE_FROM_TIMESERIES_BUCKET == stats.stageType) {
+        ReservoirSampleFromTimeseriesBucketStats* spec =
+            static_cast<ReservoirSampleFromTimeseriesBucketStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("nBucketsSkipped", static_cast<long long>(spec->nBucketsSkipped));
+            bob->appendNumber("nMeasurementsExtracted",
+                              static_cast<long long>(spec->nMeasurementsExtracted));
+        }
     } else if (STAGE_SAMPLE_FROM_TIMESERIES_BUCKET == stats.stageType) {
         SampleFromTimeseriesBucketStats* spec =
             static_cast<SampleFromTimeseriesBucketStats*>(stats.specific.get());
@@ -456,6 +473,8 @@ void statsToBSON(const PlanStageStats& stats,
                               static_cast<long long>(spec->totalDataSizeBytes));
             bob->appendBool("usedDisk", (spec->spills > 0));
             bob->appendNumber("spills", static_cast<long long>(spec->spills));
+            bob->appendNumber("spilledDataStorageSize",
+                              static_cast<long long>(spec->spilledDataStorageSize));
         }
     } else if (STAGE_SORT_MERGE == stats.stageType) {
         MergeSortStats* spec = static_cast<MergeSortStats*>(stats.specific.get());
@@ -685,6 +704,10 @@ void PlanExplainerImpl::getSummaryStats(PlanSummaryStats* statsOut) const {
             const CountScanStats* countScanStats =
                 static_cast<const CountScanStats*>(countScan->getSpecificStats());
             statsOut->indexesUsed.insert(countScanStats->indexName);
+        } else if (STAGE_INDEX_FAST_COUNT == stages[i]->stageType()) {
+            const IndexFastCountStats* indexFastCountStats =
+                static_cast<const IndexFastCountStats*>(stages[i]->getSpecificStats());
+            statsOut->indexesUsed.insert(indexFastCountStats->indexName);
         } else if (STAGE_IDHACK == stages[i]->stageType()) {
             const IDHackStage* idHackStage = static_cast<const IDHackStage*>(stages[i]);
             const IDHackStats* idHackStats =
@@ -118,6 +118,18 @@ void statsToBSON(const QuerySolutionNode* node,
             }
             break;
         }
+        case STAGE_EQ_LOOKUP: {
+            auto eln = static_cast<const EqLookupNode*>(node);
+            bob->append("foreignCollection", eln->foreignCollection.toString());
+            bob->append("localField", eln->joinFieldLocal);
+            bob->append("foreignField", eln->joinFieldForeign);
+            bob->append("asField", eln->joinField);
+            bob->append("strategy", EqLookupNode::serializeLookupStrategy(eln->lookupStrategy));
+            if (eln->idxEntry) {
+                bob->append("indexName", eln->idxEntry->identifier.catalogName);
+            }
+            break;
+        }
         case STAGE_LIMIT: {
             auto ln = static_cast<const LimitNode*>(node);
             bob->appendNumber("limitAmount", ln->limit);
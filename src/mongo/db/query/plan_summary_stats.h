@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <optional>
 #include <string>
 
@@ -60,6 +61,7 @@ struct PlanSummaryStats {
         hasSortStage |= statsIn.hasSortStage;
         usedDisk |= statsIn.usedDisk;
         planFailed |= statsIn.planFailed;
+        peakMemoryUsageBytes = std::max(peakMemoryUsageBytes, statsIn.peakMemoryUsageBytes);
         indexesUsed.insert(statsIn.indexesUsed.begin(), statsIn.indexesUsed.end());
     }
 
@@ -103,6 +105,9 @@ struct PlanSummaryStats {
     // Did this plan failed during execution?
     bool planFailed = false;
 
+    // The most memory held at once by the stages of the operation running this plan.
+    long long peakMemoryUsageBytes = 0;
+
     // The names of each index used by the plan.
     std::set<std::string> indexesUsed;
 
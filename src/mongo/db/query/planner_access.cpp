@@ -44,10 +44,13 @@
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_ixselect.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
@@ -138,6 +141,48 @@ std::vector<bool> canProvideSortWithMergeSort(
     return shouldReverseScan;
 }
 
+/**
+ * Returns true if a predicate over the field at position 'pos' of 'index' can be evaluated against
+ * the index keys alone. For a multikey index this is only the case when the path-level multikey
+ * metadata proves that no component of the field's path is an array, so that every key of a
+ * document holds the document's one value for the field.
+ */
+bool indexKeyHoldsFieldValue(const IndexEntry& index, size_t pos) {
+    if (!index.multikey) {
+        return true;
+    }
+    if (!internalQueryPlannerCoverFiltersOnNonMultikeyPaths.load() ||
+        index.type != IndexType::INDEX_BTREE || index.multikeyPaths.empty()) {
+        return false;
+    }
+    invariant(pos < index.multikeyPaths.size());
+    return index.multikeyPaths[pos].empty();
+}
+
+/**
+ * Returns true if 'expr' is a predicate from which a skip scan can build bounds over a trailing
+ * index field. Comparisons to arrays are left out, as they would need special bounds.
+ */
+bool isSkipScanPredicate(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return static_cast<const ComparisonMatchExpressionBase*>(expr)->getData().type() !=
+                BSONType::Array;
+        case MatchExpression::MATCH_IN: {
+            const auto& equalities = static_cast<const InMatchExpression*>(expr)->getEqualities();
+            return std::none_of(equalities.begin(), equalities.end(), [](auto&& elt) {
+                return elt.type() == BSONType::Array;
+            });
+        }
+        default:
+            return false;
+    }
+}
+
 }  // namespace
 
 namespace mongo {
@@ -215,7 +260,9 @@ bool isOplogTsLowerBoundPred(const mongo::MatchExpression* me) {
  * If the query solution tree contains a collection scan node with a suitable comparison
  * predicate on '_id', we add a minRecord and maxRecord on the collection node.
  */
-void handleRIDRangeScan(const MatchExpression* conjunct, CollectionScanNode* collScan) {
+void handleRIDRangeScan(const MatchExpression* conjunct,
+                        const CollatorInterface* collator,
+                        CollectionScanNode* collScan) {
     if (conjunct == nullptr) {
         return;
     }
@@ -223,7 +270,7 @@ void handleRIDRangeScan(const MatchExpression* conjunct, CollectionScanNode* col
     auto* andMatchPtr = dynamic_cast<const AndMatchExpression*>(conjunct);
     if (andMatchPtr != nullptr) {
         for (size_t index = 0; index < andMatchPtr->numChildren(); index++) {
-            handleRIDRangeScan(andMatchPtr->getChild(index), collScan);
+            handleRIDRangeScan(andMatchPtr->getChild(index), collator, collScan);
         }
         return;
     }
@@ -232,6 +279,14 @@ void handleRIDRangeScan(const MatchExpression* conjunct, CollectionScanNode* col
         return;
     }
 
+    // RecordIds compare the KeyStrings of the _id values bytewise, which only agrees with the
+    // query's comparison of collatable values when the query has the simple collation.
+    auto* comparison = dynamic_cast<const ComparisonMatchExpressionBase*>(conjunct);
+    if (!comparison ||
+        (collator && CollationIndexKey::isCollatableType(comparison->getData().type()))) {
+        return;
+    }
+
     const bool hasMaxRecord = collScan->maxRecord.has_value();
     const bool hasMinRecord = collScan->minRecord.has_value();
 
@@ -342,7 +397,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
     }
 
     if (params.allowRIDRange && !csn->resumeAfterRecordId) {
-        handleRIDRangeScan(csn->filter.get(), csn.get());
+        handleRIDRangeScan(csn->filter.get(), query.getCollator(), csn.get());
     }
 
     return csn;
@@ -428,6 +483,14 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeLeafNode(
 
         IndexBoundsBuilder::translate(expr, keyElt, index, &isn->bounds.fields[pos], tightnessOut);
 
+        // Only the bounds of regular indexes are entirely built by translating predicates, so they
+        // are the only ones which can be rebuilt for other values of the input parameters.
+        if (INDEX_BTREE == index.type) {
+            isn->boundsBuildingSteps.emplace(index.keyPattern.nFields());
+            (*isn->boundsBuildingSteps)[pos].emplace_back(
+                IndexBoundsBuilder::BoundsBuildingStep::Kind::kTranslate, expr, *tightnessOut);
+        }
+
         return isn;
     }
 }
@@ -539,6 +602,8 @@ void QueryPlannerAccess::mergeWithLeafNode(MatchExpression* expr, ScanBuildingSt
     }
 
     IndexBounds* boundsToFillOut = nullptr;
+    std::vector<std::vector<IndexBoundsBuilder::BoundsBuildingStep>>* boundsBuildingSteps =
+        nullptr;
 
     if (STAGE_GEO_NEAR_2D == type) {
         invariant(INDEX_2D == index.type);
@@ -586,6 +651,9 @@ void QueryPlannerAccess::mergeWithLeafNode(MatchExpression* expr, ScanBuildingSt
         }
 
         boundsToFillOut = &scan->bounds;
+        if (scan->boundsBuildingSteps) {
+            boundsBuildingSteps = &*scan->boundsBuildingSteps;
+        }
     }
 
     // Get the ixtag->pos-th element of the index key pattern.
@@ -603,17 +671,26 @@ void QueryPlannerAccess::mergeWithLeafNode(MatchExpression* expr, ScanBuildingSt
 
     OrderedIntervalList* oil = &boundsToFillOut->fields[pos];
 
+    using StepKind = IndexBoundsBuilder::BoundsBuildingStep::Kind;
+    StepKind stepKind;
     if (boundsToFillOut->fields[pos].name.empty()) {
         IndexBoundsBuilder::translate(expr, keyElt, index, oil, &scanState->tightness);
+        stepKind = StepKind::kTranslate;
     } else {
         if (MatchExpression::AND == mergeType) {
             IndexBoundsBuilder::translateAndIntersect(
                 expr, keyElt, index, oil, &scanState->tightness);
+            stepKind = StepKind::kIntersect;
         } else {
             verify(MatchExpression::OR == mergeType);
             IndexBoundsBuilder::translateAndUnion(expr, keyElt, index, oil, &scanState->tightness);
+            stepKind = StepKind::kUnion;
         }
     }
+
+    if (boundsBuildingSteps) {
+        (*boundsBuildingSteps)[pos].emplace_back(stepKind, expr, scanState->tightness);
+    }
 }
 
 void buildTextSubPlan(TextMatchNode* tn) {
@@ -986,11 +1063,11 @@ bool isCoveredNullQuery(const CanonicalQuery& query,
                         const vector<IndexEntry>& indices,
                         const QueryPlannerParams& params) {
     // We are only interested in queries checking for an indexed field equalling null.
-    // This optimization can only be done when the index is not multikey, otherwise empty arrays
-    // in the collection will be treated as null/undefined by the index. Additionally,
+    // This optimization can only be done when the indexed field is not multikey, otherwise empty
+    // arrays in the collection will be treated as null/undefined by the index. Additionally,
     // sparse indexes and hashed indexes should not use this optimization as they will require a
     // FETCH stage with a filter.
-    if (indices[tag->index].multikey || indices[tag->index].sparse ||
+    if (!indexKeyHoldsFieldValue(indices[tag->index], tag->pos) || indices[tag->index].sparse ||
         indices[tag->index].type == IndexType::INDEX_HASHED ||
         !ComparisonMatchExpressionBase::isEquality(root->matchType())) {
         return false;
@@ -1542,7 +1619,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::_buildIndexedDataAccess(
                 isCoveredNullQuery(query, root, tag, indices, params)) {
                 return soln;
             } else if (tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-                       !indices[tag->index].multikey) {
+                       indexKeyHoldsFieldValue(indices[tag->index], tag->pos)) {
                 verify(nullptr == soln->filter.get());
                 soln->filter = std::move(ownedRoot);
                 return soln;
@@ -1691,18 +1768,20 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
         // we know that we don't need it to create a FETCH stage.
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
     } else if (scanState->tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-               (INDEX_TEXT == index.type || !index.multikey)) {
+               (INDEX_TEXT == index.type ||
+                indexKeyHoldsFieldValue(index, scanState->ixtag->pos))) {
         // The bounds are not exact, but the information needed to
         // evaluate the predicate is in the index key. Remove the
         // MatchExpression from its parent and attach it to the filter
         // of the index scan we're building.
         //
-        // We can only use this optimization if the index is NOT multikey.
+        // We can only use this optimization if the indexed field is NOT multikey.
         // Suppose that we had the multikey index {x: 1} and a document
         // {x: ["a", "b"]}. Now if we query for {x: /b/} the filter might
         // ever only be applied to the index key "a". We'd incorrectly
         // conclude that the document does not match the query :( so we
-        // gotta stick to non-multikey indices.
+        // gotta stick to fields which the multikey metadata proves are
+        // not arrays.
         auto child = std::move((*root->getChildVector())[scanState->curChild]);
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
 
@@ -1713,6 +1792,77 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
     }
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeIndexSkipScan(
+    const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params) {
+    // Sparse and partial indexes may not hold every document the query matches, and the bounds
+    // over string values are only right when the index and the query agree on the collation.
+    if (index.type != IndexType::INDEX_BTREE || index.keyPattern.nFields() < 2 || index.sparse ||
+        index.filterExpr ||
+        !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+        return nullptr;
+    }
+
+    // Any predicate over the leading field already lets the index be used in the usual way.
+    stdx::unordered_set<std::string> fields;
+    QueryPlannerIXSelect::getFields(query.root(), &fields);
+    if (fields.count(index.keyPattern.firstElementFieldName())) {
+        return nullptr;
+    }
+
+    std::vector<const MatchExpression*> predicates;
+    if (MatchExpression::AND == query.root()->matchType()) {
+        for (size_t i = 0; i < query.root()->numChildren(); ++i) {
+            predicates.push_back(query.root()->getChild(i));
+        }
+    } else {
+        predicates.push_back(query.root());
+    }
+
+    auto isn = std::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kIndexKey];
+    isn->queryCollator = query.getCollator();
+    isn->bounds.fields.resize(index.keyPattern.nFields());
+
+    // Intersect the bounds of every predicate over a trailing field. Fields with array components
+    // are left unbounded, as intersecting the bounds of several predicates over such a field could
+    // lose documents whose array elements each satisfy a different predicate.
+    bool hasTrailingBounds = false;
+    for (auto&& predicate : predicates) {
+        if (!isSkipScanPredicate(predicate)) {
+            continue;
+        }
+        size_t pos = 0;
+        for (auto&& elt : index.keyPattern) {
+            if (pos > 0 && predicate->path() == elt.fieldNameStringData() &&
+                !index.pathHasMultikeyComponent(elt.fieldNameStringData())) {
+                auto& oil = isn->bounds.fields[pos];
+                IndexBoundsBuilder::BoundsTightness tightness;
+                if (oil.name.empty()) {
+                    IndexBoundsBuilder::translate(predicate, elt, index, &oil, &tightness);
+                } else {
+                    IndexBoundsBuilder::translateAndIntersect(
+                        predicate, elt, index, &oil, &tightness);
+                }
+                hasTrailingBounds = true;
+            }
+            ++pos;
+        }
+    }
+
+    if (!hasTrailingBounds) {
+        return nullptr;
+    }
+
+    finishLeafNode(isn.get(), index);
+
+    // The scan is only ever a superset of the matching documents, so the whole filter is applied
+    // to the fetched documents.
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return fetch;
+}
+
 std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeIndexScan(
     const IndexEntry& index,
     const CanonicalQuery& query,
@@ -112,6 +112,16 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Return a plan that scans 'index', a compound index whose leading field 'query' does not
+     * constrain, with bounds built from the predicates over its trailing fields. The index scan
+     * seeks past each distinct value of the leading field to the trailing bounds. Returns nullptr
+     * if 'index' cannot be skip scanned for 'query', or if no trailing field has a predicate.
+     */
+    static std::unique_ptr<QuerySolutionNode> makeIndexSkipScan(const IndexEntry& index,
+                                                                const CanonicalQuery& query,
+                                                                const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
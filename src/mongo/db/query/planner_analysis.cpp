@@ -40,6 +40,7 @@
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/query/projection_parser.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/logv2/log.h"
@@ -379,11 +380,33 @@ std::unique_ptr<QuerySolutionNode> addSortKeyGeneratorStageIfNeeded(
     return solnRoot;
 }
 
+/**
+ * Returns a simple inclusion projection of the top-level fields of the paths that the inclusion
+ * projection of 'query' includes. For example, {'a.b': 1, c: 1} becomes {a: 1, c: 1, _id: 0}.
+ */
+projection_ast::Projection makeTopLevelInclusion(const CanonicalQuery& query) {
+    std::set<std::string> topLevelFields;
+    for (auto&& path : query.getProj()->getRequiredFields()) {
+        topLevelFields.insert(FieldRef(path).getPart(0).toString());
+    }
+
+    BSONObjBuilder bob;
+    for (auto&& field : topLevelFields) {
+        bob.append(field, 1);
+    }
+    if (!topLevelFields.count("_id")) {
+        bob.append("_id", 0);
+    }
+    return projection_ast::parse(
+        query.getExpCtx(), bob.obj(), ProjectionPolicies::aggregateProjectionPolicies());
+}
+
 /**
  * When projection needs to be added to the solution tree, this function chooses between the default
  * implementation and one of the fast paths.
  */
 std::unique_ptr<ProjectionNode> analyzeProjection(const CanonicalQuery& query,
+                                                  const QueryPlannerParams& params,
                                                   std::unique_ptr<QuerySolutionNode> solnRoot,
                                                   const bool hasSortStage) {
     LOGV2_DEBUG(20949, 5, "PROJECTION: Current plan", "plan"_attr = redact(solnRoot->toString()));
@@ -405,6 +428,17 @@ std::unique_ptr<ProjectionNode> analyzeProjection(const CanonicalQuery& query,
     // projection can cover. Plans that don't meet all the requirements for these fast path
     // projections will all use ProjectionNodeDefault, which is able to handle all projections,
     // covered or otherwise.
+    // When the projection only lists the fields the caller depends on, a fetched plan can keep
+    // whole top-level fields rather than build a document to extract dotted paths from them.
+    if ((params.options & QueryPlannerParams::PROJECTION_IS_DEPENDENCY_SET) &&
+        solnRoot->fetched() && query.getProj()->isInclusionOnly() &&
+        !query.getProj()->isSimple()) {
+        return std::make_unique<ProjectionNodeSimple>(
+            addSortKeyGeneratorStageIfNeeded(query, hasSortStage, std::move(solnRoot)),
+            *query.root(),
+            makeTopLevelInclusion(query));
+    }
+
     if (query.getProj()->isSimple()) {
         // If the projection is simple, but not covered, use 'ProjectionNodeSimple'.
         if (solnRoot->fetched()) {
@@ -993,7 +1027,7 @@ std::unique_ptr<QuerySolution> QueryPlannerAnalysis::analyzeDataAccess(
                 ? QueryPlannerCommon::extractSortKeyMetaFieldsFromProjection(*query.getProj())
                 : std::vector<FieldPath>{});
     } else if (query.getProj()) {
-        solnRoot = analyzeProjection(query, std::move(solnRoot), hasSortStage);
+        solnRoot = analyzeProjection(query, params, std::move(solnRoot), hasSortStage);
     } else {
         // Even if there's no projection, the client may want sort key metadata.
         solnRoot = addSortKeyGeneratorStageIfNeeded(query, hasSortStage, std::move(solnRoot));
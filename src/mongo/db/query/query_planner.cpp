@@ -182,6 +182,15 @@ string optionString(size_t options) {
             case QueryPlannerParams::RETURN_OWNED_DATA:
                 ss << "RETURN_OWNED_DATA ";
                 break;
+            case QueryPlannerParams::ALLOW_PARALLEL_COLLSCAN:
+                ss << "ALLOW_PARALLEL_COLLSCAN ";
+                break;
+            case QueryPlannerParams::GENERATE_INDEX_SKIP_SCANS:
+                ss << "GENERATE_INDEX_SKIP_SCANS ";
+                break;
+            case QueryPlannerParams::PROJECTION_IS_DEPENDENCY_SET:
+                ss << "PROJECTION_IS_DEPENDENCY_SET ";
+                break;
             case QueryPlannerParams::DEFAULT:
                 MONGO_UNREACHABLE;
                 break;
@@ -320,11 +329,25 @@ static BSONObj finishMaxObj(const IndexEntry& indexEntry,
     }
 }
 
+/**
+ * Builds a solution around a collection scan. If 'allowParallelScan' is true and the scan neither
+ * has to return documents in RecordId order nor needs to remember where it stopped, it is marked
+ * as eligible for being split across several threads.
+ */
 std::unique_ptr<QuerySolution> buildCollscanSoln(const CanonicalQuery& query,
                                                  bool tailable,
-                                                 const QueryPlannerParams& params) {
+                                                 const QueryPlannerParams& params,
+                                                 bool allowParallelScan = false) {
     std::unique_ptr<QuerySolutionNode> solnRoot(
         QueryPlannerAccess::makeCollectionScan(query, tailable, params));
+    if (allowParallelScan) {
+        auto csn = static_cast<CollectionScanNode*>(solnRoot.get());
+        csn->allowParallelScan = csn->direction == 1 && !csn->tailable &&
+            !csn->shouldTrackLatestOplogTimestamp && !csn->requestResumeToken &&
+            !csn->resumeAfterRecordId && !csn->minRecord && !csn->maxRecord &&
+            !csn->assertTsHasNotFallenOffOplog && !csn->stopApplyingFilterAfterFirstMatch &&
+            !query.nss().isOplog();
+    }
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
@@ -337,6 +360,17 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const IndexEntry& index,
+                                                 const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params) {
+    std::unique_ptr<QuerySolutionNode> solnRoot(
+        QueryPlannerAccess::makeIndexSkipScan(index, query, params));
+    if (!solnRoot) {
+        return nullptr;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getFindCommandRequest().getSort().isPrefixOf(
         kp, SimpleBSONElementComparator::kInstance);
@@ -504,6 +538,15 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
         } else {
             return {std::move(soln)};
         }
+    } else if (SolutionCacheData::SKIP_IXSCAN_SOLN == winnerCacheData.solnType) {
+        // The solution can be constructed by a skip scan over the index.
+        auto soln = buildSkipScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (!soln) {
+            return Status(ErrorCodes::NoQueryExecutionPlans,
+                          "plan cache error: soln that skip scans an index");
+        } else {
+            return {std::move(soln)};
+        }
     } else if (SolutionCacheData::COLLSCAN_SOLN == winnerCacheData.solnType) {
         // The cached solution is a collection scan. We don't cache collscans
         // with tailable==true, hence the false below.
@@ -940,6 +983,38 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // A compound index whose leading field the query does not mention can still be skip scanned
+    // using the predicates over its trailing fields. How well that works depends on how many
+    // distinct leading values there are, which the planner does not know, so when the skip scans
+    // are the only indexed plans they are raced against a collection scan.
+    bool collscanRacesSkipScans = false;
+    if ((params.options & QueryPlannerParams::GENERATE_INDEX_SKIP_SCANS) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        const bool hadIndexedSolutions = !out.empty();
+        for (auto&& index : fullIndexList) {
+            if (out.size() >= params.maxIndexedSolutions) {
+                break;
+            }
+            auto soln = buildSkipScanSoln(index, query, params);
+            if (!soln) {
+                continue;
+            }
+            LOGV2_DEBUG(6108000,
+                        5,
+                        "Planner: outputting soln that skip scans an index",
+                        "solution"_attr = redact(soln->toString()));
+            PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+            indexTree->setIndexEntry(index);
+            SolutionCacheData* scd = new SolutionCacheData();
+            scd->tree.reset(indexTree);
+            scd->solnType = SolutionCacheData::SKIP_IXSCAN_SOLN;
+            soln->cacheData.reset(scd);
+            out.push_back(std::move(soln));
+            collscanRacesSkipScans = !hadIndexedSolutions && canTableScan;
+        }
+    }
+
     // An index was hinted. If there are any solutions, they use the hinted index.  If not, we
     // scan the entire index to provide results and output that as our plan.  This is the
     // desired behavior when an index is hinted that is not relevant to the query. In the case that
@@ -1109,8 +1184,14 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         return Status(ErrorCodes::NoQueryExecutionPlans, "No query solutions");
     }
 
-    if (possibleToCollscan && (collscanRequested || collScanRequired)) {
-        auto collscan = buildCollscanSoln(query, isTailable, params);
+    if (possibleToCollscan && (collscanRequested || collScanRequired || collscanRacesSkipScans)) {
+        // Only a collection scan which is the sole solution can run in parallel, since the
+        // candidates of a multi-planning trial period are all executed by the planning thread.
+        auto collscan = buildCollscanSoln(
+            query,
+            isTailable,
+            params,
+            collScanRequired && (params.options & QueryPlannerParams::ALLOW_PARALLEL_COLLSCAN));
         if (!collscan && collScanRequired) {
             return Status(ErrorCodes::NoQueryExecutionPlans,
                           "Failed to build collection scan soln");
@@ -1322,4 +1403,66 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::choosePlanForSubqueries
 
     return std::move(compositeSolution);
 }
+std::unique_ptr<QuerySolution> QueryPlanner::extendWithEqLookups(
+    const CanonicalQuery& query,
+    const QueryPlannerParams& params,
+    std::unique_ptr<QuerySolution> solution) {
+    if (query.getPipelineLookups().empty()) {
+        return solution;
+    }
+
+    // Returns the index usable for an indexed nested loop join on 'foreignField', if any. Such an
+    // index must hold a key for every foreign document, and compare strings the same way as the
+    // query. It must not be multikey either: an element of a local array which is itself an array
+    // has to match a foreign array equal to it as a whole, which a multikey index holds no key
+    // for, so those joins are left to the hash join. Among the candidates, the index with the
+    // fewest fields is preferred.
+    auto findIndexForForeignField =
+        [&](const NamespaceString& foreignCollection,
+            const std::string& foreignField) -> boost::optional<IndexEntry> {
+        auto it = params.foreignCollectionIndices.find(foreignCollection);
+        if (it == params.foreignCollectionIndices.end()) {
+            return boost::none;
+        }
+
+        const IndexEntry* best = nullptr;
+        for (auto&& entry : it->second) {
+            if (entry.type != INDEX_BTREE || entry.sparse || entry.filterExpr || entry.multikey ||
+                !CollatorInterface::collatorsMatch(entry.collator, query.getCollator())) {
+                continue;
+            }
+
+            auto firstField = entry.keyPattern.firstElement();
+            if (firstField.fieldNameStringData() != foreignField) {
+                continue;
+            }
+
+            if (!best || entry.keyPattern.nFields() < best->keyPattern.nFields()) {
+                best = &entry;
+            }
+        }
+
+        if (!best) {
+            return boost::none;
+        }
+        return *best;
+    };
+
+    auto root = solution->extractRoot();
+    for (auto&& lookup : query.getPipelineLookups()) {
+        auto idxEntry = findIndexForForeignField(lookup.foreignCollection, lookup.foreignField);
+        auto strategy = idxEntry ? EqLookupNode::LookupStrategy::kIndexedLoopJoin
+                                 : EqLookupNode::LookupStrategy::kHashJoin;
+        root = std::make_unique<EqLookupNode>(std::move(root),
+                                              lookup.foreignCollection,
+                                              lookup.localField,
+                                              lookup.foreignField,
+                                              lookup.asField,
+                                              strategy,
+                                              std::move(idxEntry));
+    }
+    solution->setRoot(std::move(root));
+    return solution;
+}
+
 }  // namespace mongo
@@ -154,5 +154,16 @@ public:
         QueryPlanner::SubqueriesPlanningResult planningResult,
         std::function<StatusWith<std::unique_ptr<QuerySolution>>(
             CanonicalQuery* cq, std::vector<std::unique_ptr<QuerySolution>>)> multiplanCallback);
+
+    /**
+     * Places an EQ_LOOKUP node above the root of 'solution' for each of the $lookup stages pushed
+     * down into 'query', choosing for each of them between an indexed nested loop join and a hash
+     * join depending on the indices of its foreign collection. Returns 'solution' unchanged if
+     * the query has no pushed down $lookup.
+     */
+    static std::unique_ptr<QuerySolution> extendWithEqLookups(
+        const CanonicalQuery& query,
+        const QueryPlannerParams& params,
+        std::unique_ptr<QuerySolution> solution);
 };
 }  // namespace mongo
@@ -33,6 +33,7 @@
 #include "mongo/db/json.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace {
 
@@ -1452,6 +1453,51 @@ TEST_F(QueryPlannerTest, CanCoverNonMultikeyDottedField) {
         "bounds: {'a.y':[[1,1,true,true]],'b.z':[[2,2,true,true]]}}}}}");
 }
 
+TEST_F(QueryPlannerTest, CanCoverInexactPredicateOnNonMultikeyFieldWithPathLevelMultikeyInfo) {
+    RAIIServerParameterControllerForTest controller{
+        "internalQueryPlannerCoverFiltersOnNonMultikeyPaths", true};
+    MultikeyPaths multikeyPaths{{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {a: /foo/, b: 2}, projection: {_id: 0, a: 1}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {ixscan: {pattern: {a: 1, b: 1}, "
+        "filter: {a: /foo/}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CannotCoverInexactPredicateOnNonMultikeyFieldWhenKnobIsOff) {
+    RAIIServerParameterControllerForTest controller{
+        "internalQueryPlannerCoverFiltersOnNonMultikeyPaths", false};
+    MultikeyPaths multikeyPaths{{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {a: /foo/, b: 2}, projection: {_id: 0, a: 1}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {fetch: {filter: {a: /foo/}, node: "
+        "{ixscan: {pattern: {a: 1, b: 1}, filter: null}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CannotCoverInexactPredicateOnMultikeyFieldWithPathLevelMultikeyInfo) {
+    RAIIServerParameterControllerForTest controller{
+        "internalQueryPlannerCoverFiltersOnNonMultikeyPaths", true};
+    MultikeyPaths multikeyPaths{{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {a: 1, b: /foo/}, projection: {_id: 0, a: 1}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {fetch: {filter: {b: /foo/}, node: "
+        "{ixscan: {pattern: {a: 1, b: 1}, filter: null}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, ContainedOrElemMatchValue) {
     addIndex(BSON("b" << 1 << "a" << 1));
     addIndex(BSON("c" << 1 << "a" << 1));
@@ -790,4 +790,42 @@ TEST_F(QueryPlannerTest, NoSortStageWhenMinMaxIndexCollationDoesNotMatchButBound
     assertSolutionExists("{fetch: {node: {ixscan: {pattern: {a: 1, b: 1, c: 1}}}}}");
 }
 
+TEST_F(QueryPlannerTest, ClusteredIdStringEqualityWithoutCollationGetsRecordIdBounds) {
+    params.allowRIDRange = true;
+
+    runQueryAsCommand(fromjson("{find: 'testns', filter: {_id: 'foo'}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {_id: 'foo'}}}");
+    auto csn = static_cast<const CollectionScanNode*>(solns[0]->root());
+    ASSERT(csn->minRecord);
+    ASSERT(csn->maxRecord);
+    ASSERT_EQ(*csn->minRecord, *csn->maxRecord);
+}
+
+TEST_F(QueryPlannerTest, ClusteredIdStringComparisonWithCollationGetsNoRecordIdBounds) {
+    params.allowRIDRange = true;
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {_id: {$gte: 'a', $lt: 'foo'}}, "
+                 "collation: {locale: 'reverse'}}"));
+
+    assertNumSolutions(1U);
+    auto csn = static_cast<const CollectionScanNode*>(solns[0]->root());
+    ASSERT_FALSE(csn->minRecord);
+    ASSERT_FALSE(csn->maxRecord);
+}
+
+TEST_F(QueryPlannerTest, ClusteredIdNumericComparisonWithCollationGetsRecordIdBounds) {
+    params.allowRIDRange = true;
+
+    runQueryAsCommand(fromjson(
+        "{find: 'testns', filter: {_id: {$gte: 1, $lt: 5}}, collation: {locale: 'reverse'}}"));
+
+    assertNumSolutions(1U);
+    auto csn = static_cast<const CollectionScanNode*>(solns[0]->root());
+    ASSERT(csn->minRecord);
+    ASSERT(csn->maxRecord);
+}
+
 }  // namespace
@@ -1210,6 +1210,51 @@ TEST_F(QueryPlannerTest, EmptyQueryWithProjectionDoesNotUseCoveredIxscanOnCompou
         "{cscan: {dir: 1}}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScansIndexWithUnconstrainedLeadingFieldIfEnabled) {
+    params.options |= QueryPlannerParams::GENERATE_INDEX_SKIP_SCANS;
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+    runQuery(fromjson("{ts: {$gte: 5, $lt: 10}}"));
+    assertNumSolutions(2);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {tenant: 1, ts: 1}, bounds: "
+        "{tenant: [['MinKey', 'MaxKey', true, true]], ts: [[5, 10, true, false]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, DoesNotSkipScanIndexIfDisabled) {
+    params.options &= ~QueryPlannerParams::GENERATE_INDEX_SKIP_SCANS;
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+    runQuery(fromjson("{ts: {$gte: 5, $lt: 10}}"));
+    assertNumSolutions(1);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, DoesNotSkipScanIndexWhenLeadingFieldIsConstrained) {
+    params.options |= QueryPlannerParams::GENERATE_INDEX_SKIP_SCANS;
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+    runQuery(fromjson("{tenant: {$gt: 1}, ts: 5}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {tenant: 1, ts: 1}, bounds: "
+        "{tenant: [[1, Infinity, false, true]], ts: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, DoesNotSkipScanIndexOverMultikeyTrailingField) {
+    params.options |= QueryPlannerParams::GENERATE_INDEX_SKIP_SCANS;
+    addIndex(BSON("tenant" << 1 << "ts" << 1), MultikeyPaths{{}, {0U}});
+    runQuery(fromjson("{ts: 5}"));
+    assertNumSolutions(1);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, DoesNotSkipScanSparseIndex) {
+    params.options |= QueryPlannerParams::GENERATE_INDEX_SKIP_SCANS;
+    addIndex(BSON("tenant" << 1 << "ts" << 1), false /* multikey */, true /* sparse */);
+    runQuery(fromjson("{ts: 5}"));
+    assertNumSolutions(1);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
 TEST_F(QueryPlannerTest, EmptyQueryWithProjectionDoesNotConsiderNonHintedIndices) {
     params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     addIndex(BSON("a" << 1));
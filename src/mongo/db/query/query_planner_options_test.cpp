@@ -935,5 +935,72 @@ TEST_F(QueryPlannerTest, PreserveRecordIdOptionPrecludesSimpleSort) {
         "{sort: {pattern: {a: 1}, limit: 0, type: 'default', node: {cscan: {dir: 1}}}}");
 }
 
+TEST_F(QueryPlannerTest, AllowParallelCollscanOptionMarksSoleCollscan) {
+    params.options |= QueryPlannerParams::ALLOW_PARALLEL_COLLSCAN;
+
+    runQuery(fromjson("{a: 1}"));
+    assertHasOnlyCollscan();
+    ASSERT_TRUE(static_cast<const CollectionScanNode*>(solns.front()->root())->allowParallelScan);
+}
+
+TEST_F(QueryPlannerTest, AllowParallelCollscanOptionIgnoredWhenCollscanCompetesWithIndexedPlans) {
+    params.options |= QueryPlannerParams::ALLOW_PARALLEL_COLLSCAN;
+    addIndex(BSON("a" << 1));
+
+    runQuery(fromjson("{a: 1}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {a: 1}}}");
+    for (auto&& soln : solns) {
+        if (soln->root()->getType() == STAGE_COLLSCAN) {
+            ASSERT_FALSE(static_cast<const CollectionScanNode*>(soln->root())->allowParallelScan);
+        }
+    }
+}
+
+TEST_F(QueryPlannerTest, AllowParallelCollscanOptionIgnoredForReverseCollscan) {
+    params.options |= QueryPlannerParams::ALLOW_PARALLEL_COLLSCAN;
+
+    runQueryAsCommand(fromjson("{find: 'testns', filter: {a: 1}, hint: {$natural: -1}}"));
+    assertHasOnlyCollscan();
+    ASSERT_FALSE(static_cast<const CollectionScanNode*>(solns.front()->root())->allowParallelScan);
+}
+
+TEST_F(QueryPlannerTest, DependencyProjectionOfDottedPathsKeepsTopLevelFields) {
+    params.options |= QueryPlannerParams::PROJECTION_IS_DEPENDENCY_SET;
+
+    runQuerySortProj(fromjson("{x: 1}"), BSONObj(), fromjson("{_id: 0, 'a.b': 1, 'a.c': 1, d: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1, d: 1}, type: 'simple', node: {cscan: {dir: 1}}}}");
+}
+
+TEST_F(QueryPlannerTest, DependencyProjectionKeepsIdWhenDependedOn) {
+    params.options |= QueryPlannerParams::PROJECTION_IS_DEPENDENCY_SET;
+
+    runQuerySortProj(fromjson("{x: 1}"), BSONObj(), fromjson("{'_id.a': 1, 'b.c': 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{proj: {spec: {_id: 1, b: 1}, type: 'simple', node: {cscan: {dir: 1}}}}");
+}
+
+TEST_F(QueryPlannerTest, DependencyProjectionOfDottedPathsStillCoveredByIndex) {
+    params.options |= QueryPlannerParams::PROJECTION_IS_DEPENDENCY_SET;
+    addIndex(BSON("a.b" << 1));
+
+    runQuerySortProj(fromjson("{'a.b': {$gt: 0}}"), BSONObj(), fromjson("{_id: 0, 'a.b': 1}"));
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, type: 'simple', node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, 'a.b': 1}, type: 'default', node: "
+        "{ixscan: {pattern: {'a.b': 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, DottedInclusionProjectionUsesDefaultImplementationWithoutOption) {
+    runQuerySortProj(fromjson("{x: 1}"), BSONObj(), fromjson("{_id: 0, 'a.b': 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, 'a.b': 1}, type: 'default', node: {cscan: {dir: 1}}}}");
+}
+
 }  // namespace
 }  // namespace mongo
@@ -31,7 +31,10 @@
 
 #include <vector>
 
+#include <map>
+
 #include "mongo/db/jsobj.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/query/index_entry.h"
 #include "mongo/db/query/query_knobs_gen.h"
 
@@ -123,6 +126,20 @@ struct QueryPlannerParams {
         // Ensure that any plan generated returns data that is "owned." That is, all BSONObjs are
         // in an "owned" state and are not pointing to data that belongs to the storage engine.
         RETURN_OWNED_DATA = 1 << 13,
+
+        // Set this when the caller does not depend on the order in which documents are returned,
+        // for example because they all feed a $group. A collection scan which ends up being the
+        // only solution may then be executed by several threads in parallel.
+        ALLOW_PARALLEL_COLLSCAN = 1 << 14,
+
+        // Set this to generate skip scans over compound indexes whose leading field the query
+        // does not constrain, for queries that have predicates over the trailing fields.
+        GENERATE_INDEX_SKIP_SCANS = 1 << 15,
+
+        // Set this when the projection only lists the fields that the caller depends on, so that
+        // results may hold more of a top-level field than the projection includes. Fetched plans
+        // may then copy the top-level fields of dotted inclusions instead of extracting the paths.
+        PROJECTION_IS_DEPENDENCY_SET = 1 << 16,
     };
 
     // See Options enum above.
@@ -131,6 +148,10 @@ struct QueryPlannerParams {
     // What indices are available for planning?
     std::vector<IndexEntry> indices;
 
+    // The indices available on the foreign collection of each $lookup pushed down into the query.
+    // There is no entry for a foreign collection which does not exist.
+    std::map<NamespaceString, std::vector<IndexEntry>> foreignCollectionIndices;
+
     // What's our shard key?  If INCLUDE_SHARD_FILTER is set we will create a shard filtering
     // stage.  If we know the shard key, we can perform covering analysis instead of always
     // forcing a fetch.
@@ -167,6 +167,20 @@ void QuerySolution::setRoot(std::unique_ptr<QuerySolutionNode> root) {
     assignNodeIds(idGenerator, *_root);
 }
 
+std::unique_ptr<QuerySolution> QuerySolution::clone() const {
+    auto soln = std::make_unique<QuerySolution>();
+    if (_root) {
+        soln->setRoot(std::unique_ptr<QuerySolutionNode>(_root->clone()));
+    }
+    soln->hasBlockingStage = hasBlockingStage;
+    soln->indexFilterApplied = indexFilterApplied;
+    if (cacheData) {
+        soln->cacheData = cacheData->clone();
+    }
+    soln->_enumeratorExplainInfo = _enumeratorExplainInfo;
+    return soln;
+}
+
 //
 // CollectionScanNode
 //
@@ -182,6 +196,10 @@ void CollectionScanNode::appendToString(str::stream* ss, int indent) const {
         addIndent(ss, indent + 1);
         *ss << "filter = " << filter->debugString();
     }
+    if (allowParallelScan) {
+        addIndent(ss, indent + 1);
+        *ss << "allowParallelScan = true\n";
+    }
     addCommon(ss, indent);
 }
 
@@ -195,6 +213,7 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->shouldTrackLatestOplogTimestamp = this->shouldTrackLatestOplogTimestamp;
     copy->assertTsHasNotFallenOffOplog = this->assertTsHasNotFallenOffOplog;
     copy->shouldWaitForOplogVisibility = this->shouldWaitForOplogVisibility;
+    copy->allowParallelScan = this->allowParallelScan;
 
     return copy;
 }
@@ -912,6 +931,16 @@ QuerySolutionNode* IndexScanNode::clone() const {
     copy->direction = this->direction;
     copy->addKeyMetadata = this->addKeyMetadata;
     copy->bounds = this->bounds;
+    if (this->boundsBuildingSteps) {
+        copy->boundsBuildingSteps.emplace();
+        auto& fieldSteps = *copy->boundsBuildingSteps;
+        for (auto&& steps : *this->boundsBuildingSteps) {
+            auto& copiedSteps = fieldSteps.emplace_back();
+            for (auto&& step : steps) {
+                copiedSteps.push_back(step.clone());
+            }
+        }
+    }
     copy->queryCollator = this->queryCollator;
 
     return copy;
@@ -1231,6 +1260,54 @@ QuerySolutionNode* ShardingFilterNode::clone() const {
     return copy;
 }
 
+//
+// EqLookupNode
+//
+
+StringData EqLookupNode::serializeLookupStrategy(LookupStrategy strategy) {
+    switch (strategy) {
+        case LookupStrategy::kIndexedLoopJoin:
+            return "IndexedLoopJoin"_sd;
+        case LookupStrategy::kHashJoin:
+            return "HashJoin"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void EqLookupNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "EQ_LOOKUP\n";
+    addIndent(ss, indent + 1);
+    *ss << "from = " << foreignCollection.toString() << "\n";
+    addIndent(ss, indent + 1);
+    *ss << "as = " << joinField << "\n";
+    addIndent(ss, indent + 1);
+    *ss << "localField = " << joinFieldLocal << "\n";
+    addIndent(ss, indent + 1);
+    *ss << "foreignField = " << joinFieldForeign << "\n";
+    addIndent(ss, indent + 1);
+    *ss << "strategy = " << serializeLookupStrategy(lookupStrategy) << "\n";
+    if (idxEntry) {
+        addIndent(ss, indent + 1);
+        *ss << "indexName = " << idxEntry->identifier.catalogName << "\n";
+    }
+    addCommon(ss, indent);
+    addIndent(ss, indent + 1);
+    *ss << "Child:" << '\n';
+    children[0]->appendToString(ss, indent + 2);
+}
+
+QuerySolutionNode* EqLookupNode::clone() const {
+    auto copy = new EqLookupNode(std::unique_ptr<QuerySolutionNode>(children[0]->clone()),
+                                 foreignCollection,
+                                 joinFieldLocal,
+                                 joinFieldForeign,
+                                 joinField,
+                                 lookupStrategy,
+                                 idxEntry);
+    return copy;
+}
+
 //
 // DistinctNode
 //
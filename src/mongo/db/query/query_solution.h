@@ -37,6 +37,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_enumerator_explain_info.h"
 #include "mongo/db/query/stage_types.h"
@@ -362,6 +363,19 @@ public:
      */
     void setRoot(std::unique_ptr<QuerySolutionNode> root);
 
+    /**
+     * Returns a deep copy of this solution. The nodes of the copy have the same ids as the ones of
+     * this solution.
+     */
+    std::unique_ptr<QuerySolution> clone() const;
+
+    /**
+     * Releases the ownership of the root of this QuerySolution, which is left empty.
+     */
+    std::unique_ptr<QuerySolutionNode> extractRoot() {
+        return std::move(_root);
+    }
+
     // There are two known scenarios in which a query solution might potentially block:
     //
     // Sort stage:
@@ -452,6 +466,10 @@ struct CollectionScanNode : public QuerySolutionNodeWithSortSet {
 
     // Once the first matching document is found, assume that all documents after it must match.
     bool stopApplyingFilterAfterFirstMatch = false;
+
+    // If true, the scan may be split into RecordId ranges which are read by several threads, so
+    // the documents are returned in no particular order.
+    bool allowParallelScan = false;
 };
 
 /**
@@ -675,6 +693,12 @@ struct IndexScanNode : public QuerySolutionNodeWithSortSet {
 
     IndexBounds bounds;
 
+    // For each field of 'bounds', the steps the bounds were built with, so that they can be rebuilt
+    // after binding the input parameters of the query to other constants. Not set when the bounds
+    // were built by other means, in which case they cannot be rebuilt.
+    boost::optional<std::vector<std::vector<IndexBoundsBuilder::BoundsBuildingStep>>>
+        boundsBuildingSteps;
+
     const CollatorInterface* queryCollator;
 
     // The set of paths in the index key pattern which have at least one multikey path component, or
@@ -1092,6 +1116,83 @@ struct ShardingFilterNode : public QuerySolutionNode {
     QuerySolutionNode* clone() const;
 };
 
+/**
+ * Joins every document produced by its child with the documents of 'foreignCollection' whose
+ * 'joinFieldForeign' equals the 'joinFieldLocal' of the child document, following the semantics of
+ * $lookup with the localField/foreignField syntax. The matching foreign documents are stored as an
+ * array in the 'joinField' of the output document.
+ */
+struct EqLookupNode : public QuerySolutionNode {
+    enum class LookupStrategy {
+        // Seek into an index of the foreign collection whose leading field is 'joinFieldForeign',
+        // once for each local document.
+        kIndexedLoopJoin,
+        // Build a hash table over the whole foreign collection and probe it with each local
+        // document.
+        kHashJoin,
+    };
+
+    static StringData serializeLookupStrategy(LookupStrategy strategy);
+
+    EqLookupNode(std::unique_ptr<QuerySolutionNode> child,
+                 const NamespaceString& foreignCollection,
+                 const std::string& joinFieldLocal,
+                 const std::string& joinFieldForeign,
+                 const std::string& joinField,
+                 LookupStrategy lookupStrategy,
+                 boost::optional<IndexEntry> idxEntry)
+        : QuerySolutionNode(std::move(child)),
+          foreignCollection(foreignCollection),
+          joinFieldLocal(joinFieldLocal),
+          joinFieldForeign(joinFieldForeign),
+          joinField(joinField),
+          lookupStrategy(lookupStrategy),
+          idxEntry(std::move(idxEntry)) {}
+
+    StageType getType() const final {
+        return STAGE_EQ_LOOKUP;
+    }
+
+    void appendToString(str::stream* ss, int indent) const final;
+
+    bool fetched() const final {
+        return children[0]->fetched();
+    }
+
+    FieldAvailability getFieldAvailability(const std::string& field) const final {
+        if (field == joinField) {
+            return FieldAvailability::kFullyProvided;
+        }
+        return children[0]->getFieldAvailability(field);
+    }
+
+    bool sortedByDiskLoc() const final {
+        return children[0]->sortedByDiskLoc();
+    }
+
+    const ProvidedSortSet& providedSorts() const final {
+        return children[0]->providedSorts();
+    }
+
+    QuerySolutionNode* clone() const final;
+
+    // The foreign (inner) collection, in the same database as the local (outer) collection.
+    NamespaceString foreignCollection;
+
+    // The top-level fields used to match the local and the foreign documents.
+    std::string joinFieldLocal;
+    std::string joinFieldForeign;
+
+    // The top-level field of the output documents which holds the array of matching foreign
+    // documents.
+    std::string joinField;
+
+    LookupStrategy lookupStrategy;
+
+    // The index of the foreign collection used by the 'kIndexedLoopJoin' strategy.
+    boost::optional<IndexEntry> idxEntry;
+};
+
 /**
  * Distinct queries only want one value for a given field.  We run an index scan but
  * *always* skip over the current key to the next key.
@@ -137,6 +137,9 @@ CandidatePlans CachedSolutionPlanner::replan(bool shouldCache, std::string reaso
 
     // Use the query planning module to plan the whole query.
     auto solutions = uassertStatusOK(QueryPlanner::plan(_cq, _queryParams));
+    for (auto&& solution : solutions) {
+        solution = QueryPlanner::extendWithEqLookups(_cq, _queryParams, std::move(solution));
+    }
     if (solutions.size() == 1) {
         // Only one possible plan. Build the stages from the solution.
         auto [root, data] = buildExecutableTree(*solutions[0]);
@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_plan_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/stage_builder_util.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo::sbe {
+namespace {
+const auto getPlanCache = ServiceContext::declareDecoration<PlanCache>();
+
+/**
+ * Fields of the find command which do not influence the tree built for it, and therefore must not
+ * prevent two operations running the same query from sharing a cache entry.
+ */
+const StringDataSet kNonPlanFields{FindCommandRequest::kAllowPartialResultsFieldName,
+                                   FindCommandRequest::kAllowSpeculativeMajorityReadFieldName,
+                                   FindCommandRequest::kBatchSizeFieldName,
+                                   FindCommandRequest::kDbNameFieldName,
+                                   FindCommandRequest::kLegacyRuntimeConstantsFieldName,
+                                   FindCommandRequest::kMaxTimeMSFieldName,
+                                   FindCommandRequest::kNoCursorTimeoutFieldName,
+                                   FindCommandRequest::kReadConcernFieldName,
+                                   FindCommandRequest::kSingleBatchFieldName,
+                                   FindCommandRequest::kTermFieldName,
+                                   FindCommandRequest::kUnwrappedReadPrefFieldName};
+}  // namespace
+
+PlanCache& PlanCache::get(ServiceContext* serviceContext) {
+    return getPlanCache(serviceContext);
+}
+
+bool PlanCache::shouldCacheQuery(const CanonicalQuery& cq, size_t plannerOptions) {
+    if (internalQuerySlotBasedExecutionPlanCacheSize.load() == 0) {
+        return false;
+    }
+
+    // The shard filter and the oplog timestamp tracking capture state of the operation which built
+    // the tree.
+    if (plannerOptions &
+        (QueryPlannerParams::INCLUDE_SHARD_FILTER | QueryPlannerParams::TRACK_LATEST_OPLOG_TS)) {
+        return false;
+    }
+
+    const auto& findCommand = cq.getFindCommandRequest();
+    if (findCommand.getTailable() || !findCommand.getResumeAfter().isEmpty() ||
+        findCommand.getRequestResumeToken()) {
+        return false;
+    }
+
+    // Lookups lowered into the tree read from foreign collections, whose plan caches are not
+    // tracked by the entries.
+    return cq.getPipelineLookups().empty();
+}
+
+std::string PlanCache::computeKey(const CollectionPtr& collection,
+                                  const CanonicalQuery& cq,
+                                  const PlanCacheKey& planCacheKey,
+                                  size_t plannerOptions) {
+    BSONObjBuilder bob;
+    collection->uuid().appendToBuilder(&bob, "uuid");
+    bob.append("shape", planCacheKey.toString());
+    bob.append("plannerOptions", static_cast<long long>(plannerOptions));
+
+    BSONObjBuilder queryBob{bob.subobjStart("query")};
+    for (auto&& elem : cq.getFindCommandRequest().toBSON({})) {
+        if (!kNonPlanFields.count(elem.fieldNameStringData())) {
+            queryBob.append(elem);
+        }
+    }
+    queryBob.doneFast();
+
+    auto key = bob.obj();
+    return {key.objdata(), static_cast<size_t>(key.objsize())};
+}
+
+PlanCache::PlanCache() : PlanCache(internalQuerySlotBasedExecutionPlanCacheSize.load()) {}
+
+PlanCache::PlanCache(size_t size) : _cache(size) {}
+
+boost::optional<PlanCache::CachedPlan> PlanCache::get(OperationContext* opCtx,
+                                                      const CanonicalQuery& cq,
+                                                      const std::string& key,
+                                                      uint64_t planCacheVersion,
+                                                      PlanYieldPolicy* yieldPolicy) {
+    EntryPtr entry;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        EntryPtr* found;
+        if (!_cache.get(key, &found).isOK()) {
+            return boost::none;
+        }
+        entry = *found;
+
+        if (entry->planCacheVersion != planCacheVersion) {
+            // The plan cache has changed since the entry was created, so the tree may no longer be
+            // the one the planner would choose. The entry itself is destroyed outside the mutex.
+            _cache.remove(key).ignore();
+            return boost::none;
+        }
+    }
+
+    return CachedPlan{stage_builder::cloneSlotBasedExecutableTree(
+                          opCtx, cq, *entry->root, entry->data, yieldPolicy),
+                      entry->solution->clone()};
+}
+
+void PlanCache::set(const std::string& key,
+                    const PlanStage& root,
+                    const stage_builder::PlanStageData& data,
+                    const QuerySolution& solution,
+                    uint64_t planCacheVersion) {
+    auto entry = std::make_shared<const Entry>(
+        Entry{root.clone(), data.makeCopy(), solution.clone(), planCacheVersion});
+
+    std::unique_ptr<EntryPtr> evicted;
+    stdx::lock_guard<Latch> lk(_mutex);
+    evicted = _cache.add(key, new EntryPtr(std::move(entry)));
+}
+
+void PlanCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _cache.clear();
+}
+
+size_t PlanCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _cache.size();
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/query/lru_key_value.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+class CollectionPtr;
+class OperationContext;
+class ServiceContext;
+
+namespace sbe {
+/**
+ * A process-wide cache of SBE execution trees. While the classic PlanCache only remembers the
+ * winning QuerySolution for a query shape, this cache keeps the tree built from it for one exact
+ * query (i.e. the shape and all of its constants), so that repeats of that query skip recovering
+ * the solution from the plan cache and building the stages.
+ *
+ * Every entry is tagged with the version of the collection's PlanCache it was derived from and is
+ * only used while that version is current. Changes to the plan cache, such as a new winning plan
+ * or an index build, therefore implicitly invalidate the affected entries.
+ *
+ * The cached trees are never executed. Callers get a clone which they own exclusively.
+ */
+class PlanCache {
+public:
+    /**
+     * An executable tree along with the solution it was built from.
+     */
+    struct CachedPlan {
+        std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData> root;
+        std::unique_ptr<QuerySolution> solution;
+    };
+
+    static PlanCache& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns whether the tree built for 'cq' only depends on the query itself, in which case it
+     * can be reused by later operations running the same query.
+     */
+    static bool shouldCacheQuery(const CanonicalQuery& cq, size_t plannerOptions);
+
+    /**
+     * Computes the key identifying the exact query 'cq' against 'collection'. The 'planCacheKey' is
+     * the key of the query shape in the collection's PlanCache.
+     */
+    static std::string computeKey(const CollectionPtr& collection,
+                                  const CanonicalQuery& cq,
+                                  const PlanCacheKey& planCacheKey,
+                                  size_t plannerOptions);
+
+    /**
+     * Creates a cache sized by 'internalQuerySlotBasedExecutionPlanCacheSize'.
+     */
+    PlanCache();
+
+    explicit PlanCache(size_t size);
+
+    /**
+     * Returns a clone of the tree cached for 'key', ready to be executed by the operation running
+     * 'cq'. Returns boost::none if there is no such tree, or if it was derived from a version of
+     * the plan cache other than 'planCacheVersion'.
+     */
+    boost::optional<CachedPlan> get(OperationContext* opCtx,
+                                    const CanonicalQuery& cq,
+                                    const std::string& key,
+                                    uint64_t planCacheVersion,
+                                    PlanYieldPolicy* yieldPolicy);
+
+    /**
+     * Caches a copy of the not yet prepared 'root' tree built from 'solution' for 'key'.
+     */
+    void set(const std::string& key,
+             const PlanStage& root,
+             const stage_builder::PlanStageData& data,
+             const QuerySolution& solution,
+             uint64_t planCacheVersion);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::unique_ptr<PlanStage> root;
+        stage_builder::PlanStageData data;
+        std::unique_ptr<QuerySolution> solution;
+
+        // Version of the collection's PlanCache this entry was derived from.
+        uint64_t planCacheVersion;
+    };
+
+    // Entries are shared so that they can be cloned without holding the mutex, even if they are
+    // evicted concurrently.
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    LRUKeyValue<std::string, EntryPtr> _cache;
+
+    // Protects '_cache'.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("sbe::PlanCache::_mutex");
+};
+}  // namespace sbe
+}  // namespace mongo
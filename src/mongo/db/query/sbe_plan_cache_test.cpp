@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file contains tests for sbe::PlanCache.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/plan_yield_policy_sbe.h"
+#include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/sbe_plan_cache.h"
+#include "mongo/db/query/sbe_stage_builder_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/clock_source_mock.h"
+
+namespace mongo {
+namespace {
+const NamespaceString kTestNss("TestDB", "TestColl");
+
+class SbePlanCacheTest : public SbeStageBuilderTestFixture {
+protected:
+    std::unique_ptr<CanonicalQuery> makeQuery(BSONObj filter) {
+        auto findCommand = std::make_unique<FindCommandRequest>(kTestNss);
+        findCommand->setFilter(filter);
+        const boost::intrusive_ptr<ExpressionContext> expCtx(
+            new ExpressionContextForTest(kTestNss));
+        auto statusWithCQ =
+            CanonicalQuery::canonicalize(opCtx(), std::move(findCommand), false, expCtx);
+        ASSERT_OK(statusWithCQ.getStatus());
+        return std::move(statusWithCQ.getValue());
+    }
+
+    std::unique_ptr<PlanYieldPolicySBE> makeYieldPolicy() {
+        return std::make_unique<PlanYieldPolicySBE>(PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                                    &_clock,
+                                                    0,
+                                                    Milliseconds::zero(),
+                                                    nullptr,
+                                                    nullptr);
+    }
+
+    /**
+     * Builds the tree for a virtual scan over 'docs' and stores it in 'cache' under 'key'.
+     */
+    void addEntry(sbe::PlanCache& cache,
+                  const std::string& key,
+                  const std::vector<BSONArray>& docs,
+                  uint64_t planCacheVersion) {
+        auto solution = makeQuerySolution(
+            std::make_unique<VirtualScanNode>(docs, VirtualScanNode::ScanType::kCollScan, false));
+        auto [resultSlots, stage, data] = buildPlanStage(std::move(solution), false, nullptr);
+        auto cachedSolution = makeQuerySolution(
+            std::make_unique<VirtualScanNode>(docs, VirtualScanNode::ScanType::kCollScan, false));
+        cache.set(key, *stage, data, *cachedSolution, planCacheVersion);
+    }
+
+    /**
+     * Executes a tree returned by the cache and asserts that it produces 'expected'.
+     */
+    void assertResults(sbe::PlanCache::CachedPlan& cachedPlan, const BSONArray& expected) {
+        auto& [stage, data] = cachedPlan.root;
+        auto resultSlot = data.outputs.get(stage_builder::PlanStageSlots::kResult);
+        auto resultAccessors = prepareTree(&data.ctx, stage.get(), sbe::makeSV(resultSlot));
+        auto [resultsTag, resultsVal] = getAllResults(stage.get(), resultAccessors[0]);
+        sbe::value::ValueGuard resultGuard{resultsTag, resultsVal};
+
+        auto [expectedTag, expectedVal] = stage_builder::makeValue(expected);
+        sbe::value::ValueGuard expectedGuard{expectedTag, expectedVal};
+        ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
+    }
+
+private:
+    ClockSourceMock _clock;
+};
+
+TEST_F(SbePlanCacheTest, CachedTreeCanBeExecutedRepeatedly) {
+    sbe::PlanCache cache{10};
+    auto docs = std::vector<BSONArray>{BSON_ARRAY(BSON("a" << 1)), BSON_ARRAY(BSON("a" << 2))};
+    addEntry(cache, "key", docs, 1);
+    ASSERT_EQ(cache.size(), 1U);
+
+    auto cq = makeQuery(BSON("a" << 1));
+    auto yieldPolicy = makeYieldPolicy();
+    for (int i = 0; i < 2; ++i) {
+        auto cachedPlan = cache.get(opCtx(), *cq, "key", 1, yieldPolicy.get());
+        ASSERT(cachedPlan);
+        ASSERT(cachedPlan->solution);
+        assertResults(*cachedPlan, BSON_ARRAY(BSON("a" << 1) << BSON("a" << 2)));
+    }
+}
+
+TEST_F(SbePlanCacheTest, LookupMissesForUnknownKey) {
+    sbe::PlanCache cache{10};
+    addEntry(cache, "key", {BSON_ARRAY(BSON("a" << 1))}, 1);
+
+    auto cq = makeQuery(BSON("a" << 1));
+    auto yieldPolicy = makeYieldPolicy();
+    ASSERT_FALSE(cache.get(opCtx(), *cq, "otherKey", 1, yieldPolicy.get()));
+    ASSERT_EQ(cache.size(), 1U);
+}
+
+TEST_F(SbePlanCacheTest, StaleEntryIsRemovedOnLookup) {
+    sbe::PlanCache cache{10};
+    addEntry(cache, "key", {BSON_ARRAY(BSON("a" << 1))}, 1);
+
+    auto cq = makeQuery(BSON("a" << 1));
+    auto yieldPolicy = makeYieldPolicy();
+    ASSERT_FALSE(cache.get(opCtx(), *cq, "key", 2, yieldPolicy.get()));
+    ASSERT_EQ(cache.size(), 0U);
+}
+
+TEST_F(SbePlanCacheTest, LeastRecentlyUsedEntryIsEvicted) {
+    sbe::PlanCache cache{1};
+    addEntry(cache, "key1", {BSON_ARRAY(BSON("a" << 1))}, 1);
+    addEntry(cache, "key2", {BSON_ARRAY(BSON("a" << 2))}, 1);
+    ASSERT_EQ(cache.size(), 1U);
+
+    auto cq = makeQuery(BSON("a" << 1));
+    auto yieldPolicy = makeYieldPolicy();
+    ASSERT_FALSE(cache.get(opCtx(), *cq, "key1", 1, yieldPolicy.get()));
+
+    auto cachedPlan = cache.get(opCtx(), *cq, "key2", 1, yieldPolicy.get());
+    ASSERT(cachedPlan);
+    assertResults(*cachedPlan, BSON_ARRAY(BSON("a" << 2)));
+}
+
+TEST_F(SbePlanCacheTest, QueriesDependingOnOperationStateAreNotCached) {
+    auto cq = makeQuery(BSON("a" << 1));
+    ASSERT_TRUE(sbe::PlanCache::shouldCacheQuery(*cq, QueryPlannerParams::DEFAULT));
+    ASSERT_FALSE(sbe::PlanCache::shouldCacheQuery(*cq, QueryPlannerParams::INCLUDE_SHARD_FILTER));
+    ASSERT_FALSE(sbe::PlanCache::shouldCacheQuery(*cq, QueryPlannerParams::TRACK_LATEST_OPLOG_TS));
+}
+}  // namespace
+}  // namespace mongo
@@ -34,10 +34,14 @@
 #include "mongo/db/query/sbe_stage_builder.h"
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/exec/sbe/stages/co_scan.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 #include "mongo/db/exec/sbe/stages/hash_join.h"
+#include "mongo/db/exec/sbe/stages/hash_lookup.h"
+#include "mongo/db/exec/sbe/stages/ix_scan.h"
 #include "mongo/db/exec/sbe/stages/limit_skip.h"
 #include "mongo/db/exec/sbe/stages/loop_join.h"
 #include "mongo/db/exec/sbe/stages/makeobj.h"
@@ -49,6 +53,7 @@
 #include "mongo/db/exec/sbe/stages/traverse.h"
 #include "mongo/db/exec/sbe/stages/union.h"
 #include "mongo/db/exec/sbe/stages/unique.h"
+#include "mongo/db/exec/sbe/stages/unwind.h"
 #include "mongo/db/exec/sbe/values/sort_spec.h"
 #include "mongo/db/exec/shard_filterer.h"
 #include "mongo/db/fts/fts_index_format.h"
@@ -373,6 +378,35 @@ std::unique_ptr<sbe::RuntimeEnvironment> makeRuntimeEnvironment(
     return env;
 }
 
+void refreshRuntimeEnvironment(const CanonicalQuery& cq,
+                               OperationContext* opCtx,
+                               sbe::RuntimeEnvironment* env) {
+    env->resetSlot(
+        env->getSlot("timeZoneDB"_sd),
+        sbe::value::TypeTags::timeZoneDB,
+        sbe::value::bitcastFrom<const TimeZoneDatabase*>(getTimeZoneDatabase(opCtx)),
+        false);
+
+    // The collator is owned by the query, so it has to be re-pointed at the one of 'cq'.
+    if (auto slot = env->getSlotIfExists("collator"_sd); slot) {
+        invariant(cq.getCollator());
+        env->resetSlot(*slot,
+                       sbe::value::TypeTags::collator,
+                       sbe::value::bitcastFrom<const CollatorInterface*>(cq.getCollator()),
+                       false);
+    }
+
+    for (auto&& [id, name] : Variables::kIdToBuiltinVarName) {
+        if (id != Variables::kRootId && id != Variables::kRemoveId &&
+            cq.getExpCtx()->variables.hasValue(id)) {
+            if (auto slot = env->getSlotIfExists(name); slot) {
+                auto [tag, val] = makeValue(cq.getExpCtx()->variables.getValue(id));
+                env->resetSlot(*slot, tag, val, true);
+            }
+        }
+    }
+}
+
 PlanStageSlots::PlanStageSlots(const PlanStageReqs& reqs,
                                sbe::value::SlotIdGenerator* slotIdGenerator) {
     for (auto&& [slotName, isRequired] : reqs._slots) {
@@ -397,6 +431,17 @@ std::string PlanStageData::debugString() const {
     return builder.str();
 }
 
+PlanStageData PlanStageData::makeCopy() const {
+    PlanStageData data{env->makeDeepCopy()};
+    data.outputs = outputs;
+    data.iamMap = iamMap;
+    data.shouldTrackLatestOplogTimestamp = shouldTrackLatestOplogTimestamp;
+    data.shouldTrackResumeToken = shouldTrackResumeToken;
+    data.shouldUseTailableScan = shouldUseTailableScan;
+    data.replanReason = replanReason;
+    return data;
+}
+
 namespace {
 void getAllNodesByTypeHelper(const QuerySolutionNode* root,
                              StageType type,
@@ -1905,6 +1950,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                         innerCondSlots,
                                                         innerProjectSlots,
                                                         collatorSlot,
+                                                        _cq.getExpCtx()->allowDiskUse,
                                                         root->nodeId());
 
     // If there are more than 2 children, iterate all remaining children and hash
@@ -1927,6 +1973,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                        innerCondSlots,
                                                        innerProjectSlots,
                                                        collatorSlot,
+                                                       _cq.getExpCtx()->allowDiskUse,
                                                        root->nodeId());
     }
 
@@ -2373,6 +2420,247 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             std::move(outputs)};
 }
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildEqLookup(
+    const QuerySolutionNode* root, const PlanStageReqs& reqs) {
+    const auto eqLookupNode = static_cast<const EqLookupNode*>(root);
+    const auto nodeId = root->nodeId();
+
+    auto childReqs = reqs.copy().set(kResult);
+    auto [stage, outputs] = build(eqLookupNode->children[0], childReqs);
+    auto localResultSlot = outputs.get(kResult);
+
+    // Extract the value of the local join field. As in the classic $lookup, a missing field and
+    // an empty array are both matched as null by either join strategy.
+    auto localFieldSlot = _slotIdGenerator.generate();
+    stage = sbe::makeProjectStage(
+        std::move(stage),
+        nodeId,
+        localFieldSlot,
+        makeFillEmptyNull(makeFunction("getField"_sd,
+                                       makeVariable(localResultSlot),
+                                       makeConstant(eqLookupNode->joinFieldLocal))));
+    auto localKeySlot = _slotIdGenerator.generate();
+    stage = sbe::makeProjectStage(
+        std::move(stage),
+        nodeId,
+        localKeySlot,
+        sbe::makeE<sbe::EIf>(
+            makeFillEmptyFalse(makeFunction("isArrayEmpty"_sd, makeVariable(localFieldSlot))),
+            makeConstant(sbe::value::TypeTags::Null, 0),
+            makeVariable(localFieldSlot)));
+
+    auto collatorSlot = _data.env->getSlotIfExists("collator"_sd);
+    auto foreignColl = CollectionCatalog::get(_opCtx)->lookupCollectionByNamespace(
+        _opCtx, eqLookupNode->foreignCollection);
+
+    auto matchedSlot = _slotIdGenerator.generate();
+    if (eqLookupNode->lookupStrategy == EqLookupNode::LookupStrategy::kHashJoin) {
+        auto foreignResultSlot = _slotIdGenerator.generate();
+        auto foreignKeySlot = _slotIdGenerator.generate();
+        std::unique_ptr<sbe::PlanStage> innerStage;
+        if (foreignColl) {
+            innerStage = sbe::makeS<sbe::ScanStage>(
+                foreignColl->uuid(),
+                foreignResultSlot,
+                boost::none,
+                boost::none,
+                boost::none,
+                boost::none,
+                boost::none,
+                boost::none,
+                std::vector<std::string>{eqLookupNode->joinFieldForeign},
+                sbe::makeSV(foreignKeySlot),
+                boost::none,
+                true /* forward */,
+                _yieldPolicy,
+                nodeId,
+                sbe::ScanCallbacks{});
+        } else {
+            // A non-existent foreign collection behaves as an empty one.
+            innerStage = sbe::makeProjectStage(
+                makeLimitCoScanTree(nodeId, 0),
+                nodeId,
+                foreignResultSlot,
+                makeConstant(sbe::value::TypeTags::Nothing, 0),
+                foreignKeySlot,
+                makeConstant(sbe::value::TypeTags::Nothing, 0));
+        }
+
+        stage = sbe::makeS<sbe::HashLookupStage>(std::move(stage),
+                                                 std::move(innerStage),
+                                                 localKeySlot,
+                                                 foreignKeySlot,
+                                                 foreignResultSlot,
+                                                 matchedSlot,
+                                                 collatorSlot,
+                                                 nodeId);
+    } else {
+        tassert(6100302,
+                "indexed loop join $lookup requires an index on the foreign collection",
+                eqLookupNode->idxEntry && foreignColl);
+        const auto& indexName = eqLookupNode->idxEntry->identifier.catalogName;
+        auto descriptor = foreignColl->getIndexCatalog()->findIndexByName(_opCtx, indexName);
+        tassert(6100303,
+                str::stream() << "failed to find index in catalog named: " << indexName,
+                descriptor);
+        auto accessMethod = foreignColl->getIndexCatalog()->getEntry(descriptor)->accessMethod();
+        auto keyStringVersion = accessMethod->getSortedDataInterface()->getKeyStringVersion();
+
+        int32_t orderingBits = 0;
+        int fieldIdx = 0;
+        for (auto&& elem : descriptor->keyPattern()) {
+            if (elem.number() < 0) {
+                orderingBits |= (1 << fieldIdx);
+            }
+            ++fieldIdx;
+        }
+
+        // Every element of an array local value is looked up separately, a scalar is looked up
+        // as is.
+        auto keysSlot = _slotIdGenerator.generate();
+        stage = sbe::makeProjectStage(
+            std::move(stage),
+            nodeId,
+            keysSlot,
+            sbe::makeE<sbe::EIf>(makeFunction("isArray"_sd, makeVariable(localKeySlot)),
+                                 makeVariable(localKeySlot),
+                                 makeFunction("newArray"_sd, makeVariable(localKeySlot))));
+
+        auto keySlot = _slotIdGenerator.generate();
+        auto keyIdxSlot = _slotIdGenerator.generate();
+        std::unique_ptr<sbe::PlanStage> keysStage = sbe::makeS<sbe::UnwindStage>(
+            makeLimitCoScanTree(nodeId), keysSlot, keySlot, keyIdxSlot, false, nodeId);
+
+        // Build the bounds [key, key] over the leading field of the index. The exclusive-before
+        // and exclusive-after discriminators place them around all the keys with this prefix.
+        auto makeBound = [&](KeyString::Discriminator discriminator) {
+            auto keyExpr = !collatorSlot ? makeVariable(keySlot)
+                                         : makeFunction("collComparisonKey"_sd,
+                                                        makeVariable(keySlot),
+                                                        makeVariable(*collatorSlot));
+            return makeFunction(
+                "ks"_sd,
+                makeConstant(sbe::value::TypeTags::NumberInt64,
+                             static_cast<int64_t>(keyStringVersion)),
+                makeConstant(sbe::value::TypeTags::NumberInt32, orderingBits),
+                std::move(keyExpr),
+                makeConstant(sbe::value::TypeTags::NumberInt64,
+                             static_cast<int64_t>(discriminator)));
+        };
+        auto lowKeySlot = _slotIdGenerator.generate();
+        auto highKeySlot = _slotIdGenerator.generate();
+        keysStage = sbe::makeProjectStage(std::move(keysStage),
+                                          nodeId,
+                                          lowKeySlot,
+                                          makeBound(KeyString::Discriminator::kExclusiveBefore),
+                                          highKeySlot,
+                                          makeBound(KeyString::Discriminator::kExclusiveAfter));
+
+        auto ridSlot = _slotIdGenerator.generate();
+        auto ixScanStage = sbe::makeS<sbe::IndexScanStage>(foreignColl->uuid(),
+                                                           indexName,
+                                                           true /* forward */,
+                                                           boost::none,
+                                                           ridSlot,
+                                                           boost::none,
+                                                           sbe::IndexKeysInclusionSet{},
+                                                           sbe::makeSV(),
+                                                           lowKeySlot,
+                                                           highKeySlot,
+                                                           _yieldPolicy,
+                                                           nodeId);
+
+        // Several elements of a local array can match the same foreign document, so the record
+        // ids are deduplicated before fetching.
+        std::unique_ptr<sbe::PlanStage> foreignStage = sbe::makeS<sbe::UniqueStage>(
+            sbe::makeS<sbe::LoopJoinStage>(std::move(keysStage),
+                                           std::move(ixScanStage),
+                                           sbe::makeSV(),
+                                           sbe::makeSV(lowKeySlot, highKeySlot),
+                                           nullptr,
+                                           nodeId),
+            sbe::makeSV(ridSlot),
+            nodeId);
+
+        auto foreignResultSlot = _slotIdGenerator.generate();
+        auto fetchStage = sbe::makeS<sbe::ScanStage>(foreignColl->uuid(),
+                                                     foreignResultSlot,
+                                                     boost::none,
+                                                     boost::none,
+                                                     boost::none,
+                                                     boost::none,
+                                                     boost::none,
+                                                     boost::none,
+                                                     std::vector<std::string>{},
+                                                     sbe::makeSV(),
+                                                     ridSlot,
+                                                     true /* forward */,
+                                                     nullptr,
+                                                     nodeId,
+                                                     sbe::ScanCallbacks{});
+        foreignStage = sbe::makeS<sbe::LoopJoinStage>(
+            std::move(foreignStage),
+            sbe::makeS<sbe::LimitSkipStage>(std::move(fetchStage), 1, boost::none, nodeId),
+            sbe::makeSV(),
+            sbe::makeSV(ridSlot),
+            nullptr,
+            nodeId);
+
+        // Accumulate the matching foreign documents into an array. The group produces no row
+        // when nothing matched, in which case the union falls through to an empty array.
+        auto groupSlot = _slotIdGenerator.generate();
+        foreignStage = sbe::makeS<sbe::HashAggStage>(
+            std::move(foreignStage),
+            sbe::makeSV(),
+            sbe::makeEM(groupSlot, makeFunction("addToArray"_sd, makeVariable(foreignResultSlot))),
+            boost::none,
+            false /* allowDiskUse */,
+            nodeId);
+
+        auto emptySlot = _slotIdGenerator.generate();
+        auto emptyStage = sbe::makeProjectStage(
+            makeLimitCoScanTree(nodeId), nodeId, emptySlot, makeFunction("newArray"_sd));
+
+        std::vector<std::unique_ptr<sbe::PlanStage>> unionBranches;
+        unionBranches.push_back(std::move(foreignStage));
+        unionBranches.push_back(std::move(emptyStage));
+        auto innerStage = makeLimitTree(
+            sbe::makeS<sbe::UnionStage>(std::move(unionBranches),
+                                        std::vector<sbe::value::SlotVector>{
+                                            sbe::makeSV(groupSlot), sbe::makeSV(emptySlot)},
+                                        sbe::makeSV(matchedSlot),
+                                        nodeId),
+            nodeId);
+
+        auto outerProjects = sbe::makeSV();
+        outputs.forEachSlot(childReqs, [&](auto&& slot) { outerProjects.push_back(slot); });
+        stage = sbe::makeS<sbe::LoopJoinStage>(std::move(stage),
+                                               std::move(innerStage),
+                                               std::move(outerProjects),
+                                               sbe::makeSV(keysSlot),
+                                               nullptr,
+                                               nodeId);
+    }
+
+    // Attach the matched foreign documents to the local document under the 'as' field,
+    // replacing any value it previously held.
+    auto newResultSlot = _slotIdGenerator.generate();
+    stage = sbe::makeS<sbe::MakeBsonObjStage>(
+        std::move(stage),
+        newResultSlot,
+        localResultSlot,
+        sbe::MakeBsonObjStage::FieldBehavior::drop,
+        std::vector<std::string>{eqLookupNode->joinField},
+        std::vector<std::string>{eqLookupNode->joinField},
+        sbe::makeSV(matchedSlot),
+        true /* forceNewObject */,
+        false /* returnOldObject */,
+        nodeId);
+    outputs.set(kResult, newResultSlot);
+
+    return {std::move(stage), std::move(outputs)};
+}
+
 // Returns a non-null pointer to the root of a plan tree, or a non-OK status if the PlanStage tree
 // could not be constructed.
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::build(
@@ -2401,6 +2689,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             {STAGE_TEXT_MATCH, &SlotBasedStageBuilder::buildTextMatch},
             {STAGE_RETURN_KEY, &SlotBasedStageBuilder::buildReturnKey},
             {STAGE_EOF, &SlotBasedStageBuilder::buildEof},
+            {STAGE_EQ_LOOKUP, &SlotBasedStageBuilder::buildEqLookup},
             {STAGE_AND_HASH, &SlotBasedStageBuilder::buildAndHash},
             {STAGE_AND_SORTED, &SlotBasedStageBuilder::buildAndSorted},
             {STAGE_SORT_MERGE, &SlotBasedStageBuilder::buildSortMerge},
@@ -49,6 +49,14 @@ std::unique_ptr<sbe::RuntimeEnvironment> makeRuntimeEnvironment(
     OperationContext* opCtx,
     sbe::value::SlotIdGenerator* slotIdGenerator);
 
+/**
+ * Resets the global values registered by 'makeRuntimeEnvironment()' in 'env' to the ones of the
+ * given query. Used when an environment built for a different operation is reused.
+ */
+void refreshRuntimeEnvironment(const CanonicalQuery& cq,
+                               OperationContext* opCtx,
+                               sbe::RuntimeEnvironment* env);
+
 class PlanStageReqs;
 
 /**
@@ -229,6 +237,12 @@ struct PlanStageData {
 
     std::string debugString() const;
 
+    /**
+     * Returns a copy of this data with its own, independent RuntimeEnvironment. Must only be
+     * called before the plan this data belongs to is prepared.
+     */
+    PlanStageData makeCopy() const;
+
     // This holds the output slots produced by SBE plan (resultSlot, recordIdSlot, etc).
     PlanStageSlots outputs;
 
@@ -327,6 +341,9 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildEof(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildEqLookup(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildAndHash(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
 #include "mongo/db/exec/sbe/stages/union.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/util/make_data_structure.h"
@@ -615,6 +616,66 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
 
     return {std::move(stage), std::move(outputs)};
 }
+
+/**
+ * Generates a collection scan sub-tree which is executed by 'degree' threads. Every thread runs a
+ * copy of a ParallelScanStage, which hands out non-overlapping RecordId ranges of the collection,
+ * together with the scan's filter. The matching documents are gathered by an ExchangeConsumer in
+ * no particular order.
+ *
+ * The producer threads are not attached to the query's yield policy, so the scan never yields.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateParallelCollScan(
+    StageBuilderState& state,
+    const CollectionPtr& collection,
+    const CollectionScanNode* csn,
+    size_t degree) {
+    invariant(csn->allowParallelScan);
+    invariant(csn->direction == CollectionScanParams::FORWARD);
+    invariant(!csn->tailable && !csn->resumeAfterRecordId && !csn->shouldTrackLatestOplogTimestamp);
+
+    auto resultSlot = state.slotId();
+    auto recordIdSlot = state.slotId();
+
+    std::unique_ptr<sbe::PlanStage> stage =
+        sbe::makeS<sbe::ParallelScanStage>(collection->uuid(),
+                                           resultSlot,
+                                           recordIdSlot,
+                                           boost::none /* snapshotIdSlot */,
+                                           boost::none /* indexIdSlot */,
+                                           boost::none /* indexKeySlot */,
+                                           boost::none /* keyPatternSlot */,
+                                           std::vector<std::string>{},
+                                           sbe::makeSV(),
+                                           nullptr /* yieldPolicy */,
+                                           csn->nodeId(),
+                                           sbe::ScanCallbacks{});
+
+    if (csn->filter) {
+        auto relevantSlots = sbe::makeSV(resultSlot, recordIdSlot);
+
+        auto [_, outputStage] = generateFilter(state,
+                                               csn->filter.get(),
+                                               {std::move(stage), std::move(relevantSlots)},
+                                               resultSlot,
+                                               csn->nodeId());
+        stage = std::move(outputStage.stage);
+    }
+
+    stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                              degree,
+                                              sbe::makeSV(resultSlot, recordIdSlot),
+                                              sbe::ExchangePolicy::roundrobin,
+                                              nullptr /* partition */,
+                                              nullptr /* orderLess */,
+                                              csn->nodeId());
+
+    PlanStageSlots outputs;
+    outputs.set(PlanStageSlots::kResult, resultSlot);
+    outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
+
+    return {std::move(stage), std::move(outputs)};
+}
 }  // namespace
 
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
@@ -626,6 +687,9 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     if (csn->minRecord || csn->maxRecord || csn->stopApplyingFilterAfterFirstMatch) {
         return generateOptimizedOplogScan(
             state, collection, csn, yieldPolicy, isTailableResumeBranch);
+    } else if (const auto degree = internalQuerySlotBasedExecutionParallelCollScanDegree.load();
+               csn->allowParallelScan && degree > 1) {
+        return generateParallelCollScan(state, collection, csn, static_cast<size_t>(degree));
     } else {
         return generateGenericCollScan(state, collection, csn, yieldPolicy, isTailableResumeBranch);
     }
@@ -457,6 +457,7 @@ public:
     void visit(const ExpressionFunction* expr) final {}
     void visit(const ExpressionRandom* expr) final {}
     void visit(const ExpressionToHashedIndexKey* expr) final {}
+    void visit(const ExpressionCommonSubexpression* expr) final {}
     void visit(const ExpressionDateAdd* expr) final {}
     void visit(const ExpressionDateSubtract* expr) final {}
     void visit(const ExpressionGetField* expr) final {}
@@ -660,6 +661,7 @@ public:
     void visit(const ExpressionFunction* expr) final {}
     void visit(const ExpressionRandom* expr) final {}
     void visit(const ExpressionToHashedIndexKey* expr) final {}
+    void visit(const ExpressionCommonSubexpression* expr) final {}
     void visit(const ExpressionDateAdd* expr) final {}
     void visit(const ExpressionDateSubtract* expr) final {}
     void visit(const ExpressionGetField* expr) final {}
@@ -1139,6 +1141,7 @@ public:
                                       sbe::makeSV(),
                                       sbe::makeEM(groupSlot, std::move(addToArrayExpr)),
                                       collatorSlot,
+                                      false /* allowDiskUse */,
                                       _context->planNodeId);
 
         // Build subtree to handle nulls. If an input is null, return null. Otherwise, unwind the
@@ -1167,6 +1170,7 @@ public:
                         sbe::makeSV(),
                         sbe::makeEM(finalGroupSlot, std::move(finalAddToArrayExpr)),
                         collatorSlot,
+                        false /* allowDiskUse */,
                         _context->planNodeId);
 
         // Create a branch stage to select between the branch that produces one null if any elements
@@ -2719,6 +2723,11 @@ public:
         unsupportedExpression("$toHashedIndexKey");
     }
 
+    void visit(const ExpressionCommonSubexpression* expr) final {
+        // The shared subexpression is translated as its only child, whose result is already the
+        // result of this node.
+    }
+
     void visit(const ExpressionDateAdd* expr) final {
         generateDateArithmeticsExpression(expr, "dateAdd");
     }
@@ -100,7 +100,8 @@ CandidatePlans SubPlanner::plan(
     }
 
     // Build a plan stage tree from a composite solution.
-    auto compositeSolution = std::move(subplanSelectStat.getValue());
+    auto compositeSolution = QueryPlanner::extendWithEqLookups(
+        _cq, _queryParams, std::move(subplanSelectStat.getValue()));
     auto&& [root, data] = stage_builder::buildSlotBasedExecutableTree(
         _opCtx, _collection, _cq, *compositeSolution, _yieldPolicy);
     auto status = prepareExecutionPlan(root.get(), &data);
@@ -115,6 +116,9 @@ CandidatePlans SubPlanner::plan(
 CandidatePlans SubPlanner::planWholeQuery() const {
     // Use the query planning module to plan the whole query.
     auto solutions = uassertStatusOK(QueryPlanner::plan(_cq, _queryParams));
+    for (auto&& solution : solutions) {
+        solution = QueryPlanner::extendWithEqLookups(_cq, _queryParams, std::move(solution));
+    }
 
     // Only one possible plan. Build the stages from the solution.
     if (solutions.size() == 1) {
@@ -53,6 +53,27 @@ std::unique_ptr<PlanStage> buildClassicExecutableTree(OperationContext* opCtx,
     return builder->build(solution.root());
 }
 
+namespace {
+/**
+ * Readies a freshly built or cloned SBE tree for execution by the operation running 'cq'.
+ */
+void attachSlotBasedExecutableTree(OperationContext* opCtx,
+                                   const CanonicalQuery& cq,
+                                   sbe::PlanStage* root,
+                                   PlanYieldPolicySBE* yieldPolicy) {
+    root->attachToOperationContext(opCtx);
+
+    auto expCtx = cq.getExpCtxRaw();
+    tassert(5327100, "No expression context", expCtx);
+    if (expCtx->explain || expCtx->mayDbProfile) {
+        root->markShouldCollectTimingInfo();
+    }
+
+    // Register this plan to yield according to the configured policy.
+    yieldPolicy->registerPlan(root);
+}
+}  // namespace
+
 std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
 buildSlotBasedExecutableTree(OperationContext* opCtx,
                              const CollectionPtr& collection,
@@ -76,17 +97,27 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
     auto root = builder->build(solution.root());
     auto data = builder->getPlanStageData();
 
-    root->attachToOperationContext(opCtx);
+    attachSlotBasedExecutableTree(opCtx, cq, root.get(), sbeYieldPolicy);
 
-    auto expCtx = cq.getExpCtxRaw();
-    tassert(5327100, "No expression context", expCtx);
-    if (expCtx->explain || expCtx->mayDbProfile) {
-        root->markShouldCollectTimingInfo();
-    }
+    return {std::move(root), std::move(data)};
+}
 
-    // Register this plan to yield according to the configured policy.
-    sbeYieldPolicy->registerPlan(root.get());
+std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+cloneSlotBasedExecutableTree(OperationContext* opCtx,
+                             const CanonicalQuery& cq,
+                             const sbe::PlanStage& root,
+                             const stage_builder::PlanStageData& data,
+                             PlanYieldPolicy* yieldPolicy) {
+    auto sbeYieldPolicy = dynamic_cast<PlanYieldPolicySBE*>(yieldPolicy);
+    invariant(sbeYieldPolicy);
 
-    return {std::move(root), std::move(data)};
+    auto clonedRoot = root.clone();
+    auto clonedData = data.makeCopy();
+
+    clonedRoot->attachNewYieldPolicy(sbeYieldPolicy);
+    refreshRuntimeEnvironment(cq, opCtx, clonedData.env);
+    attachSlotBasedExecutableTree(opCtx, cq, clonedRoot.get(), sbeYieldPolicy);
+
+    return {std::move(clonedRoot), std::move(clonedData)};
 }
 }  // namespace mongo::stage_builder
@@ -57,4 +57,17 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
                              const QuerySolution& solution,
                              PlanYieldPolicy* yieldPolicy);
 
+/**
+ * Clones an SBE tree and its PlanStageData, as previously returned by
+ * 'buildSlotBasedExecutableTree()' and not yet prepared, so that it can be executed on behalf of
+ * the operation running 'cq' with the given 'yieldPolicy'. The clone does not share any state with
+ * the original, which may be used concurrently.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+cloneSlotBasedExecutableTree(OperationContext* opCtx,
+                             const CanonicalQuery& cq,
+                             const sbe::PlanStage& root,
+                             const stage_builder::PlanStageData& data,
+                             PlanYieldPolicy* yieldPolicy);
+
 }  // namespace mongo::stage_builder
@@ -45,10 +45,12 @@ StringData stageTypeToString(StageType stageType) {
         {STAGE_DISTINCT_SCAN, "DISTINCT_SCAN"_sd},
         {STAGE_ENSURE_SORTED, "SORTED"_sd},
         {STAGE_EOF, "EOF"_sd},
+        {STAGE_EQ_LOOKUP, "EQ_LOOKUP"_sd},
         {STAGE_FETCH, "FETCH"_sd},
         {STAGE_GEO_NEAR_2D, "GEO_NEAR_2D"_sd},
         {STAGE_GEO_NEAR_2DSPHERE, "GEO_NEAR_2DSPHERE"_sd},
         {STAGE_IDHACK, "IDHACK"_sd},
+        {STAGE_INDEX_FAST_COUNT, "INDEX_FAST_COUNT"_sd},
         {STAGE_IXSCAN, "IXSCAN"_sd},
         {STAGE_LIMIT, "LIMIT"_sd},
         {STAGE_MOCK, "MOCK"_sd},
@@ -60,6 +62,8 @@ StringData stageTypeToString(StageType stageType) {
         {STAGE_PROJECTION_SIMPLE, "PROJECTION_SIMPLE"_sd},
         {STAGE_QUEUED_DATA, "QUEUED_DATA"_sd},
         {STAGE_RECORD_STORE_FAST_COUNT, "RECORD_STORE_FAST_COUNT"_sd},
+        {STAGE_RESERVOIR_SAMPLE_FROM_TIMESERIES_BUCKET,
+         "RESERVOIR_SAMPLE_FROM_TIMESERIES_BUCKET"_sd},
         {STAGE_RETURN_KEY, "RETURN_KEY"_sd},
         {STAGE_SAMPLE_FROM_TIMESERIES_BUCKET, "SAMPLE_FROM_TIMESERIES_BUCKET"_sd},
         {STAGE_SHARDING_FILTER, "SHARDING_FILTER"_sd},
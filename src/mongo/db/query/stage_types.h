@@ -75,6 +75,10 @@ enum StageType {
 
     STAGE_EOF,
 
+    // An equality join of the form of $lookup with the localField/foreignField syntax, pushed down
+    // from an aggregation pipeline into the SBE engine.
+    STAGE_EQ_LOOKUP,
+
     STAGE_FETCH,
 
     // The two $geoNear impls imply a fetch+sort and must be stages.
@@ -83,6 +87,10 @@ enum StageType {
 
     STAGE_IDHACK,
 
+    // If we're running a .count() whose query is the filter of a partial index, we can just ask the
+    // storage engine how many keys the index has.
+    STAGE_INDEX_FAST_COUNT,
+
     STAGE_IXSCAN,
     STAGE_LIMIT,
 
@@ -101,6 +109,7 @@ enum StageType {
 
     STAGE_QUEUED_DATA,
     STAGE_RECORD_STORE_FAST_COUNT,
+    STAGE_RESERVOIR_SAMPLE_FROM_TIMESERIES_BUCKET,
     STAGE_RETURN_KEY,
     STAGE_SAMPLE_FROM_TIMESERIES_BUCKET,
     STAGE_SHARDING_FILTER,
@@ -49,6 +49,9 @@ YieldPolicyCallbacksImpl::YieldPolicyCallbacksImpl(NamespaceString nssForFailpoi
 void YieldPolicyCallbacksImpl::duringYield(OperationContext* opCtx) const {
     CurOp::get(opCtx)->yielded();
 
+    // Refresh the operation's currentOp snapshot while its locks are released.
+    CurOp::publishCurrentOpSnapshot(opCtx);
+
     const auto& nss = _nss;
     auto failPointHang = [opCtx, nss](FailPoint* fp) {
         fp->executeIf(
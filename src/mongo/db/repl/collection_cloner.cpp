@@ -31,7 +31,13 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
+#include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/client/dbclient_connection.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/index_build_entry_helpers.h"
 #include "mongo/db/index_builds_coordinator.h"
@@ -39,10 +45,11 @@
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/database_cloner_gen.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
 #include "mongo/db/wire_version.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
-
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -56,6 +63,13 @@ MONGO_FAIL_POINT_DEFINE(initialSyncHangDuringCollectionClone);
 // DBClientConnection, optionally limited to a specific collection.
 MONGO_FAIL_POINT_DEFINE(initialSyncHangCollectionClonerAfterHandlingBatchResponse);
 
+namespace {
+
+// The number of _ids sampled from the source for each range of a collection cloned in ranges.
+constexpr int kSampledIdsPerRange = 16;
+
+}  // namespace
+
 CollectionCloner::CollectionCloner(const NamespaceString& sourceNss,
                                    const CollectionOptions& collectionOptions,
                                    InitialSyncSharedData* sharedData,
@@ -236,7 +250,15 @@ BaseCloner::AfterStageBehavior CollectionCloner::createCollectionStage() {
 }
 
 BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
-    runQuery();
+    if (!_rangesChosen) {
+        chooseRanges();
+        _rangesChosen = true;
+    }
+    if (_rangeLastIds.empty()) {
+        runQuery();
+    } else {
+        runRangeQueries();
+    }
     waitForDatabaseWorkToComplete();
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
@@ -371,18 +393,219 @@ void CollectionCloner::runQuery() {
     }
 }
 
-void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+void CollectionCloner::chooseRanges() {
+    const int rangeCount = collectionClonerRangeCount;
+    if (rangeCount <= 1 || !_resumeSupported || _collectionOptions.capped ||
+        _collectionOptions.clusteredIndex || !_collectionOptions.collation.isEmpty() ||
+        _idIndexSpec.isEmpty()) {
+        return;
+    }
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_stats.bytesToCopy < collectionClonerRangeMinBytes) {
+            return;
+        }
+    }
+
+    // The ranges are bounded by index keys rather than query predicates, so that _ids of every
+    // type fall into exactly one of them. They are compared as in an _id index without collation,
+    // which is why collections with a default collation are not split.
+    const int sampleSize = rangeCount * kSampledIdsPerRange;
+    BSONObj res;
+    getClient()->runCommand(
+        _sourceNss.db().toString(),
+        BSON("aggregate" << _sourceNss.coll() << "pipeline"
+                         << BSON_ARRAY(BSON("$sample" << BSON("size" << sampleSize))
+                                       << BSON("$project" << BSON("_id" << 1)))
+                         << "cursor" << BSON("batchSize" << sampleSize + 1)),
+        res,
+        QueryOption_SecondaryOk);
+    if (auto status = getStatusFromCommandResult(res); !status.isOK()) {
+        LOGV2_DEBUG(6103500,
+                    1,
+                    "Cloning collection with a single query since its _ids could not be sampled",
+                    "namespace"_attr = _sourceNss,
+                    "error"_attr = status);
+        return;
+    }
+
+    std::vector<BSONObj> sampledIds;
+    for (auto&& doc : res["cursor"]["firstBatch"].Obj()) {
+        if (doc.type() == Object && doc.Obj().hasField("_id")) {
+            sampledIds.push_back(doc.Obj().getOwned());
+        }
+    }
+    std::sort(sampledIds.begin(),
+              sampledIds.end(),
+              SimpleBSONObjComparator::kInstance.makeLessThan());
+    sampledIds.erase(std::unique(sampledIds.begin(),
+                                 sampledIds.end(),
+                                 SimpleBSONObjComparator::kInstance.makeEqualTo()),
+                     sampledIds.end());
+    if (sampledIds.size() < 2) {
+        return;
+    }
+
+    // Split the collection at evenly spaced sampled _ids.
+    std::vector<Stats::RangeStats> ranges;
+    BSONObj min;
+    for (int i = 1; i < rangeCount; ++i) {
+        auto& splitPoint = sampledIds[i * sampledIds.size() / rangeCount];
+        if (!min.isEmpty() && SimpleBSONObjComparator::kInstance.evaluate(splitPoint == min)) {
+            continue;
+        }
+        ranges.push_back({min, splitPoint});
+        min = splitPoint;
+    }
+    ranges.push_back({min, BSONObj()});
+    if (ranges.size() < 2) {
+        return;
+    }
+
+    LOGV2(6103501,
+          "Collection cloner will clone the collection in ranges of _id",
+          "namespace"_attr = _sourceNss,
+          "numRanges"_attr = ranges.size());
+    _rangeLastIds.resize(ranges.size());
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.ranges = std::move(ranges);
+}
+
+void CollectionCloner::runRangeQueries() {
+    _rangeQueryFailed.store(false);
+    std::vector<Status> statuses(_rangeLastIds.size(), Status::OK());
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < _rangeLastIds.size(); ++i) {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_stats.ranges[i].done) {
+                continue;
+            }
+        }
+        threads.emplace_back([this, i, &status = statuses[i]] {
+            Client::initThread(str::stream() << "CollectionClonerRange-" << i);
+            try {
+                runRangeQuery(i);
+            } catch (const DBException& ex) {
+                status = ex.toStatus();
+                _rangeQueryFailed.store(true);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    // Report the first error which did not just come from stopping the query of a range because
+    // another one failed.
+    auto failed = std::find_if(statuses.begin(), statuses.end(), [](const Status& status) {
+        return !status.isOK() && status != ErrorCodes::CallbackCanceled;
+    });
+    if (failed == statuses.end()) {
+        failed = std::find_if(
+            statuses.begin(), statuses.end(), [](const Status& status) { return !status.isOK(); });
+    }
+    if (failed != statuses.end()) {
+        uassertStatusOK(*failed);
+    }
+}
+
+void CollectionCloner::runRangeQuery(size_t rangeIndex) {
+    auto conn = std::make_unique<DBClientConnection>(true /* autoReconnect */);
+    uassertStatusOK(conn->connect(getSource(), StringData(), boost::none));
+    uassertStatusOK(replAuthenticate(conn.get())
+                        .withContext(str::stream() << "Failed to authenticate to " << getSource()));
+
+    BSONObj min;
+    BSONObj max;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        min = _stats.ranges[rangeIndex].min;
+        max = _stats.ranges[rangeIndex].max;
+    }
+    if (!_rangeLastIds[rangeIndex].isEmpty()) {
+        // The bound is inclusive, so the document with this _id is skipped once it is fetched
+        // again.
+        min = _rangeLastIds[rangeIndex];
+    }
+
+    Query query;
+    query.hint(BSON("_id" << 1));
+    if (!min.isEmpty()) {
+        query.minKey(min);
+    }
+    if (!max.isEmpty()) {
+        query.maxKey(max);
+    }
+    conn->query(
+        [this, rangeIndex](DBClientCursorBatchIterator& iter) {
+            handleNextRangeBatch(rangeIndex, iter);
+        },
+        _sourceDbAndUuid,
+        query,
+        nullptr /* fieldsToReturn */,
+        QueryOption_NoCursorTimeout | QueryOption_SecondaryOk |
+            (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
+        _collectionClonerBatchSize,
+        ReadConcernArgs::kImplicitDefault);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.ranges[rangeIndex].done = true;
+}
+
+void CollectionCloner::handleNextRangeBatch(size_t rangeIndex, DBClientCursorBatchIterator& iter) {
+    uassertInitialSyncNotFailed();
+    if (_rangeQueryFailed.load()) {
+        uasserted(ErrorCodes::CallbackCanceled,
+                  "Query of collection range cancelled since another range failed");
+    }
+
+    auto& lastId = _rangeLastIds[rangeIndex];
     {
-        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
-        if (!getSharedData()->getStatus(lk).isOK()) {
-            static constexpr char message[] =
-                "Collection cloning cancelled due to initial sync failure";
-            LOGV2(21136, message, "error"_attr = getSharedData()->getStatus(lk));
-            uasserted(ErrorCodes::CallbackCanceled,
-                      str::stream() << message << ": " << getSharedData()->getStatus(lk));
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.receivedBatches++;
+        while (iter.moreInCurrentBatch()) {
+            auto doc = iter.nextSafe();
+            auto id = doc["_id"];
+            if (!lastId.isEmpty() &&
+                SimpleBSONElementComparator::kInstance.evaluate(id == lastId.firstElement())) {
+                continue;
+            }
+            lastId = BSON("_id" << id);
+            _documentsToInsert.emplace_back(std::move(doc));
+            _stats.ranges[rangeIndex].documentsFetched++;
         }
     }
 
+    scheduleInsertDocuments();
+}
+
+void CollectionCloner::uassertInitialSyncNotFailed() {
+    stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
+    if (!getSharedData()->getStatus(lk).isOK()) {
+        static constexpr char message[] =
+            "Collection cloning cancelled due to initial sync failure";
+        LOGV2(21136, message, "error"_attr = getSharedData()->getStatus(lk));
+        uasserted(ErrorCodes::CallbackCanceled,
+                  str::stream() << message << ": " << getSharedData()->getStatus(lk));
+    }
+}
+
+void CollectionCloner::scheduleInsertDocuments() {
+    auto&& scheduleResult = _scheduleDbWorkFn(
+        [=](const executor::TaskExecutor::CallbackArgs& cbd) { insertDocumentsCallback(cbd); });
+
+    if (!scheduleResult.isOK()) {
+        Status newStatus = scheduleResult.getStatus().withContext(
+            str::stream() << "Error cloning collection '" << _sourceNss.ns() << "'");
+        // We must throw an exception to terminate query.
+        uassertStatusOK(newStatus);
+    }
+}
+
+void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+    uassertInitialSyncNotFailed();
+
     // If this is 'true', it means that something happened to our remote cursor for a reason other
     // than the collection being dropped, all while we were running a non-resumable (4.2) clone.
     // We must abort initial sync in that case.
@@ -406,15 +629,7 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
     }
 
     // Schedule the next document batch insertion.
-    auto&& scheduleResult = _scheduleDbWorkFn(
-        [=](const executor::TaskExecutor::CallbackArgs& cbd) { insertDocumentsCallback(cbd); });
-
-    if (!scheduleResult.isOK()) {
-        Status newStatus = scheduleResult.getStatus().withContext(
-            str::stream() << "Error cloning collection '" << _sourceNss.ns() << "'");
-        // We must throw an exception to terminate query.
-        uassertStatusOK(newStatus);
-    }
+    scheduleInsertDocuments();
 
     if (_resumeSupported) {
         // Store the resume token for this batch.
@@ -542,6 +757,21 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
         }
     }
     builder->appendNumber("receivedBatches", static_cast<long long>(receivedBatches));
+    if (!ranges.empty()) {
+        BSONArrayBuilder rangesBuilder(builder->subarrayStart("ranges"));
+        for (const auto& range : ranges) {
+            BSONObjBuilder rangeBuilder(rangesBuilder.subobjStart());
+            if (!range.min.isEmpty()) {
+                rangeBuilder.append("min", range.min);
+            }
+            if (!range.max.isEmpty()) {
+                rangeBuilder.append("max", range.max);
+            }
+            rangeBuilder.appendNumber("documentsFetched",
+                                      static_cast<long long>(range.documentsFetched));
+            rangeBuilder.append("done", range.done);
+        }
+    }
 }
 
 }  // namespace repl
@@ -36,6 +36,7 @@
 #include "mongo/db/repl/initial_sync_base_cloner.h"
 #include "mongo/db/repl/initial_sync_shared_data.h"
 #include "mongo/db/repl/task_runner.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
@@ -64,6 +65,16 @@ public:
         long long avgObjSize{0};
         long long approxBytesCopied{0};
 
+        // The ranges of _id in which the collection is cloned concurrently, if it is cloned in
+        // ranges. The bounds are {_id: <value>} objects, empty when the range is unbounded.
+        struct RangeStats {
+            BSONObj min;
+            BSONObj max;
+            size_t documentsFetched{0};
+            bool done{false};
+        };
+        std::vector<RangeStats> ranges;
+
         std::string toString() const;
         BSONObj toBSON() const;
         void append(BSONObjBuilder* builder) const;
@@ -226,6 +237,40 @@ private:
      */
     void runQuery();
 
+    /**
+     * Decides whether to clone the collection in several ranges of _id over concurrent
+     * connections, and if so, chooses the ranges from a $sample of the _ids on the source. Only
+     * large collections with a simple _id index are split.
+     */
+    void chooseRanges();
+
+    /**
+     * Clones each range which is not done yet over its own connection, concurrently, and waits for
+     * all of them to finish. Throws the error of the first range which failed.
+     */
+    void runRangeQueries();
+
+    /**
+     * Queries the documents in the range at 'rangeIndex' through the _id index, starting after the
+     * last document fetched by a previous attempt if there was one.
+     */
+    void runRangeQuery(size_t rangeIndex);
+
+    /**
+     * Like handleNextBatch, for a batch of the query of the range at 'rangeIndex'.
+     */
+    void handleNextRangeBatch(size_t rangeIndex, DBClientCursorBatchIterator& iter);
+
+    /**
+     * Throws if initial sync has failed, to cancel the query in progress.
+     */
+    void uassertInitialSyncNotFailed();
+
+    /**
+     * Schedules the insertion of the documents in _documentsToInsert.
+     */
+    void scheduleInsertDocuments();
+
     /**
      * Used to terminate the clone when we encounter a fatal error during a non-resumable query.
      * Throws.
@@ -278,6 +323,17 @@ private:
     // If true, it means we are starting a new query or resuming an interrupted one.
     bool _firstBatchOfQueryRound = true;  // (X)
 
+    // Whether chooseRanges() has run, so that the ranges are kept when the query stage is retried.
+    bool _rangesChosen = false;  // (X)
+
+    // The _id of the last document fetched in each range of _stats.ranges, as {_id: <value>}, so
+    // that the query of the range can resume after it. Each is only accessed by the thread cloning
+    // the range while the ranges are being cloned.
+    std::vector<BSONObj> _rangeLastIds;  // (S)
+
+    // Set when the query of a range fails, to stop the queries of the other ranges.
+    AtomicWord<bool> _rangeQueryFailed{false};  // (S)
+
     // Only set during non-resumable (4.2) queries.
     // Signifies that there were changes to the collection on the sync source that resulted in
     // our remote cursor getting killed.
@@ -38,11 +38,13 @@
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
 #include "mongo/db/repl/oplog_buffer_collection.h"
 #include "mongo/db/repl/oplog_buffer_proxy.h"
+#include "mongo/db/repl/oplog_buffer_spill.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_external_state.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/storage_interface.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -51,15 +53,37 @@ namespace {
 
 const char kCollectionOplogBufferName[] = "collection";
 const char kBlockingQueueOplogBufferName[] = "inMemoryBlockingQueue";
+const char kSpillOplogBufferName[] = "inMemoryWithSpill";
 
 MONGO_INITIALIZER(initialSyncOplogBuffer)(InitializerContext*) {
     if ((initialSyncOplogBuffer != kCollectionOplogBufferName) &&
-        (initialSyncOplogBuffer != kBlockingQueueOplogBufferName)) {
+        (initialSyncOplogBuffer != kBlockingQueueOplogBufferName) &&
+        (initialSyncOplogBuffer != kSpillOplogBufferName)) {
         uasserted(ErrorCodes::BadValue,
                   "unsupported initial sync oplog buffer option: " + initialSyncOplogBuffer);
     }
 }
 
+const char kLogicalInitialSyncMethodName[] = "logical";
+const char kFileCopyBasedInitialSyncMethodName[] = "fileCopyBased";
+
+MONGO_INITIALIZER(initialSyncMethod)(InitializerContext*) {
+    if ((initialSyncMethod != kLogicalInitialSyncMethodName) &&
+        (initialSyncMethod != kFileCopyBasedInitialSyncMethodName)) {
+        uasserted(ErrorCodes::BadValue,
+                  "unsupported initial sync method option: " + initialSyncMethod);
+    }
+
+    // File copy based initial sync needs a backup cursor on the sync source, and the backup cursor
+    // hooks are not implemented in this build, so only the logical InitialSyncer is available.
+    if (initialSyncMethod == kFileCopyBasedInitialSyncMethodName) {
+        LOGV2_WARNING(6103600,
+                      "File copy based initial sync is not supported by this build, logical "
+                      "initial sync will be used instead",
+                      "initialSyncMethod"_attr = initialSyncMethod);
+    }
+}
+
 }  // namespace
 
 DataReplicatorExternalStateImpl::DataReplicatorExternalStateImpl(
@@ -126,6 +150,11 @@ std::unique_ptr<OplogBuffer> DataReplicatorExternalStateImpl::makeInitialSyncOpl
         options.peekCacheSize = std::size_t(initialSyncOplogBufferPeekCacheSize);
         return std::make_unique<OplogBufferProxy>(
             std::make_unique<OplogBufferCollection>(StorageInterface::get(opCtx), options));
+    } else if (initialSyncOplogBuffer == kSpillOplogBufferName) {
+        OplogBufferSpill::Options options;
+        options.spillDirectory = storageGlobalParams.dbpath + "/_tmp";
+        options.maxMemoryUsageBytes = std::size_t(initialSyncOplogBufferSpillMemoryLimitBytes);
+        return std::make_unique<OplogBufferSpill>(options);
     } else {
         return std::make_unique<OplogBufferBlockingQueue>();
     }
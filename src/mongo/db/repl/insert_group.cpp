@@ -37,9 +37,11 @@
 #include <iterator>
 
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 
@@ -51,8 +53,13 @@ namespace {
 // Must not create too large an object.
 const auto kInsertGroupMaxGroupSize = write_ops::insertVectorMaxBytes;
 
-// Limit number of ops in a single group.
-constexpr auto kInsertGroupMaxOpCount = 64;
+// The number of groups of inserts applied in bulk, and the number of inserts in them.
+Counter64 insertGroupsApplied;
+ServerStatusMetricField<Counter64> displayInsertGroupsApplied("repl.apply.insertGroups.num",
+                                                              &insertGroupsApplied);
+Counter64 insertGroupOpsApplied;
+ServerStatusMetricField<Counter64> displayInsertGroupOpsApplied("repl.apply.insertGroups.ops",
+                                                                &insertGroupOpsApplied);
 
 }  // namespace
 
@@ -97,6 +104,10 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
     auto opCount = std::vector<const OplogEntry*>::size_type(1);
     auto groupNamespace = entry.getNss();
 
+    // Limit number of ops in a single group.
+    const auto maxOpCount = std::vector<const OplogEntry*>::size_type(
+        oplogApplicationInsertGroupMaxOpCount.load());
+
     /**
      * Search for the op that delimits this insert group, and save its position
      * in endOfGroupableOpsIterator. For example, given the following list of oplog
@@ -121,7 +132,7 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
             return nextEntry->getOpType() != OpTypeEnum::kInsert  // Must be an insert.
                 || opNamespace != groupNamespace                  // Must be in the same namespace.
                 || groupSize > kInsertGroupMaxGroupSize  // Must not create too large an object.
-                || opCount > kInsertGroupMaxOpCount;     // Limit number of ops in a single group.
+                || opCount > maxOpCount;                 // Limit number of ops in a single group.
         });
 
     // See if we were able to create a group that contains more than a single op.
@@ -135,6 +146,9 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
     try {
         uassertStatusOK(
             _applyOplogEntryOrGroupedInserts(_opCtx, groupedInserts, _mode, _isDataConsistent));
+        insertGroupsApplied.increment();
+        insertGroupOpsApplied.increment(std::distance(it, endOfGroupableOpsIterator));
+
         // It succeeded, advance the oplogEntriesIterator to the end of the
         // group of inserts.
         return endOfGroupableOpsIterator - 1;
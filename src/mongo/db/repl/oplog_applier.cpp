@@ -100,7 +100,7 @@ void OplogApplier::enqueue(OperationContext* opCtx,
                            std::vector<OplogEntry>::const_iterator end) {
     OplogBuffer::Batch batch;
     for (auto i = begin; i != end; ++i) {
-        batch.push_back(i->getEntry().getRaw());
+        batch.push_back(i->getRaw());
     }
     enqueue(opCtx, batch.cbegin(), batch.cend());
 }
@@ -51,6 +51,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/platform/basic.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
 #include "mongo/util/log_with_sampling.h"
 
 namespace mongo {
@@ -73,6 +74,11 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// The number of batches written to the oplog while the previous batch was being applied.
+Counter64 pipelinedBatches;
+ServerStatusMetricField<Counter64> displayPipelinedBatches("repl.apply.pipelinedBatches",
+                                                           &pipelinedBatches);
+
 /**
  * Used for logging a report of ops that take longer than "slowMS" to apply. This is called
  * right before returning from applyOplogEntryOrGroupedInserts, and it returns the same status.
@@ -265,6 +271,11 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
             ? new ApplyBatchFinalizerForJournal(_replCoord)
             : new ApplyBatchFinalizer(_replCoord)};
 
+    // The next batch, if it was taken from the batcher while applying the previous one, and
+    // whether it has been written to the oplog since.
+    boost::optional<OplogBatch> pipelinedBatch;
+    bool pipelinedBatchWrittenToOplog = false;
+
     while (true) {  // Exits on message from OplogBatcher.
         // Use a new operation context each iteration, as otherwise we may appear to use a single
         // collection name to refer to collections with different UUIDs.
@@ -289,7 +300,10 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
         // ready in time, we'll loop again so we can do the above checks periodically.
-        OplogBatch ops = _oplogBatcher->getNextBatch(Seconds(1));
+        OplogBatch ops =
+            pipelinedBatch ? std::move(*pipelinedBatch) : _oplogBatcher->getNextBatch(Seconds(1));
+        const bool opsWrittenToOplog = std::exchange(pipelinedBatchWrittenToOplog, false);
+        pipelinedBatch.reset();
         if (ops.empty()) {
             if (ops.mustShutdown()) {
                 // Shut down and exit oplog application loop.
@@ -331,7 +345,12 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Apply the operations in this batch. '_applyOplogBatch' returns the optime of the
         // last op that was applied, which should be the last optime in the batch.
-        auto swLastOpTimeAppliedInBatch = _applyOplogBatch(&opCtx, ops.releaseBatch());
+        if (oplogApplicationPipelinesOplogWrites.load() && !getOptions().skipWritesToOplog) {
+            pipelinedBatch.emplace(0);
+        }
+        auto swLastOpTimeAppliedInBatch = _applyOplogBatch(
+            &opCtx, ops.releaseBatch(), opsWrittenToOplog, pipelinedBatch.get_ptr());
+        pipelinedBatchWrittenToOplog = pipelinedBatch && !pipelinedBatch->empty();
         if (swLastOpTimeAppliedInBatch.getStatus().code() == ErrorCodes::InterruptedAtShutdown) {
             // If an operation was interrupted at shutdown, fail the batch without advancing
             // appliedThrough as if this were an unclean shutdown. This ensures the stable timestamp
@@ -367,6 +386,10 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
     }
 }
 
+// We want to be able to take advantage of bulk inserts so we don't use multiple threads if it
+// would result too little work per thread. This also ensures that we can amortize the
+// setup/teardown overhead across many writes.
+const size_t kMinOplogEntriesPerThread = 16;
 
 // Schedules the writes to the oplog for 'ops' into threadPool. The caller must guarantee that
 // 'ops' stays valid until all scheduled work in the thread pool completes.
@@ -394,7 +417,7 @@ void scheduleWritesToOplog(OperationContext* opCtx,
             std::vector<InsertStatement> docs;
             docs.reserve(end - begin);
             for (size_t i = begin; i < end; i++) {
-                docs.emplace_back(InsertStatement{ops[i].getEntry().getRaw(),
+                docs.emplace_back(InsertStatement{ops[i].getRaw(),
                                                   ops[i].getOpTime().getTimestamp(),
                                                   ops[i].getOpTime().getTerm()});
             }
@@ -405,10 +428,6 @@ void scheduleWritesToOplog(OperationContext* opCtx,
         };
     };
 
-    // We want to be able to take advantage of bulk inserts so we don't use multiple threads if it
-    // would result too little work per thread. This also ensures that we can amortize the
-    // setup/teardown overhead across many writes.
-    const size_t kMinOplogEntriesPerThread = 16;
     const bool enoughToMultiThread =
         ops.size() >= kMinOplogEntriesPerThread * writerPool->getStats().options.maxThreads;
 
@@ -429,9 +448,53 @@ void scheduleWritesToOplog(OperationContext* opCtx,
     }
 }
 
+// Parses the fields of 'ops' left unparsed by the batcher on the threads of 'writerPool' and waits
+// for them to be parsed. Only the accessors OplogEntry::parseDeferred() allows to be called
+// concurrently may be called on 'ops' while this runs.
+void parseDeferredFields(ThreadPool* writerPool, std::vector<OplogEntry>* ops) {
+    auto parseRange = [ops](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            fassert(6114700, (*ops)[i].parseDeferredFields());
+        }
+    };
+
+    const size_t numThreads = writerPool->getStats().options.maxThreads;
+    if (ops->size() < kMinOplogEntriesPerThread * numThreads) {
+        parseRange(0, ops->size());
+        return;
+    }
+
+    std::vector<Future<void>> parsed;
+    const size_t numOpsPerThread = ops->size() / numThreads;
+    for (size_t thread = 0; thread < numThreads; thread++) {
+        size_t begin = thread * numOpsPerThread;
+        size_t end = (thread == numThreads - 1) ? ops->size() : begin + numOpsPerThread;
+        auto pf = makePromiseFuture<void>();
+        writerPool->schedule(
+            [parseRange, begin, end, promise = std::move(pf.promise)](auto status) mutable {
+                invariant(status);
+                parseRange(begin, end);
+                promise.emplaceValue();
+            });
+        parsed.push_back(std::move(pf.future));
+    }
+
+    for (auto& future : parsed) {
+        future.get();
+    }
+}
+
 StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                                                       std::vector<OplogEntry> ops) {
+    return _applyOplogBatch(opCtx, std::move(ops), false, nullptr);
+}
+
+StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
+                                                      std::vector<OplogEntry> ops,
+                                                      bool opsWrittenToOplog,
+                                                      OplogBatch* nextBatch) {
     invariant(!ops.empty());
+    invariant(!nextBatch || !getOptions().skipWritesToOplog);
 
     LOGV2_DEBUG(21230,
                 2,
@@ -463,12 +526,16 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         ON_BLOCK_EXIT([&] { _writerPool->waitForIdle(); });
 
         // Write batch of ops into oplog.
-        if (!getOptions().skipWritesToOplog) {
+        if (!getOptions().skipWritesToOplog && !opsWrittenToOplog) {
             _consistencyMarkers->setOplogTruncateAfterPoint(
                 opCtx, _replCoord->getMyLastAppliedOpTime().getTimestamp());
             scheduleWritesToOplog(opCtx, _storageInterface, _writerPool, ops);
         }
 
+        // The batcher only decoded the fields it needed to form the batch, so decode the rest of
+        // each entry in parallel before partitioning the batch between the writer threads.
+        parseDeferredFields(_writerPool, &ops);
+
         // Holds 'pseudo operations' generated by secondaries to aid in replication.
         // Keep in scope until all operations in 'ops' and 'derivedOps' have been applied.
         // Pseudo operations include:
@@ -536,6 +603,22 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                 });
             }
 
+            if (nextBatch) {
+                // The batcher only starts on the batch after the next one once the next one is
+                // taken, so take it without waiting, even if it is empty, and leave it for the
+                // caller to handle.
+                *nextBatch = _oplogBatcher->getNextBatch(Seconds(0));
+                if (!nextBatch->empty()) {
+                    // If we crash before the next batch has been fully written, truncate the oplog
+                    // back to this batch, which has been fully written.
+                    _consistencyMarkers->setOplogTruncateAfterPoint(opCtx,
+                                                                    ops.back().getTimestamp());
+                    scheduleWritesToOplog(
+                        opCtx, _storageInterface, _writerPool, nextBatch->getBatch());
+                    pipelinedBatches.increment();
+                }
+            }
+
             _writerPool->waitForIdle();
 
             // If any of the statuses is not ok, return error.
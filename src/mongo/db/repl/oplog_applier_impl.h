@@ -102,6 +102,18 @@ private:
      */
     StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * Same as above, except that the oplog writes for 'ops' are skipped if 'opsWrittenToOplog' is
+     * true, since they were already done while applying the previous batch. If 'nextBatch' is not
+     * null, the next batch is taken from the batcher into it once the writer threads have been
+     * given 'ops' to apply, and if it is not empty, it is written to the oplog by the writer
+     * threads as they finish applying 'ops'.
+     */
+    StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx,
+                                        std::vector<OplogEntry> ops,
+                                        bool opsWrittenToOplog,
+                                        OplogBatch* nextBatch);
+
     void _deriveOpsAndFillWriterVectors(OperationContext* opCtx,
                                         std::vector<OplogEntry>* ops,
                                         std::vector<std::vector<const OplogEntry*>>* writerVectors,
@@ -56,6 +56,7 @@
 #include "mongo/db/repl/idempotency_test_fixture.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/oplog_entry_test_helpers.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -539,6 +540,47 @@ TEST_F(OplogApplierImplTest,
                   secondDerivedOp.getObject()["lastWriteOpTime"]["ts"].timestamp());
 }
 
+TEST_F(OplogApplierImplTest, FillWriterVectorsSpreadsOpsOnCollectionWithUniqueIndexById) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    auto uuid = createCollectionWithUuid(_opCtx.get(), nss);
+    createIndex(_opCtx.get(),
+                nss,
+                uuid,
+                BSON("v" << 2 << "key" << BSON("x" << 1) << "name"
+                         << "x_1"
+                         << "unique" << true));
+
+    // Every insert has the same value for the unique index, so the batch is only applied in
+    // parallel if ops are partitioned by _id regardless of the unique index.
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 100; ++i) {
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i + 1), 1LL}, nss, BSON("_id" << i << "x" << 1)));
+    }
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    std::vector<std::vector<const OplogEntry*>> writerVectors(
+        writerPool->getStats().options.maxThreads);
+    std::vector<std::vector<OplogEntry>> derivedOps;
+    oplogApplier.fillWriterVectors_forTest(_opCtx.get(), &ops, &writerVectors, &derivedOps);
+
+    auto usedWriters = std::count_if(writerVectors.begin(),
+                                     writerVectors.end(),
+                                     [](const auto& writer) { return !writer.empty(); });
+    ASSERT_GT(usedWriters, 1);
+}
+
 class MultiOplogEntryOplogApplierImplTest : public OplogApplierImplTest {
 public:
     MultiOplogEntryOplogApplierImplTest()
@@ -1775,6 +1817,62 @@ TEST_F(OplogApplierImplTest,
     ASSERT_BSONOBJ_EQ(insertOps.back().getObject(), singleInsertDocumentGroup[0]);
 }
 
+TEST_F(OplogApplierImplTest, MoveInsertsAheadWithinNamespaceMovesInsertsAheadOfOtherOps) {
+    NamespaceString nss1("test.foo");
+    NamespaceString nss2("test.bar");
+    auto insert1 = makeInsertDocumentOplogEntry(
+        {Timestamp(Seconds(1), 0), 1LL}, nss1, BSON("_id" << 1));
+    auto update = makeUpdateDocumentOplogEntry(
+        {Timestamp(Seconds(2), 0), 1LL}, nss1, BSON("_id" << 0), BSON("$set" << BSON("a" << 1)));
+    auto insert2 = makeInsertDocumentOplogEntry(
+        {Timestamp(Seconds(3), 0), 1LL}, nss1, BSON("_id" << 2));
+    auto remove = makeDeleteDocumentOplogEntry(
+        {Timestamp(Seconds(4), 0), 1LL}, nss1, BSON("_id" << 3));
+    auto insert3 = makeInsertDocumentOplogEntry(
+        {Timestamp(Seconds(5), 0), 1LL}, nss1, BSON("_id" << 4));
+    auto otherInsert = makeInsertDocumentOplogEntry(
+        {Timestamp(Seconds(6), 0), 1LL}, nss2, BSON("_id" << 1));
+
+    std::vector<const OplogEntry*> ops{
+        &insert1, &update, &insert2, &remove, &insert3, &otherInsert};
+    OplogApplierUtils::moveInsertsAheadWithinNamespace(&ops);
+
+    std::vector<const OplogEntry*> expected{
+        &insert1, &insert2, &insert3, &update, &remove, &otherInsert};
+    ASSERT(ops == expected);
+}
+
+TEST_F(OplogApplierImplTest, MoveInsertsAheadWithinNamespaceKeepsOrderWhenIdsMayConflict) {
+    NamespaceString nss("test.foo");
+    auto insert1 = makeInsertDocumentOplogEntry(
+        {Timestamp(Seconds(1), 0), 1LL}, nss, BSON("_id" << 1));
+    auto remove = makeDeleteDocumentOplogEntry(
+        {Timestamp(Seconds(2), 0), 1LL}, nss, BSON("_id" << 2));
+    auto insert2 = makeInsertDocumentOplogEntry(
+        {Timestamp(Seconds(3), 0), 1LL}, nss, BSON("_id" << 2));
+
+    // The delete must stay ahead of the insert of the same _id.
+    std::vector<const OplogEntry*> ops{&insert1, &remove, &insert2};
+    auto expected = ops;
+    OplogApplierUtils::moveInsertsAheadWithinNamespace(&ops);
+    ASSERT(ops == expected);
+
+    // An update on a string _id may match the _id of an insert under the collation.
+    auto update = makeUpdateDocumentOplogEntry({Timestamp(Seconds(4), 0), 1LL},
+                                               nss,
+                                               BSON("_id"
+                                                    << "a"),
+                                               BSON("$set" << BSON("a" << 1)));
+    auto insert3 = makeInsertDocumentOplogEntry({Timestamp(Seconds(5), 0), 1LL},
+                                                nss,
+                                                BSON("_id"
+                                                     << "A"));
+    ops = {&insert1, &update, &insert3};
+    expected = ops;
+    OplogApplierUtils::moveInsertsAheadWithinNamespace(&ops);
+    ASSERT(ops == expected);
+}
+
 // Create an 'insert' oplog operation of an approximate size in bytes. The '_id' of the oplog entry
 // and its optime in seconds are given by the 'id' argument.
 OplogEntry makeSizedInsertOp(const NamespaceString& nss, int size, int id) {
@@ -31,6 +31,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/document_validation.h"
@@ -58,6 +61,51 @@ CachedCollectionProperties::getCollectionProperties(OperationContext* opCtx,
     return collProperties;
 }
 
+namespace {
+
+/**
+ * Returns true if the inserts in the run of ops on a single namespace [begin, end) can be applied
+ * before its other ops.
+ */
+bool canMoveInsertsAhead(std::vector<const OplogEntry*>::const_iterator begin,
+                         std::vector<const OplogEntry*>::const_iterator end) {
+    auto otherIds = SimpleBSONElementComparator::kInstance.makeBSONEltUnorderedSet();
+    size_t numInserts = 0;
+    for (auto it = begin; it != end; ++it) {
+        const auto& op = **it;
+        if (!op.isCrudOpType() || op.isForCappedCollection()) {
+            return false;
+        }
+        if (op.getOpType() == OpTypeEnum::kInsert) {
+            ++numInserts;
+            continue;
+        }
+
+        // The hash which assigned the ops to this writer uses the collator of the collection, so
+        // _ids holding strings may match a different _id of an insert.
+        auto id = op.getIdElement();
+        switch (id.type()) {
+            case EOO:
+            case String:
+            case Symbol:
+            case Object:
+            case Array:
+                return false;
+            default:
+                otherIds.insert(id);
+        }
+    }
+    if (numInserts < 2 || otherIds.empty()) {
+        return false;
+    }
+
+    return std::none_of(begin, end, [&](const OplogEntry* op) {
+        return op->getOpType() == OpTypeEnum::kInsert && otherIds.count(op->getIdElement());
+    });
+}
+
+}  // namespace
+
 CachedCollectionProperties::CollectionProperties
 CachedCollectionProperties::getCollectionPropertiesImpl(OperationContext* opCtx,
                                                         const NamespaceString& nss) {
@@ -86,6 +134,11 @@ void OplogApplierUtils::processCrudOp(OperationContext* opCtx,
     //
     // For capped collections, this is illegal, since capped collections must preserve
     // insertion order.
+    //
+    // Unique secondary indexes do not need ops to be serialized. Writers apply ops with
+    // constraints relaxed, so a key which is only transiently duplicated because ops on different
+    // documents apply out of order within the batch does not fail, and the indexes are consistent
+    // again once the whole batch is applied.
     if (!collProperties.isCapped) {
         BSONElement id = op->getIdElement();
         BSONElementComparator elementHasher(BSONElementComparator::FieldNamesMode::kIgnore,
@@ -144,6 +197,23 @@ void OplogApplierUtils::stableSortByNamespace(std::vector<const OplogEntry*>* op
     std::stable_sort(oplogEntryPointers->begin(), oplogEntryPointers->end(), nssComparator);
 }
 
+void OplogApplierUtils::moveInsertsAheadWithinNamespace(
+    std::vector<const OplogEntry*>* oplogEntryPointers) {
+    auto runStart = oplogEntryPointers->begin();
+    while (runStart != oplogEntryPointers->end()) {
+        const auto& nss = (*runStart)->getNss();
+        auto runEnd = std::find_if(runStart, oplogEntryPointers->end(), [&](const OplogEntry* op) {
+            return op->getNss() != nss;
+        });
+        if (canMoveInsertsAhead(runStart, runEnd)) {
+            std::stable_partition(runStart, runEnd, [](const OplogEntry* op) {
+                return op->getOpType() == OpTypeEnum::kInsert;
+            });
+        }
+        runStart = runEnd;
+    }
+}
+
 void OplogApplierUtils::addDerivedOps(OperationContext* opCtx,
                                       std::vector<OplogEntry>* derivedOps,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors,
@@ -287,6 +357,9 @@ Status OplogApplierUtils::applyOplogBatchCommon(
     // Group the operations by namespace in order to get larger groups for bulk inserts, but do not
     // mix up the current order of oplog entries within the same namespace (thus *stable* sort).
     stableSortByNamespace(ops);
+    if (oplogApplicationReordersInserts.load()) {
+        moveInsertsAheadWithinNamespace(ops);
+    }
     InsertGroup insertGroup(
         ops, opCtx, oplogApplicationMode, isDataConsistent, applyOplogEntryOrGroupedInserts);
 
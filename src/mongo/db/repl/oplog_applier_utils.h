@@ -73,6 +73,15 @@ public:
      */
     static void stableSortByNamespace(std::vector<const OplogEntry*>* oplogEntryPointers);
 
+    /**
+     * Within each run of CRUD ops on the same namespace, as produced by stableSortByNamespace(),
+     * moves the inserts ahead of the other ops while keeping the relative order of the inserts
+     * and of the other ops, so that the inserts can be grouped. A run is left unchanged unless
+     * none of its updates and deletes can touch a document inserted in the run, which is the case
+     * when their _ids differ and cannot compare equal under a collation.
+     */
+    static void moveInsertsAheadWithinNamespace(std::vector<const OplogEntry*>* oplogEntryPointers);
+
     /**
      * Updates a CRUD op's hash and isForCappedCollection field if necessary.
      */
@@ -160,7 +160,9 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
     std::vector<OplogEntry> ops;
     BSONObj op;
     while (_oplogBuffer->peek(opCtx, &op)) {
-        auto entry = OplogEntry(op);
+        // Only decode the fields needed to batch the entry. The applier decodes the rest of the
+        // entries of the batch in parallel.
+        auto entry = OplogEntry::parseDeferred(op);
 
         // Check for oplog version change.
         if (entry.getVersion() != OplogEntry::kOplogVersion) {
@@ -282,8 +284,8 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
 
             auto oplogEntries =
                 fassertNoTrace(31004, getNextApplierBatch(opCtx.get(), batchLimits));
-            for (const auto& oplogEntry : oplogEntries) {
-                ops.emplace_back(oplogEntry);
+            for (auto& oplogEntry : oplogEntries) {
+                ops.emplace_back(std::move(oplogEntry));
             }
 
             // If we don't have anything in the batch, wait a bit for something to appear.
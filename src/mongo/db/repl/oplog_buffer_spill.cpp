@@ -0,0 +1,292 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_spill.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+namespace repl {
+
+OplogBufferSpill::OplogBufferSpill(Options options, Counters* counters)
+    : _options(std::move(options)),
+      _counters(counters),
+      _segmentPathPrefix((boost::filesystem::path(_options.spillDirectory) /
+                          ("oplogBuffer-" + UUID::gen().toString() + "-"))
+                             .string()) {}
+
+OplogBufferSpill::~OplogBufferSpill() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _removeSegments(lk);
+}
+
+void OplogBufferSpill::startup(OperationContext*) {
+    boost::filesystem::create_directories(_options.spillDirectory);
+
+    // Update server status metric to reflect the current oplog buffer's max size.
+    if (_counters) {
+        _counters->setMaxSize(getMaxSize());
+    }
+}
+
+void OplogBufferSpill::shutdown(OperationContext* opCtx) {
+    clear(opCtx);
+}
+
+void OplogBufferSpill::push(OperationContext*,
+                            Batch::const_iterator begin,
+                            Batch::const_iterator end) {
+    if (begin == end) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(!_drainMode);
+    bool spilled = false;
+    for (auto it = begin; it != end; ++it) {
+        auto size = std::size_t(it->objsize());
+
+        // Once an entry is spilled, the entries pushed after it have to be spilled too until the
+        // segments are read back, so that they are popped in order.
+        if (_segments.empty() && _memorySize + size <= _options.maxMemoryUsageBytes) {
+            _memory.push_back(*it);
+            _memorySize += size;
+        } else {
+            _spill(lk, *it);
+            spilled = true;
+        }
+        _count++;
+        _size += size;
+        if (_counters) {
+            _counters->increment(*it);
+        }
+    }
+    if (spilled) {
+        _writer.flush();
+        uassert(6103701,
+                str::stream() << "Failed to write to oplog buffer file " << _segments.back().path,
+                _writer.good());
+    }
+    _lastPushed = *(end - 1);
+    _notEmptyCv.notify_one();
+}
+
+void OplogBufferSpill::waitForSpace(OperationContext*, std::size_t) {}
+
+bool OplogBufferSpill::isEmpty() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _count == 0;
+}
+
+std::size_t OplogBufferSpill::getMaxSize() const {
+    return 0;
+}
+
+std::size_t OplogBufferSpill::getSize() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _size;
+}
+
+std::size_t OplogBufferSpill::getCount() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _count;
+}
+
+void OplogBufferSpill::clear(OperationContext*) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _clear(lk);
+}
+
+bool OplogBufferSpill::tryPop(OperationContext*, Value* value) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _refill(lk);
+    if (_memory.empty()) {
+        return false;
+    }
+    *value = std::move(_memory.front());
+    _memory.pop_front();
+
+    auto size = std::size_t(value->objsize());
+    _memorySize -= size;
+    _count--;
+    _size -= size;
+    if (_counters) {
+        _counters->decrement(*value);
+    }
+    return true;
+}
+
+bool OplogBufferSpill::waitForData(Seconds waitDuration) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _notEmptyCv.wait_for(
+        lk, waitDuration.toSystemDuration(), [&] { return _drainMode || _count > 0; });
+    return _count > 0;
+}
+
+bool OplogBufferSpill::peek(OperationContext*, Value* value) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _refill(lk);
+    if (_memory.empty()) {
+        return false;
+    }
+    *value = _memory.front();
+    return true;
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferSpill::lastObjectPushed(OperationContext*) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _lastPushed;
+}
+
+void OplogBufferSpill::enterDrainMode() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drainMode = true;
+    _notEmptyCv.notify_one();
+}
+
+void OplogBufferSpill::exitDrainMode() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drainMode = false;
+}
+
+std::size_t OplogBufferSpill::getNumSegments_forTest() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _segments.size();
+}
+
+void OplogBufferSpill::_spill(WithLock, const Value& value) {
+    if (_segments.empty() || _segments.back().size >= _options.maxSegmentSizeBytes) {
+        if (_writer.is_open()) {
+            _writer.close();
+        }
+        Segment segment;
+        segment.path = _segmentPathPrefix + std::to_string(_nextSegmentId++);
+        _writer.open(segment.path, std::ios::binary | std::ios::out | std::ios::trunc);
+        uassert(6103700,
+                str::stream() << "Failed to open oplog buffer file " << segment.path,
+                _writer.is_open());
+        _segments.push_back(std::move(segment));
+    }
+
+    auto& segment = _segments.back();
+    _writer.write(value.objdata(), value.objsize());
+    uassert(6103702,
+            str::stream() << "Failed to write to oplog buffer file " << segment.path,
+            _writer.good());
+    segment.count++;
+    segment.size += std::size_t(value.objsize());
+}
+
+void OplogBufferSpill::_refill(WithLock) {
+    if (!_memory.empty() || _segments.empty()) {
+        return;
+    }
+
+    auto& segment = _segments.front();
+    if (!_reader.is_open()) {
+        _reader.open(segment.path, std::ios::binary | std::ios::in);
+        uassert(6103703,
+                str::stream() << "Failed to open oplog buffer file " << segment.path,
+                _reader.is_open());
+    }
+
+    // Read the entries of the segment into memory until the memory limit, reading at least one.
+    while (segment.countRead < segment.count &&
+           (_memory.empty() || _memorySize < _options.maxMemoryUsageBytes)) {
+        char sizeBuf[sizeof(int32_t)];
+        _reader.read(sizeBuf, sizeof(sizeBuf));
+        auto size = ConstDataView(sizeBuf).read<LittleEndian<int32_t>>();
+        uassert(6103704,
+                str::stream() << "Failed to read from oplog buffer file " << segment.path,
+                _reader.good() && size >= BSONObj::kMinBSONLength &&
+                    size <= BSONObjMaxInternalSize);
+
+        auto buffer = SharedBuffer::allocate(size);
+        std::memcpy(buffer.get(), sizeBuf, sizeof(sizeBuf));
+        _reader.read(buffer.get() + sizeof(sizeBuf), size - sizeof(sizeBuf));
+        uassert(6103705,
+                str::stream() << "Failed to read from oplog buffer file " << segment.path,
+                _reader.good());
+
+        _memory.emplace_back(std::move(buffer));
+        _memorySize += std::size_t(size);
+        segment.countRead++;
+    }
+
+    // Remove the segment once all of its entries have been read. If it is the one being written,
+    // the next spilled entry starts a new segment.
+    if (segment.countRead == segment.count) {
+        _reader.close();
+        if (_segments.size() == 1 && _writer.is_open()) {
+            _writer.close();
+        }
+        boost::filesystem::remove(segment.path);
+        _segments.pop_front();
+    } else {
+        // Entries may be appended to the segment after this read, so let the next read see them.
+        _reader.clear();
+    }
+}
+
+void OplogBufferSpill::_removeSegments(WithLock) {
+    if (_writer.is_open()) {
+        _writer.close();
+    }
+    if (_reader.is_open()) {
+        _reader.close();
+    }
+    for (const auto& segment : _segments) {
+        boost::system::error_code ec;
+        boost::filesystem::remove(segment.path, ec);
+    }
+    _segments.clear();
+}
+
+void OplogBufferSpill::_clear(WithLock lk) {
+    _removeSegments(lk);
+    _memory.clear();
+    _memorySize = 0;
+    _count = 0;
+    _size = 0;
+    _lastPushed = boost::none;
+    if (_counters) {
+        _counters->clear();
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
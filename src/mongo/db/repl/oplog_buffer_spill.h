@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <fstream>
+#include <string>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Oplog buffer which keeps oplog entries in memory up to a limit, and appends the entries pushed
+ * past it to segment files on disk, which are read back in order once the entries in memory have
+ * been popped. Unlike OplogBufferCollection, buffering an entry costs no storage engine write, and
+ * unlike OplogBufferBlockingQueue, pushing never blocks on space.
+ *
+ * Entries held in memory are handed out without being copied. Each segment file is removed once
+ * all of its entries have been read.
+ */
+class OplogBufferSpill final : public OplogBuffer {
+public:
+    struct Options {
+        // Directory holding the segment files.
+        std::string spillDirectory;
+
+        // Total size of the entries held in memory, above which pushed entries are spilled.
+        std::size_t maxMemoryUsageBytes = 256 * 1024 * 1024;
+
+        // Size of a segment file above which pushed entries are spilled to a new one.
+        std::size_t maxSegmentSizeBytes = 64 * 1024 * 1024;
+    };
+
+    explicit OplogBufferSpill(Options options, Counters* counters = nullptr);
+    ~OplogBufferSpill();
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void push(OperationContext* opCtx,
+              Batch::const_iterator begin,
+              Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+    void enterDrainMode() final;
+    void exitDrainMode() final;
+
+    /**
+     * Returns the number of segment files currently on disk.
+     */
+    std::size_t getNumSegments_forTest() const;
+
+private:
+    struct Segment {
+        std::string path;
+        std::size_t count = 0;
+        std::size_t size = 0;
+        std::size_t countRead = 0;
+    };
+
+    /**
+     * Appends 'value' to the last segment file, starting a new one if needed.
+     */
+    void _spill(WithLock, const Value& value);
+
+    /**
+     * Reads entries from the first segment file into memory if none are left in memory. Removes
+     * the segment file once all of its entries have been read.
+     */
+    void _refill(WithLock);
+
+    /**
+     * Closes and removes all segment files.
+     */
+    void _removeSegments(WithLock);
+
+    void _clear(WithLock);
+
+    const Options _options;
+    Counters* const _counters;
+
+    // Each segment file is named after this prefix and a sequence number.
+    const std::string _segmentPathPrefix;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogBufferSpill::_mutex");
+    stdx::condition_variable _notEmptyCv;
+
+    // The oldest entries, followed by the entries of '_segments' in the order they were pushed.
+    std::deque<Value> _memory;
+    std::size_t _memorySize = 0;
+
+    std::deque<Segment> _segments;
+    std::size_t _nextSegmentId = 0;
+
+    // Appends to the last segment, and reads from the first one.
+    std::ofstream _writer;
+    std::ifstream _reader;
+
+    std::size_t _count = 0;
+    std::size_t _size = 0;
+    boost::optional<Value> _lastPushed;
+    bool _drainMode = false;
+};
+
+}  // namespace repl
+}  // namespace mongo
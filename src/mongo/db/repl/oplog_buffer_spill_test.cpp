@@ -0,0 +1,217 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_spill.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+BSONObj makeOplogEntry(int i) {
+    return BSON("ts" << Timestamp(1, i) << "op"
+                     << "i"
+                     << "o" << BSON("_id" << i << "pad" << std::string(100, 'x')));
+}
+
+class OplogBufferSpillTest : public unittest::Test {
+protected:
+    OplogBufferSpill::Options makeOptions(std::size_t memoryEntries, std::size_t segmentEntries) {
+        auto entrySize = std::size_t(makeOplogEntry(0).objsize());
+        OplogBufferSpill::Options options;
+        options.spillDirectory = _tempDir.path();
+        options.maxMemoryUsageBytes = memoryEntries * entrySize;
+        options.maxSegmentSizeBytes = segmentEntries * entrySize;
+        return options;
+    }
+
+    std::size_t countFiles() const {
+        return std::distance(boost::filesystem::directory_iterator(_tempDir.path()),
+                             boost::filesystem::directory_iterator());
+    }
+
+    void pushRange(OplogBufferSpill* buffer, int begin, int end) {
+        OplogBuffer::Batch batch;
+        for (int i = begin; i < end; ++i) {
+            batch.push_back(makeOplogEntry(i));
+        }
+        buffer->push(nullptr, batch.cbegin(), batch.cend());
+    }
+
+    void popRange(OplogBufferSpill* buffer, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            BSONObj doc;
+            ASSERT_TRUE(buffer->tryPop(nullptr, &doc));
+            ASSERT_BSONOBJ_EQ(makeOplogEntry(i), doc);
+        }
+    }
+
+    unittest::TempDir _tempDir{"oplogBufferSpillTest"};
+};
+
+TEST_F(OplogBufferSpillTest, PushAndPopInMemoryDoesNotSpill) {
+    OplogBufferSpill buffer(makeOptions(10, 4));
+    buffer.startup(nullptr);
+
+    pushRange(&buffer, 0, 10);
+    ASSERT_EQUALS(10U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getNumSegments_forTest());
+    ASSERT_EQUALS(0U, countFiles());
+
+    popRange(&buffer, 0, 10);
+    ASSERT_TRUE(buffer.isEmpty());
+    BSONObj doc;
+    ASSERT_FALSE(buffer.tryPop(nullptr, &doc));
+}
+
+TEST_F(OplogBufferSpillTest, EntriesPastMemoryLimitAreSpilledAndPoppedInOrder) {
+    OplogBufferSpill buffer(makeOptions(3, 4));
+    buffer.startup(nullptr);
+
+    pushRange(&buffer, 0, 12);
+    ASSERT_EQUALS(12U, buffer.getCount());
+    ASSERT_EQUALS(12U * makeOplogEntry(0).objsize(), buffer.getSize());
+    // 9 entries past the memory limit are spilled to 3 segments of 4, 4 and 1 entries.
+    ASSERT_EQUALS(3U, buffer.getNumSegments_forTest());
+    ASSERT_EQUALS(3U, countFiles());
+
+    // Entries pushed after a spill keep being spilled while segments remain.
+    popRange(&buffer, 0, 2);
+    pushRange(&buffer, 12, 14);
+    ASSERT_EQUALS(12U, buffer.getCount());
+
+    popRange(&buffer, 2, 14);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0U, buffer.getNumSegments_forTest());
+    ASSERT_EQUALS(0U, countFiles());
+}
+
+TEST_F(OplogBufferSpillTest, SegmentIsRemovedOnceRead) {
+    OplogBufferSpill buffer(makeOptions(2, 2));
+    buffer.startup(nullptr);
+
+    pushRange(&buffer, 0, 6);
+    ASSERT_EQUALS(2U, buffer.getNumSegments_forTest());
+
+    // Popping the entries in memory reads the first segment into memory and removes it.
+    popRange(&buffer, 0, 3);
+    ASSERT_EQUALS(1U, buffer.getNumSegments_forTest());
+    ASSERT_EQUALS(1U, countFiles());
+
+    popRange(&buffer, 3, 6);
+    ASSERT_EQUALS(0U, countFiles());
+
+    // Memory is free again, so the next entries are not spilled.
+    pushRange(&buffer, 6, 8);
+    ASSERT_EQUALS(0U, buffer.getNumSegments_forTest());
+    popRange(&buffer, 6, 8);
+}
+
+TEST_F(OplogBufferSpillTest, EntriesAppendedToPartiallyReadSegmentArePopped) {
+    OplogBufferSpill buffer(makeOptions(1, 10));
+    buffer.startup(nullptr);
+
+    pushRange(&buffer, 0, 3);
+    popRange(&buffer, 0, 2);
+    pushRange(&buffer, 3, 5);
+    ASSERT_EQUALS(1U, buffer.getNumSegments_forTest());
+    popRange(&buffer, 2, 5);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, countFiles());
+}
+
+TEST_F(OplogBufferSpillTest, PeekReturnsSpilledEntryWithoutPoppingIt) {
+    OplogBufferSpill buffer(makeOptions(1, 4));
+    buffer.startup(nullptr);
+
+    pushRange(&buffer, 0, 3);
+    popRange(&buffer, 0, 1);
+
+    BSONObj doc;
+    ASSERT_TRUE(buffer.peek(nullptr, &doc));
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(1), doc);
+    ASSERT_EQUALS(2U, buffer.getCount());
+    popRange(&buffer, 1, 3);
+    ASSERT_FALSE(buffer.peek(nullptr, &doc));
+}
+
+TEST_F(OplogBufferSpillTest, LastObjectPushedReturnsSpilledEntry) {
+    OplogBufferSpill buffer(makeOptions(1, 4));
+    buffer.startup(nullptr);
+    ASSERT_FALSE(buffer.lastObjectPushed(nullptr));
+
+    pushRange(&buffer, 0, 5);
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(4), *buffer.lastObjectPushed(nullptr));
+}
+
+TEST_F(OplogBufferSpillTest, ClearRemovesSegments) {
+    OplogBufferSpill buffer(makeOptions(1, 2));
+    buffer.startup(nullptr);
+
+    pushRange(&buffer, 0, 6);
+    ASSERT_NOT_EQUALS(0U, countFiles());
+
+    buffer.clear(nullptr);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_FALSE(buffer.lastObjectPushed(nullptr));
+    ASSERT_EQUALS(0U, countFiles());
+
+    pushRange(&buffer, 6, 10);
+    popRange(&buffer, 6, 10);
+}
+
+TEST_F(OplogBufferSpillTest, DestructorRemovesSegments) {
+    {
+        OplogBufferSpill buffer(makeOptions(1, 2));
+        buffer.startup(nullptr);
+        pushRange(&buffer, 0, 6);
+        ASSERT_NOT_EQUALS(0U, countFiles());
+    }
+    ASSERT_EQUALS(0U, countFiles());
+}
+
+TEST_F(OplogBufferSpillTest, WaitForDataReturnsOnceEntryIsPushed) {
+    OplogBufferSpill buffer(makeOptions(1, 2));
+    buffer.startup(nullptr);
+    ASSERT_FALSE(buffer.waitForData(Seconds(0)));
+
+    pushRange(&buffer, 0, 2);
+    ASSERT_TRUE(buffer.waitForData(Seconds(10)));
+}
+
+}  // namespace
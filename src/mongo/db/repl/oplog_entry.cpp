@@ -487,8 +487,24 @@ OplogEntry::OplogEntry(DurableOplogEntry entry) : _entry(std::move(entry)) {}
 
 OplogEntry::OplogEntry(const BSONObj& entry)
     : OplogEntry(uassertStatusOK(DurableOplogEntry::parse(entry))) {}
+
+OplogEntry::OplogEntry(BatchingFields batchingFields)
+    : _batchingFields(std::move(batchingFields)) {}
+
+const DurableOplogEntry& OplogEntry::getEntry() const {
+    return _parsedEntry();
+}
+
+const DurableOplogEntry& OplogEntry::_parsedEntry() const {
+    if (!_entry) {
+        _entry.emplace(uassertStatusOK(DurableOplogEntry::parse(_batchingFields->raw)));
+    }
+    return *_entry;
+}
+
 void OplogEntry::setEntry(DurableOplogEntry entry) {
     _entry = std::move(entry);
+    _batchingFields.reset();
 }
 
 bool operator==(const OplogEntry& lhs, const OplogEntry& rhs) {
@@ -508,12 +524,100 @@ StatusWith<OplogEntry> OplogEntry::parse(const BSONObj& object) {
 
     return OplogEntry(std::move(parseStatus.getValue()));
 }
+
+OplogEntry OplogEntry::parseDeferred(const BSONObj& object) {
+    IDLParserErrorContext ctxt("OplogEntryBase");
+    BatchingFields fields;
+    fields.raw = object.getOwned();
+
+    bool hasTimestamp = false;
+    bool hasWallClockTime = false;
+    bool hasOpType = false;
+    bool hasNss = false;
+    bool hasObject = false;
+    for (auto&& elem : fields.raw) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kTimestampFieldName) {
+            if (ctxt.checkAndAssertType(elem, bsonTimestamp)) {
+                fields.timestamp = elem.timestamp();
+                hasTimestamp = true;
+            }
+        } else if (fieldName == kTermFieldName) {
+            if (ctxt.checkAndAssertType(elem, NumberLong)) {
+                fields.term = elem._numberLong();
+            }
+        } else if (fieldName == kWallClockTimeFieldName) {
+            if (ctxt.checkAndAssertType(elem, Date)) {
+                fields.wallClockTime = elem.date();
+                hasWallClockTime = true;
+            }
+        } else if (fieldName == kVersionFieldName) {
+            if (ctxt.checkAndAssertTypes(elem,
+                                         {NumberLong, NumberInt, NumberDecimal, NumberDouble})) {
+                fields.version = elem.safeNumberLong();
+            }
+        } else if (fieldName == kOpTypeFieldName) {
+            if (ctxt.checkAndAssertType(elem, String)) {
+                fields.opType = OpType_parse(ctxt, elem.valueStringData());
+                hasOpType = true;
+            }
+        } else if (fieldName == kNssFieldName) {
+            if (ctxt.checkAndAssertType(elem, String)) {
+                fields.nss = NamespaceString(elem.valueStringData());
+                hasNss = true;
+            }
+        } else if (fieldName == kObjectFieldName) {
+            if (ctxt.checkAndAssertType(elem, Object)) {
+                fields.object = elem.Obj();
+                hasObject = true;
+            }
+        }
+    }
+
+    if (!hasTimestamp) {
+        ctxt.throwMissingField(kTimestampFieldName);
+    }
+    if (!hasWallClockTime) {
+        ctxt.throwMissingField(kWallClockTimeFieldName);
+    }
+    if (!hasOpType) {
+        ctxt.throwMissingField(kOpTypeFieldName);
+    }
+    if (!hasNss) {
+        ctxt.throwMissingField(kNssFieldName);
+    }
+    if (!hasObject) {
+        ctxt.throwMissingField(kObjectFieldName);
+    }
+
+    if (fields.opType == OpTypeEnum::kCommand) {
+        fields.commandType = parseCommandType(fields.object);
+    }
+    return OplogEntry(std::move(fields));
+}
+
+Status OplogEntry::parseDeferredFields() {
+    if (_entry) {
+        return Status::OK();
+    }
+
+    auto swEntry = DurableOplogEntry::parse(_batchingFields->raw);
+    if (!swEntry.isOK()) {
+        return swEntry.getStatus();
+    }
+    _entry.emplace(std::move(swEntry.getValue()));
+    return Status::OK();
+}
+
+const BSONObj& OplogEntry::getRaw() const {
+    return _batchingFields ? _batchingFields->raw : _parsedEntry().getRaw();
+}
 std::string OplogEntry::toStringForLogging() const {
     return toBSONForLogging().toString();
 }
 BSONObj OplogEntry::toBSONForLogging() const {
     BSONObjBuilder builder;
-    auto entry = _entry.toBSON();
+    auto entry = getRaw();
     auto estimatedTotalSize = entry.objsize();
 
     const auto sizeTooBig = 0.9 * BSONObj::DefaultSizeTrait::MaxSize;
@@ -582,162 +686,168 @@ void OplogEntry::setPostImageOp(const BSONObj& postImageOp) {
 }
 
 const boost::optional<mongo::Value>& OplogEntry::get_id() const& {
-    return _entry.get_id();
+    return _parsedEntry().get_id();
 }
 
 std::vector<StmtId> OplogEntry::getStatementIds() const& {
-    return _entry.getStatementIds();
+    return _parsedEntry().getStatementIds();
 }
 
 const OperationSessionInfo& OplogEntry::getOperationSessionInfo() const {
-    return _entry.getOperationSessionInfo();
+    return _parsedEntry().getOperationSessionInfo();
 }
 const boost::optional<mongo::LogicalSessionId>& OplogEntry::getSessionId() const {
-    return _entry.getSessionId();
+    return _parsedEntry().getSessionId();
 }
 
 const boost::optional<std::int64_t> OplogEntry::getTxnNumber() const {
-    return _entry.getTxnNumber();
+    return _parsedEntry().getTxnNumber();
 }
 
 const DurableReplOperation& OplogEntry::getDurableReplOperation() const {
-    return _entry.getDurableReplOperation();
+    return _parsedEntry().getDurableReplOperation();
 }
 
 mongo::repl::OpTypeEnum OplogEntry::getOpType() const {
-    return _entry.getOpType();
+    return _batchingFields ? _batchingFields->opType : _parsedEntry().getOpType();
 }
 
 const mongo::NamespaceString& OplogEntry::getNss() const {
-    return _entry.getNss();
+    return _batchingFields ? _batchingFields->nss : _parsedEntry().getNss();
 }
 
 const boost::optional<mongo::UUID>& OplogEntry::getUuid() const {
-    return _entry.getUuid();
+    return _parsedEntry().getUuid();
 }
 
 const mongo::BSONObj& OplogEntry::getObject() const {
-    return _entry.getObject();
+    return _batchingFields ? _batchingFields->object : _parsedEntry().getObject();
 }
 
 const boost::optional<mongo::BSONObj>& OplogEntry::getObject2() const {
-    return _entry.getObject2();
+    return _parsedEntry().getObject2();
 }
 
 const boost::optional<bool> OplogEntry::getUpsert() const {
-    return _entry.getUpsert();
+    return _parsedEntry().getUpsert();
 }
 
 const boost::optional<mongo::repl::OpTime>& OplogEntry::getPreImageOpTime() const {
-    return _entry.getPreImageOpTime();
+    return _parsedEntry().getPreImageOpTime();
 }
 
 const boost::optional<mongo::ShardId>& OplogEntry::getDestinedRecipient() const {
-    return _entry.getDestinedRecipient();
+    return _parsedEntry().getDestinedRecipient();
 }
 
 const mongo::Timestamp& OplogEntry::getTimestamp() const {
-    return _entry.getTimestamp();
+    return _batchingFields ? _batchingFields->timestamp : _parsedEntry().getTimestamp();
 }
 
 const boost::optional<std::int64_t> OplogEntry::getTerm() const {
-    return _entry.getTerm();
+    return _batchingFields ? _batchingFields->term : _parsedEntry().getTerm();
 }
 
 const mongo::Date_t& OplogEntry::getWallClockTime() const {
-    return _entry.getWallClockTime();
+    return _batchingFields ? _batchingFields->wallClockTime : _parsedEntry().getWallClockTime();
 }
 
 const boost::optional<std::int64_t> OplogEntry::getHash() const& {
-    return _entry.getHash();
+    return _parsedEntry().getHash();
 }
 
 std::int64_t OplogEntry::getVersion() const {
-    return _entry.getVersion();
+    return _batchingFields ? _batchingFields->version : _parsedEntry().getVersion();
 }
 
 const boost::optional<bool> OplogEntry::getFromMigrate() const& {
-    return _entry.getFromMigrate();
+    return _parsedEntry().getFromMigrate();
 }
 
 const boost::optional<mongo::UUID>& OplogEntry::getFromTenantMigration() const& {
-    return _entry.getFromTenantMigration();
+    return _parsedEntry().getFromTenantMigration();
 }
 
 const boost::optional<mongo::repl::OpTime>& OplogEntry::getPrevWriteOpTimeInTransaction() const& {
-    return _entry.getPrevWriteOpTimeInTransaction();
+    return _parsedEntry().getPrevWriteOpTimeInTransaction();
 }
 
 const boost::optional<mongo::repl::OpTime>& OplogEntry::getPostImageOpTime() const& {
-    return _entry.getPostImageOpTime();
+    return _parsedEntry().getPostImageOpTime();
 }
 
 const boost::optional<RetryImageEnum> OplogEntry::getNeedsRetryImage() const {
-    return _entry.getNeedsRetryImage();
+    return _parsedEntry().getNeedsRetryImage();
 }
 
 OpTime OplogEntry::getOpTime() const {
-    return _entry.getOpTime();
+    if (_batchingFields) {
+        return OpTime(_batchingFields->timestamp,
+                      _batchingFields->term.value_or(OpTime::kUninitializedTerm));
+    }
+    return _parsedEntry().getOpTime();
 }
 
 bool OplogEntry::isCommand() const {
-    return _entry.isCommand();
+    return getOpType() == OpTypeEnum::kCommand;
 }
 
 bool OplogEntry::isPartialTransaction() const {
-    return _entry.isPartialTransaction();
+    return getCommandType() == CommandType::kApplyOps &&
+        getObject()[ApplyOpsCommandInfoBase::kPartialTxnFieldName].booleanSafe();
 }
 
 bool OplogEntry::isEndOfLargeTransaction() const {
-    return _entry.isEndOfLargeTransaction();
+    return _parsedEntry().isEndOfLargeTransaction();
 }
 
 bool OplogEntry::isPreparedCommit() const {
-    return _entry.isPreparedCommit();
+    return _parsedEntry().isPreparedCommit();
 }
 
 bool OplogEntry::isTerminalApplyOps() const {
-    return _entry.isTerminalApplyOps();
+    return _parsedEntry().isTerminalApplyOps();
 }
 
 bool OplogEntry::isSingleOplogEntryTransaction() const {
-    return _entry.isSingleOplogEntryTransaction();
+    return _parsedEntry().isSingleOplogEntryTransaction();
 }
 
 bool OplogEntry::isSingleOplogEntryTransactionWithCommand() const {
-    return _entry.isSingleOplogEntryTransactionWithCommand();
+    return _parsedEntry().isSingleOplogEntryTransactionWithCommand();
 }
 
 bool OplogEntry::isCrudOpType() const {
-    return _entry.isCrudOpType();
+    return _parsedEntry().isCrudOpType();
 }
 
 bool OplogEntry::isIndexCommandType() const {
-    return _entry.isIndexCommandType();
+    return _parsedEntry().isIndexCommandType();
 }
 
 bool OplogEntry::shouldPrepare() const {
-    return _entry.shouldPrepare();
+    return getCommandType() == CommandType::kApplyOps &&
+        getObject()[ApplyOpsCommandInfoBase::kPrepareFieldName].booleanSafe();
 }
 
 BSONElement OplogEntry::getIdElement() const {
-    return _entry.getIdElement();
+    return _parsedEntry().getIdElement();
 }
 
 BSONObj OplogEntry::getOperationToApply() const {
-    return _entry.getOperationToApply();
+    return _parsedEntry().getOperationToApply();
 }
 
 BSONObj OplogEntry::getObjectContainingDocumentKey() const {
-    return _entry.getObjectContainingDocumentKey();
+    return _parsedEntry().getObjectContainingDocumentKey();
 }
 
 OplogEntry::CommandType OplogEntry::getCommandType() const {
-    return _entry.getCommandType();
+    return _batchingFields ? _batchingFields->commandType : _parsedEntry().getCommandType();
 }
 
 int OplogEntry::getRawObjSizeBytes() const {
-    return _entry.getRawObjSizeBytes();
+    return getRaw().objsize();
 }
 
 }  // namespace repl
@@ -76,9 +76,29 @@ public:
         _fullPreImage = std::move(value);
     }
 
+    /**
+     * Serializes the operation ahead of the applyOps entry of its transaction, so that the commit
+     * only has to copy it in. Anything set on the operation afterwards must discard it.
+     */
+    void serializeForApplyOps() {
+        _serializedForApplyOps = toBSON();
+    }
+
+    void discardSerializationForApplyOps() {
+        _serializedForApplyOps = BSONObj();
+    }
+
+    /**
+     * Returns what toBSON() does, serialized ahead of time if it was.
+     */
+    BSONObj toBSONForApplyOps() const {
+        return _serializedForApplyOps.isEmpty() ? toBSON() : _serializedForApplyOps;
+    }
+
 private:
     BSONObj _preImageDocumentKey;
     BSONObj _fullPreImage;
+    BSONObj _serializedForApplyOps;
 };
 
 /**
@@ -490,9 +510,11 @@ public:
     OplogEntry(DurableOplogEntry oplog);
     OplogEntry(const BSONObj& oplog);
 
-    const DurableOplogEntry& getEntry() const {
-        return _entry;
-    }
+    /**
+     * Returns the parsed entry, parsing the deferred fields of an entry created by parseDeferred()
+     * first if needed.
+     */
+    const DurableOplogEntry& getEntry() const;
 
     void setEntry(DurableOplogEntry oplog);
 
@@ -501,6 +523,31 @@ public:
      */
     static StatusWith<OplogEntry> parse(const BSONObj& object);
 
+    /**
+     * Creates an OplogEntry which only decodes the fields of 'object' needed to place it in a batch
+     * of oplog application: the optime, the wall clock time, the version, the operation type, the
+     * namespace and the object, and the command type of commands. The other fields are decoded by
+     * parseDeferredFields(), or by the first call to any accessor not listed below. Throws if one
+     * of the decoded fields is missing or has the wrong type.
+     *
+     * Until parseDeferredFields() is called, only getRaw(), getTimestamp(), getTerm(),
+     * getOpTime(), getWallClockTime(), getVersion(), getOpType(), isCommand(), getNss(),
+     * getObject(), getCommandType(), isPartialTransaction(), shouldPrepare() and
+     * getRawObjSizeBytes() may be called concurrently with it.
+     */
+    static OplogEntry parseDeferred(const BSONObj& object);
+
+    /**
+     * Parses the fields of an entry created by parseDeferred() which have not been parsed yet. A
+     * no-op for any other entry or if they have already been parsed.
+     */
+    Status parseDeferredFields();
+
+    /**
+     * Returns the original document used to create this OplogEntry.
+     */
+    const BSONObj& getRaw() const;
+
     bool isForCappedCollection() const;
     void setIsForCappedCollection(bool isForCappedCollection);
 
@@ -563,7 +610,29 @@ public:
     int getRawObjSizeBytes() const;
 
 private:
-    DurableOplogEntry _entry;
+    // The fields decoded by parseDeferred(). They are never changed once the entry is created, so
+    // that they can be read while the rest of the entry is being parsed.
+    struct BatchingFields {
+        BSONObj raw;
+        Timestamp timestamp;
+        boost::optional<std::int64_t> term;
+        Date_t wallClockTime;
+        std::int64_t version = DurableOplogEntry::kOplogVersion;
+        OpTypeEnum opType = OpTypeEnum::kNoop;
+        NamespaceString nss;
+        BSONObj object;
+        CommandType commandType = CommandType::kNotCommand;
+    };
+
+    explicit OplogEntry(BatchingFields batchingFields);
+
+    const DurableOplogEntry& _parsedEntry() const;
+
+    boost::optional<BatchingFields> _batchingFields;
+
+    // Only unset for an entry created by parseDeferred() whose deferred fields have not been parsed
+    // yet.
+    mutable boost::optional<DurableOplogEntry> _entry;
 
 
     // We use std::shared_ptr<DurableOplogEntry> rather than boost::optional<DurableOplogEntry> here
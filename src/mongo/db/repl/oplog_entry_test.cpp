@@ -135,6 +135,46 @@ TEST(OplogEntryTest, OpTimeBaseNonStrictParsing) {
         40414);
 }
 
+TEST(OplogEntryTest, ParseDeferred) {
+    const BSONObj doc = BSON("_id" << docId << "a" << 5);
+    const auto entry = makeInsertDocumentOplogEntry(entryOpTime, nss, doc);
+
+    auto deferred = OplogEntry::parseDeferred(entry.getRaw());
+    ASSERT_BSONOBJ_EQ(deferred.getRaw(), entry.getRaw());
+    ASSERT_EQ(deferred.getOpTime(), entryOpTime);
+    ASSERT_EQ(deferred.getWallClockTime(), entry.getWallClockTime());
+    ASSERT_EQ(deferred.getVersion(), OplogEntry::kOplogVersion);
+    ASSERT(deferred.getOpType() == OpTypeEnum::kInsert);
+    ASSERT_EQ(deferred.getNss(), nss);
+    ASSERT_BSONOBJ_EQ(deferred.getObject(), doc);
+    ASSERT(deferred.getCommandType() == OplogEntry::CommandType::kNotCommand);
+    ASSERT_FALSE(deferred.isPartialTransaction());
+    ASSERT_FALSE(deferred.shouldPrepare());
+
+    ASSERT_OK(deferred.parseDeferredFields());
+    ASSERT(deferred == entry);
+    ASSERT_OK(deferred.parseDeferredFields());
+}
+
+TEST(OplogEntryTest, ParseDeferredReportsInvalidFieldsOnlyOnceParsed) {
+    const BSONObj oplogEntryExtraField = BSON("ts" << Timestamp(0, 0) << "t" << 0LL << "op"
+                                                   << "c"
+                                                   << "ns" << nss.ns() << "wall" << Date_t() << "o"
+                                                   << BSON("create" << nss.coll()) << "extraField"
+                                                   << 3);
+
+    auto deferred = OplogEntry::parseDeferred(oplogEntryExtraField);
+    ASSERT(deferred.getCommandType() == OplogEntry::CommandType::kCreate);
+    ASSERT_EQ(deferred.parseDeferredFields().code(), 40415);
+
+    const BSONObj oplogEntryMissingTimestamp =
+        BSON("t" << 0LL << "op"
+                 << "c"
+                 << "ns" << nss.ns() << "wall" << Date_t() << "o" << BSON("_id" << 1));
+    ASSERT_THROWS_CODE(
+        OplogEntry::parseDeferred(oplogEntryMissingTimestamp), AssertionException, 40414);
+}
+
 
 }  // namespace
 }  // namespace repl
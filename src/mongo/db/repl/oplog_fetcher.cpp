@@ -42,6 +42,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/s/resharding/resume_token_gen.h"
+#include "mongo/transport/message_compressor_manager.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/time_support.h"
@@ -185,8 +186,14 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
       _oplogFetcherRestartDecision(std::move(oplogFetcherRestartDecision)),
       _onShutdownCallbackFn(onShutdownCallbackFn),
       _lastFetched(config.initialLastFetched),
-      _createClientFn(
-          [] { return std::make_unique<DBClientConnection>(true /* autoReconnect */); }),
+      _createClientFn([] {
+          auto conn = std::make_unique<DBClientConnection>(true /* autoReconnect */);
+          if (!oplogFetcherPreferredCompressor.empty()) {
+              conn->getCompressorManager().setClientPreferredCompressors(
+                  {oplogFetcherPreferredCompressor});
+          }
+          return conn;
+      }),
       _dataReplicatorExternalState(dataReplicatorExternalState),
       _enqueueDocumentsFn(enqueueDocumentsFn),
       _awaitDataTimeout(calculateAwaitDataTimeout(config.replSetConfig)),
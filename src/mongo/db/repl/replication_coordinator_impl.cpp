@@ -955,6 +955,8 @@ void ReplicationCoordinatorImpl::shutdown(OperationContext* opCtx) {
         }
         _replicationWaiterList.setErrorAll_inlock(
             {ErrorCodes::ShutdownInProgress, "Replication is being shut down"});
+        _majorityReplicationWaiterList.setErrorAll_inlock(
+            {ErrorCodes::ShutdownInProgress, "Replication is being shut down"});
         _opTimeWaiterList.setErrorAll_inlock(
             {ErrorCodes::ShutdownInProgress, "Replication is being shut down"});
         _currentCommittedSnapshotCond.notify_all();
@@ -2054,7 +2056,7 @@ SharedSemiFuture<void> ReplicationCoordinatorImpl::_startWaitingForReplication(
     // _replicationWaiterList will be checked and notified on remote opTime updates and on self's
     // lastDurable updates (but not on self's lastApplied updates, in which case use
     // _opTimeWaiterList instead).
-    return _replicationWaiterList.add_inlock(opTime, writeConcern);
+    return _getReplicationWaiterList_inlock(writeConcern).add_inlock(opTime, writeConcern);
 }
 
 void ReplicationCoordinatorImpl::waitForStepDownAttempt_forTest() {
@@ -2683,7 +2685,8 @@ void ReplicationCoordinatorImpl::stepDown(OperationContext* opCtx,
         // current term. Also see TopologyCoordinator::isSafeToStepDown.
         invariant(lastAppliedOpTime.getTerm() == currentTerm);
 
-        auto future = _replicationWaiterList.add_inlock(lastAppliedOpTime, waiterWriteConcern);
+        auto future = _getReplicationWaiterList_inlock(waiterWriteConcern)
+                          .add_inlock(lastAppliedOpTime, waiterWriteConcern);
 
         lk.unlock();
         auto status = futureGetNoThrowWithDeadline(
@@ -4196,6 +4199,8 @@ ReplicationCoordinatorImpl::_updateMemberStateFromTopologyCoordinator(WithLock l
         // Wake up any threads blocked in awaitReplication, close connections, etc.
         _replicationWaiterList.setErrorAll_inlock(
             {ErrorCodes::PrimarySteppedDown, "Primary stepped down while waiting for replication"});
+        _majorityReplicationWaiterList.setErrorAll_inlock(
+            {ErrorCodes::PrimarySteppedDown, "Primary stepped down while waiting for replication"});
         // Wake up the optime waiter that is waiting for primary catch-up to finish.
         _opTimeWaiterList.setErrorAll_inlock(
             {ErrorCodes::PrimarySteppedDown, "Primary stepped down while waiting for replication"});
@@ -4685,16 +4690,17 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
     }
 
     // Wake up writeConcern waiters that are no longer satisfiable due to the rsConfig change.
-    _replicationWaiterList.setValueIf_inlock(
-        [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
-            invariant(waiter->writeConcern);
-            // This throws if a waiter's writeConcern is no longer satisfiable, in which case
-            // setValueIf_inlock will fulfill the waiter's promise with the error status.
-            uassertStatusOK(_checkIfWriteConcernCanBeSatisfied_inlock(waiter->writeConcern.get()));
-            // Return false meaning that the waiter is still satisfiable and thus can remain in the
-            // waiter list.
-            return false;
-        });
+    auto checkIfStillSatisfiable = [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
+        invariant(waiter->writeConcern);
+        // This throws if a waiter's writeConcern is no longer satisfiable, in which case
+        // setValueIf_inlock will fulfill the waiter's promise with the error status.
+        uassertStatusOK(_checkIfWriteConcernCanBeSatisfied_inlock(waiter->writeConcern.get()));
+        // Return false meaning that the waiter is still satisfiable and thus can remain in the
+        // waiter list.
+        return false;
+    };
+    _replicationWaiterList.setValueIf_inlock(checkIfStillSatisfiable);
+    _majorityReplicationWaiterList.setValueIf_inlock(checkIfStillSatisfiable);
 
     _cancelCatchupTakeover_inlock();
     _cancelPriorityTakeover_inlock();
@@ -4733,12 +4739,32 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
-    _replicationWaiterList.setValueIf_inlock(
-        [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
-            invariant(waiter->writeConcern);
-            return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
-        },
-        opTime);
+    auto doneWaiting = [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
+        invariant(waiter->writeConcern);
+        return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
+    };
+    _replicationWaiterList.setValueIf_inlock(doneWaiting, opTime);
+
+    // "majority" waiters past the committed snapshot cannot be done waiting yet, so only check
+    // the ones up to it. See _doneWaitingForReplication_inlock.
+    if (_externalState->snapshotsEnabled() && !gTestingSnapshotBehaviorInIsolation) {
+        if (!_currentCommittedSnapshot) {
+            return;
+        }
+        if (!opTime || *_currentCommittedSnapshot < *opTime) {
+            opTime = *_currentCommittedSnapshot;
+        }
+    }
+    _majorityReplicationWaiterList.setValueIf_inlock(doneWaiting, opTime);
+}
+
+ReplicationCoordinatorImpl::WaiterList&
+ReplicationCoordinatorImpl::_getReplicationWaiterList_inlock(
+    const WriteConcernOptions& writeConcern) {
+    if (writeConcern.wMode == WriteConcernOptions::kMajority) {
+        return _majorityReplicationWaiterList;
+    }
+    return _replicationWaiterList;
 }
 
 Status ReplicationCoordinatorImpl::processReplSetUpdatePosition(const UpdatePositionArgs& updates) {
@@ -5573,7 +5599,7 @@ void ReplicationCoordinatorImpl::createWMajorityWriteAvailabilityDateWaiter(OpTi
     auto pf = makePromiseFuture<void>();
     auto waiter = std::make_shared<Waiter>(std::move(pf.promise), writeConcern);
     auto future = std::move(pf.future).onCompletion(setOpTimeCB);
-    _replicationWaiterList.add_inlock(opTime, waiter);
+    _getReplicationWaiterList_inlock(writeConcern).add_inlock(opTime, waiter);
 }
 
 bool ReplicationCoordinatorImpl::_updateCommittedSnapshot(WithLock lk,
@@ -947,11 +947,17 @@ private:
                                                     int myIndex);
 
     /**
-     * Helper to wake waiters in _replicationWaiterList waiting for opTime <= the opTime passed in
-     * (or all waiters if opTime passed in is boost::none) that are doneWaitingForReplication.
+     * Helper to wake waiters in _replicationWaiterList and _majorityReplicationWaiterList waiting
+     * for opTime <= the opTime passed in (or all waiters if opTime passed in is boost::none) that
+     * are doneWaitingForReplication.
      */
     void _wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime = boost::none);
 
+    /**
+     * Returns the list a replication waiter with the given writeConcern is registered in.
+     */
+    WaiterList& _getReplicationWaiterList_inlock(const WriteConcernOptions& writeConcern);
+
     /**
      * Scheduled to cause the ReplicationCoordinator to reconsider any state that might
      * need to change as a result of time passing - for instance becoming PRIMARY when a single
@@ -1565,6 +1571,12 @@ private:
     // avoid checking all waiters in the list on every write.
     WaiterList _replicationWaiterList;  // (M)
 
+    // list of information about clients waiting on "majority" replication. While snapshots are
+    // enabled, these waiters cannot be satisfied before the committed snapshot reaches their
+    // opTime, so keeping them apart lets opTime updates skip the ones past the committed snapshot
+    // instead of checking them again on every update.
+    WaiterList _majorityReplicationWaiterList;  // (M)
+
     // list of information about clients waiting for a particular lastApplied opTime.
     // Waiters in this list are checked and notified on self's lastApplied opTime updates.
     WaiterList _opTimeWaiterList;  // (M)
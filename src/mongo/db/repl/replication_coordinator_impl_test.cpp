@@ -5666,6 +5666,59 @@ TEST_F(ReplCoordTest,
     ASSERT_OK(getReplCoord()->awaitReplication(opCtx.get(), time, majorityWriteConcern).status);
 }
 
+TEST_F(ReplCoordTest, MajorityAndNumericWriteConcernWaitersAreWokenIndependently) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    OpTime time(Timestamp(100, 1), 1);
+    getStorageInterface()->allDurableTimestamp = time.getTimestamp();
+    replCoordSetMyLastAppliedOpTime(time, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time, Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    WriteConcernOptions majorityWriteConcern;
+    majorityWriteConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    majorityWriteConcern.wMode = WriteConcernOptions::kMajority;
+    majorityWriteConcern.syncMode = WriteConcernOptions::SyncMode::NONE;
+
+    WriteConcernOptions allNodesWriteConcern;
+    allNodesWriteConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    allNodesWriteConcern.wNumNodes = 3;
+    allNodesWriteConcern.syncMode = WriteConcernOptions::SyncMode::NONE;
+
+    ReplicationAwaiter majorityAwaiter(getReplCoord(), getServiceContext());
+    majorityAwaiter.setOpTime(time);
+    majorityAwaiter.setWriteConcern(majorityWriteConcern);
+    majorityAwaiter.start();
+
+    ReplicationAwaiter allNodesAwaiter(getReplCoord(), getServiceContext());
+    allNodesAwaiter.setOpTime(time);
+    allNodesAwaiter.setWriteConcern(allNodesWriteConcern);
+    allNodesAwaiter.start();
+
+    // Two of three nodes have the write, which commits it and satisfies only the majority waiter.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time));
+    ASSERT_OK(getReplCoord()->setLastDurableOptime_forTest(2, 1, time));
+    ASSERT_OK(majorityAwaiter.getResult().status);
+    majorityAwaiter.reset();
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time));
+    ASSERT_OK(getReplCoord()->setLastDurableOptime_forTest(2, 2, time));
+    ASSERT_OK(allNodesAwaiter.getResult().status);
+    allNodesAwaiter.reset();
+}
+
 TEST_F(ReplCoordTest,
        UpdateLastCommittedOpTimeWhenAndOnlyWhenAMajorityOfVotingNodesHaveReceivedTheOp) {
     // Test that the commit level advances properly.
@@ -36,6 +36,7 @@
 #include "mongo/db/repl/replication_recovery.h"
 
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/namespace_string.h"
@@ -68,13 +69,43 @@ namespace {
 const auto kRecoveryBatchLogLevel = logv2::LogSeverity::Debug(2);
 const auto kRecoveryOperationLogLevel = logv2::LogSeverity::Debug(3);
 
+// How often the progress of oplog application during recovery is logged.
+const auto kRecoveryProgressLogInterval = Seconds(10);
+
+// The number of batches and operations applied by oplog application during startup recovery and
+// rollback recovery.
+Counter64 recoveryApplyBatchesCounter;
+ServerStatusMetricField<Counter64> displayRecoveryApplyBatches(
+    "repl.recovery.oplogApplication.batches", &recoveryApplyBatchesCounter);
+Counter64 recoveryApplyOpsCounter;
+ServerStatusMetricField<Counter64> displayRecoveryApplyOps("repl.recovery.oplogApplication.ops",
+                                                           &recoveryApplyOpsCounter);
+
 /**
  * Tracks and logs operations applied during recovery.
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    explicit RecoveryOplogApplierStats(const Timestamp& endPoint) : _endPoint(endPoint) {}
+
     void onBatchBegin(const std::vector<OplogEntry>& batch) final {
         _numBatches++;
+        recoveryApplyBatchesCounter.increment();
+        recoveryApplyOpsCounter.increment(batch.size());
+
+        // Replaying a long oplog can take a while, so periodically report how far it has gone.
+        if (_progressTimer.elapsed() >= kRecoveryProgressLogInterval) {
+            LOGV2(6103900,
+                  "Oplog application for recovery in progress",
+                  "numOpsApplied"_attr = _numOpsApplied,
+                  "numBatches"_attr = _numBatches,
+                  "nextOpTime"_attr = batch.front().getOpTime(),
+                  "endPoint"_attr = _endPoint,
+                  "opsPerSecond"_attr = _opsPerSecond(),
+                  "durationMillis"_attr = _totalTimer.millis());
+            _progressTimer.reset();
+        }
+
         LOGV2_FOR_RECOVERY(24098,
                            kRecoveryBatchLogLevel.toInt(),
                            "Applying operations in batch: {numBatches}({batchSize} operations "
@@ -115,10 +146,20 @@ public:
               "Completed oplog application for recovery",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
-              "applyThroughOpTime"_attr = applyThroughOpTime);
+              "applyThroughOpTime"_attr = applyThroughOpTime,
+              "opsPerSecond"_attr = _opsPerSecond(),
+              "durationMillis"_attr = _totalTimer.millis());
     }
 
 private:
+    long long _opsPerSecond() const {
+        auto micros = _totalTimer.micros();
+        return micros == 0 ? 0 : static_cast<long long>(_numOpsApplied * 1000 * 1000 / micros);
+    }
+
+    const Timestamp _endPoint;
+    Timer _totalTimer;
+    Timer _progressTimer;
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
 };
@@ -658,7 +699,7 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
     oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    RecoveryOplogApplierStats stats(endPoint);
 
     auto writerPool = makeReplWriterPool();
     auto* replCoord = ReplicationCoordinator::get(opCtx);
@@ -36,6 +36,7 @@
 #include <random>
 
 #include "mongo/db/s/balancer/type_migration.h"
+#include "mongo/db/s/sharding_config_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog/type_tags.h"
@@ -58,6 +59,19 @@ namespace {
 // optimal average across all shards for a zone for a rebalancing migration to be initiated.
 const size_t kDefaultImbalanceThreshold = 1;
 
+/**
+ * Returns true if 'lhs' is serving more operations per second than 'rhs' or, if they are equally
+ * busy, if it holds more data.
+ */
+bool isMoreLoaded(const ClusterStatistics::ShardStatistics& lhs,
+                  const ClusterStatistics::ShardStatistics& rhs) {
+    if (lhs.opsPerSecond != rhs.opsPerSecond) {
+        return lhs.opsPerSecond > rhs.opsPerSecond;
+    }
+
+    return lhs.currSizeMB > rhs.currSizeMB;
+}
+
 }  // namespace
 
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
@@ -254,7 +268,9 @@ ShardId BalancerPolicy::_getLeastLoadedReceiverShard(const ShardStatisticsVector
                                                      const DistributionStatus& distribution,
                                                      const string& tag,
                                                      const set<ShardId>& excludedShards) {
-    ShardId best;
+    const bool breakTiesByLoad = balancerBreakChunkCountTiesByShardLoad.load();
+
+    const ClusterStatistics::ShardStatistics* best = nullptr;
     unsigned minChunks = numeric_limits<unsigned>::max();
 
     for (const auto& stat : shardStats) {
@@ -267,22 +283,25 @@ ShardId BalancerPolicy::_getLeastLoadedReceiverShard(const ShardStatisticsVector
         }
 
         unsigned myChunks = distribution.numberOfChunksInShard(stat.shardId);
-        if (myChunks >= minChunks) {
+        if (myChunks > minChunks ||
+            (myChunks == minChunks && !(breakTiesByLoad && isMoreLoaded(*best, stat)))) {
             continue;
         }
 
-        best = stat.shardId;
+        best = &stat;
         minChunks = myChunks;
     }
 
-    return best;
+    return best ? best->shardId : ShardId();
 }
 
 ShardId BalancerPolicy::_getMostOverloadedShard(const ShardStatisticsVector& shardStats,
                                                 const DistributionStatus& distribution,
                                                 const string& chunkTag,
                                                 const set<ShardId>& excludedShards) {
-    ShardId worst;
+    const bool breakTiesByLoad = balancerBreakChunkCountTiesByShardLoad.load();
+
+    const ClusterStatistics::ShardStatistics* worst = nullptr;
     unsigned maxChunks = 0;
 
     for (const auto& stat : shardStats) {
@@ -291,14 +310,16 @@ ShardId BalancerPolicy::_getMostOverloadedShard(const ShardStatisticsVector& sha
 
         const unsigned shardChunkCount =
             distribution.numberOfChunksInShardWithTag(stat.shardId, chunkTag);
-        if (shardChunkCount <= maxChunks)
+        if (shardChunkCount < maxChunks ||
+            (shardChunkCount == maxChunks &&
+             !(breakTiesByLoad && worst && isMoreLoaded(stat, *worst))))
             continue;
 
-        worst = stat.shardId;
+        worst = &stat;
         maxChunks = shardChunkCount;
     }
 
-    return worst;
+    return worst ? worst->shardId : ShardId();
 }
 
 // Returns a random integer in [0, max) using a uniform random distribution.
@@ -251,7 +251,8 @@ public:
 private:
     /**
      * Return the shard with the specified tag, which has the least number of chunks. If the tag is
-     * empty, considers all shards.
+     * empty, considers all shards. If balancerBreakChunkCountTiesByShardLoad is enabled, ties are
+     * broken in favour of the shard with the least load.
      */
     static ShardId _getLeastLoadedReceiverShard(const ShardStatisticsVector& shardStats,
                                                 const DistributionStatus& distribution,
@@ -260,7 +261,8 @@ private:
 
     /**
      * Return the shard which has the least number of chunks with the specified tag. If the tag is
-     * empty, considers all chunks.
+     * empty, considers all chunks. If balancerBreakChunkCountTiesByShardLoad is enabled, ties are
+     * broken in favour of the shard with the most load.
      */
     static ShardId _getMostOverloadedShard(const ShardStatisticsVector& shardStats,
                                            const DistributionStatus& distribution,
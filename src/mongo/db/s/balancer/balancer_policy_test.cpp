@@ -33,6 +33,7 @@
 
 #include "mongo/db/keypattern.h"
 #include "mongo/db/s/balancer/balancer_policy.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/unittest/unittest.h"
@@ -298,6 +299,87 @@ TEST(BalancerPolicy, ParallelBalancingNotSchedulingOnInUseDestinationShards) {
     ASSERT_EQ(MigrateInfo::chunksImbalance, migrations[0].reason);
 }
 
+TEST(BalancerPolicy, ChunkCountTiesIgnoreShardLoadByDefault) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 5},
+         {ShardStatistics(kShardId1, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 5},
+         {ShardStatistics(kShardId2, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0},
+         {ShardStatistics(kShardId3, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+    cluster.first[1].opsPerSecond = 100;
+    cluster.first[2].opsPerSecond = 50;
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(2U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId2, migrations[0].to);
+    ASSERT_EQ(kShardId1, migrations[1].from);
+    ASSERT_EQ(kShardId3, migrations[1].to);
+}
+
+TEST(BalancerPolicy, ChunkCountTiesBrokenByShardLoad) {
+    RAIIServerParameterControllerForTest breakTiesByLoad{"balancerBreakChunkCountTiesByShardLoad",
+                                                         true};
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 5},
+         {ShardStatistics(kShardId1, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 5},
+         {ShardStatistics(kShardId2, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0},
+         {ShardStatistics(kShardId3, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+    cluster.first[0].opsPerSecond = 10;
+    cluster.first[1].opsPerSecond = 100;
+    cluster.first[2].opsPerSecond = 50;
+    cluster.first[3].opsPerSecond = 5;
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(2U, migrations.size());
+    ASSERT_EQ(kShardId1, migrations[0].from);
+    ASSERT_EQ(kShardId3, migrations[0].to);
+    ASSERT_EQ(kShardId0, migrations[1].from);
+    ASSERT_EQ(kShardId2, migrations[1].to);
+}
+
+TEST(BalancerPolicy, ChunkCountAndShardLoadTiesBrokenByDataSize) {
+    RAIIServerParameterControllerForTest breakTiesByLoad{"balancerBreakChunkCountTiesByShardLoad",
+                                                         true};
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 50, false, emptyTagSet, emptyShardVersion), 5},
+         {ShardStatistics(kShardId1, kNoMaxSize, 80, false, emptyTagSet, emptyShardVersion), 5},
+         {ShardStatistics(kShardId2, kNoMaxSize, 20, false, emptyTagSet, emptyShardVersion), 0},
+         {ShardStatistics(kShardId3, kNoMaxSize, 10, false, emptyTagSet, emptyShardVersion), 0}});
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(2U, migrations.size());
+    ASSERT_EQ(kShardId1, migrations[0].from);
+    ASSERT_EQ(kShardId3, migrations[0].to);
+    ASSERT_EQ(kShardId0, migrations[1].from);
+    ASSERT_EQ(kShardId2, migrations[1].to);
+}
+
+TEST(BalancerPolicy, ChunkCountTakesPrecedenceOverShardLoad) {
+    RAIIServerParameterControllerForTest breakTiesByLoad{"balancerBreakChunkCountTiesByShardLoad",
+                                                         true};
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 6, false, emptyTagSet, emptyShardVersion), 6},
+         {ShardStatistics(kShardId1, kNoMaxSize, 4, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId2, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0},
+         {ShardStatistics(kShardId3, kNoMaxSize, 1, false, emptyTagSet, emptyShardVersion), 1}});
+    cluster.first[1].opsPerSecond = 100;
+    cluster.first[2].opsPerSecond = 100;
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(2U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId2, migrations[0].to);
+    ASSERT_EQ(kShardId1, migrations[1].from);
+    ASSERT_EQ(kShardId3, migrations[1].to);
+}
+
 TEST(BalancerPolicy, JumboChunksNotMoved) {
     auto cluster = generateCluster(
         {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 4},
@@ -93,6 +93,10 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // Number of operations per second served by this shard's primary, as sampled from its
+        // opcounters between two statistics refreshes. Zero if it has not been sampled yet.
+        double opsPerSecond{0};
     };
 
     virtual ~ClusterStatistics();
@@ -38,6 +38,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/client/read_preference.h"
+#include "mongo/db/s/sharding_config_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
@@ -49,16 +50,15 @@ namespace mongo {
 namespace {
 
 const char kVersionField[] = "version";
+const char kOpcountersField[] = "opcounters";
 
 /**
- * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * Executes the serverStatus command against the specified shard and returns its response.
  *
- * Returns the MongoD version in strig format or an error. Known error codes are:
+ * Returns the serverStatus response or an error. Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
- *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<BSONObj> retrieveShardServerStatus(OperationContext* opCtx, ShardId shardId) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -79,8 +79,16 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
         return commandResponse.getValue().commandStatus;
     }
 
-    BSONObj serverStatus = std::move(commandResponse.getValue().response);
+    return std::move(commandResponse.getValue().response);
+}
 
+/**
+ * Obtains the version of the running MongoD service from its serverStatus response.
+ *
+ * Returns the MongoD version in strig format or an error. Known error codes are:
+ *  NoSuchKey if the version could not be retrieved
+ */
+StatusWith<std::string> extractShardMongoDVersion(const BSONObj& serverStatus) {
     std::string version;
     Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
     if (!status.isOK()) {
@@ -90,6 +98,21 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
     return version;
 }
 
+/**
+ * Returns the total number of operations of all types the MongoD service has served since it
+ * started, according to the opcounters section of its serverStatus response.
+ */
+long long extractShardTotalOps(const BSONObj& serverStatus) {
+    long long totalOps = 0;
+    for (const auto& counter : serverStatus[kOpcountersField].Obj()) {
+        if (counter.isNumber()) {
+            totalOps += counter.safeNumberLong();
+        }
+    }
+
+    return totalOps;
+}
+
 }  // namespace
 
 using ShardStatistics = ClusterStatistics::ShardStatistics;
@@ -98,6 +121,35 @@ ClusterStatisticsImpl::ClusterStatisticsImpl(BalancerRandomSource& random) : _ra
 
 ClusterStatisticsImpl::~ClusterStatisticsImpl() = default;
 
+double ClusterStatisticsImpl::sampleShardLoad(const ShardId& shardId,
+                                              long long totalOps,
+                                              Date_t now,
+                                              Milliseconds minSampleInterval) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto it = _shardLoadSamples.find(shardId);
+    if (it == _shardLoadSamples.end()) {
+        _shardLoadSamples.emplace(shardId, ShardLoadSample{now, totalOps, 0});
+        return 0;
+    }
+
+    auto& sample = it->second;
+    const auto elapsed = now - sample.sampledAt;
+    if (elapsed < minSampleInterval) {
+        return sample.opsPerSecond;
+    }
+
+    // The counters restart from zero when the shard's primary restarts or changes, in which case
+    // there is no meaningful rate to compute until the next sample
+    sample.opsPerSecond = totalOps >= sample.totalOps
+        ? double(totalOps - sample.totalOps) * 1000 / durationCount<Milliseconds>(elapsed)
+        : 0;
+    sample.sampledAt = now;
+    sample.totalOps = totalOps;
+
+    return sample.opsPerSecond;
+}
+
 StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(OperationContext* opCtx) {
     // Get a list of all the shards that are participating in this balance round along with any
     // maximum allowed quotas and current utilization. We get the latter by issuing
@@ -116,9 +168,12 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
 
     std::vector<ShardStatistics> stats;
 
+    const bool sampleShardLoads = balancerBreakChunkCountTiesByShardLoad.load();
+    const Milliseconds minSampleInterval(balancerShardLoadSampleIntervalMS.load());
+
     for (const auto& shard : shards) {
         const auto shardSizeStatus = [&]() -> StatusWith<long long> {
-            if (!shard.getMaxSizeMB()) {
+            if (!shard.getMaxSizeMB() && !sampleShardLoads) {
                 return 0;
             }
 
@@ -134,8 +189,12 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
         }
 
         std::string mongoDVersion;
+        double opsPerSecond = 0;
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
+        auto serverStatus = retrieveShardServerStatus(opCtx, shard.getName());
+        auto mongoDVersionStatus = serverStatus.isOK()
+            ? extractShardMongoDVersion(serverStatus.getValue())
+            : StatusWith<std::string>(serverStatus.getStatus());
         if (mongoDVersionStatus.isOK()) {
             mongoDVersion = std::move(mongoDVersionStatus.getValue());
         } else {
@@ -148,6 +207,16 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                   "error"_attr = mongoDVersionStatus.getStatus());
         }
 
+        // Similarly, the load is only used to break ties between shards with the same number of
+        // chunks, so a shard whose opcounters cannot be obtained is just considered idle
+        if (sampleShardLoads && serverStatus.isOK() &&
+            serverStatus.getValue()[kOpcountersField].type() == Object) {
+            opsPerSecond = sampleShardLoad(shard.getName(),
+                                           extractShardTotalOps(serverStatus.getValue()),
+                                           Date_t::now(),
+                                           minSampleInterval);
+        }
+
         std::set<std::string> shardTags;
 
         for (const auto& shardTag : shard.getTags()) {
@@ -160,6 +229,7 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+        stats.back().opsPerSecond = opsPerSecond;
     }
 
     return stats;
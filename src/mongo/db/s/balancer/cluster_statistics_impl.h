@@ -31,6 +31,9 @@
 
 #include "mongo/db/s/balancer/balancer_random.h"
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -46,9 +49,34 @@ public:
 
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
 
+    /**
+     * Records that the shard had served 'totalOps' operations in total as of 'now' and returns its
+     * operations per second since the previous sample. Samples taken less than
+     * 'minSampleInterval' after the previous one are ignored and the last computed rate is
+     * returned instead, so that the several refreshes done within a balancer round do not produce
+     * rates over very short intervals. Returns zero until two samples have been recorded.
+     */
+    double sampleShardLoad(const ShardId& shardId,
+                           long long totalOps,
+                           Date_t now,
+                           Milliseconds minSampleInterval);
+
 private:
+    // The last opcounters sample taken from a shard and the rate computed from it
+    struct ShardLoadSample {
+        Date_t sampledAt;
+        long long totalOps{0};
+        double opsPerSecond{0};
+    };
+
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // Protects the state below
+    Mutex _mutex = MONGO_MAKE_LATCH("ClusterStatisticsImpl::_mutex");
+
+    // The last load sample taken from each shard
+    stdx::unordered_map<ShardId, ShardLoadSample, ShardId::Hasher> _shardLoadSamples;
 };
 
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/db/s/balancer/cluster_statistics_impl.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -48,5 +49,42 @@ TEST(ShardStatistics, SizeMaxedTest) {
                .isSizeMaxed());
 }
 
+TEST(ClusterStatisticsImpl, SampleShardLoad) {
+    BalancerRandomSource random;
+    ClusterStatisticsImpl clusterStats(random);
+
+    const ShardId shardId("TestShardId");
+    const Milliseconds minInterval(1000);
+    const auto start = Date_t::now();
+
+    // The first sample only establishes the baseline
+    ASSERT_EQ(0, clusterStats.sampleShardLoad(shardId, 1000, start, minInterval));
+
+    ASSERT_EQ(500, clusterStats.sampleShardLoad(shardId, 2000, start + Seconds(2), minInterval));
+
+    // Samples taken too soon after the previous one keep the last rate
+    ASSERT_EQ(500,
+              clusterStats.sampleShardLoad(
+                  shardId, 2010, start + Seconds(2) + Milliseconds(10), minInterval));
+
+    ASSERT_EQ(100, clusterStats.sampleShardLoad(shardId, 2100, start + Seconds(3), minInterval));
+
+    // Other shards are sampled independently
+    ASSERT_EQ(0, clusterStats.sampleShardLoad(ShardId("Other"), 5000, start, minInterval));
+}
+
+TEST(ClusterStatisticsImpl, SampleShardLoadAfterCountersReset) {
+    BalancerRandomSource random;
+    ClusterStatisticsImpl clusterStats(random);
+
+    const ShardId shardId("TestShardId");
+    const Milliseconds minInterval(1000);
+    const auto start = Date_t::now();
+
+    ASSERT_EQ(0, clusterStats.sampleShardLoad(shardId, 1000, start, minInterval));
+    ASSERT_EQ(0, clusterStats.sampleShardLoad(shardId, 10, start + Seconds(1), minInterval));
+    ASSERT_EQ(90, clusterStats.sampleShardLoad(shardId, 100, start + Seconds(2), minInterval));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -36,11 +36,13 @@
 #include <list>
 #include <vector>
 
+#include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/cancelable_operation_context.h"
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_builds_coordinator.h"
@@ -782,6 +784,33 @@ void MigrationDestinationManager::_dropLocalIndexesIfNecessary(
     }
 }
 
+std::vector<BSONObj> MigrationDestinationManager::_deferSecondaryIndexBuildsIfPossible(
+    OperationContext* opCtx,
+    const NamespaceString& nss,
+    CollectionOptionsAndIndexes* collectionOptionsAndIndexes) {
+    {
+        AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+        if (autoColl && !autoColl->isEmpty(opCtx)) {
+            return {};
+        }
+    }
+
+    std::vector<BSONObj> indexSpecsToBuildFirst;
+    std::vector<BSONObj> deferredIndexSpecs;
+    for (auto&& indexSpec : collectionOptionsAndIndexes->indexSpecs) {
+        const auto keyPattern = indexSpec[IndexDescriptor::kKeyPatternFieldName].Obj();
+        if (IndexDescriptor::isIdIndexPattern(keyPattern) ||
+            _shardKeyPattern.isPrefixOf(keyPattern, SimpleBSONElementComparator::kInstance)) {
+            indexSpecsToBuildFirst.push_back(indexSpec);
+        } else {
+            deferredIndexSpecs.push_back(indexSpec);
+        }
+    }
+
+    collectionOptionsAndIndexes->indexSpecs = std::move(indexSpecsToBuildFirst);
+    return deferredIndexSpecs;
+}
+
 void MigrationDestinationManager::cloneCollectionIndexesAndOptions(
     OperationContext* opCtx,
     const NamespaceString& nss,
@@ -1013,6 +1042,7 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
     // complex, and 2) some of the operations, like creating the collection or building indexes, are
     // not currently supported in retryable writes.
     outerOpCtx->setAlwaysInterruptAtStepDownOrUp();
+    std::vector<BSONObj> deferredIndexSpecs;
     {
         auto newClient = outerOpCtx->getServiceContext()->makeClient("MigrationCoordinator");
         {
@@ -1027,7 +1057,16 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             cc().makeOperationContext(), outerOpCtx->getCancellationToken(), executor);
 
         _dropLocalIndexesIfNecessary(altOpCtx.get(), _nss, donorCollectionOptionsAndIndexes);
-        cloneCollectionIndexesAndOptions(altOpCtx.get(), _nss, donorCollectionOptionsAndIndexes);
+
+        // When cloning into an empty collection, only create the indexes needed while cloning up
+        // front and bulk build the rest from the cloned documents afterwards, rather than
+        // maintaining every index on each insert.
+        auto collectionOptionsAndIndexes = donorCollectionOptionsAndIndexes;
+        if (migrateCloneDeferSecondaryIndexBuilds.load()) {
+            deferredIndexSpecs = _deferSecondaryIndexBuildsIfPossible(
+                altOpCtx.get(), _nss, &collectionOptionsAndIndexes);
+        }
+        cloneCollectionIndexesAndOptions(altOpCtx.get(), _nss, collectionOptionsAndIndexes);
 
         timing.done(2);
         migrateThreadHangAtStep2.pauseWhileSet();
@@ -1173,6 +1212,22 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
         // secondaries
         lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
 
+        if (!deferredIndexSpecs.empty()) {
+            assertNotAborted(opCtx);
+
+            LOGV2(6104700,
+                  "Building deferred indexes on cloned documents",
+                  "namespace"_attr = _nss.ns(),
+                  "indexes"_attr = deferredIndexSpecs.size(),
+                  "migrationId"_attr = _migrationId->toBSON());
+
+            // The index build goes through the index builds coordinator, which bulk loads the keys
+            // of the documents cloned so far and replicates the build to the secondaries.
+            DBDirectClient client(opCtx);
+            client.createIndexes(_nss.ns(), deferredIndexSpecs);
+            lastOpApplied = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+        }
+
         timing.done(4);
         migrateThreadHangAtStep4.pauseWhileSet();
 
@@ -202,6 +202,17 @@ private:
         const NamespaceString& nss,
         const CollectionOptionsAndIndexes& collectionOptionsAndIndexes);
 
+    /**
+     * If the collection is missing or empty locally, removes from 'collectionOptionsAndIndexes'
+     * the donor's indexes which neither the initial clone nor the range deleter depend on, and
+     * returns them so they can be built in bulk once the documents have been cloned. Every index
+     * other than the _id index and the ones prefixed by the shard key is deferred.
+     */
+    std::vector<BSONObj> _deferSecondaryIndexBuildsIfPossible(
+        OperationContext* opCtx,
+        const NamespaceString& nss,
+        CollectionOptionsAndIndexes* collectionOptionsAndIndexes);
+
     /**
      * Remembers a chunk range between 'min' and 'max' as a range which will have data migrated
      * into it, to protect it against separate commands to clean up orphaned data. First, though,
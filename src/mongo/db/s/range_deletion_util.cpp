@@ -54,8 +54,10 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/migration_util.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/remove_saver.h"
@@ -64,6 +66,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/cancellation.h"
 #include "mongo/util/future_util.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -77,6 +80,10 @@ MONGO_FAIL_POINT_DEFINE(suspendRangeDeletion);
 MONGO_FAIL_POINT_DEFINE(throwWriteConflictExceptionInDeleteRange);
 MONGO_FAIL_POINT_DEFINE(throwInternalErrorInDeleteRange);
 
+// The longest an adaptive range deletion backs off between batches, unless the configured delay
+// between batches is already longer.
+const Milliseconds kMaxAdaptiveDelayBetweenBatches = Seconds(1);
+
 /**
  * Returns whether the currentCollection has the same UUID as the expectedCollectionUuid. Used to
  * ensure that the collection has not been dropped or dropped and recreated since the range was
@@ -284,6 +291,35 @@ void ensureRangeDeletionTaskStillExists(OperationContext* opCtx, const UUID& mig
     // holding any locks.
 }
 
+/**
+ * Returns how far the majority commit point is behind the last write applied on this node.
+ */
+Milliseconds getMajorityCommitLag(OperationContext* opCtx) {
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return Milliseconds(0);
+    }
+
+    const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime().wallTime;
+    const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime().wallTime;
+    if (lastCommitted == Date_t() || lastApplied <= lastCommitted) {
+        return Milliseconds(0);
+    }
+    return lastApplied - lastCommitted;
+}
+
+/**
+ * Adapts a RangeDeletionThrottle to the backoff interface of AsyncTry, so that the loop deleting a
+ * range waits for the throttle's current delay between batches.
+ */
+struct RangeDeletionThrottleBackoff {
+    Milliseconds nextSleep() {
+        return throttle->getDelayBetweenBatches();
+    }
+
+    std::shared_ptr<RangeDeletionThrottle> throttle;
+};
+
 /**
  * Delete the range in a sequence of batches until there are no more documents to
  * delete or deletion returns an error.
@@ -296,15 +332,19 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    auto throttle = std::make_shared<RangeDeletionThrottle>(
+        numDocsToRemovePerBatch, delayBetweenBatches, rangeDeleterAdaptiveBatching.load());
+
     return AsyncTry([=] {
                return withTemporaryOperationContext([=](OperationContext* opCtx) {
+                   const auto numDocsToRemovePerBatch = throttle->getBatchSize();
                    LOGV2_DEBUG(5346200,
                                1,
                                "Starting batch deletion",
                                "namespace"_attr = nss,
                                "range"_attr = redact(range.toString()),
                                "numDocsToRemovePerBatch"_attr = numDocsToRemovePerBatch,
-                               "delayBetweenBatches"_attr = delayBetweenBatches);
+                               "delayBetweenBatches"_attr = throttle->getDelayBetweenBatches());
 
                    if (migrationId) {
                        ensureRangeDeletionTaskStillExists(opCtx, *migrationId);
@@ -320,11 +360,16 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                        "deletion task. No need to delete documents.",
                        !collectionUuidHasChanged(nss, collection.getCollection(), collectionUuid));
 
+                   Timer batchTimer;
                    auto numDeleted = uassertStatusOK(deleteNextBatch(opCtx,
                                                                      collection.getCollection(),
                                                                      keyPattern,
                                                                      range,
                                                                      numDocsToRemovePerBatch));
+                   if (numDeleted > 0) {
+                       throttle->noteBatchDeleted(getMajorityCommitLag(opCtx),
+                                                  Milliseconds(batchTimer.millis()));
+                   }
 
                    LOGV2_DEBUG(
                        23769,
@@ -352,7 +397,7 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                 ErrorCodes::isShutdownError(swNumDeleted.getStatus()) ||
                 ErrorCodes::isNotPrimaryError(swNumDeleted.getStatus());
         })
-        .withDelayBetweenIterations(delayBetweenBatches)
+        .withBackoffBetweenIterations(RangeDeletionThrottleBackoff{throttle})
         .on(executor, CancellationToken::uncancelable())
         .ignoreValue();
 }
@@ -425,6 +470,40 @@ std::vector<RangeDeletionTask> getPersistentRangeDeletionTasks(OperationContext*
 
 }  // namespace
 
+RangeDeletionThrottle::RangeDeletionThrottle(int batchSize,
+                                             Milliseconds delayBetweenBatches,
+                                             bool adaptive)
+    : _initialBatchSize(batchSize),
+      _initialDelayBetweenBatches(delayBetweenBatches),
+      _adaptive(adaptive),
+      _batchSize(batchSize),
+      _delayBetweenBatches(delayBetweenBatches) {
+    invariant(batchSize > 0);
+}
+
+void RangeDeletionThrottle::noteBatchDeleted(Milliseconds majorityCommitLag,
+                                             Milliseconds batchDuration) {
+    if (!_adaptive) {
+        return;
+    }
+
+    const bool fallingBehind =
+        majorityCommitLag > Milliseconds(rangeDeleterAdaptiveMaxMajorityLagMS.load()) ||
+        batchDuration > Milliseconds(rangeDeleterAdaptiveTargetBatchDurationMS.load());
+
+    if (fallingBehind) {
+        _batchSize = std::max(1, _batchSize / 2);
+        _delayBetweenBatches =
+            std::min(std::max(_delayBetweenBatches * 2, Milliseconds(1)),
+                     std::max(kMaxAdaptiveDelayBetweenBatches, _initialDelayBetweenBatches));
+    } else {
+        const int maxBatchSize =
+            std::max(_initialBatchSize, rangeDeleterAdaptiveMaxBatchSize.load());
+        _batchSize = std::min(maxBatchSize, _batchSize + _initialBatchSize);
+        _delayBetweenBatches = std::max(_delayBetweenBatches / 2, _initialDelayBetweenBatches);
+    }
+}
+
 void snapshotRangeDeletionsForRename(OperationContext* opCtx,
                                      const NamespaceString& fromNss,
                                      const NamespaceString& toNss) {
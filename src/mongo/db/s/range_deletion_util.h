@@ -51,6 +51,42 @@ extern AtomicWord<int> rangeDeleterBatchSize;
 // next batch of deletions.
 extern AtomicWord<int> rangeDeleterBatchDelayMS;
 
+/**
+ * Chooses how many documents each batch of a range deletion removes and how long to wait between
+ * batches. Unless adaptive, both stay at their initial values. Otherwise, the batch size grows by
+ * its initial value after every batch deleted while the node keeps up, and is halved, with the
+ * delay doubled, after every batch which left the majority commit point too far behind or took too
+ * long to delete.
+ *
+ * Not thread safe, as the batches of a range deletion run one after another.
+ */
+class RangeDeletionThrottle {
+public:
+    RangeDeletionThrottle(int batchSize, Milliseconds delayBetweenBatches, bool adaptive);
+
+    int getBatchSize() const {
+        return _batchSize;
+    }
+
+    Milliseconds getDelayBetweenBatches() const {
+        return _delayBetweenBatches;
+    }
+
+    /**
+     * Adjusts the batch size and delay after a batch which took 'batchDuration' to delete, after
+     * which the majority commit point was 'majorityCommitLag' behind this node's last write.
+     */
+    void noteBatchDeleted(Milliseconds majorityCommitLag, Milliseconds batchDuration);
+
+private:
+    const int _initialBatchSize;
+    const Milliseconds _initialDelayBetweenBatches;
+    const bool _adaptive;
+
+    int _batchSize;
+    Milliseconds _delayBetweenBatches;
+};
+
 /**
  * Deletes a range of orphaned documents for the given namespace and collection UUID. Returns a
  * future which will be resolved when the range has finished being deleted. The resulting future
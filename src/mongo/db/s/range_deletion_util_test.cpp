@@ -43,6 +43,7 @@
 #include "mongo/db/s/shard_server_test_fixture.h"
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/vector_clock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/util/fail_point.h"
 
@@ -1039,5 +1040,56 @@ TEST_F(RenameRangeDeletionsTest, IdempotentRenameRangeDeletionsTest) {
     ASSERT_EQ(0, forRenameStore.count(operationContext(), BSONObj()));
 }
 
+TEST(RangeDeletionThrottleTest, NonAdaptiveThrottleKeepsConfiguredValues) {
+    RangeDeletionThrottle throttle(100, Milliseconds(20), false /* adaptive */);
+
+    throttle.noteBatchDeleted(Seconds(60), Seconds(60));
+    ASSERT_EQ(100, throttle.getBatchSize());
+    ASSERT_EQ(Milliseconds(20), throttle.getDelayBetweenBatches());
+}
+
+TEST(RangeDeletionThrottleTest, AdaptiveThrottleBacksOffWhenMajorityCommitLags) {
+    RAIIServerParameterControllerForTest maxLag{"rangeDeleterAdaptiveMaxMajorityLagMS", 1000};
+    RangeDeletionThrottle throttle(100, Milliseconds(0), true /* adaptive */);
+
+    throttle.noteBatchDeleted(Seconds(5), Milliseconds(0));
+    ASSERT_EQ(50, throttle.getBatchSize());
+    ASSERT_EQ(Milliseconds(1), throttle.getDelayBetweenBatches());
+
+    throttle.noteBatchDeleted(Seconds(5), Milliseconds(0));
+    ASSERT_EQ(25, throttle.getBatchSize());
+    ASSERT_EQ(Milliseconds(2), throttle.getDelayBetweenBatches());
+
+    // Once replication catches up the throttle recovers towards its configured values.
+    throttle.noteBatchDeleted(Milliseconds(0), Milliseconds(0));
+    ASSERT_EQ(125, throttle.getBatchSize());
+    ASSERT_EQ(Milliseconds(1), throttle.getDelayBetweenBatches());
+
+    throttle.noteBatchDeleted(Milliseconds(0), Milliseconds(0));
+    ASSERT_EQ(225, throttle.getBatchSize());
+    ASSERT_EQ(Milliseconds(0), throttle.getDelayBetweenBatches());
+}
+
+TEST(RangeDeletionThrottleTest, AdaptiveThrottleBacksOffOnSlowBatches) {
+    RAIIServerParameterControllerForTest targetDuration{
+        "rangeDeleterAdaptiveTargetBatchDurationMS", 100};
+    RangeDeletionThrottle throttle(64, Milliseconds(10), true /* adaptive */);
+
+    throttle.noteBatchDeleted(Milliseconds(0), Milliseconds(500));
+    ASSERT_EQ(32, throttle.getBatchSize());
+    ASSERT_EQ(Milliseconds(20), throttle.getDelayBetweenBatches());
+}
+
+TEST(RangeDeletionThrottleTest, AdaptiveThrottleGrowsUpToMaxBatchSize) {
+    RAIIServerParameterControllerForTest maxBatchSize{"rangeDeleterAdaptiveMaxBatchSize", 250};
+    RangeDeletionThrottle throttle(100, Milliseconds(0), true /* adaptive */);
+
+    for (int i = 0; i < 10; i++) {
+        throttle.noteBatchDeleted(Milliseconds(0), Milliseconds(0));
+    }
+    ASSERT_EQ(250, throttle.getBatchSize());
+    ASSERT_EQ(Milliseconds(0), throttle.getDelayBetweenBatches());
+}
+
 }  // namespace
 }  // namespace mongo
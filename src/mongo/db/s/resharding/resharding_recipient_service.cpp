@@ -589,6 +589,11 @@ ReshardingRecipientService::RecipientStateMachine::_cloneThenTransitionToApplyin
 
     return future_util::withCancellation(_dataReplication->awaitCloningDone(), abortToken)
         .thenRunOn(**executor)
+        .then([this] {
+            auto opCtx = _cancelableOpCtxFactory->makeOperationContext(&cc());
+            _externalState->ensureTempReshardingCollectionIndexesBuilt(
+                opCtx.get(), _metadata, *_cloneTimestamp);
+        })
         .then([this] { _transitionToApplying(); });
 }
 
@@ -31,7 +31,15 @@
 
 #include "mongo/db/s/resharding/resharding_recipient_service_external_state.h"
 
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/s/resharding/resharding_donor_recipient_common.h"
+#include "mongo/db/s/resharding/resharding_server_parameters_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
@@ -69,6 +77,23 @@ void ReshardingRecipientService::RecipientStateMachineExternalState::
                              cloneTimestamp,
                              "loading indexes to create temporary resharding collection"_sd);
 
+    if (resharding::gReshardingRecipientDeferSecondaryIndexBuilds.load()) {
+        // Keep the _id index and the indexes which can serve as the new shard key index. The
+        // others are built by ensureTempReshardingCollectionIndexesBuilt() once cloning is done.
+        const BSONObj newShardKey = metadata.getReshardingKey().toBSON();
+        indexes.erase(std::remove_if(indexes.begin(),
+                                     indexes.end(),
+                                     [&](const BSONObj& indexSpec) {
+                                         const auto keyPattern =
+                                             indexSpec[IndexDescriptor::kKeyPatternFieldName].Obj();
+                                         return !IndexDescriptor::isIdIndexPattern(keyPattern) &&
+                                             !newShardKey.isPrefixOf(
+                                                 keyPattern,
+                                                 SimpleBSONElementComparator::kInstance);
+                                     }),
+                      indexes.end());
+    }
+
     // Set the temporary resharding collection's UUID to the resharding UUID. Note that
     // BSONObj::addFields() replaces any fields that already exist.
     collOptions = collOptions.addFields(BSON("uuid" << metadata.getReshardingUUID()));
@@ -81,6 +106,50 @@ void ReshardingRecipientService::RecipientStateMachineExternalState::
                                     std::move(collOptions)});
 }
 
+void ReshardingRecipientService::RecipientStateMachineExternalState::
+    ensureTempReshardingCollectionIndexesBuilt(OperationContext* opCtx,
+                                               const CommonReshardingMetadata& metadata,
+                                               Timestamp cloneTimestamp) {
+    const auto& tempNss = metadata.getTempReshardingNss();
+
+    // Index builds started before a failover are still running on a new primary, so they are
+    // waited on rather than being started again.
+    IndexBuildsCoordinator::get(opCtx)->awaitNoIndexBuildInProgressForCollection(
+        opCtx, metadata.getReshardingUUID());
+
+    auto [indexes, unusedIdIndex] =
+        getCollectionIndexes(opCtx,
+                             metadata.getSourceNss(),
+                             metadata.getSourceUUID(),
+                             cloneTimestamp,
+                             "loading indexes to build on temporary resharding collection"_sd);
+
+    auto missingIndexes = [&, &indexes = indexes] {
+        AutoGetCollection tempColl(opCtx, tempNss, MODE_IS);
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Temporary resharding collection '" << tempNss
+                              << "' did not already exist",
+                tempColl);
+        return tempColl->getIndexCatalog()->removeExistingIndexesNoChecks(
+            opCtx, tempColl.getCollection(), indexes);
+    }();
+
+    if (missingIndexes.empty()) {
+        return;
+    }
+
+    LOGV2(6104800,
+          "Building indexes on temporary resharding collection",
+          "namespace"_attr = tempNss,
+          "reshardingUUID"_attr = metadata.getReshardingUUID(),
+          "indexes"_attr = missingIndexes.size());
+
+    // The index builds coordinator bulk loads the index keys from the cloned documents and
+    // replicates the index builds to the secondaries.
+    DBDirectClient client(opCtx);
+    client.createIndexes(tempNss.ns(), missingIndexes);
+}
+
 template <typename Callable>
 auto RecipientStateMachineExternalStateImpl::_withShardVersionRetry(OperationContext* opCtx,
                                                                     const NamespaceString& nss,
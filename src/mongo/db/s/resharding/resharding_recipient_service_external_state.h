@@ -103,6 +103,18 @@ public:
     void ensureTempReshardingCollectionExistsWithIndexes(OperationContext* opCtx,
                                                          const CommonReshardingMetadata& metadata,
                                                          Timestamp cloneTimestamp);
+
+    /**
+     * Builds the source collection's indexes which are missing from the temporary resharding
+     * collection, and waits for any index builds already in progress on it to finish.
+     *
+     * When 'reshardingRecipientDeferSecondaryIndexBuilds' is set, the temporary resharding
+     * collection is created without its secondary indexes so that they can be built from the
+     * cloned documents once the collection cloner has finished.
+     */
+    void ensureTempReshardingCollectionIndexesBuilt(OperationContext* opCtx,
+                                                    const CommonReshardingMetadata& metadata,
+                                                    Timestamp cloneTimestamp);
 };
 
 class RecipientStateMachineExternalStateImpl
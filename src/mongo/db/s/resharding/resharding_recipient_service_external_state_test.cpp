@@ -44,6 +44,7 @@
 #include "mongo/db/s/resharding_util.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/db/session_catalog_mongod.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog_cache_test_fixture.h"
 #include "mongo/s/database_version.h"
@@ -298,6 +299,60 @@ TEST_F(RecipientServiceExternalStateTest, CreateLocalReshardingCollectionBasic)
     verifyCollectionAndIndexes(kReshardingNss, kReshardingUUID, indexes);
 }
 
+TEST_F(RecipientServiceExternalStateTest, CreateLocalReshardingCollectionDefersSecondaryIndexes) {
+    // TODO (SERVER-57194): enable lock-free reads.
+    bool disableLockFreeReadsOriginalValue = storageGlobalParams.disableLockFreeReads;
+    storageGlobalParams.disableLockFreeReads = true;
+    ON_BLOCK_EXIT(
+        [&] { storageGlobalParams.disableLockFreeReads = disableLockFreeReadsOriginalValue; });
+
+    RAIIServerParameterControllerForTest deferIndexBuilds{
+        "reshardingRecipientDeferSecondaryIndexBuilds", true};
+
+    auto shards = setupNShards(2);
+
+    // Shard kOrigNss by _id with chunks [minKey, 0), [0, maxKey] on shards "0" and "1"
+    // respectively. ShardId("1") is the primary shard for the database.
+    loadRoutingTableWithTwoChunksAndTwoShardsImpl(
+        kOrigNss, BSON("_id" << 1), boost::optional<std::string>("1"), kOrigUUID);
+
+    // Simulate a refresh for the temporary resharding collection.
+    loadOneChunkMetadataForTemporaryReshardingColl(
+        kReshardingNss, kOrigNss, kReshardingKey, kReshardingUUID, kReshardingEpoch);
+
+    const auto idIndex = BSON("v" << 2 << "key" << BSON("_id" << 1) << "name"
+                                  << "_id_");
+    const auto shardKeyPrefixedIndex = BSON("v" << 2 << "key" << BSON("newKey" << 1 << "a" << 1)
+                                                << "name"
+                                                << "newKey_1_a_1");
+    const auto secondaryIndex = BSON("v" << 2 << "key"
+                                         << BSON("a" << 1 << "b"
+                                                     << "hashed")
+                                         << "name"
+                                         << "indexOne");
+    auto future = launchAsync([&] {
+        expectRefreshReturnForOriginalColl(kOrigNss, kShardKey, kOrigUUID, kOrigEpoch);
+        expectListCollections(kOrigNss,
+                              kOrigUUID,
+                              {BSON("name" << kOrigNss.coll() << "options" << BSONObj() << "info"
+                                           << BSON("readOnly" << false << "uuid" << kOrigUUID)
+                                           << "idIndex" << idIndex)},
+                              HostAndPort(shards[1].getHost()));
+        expectListIndexes(kOrigNss,
+                          kOrigUUID,
+                          {idIndex, shardKeyPrefixedIndex, secondaryIndex},
+                          HostAndPort(shards[0].getHost()));
+    });
+
+    RecipientStateMachineExternalStateImpl externalState;
+    externalState.ensureTempReshardingCollectionExistsWithIndexes(
+        operationContext(), kMetadata, kDefaultFetchTimestamp);
+
+    future.default_timed_get();
+
+    verifyCollectionAndIndexes(kReshardingNss, kReshardingUUID, {idIndex, shardKeyPrefixedIndex});
+}
+
 TEST_F(RecipientServiceExternalStateTest,
        CreatingLocalReshardingCollectionRetriesOnStaleVersionErrors) {
     // TODO (SERVER-57194): enable lock-free reads.
@@ -33,6 +33,8 @@
 
 #include "mongo/db/s/split_vector.h"
 
+#include <cmath>
+
 #include "mongo/base/status_with.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -44,7 +46,9 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 namespace {
@@ -52,10 +56,157 @@ namespace {
 const int kMaxObjectPerChunk{250000};
 const int estimatedAdditionalBytesPerItemInBSONArray{2};
 
+// How many documents splitVector may draw per document it wants in the sample, which bounds the
+// cost of sampling a chunk holding only a small fraction of the collection.
+const int kMaxDrawsPerSampledKey{100};
+
+// The fewest sampled documents that must fall between two consecutive split points for the sample
+// to be used. With fewer, the sizes of the resulting chunks would vary too much.
+const double kMinSampledKeysPerChunk{10};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
 
+/**
+ * Chooses the split points of the range [minKey, maxKey) from the shard keys of up to 'sampleSize'
+ * documents of the range, drawn at random from the whole collection. Each split point is placed
+ * after the number of sampled keys which corresponds to 'keyCount' documents of the collection.
+ *
+ * 'firstKey' is the smallest shard key in the range, which is never returned as a split point.
+ *
+ * Returns boost::none if the storage engine cannot sample the collection or the sample is too
+ * small to place the split points accurately, in which case the caller should scan the index.
+ */
+boost::optional<std::vector<BSONObj>> sampleSplitKeys(OperationContext* opCtx,
+                                                      const NamespaceString& nss,
+                                                      const CollectionPtr& collection,
+                                                      const BSONObj& keyPattern,
+                                                      const BSONObj& indexKeyPattern,
+                                                      const BSONObj& minKey,
+                                                      const BSONObj& maxKey,
+                                                      const BSONObj& firstKey,
+                                                      long long recCount,
+                                                      long long keyCount,
+                                                      boost::optional<long long> maxSplitPoints,
+                                                      int sampleSize) {
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    Timer timer;
+    const ShardKeyPattern shardKeyPattern(keyPattern);
+    const auto rangeMin = dotted_path_support::extractElementsBasedOnTemplate(
+        prettyKey(indexKeyPattern, minKey), keyPattern);
+    const auto rangeMax = dotted_path_support::extractElementsBasedOnTemplate(
+        prettyKey(indexKeyPattern, maxKey), keyPattern);
+
+    std::vector<BSONObj> sampledKeys;
+    const long long maxDraws = static_cast<long long>(sampleSize) * kMaxDrawsPerSampledKey;
+    long long draws = 0;
+    while (sampledKeys.size() < static_cast<size_t>(sampleSize) && draws < maxDraws) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        if (++draws % 128 == 0) {
+            opCtx->checkForInterrupt();
+        }
+
+        auto key = shardKeyPattern.extractShardKeyFromDoc(record->data.toBson());
+        if (key.isEmpty() || key.woCompare(rangeMin) < 0 || key.woCompare(rangeMax) >= 0) {
+            continue;
+        }
+        sampledKeys.push_back(key.getOwned());
+    }
+
+    // Each sampled key of the range stands for 'recCount / draws' documents of the collection.
+    const double estimatedRangeKeys =
+        draws ? static_cast<double>(sampledKeys.size()) * recCount / draws : 0;
+    const double sampledKeysPerChunk =
+        recCount ? static_cast<double>(keyCount) * draws / recCount : 0;
+
+    if (sampledKeys.size() < static_cast<size_t>(sampleSize) / 2 ||
+        (estimatedRangeKeys > keyCount && sampledKeysPerChunk < kMinSampledKeysPerChunk)) {
+        LOGV2(6114500,
+              "Sampling the chunk is not accurate enough to choose its split points, scanning the "
+              "shard key index instead",
+              "namespace"_attr = nss.toString(),
+              "minKey"_attr = redact(rangeMin),
+              "maxKey"_attr = redact(rangeMax),
+              "documentsSampled"_attr = draws,
+              "sampledKeysInRange"_attr = sampledKeys.size(),
+              "sampledKeysPerChunk"_attr = sampledKeysPerChunk,
+              "duration"_attr = Milliseconds(timer.millis()));
+        return boost::none;
+    }
+
+    std::sort(sampledKeys.begin(),
+              sampledKeys.end(),
+              SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    std::vector<BSONObj> splitKeys;
+    std::size_t splitVectorResponseSize = 0;
+    auto tooFrequentKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    BSONObj lastSplitKey = firstKey;
+    double position = sampledKeysPerChunk;
+    while (estimatedRangeKeys > keyCount && position < sampledKeys.size()) {
+        if (maxSplitPoints && maxSplitPoints.get() &&
+            static_cast<long long>(splitKeys.size()) >= maxSplitPoints.get()) {
+            break;
+        }
+
+        // As when scanning the index, all the instances of a key value must live in the same
+        // chunk, so a key which was already split on moves the split point to the next key.
+        auto it = sampledKeys.begin() + static_cast<std::size_t>(position);
+        if (it->woCompare(lastSplitKey) <= 0) {
+            tooFrequentKeys.insert(lastSplitKey);
+            it = std::upper_bound(it,
+                                  sampledKeys.end(),
+                                  lastSplitKey,
+                                  SimpleBSONObjComparator::kInstance.makeLessThan());
+            if (it == sampledKeys.end()) {
+                break;
+            }
+        }
+
+        auto additionalKeySize = it->objsize() + estimatedAdditionalBytesPerItemInBSONArray;
+        if (splitVectorResponseSize + additionalKeySize > BSONObjMaxUserSize) {
+            break;
+        }
+        splitVectorResponseSize += additionalKeySize;
+        splitKeys.push_back(*it);
+        lastSplitKey = *it;
+        position = (it - sampledKeys.begin()) + sampledKeysPerChunk;
+    }
+
+    for (const auto& key : tooFrequentKeys) {
+        LOGV2_WARNING(6114501,
+                      "Possible low cardinality key detected while sampling the chunk",
+                      "namespace"_attr = nss.toString(),
+                      "key"_attr = redact(key));
+    }
+
+    // The sizes of the chunks are estimated from 'sampledKeysPerChunk' keys each, so they have a
+    // relative standard error of about 1 / sqrt(sampledKeysPerChunk).
+    LOGV2(6114502,
+          "Chose split points for chunk from a sample of its documents",
+          "namespace"_attr = nss.toString(),
+          "keyPattern"_attr = redact(keyPattern),
+          "minKey"_attr = redact(rangeMin),
+          "maxKey"_attr = redact(rangeMax),
+          "keyCount"_attr = keyCount,
+          "numSplits"_attr = splitKeys.size(),
+          "documentsSampled"_attr = draws,
+          "sampledKeysInRange"_attr = sampledKeys.size(),
+          "estimatedKeysInRange"_attr = static_cast<long long>(estimatedRangeKeys),
+          "estimatedChunkSizeRelativeError"_attr = 1 / std::sqrt(sampledKeysPerChunk),
+          "duration"_attr = Milliseconds(timer.millis()));
+
+    return splitKeys;
+}
+
 }  // namespace
 
 std::vector<BSONObj> splitVector(OperationContext* opCtx,
@@ -213,6 +364,29 @@ std::vector<BSONObj> splitVector(OperationContext* opCtx,
             return emptyVector;
         }
 
+        // Choose the split points from a sample of the range, rather than from every key in it,
+        // if the sample is large enough to be accurate.
+        const int sampleSize = splitVectorSampleSize.load();
+        if (sampleSize > 0 && !force) {
+            auto sampledSplitKeys = sampleSplitKeys(
+                opCtx,
+                nss,
+                collection.getCollection(),
+                keyPattern,
+                shardKeyIdx->keyPattern(),
+                minKey,
+                maxKey,
+                dotted_path_support::extractElementsBasedOnTemplate(
+                    prettyKey(shardKeyIdx->keyPattern(), currKey.getOwned()), keyPattern),
+                recCount,
+                keyCount,
+                maxSplitPoints,
+                sampleSize);
+            if (sampledSplitKeys) {
+                return std::move(*sampledSplitKeys);
+            }
+        }
+
         // Use every 'keyCount'-th key as a split point. We add the initial key as a sentinel,
         // to be removed at the end. If a key appears more times than entries allowed on a
         // chunk, we issue a warning and split on the following key.
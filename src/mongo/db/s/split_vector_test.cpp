@@ -38,6 +38,7 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/shard_server_test_fixture.h"
 #include "mongo/db/s/split_vector.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo {
 namespace {
@@ -128,6 +129,23 @@ TEST_F(SplitVectorTest, ForceSplit) {
     }
 }
 
+TEST_F(SplitVectorTest, SplitVectorScansIndexIfSamplingIsUnsupported) {
+    // The storage engine used by the tests cannot sample documents at random, so the split points
+    // are still found by scanning the index.
+    RAIIServerParameterControllerForTest sampleSize{"splitVectorSampleSize", 1000};
+    std::vector<BSONObj> splitKeys = splitVector(operationContext(),
+                                                 kNss,
+                                                 BSON(kPattern << 1),
+                                                 BSON(kPattern << 0),
+                                                 BSON(kPattern << 100),
+                                                 false,
+                                                 boost::none,
+                                                 boost::none,
+                                                 getDocSizeBytes() * 100LL);
+    ASSERT_EQ(splitKeys.size(), 1UL);
+    ASSERT_BSONOBJ_EQ(splitKeys.front(), BSON(kPattern << 50));
+}
+
 TEST_F(SplitVectorTest, MaxChunkObjectsSet) {
     std::vector<BSONObj> splitKeys = splitVector(operationContext(),
                                                  kNss,
@@ -47,6 +47,7 @@
 #include "mongo/db/command_can_run_here.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
+#include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/curop_metrics.h"
@@ -78,10 +79,11 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/transaction_coordinator_factory.h"
-#include "mongo/db/service_entry_point_common.h"
+#include "mongo/db/service_entry_point_common_gen.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/api_version_metrics.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_shape_metrics.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/db/stats/server_read_concern_metrics.h"
 #include "mongo/db/stats/top.h"
@@ -1096,6 +1098,11 @@ void RunCommandImpl::_prologue() {
     auto opCtx = execContext->getOpCtx();
     const Command* command = _ecd->getInvocation()->definition();
     auto bytesToReserve = command->reserveBytesForReply();
+    if (gReserveReplyBytesFromRecentReplies.load()) {
+        bytesToReserve = std::max(
+            bytesToReserve,
+            std::min(command->typicalReplySize(), std::size_t(BSONObjMaxInternalSize)));
+    }
 // SERVER-22100: In Windows DEBUG builds, the CRT heap debugging overhead, in conjunction with the
 // additional memory pressure introduced by reply buffer pre-allocation, causes the concurrency
 // suite to run extremely slowly. As a workaround we do not pre-allocate in Windows DEBUG builds.
@@ -1408,6 +1415,9 @@ void ExecCommandDatabase::_initiateCommand() {
     const bool collect = command->collectsResourceConsumptionMetrics() && !_isInternalClient();
     _scopedMetrics.emplace(opCtx, dbname, collect);
 
+    // Flow control can throttle the databases generating most of the writes apart from the others.
+    FlowControlTicketholder::setSource(opCtx, dbname);
+
     const auto allowTransactionsOnConfigDatabase =
         (serverGlobalParams.clusterRole == ClusterRole::ConfigServer ||
          serverGlobalParams.clusterRole == ClusterRole::ShardServer);
@@ -1633,6 +1643,7 @@ void ExecCommandDatabase::_initiateCommand() {
     }
 
     CurOp::get(opCtx)->ensureStarted();
+    CurOp::publishCurrentOpSnapshot(opCtx);
 
     command->incrementCommandsExecuted();
 
@@ -1827,7 +1838,16 @@ void curOpCommandSetup(OperationContext* opCtx, const OpMsgRequest& request) {
 }
 
 Future<void> parseCommand(std::shared_ptr<HandleRequest::ExecutionContext> execContext) try {
-    execContext->setRequest(rpc::opMsgRequestFromAnyProtocol(execContext->getMessage()));
+    const auto& msg = execContext->getMessage();
+    if (msg.operation() == dbMsg && execContext->client().isInDirectClient()) {
+        // DBDirectClient serialized this request in-process from BSON which the server built or
+        // had already validated, and it never crossed the transport layer, so it carries no
+        // checksum either. That trust only holds as long as every caller of DBDirectClient passes
+        // well-formed BSON, so debug builds still validate it, to catch a caller which does not.
+        execContext->setRequest(OpMsgRequest::parseOwned(msg, kDebugBuild /* validateBSON */));
+    } else {
+        execContext->setRequest(rpc::opMsgRequestFromAnyProtocol(msg));
+    }
     return Status::OK();
 } catch (const DBException& ex) {
     // Need to set request as `makeCommandResponse` expects an empty request on failure.
@@ -1946,6 +1966,9 @@ DbResponse makeCommandResponse(std::shared_ptr<HandleRequest::ExecutionContext>
 
     dbResponse.response = replyBuilder->done();
     CurOp::get(opCtx)->debug().responseLength = dbResponse.response.header().dataLen();
+    if (c && gReserveReplyBytesFromRecentReplies.load()) {
+        c->recordReplySize(dbResponse.response.size());
+    }
 
     return dbResponse;
 }
@@ -2281,6 +2304,19 @@ void HandleRequest::completeOperation(DbResponse& response) {
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
 
+    const auto& opDebug = currentOp.debug();
+    if (opDebug.queryHash && QueryShapeMetrics::isEnabled()) {
+        QueryShapeMetrics::Execution execution;
+        execution.latency = opDebug.executionTime;
+        execution.planningTime = opDebug.planningTime;
+        execution.keysExamined = opDebug.additiveMetrics.keysExamined.value_or(0);
+        execution.docsExamined = opDebug.additiveMetrics.docsExamined.value_or(0);
+        execution.nreturned = std::max(opDebug.nreturned, 0LL);
+        execution.readWriteType = currentOp.getReadWriteType();
+        QueryShapeMetrics::get(opCtx->getServiceContext())
+            .record(currentOp.getNSS(), *opDebug.queryHash, execution);
+    }
+
     if (shouldProfile) {
         // Performance profiling is on
         if (opCtx->lockState()->isReadLocked()) {
@@ -2302,6 +2338,26 @@ void HandleRequest::completeOperation(DbResponse& response) {
     recordCurOpMetrics(opCtx);
 }
 
+/**
+ * Returns true if the operation spent more time reading from disk than
+ * 'borrowedThreadMaxStorageReadMicros' allows. Storage statistics are only gathered for operations
+ * that are slow or profiled, so this does not call into the storage engine for any others.
+ */
+bool isDiskBoundOperation(OperationContext* opCtx) {
+    auto maxReadMicros = gBorrowedThreadMaxStorageReadMicros.load();
+    if (maxReadMicros == 0) {
+        return false;
+    }
+
+    const auto& storageStats = CurOp::get(opCtx)->debug().storageStats;
+    if (!storageStats) {
+        return false;
+    }
+
+    auto readMicros = storageStats->toBSON()["data"]["timeReadingMicros"];
+    return readMicros.isNumber() && readMicros.safeNumberLong() > maxReadMicros;
+}
+
 }  // namespace
 
 BSONObj ServiceEntryPointCommon::getRedactedCopyForLogging(const Command* command,
@@ -2339,6 +2395,20 @@ Future<DbResponse> ServiceEntryPointCommon::handleRequest(
                     // off of it.
                     seCtx->setThreadingModel(
                         transport::ServiceExecutor::ThreadingModel::kDedicated);
+                } else if (seCtx->getThreadingModel() ==
+                               transport::ServiceExecutor::ThreadingModel::kBorrowed &&
+                           isDiskBoundOperation(opCtx)) {
+                    // An operation that waited on disk reads blocks the thread it runs on, which
+                    // the fixed executor shares with other clients. Its client is likely to issue
+                    // more such operations (e.g. the getMores of a cold scan), so move it to a
+                    // thread of its own.
+                    LOGV2_DEBUG(6115000,
+                                2,
+                                "Moving a client off of borrowed threads after a disk-bound "
+                                "operation",
+                                "client"_attr = opCtx->getClient()->desc());
+                    seCtx->setThreadingModel(
+                        transport::ServiceExecutor::ThreadingModel::kDedicated);
                 }
             }
 
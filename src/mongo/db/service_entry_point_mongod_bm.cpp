@@ -0,0 +1,248 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_impl.h"
+#include "mongo/db/catalog/database_holder_impl.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/index/index_access_method_factory_impl.h"
+#include "mongo/db/index_builds_coordinator_mongod.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/s/collection_sharding_state_factory_standalone.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/service_entry_point_mongod.h"
+#include "mongo/db/storage/control/storage_control.h"
+#include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/periodic_runner_factory.h"
+
+namespace mongo {
+namespace {
+
+constexpr auto kDbName = "bench"_sd;
+constexpr auto kCollName = "coll"_sd;
+constexpr int kNumDocs = 10 * 1000;
+constexpr int kRangeSize = 100;
+
+/**
+ * Starts a standalone mongod in-process, with WiredTiger in a temporary directory, and sends it
+ * OP_MSG requests through its ServiceEntryPoint as if they came from the network. Each benchmark
+ * run starts on a collection of 'kNumDocs' documents {_id: i, a: i, s: <string>}, indexed on 'a'.
+ *
+ * Point TMPDIR at a tmpfs mount to keep the disk out of the measurements.
+ */
+class ServiceEntryPointMongodBM : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State& state) override {
+        _dir.emplace("service_entry_point_mongod_bm");
+
+        setGlobalServiceContext(ServiceContext::make());
+        _serviceContext = getGlobalServiceContext();
+        _serviceContext->setServiceEntryPoint(
+            std::make_unique<ServiceEntryPointMongod>(_serviceContext));
+        _serviceContext->setOpObserver(std::make_unique<OpObserverRegistry>());
+        _serviceContext->setPeriodicRunner(makePeriodicRunner(_serviceContext));
+        _threadClient.emplace("bench", _serviceContext);
+
+        storageGlobalParams.dbpath = _dir->path();
+        storageGlobalParams.engine = "wiredTiger";
+        storageGlobalParams.engineSetByUser = true;
+        storageGlobalParams.repair = false;
+        // (Generic FCV reference): Initialize FCV.
+        serverGlobalParams.mutableFeatureCompatibility.setVersion(
+            ServerGlobalParams::FeatureCompatibility::kLatest);
+
+        {
+            auto opCtx = cc().makeOperationContext();
+            initializeStorageEngine(opCtx.get(),
+                                    StorageEngineInitFlags::kAllowNoLockFile |
+                                        StorageEngineInitFlags::kSkipMetadataFile);
+        }
+        StorageControl::startStorageControls(_serviceContext, true /*forTestOnly*/);
+
+        CollectionShardingStateFactory::set(
+            _serviceContext,
+            std::make_unique<CollectionShardingStateFactoryStandalone>(_serviceContext));
+        DatabaseHolder::set(_serviceContext, std::make_unique<DatabaseHolderImpl>());
+        IndexAccessMethodFactory::set(_serviceContext,
+                                      std::make_unique<IndexAccessMethodFactoryImpl>());
+        Collection::Factory::set(_serviceContext, std::make_unique<CollectionImpl::FactoryImpl>());
+        IndexBuildsCoordinator::set(_serviceContext,
+                                    std::make_unique<IndexBuildsCoordinatorMongod>());
+
+        // Run as a standalone, so that writes do not need an oplog.
+        repl::ReplicationCoordinator::set(
+            _serviceContext,
+            std::make_unique<repl::ReplicationCoordinatorMock>(_serviceContext,
+                                                               repl::ReplSettings()));
+
+        _serviceContext->getStorageEngine()->notifyStartupComplete();
+
+        const std::string value(100, 'x');
+        BSONArrayBuilder docs;
+        for (int i = 0; i < kNumDocs; ++i) {
+            docs.append(BSON("_id" << i << "a" << i << "s" << value));
+        }
+        runCommand(BSON("insert" << kCollName << "documents" << docs.arr()));
+        runCommand(BSON("createIndexes" << kCollName << "indexes"
+                                        << BSON_ARRAY(BSON("key" << BSON("a" << 1) << "name"
+                                                                 << "a_1"))));
+        _nextId = kNumDocs;
+    }
+
+    void TearDown(benchmark::State& state) override {
+        {
+            auto opCtx = cc().makeOperationContext();
+            IndexBuildsCoordinator::get(opCtx.get())->shutdown(opCtx.get());
+        }
+
+        CollectionShardingStateFactory::clear(_serviceContext);
+
+        {
+            auto opCtx = cc().makeOperationContext();
+            Lock::GlobalLock glk(opCtx.get(), MODE_X);
+            DatabaseHolder::get(opCtx.get())->closeAll(opCtx.get());
+        }
+
+        shutdownGlobalStorageEngineCleanly(_serviceContext);
+
+        _threadClient.reset();
+        _dir.reset();
+    }
+
+protected:
+    /**
+     * Runs 'cmd' against the benchmark database, as a new operation, and returns its reply.
+     */
+    BSONObj runCommand(BSONObj cmd) {
+        auto opCtx = cc().makeOperationContext();
+        auto request = OpMsgRequest::fromDBAndBody(kDbName, std::move(cmd)).serialize();
+        request.header().setId(nextMessageId());
+
+        auto response =
+            _serviceContext->getServiceEntryPoint()->handleRequest(opCtx.get(), request).get();
+        auto reply = OpMsg::parse(response.response).body;
+        uassertStatusOK(getStatusFromWriteCommandReply(reply));
+        return reply;
+    }
+
+    /**
+     * Returns the lower bound of a range of 'kRangeSize' documents, so that successive iterations
+     * spread over the whole collection.
+     */
+    int rangeStart(int64_t iteration) const {
+        return (iteration * kRangeSize) % (kNumDocs - kRangeSize);
+    }
+
+    int _nextId = 0;
+
+private:
+    boost::optional<unittest::TempDir> _dir;
+    ServiceContext* _serviceContext = nullptr;
+    boost::optional<ThreadClient> _threadClient;
+};
+
+BENCHMARK_DEFINE_F(ServiceEntryPointMongodBM, BM_FindById)(benchmark::State& state) {
+    int64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(runCommand(
+            BSON("find" << kCollName << "filter" << BSON("_id" << (i++ % kNumDocs)) << "limit" << 1
+                        << "singleBatch" << true)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_DEFINE_F(ServiceEntryPointMongodBM, BM_FindRange)(benchmark::State& state) {
+    int64_t i = 0;
+    for (auto _ : state) {
+        const int start = rangeStart(i++);
+        benchmark::DoNotOptimize(runCommand(BSON(
+            "find" << kCollName << "filter"
+                   << BSON("a" << BSON("$gte" << start << "$lt" << start + kRangeSize))
+                   << "batchSize" << kRangeSize + 1)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_DEFINE_F(ServiceEntryPointMongodBM, BM_Insert)(benchmark::State& state) {
+    const std::string value(100, 'x');
+    for (auto _ : state) {
+        const int id = _nextId++;
+        benchmark::DoNotOptimize(runCommand(
+            BSON("insert" << kCollName << "documents"
+                          << BSON_ARRAY(BSON("_id" << id << "a" << id << "s" << value)))));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_DEFINE_F(ServiceEntryPointMongodBM, BM_UpdateById)(benchmark::State& state) {
+    int64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(runCommand(
+            BSON("update" << kCollName << "updates"
+                          << BSON_ARRAY(BSON("q" << BSON("_id" << (i++ % kNumDocs)) << "u"
+                                                 << BSON("$inc" << BSON("n" << 1)))))));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_DEFINE_F(ServiceEntryPointMongodBM, BM_AggregateRange)(benchmark::State& state) {
+    int64_t i = 0;
+    for (auto _ : state) {
+        const int start = rangeStart(i++);
+        benchmark::DoNotOptimize(runCommand(BSON(
+            "aggregate" << kCollName << "pipeline"
+                        << BSON_ARRAY(
+                               BSON("$match" << BSON("a" << BSON("$gte" << start << "$lt"
+                                                                        << start + kRangeSize)))
+                               << BSON("$group" << BSON("_id" << BSONNULL << "total"
+                                                              << BSON("$sum"
+                                                                      << "$a"))))
+                        << "cursor" << BSONObj())));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(ServiceEntryPointMongodBM, BM_FindById);
+BENCHMARK_REGISTER_F(ServiceEntryPointMongodBM, BM_FindRange);
+BENCHMARK_REGISTER_F(ServiceEntryPointMongodBM, BM_Insert);
+BENCHMARK_REGISTER_F(ServiceEntryPointMongodBM, BM_UpdateById);
+BENCHMARK_REGISTER_F(ServiceEntryPointMongodBM, BM_AggregateRange);
+
+}  // namespace
+}  // namespace mongo
@@ -49,17 +49,21 @@ const auto operationSessionDecoration =
 }  // namespace
 
 SessionCatalog::~SessionCatalog() {
-    stdx::lock_guard<Latch> lg(_mutex);
-    for (const auto& entry : _sessions) {
-        ObservableSession session(lg, entry.second->session);
-        invariant(!session.currentOperation());
-        invariant(!session._killed());
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lg(partition.mutex);
+        for (const auto& entry : partition.sessions) {
+            ObservableSession session(lg, entry.second->session);
+            invariant(!session.currentOperation());
+            invariant(!session._killed());
+        }
     }
 }
 
 void SessionCatalog::reset_forTest() {
-    stdx::lock_guard<Latch> lg(_mutex);
-    _sessions.clear();
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lg(partition.mutex);
+        partition.sessions.clear();
+    }
 }
 
 SessionCatalog* SessionCatalog::get(OperationContext* opCtx) {
@@ -79,9 +83,11 @@ SessionCatalog::ScopedCheckedOutSession SessionCatalog::_checkOutSession(Operati
     invariant(!opCtx->lockState()->inAWriteUnitOfWork());
     invariant(!opCtx->lockState()->isLocked());
 
-    stdx::unique_lock<Latch> ul(_mutex);
+    const auto& lsid = *opCtx->getLogicalSessionId();
+    auto& partition = _getPartition(lsid);
+    stdx::unique_lock<Latch> ul(partition.mutex);
 
-    auto sri = _getOrCreateSessionRuntimeInfo(ul, opCtx, *opCtx->getLogicalSessionId());
+    auto sri = _getOrCreateSessionRuntimeInfo(ul, partition, opCtx, lsid);
 
     // Wait until the session is no longer checked out and until the previously scheduled kill has
     // completed
@@ -107,8 +113,9 @@ SessionCatalog::SessionToKill SessionCatalog::checkOutSessionForKill(OperationCo
     invariant(!operationSessionDecoration(opCtx));
     invariant(!opCtx->getTxnNumber());
 
-    stdx::unique_lock<Latch> ul(_mutex);
-    auto sri = _getOrCreateSessionRuntimeInfo(ul, opCtx, killToken.lsidToKill);
+    auto& partition = _getPartition(killToken.lsidToKill);
+    stdx::unique_lock<Latch> ul(partition.mutex);
+    auto sri = _getOrCreateSessionRuntimeInfo(ul, partition, opCtx, killToken.lsidToKill);
     invariant(ObservableSession(ul, sri->session)._killed());
 
     // Wait until the session is no longer checked out
@@ -131,9 +138,10 @@ void SessionCatalog::scanSession(const LogicalSessionId& lsid,
     std::unique_ptr<SessionRuntimeInfo> sessionToReap;
 
     {
-        stdx::lock_guard<Latch> lg(_mutex);
-        auto it = _sessions.find(lsid);
-        if (it != _sessions.end()) {
+        auto& partition = _getPartition(lsid);
+        stdx::lock_guard<Latch> lg(partition.mutex);
+        auto it = partition.sessions.find(lsid);
+        if (it != partition.sessions.end()) {
             auto& sri = it->second;
             ObservableSession osession(lg, sri->session);
             workerFn(osession);
@@ -141,7 +149,7 @@ void SessionCatalog::scanSession(const LogicalSessionId& lsid,
             if (osession._markedForReap && !osession._killed() && !osession.currentOperation() &&
                 !sri->numWaitingToCheckOut) {
                 sessionToReap = std::move(sri);
-                _sessions.erase(it);
+                partition.sessions.erase(it);
             }
         }
     }
@@ -151,16 +159,16 @@ void SessionCatalog::scanSessions(const SessionKiller::Matcher& matcher,
                                   const ScanSessionsCallbackFn& workerFn) {
     std::vector<std::unique_ptr<SessionRuntimeInfo>> sessionsToReap;
 
-    {
-        stdx::lock_guard<Latch> lg(_mutex);
+    LOGV2_DEBUG(21976,
+                2,
+                "Scanning {sessionCount} sessions",
+                "Scanning sessions",
+                "sessionCount"_attr = size());
 
-        LOGV2_DEBUG(21976,
-                    2,
-                    "Scanning {sessionCount} sessions",
-                    "Scanning sessions",
-                    "sessionCount"_attr = _sessions.size());
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lg(partition.mutex);
 
-        for (auto it = _sessions.begin(); it != _sessions.end(); ++it) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end();) {
             if (matcher.match(it->first)) {
                 auto& sri = it->second;
                 ObservableSession osession(lg, sri->session);
@@ -170,32 +178,43 @@ void SessionCatalog::scanSessions(const SessionKiller::Matcher& matcher,
                 if (osession._markedForReap && !osession._killed() &&
                     !osession.currentOperation() && !sri->numWaitingToCheckOut) {
                     sessionsToReap.emplace_back(std::move(sri));
-                    _sessions.erase(it++);
+                    partition.sessions.erase(it++);
+                    continue;
                 }
             }
+            ++it;
         }
     }
 }
 
 SessionCatalog::KillToken SessionCatalog::killSession(const LogicalSessionId& lsid) {
-    stdx::lock_guard<Latch> lg(_mutex);
-    auto it = _sessions.find(lsid);
-    uassert(ErrorCodes::NoSuchSession, "Session not found", it != _sessions.end());
+    auto& partition = _getPartition(lsid);
+    stdx::lock_guard<Latch> lg(partition.mutex);
+    auto it = partition.sessions.find(lsid);
+    uassert(ErrorCodes::NoSuchSession, "Session not found", it != partition.sessions.end());
 
     auto& sri = it->second;
     return ObservableSession(lg, sri->session).kill();
 }
 
 size_t SessionCatalog::size() const {
-    stdx::lock_guard<Latch> lg(_mutex);
-    return _sessions.size();
+    size_t size = 0;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lg(partition.mutex);
+        size += partition.sessions.size();
+    }
+    return size;
+}
+
+SessionCatalog::Partition& SessionCatalog::_getPartition(const LogicalSessionId& lsid) {
+    return _partitions[LogicalSessionIdHash()(lsid) % kNumPartitions];
 }
 
 SessionCatalog::SessionRuntimeInfo* SessionCatalog::_getOrCreateSessionRuntimeInfo(
-    WithLock, OperationContext* opCtx, const LogicalSessionId& lsid) {
-    auto it = _sessions.find(lsid);
-    if (it == _sessions.end()) {
-        it = _sessions.emplace(lsid, std::make_unique<SessionRuntimeInfo>(lsid)).first;
+    WithLock, Partition& partition, OperationContext* opCtx, const LogicalSessionId& lsid) {
+    auto it = partition.sessions.find(lsid);
+    if (it == partition.sessions.end()) {
+        it = partition.sessions.emplace(lsid, std::make_unique<SessionRuntimeInfo>(lsid)).first;
     }
 
     return it->second.get();
@@ -203,11 +222,12 @@ SessionCatalog::SessionRuntimeInfo* SessionCatalog::_getOrCreateSessionRuntimeIn
 
 void SessionCatalog::_releaseSession(SessionRuntimeInfo* sri,
                                      boost::optional<KillToken> killToken) {
-    stdx::lock_guard<Latch> lg(_mutex);
+    auto& partition = _getPartition(sri->session.getSessionId());
+    stdx::lock_guard<Latch> lg(partition.mutex);
 
     // Make sure we have exactly the same session on the map and that it is still associated with an
     // operation context (meaning checked-out)
-    invariant(_sessions[sri->session.getSessionId()].get() == sri);
+    invariant(partition.sessions[sri->session.getSessionId()].get() == sri);
     invariant(sri->session._checkoutOpCtx);
     sri->session._checkoutOpCtx = nullptr;
     sri->availableCondVar.notify_all();
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -91,13 +92,12 @@ public:
     SessionToKill checkOutSessionForKill(OperationContext* opCtx, KillToken killToken);
 
     /**
-     * Iterates through the SessionCatalog under the SessionCatalog mutex and applies 'workerFn' to
-     * each Session which matches the specified 'matcher'.
+     * Iterates through the SessionCatalog and applies 'workerFn' to each Session which matches the
+     * specified 'matcher'. The catalog is scanned one partition at a time, and 'workerFn' runs
+     * under the mutex of the partition which holds the session it is passed.
      *
-     * NOTE: Since this method runs with the session catalog mutex, the work done by 'workerFn' is
-     * not allowed to block, perform I/O or acquire any lock manager locks.
-     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
-     * SessionCatalog.
+     * NOTE: Since this method runs with a session catalog mutex, the work done by 'workerFn' is not
+     * allowed to block, perform I/O or acquire any lock manager locks.
      */
     using ScanSessionsCallbackFn = std::function<void(ObservableSession&)>;
     void scanSession(const LogicalSessionId& lsid, const ScanSessionsCallbackFn& workerFn);
@@ -105,7 +105,7 @@ public:
                       const ScanSessionsCallbackFn& workerFn);
 
     /**
-     * Shortcut to invoke 'kill' on the specified session under the SessionCatalog mutex. Throws a
+     * Shortcut to invoke 'kill' on the specified session under its SessionCatalog mutex. Throws a
      * NoSuchSession exception if the session doesn't exist.
      */
     KillToken killSession(const LogicalSessionId& lsid);
@@ -129,22 +129,43 @@ private:
         // sessions entries from the map.
         int numWaitingToCheckOut{0};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
-        // the state transitions.
+        // Signaled when the state becomes available. Uses the mutex of the partition which owns
+        // this entry to protect the state transitions.
         stdx::condition_variable availableCondVar;
     };
     using SessionRuntimeInfoMap = LogicalSessionIdMap<std::unique_ptr<SessionRuntimeInfo>>;
 
+    // The session map is split into partitions by the hash of the session id, each with its own
+    // mutex, so that operations on different sessions do not contend on a single catalog mutex. No
+    // code path holds the mutexes of more than one partition at a time.
+    static constexpr size_t kNumPartitions = 16;
+
+    struct Partition {
+        // Protects the state below
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(4), "SessionCatalog::Partition::mutex");
+
+        // Owns the Session objects for all current Sessions which hash to this partition.
+        SessionRuntimeInfoMap sessions;
+    };
+
+    /**
+     * Returns the partition which owns the entry for 'lsid'.
+     */
+    Partition& _getPartition(const LogicalSessionId& lsid);
+
     /**
      * Blocking method, which checks-out the session set on 'opCtx'.
      */
     ScopedCheckedOutSession _checkOutSession(OperationContext* opCtx);
 
     /**
-     * Creates or returns the session runtime info for 'lsid' from the '_sessions' map. The returned
-     * pointer is guaranteed to be linked on the map for as long as the mutex is held.
+     * Creates or returns the session runtime info for 'lsid' from the map of 'partition', which
+     * must be the partition for 'lsid'. The returned pointer is guaranteed to be linked on the map
+     * for as long as the partition mutex is held.
      */
     SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock,
+                                                       Partition& partition,
                                                        OperationContext* opCtx,
                                                        const LogicalSessionId& lsid);
 
@@ -153,12 +174,7 @@ private:
      */
     void _releaseSession(SessionRuntimeInfo* sri, boost::optional<KillToken> killToken);
 
-    // Protects the state below
-    mutable Mutex _mutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(4), "SessionCatalog::_mutex");
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    std::array<Partition, kNumPartitions> _partitions;
 };
 
 /**
@@ -242,8 +258,8 @@ using SessionToKill = SessionCatalog::SessionToKill;
 /**
  * This type represents access to a session inside of a scanSessions loop.
  * If you have one of these, you're in a scanSessions callback context, and so
- * have locked the whole catalog and, if the observed session is bound to an operation context,
- * you hold that operation context's client's mutex, as well.
+ * have locked the catalog partition which holds the session and, if the observed session is bound
+ * to an operation context, you hold that operation context's client's mutex, as well.
  */
 class ObservableSession {
 public:
@@ -266,6 +266,33 @@ TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReap) {
     });
 }
 
+TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReapAcrossAllPartitions) {
+    // Create enough sessions that every partition of the catalog holds several of them.
+    const size_t kNumSessions = 100;
+    for (size_t i = 0; i < kNumSessions; ++i) {
+        stdx::async(stdx::launch::async,
+                    [this] {
+                        ThreadClient tc(getServiceContext());
+                        auto opCtx = makeOperationContext();
+                        opCtx->setLogicalSessionId(makeLogicalSessionIdForTest());
+                        OperationContextSession ocs(opCtx.get());
+                    })
+            .get();
+    }
+    ASSERT_EQ(kNumSessions, catalog()->size());
+
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(_opCtx)});
+
+    size_t numSessionsScanned = 0;
+    catalog()->scanSessions(matcherAllSessions, [&](ObservableSession& session) {
+        ++numSessionsScanned;
+        session.markForReap();
+    });
+    ASSERT_EQ(kNumSessions, numSessionsScanned);
+    ASSERT_EQ(0U, catalog()->size());
+}
+
 TEST_F(SessionCatalogTest, KillSessionWhenSessionIsNotCheckedOut) {
     const auto lsid = makeLogicalSessionIdForTest();
 
@@ -61,9 +61,12 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -104,6 +107,80 @@ EncryptionHooks* getEncryptionHooksIfEnabled() {
     return encryptionHooks;
 }
 
+/**
+ * Calls 'fn(i)' for every i in [0, n), each on its own thread except for i == 0, which runs on the
+ * calling thread. Rethrows the first exception thrown by any of the calls once all have finished.
+ */
+template <typename Fn>
+void runConcurrently(size_t n, const Fn& fn) {
+    std::vector<std::exception_ptr> errors(n);
+    auto runOne = [&](size_t i) {
+        try {
+            fn(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<stdx::thread> threads;
+        threads.reserve(n - 1);
+        // Join whatever was started even if starting a later thread fails.
+        ON_BLOCK_EXIT([&] {
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        });
+        for (size_t i = 1; i < n; ++i) {
+            threads.emplace_back(runOne, i);
+        }
+        runOne(0);
+    }
+
+    for (auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+/**
+ * Stable sorts [begin, end) using up to 'maxThreads' threads. The range is split into contiguous
+ * chunks that are sorted concurrently, and neighbouring sorted chunks are then merged pairwise,
+ * with the merges of each round also running concurrently. Ranges too small to be worth the
+ * threads are sorted on the calling thread.
+ */
+template <typename RandomIt, typename Less>
+void parallelStableSort(RandomIt begin, RandomIt end, const Less& less, size_t maxThreads) {
+    constexpr size_t kMinElementsPerThread = 4096;
+    const size_t size = end - begin;
+    const size_t numChunks = std::min(maxThreads, size / kMinElementsPerThread);
+    if (numChunks <= 1) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    std::vector<RandomIt> bounds;
+    bounds.reserve(numChunks + 1);
+    for (size_t i = 0; i < numChunks; ++i) {
+        bounds.push_back(begin + size * i / numChunks);
+    }
+    bounds.push_back(end);
+
+    runConcurrently(numChunks,
+                    [&](size_t i) { std::stable_sort(bounds[i], bounds[i + 1], less); });
+
+    // After the round of merges with a given 'width', each run of 2 * 'width' chunks is sorted.
+    for (size_t width = 1; width < numChunks; width *= 2) {
+        const size_t numMerges = (numChunks - width + 2 * width - 1) / (2 * width);
+        runConcurrently(numMerges, [&](size_t m) {
+            const size_t first = m * 2 * width;
+            std::inplace_merge(bounds[first],
+                               bounds[first + width],
+                               bounds[std::min(first + 2 * width, numChunks)],
+                               less);
+        });
+    }
+}
 }  // namespace
 
 namespace sorter {
@@ -304,12 +381,13 @@ private:
         const bool compressed = rawSize < 0;
         int32_t blockSize = std::abs(rawSize);
 
-        _buffer.reset(new char[blockSize]);
+        reserveBuffer(_buffer, _bufferCapacity, blockSize);
         read(_buffer.get(), blockSize);
         uassert(16816, "file too short?", !_done);
 
         if (auto encryptionHooks = getEncryptionHooksIfEnabled()) {
             std::unique_ptr<char[]> out(new char[blockSize]);
+            _bufferCapacity = blockSize;
             size_t outLen;
             Status status =
                 encryptionHooks->unprotectTmpData(reinterpret_cast<const uint8_t*>(_buffer.get()),
@@ -337,14 +415,23 @@ private:
                 "couldn't get uncompressed length",
                 snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
 
-        std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
+        reserveBuffer(_decompressionBuffer, _decompressionBufferCapacity, uncompressedSize);
         uassert(17062,
                 "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+                snappy::RawUncompress(_buffer.get(), blockSize, _decompressionBuffer.get()));
 
-        // hold on to decompressed data and throw out compressed data at block exit
-        _buffer.swap(decompressionBuffer);
-        _bufferReader.reset(new BufReader(_buffer.get(), uncompressedSize));
+        _bufferReader.reset(new BufReader(_decompressionBuffer.get(), uncompressedSize));
+    }
+
+    /**
+     * Makes 'buffer' hold at least 'size' bytes. Blocks are mostly the same size, so this keeps
+     * the existing allocation whenever it is large enough rather than allocating for each block.
+     */
+    static void reserveBuffer(std::unique_ptr<char[]>& buffer, size_t& capacity, size_t size) {
+        if (capacity >= size)
+            return;
+        buffer.reset(new char[size]);
+        capacity = size;
     }
 
     /**
@@ -378,7 +465,12 @@ private:
     const Settings _settings;
     bool _done;
 
+    // Holds each block as read from disk, and then decrypted.
     std::unique_ptr<char[]> _buffer;
+    size_t _bufferCapacity = 0;
+    // Holds each compressed block after it has been decompressed.
+    std::unique_ptr<char[]> _decompressionBuffer;
+    size_t _decompressionBufferCapacity = 0;
     std::unique_ptr<BufReader> _bufferReader;
     std::string _fileFullPath;        // File containing the sorted data range.
     std::streampos _fileStartOffset;  // File offset at which the sorted data range starts.
@@ -571,6 +663,18 @@ public:
           _nextSortedFileWriterOffset(!ranges.empty() ? ranges.back().getEndOffset() : 0) {
         invariant(opts.extSortAllowed);
 
+        // Data past the end of the last range was spilled after the ranges were recorded, as when
+        // resuming from a checkpoint. Discard it, since new data is appended to the file.
+        const std::uintmax_t endOffset = std::streamoff(_nextSortedFileWriterOffset);
+        boost::system::error_code ec;
+        if (boost::filesystem::file_size(this->_fileFullPath, ec) > endOffset && !ec) {
+            boost::filesystem::resize_file(this->_fileFullPath, endOffset, ec);
+            uassert(6107502,
+                    str::stream() << "Failed to truncate sort file " << this->_fileFullPath
+                                  << ": " << ec.message(),
+                    !ec);
+        }
+
         this->_iters.reserve(ranges.size());
         std::transform(ranges.begin(),
                        ranges.end(),
@@ -649,7 +753,7 @@ private:
 
     void sort() {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        parallelStableSort(_data.begin(), _data.end(), less, this->_opts.sortThreads);
         this->_numSorted += _data.size();
     }
 
@@ -668,6 +772,7 @@ private:
                           << " bytes, but did not opt in to external sorting.");
         }
 
+        Timer timer;
         sort();
 
         SortedFileWriter<Key, Value> writer(
@@ -676,6 +781,9 @@ private:
             writer.addAlreadySorted(_data.front().first, _data.front().second);
         }
         Iterator* iteratorPtr = writer.done();
+        this->_spillStats.spilledDataBytes +=
+            writer.getFileEndOffset() - _nextSortedFileWriterOffset;
+        this->_spillStats.spillTime += Microseconds(timer.micros());
         _nextSortedFileWriterOffset = writer.getFileEndOffset();
 
         this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
@@ -963,6 +1071,7 @@ private:
         // We should check readOnly before getting here.
         invariant(!storageGlobalParams.readOnly);
 
+        Timer timer;
         sort();
         updateCutoff();
 
@@ -976,6 +1085,9 @@ private:
         std::vector<Data>().swap(_data);
 
         Iterator* iteratorPtr = writer.done();
+        this->_spillStats.spilledDataBytes +=
+            writer.getFileEndOffset() - _nextSortedFileWriterOffset;
+        this->_spillStats.spillTime += Microseconds(timer.micros());
         _nextSortedFileWriterOffset = writer.getFileEndOffset();
         this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
 
@@ -1018,8 +1130,14 @@ Sorter<Key, Value>::Sorter(const SortOptions& opts, const std::string& fileName)
 
 template <typename Key, typename Value>
 typename Sorter<Key, Value>::PersistedState Sorter<Key, Value>::persistDataForShutdown() {
-    spill();
+    auto state = persistDataForCheckpoint();
     _shouldKeepFilesOnDestruction = true;
+    return state;
+}
+
+template <typename Key, typename Value>
+typename Sorter<Key, Value>::PersistedState Sorter<Key, Value>::persistDataForCheckpoint() {
+    spill();
 
     std::vector<SorterRange> ranges;
     ranges.reserve(_iters.size());
@@ -1097,14 +1215,14 @@ void SortedFileWriter<Key, Value>::spill() {
     if (size == 0)
         return;
 
-    std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
-    verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
+    // Compressing into a member buffer lets it keep its capacity from block to block.
+    snappy::Compress(outBuffer, size, &_compressionBuffer);
+    verify(_compressionBuffer.size() <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = _compressionBuffer.size() < size_t(_buffer.len() / 10 * 9);
     if (shouldCompress) {
-        size = compressed.size();
-        outBuffer = const_cast<char*>(compressed.data());
+        size = _compressionBuffer.size();
+        outBuffer = const_cast<char*>(_compressionBuffer.data());
     }
 
     std::unique_ptr<char[]> out;
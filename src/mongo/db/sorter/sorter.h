@@ -41,6 +41,7 @@
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/sorter/sorter_gen.h"
 #include "mongo/util/bufreader.h"
+#include "mongo/util/duration.h"
 
 /**
  * This is the public API for the Sorter (both in-memory and external)
@@ -118,11 +119,17 @@ struct SortOptions {
     // instead of copying.
     bool moveSortedDataIntoIterator;
 
+    // The maximum number of threads used to sort the in-memory data before it is spilled or
+    // returned. The comparator must be safe to call concurrently if this is greater than 1. Only
+    // applies when there is no limit.
+    size_t sortThreads;
+
     SortOptions()
         : limit(0),
           maxMemoryUsageBytes(64 * 1024 * 1024),
           extSortAllowed(false),
-          moveSortedDataIntoIterator(false) {}
+          moveSortedDataIntoIterator(false),
+          sortThreads(1) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -155,6 +162,22 @@ struct SortOptions {
         moveSortedDataIntoIterator = newMoveSortedDataIntoIterator;
         return *this;
     }
+
+    SortOptions& SortThreads(size_t newSortThreads) {
+        sortThreads = newSortThreads;
+        return *this;
+    }
+};
+
+/**
+ * What a Sorter has spilled to disk so far.
+ */
+struct SorterSpillStats {
+    // Bytes written to the spill file, after compression and encryption.
+    uint64_t spilledDataBytes = 0;
+
+    // Time spent sorting and writing out the data that was spilled.
+    Microseconds spillTime{0};
 };
 
 /**
@@ -294,8 +317,19 @@ public:
         return _totalDataSizeSorted;
     }
 
+    const SorterSpillStats& spillStats() const {
+        return _spillStats;
+    }
+
     PersistedState persistDataForShutdown();
 
+    /**
+     * Spills the data held in memory and returns the state needed to read back everything added
+     * so far. Unlike persistDataForShutdown(), more data can be added afterwards and the files are
+     * still removed on destruction.
+     */
+    PersistedState persistDataForCheckpoint();
+
 protected:
     Sorter() {}  // can only be constructed as a base
 
@@ -303,6 +337,7 @@ protected:
 
     size_t _numSorted = 0;              // Keeps track of the number of keys sorted.
     uint64_t _totalDataSizeSorted = 0;  // Keeps track of the total size of data sorted.
+    SorterSpillStats _spillStats;       // Only tracks spills made by this Sorter instance.
 
     // Whether the files written by this Sorter should be kept on destruction.
     bool _shouldKeepFilesOnDestruction = false;
@@ -363,6 +398,7 @@ private:
     std::string _fileFullPath;
     std::ofstream _file;
     BufBuilder _buffer;
+    std::string _compressionBuffer;
 
     // Keeps track of the hash of all data objects spilled to disk. Passed to the FileIterator
     // to ensure data has not been corrupted after reading from disk.
@@ -390,6 +390,7 @@ public:
                 addData(sorter.get());
                 ASSERT_ITERATORS_EQUIVALENT(done(sorter.get()), correct());
                 ASSERT_EQ(numAdded(), sorter->numSorted());
+                ASSERT_EQ(sorter->numSpills() > 0, sorter->spillStats().spilledDataBytes > 0);
                 if (assertRanges) {
                     assertRangeInfo(sorter, opts);
                 }
@@ -652,6 +653,22 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+template <bool Random = true>
+class LotsOfDataParallelSort : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        // Make sure each spill is large enough to be split across all of the threads.
+        MONGO_STATIC_ASSERT(MEM_LIMIT / sizeof(IWPair) > 4 * 4096);
+        MONGO_STATIC_ASSERT((Parent::NUM_ITEMS * sizeof(IWPair)) / MEM_LIMIT > 2);
+
+        return opts.MaxMemoryUsageBytes(MEM_LIMIT).ExtSortAllowed().SortThreads(5);
+    }
+    size_t correctNumRanges() const override {
+        return Parent::NUM_ITEMS * sizeof(IWPair) / MEM_LIMIT + 1;
+    }
+    enum { MEM_LIMIT = 1024 * 1024 };
+};
 }  // namespace SorterTests
 
 class SorterSuite : public mongo::unittest::OldStyleSuiteSpecification {
@@ -670,6 +687,8 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/false>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
@@ -867,6 +886,47 @@ TEST_F(SorterMakeFromExistingRangesTest, RoundTrip) {
     }
 }
 
+TEST_F(SorterMakeFromExistingRangesTest, ResumeFromCheckpoint) {
+    unittest::TempDir tempDir(_agent.getSuiteName() + "_" + _agent.getTestName());
+
+    auto opts = SortOptions()
+                    .ExtSortAllowed()
+                    .TempDir(tempDir.path())
+                    .MaxMemoryUsageBytes(sizeof(IWSorter::Data));
+
+    IWPair pairInsertedBeforeCheckpoint(1, 100);
+
+    // Data spilled after the checkpoint is still in the file, as after an unclean shutdown, but is
+    // not part of the checkpointed state.
+    IWSorter::PersistedState state;
+    {
+        auto sorterBeforeCrash = std::unique_ptr<IWSorter>(IWSorter::make(opts, IWComparator(ASC)));
+        sorterBeforeCrash->add(pairInsertedBeforeCheckpoint.first,
+                               pairInsertedBeforeCheckpoint.second);
+        state = sorterBeforeCrash->persistDataForCheckpoint();
+        ASSERT_EQUALS(1U, state.ranges.size()) << state.ranges.size();
+
+        sorterBeforeCrash->add(3, 300);
+        ASSERT_EQUALS(2U, sorterBeforeCrash->persistDataForShutdown().ranges.size());
+    }
+
+    auto sorter = std::unique_ptr<IWSorter>(
+        IWSorter::makeFromExistingRanges(state.fileName, state.ranges, opts, IWComparator(ASC)));
+    ASSERT_EQ(state.ranges.size(), sorter->numSpills());
+
+    IWPair pairInsertedAfterStartup(2, 200);
+    sorter->add(pairInsertedAfterStartup.first, pairInsertedAfterStartup.second);
+
+    auto iter = std::unique_ptr<IWIterator>(sorter->done());
+    iter->openSource();
+    ASSERT(iter->more());
+    ASSERT_EQUALS(pairInsertedBeforeCheckpoint.first, iter->next().first);
+    ASSERT(iter->more());
+    ASSERT_EQUALS(pairInsertedAfterStartup.first, iter->next().first);
+    ASSERT_FALSE(iter->more());
+    iter->closeSource();
+}
+
 }  // namespace
 }  // namespace sorter
 }  // namespace mongo
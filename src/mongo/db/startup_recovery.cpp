@@ -343,10 +343,10 @@ void reconcileCatalogAndRebuildUnfinishedIndexes(
         fassert(40593, storageEngine->reconcileCatalogAndIdents(opCtx, lastShutdownState));
 
     auto tempDir = boost::filesystem::path(storageGlobalParams.dbpath).append("_tmp");
-    if (reconcileResult.indexBuildsToResume.empty() ||
-        lastShutdownState == StorageEngine::LastShutdownState::kUnclean) {
-        // If we did not find any index builds to resume or we are starting up after an unclean
-        // shutdown, nothing in the temp directory will be used. Thus, we can clear it completely.
+    if (reconcileResult.indexBuildsToResume.empty()) {
+        // If we did not find any index builds to resume, nothing in the temp directory will be
+        // used. Thus, we can clear it completely. After an unclean shutdown, index builds are only
+        // resumed from state that was checkpointed during their collection scan.
         LOGV2(5071100, "Clearing temp directory");
 
         boost::system::error_code ec;
@@ -64,6 +64,27 @@ TEST(OperationLatencyHistogram, EnsureIncrementsStored) {
     ASSERT_EQUALS(out["transactions"]["ops"].Long(), kMaxBuckets);
 }
 
+TEST(OperationLatencyHistogram, AddMergesEveryHistogram) {
+    OperationLatencyHistogram hist;
+    OperationLatencyHistogram other;
+    hist.increment(1, Command::ReadWriteType::kRead);
+    other.increment(2, Command::ReadWriteType::kRead);
+    other.increment(3000, Command::ReadWriteType::kWrite);
+    other.increment(4, Command::ReadWriteType::kTransaction);
+    hist.add(other);
+
+    BSONObjBuilder outBuilder;
+    hist.append(true, false, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["ops"].Long(), 2);
+    ASSERT_EQUALS(out["reads"]["latency"].Long(), 3);
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), 1);
+    ASSERT_EQUALS(out["writes"]["latency"].Long(), 3000);
+    ASSERT_EQUALS(out["commands"]["ops"].Long(), 0);
+    ASSERT_EQUALS(out["transactions"]["ops"].Long(), 1);
+    ASSERT_EQUALS(out["transactions"]["latency"].Long(), 4);
+}
+
 TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
     OperationLatencyHistogram hist;
     // Increment at the boundary, boundary+1, and boundary-1.
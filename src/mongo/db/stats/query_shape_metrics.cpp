@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_metrics.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+const auto getQueryShapeMetrics = ServiceContext::declareDecoration<QueryShapeMetrics>();
+
+/**
+ * Reports how many query shapes are tracked. The metrics of each shape are only reported by the
+ * $queryShapeMetrics aggregation stage, because a set of fields which changes with the workload
+ * would defeat the compression of FTDC.
+ */
+class QueryShapeMetricsServerStatusSection final : public ServerStatusSection {
+public:
+    QueryShapeMetricsServerStatusSection() : ServerStatusSection("queryShapeMetrics") {}
+
+    bool includeByDefault() const override {
+        return QueryShapeMetrics::isEnabled();
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder builder;
+        QueryShapeMetrics::get(opCtx->getServiceContext()).appendSummary(&builder);
+        return builder.obj();
+    }
+} queryShapeMetricsServerStatusSection;
+}  // namespace
+
+QueryShapeMetrics& QueryShapeMetrics::get(ServiceContext* service) {
+    return getQueryShapeMetrics(service);
+}
+
+bool QueryShapeMetrics::isEnabled() {
+    return internalQueryShapeMetricsMaxEntries > 0;
+}
+
+void QueryShapeMetrics::record(const NamespaceString& nss,
+                               uint32_t queryHash,
+                               const Execution& execution) {
+    const auto now = Date_t::now();
+    auto& partition = _partitions[queryHash % kNumPartitions];
+
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    if (!partition.shapes) {
+        const size_t maxEntries = internalQueryShapeMetricsMaxEntries;
+        partition.shapes = std::make_unique<LRUCache<Key, Metrics>>(
+            std::max<size_t>(maxEntries / kNumPartitions, 1));
+    }
+
+    Key key{nss.ns(), queryHash};
+    auto it = partition.shapes->find(key);
+    if (it == partition.shapes->end()) {
+        Metrics metrics;
+        metrics.firstSeen = now;
+        if (partition.shapes->add(key, std::move(metrics))) {
+            _numEvicted.fetchAndAddRelaxed(1);
+        }
+        // New entries are added as the most recently used.
+        it = partition.shapes->begin();
+    }
+
+    auto& metrics = it->second;
+    ++metrics.execCount;
+    metrics.totalPlanningTimeMicros += durationCount<Microseconds>(execution.planningTime);
+    metrics.totalExecutionTimeMicros +=
+        std::max(durationCount<Microseconds>(execution.latency - execution.planningTime), 0LL);
+    metrics.totalKeysExamined += execution.keysExamined;
+    metrics.totalDocsExamined += execution.docsExamined;
+    metrics.totalDocsReturned += execution.nreturned;
+    metrics.lastSeen = now;
+    metrics.latencyStats.increment(durationCount<Microseconds>(execution.latency),
+                                   execution.readWriteType);
+}
+
+std::vector<BSONObj> QueryShapeMetrics::getStatsByQueryShape() const {
+    std::vector<BSONObj> stats;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        if (!partition.shapes) {
+            continue;
+        }
+        for (auto&& [key, metrics] : *partition.shapes) {
+            BSONObjBuilder builder;
+            builder.append("queryHash", zeroPaddedHex(key.second));
+            builder.append("ns", key.first);
+            builder.append("execCount", metrics.execCount);
+            builder.append("totalPlanningTimeMicros", metrics.totalPlanningTimeMicros);
+            builder.append("totalExecutionTimeMicros", metrics.totalExecutionTimeMicros);
+            builder.append("totalKeysExamined", metrics.totalKeysExamined);
+            builder.append("totalDocsExamined", metrics.totalDocsExamined);
+            builder.append("totalDocsReturned", metrics.totalDocsReturned);
+            builder.appendDate("firstSeen", metrics.firstSeen);
+            builder.appendDate("lastSeen", metrics.lastSeen);
+            BSONObjBuilder latencyBuilder(builder.subobjStart("latencyStats"));
+            metrics.latencyStats.append(true, false, &latencyBuilder);
+            latencyBuilder.doneFast();
+            stats.push_back(builder.obj());
+        }
+    }
+    return stats;
+}
+
+void QueryShapeMetrics::appendSummary(BSONObjBuilder* builder) const {
+    long long numShapes = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        if (partition.shapes) {
+            numShapes += partition.shapes->size();
+        }
+    }
+    builder->append("numShapes", numShapes);
+    builder->append("numEvicted", _numEvicted.load());
+}
+
+}  // namespace mongo
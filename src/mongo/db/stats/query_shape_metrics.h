@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * QueryShapeMetrics keeps latency histograms and execution totals for every query shape run on
+ * this node, keyed by namespace and query hash. Up to 'internalQueryShapeMetricsMaxEntries' shapes
+ * are tracked; the least recently run shapes are evicted beyond that. The shapes are split over a
+ * fixed number of partitions by their query hash, each with its own mutex and LRU, so that the
+ * operations completing at the same time rarely contend.
+ */
+class QueryShapeMetrics {
+public:
+    /**
+     * What one operation with a query shape contributes to the metrics of that shape.
+     */
+    struct Execution {
+        Microseconds latency{0};
+        Microseconds planningTime{0};
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nreturned = 0;
+        Command::ReadWriteType readWriteType = Command::ReadWriteType::kRead;
+    };
+
+    static QueryShapeMetrics& get(ServiceContext* service);
+
+    /**
+     * Returns true if the metrics of query shapes are being tracked.
+     */
+    static bool isEnabled();
+
+    void record(const NamespaceString& nss, uint32_t queryHash, const Execution& execution);
+
+    /**
+     * Returns one document per tracked query shape.
+     */
+    std::vector<BSONObj> getStatsByQueryShape() const;
+
+    /**
+     * Appends the number of tracked and evicted query shapes.
+     */
+    void appendSummary(BSONObjBuilder* builder) const;
+
+private:
+    using Key = std::pair<std::string, uint32_t>;
+
+    struct Metrics {
+        long long execCount = 0;
+        long long totalPlanningTimeMicros = 0;
+        long long totalExecutionTimeMicros = 0;
+        long long totalKeysExamined = 0;
+        long long totalDocsExamined = 0;
+        long long totalDocsReturned = 0;
+        Date_t firstSeen;
+        Date_t lastSeen;
+        OperationLatencyHistogram latencyStats;
+    };
+
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryShapeMetrics::Partition::mutex");
+        // Created on first use, once the value of 'internalQueryShapeMetricsMaxEntries' is known.
+        std::unique_ptr<LRUCache<Key, Metrics>> shapes;
+    };
+
+    static constexpr size_t kNumPartitions = 16;
+
+    std::array<Partition, kNumPartitions> _partitions;
+
+    AtomicWord<long long> _numEvicted;
+};
+
+}  // namespace mongo
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_metrics.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+QueryShapeMetrics::Execution makeExecution(long long latencyMicros, long long planningMicros) {
+    QueryShapeMetrics::Execution execution;
+    execution.latency = Microseconds(latencyMicros);
+    execution.planningTime = Microseconds(planningMicros);
+    execution.keysExamined = 3;
+    execution.docsExamined = 2;
+    execution.nreturned = 1;
+    return execution;
+}
+
+TEST(QueryShapeMetricsTest, AccumulatesExecutionsOfTheSameShape) {
+    RAIIServerParameterControllerForTest maxEntries("internalQueryShapeMetricsMaxEntries", 100);
+    QueryShapeMetrics metrics;
+    metrics.record(kNss, 1, makeExecution(100, 10));
+    metrics.record(kNss, 1, makeExecution(300, 20));
+    metrics.record(NamespaceString("test.other"), 1, makeExecution(50, 5));
+
+    auto stats = metrics.getStatsByQueryShape();
+    ASSERT_EQ(stats.size(), 2U);
+    auto shape = stats[0]["ns"].String() == kNss.ns() ? stats[0] : stats[1];
+    ASSERT_EQ(shape["queryHash"].String(), "00000001");
+    ASSERT_EQ(shape["execCount"].Long(), 2);
+    ASSERT_EQ(shape["totalPlanningTimeMicros"].Long(), 30);
+    ASSERT_EQ(shape["totalExecutionTimeMicros"].Long(), 370);
+    ASSERT_EQ(shape["totalKeysExamined"].Long(), 6);
+    ASSERT_EQ(shape["totalDocsExamined"].Long(), 4);
+    ASSERT_EQ(shape["totalDocsReturned"].Long(), 2);
+    ASSERT_EQ(shape["latencyStats"]["reads"]["ops"].Long(), 2);
+    ASSERT_EQ(shape["latencyStats"]["reads"]["latency"].Long(), 400);
+}
+
+TEST(QueryShapeMetricsTest, EvictsLeastRecentlyRunShape) {
+    // One shape per partition. Query hashes 1 and 17 fall in the same partition.
+    RAIIServerParameterControllerForTest maxEntries("internalQueryShapeMetricsMaxEntries", 16);
+    QueryShapeMetrics metrics;
+    metrics.record(kNss, 1, makeExecution(100, 10));
+    metrics.record(kNss, 17, makeExecution(100, 10));
+    metrics.record(kNss, 17, makeExecution(100, 10));
+    metrics.record(kNss, 2, makeExecution(100, 10));
+
+    auto stats = metrics.getStatsByQueryShape();
+    ASSERT_EQ(stats.size(), 2U);
+    for (auto&& shape : stats) {
+        ASSERT_NE(shape["queryHash"].String(), "00000001");
+    }
+
+    BSONObjBuilder builder;
+    metrics.appendSummary(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(), BSON("numShapes" << 2LL << "numEvicted" << 1LL));
+}
+
+}  // namespace
+}  // namespace mongo
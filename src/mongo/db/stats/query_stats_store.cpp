@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_stats_store.h"
+
+#include <map>
+#include <tuple>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+const auto getQueryStatsStore = ServiceContext::declareDecoration<QueryStatsStore>();
+
+struct StageTotals {
+    std::string path;
+    std::string stage;
+    long long numSamples = 0;
+    long long executionTimeMillis = 0;
+    long long advanced = 0;
+};
+
+struct ShapeTotals {
+    long long numSamples = 0;
+    Date_t firstSampled = Date_t::max();
+    Date_t lastSampled = Date_t::min();
+    std::vector<StageTotals> stages;
+};
+
+StringData engineName(QueryStatsStore::Engine engine) {
+    return engine == QueryStatsStore::Engine::kSBE ? "sbe"_sd : "classic"_sd;
+}
+}  // namespace
+
+QueryStatsStore& QueryStatsStore::get(ServiceContext* service) {
+    return getQueryStatsStore(service);
+}
+
+bool QueryStatsStore::shouldSample() {
+    const auto sampleRate = internalQueryStatsSampleRate.load();
+    if (sampleRate <= 0) {
+        return false;
+    }
+    return _numExecutors.fetchAndAddRelaxed(1) % sampleRate == 0;
+}
+
+void QueryStatsStore::record(Sample sample) {
+    const auto maxSamples = static_cast<size_t>(internalQueryStatsMaxSamples.load());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_samples.size() > maxSamples) {
+        // The buffer was shrunk since the last sample was recorded.
+        _samples.resize(maxSamples);
+        _nextSample = 0;
+    }
+    if (_samples.size() < maxSamples) {
+        _samples.push_back(std::move(sample));
+        return;
+    }
+    _samples[_nextSample] = std::move(sample);
+    _nextSample = (_nextSample + 1) % maxSamples;
+}
+
+std::vector<BSONObj> QueryStatsStore::getStatsByQueryShape() const {
+    std::map<std::tuple<std::string, uint32_t, Engine>, ShapeTotals> shapes;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto&& sample : _samples) {
+            auto& shape = shapes[{sample.nss.ns(), sample.queryHash, sample.engine}];
+            ++shape.numSamples;
+            shape.firstSampled = std::min(shape.firstSampled, sample.time);
+            shape.lastSampled = std::max(shape.lastSampled, sample.time);
+
+            // Plans are small, and samples of the same shape mostly share their plan, so a linear
+            // search for the matching stage is cheap.
+            for (auto&& stageSample : sample.stages) {
+                auto stage = std::find_if(
+                    shape.stages.begin(), shape.stages.end(), [&](const StageTotals& totals) {
+                        return totals.path == stageSample.path && totals.stage == stageSample.stage;
+                    });
+                if (stage == shape.stages.end()) {
+                    stage = shape.stages.insert(
+                        shape.stages.end(), StageTotals{stageSample.path, stageSample.stage});
+                }
+                ++stage->numSamples;
+                stage->executionTimeMillis += stageSample.executionTimeMillis;
+                stage->advanced += stageSample.advanced;
+            }
+        }
+    }
+
+    std::vector<BSONObj> stats;
+    stats.reserve(shapes.size());
+    for (auto&& [key, shape] : shapes) {
+        auto&& [ns, queryHash, engine] = key;
+        BSONObjBuilder builder;
+        builder.append("queryHash", zeroPaddedHex(queryHash));
+        builder.append("ns", ns);
+        builder.append("engine", engineName(engine));
+        builder.append("numSamples", shape.numSamples);
+        builder.appendDate("firstSampled", shape.firstSampled);
+        builder.appendDate("lastSampled", shape.lastSampled);
+        BSONArrayBuilder stagesBuilder(builder.subarrayStart("stages"));
+        for (auto&& stage : shape.stages) {
+            BSONObjBuilder stageBuilder(stagesBuilder.subobjStart());
+            stageBuilder.append("path", stage.path);
+            stageBuilder.append("stage", stage.stage);
+            stageBuilder.append("numSamples", stage.numSamples);
+            stageBuilder.append("totalExecutionTimeMillis", stage.executionTimeMillis);
+            stageBuilder.append("totalAdvanced", stage.advanced);
+        }
+        stagesBuilder.doneFast();
+        stats.push_back(builder.obj());
+    }
+    return stats;
+}
+
+void QueryStatsStore::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _samples.clear();
+    _nextSample = 0;
+}
+
+}  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * QueryStatsStore keeps the per-stage execution statistics of a sample of the queries run on this
+ * node, so that they can be inspected with the $queryStats aggregation stage. One in every
+ * 'internalQueryStatsSampleRate' query executors is sampled. When a sampled executor is disposed,
+ * the statistics of each of its stages are recorded into a bounded ring buffer, overwriting the
+ * oldest sample once the buffer holds 'internalQueryStatsMaxSamples' of them. Samples are only
+ * aggregated by query shape when they are read.
+ */
+class QueryStatsStore {
+public:
+    enum class Engine { kClassic, kSBE };
+
+    struct StageSample {
+        // The position of the stage in the plan, as the dotted list of the indices of the stage
+        // and its ancestors among their siblings. The root stage is at path "0".
+        std::string path;
+        std::string stage;
+        long long executionTimeMillis = 0;
+        long long advanced = 0;
+    };
+
+    struct Sample {
+        NamespaceString nss;
+        uint32_t queryHash = 0;
+        Engine engine = Engine::kClassic;
+        Date_t time;
+        std::vector<StageSample> stages;
+    };
+
+    static QueryStatsStore& get(ServiceContext* service);
+
+    /**
+     * Returns true if the query executor being created should be sampled. Always returns false
+     * when sampling is disabled.
+     */
+    bool shouldSample();
+
+    void record(Sample sample);
+
+    /**
+     * Returns one document per query shape, namespace and execution engine seen among the current
+     * samples, holding the totals of each stage of their plans.
+     */
+    std::vector<BSONObj> getStatsByQueryShape() const;
+
+    void clear();
+
+private:
+    AtomicWord<unsigned long long> _numExecutors;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryStatsStore::_mutex");
+    std::vector<Sample> _samples;
+    size_t _nextSample = 0;
+};
+
+}  // namespace mongo
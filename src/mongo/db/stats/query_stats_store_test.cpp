@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_stats_store.h"
+
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+QueryStatsStore::Sample makeSample(uint32_t queryHash, long long timeMillis) {
+    QueryStatsStore::Sample sample;
+    sample.nss = NamespaceString("test.coll");
+    sample.queryHash = queryHash;
+    sample.time = Date_t::fromMillisSinceEpoch(timeMillis);
+    sample.stages = {{"0", "FETCH", timeMillis, 2}, {"0.0", "IXSCAN", 1, 3}};
+    return sample;
+}
+
+TEST(QueryStatsStoreTest, SamplingIsDisabledByDefault) {
+    QueryStatsStore store;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_FALSE(store.shouldSample());
+    }
+}
+
+TEST(QueryStatsStoreTest, SamplesOneInEverySampleRateExecutors) {
+    RAIIServerParameterControllerForTest sampleRate("internalQueryStatsSampleRate", 3);
+    QueryStatsStore store;
+    int numSampled = 0;
+    for (int i = 0; i < 9; ++i) {
+        numSampled += store.shouldSample();
+    }
+    ASSERT_EQ(numSampled, 3);
+}
+
+TEST(QueryStatsStoreTest, AggregatesSamplesByQueryShape) {
+    QueryStatsStore store;
+    store.record(makeSample(1, 10));
+    store.record(makeSample(1, 20));
+    store.record(makeSample(2, 30));
+
+    auto stats = store.getStatsByQueryShape();
+    ASSERT_EQ(stats.size(), 2U);
+    ASSERT_BSONOBJ_EQ(stats[0],
+                      BSON("queryHash"
+                           << "00000001"
+                           << "ns"
+                           << "test.coll"
+                           << "engine"
+                           << "classic"
+                           << "numSamples" << 2LL << "firstSampled"
+                           << Date_t::fromMillisSinceEpoch(10) << "lastSampled"
+                           << Date_t::fromMillisSinceEpoch(20) << "stages"
+                           << BSON_ARRAY(BSON("path"
+                                              << "0"
+                                              << "stage"
+                                              << "FETCH"
+                                              << "numSamples" << 2LL << "totalExecutionTimeMillis"
+                                              << 30LL << "totalAdvanced" << 4LL)
+                                         << BSON("path"
+                                                 << "0.0"
+                                                 << "stage"
+                                                 << "IXSCAN"
+                                                 << "numSamples" << 2LL
+                                                 << "totalExecutionTimeMillis" << 2LL
+                                                 << "totalAdvanced" << 6LL))));
+    ASSERT_EQ(stats[1]["queryHash"].String(), "00000002");
+    ASSERT_EQ(stats[1]["numSamples"].Long(), 1);
+}
+
+TEST(QueryStatsStoreTest, OverwritesOldestSampleWhenFull) {
+    RAIIServerParameterControllerForTest maxSamples("internalQueryStatsMaxSamples", 2);
+    QueryStatsStore store;
+    store.record(makeSample(1, 10));
+    store.record(makeSample(2, 20));
+    store.record(makeSample(3, 30));
+
+    auto stats = store.getStatsByQueryShape();
+    ASSERT_EQ(stats.size(), 2U);
+    ASSERT_EQ(stats[0]["queryHash"].String(), "00000002");
+    ASSERT_EQ(stats[1]["queryHash"].String(), "00000003");
+
+    store.clear();
+    ASSERT(store.getStatsByQueryShape().empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -52,6 +52,7 @@ static const char kDocBytesWritten[] = "docBytesWritten";
 static const char kDocUnitsRead[] = "docUnitsRead";
 static const char kDocUnitsReturned[] = "docUnitsReturned";
 static const char kDocUnitsWritten[] = "docUnitsWritten";
+static const char kHardwareCounters[] = "hardwareCounters";
 static const char kIdxEntryBytesRead[] = "idxEntryBytesRead";
 static const char kIdxEntryBytesWritten[] = "idxEntryBytesWritten";
 static const char kIdxEntryUnitsRead[] = "idxEntryUnitsRead";
@@ -116,6 +117,10 @@ bool ResourceConsumption::isMetricsAggregationEnabled() {
     return gAggregateOperationResourceConsumptionMetrics;
 }
 
+bool ResourceConsumption::isHardwareCounterCollectionEnabled() {
+    return gCollectOperationResourceConsumptionHardwareCounters;
+}
+
 ResourceConsumption::MetricsCollector& ResourceConsumption::MetricsCollector::get(
     OperationContext* opCtx) {
     return getMetricsCollector(opCtx);
@@ -199,6 +204,12 @@ void ResourceConsumption::AggregatedMetrics::toBson(BSONObjBuilder* builder) con
 
     writeMetrics.toBson(builder);
     builder->appendNumber(kCpuNanos, durationCount<Nanoseconds>(cpuNanos));
+
+    if (isHardwareCounterCollectionEnabled()) {
+        BSONObjBuilder hardwareBuilder = builder->subobjStart(kHardwareCounters);
+        hardwareCounts.toBson(&hardwareBuilder);
+        hardwareBuilder.done();
+    }
 }
 
 void ResourceConsumption::OperationMetrics::toBson(BSONObjBuilder* builder) const {
@@ -207,6 +218,11 @@ void ResourceConsumption::OperationMetrics::toBson(BSONObjBuilder* builder) cons
     if (cpuTimer) {
         builder->appendNumber(kCpuNanos, durationCount<Nanoseconds>(cpuTimer->getElapsed()));
     }
+    if (hardwareCounters) {
+        BSONObjBuilder hardwareBuilder = builder->subobjStart(kHardwareCounters);
+        hardwareCounters->getCounts().toBson(&hardwareBuilder);
+        hardwareBuilder.done();
+    }
 }
 
 void ResourceConsumption::OperationMetrics::toBsonNonZeroFields(BSONObjBuilder* builder) const {
@@ -227,6 +243,12 @@ void ResourceConsumption::OperationMetrics::toBsonNonZeroFields(BSONObjBuilder*
     appendNonZeroMetric(builder, kIdxEntryBytesWritten, writeMetrics.idxEntriesWritten.bytes());
     appendNonZeroMetric(builder, kIdxEntryUnitsWritten, writeMetrics.idxEntriesWritten.units());
     appendNonZeroMetric(builder, kTotalUnitsWritten, writeMetrics.totalWritten.units());
+
+    if (hardwareCounters) {
+        BSONObjBuilder hardwareBuilder = builder->subobjStart(kHardwareCounters);
+        hardwareCounters->getCounts().toBson(&hardwareBuilder);
+        hardwareBuilder.done();
+    }
 }
 
 template <typename Func>
@@ -284,6 +306,14 @@ void ResourceConsumption::MetricsCollector::beginScopedCollecting(OperationConte
     if (_metrics.cpuTimer) {
         _metrics.cpuTimer->start();
     }
+
+    // The OperationHardwareCounters may likewise be nullptr if perf events are unavailable.
+    if (isHardwareCounterCollectionEnabled()) {
+        _metrics.hardwareCounters = OperationHardwareCounters::get(opCtx);
+        if (_metrics.hardwareCounters) {
+            _metrics.hardwareCounters->start();
+        }
+    }
 }
 
 bool ResourceConsumption::MetricsCollector::endScopedCollecting() {
@@ -291,6 +321,9 @@ bool ResourceConsumption::MetricsCollector::endScopedCollecting() {
     if (wasCollecting && _metrics.cpuTimer) {
         _metrics.cpuTimer->stop();
     }
+    if (wasCollecting && _metrics.hardwareCounters) {
+        _metrics.hardwareCounters->stop();
+    }
     _collecting = ScopedCollectionState::kInactive;
     return wasCollecting;
 }
@@ -372,6 +405,9 @@ void ResourceConsumption::merge(OperationContext* opCtx,
     if (metrics.cpuTimer) {
         newMetrics.cpuNanos = metrics.cpuTimer->getElapsed();
     }
+    if (metrics.hardwareCounters) {
+        newMetrics.hardwareCounts = metrics.hardwareCounters->getCounts();
+    }
 
     // Add all metrics into the the globally-aggregated metrics.
     stdx::lock_guard<Mutex> lk(_mutex);
@@ -36,6 +36,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/operation_cpu_timer.h"
+#include "mongo/db/operation_hardware_counters.h"
 #include "mongo/platform/mutex.h"
 
 namespace mongo {
@@ -231,6 +232,9 @@ public:
 
         // Records CPU time consumed by this operation.
         OperationCPUTimer* cpuTimer = nullptr;
+
+        // Counts the hardware events and block I/O of this operation, when enabled and supported.
+        OperationHardwareCounters* hardwareCounters = nullptr;
     };
 
     /**
@@ -244,6 +248,7 @@ public:
             secondaryReadMetrics += other.secondaryReadMetrics;
             writeMetrics += other.writeMetrics;
             cpuNanos += other.cpuNanos;
+            hardwareCounts += other.hardwareCounts;
         };
 
         AggregatedMetrics& operator+=(const AggregatedMetrics& other) {
@@ -267,6 +272,9 @@ public:
 
         // Amount of CPU time consumed by an operation in nanoseconds
         Nanoseconds cpuNanos;
+
+        // Hardware events and block I/O counted for all operations
+        OperationHardwareCounters::Counts hardwareCounts;
     };
 
     /**
@@ -465,6 +473,11 @@ public:
      */
     static bool isMetricsAggregationEnabled();
 
+    /**
+     * Returns true if hardware counters should be collected along with the other metrics.
+     */
+    static bool isHardwareCounterCollectionEnabled();
+
     /**
      * Merges OperationMetrics with a globally-aggregated structure. The OperationMetrics's contents
      * are added to existing values in a map keyed by database name. Read metrics will be attributed
@@ -37,6 +37,8 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
@@ -52,6 +54,7 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
     auto scale = storageStatsSpec.getScale().value_or(1);
     bool verbose = storageStatsSpec.getVerbose();
     bool waitForLock = storageStatsSpec.getWaitForLock();
+    bool cacheUsage = storageStatsSpec.getCacheUsage();
 
     bool isTimeseries = false;
     if (auto viewCatalog = DatabaseHolder::get(opCtx)->getViewCatalog(opCtx, nss.db())) {
@@ -129,6 +132,15 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
     BSONObjBuilder indexDetails;
     std::vector<std::string> indexBuilds;
 
+    // The cache usage is only what the storage engine last sampled, so reporting it opens no
+    // statistics cursors of its own.
+    const KVEngine* engine = opCtx->getServiceContext()->getStorageEngine()->getEngine();
+    BSONObjBuilder collectionCacheUsage;
+    BSONObjBuilder indexCacheUsage;
+    if (cacheUsage) {
+        engine->appendIdentCacheUsage(recordStore->getIdent(), scale, &collectionCacheUsage);
+    }
+
     std::unique_ptr<IndexCatalog::IndexIterator> it =
         indexCatalog->getIndexIterator(opCtx, /*includeUnfinishedIndexes=*/true);
     while (it->more()) {
@@ -142,6 +154,13 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
             indexDetails.append(descriptor->indexName(), bob.obj());
         }
 
+        if (cacheUsage) {
+            BSONObjBuilder usage;
+            if (engine->appendIdentCacheUsage(entry->getIdent(), scale, &usage)) {
+                indexCacheUsage.append(descriptor->indexName(), usage.obj());
+            }
+        }
+
         // Not all indexes in the collection stats may be visible or consistent with our
         // snapshot. For this reason, it is unsafe to check `isReady` on the entry, which
         // asserts that the index's in-memory state is consistent with our snapshot.
@@ -157,6 +176,12 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
     result->append("indexDetails", indexDetails.obj());
     result->append("indexBuilds", indexBuilds);
 
+    if (cacheUsage) {
+        BSONObjBuilder bob(result->subobjStart("cacheUsage"));
+        bob.append("collection", collectionCacheUsage.obj());
+        bob.append("indexes", indexCacheUsage.obj());
+    }
+
     BSONObjBuilder indexSizes;
     long long indexSize = collection->getIndexSize(opCtx, &indexSizes, scale);
 
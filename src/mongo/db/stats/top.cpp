@@ -35,6 +35,7 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/util/processinfo.h"
 
 namespace mongo {
 
@@ -66,11 +67,56 @@ Top::CollectionData::CollectionData(const CollectionData& older, const Collectio
       remove(older.remove, newer.remove),
       commands(older.commands, newer.commands) {}
 
+void Top::CollectionData::add(const CollectionData& other) {
+    total.add(other.total);
+    readLock.add(other.readLock);
+    writeLock.add(other.writeLock);
+    queries.add(other.queries);
+    getmore.add(other.getmore);
+    insert.add(other.insert);
+    update.add(other.update);
+    remove.add(other.remove);
+    commands.add(other.commands);
+    opLatencyHistogram.add(other.opLatencyHistogram);
+}
+
 // static
 Top& Top::get(ServiceContext* service) {
     return getTop(service);
 }
 
+Top::Top() : _partitions(_makePartitions()) {}
+
+std::vector<std::unique_ptr<Top::Partition>> Top::_makePartitions() {
+    // One partition per core the process may run on. Every namespace can have an entry in every
+    // partition, so their number is capped.
+    auto numPartitions =
+        std::min(std::max(ProcessInfo::getNumAvailableCores(), 1UL), kMaxPartitions);
+    std::vector<std::unique_ptr<Partition>> partitions;
+    for (unsigned long i = 0; i < numPartitions; ++i) {
+        partitions.push_back(std::make_unique<Partition>());
+    }
+    return partitions;
+}
+
+Top::Partition& Top::_getPartitionForThisThread() {
+    // Threads are spread over the partitions in the order in which they first record usage.
+    static AtomicWord<unsigned> nextThreadIndex;
+    thread_local const unsigned threadIndex = nextThreadIndex.fetchAndAddRelaxed(1);
+    return *_partitions[threadIndex % _partitions.size()];
+}
+
+Top::UsageMap Top::_mergeUsage() const {
+    UsageMap merged;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition->lock);
+        for (auto&& [ns, coll] : partition->usage) {
+            merged[ns].add(coll);
+        }
+    }
+    return merged;
+}
+
 void Top::record(OperationContext* opCtx,
                  StringData ns,
                  LogicalOp logicalOp,
@@ -82,9 +128,10 @@ void Top::record(OperationContext* opCtx,
         return;
 
     auto hashedNs = UsageMap::hasher().hashed_key(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto& partition = _getPartitionForThisThread();
+    stdx::lock_guard<SimpleMutex> lk(partition.lock);
 
-    CollectionData& coll = _usage[hashedNs];
+    CollectionData& coll = partition.usage[hashedNs];
     _record(opCtx, coll, logicalOp, lockType, micros, readWriteType);
 }
 
@@ -134,18 +181,18 @@ void Top::_record(OperationContext* opCtx,
 }
 
 void Top::collectionDropped(const NamespaceString& nss) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(nss.ns());
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition->lock);
+        partition->usage.erase(nss.ns());
+    }
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out = _mergeUsage();
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    _appendToUsageMap(b, _mergeUsage());
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -190,9 +237,19 @@ void Top::appendLatencyStats(const NamespaceString& nss,
                              bool includeHistograms,
                              BSONObjBuilder* builder) {
     auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    OperationLatencyHistogram histogram;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition->lock);
+        // Like 'record', reading the statistics of a namespace makes it appear in the usage map.
+        // One entry per namespace is enough for that, so it only goes in the first partition.
+        if (partition == _partitions.front()) {
+            histogram.add(partition->usage[hashedNs].opLatencyHistogram);
+        } else if (auto it = partition->usage.find(hashedNs); it != partition->usage.end()) {
+            histogram.add(it->second.opLatencyHistogram);
+        }
+    }
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, false, &latencyStatsBuilder);
+    histogram.append(includeHistograms, false, &latencyStatsBuilder);
     builder->append("ns", nss.ns());
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
@@ -203,20 +260,26 @@ void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
     if (!opCtx->shouldIncrementLatencyStats())
         return;
 
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    auto& partition = _getPartitionForThisThread();
+    stdx::lock_guard<SimpleMutex> guard(partition.lock);
+    _incrementHistogram(opCtx, latency, &partition.globalHistogramStats, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms,
                                    bool slowMSBucketsOnly,
                                    BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder);
+    OperationLatencyHistogram globalHistogramStats;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> guard(partition->lock);
+        globalHistogramStats.add(partition->globalHistogramStats);
+    }
+    globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
+    auto& partition = _getPartitionForThisThread();
+    stdx::lock_guard<SimpleMutex> guard(partition.lock);
+    partition.globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
 void Top::_incrementHistogram(OperationContext* opCtx,
@@ -52,7 +52,7 @@ class Top {
 public:
     static Top& get(ServiceContext* service);
 
-    Top() = default;
+    Top();
 
     struct UsageData {
         UsageData() : time(0), count(0) {}
@@ -64,6 +64,11 @@ public:
             count++;
             time += micros;
         }
+
+        void add(const UsageData& other) {
+            count += other.count;
+            time += other.time;
+        }
     };
 
     struct CollectionData {
@@ -85,6 +90,11 @@ public:
         UsageData remove;
         UsageData commands;
         OperationLatencyHistogram opLatencyHistogram;
+
+        /**
+         * Adds the usage recorded in 'other' to this one.
+         */
+        void add(const CollectionData& other);
     };
 
     enum class LockType {
@@ -137,6 +147,28 @@ public:
                                   BSONObjBuilder* builder);
 
 private:
+    /**
+     * Usage is recorded into one of several partitions, each with its own mutex, so that threads
+     * finishing operations at the same time rarely contend. Every thread sticks to the partition
+     * it is first assigned to. The partitions are added together whenever the statistics are read.
+     */
+    struct Partition {
+        mutable SimpleMutex lock;
+        OperationLatencyHistogram globalHistogramStats;
+        UsageMap usage;
+    };
+
+    static constexpr unsigned long kMaxPartitions = 16;
+
+    static std::vector<std::unique_ptr<Partition>> _makePartitions();
+
+    Partition& _getPartitionForThisThread();
+
+    /**
+     * Returns the usage of every namespace, summed over all partitions.
+     */
+    UsageMap _mergeUsage() const;
+
     void _appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const;
 
     void _appendStatsEntry(BSONObjBuilder& b, const char* statsName, const UsageData& map) const;
@@ -153,9 +185,7 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
+    std::vector<std::unique_ptr<Partition>> _partitions;
 };
 
 }  // namespace mongo
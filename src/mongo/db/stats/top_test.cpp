@@ -29,7 +29,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
 #include "mongo/db/stats/top.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 namespace {
@@ -40,4 +43,28 @@ TEST(TopTest, CollectionDropped) {
     Top().collectionDropped(NamespaceString("test.coll"));
 }
 
+TEST(TopTest, GlobalLatencyStatsSumOverThreads) {
+    Top top;
+    const int kThreads = 8;
+    const int kIncrementsPerThread = 100;
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kIncrementsPerThread; ++j) {
+                top.incrementGlobalTransactionLatencyStats(10);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    BSONObjBuilder builder;
+    top.appendGlobalLatencyStats(false, false, &builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["transactions"]["ops"].Long(), kThreads * kIncrementsPerThread);
+    ASSERT_EQ(stats["transactions"]["latency"].Long(), kThreads * kIncrementsPerThread * 10);
+}
+
 }  // namespace
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_events.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+const auto getOperationWaitEvents = OperationContext::declareDecoration<WaitEventStats>();
+const auto getServiceWaitEvents = ServiceContext::declareDecoration<WaitEventStats>();
+}  // namespace
+
+StringData toStringData(WaitEvent event) {
+    switch (event) {
+        case WaitEvent::kTicketQueue:
+            return "ticketQueue"_sd;
+        case WaitEvent::kFlowControl:
+            return "flowControl"_sd;
+        case WaitEvent::kPrepareConflict:
+            return "prepareConflict"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+WaitEventStats& WaitEventStats::get(OperationContext* opCtx) {
+    return getOperationWaitEvents(opCtx);
+}
+
+WaitEventStats& WaitEventStats::get(ServiceContext* service) {
+    return getServiceWaitEvents(service);
+}
+
+void WaitEventStats::record(OperationContext* opCtx, WaitEvent event, Microseconds duration) {
+    get(opCtx)._add(event, duration);
+    get(opCtx->getServiceContext())._add(event, duration);
+}
+
+bool WaitEventStats::empty() const {
+    return std::all_of(_counters.begin(), _counters.end(), [](const Counters& counters) {
+        return counters.count.loadRelaxed() == 0;
+    });
+}
+
+void WaitEventStats::append(BSONObjBuilder* builder, bool includeAll) const {
+    for (size_t i = 0; i < kNumWaitEvents; ++i) {
+        auto event = static_cast<WaitEvent>(i);
+        auto count = getCount(event);
+        if (count == 0 && !includeAll) {
+            continue;
+        }
+        BSONObjBuilder eventBuilder(builder->subobjStart(toStringData(event)));
+        eventBuilder.append("count", count);
+        eventBuilder.append("timeMicros", durationCount<Microseconds>(getTime(event)));
+    }
+}
+
+void WaitEventStats::_add(WaitEvent event, Microseconds duration) {
+    auto& counters = _counters[static_cast<size_t>(event)];
+    counters.count.fetchAndAddRelaxed(1);
+    counters.micros.fetchAndAddRelaxed(durationCount<Microseconds>(duration));
+}
+
+}  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * The events which an operation can spend its time waiting on, other than locks. Lock waits are
+ * already reported per resource by the LockStats of each operation.
+ */
+enum class WaitEvent {
+    kTicketQueue,      // Queued for a storage engine read or write ticket.
+    kFlowControl,      // Queued for a flow control ticket.
+    kPrepareConflict,  // Waiting for a prepared transaction to commit or abort.
+};
+
+constexpr size_t kNumWaitEvents = 3;
+
+StringData toStringData(WaitEvent event);
+
+/**
+ * WaitEventStats counts how many times, and for how long, each wait event was waited on. Each
+ * operation has its own, which is reported in the slow query log, the profiler and $currentOp, and
+ * the node has one for all operations, which is reported in serverStatus.
+ *
+ * The subsystems which make an operation wait report it through ScopedWaitEvent, or through
+ * record() when they time the wait themselves.
+ */
+class WaitEventStats {
+public:
+    static WaitEventStats& get(OperationContext* opCtx);
+
+    /**
+     * Returns the totals of all operations of the node.
+     */
+    static WaitEventStats& get(ServiceContext* service);
+
+    /**
+     * Records that 'opCtx' waited on 'event' for 'duration'.
+     */
+    static void record(OperationContext* opCtx, WaitEvent event, Microseconds duration);
+
+    long long getCount(WaitEvent event) const {
+        return _counters[static_cast<size_t>(event)].count.loadRelaxed();
+    }
+
+    Microseconds getTime(WaitEvent event) const {
+        return Microseconds(_counters[static_cast<size_t>(event)].micros.loadRelaxed());
+    }
+
+    /**
+     * Returns true if no event was waited on.
+     */
+    bool empty() const;
+
+    /**
+     * Appends a {count, timeMicros} subobject per wait event. Events which were never waited on
+     * are omitted, unless 'includeAll' is true.
+     */
+    void append(BSONObjBuilder* builder, bool includeAll) const;
+
+private:
+    struct Counters {
+        AtomicWord<long long> count;
+        AtomicWord<long long> micros;
+    };
+
+    void _add(WaitEvent event, Microseconds duration);
+
+    // Atomic because those of an operation are read by $currentOp from other threads.
+    std::array<Counters, kNumWaitEvents> _counters;
+};
+
+/**
+ * Records the time from its construction to its destruction as a wait of 'opCtx' on 'event'. Does
+ * nothing if 'opCtx' is null.
+ */
+class ScopedWaitEvent {
+    ScopedWaitEvent(const ScopedWaitEvent&) = delete;
+    ScopedWaitEvent& operator=(const ScopedWaitEvent&) = delete;
+
+public:
+    ScopedWaitEvent(OperationContext* opCtx, WaitEvent event) : _opCtx(opCtx), _event(event) {}
+
+    ~ScopedWaitEvent() {
+        if (_opCtx) {
+            WaitEventStats::record(_opCtx, _event, Microseconds(_timer.micros()));
+        }
+    }
+
+private:
+    OperationContext* const _opCtx;
+    const WaitEvent _event;
+    Timer _timer;
+};
+
+}  // namespace mongo
@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_events.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class WaitEventsTest : public ServiceContextTest {};
+
+TEST_F(WaitEventsTest, RecordsIntoOperationAndNode) {
+    auto opCtx = makeOperationContext();
+    WaitEventStats::record(opCtx.get(), WaitEvent::kTicketQueue, Microseconds(10));
+    WaitEventStats::record(opCtx.get(), WaitEvent::kTicketQueue, Microseconds(5));
+
+    auto otherOpCtx = makeOperationContext();
+    WaitEventStats::record(otherOpCtx.get(), WaitEvent::kPrepareConflict, Microseconds(7));
+
+    const auto& opStats = WaitEventStats::get(opCtx.get());
+    ASSERT_EQ(opStats.getCount(WaitEvent::kTicketQueue), 2);
+    ASSERT_EQ(opStats.getTime(WaitEvent::kTicketQueue), Microseconds(15));
+    ASSERT_EQ(opStats.getCount(WaitEvent::kPrepareConflict), 0);
+
+    BSONObjBuilder opBuilder;
+    opStats.append(&opBuilder, false /* includeAll */);
+    ASSERT_BSONOBJ_EQ(opBuilder.obj(),
+                      BSON("ticketQueue" << BSON("count" << 2LL << "timeMicros" << 15LL)));
+
+    BSONObjBuilder nodeBuilder;
+    WaitEventStats::get(getServiceContext()).append(&nodeBuilder, true /* includeAll */);
+    ASSERT_BSONOBJ_EQ(nodeBuilder.obj(),
+                      BSON("ticketQueue" << BSON("count" << 2LL << "timeMicros" << 15LL)
+                                         << "flowControl"
+                                         << BSON("count" << 0LL << "timeMicros" << 0LL)
+                                         << "prepareConflict"
+                                         << BSON("count" << 1LL << "timeMicros" << 7LL)));
+}
+
+TEST_F(WaitEventsTest, ScopedWaitEventRecordsOneWait) {
+    auto opCtx = makeOperationContext();
+    ASSERT(WaitEventStats::get(opCtx.get()).empty());
+    { ScopedWaitEvent waitEvent(opCtx.get(), WaitEvent::kFlowControl); }
+    { ScopedWaitEvent waitEvent(nullptr, WaitEvent::kFlowControl); }
+    ASSERT_EQ(WaitEventStats::get(opCtx.get()).getCount(WaitEvent::kFlowControl), 1);
+    ASSERT_FALSE(WaitEventStats::get(opCtx.get()).empty());
+}
+
+}  // namespace
+}  // namespace mongo
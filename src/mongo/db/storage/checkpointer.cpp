@@ -33,9 +33,11 @@
 
 #include "mongo/db/storage/checkpointer.h"
 
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
@@ -48,6 +50,24 @@ const auto getCheckpointer = ServiceContext::declareDecoration<std::unique_ptr<C
 
 MONGO_FAIL_POINT_DEFINE(pauseCheckpointThread);
 
+class CheckpointerServerStatusSection : public ServerStatusSection {
+public:
+    CheckpointerServerStatusSection() : ServerStatusSection("checkpointer") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        if (auto checkpointer = Checkpointer::get(opCtx)) {
+            checkpointer->appendStats(&builder);
+        }
+        return builder.obj();
+    }
+} checkpointerServerStatusSection;
+
 }  // namespace
 
 Checkpointer* Checkpointer::get(ServiceContext* serviceCtx) {
@@ -71,28 +91,45 @@ void Checkpointer::run() {
     ThreadClient tc(name(), getGlobalServiceContext());
     LOGV2_DEBUG(22307, 1, "Starting thread", "threadName"_attr = name());
 
+    Date_t lastCheckpointEnd = Date_t::now();
     while (true) {
         auto opCtx = tc->makeOperationContext();
+        boost::optional<int64_t> dirtyBytes;
 
         {
             stdx::unique_lock<Latch> lock(_mutex);
             MONGO_IDLE_THREAD_BLOCK;
 
             // Wait for 'storageGlobalParams.checkpointDelaySecs' seconds; or until either shutdown
-            // is signaled or a checkpoint is triggered.
-            _sleepCV.wait_for(lock,
-                              stdx::chrono::seconds(static_cast<std::int64_t>(
-                                  storageGlobalParams.checkpointDelaySecs)),
-                              [&] { return _shuttingDown || _triggerCheckpoint; });
-
-            // If the checkpointDelaySecs is set to 0, that means we should skip checkpointing.
-            // However, checkpointDelaySecs is adjustable by a runtime server parameter, so we
-            // need to wake up to check periodically. The wakeup to check period is arbitrary.
-            while (storageGlobalParams.checkpointDelaySecs == 0 && !_shuttingDown &&
-                   !_triggerCheckpoint) {
-                _sleepCV.wait_for(lock, stdx::chrono::seconds(static_cast<std::int64_t>(3)), [&] {
-                    return _shuttingDown || _triggerCheckpoint;
-                });
+            // is signaled, a checkpoint is triggered, or the cache holds more dirty data than
+            // 'checkpointDirtyCacheTriggerMB'.
+            //
+            // If the checkpointDelaySecs is set to 0, that means we should skip checkpointing on
+            // an interval. However, both settings are adjustable by runtime server parameters, so
+            // we need to wake up to check periodically. The wakeup to check period is arbitrary.
+            const auto shouldWakeUp = [&] { return _shuttingDown || _triggerCheckpoint; };
+            while (!shouldWakeUp()) {
+                const auto delaySecs =
+                    static_cast<std::int64_t>(storageGlobalParams.checkpointDelaySecs);
+                const auto dirtyTriggerBytes = gCheckpointDirtyCacheTriggerMB.load() * 1024 * 1024;
+                const auto now = Date_t::now();
+                const auto nextCheckpoint = lastCheckpointEnd + Seconds(delaySecs);
+                if (delaySecs != 0 && now >= nextCheckpoint) {
+                    break;
+                }
+                if (dirtyTriggerBytes > 0) {
+                    dirtyBytes = _kvEngine->getCacheDirtyBytes();
+                    if (dirtyBytes && *dirtyBytes >= dirtyTriggerBytes) {
+                        _numDirtyCacheTriggered.fetchAndAdd(1);
+                        break;
+                    }
+                }
+
+                auto wakeUp = delaySecs == 0 ? now + Seconds(3) : nextCheckpoint;
+                if (dirtyTriggerBytes > 0) {
+                    wakeUp = std::min(wakeUp, now + Seconds(1));
+                }
+                _sleepCV.wait_until(lock, wakeUp.toSystemTimePoint(), shouldWakeUp);
             }
 
             if (_shuttingDown) {
@@ -111,12 +148,22 @@ void Checkpointer::run() {
 
         pauseCheckpointThread.pauseWhileSet();
 
+        if (!dirtyBytes) {
+            dirtyBytes = _kvEngine->getCacheDirtyBytes();
+        }
         const Date_t startTime = Date_t::now();
 
         // TODO SERVER-50861: Access the storage engine via the ServiceContext.
         _kvEngine->checkpoint();
 
-        const auto secondsElapsed = durationCount<Seconds>(Date_t::now() - startTime);
+        lastCheckpointEnd = Date_t::now();
+        const auto elapsed = lastCheckpointEnd - startTime;
+        _numCheckpoints.fetchAndAdd(1);
+        _lastDurationMillis.store(durationCount<Milliseconds>(elapsed));
+        _totalDurationMillis.fetchAndAdd(durationCount<Milliseconds>(elapsed));
+        _lastDirtyBytes.store(dirtyBytes.value_or(0));
+
+        const auto secondsElapsed = durationCount<Seconds>(elapsed);
         if (secondsElapsed >= 30) {
             LOGV2_DEBUG(22308,
                         1,
@@ -126,6 +173,14 @@ void Checkpointer::run() {
     }
 }
 
+void Checkpointer::appendStats(BSONObjBuilder* builder) const {
+    builder->append("checkpoints", _numCheckpoints.load());
+    builder->append("triggeredByDirtyCache", _numDirtyCacheTriggered.load());
+    builder->append("lastDurationMillis", _lastDurationMillis.load());
+    builder->append("totalDurationMillis", _totalDurationMillis.load());
+    builder->append("lastDirtyBytes", _lastDirtyBytes.load());
+}
+
 void Checkpointer::triggerFirstStableCheckpoint(Timestamp prevStable,
                                                 Timestamp initialData,
                                                 Timestamp currStable) {
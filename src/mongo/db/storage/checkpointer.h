@@ -29,12 +29,14 @@
 
 #pragma once
 
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/background.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class KVEngine;
 class OperationContext;
 class ServiceContext;
@@ -59,7 +61,9 @@ public:
     }
 
     /**
-     * Starts the checkpoint thread that runs every storageGlobalParams.checkpointDelaySecs seconds.
+     * Starts the checkpoint thread that runs every storageGlobalParams.checkpointDelaySecs seconds,
+     * and also whenever the storage engine cache holds more than checkpointDirtyCacheTriggerMB
+     * megabytes of dirty data.
      */
     void run() override;
 
@@ -87,6 +91,11 @@ public:
      */
     void shutdown(const Status& reason);
 
+    /**
+     * Appends the number and durations of the checkpoints taken so far, for serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
     // A pointer to the KVEngine is maintained only due to unit testing limitations that don't fully
     // setup the ServiceContext.
@@ -109,6 +118,14 @@ private:
 
     // This flag allows the checkpoint thread to wake up early when _sleepCV is signaled.
     bool _triggerCheckpoint;
+
+    // Statistics about the checkpoints taken, reported in serverStatus. '_lastDirtyBytes' holds the
+    // dirty bytes in the cache when the last checkpoint started.
+    AtomicWord<long long> _numCheckpoints{0};
+    AtomicWord<long long> _numDirtyCacheTriggered{0};
+    AtomicWord<long long> _lastDurationMillis{0};
+    AtomicWord<long long> _totalDurationMillis{0};
+    AtomicWord<long long> _lastDirtyBytes{0};
 };
 
 }  // namespace mongo
@@ -146,7 +146,7 @@ FlowControl::FlowControl(ServiceContext* service, repl::ReplicationCoordinator*
     _jobAnchor = service->getPeriodicRunner()->makeJob(
         {"FlowControlRefresher",
          [this](Client* client) {
-             FlowControlTicketholder::get(client->getServiceContext())->refreshTo(getNumTickets());
+             _refreshTickets(FlowControlTicketholder::get(client->getServiceContext()));
          },
          Seconds(1)});
     _jobAnchor.start();
@@ -222,9 +222,68 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
 
+    if (gFlowControlThrottleBySource.load()) {
+        stdx::lock_guard<Latch> lk(_throttledSourcesMutex);
+        BSONObjBuilder sourcesBuilder(bob.subobjStart("throttledSources"));
+        for (const auto& [source, throttle] : _throttledSources) {
+            BSONObjBuilder sourceBuilder(sourcesBuilder.subobjStart(source));
+            sourceBuilder.append("acquiredLastPeriod", throttle.acquiredLastPeriod);
+            sourceBuilder.append("ticketLimit", throttle.ticketLimit);
+        }
+    }
+
     return bob.obj();
 }
 
+void FlowControl::_refreshTickets(FlowControlTicketholder* ticketholder) {
+    const int numTickets = getNumTickets();
+    const bool throttleBySource = gFlowControlThrottleBySource.load();
+    ticketholder->setTrackSources(throttleBySource);
+    if (!throttleBySource) {
+        ticketholder->refreshTo(numTickets);
+        stdx::lock_guard<Latch> lk(_throttledSourcesMutex);
+        _throttledSources.clear();
+        return;
+    }
+    ticketholder->refreshTo(
+        numTickets, _calculateSourceLimits(numTickets, ticketholder->takeAcquisitionsBySource()));
+}
+
+StringMap<int> FlowControl::_calculateSourceLimits(
+    int numTickets, const StringMap<std::int64_t>& acquisitionsBySource) {
+    std::int64_t totalAcquisitions = 0;
+    for (const auto& [source, acquisitions] : acquisitionsBySource) {
+        totalAcquisitions += acquisitions;
+    }
+
+    StringMap<int> limits;
+    std::map<std::string, SourceThrottle> throttledSources;
+    const double maxShare = gFlowControlSourceMaxShare.load();
+    if (numTickets < kMaxTickets && totalAcquisitions > 0) {
+        for (const auto& [source, acquisitions] : acquisitionsBySource) {
+            if (static_cast<double>(acquisitions) / totalAcquisitions <= maxShare) {
+                continue;
+            }
+            // Leave at least one ticket so that the source still makes progress.
+            const int limit =
+                std::max(1, multiplyWithOverflowCheck(numTickets, maxShare, numTickets));
+            limits[source] = limit;
+            throttledSources[source] = {acquisitions, limit};
+            LOGV2_DEBUG(6104000,
+                        DEBUG_LOG_LEVEL,
+                        "Flow control is limiting the tickets of a source",
+                        "source"_attr = source,
+                        "acquiredLastPeriod"_attr = acquisitions,
+                        "totalAcquiredLastPeriod"_attr = totalAcquisitions,
+                        "ticketLimit"_attr = limit);
+        }
+    }
+
+    stdx::lock_guard<Latch> lk(_throttledSourcesMutex);
+    _throttledSources = std::move(throttledSources);
+    return limits;
+}
+
 void FlowControl::disableUntil(Date_t deadline) {
     _disableUntil.store(deadline);
 }
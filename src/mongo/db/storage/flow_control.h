@@ -30,6 +30,7 @@
 #pragma once
 
 #include <deque>
+#include <map>
 
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
@@ -38,9 +39,12 @@
 #include "mongo/db/service_context.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
+class FlowControlTicketholder;
+
 /**
  * This class encapsulates (most) logic relating to throttling incoming writes when a primary
  * discovers the commit point is lagging behind. The only method exposed to the system for
@@ -134,6 +138,14 @@ public:
                                    std::uint64_t thresholdLagMillis);
     void _trimSamples(const Timestamp trimSamplesTo);
 
+    /**
+     * Returns the ticket limit of each source that acquired more than `flowControlSourceMaxShare`
+     * of the tickets last period, given the `numTickets` handed out for the next period. Sources
+     * are only limited while flow control hands out fewer than the maximum number of tickets.
+     */
+    StringMap<int> _calculateSourceLimits(int numTickets,
+                                          const StringMap<std::int64_t>& acquisitionsBySource);
+
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
     // observations of the corresponding counter at (roughly) <timestamp>.
     typedef std::tuple<std::uint64_t, std::uint64_t, std::int64_t> Sample;
@@ -142,6 +154,16 @@ public:
     }
 
 private:
+    struct SourceThrottle {
+        std::int64_t acquiredLastPeriod = 0;
+        int ticketLimit = 0;
+    };
+
+    /**
+     * Refreshes the tickets of `ticketholder` for the next period.
+     */
+    void _refreshTickets(FlowControlTicketholder* ticketholder);
+
     repl::ReplicationCoordinator* _replCoord;
 
     // These values are updated with each flow control computation and are also surfaced in server
@@ -155,6 +177,10 @@ private:
     AtomicWord<std::int64_t> _isLaggedTimeMicros{0};
     AtomicWord<Date_t> _disableUntil;
 
+    // The sources limited in the current period, surfaced in server status.
+    mutable Mutex _throttledSourcesMutex = MONGO_MAKE_LATCH("FlowControl::_throttledSourcesMutex");
+    std::map<std::string, SourceThrottle> _throttledSources;
+
     mutable Mutex _sampledOpsMutex = MONGO_MAKE_LATCH("FlowControl::_sampledOpsMutex");
     std::deque<Sample> _sampledOpsApplied;
 
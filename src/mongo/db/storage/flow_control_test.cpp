@@ -40,6 +40,7 @@
 #include "mongo/db/storage/flow_control_parameters_gen.h"
 #include "mongo/logv2/log_debug.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -286,4 +287,59 @@ TEST_F(FlowControlTest, DisableUntil) {
     // After the deadline passes, the override should take effect.
     ASSERT_EQ(ticketOverride, flowControl->getNumTickets(reenabled));
 }
+
+TEST_F(FlowControlTest, CalculatingSourceLimits) {
+    const double maxShare = gFlowControlSourceMaxShare.load();
+    ON_BLOCK_EXIT([&] { gFlowControlSourceMaxShare.store(maxShare); });
+    gFlowControlSourceMaxShare.store(0.5);
+
+    StringMap<std::int64_t> acquisitions{{"heavy", 800}, {"light", 200}};
+    auto limits = flowControl->_calculateSourceLimits(1000, acquisitions);
+    ASSERT_EQ(1U, limits.size());
+    ASSERT_EQ(500, limits["heavy"]);
+
+    // No source is limited while flow control is not throttling.
+    ASSERT(flowControl->_calculateSourceLimits(FlowControl::kMaxTickets, acquisitions).empty());
+
+    // A source is left at least one ticket.
+    limits = flowControl->_calculateSourceLimits(1, acquisitions);
+    ASSERT_EQ(1, limits["heavy"]);
+
+    // Sources with an even share of the tickets are not limited.
+    acquisitions = {{"a", 500}, {"b", 500}};
+    ASSERT(flowControl->_calculateSourceLimits(1000, acquisitions).empty());
+}
+
+TEST_F(FlowControlTest, TicketholderLimitsSource) {
+    auto ticketholder = FlowControlTicketholder::get(getServiceContext());
+    ticketholder->setTrackSources(true);
+    ticketholder->refreshTo(3, {{"heavy", 1}});
+
+    FlowControlTicketholder::CurOp stats;
+    FlowControlTicketholder::setSource(opCtx.get(), "heavy");
+    ticketholder->getTicket(opCtx.get(), &stats);
+    ASSERT_EQ(1, stats.ticketsAcquired);
+
+    // The limited source has used up its tickets, while the others can take the rest.
+    auto otherClient = getServiceContext()->makeClient("FlowControl other Client");
+    auto otherOpCtx = otherClient->makeOperationContext();
+    FlowControlTicketholder::setSource(otherOpCtx.get(), "light");
+    FlowControlTicketholder::CurOp otherStats;
+    ticketholder->getTicket(otherOpCtx.get(), &otherStats);
+    ticketholder->getTicket(otherOpCtx.get(), &otherStats);
+    ASSERT_EQ(2, otherStats.ticketsAcquired);
+
+    ticketholder->refreshTo(3, {{"heavy", 1}});
+    ticketholder->getTicket(opCtx.get(), &stats);
+    opCtx->setDeadlineAfterNowBy(Milliseconds(10), ErrorCodes::ExceededTimeLimit);
+    ASSERT_THROWS_CODE(ticketholder->getTicket(opCtx.get(), &stats),
+                       DBException,
+                       ErrorCodes::ExceededTimeLimit);
+    ASSERT_EQ(2, stats.ticketsAcquired);
+
+    auto acquisitions = ticketholder->takeAcquisitionsBySource();
+    ASSERT_EQ(2, acquisitions["heavy"]);
+    ASSERT_EQ(2, acquisitions["light"]);
+    ASSERT(ticketholder->takeAcquisitionsBySource().empty());
+}
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/key_string.h"
 
+#include <algorithm>
 #include <cmath>
 #include <type_traits>
 
@@ -248,6 +249,15 @@ void memcpy_flipBits(void* dst, const void* src, size_t bytes) {
     const char* input = static_cast<const char*>(src);
     char* output = static_cast<char*>(dst);
     const char* const end = input + bytes;
+
+    // Flip a word at a time, then finish off the tail byte by byte.
+    for (; end - input >= static_cast<ptrdiff_t>(sizeof(uint64_t));
+         input += sizeof(uint64_t), output += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, input, sizeof(word));
+        word = ~word;
+        memcpy(output, &word, sizeof(word));
+    }
     while (input != end) {
         *output++ = ~(*input++);
     }
@@ -262,6 +272,23 @@ T readType(BufReader* reader, bool inverted) {
     return t;
 }
 
+/**
+ * Reads the next 'bytes' bytes, at most 8, as a big endian unsigned integer. This replaces reading
+ * and shifting in one byte at a time.
+ */
+uint64_t readBigEndianUnsigned(BufReader* reader, size_t bytes, bool inverted) {
+    dassert(bytes <= sizeof(uint64_t));
+    uint64_t value = 0;
+    memcpy(reinterpret_cast<char*>(&value + 1) - bytes, reader->skip(bytes), bytes);
+    value = endian::bigToNative(value);
+    if (inverted) {
+        const uint64_t usedBits =
+            bytes == sizeof(uint64_t) ? ~0ULL : (1ULL << (bytes * 8)) - 1;
+        value ^= usedBits;
+    }
+    return value;
+}
+
 StringData readCString(BufReader* reader) {
     const char* start = static_cast<const char*>(reader->pos());
     const char* end = static_cast<const char*>(memchr(start, 0x0, reader->remaining()));
@@ -1217,17 +1244,18 @@ void BuilderBase<BufferT>::_appendPreshiftedIntegerPortion(uint64_t value,
 
     const size_t bytesNeeded = (64 - countLeadingZeros64(value) + 7) / 8;
 
-    // Append the low bytes of value in big endian order.
-    value = endian::nativeToBig(value);
-    const void* firstUsedByte = reinterpret_cast<const char*>((&value) + 1) - bytesNeeded;
+    _append(isNegative ? uint8_t(CType::kNumericNegative1ByteInt - (bytesNeeded - 1))
+                       : uint8_t(CType::kNumericPositive1ByteInt + (bytesNeeded - 1)),
+            invert);
 
-    if (isNegative) {
-        _append(uint8_t(CType::kNumericNegative1ByteInt - (bytesNeeded - 1)), invert);
-        _appendBytes(firstUsedByte, bytesNeeded, !invert);
-    } else {
-        _append(uint8_t(CType::kNumericPositive1ByteInt + (bytesNeeded - 1)), invert);
-        _appendBytes(firstUsedByte, bytesNeeded, invert);
+    // Append the low bytes of value in big endian order. Flipping the whole word up front avoids
+    // the byte-wise loop in _appendBytes().
+    value = endian::nativeToBig(value);
+    if (isNegative != invert) {
+        value = ~value;
     }
+    const void* firstUsedByte = reinterpret_cast<const char*>((&value) + 1) - bytesNeeded;
+    memcpy(_buffer().skip(bytesNeeded), firstUsedByte, bytesNeeded);
 }
 
 
@@ -1753,14 +1781,8 @@ void toBsonValue(uint8_t ctype,
         case CType::kNumericPositive8ByteInt: {
             const uint8_t originalType = typeBits->readNumeric();
 
-            uint64_t encodedIntegerPart = 0;
-            {
-                size_t intBytesRemaining = CType::numBytesForInt(ctype);
-                while (intBytesRemaining--) {
-                    encodedIntegerPart =
-                        (encodedIntegerPart << 8) | readType<uint8_t>(reader, inverted);
-                }
-            }
+            const uint64_t encodedIntegerPart =
+                readBigEndianUnsigned(reader, CType::numBytesForInt(ctype), inverted);
 
             const bool haveFractionalPart = (encodedIntegerPart & 1);
             int64_t integerPart = encodedIntegerPart >> 1;
@@ -1808,11 +1830,8 @@ void toBsonValue(uint8_t ctype,
                 if (isNegative) {
                     doubleBits |= (1ULL << 63);  // sign bit
                 }
-                for (size_t i = 0; i < fractionalBytes; i++) {
-                    // fold in the fractional bytes
-                    const uint64_t byte = readType<uint8_t>(reader, inverted);
-                    doubleBits |= (byte << ((fractionalBytes - i - 1) * 8));
-                }
+                // fold in the fractional bytes
+                doubleBits |= readBigEndianUnsigned(reader, fractionalBytes, inverted);
 
                 double number;
                 memcpy(&number, &doubleBits, sizeof(number));
@@ -1823,10 +1842,8 @@ void toBsonValue(uint8_t ctype,
             // KeyString V1: all numeric values with fractions have at least 8 bytes.
             // Start with integer part, and read until we have a full 8 bytes worth of data.
             const size_t fracBytes = 8 - CType::numBytesForInt(ctype);
-            uint64_t encodedFraction = integerPart;
-
-            for (int fracBytesRemaining = fracBytes; fracBytesRemaining; fracBytesRemaining--)
-                encodedFraction = (encodedFraction << 8) | readType<uint8_t>(reader, inverted);
+            const uint64_t encodedFraction = (uint64_t(integerPart) << (fracBytes * 8)) |
+                readBigEndianUnsigned(reader, fracBytes, inverted);
 
             // Zero out the DCM and convert the whole binary fraction
             double bin = static_cast<double>(encodedFraction & ~3ULL) * kInvPow256[fracBytes];
@@ -2088,14 +2105,8 @@ void filterKeyFromKeyString(uint8_t ctype, BufReader* reader, bool inverted, Ver
         case CType::kNumericPositive6ByteInt:
         case CType::kNumericPositive7ByteInt:
         case CType::kNumericPositive8ByteInt: {
-            uint64_t encodedIntegerPart = 0;
-            {
-                size_t intBytesRemaining = CType::numBytesForInt(ctype);
-                while (intBytesRemaining--) {
-                    encodedIntegerPart =
-                        (encodedIntegerPart << 8) | readType<uint8_t>(reader, inverted);
-                }
-            }
+            const uint64_t encodedIntegerPart =
+                readBigEndianUnsigned(reader, CType::numBytesForInt(ctype), inverted);
 
             const bool haveFractionalPart = (encodedIntegerPart & 1);
             int64_t integerPart = encodedIntegerPart >> 1;
@@ -2120,10 +2131,8 @@ void filterKeyFromKeyString(uint8_t ctype, BufReader* reader, bool inverted, Ver
             // KeyString V1: all numeric values with fractions have at least 8 bytes.
             // Start with integer part, and read until we have a full 8 bytes worth of data.
             const size_t fracBytes = 8 - CType::numBytesForInt(ctype);
-            uint64_t encodedFraction = integerPart;
-
-            for (int fracBytesRemaining = fracBytes; fracBytesRemaining; fracBytesRemaining--)
-                encodedFraction = (encodedFraction << 8) | readType<uint8_t>(reader, inverted);
+            const uint64_t encodedFraction = (uint64_t(integerPart) << (fracBytes * 8)) |
+                readBigEndianUnsigned(reader, fracBytes, inverted);
 
             // The two lsb's are the DCM, except for the 8-byte case, where it's already known
             DecimalContinuationMarker dcm = fracBytes
@@ -2640,6 +2649,82 @@ void Value::serializeWithoutRecordIdLong(BufBuilder& buf) const {
     buf.appendBuf(_buffer.get() + _ksSize, _buffer.size() - _ksSize);  // Serialize TypeBits
 }
 
+namespace {
+
+void appendVarUInt32(BufBuilder& buf, uint32_t value) {
+    while (value >= 0x80) {
+        buf.appendUChar(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buf.appendUChar(static_cast<unsigned char>(value));
+}
+
+uint32_t readVarUInt32(BufReader& reader) {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        const uint8_t byte = reader.read<uint8_t>();
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    uasserted(6101700, "Invalid length in front-coded KeyString run");
+}
+
+}  // namespace
+
+void FrontCodedBuilder::append(const Value& key) {
+    invariant(key.getVersion() == _version);
+
+    const char* keyBuffer = key.getBuffer();
+    const size_t keySize = key.getSize();
+    const size_t maxShared = std::min(keySize, _previousKey.size());
+    const size_t shared =
+        std::mismatch(keyBuffer, keyBuffer + maxShared, _previousKey.data()).first - keyBuffer;
+
+    appendVarUInt32(_buffer, shared);
+    appendVarUInt32(_buffer, keySize - shared);
+    _buffer.appendBuf(keyBuffer + shared, keySize - shared);
+
+    auto typeBits = key.getTypeBits();
+    if (typeBits.isAllZeros()) {
+        _buffer.appendChar(0);
+    } else {
+        _buffer.appendBuf(typeBits.getBuffer(), typeBits.getSize());
+    }
+
+    _previousKey.assign(keyBuffer, keySize);
+    _numKeys++;
+}
+
+boost::optional<Value> FrontCodedReader::next() {
+    if (_reader.atEof()) {
+        return boost::none;
+    }
+
+    const uint32_t shared = readVarUInt32(_reader);
+    const uint32_t suffixSize = readVarUInt32(_reader);
+    uassert(6101701,
+            "Front-coded KeyString shares more bytes than the previous key holds",
+            shared <= _previousKey.size());
+    const char* suffix = static_cast<const char*>(_reader.skip(suffixSize));
+
+    _previousKey.resize(shared);
+    _previousKey.append(suffix, suffixSize);
+
+    BufBuilder newBuf;
+    newBuf.appendBuf(_previousKey.data(), _previousKey.size());
+    auto typeBits = TypeBits::fromBuffer(_version, &_reader);
+    if (typeBits.isAllZeros()) {
+        newBuf.appendChar(0);
+    } else {
+        newBuf.appendBuf(typeBits.getBuffer(), typeBits.getSize());
+    }
+
+    const int32_t ksSize = _previousKey.size();
+    return Value(_version, ksSize, SharedBufferFragment(newBuf.release(), newBuf.len()));
+}
+
 template class BuilderBase<Builder>;
 template class BuilderBase<HeapBuilder>;
 template class BuilderBase<PooledBuilder>;
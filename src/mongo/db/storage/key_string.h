@@ -45,6 +45,7 @@
 #include "mongo/util/assert_util.h"
 
 #include <boost/container/flat_set.hpp>
+#include <boost/optional.hpp>
 
 namespace mongo {
 
@@ -441,6 +442,57 @@ private:
     SharedBufferFragment _buffer;
 };
 
+/**
+ * Front-codes a run of KeyString Values into a single buffer: each key is stored as the length of
+ * the prefix it shares with the previously appended key, followed by the rest of its bytes and its
+ * TypeBits. Keys of compound indexes with long leading fields that repeat across neighbouring keys,
+ * such as a tenant id followed by a type, shrink to little more than their distinct suffixes.
+ * Any order is accepted, but only keys appended in ascending order share meaningful prefixes.
+ */
+class FrontCodedBuilder {
+public:
+    explicit FrontCodedBuilder(Version version) : _version(version) {}
+
+    void append(const Value& key);
+
+    size_t numKeys() const {
+        return _numKeys;
+    }
+
+    // Returns the number of bytes the encoded run occupies.
+    int size() const {
+        return _buffer.len();
+    }
+
+    const char* getBuffer() const {
+        return _buffer.buf();
+    }
+
+private:
+    const Version _version;
+    BufBuilder _buffer;
+    std::string _previousKey;
+    size_t _numKeys = 0;
+};
+
+/**
+ * Decodes, in order, the keys of a run encoded by FrontCodedBuilder. The Version must match the
+ * one the run was built with.
+ */
+class FrontCodedReader {
+public:
+    FrontCodedReader(Version version, const char* buffer, size_t size)
+        : _version(version), _reader(buffer, size) {}
+
+    // Returns boost::none once every key has been read.
+    boost::optional<Value> next();
+
+private:
+    const Version _version;
+    BufReader _reader;
+    std::string _previousKey;
+};
+
 enum class Discriminator {
     kInclusive,  // Anything to be stored in an index must use this.
     kExclusiveBefore,
@@ -33,6 +33,7 @@
 
 #include <benchmark/benchmark.h>
 #include <random>
+#include <string>
 #include <vector>
 
 #include "mongo/db/storage/key_string.h"
@@ -48,6 +49,7 @@ const int kStrLenMultiplier = 100;
 const int kArrLenMultiplier = 40;
 
 const Ordering ALL_ASCENDING = Ordering::make(BSONObj());
+const Ordering ALL_DESCENDING = Ordering::make(BSON("a" << -1));
 
 struct BsonsAndKeyStrings {
     int bsonSize = 0;
@@ -97,13 +99,14 @@ BSONObj generateBson(BsonValueType bsonValueType) {
 }
 
 static BsonsAndKeyStrings generateBsonsAndKeyStrings(BsonValueType bsonValueType,
-                                                     KeyString::Version version) {
+                                                     KeyString::Version version,
+                                                     Ordering ordering = ALL_ASCENDING) {
     BsonsAndKeyStrings result;
     result.bsonSize = 0;
     result.keystringSize = 0;
     for (int i = 0; i < kSampleSize; i++) {
         BSONObj bson = generateBson(bsonValueType);
-        KeyString::Builder ks(version, bson, ALL_ASCENDING);
+        KeyString::Builder ks(version, bson, ordering);
         result.bsonSize += bson.objsize();
         result.keystringSize += ks.getSize();
         result.bsons[i] = bson;
@@ -121,12 +124,14 @@ static BsonsAndKeyStrings generateBsonsAndKeyStrings(BsonValueType bsonValueType
 
 void BM_BSONToKeyString(benchmark::State& state,
                         const KeyString::Version version,
-                        BsonValueType bsonType) {
-    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+                        BsonValueType bsonType,
+                        Ordering ordering = ALL_ASCENDING) {
+    const BsonsAndKeyStrings bsonsAndKeyStrings =
+        generateBsonsAndKeyStrings(bsonType, version, ordering);
     for (auto _ : state) {
         benchmark::ClobberMemory();
         for (auto bson : bsonsAndKeyStrings.bsons) {
-            benchmark::DoNotOptimize(KeyString::Builder(version, bson, ALL_ASCENDING));
+            benchmark::DoNotOptimize(KeyString::Builder(version, bson, ordering));
         }
     }
     state.SetBytesProcessed(state.iterations() * bsonsAndKeyStrings.bsonSize);
@@ -135,8 +140,10 @@ void BM_BSONToKeyString(benchmark::State& state,
 
 void BM_KeyStringToBSON(benchmark::State& state,
                         const KeyString::Version version,
-                        BsonValueType bsonType) {
-    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+                        BsonValueType bsonType,
+                        Ordering ordering = ALL_ASCENDING) {
+    const BsonsAndKeyStrings bsonsAndKeyStrings =
+        generateBsonsAndKeyStrings(bsonType, version, ordering);
     for (auto _ : state) {
         benchmark::ClobberMemory();
         for (size_t i = 0; i < kSampleSize; i++) {
@@ -144,7 +151,7 @@ void BM_KeyStringToBSON(benchmark::State& state,
             benchmark::DoNotOptimize(
                 KeyString::toBson(bsonsAndKeyStrings.keystrings[i].get(),
                                   bsonsAndKeyStrings.keystringLens[i],
-                                  ALL_ASCENDING,
+                                  ordering,
                                   KeyString::TypeBits::fromBuffer(version, &buf)));
         }
     }
@@ -207,6 +214,58 @@ void BM_KeyStringStackBuilderCopy(benchmark::State& state, BsonValueType bsonTyp
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+// Compound keys shaped like {tenant, type, timestamp}, in index order, so that neighbouring keys
+// share long prefixes.
+std::vector<KeyString::Value> generateCompoundKeys(KeyString::Version version) {
+    std::vector<KeyString::Value> keys;
+    for (int i = 0; i < kSampleSize; i++) {
+        BSONObj bson = BSON("" << ("tenant-" + std::to_string(i / 100)) << ""
+                               << (i % 100 < 50 ? "invoice" : "receipt") << ""
+                               << Date_t::fromMillisSinceEpoch(i));
+        keys.push_back(KeyString::Builder(version, bson, ALL_ASCENDING).getValueCopy());
+    }
+    return keys;
+}
+
+void BM_KeyStringFrontCode(benchmark::State& state, const KeyString::Version version) {
+    const auto keys = generateCompoundKeys(version);
+    int fullSize = 0;
+    int frontCodedSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        KeyString::FrontCodedBuilder builder(version);
+        for (auto&& key : keys) {
+            builder.append(key);
+        }
+        frontCodedSize = builder.size();
+        benchmark::DoNotOptimize(builder.getBuffer());
+    }
+    for (auto&& key : keys) {
+        BufBuilder buf;
+        key.serialize(buf);
+        fullSize += buf.len();
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+    state.counters["fullBytesPerKey"] = double(fullSize) / kSampleSize;
+    state.counters["frontCodedBytesPerKey"] = double(frontCodedSize) / kSampleSize;
+}
+
+void BM_KeyStringFrontDecode(benchmark::State& state, const KeyString::Version version) {
+    const auto keys = generateCompoundKeys(version);
+    KeyString::FrontCodedBuilder builder(version);
+    for (auto&& key : keys) {
+        builder.append(key);
+    }
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        KeyString::FrontCodedReader reader(version, builder.getBuffer(), builder.size());
+        while (auto key = reader.next()) {
+            benchmark::DoNotOptimize(key);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+}
+
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Decimal, DECIMAL);
@@ -234,6 +293,11 @@ BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Array, KeyString::Version::V1, ARRAY);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Int_Desc, KeyString::Version::V1, INT, ALL_DESCENDING);
+BENCHMARK_CAPTURE(
+    BM_BSONToKeyString, V1_Double_Desc, KeyString::Version::V1, DOUBLE, ALL_DESCENDING);
+BENCHMARK_CAPTURE(
+    BM_BSONToKeyString, V1_String_Desc, KeyString::Version::V1, STRING, ALL_DESCENDING);
 
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Int, KeyString::Version::V1, INT);
@@ -244,6 +308,14 @@ BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Array, KeyString::Version::V1, ARRAY);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Int_Desc, KeyString::Version::V1, INT, ALL_DESCENDING);
+BENCHMARK_CAPTURE(
+    BM_KeyStringToBSON, V1_Double_Desc, KeyString::Version::V1, DOUBLE, ALL_DESCENDING);
+BENCHMARK_CAPTURE(
+    BM_KeyStringToBSON, V1_String_Desc, KeyString::Version::V1, STRING, ALL_DESCENDING);
+
+BENCHMARK_CAPTURE(BM_KeyStringFrontCode, V1_Compound, KeyString::Version::V1);
+BENCHMARK_CAPTURE(BM_KeyStringFrontDecode, V1_Compound, KeyString::Version::V1);
 
 }  // namespace
 }  // namespace mongo
@@ -505,6 +505,24 @@ TEST_F(KeyStringBuilderTest, NumbersNearInt32Max) {
     }
 }
 
+TEST_F(KeyStringBuilderTest, IntegersOfEveryEncodedWidth) {
+    // Integers are encoded with between 1 and 8 bytes for their magnitude. Cover both ends of each
+    // width, with and without a fractional part, in both orderings and signs.
+    for (int bytes = 1; bytes <= 8; bytes++) {
+        // The magnitude is shifted left by one bit to make room for the fractional part flag.
+        const long long largest = (1ULL << (bytes * 8 - 1)) - 1;
+        const long long smallest = (largest >> 8) + 1;
+        for (const long long magnitude : {smallest, largest}) {
+            for (const long long num : {magnitude, -magnitude}) {
+                ROUNDTRIP(version, BSON("" << num));
+                if (magnitude < (1LL << 52)) {
+                    ROUNDTRIP(version, BSON("" << static_cast<double>(num) + 0.5));
+                }
+            }
+        }
+    }
+}
+
 TEST_F(KeyStringBuilderTest, DecimalNumbers) {
     if (version == KeyString::Version::V0) {
         LOGV2(22228, "not testing DecimalNumbers for KeyStringBuilder V0");
@@ -640,6 +658,44 @@ TEST_F(KeyStringBuilderTest, KeyStringGetValueCopyTest) {
     COMPARE_KS_BSON(data2, BSON("" << 1), ALL_ASCENDING);
 }
 
+TEST_F(KeyStringBuilderTest, FrontCodedRunRoundTrips) {
+    // Keys sharing long leading fields, with doubles mixed in so that some keys carry TypeBits.
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 50; i++) {
+        BSONObjBuilder bob;
+        bob.append("", "tenant-0000000042");
+        bob.append("", i < 25 ? "invoice" : "receipt");
+        if (i % 2) {
+            bob.append("", i);
+        } else {
+            bob.append("", i + 0.5);
+        }
+        docs.push_back(bob.obj());
+    }
+
+    KeyString::FrontCodedBuilder builder(version);
+    int fullSize = 0;
+    for (auto&& doc : docs) {
+        KeyString::Value key = KeyString::Builder(version, doc, ALL_ASCENDING).getValueCopy();
+        BufBuilder serialized;
+        key.serialize(serialized);
+        fullSize += serialized.len();
+        builder.append(key);
+    }
+    ASSERT_EQ(docs.size(), builder.numKeys());
+    ASSERT_LT(builder.size(), fullSize / 2);
+
+    KeyString::FrontCodedReader reader(version, builder.getBuffer(), builder.size());
+    for (auto&& doc : docs) {
+        auto key = reader.next();
+        ASSERT(key);
+        auto expected = KeyString::Builder(version, doc, ALL_ASCENDING).getValueCopy();
+        ASSERT_EQ(0, key->compareWithTypeBits(expected));
+        COMPARE_KS_BSON(*key, doc, ALL_ASCENDING);
+    }
+    ASSERT_FALSE(reader.next());
+}
+
 TEST_F(KeyStringBuilderTest, KeyStringBuilderAppendBsonElement) {
     // Test that appendBsonElement works.
     {
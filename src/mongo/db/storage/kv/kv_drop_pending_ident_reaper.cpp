@@ -35,13 +35,35 @@
 
 #include <algorithm>
 
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/ident.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
+namespace {
+
+// The number of idents waiting to be dropped, how many were dropped and how long the storage
+// engine took to drop them, and how many passes were deferred because a checkpoint was running.
+Counter64 queuedDropPendingIdents;
+ServerStatusMetricField<Counter64> displayQueuedDropPendingIdents(
+    "storage.dropPendingIdents.queued", &queuedDropPendingIdents);
+TimerStats dropPendingIdentsDropStats;
+ServerStatusMetricField<TimerStats> displayDropPendingIdentsDrops(
+    "storage.dropPendingIdents.drops", &dropPendingIdentsDropStats);
+Counter64 dropPendingIdentsDeferredForCheckpoint;
+ServerStatusMetricField<Counter64> displayDropPendingIdentsDeferredForCheckpoint(
+    "storage.dropPendingIdents.passesDeferredForCheckpoint",
+    &dropPendingIdentsDeferredForCheckpoint);
+
+}  // namespace
+
 KVDropPendingIdentReaper::KVDropPendingIdentReaper(KVEngine* engine) : _engine(engine) {}
 
 void KVDropPendingIdentReaper::addDropPendingIdent(const Timestamp& dropTimestamp,
@@ -58,6 +80,7 @@ void KVDropPendingIdentReaper::addDropPendingIdent(const Timestamp& dropTimestam
         info.dropToken = ident;
         info.onDrop = std::move(onDrop);
         _dropPendingIdents.insert(std::make_pair(dropTimestamp, info));
+        queuedDropPendingIdents.increment();
     } else {
         LOGV2_FATAL_NOTRACE(51023,
                             "Failed to add drop-pending ident, duplicate timestamp and ident pair",
@@ -87,11 +110,13 @@ std::set<std::string> KVDropPendingIdentReaper::getAllIdentNames() const {
 }
 
 void KVDropPendingIdentReaper::dropIdentsOlderThan(OperationContext* opCtx, const Timestamp& ts) {
+    const size_t maxDrops = gDropPendingIdentReaperMaxDropsPerPass.load();
     DropPendingIdents toDrop;
     {
         stdx::lock_guard<Latch> lock(_mutex);
         for (auto it = _dropPendingIdents.cbegin();
-             it != _dropPendingIdents.cend() && (it->first < ts || it->first == Timestamp::min());
+             it != _dropPendingIdents.cend() && (it->first < ts || it->first == Timestamp::min()) &&
+             (maxDrops == 0 || toDrop.size() < maxDrops);
              ++it) {
             // This collection/index satisfies the 'ts' requirement to be safe to drop, but we must
             // also check that there are no active operations remaining that still retain a
@@ -106,6 +131,17 @@ void KVDropPendingIdentReaper::dropIdentsOlderThan(OperationContext* opCtx, cons
         return;
     }
 
+    // Dropping a table competes with a running checkpoint for the storage engine's schema lock, so
+    // optionally leave the idents queued for a later pass.
+    if (gDropPendingIdentReaperDeferDuringCheckpoint.load() && _engine->isCheckpointRunning()) {
+        dropPendingIdentsDeferredForCheckpoint.increment();
+        LOGV2_DEBUG(6112800,
+                    1,
+                    "Deferring the drop of idents while a checkpoint is running",
+                    "numIdents"_attr = toDrop.size());
+        return;
+    }
+
     for (auto& timestampAndIdentInfo : toDrop) {
         // Guards against catalog changes while dropping idents using KVEngine::dropIdent(). Yields
         // after dropping each ident.
@@ -119,8 +155,10 @@ void KVDropPendingIdentReaper::dropIdentsOlderThan(OperationContext* opCtx, cons
               "ident"_attr = identName,
               "dropTimestamp"_attr = dropTimestamp);
         WriteUnitOfWork wuow(opCtx);
+        Timer timer;
         auto status =
             _engine->dropIdent(opCtx->recoveryUnit(), identName, std::move(identInfo.onDrop));
+        dropPendingIdentsDropStats.record(timer);
         if (!status.isOK()) {
             LOGV2_FATAL_NOTRACE(51022,
                                 "Failed to remove drop-pending ident",
@@ -145,6 +183,7 @@ void KVDropPendingIdentReaper::dropIdentsOlderThan(OperationContext* opCtx, cons
             for (auto it = beginEndPair.first; it != beginEndPair.second;) {
                 if (it->second.identName == timestampAndIdentInfo.second.identName) {
                     it = _dropPendingIdents.erase(it);
+                    queuedDropPendingIdents.decrement();
                     break;
                 } else {
                     ++it;
@@ -156,6 +195,7 @@ void KVDropPendingIdentReaper::dropIdentsOlderThan(OperationContext* opCtx, cons
 
 void KVDropPendingIdentReaper::clearDropPendingState() {
     stdx::lock_guard<Latch> lock(_mutex);
+    queuedDropPendingIdents.decrement(_dropPendingIdents.size());
     _dropPendingIdents.clear();
 }
 
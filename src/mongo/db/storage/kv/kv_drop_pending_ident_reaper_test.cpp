@@ -35,6 +35,7 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/ident.h"
 #include "mongo/db/storage/kv/kv_drop_pending_ident_reaper.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -129,6 +130,13 @@ public:
 
     void setPinnedOplogTimestamp(const Timestamp& pinnedTimestamp) {}
 
+    bool isCheckpointRunning() const override {
+        return checkpointRunning;
+    }
+
+    // Whether isCheckpointRunning() reports a checkpoint in progress.
+    bool checkpointRunning = false;
+
     // List of ident names removed using dropIdent().
     std::vector<std::string> droppedIdents;
 
@@ -395,5 +403,51 @@ DEATH_TEST_F(KVDropPendingIdentReaperTest,
     reaper.dropIdentsOlderThan(opCtx.get(), makeTimestampWithNextInc(dropTimestamp));
 }
 
+TEST_F(KVDropPendingIdentReaperTest, DropIdentsOlderThanDropsAtMostTheLimitPerPass) {
+    RAIIServerParameterControllerForTest maxDrops{"dropPendingIdentReaperMaxDropsPerPass", 2};
+    auto opCtx = makeOpCtx();
+    auto engine = getEngine();
+    KVDropPendingIdentReaper reaper(engine);
+
+    const Timestamp laterThanDropTimestamps{Seconds(100), 0};
+    for (int i = 0; i < 5; ++i) {
+        reaper.addDropPendingIdent({Seconds(i + 1), 0},
+                                   std::make_shared<Ident>(str::stream() << "ident" << i));
+    }
+
+    // The oldest idents are dropped first.
+    reaper.dropIdentsOlderThan(opCtx.get(), laterThanDropTimestamps);
+    ASSERT_EQUALS(2U, engine->droppedIdents.size());
+    ASSERT_EQUALS("ident0", engine->droppedIdents[0]);
+    ASSERT_EQUALS("ident1", engine->droppedIdents[1]);
+    ASSERT_EQUALS(Timestamp(Seconds(3), 0), *reaper.getEarliestDropTimestamp());
+
+    reaper.dropIdentsOlderThan(opCtx.get(), laterThanDropTimestamps);
+    reaper.dropIdentsOlderThan(opCtx.get(), laterThanDropTimestamps);
+    ASSERT_EQUALS(5U, engine->droppedIdents.size());
+    ASSERT_FALSE(reaper.getEarliestDropTimestamp());
+}
+
+TEST_F(KVDropPendingIdentReaperTest, DropIdentsOlderThanDefersWhileCheckpointIsRunning) {
+    RAIIServerParameterControllerForTest defer{"dropPendingIdentReaperDeferDuringCheckpoint", true};
+    auto opCtx = makeOpCtx();
+    auto engine = getEngine();
+    KVDropPendingIdentReaper reaper(engine);
+
+    const Timestamp dropTimestamp{Seconds(100), 0};
+    const Timestamp laterThanDropTimestamp{Seconds(200), 0};
+    reaper.addDropPendingIdent(dropTimestamp, std::make_shared<Ident>("ident"));
+
+    engine->checkpointRunning = true;
+    reaper.dropIdentsOlderThan(opCtx.get(), laterThanDropTimestamp);
+    ASSERT_EQUALS(0U, engine->droppedIdents.size());
+    ASSERT_EQUALS(dropTimestamp, *reaper.getEarliestDropTimestamp());
+
+    engine->checkpointRunning = false;
+    reaper.dropIdentsOlderThan(opCtx.get(), laterThanDropTimestamp);
+    ASSERT_EQUALS(1U, engine->droppedIdents.size());
+    ASSERT_FALSE(reaper.getEarliestDropTimestamp());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -131,6 +131,17 @@ public:
 
     virtual int64_t getIdentSize(OperationContext* opCtx, StringData ident) = 0;
 
+    /**
+     * Appends what the engine last sampled of the cache usage of 'ident', scaling sizes down by
+     * 'scale'. Returns false, appending nothing, if the engine does not sample cache usage or has
+     * not sampled 'ident'.
+     */
+    virtual bool appendIdentCacheUsage(StringData ident,
+                                       double scale,
+                                       BSONObjBuilder* bob) const {
+        return false;
+    }
+
     /**
      * Repair an ident. Returns Status::OK if repair did not modify data. Returns a non-fatal status
      * of DataModifiedByRepair if a repair operation succeeded, but may have modified data.
@@ -215,6 +226,21 @@ public:
 
     virtual void checkpoint() {}
 
+    /**
+     * Returns the number of bytes in the cache which were modified since they were last written
+     * out, or boost::none if the engine does not track them.
+     */
+    virtual boost::optional<int64_t> getCacheDirtyBytes() const {
+        return boost::none;
+    }
+
+    /**
+     * Returns whether a checkpoint is being taken. Engines which cannot tell always return false.
+     */
+    virtual bool isCheckpointRunning() const {
+        return false;
+    }
+
     virtual bool isDurable() const = 0;
 
     /**
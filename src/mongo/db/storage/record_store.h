@@ -113,6 +113,13 @@ public:
      */
     virtual boost::optional<Record> next() = 0;
 
+    /**
+     * Hints that the caller is going to scan many records with this cursor, so the storage engine
+     * may read upcoming records into its cache ahead of the cursor. The hint does not change
+     * which records are returned. Ignored by default.
+     */
+    virtual void enableReadAhead() {}
+
     //
     // Saving and restoring state
     //
@@ -180,6 +180,21 @@ public:
         return x;
     }
 
+    /**
+     * Returns the number of entries in 'this' index without traversing it, if the storage engine
+     * maintains that number for the index, or boost::none otherwise. Like the fast count of a
+     * RecordStore, the number is only approximate after an unclean shutdown or a rollback.
+     */
+    virtual boost::optional<long long> fastKeyCount(OperationContext* opCtx) const {
+        return boost::none;
+    }
+
+    /**
+     * Replaces the maintained number of entries with 'numKeys', as counted by validate. Does
+     * nothing for an index whose number of entries the storage engine does not maintain.
+     */
+    virtual void updateKeyCountAfterRepair(OperationContext* opCtx, long long numKeys) {}
+
     /*
      * Return the KeyString version for 'this' index.
      */
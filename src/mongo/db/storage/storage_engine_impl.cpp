@@ -56,6 +56,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 #define LOGV2_FOR_RECOVERY(ID, DLEVEL, MESSAGE, ...) \
     LOGV2_DEBUG_OPTIONS(ID, DLEVEL, {logv2::LogComponent::kStorageRecovery}, MESSAGE, ##__VA_ARGS__)
@@ -144,9 +145,11 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
         _dumpCatalog(opCtx);
     }
 
+    Timer timer;
     _catalog.reset(new DurableCatalogImpl(
         _catalogRecordStore.get(), _options.directoryPerDB, _options.directoryForIndexes, this));
     _catalog->init(opCtx);
+    const auto catalogInitMillis = timer.millis();
 
     // We populate 'identsKnownToStorageEngine' only if:
     // - doing repair; or
@@ -190,12 +193,13 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
         // a repair context, if we can't find an ident in the catalog, we generate a catalog entry
         // 'local.orphan.xxxxx' for it. However, in a nonrepair context, the orphaned idents
         // will be dropped in reconcileCatalogAndIdents().
+        stdx::unordered_set<std::string> catalogIdents;
+        for (const auto& entry : catalogEntries) {
+            catalogIdents.insert(entry.ident);
+        }
         for (const auto& ident : identsKnownToStorageEngine) {
             if (_catalog->isCollectionIdent(ident)) {
-                bool isOrphan = !std::any_of(
-                    catalogEntries.begin(),
-                    catalogEntries.end(),
-                    [this, &ident](DurableCatalog::Entry entry) { return entry.ident == ident; });
+                bool isOrphan = !catalogIdents.count(ident);
                 if (isOrphan) {
                     // If the catalog does not have information about this
                     // collection, we create an new entry for it.
@@ -235,6 +239,11 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
         }
     }
 
+    // Every registration copies the parts of the collection catalog it modifies, so register all of
+    // the collections with a single catalog write once they have been opened.
+    const auto readEntriesMillis = timer.millis() - catalogInitMillis;
+    std::vector<std::shared_ptr<Collection>> collections;
+    collections.reserve(catalogEntries.size());
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
             // If we are loading the catalog after an unclean shutdown or during repair, it's
@@ -289,7 +298,8 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs);
+        collections.push_back(
+            _makeCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs));
 
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248,
@@ -298,8 +308,25 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
                   "namespace"_attr = entry.nss);
         }
     }
+    const auto openCollectionsMillis = timer.millis() - catalogInitMillis - readEntriesMillis;
+
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        for (auto&& collection : collections) {
+            auto uuid = collection->uuid();
+            catalog.registerCollection(opCtx, uuid, std::move(collection));
+        }
+    });
 
     opCtx->recoveryUnit()->abandonSnapshot();
+
+    LOGV2(6112100,
+          "Loaded the catalog",
+          "numCollections"_attr = collections.size(),
+          "catalogInitMillis"_attr = catalogInitMillis,
+          "readEntriesMillis"_attr = readEntriesMillis,
+          "openCollectionsMillis"_attr = openCollectionsMillis,
+          "registerCollectionsMillis"_attr =
+              timer.millis() - catalogInitMillis - readEntriesMillis - openCollectionsMillis);
 }
 
 void StorageEngineImpl::_initCollection(OperationContext* opCtx,
@@ -307,6 +334,18 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
                                         const NamespaceString& nss,
                                         bool forRepair,
                                         Timestamp minVisibleTs) {
+    auto collection = _makeCollection(opCtx, catalogId, nss, forRepair, minVisibleTs);
+    auto uuid = collection->uuid();
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        catalog.registerCollection(opCtx, uuid, std::move(collection));
+    });
+}
+
+std::shared_ptr<Collection> StorageEngineImpl::_makeCollection(OperationContext* opCtx,
+                                                               RecordId catalogId,
+                                                               const NamespaceString& nss,
+                                                               bool forRepair,
+                                                               Timestamp minVisibleTs) {
     auto md = _catalog->getMetaData(opCtx, catalogId);
     uassert(ErrorCodes::MustDowngrade,
             str::stream() << "Collection does not have UUID in KVCatalog. Collection: " << nss,
@@ -327,10 +366,7 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, md, std::move(rs));
     collection->setMinimumVisibleSnapshot(minVisibleTs);
-
-    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
-        catalog.registerCollection(opCtx, md->options.uuid.get(), std::move(collection));
-    });
+    return collection;
 }
 
 void StorageEngineImpl::closeCatalog(OperationContext* opCtx) {
@@ -392,15 +428,15 @@ bool StorageEngineImpl::_handleInternalIdent(OperationContext* opCtx,
 
     allInternalIdents->insert(ident);
 
-    // When starting up after an unclean shutdown, we do not attempt to recover any state from the
-    // internal idents. Thus, we drop them in this case.
-    if (lastShutdownState == LastShutdownState::kUnclean || !supportsResumableIndexBuilds()) {
+    if (!supportsResumableIndexBuilds()) {
         internalIdentsToDrop->insert(ident);
         return true;
     }
 
     if (!_catalog->isResumableIndexBuildIdent(ident)) {
-        return false;
+        // After an unclean shutdown, the internal idents that are not used by the index builds
+        // being resumed are dropped once all of the resumable state has been found.
+        return lastShutdownState == LastShutdownState::kUnclean;
     }
 
     // When starting up after a clean shutdown and resumable index builds are supported, find the
@@ -432,6 +468,19 @@ bool StorageEngineImpl::_handleInternalIdent(OperationContext* opCtx,
             return true;
         }
 
+        // After an unclean shutdown, only the state checkpointed during a collection scan can be
+        // used. Tables written to after the scan, such as the index itself, are not recovered to a
+        // point consistent with that state.
+        if (lastShutdownState == LastShutdownState::kUnclean &&
+            resumeInfo.getPhase() != IndexBuildPhaseEnum::kCollectionScan) {
+            LOGV2(6107501,
+                  "Not resuming index build after unclean shutdown",
+                  "buildUUID"_attr = resumeInfo.getBuildUUID(),
+                  "phase"_attr = IndexBuildPhase_serializer(resumeInfo.getPhase()));
+            internalIdentsToDrop->insert(ident);
+            return true;
+        }
+
         reconcileResult->indexBuildsToResume.push_back(resumeInfo);
 
         // Once we have parsed the resume info, we can safely drop the internal ident.
@@ -446,6 +495,12 @@ bool StorageEngineImpl::_handleInternalIdent(OperationContext* opCtx,
         return true;
     }
 
+    // After an unclean shutdown, this may be the table of a checkpoint that was removed.
+    if (lastShutdownState == LastShutdownState::kUnclean) {
+        internalIdentsToDrop->insert(ident);
+        return true;
+    }
+
     return false;
 }
 
@@ -693,6 +748,25 @@ StatusWith<StorageEngine::ReconcileResult> StorageEngineImpl::reconcileCatalogAn
     // If there are no index builds to resume, we should drop all internal idents.
     if (reconcileResult.indexBuildsToResume.empty()) {
         internalIdentsToDrop.swap(allInternalIdents);
+    } else if (lastShutdownState == LastShutdownState::kUnclean) {
+        // After an unclean shutdown, keep only the tables of the index builds being resumed.
+        std::set<std::string> identsToKeep;
+        for (const auto& resumeInfo : reconcileResult.indexBuildsToResume) {
+            for (const auto& index : resumeInfo.getIndexes()) {
+                identsToKeep.insert(index.getSideWritesTable().toString());
+                if (auto ident = index.getDuplicateKeyTrackerTable()) {
+                    identsToKeep.insert(ident->toString());
+                }
+                if (auto ident = index.getSkippedRecordTrackerTable()) {
+                    identsToKeep.insert(ident->toString());
+                }
+            }
+        }
+        for (const auto& ident : allInternalIdents) {
+            if (identsToKeep.find(ident) == identsToKeep.end()) {
+                internalIdentsToDrop.insert(ident);
+            }
+        }
     }
 
     for (auto&& temp : internalIdentsToDrop) {
@@ -367,6 +367,16 @@ private:
                          bool forRepair,
                          Timestamp minVisibleTs);
 
+    /**
+     * Opens the collection with the given catalog entry, without registering it with the
+     * CollectionCatalog.
+     */
+    std::shared_ptr<Collection> _makeCollection(OperationContext* opCtx,
+                                                RecordId catalogId,
+                                                const NamespaceString& nss,
+                                                bool forRepair,
+                                                Timestamp minVisibleTs);
+
     Status _dropCollectionsNoTimestamp(OperationContext* opCtx, const std::vector<UUID>& toDrop);
 
     /**
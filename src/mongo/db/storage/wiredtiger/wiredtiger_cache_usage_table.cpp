@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_cache_usage_table.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+namespace {
+
+long long counterDelta(long long previous, long long current) {
+    return current >= previous ? current - previous : current;
+}
+
+}  // namespace
+
+void WiredTigerCacheUsageTable::update(
+    Date_t sampledAt, const std::vector<std::pair<std::string, Counters>>& samples) {
+    stdx::unordered_map<std::string, Counters> counters;
+    stdx::unordered_map<std::string, Usage> usage;
+    std::vector<std::string> ranking;
+    counters.reserve(samples.size());
+    usage.reserve(samples.size());
+    ranking.reserve(samples.size());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& [ident, current] : samples) {
+        Usage u;
+        u.bytesInCache = current.bytesInCache;
+        if (auto it = _counters.find(ident); it != _counters.end()) {
+            u.pagesReadDelta = counterDelta(it->second.pagesRead, current.pagesRead);
+            u.pagesEvictedDelta = counterDelta(it->second.pagesEvicted, current.pagesEvicted);
+        }
+        counters[ident] = current;
+        usage[ident] = u;
+        ranking.push_back(ident);
+    }
+
+    std::sort(ranking.begin(), ranking.end(), [&](const std::string& l, const std::string& r) {
+        const auto& lu = usage.at(l);
+        const auto& ru = usage.at(r);
+        if (lu.pagesMovedDelta() != ru.pagesMovedDelta()) {
+            return lu.pagesMovedDelta() > ru.pagesMovedDelta();
+        }
+        if (lu.bytesInCache != ru.bytesInCache) {
+            return lu.bytesInCache > ru.bytesInCache;
+        }
+        return l < r;
+    });
+
+    _sampledAt = sampledAt;
+    _counters = std::move(counters);
+    _usage = std::move(usage);
+    _ranking = std::move(ranking);
+}
+
+bool WiredTigerCacheUsageTable::appendIdentUsage(StringData ident,
+                                                 double scale,
+                                                 BSONObjBuilder* bob) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _usage.find(ident.toString());
+    if (it == _usage.end()) {
+        return false;
+    }
+    bob->append("sampledAt", _sampledAt);
+    _appendUsage(it->second, scale, bob);
+    return true;
+}
+
+void WiredTigerCacheUsageTable::appendTopIdents(size_t topN, BSONObjBuilder* bob) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    bob->append("sampledAt", _sampledAt);
+    BSONObjBuilder idents(bob->subobjStart("idents"));
+    for (size_t i = 0; i < std::min(topN, _ranking.size()); ++i) {
+        BSONObjBuilder identBob(idents.subobjStart(_ranking[i]));
+        _appendUsage(_usage.at(_ranking[i]), 1, &identBob);
+    }
+}
+
+std::vector<std::pair<std::string, long long>> WiredTigerCacheUsageTable::getIdentsInCache() const {
+    std::vector<std::pair<std::string, long long>> idents;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (const auto& [ident, usage] : _usage) {
+            if (usage.bytesInCache > 0) {
+                idents.emplace_back(ident, usage.bytesInCache);
+            }
+        }
+    }
+
+    std::sort(idents.begin(), idents.end(), [](const auto& l, const auto& r) {
+        return l.second != r.second ? l.second > r.second : l.first < r.first;
+    });
+    return idents;
+}
+
+void WiredTigerCacheUsageTable::_appendUsage(const Usage& usage,
+                                             double scale,
+                                             BSONObjBuilder* bob) {
+    bob->appendNumber("bytesInCache", static_cast<long long>(usage.bytesInCache / scale));
+    bob->appendNumber("pagesRead", usage.pagesReadDelta);
+    bob->appendNumber("pagesEvicted", usage.pagesEvictedDelta);
+}
+
+}  // namespace mongo
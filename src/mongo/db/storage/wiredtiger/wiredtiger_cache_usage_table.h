@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * Holds the most recent sample of how much of the WiredTiger cache each ident uses and how many
+ * of its pages moved in and out of the cache since the sample before. Idents are ranked by that
+ * movement, so the top of the table shows which collections and indexes thrash the cache.
+ *
+ * Thread safe.
+ */
+class WiredTigerCacheUsageTable {
+public:
+    /**
+     * The cumulative statistics of one ident's data source, as read from WiredTiger.
+     */
+    struct Counters {
+        long long bytesInCache = 0;
+        long long pagesRead = 0;
+        long long pagesEvicted = 0;
+    };
+
+    /**
+     * One ident's usage as of the last sample. The 'Delta' fields cover the interval since the
+     * sample before it.
+     */
+    struct Usage {
+        long long bytesInCache = 0;
+        long long pagesReadDelta = 0;
+        long long pagesEvictedDelta = 0;
+
+        long long pagesMovedDelta() const {
+            return pagesReadDelta + pagesEvictedDelta;
+        }
+    };
+
+    /**
+     * Replaces the table with 'samples', taken at 'sampledAt'. Idents missing from 'samples' are
+     * forgotten, and idents sampled for the first time have no deltas yet. The counters of data
+     * sources that were reopened since the previous sample start over from zero, so deltas that
+     * would be negative are taken from the new counters alone.
+     */
+    void update(Date_t sampledAt, const std::vector<std::pair<std::string, Counters>>& samples);
+
+    /**
+     * Appends 'ident's usage as of the last sample to 'bob'. Returns false, appending nothing, if
+     * 'ident' was not sampled.
+     */
+    bool appendIdentUsage(StringData ident, double scale, BSONObjBuilder* bob) const;
+
+    /**
+     * Appends the time of the last sample and the usage of the 'topN' idents whose pages moved in
+     * and out of the cache the most over the last interval, keyed by ident.
+     */
+    void appendTopIdents(size_t topN, BSONObjBuilder* bob) const;
+
+    /**
+     * Returns the idents which had bytes in the cache as of the last sample, with those bytes,
+     * largest first.
+     */
+    std::vector<std::pair<std::string, long long>> getIdentsInCache() const;
+
+private:
+    static void _appendUsage(const Usage& usage, double scale, BSONObjBuilder* bob);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerCacheUsageTable::_mutex");
+    Date_t _sampledAt;
+    stdx::unordered_map<std::string, Counters> _counters;
+    stdx::unordered_map<std::string, Usage> _usage;
+
+    // Every sampled ident, hottest first.
+    std::vector<std::string> _ranking;
+};
+
+}  // namespace mongo
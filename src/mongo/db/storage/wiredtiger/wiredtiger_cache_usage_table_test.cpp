@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_cache_usage_table.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Counters = WiredTigerCacheUsageTable::Counters;
+
+BSONObj identUsage(const WiredTigerCacheUsageTable& table, StringData ident, double scale = 1) {
+    BSONObjBuilder bob;
+    ASSERT(table.appendIdentUsage(ident, scale, &bob));
+    return bob.obj();
+}
+
+TEST(WiredTigerCacheUsageTableTest, ReportsDeltasSincePreviousSample) {
+    WiredTigerCacheUsageTable table;
+    const auto first = Date_t::fromMillisSinceEpoch(1000);
+    const auto second = Date_t::fromMillisSinceEpoch(2000);
+
+    // An ident sampled for the first time has no deltas yet.
+    table.update(first, {{"collection-1", Counters{4096, 10, 2}}});
+    auto usage = identUsage(table, "collection-1");
+    ASSERT_EQ(usage["sampledAt"].Date(), first);
+    ASSERT_EQ(usage["bytesInCache"].numberLong(), 4096);
+    ASSERT_EQ(usage["pagesRead"].numberLong(), 0);
+    ASSERT_EQ(usage["pagesEvicted"].numberLong(), 0);
+
+    table.update(second, {{"collection-1", Counters{8192, 25, 7}}});
+    usage = identUsage(table, "collection-1", 1024);
+    ASSERT_EQ(usage["sampledAt"].Date(), second);
+    ASSERT_EQ(usage["bytesInCache"].numberLong(), 8);
+    ASSERT_EQ(usage["pagesRead"].numberLong(), 15);
+    ASSERT_EQ(usage["pagesEvicted"].numberLong(), 5);
+}
+
+TEST(WiredTigerCacheUsageTableTest, CountersStartOverWhenDataSourceReopens) {
+    WiredTigerCacheUsageTable table;
+    table.update(Date_t::fromMillisSinceEpoch(1000), {{"index-2", Counters{0, 100, 50}}});
+    table.update(Date_t::fromMillisSinceEpoch(2000), {{"index-2", Counters{0, 3, 1}}});
+    auto usage = identUsage(table, "index-2");
+    ASSERT_EQ(usage["pagesRead"].numberLong(), 3);
+    ASSERT_EQ(usage["pagesEvicted"].numberLong(), 1);
+}
+
+TEST(WiredTigerCacheUsageTableTest, ForgetsIdentsNoLongerSampled) {
+    WiredTigerCacheUsageTable table;
+    table.update(Date_t::fromMillisSinceEpoch(1000),
+                 {{"collection-1", Counters{}}, {"collection-2", Counters{}}});
+    table.update(Date_t::fromMillisSinceEpoch(2000), {{"collection-2", Counters{}}});
+
+    BSONObjBuilder bob;
+    ASSERT_FALSE(table.appendIdentUsage("collection-1", 1, &bob));
+    ASSERT(bob.obj().isEmpty());
+    identUsage(table, "collection-2");
+}
+
+TEST(WiredTigerCacheUsageTableTest, RanksTopIdentsByPagesMoved) {
+    WiredTigerCacheUsageTable table;
+    table.update(Date_t::fromMillisSinceEpoch(1000),
+                 {{"cold", Counters{1 << 20, 0, 0}},
+                  {"warm", Counters{1024, 0, 0}},
+                  {"hot", Counters{1024, 0, 0}}});
+    table.update(Date_t::fromMillisSinceEpoch(2000),
+                 {{"cold", Counters{1 << 20, 0, 0}},
+                  {"warm", Counters{1024, 10, 0}},
+                  {"hot", Counters{1024, 20, 20}}});
+
+    BSONObjBuilder bob;
+    table.appendTopIdents(2, &bob);
+    auto idents = bob.obj()["idents"].Obj();
+    ASSERT_EQ(idents.nFields(), 2);
+    BSONObjIterator it(idents);
+    ASSERT_EQ(it.next().fieldNameStringData(), "hot");
+    ASSERT_EQ(it.next().fieldNameStringData(), "warm");
+
+    // Without any movement, the idents using the most cache come first.
+    BSONObjBuilder all;
+    table.update(Date_t::fromMillisSinceEpoch(3000),
+                 {{"cold", Counters{1 << 20, 0, 0}},
+                  {"warm", Counters{1024, 10, 0}},
+                  {"hot", Counters{1024, 20, 20}}});
+    table.appendTopIdents(1, &all);
+    ASSERT_EQ(all.obj()["idents"].Obj().firstElementFieldNameStringData(), "cold");
+}
+
+TEST(WiredTigerCacheUsageTableTest, ListsIdentsInCacheByBytes) {
+    WiredTigerCacheUsageTable table;
+    table.update(Date_t::fromMillisSinceEpoch(1000),
+                 {{"evicted", Counters{0, 10, 10}},
+                  {"small", Counters{1024, 0, 0}},
+                  {"large", Counters{1 << 20, 0, 0}}});
+    auto idents = table.getIdentsInCache();
+    ASSERT_EQ(idents.size(), 2U);
+    ASSERT_EQ(idents[0].first, "large");
+    ASSERT_EQ(idents[0].second, 1 << 20);
+    ASSERT_EQ(idents[1].first, "small");
+    ASSERT_EQ(idents[1].second, 1024);
+}
+
+}  // namespace
+}  // namespace mongo
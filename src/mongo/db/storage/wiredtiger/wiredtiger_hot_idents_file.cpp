@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_hot_idents_file.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/base/data_range.h"
+#include "mongo/base/data_type_validated.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/storage_file_util.h"
+#include "mongo/rpc/object_check.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+Status WiredTigerHotIdentsFile::write(const std::string& dbpath, const HotIdents& idents) {
+    BSONObjBuilder bob;
+    {
+        BSONArrayBuilder identsBuilder(bob.subarrayStart("idents"));
+        for (const auto& [ident, bytesInCache] : idents) {
+            identsBuilder.append(BSON("ident" << ident << "bytesInCache" << bytesInCache));
+        }
+    }
+    const BSONObj obj = bob.obj();
+
+    const auto path = boost::filesystem::path(dbpath) / kFileName.toString();
+    const auto tempPath = boost::filesystem::path(dbpath) / (kFileName + ".tmp");
+    {
+        std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+        if (!ofs) {
+            return {ErrorCodes::FileNotOpen,
+                    str::stream() << "Failed to open " << tempPath.string() << ": "
+                                  << errnoWithDescription()};
+        }
+        ofs.write(obj.objdata(), obj.objsize());
+        if (!ofs) {
+            return {ErrorCodes::OperationFailed,
+                    str::stream() << "Failed to write " << tempPath.string() << ": "
+                                  << errnoWithDescription()};
+        }
+    }
+
+    if (auto status = fsyncFile(tempPath); !status.isOK()) {
+        return status;
+    }
+    try {
+        boost::filesystem::rename(tempPath, path);
+    } catch (const std::exception& ex) {
+        return {ErrorCodes::FileRenameFailed,
+                str::stream() << "Failed to rename " << tempPath.string() << " to "
+                              << path.string() << ": " << ex.what()};
+    }
+    return fsyncParentDirectory(path);
+}
+
+StatusWith<WiredTigerHotIdentsFile::HotIdents> WiredTigerHotIdentsFile::read(
+    const std::string& dbpath) {
+    const auto path = boost::filesystem::path(dbpath) / kFileName.toString();
+    boost::system::error_code ec;
+    const auto fileSize = boost::filesystem::file_size(path, ec);
+    if (ec) {
+        return {ErrorCodes::NonExistentPath,
+                str::stream() << "Failed to find " << path.string() << ": " << ec.message()};
+    }
+
+    std::vector<char> buffer(fileSize);
+    {
+        std::ifstream ifs(path.c_str(), std::ios_base::in | std::ios_base::binary);
+        if (!ifs || !ifs.read(buffer.data(), buffer.size())) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "Failed to read " << path.string()};
+        }
+    }
+
+    auto swObj = ConstDataRange(buffer.data(), buffer.size()).readNoThrow<Validated<BSONObj>>();
+    if (!swObj.isOK()) {
+        return swObj.getStatus();
+    }
+
+    HotIdents idents;
+    try {
+        for (auto&& elem : swObj.getValue().val["idents"].Obj()) {
+            auto entry = elem.Obj();
+            idents.emplace_back(entry["ident"].String(), entry["bytesInCache"].safeNumberLong());
+        }
+    } catch (const DBException& ex) {
+        return ex.toStatus().withContext(str::stream() << "Invalid " << path.string());
+    }
+    return idents;
+}
+
+}  // namespace mongo
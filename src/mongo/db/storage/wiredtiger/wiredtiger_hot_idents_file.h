@@ -0,0 +1,66 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * The file in the dbpath that lists the collections and indexes which held the most bytes in the
+ * WiredTiger cache, along with those bytes, largest first. The cache usage sampler rewrites it
+ * after every sample so that, after a restart, the cache warmer knows what to read back into the
+ * cache.
+ */
+class WiredTigerHotIdentsFile {
+public:
+    using HotIdents = std::vector<std::pair<std::string, long long>>;
+
+    static constexpr StringData kFileName = "WiredTigerHotIdents.bson"_sd;
+
+    /**
+     * Atomically replaces the file in 'dbpath' with 'idents'.
+     */
+    static Status write(const std::string& dbpath, const HotIdents& idents);
+
+    /**
+     * Returns the idents last written to the file in 'dbpath'. Returns NonExistentPath if there is
+     * no such file.
+     */
+    static StatusWith<HotIdents> read(const std::string& dbpath);
+};
+
+}  // namespace mongo
@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_hot_idents_file.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(WiredTigerHotIdentsFileTest, ReadsBackWhatWasWritten) {
+    unittest::TempDir dbpath("wiredtiger_hot_idents_file_test");
+    WiredTigerHotIdentsFile::HotIdents idents{{"collection-1", 1 << 20}, {"index-2", 4096}};
+    ASSERT_OK(WiredTigerHotIdentsFile::write(dbpath.path(), idents));
+    ASSERT(WiredTigerHotIdentsFile::read(dbpath.path()).getValue() == idents);
+
+    // A later write replaces the earlier one.
+    idents = {{"index-3", 1}};
+    ASSERT_OK(WiredTigerHotIdentsFile::write(dbpath.path(), idents));
+    ASSERT(WiredTigerHotIdentsFile::read(dbpath.path()).getValue() == idents);
+}
+
+TEST(WiredTigerHotIdentsFileTest, MissingFile) {
+    unittest::TempDir dbpath("wiredtiger_hot_idents_file_test");
+    ASSERT_EQ(WiredTigerHotIdentsFile::read(dbpath.path()).getStatus(),
+              ErrorCodes::NonExistentPath);
+}
+
+TEST(WiredTigerHotIdentsFileTest, CorruptFile) {
+    unittest::TempDir dbpath("wiredtiger_hot_idents_file_test");
+    {
+        std::ofstream ofs(
+            (boost::filesystem::path(dbpath.path()) / WiredTigerHotIdentsFile::kFileName.toString())
+                .c_str());
+        ofs << "not bson";
+    }
+    ASSERT_NOT_OK(WiredTigerHotIdentsFile::read(dbpath.path()).getStatus());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -51,6 +51,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor_helpers.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -60,6 +61,7 @@
 #include "mongo/util/hex.h"
 #include "mongo/util/str.h"
 #include "mongo/util/testing_proctor.h"
+#include "mongo/util/timer.h"
 
 #define TRACING_ENABLED 0
 
@@ -252,6 +254,53 @@ WiredTigerIndex::WiredTigerIndex(OperationContext* ctx,
       _keyPattern(desc->keyPattern()),
       _collation(desc->collation()) {}
 
+void WiredTigerIndex::trackKeyCount(WiredTigerSizeStorer* sizeStorer) {
+    _sizeStorer = sizeStorer;
+    _keyCount = _sizeStorer->loadIndexKeyCount(_uri);
+}
+
+boost::optional<long long> WiredTigerIndex::fastKeyCount(OperationContext* opCtx) const {
+    if (!_keyCount) {
+        return boost::none;
+    }
+    return _keyCount->numRecords.load();
+}
+
+void WiredTigerIndex::updateKeyCountAfterRepair(OperationContext* opCtx, long long numKeys) {
+    if (!_sizeStorer) {
+        return;
+    }
+    if (!_keyCount) {
+        _keyCount = std::make_shared<WiredTigerSizeStorer::SizeInfo>();
+    }
+    _keyCount->numRecords.store(std::max(numKeys, 0ll));
+    _sizeStorer->storeIndexKeyCount(_uri, _keyCount);
+}
+
+void WiredTigerIndex::_changeKeyCount(OperationContext* opCtx, long long diff) {
+    if (!_keyCount) {
+        return;
+    }
+    if (_keyCount->numRecords.addAndFetch(diff) < 0) {
+        _keyCount->numRecords.store(0);
+    }
+    _sizeStorer->storeIndexKeyCount(_uri, _keyCount);
+
+    opCtx->recoveryUnit()->onRollback([keyCount = _keyCount, diff] {
+        if (keyCount->numRecords.addAndFetch(-diff) < 0) {
+            keyCount->numRecords.store(0);
+        }
+    });
+}
+
+void WiredTigerIndex::_addBulkLoadedKey() {
+    if (!_keyCount) {
+        return;
+    }
+    _keyCount->numRecords.addAndFetch(1);
+    _sizeStorer->storeIndexKeyCount(_uri, _keyCount);
+}
+
 NamespaceString WiredTigerIndex::getCollectionNamespace(OperationContext* opCtx) const {
     return _desc->getEntry()->getNSSFromCatalog(opCtx);
 }
@@ -626,6 +675,7 @@ public:
         _cursor->set_value(_cursor, valueItem.Get());
 
         invariantWTOK(wiredTigerCursorInsert(_opCtx, _cursor));
+        _idx->_addBulkLoadedKey();
 
         auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
         metricsCollector.incrementOneIdxEntryWritten(item.size);
@@ -647,10 +697,14 @@ private:
  */
 class WiredTigerIndex::UniqueBulkBuilder : public BulkBuilder {
 public:
-    UniqueBulkBuilder(WiredTigerIndex* idx, OperationContext* opCtx, bool dupsAllowed)
+    UniqueBulkBuilder(WiredTigerIndex* idx,
+                      OperationContext* opCtx,
+                      bool dupsAllowed,
+                      BloomFilter* keyFilter)
         : BulkBuilder(idx, opCtx),
           _idx(idx),
           _dupsAllowed(dupsAllowed),
+          _keyFilter(keyFilter),
           _previousKeyString(idx->getKeyStringVersion()) {
         invariant(!_idx->isIdIndex());
     }
@@ -692,10 +746,17 @@ public:
         _cursor->set_value(_cursor, valueItem.Get());
 
         invariantWTOK(wiredTigerCursorInsert(_opCtx, _cursor));
+        _idx->_addBulkLoadedKey();
 
         auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
         metricsCollector.incrementOneIdxEntryWritten(keyItem.size);
 
+        if (_keyFilter) {
+            _keyFilter->insert(newKeyString.getBuffer(),
+                               KeyString::sizeWithoutRecordIdLongAtEnd(newKeyString.getBuffer(),
+                                                                       newKeyString.getSize()));
+        }
+
         // Don't copy the key again if dups are allowed.
         if (!_dupsAllowed)
             _previousKeyString.resetFromBuffer(newKeyString.getBuffer(), newKeyString.getSize());
@@ -706,6 +767,7 @@ public:
 private:
     WiredTigerIndex* _idx;
     const bool _dupsAllowed;
+    BloomFilter* const _keyFilter;
     KeyString::Builder _previousKeyString;
 };
 
@@ -1375,6 +1437,62 @@ WiredTigerIndexUnique::WiredTigerIndexUnique(OperationContext* ctx,
     invariant(!isIdIndex());
     // All unique indexes should be in the timestamp-safe format version as of version 4.2.
     invariant(isTimestampSafeUniqueIdx());
+
+    // An index is only opened at startup, when it is created, or while its collection is locked
+    // exclusively, so no other operation can write to it until the filter is built.
+    if (gWiredTigerUniqueIndexKeyFilterBitsPerKey > 0 && !isReadOnly) {
+        _buildKeyFilter(ctx);
+    }
+}
+
+void WiredTigerIndexUnique::_buildKeyFilter(OperationContext* opCtx) {
+    Timer timer;
+
+    // Use a different session, as the caller may be in the middle of a transaction.
+    auto session = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getSession();
+    WT_SESSION* s = session->getSession();
+    WT_CURSOR* cursor;
+    invariantWTOK(s->open_cursor(s, uri().c_str(), nullptr, nullptr, &cursor));
+    ON_BLOCK_EXIT([&] { cursor->close(cursor); });
+
+    // Size the filter for twice the keys present, so that it remains selective as the index grows.
+    int ret;
+    std::size_t numKeys = 0;
+    while ((ret = cursor->next(cursor)) == 0) {
+        ++numKeys;
+    }
+    std::unique_ptr<BloomFilter> keyFilter;
+    if (ret == WT_NOTFOUND) {
+        keyFilter = std::make_unique<BloomFilter>(std::max<std::size_t>(2 * numKeys, 1024),
+                                                  gWiredTigerUniqueIndexKeyFilterBitsPerKey);
+        invariantWTOK(cursor->reset(cursor));
+        while ((ret = cursor->next(cursor)) == 0) {
+            WT_ITEM item;
+            invariantWTOK(cursor->get_key(cursor, &item));
+            const char* buffer = static_cast<const char*>(item.data);
+            keyFilter->insert(buffer, KeyString::sizeWithoutRecordIdLongAtEnd(buffer, item.size));
+        }
+    }
+
+    if (ret != WT_NOTFOUND) {
+        // The index stays usable, only without the filter.
+        LOGV2_WARNING(6107701,
+                      "Failed to build the key filter of a unique index",
+                      "index"_attr = _indexName,
+                      "uri"_attr = uri(),
+                      "error"_attr = wtRCToStatus(ret));
+        return;
+    }
+
+    LOGV2_DEBUG(6107700,
+                1,
+                "Built the key filter of a unique index",
+                "index"_attr = _indexName,
+                "uri"_attr = uri(),
+                "numKeys"_attr = numKeys,
+                "sizeBytes"_attr = keyFilter->sizeInBytes(),
+                "durationMillis"_attr = timer.millis());
+    _keyFilter = std::move(keyFilter);
 }
 
 std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
@@ -1384,7 +1502,7 @@ std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
 
 std::unique_ptr<SortedDataBuilderInterface> WiredTigerIndexUnique::makeBulkBuilder(
     OperationContext* opCtx, bool dupsAllowed) {
-    return std::make_unique<UniqueBulkBuilder>(this, opCtx, dupsAllowed);
+    return std::make_unique<UniqueBulkBuilder>(this, opCtx, dupsAllowed, _keyFilter.get());
 }
 
 bool WiredTigerIndexUnique::isTimestampSafeUniqueIdx() const {
@@ -1530,12 +1648,23 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
 
     int ret;
 
+    // A prefix key is KeyString of index key. It is the component of the index entry that
+    // should be unique.
+    auto sizeWithoutRecordId =
+        KeyString::sizeWithoutRecordIdLongAtEnd(keyString.getBuffer(), keyString.getSize());
+
+    // The key filter must learn of the key before the key can become visible to any other
+    // operation, so that later inserts of the same key perform the full duplicate check.
+    bool mayBeDuplicate = true;
+    if (_keyFilter) {
+        mayBeDuplicate = _keyFilter->mayContain(keyString.getBuffer(), sizeWithoutRecordId);
+        if (!mayBeDuplicate) {
+            _keyFilter->insert(keyString.getBuffer(), sizeWithoutRecordId);
+        }
+    }
+
     // Pre-checks before inserting on a primary.
     if (!dupsAllowed) {
-        // A prefix key is KeyString of index key. It is the component of the index entry that
-        // should be unique.
-        auto sizeWithoutRecordId =
-            KeyString::sizeWithoutRecordIdLongAtEnd(keyString.getBuffer(), keyString.getSize());
         WiredTigerItem prefixKeyItem(keyString.getBuffer(), sizeWithoutRecordId);
 
         // First phase inserts the prefix key to prohibit concurrent insertions of same key
@@ -1565,10 +1694,14 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
 
         // Second phase looks up for existence of key to avoid insertion of duplicate key
         // The usage of 'prefix_key=true' enables an optimization that allows this search to return
-        // more quickly. See SERVER-56509.
-        c->reconfigure(c, "prefix_key=true");
-        ON_BLOCK_EXIT([c] { c->reconfigure(c, "prefix_key=false"); });
-        auto keyExists = _keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId);
+        // more quickly. See SERVER-56509. The lookup is skipped for keys the key filter rules out:
+        // the first phase still conflicts with any concurrent insert of the same key.
+        bool keyExists = false;
+        if (mayBeDuplicate) {
+            c->reconfigure(c, "prefix_key=true");
+            ON_BLOCK_EXIT([c] { c->reconfigure(c, "prefix_key=false"); });
+            keyExists = _keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId);
+        }
         if (keyExists) {
             auto key = KeyString::toBson(
                 keyString.getBuffer(), sizeWithoutRecordId, _ordering, keyString.getTypeBits());
@@ -1599,8 +1732,10 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
     metricsCollector.incrementOneIdxEntryWritten(keyItem.size);
 
     // It is possible that this key is already present during a concurrent background index build.
-    if (ret != WT_DUPLICATE_KEY)
+    if (ret != WT_DUPLICATE_KEY) {
         invariantWTOK(ret);
+        _changeKeyCount(opCtx, 1);
+    }
 
     return Status::OK();
 }
@@ -1696,6 +1831,7 @@ void WiredTigerIndexUnique::_unindex(OperationContext* opCtx,
 
     if (ret != WT_NOTFOUND) {
         invariantWTOK(ret);
+        _changeKeyCount(opCtx, -1);
         return;
     }
 
@@ -1713,6 +1849,7 @@ void WiredTigerIndexUnique::_unindex(OperationContext* opCtx,
         return;
     }
     invariantWTOK(ret);
+    _changeKeyCount(opCtx, -1);
 }
 // ------------------------------
 
@@ -1759,9 +1896,12 @@ Status WiredTigerIndexStandard::_insert(OperationContext* opCtx,
     // If the record was already in the index, we just return OK.
     // This can happen, for example, when building a background index while documents are being
     // written and reindexed.
-    if (ret != 0 && ret != WT_DUPLICATE_KEY)
+    if (ret == WT_DUPLICATE_KEY)
+        return Status::OK();
+    if (ret != 0)
         return wtRCToStatus(ret);
 
+    _changeKeyCount(opCtx, 1);
     return Status::OK();
 }
 
@@ -1778,6 +1918,7 @@ void WiredTigerIndexStandard::_unindex(OperationContext* opCtx,
         return;
     }
     invariantWTOK(ret);
+    _changeKeyCount(opCtx, -1);
 
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
     metricsCollector.incrementOneIdxEntryWritten(item.size);
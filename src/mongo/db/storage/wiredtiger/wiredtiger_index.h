@@ -37,6 +37,8 @@
 #include "mongo/db/storage/sorted_data_interface.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/util/bloom_filter.h"
 
 namespace mongo {
 
@@ -125,6 +127,10 @@ public:
 
     Status compact(OperationContext* opCtx) override;
 
+    boost::optional<long long> fastKeyCount(OperationContext* opCtx) const override;
+
+    void updateKeyCountAfterRepair(OperationContext* opCtx, long long numKeys) override;
+
     const std::string& uri() const {
         return _uri;
     }
@@ -149,6 +155,12 @@ public:
         return false;
     }
 
+    /**
+     * Maintains the number of keys in this index in 'sizeStorer', continuing from the count stored
+     * there if there is one. Otherwise the count stays unknown until validate establishes it.
+     */
+    void trackKeyCount(WiredTigerSizeStorer* sizeStorer);
+
     virtual bool isDup(OperationContext* opCtx,
                        WT_CURSOR* c,
                        const KeyString::Value& keyString) = 0;
@@ -169,6 +181,18 @@ protected:
     void setKey(WT_CURSOR* cursor, const WT_ITEM* item);
     void getKey(OperationContext* opCtx, WT_CURSOR* cursor, WT_ITEM* key);
 
+    /**
+     * Adds 'diff' to the maintained key count, if any, and subtracts it again should the current
+     * unit of work roll back.
+     */
+    void _changeKeyCount(OperationContext* opCtx, long long diff);
+
+    /**
+     * Adds one key to the maintained key count, if any, for the bulk builders, whose writes are
+     * not part of the current unit of work.
+     */
+    void _addBulkLoadedKey();
+
     /*
      * Determines the data format version from application metadata and verifies compatibility.
      * Returns the corresponding KeyString version.
@@ -194,6 +218,11 @@ protected:
     const std::string _indexName;
     const BSONObj _keyPattern;
     const BSONObj _collation;
+
+    // Set by trackKeyCount(). '_keyCount' stays null until a key count exists for the index. Both
+    // are only written while no other operation can use the index.
+    WiredTigerSizeStorer* _sizeStorer = nullptr;
+    std::shared_ptr<WiredTigerSizeStorer::SizeInfo> _keyCount;
 };
 
 class WiredTigerIndexUnique : public WiredTigerIndex {
@@ -235,7 +264,18 @@ private:
      */
     bool _keyExists(OperationContext* opCtx, WT_CURSOR* c, const char* buffer, size_t size);
 
+    /**
+     * Fills '_keyFilter' with the prefix keys in the index. Must only be called while no other
+     * operation can write to the index.
+     */
+    void _buildKeyFilter(OperationContext* opCtx);
+
     bool _partial;
+
+    // Holds every prefix key inserted into the index since it was opened, and possibly keys that
+    // were removed or never committed since. Null unless enabled by
+    // 'wiredTigerUniqueIndexKeyFilterBitsPerKey'.
+    std::unique_ptr<BloomFilter> _keyFilter;
 };
 
 class WiredTigerIdIndex : public WiredTigerIndex {
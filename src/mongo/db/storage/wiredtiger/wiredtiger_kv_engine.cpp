@@ -81,16 +81,19 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_hot_idents_file.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_sizer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/exit.h"
@@ -101,6 +104,7 @@
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/testing_proctor.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 #if !defined(__has_feature)
 #define __has_feature(x) 0
@@ -244,6 +248,353 @@ private:
     stdx::condition_variable _condvar;
 };
 
+/**
+ * Periodically samples the cache usage of every ident into the engine's WiredTigerCacheUsageTable,
+ * when wiredTigerCacheUsageSampleIntervalSecs is set. Unless 'hotIdentsDbpath' is empty, every
+ * sample is also persisted there for the cache warmer of the next startup.
+ */
+class WiredTigerKVEngine::WiredTigerCacheUsageSampler : public BackgroundJob {
+public:
+    WiredTigerCacheUsageSampler(WT_CONNECTION* conn,
+                                ClockSource* clockSource,
+                                WiredTigerCacheUsageTable* table,
+                                std::string hotIdentsDbpath)
+        : BackgroundJob(false /* deleteSelf */),
+          _conn(conn),
+          _clockSource(clockSource),
+          _table(table),
+          _hotIdentsDbpath(std::move(hotIdentsDbpath)) {}
+
+    virtual string name() const {
+        return "WTCacheUsageSampler";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(6110000, 1, "starting {name} thread", "name"_attr = name());
+
+        while (!_shuttingDown.load()) {
+            _sample();
+
+            stdx::unique_lock<Latch> lock(_mutex);
+            MONGO_IDLE_THREAD_BLOCK;
+            _condvar.wait_for(lock,
+                              stdx::chrono::seconds(gWiredTigerCacheUsageSampleIntervalSecs),
+                              [&] { return _shuttingDown.load(); });
+        }
+        LOGV2_DEBUG(6110001, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    void _sample() {
+        WiredTigerSession session(_conn);
+        WT_SESSION* s = session.getSession();
+
+        std::vector<std::pair<std::string, WiredTigerCacheUsageTable::Counters>> samples;
+        for (auto&& ident : _listIdents(s)) {
+            if (_shuttingDown.load()) {
+                return;
+            }
+            if (auto counters = _readCounters(s, ident)) {
+                samples.emplace_back(std::move(ident), *counters);
+            }
+        }
+        _table->update(_clockSource->now(), samples);
+
+        if (!_hotIdentsDbpath.empty()) {
+            auto status =
+                WiredTigerHotIdentsFile::write(_hotIdentsDbpath, _table->getIdentsInCache());
+            if (!status.isOK()) {
+                LOGV2_WARNING(6112600,
+                              "Failed to persist the idents using the most cache",
+                              "error"_attr = status);
+            }
+        }
+    }
+
+    std::vector<std::string> _listIdents(WT_SESSION* s) {
+        std::vector<std::string> idents;
+        WT_CURSOR* c = nullptr;
+        // No need for a metadata:create cursor, since it gathers extra information and is slower.
+        if (s->open_cursor(s, "metadata:", nullptr, nullptr, &c) != 0) {
+            return idents;
+        }
+        ON_BLOCK_EXIT([&] { c->close(c); });
+
+        while (c->next(c) == 0) {
+            const char* raw;
+            c->get_key(c, &raw);
+            StringData key(raw);
+            if (key.startsWith(kTableUriPrefix)) {
+                idents.push_back(key.substr(kTableUriPrefix.size()).toString());
+            }
+        }
+        return idents;
+    }
+
+    boost::optional<WiredTigerCacheUsageTable::Counters> _readCounters(WT_SESSION* s,
+                                                                       const std::string& ident) {
+        // Reads all three statistics from one cursor, as opening a statistics cursor is the
+        // expensive part. The ident may be dropped at any point, in which case it is skipped.
+        WT_CURSOR* c = nullptr;
+        const std::string uri = "statistics:" + (kTableUriPrefix + ident);
+        if (s->open_cursor(s, uri.c_str(), nullptr, "statistics=(fast)", &c) != 0) {
+            return boost::none;
+        }
+        ON_BLOCK_EXIT([&] { c->close(c); });
+
+        auto read = [&](int key) -> boost::optional<long long> {
+            int64_t value;
+            c->set_key(c, key);
+            if (c->search(c) != 0 || c->get_value(c, nullptr, nullptr, &value) != 0) {
+                return boost::none;
+            }
+            return static_cast<long long>(value);
+        };
+        auto bytesInCache = read(WT_STAT_DSRC_CACHE_BYTES_INUSE);
+        auto pagesRead = read(WT_STAT_DSRC_CACHE_READ);
+        auto cleanEvicted = read(WT_STAT_DSRC_CACHE_EVICTION_CLEAN);
+        auto dirtyEvicted = read(WT_STAT_DSRC_CACHE_EVICTION_DIRTY);
+        if (!bytesInCache || !pagesRead || !cleanEvicted || !dirtyEvicted) {
+            return boost::none;
+        }
+        return WiredTigerCacheUsageTable::Counters{
+            *bytesInCache, *pagesRead, *cleanEvicted + *dirtyEvicted};
+    }
+
+    WT_CONNECTION* const _conn;
+    ClockSource* const _clockSource;
+    WiredTigerCacheUsageTable* const _table;
+    const std::string _hotIdentsDbpath;
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerCacheUsageSampler::_mutex");  // protects _condvar
+    stdx::condition_variable _condvar;
+};
+
+/**
+ * Once after startup, reads the idents persisted by the cache usage sampler of the previous run
+ * back into the cache, hottest first, when wiredTigerCacheWarmingMBPerSec is set. Each ident is
+ * scanned from its start until as many bytes as it held in the cache have been read. Warming stops
+ * early once the cache is mostly full, so that it never evicts pages that the workload has read in
+ * the meantime.
+ */
+class WiredTigerKVEngine::WiredTigerCacheWarmer : public BackgroundJob {
+public:
+    WiredTigerCacheWarmer(WT_CONNECTION* conn, std::string dbpath, long long bytesPerSecond)
+        : BackgroundJob(false /* deleteSelf */),
+          _conn(conn),
+          _dbpath(std::move(dbpath)),
+          _bytesPerSecond(bytesPerSecond) {}
+
+    virtual string name() const {
+        return "WTCacheWarmer";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(6112601, 1, "starting {name} thread", "name"_attr = name());
+
+        auto swIdents = WiredTigerHotIdentsFile::read(_dbpath);
+        if (!swIdents.isOK()) {
+            LOGV2(6112602,
+                  "Not warming the WiredTiger cache, no idents were persisted",
+                  "reason"_attr = swIdents.getStatus());
+            _setState(State::kNoHotIdents);
+            return;
+        }
+        const auto& idents = swIdents.getValue();
+        {
+            stdx::lock_guard<Latch> lock(_mutex);
+            _state = State::kRunning;
+            _identsToWarm = idents.size();
+        }
+
+        WiredTigerSession session(_conn);
+        for (const auto& [ident, bytesInCache] : idents) {
+            if (_shuttingDown.load()) {
+                _setState(State::kInterrupted);
+                break;
+            }
+            if (_isCacheFull(session.getSession())) {
+                _setState(State::kCacheFull);
+                break;
+            }
+            _warmIdent(session.getSession(), ident, bytesInCache);
+            _identsWarmed.fetchAndAdd(1);
+        }
+
+        {
+            stdx::lock_guard<Latch> lock(_mutex);
+            if (_state == State::kRunning) {
+                _state = State::kCompleted;
+            }
+            _durationMillis = _timer.millis();
+        }
+        LOGV2(6112603,
+              "Finished warming the WiredTiger cache",
+              "state"_attr = _stateName(),
+              "identsWarmed"_attr = _identsWarmed.load(),
+              "bytesRead"_attr = _bytesRead.load(),
+              "durationMillis"_attr = _durationMillis);
+    }
+
+    void appendStats(BSONObjBuilder* bob) const {
+        stdx::lock_guard<Latch> lock(_mutex);
+        bob->append("state", _stateNameInLock());
+        bob->appendNumber("identsToWarm", static_cast<long long>(_identsToWarm));
+        bob->appendNumber("identsWarmed", _identsWarmed.load());
+        bob->appendNumber("bytesRead", _bytesRead.load());
+        bob->appendNumber("durationMillis",
+                          _state == State::kRunning ? _timer.millis() : _durationMillis);
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    enum class State { kStarting, kNoHotIdents, kRunning, kCacheFull, kInterrupted, kCompleted };
+
+    // Warming stops once this fraction of the cache is in use.
+    static constexpr double kMaxCacheFillRatio = 0.8;
+
+    // How many records are read between two checks of the read rate.
+    static constexpr int kRecordsPerThrottleCheck = 64;
+
+    void _warmIdent(WT_SESSION* s, const std::string& ident, long long bytesInCache) {
+        // The raw cursor reads keys and values of any format, and the ident may have been dropped,
+        // in which case it is skipped.
+        WT_CURSOR* c = nullptr;
+        const std::string uri = kTableUriPrefix + ident;
+        if (s->open_cursor(s, uri.c_str(), nullptr, "raw", &c) != 0) {
+            return;
+        }
+        ON_BLOCK_EXIT([&] { c->close(c); });
+
+        long long identBytesRead = 0;
+        int ret = c->next(c);
+        for (int records = 1; ret == 0 && identBytesRead < bytesInCache; ++records) {
+            WT_ITEM key, value;
+            if (c->get_key(c, &key) != 0 || c->get_value(c, &value) != 0) {
+                return;
+            }
+            identBytesRead += key.size + value.size;
+            _bytesRead.fetchAndAdd(key.size + value.size);
+
+            if (records % kRecordsPerThrottleCheck == 0 && _isAheadOfRate()) {
+                // Release the page the cursor is positioned on, and resume right after the last
+                // key read once the rate allows.
+                std::string lastKey(static_cast<const char*>(key.data), key.size);
+                c->reset(c);
+                if (!_waitForRate()) {
+                    return;
+                }
+                WT_ITEM resumeKey;
+                resumeKey.data = lastKey.data();
+                resumeKey.size = lastKey.size();
+                c->set_key(c, &resumeKey);
+                int exact;
+                if (c->search_near(c, &exact) != 0) {
+                    return;
+                }
+                if (exact > 0) {
+                    continue;
+                }
+            }
+            ret = c->next(c);
+        }
+    }
+
+    Microseconds _microsAllowedSoFar() const {
+        return Microseconds(_bytesRead.load() * 1000 * 1000 / _bytesPerSecond);
+    }
+
+    bool _isAheadOfRate() const {
+        return _microsAllowedSoFar() > Microseconds(_timer.micros());
+    }
+
+    /**
+     * Waits until the bytes read so far are within the rate. Returns false if shutdown began.
+     */
+    bool _waitForRate() {
+        const auto wait = _microsAllowedSoFar() - Microseconds(_timer.micros());
+        stdx::unique_lock<Latch> lock(_mutex);
+        MONGO_IDLE_THREAD_BLOCK;
+        _condvar.wait_for(lock, wait.toSystemDuration(), [&] { return _shuttingDown.load(); });
+        return !_shuttingDown.load();
+    }
+
+    bool _isCacheFull(WT_SESSION* s) const {
+        auto getStat = [&](int key) {
+            return WiredTigerUtil::getStatisticsValue(s, "statistics:", "statistics=(fast)", key);
+        };
+        auto inUse = getStat(WT_STAT_CONN_CACHE_BYTES_INUSE);
+        auto max = getStat(WT_STAT_CONN_CACHE_BYTES_MAX);
+        if (!inUse.isOK() || !max.isOK() || max.getValue() <= 0) {
+            return true;
+        }
+        return inUse.getValue() >= kMaxCacheFillRatio * max.getValue();
+    }
+
+    void _setState(State state) {
+        stdx::lock_guard<Latch> lock(_mutex);
+        _state = state;
+    }
+
+    std::string _stateName() const {
+        stdx::lock_guard<Latch> lock(_mutex);
+        return _stateNameInLock();
+    }
+
+    std::string _stateNameInLock() const {
+        switch (_state) {
+            case State::kStarting:
+                return "starting";
+            case State::kNoHotIdents:
+                return "noHotIdents";
+            case State::kRunning:
+                return "running";
+            case State::kCacheFull:
+                return "cacheFull";
+            case State::kInterrupted:
+                return "interrupted";
+            case State::kCompleted:
+                return "completed";
+        }
+        MONGO_UNREACHABLE;
+    }
+
+    WT_CONNECTION* const _conn;
+    const std::string _dbpath;
+    const long long _bytesPerSecond;
+    const Timer _timer;
+    AtomicWord<bool> _shuttingDown{false};
+    AtomicWord<long long> _identsWarmed{0};
+    AtomicWord<long long> _bytesRead{0};
+
+    // Protects _condvar and the members below.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerCacheWarmer::_mutex");
+    stdx::condition_variable _condvar;
+    State _state = State::kStarting;
+    size_t _identsToWarm = 0;
+    long long _durationMillis = 0;
+};
+
 std::string toString(const StorageEngine::OldestActiveTransactionTimestampResult& r) {
     if (r.isOK()) {
         if (r.getValue()) {
@@ -261,6 +612,141 @@ std::string toString(const StorageEngine::OldestActiveTransactionTimestampResult
 namespace {
 TicketHolder openWriteTransaction(128);
 TicketHolder openReadTransaction(128);
+
+/**
+ * Periodically resizes the concurrent transaction tickets when
+ * wiredTigerAdaptiveConcurrentTransactions is enabled.
+ */
+class WiredTigerTicketSizerJob : public BackgroundJob {
+public:
+    explicit WiredTigerTicketSizerJob(WT_CONNECTION* conn)
+        : BackgroundJob(false /* deleteSelf */),
+          _conn(conn),
+          _write(&openWriteTransaction),
+          _read(&openReadTransaction) {}
+
+    virtual string name() const {
+        return "WTTicketSizer";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(6105700, 1, "starting {name} thread", "name"_attr = name());
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, stdx::chrono::seconds(1));
+            }
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            const double dirtyRatio = _getDirtyRatio();
+            _adjust("write", &_write, dirtyRatio);
+            _adjust("read", &_read, dirtyRatio);
+        }
+        LOGV2_DEBUG(6105701, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void appendStats(StringData pool, BSONObjBuilder* b) {
+        stdx::lock_guard<Latch> lock(_mutex);
+        (pool == "write" ? _write : _read).sizer.appendStats(b);
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    struct Pool {
+        explicit Pool(TicketHolder* holder)
+            : holder(holder),
+              sizer(gWiredTigerAdaptiveConcurrentTransactionsMin,
+                    gWiredTigerAdaptiveConcurrentTransactionsMax),
+              lastQueuedWaits(holder->totalQueuedWaits()),
+              lastQueuedMicros(holder->totalQueuedMicros()) {}
+
+        TicketHolder* const holder;
+        WiredTigerTicketSizer sizer;
+        long long lastQueuedWaits;
+        long long lastQueuedMicros;
+    };
+
+    double _getDirtyRatio() {
+        WiredTigerSession session(_conn);
+        auto getStat = [&](int key) {
+            return WiredTigerUtil::getStatisticsValue(
+                session.getSession(), "statistics:", "statistics=(fast)", key);
+        };
+        auto dirty = getStat(WT_STAT_CONN_CACHE_BYTES_DIRTY);
+        auto max = getStat(WT_STAT_CONN_CACHE_BYTES_MAX);
+        if (!dirty.isOK() || !max.isOK() || max.getValue() <= 0) {
+            return 0;
+        }
+        return static_cast<double>(dirty.getValue()) / max.getValue();
+    }
+
+    void _adjust(StringData poolName, Pool* pool, double dirtyRatio) {
+        TicketHolder* holder = pool->holder;
+        const int current = holder->outof();
+        int next;
+        {
+            stdx::lock_guard<Latch> lock(_mutex);
+            WiredTigerTicketSizer::Sample sample;
+            sample.queuedWaits = holder->totalQueuedWaits() - pool->lastQueuedWaits;
+            sample.queuedMicros = holder->totalQueuedMicros() - pool->lastQueuedMicros;
+            sample.dirtyRatio = dirtyRatio;
+            pool->lastQueuedWaits += sample.queuedWaits;
+            pool->lastQueuedMicros += sample.queuedMicros;
+
+            next = pool->sizer.nextSize(current, sample);
+            if (next == current) {
+                return;
+            }
+            LOGV2_DEBUG(6105702,
+                        1,
+                        "Resizing concurrent transaction tickets",
+                        "pool"_attr = poolName,
+                        "from"_attr = current,
+                        "to"_attr = next,
+                        "queuedWaits"_attr = sample.queuedWaits,
+                        "queuedMicros"_attr = sample.queuedMicros,
+                        "dirtyRatio"_attr = dirtyRatio);
+        }
+
+        // Shrinking waits for the tickets in use to come back, so it must not hold '_mutex'.
+        auto status = holder->resize(next);
+        if (!status.isOK()) {
+            LOGV2_WARNING(6105703,
+                          "Failed to resize concurrent transaction tickets",
+                          "pool"_attr = poolName,
+                          "to"_attr = next,
+                          "error"_attr = status);
+        }
+    }
+
+    WT_CONNECTION* const _conn;
+    AtomicWord<bool> _shuttingDown{false};
+
+    // Protects the sizers, which are read by serverStatus, and '_condvar'.
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketSizerJob::_mutex");
+    stdx::condition_variable _condvar;
+
+    Pool _write;
+    Pool _read;
+};
+
+// The ticket holders outlive any engine, so the job resizing them is owned here rather than by the
+// engine, and reported by the static WiredTigerKVEngine::appendGlobalStats().
+Mutex ticketSizerJobMutex = MONGO_MAKE_LATCH("ticketSizerJobMutex");
+std::unique_ptr<WiredTigerTicketSizerJob> ticketSizerJob;
 }  // namespace
 
 OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
@@ -516,6 +1002,34 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    if (gWiredTigerCacheUsageSampleIntervalSecs > 0) {
+        _cacheUsageSampler = std::make_unique<WiredTigerCacheUsageSampler>(
+            _conn, _clockSource, &_cacheUsageTable, _ephemeral || _readOnly ? "" : _path);
+        _cacheUsageSampler->go();
+    }
+
+    if (gWiredTigerCacheWarmingMBPerSec > 0 && !_ephemeral) {
+        _cacheWarmer = std::make_unique<WiredTigerCacheWarmer>(
+            _conn, _path, gWiredTigerCacheWarmingMBPerSec * 1024LL * 1024);
+        _cacheWarmer->go();
+    }
+
+    if (gWiredTigerAdaptiveConcurrentTransactions) {
+        stdx::lock_guard<Latch> lock(ticketSizerJobMutex);
+        invariant(!ticketSizerJob);
+        ticketSizerJob = std::make_unique<WiredTigerTicketSizerJob>(_conn);
+        ticketSizerJob->go();
+    }
+
+    {
+        ThreadPool::Options options;
+        options.poolName = "WiredTigerReadAhead";
+        options.minThreads = 0;
+        options.maxThreads = gWiredTigerReadAheadThreads;
+        _readAheadPool = std::make_unique<ThreadPool>(std::move(options));
+        _readAheadPool->startup();
+    }
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -598,12 +1112,18 @@ void WiredTigerKVEngine::notifyStartupComplete() {
 }
 
 void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
+    stdx::lock_guard<Latch> lock(ticketSizerJobMutex);
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
         BSONObjBuilder bbb(bb.subobjStart("write"));
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendQueueStats(&bbb);
+        if (ticketSizerJob) {
+            BSONObjBuilder adaptive(bbb.subobjStart("adaptive"));
+            ticketSizerJob->appendStats("write", &adaptive);
+        }
         bbb.done();
     }
     {
@@ -611,6 +1131,11 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendQueueStats(&bbb);
+        if (ticketSizerJob) {
+            BSONObjBuilder adaptive(bbb.subobjStart("adaptive"));
+            ticketSizerJob->appendStats("read", &adaptive);
+        }
         bbb.done();
     }
     bb.done();
@@ -718,11 +1243,31 @@ void WiredTigerKVEngine::cleanShutdown() {
 
     // these must be the last things we do before _conn->close();
     haltOplogManager(/*oplogRecordStore=*/nullptr, /*shuttingDown=*/true);
+    std::unique_ptr<WiredTigerTicketSizerJob> sizerJob;
+    {
+        stdx::lock_guard<Latch> lock(ticketSizerJobMutex);
+        sizerJob = std::move(ticketSizerJob);
+    }
+    if (sizerJob) {
+        sizerJob->shutdown();
+    }
+    if (_cacheUsageSampler) {
+        _cacheUsageSampler->shutdown();
+    }
+    if (_cacheWarmer) {
+        _cacheWarmer->shutdown();
+    }
     if (_sessionSweeper) {
         LOGV2(22318, "Shutting down session sweeper thread");
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_readAheadPool) {
+        // Read-ahead requests hold sessions from the session cache, so they must be drained
+        // before the cache shuts down.
+        _readAheadPool->shutdown();
+        _readAheadPool->join();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps.",
@@ -801,6 +1346,24 @@ Status WiredTigerKVEngine::okToRename(OperationContext* opCtx,
     return Status::OK();
 }
 
+bool WiredTigerKVEngine::appendIdentCacheUsage(StringData ident,
+                                               double scale,
+                                               BSONObjBuilder* bob) const {
+    return _cacheUsageTable.appendIdentUsage(ident, scale, bob);
+}
+
+void WiredTigerKVEngine::appendCacheUsageStats(BSONObjBuilder* bob) const {
+    if (_cacheUsageSampler) {
+        _cacheUsageTable.appendTopIdents(gWiredTigerCacheUsageTopIdents.load(), bob);
+    }
+}
+
+void WiredTigerKVEngine::appendCacheWarmingStats(BSONObjBuilder* bob) const {
+    if (_cacheWarmer) {
+        _cacheWarmer->appendStats(bob);
+    }
+}
+
 int64_t WiredTigerKVEngine::getIdentSize(OperationContext* opCtx, StringData ident) {
     WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSession();
     return WiredTigerUtil::getIdentSize(session->getSession(), _uri(ident));
@@ -1191,9 +1754,26 @@ WiredTigerKVEngine::beginNonBlockingBackup(OperationContext* opCtx,
                                            const StorageEngine::BackupOptions& options) {
     uassert(51034, "Cannot open backup cursor with in-memory mode.", !isEphemeral());
 
+    // WiredTiger only reports these as a generic EINVAL, once the backup cursor is opened.
+    if (options.incrementalBackup != options.thisBackupName.has_value()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "A backup must be named if and only if it is incremental");
+    }
+    if (options.srcBackupName && !options.incrementalBackup) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "Only an incremental backup can be taken relative to an earlier one");
+    }
+    if (options.srcBackupName && options.srcBackupName == options.thisBackupName) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "An incremental backup must be named differently from its source backup");
+    }
+    if (options.incrementalBackup && options.blockSizeMB < 1) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "The block size of an incremental backup must be at least 1MB");
+    }
+
     std::stringstream ss;
     if (options.incrementalBackup) {
-        invariant(options.thisBackupName);
         ss << "incremental=(enabled=true,force_stop=false,";
         ss << "granularity=" << options.blockSizeMB << "MB,";
         ss << "this_id=" << std::quoted(str::escape(*options.thisBackupName)) << ",";
@@ -1547,7 +2127,15 @@ Status WiredTigerKVEngine::createSortedDataInterface(OperationContext* opCtx,
         "collection_uuid"_attr = collOptions.uuid,
         "ident"_attr = ident,
         "config"_attr = config);
-    return wtRCToStatus(WiredTigerIndex::Create(opCtx, _uri(ident), config));
+    auto status = wtRCToStatus(WiredTigerIndex::Create(opCtx, _uri(ident), config));
+
+    // The key count of a partial index starts from zero here, so that it is known from then on.
+    // Indexes created before key counts were maintained only have one once validate stores it.
+    if (status.isOK() && desc->isPartial() && _sizeStorer) {
+        _sizeStorer->storeIndexKeyCount(_uri(ident),
+                                        std::make_shared<WiredTigerSizeStorer::SizeInfo>(0, 0));
+    }
+    return status;
 }
 
 Status WiredTigerKVEngine::importSortedDataInterface(OperationContext* opCtx,
@@ -1579,14 +2167,23 @@ std::unique_ptr<SortedDataInterface> WiredTigerKVEngine::getSortedDataInterface(
         invariant(!collOptions.clusteredIndex);
         return std::make_unique<WiredTigerIdIndex>(opCtx, _uri(ident), ident, desc, _readOnly);
     }
+
+    std::unique_ptr<WiredTigerIndex> index;
     if (desc->unique()) {
         invariant(!collOptions.clusteredIndex);
-        return std::make_unique<WiredTigerIndexUnique>(opCtx, _uri(ident), ident, desc, _readOnly);
+        index = std::make_unique<WiredTigerIndexUnique>(opCtx, _uri(ident), ident, desc, _readOnly);
+    } else {
+        auto keyFormat = (collOptions.clusteredIndex) ? KeyFormat::String : KeyFormat::Long;
+        index = std::make_unique<WiredTigerIndexStandard>(
+            opCtx, _uri(ident), ident, keyFormat, desc, _readOnly);
     }
 
-    auto keyFormat = (collOptions.clusteredIndex) ? KeyFormat::String : KeyFormat::Long;
-    return std::make_unique<WiredTigerIndexStandard>(
-        opCtx, _uri(ident), ident, keyFormat, desc, _readOnly);
+    // The filter of a partial index declares the documents it counts, so that a count with an
+    // equivalent query can be answered from the number of keys in the index.
+    if (desc->isPartial() && _sizeStorer) {
+        index->trackKeyCount(_sizeStorer.get());
+    }
+    return index;
 }
 
 std::unique_ptr<RecordStore> WiredTigerKVEngine::makeTemporaryRecordStore(OperationContext* opCtx,
@@ -1800,6 +2397,25 @@ bool WiredTigerKVEngine::supportsDirectoryPerDB() const {
     return true;
 }
 
+boost::optional<int64_t> WiredTigerKVEngine::getCacheDirtyBytes() const {
+    WiredTigerSession session(_conn);
+    auto dirty = WiredTigerUtil::getStatisticsValue(
+        session.getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    if (!dirty.isOK()) {
+        return boost::none;
+    }
+    return dirty.getValue();
+}
+
+bool WiredTigerKVEngine::isCheckpointRunning() const {
+    WiredTigerSession session(_conn);
+    auto running = WiredTigerUtil::getStatisticsValue(session.getSession(),
+                                                      "statistics:",
+                                                      "statistics=(fast)",
+                                                      WT_STAT_CONN_TXN_CHECKPOINT_RUNNING);
+    return running.isOK() && running.getValue() != 0;
+}
+
 void WiredTigerKVEngine::checkpoint() {
     const Timestamp stableTimestamp = getStableTimestamp();
     const Timestamp initialDataTimestamp = getInitialDataTimestamp();
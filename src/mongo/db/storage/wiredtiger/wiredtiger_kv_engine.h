@@ -42,6 +42,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cache_usage_table.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -53,6 +54,7 @@ namespace mongo {
 
 class ClockSource;
 class JournalListener;
+class ThreadPool;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
@@ -113,6 +115,10 @@ public:
 
     void checkpoint() override;
 
+    boost::optional<int64_t> getCacheDirtyBytes() const override;
+
+    bool isCheckpointRunning() const override;
+
     bool isDurable() const override {
         return _durable;
     }
@@ -193,6 +199,22 @@ public:
 
     int64_t getIdentSize(OperationContext* opCtx, StringData ident) override;
 
+    bool appendIdentCacheUsage(StringData ident,
+                               double scale,
+                               BSONObjBuilder* bob) const override;
+
+    /**
+     * Appends the idents whose pages moved in and out of the cache the most over the last sampling
+     * interval, if the cache usage sampler runs.
+     */
+    void appendCacheUsageStats(BSONObjBuilder* bob) const;
+
+    /**
+     * Appends the progress of reading the idents which held the most cache before the last
+     * shutdown back into the cache, if the cache warmer runs.
+     */
+    void appendCacheWarmingStats(BSONObjBuilder* bob) const;
+
     Status repairIdent(OperationContext* opCtx, StringData ident) override;
 
     Status recoverOrphanedIdent(OperationContext* opCtx,
@@ -293,10 +315,24 @@ public:
      *
      * A caller that simply wants to call `triggerOplogVisibilityUpdate` may do so without concern.
      */
+    /**
+     * Returns the pool running the best-effort read-ahead requests of forward record store scans.
+     */
+    ThreadPool* getReadAheadPool() const {
+        return _readAheadPool.get();
+    }
+
     WiredTigerOplogManager* getOplogManager() const {
         return _oplogManager.get();
     }
 
+    /**
+     * Returns the size storer, or nullptr if this engine does not persist size information.
+     */
+    WiredTigerSizeStorer* getSizeStorer() const {
+        return _sizeStorer.get();
+    }
+
     static void appendGlobalStats(BSONObjBuilder& b);
 
     Timestamp getStableTimestamp() const override;
@@ -362,6 +398,8 @@ public:
 
 private:
     class WiredTigerSessionSweeper;
+    class WiredTigerCacheUsageSampler;
+    class WiredTigerCacheWarmer;
 
     struct IdentToDrop {
         std::string uri;
@@ -456,6 +494,12 @@ private:
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
 
+    WiredTigerCacheUsageTable _cacheUsageTable;
+    std::unique_ptr<WiredTigerCacheUsageSampler> _cacheUsageSampler;
+    std::unique_ptr<WiredTigerCacheWarmer> _cacheWarmer;
+
+    std::unique_ptr<ThreadPool> _readAheadPool;
+
     std::string _rsOptions;
     std::string _indexOptions;
 
@@ -501,6 +501,111 @@ TEST_F(WiredTigerKVEngineTest, TestPinOldestTimestampErrors) {
     ASSERT_EQ(initTs, _engine->getOldestTimestamp());
 }
 
+TEST_F(WiredTigerKVEngineTest, BackupRejectsInvalidOptions) {
+    auto opCtxRaii = _makeOperationContext();
+    auto assertInvalid = [&](const StorageEngine::BackupOptions& options) {
+        ASSERT_EQ(_engine->beginNonBlockingBackup(opCtxRaii.get(), options).getStatus(),
+                  ErrorCodes::InvalidOptions);
+    };
+
+    StorageEngine::BackupOptions options;
+    options.incrementalBackup = true;
+    assertInvalid(options);
+
+    options.thisBackupName = "a";
+    options.srcBackupName = "a";
+    assertInvalid(options);
+
+    options.srcBackupName = boost::none;
+    options.blockSizeMB = 0;
+    assertInvalid(options);
+
+    StorageEngine::BackupOptions fullBackup;
+    fullBackup.srcBackupName = "a";
+    assertInvalid(fullBackup);
+}
+
+TEST_F(WiredTigerKVEngineTest, IncrementalBackupReturnsChangedBlocks) {
+    auto opCtxRaii = _makeOperationContext();
+    OperationContext* opCtx = opCtxRaii.get();
+
+    auto makeRecordStore = [&](const std::string& ident) {
+        NamespaceString nss("a." + ident);
+        ASSERT_OK(_engine->createRecordStore(opCtx, nss.ns(), ident, CollectionOptions()));
+        return _engine->getRecordStore(opCtx, nss.ns(), ident, CollectionOptions());
+    };
+    auto insertRecords = [&](RecordStore* rs, int numRecords) {
+        const std::string data(1024, 'x');
+        WriteUnitOfWork wuow(opCtx);
+        for (int i = 0; i < numRecords; ++i) {
+            ASSERT_OK(rs->insertRecord(opCtx, data.c_str(), data.size() + 1, Timestamp()));
+        }
+        wuow.commit();
+    };
+    auto readBlocks = [&](const StorageEngine::BackupOptions& options) {
+        auto cursor = unittest::assertGet(_engine->beginNonBlockingBackup(opCtx, options));
+        std::vector<StorageEngine::BackupBlock> blocks;
+        while (true) {
+            auto batch = unittest::assertGet(cursor->getNextBatch(16));
+            if (batch.empty()) {
+                break;
+            }
+            blocks.insert(blocks.end(), batch.begin(), batch.end());
+        }
+        _engine->endNonBlockingBackup(opCtx);
+        return blocks;
+    };
+    auto blocksOf = [&](const std::vector<StorageEngine::BackupBlock>& blocks,
+                        const std::string& ident) {
+        const auto path = _engine->getDataFilePathForIdent(ident)->string();
+        std::vector<StorageEngine::BackupBlock> fileBlocks;
+        std::copy_if(blocks.begin(),
+                     blocks.end(),
+                     std::back_inserter(fileBlocks),
+                     [&](const auto& block) { return block.filename == path; });
+        return fileBlocks;
+    };
+
+    auto changed = makeRecordStore("collection-changed");
+    auto unchanged = makeRecordStore("collection-unchanged");
+    insertRecords(changed.get(), 1000);
+    insertRecords(unchanged.get(), 1000);
+    _engine->flushAllFiles(opCtx, /*callerHoldsReadLock=*/false);
+
+    // The basis for incremental backups lists every file in its entirety.
+    StorageEngine::BackupOptions options;
+    options.incrementalBackup = true;
+    options.blockSizeMB = 1;
+    options.thisBackupName = "basis";
+    auto basisBlocks = readBlocks(options);
+    for (const auto& ident : {"collection-changed", "collection-unchanged"}) {
+        auto fileBlocks = blocksOf(basisBlocks, ident);
+        ASSERT_EQ(fileBlocks.size(), 1U);
+        ASSERT_EQ(fileBlocks[0].offset, 0U);
+        ASSERT_EQ(fileBlocks[0].length, fileBlocks[0].fileSize);
+    }
+
+    insertRecords(changed.get(), 1000);
+    _engine->flushAllFiles(opCtx, /*callerHoldsReadLock=*/false);
+
+    // The next backup only lists the ranges that changed since the basis, and an empty block for a
+    // file that did not change at all.
+    options.thisBackupName = "next";
+    options.srcBackupName = "basis";
+    auto nextBlocks = readBlocks(options);
+
+    auto changedBlocks = blocksOf(nextBlocks, "collection-changed");
+    ASSERT_GT(changedBlocks.size(), 0U);
+    for (const auto& block : changedBlocks) {
+        ASSERT_GT(block.length, 0U);
+        ASSERT_LTE(block.length, 1024U * 1024U);
+        ASSERT_LTE(block.offset + block.length, block.fileSize);
+    }
+
+    auto unchangedBlocks = blocksOf(nextBlocks, "collection-unchanged");
+    ASSERT_EQ(unchangedBlocks.size(), 1U);
+    ASSERT_EQ(unchangedBlocks[0].length, 0U);
+}
 
 std::unique_ptr<KVHarnessHelper> makeHelper(ServiceContext* svcCtx) {
     return std::make_unique<WiredTigerKVHarnessHelper>(svcCtx);
@@ -38,7 +38,9 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/static_assert.h"
@@ -60,14 +62,17 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_zstd_dictionary.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
@@ -113,6 +118,46 @@ void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
 
     fassertNoTrace(39998, appMetadata.getValue().getIntField("oplogKeyExtractionVersion") == 1);
 }
+
+/**
+ * Steps over 'numRecords' records following 'start' on a session of its own, which leaves the
+ * pages holding them in the cache for the scan that requested the read-ahead. This is purely an
+ * optimization, so any error simply ends the read-ahead.
+ */
+void readAheadRecords(WiredTigerSessionCache* sessionCache,
+                      const std::string& uri,
+                      KeyFormat keyFormat,
+                      const RecordId& start,
+                      int64_t numRecords) {
+    if (sessionCache->isShuttingDown()) {
+        return;
+    }
+
+    UniqueWiredTigerSession session = sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+    WT_CURSOR* c = nullptr;
+    if (s->open_cursor(s, uri.c_str(), nullptr, nullptr, &c) != 0) {
+        return;
+    }
+    ON_BLOCK_EXIT([&] { c->close(c); });
+
+    auto key = makeCursorKey(start, keyFormat);
+    if (auto itemPtr = stdx::get_if<WiredTigerItem>(&key)) {
+        c->set_key(c, itemPtr->Get());
+    } else {
+        c->set_key(c, stdx::get<int64_t>(key));
+    }
+
+    int exact;
+    if (c->search_near(c, &exact) != 0) {
+        return;
+    }
+    for (int64_t i = 0; i < numRecords; ++i) {
+        if (c->next(c) != 0) {
+            return;
+        }
+    }
+}
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(WTCompactRecordStoreEBUSY);
@@ -186,6 +231,7 @@ public:
 
         stdx::lock_guard<Latch> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_stonesVersion++;
     }
 
     void rollback() final {}
@@ -234,8 +280,20 @@ void WiredTigerRecordStore::OplogStones::kill() {
 }
 
 void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
-    // Wait until kill() is called or there are too many oplog stones.
+    // Wait until kill() is called, there are too many oplog stones, or the stones are due to be
+    // persisted.
     stdx::unique_lock<Latch> lock(_oplogReclaimMutex);
+
+    // Space out consecutive truncations. The caller has released its locks on the oplog, so
+    // writers are not held up while we wait.
+    auto truncationDelay = Milliseconds(gOplogTruncationDelayBetweenStonesMillis.load());
+    auto numStonesTruncated = _numStonesTruncated.load();
+    if (truncationDelay > Milliseconds(0) && numStonesTruncated != _numStonesTruncatedAtLastWait) {
+        MONGO_IDLE_THREAD_BLOCK;
+        _oplogReclaimCv.wait_for(lock, truncationDelay.toSystemDuration(), [&] { return _isDead; });
+    }
+    _numStonesTruncatedAtLastWait = numStonesTruncated;
+
     while (!_isDead) {
         {
             MONGO_IDLE_THREAD_BLOCK;
@@ -263,8 +321,18 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
                     break;
                 }
             }
+
+            // Return to the reclaim thread so that it persists the stones, see persistIfNeeded().
+            if (_needsPersist_inlock(Date_t::now())) {
+                break;
+            }
+        }
+
+        if (auto persistInterval = gOplogStonesPersistIntervalSeconds.load()) {
+            _oplogReclaimCv.wait_for(lock, Seconds(persistInterval).toSystemDuration());
+        } else {
+            _oplogReclaimCv.wait(lock);
         }
-        _oplogReclaimCv.wait(lock);
     }
 }
 
@@ -309,6 +377,8 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<Latch> lk(_mutex);
     _stones.pop_front();
+    _stonesVersion++;
+    _numStonesTruncated.fetchAndAdd(1);
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext* opCtx,
@@ -350,6 +420,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
 
     OplogStones::Stone stone(_currentRecords.swap(0), _currentBytes.swap(0), lastRecord, wallTime);
     _stones.push_back(stone);
+    _stonesVersion++;
 
     LOGV2_DEBUG(22381,
                 2,
@@ -396,6 +467,7 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    _stonesVersion++;
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -442,6 +514,10 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
         return;
     }
 
+    if (_loadPersistedStones(opCtx)) {
+        return;
+    }
+
     // Only use sampling to estimate where to place the oplog stones if the number of samples drawn
     // is less than 5% of the collection.
     const uint64_t kMinSampleRatioForRandCursor = 20;
@@ -464,6 +540,111 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
     _calculateStonesBySampling(opCtx, int64_t(estRecordsPerStone), int64_t(estBytesPerStone));
 }
 
+bool WiredTigerRecordStore::OplogStones::_loadPersistedStones(OperationContext* opCtx) {
+    if (!_rs->_sizeStorer) {
+        return false;
+    }
+
+    BSONObj persisted = _rs->_sizeStorer->loadOplogStones(_rs->_uri);
+    if (persisted.isEmpty() || persisted["stones"].type() != BSONType::Array) {
+        return false;
+    }
+
+    RecordId earliestRecord;
+    RecordId latestRecord;
+    {
+        auto record = _rs->getCursor(opCtx, true /* forward */)->next();
+        if (!record) {
+            return false;
+        }
+        earliestRecord = record->id;
+    }
+    {
+        auto record = _rs->getCursor(opCtx, false /* forward */)->next();
+        if (!record) {
+            return false;
+        }
+        latestRecord = record->id;
+    }
+
+    std::deque<OplogStones::Stone> stones;
+    for (auto&& elem : persisted["stones"].Obj()) {
+        if (elem.type() != BSONType::Object || !elem["lastRecord"].isNumber() ||
+            elem["wallTime"].type() != BSONType::Date) {
+            return false;
+        }
+        BSONObj stone = elem.Obj();
+        RecordId lastRecord(stone["lastRecord"].safeNumberLong());
+
+        // Stones that were already truncated, e.g. before an unclean shutdown, no longer apply.
+        if (lastRecord < earliestRecord) {
+            continue;
+        }
+
+        // Stones past the end of the oplog were rolled back since they were saved. The oplog after
+        // the last stone that still applies is accounted for by the scan below.
+        if (lastRecord > latestRecord) {
+            break;
+        }
+
+        if (!stones.empty() && lastRecord <= stones.back().lastRecord) {
+            LOGV2_WARNING(6101600,
+                          "Ignoring persisted oplog truncation points that are out of order",
+                          "lastRecord"_attr = lastRecord,
+                          "previousLastRecord"_attr = stones.back().lastRecord);
+            return false;
+        }
+
+        stones.emplace_back(stone["records"].safeNumberLong(),
+                            stone["bytes"].safeNumberLong(),
+                            lastRecord,
+                            stone["wallTime"].Date());
+    }
+
+    // Scan the oplog written after the last persisted stone. This is bounded, as the stones are
+    // persisted periodically; if it turns out to be large, sampling is cheaper.
+    const int64_t maxTailBytes = kMaxPersistedTailStones * _minBytesPerStone;
+    int64_t tailBytes = 0;
+    int64_t currentRecords = 0;
+    int64_t currentBytes = 0;
+    auto cursor = _rs->getCursor(opCtx, true /* forward */);
+    auto record = stones.empty() ? cursor->next() : cursor->seekNear(stones.back().lastRecord);
+    if (record && !stones.empty() && record->id <= stones.back().lastRecord) {
+        record = cursor->next();
+    }
+    for (; record; record = cursor->next()) {
+        tailBytes += record->data.size();
+        if (tailBytes > maxTailBytes) {
+            LOGV2(6101601,
+                  "Too much oplog follows the persisted oplog truncation points, ignoring them",
+                  "maxTailBytes"_attr = maxTailBytes);
+            return false;
+        }
+
+        currentRecords++;
+        currentBytes += record->data.size();
+        if (currentBytes >= _minBytesPerStone) {
+            BSONObj obj = record->data.toBson();
+            auto wallTime = obj.hasField("wall") ? obj["wall"].Date() : obj["ts"].timestampTime();
+            stones.emplace_back(currentRecords, currentBytes, record->id, wallTime);
+            currentRecords = 0;
+            currentBytes = 0;
+        }
+    }
+
+    LOGV2(6101602,
+          "Reusing persisted oplog truncation points",
+          "numStones"_attr = stones.size(),
+          "tailBytesScanned"_attr = tailBytes);
+
+    _stones = std::move(stones);
+    _currentRecords.store(currentRecords);
+    _currentBytes.store(currentBytes);
+    _processBySampling.store(false);
+    _loadedPersistedStones.store(true);
+    return true;
+}
+
 void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationContext* opCtx) {
     _processBySampling.store(false);  // process by scanning
     LOGV2(22384, "Scanning the oplog to determine where to place markers for truncation");
@@ -620,6 +801,68 @@ void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
     }
 }
 
+bool WiredTigerRecordStore::OplogStones::_needsPersist_inlock(Date_t now) const {
+    auto persistInterval = gOplogStonesPersistIntervalSeconds.load();
+    return _rs->_sizeStorer && persistInterval > 0 && _stonesVersion != _persistedStonesVersion &&
+        now - _lastPersistTime >= Seconds(persistInterval);
+}
+
+void WiredTigerRecordStore::OplogStones::persistIfNeeded() {
+    BSONObj persisted;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto now = Date_t::now();
+        if (!_needsPersist_inlock(now)) {
+            return;
+        }
+
+        BSONObjBuilder builder;
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (auto&& stone : _stones) {
+            stonesBuilder.append(BSON("records" << stone.records << "bytes" << stone.bytes
+                                                << "lastRecord" << stone.lastRecord.getLong()
+                                                << "wallTime" << stone.wallTime));
+        }
+        stonesBuilder.done();
+        persisted = builder.obj();
+
+        _persistedStonesVersion = _stonesVersion;
+        _lastPersistTime = now;
+    }
+
+    _rs->_sizeStorer->storeOplogStones(_rs->_uri, persisted);
+    _numPersists.fetchAndAdd(1);
+}
+
+void WiredTigerRecordStore::OplogStones::getOplogStonesStats(BSONObjBuilder& builder) const {
+    builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
+    StringData processingMethod = _processBySampling.load() ? "sampling"_sd : "scanning"_sd;
+    if (_loadedPersistedStones.load()) {
+        processingMethod = "persisted"_sd;
+    }
+    builder.append("processingMethod", processingMethod);
+    if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
+        builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        int64_t totalBytes = 0;
+        for (auto&& stone : _stones) {
+            totalBytes += stone.bytes;
+        }
+        builder.append("stoneCount", static_cast<long long>(_stones.size()));
+        builder.append("stonesTotalBytes", totalBytes);
+        builder.append("minBytesPerStone", _minBytesPerStone);
+        if (!_stones.empty()) {
+            builder.append("oldestStoneWallTime", _stones.front().wallTime);
+        }
+    }
+    builder.append("currentStoneBytes", _currentBytes.load());
+    builder.append("stonesTruncatedCount", _numStonesTruncated.load());
+    builder.append("stonesPersistedCount", _numPersists.load());
+}
+
 void WiredTigerRecordStore::OplogStones::adjust(int64_t maxSize) {
     stdx::lock_guard<Latch> reclaimLk(_oplogReclaimMutex);
     stdx::lock_guard<Latch> lk(_mutex);
@@ -1138,7 +1381,11 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
     invariant(_keyFormat == KeyFormat::Long);
 
+    // Save the stones before truncating, as a restart can discard the ones truncated since.
+    _oplogStones->persistIfNeeded();
+
     Timer timer;
+    int64_t numStonesTruncated = 0;
     while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
         invariant(stone->lastRecord.isValid());
 
@@ -1232,10 +1479,22 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
             _oplogStones->firstRecord = stone->lastRecord;
             _oplogFirstRecord = stone->lastRecord;
+            numStonesTruncated++;
         } catch (const WriteConflictException&) {
             LOGV2_DEBUG(
                 22400, 1, "Caught WriteConflictException while truncating oplog entries, retrying");
         }
+
+        // When truncation is spread out, the reclaim thread waits before the next stone, see
+        // awaitHasExcessStonesOrDead().
+        if (numStonesTruncated > 0 && gOplogTruncationDelayBetweenStonesMillis.load() > 0) {
+            break;
+        }
+    }
+
+    if (numStonesTruncated == 0) {
+        // The reclaim thread may have been woken up only to persist the stones.
+        return;
     }
 
     auto elapsedMicros = timer.micros();
@@ -1274,7 +1533,22 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     Record highestIdRecord;
     invariant(nRecords != 0);
 
+    // Positions of 'records' in the order they are written to the table. Writing in key order
+    // keeps the cursor moving forward through the tree instead of searching from the root for
+    // every record.
+    std::vector<size_t> insertOrder;
+
     if (_keyFormat == KeyFormat::Long) {
+        // Reserve all the RecordIds the batch needs with a single atomic increment.
+        RecordId nextReservedId;
+        if (!_isOplog) {
+            auto numNullIds = std::count_if(
+                records, records + nRecords, [](const Record& rec) { return rec.id.isNull(); });
+            if (numNullIds > 0) {
+                nextReservedId = _nextId(opCtx, numNullIds);
+            }
+        }
+
         // Non-clustered record stores will extract the RecordId key for the oplog and generate
         // unique int64_t RecordIds if RecordIds are not set.
         for (size_t i = 0; i < nRecords; i++) {
@@ -1289,15 +1563,26 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
                 // Some RecordStores, like TemporaryRecordStores, may want to set their own
                 // RecordIds.
                 if (record.id.isNull()) {
-                    record.id = _nextId(opCtx);
+                    record.id = nextReservedId;
+                    nextReservedId = RecordId(nextReservedId.getLong() + 1);
                 }
             }
             dassert(record.id > highestIdRecord.id);
             highestIdRecord = record;
         }
-    }
-
-    for (size_t i = 0; i < nRecords; i++) {
+    } else if (!std::is_sorted(records, records + nRecords, [](const Record& a, const Record& b) {
+                   return a.id < b.id;
+               })) {
+        // Clustered RecordIds are chosen by the caller and may arrive in any order.
+        insertOrder.resize(nRecords);
+        std::iota(insertOrder.begin(), insertOrder.end(), 0);
+        std::sort(insertOrder.begin(), insertOrder.end(), [&](size_t a, size_t b) {
+            return records[a].id < records[b].id;
+        });
+    }
+
+    for (size_t n = 0; n < nRecords; n++) {
+        size_t i = insertOrder.empty() ? n : insertOrder[n];
         auto& record = records[i];
         invariant(!record.id.isNull());
         invariant(!record_id_helpers::isReserved(record.id));
@@ -1694,6 +1979,13 @@ void WiredTigerRecordStore::appendCustomStats(OperationContext* opCtx,
         bob.append("creationString", metadataResult.getValue());
         // Type can be "lsm" or "file"
         bob.append("type", type);
+
+        WiredTigerConfigParser parser(metadataResult.getValue());
+        WT_CONFIG_ITEM blockCompressor;
+        if (parser.get("block_compressor", &blockCompressor) == 0) {
+            WiredTigerZstdDictionaries::appendStats(
+                StringData(blockCompressor.str, blockCompressor.len), &bob);
+        }
     }
 
     Status status =
@@ -1777,13 +2069,14 @@ void WiredTigerRecordStore::_initNextIdIfNeeded(OperationContext* opCtx) {
     _nextIdNum.store(nextId);
 }
 
-RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx) {
+RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx, int64_t count) {
     // Clustered record stores do not generate unique ObjectId's for RecordId's as the expectation
     // is for the caller to set the RecordId using the server generated ObjectId.
     invariant(_keyFormat == KeyFormat::Long);
     invariant(!_isOplog);
+    invariant(count > 0);
     _initNextIdIfNeeded(opCtx);
-    RecordId out = RecordId(_nextIdNum.fetchAndAdd(1));
+    RecordId out = RecordId(_nextIdNum.fetchAndAdd(count));
     invariant(out.isValid());
     return out;
 }
@@ -2061,9 +2354,48 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     metricsCollector.incrementOneDocRead(value.size);
 
     _lastReturnedId = id;
+    if (_readAhead) {
+        _maybeScheduleReadAhead(id);
+    }
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+void WiredTigerRecordStoreCursorBase::enableReadAhead() {
+    // Read-ahead only follows forward scans of regular collections. Reading ahead of the oplog
+    // could touch entries that are not yet visible.
+    if (!_forward || _rs._isOplog || !_rs._kvEngine || !_rs._kvEngine->getReadAheadPool()) {
+        return;
+    }
+    _readAhead = true;
+    _readAheadInFlight = std::make_shared<AtomicWord<bool>>(false);
+}
+
+void WiredTigerRecordStoreCursorBase::_maybeScheduleReadAhead(const RecordId& id) {
+    const int64_t windowSize = gWiredTigerCursorReadAheadRecords.load();
+    if (windowSize <= 0 || ++_recordsSinceReadAhead < std::max<int64_t>(windowSize / 2, 1)) {
+        return;
+    }
+    // Only keep one request per cursor outstanding. If the previous one is still running, the
+    // cursor is catching up with it and another request would read the same pages.
+    if (_readAheadInFlight->swap(true)) {
+        return;
+    }
+    _recordsSinceReadAhead = 0;
+
+    _rs._kvEngine->getReadAheadPool()->schedule(
+        [sessionCache = WiredTigerRecoveryUnit::get(_opCtx)->getSessionCache(),
+         uri = _rs.getURI(),
+         keyFormat = _rs.keyFormat(),
+         start = id,
+         windowSize,
+         inFlight = _readAheadInFlight](Status status) {
+            ON_BLOCK_EXIT([&] { inFlight->store(false); });
+            if (status.isOK()) {
+                readAheadRecords(sessionCache, uri, keyFormat, start, windowSize);
+            }
+        });
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
     invariant(_hasRestored);
     if (_forward && _oplogVisibleTs && id.getLong() > *_oplogVisibleTs) {
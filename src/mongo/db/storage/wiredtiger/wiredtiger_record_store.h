@@ -287,7 +287,10 @@ private:
                           const Timestamp* timestamps,
                           size_t nRecords);
 
-    RecordId _nextId(OperationContext* opCtx);
+    /**
+     * Reserves 'count' consecutive RecordIds and returns the first of them.
+     */
+    RecordId _nextId(OperationContext* opCtx, int64_t count = 1);
     RecordData _getData(const WiredTigerCursor& cursor) const;
 
 
@@ -388,6 +391,8 @@ public:
 
     boost::optional<Record> next();
 
+    void enableReadAhead() override;
+
     boost::optional<Record> seekExact(const RecordId& id);
 
     boost::optional<Record> seekNear(const RecordId& start);
@@ -424,12 +429,25 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Asks the engine's read-ahead pool to bring the records following 'id' into the cache once
+     * the cursor has consumed half of the previously requested window.
+     */
+    void _maybeScheduleReadAhead(const RecordId& id);
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
      * established.
      */
     boost::optional<std::int64_t> _oplogVisibleTs = boost::none;
+
+    bool _readAhead = false;
+    int64_t _recordsSinceReadAhead = 0;
+
+    // Set while a read-ahead request issued by this cursor is queued or running. Shared with the
+    // request so that it can outlive the cursor.
+    std::shared_ptr<AtomicWord<bool>> _readAheadInFlight;
 };
 
 class WiredTigerRecordStoreStandardCursor final : public WiredTigerRecordStoreCursorBase {
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/record_id_helpers.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store_test_harness.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Inserts batches of 'state.range(0)' documents into a fresh record store per iteration. Clustered
+ * record stores receive their RecordIds in random order, as a batch of unsorted _id values would.
+ */
+void insertBatches(benchmark::State& state, bool clustered) {
+    const auto batchSize = static_cast<size_t>(state.range(0));
+    WiredTigerHarnessHelper harnessHelper;
+
+    std::vector<BSONObj> docs;
+    for (size_t i = 0; i < batchSize; ++i) {
+        docs.push_back(BSON("_id" << OID::gen() << "i" << static_cast<long long>(i)));
+    }
+    std::shuffle(docs.begin(), docs.end(), std::mt19937{0});
+    std::vector<Timestamp> timestamps(batchSize, Timestamp());
+
+    int collectionNum = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        CollectionOptions options;
+        options.clusteredIndex = clustered;
+        auto rs = harnessHelper.newNonCappedRecordStore(
+            "test.bm" + std::to_string(collectionNum++), options);
+        auto opCtx = harnessHelper.newOperationContext();
+
+        std::vector<Record> records;
+        records.reserve(batchSize);
+        for (const auto& doc : docs) {
+            RecordId id =
+                clustered ? uassertStatusOK(record_id_helpers::keyForDoc(doc)) : RecordId();
+            records.push_back({id, RecordData(doc.objdata(), doc.objsize())});
+        }
+        state.ResumeTiming();
+
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_OK(rs->insertRecords(opCtx.get(), &records, timestamps));
+        wuow.commit();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+void BM_RecordStoreInsertBatch(benchmark::State& state) {
+    insertBatches(state, false /* clustered */);
+}
+
+void BM_ClusteredRecordStoreInsertBatch(benchmark::State& state) {
+    insertBatches(state, true /* clustered */);
+}
+
+BENCHMARK(BM_RecordStoreInsertBatch)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(BM_ClusteredRecordStoreInsertBatch)->Arg(1)->Arg(100)->Arg(1000);
+
+}  // namespace
+}  // namespace mongo
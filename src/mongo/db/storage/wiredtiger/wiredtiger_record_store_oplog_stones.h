@@ -65,13 +65,7 @@ public:
 
     void awaitHasExcessStonesOrDead();
 
-    void getOplogStonesStats(BSONObjBuilder& builder) const {
-        builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
-        if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
-            builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
-        }
-    }
+    void getOplogStonesStats(BSONObjBuilder& builder) const;
 
     boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
 
@@ -94,6 +88,11 @@ public:
     // Resize oplog size
     void adjust(int64_t maxSize);
 
+    // Saves the current stones through the size storer so the next startup can reuse them instead
+    // of scanning or sampling the oplog. Does nothing if the stones have not changed, or were saved
+    // less than 'oplogTruncationPointsPersistIntervalSeconds' ago.
+    void persistIfNeeded();
+
     // The start point of where to truncate next. Used by the background reclaim thread to
     // efficiently truncate records with WiredTiger by skipping over tombstones, etc.
     RecordId firstRecord;
@@ -121,11 +120,16 @@ public:
         return _processBySampling.load();
     }
 
+    bool loadedPersistedStones() const {
+        return _loadedPersistedStones.load();
+    }
+
 private:
     class InsertChange;
     class TruncateChange;
 
     void _calculateStones(OperationContext* opCtx, size_t size);
+    bool _loadPersistedStones(OperationContext* opCtx);
     void _calculateStonesByScanning(OperationContext* opCtx);
     void _calculateStonesBySampling(OperationContext* opCtx,
                                     int64_t estRecordsPerStone,
@@ -133,8 +137,14 @@ private:
 
     void _pokeReclaimThreadIfNeeded();
 
+    bool _needsPersist_inlock(Date_t now) const;
+
     static const uint64_t kRandomSamplesPerStone = 10;
 
+    // Upper bound, in multiples of '_minBytesPerStone', on how much oplog written after the last
+    // persisted stone is scanned at startup before sampling is used instead.
+    static const int64_t kMaxPersistedTailStones = 4;
+
     WiredTigerRecordStore* _rs;
 
     Mutex _oplogReclaimMutex;
@@ -144,6 +154,10 @@ private:
     // database, and false otherwise.
     bool _isDead = false;
 
+    // Value of '_numStonesTruncated' when the reclaim thread last waited for excess stones. Used to
+    // space out consecutive truncations. Protected by '_oplogReclaimMutex'.
+    long long _numStonesTruncatedAtLastWait = 0;
+
     // Minimum number of bytes the stone being filled should contain before it gets added to the
     // deque of oplog stones.
     int64_t _minBytesPerStone;
@@ -153,10 +167,20 @@ private:
     AtomicWord<int64_t> _totalTimeProcessing;  // Amount of time spent scanning and/or sampling the
                                                // oplog during start up, if any.
     AtomicWord<bool> _processBySampling;       // Whether the oplog was sampled or scanned.
+    AtomicWord<bool> _loadedPersistedStones;   // Whether persisted stones were reused.
+
+    AtomicWord<long long> _numStonesTruncated;  // Number of stones removed by truncation.
+    AtomicWord<long long> _numPersists;         // Number of times the stones were persisted.
 
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
     std::deque<OplogStones::Stone> _stones;  // front = oldest, back = newest.
+
+    // Bumped on every change to '_stones'. Compared against '_persistedStonesVersion' to skip
+    // persisting unchanged stones. Both are protected by '_mutex', as is '_lastPersistTime'.
+    uint64_t _stonesVersion = 1;
+    uint64_t _persistedStonesVersion = 0;
+    Date_t _lastPersistTime;
 };
 
 }  // namespace mongo
@@ -47,6 +47,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
@@ -916,6 +917,54 @@ TEST(WiredTigerRecordStoreTest, OplogStones_Duplicates) {
     }
 }
 
+// Stones persisted through the size storer are reused on the next startup, together with the oplog
+// written after the last persisted stone.
+TEST(WiredTigerRecordStoreTest, OplogStones_LoadPersistedStones) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    auto wtHarnessHelper = dynamic_cast<WiredTigerHarnessHelper*>(harnessHelper.get());
+    auto wtKvEngine = dynamic_cast<WiredTigerKVEngine*>(harnessHelper->getEngine());
+    WiredTigerSizeStorer* sizeStorer = wtKvEngine->getSizeStorer();
+    ASSERT(sizeStorer);
+
+    auto makeOplog = [&] {
+        std::unique_ptr<RecordStore> rs(wtHarnessHelper->newOplogRecordStoreNoInit(sizeStorer));
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        checked_cast<WiredTigerRecordStore*>(rs.get())->postConstructorInit(opCtx.get());
+        return rs;
+    };
+
+    std::unique_ptr<RecordStore> rs = makeOplog();
+    WiredTigerRecordStore* wtrs = checked_cast<WiredTigerRecordStore*>(rs.get());
+    wtrs->oplogStones()->setMinBytesPerStone(100);
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 1), 100), RecordId(1, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 2), 110), RecordId(1, 2));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 3), 50), RecordId(1, 3));
+        ASSERT_EQ(2U, wtrs->oplogStones()->numStones());
+    }
+
+    wtrs->oplogStones()->persistIfNeeded();
+    rs.reset();
+
+    // Make the whole oplog visible to the startup scan of the records after the last stone.
+    wtKvEngine->getOplogManager()->setOplogReadTimestamp(Timestamp(1, 3));
+
+    rs = makeOplog();
+    wtrs = checked_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    ASSERT(oplogStones->loadedPersistedStones());
+    ASSERT_EQ(2U, oplogStones->numStones());
+    ASSERT_EQ(1, oplogStones->currentRecords());
+    ASSERT_EQ(50, oplogStones->currentBytes());
+
+    BSONObjBuilder statsBuilder;
+    oplogStones->getOplogStonesStats(statsBuilder);
+    ASSERT_EQ("persisted", statsBuilder.obj()["processingMethod"].str());
+}
+
 TEST(WiredTigerRecordStoreTest, GetLatestOplogTest) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
@@ -965,6 +1014,43 @@ TEST(WiredTigerRecordStoreTest, GetLatestOplogTest) {
     ASSERT_EQ(tsThree, wtrs->getLatestOplogTimestamp(op1.get()));
 }
 
+// Cursors hand out RecordData pointing into WiredTiger's buffers, and scans rely on this to avoid
+// a copy per record. Only findRecord(), which outlives its cursor, returns owned data.
+TEST(WiredTigerRecordStoreTest, CursorsReturnUnownedRecordData) {
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    RecordId rid;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, Timestamp());
+        ASSERT_OK(res.getStatus());
+        rid = res.getValue();
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getCursor(opCtx.get());
+
+    auto record = cursor->next();
+    ASSERT(record);
+    ASSERT_FALSE(record->data.isOwned());
+
+    record = cursor->seekExact(rid);
+    ASSERT(record);
+    ASSERT_FALSE(record->data.isOwned());
+
+    record = cursor->seekNear(rid);
+    ASSERT(record);
+    ASSERT_FALSE(record->data.isOwned());
+
+    RecordData found;
+    ASSERT(rs->findRecord(opCtx.get(), rid, &found));
+    ASSERT_TRUE(found.isOwned());
+    ASSERT_EQ(0, strcmp("a", found.data()));
+}
+
 TEST(WiredTigerRecordStoreTest, CursorInActiveTxnAfterNext) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -1045,5 +1131,38 @@ TEST(WiredTigerRecordStoreTest, CursorInActiveTxnAfterSeek) {
     }
 }
 
+TEST(WiredTigerRecordStoreTest, ForwardScanWithReadAheadReturnsAllRecords) {
+    RAIIServerParameterControllerForTest readAheadController{"wiredTigerCursorReadAheadRecords",
+                                                             10};
+
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int numRecords = 100;
+    std::vector<RecordId> rids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < numRecords; i++) {
+            StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, Timestamp());
+            ASSERT_OK(res.getStatus());
+            rids.push_back(res.getValue());
+        }
+        uow.commit();
+    }
+
+    // Read-ahead requests run concurrently with the scan but never change what it returns.
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getCursor(opCtx.get());
+    cursor->enableReadAhead();
+    for (const auto& rid : rids) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(rid, record->id);
+    }
+    ASSERT_FALSE(cursor->next());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -65,7 +65,8 @@ public:
     /**
      * Create an oplog record store without calling postConstructorInit().
      */
-    std::unique_ptr<RecordStore> newOplogRecordStoreNoInit();
+    std::unique_ptr<RecordStore> newOplogRecordStoreNoInit(
+        WiredTigerSizeStorer* sizeStorer = nullptr);
 
     WT_CONNECTION* conn() {
         return _engine.getConnection();
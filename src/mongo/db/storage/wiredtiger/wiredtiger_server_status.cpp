@@ -40,6 +40,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
@@ -74,6 +75,26 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
     invariant(s);
     const string uri = "statistics:";
 
+    // The hot metrics are sampled by high resolution FTDC, so only read the handful of statistics
+    // needed rather than exporting the whole statistics cursor.
+    if (configElement.type() == Object && configElement.Obj()["hotMetricsOnly"].trueValue()) {
+        BSONObjBuilder bob;
+        {
+            BSONObjBuilder cache(bob.subobjStart("cache"));
+            auto appendStat = [&](StringData name, int key) {
+                auto value = WiredTigerUtil::getStatisticsValue(s, uri, "statistics=(fast)", key);
+                if (value.isOK()) {
+                    cache.append(name, static_cast<long long>(value.getValue()));
+                }
+            };
+            appendStat("bytes currently in the cache", WT_STAT_CONN_CACHE_BYTES_INUSE);
+            appendStat("tracked dirty bytes in the cache", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+            appendStat("maximum bytes configured", WT_STAT_CONN_CACHE_BYTES_MAX);
+        }
+        WiredTigerKVEngine::appendGlobalStats(bob);
+        return bob.obj();
+    }
+
     // Filter out unrelevant statistic fields.
     std::vector<std::string> fieldsToIgnore = {"LSM"};
 
@@ -90,6 +111,31 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
+    {
+        BSONObjBuilder subsection(bob.subobjStart("session cache"));
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendStats(&subsection);
+    }
+
+    {
+        BSONObjBuilder subsection(bob.subobjStart("group commit"));
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendGroupCommitStats(&subsection);
+    }
+
+    if (auto sizeStorer = _engine->getSizeStorer()) {
+        BSONObjBuilder subsection(bob.subobjStart("size storer"));
+        sizeStorer->appendStats(&subsection);
+    }
+
+    {
+        BSONObjBuilder subsection(bob.subobjStart("cacheUsage"));
+        _engine->appendCacheUsageStats(&subsection);
+    }
+
+    {
+        BSONObjBuilder subsection(bob.subobjStart("cacheWarming"));
+        _engine->appendCacheWarmingStats(&subsection);
+    }
+
     {
         BSONObjBuilder subsection(bob.subobjStart("oplog"));
         subsection.append("visibility timestamp",
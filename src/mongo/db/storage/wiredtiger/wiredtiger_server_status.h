@@ -37,6 +37,10 @@ class WiredTigerKVEngine;
 
 /**
  * Adds "wiredTiger" to the results of db.serverStatus().
+ *
+ * Passing {wiredTiger: {hotMetricsOnly: true}} restricts the section to the cache fill and dirty
+ * bytes and the concurrent transaction tickets, which are cheap enough to sample many times a
+ * second.
  */
 class WiredTigerServerStatusSection : public ServerStatusSection {
 public:
@@ -44,8 +44,11 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -200,11 +203,17 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+// Upper bound on the number of session cache partitions, regardless of the number of cores.
+constexpr unsigned long kMaxSessionCachePartitions = 64;
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _partitions(_makePartitions()),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -212,6 +221,7 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _partitions(_makePartitions()),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -325,6 +335,9 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         token = journalListener->getToken(opCtx);
     }
 
+    Timer waitTimer;
+    ON_BLOCK_EXIT([&] { _durableWaitMicros.record(waitTimer.micros()); });
+
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -332,8 +345,23 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
     uint32_t current = _lastSyncTime.loadRelaxed();  // synchronized with writes through mutex
     if (current != start) {
         // Someone else synced already since we read lastSyncTime, so we're done!
+        _callersServedByLastFlush++;
         return;
     }
+
+    // Let callers that arrive now read the current value of _lastSyncTime and queue up on the
+    // mutex, so that the flush below covers their writes too.
+    if (auto window = _groupCommitWindow_inlock(); window > Microseconds(0)) {
+        stdx::this_thread::sleep_for(window.toSystemDuration());
+        _groupCommitWaitMicros.fetchAndAdd(durationCount<Microseconds>(window));
+    }
+
+    if (_journalFlushes.load() > 0) {
+        _flushBatchSizes.record(_callersServedByLastFlush);
+        _avgFlushBatchSize = 0.9 * _avgFlushBatchSize + 0.1 * _callersServedByLastFlush;
+    }
+    _callersServedByLastFlush = 1;
+
     _lastSyncTime.store(current + 1);
 
     // Nobody has synched yet, so we have to sync ourselves.
@@ -346,7 +374,10 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
 
     // Use the journal when available, or a checkpoint otherwise.
     if (_engine && _engine->isDurable()) {
+        Timer flushTimer;
         invariantWTOK(_waitUntilDurableSession->log_flush(_waitUntilDurableSession, "sync=on"));
+        _avgFlushMicros = 0.9 * _avgFlushMicros + 0.1 * flushTimer.micros();
+        _journalFlushes.fetchAndAdd(1);
         LOGV2_DEBUG(22419, 4, "flushed journal");
     } else {
         invariantWTOK(_waitUntilDurableSession->checkpoint(_waitUntilDurableSession, nullptr));
@@ -362,24 +393,37 @@ void WiredTigerSessionCache::waitUntilPreparedUnitOfWorkCommitsOrAborts(Operatio
                                                                         std::uint64_t lastCount) {
     invariant(opCtx);
     stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
-    if (lastCount == _prepareCommitOrAbortCounter.loadRelaxed()) {
+    // Registering as a waiter before reading the counter pairs with the notifier bumping the
+    // counter before reading the number of waiters: either the notifier sees this waiter, or this
+    // waiter sees the new count and does not block.
+    _prepareConflictWaiters.fetchAndAdd(1);
+    ON_BLOCK_EXIT([&] { _prepareConflictWaiters.fetchAndSubtract(1); });
+    if (lastCount == _prepareCommitOrAbortCounter.load()) {
         opCtx->waitForConditionOrInterrupt(_prepareCommittedOrAbortedCond, lk, [&] {
-            return _prepareCommitOrAbortCounter.loadRelaxed() > lastCount;
+            return _prepareCommitOrAbortCounter.load() > lastCount;
         });
     }
 }
 
 void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
-    stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
     _prepareCommitOrAbortCounter.fetchAndAdd(1);
+    if (_prepareConflictWaiters.load() == 0) {
+        return;
+    }
+
+    // Taking the mutex ensures that a waiter which read the old count is already blocked on the
+    // condition variable by the time it is notified.
+    stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
     _prepareCommittedOrAbortedCond.notify_all();
 }
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lock(partition->mutex);
+        for (auto session : partition->sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -387,15 +431,104 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lock(partition->mutex);
+        for (auto session : partition->sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lock(partition->mutex);
+        count += partition->sessions.size();
+    }
+    return count;
+}
+
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) const {
+    long long localHits = 0;
+    long long steals = 0;
+    long long misses = 0;
+    for (auto&& partition : _partitions) {
+        localHits += partition->localHits.loadRelaxed();
+        steals += partition->steals.loadRelaxed();
+        misses += partition->misses.loadRelaxed();
+    }
+
+    builder->append("partitions", static_cast<long long>(_partitions.size()));
+    builder->append("sessions taken from own partition", localHits);
+    builder->append("sessions stolen from other partitions", steals);
+    builder->append("sessions opened on cache miss", misses);
+}
+
+void WiredTigerSessionCache::appendGroupCommitStats(BSONObjBuilder* builder) const {
+    builder->append("journal flushes", _journalFlushes.load());
+    builder->append("total group commit wait micros", _groupCommitWaitMicros.load());
+    {
+        BSONObjBuilder waitBuilder(builder->subobjStart("durable wait micros"));
+        _durableWaitMicros.append(&waitBuilder);
+    }
+    {
+        BSONObjBuilder batchBuilder(builder->subobjStart("callers per flush"));
+        _flushBatchSizes.append(&batchBuilder);
+    }
+}
+
+Microseconds WiredTigerSessionCache::_groupCommitWindow_inlock() const {
+    auto maxWindow = Microseconds(gWiredTigerJournalGroupCommitMaxWindowMicros.load());
+    if (maxWindow == Microseconds(0) || !_engine || !_engine->isDurable()) {
+        return Microseconds(0);
+    }
+
+    // A lone writer would only pay the extra latency, so wait only once flushes are observed to
+    // serve several callers. Waiting for half a flush at most bounds that cost while still giving
+    // writers arriving at a comparable rate a chance to join.
+    if (_avgFlushBatchSize < 2) {
+        return Microseconds(0);
+    }
+    return std::min(maxWindow, Microseconds(static_cast<long long>(_avgFlushMicros / 2)));
+}
+
+void WiredTigerSessionCache::Log2Histogram::record(uint64_t value) {
+    size_t bucket = value == 0 ? 0 : 64 - countLeadingZeros64(value);
+    _buckets[std::min(bucket, kNumBuckets - 1)].fetchAndAdd(1);
+}
+
+void WiredTigerSessionCache::Log2Histogram::append(BSONObjBuilder* builder) const {
+    std::array<long long, kNumBuckets> counts;
+    long long total = 0;
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        counts[i] = _buckets[i].load();
+        total += counts[i];
+    }
+    builder->append("count", total);
+
+    // Every value in bucket i is below 2^i, so percentiles are reported as that exclusive bound.
+    auto percentile = [&](double fraction) {
+        long long seen = 0;
+        for (size_t i = 0; i < kNumBuckets; ++i) {
+            seen += counts[i];
+            if (seen > 0 && seen >= fraction * total) {
+                return 1LL << i;
+            }
+        }
+        return 0LL;
+    };
+    builder->append("p50", percentile(0.5));
+    builder->append("p99", percentile(0.99));
+
+    BSONArrayBuilder bucketsBuilder(builder->subarrayStart("histogram"));
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        if (counts[i] == 0) {
+            continue;
+        }
+        BSONObjBuilder entryBuilder(bucketsBuilder.subobjStart());
+        entryBuilder.append("lessThan", 1LL << i);
+        entryBuilder.append("count", counts[i]);
+    }
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -407,14 +540,15 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lock(partition->mutex);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        auto& sessions = partition->sessions;
+        for (auto it = sessions.begin(); it != sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = sessions.erase(it);
                 sessionsToClose.push_back(session);
             } else {
                 ++it;
@@ -434,9 +568,18 @@ void WiredTigerSessionCache::closeAll() {
     SessionCache swap;
 
     {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        // Hold every partition's mutex while bumping the epoch, so that a concurrent release which
+        // rechecks the epoch under its partition's mutex cannot cache a session of the old epoch.
+        std::vector<stdx::unique_lock<Latch>> locks;
+        for (auto&& partition : _partitions) {
+            locks.emplace_back(partition->mutex);
+        }
+
         _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+        for (auto&& partition : _partitions) {
+            swap.insert(swap.end(), partition->sessions.begin(), partition->sessions.end());
+            partition->sessions.clear();
+        }
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -453,24 +596,71 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
+    const auto ownIndex = _getPartitionIndexForThisThread();
+    auto& ownPartition = *_partitions[ownIndex];
     {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
-            // Reset the idle time
-            cachedSession->setIdleExpireTime(Date_t::min());
+        stdx::lock_guard<Latch> lock(ownPartition.mutex);
+        if (auto cachedSession = _popSession(ownPartition)) {
+            ownPartition.localHits.fetchAndAddRelaxed(1);
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
+    // Our own partition is empty, so try to take an idle session from one of the others. A
+    // partition whose mutex is held is in use by its own threads and is skipped rather than waited
+    // for, since opening a new session is cheaper than queueing behind them.
+    for (size_t i = 1; i < _partitions.size(); ++i) {
+        auto& partition = *_partitions[(ownIndex + i) % _partitions.size()];
+        stdx::unique_lock<Latch> lock(partition.mutex, stdx::try_to_lock);
+        if (!lock.owns_lock()) {
+            continue;
+        }
+        if (auto cachedSession = _popSession(partition)) {
+            ownPartition.steals.fetchAndAddRelaxed(1);
+            return UniqueWiredTigerSession(cachedSession);
+        }
+    }
+
+    ownPartition.misses.fetchAndAddRelaxed(1);
+
     // Outside of the cache partition lock, but on release will be put back on the cache
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
 
+std::vector<std::unique_ptr<WiredTigerSessionCache::Partition>>
+WiredTigerSessionCache::_makePartitions() {
+    // One partition per core the process may run on.
+    auto numPartitions = std::min(std::max(ProcessInfo::getNumAvailableCores(), 1UL),
+                                  kMaxSessionCachePartitions);
+    std::vector<std::unique_ptr<Partition>> partitions;
+    for (unsigned long i = 0; i < numPartitions; ++i) {
+        partitions.push_back(std::make_unique<Partition>());
+    }
+    return partitions;
+}
+
+size_t WiredTigerSessionCache::_getPartitionIndexForThisThread() const {
+    // Threads are spread over the partitions in the order in which they first use a session cache.
+    static AtomicWord<unsigned> nextThreadIndex;
+    thread_local const unsigned threadIndex = nextThreadIndex.fetchAndAddRelaxed(1);
+    return threadIndex % _partitions.size();
+}
+
+WiredTigerSession* WiredTigerSessionCache::_popSession(Partition& partition) {
+    if (partition.sessions.empty()) {
+        return nullptr;
+    }
+
+    // Get the most recently used session so that if we discard sessions, we're discarding older
+    // ones
+    WiredTigerSession* cachedSession = partition.sessions.back();
+    partition.sessions.pop_back();
+    // Reset the idle time
+    cachedSession->setIdleExpireTime(Date_t::min());
+    return cachedSession;
+}
+
 void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     invariant(session);
     invariant(session->cursorsOut() == 0);
@@ -521,10 +711,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& partition = *_partitions[_getPartitionIndexForThisThread()];
+        stdx::lock_guard<Latch> lock(partition.mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
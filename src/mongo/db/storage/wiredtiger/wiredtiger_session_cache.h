@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <string>
 
@@ -39,9 +40,11 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -262,6 +265,18 @@ public:
      */
     size_t getIdleSessionsCount();
 
+    /**
+     * Appends the number of partitions of the cache together with counters of how sessions were
+     * handed out: from the calling thread's own partition, stolen from another partition, or newly
+     * opened because no idle session could be found.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+    /**
+     * Appends statistics about journal flushes issued by waitUntilDurable, for use in serverStatus.
+     */
+    void appendGroupCommitStats(BSONObjBuilder* builder) const;
+
     /**
      * Closes all cached sessions whose idle expiration time has been reached.
      */
@@ -303,7 +318,9 @@ public:
      *
      * Specifying Fsync::kJournal will flush only the (oplog) journal to disk. Callers are
      * serialized by a mutex and will return early if it is discovered that another thread started
-     * and completed a flush while they slept.
+     * and completed a flush while they slept. While flushes are observed to serve several callers,
+     * the caller about to flush first waits briefly for more callers to join it, see
+     * 'wiredTigerJournalGroupCommitMaxWindowMicros'.
      *
      * Specifying Fsync::kCheckpointStableTimestamp will take a checkpoint up to and including the
      * stable timestamp.
@@ -338,7 +355,7 @@ public:
 
     /**
      * Notifies waiters that the caller's perpared unit of work has ended (either committed or
-     * aborted).
+     * aborted). The notification is skipped when nobody is blocked on a prepare conflict.
      */
     void notifyPreparedUnitOfWorkHasCommittedOrAborted();
 
@@ -379,25 +396,95 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
 
-    // Bumped when all open sessions need to be closed
+    /**
+     * A free list of idle sessions with its own lock. Every thread returns its sessions to, and
+     * takes them from, the partition it is assigned to, so that threads running on different cores
+     * rarely contend on the same mutex. A thread whose partition is empty steals an idle session
+     * from another partition, skipping partitions whose lock is currently held.
+     */
+    struct Partition {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::Partition::mutex");
+        SessionCache sessions;
+
+        // Counted against the partition of the thread asking for a session, see appendStats().
+        AtomicWord<long long> localHits{0};
+        AtomicWord<long long> steals{0};
+        AtomicWord<long long> misses{0};
+    };
+
+    static std::vector<std::unique_ptr<Partition>> _makePartitions();
+
+    /**
+     * Returns the index of the partition assigned to the calling thread.
+     */
+    size_t _getPartitionIndexForThisThread() const;
+
+    /**
+     * Pops the most recently released session of 'partition'. Must be called with the partition's
+     * mutex held.
+     */
+    WiredTigerSession* _popSession(Partition& partition);
+
+    // Never resized after construction, so it may be read without holding any lock.
+    std::vector<std::unique_ptr<Partition>> _partitions;
+
+    // Bumped when all open sessions need to be closed. Only bumped while holding the mutexes of all
+    // the partitions.
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
 
     // Bumped when all open cursors need to be closed
     AtomicWord<unsigned long long> _cursorEpoch;  // atomic so we can check it outside of the lock
 
+    /**
+     * Counts samples in power-of-two buckets, bucket i > 0 holding values in [2^(i-1), 2^i), which
+     * is enough to estimate percentiles cheaply. Safe for concurrent use.
+     */
+    class Log2Histogram {
+    public:
+        void record(uint64_t value);
+
+        /**
+         * Appends the sample count, exclusive upper bounds for the 50th and 99th percentiles, and
+         * the non-empty buckets.
+         */
+        void append(BSONObjBuilder* builder) const;
+
+    private:
+        static constexpr size_t kNumBuckets = 32;
+        std::array<AtomicWord<long long>, kNumBuckets> _buckets{};
+    };
+
+    /**
+     * Returns how long the caller about to flush the journal should wait for other callers of
+     * waitUntilDurable to join it. Must be called with _lastSyncMutex held.
+     */
+    Microseconds _groupCommitWindow_inlock() const;
+
     // Counter and critical section mutex for waitUntilDurable
     AtomicWord<unsigned> _lastSyncTime;
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
 
+    // Adaptive group commit state, protected by _lastSyncMutex. Callers that return without
+    // flushing are counted towards the most recent flush, so batch sizes are approximate.
+    long long _callersServedByLastFlush = 0;
+    double _avgFlushBatchSize = 1;
+    double _avgFlushMicros = 0;
+
+    AtomicWord<long long> _journalFlushes{0};
+    AtomicWord<long long> _groupCommitWaitMicros{0};
+    Log2Histogram _durableWaitMicros;
+    Log2Histogram _flushBatchSizes;
+
     // Mutex and cond var for waiting on prepare commit or abort.
     Mutex _prepareCommittedOrAbortedMutex =
         MONGO_MAKE_LATCH("WiredTigerSessionCache::_prepareCommittedOrAbortedMutex");
     stdx::condition_variable _prepareCommittedOrAbortedCond;
     AtomicWord<std::uint64_t> _prepareCommitOrAbortCounter{0};
+    // Number of threads in waitUntilPreparedUnitOfWorkCommitsOrAborts(), so that committing or
+    // aborting a prepared transaction need not take the mutex when no reader is waiting on one.
+    AtomicWord<int> _prepareConflictWaiters{0};
 
     // Protects getting and setting the _journalListener below.
     Mutex _journalListenerMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_journalListenerMutex");
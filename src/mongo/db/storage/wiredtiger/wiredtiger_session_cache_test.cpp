@@ -33,9 +33,11 @@
 #include <string>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -114,4 +116,57 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, IdleSessionIsReusedByAnotherThread) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    { UniqueWiredTigerSession session = sessionCache->getSession(); }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    // The other thread is usually assigned another partition, which is empty, so it has to steal
+    // the idle session released by this thread.
+    size_t idleSessionsWhileInUse = 0;
+    stdx::thread([&] {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        idleSessionsWhileInUse = sessionCache->getIdleSessionsCount();
+    }).join();
+    ASSERT_EQUALS(idleSessionsWhileInUse, 0U);
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    BSONObjBuilder builder;
+    sessionCache->appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQUALS(stats["sessions opened on cache miss"].numberLong(), 1);
+    ASSERT_EQUALS(stats["sessions taken from own partition"].numberLong() +
+                      stats["sessions stolen from other partitions"].numberLong(),
+                  1);
+}
+
+TEST(WiredTigerSessionCacheTest, DurableWaitsAreCounted) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Without a storage engine there is no journal, so every wait takes a checkpoint instead.
+    const int kWaits = 3;
+    for (int i = 0; i < kWaits; i++) {
+        sessionCache->waitUntilDurable(nullptr,
+                                       WiredTigerSessionCache::Fsync::kJournal,
+                                       WiredTigerSessionCache::UseJournalListener::kSkip);
+    }
+
+    BSONObjBuilder builder;
+    sessionCache->appendGroupCommitStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQUALS(stats["journal flushes"].numberLong(), 0);
+    ASSERT_EQUALS(stats["total group commit wait micros"].numberLong(), 0);
+
+    auto waits = stats["durable wait micros"].Obj();
+    ASSERT_EQUALS(waits["count"].numberLong(), kWaits);
+    ASSERT_GTE(waits["p99"].numberLong(), waits["p50"].numberLong());
+    long long histogramCount = 0;
+    for (auto&& bucket : waits["histogram"].Array()) {
+        histogramCount += bucket["count"].numberLong();
+    }
+    ASSERT_EQUALS(histogramCount, kWaits);
+}
+
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <string_view>
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -74,8 +75,9 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
         return;
 
     // Ordering is important: as the entry may be flushed concurrently, set the dirty flag last.
-    stdx::lock_guard<Latch> lk(_bufferMutex);
-    auto& entry = _buffer[uri];
+    auto& shard = _bufferShards[_shardIndex(uri)];
+    stdx::lock_guard<Latch> lk(shard.mutex);
+    auto& entry = shard.buffer[uri];
     // During rollback it is possible to get a new SizeInfo. In that case clear the dirty flag,
     // so the SizeInfo can be destructed without triggering the dirty check invariant.
     if (entry && entry.get() != sizeInfo.get())
@@ -94,11 +96,26 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
 }
 
 std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(StringData uri) const {
+    auto sizeInfo = _load(uri);
+    return sizeInfo ? sizeInfo : std::make_shared<SizeInfo>();
+}
+
+void WiredTigerSizeStorer::storeIndexKeyCount(StringData uri, std::shared_ptr<SizeInfo> keyCount) {
+    store(_indexKeyCountKey(uri), std::move(keyCount));
+}
+
+std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::loadIndexKeyCount(
+    StringData uri) const {
+    return _load(_indexKeyCountKey(uri));
+}
+
+std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::_load(StringData uri) const {
     {
         // Check if we can satisfy the read from the buffer.
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        Buffer::const_iterator it = _buffer.find(uri);
-        if (it != _buffer.end())
+        const auto& shard = _bufferShards[_shardIndex(uri)];
+        stdx::lock_guard<Latch> bufferLock(shard.mutex);
+        Buffer::const_iterator it = shard.buffer.find(uri);
+        if (it != shard.buffer.end())
             return it->second;
     }
 
@@ -113,7 +130,7 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
         _cursor->set_key(_cursor, &key);
         int ret = _cursor->search(_cursor);
         if (ret == WT_NOTFOUND)
-            return std::make_shared<SizeInfo>();
+            return nullptr;
         invariantWTOK(ret);
     }
 
@@ -131,59 +148,161 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
-    Buffer buffer;
-    {
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+    // Detach every shard up front, so that stores arriving during the flush go to fresh buffers.
+    std::array<Buffer, kNumBufferShards> buffers;
+    size_t lastNonEmpty = kNumBufferShards;
+    long long numEntries = 0;
+    for (size_t i = 0; i < kNumBufferShards; ++i) {
+        {
+            stdx::lock_guard<Latch> bufferLock(_bufferShards[i].mutex);
+            _bufferShards[i].buffer.swap(buffers[i]);
+        }
+        if (!buffers[i].empty()) {
+            lastNonEmpty = i;
+            numEntries += buffers[i].size();
+        }
     }
 
-    if (buffer.empty())
+    if (lastNonEmpty == kNumBufferShards)
         return;  // Nothing to do.
 
-    Timer t;
-    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
-    {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
-            }
-        });
-
-        WT_SESSION* session = _session.getSession();
-        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
-
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-
-            // Ordering is important here: when the store method checks if the SizeInfo
-            // is dirty and it returns true, the current values of numRecords and dataSize must
-            // still be written back. So, the required order is to clear the dirty flag first.
-            SizeInfo& sizeInfo = *it->second;
-            sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
-
-            auto& uri = it->first;
-            LOGV2_DEBUG(22425,
-                        2,
-                        "WiredTigerSizeStorer::flush {uri} -> {data}",
-                        "uri"_attr = uri,
-                        "data"_attr = redact(data));
-            WiredTigerItem key(uri.c_str(), uri.size());
-            WiredTigerItem value(data.objdata(), data.objsize());
-            _cursor->set_key(_cursor, key.Get());
-            _cursor->set_value(_cursor, value.Get());
-            invariantWTOK(_cursor->insert(_cursor));
+    // On failure, place unwritten entries back into their shards, unless a newer value already
+    // exists.
+    ON_BLOCK_EXIT([this, &buffers]() {
+        for (size_t i = 0; i < kNumBufferShards; ++i) {
+            if (buffers[i].empty())
+                continue;
+            stdx::lock_guard<Latch> bufferLock(_bufferShards[i].mutex);
+            for (auto& it : buffers[i])
+                _bufferShards[i].buffer.try_emplace(it.first, it.second);
         }
-        txnOpen.done();
-        invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
+    });
+
+    Timer t;
+    for (size_t i = 0; i <= lastNonEmpty; ++i) {
+        if (buffers[i].empty())
+            continue;
+
+        // Only the final transaction needs to sync, as it makes all earlier commits durable too.
+        // The cursor mutex is released between shards to let loads of unbuffered entries through.
+        stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+        _flushBuffer(cursorLock, &buffers[i], syncToDisk && i == lastNonEmpty);
     }
 
     auto micros = t.micros();
+    _recordFlush(micros, numEntries);
     LOGV2_DEBUG(22426, 2, "WiredTigerSizeStorer flush took {micros} µs", "micros"_attr = micros);
 }
+
+void WiredTigerSizeStorer::storeOplogStones(StringData uri, const BSONObj& stones) {
+    if (_readOnly)
+        return;
+
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([this]() { _cursor->reset(_cursor); });
+
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, nullptr);
+
+    const std::string key = _oplogStonesKey(uri);
+    WiredTigerItem keyItem(key.c_str(), key.size());
+    WiredTigerItem valueItem(stones.objdata(), stones.objsize());
+    _cursor->set_key(_cursor, keyItem.Get());
+    _cursor->set_value(_cursor, valueItem.Get());
+    invariantWTOK(_cursor->insert(_cursor));
+
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
+}
+
+BSONObj WiredTigerSizeStorer::loadOplogStones(StringData uri) const {
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
+
+    _cursor->reset(_cursor);
+
+    const std::string key = _oplogStonesKey(uri);
+    WT_ITEM keyItem = {key.c_str(), key.size()};
+    _cursor->set_key(_cursor, &keyItem);
+    int ret = _cursor->search(_cursor);
+    if (ret == WT_NOTFOUND)
+        return BSONObj();
+    invariantWTOK(ret);
+
+    WT_ITEM value;
+    invariantWTOK(_cursor->get_value(_cursor, &value));
+    return BSONObj(reinterpret_cast<const char*>(value.data)).getOwned();
+}
+
+void WiredTigerSizeStorer::appendStats(BSONObjBuilder* builder) const {
+    builder->append("flushes", _numFlushes.load());
+    builder->append("entries flushed", _numEntriesFlushed.load());
+    builder->append("total flush time micros", _totalFlushMicros.load());
+
+    BSONArrayBuilder histogramBuilder(builder->subarrayStart("flush latency histogram"));
+    for (size_t i = 0; i < _flushLatencyBuckets.size(); ++i) {
+        BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+        entryBuilder.append("micros", i == 0 ? 0LL : kFlushLatencyBounds[i - 1]);
+        entryBuilder.append("count", _flushLatencyBuckets[i].load());
+    }
+}
+
+size_t WiredTigerSizeStorer::_shardIndex(StringData uri) {
+    // Deliberately not the StringMap hasher: reusing its bits would skew the distribution of
+    // entries within each shard's hash table.
+    return std::hash<std::string_view>{}(std::string_view(uri.rawData(), uri.size())) %
+        kNumBufferShards;
+}
+
+std::string WiredTigerSizeStorer::_oplogStonesKey(StringData uri) {
+    return uri.toString() + "|oplogStones";
+}
+
+std::string WiredTigerSizeStorer::_indexKeyCountKey(StringData uri) {
+    return uri.toString() + "|keyCount";
+}
+
+void WiredTigerSizeStorer::_flushBuffer(WithLock, Buffer* buffer, bool syncToDisk) {
+    ON_BLOCK_EXIT([this]() { _cursor->reset(_cursor); });
+
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+
+    for (auto it = buffer->begin(); it != buffer->end(); ++it) {
+
+        // Ordering is important here: when the store method checks if the SizeInfo
+        // is dirty and it returns true, the current values of numRecords and dataSize must
+        // still be written back. So, the required order is to clear the dirty flag first.
+        SizeInfo& sizeInfo = *it->second;
+        sizeInfo._dirty.store(false);
+        BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
+                                         << sizeInfo.dataSize.load());
+
+        auto& uri = it->first;
+        LOGV2_DEBUG(22425,
+                    2,
+                    "WiredTigerSizeStorer::flush {uri} -> {data}",
+                    "uri"_attr = uri,
+                    "data"_attr = redact(data));
+        WiredTigerItem key(uri.c_str(), uri.size());
+        WiredTigerItem value(data.objdata(), data.objsize());
+        _cursor->set_key(_cursor, key.Get());
+        _cursor->set_value(_cursor, value.Get());
+        invariantWTOK(_cursor->insert(_cursor));
+    }
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
+    buffer->clear();
+}
+
+void WiredTigerSizeStorer::_recordFlush(long long micros, long long numEntries) {
+    _numFlushes.fetchAndAdd(1);
+    _numEntriesFlushed.fetchAndAdd(numEntries);
+    _totalFlushMicros.fetchAndAdd(micros);
+
+    size_t bucket = 0;
+    while (bucket < kFlushLatencyBounds.size() && micros >= kFlushLatencyBounds[bucket])
+        ++bucket;
+    _flushLatencyBuckets[bucket].fetchAndAdd(1);
+}
 }  // namespace mongo
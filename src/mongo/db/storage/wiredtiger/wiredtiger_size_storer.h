@@ -29,14 +29,17 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/string_map.h"
 
 namespace mongo {
@@ -51,6 +54,10 @@ namespace mongo {
  * in size updates to be lost, so size information is only approximate. Reads use the buffer for
  * pending stores, or otherwise read directly from the WiredTiger table using a dedicated session
  * and cursor.
+ *
+ * The buffer is split into shards keyed by a hash of the URI, so that concurrent stores and loads
+ * of different collections rarely contend on the same mutex. Flushing writes one shard per
+ * WiredTiger transaction and releases the cursor between shards, keeping each write-back small.
  */
 class WiredTigerSizeStorer {
 public:
@@ -89,22 +96,80 @@ public:
 
     std::shared_ptr<SizeInfo> load(StringData uri) const;
 
+    /**
+     * Like store() and load(), for the number of keys in the index table 'uri', which is kept in
+     * 'numRecords'. Index key counts live in the same table under a derived key. Unlike load(),
+     * loadIndexKeyCount() returns null if no key count was ever stored for the index.
+     */
+    void storeIndexKeyCount(StringData uri, std::shared_ptr<SizeInfo> keyCount);
+    std::shared_ptr<SizeInfo> loadIndexKeyCount(StringData uri) const;
+
     /**
      * Writes all changes to the underlying table.
      */
     void flush(bool syncToDisk);
 
+    /**
+     * Durably replaces the oplog truncation points saved for the oplog table 'uri'. Unlike size
+     * information these are written immediately rather than buffered, as the oplog only saves them
+     * from its background reclaim thread. They live in the same table under a derived key.
+     */
+    void storeOplogStones(StringData uri, const BSONObj& stones);
+
+    /**
+     * Returns the truncation points last saved by storeOplogStones, or an empty object if none.
+     */
+    BSONObj loadOplogStones(StringData uri) const;
+
+    /**
+     * Appends flush counters and a flush latency histogram, for use in serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    static constexpr size_t kNumBufferShards = 16;
+
+    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
+
+    struct BufferShard {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSizeStorer::BufferShard::mutex");
+        Buffer buffer;
+    };
+
+    /**
+     * Upper bounds, in microseconds, of all but the last flush latency histogram bucket.
+     */
+    static constexpr std::array<long long, 4> kFlushLatencyBounds = {1000, 10000, 100000, 1000000};
+
+    static size_t _shardIndex(StringData uri);
+
+    static std::string _oplogStonesKey(StringData uri);
+
+    static std::string _indexKeyCountKey(StringData uri);
+
+    /**
+     * Returns the SizeInfo buffered or stored under 'key', or null if there is none.
+     */
+    std::shared_ptr<SizeInfo> _load(StringData key) const;
+
+    /**
+     * Writes the entries of 'buffer' in a single transaction. Requires holding _cursorMutex.
+     */
+    void _flushBuffer(WithLock, Buffer* buffer, bool syncToDisk);
+
+    void _recordFlush(long long micros, long long numEntries);
+
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor. Acquire *before* any BufferShard::mutex.
     mutable Mutex _cursorMutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::_cursorMutex");
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
-    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
+    std::array<BufferShard, kNumBufferShards> _bufferShards;
 
-    mutable Mutex _bufferMutex =
-        MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
-    Buffer _buffer;
+    AtomicWord<long long> _numFlushes{0};
+    AtomicWord<long long> _numEntriesFlushed{0};
+    AtomicWord<long long> _totalFlushMicros{0};
+    std::array<AtomicWord<long long>, kFlushLatencyBounds.size() + 1> _flushLatencyBuckets{};
 };
 }  // namespace mongo
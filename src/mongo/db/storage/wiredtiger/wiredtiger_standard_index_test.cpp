@@ -137,6 +137,10 @@ public:
         return std::make_unique<WiredTigerRecoveryUnit>(_sessionCache, &_oplogManager);
     }
 
+    WT_CONNECTION* conn() const {
+        return _conn;
+    }
+
 private:
     unittest::TempDir _dbpath;
     std::unique_ptr<ClockSource> _fastClockSource;
@@ -295,5 +299,61 @@ TEST(WiredTigerStandardIndexText, CursorInActiveTxnAfterSeekExact) {
     }
 }
 
+TEST(WiredTigerStandardIndexText, MaintainsKeyCountOfPartialIndex) {
+    WiredTigerIndexHarnessHelper harnessHelper;
+    bool unique = false;
+    bool partial = true;
+    auto sdi = harnessHelper.newSortedDataInterface(unique, partial, KeyFormat::Long);
+    auto index = checked_cast<WiredTigerIndex*>(sdi.get());
+    WiredTigerSizeStorer sizeStorer(harnessHelper.conn(), "table:sizeStorer");
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+    // Without a stored key count, the number of keys is unknown.
+    index->trackKeyCount(&sizeStorer);
+    ASSERT_FALSE(sdi->fastKeyCount(opCtx.get()));
+
+    sizeStorer.storeIndexKeyCount(index->uri(),
+                                  std::make_shared<WiredTigerSizeStorer::SizeInfo>(0, 0));
+    index->trackKeyCount(&sizeStorer);
+    ASSERT_EQ(0, *sdi->fastKeyCount(opCtx.get()));
+
+    auto ks1 = makeKeyString(sdi.get(), BSON("" << 1), RecordId(1));
+    auto ks2 = makeKeyString(sdi.get(), BSON("" << 2), RecordId(2));
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(sdi->insert(opCtx.get(), ks1, true));
+        ASSERT_OK(sdi->insert(opCtx.get(), ks2, true));
+        // A key which is already in the index is not counted twice.
+        ASSERT_OK(sdi->insert(opCtx.get(), ks2, true));
+        uow.commit();
+    }
+    ASSERT_EQ(2, *sdi->fastKeyCount(opCtx.get()));
+
+    // Changes of a unit of work which rolls back are not counted.
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        auto ks3 = makeKeyString(sdi.get(), BSON("" << 3), RecordId(3));
+        ASSERT_OK(sdi->insert(opCtx.get(), ks3, true));
+        sdi->unindex(opCtx.get(), ks1, true);
+        ASSERT_EQ(2, *sdi->fastKeyCount(opCtx.get()));
+    }
+    ASSERT_EQ(2, *sdi->fastKeyCount(opCtx.get()));
+
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        sdi->unindex(opCtx.get(), ks1, true);
+        // A key which is not in the index is not subtracted.
+        sdi->unindex(opCtx.get(), ks1, true);
+        uow.commit();
+    }
+    ASSERT_EQ(1, *sdi->fastKeyCount(opCtx.get()));
+
+    sdi->updateKeyCountAfterRepair(opCtx.get(), 5);
+    ASSERT_EQ(5, *sdi->fastKeyCount(opCtx.get()));
+
+    sizeStorer.flush(true);
+    ASSERT_EQ(5, sizeStorer.loadIndexKeyCount(index->uri())->numRecords.load());
+}
+
 }  // namespace
 }  // namespace mongo
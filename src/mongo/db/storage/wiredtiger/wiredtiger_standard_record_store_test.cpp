@@ -200,5 +200,38 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(), val);
 }
 
+// Entries spread over every buffer shard are all written back and counted by a single flush.
+TEST_F(SizeStorerUpdateTest, FlushWritesAllShards) {
+    const int kNumUris = 100;
+    std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> infos;
+    for (int i = 0; i < kNumUris; i++) {
+        infos.push_back(std::make_shared<WiredTigerSizeStorer::SizeInfo>(i, i * 10));
+        sizeStorer->store("table:sizeStorerShard" + std::to_string(i), infos.back());
+    }
+
+    sizeStorer->flush(true);
+
+    BSONObjBuilder bob;
+    sizeStorer->appendStats(&bob);
+    BSONObj stats = bob.obj();
+    ASSERT_EQUALS(1, stats["flushes"].numberLong());
+    ASSERT_EQUALS(kNumUris, stats["entries flushed"].numberLong());
+
+    long long histogramCount = 0;
+    for (auto&& bucket : stats["flush latency histogram"].Array())
+        histogramCount += bucket["count"].numberLong();
+    ASSERT_EQUALS(1, histogramCount);
+
+    // Read back through a fresh size storer so nothing can be served from the buffer.
+    WiredTigerSizeStorer reader(harnessHelper->conn(),
+                                WiredTigerKVEngine::kTableUriPrefix + "sizeStorer",
+                                false /* readOnly */);
+    for (int i = 0; i < kNumUris; i++) {
+        auto info = reader.load("table:sizeStorerShard" + std::to_string(i));
+        ASSERT_EQUALS(i, info->numRecords.load());
+        ASSERT_EQUALS(i * 10, info->dataSize.load());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_sizer.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+StringData toString(WiredTigerTicketSizer::Decision decision) {
+    switch (decision) {
+        case WiredTigerTicketSizer::Decision::kHold:
+            return "hold"_sd;
+        case WiredTigerTicketSizer::Decision::kIncrease:
+            return "increase"_sd;
+        case WiredTigerTicketSizer::Decision::kDecrease:
+            return "decrease"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace
+
+WiredTigerTicketSizer::WiredTigerTicketSizer(int minTickets, int maxTickets)
+    : _min(minTickets), _max(std::max(minTickets, maxTickets)) {}
+
+int WiredTigerTicketSizer::nextSize(int current, const Sample& sample) {
+    int next = current;
+    if (sample.dirtyRatio > kDirtyRatioBackoff) {
+        next = current - std::max(1, current / 4);
+    } else if (sample.queuedWaits > 0 &&
+               sample.queuedMicros / sample.queuedWaits >= kMinAverageQueuedMicros) {
+        next = current + kIncreaseStep;
+    }
+    next = std::clamp(next, _min, _max);
+
+    if (next > current) {
+        _lastDecision = Decision::kIncrease;
+        _increases++;
+    } else if (next < current) {
+        _lastDecision = Decision::kDecrease;
+        _decreases++;
+    } else {
+        _lastDecision = Decision::kHold;
+    }
+    return next;
+}
+
+void WiredTigerTicketSizer::appendStats(BSONObjBuilder* b) const {
+    b->append("minTickets", _min);
+    b->append("maxTickets", _max);
+    b->append("increases", _increases);
+    b->append("decreases", _decreases);
+    b->append("lastDecision", toString(_lastDecision));
+}
+
+}  // namespace mongo
@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+/**
+ * Decides how many concurrent transaction tickets a TicketHolder should offer, from what was
+ * observed over the last sampling interval. Tickets are added a few at a time while operations
+ * queue for them, and taken away multiplicatively while the cache holds too much dirty data, when
+ * more concurrency would only make eviction fall further behind.
+ *
+ * Not thread safe.
+ */
+class WiredTigerTicketSizer {
+public:
+    /**
+     * What was observed over one sampling interval.
+     */
+    struct Sample {
+        // Number of ticket acquisitions that had to wait, and for how long in total.
+        long long queuedWaits = 0;
+        long long queuedMicros = 0;
+
+        // Fraction of the cache holding dirty data.
+        double dirtyRatio = 0;
+    };
+
+    enum class Decision { kHold, kIncrease, kDecrease };
+
+    // Above this fraction of dirty cache the number of tickets is reduced.
+    static constexpr double kDirtyRatioBackoff = 0.15;
+
+    // The number of tickets added after an interval in which operations queued.
+    static constexpr int kIncreaseStep = 8;
+
+    // The average time an acquisition must have waited before an increase is worth it.
+    static constexpr long long kMinAverageQueuedMicros = 100;
+
+    WiredTigerTicketSizer(int minTickets, int maxTickets);
+
+    /**
+     * Returns the number of tickets to offer for the next interval, given the number offered now
+     * and what was observed over the interval that just ended. Always within [min, max].
+     */
+    int nextSize(int current, const Sample& sample);
+
+    Decision lastDecision() const {
+        return _lastDecision;
+    }
+
+    void appendStats(BSONObjBuilder* b) const;
+
+private:
+    const int _min;
+    const int _max;
+
+    Decision _lastDecision = Decision::kHold;
+    long long _increases = 0;
+    long long _decreases = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_sizer.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Sample = WiredTigerTicketSizer::Sample;
+using Decision = WiredTigerTicketSizer::Decision;
+
+TEST(WiredTigerTicketSizerTest, HoldsWithoutQueueingOrCachePressure) {
+    WiredTigerTicketSizer sizer(16, 256);
+    ASSERT_EQ(sizer.nextSize(128, Sample{}), 128);
+    ASSERT(sizer.lastDecision() == Decision::kHold);
+}
+
+TEST(WiredTigerTicketSizerTest, IncreasesAdditivelyWhileOperationsQueue) {
+    WiredTigerTicketSizer sizer(16, 140);
+    Sample sample{10, 10 * 1000, 0.05};
+    ASSERT_EQ(sizer.nextSize(128, sample), 128 + WiredTigerTicketSizer::kIncreaseStep);
+    ASSERT(sizer.lastDecision() == Decision::kIncrease);
+
+    // Never past the maximum.
+    ASSERT_EQ(sizer.nextSize(136, sample), 140);
+    ASSERT_EQ(sizer.nextSize(140, sample), 140);
+    ASSERT(sizer.lastDecision() == Decision::kHold);
+}
+
+TEST(WiredTigerTicketSizerTest, IgnoresBriefQueueing) {
+    WiredTigerTicketSizer sizer(16, 256);
+    ASSERT_EQ(sizer.nextSize(128, Sample{10, 10, 0}), 128);
+    ASSERT(sizer.lastDecision() == Decision::kHold);
+}
+
+TEST(WiredTigerTicketSizerTest, DecreasesMultiplicativelyUnderCachePressure) {
+    WiredTigerTicketSizer sizer(16, 256);
+
+    // Cache pressure wins over queueing.
+    Sample sample{10, 10 * 1000, 0.5};
+    ASSERT_EQ(sizer.nextSize(128, sample), 96);
+    ASSERT(sizer.lastDecision() == Decision::kDecrease);
+
+    // Never below the minimum.
+    ASSERT_EQ(sizer.nextSize(20, sample), 16);
+    ASSERT_EQ(sizer.nextSize(16, sample), 16);
+    ASSERT(sizer.lastDecision() == Decision::kHold);
+}
+
+TEST(WiredTigerTicketSizerTest, ReportsDecisions) {
+    WiredTigerTicketSizer sizer(16, 256);
+    sizer.nextSize(128, Sample{10, 10 * 1000, 0});
+    sizer.nextSize(136, Sample{0, 0, 0.5});
+    sizer.nextSize(102, Sample{0, 0, 0.5});
+
+    BSONObjBuilder bob;
+    sizer.appendStats(&bob);
+    auto stats = bob.obj();
+    ASSERT_EQ(stats["minTickets"].numberInt(), 16);
+    ASSERT_EQ(stats["maxTickets"].numberInt(), 256);
+    ASSERT_EQ(stats["increases"].numberLong(), 1);
+    ASSERT_EQ(stats["decreases"].numberLong(), 2);
+    ASSERT_EQ(stats["lastDecision"].str(), "decrease");
+}
+
+}  // namespace
+}  // namespace mongo
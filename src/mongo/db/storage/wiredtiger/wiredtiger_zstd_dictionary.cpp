@@ -0,0 +1,515 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_zstd_dictionary.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <memory>
+#include <zstd.h>
+
+#if __has_include(<zdict.h>)
+#include <zdict.h>
+#else
+#include <dictBuilder/zdict.h>
+#endif
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_file_util.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/ctype.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/static_immortal.h"
+#include "mongo/util/str.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+constexpr auto kFileExtension = ".dict"_sd;
+
+// Like WiredTiger's own zstd compressor, every compressed page starts with the length of the zstd
+// frame that follows, as the page handed back for decompression may be padded.
+constexpr size_t kLengthPrefixBytes = sizeof(uint64_t);
+
+struct DictionaryCompressor;
+
+// WiredTiger passes the callbacks the WT_COMPRESSOR they were registered with, which, as the first
+// member of a standard layout struct, leads back to its dictionary.
+struct WTDictionaryCompressor {
+    WT_COMPRESSOR wtCompressor;
+    DictionaryCompressor* compressor;
+};
+
+struct DictionaryCompressor {
+    DictionaryCompressor(std::string name, std::string dictionary);
+
+    WTDictionaryCompressor wt{};
+    const std::string name;
+    const std::string dictionary;
+    ZSTD_CDict* const cdict;
+    ZSTD_DDict* const ddict;
+
+    AtomicWord<long long> pagesCompressed{0};
+    AtomicWord<long long> uncompressedBytes{0};
+    AtomicWord<long long> compressedBytes{0};
+    AtomicWord<long long> compressMicros{0};
+    AtomicWord<long long> pagesDecompressed{0};
+    AtomicWord<long long> decompressMicros{0};
+};
+
+DictionaryCompressor* getDictionaryCompressor(WT_COMPRESSOR* wtCompressor) {
+    return reinterpret_cast<WTDictionaryCompressor*>(wtCompressor)->compressor;
+}
+
+struct ZstdContextDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+ZSTD_CCtx* getCompressionContext() {
+    thread_local std::unique_ptr<ZSTD_CCtx, ZstdContextDeleter> ctx(ZSTD_createCCtx());
+    return ctx.get();
+}
+
+ZSTD_DCtx* getDecompressionContext() {
+    thread_local std::unique_ptr<ZSTD_DCtx, ZstdContextDeleter> ctx(ZSTD_createDCtx());
+    return ctx.get();
+}
+
+int compressPage(WT_COMPRESSOR* wtCompressor,
+                 WT_SESSION* session,
+                 uint8_t* src,
+                 size_t srcLen,
+                 uint8_t* dst,
+                 size_t dstLen,
+                 size_t* resultLen,
+                 int* compressionFailed) {
+    auto compressor = getDictionaryCompressor(wtCompressor);
+    auto ctx = getCompressionContext();
+    if (!ctx) {
+        return ENOMEM;
+    }
+
+    Timer timer;
+    size_t ret = ZSTD_compress_usingCDict(ctx,
+                                          dst + kLengthPrefixBytes,
+                                          dstLen - kLengthPrefixBytes,
+                                          src,
+                                          srcLen,
+                                          compressor->cdict);
+    compressor->compressMicros.fetchAndAdd(timer.micros());
+    compressor->pagesCompressed.fetchAndAdd(1);
+    compressor->uncompressedBytes.fetchAndAdd(srcLen);
+
+    if (ZSTD_isError(ret)) {
+        *compressionFailed = 1;
+        LOGV2_ERROR(6114300,
+                    "zstd dictionary compression failed",
+                    "dictionary"_attr = compressor->name,
+                    "error"_attr = ZSTD_getErrorName(ret));
+        return WT_ERROR;
+    }
+
+    // WiredTiger writes the page uncompressed when compressing it would not make it smaller.
+    if (ret + kLengthPrefixBytes >= srcLen) {
+        compressor->compressedBytes.fetchAndAdd(srcLen);
+        *compressionFailed = 1;
+        return 0;
+    }
+
+    DataView(reinterpret_cast<char*>(dst)).write<LittleEndian<uint64_t>>(ret);
+    *resultLen = ret + kLengthPrefixBytes;
+    *compressionFailed = 0;
+    compressor->compressedBytes.fetchAndAdd(*resultLen);
+    return 0;
+}
+
+int decompressPage(WT_COMPRESSOR* wtCompressor,
+                   WT_SESSION* session,
+                   uint8_t* src,
+                   size_t srcLen,
+                   uint8_t* dst,
+                   size_t dstLen,
+                   size_t* resultLen) {
+    auto compressor = getDictionaryCompressor(wtCompressor);
+    if (srcLen < kLengthPrefixBytes) {
+        return WT_ERROR;
+    }
+    const uint64_t frameLen =
+        ConstDataView(reinterpret_cast<const char*>(src)).read<LittleEndian<uint64_t>>();
+    if (frameLen > srcLen - kLengthPrefixBytes) {
+        LOGV2_ERROR(6114301,
+                    "zstd dictionary compressed page is shorter than its frame",
+                    "dictionary"_attr = compressor->name,
+                    "pageBytes"_attr = srcLen,
+                    "frameBytes"_attr = frameLen);
+        return WT_ERROR;
+    }
+    auto ctx = getDecompressionContext();
+    if (!ctx) {
+        return ENOMEM;
+    }
+
+    Timer timer;
+    size_t ret = ZSTD_decompress_usingDDict(
+        ctx, dst, dstLen, src + kLengthPrefixBytes, frameLen, compressor->ddict);
+    compressor->decompressMicros.fetchAndAdd(timer.micros());
+    compressor->pagesDecompressed.fetchAndAdd(1);
+
+    if (ZSTD_isError(ret)) {
+        LOGV2_ERROR(6114302,
+                    "zstd dictionary decompression failed",
+                    "dictionary"_attr = compressor->name,
+                    "error"_attr = ZSTD_getErrorName(ret));
+        return WT_ERROR;
+    }
+    *resultLen = ret;
+    return 0;
+}
+
+int preSize(WT_COMPRESSOR* wtCompressor,
+            WT_SESSION* session,
+            uint8_t* src,
+            size_t srcLen,
+            size_t* resultLen) {
+    *resultLen = ZSTD_compressBound(srcLen) + kLengthPrefixBytes;
+    return 0;
+}
+
+DictionaryCompressor::DictionaryCompressor(std::string name, std::string dictionary)
+    : name(std::move(name)),
+      dictionary(std::move(dictionary)),
+      cdict(ZSTD_createCDict(this->dictionary.data(),
+                             this->dictionary.size(),
+                             wiredTigerGlobalOptions.zstdCompressorLevel)),
+      ddict(ZSTD_createDDict(this->dictionary.data(), this->dictionary.size())) {
+    wt.wtCompressor.compress = compressPage;
+    wt.wtCompressor.decompress = decompressPage;
+    wt.wtCompressor.pre_size = preSize;
+    wt.wtCompressor.terminate = nullptr;
+    wt.compressor = this;
+}
+
+/**
+ * Every dictionary registered with a connection. They are never freed: pages may be evicted, and
+ * so compressed, until the connection is closed, and a later connection in the same process (as
+ * on the journal to nojournal transition) registers the same ones again.
+ */
+struct Registry {
+    Mutex mutex = MONGO_MAKE_LATCH("WiredTigerZstdDictionaries::Registry::mutex");
+    StringMap<std::unique_ptr<DictionaryCompressor>> dictionaries;
+};
+
+Registry& getRegistry() {
+    static StaticImmortal<Registry> registry;
+    return *registry;
+}
+
+boost::filesystem::path getDirectory(const std::string& dbpath) {
+    return boost::filesystem::path(dbpath) /
+        WiredTigerZstdDictionaries::kDirectoryName.toString();
+}
+
+std::string getCompressorName(StringData name) {
+    return WiredTigerZstdDictionaries::kCompressorPrefix.toString() + name;
+}
+
+/**
+ * Registers the dictionary 'name' with 'conn', creating its compressor unless another connection
+ * already registered it.
+ */
+Status registerDictionary(WithLock,
+                          WT_CONNECTION* conn,
+                          const std::string& name,
+                          std::string dictionary) {
+    auto& registry = getRegistry();
+    auto it = registry.dictionaries.find(name);
+    if (it == registry.dictionaries.end()) {
+        auto compressor = std::make_unique<DictionaryCompressor>(name, std::move(dictionary));
+        if (!compressor->cdict || !compressor->ddict) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Invalid zstd dictionary '" << name << "'"};
+        }
+        it = registry.dictionaries.emplace(name, std::move(compressor)).first;
+    } else if (it->second->dictionary != dictionary) {
+        return {ErrorCodes::NamespaceExists,
+                str::stream() << "A different zstd dictionary named '" << name
+                              << "' is already registered"};
+    }
+
+    int ret = conn->add_compressor(
+        conn, getCompressorName(name).c_str(), &it->second->wt.wtCompressor, nullptr);
+    return wtRCToStatus(ret, "Failed to register a zstd dictionary compressor");
+}
+
+Status readDictionary(const boost::filesystem::path& path, std::string* dictionary) {
+    boost::system::error_code ec;
+    const auto fileSize = boost::filesystem::file_size(path, ec);
+    if (ec) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to read the size of " << path.string() << ": "
+                              << ec.message()};
+    }
+
+    dictionary->resize(fileSize);
+    std::ifstream ifs(path.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!ifs || !ifs.read(dictionary->data(), dictionary->size())) {
+        return {ErrorCodes::FileStreamFailed, str::stream() << "Failed to read " << path.string()};
+    }
+    return Status::OK();
+}
+
+Status writeDictionary(const boost::filesystem::path& path, const std::string& dictionary) {
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(path.parent_path(), ec);
+    if (ec) {
+        return {ErrorCodes::FileNotOpen,
+                str::stream() << "Failed to create " << path.parent_path().string() << ": "
+                              << ec.message()};
+    }
+    if (auto status = fsyncParentDirectory(path.parent_path()); !status.isOK()) {
+        return status;
+    }
+
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+        if (!ofs) {
+            return {ErrorCodes::FileNotOpen,
+                    str::stream() << "Failed to open " << tempPath.string() << ": "
+                                  << errnoWithDescription()};
+        }
+        ofs.write(dictionary.data(), dictionary.size());
+        if (!ofs) {
+            return {ErrorCodes::OperationFailed,
+                    str::stream() << "Failed to write " << tempPath.string() << ": "
+                                  << errnoWithDescription()};
+        }
+    }
+
+    if (auto status = fsyncFile(tempPath); !status.isOK()) {
+        return status;
+    }
+    try {
+        boost::filesystem::rename(tempPath, path);
+    } catch (const std::exception& ex) {
+        return {ErrorCodes::FileRenameFailed,
+                str::stream() << "Failed to rename " << tempPath.string() << " to "
+                              << path.string() << ": " << ex.what()};
+    }
+    return fsyncParentDirectory(path);
+}
+
+ServiceContext::ConstructorActionRegisterer registerZstdDictionaryExtension{
+    "RegisterWiredTigerZstdDictionaryExtension", [](ServiceContext* service) {
+        WiredTigerExtensions::get(service)->addExtension(
+            "local=(entry=mongo_wiredtiger_zstd_dictionary_init)");
+    }};
+
+}  // namespace
+
+Status WiredTigerZstdDictionaries::validateName(StringData name) {
+    if (name.empty() || name.size() > kMaxNameLength) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "A zstd dictionary name must have between 1 and "
+                              << kMaxNameLength << " characters"};
+    }
+    for (char c : name) {
+        if (!ctype::isAlnum(c) && c != '_') {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "A zstd dictionary name may only contain letters, digits "
+                                     "and underscores: '"
+                                  << name << "'"};
+        }
+    }
+    return Status::OK();
+}
+
+StatusWith<std::string> WiredTigerZstdDictionaries::train(const std::vector<std::string>& samples,
+                                                          size_t maxDictionaryBytes) {
+    std::string samplesBuffer;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        samplesBuffer.append(sample);
+        sampleSizes.push_back(sample.size());
+    }
+
+    std::string dictionary(maxDictionaryBytes, '\0');
+    size_t ret = ZDICT_trainFromBuffer(dictionary.data(),
+                                       dictionary.size(),
+                                       samplesBuffer.data(),
+                                       sampleSizes.data(),
+                                       sampleSizes.size());
+    if (ZDICT_isError(ret)) {
+        return {ErrorCodes::OperationFailed,
+                str::stream() << "Failed to train a zstd dictionary from " << samples.size()
+                              << " samples: " << ZDICT_getErrorName(ret)};
+    }
+    dictionary.resize(ret);
+    return dictionary;
+}
+
+Status WiredTigerZstdDictionaries::add(WT_CONNECTION* conn,
+                                       const std::string& dbpath,
+                                       StringData name,
+                                       const std::string& dictionary) {
+    if (auto status = validateName(name); !status.isOK()) {
+        return status;
+    }
+
+    auto& registry = getRegistry();
+    stdx::lock_guard<Latch> lk(registry.mutex);
+    const auto path = getDirectory(dbpath) / (name.toString() + kFileExtension);
+    if (registry.dictionaries.count(name) || boost::filesystem::exists(path)) {
+        return {ErrorCodes::NamespaceExists,
+                str::stream() << "A zstd dictionary named '" << name << "' already exists"};
+    }
+
+    // The dictionary is durable before any collection can be created with it, as the collection's
+    // pages cannot be read without it.
+    if (auto status = writeDictionary(path, dictionary); !status.isOK()) {
+        return status;
+    }
+    auto status = registerDictionary(lk, conn, name.toString(), dictionary);
+    if (!status.isOK()) {
+        boost::system::error_code ec;
+        boost::filesystem::remove(path, ec);
+        return status;
+    }
+
+    LOGV2(6114303,
+          "Added a zstd dictionary compressor",
+          "compressor"_attr = getCompressorName(name),
+          "dictionaryBytes"_attr = dictionary.size());
+    return Status::OK();
+}
+
+Status WiredTigerZstdDictionaries::registerAll(WT_CONNECTION* conn, const std::string& dbpath) {
+    const auto directory = getDirectory(dbpath);
+    boost::system::error_code ec;
+    if (!boost::filesystem::is_directory(directory, ec)) {
+        return Status::OK();
+    }
+
+    auto& registry = getRegistry();
+    stdx::lock_guard<Latch> lk(registry.mutex);
+    for (const auto& entry : boost::filesystem::directory_iterator(directory, ec)) {
+        const auto& path = entry.path();
+        if (path.extension().string() != kFileExtension) {
+            continue;
+        }
+
+        const auto name = path.stem().string();
+        if (auto status = validateName(name); !status.isOK()) {
+            return status.withContext(str::stream() << "Invalid dictionary " << path.string());
+        }
+        std::string dictionary;
+        if (auto status = readDictionary(path, &dictionary); !status.isOK()) {
+            return status;
+        }
+        if (auto status = registerDictionary(lk, conn, name, std::move(dictionary));
+            !status.isOK()) {
+            return status;
+        }
+        LOGV2(6114304,
+              "Registered a zstd dictionary compressor",
+              "compressor"_attr = getCompressorName(name));
+    }
+    if (ec) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to list " << directory.string() << ": " << ec.message()};
+    }
+    return Status::OK();
+}
+
+void WiredTigerZstdDictionaries::appendStats(StringData compressorName, BSONObjBuilder* builder) {
+    if (!compressorName.startsWith(kCompressorPrefix)) {
+        return;
+    }
+    const auto name = compressorName.substr(kCompressorPrefix.size());
+
+    auto& registry = getRegistry();
+    stdx::lock_guard<Latch> lk(registry.mutex);
+    auto it = registry.dictionaries.find(name);
+    if (it == registry.dictionaries.end()) {
+        return;
+    }
+    const auto& compressor = *it->second;
+
+    BSONObjBuilder bob(builder->subobjStart("zstdDictionary"));
+    bob.append("name", name);
+    bob.appendNumber("dictionaryBytes", static_cast<long long>(compressor.dictionary.size()));
+    const auto uncompressedBytes = compressor.uncompressedBytes.load();
+    const auto compressedBytes = compressor.compressedBytes.load();
+    bob.append("pagesCompressed", compressor.pagesCompressed.load());
+    bob.append("uncompressedBytes", uncompressedBytes);
+    bob.append("compressedBytes", compressedBytes);
+    bob.append("compressionRatio",
+               compressedBytes ? static_cast<double>(uncompressedBytes) / compressedBytes : 0.0);
+    bob.append("compressMicros", compressor.compressMicros.load());
+    bob.append("pagesDecompressed", compressor.pagesDecompressed.load());
+    bob.append("decompressMicros", compressor.decompressMicros.load());
+}
+
+}  // namespace mongo
+
+int mongo_wiredtiger_zstd_dictionary_init(WT_CONNECTION* conn, WT_CONFIG_ARG* config) {
+    using namespace mongo;
+    auto status = [&] {
+        try {
+            return WiredTigerZstdDictionaries::registerAll(conn, conn->get_home(conn));
+        } catch (...) {
+            return exceptionToStatus();
+        }
+    }();
+    if (!status.isOK()) {
+        LOGV2_ERROR(6114305, "Failed to register the zstd dictionaries", "error"_attr = status);
+        return EINVAL;
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <wiredtiger.h>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/compiler.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Block compressors that compress every page of a table with zstd against a dictionary trained
+ * from sampled documents, for collections of small documents that share most of their field names
+ * and value shapes but are too small for a page on its own to give zstd much history.
+ *
+ * WiredTiger names compressors per connection and never tells a compressor which table a page
+ * belongs to, so each dictionary is registered as its own compressor, named
+ * "zstd_dict_<name>", and a collection opts in with 'block_compressor=zstd_dict_<name>' in its
+ * WiredTiger configString. A page can only be decompressed with the dictionary it was written
+ * with, so a dictionary never changes once trained: retraining stores a dictionary under a new
+ * name for collections created afterwards.
+ *
+ * The dictionaries are kept in the 'zstd-dictionaries' directory of the dbpath and are registered
+ * by a WiredTiger extension run from wiredtiger_open, before recovery opens any table using them.
+ */
+class WiredTigerZstdDictionaries {
+public:
+    static constexpr StringData kCompressorPrefix = "zstd_dict_"_sd;
+    static constexpr StringData kDirectoryName = "zstd-dictionaries"_sd;
+    static constexpr size_t kMaxNameLength = 64;
+
+    /**
+     * Returns an error unless 'name' is a non-empty dictionary name of at most 'kMaxNameLength'
+     * letters, digits and underscores.
+     */
+    static Status validateName(StringData name);
+
+    /**
+     * Trains a dictionary of at most 'maxDictionaryBytes' from 'samples'.
+     */
+    static StatusWith<std::string> train(const std::vector<std::string>& samples,
+                                         size_t maxDictionaryBytes);
+
+    /**
+     * Durably stores 'dictionary' as 'name' under 'dbpath', then registers it with 'conn'. Fails
+     * with NamespaceExists if a dictionary of that name already exists.
+     */
+    static Status add(WT_CONNECTION* conn,
+                      const std::string& dbpath,
+                      StringData name,
+                      const std::string& dictionary);
+
+    /**
+     * Registers every dictionary stored under 'dbpath' with 'conn'.
+     */
+    static Status registerAll(WT_CONNECTION* conn, const std::string& dbpath);
+
+    /**
+     * Appends a 'zstdDictionary' subobject with the size and compression statistics of the
+     * dictionary used by the block compressor 'compressorName', if it is one of these. The
+     * statistics are shared by every collection using the dictionary.
+     */
+    static void appendStats(StringData compressorName, BSONObjBuilder* builder);
+};
+
+}  // namespace mongo
+
+/**
+ * The entry point of the WiredTiger extension that registers the stored dictionaries. It is
+ * looked up by name when WiredTiger loads the extension.
+ */
+extern "C" MONGO_COMPILER_API_EXPORT int mongo_wiredtiger_zstd_dictionary_init(
+    WT_CONNECTION* conn, WT_CONFIG_ARG* config);
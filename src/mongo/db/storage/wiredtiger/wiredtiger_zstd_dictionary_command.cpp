@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_zstd_dictionary.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_zstd_dictionary_gen.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Trains a zstd dictionary from documents sampled from a collection and registers it as the block
+ * compressor "zstd_dict_<name>", which collections created afterwards can use through their
+ * WiredTiger configString. The dictionary is only added to this node.
+ */
+class CmdTrainCompressionDictionary : public BasicCommand {
+public:
+    CmdTrainCompressionDictionary() : BasicCommand("trainCompressionDictionary") {}
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    std::string help() const override {
+        return "Train a zstd dictionary from sampled documents and register it as the WiredTiger "
+               "block compressor zstd_dict_<name>\n"
+               "{ trainCompressionDictionary: <collection>, name: <string>, "
+               "[sampleSize: <int>], [maxDictionaryBytes: <int>] }";
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) const override {
+        ActionSet actions;
+        actions.addAction(ActionType::compact);
+        out->push_back(Privilege(parseResourcePattern(dbname, cmdObj), actions));
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        auto request = TrainCompressionDictionaryCommand::parse(
+            IDLParserErrorContext("trainCompressionDictionary"), cmdObj);
+        uassertStatusOK(WiredTigerZstdDictionaries::validateName(request.getName()));
+
+        auto engine = dynamic_cast<WiredTigerKVEngine*>(
+            opCtx->getServiceContext()->getStorageEngine()->getEngine());
+        uassert(ErrorCodes::IllegalOperation,
+                "trainCompressionDictionary requires the WiredTiger storage engine",
+                engine);
+
+        std::vector<std::string> samples;
+        {
+            AutoGetCollectionForRead coll(opCtx, request.getNamespace());
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << request.getNamespace() << " does not exist",
+                    coll);
+
+            auto sampleSize = std::min<long long>(request.getSampleSize(), coll->numRecords(opCtx));
+            auto cursor = coll->getRecordStore()->getRandomCursor(opCtx);
+            uassert(6114306, "The collection does not support random sampling", cursor);
+            samples.reserve(sampleSize);
+            while (static_cast<long long>(samples.size()) < sampleSize) {
+                auto record = cursor->next();
+                if (!record) {
+                    break;
+                }
+                samples.emplace_back(record->data.data(), record->data.size());
+            }
+        }
+        uassert(ErrorCodes::IllegalOperation,
+                "Cannot train a dictionary from an empty collection",
+                !samples.empty());
+
+        auto dictionary = uassertStatusOK(
+            WiredTigerZstdDictionaries::train(samples, request.getMaxDictionaryBytes()));
+
+        WT_CONNECTION* conn = engine->getConnection();
+        uassertStatusOK(WiredTigerZstdDictionaries::add(
+            conn, conn->get_home(conn), request.getName(), dictionary));
+
+        result.append("blockCompressor",
+                      WiredTigerZstdDictionaries::kCompressorPrefix.toString() + request.getName());
+        result.appendNumber("samples", static_cast<long long>(samples.size()));
+        result.appendNumber("dictionaryBytes", static_cast<long long>(dictionary.size()));
+        return true;
+    }
+} cmdTrainCompressionDictionary;
+
+}  // namespace
+}  // namespace mongo
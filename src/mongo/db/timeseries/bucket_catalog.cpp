@@ -38,6 +38,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/platform/compiler.h"
@@ -76,6 +77,26 @@ void normalizeArray(BSONArrayBuilder* builder, const BSONObj& obj) {
     }
 }
 
+/**
+ * Hashes a metadata value such that values which only differ in the order of their (possibly
+ * nested) object fields, and are therefore equal once normalized, hash identically.
+ */
+std::size_t hashIgnoringFieldOrder(const BSONElement& elem) {
+    if (elem.type() != BSONType::Object && elem.type() != BSONType::Array) {
+        return absl::Hash<absl::string_view>{}(absl::string_view(elem.value(), elem.valuesize()));
+    }
+
+    // Combine the hashes of the fields commutatively so their order does not matter. The order of
+    // array elements is still captured by their field names.
+    std::size_t hash = 0;
+    for (auto&& field : elem.Obj()) {
+        hash += absl::Hash<std::pair<absl::string_view, std::size_t>>{}(
+            {absl::string_view(field.fieldName(), field.fieldNameSize() - 1),
+             hashIgnoringFieldOrder(field)});
+    }
+    return hash;
+}
+
 void normalizeObject(BSONObjBuilder* builder, const BSONObj& obj) {
     // BSONObjIteratorSorted provides an abstraction similar to what this function does. However it
     // is using a lexical comparison that is slower than just doing a binary comparison of the field
@@ -175,8 +196,8 @@ BucketCatalog& BucketCatalog::get(OperationContext* opCtx) {
     return get(opCtx->getServiceContext());
 }
 
-BSONObj BucketCatalog::getMetadata(Bucket* ptr) const {
-    BucketAccess bucket{const_cast<BucketCatalog*>(this), ptr};
+BSONObj BucketCatalog::getMetadata(const std::shared_ptr<WriteBatch>& batch) const {
+    BucketAccess bucket{const_cast<BucketCatalog*>(this), batch->bucket(), batch->_stripe};
     if (!bucket) {
         return {};
     }
@@ -190,7 +211,8 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
     const StringData::ComparatorInterface* comparator,
     const TimeseriesOptions& options,
     const BSONObj& doc,
-    CombineWithInsertsFromOtherClients combine) {
+    CombineWithInsertsFromOtherClients combine,
+    const BucketFinder& findBucket) {
 
     BSONElement metadata;
     auto metaFieldName = options.getMetaField();
@@ -211,7 +233,15 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
 
     auto time = timeElem.Date();
 
-    BucketAccess bucket{this, key, options, stats.get(), time};
+    // Reopening a bucket which is being compressed after it was closed would corrupt it, so this
+    // is only done when closed buckets are left as they are.
+    boost::optional<BucketToReopen> bucketToReopen;
+    if (findBucket && gTimeseriesReopenBucketsForLateMeasurements.load() &&
+        !gTimeseriesBucketCompressionOnClose.load()) {
+        bucketToReopen = _findBucketToReopen(key, options, time, findBucket);
+    }
+
+    BucketAccess bucket{this, key, options, stats.get(), time, bucketToReopen.get_ptr()};
     invariant(bucket);
 
     NewFieldNames newFieldNamesToBeInserted;
@@ -245,8 +275,9 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
         return false;
     };
 
+    boost::optional<OID> closedBucket;
     if (!bucket->_ns.isEmpty() && isBucketFull(&bucket)) {
-        bucket.rollover(isBucketFull);
+        closedBucket = bucket.rollover(isBucketFull);
         bucket->_calculateBucketFieldsAndSizeChange(doc,
                                                     options.getMetaField(),
                                                     &newFieldNamesToBeInserted,
@@ -255,6 +286,9 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
     }
 
     auto batch = bucket->_activeBatch(getOpId(opCtx, combine), stats);
+    if (closedBucket) {
+        batch->_closedBuckets.push_back(*closedBucket);
+    }
     batch->_addMeasurement(doc);
     batch->_recordNewFields(std::move(newFieldNamesToBeInserted));
 
@@ -269,10 +303,10 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
         key.metadata.normalize();
         bucket->_metadata = key.metadata;
 
-        // The namespace is stored two times: the bucket itself and _openBuckets.
+        // The namespace is stored two times: the bucket itself and openBuckets.
         // The metadata is stored two times, normalized and un-normalized. A unique pointer to the
-        // bucket is stored once: _allBuckets. A raw pointer to the bucket is stored at most twice:
-        // _openBuckets, _idleBuckets.
+        // bucket is stored once: allBuckets. A raw pointer to the bucket is stored at most twice:
+        // openBuckets, idleBuckets.
         bucket->_memoryUsage += (ns.size() * 2) + (bucket->_metadata.toBSON().objsize() * 2) +
             sizeof(Bucket) + sizeof(std::unique_ptr<Bucket>) + (sizeof(Bucket*) * 2);
     } else {
@@ -291,7 +325,7 @@ bool BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
 
     _waitToCommitBatch(batch);
 
-    BucketAccess bucket(this, batch->bucket(), BucketState::kPrepared);
+    BucketAccess bucket(this, batch->bucket(), batch->_stripe, BucketState::kPrepared);
     if (batch->finished()) {
         // Someone may have aborted it while we were waiting.
         return false;
@@ -309,14 +343,17 @@ bool BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
     return true;
 }
 
-void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info) {
+std::vector<OID> BucketCatalog::finish(std::shared_ptr<WriteBatch> batch,
+                                       const CommitInfo& info) {
     invariant(!batch->finished());
     invariant(!batch->active());
 
     Bucket* ptr(batch->bucket());
+    auto closedBuckets = std::move(batch->_closedBuckets);
     batch->_finish(info);
 
-    BucketAccess bucket(this, ptr, BucketState::kNormal);
+    auto& stripe = _stripes[batch->_stripe];
+    BucketAccess bucket(this, ptr, batch->_stripe, BucketState::kNormal);
     if (bucket) {
         bucket->_preparedBatch.reset();
     }
@@ -338,11 +375,11 @@ void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo&
         // It's possible that we cleared the bucket in between preparing the commit and finishing
         // here. In this case, we should abort any other ongoing batches and clear the bucket from
         // the catalog so it's not hanging around idle.
-        auto lk = _lockExclusive();
-        if (_allBuckets.contains(ptr)) {
+        stdx::lock_guard stripeLock{stripe.mutex};
+        if (stripe.allBuckets.contains(ptr)) {
             stdx::unique_lock blk{ptr->_mutex};
             ptr->_preparedBatch.reset();
-            _abort(blk, ptr, nullptr, boost::none);
+            _abort(&stripe, stripeLock, blk, ptr, nullptr, boost::none);
         }
     } else if (bucket->allCommitted()) {
         if (bucket->_full) {
@@ -351,21 +388,24 @@ void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo&
             _memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
 
             bucket.release();
-            auto lk = _lockExclusive();
+            stdx::lock_guard stripeLock{stripe.mutex};
 
-            // Only remove from _allBuckets and _idleBuckets. If it was marked full, we know that
+            // Only remove from allBuckets and idleBuckets. If it was marked full, we know that
             // happened in BucketAccess::rollover, and that there is already a new open bucket for
             // this metadata.
-            _markBucketNotIdle(ptr, false /* locked */);
+            _markBucketNotIdle(&stripe, ptr, false /* locked */);
             {
                 stdx::lock_guard statesLk{_statesMutex};
                 _bucketStates.erase(ptr->_id);
             }
-            _allBuckets.erase(ptr);
+            closedBuckets.push_back(ptr->_id);
+            stripe.allBuckets.erase(ptr);
         } else {
             _markBucketIdle(bucket);
         }
     }
+
+    return closedBuckets;
 }
 
 void BucketCatalog::abort(std::shared_ptr<WriteBatch> batch,
@@ -381,18 +421,24 @@ void BucketCatalog::abort(std::shared_ptr<WriteBatch> batch,
     Bucket* bucket = batch->bucket();
 
     // Before we access the bucket, make sure it's still there.
-    auto lk = _lockExclusive();
-    if (!_allBuckets.contains(bucket)) {
+    auto& stripe = _stripes[batch->_stripe];
+    stdx::lock_guard stripeLock{stripe.mutex};
+    if (!stripe.allBuckets.contains(bucket)) {
         // Special case, bucket has already been cleared, and we need only abort this batch.
         batch->_abort(status, false);
         return;
     }
 
     stdx::unique_lock blk{bucket->_mutex};
-    _abort(blk, bucket, batch, status);
+    _abort(&stripe, stripeLock, blk, bucket, batch, status);
 }
 
 void BucketCatalog::clear(const OID& oid) {
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        _numClears.fetchAndAdd(1);
+    }
+
     auto result = _setBucketState(oid, BucketState::kCleared);
     if (result && *result == BucketState::kPreparedAndCleared) {
         hangTimeseriesDirectModificationBeforeWriteConflict.pauseWhileSet();
@@ -401,20 +447,40 @@ void BucketCatalog::clear(const OID& oid) {
 }
 
 void BucketCatalog::clear(const std::function<bool(const NamespaceString&)>& shouldClear) {
-    auto lk = _lockExclusive();
-    auto statsLk = _statsMutex.lockExclusive();
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        _numClears.fetchAndAdd(1);
+    }
+
+    // Only lock one stripe at a time, so that writers to the other stripes can proceed.
+    stdx::unordered_set<NamespaceString> clearedNamespaces;
+    for (auto& stripe : _stripes) {
+        stdx::lock_guard stripeLock{stripe.mutex};
+        for (auto it = stripe.allBuckets.begin(); it != stripe.allBuckets.end();) {
+            auto nextIt = std::next(it);
+
+            const auto& bucket = *it;
+            stdx::unique_lock blk{bucket->_mutex};
+            if (shouldClear(bucket->_ns)) {
+                clearedNamespaces.insert(bucket->_ns);
+                _abort(&stripe, stripeLock, blk, bucket.get(), nullptr, boost::none);
+            }
 
-    for (auto it = _allBuckets.begin(); it != _allBuckets.end();) {
-        auto nextIt = std::next(it);
+            it = nextIt;
+        }
 
-        const auto& bucket = *it;
-        stdx::unique_lock blk{bucket->_mutex};
-        if (shouldClear(bucket->_ns)) {
-            _executionStats.erase(bucket->_ns);
-            _abort(blk, bucket.get(), nullptr, boost::none);
+        for (auto it = stripe.archivedBuckets.begin(); it != stripe.archivedBuckets.end();) {
+            auto nextIt = std::next(it);
+            if (shouldClear(it->first.ns)) {
+                _removeArchivedBucket(&stripe, stripeLock, it);
+            }
+            it = nextIt;
         }
+    }
 
-        it = nextIt;
+    auto statsLk = _statsMutex.lockExclusive();
+    for (auto&& ns : clearedNamespaces) {
+        _executionStats.erase(ns);
     }
 }
 
@@ -441,6 +507,9 @@ void BucketCatalog::appendExecutionStats(const NamespaceString& ns, BSONObjBuild
                           stats->numBucketsClosedDueToTimeBackward.load());
     builder->appendNumber("numBucketsClosedDueToMemoryThreshold",
                           stats->numBucketsClosedDueToMemoryThreshold.load());
+    builder->appendNumber("numBucketsArchivedDueToMemoryThreshold",
+                          stats->numBucketsArchivedDueToMemoryThreshold.load());
+    builder->appendNumber("numBucketsReopened", stats->numBucketsReopened.load());
     auto commits = stats->numCommits.load();
     builder->appendNumber("numCommits", commits);
     builder->appendNumber("numWaits", stats->numWaits.load());
@@ -467,17 +536,16 @@ BucketCatalog::StripedMutex::ExclusiveLock BucketCatalog::StripedMutex::lockExcl
     return ExclusiveLock{*this};
 }
 
-BucketCatalog::StripedMutex::SharedLock BucketCatalog::_lockShared() const {
-    return _bucketMutex.lockShared();
-}
-
-BucketCatalog::StripedMutex::ExclusiveLock BucketCatalog::_lockExclusive() const {
-    return _bucketMutex.lockExclusive();
+std::size_t BucketCatalog::_getStripeNumber(const BucketKey& key) {
+    auto hash = absl::Hash<std::pair<std::size_t, std::size_t>>{}(
+        {absl::Hash<NamespaceString>{}(key.ns),
+         hashIgnoringFieldOrder(key.metadata.getMetaElement())});
+    return hash % kNumberOfStripes;
 }
 
 void BucketCatalog::_waitToCommitBatch(const std::shared_ptr<WriteBatch>& batch) {
     while (true) {
-        BucketAccess bucket{this, batch->bucket()};
+        BucketAccess bucket{this, batch->bucket(), batch->_stripe};
         if (!bucket) {
             return;
         }
@@ -495,9 +563,12 @@ void BucketCatalog::_waitToCommitBatch(const std::shared_ptr<WriteBatch>& batch)
     }
 }
 
-bool BucketCatalog::_removeBucket(Bucket* bucket, bool expiringBuckets) {
-    auto it = _allBuckets.find(bucket);
-    if (it == _allBuckets.end()) {
+bool BucketCatalog::_removeBucket(Stripe* stripe,
+                                  WithLock stripeLock,
+                                  Bucket* bucket,
+                                  bool expiringBuckets) {
+    auto it = stripe->allBuckets.find(bucket);
+    if (it == stripe->allBuckets.end()) {
         return false;
     }
 
@@ -505,26 +576,30 @@ bool BucketCatalog::_removeBucket(Bucket* bucket, bool expiringBuckets) {
     invariant(!bucket->_preparedBatch);
 
     _memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
-    _markBucketNotIdle(bucket, expiringBuckets /* locked */);
-    _removeNonNormalizedKeysForBucket(bucket);
-    _openBuckets.erase({bucket->_ns, bucket->_metadata});
+    _markBucketNotIdle(stripe, bucket, expiringBuckets /* locked */);
+    _removeNonNormalizedKeysForBucket(stripe, stripeLock, bucket);
+    stripe->openBuckets.erase({bucket->_ns, bucket->_metadata});
     {
         stdx::lock_guard statesLk{_statesMutex};
         _bucketStates.erase(bucket->_id);
     }
-    _allBuckets.erase(it);
+    stripe->allBuckets.erase(it);
 
     return true;
 }
 
-void BucketCatalog::_removeNonNormalizedKeysForBucket(Bucket* bucket) {
+void BucketCatalog::_removeNonNormalizedKeysForBucket(Stripe* stripe,
+                                                      WithLock stripeLock,
+                                                      Bucket* bucket) {
     auto comparator = bucket->_metadata.getComparator();
     for (auto&& metadata : bucket->_nonNormalizedKeyMetadatas) {
-        _openBuckets.erase({bucket->_ns, {metadata.firstElement(), metadata, comparator}});
+        stripe->openBuckets.erase({bucket->_ns, {metadata.firstElement(), metadata, comparator}});
     }
 }
 
-void BucketCatalog::_abort(stdx::unique_lock<Mutex>& lk,
+void BucketCatalog::_abort(Stripe* stripe,
+                           WithLock stripeLock,
+                           stdx::unique_lock<Mutex>& lk,
                            Bucket* bucket,
                            std::shared_ptr<WriteBatch> batch,
                            const boost::optional<Status>& status) {
@@ -551,68 +626,377 @@ void BucketCatalog::_abort(stdx::unique_lock<Mutex>& lk,
 
     lk.unlock();
     if (doRemove) {
-        [[maybe_unused]] bool removed = _removeBucket(bucket, false /* expiringBuckets */);
+        [[maybe_unused]] bool removed =
+            _removeBucket(stripe, stripeLock, bucket, false /* expiringBuckets */);
     }
 }
 
 void BucketCatalog::_markBucketIdle(Bucket* bucket) {
     invariant(bucket);
-    stdx::lock_guard lk{_idleMutex};
-    _idleBuckets.push_front(bucket);
-    bucket->_idleListEntry = _idleBuckets.begin();
+    auto& stripe = _stripes[bucket->_stripe];
+    stdx::lock_guard lk{stripe.idleMutex};
+    stripe.idleBuckets.push_front(bucket);
+    bucket->_idleListEntry = stripe.idleBuckets.begin();
 }
 
-void BucketCatalog::_markBucketNotIdle(Bucket* bucket, bool locked) {
+void BucketCatalog::_markBucketNotIdle(Stripe* stripe, Bucket* bucket, bool locked) {
     invariant(bucket);
     if (bucket->_idleListEntry) {
         stdx::unique_lock<Mutex> guard;
         if (!locked) {
-            guard = stdx::unique_lock{_idleMutex};
+            guard = stdx::unique_lock{stripe->idleMutex};
         }
-        _idleBuckets.erase(*bucket->_idleListEntry);
+        stripe->idleBuckets.erase(*bucket->_idleListEntry);
         bucket->_idleListEntry = boost::none;
     }
 }
 
 void BucketCatalog::_verifyBucketIsUnused(Bucket* bucket) const {
     // Take a lock on the bucket so we guarantee no one else is accessing it. We can release it
-    // right away since no one else can take it again without taking the catalog lock, which we
+    // right away since no one else can take it again without taking the stripe lock, which we
     // also hold outside this method.
     stdx::lock_guard<Mutex> lk{bucket->_mutex};
 }
 
-void BucketCatalog::_expireIdleBuckets(ExecutionStats* stats) {
-    // Must hold an exclusive lock on _bucketMutex from outside.
-    stdx::lock_guard lk{_idleMutex};
+void BucketCatalog::_expireIdleBuckets(Stripe* stripe, WithLock stripeLock, ExecutionStats* stats) {
+    auto overThreshold = [this] {
+        return _memoryUsage.load() >
+            static_cast<std::uint64_t>(gTimeseriesIdleBucketExpiryMemoryUsageThreshold);
+    };
 
     // As long as we still need space and have entries, close idle buckets.
-    while (!_idleBuckets.empty() &&
-           _memoryUsage.load() >
-               static_cast<std::uint64_t>(gTimeseriesIdleBucketExpiryMemoryUsageThreshold)) {
-        Bucket* bucket = _idleBuckets.back();
-        _verifyBucketIsUnused(bucket);
-        if (_removeBucket(bucket, true /* expiringBuckets */)) {
-            stats->numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(1);
+    auto expire = [&](Stripe* s, WithLock lock) {
+        stdx::lock_guard lk{s->idleMutex};
+        while (!s->idleBuckets.empty() && overThreshold()) {
+            Bucket* bucket = s->idleBuckets.back();
+            _verifyBucketIsUnused(bucket);
+            auto archived = _makeArchivedBucket(bucket);
+            BucketKey key{bucket->_ns, bucket->_metadata};
+            if (_removeBucket(s, lock, bucket, true /* expiringBuckets */)) {
+                stats->numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(1);
+                if (archived) {
+                    _archiveBucket(s, lock, key, std::move(*archived));
+                    stats->numBucketsArchivedDueToMemoryThreshold.fetchAndAddRelaxed(1);
+                }
+            }
+        }
+    };
+
+    expire(stripe, stripeLock);
+
+    // Only take from the other stripes if their locks are free, as we must not block on one stripe
+    // while holding another.
+    for (auto& other : _stripes) {
+        if (!overThreshold()) {
+            break;
+        }
+        if (&other == stripe) {
+            continue;
+        }
+
+        stdx::unique_lock otherLock{other.mutex, stdx::try_to_lock};
+        if (otherLock.owns_lock()) {
+            expire(&other, otherLock);
         }
     }
 }
 
 std::size_t BucketCatalog::_numberOfIdleBuckets() const {
-    stdx::lock_guard lk{_idleMutex};
-    return _idleBuckets.size();
+    std::size_t count = 0;
+    for (auto&& stripe : _stripes) {
+        stdx::lock_guard lk{stripe.idleMutex};
+        count += stripe.idleBuckets.size();
+    }
+    return count;
+}
+
+boost::optional<BucketCatalog::ArchivedBucket> BucketCatalog::_makeArchivedBucket(
+    Bucket* bucket) const {
+    if (!gTimeseriesArchiveExpiredBuckets.load() || bucket->_numCommittedMeasurements == 0 ||
+        bucket->_numCommittedMeasurements != bucket->_numMeasurements) {
+        return boost::none;
+    }
+
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        auto it = _bucketStates.find(bucket->_id);
+        if (it == _bucketStates.end() || it->second != BucketState::kNormal) {
+            return boost::none;
+        }
+    }
+
+    ArchivedBucket archived;
+    archived.id = bucket->_id;
+    archived.fieldNames = bucket->_fieldNames;
+    archived.min = bucket->_minmax.min();
+    archived.max = bucket->_minmax.max();
+    archived.latestTime = bucket->_latestTime;
+    archived.size = bucket->_size;
+    archived.numMeasurements = bucket->_numCommittedMeasurements;
+
+    // The namespace and metadata are stored once, in the key of the archive.
+    archived.memoryUsage = sizeof(ArchivedBucket) + bucket->_ns.size() +
+        bucket->_metadata.toBSON().objsize() + archived.min.objsize() + archived.max.objsize() +
+        sizeof(std::pair<OID, BucketState>);
+    for (auto&& fieldName : archived.fieldNames) {
+        archived.memoryUsage += fieldName.size();
+    }
+
+    if (_archivedMemoryUsage.load() + archived.memoryUsage >
+        static_cast<std::uint64_t>(gTimeseriesArchivedBucketsMemoryUsageThreshold)) {
+        return boost::none;
+    }
+
+    return archived;
+}
+
+void BucketCatalog::_archiveBucket(Stripe* stripe,
+                                   WithLock stripeLock,
+                                   const BucketKey& key,
+                                   ArchivedBucket&& archived) {
+    // Only remember the most recently expired bucket for each key, which is the one most likely to
+    // receive further measurements.
+    auto it = stripe->archivedBuckets.find(key);
+    if (it != stripe->archivedBuckets.end()) {
+        _removeArchivedBucket(stripe, stripeLock, it);
+    }
+
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        _bucketStates.emplace(archived.id, BucketState::kNormal);
+    }
+    _archivedMemoryUsage.fetchAndAdd(archived.memoryUsage);
+    stripe->archivedBuckets.emplace(key, std::move(archived));
+}
+
+void BucketCatalog::_removeArchivedBucket(Stripe* stripe,
+                                          WithLock stripeLock,
+                                          decltype(Stripe::archivedBuckets)::iterator it) {
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        _bucketStates.erase(it->second.id);
+    }
+    _archivedMemoryUsage.fetchAndSubtract(it->second.memoryUsage);
+    stripe->archivedBuckets.erase(it);
+}
+
+BucketCatalog::Bucket* BucketCatalog::_restoreBucket(Stripe* stripe,
+                                                     WithLock stripeLock,
+                                                     const BucketKey& key,
+                                                     ArchivedBucket&& archived,
+                                                     ExecutionStats* stats) {
+    auto [it, inserted] = stripe->allBuckets.insert(std::make_unique<Bucket>());
+    Bucket* bucket = it->get();
+    bucket->_id = archived.id;
+    bucket->_stripe = stripe - _stripes.data();
+    bucket->_ns = key.ns;
+    bucket->_metadata = key.metadata;
+    bucket->_fieldNames = std::move(archived.fieldNames);
+    bucket->_latestTime = archived.latestTime;
+    bucket->_size = archived.size;
+    bucket->_numMeasurements = archived.numMeasurements;
+    bucket->_numCommittedMeasurements = archived.numMeasurements;
+
+    // Restore the committed min and max, then consume the updates so that only changes made by
+    // later measurements are written to the bucket.
+    auto metaField = bucket->_metadata.getMetaField();
+    auto comparator = bucket->_metadata.getComparator();
+    bucket->_minmax.update(archived.min, metaField, comparator);
+    bucket->_minmax.update(archived.max, metaField, comparator);
+    bucket->_minmax.min();
+    bucket->_minmax.max();
+
+    // Account for the bucket as insert() would for a new bucket after its first commit, since
+    // insert() only tracks the change in usage of an existing bucket.
+    bucket->_memoryUsage += (bucket->_ns.size() * 2) +
+        (bucket->_metadata.toBSON().objsize() * 2) + sizeof(Bucket) +
+        sizeof(std::unique_ptr<Bucket>) + (sizeof(Bucket*) * 2) + archived.min.objsize() +
+        archived.max.objsize();
+    _memoryUsage.fetchAndAdd(bucket->_memoryUsage);
+
+    stats->numBucketsReopened.fetchAndAddRelaxed(1);
+    return bucket;
+}
+
+BucketCatalog::Bucket* BucketCatalog::_reopenArchivedBucket(Stripe* stripe,
+                                                            WithLock stripeLock,
+                                                            const BucketKey& key,
+                                                            const Date_t& time,
+                                                            const TimeseriesOptions& options,
+                                                            ExecutionStats* stats) {
+    auto it = stripe->archivedBuckets.find(key);
+    if (it == stripe->archivedBuckets.end()) {
+        return nullptr;
+    }
+
+    auto& archived = it->second;
+    bool cleared = false;
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        auto statesIt = _bucketStates.find(archived.id);
+        invariant(statesIt != _bucketStates.end());
+        cleared = statesIt->second != BucketState::kNormal;
+    }
+    if (cleared) {
+        // The bucket was modified on disk since it was archived, so it cannot be reopened.
+        _removeArchivedBucket(stripe, stripeLock, it);
+        return nullptr;
+    }
+
+    auto bucketTime = archived.id.asDateT();
+    if (time < bucketTime || time - bucketTime >= Seconds(*options.getBucketMaxSpanSeconds()) ||
+        archived.numMeasurements >= static_cast<std::uint64_t>(gTimeseriesBucketMaxCount) ||
+        archived.size >= static_cast<std::uint64_t>(gTimeseriesBucketMaxSize)) {
+        // The measurement does not fit, but later ones still may.
+        return nullptr;
+    }
+
+    // The archived bucket keeps its entry in '_bucketStates'.
+    auto restored = std::move(archived);
+    _archivedMemoryUsage.fetchAndSubtract(restored.memoryUsage);
+    stripe->archivedBuckets.erase(it);
+
+    return _restoreBucket(stripe, stripeLock, key, std::move(restored), stats);
 }
 
-BucketCatalog::Bucket* BucketCatalog::_allocateBucket(const BucketKey& key,
+boost::optional<BucketCatalog::BucketToReopen> BucketCatalog::_findBucketToReopen(
+    BucketKey& key,
+    const TimeseriesOptions& options,
+    const Date_t& time,
+    const BucketFinder& findBucket) {
+    auto fitsOpenBucket = [&] {
+        auto& stripe = _stripes[_getStripeNumber(key)];
+        stdx::lock_guard lk{stripe.mutex};
+        auto it = stripe.openBuckets.find(key);
+        if (it == stripe.openBuckets.end()) {
+            return false;
+        }
+
+        // The id of a bucket does not change once it has been added to its stripe, so it can be
+        // read without the lock on the bucket.
+        auto bucketTime = it->second->id().asDateT();
+        return time >= bucketTime &&
+            time - bucketTime < Seconds(*options.getBucketMaxSpanSeconds());
+    };
+
+    if (fitsOpenBucket()) {
+        return boost::none;
+    }
+    if (!key.metadata.normalized()) {
+        key.metadata.normalize();
+        if (fitsOpenBucket()) {
+            return boost::none;
+        }
+    }
+
+    BucketToReopen bucketToReopen;
+    bucketToReopen.numClears = _numClears.load();
+    bucketToReopen.bucketDoc = findBucket(key.metadata.getMetaElement(), time);
+    if (bucketToReopen.bucketDoc.isEmpty()) {
+        return boost::none;
+    }
+    return bucketToReopen;
+}
+
+BucketCatalog::Bucket* BucketCatalog::_reopenBucket(Stripe* stripe,
+                                                    WithLock stripeLock,
+                                                    const BucketKey& key,
+                                                    const Date_t& time,
+                                                    const TimeseriesOptions& options,
+                                                    ExecutionStats* stats,
+                                                    const BucketToReopen& bucketToReopen) {
+    const auto& bucketDoc = bucketToReopen.bucketDoc;
+    auto idElem = bucketDoc[timeseries::kBucketIdFieldName];
+    auto controlElem = bucketDoc[timeseries::kBucketControlFieldName];
+    auto dataElem = bucketDoc[timeseries::kBucketDataFieldName];
+    if (idElem.type() != BSONType::jstOID || controlElem.type() != BSONType::Object ||
+        dataElem.type() != BSONType::Object) {
+        return nullptr;
+    }
+
+    // Closed and compressed buckets cannot receive any more measurements.
+    auto control = controlElem.Obj();
+    if (control.getIntField(timeseries::kBucketControlVersionFieldName) !=
+            timeseries::kTimeseriesControlDefaultVersion ||
+        control.getBoolField("closed")) {
+        return nullptr;
+    }
+
+    ArchivedBucket reopened;
+    reopened.id = idElem.OID();
+    auto bucketTime = reopened.id.asDateT();
+    if (time < bucketTime || time - bucketTime >= Seconds(*options.getBucketMaxSpanSeconds())) {
+        return nullptr;
+    }
+
+    // The bucket must belong to the same series, which the query used to find it may not ensure.
+    auto metaElem = bucketDoc[timeseries::kBucketMetaFieldName];
+    auto keyMetaElem = key.metadata.getMetaElement();
+    if (keyMetaElem ? !keyMetaElem.binaryEqualValues(metaElem) : !metaElem.eoo()) {
+        return nullptr;
+    }
+
+    auto data = dataElem.Obj();
+    reopened.numMeasurements = data.getObjectField(options.getTimeField()).nFields();
+    reopened.size = bucketDoc.objsize();
+    if (reopened.numMeasurements == 0 ||
+        reopened.numMeasurements >= static_cast<std::uint64_t>(gTimeseriesBucketMaxCount) ||
+        reopened.size >= static_cast<std::uint64_t>(gTimeseriesBucketMaxSize)) {
+        return nullptr;
+    }
+
+    for (auto&& field : data) {
+        reopened.fieldNames.emplace(field.fieldNameStringData());
+    }
+    reopened.min = control.getObjectField("min").getOwned();
+    reopened.max = control.getObjectField("max").getOwned();
+    auto latestTimeElem = reopened.max[options.getTimeField()];
+    if (latestTimeElem.type() != BSONType::Date) {
+        return nullptr;
+    }
+    reopened.latestTime = latestTimeElem.Date();
+
+    {
+        // A bucket which is already in the catalog is represented by its in-memory state, and one
+        // which may have been cleared since it was read cannot be trusted.
+        stdx::lock_guard statesLk{_statesMutex};
+        if (_numClears.load() != bucketToReopen.numClears ||
+            _bucketStates.contains(reopened.id)) {
+            return nullptr;
+        }
+        _bucketStates.emplace(reopened.id, BucketState::kNormal);
+    }
+
+    return _restoreBucket(stripe, stripeLock, key, std::move(reopened), stats);
+}
+
+BucketCatalog::Bucket* BucketCatalog::_allocateBucket(Stripe* stripe,
+                                                      WithLock stripeLock,
+                                                      const BucketKey& key,
                                                       const Date_t& time,
                                                       const TimeseriesOptions& options,
                                                       ExecutionStats* stats,
-                                                      bool openedDuetoMetadata) {
-    _expireIdleBuckets(stats);
+                                                      bool openedDuetoMetadata,
+                                                      const BucketToReopen* bucketToReopen) {
+    _expireIdleBuckets(stripe, stripeLock, stats);
 
-    auto [it, inserted] = _allBuckets.insert(std::make_unique<Bucket>());
+    Bucket* reopened = nullptr;
+    if (bucketToReopen) {
+        reopened = _reopenBucket(stripe, stripeLock, key, time, options, stats, *bucketToReopen);
+    }
+    if (!reopened) {
+        reopened = _reopenArchivedBucket(stripe, stripeLock, key, time, options, stats);
+    }
+    if (reopened) {
+        stripe->openBuckets[key] = reopened;
+        return reopened;
+    }
+
+    auto [it, inserted] = stripe->allBuckets.insert(std::make_unique<Bucket>());
     Bucket* bucket = it->get();
+    bucket->_stripe = stripe - _stripes.data();
     _setIdTimestamp(bucket, time, options);
-    _openBuckets[key] = bucket;
+    stripe->openBuckets[key] = bucket;
 
     if (openedDuetoMetadata) {
         stats->numBucketsOpenedDueToMetadata.fetchAndAddRelaxed(1);
@@ -810,7 +1194,8 @@ std::shared_ptr<BucketCatalog::WriteBatch> BucketCatalog::Bucket::_activeBatch(
     OperationId opId, const std::shared_ptr<ExecutionStats>& stats) {
     auto it = _batches.find(opId);
     if (it == _batches.end()) {
-        it = _batches.try_emplace(opId, std::make_shared<WriteBatch>(this, opId, stats)).first;
+        it = _batches.try_emplace(opId, std::make_shared<WriteBatch>(this, _stripe, opId, stats))
+                 .first;
     }
     return it->second;
 }
@@ -819,8 +1204,15 @@ BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
                                           BucketKey& key,
                                           const TimeseriesOptions& options,
                                           ExecutionStats* stats,
-                                          const Date_t& time)
-    : _catalog(catalog), _key(&key), _options(&options), _stats(stats), _time(&time) {
+                                          const Date_t& time,
+                                          const BucketToReopen* bucketToReopen)
+    : _catalog(catalog),
+      _stripe(&catalog->_stripes[_getStripeNumber(key)]),
+      _key(&key),
+      _options(&options),
+      _stats(stats),
+      _time(&time),
+      _bucketToReopen(bucketToReopen) {
 
     auto bucketFound = [](BucketState bucketState) {
         return bucketState == BucketState::kNormal || bucketState == BucketState::kPrepared;
@@ -849,7 +1241,7 @@ BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
             return;
         }
 
-        // Release the bucket as we need to acquire the exclusive lock for the catalog.
+        // Release the bucket as we need to acquire the stripe lock.
         release();
 
         // Re-construct the key as it were before normalization.
@@ -858,8 +1250,8 @@ BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
             : key.withCopiedMetadata(BSONObj());
         hashedKey.key = &originalBucketKey;
 
-        // Find the bucket under a catalog exclusive lock for the catalog. It may have been modified
-        // since we released our locks. If found we store the key to avoid the need to normalize for
+        // Find the bucket under the stripe lock. It may have been modified since we released our
+        // locks. If found we store the key to avoid the need to normalize for
         // future lookups with this incoming field order.
         BSONObj nonNormalizedMetadataObj =
             nonNormalizedMetadata ? nonNormalizedMetadata.wrap() : BSONObj();
@@ -869,23 +1261,24 @@ BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
         }
     }
 
-    // Bucket not found, grab exclusive lock and create bucket with the key before normalization.
+    // Bucket not found, grab the stripe lock and create bucket with the key before normalization.
     auto originalBucketKey = nonNormalizedMetadata
         ? key.withCopiedMetadata(nonNormalizedMetadata.wrap())
         : key.withCopiedMetadata(BSONObj());
     hashedKey.key = &originalBucketKey;
-    auto lk = _catalog->_lockExclusive();
-    _findOrCreateOpenBucketThenLock(hashedNormalizedKey, hashedKey);
+    stdx::lock_guard lk{_stripe->mutex};
+    _findOrCreateOpenBucketThenLock(lk, hashedNormalizedKey, hashedKey);
 }
 
 BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
                                           Bucket* bucket,
+                                          std::size_t stripe,
                                           boost::optional<BucketState> targetState)
-    : _catalog(catalog) {
+    : _catalog(catalog), _stripe(&catalog->_stripes[stripe]) {
     {
-        auto lk = _catalog->_lockShared();
-        auto bucketIt = _catalog->_allBuckets.find(bucket);
-        if (bucketIt == _catalog->_allBuckets.end()) {
+        stdx::lock_guard lk{_stripe->mutex};
+        auto bucketIt = _stripe->allBuckets.find(bucket);
+        if (bucketIt == _stripe->allBuckets.end()) {
             return;
         }
 
@@ -918,9 +1311,9 @@ BucketCatalog::BucketAccess::~BucketAccess() {
 BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLock(
     const HashedBucketKey& key) {
     {
-        auto lk = _catalog->_lockShared();
-        auto it = _catalog->_openBuckets.find(key);
-        if (it == _catalog->_openBuckets.end()) {
+        stdx::lock_guard lk{_stripe->mutex};
+        auto it = _stripe->openBuckets.find(key);
+        if (it == _stripe->openBuckets.end()) {
             // Bucket does not exist.
             return BucketState::kCleared;
         }
@@ -938,9 +1331,9 @@ BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLockA
     BSONObj nonNormalizedMetadata) {
     invariant(!isLocked());
     {
-        auto lk = _catalog->_lockExclusive();
-        auto it = _catalog->_openBuckets.find(normalizedKey);
-        if (it == _catalog->_openBuckets.end()) {
+        stdx::lock_guard lk{_stripe->mutex};
+        auto it = _stripe->openBuckets.find(normalizedKey);
+        if (it == _stripe->openBuckets.end()) {
             // Bucket does not exist.
             return BucketState::kCleared;
         }
@@ -952,10 +1345,10 @@ BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLockA
         if (_bucket->_nonNormalizedKeyMetadatas.size() <
             _bucket->_nonNormalizedKeyMetadatas.capacity()) {
             auto [_, inserted] =
-                _catalog->_openBuckets.insert(std::make_pair(nonNormalizedKey, _bucket));
+                _stripe->openBuckets.insert(std::make_pair(nonNormalizedKey, _bucket));
             if (inserted) {
                 _bucket->_nonNormalizedKeyMetadatas.push_back(nonNormalizedMetadata);
-                // Increment the memory usage to store this key and value in _openBuckets
+                // Increment the memory usage to store this key and value in openBuckets
                 _bucket->_memoryUsage += nonNormalizedKey.key->ns.size() +
                     nonNormalizedMetadata.objsize() + sizeof(_bucket);
             }
@@ -973,18 +1366,20 @@ BucketCatalog::BucketState BucketCatalog::BucketAccess::_confirmStateForAcquired
     if (state == BucketState::kCleared || state == BucketState::kPreparedAndCleared) {
         release();
     } else {
-        _catalog->_markBucketNotIdle(_bucket, false /* locked */);
+        _catalog->_markBucketNotIdle(_stripe, _bucket, false /* locked */);
     }
 
     return state;
 }
 
 void BucketCatalog::BucketAccess::_findOrCreateOpenBucketThenLock(
-    const HashedBucketKey& normalizedKey, const HashedBucketKey& nonNormalizedKey) {
-    auto it = _catalog->_openBuckets.find(normalizedKey);
-    if (it == _catalog->_openBuckets.end()) {
+    WithLock stripeLock,
+    const HashedBucketKey& normalizedKey,
+    const HashedBucketKey& nonNormalizedKey) {
+    auto it = _stripe->openBuckets.find(normalizedKey);
+    if (it == _stripe->openBuckets.end()) {
         // No open bucket for this metadata.
-        _create(normalizedKey, nonNormalizedKey);
+        _create(stripeLock, normalizedKey, nonNormalizedKey);
         return;
     }
 
@@ -997,13 +1392,13 @@ void BucketCatalog::BucketAccess::_findOrCreateOpenBucketThenLock(
         invariant(statesIt != _catalog->_bucketStates.end());
         auto& [_, state] = *statesIt;
         if (state == BucketState::kNormal || state == BucketState::kPrepared) {
-            _catalog->_markBucketNotIdle(_bucket, false /* locked */);
+            _catalog->_markBucketNotIdle(_stripe, _bucket, false /* locked */);
             return;
         }
     }
 
-    _catalog->_abort(_guard, _bucket, nullptr, boost::none);
-    _create(normalizedKey, nonNormalizedKey);
+    _catalog->_abort(_stripe, stripeLock, _guard, _bucket, nullptr, boost::none);
+    _create(stripeLock, normalizedKey, nonNormalizedKey);
 }
 
 void BucketCatalog::BucketAccess::_acquire() {
@@ -1011,13 +1406,21 @@ void BucketCatalog::BucketAccess::_acquire() {
     _guard = stdx::unique_lock<Mutex>(_bucket->_mutex);
 }
 
-void BucketCatalog::BucketAccess::_create(const HashedBucketKey& normalizedKey,
+void BucketCatalog::BucketAccess::_create(WithLock stripeLock,
+                                          const HashedBucketKey& normalizedKey,
                                           const HashedBucketKey& nonNormalizedKey,
                                           bool openedDuetoMetadata) {
     invariant(_options);
-    _bucket =
-        _catalog->_allocateBucket(normalizedKey, *_time, *_options, _stats, openedDuetoMetadata);
-    _catalog->_openBuckets[nonNormalizedKey] = _bucket;
+    _bucket = _catalog->_allocateBucket(_stripe,
+                                        stripeLock,
+                                        normalizedKey,
+                                        *_time,
+                                        *_options,
+                                        _stats,
+                                        openedDuetoMetadata,
+                                        _bucketToReopen);
+    _bucketToReopen = nullptr;
+    _stripe->openBuckets[nonNormalizedKey] = _bucket;
     _bucket->_nonNormalizedKeyMetadatas.push_back(nonNormalizedKey.key->metadata.toBSON());
     _acquire();
 }
@@ -1045,7 +1448,8 @@ BucketCatalog::BucketAccess::operator BucketCatalog::Bucket*() const {
     return _bucket;
 }
 
-void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess*)>& isBucketFull) {
+boost::optional<OID> BucketCatalog::BucketAccess::rollover(
+    const std::function<bool(BucketAccess*)>& isBucketFull) {
     invariant(isLocked());
     invariant(_key);
     invariant(_time);
@@ -1061,32 +1465,37 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
                                       : _key->withCopiedMetadata(BSONObj());
     auto hashedKey = BucketHasher{}.hashed_key(prevBucketKey);
 
-    auto lk = _catalog->_lockExclusive();
-    _findOrCreateOpenBucketThenLock(hashedNormalizedKey, hashedKey);
+    stdx::lock_guard lk{_stripe->mutex};
+    _findOrCreateOpenBucketThenLock(lk, hashedNormalizedKey, hashedKey);
 
     // Recheck if still full now that we've reacquired the bucket.
     bool sameBucket =
         oldBucket == _bucket;  // Only record stats if bucket has changed, don't double-count.
+    boost::optional<OID> closedBucket;
     if (sameBucket || isBucketFull(this)) {
         // The bucket is indeed full, so create a new one.
         if (_bucket->allCommitted()) {
             // The bucket does not contain any measurements that are yet to be committed, so we can
             // remove it now. Otherwise, we must keep the bucket around until it is committed.
             oldBucket = _bucket;
+            closedBucket = oldBucket->id();
             release();
-            bool removed = _catalog->_removeBucket(oldBucket, false /* expiringBuckets */);
+            bool removed =
+                _catalog->_removeBucket(_stripe, lk, oldBucket, false /* expiringBuckets */);
             invariant(removed);
         } else {
             _bucket->_full = true;
 
             // We will recreate a new bucket for the same key below. We also need to cleanup all
             // extra metadata keys added for the old bucket instance.
-            _catalog->_removeNonNormalizedKeysForBucket(_bucket);
+            _catalog->_removeNonNormalizedKeysForBucket(_stripe, lk, _bucket);
             release();
         }
 
-        _create(hashedNormalizedKey, hashedKey, false /* openedDueToMetadata */);
+        _create(lk, hashedNormalizedKey, hashedKey, false /* openedDueToMetadata */);
     }
+
+    return closedBucket;
 }
 
 Date_t BucketCatalog::BucketAccess::getTime() const {
@@ -1094,9 +1503,10 @@ Date_t BucketCatalog::BucketAccess::getTime() const {
 }
 
 BucketCatalog::WriteBatch::WriteBatch(Bucket* bucket,
+                                      std::size_t stripe,
                                       OperationId opId,
                                       const std::shared_ptr<ExecutionStats>& stats)
-    : _bucket{bucket}, _opId(opId), _stats{stats} {}
+    : _bucket{bucket}, _stripe{stripe}, _opId(opId), _stats{stats} {}
 
 bool BucketCatalog::WriteBatch::claimCommitRights() {
     return !_commitRights.swap(true);
@@ -1251,16 +1661,26 @@ public:
             }
         }
 
-        auto lk = bucketCatalog._lockShared();
+        std::size_t numBuckets = 0;
+        std::size_t numOpenBuckets = 0;
+        std::size_t numArchivedBuckets = 0;
+        for (auto&& stripe : bucketCatalog._stripes) {
+            stdx::lock_guard lk{stripe.mutex};
+            numBuckets += stripe.allBuckets.size();
+            numOpenBuckets += stripe.openBuckets.size();
+            numArchivedBuckets += stripe.archivedBuckets.size();
+        }
+
         BSONObjBuilder builder;
-        builder.appendNumber("numBuckets",
-                             static_cast<long long>(bucketCatalog._allBuckets.size()));
-        builder.appendNumber("numOpenBuckets",
-                             static_cast<long long>(bucketCatalog._openBuckets.size()));
+        builder.appendNumber("numBuckets", static_cast<long long>(numBuckets));
+        builder.appendNumber("numOpenBuckets", static_cast<long long>(numOpenBuckets));
         builder.appendNumber("numIdleBuckets",
                              static_cast<long long>(bucketCatalog._numberOfIdleBuckets()));
         builder.appendNumber("memoryUsage",
                              static_cast<long long>(bucketCatalog._memoryUsage.load()));
+        builder.appendNumber("numArchivedBuckets", static_cast<long long>(numArchivedBuckets));
+        builder.appendNumber("archivedMemoryUsage",
+                             static_cast<long long>(bucketCatalog._archivedMemoryUsage.load()));
         return builder.obj();
     }
 } bucketCatalogServerStatus;
@@ -41,6 +41,7 @@
 #include "mongo/db/views/view.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/string_map.h"
 
 namespace mongo {
@@ -65,6 +66,13 @@ public:
         boost::optional<OID> electionId;
     };
 
+    /**
+     * Looks up a bucket on disk for the series with the given normalized metadata whose time range
+     * can hold a measurement at the given time. Returns an empty BSONObj if there is none, or if
+     * there is no cheap way to find one.
+     */
+    using BucketFinder = std::function<BSONObj(const BSONElement& metadata, const Date_t& time)>;
+
     /**
      * The basic unit of work for a bucket. Each insert will return a shared_ptr to a WriteBatch.
      * When a writer is finished with all their insertions, they should then take steps to ensure
@@ -81,7 +89,10 @@ public:
     public:
         WriteBatch() = delete;
 
-        WriteBatch(Bucket* bucket, OperationId opId, const std::shared_ptr<ExecutionStats>& stats);
+        WriteBatch(Bucket* bucket,
+                   std::size_t stripe,
+                   OperationId opId,
+                   const std::shared_ptr<ExecutionStats>& stats);
 
         /**
          * Attempt to claim the right to commit (or abort) a batch. If it returns true, rights are
@@ -149,6 +160,11 @@ public:
 
 
         Bucket* _bucket;
+
+        // The catalog stripe which owns '_bucket'. Kept separately so the bucket can be looked up
+        // without dereferencing it, as it may already have been cleared.
+        const std::size_t _stripe;
+
         OperationId _opId;
         std::shared_ptr<ExecutionStats> _stats;
 
@@ -158,6 +174,9 @@ public:
         uint32_t _numPreviouslyCommittedMeasurements = 0;
         StringMap<std::size_t> _newFieldNamesToBeInserted;  // Value is hash of string key
 
+        // Full buckets which were closed while opening this batch's bucket.
+        std::vector<OID> _closedBuckets;
+
         bool _active = true;
 
         AtomicWord<bool> _commitRights{false};
@@ -173,19 +192,22 @@ public:
     BucketCatalog operator=(const BucketCatalog&) = delete;
 
     /**
-     * Returns the metadata for the given bucket in the following format:
+     * Returns the metadata for the bucket of the given batch in the following format:
      *     {<metadata field name>: <value>}
      * All measurements in the given bucket share same metadata value.
      *
      * Returns an empty document if the given bucket cannot be found or if this time-series
      * collection was not created with a metadata field name.
      */
-    BSONObj getMetadata(Bucket* bucket) const;
+    BSONObj getMetadata(const std::shared_ptr<WriteBatch>& batch) const;
 
     /**
      * Returns the WriteBatch into which the document was inserted. Any caller who receives the same
      * batch may commit or abort the batch after claiming commit rights. See WriteBatch for more
      * details.
+     *
+     * If 'findBucket' is provided and the document does not fit in the open bucket for its series,
+     * it is used to find a bucket on disk to reopen for the document instead of opening a new one.
      */
     StatusWith<std::shared_ptr<WriteBatch>> insert(
         OperationContext* opCtx,
@@ -193,7 +215,8 @@ public:
         const StringData::ComparatorInterface* comparator,
         const TimeseriesOptions& options,
         const BSONObj& doc,
-        CombineWithInsertsFromOtherClients combine);
+        CombineWithInsertsFromOtherClients combine,
+        const BucketFinder& findBucket = nullptr);
 
     /**
      * Prepares a batch for commit, transitioning it to an inactive state. Caller must already have
@@ -204,9 +227,10 @@ public:
 
     /**
      * Records the result of a batch commit. Caller must already have commit rights on batch, and
-     * batch must have been previously prepared.
+     * batch must have been previously prepared. Returns the ids of any buckets which were closed
+     * along the way and will not receive any further writes.
      */
-    void finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info);
+    std::vector<OID> finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info);
 
     /**
      * Aborts the given write batch and any other outstanding batches on the same bucket. Caller
@@ -375,6 +399,9 @@ public:
         // The bucket ID for the underlying document
         OID _id = OID::gen();
 
+        // The catalog stripe which owns this bucket.
+        std::size_t _stripe = 0;
+
         // The namespace that this bucket is used for.
         NamespaceString _ns;
 
@@ -417,7 +444,7 @@ public:
         // Batches, per operation, that haven't been committed or aborted yet.
         stdx::unordered_map<OperationId, std::shared_ptr<WriteBatch>> _batches;
 
-        // If the bucket is in _idleBuckets, then its position is recorded here.
+        // If the bucket is in its stripe's idle list, then its position is recorded here.
         boost::optional<IdleList::iterator> _idleListEntry = boost::none;
 
         // Approximate memory usage of this bucket.
@@ -434,6 +461,8 @@ private:
         AtomicWord<long long> numBucketsClosedDueToTimeForward;
         AtomicWord<long long> numBucketsClosedDueToTimeBackward;
         AtomicWord<long long> numBucketsClosedDueToMemoryThreshold;
+        AtomicWord<long long> numBucketsArchivedDueToMemoryThreshold;
+        AtomicWord<long long> numBucketsReopened;
         AtomicWord<long long> numCommits;
         AtomicWord<long long> numWaits;
         AtomicWord<long long> numMeasurementsCommitted;
@@ -536,6 +565,75 @@ private:
         }
     };
 
+    /**
+     * A compact summary of an idle bucket which was expired from the catalog due to memory
+     * pressure. It holds just enough of the bucket's state to reopen it, so that later measurements
+     * which fit in its time range extend the bucket on disk rather than opening a new one.
+     */
+    struct ArchivedBucket {
+        OID id;
+
+        // Top-level field names of the measurements in the bucket.
+        StringSet fieldNames;
+
+        // The minimum and maximum values for each field in the bucket, as committed to disk.
+        BSONObj min;
+        BSONObj max;
+
+        Date_t latestTime;
+        uint64_t size = 0;
+        uint32_t numMeasurements = 0;
+
+        // Approximate memory usage of this summary, including its key in the archive.
+        uint64_t memoryUsage = 0;
+    };
+
+    /**
+     * A bucket document found on disk for a measurement which does not fit in the open bucket for
+     * its series, along with the value of '_numClears' before it was read.
+     */
+    struct BucketToReopen {
+        BSONObj bucketDoc;
+        uint64_t numClears = 0;
+    };
+
+    /**
+     * An independently locked shard of the catalog. Each bucket belongs to exactly one stripe,
+     * chosen from its namespace and metadata, so writers to different metadata values rarely
+     * contend with each other.
+     *
+     * You must hold 'mutex' when accessing 'allBuckets' or 'openBuckets'. While holding it, you can
+     * take a lock on an individual bucket, then release 'mutex'. Any iterators on the protected
+     * structures should be considered invalid once the lock is released. You must *not* be holding
+     * a lock on a bucket when you attempt to acquire 'mutex', as this can result in deadlock.
+     *
+     * Typically, if you want to acquire a bucket, you should use the BucketAccess RAII class to do
+     * so, as it will take care of most of this logic for you. Only use 'mutex' directly for
+     * maintenance where you want to take the lock once and interact with several buckets in the
+     * stripe atomically. Never block on the mutex of one stripe while holding another's.
+     */
+    struct Stripe {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("BucketCatalog::Stripe::mutex");
+
+        // All buckets currently in the stripe, including buckets which are full but not yet
+        // committed.
+        stdx::unordered_set<std::unique_ptr<Bucket>> allBuckets;
+
+        // The current open bucket for each namespace and metadata pair.
+        stdx::unordered_map<BucketKey, Bucket*, BucketHasher, BucketEq> openBuckets;
+
+        // This mutex protects access to 'idleBuckets'.
+        mutable Mutex idleMutex = MONGO_MAKE_LATCH("BucketCatalog::Stripe::idleMutex");
+
+        // Buckets that do not have any writers.
+        IdleList idleBuckets;
+
+        // Summaries of expired buckets which may be reopened, at most one for each namespace and
+        // metadata pair. Protected by 'mutex'. Each archived bucket keeps its entry in
+        // '_bucketStates', so that a direct write to it on disk clears it like an open bucket.
+        stdx::unordered_map<BucketKey, ArchivedBucket, BucketHasher, BucketEq> archivedBuckets;
+    };
+
     /**
      * Helper class to handle all the locking necessary to lookup and lock a bucket for use. This
      * is intended primarily for using a single bucket, including replacing it when it becomes full.
@@ -549,9 +647,11 @@ private:
                      BucketKey& key,
                      const TimeseriesOptions& options,
                      ExecutionStats* stats,
-                     const Date_t& time);
+                     const Date_t& time,
+                     const BucketToReopen* bucketToReopen = nullptr);
         BucketAccess(BucketCatalog* catalog,
                      Bucket* bucket,
+                     std::size_t stripe,
                      boost::optional<BucketState> targetState = boost::none);
         ~BucketAccess();
 
@@ -560,33 +660,33 @@ private:
         operator bool() const;
         operator Bucket*() const;
 
-        // Release the bucket lock, typically in order to reacquire the catalog lock.
+        // Release the bucket lock, typically in order to reacquire the stripe lock.
         void release();
 
         /**
          * Close the existing, full bucket and open a new one for the same metadata.
          * Parameter is a function which should check that the bucket is indeed still full after
          * reacquiring the necessary locks. The first parameter will give the function access to
-         * this BucketAccess instance, with the bucket locked.
+         * this BucketAccess instance, with the bucket locked. Returns the id of the old bucket if
+         * it had no uncommitted measurements and so was closed immediately.
          */
-        void rollover(const std::function<bool(BucketAccess*)>& isBucketFull);
+        boost::optional<OID> rollover(const std::function<bool(BucketAccess*)>& isBucketFull);
 
         // Retrieve the time associated with the bucket (id)
         Date_t getTime() const;
 
     private:
         /**
-         * Helper to find and lock an open bucket for the given metadata if it exists. Takes a
-         * shared lock on the catalog. Returns the state of the bucket if it is locked and usable.
+         * Helper to find and lock an open bucket for the given metadata if it exists. Takes the
+         * stripe lock. Returns the state of the bucket if it is locked and usable.
          * In case the bucket does not exist or was previously cleared and thus is not usable, the
          * return value will be BucketState::kCleared.
          */
         BucketState _findOpenBucketThenLock(const HashedBucketKey& key);
 
         /**
-         * Same as _findOpenBucketThenLock above but takes an exclusive lock on the catalog. In
-         * addition to finding the bucket it also store a non-normalized key if there are available
-         * slots in the bucket.
+         * Same as _findOpenBucketThenLock above. In addition to finding the bucket it also store a
+         * non-normalized key if there are available slots in the bucket.
          */
         BucketState _findOpenBucketThenLockAndStoreKey(const HashedBucketKey& normalizedKey,
                                                        const HashedBucketKey& key,
@@ -600,24 +700,28 @@ private:
         BucketState _confirmStateForAcquiredBucket();
 
         // Helper to find an open bucket for the given metadata if it exists, create it if it
-        // doesn't, and lock it. Requires an exclusive lock on the catalog.
-        void _findOrCreateOpenBucketThenLock(const HashedBucketKey& normalizedKey,
+        // doesn't, and lock it. Requires the stripe lock.
+        void _findOrCreateOpenBucketThenLock(WithLock stripeLock,
+                                             const HashedBucketKey& normalizedKey,
                                              const HashedBucketKey& key);
 
         // Lock _bucket.
         void _acquire();
 
-        // Allocate a new bucket in the catalog, set the local state to that bucket, and acquire
-        // a lock on it.
-        void _create(const HashedBucketKey& normalizedKey,
+        // Allocate a new bucket in the catalog, or reopen '_bucketToReopen' the first time this is
+        // called, set the local state to that bucket, and acquire a lock on it.
+        void _create(WithLock stripeLock,
+                     const HashedBucketKey& normalizedKey,
                      const HashedBucketKey& key,
                      bool openedDuetoMetadata = true);
 
         BucketCatalog* _catalog;
+        Stripe* _stripe = nullptr;
         BucketKey* _key = nullptr;
         const TimeseriesOptions* _options = nullptr;
         ExecutionStats* _stats = nullptr;
         const Date_t* _time = nullptr;
+        const BucketToReopen* _bucketToReopen = nullptr;
 
         Bucket* _bucket = nullptr;
         stdx::unique_lock<Mutex> _guard;
@@ -625,27 +729,33 @@ private:
 
     class ServerStatus;
 
-    StripedMutex::SharedLock _lockShared() const;
-    StripedMutex::ExclusiveLock _lockExclusive() const;
+    /**
+     * Returns the index of the stripe which owns buckets for the given key. Keys whose metadata
+     * only differs in field order map to the same stripe, so that a key need not be normalized to
+     * find its stripe.
+     */
+    static std::size_t _getStripeNumber(const BucketKey& key);
 
     void _waitToCommitBatch(const std::shared_ptr<WriteBatch>& batch);
 
     /**
      * Removes the given bucket from the bucket catalog's internal data structures.
      */
-    bool _removeBucket(Bucket* bucket, bool expiringBuckets);
+    bool _removeBucket(Stripe* stripe, WithLock stripeLock, Bucket* bucket, bool expiringBuckets);
 
     /**
      * Removes extra non-normalized BucketKey's for the given bucket from the
      * bucket catalog's internal data structures.
      */
-    void _removeNonNormalizedKeysForBucket(Bucket* bucket);
+    void _removeNonNormalizedKeysForBucket(Stripe* stripe, WithLock stripeLock, Bucket* bucket);
 
     /**
      * Aborts any batches it can for the given bucket, then removes the bucket. If batch is
      * non-null, it is assumed that the caller has commit rights for that batch.
      */
-    void _abort(stdx::unique_lock<Mutex>& lk,
+    void _abort(Stripe* stripe,
+                WithLock stripeLock,
+                stdx::unique_lock<Mutex>& lk,
                 Bucket* bucket,
                 std::shared_ptr<WriteBatch> batch,
                 const boost::optional<Status>& status);
@@ -656,30 +766,103 @@ private:
     void _markBucketIdle(Bucket* bucket);
 
     /**
-     * Remove the bucket from the list of idle buckets. The second parameter encodes whether the
-     * caller holds a lock on _idleMutex.
+     * Remove the bucket from the list of idle buckets. The third parameter encodes whether the
+     * caller holds a lock on the stripe's idleMutex.
      */
-    void _markBucketNotIdle(Bucket* bucket, bool locked);
+    void _markBucketNotIdle(Stripe* stripe, Bucket* bucket, bool locked);
 
     /**
-     * Verify the bucket is currently unused by taking a lock on it. Must hold exclusive lock from
+     * Verify the bucket is currently unused by taking a lock on it. Must hold the stripe lock from
      * the outside for the result to be meaningful.
      */
     void _verifyBucketIsUnused(Bucket* bucket) const;
 
     /**
      * Expires idle buckets until the bucket catalog's memory usage is below the expiry threshold.
+     * Buckets are expired from the given, already locked, stripe first, then from any other stripe
+     * whose lock is free. Never waits on another stripe's lock.
      */
-    void _expireIdleBuckets(ExecutionStats* stats);
+    void _expireIdleBuckets(Stripe* stripe, WithLock stripeLock, ExecutionStats* stats);
 
     std::size_t _numberOfIdleBuckets() const;
 
-    // Allocate a new bucket (and ID) and add it to the catalog
-    Bucket* _allocateBucket(const BucketKey& key,
+    /**
+     * Returns a summary of the given bucket, which is about to be expired, from which it can later
+     * be reopened. Returns boost::none if archiving is disabled, the bucket has been cleared, or
+     * the archive is over its memory usage threshold.
+     */
+    boost::optional<ArchivedBucket> _makeArchivedBucket(Bucket* bucket) const;
+
+    /**
+     * Adds the summary of an expired bucket to the archive of the given stripe, replacing any
+     * previous summary for the same key.
+     */
+    void _archiveBucket(Stripe* stripe,
+                        WithLock stripeLock,
+                        const BucketKey& key,
+                        ArchivedBucket&& archived);
+
+    /**
+     * Removes the given summary from the archive of its stripe, forgetting the archived bucket.
+     */
+    void _removeArchivedBucket(Stripe* stripe,
+                               WithLock stripeLock,
+                               decltype(Stripe::archivedBuckets)::iterator it);
+
+    /**
+     * Adds a bucket with the state recorded in 'archived' back to the given stripe. The caller is
+     * responsible for the entry of the bucket in '_bucketStates'.
+     */
+    Bucket* _restoreBucket(Stripe* stripe,
+                           WithLock stripeLock,
+                           const BucketKey& key,
+                           ArchivedBucket&& archived,
+                           ExecutionStats* stats);
+
+    /**
+     * Reopens the archived bucket for the given key if 'time' falls within the time range it may
+     * still cover, and adds it back to the given stripe. Returns nullptr if there is no such
+     * bucket.
+     */
+    Bucket* _reopenArchivedBucket(Stripe* stripe,
+                                  WithLock stripeLock,
+                                  const BucketKey& key,
+                                  const Date_t& time,
+                                  const TimeseriesOptions& options,
+                                  ExecutionStats* stats);
+
+    /**
+     * If a measurement at 'time' does not fit in the open bucket for the given key, uses
+     * 'findBucket' to look for a bucket on disk which it does fit in. Normalizes the metadata of
+     * 'key' if it needs to look. Must not hold any catalog locks.
+     */
+    boost::optional<BucketToReopen> _findBucketToReopen(BucketKey& key,
+                                                        const TimeseriesOptions& options,
+                                                        const Date_t& time,
+                                                        const BucketFinder& findBucket);
+
+    /**
+     * Reopens the bucket found on disk for the given key, if 'time' falls within its time range,
+     * it has room for more measurements and it is not already known to the catalog, and adds it to
+     * the given stripe. Returns nullptr if the bucket cannot be reopened.
+     */
+    Bucket* _reopenBucket(Stripe* stripe,
+                          WithLock stripeLock,
+                          const BucketKey& key,
+                          const Date_t& time,
+                          const TimeseriesOptions& options,
+                          ExecutionStats* stats,
+                          const BucketToReopen& bucketToReopen);
+
+    // Allocate a new bucket (and ID), or reopen an archived one, and add it to the given stripe
+    Bucket* _allocateBucket(Stripe* stripe,
+                            WithLock stripeLock,
+                            const BucketKey& key,
                             const Date_t& time,
                             const TimeseriesOptions& options,
                             ExecutionStats* stats,
-                            bool openedDuetoMetadata);
+                            bool openedDuetoMetadata,
+                            const BucketToReopen* bucketToReopen);
 
     std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns);
     const std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns) const;
@@ -696,40 +879,13 @@ private:
      */
     boost::optional<BucketState> _setBucketState(const OID& id, BucketState target);
 
-    /**
-     * You must hold a lock on _bucketMutex when accessing _allBuckets or _openBuckets.
-     * While holding a lock on _bucketMutex, you can take a lock on an individual bucket, then
-     * release _bucketMutex. Any iterators on the protected structures should be considered invalid
-     * once the lock is released. Any subsequent access to the structures requires relocking
-     * _bucketMutex. You must *not* be holding a lock on a bucket when you attempt to acquire the
-     * lock on _mutex, as this can result in deadlock.
-     *
-     * The StripedMutex class has both shared (read-only) and exclusive (write) locks. If you are
-     * going to write to any of the protected structures, you must hold an exclusive lock.
-     *
-     * Typically, if you want to acquire a bucket, you should use the BucketAccess RAII
-     * class to do so, as it will take care of most of this logic for you. Only use the _bucketMutex
-     * directly for more global maintenance where you want to take the lock once and interact with
-     * multiple buckets atomically.
-     */
-    mutable StripedMutex _bucketMutex;
-
-    // All buckets currently in the catalog, including buckets which are full but not yet committed.
-    stdx::unordered_set<std::unique_ptr<Bucket>> _allBuckets;
-
-    // The current open bucket for each namespace and metadata pair.
-    stdx::unordered_map<BucketKey, Bucket*, BucketHasher, BucketEq> _openBuckets;
+    static constexpr std::size_t kNumberOfStripes = 32;
+    std::array<Stripe, kNumberOfStripes> _stripes;
 
     // Bucket state
     mutable Mutex _statesMutex = MONGO_MAKE_LATCH("BucketCatalog::_statesMutex");
     stdx::unordered_map<OID, BucketState, OID::Hasher> _bucketStates;
 
-    // This mutex protects access to _idleBuckets
-    mutable Mutex _idleMutex = MONGO_MAKE_LATCH("BucketCatalog::_idleMutex");
-
-    // Buckets that do not have any writers.
-    IdleList _idleBuckets;
-
     /**
      * This mutex protects access to the _executionStats map. Once you complete your lookup, you
      * can keep the shared_ptr to an individual namespace's stats object and release the lock. The
@@ -748,5 +904,12 @@ private:
 
     // Approximate memory usage of the bucket catalog.
     AtomicWord<uint64_t> _memoryUsage;
+
+    // Approximate memory usage of the summaries of archived buckets.
+    AtomicWord<uint64_t> _archivedMemoryUsage;
+
+    // Number of times buckets have been cleared, so that a bucket read from disk is not reopened if
+    // it may have been cleared while it was being read. Only modified with '_statesMutex' held.
+    AtomicWord<uint64_t> _numClears;
 };
 }  // namespace mongo
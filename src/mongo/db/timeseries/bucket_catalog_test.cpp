@@ -35,6 +35,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/death_test.h"
@@ -235,9 +236,8 @@ TEST_F(BucketCatalogTest, GetMetadataReturnsEmptyDocOnMissingBucket) {
                               BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
                      .getValue();
     ASSERT(batch->claimCommitRights());
-    auto bucket = batch->bucket();
     _bucketCatalog->abort(batch);
-    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(bucket));
+    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(batch));
 }
 
 TEST_F(BucketCatalogTest, InsertIntoDifferentBuckets) {
@@ -269,11 +269,10 @@ TEST_F(BucketCatalogTest, InsertIntoDifferentBuckets) {
     ASSERT_NE(result2.getValue(), result3.getValue());
 
     // Check metadata in buckets.
-    ASSERT_BSONOBJ_EQ(BSON(_metaField << "123"),
-                      _bucketCatalog->getMetadata(result1.getValue()->bucket()));
+    ASSERT_BSONOBJ_EQ(BSON(_metaField << "123"), _bucketCatalog->getMetadata(result1.getValue()));
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONObj()),
-                      _bucketCatalog->getMetadata(result2.getValue()->bucket()));
-    ASSERT(_bucketCatalog->getMetadata(result3.getValue()->bucket()).isEmpty());
+                      _bucketCatalog->getMetadata(result2.getValue()));
+    ASSERT(_bucketCatalog->getMetadata(result3.getValue()).isEmpty());
 
     // Committing one bucket should only return the one document in that bucket and should not
     // affect the other bucket.
@@ -302,9 +301,9 @@ TEST_F(BucketCatalogTest, InsertIntoSameBucketArray) {
 
     // Check metadata in buckets.
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSON_ARRAY(BSON("a" << 0 << "b" << 1))),
-                      _bucketCatalog->getMetadata(result1.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result1.getValue()));
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSON_ARRAY(BSON("a" << 0 << "b" << 1))),
-                      _bucketCatalog->getMetadata(result2.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result2.getValue()));
 }
 
 TEST_F(BucketCatalogTest, InsertIntoSameBucketObjArray) {
@@ -333,11 +332,11 @@ TEST_F(BucketCatalogTest, InsertIntoSameBucketObjArray) {
     ASSERT_BSONOBJ_EQ(
         BSON(_metaField << BSONObj(BSON(
                  "c" << BSON_ARRAY(BSON("a" << 0 << "b" << 1) << BSON("f" << 1 << "g" << 0))))),
-        _bucketCatalog->getMetadata(result1.getValue()->bucket()));
+        _bucketCatalog->getMetadata(result1.getValue()));
     ASSERT_BSONOBJ_EQ(
         BSON(_metaField << BSONObj(BSON(
                  "c" << BSON_ARRAY(BSON("a" << 0 << "b" << 1) << BSON("f" << 1 << "g" << 0))))),
-        _bucketCatalog->getMetadata(result2.getValue()->bucket()));
+        _bucketCatalog->getMetadata(result2.getValue()));
 }
 
 
@@ -369,11 +368,11 @@ TEST_F(BucketCatalogTest, InsertIntoSameBucketNestedArray) {
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONObj(BSON("c" << BSON_ARRAY(BSON("a" << 0 << "b" << 1)
                                                                         << BSON_ARRAY("123"
                                                                                       << "456"))))),
-                      _bucketCatalog->getMetadata(result1.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result1.getValue()));
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONObj(BSON("c" << BSON_ARRAY(BSON("a" << 0 << "b" << 1)
                                                                         << BSON_ARRAY("123"
                                                                                       << "456"))))),
-                      _bucketCatalog->getMetadata(result2.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result2.getValue()));
 }
 
 TEST_F(BucketCatalogTest, InsertNullAndMissingMetaFieldIntoDifferentBuckets) {
@@ -397,8 +396,8 @@ TEST_F(BucketCatalogTest, InsertNullAndMissingMetaFieldIntoDifferentBuckets) {
 
     // Check metadata in buckets.
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONNULL),
-                      _bucketCatalog->getMetadata(result1.getValue()->bucket()));
-    ASSERT(_bucketCatalog->getMetadata(result2.getValue()->bucket()).isEmpty());
+                      _bucketCatalog->getMetadata(result1.getValue()));
+    ASSERT(_bucketCatalog->getMetadata(result2.getValue()).isEmpty());
 
     // Committing one bucket should only return the one document in that bucket and should not
     // affect the other bucket.
@@ -436,6 +435,40 @@ TEST_F(BucketCatalogTest, ClearDatabaseBuckets) {
     _insertOneAndCommit(_ns3, 1);
 }
 
+TEST_F(BucketCatalogTest, ClearNamespaceBucketsWithManyMetadataValues) {
+    // Spread the buckets of both namespaces across the catalog's stripes.
+    std::vector<std::shared_ptr<BucketCatalog::WriteBatch>> batches1;
+    std::vector<std::shared_ptr<BucketCatalog::WriteBatch>> batches2;
+    for (int i = 0; i < 100; ++i) {
+        for (auto [ns, batches] : {std::pair{&_ns1, &batches1}, std::pair{&_ns2, &batches2}}) {
+            batches->push_back(
+                _bucketCatalog
+                    ->insert(_opCtx,
+                             *ns,
+                             _getCollator(*ns),
+                             _getTimeseriesOptions(*ns),
+                             BSON(_timeField << Date_t::now() << _metaField << i),
+                             BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
+                    .getValue());
+        }
+    }
+
+    _bucketCatalog->clear(_ns1);
+
+    for (auto&& batch : batches1) {
+        ASSERT(batch->finished());
+        ASSERT_EQ(batch->getResult().getStatus(), ErrorCodes::TimeseriesBucketCleared);
+    }
+    for (auto&& batch : batches2) {
+        ASSERT_FALSE(batch->finished());
+        ASSERT_BSONOBJ_EQ(BSON(_metaField << batch->measurements()[0][_metaField].Int()),
+                          _bucketCatalog->getMetadata(batch));
+        ASSERT(batch->claimCommitRights());
+        _bucketCatalog->prepareCommit(batch);
+        _bucketCatalog->finish(batch, {});
+    }
+}
+
 TEST_F(BucketCatalogTest, InsertBetweenPrepareAndFinish) {
     auto batch1 = _bucketCatalog
                       ->insert(_opCtx,
@@ -501,7 +534,7 @@ TEST_F(BucketCatalogWithoutMetadataTest, GetMetadataReturnsEmptyDoc) {
                               BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
                      .getValue();
 
-    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(batch->bucket()));
+    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(batch));
 
     _commit(batch, 0);
 }
@@ -579,6 +612,57 @@ TEST_F(BucketCatalogWithoutMetadataTest, CommitReturnsNewFields) {
     ASSERT(batch2->newFieldNamesToBeInserted().count("a")) << batch2->toBSON();
 }
 
+TEST_F(BucketCatalogTest, FinishReportsClosedBuckets) {
+    auto options = _getTimeseriesOptions(_ns1);
+    auto insert = [&] {
+        auto result =
+            _bucketCatalog->insert(_opCtx,
+                                   _ns1,
+                                   _getCollator(_ns1),
+                                   options,
+                                   BSON(_timeField << Date_t::now()),
+                                   BucketCatalog::CombineWithInsertsFromOtherClients::kAllow);
+        ASSERT_OK(result);
+        return result.getValue();
+    };
+    auto commit = [&](const std::shared_ptr<BucketCatalog::WriteBatch>& batch) {
+        ASSERT(batch->claimCommitRights());
+        ASSERT(_bucketCatalog->prepareCommit(batch));
+        return _bucketCatalog->finish(batch, {});
+    };
+
+    // Fill up a bucket, leaving the last measurement uncommitted.
+    auto batch = insert();
+    auto firstId = batch->bucket()->id();
+    ASSERT(commit(batch).empty());
+    for (auto i = 2; i < gTimeseriesBucketMaxCount; ++i) {
+        ASSERT(commit(insert()).empty());
+    }
+    auto lastBatch = insert();
+    ASSERT_EQ(firstId, lastBatch->bucket()->id());
+
+    // Overflowing into a new bucket cannot close the old one while it has uncommitted
+    // measurements, so the old bucket is reported closed once its last batch commits.
+    batch = insert();
+    auto secondId = batch->bucket()->id();
+    ASSERT_NE(firstId, secondId);
+    ASSERT(commit(batch).empty());
+    auto closed = commit(lastBatch);
+    ASSERT_EQ(closed.size(), 1U);
+    ASSERT_EQ(closed[0], firstId);
+
+    // If the full bucket is fully committed, it is closed as soon as the new bucket is opened and
+    // reported by the first batch into the new bucket.
+    for (auto i = 1; i < gTimeseriesBucketMaxCount; ++i) {
+        ASSERT(commit(insert()).empty());
+    }
+    batch = insert();
+    ASSERT_NE(secondId, batch->bucket()->id());
+    closed = commit(batch);
+    ASSERT_EQ(closed.size(), 1U);
+    ASSERT_EQ(closed[0], secondId);
+}
+
 TEST_F(BucketCatalogTest, AbortBatchOnBucketWithPreparedCommit) {
     auto batch1 = _bucketCatalog
                       ->insert(_opCtx,
@@ -878,5 +962,228 @@ TEST_F(BucketCatalogTest, DuplicateNewFieldNamesAcrossConcurrentBatches) {
     _bucketCatalog->finish(batch1, {});
 }
 
+TEST_F(BucketCatalogTest, ReopenArchivedBucket) {
+    RAIIServerParameterControllerForTest archiveController{"timeseriesArchiveExpiredBuckets",
+                                                           true};
+    RAIIServerParameterControllerForTest thresholdController{
+        "timeseriesIdleBucketExpiryMemoryUsageThreshold", 1};
+
+    auto time = Date_t::now();
+    auto insert = [&](int meta, Date_t time, int value) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     _getTimeseriesOptions(_ns1),
+                     BSON(_timeField << time << _metaField << meta << "a" << value),
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
+            .getValue();
+    };
+
+    auto batch1 = insert(0, time, 1);
+    auto bucketId = batch1->bucket()->id();
+    _commit(batch1, 0);
+
+    // Opening a bucket for other metadata expires the now idle bucket, which is archived.
+    _commit(insert(1, time, 1), 0);
+
+    // A later measurement which fits in the archived bucket reopens it, and only writes the changes
+    // it makes to the committed min and max.
+    auto batch2 = insert(0, time + Seconds(1), 0);
+    ASSERT_EQ(batch2->bucket()->id(), bucketId);
+    ASSERT(batch2->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch2);
+    ASSERT_EQ(batch2->numPreviouslyCommittedMeasurements(), 1);
+    ASSERT(batch2->newFieldNamesToBeInserted().empty());
+    ASSERT_BSONOBJ_EQ(batch2->min(), BSON("u" << BSON("a" << 0)));
+    ASSERT_BSONOBJ_EQ(batch2->max(), BSON("u" << BSON(_timeField << time + Seconds(1))));
+    _bucketCatalog->finish(batch2, {});
+
+    BSONObjBuilder builder;
+    _bucketCatalog->appendExecutionStats(_ns1, &builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats.getIntField("numBucketsReopened"), 1);
+    ASSERT_EQ(stats.getIntField("numBucketsOpenedDueToMetadata"), 2);
+    ASSERT_GTE(stats.getIntField("numBucketsArchivedDueToMemoryThreshold"), 2);
+}
+
+TEST_F(BucketCatalogTest, ArchivedBucketNotReopenedOutsideTimeRange) {
+    RAIIServerParameterControllerForTest archiveController{"timeseriesArchiveExpiredBuckets",
+                                                           true};
+    RAIIServerParameterControllerForTest thresholdController{
+        "timeseriesIdleBucketExpiryMemoryUsageThreshold", 1};
+
+    auto time = Date_t::now();
+    auto insert = [&](int meta, Date_t time) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     _getTimeseriesOptions(_ns1),
+                     BSON(_timeField << time << _metaField << meta),
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
+            .getValue();
+    };
+
+    auto batch1 = insert(0, time);
+    auto bucketId = batch1->bucket()->id();
+    _commit(batch1, 0);
+    _commit(insert(1, time), 0);
+
+    // Measurements before the start of the archived bucket or beyond its maximum span open a new
+    // bucket.
+    auto batch2 = insert(0, time - Hours(1));
+    ASSERT_NE(batch2->bucket()->id(), bucketId);
+    _commit(batch2, 0);
+
+    auto batch3 = insert(0, time + Hours(2));
+    ASSERT_NE(batch3->bucket()->id(), bucketId);
+    _commit(batch3, 0);
+}
+
+TEST_F(BucketCatalogTest, ClearedArchivedBucketNotReopened) {
+    RAIIServerParameterControllerForTest archiveController{"timeseriesArchiveExpiredBuckets",
+                                                           true};
+    RAIIServerParameterControllerForTest thresholdController{
+        "timeseriesIdleBucketExpiryMemoryUsageThreshold", 1};
+
+    auto time = Date_t::now();
+    auto insert = [&](const NamespaceString& ns, int meta) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     ns,
+                     _getCollator(ns),
+                     _getTimeseriesOptions(ns),
+                     BSON(_timeField << time << _metaField << meta),
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
+            .getValue();
+    };
+
+    auto batch1 = insert(_ns1, 0);
+    auto bucketId1 = batch1->bucket()->id();
+    _commit(batch1, 0);
+    auto batch2 = insert(_ns2, 0);
+    auto bucketId2 = batch2->bucket()->id();
+    _commit(batch2, 0);
+    _commit(insert(_ns3, 0), 0);
+
+    // Both buckets have been archived. A direct write to the first bucket clears it, and the
+    // second is cleared along with its namespace.
+    _bucketCatalog->clear(bucketId1);
+    _bucketCatalog->clear(_ns2);
+
+    auto batch3 = insert(_ns1, 0);
+    ASSERT_NE(batch3->bucket()->id(), bucketId1);
+    _commit(batch3, 0);
+
+    auto batch4 = insert(_ns2, 0);
+    ASSERT_NE(batch4->bucket()->id(), bucketId2);
+    _commit(batch4, 0);
+}
+
+TEST_F(BucketCatalogTest, ReopenBucketForLateMeasurement) {
+    RAIIServerParameterControllerForTest controller{"timeseriesReopenBucketsForLateMeasurements",
+                                                    true};
+
+    auto bucketTime = Date_t::fromMillisSinceEpoch(1622505600000);
+    OID bucketId = OID::gen();
+    bucketId.setTimestamp(durationCount<Seconds>(bucketTime.toDurationSinceEpoch()));
+    auto bucketDoc = BSON("_id" << bucketId << "control"
+                                << BSON("version" << 1 << "min"
+                                                  << BSON(_timeField << bucketTime << "a" << 1)
+                                                  << "max"
+                                                  << BSON(_timeField << bucketTime + Seconds(10)
+                                                                     << "a" << 1))
+                                << "meta" << 0 << "data"
+                                << BSON(_timeField << BSON("0" << bucketTime + Seconds(10)) << "a"
+                                                   << BSON("0" << 1)));
+
+    int numLookups = 0;
+    BucketCatalog::BucketFinder findBucket = [&](const BSONElement& metadata,
+                                                 const Date_t& time) {
+        ++numLookups;
+        ASSERT_BSONELT_EQ(metadata, BSON(_metaField << 0).firstElement());
+        return bucketDoc;
+    };
+    auto insert = [&](Date_t time, int value) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     _getTimeseriesOptions(_ns1),
+                     BSON(_timeField << time << _metaField << 0 << "a" << value),
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                     findBucket)
+            .getValue();
+    };
+
+    // The finder returns the same bucket for every lookup, but it cannot hold a measurement from
+    // outside its time range.
+    auto batch1 = insert(bucketTime + Hours(2), 0);
+    ASSERT_NE(batch1->bucket()->id(), bucketId);
+    ASSERT_EQ(numLookups, 1);
+    _commit(batch1, 0);
+
+    // A measurement which fits in the open bucket does not need a lookup.
+    _commit(insert(bucketTime + Hours(2) + Seconds(1), 0), 1);
+    ASSERT_EQ(numLookups, 1);
+
+    // A late measurement is added to the bucket found on disk, writing only the changes it makes to
+    // the committed min and max.
+    auto batch2 = insert(bucketTime + Seconds(5), 0);
+    ASSERT_EQ(batch2->bucket()->id(), bucketId);
+    ASSERT_EQ(numLookups, 2);
+    ASSERT(batch2->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch2);
+    ASSERT_EQ(batch2->numPreviouslyCommittedMeasurements(), 1);
+    ASSERT(batch2->newFieldNamesToBeInserted().empty());
+    ASSERT_BSONOBJ_EQ(batch2->min(), BSON("u" << BSON("a" << 0)));
+    ASSERT_BSONOBJ_EQ(batch2->max(), BSONObj());
+    _bucketCatalog->finish(batch2, {});
+
+    // The reopened bucket is now the open bucket for the series.
+    _commit(insert(bucketTime + Seconds(6), 0), 2);
+    ASSERT_EQ(numLookups, 2);
+
+    BSONObjBuilder builder;
+    _bucketCatalog->appendExecutionStats(_ns1, &builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats.getIntField("numBucketsReopened"), 1);
+    ASSERT_EQ(stats.getIntField("numBucketsOpenedDueToMetadata"), 1);
+}
+
+TEST_F(BucketCatalogTest, BucketClearedWhileBeingFoundNotReopened) {
+    RAIIServerParameterControllerForTest controller{"timeseriesReopenBucketsForLateMeasurements",
+                                                    true};
+
+    auto bucketTime = Date_t::fromMillisSinceEpoch(1622505600000);
+    OID bucketId = OID::gen();
+    bucketId.setTimestamp(durationCount<Seconds>(bucketTime.toDurationSinceEpoch()));
+    auto bucketDoc = BSON(
+        "_id" << bucketId << "control"
+              << BSON("version" << 1 << "min" << BSON(_timeField << bucketTime) << "max"
+                                << BSON(_timeField << bucketTime))
+              << "meta" << 0 << "data" << BSON(_timeField << BSON("0" << bucketTime)));
+
+    // A direct write to the bucket clears it after it has been read.
+    BucketCatalog::BucketFinder findBucket = [&](const BSONElement& metadata,
+                                                 const Date_t& time) {
+        _bucketCatalog->clear(bucketId);
+        return bucketDoc;
+    };
+
+    auto batch = _bucketCatalog
+                     ->insert(_opCtx,
+                              _ns1,
+                              _getCollator(_ns1),
+                              _getTimeseriesOptions(_ns1),
+                              BSON(_timeField << bucketTime + Seconds(1) << _metaField << 0),
+                              BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                              findBucket)
+                     .getValue();
+    ASSERT_NE(batch->bucket()->id(), bucketId);
+    _commit(batch, 0);
+}
+
 }  // namespace
 }  // namespace mongo
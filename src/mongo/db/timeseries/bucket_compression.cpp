@@ -0,0 +1,449 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mongo/base/data_range_cursor.h"
+#include "mongo/base/parse_number.h"
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/util/simple8b_type_util.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+// A compressed column is laid out as:
+//   <varint row count> <presence flag> [<presence bitmap>] <varint control length> <control>
+//   <literal pool>
+// where the control section is a sequence of runs, each an opcode followed by a varint count, and
+// the literal pool is a BSON array holding the values of every kLiteral run in order.
+enum ColumnOp : uint8_t {
+    // The next 'count' values of the literal pool.
+    kLiteral = 0,
+    // 'count' repeats of the previous value.
+    kRepeat = 1,
+    // 'count' values, each encoded as varints relative to the previous value of the same type.
+    kDelta = 2,
+};
+
+// A bitmap of the rows holding a value follows the flag only when the column is sparse.
+constexpr uint8_t kAllRowsPresent = 0;
+constexpr uint8_t kPresenceBitmap = 1;
+
+void appendVarint(BufBuilder* buf, uint64_t value) {
+    while (value >= 0x80) {
+        buf->appendChar(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    buf->appendChar(static_cast<char>(value));
+}
+
+uint64_t readVarint(ConstDataRangeCursor* cursor) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        auto byte = cursor->readAndAdvance<uint8_t>();
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    uasserted(6102100, "Malformed varint in compressed time-series column");
+}
+
+bool isDeltaType(BSONType type) {
+    switch (type) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case Date:
+        case bsonTimestamp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the value of a delta-encodable element as unsigned bits, so that deltas wrap around
+// rather than overflow.
+uint64_t valueBits(const BSONElement& elem) {
+    switch (elem.type()) {
+        case NumberInt:
+            return static_cast<uint64_t>(static_cast<int64_t>(elem._numberInt()));
+        case NumberLong:
+            return static_cast<uint64_t>(elem._numberLong());
+        case NumberDouble: {
+            double value = elem._numberDouble();
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+        case Date:
+            return static_cast<uint64_t>(elem.date().toMillisSinceEpoch());
+        case bsonTimestamp:
+            return elem.timestamp().asULL();
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+void appendValueBits(BSONObjBuilder* builder, StringData name, BSONType type, uint64_t bits) {
+    switch (type) {
+        case NumberInt:
+            builder->append(name, static_cast<int>(static_cast<int64_t>(bits)));
+            return;
+        case NumberLong:
+            builder->append(name, static_cast<long long>(bits));
+            return;
+        case NumberDouble: {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            builder->append(name, value);
+            return;
+        }
+        case Date:
+            builder->appendDate(name, Date_t::fromMillisSinceEpoch(static_cast<long long>(bits)));
+            return;
+        case bsonTimestamp:
+            builder->append(name, Timestamp(bits));
+            return;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+bool isSameValue(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.type() == rhs.type() && lhs.valuesize() == rhs.valuesize() &&
+        std::memcmp(lhs.value(), rhs.value(), lhs.valuesize()) == 0;
+}
+
+/**
+ * Encodes the data region column 'column' of a bucket holding 'numRows' measurements into 'out'.
+ * Returns false if the row keys of the column are not ascending indexes below 'numRows'.
+ */
+bool encodeColumn(const BSONObj& column, size_t numRows, BufBuilder* out) {
+    std::vector<uint8_t> presence((numRows + 7) / 8);
+    size_t numPresent = 0;
+    boost::optional<size_t> lastRow;
+
+    BufBuilder control;
+    BufBuilder runPayload;
+    BSONArrayBuilder literals;
+    ColumnOp runOp = kLiteral;
+    uint64_t runLength = 0;
+    auto flushRun = [&] {
+        if (runLength == 0) {
+            return;
+        }
+        control.appendChar(runOp);
+        appendVarint(&control, runLength);
+        control.appendBuf(runPayload.buf(), runPayload.len());
+        runPayload.reset();
+        runLength = 0;
+    };
+
+    BSONElement prev;
+    uint64_t prevDelta = 0;
+    for (auto&& elem : column) {
+        size_t row;
+        if (!NumberParser{}(elem.fieldNameStringData(), &row).isOK() || row >= numRows ||
+            (lastRow && row <= *lastRow)) {
+            return false;
+        }
+        lastRow = row;
+        presence[row / 8] |= 1 << (row % 8);
+        ++numPresent;
+
+        ColumnOp op = kLiteral;
+        if (prev && isSameValue(prev, elem)) {
+            op = kRepeat;
+        } else if (prev && prev.type() == elem.type() && isDeltaType(elem.type())) {
+            op = kDelta;
+        }
+        if (op != runOp) {
+            flushRun();
+            runOp = op;
+        }
+
+        switch (op) {
+            case kLiteral:
+                literals.append(elem);
+                prevDelta = 0;
+                break;
+            case kRepeat:
+                prevDelta = 0;
+                break;
+            case kDelta: {
+                auto bits = valueBits(elem);
+                auto prevBits = valueBits(prev);
+                if (elem.type() == NumberDouble) {
+                    // Neighbouring measurements tend to share their sign, exponent and high
+                    // mantissa bits, and short decimal fractions leave the low mantissa bits
+                    // zero, so the XOR is a few significant bits between runs of zeros. The
+                    // trailing zeros are stored as a count.
+                    auto xorBits = bits ^ prevBits;
+                    auto trailingZeros = xorBits ? countTrailingZeros64(xorBits) : 0;
+                    appendVarint(&runPayload, trailingZeros);
+                    appendVarint(&runPayload, xorBits >> trailingZeros);
+                } else {
+                    // Regularly spaced values have a constant delta, so the delta-of-delta is 0.
+                    uint64_t delta = bits - prevBits;
+                    appendVarint(&runPayload,
+                                 Simple8bTypeUtil::encodeInt64(
+                                     static_cast<int64_t>(delta - prevDelta)));
+                    prevDelta = delta;
+                }
+                break;
+            }
+        }
+        ++runLength;
+        prev = elem;
+    }
+    flushRun();
+
+    appendVarint(out, numRows);
+    if (numPresent == numRows) {
+        out->appendChar(kAllRowsPresent);
+    } else {
+        out->appendChar(kPresenceBitmap);
+        out->appendBuf(presence.data(), presence.size());
+    }
+    appendVarint(out, control.len());
+    out->appendBuf(control.buf(), control.len());
+    auto pool = literals.arr();
+    out->appendBuf(pool.objdata(), pool.objsize());
+    return true;
+}
+
+/**
+ * Decodes a column written by encodeColumn(), appending its values to 'out' under their row keys.
+ */
+void decodeColumn(ConstDataRange data, BSONObjBuilder* out) {
+    ConstDataRangeCursor cursor(data);
+    auto numRows = readVarint(&cursor);
+
+    const uint8_t* presence = nullptr;
+    auto presenceFlag = cursor.readAndAdvance<uint8_t>();
+    if (presenceFlag == kPresenceBitmap) {
+        presence = cursor.data<uint8_t>();
+        cursor.advance((numRows + 7) / 8);
+    } else {
+        uassert(6102101,
+                "Unknown presence flag in compressed time-series column",
+                presenceFlag == kAllRowsPresent);
+    }
+    auto isPresent = [&](uint64_t row) {
+        return !presence || (presence[row / 8] & (1 << (row % 8)));
+    };
+
+    auto controlLength = readVarint(&cursor);
+    ConstDataRangeCursor control(cursor.data(), std::min<uint64_t>(controlLength, cursor.length()));
+    cursor.advance(controlLength);
+
+    uassertStatusOK(validateBSON(cursor.data(), cursor.length()));
+    BSONObj pool(cursor.data());
+    uassert(6102102,
+            "Unexpected trailing bytes in compressed time-series column",
+            static_cast<size_t>(pool.objsize()) == cursor.length());
+    BSONObjIterator literals(pool);
+
+    uint64_t row = 0;
+    auto nextRowKey = [&] {
+        while (row < numRows && !isPresent(row)) {
+            ++row;
+        }
+        uassert(6102103, "Too many values in compressed time-series column", row < numRows);
+        return std::to_string(row++);
+    };
+
+    BSONElement prevLiteral;
+    uint64_t prevBits = 0;
+    uint64_t prevDelta = 0;
+    auto appendPrev = [&](StringData name) {
+        if (isDeltaType(prevLiteral.type())) {
+            appendValueBits(out, name, prevLiteral.type(), prevBits);
+        } else {
+            out->appendAs(prevLiteral, name);
+        }
+    };
+
+    while (!control.empty()) {
+        auto op = control.readAndAdvance<uint8_t>();
+        auto count = readVarint(&control);
+        for (uint64_t i = 0; i < count; ++i) {
+            switch (op) {
+                case kLiteral: {
+                    uassert(6102104,
+                            "Literal pool exhausted in compressed time-series column",
+                            literals.more());
+                    prevLiteral = literals.next();
+                    prevBits = isDeltaType(prevLiteral.type()) ? valueBits(prevLiteral) : 0;
+                    prevDelta = 0;
+                    out->appendAs(prevLiteral, nextRowKey());
+                    break;
+                }
+                case kRepeat:
+                    uassert(6102105,
+                            "Repeat run without a value in compressed time-series column",
+                            prevLiteral);
+                    prevDelta = 0;
+                    appendPrev(nextRowKey());
+                    break;
+                case kDelta: {
+                    uassert(6102106,
+                            "Delta run without a numeric value in compressed time-series column",
+                            isDeltaType(prevLiteral.type()));
+                    if (prevLiteral.type() == NumberDouble) {
+                        auto trailingZeros = readVarint(&control);
+                        uassert(6102111,
+                                "Malformed double in compressed time-series column",
+                                trailingZeros < 64);
+                        prevBits ^= readVarint(&control) << trailingZeros;
+                    } else {
+                        auto encoded = readVarint(&control);
+                        prevDelta += static_cast<uint64_t>(Simple8bTypeUtil::decodeInt64(encoded));
+                        prevBits += prevDelta;
+                    }
+                    appendPrev(nextRowKey());
+                    break;
+                }
+                default:
+                    uasserted(6102107,
+                              str::stream() << "Unknown run type " << static_cast<int>(op)
+                                            << " in compressed time-series column");
+            }
+        }
+    }
+
+    while (row < numRows) {
+        uassert(6102108, "Too few values in compressed time-series column", !isPresent(row));
+        ++row;
+    }
+    uassert(6102110, "Unused literals in compressed time-series column", !literals.more());
+}
+
+// Copies 'bucketDoc', setting control.version to 'version' and transforming each data region
+// column with 'transformColumn'. Returns boost::none if 'transformColumn' does.
+template <typename ColumnFn>
+boost::optional<BSONObj> rewriteBucket(const BSONObj& bucketDoc,
+                                       int version,
+                                       const ColumnFn& transformColumn) {
+    BSONObjBuilder builder;
+    for (auto&& elem : bucketDoc) {
+        auto name = elem.fieldNameStringData();
+        if (name == kBucketControlFieldName) {
+            BSONObjBuilder controlBuilder(builder.subobjStart(name));
+            for (auto&& controlElem : elem.Obj()) {
+                if (controlElem.fieldNameStringData() == kBucketControlVersionFieldName) {
+                    controlBuilder.append(kBucketControlVersionFieldName, version);
+                } else {
+                    controlBuilder.append(controlElem);
+                }
+            }
+        } else if (name == kBucketDataFieldName) {
+            BSONObjBuilder dataBuilder(builder.subobjStart(name));
+            for (auto&& column : elem.Obj()) {
+                if (!transformColumn(column, &dataBuilder)) {
+                    return boost::none;
+                }
+            }
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
+bool hasControlVersion(const BSONObj& bucketDoc, int version) {
+    auto control = bucketDoc[kBucketControlFieldName];
+    return control.type() == Object &&
+        control.Obj()[kBucketControlVersionFieldName].numberInt() == version &&
+        bucketDoc[kBucketDataFieldName].type() == Object;
+}
+
+}  // namespace
+
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData timeFieldName) {
+    if (!hasControlVersion(bucketDoc, kTimeseriesControlDefaultVersion)) {
+        return boost::none;
+    }
+    auto timeColumn = bucketDoc[kBucketDataFieldName].Obj()[timeFieldName];
+    if (timeColumn.type() != Object) {
+        return boost::none;
+    }
+    size_t numRows = timeColumn.Obj().nFields();
+
+    return rewriteBucket(
+        bucketDoc,
+        kTimeseriesControlCompressedVersion,
+        [numRows](const BSONElement& column, BSONObjBuilder* dataBuilder) {
+            if (column.type() != Object) {
+                return false;
+            }
+            BufBuilder encoded;
+            if (!encodeColumn(column.Obj(), numRows, &encoded)) {
+                return false;
+            }
+            dataBuilder->appendBinData(
+                column.fieldNameStringData(), encoded.len(), BinDataGeneral, encoded.buf());
+            return true;
+        });
+}
+
+boost::optional<BSONObj> decompressBucket(const BSONObj& bucketDoc) {
+    if (!hasControlVersion(bucketDoc, kTimeseriesControlCompressedVersion)) {
+        return boost::none;
+    }
+
+    return rewriteBucket(
+        bucketDoc,
+        kTimeseriesControlDefaultVersion,
+        [](const BSONElement& column, BSONObjBuilder* dataBuilder) {
+            uassert(6102109,
+                    str::stream() << "Expected compressed time-series column '"
+                                  << column.fieldNameStringData() << "' to be BinData",
+                    column.type() == BinData);
+            int length;
+            const char* data = column.binData(length);
+            BSONObjBuilder columnBuilder(dataBuilder->subobjStart(column.fieldNameStringData()));
+            decodeColumn(ConstDataRange(data, length), &columnBuilder);
+            return true;
+        });
+}
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,61 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Returns a copy of the uncompressed bucket document 'bucketDoc' in which each column of the data
+ * region has been replaced by a single BinData value, and control.version has been set to
+ * kTimeseriesControlCompressedVersion. Every column is encoded as a stream of runs:
+ *   - integers, dates and timestamps as zig-zag varint deltas-of-deltas from the previous value,
+ *   - doubles as the XOR of their bits with the previous value, minus its trailing zeros,
+ *   - repeated values of any type as a single run length,
+ *   - anything else as a literal BSON value.
+ *
+ * Returns boost::none if the bucket is already compressed or its data region does not have the
+ * layout written by the bucket catalog ("0", "1", ... row keys in ascending order).
+ */
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData timeFieldName);
+
+/**
+ * Inverse of compressBucket(). Returns boost::none if 'bucketDoc' is not compressed, and throws if
+ * a compressed column is malformed.
+ */
+boost::optional<BSONObj> decompressBucket(const BSONObj& bucketDoc);
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::timeseries {
+namespace {
+
+constexpr auto kTimeField = "time"_sd;
+
+// Builds an uncompressed bucket with 'numRows' measurements taken one second apart.
+BSONObj makeBucket(int numRows) {
+    BSONObjBuilder bucket;
+    bucket.append("_id", OID::gen());
+    {
+        BSONObjBuilder control(bucket.subobjStart(kBucketControlFieldName));
+        control.append(kBucketControlVersionFieldName, kTimeseriesControlDefaultVersion);
+        control.append("min", BSON(kTimeField << Date_t::fromMillisSinceEpoch(0)));
+        control.append("max", BSON(kTimeField << Date_t::fromMillisSinceEpoch(numRows * 1000)));
+    }
+    bucket.append(kBucketMetaFieldName, BSON("sensor" << 12));
+    {
+        BSONObjBuilder data(bucket.subobjStart(kBucketDataFieldName));
+        BSONObjBuilder time(data.subobjStart(kTimeField));
+        for (int i = 0; i < numRows; ++i) {
+            time.appendDate(std::to_string(i), Date_t::fromMillisSinceEpoch(i * 1000));
+        }
+        time.done();
+
+        BSONObjBuilder temperature(data.subobjStart("temperature"));
+        for (int i = 0; i < numRows; ++i) {
+            temperature.append(std::to_string(i), 20.0 + (i % 8) * 0.25);
+        }
+        temperature.done();
+
+        BSONObjBuilder count(data.subobjStart("count"));
+        for (int i = 0; i < numRows; ++i) {
+            count.append(std::to_string(i), static_cast<long long>(i * 3));
+        }
+        count.done();
+
+        BSONObjBuilder status(data.subobjStart("status"));
+        for (int i = 0; i < numRows; ++i) {
+            status.append(std::to_string(i), i < numRows / 2 ? "ok" : "degraded");
+        }
+    }
+    return bucket.obj();
+}
+
+TEST(BucketCompressionTest, RoundTripsRegularBucket) {
+    auto bucket = makeBucket(1000);
+    auto compressed = compressBucket(bucket, kTimeField);
+    ASSERT(compressed);
+
+    ASSERT_EQ(
+        (*compressed)[kBucketControlFieldName][kBucketControlVersionFieldName].numberInt(),
+        kTimeseriesControlCompressedVersion);
+    for (auto&& column : (*compressed)[kBucketDataFieldName].Obj()) {
+        ASSERT_EQ(column.type(), BSONType::BinData);
+    }
+    ASSERT_LT(compressed->objsize() * 8, bucket.objsize());
+
+    auto decompressed = decompressBucket(*compressed);
+    ASSERT(decompressed);
+    ASSERT_BSONOBJ_BINARY_EQ(*decompressed, bucket);
+}
+
+TEST(BucketCompressionTest, RoundTripsSparseAndMixedTypeColumns) {
+    auto bucket = fromjson(
+        "{control: {version: 1, min: {time: {$date: 0}}, max: {time: {$date: 3000}}}, "
+        "data: {time: {'0': {$date: 0}, '1': {$date: 1000}, '2': {$date: 2000}, "
+        "'3': {$date: 3000}, '4': {$date: 3000}}, "
+        "a: {'1': 1, '2': {$numberLong: '2'}, '4': 2.5}, "
+        "b: {'0': 'x', '1': 'x', '2': {c: 1}, '3': [1, 2], '4': [1, 2]}, "
+        "c: {'0': {$timestamp: {t: 5, i: 1}}, '3': {$timestamp: {t: 5, i: 2}}}, "
+        "d: {'0': -2147483648, '1': 2147483647, '2': -2147483648}, "
+        "e: {'0': NaN, '1': -0.0, '2': 0.0, '3': Infinity}}}");
+    auto compressed = compressBucket(bucket, kTimeField);
+    ASSERT(compressed);
+
+    auto decompressed = decompressBucket(*compressed);
+    ASSERT(decompressed);
+    ASSERT_BSONOBJ_BINARY_EQ(*decompressed, bucket);
+}
+
+TEST(BucketCompressionTest, SkipsBucketsThatCannotBeCompressed) {
+    auto compressed = compressBucket(makeBucket(2), kTimeField);
+    ASSERT(compressed);
+    ASSERT_FALSE(compressBucket(*compressed, kTimeField));
+    ASSERT_FALSE(decompressBucket(makeBucket(2)));
+
+    // Row keys must be ascending indexes of existing measurements.
+    ASSERT_FALSE(compressBucket(
+        fromjson("{control: {version: 1}, data: {time: {'0': 1, '1': 2}, a: {'1': 1, '0': 2}}}"),
+        kTimeField));
+    ASSERT_FALSE(compressBucket(
+        fromjson("{control: {version: 1}, data: {time: {'0': 1, '1': 2}, a: {'2': 1}}}"),
+        kTimeField));
+    ASSERT_FALSE(compressBucket(fromjson("{control: {version: 1}, data: {a: {'0': 1}}}"),
+                                kTimeField));
+}
+
+TEST(BucketCompressionTest, MalformedColumnThrows) {
+    auto notBinData = fromjson("{control: {version: 2}, data: {time: {'0': 1}}}");
+    ASSERT_THROWS_CODE(decompressBucket(notBinData), AssertionException, 6102109);
+
+    // A column claiming two rows but holding no values.
+    const char truncated[] = {2, 0, 0, 5, 0, 0, 0, 0};
+    BSONObjBuilder builder;
+    builder.append("control", BSON("version" << 2));
+    BSONObjBuilder data(builder.subobjStart("data"));
+    data.appendBinData("time", sizeof(truncated), BinDataGeneral, truncated);
+    data.done();
+    ASSERT_THROWS_CODE(decompressBucket(builder.obj()), AssertionException, 6102108);
+}
+
+}  // namespace
+}  // namespace mongo::timeseries
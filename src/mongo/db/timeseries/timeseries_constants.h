@@ -43,6 +43,12 @@ static constexpr StringData kBucketMetaFieldName = "meta"_sd;
 static constexpr StringData kBucketControlFieldName = "control"_sd;
 static constexpr StringData kControlMaxFieldNamePrefix = "control.max."_sd;
 static constexpr StringData kControlMinFieldNamePrefix = "control.min."_sd;
+static constexpr StringData kBucketControlVersionFieldName = "version"_sd;
+
+// Values of control.version for buckets with a plain BSON data region and for buckets whose data
+// region columns have been compressed.
+static constexpr int kTimeseriesControlDefaultVersion = 1;
+static constexpr int kTimeseriesControlCompressedVersion = 2;
 
 // These are hard-coded field names in create collection for time-series collections.
 static constexpr StringData kTimeFieldName = "timeField"_sd;
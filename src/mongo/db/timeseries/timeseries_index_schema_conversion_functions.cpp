@@ -33,6 +33,7 @@
 
 #include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_gen.h"
 #include "mongo/logv2/log.h"
@@ -43,6 +44,14 @@ namespace mongo {
 namespace timeseries {
 
 namespace {
+/**
+ * Returns whether 'field' may be indexed as a measurement field, which excludes the subfields of
+ * the time field and wildcard paths.
+ */
+bool isIndexableMeasurementField(StringData field, StringData timeField) {
+    return !field.startsWith(timeField + ".") && field.find("$**") == std::string::npos;
+}
+
 StatusWith<BSONObj> createBucketsSpecFromTimeseriesSpec(const TimeseriesOptions& timeseriesOptions,
                                                         const BSONObj& timeseriesIndexSpecBSON,
                                                         bool isShardKeySpec) {
@@ -83,35 +92,67 @@ StatusWith<BSONObj> createBucketsSpecFromTimeseriesSpec(const TimeseriesOptions&
             continue;
         }
 
-        if (!metaField) {
+        if (metaField) {
+            if (elem.fieldNameStringData() == *metaField) {
+                // The time-series 'metaField' field name always maps to a field named
+                // timeseries::kBucketMetaFieldName on the underlying buckets collection.
+                builder.appendAs(elem, timeseries::kBucketMetaFieldName);
+                continue;
+            }
+
+            // Time-series indexes on sub-documents of the 'metaField' are allowed.
+            if (elem.fieldNameStringData().startsWith(*metaField + ".")) {
+                builder.appendAs(elem,
+                                 str::stream()
+                                     << timeseries::kBucketMetaFieldName << "."
+                                     << elem.fieldNameStringData().substr(metaField->size() + 1));
+                continue;
+            }
+        }
+
+        if (!feature_flags::gTimeseriesMetricIndexes.isEnabledAndIgnoreFCV() || isShardKeySpec) {
+            if (!metaField) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "Invalid index spec for time-series collection: "
+                                      << redact(timeseriesIndexSpecBSON)
+                                      << ". Indexes are only allowed on the '" << timeField
+                                      << "' field, no other data fields are supported: " << elem};
+            }
+
             return {ErrorCodes::BadValue,
                     str::stream() << "Invalid index spec for time-series collection: "
                                   << redact(timeseriesIndexSpecBSON)
-                                  << ". Indexes are only allowed on the '" << timeField
-                                  << "' field, no other data fields are supported: " << elem};
+                                  << ". Indexes are only supported on the '" << *metaField
+                                  << "' and '" << timeField << "' fields: " << elem};
         }
 
-        if (elem.fieldNameStringData() == *metaField) {
-            // The time-series 'metaField' field name always maps to a field named
-            // timeseries::kBucketMetaFieldName on the underlying buckets collection.
-            builder.appendAs(elem, timeseries::kBucketMetaFieldName);
-            continue;
+        // Lastly, time-series indexes on measurement fields are allowed. They must be ascending or
+        // descending, as they are converted into a compound index on the bounds of the field in
+        // each bucket. An ascending index leads with the maximum, which bounds the buckets matching
+        // {$gt: ...} predicates, and a descending one with the minimum, which bounds those matching
+        // {$lt: ...} predicates. The measurements of the buckets are filtered after unpacking.
+        if (!elem.isNumber() ||
+            !isIndexableMeasurementField(elem.fieldNameStringData(), timeField)) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Invalid index spec for time-series collection: "
+                                  << redact(timeseriesIndexSpecBSON)
+                                  << ". Indexes on measurement fields must be ascending or "
+                                     "descending (numbers only) and cannot be on sub-fields of "
+                                     "the time field or use wildcards: "
+                                  << elem};
         }
 
-        // Lastly, time-series indexes on sub-documents of the 'metaField' are allowed.
-        if (elem.fieldNameStringData().startsWith(*metaField + ".")) {
-            builder.appendAs(elem,
-                             str::stream()
-                                 << timeseries::kBucketMetaFieldName << "."
-                                 << elem.fieldNameStringData().substr(metaField->size() + 1));
-            continue;
+        const std::string minField = str::stream()
+            << timeseries::kControlMinFieldNamePrefix << elem.fieldNameStringData();
+        const std::string maxField = str::stream()
+            << timeseries::kControlMaxFieldNamePrefix << elem.fieldNameStringData();
+        if (elem.number() >= 0) {
+            builder.appendAs(elem, maxField);
+            builder.appendAs(elem, minField);
+        } else {
+            builder.appendAs(elem, minField);
+            builder.appendAs(elem, maxField);
         }
-
-        return {ErrorCodes::BadValue,
-                str::stream() << "Invalid index spec for time-series collection: "
-                              << redact(timeseriesIndexSpecBSON)
-                              << ". Indexes are only supported on the '" << *metaField << "' and '"
-                              << timeField << "' fields: " << elem};
     }
 
     return builder.obj();
@@ -139,7 +180,10 @@ boost::optional<BSONObj> createTimeseriesIndexSpecFromBucketsIndexSpec(
         << timeseries::kControlMaxFieldNamePrefix << timeField;
 
     BSONObjBuilder builder;
-    for (const auto& elem : bucketsIndexSpecBSON) {
+    BSONObjIterator it(bucketsIndexSpecBSON);
+    while (it.more()) {
+        auto elem = it.next();
+
         // The index specification on the time field is ascending or descending.
         if (elem.fieldNameStringData() == controlMinTimeField) {
             if (!elem.isNumber()) {
@@ -156,10 +200,35 @@ boost::optional<BSONObj> createTimeseriesIndexSpecFromBucketsIndexSpec(
             continue;
         }
 
+        // The bounds of a measurement field are indexed together, the maximum first for an
+        // ascending index and the minimum first for a descending one.
+        auto fieldName = elem.fieldNameStringData();
+        bool isMin = fieldName.startsWith(timeseries::kControlMinFieldNamePrefix);
+        if (isMin || fieldName.startsWith(timeseries::kControlMaxFieldNamePrefix)) {
+            auto&& prefix = isMin ? timeseries::kControlMinFieldNamePrefix
+                                  : timeseries::kControlMaxFieldNamePrefix;
+            auto&& otherPrefix = isMin ? timeseries::kControlMaxFieldNamePrefix
+                                       : timeseries::kControlMinFieldNamePrefix;
+            auto measurementField = fieldName.substr(prefix.size());
+            const std::string otherBoundField = str::stream() << otherPrefix << measurementField;
+            auto otherBound = it.more() ? it.next() : BSONElement();
+            if (!elem.isNumber() || (elem.number() >= 0) == isMin || !otherBound ||
+                otherBound.fieldNameStringData() != otherBoundField || !otherBound.isNumber() ||
+                (otherBound.number() >= 0) == isMin ||
+                !isIndexableMeasurementField(measurementField, timeField)) {
+                // This index spec on the underlying buckets collection is not valid for
+                // time-series. Therefore, we will not convert the index spec.
+                return {};
+            }
+
+            builder.appendAs(elem, measurementField);
+            continue;
+        }
+
         if (!metaField) {
             // 'elem' is an invalid index spec field for this time-series collection. It does not
-            // match the time field and there is no metaField set. Therefore, we will not convert
-            // the index spec.
+            // match the time field or a measurement field and there is no metaField set.
+            // Therefore, we will not convert the index spec.
             return {};
         }
 
@@ -177,7 +246,8 @@ boost::optional<BSONObj> createTimeseriesIndexSpecFromBucketsIndexSpec(
         }
 
         // 'elem' is an invalid index spec field for this time-series collection. It matches neither
-        // the time field  nor the metaField field. Therefore, we will not convert the index spec.
+        // the time field, a measurement field nor the metaField field. Therefore, we will not
+        // convert the index spec.
         return {};
     }
 
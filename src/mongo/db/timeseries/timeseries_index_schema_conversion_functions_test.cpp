@@ -34,6 +34,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_gen.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -50,6 +51,10 @@ const std::string kControlMaxTimeFieldName(timeseries::kControlMaxFieldNamePrefi
 const std::string kTimeseriesSomeDataFieldName("somedatafield");
 const std::string kBucketsSomeDataFieldName(timeseries::kBucketDataFieldName + "." +
                                             kTimeseriesSomeDataFieldName);
+const std::string kControlMinSomeDataFieldName(timeseries::kControlMinFieldNamePrefix +
+                                               kTimeseriesSomeDataFieldName);
+const std::string kControlMaxSomeDataFieldName(timeseries::kControlMaxFieldNamePrefix +
+                                               kTimeseriesSomeDataFieldName);
 
 /**
  * Constructs a TimeseriesOptions object for testing.
@@ -244,6 +249,86 @@ TEST(TimeseriesIndexSchemaConversionTest, DataAndMetadataCompoundIndexSpecConver
         timeseriesOptions, timeseriesIndexSpec, bucketsIndexSpec, false /* testShouldSucceed */);
 }
 
+// {somedatafield: 1} <=> {control.max.somedatafield: 1, control.min.somedatafield: 1}
+TEST(TimeseriesIndexSchemaConversionTest, AscendingMeasurementIndexSpecConversion) {
+    RAIIServerParameterControllerForTest controller("featureFlagTimeseriesMetricIndexes", true);
+    TimeseriesOptions timeseriesOptions = makeTimeseriesOptions();
+    BSONObj timeseriesIndexSpec = BSON(kTimeseriesSomeDataFieldName << 1);
+    BSONObj bucketsIndexSpec =
+        BSON(kControlMaxSomeDataFieldName << 1 << kControlMinSomeDataFieldName << 1);
+
+    testBothWaysIndexSpecConversion(timeseriesOptions, timeseriesIndexSpec, bucketsIndexSpec);
+}
+
+// {somedatafield: -1} <=> {control.min.somedatafield: -1, control.max.somedatafield: -1}
+TEST(TimeseriesIndexSchemaConversionTest, DescendingMeasurementIndexSpecConversion) {
+    RAIIServerParameterControllerForTest controller("featureFlagTimeseriesMetricIndexes", true);
+    TimeseriesOptions timeseriesOptions = makeTimeseriesOptions();
+    BSONObj timeseriesIndexSpec = BSON(kTimeseriesSomeDataFieldName << -1);
+    BSONObj bucketsIndexSpec =
+        BSON(kControlMinSomeDataFieldName << -1 << kControlMaxSomeDataFieldName << -1);
+
+    testBothWaysIndexSpecConversion(timeseriesOptions, timeseriesIndexSpec, bucketsIndexSpec);
+}
+
+// {mm: 1, somedatafield: 1, tm: -1} <=>
+// {meta: 1, control.max.somedatafield: 1, control.min.somedatafield: 1, control.max.tm: -1,
+// control.min.tm: -1}
+TEST(TimeseriesIndexSchemaConversionTest, MetadataMeasurementAndTimeCompoundIndexSpecConversion) {
+    RAIIServerParameterControllerForTest controller("featureFlagTimeseriesMetricIndexes", true);
+    TimeseriesOptions timeseriesOptions = makeTimeseriesOptions();
+    BSONObj timeseriesIndexSpec = BSON(kTimeseriesMetaFieldName
+                                       << 1 << kTimeseriesSomeDataFieldName << 1
+                                       << kTimeseriesTimeFieldName << -1);
+    BSONObj bucketsIndexSpec =
+        BSON(timeseries::kBucketMetaFieldName
+             << 1 << kControlMaxSomeDataFieldName << 1 << kControlMinSomeDataFieldName << 1
+             << kControlMaxTimeFieldName << -1 << kControlMinTimeFieldName << -1);
+
+    testBothWaysIndexSpecConversion(timeseriesOptions, timeseriesIndexSpec, bucketsIndexSpec);
+}
+
+// {somedatafield: "hashed"} <=> {control.min.somedatafield: "hashed"}
+TEST(TimeseriesIndexSchemaConversionTest, HashedMeasurementIndexSpecConversionFails) {
+    RAIIServerParameterControllerForTest controller("featureFlagTimeseriesMetricIndexes", true);
+    TimeseriesOptions timeseriesOptions = makeTimeseriesOptions();
+    BSONObj timeseriesIndexSpec = BSON(kTimeseriesSomeDataFieldName << "hashed");
+    BSONObj bucketsIndexSpec = BSON(kControlMinSomeDataFieldName << "hashed");
+
+    testBothWaysIndexSpecConversion(
+        timeseriesOptions, timeseriesIndexSpec, bucketsIndexSpec, false /* testShouldSucceed */);
+}
+
+// {tm.subfield1: 1} <=> {control.max.tm.subfield1: 1, control.min.tm.subfield1: 1}
+TEST(TimeseriesIndexSchemaConversionTest, TimeSubFieldMeasurementIndexSpecConversionFails) {
+    RAIIServerParameterControllerForTest controller("featureFlagTimeseriesMetricIndexes", true);
+    TimeseriesOptions timeseriesOptions = makeTimeseriesOptions();
+    BSONObj timeseriesIndexSpec = BSON(kTimeseriesTimeFieldName + kSubField1Name << 1);
+    BSONObj bucketsIndexSpec = BSON(kControlMaxTimeFieldName + kSubField1Name
+                                    << 1 << kControlMinTimeFieldName + kSubField1Name << 1);
+
+    testBothWaysIndexSpecConversion(
+        timeseriesOptions, timeseriesIndexSpec, bucketsIndexSpec, false /* testShouldSucceed */);
+}
+
+// {control.max.somedatafield: 1} => {}
+TEST(TimeseriesIndexSchemaConversionTest, MeasurementIndexSpecWithSingleBoundDoesNotConvert) {
+    TimeseriesOptions timeseriesOptions = makeTimeseriesOptions();
+    BSONObj bucketsIndexSpec = BSON(kControlMaxSomeDataFieldName << 1);
+
+    ASSERT(!timeseries::createTimeseriesIndexSpecFromBucketsIndexSpec(timeseriesOptions,
+                                                                      bucketsIndexSpec));
+}
+
+// {somedatafield: 1} => shard key error
+TEST(TimeseriesIndexSchemaConversionTest, MeasurementShardKeySpecConversionFails) {
+    RAIIServerParameterControllerForTest controller("featureFlagTimeseriesMetricIndexes", true);
+    TimeseriesOptions timeseriesOptions = makeTimeseriesOptions();
+
+    ASSERT_NOT_OK(timeseries::createBucketsShardKeySpecFromTimeseriesShardKeySpec(
+        timeseriesOptions, BSON(kTimeseriesSomeDataFieldName << 1)));
+}
+
 // {mm.subfield1: 1, mm.subfield2: 1, mm.foo:1, mm.bar: 1, mm.baz: 1, tm: 1} <=>
 // {meta.subfield1: 1, meta.subfield2: 1, meta.foo: 1, meta.bar: 1, meta.baz: 1, control.min.tm: 1,
 // control.max.tm: 1}
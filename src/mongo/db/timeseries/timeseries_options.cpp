@@ -85,10 +85,15 @@ bool optionsAreEqual(const TimeseriesOptions& option1, const TimeseriesOptions&
     const auto option2BucketSpan = option2.getBucketMaxSpanSeconds()
         ? *option2.getBucketMaxSpanSeconds()
         : getMaxSpanSecondsFromGranularity(option2.getGranularity());
+    const auto& option1Rollup = option1.getRollup();
+    const auto& option2Rollup = option2.getRollup();
+    const bool rollupsAreEqual = option1Rollup && option2Rollup
+        ? option1Rollup->toBSON().binaryEqual(option2Rollup->toBSON())
+        : !option1Rollup && !option2Rollup;
     return option1.getTimeField() == option1.getTimeField() &&
         option1.getMetaField() == option2.getMetaField() &&
         option1.getGranularity() == option2.getGranularity() &&
-        option1BucketSpan == option2BucketSpan;
+        option1BucketSpan == option2BucketSpan && rollupsAreEqual;
 }
 
 }  // namespace timeseries
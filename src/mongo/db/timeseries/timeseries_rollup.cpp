@@ -0,0 +1,311 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/timeseries_rollup.h"
+
+#include <limits>
+#include <map>
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/platform/decimal128.h"
+#include "mongo/platform/overflow_arithmetic.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+enum class RollupOp { kMin, kMax, kSum };
+
+struct AccumulatorSpec {
+    StringData outputField;
+    RollupOp op;
+    // The measurement field to accumulate, or empty if 'constant' is accumulated for every
+    // measurement instead.
+    StringData inputField;
+    BSONElement constant;
+};
+
+/**
+ * Parses the accumulators of the rollup in 'options'. The returned specs point into 'options',
+ * which must outlive them.
+ */
+StatusWith<std::vector<AccumulatorSpec>> parseAccumulators(const TimeseriesOptions& options) {
+    auto isMetaField = [&](StringData field) {
+        return options.getMetaField() && field == *options.getMetaField();
+    };
+
+    std::vector<AccumulatorSpec> specs;
+    for (auto&& elem : options.getRollup()->getAccumulators()) {
+        auto field = elem.fieldNameStringData();
+        if (field.empty() || field.find('.') != std::string::npos || field.startsWith("$") ||
+            field == options.getTimeField() || isMetaField(field)) {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "Invalid time-series rollup field name: '" << field << "'"};
+        }
+        if (elem.type() != BSONType::Object || elem.Obj().nFields() != 1) {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "Time-series rollup field '" << field
+                                  << "' must be an object with a single accumulator"};
+        }
+
+        AccumulatorSpec spec{field};
+        auto acc = elem.Obj().firstElement();
+        auto name = acc.fieldNameStringData();
+        if (name == "$min"_sd) {
+            spec.op = RollupOp::kMin;
+        } else if (name == "$max"_sd) {
+            spec.op = RollupOp::kMax;
+        } else if (name == "$sum"_sd) {
+            spec.op = RollupOp::kSum;
+        } else {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "Unsupported time-series rollup accumulator '" << name
+                                  << "' for field '" << field << "'"};
+        }
+
+        if (acc.type() == BSONType::String && acc.valueStringData().startsWith("$")) {
+            spec.inputField = acc.valueStringData().substr(1);
+            if (spec.inputField.empty() || spec.inputField.find('.') != std::string::npos ||
+                isMetaField(spec.inputField)) {
+                return {ErrorCodes::InvalidOptions,
+                        str::stream()
+                            << "Time-series rollup field '" << field
+                            << "' must accumulate a top-level measurement field, but found '"
+                            << acc.valueStringData() << "'"};
+            }
+        } else if (spec.op == RollupOp::kSum && acc.isNumber()) {
+            spec.constant = acc;
+        } else {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "Time-series rollup field '" << field
+                                  << "' must accumulate a field path"
+                                  << (spec.op == RollupOp::kSum ? " or a number" : "")};
+        }
+        specs.push_back(spec);
+    }
+
+    if (specs.empty()) {
+        return {ErrorCodes::InvalidOptions,
+                "A time-series rollup must have at least one accumulator"};
+    }
+    return specs;
+}
+
+/**
+ * The running result of one accumulator over the measurements of a bin.
+ */
+class Accumulator {
+public:
+    Accumulator(const AccumulatorSpec& spec, const CollatorInterface* collator)
+        : _spec(spec), _collator(collator) {}
+
+    void process(const BSONElement& value) {
+        switch (_spec.op) {
+            case RollupOp::kMin:
+            case RollupOp::kMax: {
+                if (value.eoo() || value.isNull() || value.type() == BSONType::Undefined) {
+                    return;
+                }
+                if (_extremum.eoo()) {
+                    _extremum = value;
+                    return;
+                }
+                auto cmp = value.woCompare(_extremum, 0, _collator);
+                if (_spec.op == RollupOp::kMin ? cmp < 0 : cmp > 0) {
+                    _extremum = value;
+                }
+                return;
+            }
+            case RollupOp::kSum:
+                switch (value.type()) {
+                    case BSONType::NumberInt:
+                    case BSONType::NumberLong: {
+                        long long sum;
+                        if (overflow::add(_longSum, value.safeNumberLong(), &sum)) {
+                            // Keep summing in double precision, as $sum does.
+                            _doubleSum += static_cast<double>(_longSum) +
+                                static_cast<double>(value.safeNumberLong());
+                            _longSum = 0;
+                            _hasDouble = true;
+                        } else {
+                            _longSum = sum;
+                        }
+                        return;
+                    }
+                    case BSONType::NumberDouble:
+                        _doubleSum += value.numberDouble();
+                        _hasDouble = true;
+                        return;
+                    case BSONType::NumberDecimal:
+                        _decimalSum = _decimalSum.add(value.numberDecimal());
+                        _hasDecimal = true;
+                        return;
+                    default:
+                        return;
+                }
+        }
+        MONGO_UNREACHABLE;
+    }
+
+    void appendResult(BSONObjBuilder* builder) const {
+        if (_spec.op != RollupOp::kSum) {
+            if (_extremum.eoo()) {
+                builder->appendNull(_spec.outputField);
+            } else {
+                builder->appendAs(_extremum, _spec.outputField);
+            }
+        } else if (_hasDecimal) {
+            builder->append(_spec.outputField,
+                            _decimalSum.add(Decimal128(_doubleSum))
+                                .add(Decimal128(static_cast<std::int64_t>(_longSum))));
+        } else if (_hasDouble) {
+            builder->append(_spec.outputField, _doubleSum + static_cast<double>(_longSum));
+        } else if (_longSum >= std::numeric_limits<int>::min() &&
+                   _longSum <= std::numeric_limits<int>::max()) {
+            builder->append(_spec.outputField, static_cast<int>(_longSum));
+        } else {
+            builder->append(_spec.outputField, _longSum);
+        }
+    }
+
+private:
+    const AccumulatorSpec& _spec;
+    const CollatorInterface* _collator;
+
+    // The result of $min or $max, pointing into the bucket being rolled up.
+    BSONElement _extremum;
+
+    // The partial sums of the integral, double and decimal values added by $sum.
+    long long _longSum = 0;
+    double _doubleSum = 0;
+    Decimal128 _decimalSum;
+    bool _hasDouble = false;
+    bool _hasDecimal = false;
+};
+
+}  // namespace
+
+int getRollupBinSeconds(RollupGranularityEnum granularity) {
+    switch (granularity) {
+        case RollupGranularityEnum::Minute:
+            return 60;
+        case RollupGranularityEnum::Hour:
+            return 60 * 60;
+        case RollupGranularityEnum::Day:
+            return 60 * 60 * 24;
+    }
+    MONGO_UNREACHABLE;
+}
+
+Status validateRollup(const NamespaceString& ns, const TimeseriesOptions& options) {
+    invariant(options.getRollup());
+
+    auto into = options.getRollup()->getInto();
+    if (!NamespaceString::validCollectionName(into) || into.startsWith("system.") ||
+        into == ns.coll()) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "Invalid time-series rollup collection: '" << into << "'"};
+    }
+    return parseAccumulators(options).getStatus();
+}
+
+std::vector<BSONObj> rollUpBucket(const BSONObj& bucketDoc,
+                                  const TimeseriesOptions& options,
+                                  const CollatorInterface* collator) {
+    invariant(options.getRollup());
+    auto specs = uassertStatusOK(parseAccumulators(options));
+
+    auto decompressed = decompressBucket(bucketDoc);
+    const auto& bucket = decompressed ? *decompressed : bucketDoc;
+
+    auto data = bucket.getObjectField(kBucketDataFieldName);
+    std::vector<BSONObjIterator> columns;
+    for (auto&& spec : specs) {
+        columns.emplace_back(spec.inputField.empty() ? BSONObj()
+                                                     : data.getObjectField(spec.inputField));
+    }
+
+    const long long binMillis = durationCount<Milliseconds>(
+        Seconds(getRollupBinSeconds(options.getRollup()->getGranularity())));
+    std::map<long long, std::vector<Accumulator>> bins;
+    for (auto&& timeElem : data.getObjectField(options.getTimeField())) {
+        if (timeElem.type() != BSONType::Date) {
+            continue;
+        }
+
+        auto millis = timeElem.date().toMillisSinceEpoch();
+        auto binStart = millis - (millis % binMillis + binMillis) % binMillis;
+        auto it = bins.find(binStart);
+        if (it == bins.end()) {
+            std::vector<Accumulator> accumulators;
+            for (auto&& spec : specs) {
+                accumulators.emplace_back(spec, collator);
+            }
+            it = bins.emplace(binStart, std::move(accumulators)).first;
+        }
+
+        // The columns are sparse, but hold their rows in the same order as the time column.
+        auto rowKey = timeElem.fieldNameStringData();
+        for (size_t i = 0; i < specs.size(); ++i) {
+            BSONElement value = specs[i].constant;
+            if (!specs[i].inputField.empty()) {
+                value = columns[i].more() && (*columns[i]).fieldNameStringData() == rowKey
+                    ? columns[i].next()
+                    : BSONElement();
+            }
+            it->second[i].process(value);
+        }
+    }
+
+    auto meta = bucket[kBucketMetaFieldName];
+    std::vector<BSONObj> rollupDocs;
+    for (auto&& [binStart, accumulators] : bins) {
+        BSONObjBuilder builder;
+        builder.append(options.getTimeField(), Date_t::fromMillisSinceEpoch(binStart));
+        if (options.getMetaField() && meta) {
+            builder.appendAs(meta, *options.getMetaField());
+        }
+        for (auto&& accumulator : accumulators) {
+            accumulator.appendResult(&builder);
+        }
+        rollupDocs.push_back(builder.obj());
+    }
+    return rollupDocs;
+}
+
+}  // namespace timeseries
+}  // namespace mongo
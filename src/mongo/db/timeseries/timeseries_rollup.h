@@ -0,0 +1,75 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
+
+namespace mongo {
+
+class CollatorInterface;
+class NamespaceString;
+
+namespace timeseries {
+
+/**
+ * Returns the number of seconds summarized by each document of a rollup with the given
+ * granularity.
+ */
+int getRollupBinSeconds(RollupGranularityEnum granularity);
+
+/**
+ * Returns an error if the rollup in 'options', which must have one, is not valid for the
+ * time-series collection 'ns'. Each accumulator must be one of {$min: "$<field>"},
+ * {$max: "$<field>"}, {$sum: "$<field>"} or {$sum: <number>}, where <field> is a top-level
+ * measurement field other than the metaField, and may not be named after the timeField or the
+ * metaField.
+ */
+Status validateRollup(const NamespaceString& ns, const TimeseriesOptions& options);
+
+/**
+ * Aggregates the measurements of the bucket document 'bucketDoc' into one document for each bin of
+ * the rollup in 'options' that they fall into, in order of time. Each document holds the start of
+ * its bin in the timeField, the metadata of the bucket in the metaField, and the result of each
+ * accumulator over the measurements of this bucket in the bin. $min and $max ignore null and
+ * missing values and return null if there are no others, while $sum ignores non-numeric values.
+ *
+ * Since a bin may span several buckets, the documents for a bin have to be combined with the same
+ * accumulators to get the summary of all of its measurements.
+ */
+std::vector<BSONObj> rollUpBucket(const BSONObj& bucketDoc,
+                                  const TimeseriesOptions& options,
+                                  const CollatorInterface* collator);
+
+}  // namespace timeseries
+}  // namespace mongo
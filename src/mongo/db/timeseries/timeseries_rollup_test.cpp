@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_rollup.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::timeseries {
+namespace {
+
+const NamespaceString kNss("test.weather");
+
+TimeseriesOptions makeOptions(const BSONObj& accumulators) {
+    return TimeseriesOptions::parse(
+        IDLParserErrorContext("TimeseriesRollupTest"),
+        BSON("timeField"
+             << "time"
+             << "metaField"
+             << "tag"
+             << "rollup"
+             << BSON("into"
+                     << "weather_hourly"
+                     << "granularity"
+                     << "hour"
+                     << "accumulators" << accumulators)));
+}
+
+// A bucket with measurements at 0:30, 0:59 and 1:10, the last of which has no 'temp'.
+BSONObj makeBucket() {
+    return fromjson(R"({
+        _id: {$oid: '000000000000000000000000'},
+        control: {version: 1,
+                  min: {time: {$date: 0}, temp: 10},
+                  max: {time: {$date: 4200000}, temp: 25.5}},
+        meta: {sensor: 1},
+        data: {
+            time: {'0': {$date: 1800000}, '1': {$date: 3540000}, '2': {$date: 4200000}},
+            temp: {'0': 10, '1': 25.5},
+            status: {'0': 'ok', '1': 'ok', '2': 'degraded'}
+        }
+    })");
+}
+
+TEST(TimeseriesRollupTest, ValidRollup) {
+    ASSERT_OK(validateRollup(kNss,
+                             makeOptions(fromjson(
+                                 "{lo: {$min: '$temp'}, hi: {$max: '$temp'}, total: {$sum: "
+                                 "'$temp'}, n: {$sum: 1}, last: {$max: '$time'}}"))));
+}
+
+TEST(TimeseriesRollupTest, InvalidRollup) {
+    for (auto&& accumulators : {"{}",
+                                "{lo: 1}",
+                                "{lo: {$avg: '$temp'}}",
+                                "{lo: {$min: '$temp', $max: '$temp'}}",
+                                "{lo: {$min: 'temp'}}",
+                                "{lo: {$min: 1}}",
+                                "{lo: {$min: '$a.b'}}",
+                                "{lo: {$min: '$tag'}}",
+                                "{time: {$min: '$temp'}}",
+                                "{tag: {$min: '$temp'}}",
+                                "{'a.b': {$min: '$temp'}}"}) {
+        ASSERT_EQ(validateRollup(kNss, makeOptions(fromjson(accumulators))),
+                  ErrorCodes::InvalidOptions)
+            << accumulators;
+    }
+
+    auto options = makeOptions(fromjson("{n: {$sum: 1}}"));
+    for (auto&& into : {"weather", "system.buckets.weather", "", ".weather"}) {
+        auto rollup = *options.getRollup();
+        rollup.setInto(into);
+        options.setRollup(rollup);
+        ASSERT_EQ(validateRollup(kNss, options), ErrorCodes::InvalidOptions) << into;
+    }
+}
+
+TEST(TimeseriesRollupTest, RollUpBucketIntoBins) {
+    auto options = makeOptions(fromjson(
+        "{lo: {$min: '$temp'}, hi: {$max: '$temp'}, total: {$sum: '$temp'}, n: {$sum: 1}, "
+        "statuses: {$sum: '$status'}}"));
+
+    auto rollupDocs = rollUpBucket(makeBucket(), options, nullptr);
+    ASSERT_EQ(rollupDocs.size(), 2);
+    ASSERT_BSONOBJ_EQ(rollupDocs[0],
+                      fromjson("{time: {$date: 0}, tag: {sensor: 1}, lo: 10, hi: 25.5, total: "
+                               "35.5, n: 2, statuses: 0}"));
+    ASSERT_BSONOBJ_EQ(rollupDocs[1],
+                      fromjson("{time: {$date: 3600000}, tag: {sensor: 1}, lo: null, hi: null, "
+                               "total: 0, n: 1, statuses: 0}"));
+}
+
+TEST(TimeseriesRollupTest, RollUpCompressedBucket) {
+    auto options = makeOptions(fromjson("{hi: {$max: '$temp'}, n: {$sum: 1}}"));
+
+    auto compressed = compressBucket(makeBucket(), "time"_sd);
+    ASSERT(compressed);
+    auto rollupDocs = rollUpBucket(*compressed, options, nullptr);
+    ASSERT_EQ(rollupDocs.size(), 2);
+    ASSERT_BSONOBJ_EQ(rollupDocs[0],
+                      fromjson("{time: {$date: 0}, tag: {sensor: 1}, hi: 25.5, n: 2}"));
+    ASSERT_BSONOBJ_EQ(rollupDocs[1],
+                      fromjson("{time: {$date: 3600000}, tag: {sensor: 1}, hi: null, n: 1}"));
+}
+
+TEST(TimeseriesRollupTest, SumPromotesOnOverflow) {
+    auto options = makeOptions(fromjson("{total: {$sum: '$v'}}"));
+
+    auto bucket = BSON("_id" << OID() << "data"
+                             << BSON("time" << BSON("0" << Date_t() << "1" << Date_t())
+                                            << "v"
+                                            << BSON("0" << std::numeric_limits<long long>::max()
+                                                        << "1" << 1LL)));
+    auto rollupDocs = rollUpBucket(bucket, options, nullptr);
+    ASSERT_EQ(rollupDocs.size(), 1);
+    ASSERT_EQ(rollupDocs[0]["total"].type(), BSONType::NumberDouble);
+    ASSERT_EQ(rollupDocs[0]["total"].numberDouble(),
+              static_cast<double>(std::numeric_limits<long long>::max()) + 1);
+    ASSERT(rollupDocs[0]["tag"].eoo());
+}
+
+}  // namespace
+}  // namespace mongo::timeseries
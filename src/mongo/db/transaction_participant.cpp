@@ -264,12 +264,11 @@ void updateSessionEntry(OperationContext* opCtx, const UpdateRequest& updateRequ
     auto originalDoc = originalRecordData.toBson();
 
     invariant(collection->getDefaultCollator() == nullptr);
-    boost::intrusive_ptr<ExpressionContext> expCtx(
-        new ExpressionContext(opCtx, nullptr, updateRequest.getNamespaceString()));
 
-    auto matcher =
-        fassert(40673, MatchExpressionParser::parse(updateRequest.getQuery(), std::move(expCtx)));
-    if (!matcher->matchesBSON(originalDoc)) {
+    // The query is on _id only, which the document was found by, so comparing _id is all the
+    // matching there is to do. That spares every retryable write parsing a match expression.
+    invariant(updateRequest.getQuery().nFields() == 1);
+    if (originalDoc["_id"].woCompare(idToFetch, false) != 0) {
         // Document no longer match what we expect so throw WCE to make the caller re-examine.
         throw WriteConflictException();
     }
@@ -1266,6 +1265,9 @@ void TransactionParticipant::Participant::addTransactionOperation(
     invariant(p().autoCommit && !*p().autoCommit && o().activeTxnNumber != kUninitializedTxnNumber);
     invariant(opCtx->lockState()->inAWriteUnitOfWork());
     p().transactionOperations.push_back(operation);
+    if (gTransactionSerializeOperationsAhead.load()) {
+        p().transactionOperations.back().serializeForApplyOps();
+    }
     p().transactionOperationBytes +=
         repl::DurableOplogEntry::getDurableReplOperationSize(operation);
     if (!operation.getPreImage().isEmpty()) {
@@ -33,6 +33,9 @@
 
 #include "mongo/db/ttl.h"
 
+#include <algorithm>
+#include <map>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
@@ -41,6 +44,7 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
@@ -61,6 +65,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log_with_sampling.h"
 
 namespace mongo {
@@ -115,6 +120,27 @@ public:
             tc.get()->setSystemOperationKillableByStepdown(lk);
         }
 
+        if (auto numWorkers = ttlMonitorNumWorkers.load(); numWorkers > 1) {
+            ThreadPool::Options options;
+            options.poolName = "TTLMonitorWorkers";
+            options.minThreads = 0;
+            options.maxThreads = numWorkers;
+            options.onCreateThread = [](const std::string& threadName) {
+                Client::initThread(threadName);
+                AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+                stdx::lock_guard<Client> lk(cc());
+                cc().setSystemOperationKillableByStepdown(lk);
+            };
+            _workers = std::make_unique<ThreadPool>(options);
+            _workers->startup();
+        }
+        ON_BLOCK_EXIT([&] {
+            if (_workers) {
+                _workers->shutdown();
+                _workers->join();
+            }
+        });
+
         while (true) {
             {
                 // Wait until either ttlMonitorSleepSecs passes or a shutdown is requested.
@@ -171,7 +197,63 @@ public:
         LOGV2(3684101, "Finished shutting down TTL collection monitor thread");
     }
 
+    /**
+     * Appends what the last pass did on every TTL index, and on every clustered collection with
+     * an expiration, as of the last time they were worked on.
+     */
+    void appendStats(BSONObjBuilder* builder) const {
+        builder->append("numWorkers", std::max(1, ttlMonitorNumWorkers.load()));
+
+        stdx::lock_guard<Latch> lk(_statsMutex);
+        BSONArrayBuilder indexes(builder->subarrayStart("indexes"));
+        for (const auto& [key, stats] : _indexStats) {
+            BSONObjBuilder bob(indexes.subobjStart());
+            bob.append("ns", stats.nss.ns());
+            bob.append("index", stats.index);
+            bob.append("lastPass", stats.lastPass);
+            bob.append("numDeleted", stats.numDeleted);
+            bob.append("durationMillis", durationCount<Milliseconds>(stats.duration));
+            bob.append("lagMillis", durationCount<Milliseconds>(stats.lag));
+            if (stats.oldestRemainingAge) {
+                bob.append("oldestRemainingAgeMillis",
+                           durationCount<Milliseconds>(*stats.oldestRemainingAge));
+            }
+        }
+    }
+
 private:
+    /**
+     * What the TTL monitor did the last time it worked on one TTL index, or on a clustered
+     * collection, whose index is reported as "_id".
+     */
+    struct IndexStats {
+        NamespaceString nss;
+        std::string index;
+        Date_t lastPass;
+        long long numDeleted = 0;
+        Milliseconds duration{0};
+
+        // How long the oldest expired document had been waiting to be deleted when the work
+        // started, or zero if there was none.
+        Milliseconds lag{0};
+
+        // The age of the oldest document left once the work was done, which has not expired
+        // unless it did while the work went on.
+        boost::optional<Milliseconds> oldestRemainingAge;
+    };
+
+    static constexpr StringData kClusteredIdIndexName = "_id"_sd;
+
+    static std::string indexNameFor(const TTLCollectionCache::Info& info) {
+        return stdx::visit(
+            visit_helper::Overloaded{
+                [](const TTLCollectionCache::ClusteredId&) {
+                    return kClusteredIdIndexName.toString();
+                },
+                [](const TTLCollectionCache::IndexName& indexName) { return indexName; }},
+            info);
+    }
+
     /**
      * Gets all TTL specifications for every collection and deletes expired documents.
      */
@@ -189,42 +271,170 @@ private:
         auto ttlInfos = ttlCollectionCache.getTTLInfos();
 
         // Increment the metric after the TTL work has been finished.
-        ON_BLOCK_EXIT([&] { ttlPasses.increment(); });
-
-        // Perform a pass for every collection and index described as being TTL.
-        for (const auto& [uuid, infos] : ttlInfos) {
-            for (const auto& info : infos) {
-                // Skip collections that have not been made visible yet. The TTLCollectionCache
-                // already has the index information available, so we want to avoid removing it
-                // until the collection is visible.
-                auto collectionCatalog = CollectionCatalog::get(opCtx);
-                if (collectionCatalog->isCollectionAwaitingVisibility(uuid)) {
-                    continue;
-                }
-
-                // The collection was dropped.
-                auto nss = collectionCatalog->lookupNSSByUUID(opCtx, uuid);
-                if (!nss) {
-                    ttlCollectionCache.deregisterTTLInfo(uuid, info);
-                    continue;
+        ON_BLOCK_EXIT([&] {
+            pruneStats(ttlInfos);
+            ttlPasses.increment();
+        });
+
+        if (!_workers) {
+            // Perform a pass for every collection and index described as being TTL.
+            for (const auto& [uuid, infos] : ttlInfos) {
+                if (!deleteExpiredFromCollection(opCtx, &ttlCollectionCache, uuid, infos)) {
+                    return;
                 }
+            }
+            return;
+        }
 
-                try {
-                    deleteExpired(opCtx, &ttlCollectionCache, uuid, *nss, info);
-                } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
-                    LOGV2_WARNING(22537,
-                                  "TTLMonitor was interrupted, waiting before doing another pass",
-                                  "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+        // Every collection is a task of its own, so that a collection with a lot to delete holds
+        // up one worker only. The tasks are queued in an order which rotates from pass to pass, so
+        // that the same collections do not always wait for all others.
+        std::vector<std::pair<UUID, std::vector<TTLCollectionCache::Info>>> collections(
+            ttlInfos.begin(), ttlInfos.end());
+        if (!collections.empty()) {
+            std::rotate(collections.begin(),
+                        collections.begin() + ttlPasses.get() % collections.size(),
+                        collections.end());
+        }
+        for (auto& collection : collections) {
+            _workers->schedule([this,
+                                ttlCollectionCache = &ttlCollectionCache,
+                                uuid = collection.first,
+                                infos = std::move(collection.second)](Status status) {
+                if (!status.isOK()) {
                     return;
-                } catch (const DBException& ex) {
-                    LOGV2_ERROR(5400703,
-                                "Error running TTL job on collection",
-                                logAttrs(*nss),
-                                "error"_attr = ex);
-                    continue;
                 }
+                auto workerOpCtx = cc().makeOperationContext();
+                deleteExpiredFromCollection(workerOpCtx.get(), ttlCollectionCache, uuid, infos);
+            });
+        }
+        _workers->waitForIdle();
+    }
+
+    /**
+     * Deletes the expired documents of the collection 'uuid' for every one of its 'infos'. Returns
+     * false if that was interrupted, and true otherwise.
+     */
+    bool deleteExpiredFromCollection(OperationContext* opCtx,
+                                     TTLCollectionCache* ttlCollectionCache,
+                                     const UUID& uuid,
+                                     const std::vector<TTLCollectionCache::Info>& infos) {
+        for (const auto& info : infos) {
+            // Skip collections that have not been made visible yet. The TTLCollectionCache
+            // already has the index information available, so we want to avoid removing it
+            // until the collection is visible.
+            auto collectionCatalog = CollectionCatalog::get(opCtx);
+            if (collectionCatalog->isCollectionAwaitingVisibility(uuid)) {
+                continue;
+            }
+
+            // The collection was dropped.
+            auto nss = collectionCatalog->lookupNSSByUUID(opCtx, uuid);
+            if (!nss) {
+                ttlCollectionCache->deregisterTTLInfo(uuid, info);
+                continue;
+            }
+
+            try {
+                deleteExpired(opCtx, ttlCollectionCache, uuid, *nss, info);
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                LOGV2_WARNING(22537,
+                              "TTLMonitor was interrupted, waiting before doing another pass",
+                              "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+                return false;
+            } catch (const DBException& ex) {
+                LOGV2_ERROR(5400703,
+                            "Error running TTL job on collection",
+                            logAttrs(*nss),
+                            "error"_attr = ex);
+                continue;
             }
         }
+        return true;
+    }
+
+    /**
+     * Records what was done on 'index' of 'collection', given the oldest dates it held before and
+     * after deleting the documents which expired before 'expirationDate'.
+     */
+    void recordStats(const CollectionPtr& collection,
+                     StringData index,
+                     long long numDeleted,
+                     Milliseconds duration,
+                     Date_t expirationDate,
+                     boost::optional<Date_t> oldestBefore,
+                     boost::optional<Date_t> oldestAfter) {
+        IndexStats stats;
+        stats.nss = collection->ns();
+        stats.index = index.toString();
+        stats.lastPass = Date_t::now();
+        stats.numDeleted = numDeleted;
+        stats.duration = duration;
+        if (oldestBefore && *oldestBefore < expirationDate) {
+            stats.lag = expirationDate - *oldestBefore;
+        }
+        if (oldestAfter) {
+            stats.oldestRemainingAge = stats.lastPass - *oldestAfter;
+        }
+
+        stdx::lock_guard<Latch> lk(_statsMutex);
+        _indexStats[{collection->uuid(), stats.index}] = std::move(stats);
+    }
+
+    /**
+     * Forgets the stats of the indexes and collections which are no longer among 'ttlInfos'.
+     */
+    void pruneStats(const TTLCollectionCache::InfoMap& ttlInfos) {
+        stdx::lock_guard<Latch> lk(_statsMutex);
+        for (auto it = _indexStats.begin(); it != _indexStats.end();) {
+            auto infos = ttlInfos.find(it->first.first);
+            const std::string& index = it->first.second;
+            bool found = infos != ttlInfos.end() &&
+                std::any_of(infos->second.begin(), infos->second.end(), [&](const auto& info) {
+                    return indexNameFor(info) == index;
+                });
+            it = found ? std::next(it) : _indexStats.erase(it);
+        }
+    }
+
+    /**
+     * Returns the oldest date the TTL index 'desc' holds, if any.
+     */
+    boost::optional<Date_t> oldestIndexedDate(OperationContext* opCtx,
+                                              const CollectionPtr& collection,
+                                              const IndexDescriptor* desc,
+                                              InternalPlanner::Direction direction) const {
+        const Date_t kDawnOfTime =
+            Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::min());
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               &collection,
+                                               desc,
+                                               BSON("" << kDawnOfTime),
+                                               BSON("" << Date_t::max()),
+                                               BoundInclusion::kIncludeBothStartAndEndKeys,
+                                               PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                               direction);
+        BSONObj key;
+        if (exec->getNext(&key, nullptr) != PlanExecutor::ADVANCED) {
+            return boost::none;
+        }
+        return key.firstElement().date();
+    }
+
+    /**
+     * Returns the date of the oldest ObjectId the collection clustered by _id holds, if any.
+     */
+    boost::optional<Date_t> oldestClusteredDate(OperationContext* opCtx,
+                                                const CollectionPtr& collection) const {
+        auto record = collection->getCursor(opCtx)->next();
+        if (!record) {
+            return boost::none;
+        }
+        BSONElement id = record->data.toBson()["_id"];
+        if (id.type() != jstOID) {
+            return boost::none;
+        }
+        return id.OID().asDateT();
     }
 
     /**
@@ -404,8 +614,10 @@ private:
 
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
+        params->writeBatchSize = ttlMonitorWriteBatchSize.load();
         params->canonicalQuery = canonicalQuery.getValue().get();
 
+        const auto oldestBefore = oldestIndexedDate(opCtx, collection, desc, direction);
         Timer timer;
         auto exec =
             InternalPlanner::deleteWithIndexScan(opCtx,
@@ -423,6 +635,13 @@ private:
             ttlDeletedDocuments.increment(numDeleted);
 
             const auto duration = Milliseconds(timer.millis());
+            recordStats(collection,
+                        name,
+                        numDeleted,
+                        duration,
+                        expirationDate,
+                        oldestBefore,
+                        oldestIndexedDate(opCtx, collection, desc, direction));
             if (shouldLogSlowOpWithSampling(opCtx,
                                             logv2::LogComponent::kIndex,
                                             duration,
@@ -476,9 +695,11 @@ private:
 
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
+        params->writeBatchSize = ttlMonitorWriteBatchSize.load();
 
         // Deletes records using a bounded collection scan from the beginning of time to the
         // expiration time (inclusive).
+        const auto oldestBefore = oldestClusteredDate(opCtx, collection);
         Timer timer;
         auto exec =
             InternalPlanner::deleteWithCollectionScan(opCtx,
@@ -494,6 +715,13 @@ private:
             ttlDeletedDocuments.increment(numDeleted);
 
             const auto duration = Milliseconds(timer.millis());
+            recordStats(collection,
+                        kClusteredIdIndexName,
+                        numDeleted,
+                        duration,
+                        expirationDate,
+                        oldestBefore,
+                        oldestClusteredDate(opCtx, collection));
             if (shouldLogSlowOpWithSampling(opCtx,
                                             logv2::LogComponent::kIndex,
                                             duration,
@@ -519,8 +747,42 @@ private:
     mutable stdx::condition_variable _shuttingDownCV;
 
     bool _shuttingDown = false;
+
+    // Runs the work of each pass on several collections at a time, if there is more than one
+    // worker. Only used by the TTLMonitor thread.
+    std::unique_ptr<ThreadPool> _workers;
+
+    // Protects '_indexStats'.
+    mutable Mutex _statsMutex = MONGO_MAKE_LATCH("TTLMonitor::_statsMutex");
+
+    std::map<std::pair<UUID, std::string>, IndexStats> _indexStats;
 };
 
+namespace {
+
+class TTLMonitorServerStatusSection : public ServerStatusSection {
+public:
+    TTLMonitorServerStatusSection() : ServerStatusSection("ttlMonitor") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto ttlMonitor = TTLMonitor::get(opCtx->getServiceContext());
+        if (!ttlMonitor) {
+            return BSONObj();
+        }
+
+        BSONObjBuilder builder;
+        ttlMonitor->appendStats(&builder);
+        return builder.obj();
+    }
+} ttlMonitorServerStatusSection;
+
+}  // namespace
+
 void startTTLMonitor(ServiceContext* serviceContext) {
     std::unique_ptr<TTLMonitor> ttlMonitor = std::make_unique<TTLMonitor>();
     ttlMonitor->go();
@@ -0,0 +1,221 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/fixed_width_update.h"
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/update/document_diff_serialization.h"
+#include "mongo/db/update/update_oplog_entry_serialization.h"
+#include "mongo/db/update/update_oplog_entry_version.h"
+#include "mongo/util/safe_num.h"
+
+namespace mongo {
+
+namespace {
+
+bool isFixedWidth(BSONType type) {
+    switch (type) {
+        case NumberDouble:
+        case NumberInt:
+        case NumberLong:
+        case NumberDecimal:
+        case Bool:
+        case Date:
+        case jstOID:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Returns the element at 'path' in 'doc', or an EOO element if there is none or the path goes
+ * through an array.
+ */
+BSONElement findExistingElement(const BSONObj& doc, const FieldRef& path) {
+    BSONObj obj = doc;
+    BSONElement elem;
+    for (FieldIndex i = 0; i < path.numParts(); ++i) {
+        elem = obj[path.getPart(i)];
+        if (elem.eoo() || elem.type() == Array) {
+            return BSONElement();
+        }
+        if (i + 1 < path.numParts()) {
+            if (elem.type() != Object) {
+                return BSONElement();
+            }
+            obj = elem.embeddedObject();
+        }
+    }
+    return elem;
+}
+
+}  // namespace
+
+boost::optional<FixedWidthUpdate> FixedWidthUpdate::parse(const BSONObj& updateExpr) {
+    FixedWidthUpdate update;
+    for (auto&& opElem : updateExpr) {
+        Op op;
+        if (opElem.fieldNameStringData() == "$set"_sd) {
+            op = Op::kSet;
+        } else if (opElem.fieldNameStringData() == "$inc"_sd) {
+            op = Op::kInc;
+        } else {
+            return boost::none;
+        }
+        if (opElem.type() != Object) {
+            return boost::none;
+        }
+
+        for (auto&& field : opElem.embeddedObject()) {
+            FieldRef path(field.fieldNameStringData());
+            if (path.empty()) {
+                return boost::none;
+            }
+            for (FieldIndex i = 0; i < path.numParts(); ++i) {
+                auto part = path.getPart(i);
+                if (part.empty() || part[0] == '$') {
+                    return boost::none;
+                }
+            }
+            if (op == Op::kSet ? !isFixedWidth(field.type()) : !field.isNumber()) {
+                return boost::none;
+            }
+            update._fields.push_back({op, std::move(path), field});
+        }
+    }
+    if (update._fields.empty()) {
+        return boost::none;
+    }
+    return update;
+}
+
+boost::optional<FixedWidthUpdate::Result> FixedWidthUpdate::apply(
+    const BSONObj& doc, UpdateExecutor::ApplyParams::LogMode logMode) const {
+    // Every field is checked before anything is produced, as any of them may send the whole update
+    // down the regular path. The new values are named after their full paths, as $v:1 oplog
+    // entries need them.
+    std::vector<std::pair<BSONElement, const Field*>> modified;
+    BSONObjBuilder newValuesBuilder;
+    for (const auto& field : _fields) {
+        auto elem = findExistingElement(doc, field.path);
+        if (!elem) {
+            return boost::none;
+        }
+
+        if (field.op == Op::kSet) {
+            if (elem.type() != field.value.type()) {
+                return boost::none;
+            }
+            if (elem.woCompare(field.value, false /* considerFieldName */) == 0) {
+                continue;
+            }
+            newValuesBuilder.appendAs(field.value, field.path.dottedField());
+        } else {
+            if (!elem.isNumber()) {
+                return boost::none;
+            }
+            SafeNum original(elem);
+            SafeNum valueToSet(field.value);
+            valueToSet += original;
+            if (!valueToSet.isValid() || valueToSet.type() != elem.type()) {
+                return boost::none;
+            }
+            if (valueToSet.isIdentical(original)) {
+                continue;
+            }
+            valueToSet.toBSON(field.path.dottedField(), &newValuesBuilder);
+        }
+        modified.emplace_back(elem, &field);
+    }
+
+    Result result;
+    if (modified.empty()) {
+        return result;
+    }
+    result.noop = false;
+    result.newValues = newValuesBuilder.obj();
+
+    diff_tree::DocumentSubDiffNode diffRoot;
+    BSONObjIterator newValues(result.newValues);
+    for (const auto& [oldElem, field] : modified) {
+        auto newElem = newValues.next();
+        invariant(newElem.valuesize() == oldElem.valuesize());
+        result.damages.emplace_back(newElem.value() - result.newValues.objdata(),
+                                    newElem.valuesize(),
+                                    oldElem.value() - doc.objdata(),
+                                    oldElem.valuesize());
+
+        if (logMode == UpdateExecutor::ApplyParams::LogMode::kGenerateOplogEntry) {
+            diff_tree::DocumentSubDiffNode* node = &diffRoot;
+            const FieldIndex lastPart = field->path.numParts() - 1;
+            for (FieldIndex i = 0; i < lastPart; ++i) {
+                auto part = field->path.getPart(i);
+                auto child = node->getChild(part);
+                if (!child) {
+                    child =
+                        node->addChild(part, std::make_unique<diff_tree::DocumentSubDiffNode>());
+                }
+                node = checked_cast<diff_tree::DocumentSubDiffNode*>(child);
+            }
+            node->addUpdate(field->path.getPart(lastPart), newElem);
+        }
+    }
+
+    switch (logMode) {
+        case UpdateExecutor::ApplyParams::LogMode::kDoNotGenerateOplogEntry:
+            break;
+        case UpdateExecutor::ApplyParams::LogMode::kGenerateOnlyV1OplogEntry: {
+            BSONObjBuilder oplogEntry;
+            oplogEntry.append(kUpdateOplogEntryVersionFieldName,
+                              static_cast<int>(UpdateOplogEntryVersion::kUpdateNodeV1));
+            oplogEntry.append("$set", result.newValues);
+            result.oplogEntry = oplogEntry.obj();
+            break;
+        }
+        case UpdateExecutor::ApplyParams::LogMode::kGenerateOplogEntry:
+            result.oplogEntry = update_oplog_entry::makeDeltaOplogEntry(diffRoot.serialize());
+            break;
+    }
+    return result;
+}
+
+std::vector<const FieldRef*> FixedWidthUpdate::paths() const {
+    std::vector<const FieldRef*> paths;
+    paths.reserve(_fields.size());
+    for (const auto& field : _fields) {
+        paths.push_back(&field.path);
+    }
+    return paths;
+}
+
+}  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/mutable/damage_vector.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/db/update/update_executor.h"
+
+namespace mongo {
+
+/**
+ * The fast path for updates which only $set values of fixed-width types and $inc numbers, which
+ * counters and flags are typically maintained with. When every path they modify already exists in
+ * the document with a value of the same width, they are applied by writing the new values over the
+ * old ones, straight from the document's BSON: no mutablebson::Document is built and the oplog
+ * entry is generated without going through a log builder.
+ */
+class FixedWidthUpdate {
+public:
+    /**
+     * The update of a single document.
+     */
+    struct Result {
+        // True if no value changed, in which case there are no damages and no oplog entry.
+        bool noop = true;
+
+        // The new values. It is the damage source, so must outlive the write of the damages.
+        BSONObj newValues;
+        mutablebson::DamageVector damages;
+
+        BSONObj oplogEntry;
+    };
+
+    /**
+     * Returns the fast path for 'updateExpr' if it only has $set and $inc operators, every $set
+     * value is of a fixed-width type, and no path is positional. Returns boost::none otherwise.
+     * 'updateExpr' must have already been parsed successfully as an update expression, and must
+     * outlive the returned object.
+     */
+    static boost::optional<FixedWidthUpdate> parse(const BSONObj& updateExpr);
+
+    /**
+     * Applies the update to 'doc', returning boost::none if it cannot be applied in place: a path
+     * is missing or goes through an array, a $set changes the type of a value, or an $inc changes
+     * the type of a number or fails. The caller must then apply the update the regular way, which
+     * also raises any error.
+     */
+    boost::optional<Result> apply(const BSONObj& doc,
+                                  UpdateExecutor::ApplyParams::LogMode logMode) const;
+
+    /**
+     * Every path the update modifies, for the caller to check against indexed and immutable paths.
+     */
+    std::vector<const FieldRef*> paths() const;
+
+private:
+    enum class Op { kSet, kInc };
+
+    struct Field {
+        Op op;
+        FieldRef path;
+        BSONElement value;
+    };
+
+    std::vector<Field> _fields;
+};
+
+}  // namespace mongo
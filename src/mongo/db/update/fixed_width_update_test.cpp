@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cstring>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/update/fixed_width_update.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using LogMode = UpdateExecutor::ApplyParams::LogMode;
+
+/**
+ * Writes the damages of 'result' over a copy of 'doc'.
+ */
+BSONObj applyDamages(const BSONObj& doc, const FixedWidthUpdate::Result& result) {
+    std::string buf(doc.objdata(), doc.objsize());
+    for (const auto& damage : result.damages) {
+        ASSERT_EQ(damage.sourceSize, damage.targetSize);
+        std::memcpy(&buf[damage.targetOffset],
+                    result.newValues.objdata() + damage.sourceOffset,
+                    damage.sourceSize);
+    }
+    return BSONObj(buf.data()).getOwned();
+}
+
+TEST(FixedWidthUpdateTest, OnlyHandlesSetAndIncOfFixedWidthValues) {
+    ASSERT(FixedWidthUpdate::parse(fromjson("{$inc: {a: 1}, $set: {b: true, 'c.d': 1.5}}")));
+    ASSERT(FixedWidthUpdate::parse(BSON("$set" << BSON("a" << OID::gen() << "b" << Date_t()))));
+
+    ASSERT_FALSE(FixedWidthUpdate::parse(fromjson("{$set: {a: 'string'}}")));
+    ASSERT_FALSE(FixedWidthUpdate::parse(fromjson("{$set: {a: {b: 1}}}")));
+    ASSERT_FALSE(FixedWidthUpdate::parse(fromjson("{$inc: {a: 1}, $unset: {b: 1}}")));
+    ASSERT_FALSE(FixedWidthUpdate::parse(fromjson("{$mul: {a: 2}}")));
+    ASSERT_FALSE(FixedWidthUpdate::parse(fromjson("{$inc: {'a.$': 1}}")));
+    ASSERT_FALSE(FixedWidthUpdate::parse(fromjson("{$inc: {'a.$[]': 1}}")));
+    ASSERT_FALSE(FixedWidthUpdate::parse(fromjson("{}")));
+}
+
+TEST(FixedWidthUpdateTest, IncrementsInPlace) {
+    auto updateExpr = fromjson("{$inc: {n: 1, 'a.m': NumberLong(-5)}}");
+    auto update = FixedWidthUpdate::parse(updateExpr);
+    ASSERT(update);
+
+    auto doc = fromjson("{_id: 0, n: 41, a: {m: NumberLong(10), s: 'x'}}");
+    auto result = update->apply(doc, LogMode::kGenerateOplogEntry);
+    ASSERT(result);
+    ASSERT_FALSE(result->noop);
+    ASSERT_EQ(result->damages.size(), 2U);
+    ASSERT_BSONOBJ_BINARY_EQ(applyDamages(doc, *result),
+                             fromjson("{_id: 0, n: 42, a: {m: NumberLong(5), s: 'x'}}"));
+    ASSERT_BSONOBJ_EQ(result->oplogEntry,
+                      fromjson("{$v: 2, diff: {u: {n: 42}, sa: {u: {m: NumberLong(5)}}}}"));
+}
+
+TEST(FixedWidthUpdateTest, SetsInPlace) {
+    auto updateExpr = fromjson("{$set: {flag: true, x: 2.5}}");
+    auto update = FixedWidthUpdate::parse(updateExpr);
+    ASSERT(update);
+
+    auto doc = fromjson("{_id: 0, x: 1.0, flag: false}");
+    auto result = update->apply(doc, LogMode::kGenerateOnlyV1OplogEntry);
+    ASSERT(result);
+    ASSERT_BSONOBJ_BINARY_EQ(applyDamages(doc, *result), fromjson("{_id: 0, x: 2.5, flag: true}"));
+    ASSERT_BSONOBJ_EQ(result->oplogEntry, fromjson("{$v: 1, $set: {flag: true, x: 2.5}}"));
+
+    auto unlogged = update->apply(doc, LogMode::kDoNotGenerateOplogEntry);
+    ASSERT(unlogged);
+    ASSERT(unlogged->oplogEntry.isEmpty());
+}
+
+TEST(FixedWidthUpdateTest, SkipsUnchangedValues) {
+    auto updateExpr = fromjson("{$set: {a: 1}, $inc: {b: 0, c: 1}}");
+    auto update = FixedWidthUpdate::parse(updateExpr);
+    ASSERT(update);
+
+    auto doc = fromjson("{_id: 0, a: 1, b: 7, c: 7}");
+    auto result = update->apply(doc, LogMode::kGenerateOplogEntry);
+    ASSERT(result);
+    ASSERT_EQ(result->damages.size(), 1U);
+    ASSERT_BSONOBJ_EQ(result->oplogEntry, fromjson("{$v: 2, diff: {u: {c: 8}}}"));
+
+    auto noopExpr = fromjson("{$set: {a: 1}, $inc: {b: 0}}");
+    auto noop = FixedWidthUpdate::parse(noopExpr)->apply(doc, LogMode::kGenerateOplogEntry);
+    ASSERT(noop);
+    ASSERT(noop->noop);
+    ASSERT(noop->damages.empty());
+    ASSERT(noop->oplogEntry.isEmpty());
+}
+
+TEST(FixedWidthUpdateTest, FallsBackWhenValuesChangeWidth) {
+    auto incExpr = fromjson("{$inc: {n: 1}}");
+    auto inc = FixedWidthUpdate::parse(incExpr);
+    ASSERT(inc);
+
+    // Overflowing into a long, and adding a double to an int, change the type of the number.
+    ASSERT_FALSE(inc->apply(BSON("_id" << 0 << "n" << std::numeric_limits<int>::max()),
+                            LogMode::kGenerateOplogEntry));
+    auto doubleIncExpr = fromjson("{$inc: {n: 0.5}}");
+    ASSERT_FALSE(FixedWidthUpdate::parse(doubleIncExpr)->apply(fromjson("{_id: 0, n: 1}"),
+                                                               LogMode::kGenerateOplogEntry));
+
+    // The regular path raises the error for non-numeric values.
+    ASSERT_FALSE(inc->apply(fromjson("{_id: 0, n: 'one'}"), LogMode::kGenerateOplogEntry));
+
+    auto setExpr = fromjson("{$set: {n: NumberLong(1)}}");
+    ASSERT_FALSE(FixedWidthUpdate::parse(setExpr)->apply(fromjson("{_id: 0, n: 1}"),
+                                                         LogMode::kGenerateOplogEntry));
+}
+
+TEST(FixedWidthUpdateTest, FallsBackWhenPathIsMissingOrGoesThroughArray) {
+    auto updateExpr = fromjson("{$inc: {'a.b': 1}}");
+    auto update = FixedWidthUpdate::parse(updateExpr);
+    ASSERT(update);
+
+    ASSERT_FALSE(update->apply(fromjson("{_id: 0}"), LogMode::kGenerateOplogEntry));
+    ASSERT_FALSE(update->apply(fromjson("{_id: 0, a: {}}"), LogMode::kGenerateOplogEntry));
+    ASSERT_FALSE(update->apply(fromjson("{_id: 0, a: 1}"), LogMode::kGenerateOplogEntry));
+    ASSERT_FALSE(update->apply(fromjson("{_id: 0, a: [{b: 1}]}"), LogMode::kGenerateOplogEntry));
+    ASSERT_FALSE(update->apply(fromjson("{_id: 0, a: {b: [1]}}"), LogMode::kGenerateOplogEntry));
+    ASSERT(update->apply(fromjson("{_id: 0, a: {b: 1}}"), LogMode::kGenerateOplogEntry));
+}
+
+}  // namespace
+}  // namespace mongo
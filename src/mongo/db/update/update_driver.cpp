@@ -39,6 +39,7 @@
 #include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/update/delta_executor.h"
 #include "mongo/db/update/modifier_table.h"
@@ -187,6 +188,11 @@ void UpdateDriver::parse(
     auto root = std::make_unique<UpdateObjectNode>();
     _positional = parseUpdateExpression(updateExpr, root.get(), _expCtx, arrayFilters);
     _updateExecutor = std::make_unique<UpdateTreeExecutor>(std::move(root));
+
+    if (internalQueryEnableFixedWidthUpdateFastPath.load() && !_positional &&
+        arrayFilters.empty()) {
+        _fixedWidthUpdate = FixedWidthUpdate::parse(updateExpr);
+    }
 }
 
 Status UpdateDriver::populateDocumentWithQueryFields(OperationContext* opCtx,
@@ -265,20 +271,7 @@ Status UpdateDriver::update(OperationContext* opCtx,
     invariant(!modifiedPaths || modifiedPaths->empty());
 
     if (_logOp && logOpRec) {
-        const auto& fcvState = serverGlobalParams.featureCompatibility;
-
-        // Updates may be run as part of the startup sequence, before the global FCV state has been
-        // initialized. We conservatively do not permit the use of $v:2 oplog entries in these
-        // situations.
-
-        // TODO SERVER-51075: Remove FCV check for $v:2 delta oplog entries.
-        const bool fcvAllowsV2Entries = fcvState.isVersionInitialized() &&
-            fcvState.isGreaterThanOrEqualTo(
-                ServerGlobalParams::FeatureCompatibility::Version::kVersion47);
-
-        applyParams.logMode = fcvAllowsV2Entries && internalQueryEnableLoggingV2OplogEntries.load()
-            ? ApplyParams::LogMode::kGenerateOplogEntry
-            : ApplyParams::LogMode::kGenerateOnlyV1OplogEntry;
+        applyParams.logMode = _oplogEntryLogMode();
 
         if (MONGO_unlikely(hangAfterPipelineUpdateFCVCheck.shouldFail()) &&
             type() == UpdateType::kPipeline) {
@@ -307,6 +300,44 @@ Status UpdateDriver::update(OperationContext* opCtx,
     return Status::OK();
 }
 
+boost::optional<FixedWidthUpdate::Result> UpdateDriver::updateInPlace(
+    const BSONObj& doc, const FieldRefSet& immutablePaths) {
+    if (!_fixedWidthUpdate) {
+        return boost::none;
+    }
+
+    for (auto path : _fixedWidthUpdate->paths()) {
+        if ((_indexedFields && _indexedFields->mightBeIndexed(*path)) ||
+            immutablePaths.findConflicts(path, nullptr)) {
+            return boost::none;
+        }
+    }
+
+    auto result = _fixedWidthUpdate->apply(
+        doc, _logOp ? _oplogEntryLogMode() : ApplyParams::LogMode::kDoNotGenerateOplogEntry);
+    if (result) {
+        _affectIndices = false;
+    }
+    return result;
+}
+
+UpdateExecutor::ApplyParams::LogMode UpdateDriver::_oplogEntryLogMode() const {
+    const auto& fcvState = serverGlobalParams.featureCompatibility;
+
+    // Updates may be run as part of the startup sequence, before the global FCV state has been
+    // initialized. We conservatively do not permit the use of $v:2 oplog entries in these
+    // situations.
+
+    // TODO SERVER-51075: Remove FCV check for $v:2 delta oplog entries.
+    const bool fcvAllowsV2Entries = fcvState.isVersionInitialized() &&
+        fcvState.isGreaterThanOrEqualTo(
+            ServerGlobalParams::FeatureCompatibility::Version::kVersion47);
+
+    return fcvAllowsV2Entries && internalQueryEnableLoggingV2OplogEntries.load()
+        ? ApplyParams::LogMode::kGenerateOplogEntry
+        : ApplyParams::LogMode::kGenerateOnlyV1OplogEntry;
+}
+
 void UpdateDriver::setCollator(const CollatorInterface* collator) {
     if (_updateExecutor) {
         _updateExecutor->setCollator(collator);
@@ -41,6 +41,7 @@
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/update/fixed_width_update.h"
 #include "mongo/db/update/modifier_table.h"
 #include "mongo/db/update/object_replace_executor.h"
 #include "mongo/db/update/pipeline_executor.h"
@@ -125,6 +126,18 @@ public:
                   bool* docWasModified = nullptr,
                   FieldRefSetWithStorage* modifiedPaths = nullptr);
 
+    /**
+     * Applies the update to 'doc' through the FixedWidthUpdate fast path, producing the damages to
+     * write in place of a new document. Returns boost::none if the update is not one the fast path
+     * handles, it cannot be applied to 'doc' in place, or it modifies a path that is indexed or
+     * conflicts with 'immutablePaths'. The update must then be applied with update().
+     *
+     * The oplog entry is generated as update() would, and modsAffectIndices() is false after the
+     * update is applied.
+     */
+    boost::optional<FixedWidthUpdate::Result> updateInPlace(const BSONObj& doc,
+                                                            const FieldRefSet& immutablePaths);
+
     /**
      * Passes the visitor through to the root of the update tree. The visitor is responsible for
      * implementing methods that operate on the nodes of the tree.
@@ -213,6 +226,11 @@ private:
     /** Create the modifier and add it to the back of the modifiers vector */
     inline Status addAndParse(const modifiertable::ModifierType type, const BSONElement& elem);
 
+    /**
+     * Returns the format oplog entries of updates may be generated in.
+     */
+    UpdateExecutor::ApplyParams::LogMode _oplogEntryLogMode() const;
+
     //
     // immutable properties after parsing
     //
@@ -221,6 +239,9 @@ private:
 
     std::unique_ptr<UpdateExecutor> _updateExecutor;
 
+    // Set for operator-style updates the fixed-width fast path handles, when it is enabled.
+    boost::optional<FixedWidthUpdate> _fixedWidthUpdate;
+
     // What are the list of fields in the collection over which the update is going to be
     // applied that participate in indices?
     //
@@ -46,8 +46,10 @@
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/db/repl/read_concern_level.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/stdx/future.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/future.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -422,6 +424,91 @@ TEST_F(CursorManagerTest, CursorShouldNotTimeOutUntilIdleForLongEnoughAfterBeing
     ASSERT_EQ(0UL, cursorManager->numCursors());
 }
 
+/**
+ * Test that idle cursors time out in the order they were last used, across all partitions, and that
+ * cursors which were killed while idle are not counted again when timing out cursors.
+ */
+TEST_F(CursorManagerTest, IdleCursorsTimeOutInOrderOfLastUse) {
+    CursorManager* cursorManager = useCursorManager();
+    auto clock = useClock();
+
+    const int kNumCursors = 64;
+    std::vector<CursorId> cursorIds;
+    for (int i = 0; i < kNumCursors; ++i) {
+        auto cursorPin = cursorManager->registerCursor(
+            _opCtx.get(),
+            {makeFakePlanExecutor(),
+             kTestNss,
+             {},
+             APIParameters(),
+             {},
+             repl::ReadConcernArgs(repl::ReadConcernLevel::kLocalReadConcern),
+             BSONObj(),
+             PrivilegeVector()});
+        cursorIds.push_back(cursorPin.getCursor()->cursorid());
+        cursorPin.release();
+        clock->advance(Milliseconds(1));
+    }
+
+    // Kill one of the cursors which is about to time out while it is idle.
+    ASSERT_OK(cursorManager->killCursor(_opCtx.get(), cursorIds[0]));
+    ASSERT_EQ(static_cast<size_t>(kNumCursors - 1), cursorManager->numCursors());
+
+    // The first half of the cursors have now been idle for long enough to time out.
+    clock->advance(getDefaultCursorTimeoutMillis() - Milliseconds(kNumCursors / 2));
+    ASSERT_EQ(static_cast<size_t>(kNumCursors / 2),
+              cursorManager->timeoutCursors(_opCtx.get(), clock->now()));
+    ASSERT_EQ(static_cast<size_t>(kNumCursors / 2 - 1), cursorManager->numCursors());
+    for (int i = 0; i < kNumCursors; ++i) {
+        auto pinStatus = cursorManager->pinCursor(_opCtx.get(), cursorIds[i]);
+        ASSERT_EQ(i > kNumCursors / 2, pinStatus.isOK());
+    }
+
+    // Pinning the remaining cursors above counts as using them, so they stay alive for another
+    // full timeout period.
+    clock->advance(getDefaultCursorTimeoutMillis() - Milliseconds(1));
+    ASSERT_EQ(0UL, cursorManager->timeoutCursors(_opCtx.get(), clock->now()));
+    clock->advance(Milliseconds(1));
+    ASSERT_EQ(static_cast<size_t>(kNumCursors / 2 - 1),
+              cursorManager->timeoutCursors(_opCtx.get(), clock->now()));
+    ASSERT_EQ(0UL, cursorManager->numCursors());
+}
+
+/**
+ * Test that an operation which tries to pin a cursor while a prefetch has it pinned waits for the
+ * prefetch to finish, rather than failing because the cursor is in use.
+ */
+TEST_F(CursorManagerTest, PinningCursorWaitsForPrefetchToUnpinIt) {
+    CursorManager* cursorManager = useCursorManager();
+    auto cursorPin = makeCursor(_opCtx.get());
+    const auto cursorId = cursorPin.getCursor()->cursorid();
+    cursorPin.release();
+
+    SharedPromise<void> prefetchDone;
+    auto prefetchPin = unittest::assertGet(
+        cursorManager->pinCursorForPrefetch(_opCtx.get(), cursorId, prefetchDone.getFuture()));
+
+    // A second prefetch does not wait.
+    ASSERT_THROWS_CODE(
+        cursorManager->pinCursorForPrefetch(_opCtx.get(), cursorId, prefetchDone.getFuture()),
+        DBException,
+        ErrorCodes::CursorInUse);
+
+    auto serviceContext = _queryServiceContext->getServiceContext();
+    auto pinStatus = stdx::async(stdx::launch::async, [&] {
+        ThreadClient tc("getMore", serviceContext);
+        auto opCtx = cc().makeOperationContext();
+        return cursorManager->pinCursor(opCtx.get(), cursorId).getStatus();
+    });
+    ASSERT(pinStatus.wait_for(Milliseconds(100).toSystemDuration()) ==
+           stdx::future_status::timeout);
+
+    prefetchPin.release();
+    prefetchDone.emplaceValue();
+    ASSERT_OK(pinStatus.get());
+    ASSERT_EQ(1UL, cursorManager->numCursors());
+}
+
 /**
  * Test that a cursor correctly stores API parameters.
  */
@@ -711,9 +711,13 @@ TEST(FromJsonTest, EscapedCharacters) {
         {R"({ "a" : "\% \{ \a \z \$ \# \' \ " })",
          B().append("a", "% { a z $ # '  ").obj()},               // NonEscapedCharacters
         {"{ \"a\" : \"\x7f\" }", B().append("a", "\x7f").obj()},  // AllowedControlCharacter
+        {R"({ "a" : "abc\ndef\\ghi", "b" : 'it"s' })",
+         B().append("a", "abc\ndef\\ghi").append("b", "it\"s").obj()},  // EscapesWithinRuns
     });
     checkRejectionEach({
-        "{ \"a\" : \"\x1f\" }",  // InvalidControlCharacter
+        "{ \"a\" : \"\x1f\" }",    // InvalidControlCharacter
+        "{ \"a\" : \"abc\x1f\" }",  // InvalidControlCharacterAfterRun
+        R"({ "a" : "abc)",           // UnterminatedRun
     });
 }
 
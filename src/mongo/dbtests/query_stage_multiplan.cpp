@@ -284,6 +284,27 @@ TEST_F(QueryStageMultiPlanTest, MPSCollectionScanVsHighlySelectiveIXScan) {
     ASSERT_EQUALS(results, N / 10);
 }
 
+TEST_F(QueryStageMultiPlanTest, MPSAbandonsPlansWhichFallBehind) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlanEvaluationAbandonRatio", 0.5);
+
+    const int N = 5000;
+    for (int i = 0; i < N; ++i) {
+        insert(BSON("foo" << (i % 10)));
+    }
+
+    addIndex(BSON("foo" << 1));
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+    const CollectionPtr& coll = ctx.getCollection();
+
+    // The collection scan returns a result every tenth call to work(), so it falls behind the
+    // index scan and is abandoned long before the index scan returns enough results to end the
+    // trial period.
+    auto mps = runMultiPlanner(_expCtx.get(), nss, coll, 7);
+    auto collScanWorks = mps->getChildren()[1]->getStats()->common.works;
+    ASSERT_LT(collScanWorks, getBestPlanWorks(mps.get()));
+}
+
 TEST_F(QueryStageMultiPlanTest, MPSDoesNotCreateActiveCacheEntryImmediately) {
     const int N = 100;
     for (int i = 0; i < N; ++i) {
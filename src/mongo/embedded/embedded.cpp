@@ -62,6 +62,7 @@
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/ttl.h"
+#include "mongo/embedded/embedded_options.h"
 #include "mongo/embedded/embedded_options_parser_init.h"
 #include "mongo/embedded/index_builds_coordinator_embedded.h"
 #include "mongo/embedded/periodic_runner_embedded.h"
@@ -74,8 +75,14 @@
 #include "mongo/util/background.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/periodic_runner_factory.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+#include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#endif
 
 #include <boost/filesystem.hpp>
 
@@ -97,6 +104,24 @@ MONGO_INITIALIZER_WITH_PREREQUISITES(WireSpec, ("EndStartupOptionHandling"))(Ini
     WireSpec::instance().initialize(std::move(spec));
 }
 
+// With 'storage.lowMemory', WiredTiger gets a small cache, and as many sessions and eviction
+// threads as an embedded process needs instead of the server's defaults. A 'cacheSizeGB' or
+// 'configString' of the user's own still takes precedence.
+constexpr size_t kLowMemoryCacheSizeMB = 32;
+constexpr auto kLowMemoryWiredTigerConfig =
+    "session_max=512,eviction=(threads_min=1,threads_max=1),";
+
+void applyLowMemoryProfile() {
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+    if (wiredTigerGlobalOptions.cacheSizeGB == 0) {
+        wiredTigerGlobalOptions.cacheSizeGB = kLowMemoryCacheSizeMB / 1024.0;
+    }
+    // WiredTiger lets the last occurrence of a setting win, so the user's configString goes last.
+    wiredTigerGlobalOptions.engineConfig =
+        kLowMemoryWiredTigerConfig + wiredTigerGlobalOptions.engineConfig;
+#endif
+}
+
 // Noop, to fulfill dependencies for other initializers.
 MONGO_INITIALIZER_GENERAL(ForkServer, ("EndStartupOptionHandling"), ("default"))
 (InitializerContext* context) {}
@@ -189,6 +214,7 @@ void shutdown(ServiceContext* srvContext) {
 
 ServiceContext* initialize(const char* yaml_config) {
     srand(static_cast<unsigned>(curTimeMicros64()));
+    Timer openTimer;
 
     if (yaml_config)
         embedded::EmbeddedOptionsConfig::instance().set(yaml_config);
@@ -198,6 +224,10 @@ ServiceContext* initialize(const char* yaml_config) {
     auto giGuard = makeGuard([] { mongo::runGlobalDeinitializers().ignore(); });
     setGlobalServiceContext(ServiceContext::make());
 
+    if (embeddedGlobalOptions.lowMemory) {
+        applyLowMemoryProfile();
+    }
+
     Client::initThread("initandlisten");
     // Make sure current thread have no client set in thread_local when we leave this function
     auto clientGuard = makeGuard([] { Client::releaseCurrent(); });
@@ -333,6 +363,13 @@ ServiceContext* initialize(const char* yaml_config) {
 
     serviceContext->notifyStartupComplete();
 
+    LOGV2_OPTIONS(6113900,
+                  {LogComponent::kControl},
+                  "Embedded instance opened",
+                  "durationMillis"_attr = openTimer.millis(),
+                  "residentMemoryMB"_attr = ProcessInfo().getResidentSize(),
+                  "lowMemory"_attr = embeddedGlobalOptions.lowMemory);
+
     // Init succeeded, no need for global deinit.
     giGuard.dismiss();
 
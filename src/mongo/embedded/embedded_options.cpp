@@ -31,11 +31,16 @@
 
 #include "mongo/embedded/embedded_options.h"
 
+#include "mongo/config.h"
 #include "mongo/db/server_options_base.h"
 #include "mongo/db/server_options_helpers.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/embedded/embedded_options_gen.h"
 
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+#include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#endif
+
 #include <boost/filesystem.hpp>
 #include <string>
 
@@ -44,6 +49,8 @@ namespace embedded {
 
 using std::string;
 
+EmbeddedOptions embeddedGlobalOptions;
+
 Status addOptions(optionenvironment::OptionSection* options) {
     Status ret = addBaseServerOptions(options);
     if (!ret.isOK()) {
@@ -78,6 +85,10 @@ Status storeOptions(const moe::Environment& params) {
         storageGlobalParams.dbpath = params["storage.dbPath"].as<string>();
     }
 
+    if (params.count("storage.lowMemory")) {
+        embeddedGlobalOptions.lowMemory = params["storage.lowMemory"].as<bool>();
+    }
+
 #ifdef _WIN32
     if (storageGlobalParams.dbpath.size() > 1 &&
         storageGlobalParams.dbpath[storageGlobalParams.dbpath.size() - 1] == '/') {
@@ -102,6 +113,11 @@ Status storeOptions(const moe::Environment& params) {
 
 void resetOptions() {
     storageGlobalParams.reset();
+    embeddedGlobalOptions = EmbeddedOptions();
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+    // The low memory profile adjusts these, so they must not carry over to the next instance.
+    wiredTigerGlobalOptions = WiredTigerGlobalOptions();
+#endif
 }
 
 std::string storageDBPathDescription() {
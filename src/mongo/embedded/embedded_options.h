@@ -36,6 +36,13 @@
 namespace mongo {
 namespace embedded {
 
+struct EmbeddedOptions {
+    // Set by 'storage.lowMemory'; see applyLowMemoryProfile() in embedded.cpp.
+    bool lowMemory = false;
+};
+
+extern EmbeddedOptions embeddedGlobalOptions;
+
 Status addOptions(optionenvironment::OptionSection* options);
 
 /**
@@ -49,11 +49,13 @@
 #include "mongo/util/options_parser/environment.h"
 #include "mongo/util/options_parser/option_section.h"
 #include "mongo/util/options_parser/options_parser.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/shared_buffer.h"
 #include "mongo/util/signal_handlers_synchronous.h"
 #include "mongo/util/text.h"
+#include "mongo/util/timer.h"
 
 namespace moe = mongo::optionenvironment;
 
@@ -118,6 +120,10 @@ protected:
         yaml << YAML::Value << YAML::BeginMap;
         yaml << YAML::Key << "dbPath";
         yaml << YAML::Value << getGlobalTempDir()->path();
+        if (useLowMemoryProfile()) {
+            yaml << YAML::Key << "lowMemory";
+            yaml << YAML::Value << true;
+        }
         yaml << YAML::EndMap;  // storage
 
         yaml << YAML::EndMap;
@@ -130,8 +136,10 @@ protected:
         lib = mongo_embedded_v1_lib_init(&params, status);
         ASSERT(lib != nullptr) << mongo_embedded_v1_status_get_explanation(status);
 
+        mongo::Timer openTimer;
         db = mongo_embedded_v1_instance_create(lib, yaml.c_str(), status);
         ASSERT(db != nullptr) << mongo_embedded_v1_status_get_explanation(status);
+        openMillis = openTimer.millis();
 
         mongo_embedded_v1_status_destroy(status);
     }
@@ -199,9 +207,21 @@ protected:
     }
 
 
+    virtual bool useLowMemoryProfile() const {
+        return false;
+    }
+
 protected:
     mongo_embedded_v1_lib* lib;
     mongo_embedded_v1_instance* db;
+    long long openMillis;
+};
+
+class MongodbCAPILowMemoryTest : public MongodbCAPITest {
+protected:
+    bool useLowMemoryProfile() const override {
+        return true;
+    }
 };
 
 TEST_F(MongodbCAPITest, CreateAndDestroyDB) {
@@ -638,23 +658,33 @@ TEST_F(MongodbCAPITest, RunListCommands) {
                         allowlist.end(),
                         std::back_inserter(unsupported));
 
-    if (!missing.empty()) {
-        std::cout << "\nMissing commands from the embedded binary:\n";
-    }
-    for (auto&& cmd : missing) {
-        std::cout << cmd << "\n";
-    }
-    if (!unsupported.empty()) {
-        std::cout << "\nUnsupported commands in the embedded binary:\n";
-    }
-    for (auto&& cmd : unsupported) {
-        std::cout << cmd << "\n";
-    }
-
     ASSERT(missing.empty()) << mongo::StringSplitter::join(missing, ", ");
     ASSERT(unsupported.empty()) << mongo::StringSplitter::join(unsupported, ", ");
 }
 
+TEST_F(MongodbCAPILowMemoryTest, OpenInsertAndRead) {
+    // The open time and resident memory are logged by the instance itself, for comparison
+    // against the default profile.
+    ASSERT_GTE(openMillis, 0);
+    ASSERT_GTE(mongo::ProcessInfo().getResidentSize(), 0);
+
+    auto client = createClient();
+
+    auto insertOpMsg = mongo::OpMsgRequest::fromDBAndBody(
+        "db_name", mongo::fromjson("{insert: 'collection_name', documents: [{a: 1}, {a: 2}]}"));
+    auto insertReply = performRpc(client, insertOpMsg);
+    ASSERT_EQUALS(insertReply.getIntField("n"), 2);
+    ASSERT_EQUALS(insertReply.getField("ok").numberDouble(), 1.0);
+
+    auto findMsg = mongo::OpMsgRequest::fromDBAndBody(
+        "db_name", mongo::fromjson("{find: 'collection_name', filter: {a: 2}}"));
+    auto findReply = performRpc(client, findMsg);
+    ASSERT_EQUALS(findReply.getField("ok").numberDouble(), 1.0);
+    auto firstBatch = findReply["cursor"]["firstBatch"].Array();
+    ASSERT_EQUALS(firstBatch.size(), 1U);
+    ASSERT_EQUALS(firstBatch[0]["a"].numberInt(), 2);
+}
+
 // This test is temporary to make sure that only one database can be created
 // This restriction may be relaxed at a later time
 TEST_F(MongodbCAPITest, CreateMultipleDBs) {
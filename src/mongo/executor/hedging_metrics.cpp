@@ -29,6 +29,8 @@
 
 #include "mongo/executor/hedging_metrics.h"
 
+#include <cmath>
+
 namespace mongo {
 
 namespace {
@@ -67,6 +69,37 @@ void HedgingMetrics::incrementNumAdvantageouslyHedgedOperations() {
     _numAdvantageouslyHedgedOperations.fetchAndAdd(1);
 }
 
+long long HedgingMetrics::getNumHedgesAvoidedByDelay() const {
+    return _numHedgesAvoidedByDelay.load();
+}
+
+void HedgingMetrics::incrementNumHedgesAvoidedByDelay() {
+    _numHedgesAvoidedByDelay.fetchAndAdd(1);
+}
+
+void HedgingMetrics::recordUnhedgedLatency(Microseconds latency) {
+    const auto sample = static_cast<double>(durationCount<Microseconds>(latency));
+
+    stdx::lock_guard<Latch> lk(_latencyMutex);
+    if (_numLatencySamples++ == 0) {
+        _smoothedLatencyMicros = sample;
+        _latencyDeviationMicros = sample / 2;
+        return;
+    }
+    const double error = std::abs(_smoothedLatencyMicros - sample);
+    _latencyDeviationMicros += (error - _latencyDeviationMicros) / 4;
+    _smoothedLatencyMicros += (sample - _smoothedLatencyMicros) / 8;
+}
+
+Milliseconds HedgingMetrics::getHedgeDelay() const {
+    stdx::lock_guard<Latch> lk(_latencyMutex);
+    if (_numLatencySamples < kMinLatencySamples) {
+        return Milliseconds(0);
+    }
+    const auto delayMicros = _smoothedLatencyMicros + 2 * _latencyDeviationMicros;
+    return duration_cast<Milliseconds>(Microseconds(static_cast<long long>(delayMicros)));
+}
+
 BSONObj HedgingMetrics::toBSON() const {
     BSONObjBuilder builder;
 
@@ -74,6 +107,19 @@ BSONObj HedgingMetrics::toBSON() const {
     builder.append("numTotalHedgedOperations", _numTotalHedgedOperations.load());
     builder.append("numAdvantageouslyHedgedOperations", _numAdvantageouslyHedgedOperations.load());
 
+    // Only reported once delayed hedging has been used, so the section is unchanged otherwise.
+    long long numLatencySamples;
+    {
+        stdx::lock_guard<Latch> lk(_latencyMutex);
+        numLatencySamples = _numLatencySamples;
+    }
+    if (numLatencySamples > 0) {
+        BSONObjBuilder delayBuilder(builder.subobjStart("hedgeDelay"));
+        delayBuilder.append("numLatencySamples", numLatencySamples);
+        delayBuilder.append("currentDelayMillis", durationCount<Milliseconds>(getHedgeDelay()));
+        delayBuilder.append("numHedgesAvoidedByDelay", _numHedgesAvoidedByDelay.load());
+    }
+
     return builder.obj();
 }
 
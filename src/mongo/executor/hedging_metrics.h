@@ -31,6 +31,8 @@
 
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -56,8 +58,27 @@ public:
     long long getNumAdvantageouslyHedgedOperations() const;
     void incrementNumAdvantageouslyHedgedOperations();
 
+    long long getNumHedgesAvoidedByDelay() const;
+    void incrementNumHedgesAvoidedByDelay();
+
+    /**
+     * Records how long the first request of an operation that waits before hedging took to get a
+     * response.
+     */
+    void recordUnhedgedLatency(Microseconds latency);
+
+    /**
+     * Returns how long an operation should wait for its first request before sending a hedge: the
+     * smoothed round trip plus twice its smoothed deviation, which approximates the 95th
+     * percentile. Zero until enough round trips have been recorded to trust the estimate.
+     */
+    Milliseconds getHedgeDelay() const;
+
     BSONObj toBSON() const;
 
+    // The number of round trips to record before getHedgeDelay() stops returning zero.
+    static constexpr long long kMinLatencySamples = 10;
+
 private:
     // The number of all operations with readPreference options such that they could be hedged.
     AtomicWord<long long> _numTotalOperations{0};
@@ -68,6 +89,15 @@ private:
     // The number of all operations where a rpc other than the first one fulfilled the client
     // request.
     AtomicWord<long long> _numAdvantageouslyHedgedOperations{0};
+
+    // The number of operations that waited before hedging and got their response in time.
+    AtomicWord<long long> _numHedgesAvoidedByDelay{0};
+
+    // Round trip estimate in the manner of TCP's retransmission timer (RFC 6298).
+    mutable Mutex _latencyMutex = MONGO_MAKE_LATCH("HedgingMetrics::_latencyMutex");
+    long long _numLatencySamples = 0;
+    double _smoothedLatencyMicros = 0;
+    double _latencyDeviationMicros = 0;
 };
 
 }  // namespace mongo
@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/executor/hedging_metrics.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(HedgingMetricsTest, NoHedgeDelayUntilEnoughSamples) {
+    HedgingMetrics metrics;
+    for (long long i = 1; i < HedgingMetrics::kMinLatencySamples; ++i) {
+        metrics.recordUnhedgedLatency(Milliseconds(10));
+        ASSERT_EQ(metrics.getHedgeDelay(), Milliseconds(0));
+    }
+    metrics.recordUnhedgedLatency(Milliseconds(10));
+    ASSERT_GT(metrics.getHedgeDelay(), Milliseconds(0));
+}
+
+TEST(HedgingMetricsTest, HedgeDelayConvergesToSteadyLatency) {
+    HedgingMetrics metrics;
+    for (int i = 0; i < 100; ++i) {
+        metrics.recordUnhedgedLatency(Milliseconds(10));
+    }
+    // With no variation left, the delay is the round trip itself.
+    ASSERT_EQ(metrics.getHedgeDelay(), Milliseconds(10));
+}
+
+TEST(HedgingMetricsTest, HedgeDelayGrowsWithVariation) {
+    HedgingMetrics steady;
+    HedgingMetrics jittery;
+    for (int i = 0; i < 100; ++i) {
+        steady.recordUnhedgedLatency(Milliseconds(10));
+        jittery.recordUnhedgedLatency(Milliseconds(i % 2 ? 5 : 15));
+    }
+    ASSERT_GT(jittery.getHedgeDelay(), steady.getHedgeDelay());
+    ASSERT_LTE(jittery.getHedgeDelay(), Milliseconds(30));
+}
+
+TEST(HedgingMetricsTest, ReportsHedgeDelayOnlyOnceUsed) {
+    HedgingMetrics metrics;
+    ASSERT_FALSE(metrics.toBSON().hasField("hedgeDelay"));
+
+    metrics.recordUnhedgedLatency(Milliseconds(10));
+    metrics.incrementNumHedgesAvoidedByDelay();
+    auto hedgeDelay = metrics.toBSON()["hedgeDelay"].Obj();
+    ASSERT_EQ(hedgeDelay["numLatencySamples"].numberLong(), 1);
+    ASSERT_EQ(hedgeDelay["currentDelayMillis"].numberLong(), 0);
+    ASSERT_EQ(hedgeDelay["numHedgesAvoidedByDelay"].numberLong(), 1);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -535,6 +535,14 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
 
     // Attempt to get a connection to every target host
     for (size_t idx = 0; idx < request.target.size(); ++idx) {
+        if (idx > 0 && _svcCtx && request.hedgeOptions && request.hedgeOptions->delayUntilSlow) {
+            auto delay = HedgingMetrics::get(_svcCtx)->getHedgeDelay();
+            if (delay > Milliseconds(0)) {
+                _sendHedgeAfter(cmdState, idx, delay);
+                continue;
+            }
+        }
+
         auto connFuture = _pool->get(request.target[idx], request.sslMode, request.timeout);
 
         // If connection future is ready or requests should be sent in order, send the request
@@ -555,6 +563,37 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
     return ex.toStatus();
 }
 
+void NetworkInterfaceTL::_sendHedgeAfter(std::shared_ptr<CommandState> cmdState,
+                                         size_t idx,
+                                         Milliseconds delay) {
+    std::shared_ptr<transport::ReactorTimer> timer = _reactor->makeTimer();
+    timer->waitUntil(now() + delay, nullptr)
+        .getAsync([this, cmdState = std::move(cmdState), idx, timer](Status status) {
+            if (!status.isOK()) {
+                // Account for this target as if its connection could not be acquired.
+                cmdState->requestManager->trySend(std::move(status), idx);
+                return;
+            }
+
+            if (cmdState->finishLine.isReady()) {
+                LOGV2_DEBUG(6105900,
+                            2,
+                            "Not hedging request as it finished within the hedge delay",
+                            "requestId"_attr = cmdState->requestOnAny.id,
+                            "target"_attr = cmdState->requestOnAny.target[idx]);
+                HedgingMetrics::get(_svcCtx)->incrementNumHedgesAvoidedByDelay();
+                return;
+            }
+
+            const auto& request = cmdState->requestOnAny;
+            _pool->get(request.target[idx], request.sslMode, request.timeout)
+                .thenRunOn(_reactor)
+                .getAsync([cmdState, idx](auto swConn) {
+                    cmdState->requestManager->trySend(std::move(swConn), idx);
+                });
+        });
+}
+
 void NetworkInterfaceTL::testEgress(const HostAndPort& hostAndPort,
                                     transport::ConnectSSLMode sslMode,
                                     Milliseconds timeout,
@@ -835,6 +874,15 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
 
             returnConnection(status);
 
+            // Record the round trip even if another request won, since the slow round trips are
+            // the ones that the hedge delay must account for.
+            if (auto& hedgeOptions = cmdState->requestOnAny.hedgeOptions; !isHedge &&
+                hedgeOptions && hedgeOptions->delayUntilSlow && status.isOK() &&
+                cmdState->interface->_svcCtx) {
+                HedgingMetrics::get(cmdState->interface->_svcCtx)
+                    ->recordUnhedgedLatency(stopwatch.elapsed());
+            }
+
             const auto commandStatus = getStatusFromCommandResult(response.data);
             if (isHedge) {
                 // Ignore maxTimeMS expiration, StaleDbVersion or any error belonging to
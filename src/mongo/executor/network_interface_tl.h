@@ -334,6 +334,12 @@ private:
 
     Status _killOperation(std::shared_ptr<RequestState> requestStateToKill);
 
+    /**
+     * Acquires a connection to, and sends the request to, target 'idx' of the command once 'delay'
+     * has passed, unless the command has finished by then.
+     */
+    void _sendHedgeAfter(std::shared_ptr<CommandState> cmdState, size_t idx, Milliseconds delay);
+
     std::string _instanceName;
     ServiceContext* _svcCtx = nullptr;
     transport::TransportLayer* _tl = nullptr;
@@ -47,6 +47,9 @@ struct RemoteCommandRequestBase {
     struct HedgeOptions {
         size_t count = 0;
         int maxTimeMSForHedgedReads = 0;
+        // If true, the additional requests are only sent once the first one has taken longer than
+        // most of its recent predecessors (see HedgingMetrics::getHedgeDelay()).
+        bool delayUntilSlow = false;
     };
 
     enum FireAndForgetMode { kOn, kOff };
@@ -33,6 +33,7 @@
 
 #include "mongo/executor/thread_pool_task_executor.h"
 
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <iterator>
 #include <utility>
@@ -586,7 +587,9 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                                      const WorkQueue::iterator& end,
                                                      stdx::unique_lock<Latch> lk) {
     dassert(fromQueue != &_poolInProgressQueue);
-    std::vector<std::shared_ptr<CallbackState>> todo(begin, end);
+    // Almost every call schedules a single callback, so keep that case from allocating while
+    // '_mutex' is held.
+    boost::container::small_vector<std::shared_ptr<CallbackState>, 1> todo(begin, end);
     _poolInProgressQueue.splice(_poolInProgressQueue.end(), *fromQueue, begin, end);
 
     lk.unlock();
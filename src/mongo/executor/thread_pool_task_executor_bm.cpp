@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/executor/network_interface_mock.h"
+#include "mongo/executor/thread_pool_task_executor.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+namespace executor {
+namespace {
+
+// The number of callbacks each benchmark iteration schedules before waiting for them to run.
+constexpr int kCallbacksPerIteration = 1000;
+
+std::shared_ptr<ThreadPoolTaskExecutor> makeExecutor(int threads) {
+    ThreadPool::Options options;
+    options.poolName = "ThreadPoolTaskExecutorBM";
+    options.minThreads = threads;
+    options.maxThreads = threads;
+    auto executor = std::make_shared<ThreadPoolTaskExecutor>(
+        std::make_unique<ThreadPool>(std::move(options)),
+        std::make_unique<NetworkInterfaceMock>());
+    executor->startup();
+    return executor;
+}
+
+/**
+ * Schedules batches of no-op callbacks from 'state.threads' producers onto an executor backed by
+ * 'state.range(0)' worker threads, and reports how many callbacks ran per second.
+ */
+void BM_ScheduleWork(benchmark::State& state) {
+    static std::shared_ptr<ThreadPoolTaskExecutor> executor;
+    if (state.thread_index == 0) {
+        executor = makeExecutor(state.range(0));
+    }
+
+    for (auto _ : state) {
+        stdx::mutex mutex;  // NOLINT
+        stdx::condition_variable done;
+        AtomicWord<int> remaining{kCallbacksPerIteration};
+
+        for (int i = 0; i < kCallbacksPerIteration; ++i) {
+            auto swCbHandle = executor->scheduleWork([&](const TaskExecutor::CallbackArgs&) {
+                if (remaining.subtractAndFetch(1) == 0) {
+                    stdx::lock_guard<stdx::mutex> lk(mutex);  // NOLINT
+                    done.notify_one();
+                }
+            });
+            invariant(swCbHandle.isOK());
+        }
+
+        stdx::unique_lock<stdx::mutex> lk(mutex);  // NOLINT
+        done.wait(lk, [&] { return remaining.load() == 0; });
+    }
+    state.SetItemsProcessed(state.iterations() * kCallbacksPerIteration);
+
+    if (state.thread_index == 0) {
+        executor->shutdown();
+        executor->join();
+        executor.reset();
+    }
+}
+
+BENCHMARK(BM_ScheduleWork)->Arg(1)->Arg(4)->Arg(16)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
+}  // namespace executor
+}  // namespace mongo
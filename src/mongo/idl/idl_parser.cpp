@@ -341,6 +341,17 @@ std::vector<std::vector<std::uint8_t>> transformVector(const std::vector<ConstDa
     return output;
 }
 
+namespace idl {
+
+BSONObj getOwnedSubObject(const BSONObj& obj, const BSONObj& owner) {
+    if (!owner.isOwned()) {
+        return obj.getOwned();
+    }
+    return BSONObj(obj).shareOwnershipWith(owner.sharedBuffer());
+}
+
+}  // namespace idl
+
 /**
  * IMPORTANT: The method should not be modified, as API version input/output guarantees could
  * break because of it.
@@ -369,6 +380,14 @@ BSONObj parseOwnedBSON(BSONElement element) {
     return element.Obj().getOwned();
 }
 
+BSONObj parseOwnedBSON(BSONElement element, const BSONObj& owner) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "Expected field " << element.fieldNameStringData()
+                          << "to be of type object",
+            element.type() == BSONType::Object);
+    return idl::getOwnedSubObject(element.Obj(), owner);
+}
+
 /**
  * IMPORTANT: The method should not be modified, as API version input/output guarantees could
  * break because of it.
@@ -427,6 +427,19 @@ std::vector<std::string> transformVector(const std::vector<StringData>& input);
 std::vector<ConstDataRange> transformVector(const std::vector<std::vector<std::uint8_t>>& input);
 std::vector<std::vector<std::uint8_t>> transformVector(const std::vector<ConstDataRange>& input);
 
+namespace idl {
+
+/**
+ * Returns an owned version of 'obj', a sub-object of 'owner', which shares ownership of the buffer
+ * of 'owner' if it is owned and is a copy otherwise.
+ *
+ * Used by the IDL generated parsers of OpMsgRequests, so that their owned BSONObj fields do not
+ * copy out of the request.
+ */
+BSONObj getOwnedSubObject(const BSONObj& obj, const BSONObj& owner);
+
+}  // namespace idl
+
 /**
  * IMPORTANT: The method should not be modified, as API version input/output guarantees could
  * break because of it.
@@ -445,6 +458,12 @@ void serializeBSONWhenNotEmpty(BSONObj obj, StringData fieldName, BSONObjBuilder
  */
 BSONObj parseOwnedBSON(BSONElement element);
 
+/**
+ * Like parseOwnedBSON(), but shares ownership of the buffer of 'owner', the object 'element'
+ * belongs to, instead of copying the sub-object if 'owner' is owned.
+ */
+BSONObj parseOwnedBSON(BSONElement element, const BSONObj& owner);
+
 /**
  * IMPORTANT: The method should not be modified, as API version input/output guarantees could
  * break because of it.
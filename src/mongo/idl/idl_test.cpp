@@ -3683,6 +3683,41 @@ TEST(IDLTypeCommand, TestCommandWithIDLAnyTypeOwnedField) {
                                                         << "b"))["anyTypeField"]);
 }
 
+TEST(IDLTypeCommand, TestOwnedObjectFieldSharesRequestBuffer) {
+    IDLParserErrorContext ctxt("root");
+
+    auto isWithin = [](const BSONObj& obj, const BSONObj& owner) {
+        return obj.objdata() >= owner.objdata() &&
+            obj.objdata() + obj.objsize() <= owner.objdata() + owner.objsize();
+    };
+
+    auto request = makeOMR(BSON(CommandWithOwnedObjectMember::kCommandName
+                                << 1 << "ownedObjectField" << BSON("a" << 1) << "$db"
+                                << "db"));
+    ASSERT_TRUE(request.body.isOwned());
+
+    // Parsing an OpMsgRequest shares the buffer of the owned body.
+    auto parsed = CommandWithOwnedObjectMember::parse(ctxt, request);
+    ASSERT_TRUE(parsed.getOwnedObjectField().isOwned());
+    ASSERT_TRUE(isWithin(parsed.getOwnedObjectField(), request.body));
+
+    // The parsed field outlives the request.
+    const auto body = request.body.copy();
+    request = OpMsgRequest();
+    ASSERT_BSONOBJ_EQ(parsed.getOwnedObjectField(), BSON("a" << 1));
+
+    // An unowned body is copied out of.
+    request = makeOMR(BSONObj(body.objdata()));
+    ASSERT_FALSE(request.body.isOwned());
+    parsed = CommandWithOwnedObjectMember::parse(ctxt, request);
+    ASSERT_TRUE(parsed.getOwnedObjectField().isOwned());
+    ASSERT_FALSE(isWithin(parsed.getOwnedObjectField(), body));
+
+    // Parsing a BSONObj still copies.
+    parsed = CommandWithOwnedObjectMember::parse(ctxt, body);
+    ASSERT_FALSE(isWithin(parsed.getOwnedObjectField(), body));
+}
+
 void verifyContract(const AuthorizationContract& left, const AuthorizationContract& right) {
     ASSERT_TRUE(left.contains(right));
     ASSERT_TRUE(right.contains(left));
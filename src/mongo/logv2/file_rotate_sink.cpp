@@ -33,13 +33,20 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
 #include <fmt/format.h>
 #include <fstream>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/string_map.h"
@@ -70,19 +77,176 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
         file->put('\n');
     return file;
 }
+
+// Matches the default auto_newline_mode of text_ostream_backend.
+void appendRecord(std::string& buffer, StringData record) {
+    buffer.append(record.rawData(), record.size());
+    if (record.empty() || record[record.size() - 1] != '\n')
+        buffer.push_back('\n');
+}
+
+bool isFailed(const std::pair<const std::string, boost::shared_ptr<stream_t>>& file) {
+    return file.second->fail();
+}
+
+void abortOnFailedWrites(const StringMap<boost::shared_ptr<stream_t>>& files,
+                         LogTimestampFormat timestampFormat) {
+    try {
+        auto failedBegin = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+        auto failedEnd = boost::make_filter_iterator(isFailed, files.end(), files.end());
+
+        auto getFilename = [](const auto& file) -> const auto& {
+            return file.first;
+        };
+        auto begin = boost::make_transform_iterator(failedBegin, getFilename);
+        auto end = boost::make_transform_iterator(failedEnd, getFilename);
+        auto sequence = logv2::seqLog(begin, end);
+
+        DynamicAttributes attrs;
+        attrs.add("files", sequence);
+
+        fmt::memory_buffer buffer;
+        JSONFormatter(nullptr, timestampFormat)
+            .format(buffer,
+                    LogSeverity::Severe(),
+                    LogComponent::kControl,
+                    Date_t::now(),
+                    4522200,
+                    getThreadName(),
+                    "Writing to log file failed, aborting application",
+                    TypeErasedAttributeStorage(attrs),
+                    LogTag::kNone,
+                    LogTruncation::Disabled);
+        // Commented out log line below to get validation of the log id with the errorcodes
+        // linter LOGV2(4522200, "Writing to log file failed, aborting application");
+        std::cerr << StringData(buffer.data(), buffer.size()) << std::endl;
+    } catch (const std::exception& ex) {
+        std::cerr << "Caught std::exception of type " << demangleName(typeid(ex)) << ": "
+                  << ex.what() << std::endl;
+    } catch (const boost::exception& ex) {
+        std::cerr << "Caught boost::exception of type " << demangleName(typeid(ex)) << ": "
+                  << boost::diagnostic_information(ex) << std::endl;
+    } catch (...) {
+        std::cerr << "Caught unidentified exception" << std::endl;
+    }
+
+    printStackTrace(std::cerr);
+    quickExitWithoutLogging(EXIT_FAILURE);
+}
 }  // namespace
 
 struct FileRotateSink::Impl {
     Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
+
+    // Writes out everything buffered so far. Must be called with 'filesMutex' held so that
+    // batches reach the files in the order they were buffered.
+    void writeBuffered(WithLock);
+
+    void asyncWriterLoop();
+
     StringMap<boost::shared_ptr<stream_t>> files;
     LogTimestampFormat timestampFormat;
+
+    // State for asynchronous writes, see startAsyncWrites(). 'filesMutex' serializes writes to
+    // 'files' with changes to them, as the writer thread does not hold the sink frontend's lock.
+    // When both are needed 'filesMutex' is acquired before 'bufferMutex'.
+    bool async = false;
+    stdx::mutex filesMutex;  // NOLINT
+    stdx::mutex bufferMutex;  // NOLINT
+    stdx::condition_variable bufferCV;
+    std::string buffered;
+    std::string writing;  // Only used with 'filesMutex' held.
+    size_t maxBufferedBytes = 0;
+    uint64_t droppedRecords = 0;
+    bool shutdown = false;
+    stdx::thread writer;
 };
 
+void FileRotateSink::Impl::writeBuffered(WithLock) {
+    // Swapping the buffers keeps both of their capacities, so neither side reallocates once
+    // the log volume has settled.
+    uint64_t dropped;
+    {
+        stdx::lock_guard lk(bufferMutex);
+        writing.swap(buffered);
+        dropped = std::exchange(droppedRecords, 0);
+    }
+
+    if (dropped) {
+        DynamicAttributes attrs;
+        attrs.add("dropped", static_cast<long long>(dropped));
+
+        fmt::memory_buffer buffer;
+        JSONFormatter(nullptr, timestampFormat)
+            .format(buffer,
+                    LogSeverity::Warning(),
+                    LogComponent::kControl,
+                    Date_t::now(),
+                    6107000,
+                    getThreadName(),
+                    "Dropped log records because the asynchronous log write buffer was full",
+                    TypeErasedAttributeStorage(attrs),
+                    LogTag::kNone,
+                    LogTruncation::Disabled);
+        // Commented out log line below to get validation of the log id with the errorcodes
+        // linter LOGV2(6107000, "Dropped log records because the asynchronous log write buffer
+        // was full");
+        buffer.push_back('\n');
+        writing.append(buffer.data(), buffer.size());
+    }
+
+    if (writing.empty())
+        return;
+
+    for (auto& file : files) {
+        file.second->write(writing.data(), writing.size());
+        file.second->flush();
+    }
+    writing.clear();
+    if (std::any_of(files.begin(), files.end(), isFailed))
+        abortOnFailedWrites(files, timestampFormat);
+}
+
+void FileRotateSink::Impl::asyncWriterLoop() {
+    setThreadName("LogWriter");
+    while (true) {
+        bool done;
+        {
+            stdx::unique_lock lk(bufferMutex);
+            bufferCV.wait(lk, [&] { return shutdown || !buffered.empty() || droppedRecords; });
+            done = shutdown;
+        }
+
+        stdx::lock_guard lk(filesMutex);
+        writeBuffered(lk);
+        if (done)
+            return;
+    }
+}
+
 FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
     : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->writer.joinable()) {
+        {
+            stdx::lock_guard lk(_impl->bufferMutex);
+            _impl->shutdown = true;
+        }
+        _impl->bufferCV.notify_one();
+        _impl->writer.join();
+    }
+}
+
+void FileRotateSink::startAsyncWrites(size_t maxBufferedBytes) {
+    invariant(!_impl->async);
+    _impl->async = true;
+    _impl->maxBufferedBytes = maxBufferedBytes;
+    _impl->writer = stdx::thread([this] { _impl->asyncWriterLoop(); });
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
+    stdx::lock_guard lk(_impl->filesMutex);
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
         add_stream(statusWithFile.getValue());
@@ -92,6 +256,7 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    stdx::lock_guard lk(_impl->filesMutex);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -102,6 +267,11 @@ void FileRotateSink::removeFile(const std::string& filename) {
 Status FileRotateSink::rotate(bool rename,
                               StringData renameSuffix,
                               std::function<void(Status)> onMinorError) {
+    stdx::lock_guard lk(_impl->filesMutex);
+    // Records buffered before the rotation belong in the file being rotated out.
+    if (_impl->async)
+        _impl->writeBuffered(lk);
+
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -161,53 +331,34 @@ Status FileRotateSink::rotate(bool rename,
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
-    auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
-    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
-        try {
-            auto failedBegin =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-            auto failedEnd =
-                boost::make_filter_iterator(isFailed, _impl->files.end(), _impl->files.end());
-
-            auto getFilename = [](const auto& file) -> const auto& {
-                return file.first;
-            };
-            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
-            auto end = boost::make_transform_iterator(failedEnd, getFilename);
-            auto sequence = logv2::seqLog(begin, end);
-
-            DynamicAttributes attrs;
-            attrs.add("files", sequence);
-
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        LogTruncation::Disabled);
-            // Commented out log line below to get validation of the log id with the errorcodes
-            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cerr << StringData(buffer.data(), buffer.size()) << std::endl;
-        } catch (const std::exception& ex) {
-            std::cerr << "Caught std::exception of type " << demangleName(typeid(ex)) << ": "
-                      << ex.what() << std::endl;
-        } catch (const boost::exception& ex) {
-            std::cerr << "Caught boost::exception of type " << demangleName(typeid(ex)) << ": "
-                      << boost::diagnostic_information(ex) << std::endl;
-        } catch (...) {
-            std::cerr << "Caught unidentified exception" << std::endl;
+    if (_impl->async) {
+        const auto severity =
+            boost::log::extract<LogSeverity>(attributes::severity(), rec).get();
+        if (severity >= LogSeverity::Error()) {
+            stdx::lock_guard filesLk(_impl->filesMutex);
+            {
+                stdx::lock_guard lk(_impl->bufferMutex);
+                appendRecord(_impl->buffered, formatted_string);
+            }
+            _impl->writeBuffered(filesLk);
+            return;
         }
 
-        printStackTrace(std::cerr);
-        quickExitWithoutLogging(EXIT_FAILURE);
+        {
+            stdx::lock_guard lk(_impl->bufferMutex);
+            if (_impl->buffered.size() + formatted_string.size() >= _impl->maxBufferedBytes) {
+                ++_impl->droppedRecords;
+                return;
+            }
+            appendRecord(_impl->buffered, formatted_string);
+        }
+        _impl->bufferCV.notify_one();
+        return;
     }
+
+    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed))
+        abortOnFailedWrites(_impl->files, _impl->timestampFormat);
 }
 
 }  // namespace mongo::logv2
@@ -50,6 +50,14 @@ public:
 
     Status rotate(bool rename, StringData renameSuffix, std::function<void(Status)> onMinorError);
 
+    // Hands formatted records to a background thread that writes them out, instead of writing
+    // and flushing on the logging thread. At most 'maxBufferedBytes' of records wait to be
+    // written; records that do not fit are dropped and the number dropped is written to the log
+    // once there is room again. Records of severity Error and above are written synchronously,
+    // together with everything buffered before them, so they are on disk before the caller
+    // carries on (and possibly aborts).
+    void startAsyncWrites(size_t maxBufferedBytes);
+
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
 private:
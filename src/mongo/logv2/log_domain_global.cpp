@@ -172,6 +172,8 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
         if (!ret.isOK())
             return ret;
         backend->lockedBackend<0>()->auto_flush(true);
+        if (options.fileAsyncWriteBufferBytes)
+            backend->lockedBackend<0>()->startAsyncWrites(options.fileAsyncWriteBufferBytes);
         backend->setFilter<2>(
             TaggedSeverityFilter(_parent, {LogTag::kStartupWarnings}, LogSeverity::Log()));
 
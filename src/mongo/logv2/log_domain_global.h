@@ -45,6 +45,9 @@ public:
         std::string filePath;
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
+        // When non-zero, log file writes happen on a background thread, see
+        // FileRotateSink::startAsyncWrites().
+        size_t fileAsyncWriteBufferBytes{0};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
         bool syslogEnabled{false};
         int syslogFacility{-1};  // invalid facility by default, must be set
@@ -97,6 +97,34 @@ private:
     bool _shouldInit;
 };
 
+// Logs through the server's own file sink into /dev/null, so that the cost of writing and flushing
+// the log file is on the logging thread unless asynchronous writes are enabled.
+class ScopedLogV2FileBench {
+public:
+    ScopedLogV2FileBench(benchmark::State& state) {
+        _shouldInit = state.thread_index == 0;
+        if (_shouldInit) {
+            logv2::LogDomainGlobal::ConfigurationOptions config;
+            config.consoleEnabled = false;
+            config.fileEnabled = true;
+            config.filePath = "/dev/null";
+            config.fileOpenMode = logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kAppend;
+            config.fileAsyncWriteBufferBytes = state.range(0);
+            invariant(
+                logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
+        }
+    }
+
+    ~ScopedLogV2FileBench() {
+        if (_shouldInit) {
+            invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
+        }
+    }
+
+private:
+    bool _shouldInit;
+};
+
 // "Expensive" way to create a string.
 std::string createLongString() {
     return std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c') +
@@ -150,6 +178,20 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+void BM_EnabledLogV2FileSink(benchmark::State& state) {
+    ScopedLogV2FileBench init(state);
+
+    for (auto _ : state) {
+        LOGV2(6107001,
+              "Slow query",
+              "ns"_attr = "test.coll"_sd,
+              "durationMillis"_attr = 150,
+              "planSummary"_attr = "IXSCAN { a: 1 }"_sd,
+              "docsExamined"_attr = 1000,
+              "keysExamined"_attr = 1000);
+    }
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
@@ -161,6 +203,8 @@ BENCHMARK(BM_NoopLogV2Arg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
+// The argument is the asynchronous write buffer size, 0 writes synchronously.
+BENCHMARK(BM_EnabledLogV2FileSink)->Arg(0)->Arg(64 << 20)->Apply(ThreadCounts);
 
 }  // namespace
 }  // namespace mongo
@@ -127,7 +127,7 @@ void OpMsg::appendChecksum(Message* message) {
 #endif
 }
 
-OpMsg OpMsg::parse(const Message& message) try {
+OpMsg OpMsg::parse(const Message& message, bool validateBSON) try {
     // It is the caller's responsibility to call the correct parser for a given message type.
     invariant(!message.empty());
     invariant(message.operation() == dbMsg);
@@ -150,6 +150,12 @@ OpMsg OpMsg::parse(const Message& message) try {
 
     // The sections begin after the flags and before the checksum (if present).
     BufReader sectionsBuf(message.singleData().data() + sizeof(flags), dataSize);
+    auto readBSON = [validateBSON](BufReader& buf) -> BSONObj {
+        if (validateBSON) {
+            return buf.read<Validated<BSONObj>>();
+        }
+        return buf.read<BSONObj>();
+    };
 
     // TODO some validation may make more sense in the IDL parser. I've tagged them with comments.
     bool haveBody = false;
@@ -160,7 +166,7 @@ OpMsg OpMsg::parse(const Message& message) try {
             case Section::kBody: {
                 uassert(40430, "Multiple body sections in message", !haveBody);
                 haveBody = true;
-                msg.body = sectionsBuf.read<Validated<BSONObj>>();
+                msg.body = readBSON(sectionsBuf);
                 break;
             }
 
@@ -183,7 +189,7 @@ OpMsg OpMsg::parse(const Message& message) try {
 
                 msg.sequences.push_back({name.toString()});
                 while (!seqBuf.atEof()) {
-                    msg.sequences.back().objs.push_back(seqBuf.read<Validated<BSONObj>>());
+                    msg.sequences.back().objs.push_back(readBSON(seqBuf));
                 }
                 break;
             }
@@ -105,15 +105,16 @@ struct OpMsg {
     }
 
     /**
-     * Parses and returns an OpMsg containing unowned BSON.
+     * Parses and returns an OpMsg containing unowned BSON. The BSON is validated unless
+     * 'validateBSON' is false, which is only appropriate for messages built by this process.
      */
-    static OpMsg parse(const Message& message);
+    static OpMsg parse(const Message& message, bool validateBSON = true);
 
     /**
      * Parses and returns an OpMsg containing owned BSON.
      */
-    static OpMsg parseOwned(const Message& message) {
-        auto msg = parse(message);
+    static OpMsg parseOwned(const Message& message, bool validateBSON = true) {
+        auto msg = parse(message, validateBSON);
         msg.shareOwnershipWith(message.sharedBuffer());
         return msg;
     }
@@ -160,8 +161,8 @@ struct OpMsgRequest : public OpMsg {
         return OpMsgRequest(OpMsg::parse(message));
     }
 
-    static OpMsgRequest parseOwned(const Message& message) {
-        return OpMsgRequest(OpMsg::parseOwned(message));
+    static OpMsgRequest parseOwned(const Message& message, bool validateBSON = true) {
+        return OpMsgRequest(OpMsg::parseOwned(message, validateBSON));
     }
 
     static OpMsgRequest fromDBAndBody(StringData db,
@@ -639,6 +639,20 @@ TEST_F(OpMsgParser, FailsWithChecksumMismatch) {
     });
 }
 
+TEST_F(OpMsgParser, SkipsBSONValidationWhenAsked) {
+    // A body holding an element of the unknown type 0x20.
+    auto makeMsg = [] {
+        return OpMsgBytes{
+            kNoFlags,  //
+            kBodySection,
+            Sized{'\x20', "a"_sd, '\0'},
+        };
+    };
+
+    ASSERT_THROWS_CODE(makeMsg().parse(), AssertionException, ErrorCodes::InvalidBSON);
+    ASSERT_EQ(OpMsg::parseOwned(makeMsg().done(), false /* validateBSON */).body.objsize(), 8);
+}
+
 void testSerializer(const Message& fromSerializer, OpMsgBytes&& expected) {
     const auto expectedMsg = expected.done();
     ASSERT_EQ(fromSerializer.operation(), dbMsg);
@@ -103,6 +103,7 @@ CatalogCache::CatalogCache(ServiceContext* const service, CatalogCacheLoader& ca
       }())),
       _databaseCache(service, *_executor, _cacheLoader),
       _collectionCache(service, *_executor, _cacheLoader) {
+    _databaseCache.setNegativeCacheTTL(Milliseconds(gCatalogCacheDatabaseNegativeCacheTTLMS));
     _executor->startup();
 }
 
@@ -349,6 +350,24 @@ void CatalogCache::invalidateShardOrEntireCollectionEntryForShardedCollection(
     }
 }
 
+bool CatalogCache::onRoutingTableChangeNotification(const NamespaceString& nss,
+                                                    const ChunkVersion& newVersion) {
+    if (!_collectionCache.peekLatestCached(nss)) {
+        return false;
+    }
+    _stats.countRoutingTableChangeNotifications.addAndFetch(1);
+
+    if (!_collectionCache.advanceTimeInStore(
+            nss, ComparableChunkVersion::makeComparableChunkVersion(newVersion))) {
+        return false;
+    }
+    _stats.countRefreshesStartedByNotification.addAndFetch(1);
+
+    // Nothing waits for the refresh here, requests which need the routing table join it instead.
+    (void)_collectionCache.acquireAsync(nss, CacheCausalConsistency::kLatestKnown);
+    return true;
+}
+
 void CatalogCache::invalidateEntriesThatReferenceShard(const ShardId& shardId) {
     LOGV2_DEBUG(4997600,
                 1,
@@ -405,6 +424,9 @@ void CatalogCache::report(BSONObjBuilder* builder) const {
 
     _stats.report(&cacheStatsBuilder);
     _collectionCache.reportStats(&cacheStatsBuilder);
+
+    BSONObjBuilder databaseCacheBuilder(cacheStatsBuilder.subobjStart("databaseCache"));
+    _databaseCache.appendStats(&databaseCacheBuilder);
 }
 
 void CatalogCache::checkAndRecordOperationBlockedByRefresh(OperationContext* opCtx,
@@ -448,6 +470,10 @@ void CatalogCache::invalidateCollectionEntry_LINEARIZABLE(const NamespaceString&
 
 void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     builder->append("countStaleConfigErrors", countStaleConfigErrors.load());
+    builder->append("countRoutingTableChangeNotifications",
+                    countRoutingTableChangeNotifications.load());
+    builder->append("countRefreshesStartedByNotification",
+                    countRefreshesStartedByNotification.load());
 
     builder->append("totalRefreshWaitTimeMicros", totalRefreshWaitTimeMicros.load());
 
@@ -577,6 +603,11 @@ void CatalogCache::CollectionCache::Stats::report(BSONObjBuilder* builder) const
     builder->append("countFullRefreshesStarted", countFullRefreshesStarted.load());
 
     builder->append("countFailedRefreshes", countFailedRefreshes.load());
+
+    builder->append("totalIncrementalRefreshTimeMicros", totalIncrementalRefreshTimeMicros.load());
+    builder->append("totalFullRefreshTimeMicros", totalFullRefreshTimeMicros.load());
+    builder->append("totalIncrementalRoutingTableUpdateTimeMicros",
+                    totalIncrementalRoutingTableUpdateTimeMicros.load());
 }
 
 CatalogCache::CollectionCache::LookupResult CatalogCache::CollectionCache::_lookupCollection(
@@ -611,6 +642,11 @@ CatalogCache::CollectionCache::LookupResult CatalogCache::CollectionCache::_look
             // updating. Otherwise, we're making a whole new routing table.
             if (isIncremental &&
                 existingHistory->optRt->getVersion().epoch() == collectionAndChunks.epoch) {
+                Timer updateTimer;
+                ON_BLOCK_EXIT([&] {
+                    _stats.totalIncrementalRoutingTableUpdateTimeMicros.addAndFetch(
+                        updateTimer.micros());
+                });
                 if (existingHistory->optRt->getVersion().getTimestamp().is_initialized() !=
                     collectionAndChunks.creationTime.is_initialized()) {
                     return existingHistory->optRt
@@ -690,6 +726,11 @@ CatalogCache::CollectionCache::LookupResult CatalogCache::CollectionCache::_look
                                   "timeInStore"_attr = previousVersion.toBSONForLogging(),
                                   "duration"_attr = Milliseconds(t.millis()));
         _updateRefreshesStats(isIncremental, false);
+        if (isIncremental) {
+            _stats.totalIncrementalRefreshTimeMicros.addAndFetch(t.micros());
+        } else {
+            _stats.totalFullRefreshTimeMicros.addAndFetch(t.micros());
+        }
 
         return LookupResult(OptionalRoutingTableHistory(std::move(newRoutingHistory)),
                             std::move(newComparableVersion));
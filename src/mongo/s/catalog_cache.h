@@ -172,6 +172,18 @@ public:
         const boost::optional<ChunkVersion>& wantedVersion,
         const ShardId& shardId);
 
+    /**
+     * Non-blocking method, to be called when the config server reports that a chunk of 'nss' was
+     * committed at 'newVersion'. If an older routing table for 'nss' is cached, marks it as needing
+     * refresh and starts refreshing it in the background, so that later requests find it up to
+     * date instead of discovering it is stale through a StaleConfig error. Collections which are
+     * not cached are left to be loaded when first needed.
+     *
+     * Returns whether a refresh was started.
+     */
+    bool onRoutingTableChangeNotification(const NamespaceString& nss,
+                                          const ChunkVersion& newVersion);
+
     /**
      * Non-blocking method, which invalidates all namespaces which contain data on the specified
      * shard and all databases which have the shard listed as their primary shard.
@@ -268,6 +280,15 @@ private:
             // failed for whatever reason
             AtomicWord<long long> countFailedRefreshes{0};
 
+            // Cumulative, always-increasing counters of how much time successful incremental and
+            // full refreshes took
+            AtomicWord<long long> totalIncrementalRefreshTimeMicros{0};
+            AtomicWord<long long> totalFullRefreshTimeMicros{0};
+
+            // Cumulative, always-increasing counter of how much time incremental refreshes spent
+            // merging the changed chunks into the cached routing table
+            AtomicWord<long long> totalIncrementalRoutingTableUpdateTimeMicros{0};
+
             /**
              * Reports the accumulated statistics for serverStatus.
              */
@@ -301,6 +322,11 @@ private:
         // refreshes)
         AtomicWord<long long> countStaleConfigErrors{0};
 
+        // Counts how many chunk changes were reported for cached collections by the config server,
+        // and how many of them started a refresh because the cached routing table was older
+        AtomicWord<long long> countRoutingTableChangeNotifications{0};
+        AtomicWord<long long> countRefreshesStartedByNotification{0};
+
         // Cumulative, always-increasing counter of how much time threads waiting for refresh
         // combined
         AtomicWord<long long> totalRefreshWaitTimeMicros{0};
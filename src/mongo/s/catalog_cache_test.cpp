@@ -275,6 +275,41 @@ TEST_F(CatalogCacheTest, OnStaleShardVersionWithGraterVersion) {
     ASSERT(status == ErrorCodes::InternalError);
 }
 
+TEST_F(CatalogCacheTest, RoutingTableChangeNotificationWithSameVersion) {
+    const auto dbVersion = DatabaseVersion(UUID::gen());
+    const auto cachedCollVersion = ChunkVersion(1, 0, OID::gen(), boost::none /* timestamp */);
+
+    loadDatabases({DatabaseType(kNss.db().toString(), kShards[0], true, dbVersion)});
+    loadCollection(cachedCollVersion);
+    ASSERT_FALSE(_catalogCache->onRoutingTableChangeNotification(kNss, cachedCollVersion));
+    ASSERT_OK(_catalogCache->getCollectionRoutingInfo(operationContext(), kNss).getStatus());
+}
+
+TEST_F(CatalogCacheTest, RoutingTableChangeNotificationForUncachedCollection) {
+    const auto collVersion = ChunkVersion(1, 0, OID::gen(), boost::none /* timestamp */);
+    ASSERT_FALSE(_catalogCache->onRoutingTableChangeNotification(kNss, collVersion));
+}
+
+TEST_F(CatalogCacheTest, RoutingTableChangeNotificationWithGreaterVersionRefreshes) {
+    const auto dbVersion = DatabaseVersion(UUID::gen());
+    const auto cachedCollVersion = ChunkVersion(1, 0, OID::gen(), boost::none /* timestamp */);
+    const auto newCollVersion =
+        ChunkVersion(2, 0, cachedCollVersion.epoch(), cachedCollVersion.getTimestamp());
+
+    loadDatabases({DatabaseType(kNss.db().toString(), kShards[0], true, dbVersion)});
+    loadCollection(cachedCollVersion);
+
+    // The refresh starts in the background with the notification, so the new chunks must be
+    // available before it.
+    const auto scopedCollProv = scopedCollectionProvider(makeCollectionType(newCollVersion));
+    const auto scopedChunksProv = scopedChunksProvider(makeChunks(newCollVersion));
+    ASSERT_TRUE(_catalogCache->onRoutingTableChangeNotification(kNss, newCollVersion));
+
+    const auto swChunkManager = _catalogCache->getCollectionRoutingInfo(operationContext(), kNss);
+    ASSERT_OK(swChunkManager.getStatus());
+    ASSERT_EQ(swChunkManager.getValue().getVersion(), newCollVersion);
+}
+
 TEST_F(CatalogCacheTest, GetDatabaseWithMetadataFormatChange) {
     const auto dbName = "testDB";
     const auto uuid = UUID::gen();
@@ -33,6 +33,8 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include <limits>
+
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -192,7 +194,18 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
 }
 
 void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
+    if (!_chunkMap.empty() && chunk->getRange().overlaps(_chunkMap.back()->getRange())) {
+        if (_chunkMap.back()->getLastmod().isOlderThan(chunk->getLastmod())) {
+            _chunkMap.pop_back();
+            _popBackMaxKeyString();
+            _chunkMap.push_back(chunk);
+            _pushBackMaxKeyString(chunk->getMaxKeyString());
+        }
+    } else {
+        _chunkMap.push_back(chunk);
+        _pushBackMaxKeyString(chunk->getMaxKeyString());
+    }
+
     const auto chunkVersion = chunk->getLastmod();
     if (_collectionVersion.isOlderThan(chunkVersion)) {
         _collectionVersion = ChunkVersion(chunkVersion.majorVersion(),
@@ -228,6 +241,18 @@ ChunkMap ChunkMap::createMerged(
     ChunkMap updatedChunkMap(
         getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
 
+    // Once an unchanged chunk is appended as is, the unchanged chunks following it up to the next
+    // changed chunk cannot overlap anything in the updated map, so they are copied in bulk. This
+    // keeps merging a few changes into a large map from comparing the bounds of every chunk.
+    auto appendUnchangedChunk = [&](size_t end) {
+        const auto& chunk = _chunkMap[chunkMapIndex++];
+        updatedChunkMap.appendChunk(chunk);
+        if (updatedChunkMap._chunkMap.back() == chunk && chunkMapIndex < end) {
+            updatedChunkMap._appendChunks(*this, chunkMapIndex, end);
+            chunkMapIndex = end;
+        }
+    };
+
     while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
         if (chunkMapIndex >= _chunkMap.size()) {
             validateChunk(changedChunks[changedChunkIndex], getVersion());
@@ -236,7 +261,7 @@ ChunkMap ChunkMap::createMerged(
         }
 
         if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            appendUnchangedChunk(_chunkMap.size());
             continue;
         }
 
@@ -253,7 +278,10 @@ ChunkMap ChunkMap::createMerged(
             validateChunk(changedChunk, getVersion());
             updatedChunkMap.appendChunk(changedChunk);
         } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            // The chunks whose max is not greater than the changed chunk's min are before it.
+            const auto changedChunkMin =
+                ShardKeyPattern::toKeyString(changedChunks[changedChunkIndex]->getMin());
+            appendUnchangedChunk(_findIntersectingChunkIndex(changedChunkMin, true));
         }
     }
 
@@ -278,22 +306,60 @@ BSONObj ChunkMap::toBSON() const {
 
 ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
                                                                        bool isMaxInclusive) const {
-    auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
-
-    if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
-    } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
+    return _chunkMap.begin() +
+        _findIntersectingChunkIndex(ShardKeyPattern::toKeyString(shardKey), isMaxInclusive);
+}
+
+size_t ChunkMap::_findIntersectingChunkIndex(StringData keyString, bool isMaxInclusive) const {
+    size_t first = 0;
+    size_t count = _chunkMap.size();
+    while (count > 0) {
+        const size_t step = count / 2;
+        const size_t mid = first + step;
+        const auto maxKeyString = _getMaxKeyString(mid);
+        if (isMaxInclusive ? maxKeyString <= keyString : maxKeyString < keyString) {
+            first = mid + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+void ChunkMap::_pushBackMaxKeyString(const std::string& maxKeyString) {
+    invariant(_maxKeyStrings.size() + maxKeyString.size() <= std::numeric_limits<uint32_t>::max());
+    _maxKeyStrings.append(maxKeyString);
+    _maxKeyStringEnds.push_back(static_cast<uint32_t>(_maxKeyStrings.size()));
+}
+
+void ChunkMap::_popBackMaxKeyString() {
+    _maxKeyStringEnds.pop_back();
+    _maxKeyStrings.resize(_maxKeyStringEnds.empty() ? 0 : _maxKeyStringEnds.back());
+}
+
+void ChunkMap::_appendChunks(const ChunkMap& other, size_t begin, size_t end) {
+    invariant(begin < end && end <= other._chunkMap.size());
+    _chunkMap.insert(
+        _chunkMap.end(), other._chunkMap.begin() + begin, other._chunkMap.begin() + end);
+
+    const size_t keyStringsBegin = begin == 0 ? 0 : other._maxKeyStringEnds[begin - 1];
+    const size_t keyStringsEnd = other._maxKeyStringEnds[end - 1];
+    const size_t offset = _maxKeyStrings.size();
+    invariant(offset + keyStringsEnd - keyStringsBegin <= std::numeric_limits<uint32_t>::max());
+    _maxKeyStrings.append(other._maxKeyStrings, keyStringsBegin, keyStringsEnd - keyStringsBegin);
+    for (size_t i = begin; i < end; ++i) {
+        _maxKeyStringEnds.push_back(
+            static_cast<uint32_t>(offset + other._maxKeyStringEnds[i] - keyStringsBegin));
+    }
+
+    // None of the chunks of 'other' is newer than its collection version, so that bounds the
+    // version of the chunks appended.
+    if (_collectionVersion.isOlderThan(other._collectionVersion)) {
+        _collectionVersion = ChunkVersion(other._collectionVersion.majorVersion(),
+                                          other._collectionVersion.minorVersion(),
+                                          other._collectionVersion.epoch(),
+                                          _collTimestamp);
     }
 }
 
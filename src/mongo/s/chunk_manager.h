@@ -82,6 +82,7 @@ public:
                       size_t initialCapacity = 0)
         : _collectionVersion(0, 0, epoch, timestamp), _collTimestamp(timestamp) {
         _chunkMap.reserve(initialCapacity);
+        _maxKeyStringEnds.reserve(initialCapacity);
     }
 
     size_t size() const {
@@ -130,8 +131,38 @@ private:
     std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
         const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
 
+    /**
+     * Returns the max key string of the chunk at position 'i' in '_chunkMap'.
+     */
+    StringData _getMaxKeyString(size_t i) const {
+        const size_t begin = i == 0 ? 0 : _maxKeyStringEnds[i - 1];
+        return StringData(_maxKeyStrings.data() + begin, _maxKeyStringEnds[i] - begin);
+    }
+
+    /**
+     * Returns the position in '_chunkMap' of the first chunk whose max key string is greater than
+     * 'keyString', or not less than it if 'isMaxInclusive' is false.
+     */
+    size_t _findIntersectingChunkIndex(StringData keyString, bool isMaxInclusive) const;
+
+    void _pushBackMaxKeyString(const std::string& maxKeyString);
+    void _popBackMaxKeyString();
+
+    /**
+     * Appends the chunks of 'other' at positions [begin, end), which must not overlap the last
+     * chunk of this map, without comparing their bounds.
+     */
+    void _appendChunks(const ChunkMap& other, size_t begin, size_t end);
+
     ChunkVector _chunkMap;
 
+    // The max key strings of the chunks in '_chunkMap', in the same order, laid out back to back so
+    // that a lookup compares bytes of one buffer rather than dereferencing every chunk it probes.
+    std::string _maxKeyStrings;
+
+    // The offset in '_maxKeyStrings' at which the max key string of each chunk ends.
+    std::vector<uint32_t> _maxKeyStringEnds;
+
     // Max version across all chunks
     ChunkVersion _collectionVersion;
 
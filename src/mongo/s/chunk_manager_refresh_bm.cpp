@@ -413,6 +413,27 @@ MONGO_INITIALIZER(RegisterBenchmarks)(InitializerContext* context) {
             ->Args({1000, 50000})
             ->Args({2, 2});
     }
+
+    // Targeting against collections with many chunks, where the routing table no longer fits in
+    // the CPU caches.
+    std::initializer_list<benchmark::internal::Benchmark*> targetingBmCases{
+        REGISTER_BENCHMARK_CAPTURE(BM_FindIntersectingChunk,
+                                   PessimalManyChunks,
+                                   makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(BM_FindIntersectingChunk,
+                                   OptimalManyChunks,
+                                   makeChunkManagerWithOptimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(BM_GetShardIdsForRange,
+                                   PessimalManyChunks,
+                                   makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(BM_GetShardIdsForRange,
+                                   OptimalManyChunks,
+                                   makeChunkManagerWithOptimalBalancedDistribution),
+    };
+
+    for (auto bmCase : targetingBmCases) {
+        bmCase->Args({10, 500000})->Args({100, 500000});
+    }
 }
 
 }  // namespace
@@ -282,6 +282,56 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
         _nss.isOnInternalDb() ? boost::optional<DatabaseVersion>() : _cm->dbVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_cm->isSharded()) {
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    // Extract all the shard keys up front. Documents whose shard key cannot be extracted keep the
+    // same error as targetInsert() would have thrown for them.
+    std::vector<StatusWith<ShardEndpoint>> endpoints(
+        docs.size(),
+        Status(ErrorCodes::ShardKeyNotFound,
+               "Shard key cannot contain array values or array descendants."));
+
+    const auto& shardKeyPattern = _cm->getShardKeyPattern();
+    std::vector<std::pair<BSONObj, size_t>> shardKeys;
+    shardKeys.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        auto shardKey = shardKeyPattern.extractShardKeyFromDoc(docs[i]);
+        if (!shardKey.isEmpty()) {
+            shardKeys.emplace_back(std::move(shardKey), i);
+        }
+    }
+
+    // Resolve the shard keys in ascending order, so that the routing table only needs to be
+    // searched for the first key falling into each chunk. The keys after it are matched against
+    // the bounds of the chunk found for it until one falls beyond them.
+    std::sort(shardKeys.begin(), shardKeys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first.woCompare(rhs.first) < 0;
+    });
+
+    boost::optional<Chunk> chunk;
+    boost::optional<ShardEndpoint> chunkEndpoint;
+    for (const auto& [shardKey, docIndex] : shardKeys) {
+        if (!chunk || !chunk->containsKey(shardKey)) {
+            try {
+                chunk.emplace(_cm->findIntersectingChunkWithSimpleCollation(shardKey));
+            } catch (const DBException& ex) {
+                chunk.reset();
+                endpoints[docIndex] = ex.toStatus();
+                continue;
+            }
+            chunkEndpoint.emplace(
+                chunk->getShardId(), _cm->getVersion(chunk->getShardId()), boost::none);
+        }
+        endpoints[docIndex] = *chunkEndpoint;
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
@@ -185,6 +185,43 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertsWithConstantHashedPrefixAndVarying
     ASSERT_EQUALS(res.shardName, "1");
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsMatchesTargetingEachDocument) {
+    // Create 5 chunks and 5 shards such that shardId '0' has chunk [MinKey, null), '1' has chunk
+    // [null, -100), '2' has chunk [-100, 0), '3' has chunk ['0', 100) and '4' has chunk
+    // [100, MaxKey).
+    std::vector<BSONObj> splitPoints = {
+        BSON("a.b" << BSONNULL), BSON("a.b" << -100), BSON("a.b" << 0), BSON("a.b" << 100)};
+    auto cmTargeter = prepare(BSON("a.b" << 1 << "c.d"
+                                         << "hashed"),
+                              splitPoints);
+
+    // Interleave the documents between the chunks, and mix in ones which cannot be targeted.
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; i++) {
+        docs.push_back(BSON("a" << BSON("b" << ((i * 37) % 400 - 200)) << "c" << BSON("d" << i)));
+    }
+    docs.push_back(BSONObj());
+    docs.push_back(fromjson("{a: [1, 2]}"));
+    docs.push_back(fromjson("{a: {b: 1000}, c: {d: [1, 2]}}"));
+
+    auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(endpoints.size(), docs.size());
+    for (size_t i = 0; i < docs.size(); i++) {
+        try {
+            auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+            auto endpoint = assertGet(endpoints[i]);
+            ASSERT_EQUALS(endpoint.shardName, expected.shardName);
+            ASSERT_EQUALS(*endpoint.shardVersion, *expected.shardVersion);
+        } catch (const DBException& ex) {
+            ASSERT_EQUALS(endpoints[i].getStatus().code(), ex.code());
+        }
+    }
+
+    ASSERT_EQUALS(endpoints[docs.size() - 3].getValue().shardName, "1");
+    ASSERT_EQUALS(endpoints[docs.size() - 2].getStatus(), ErrorCodes::ShardKeyNotFound);
+    ASSERT_EQUALS(endpoints[docs.size() - 1].getStatus(), ErrorCodes::ShardKeyNotFound);
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetUpdateWithRangePrefixHashedShardKey) {
     // Create 5 chunks and 5 shards such that shardId '0' has chunk [MinKey, null), '1' has chunk
     // [null, -100), '2' has chunk [-100, 0), '3' has chunk ['0', 100) and '4' has chunk
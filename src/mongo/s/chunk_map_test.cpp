@@ -165,4 +165,99 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestIntersectingChunkAfterMergingSplitChunks) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    auto newChunkMap = chunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{getShardKeyPattern().globalMin(), BSON("a" << 0)},
+                       version,
+                       kThisShard}),
+
+         std::make_shared<ChunkInfo>(
+             ChunkType{kNss, ChunkRange{BSON("a" << 0), BSON("a" << 100)}, version, kThisShard}),
+
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss,
+             ChunkRange{BSON("a" << 100), getShardKeyPattern().globalMax()},
+             version,
+             kThisShard})});
+
+    ChunkVersion splitVersion{2, 0, epoch, boost::none /* timestamp */};
+    auto splitChunkMap = newChunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(ChunkType{
+             kNss, ChunkRange{BSON("a" << 0), BSON("a" << 50)}, splitVersion, kThisShard}),
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss, ChunkRange{BSON("a" << 50), BSON("a" << 100)}, splitVersion, kThisShard})});
+    ASSERT_EQ(splitChunkMap.size(), 4);
+
+    // A key equal to the max of a chunk belongs to the next chunk.
+    auto intersectingChunk = splitChunkMap.findIntersectingChunk(BSON("a" << 50));
+    ASSERT(intersectingChunk);
+    ASSERT(SimpleBSONObjComparator::kInstance.evaluate(intersectingChunk->getMin() ==
+                                                       BSON("a" << 50)));
+
+    intersectingChunk = splitChunkMap.findIntersectingChunk(BSON("a" << 0));
+    ASSERT(intersectingChunk);
+    ASSERT(SimpleBSONObjComparator::kInstance.evaluate(intersectingChunk->getMax() ==
+                                                       BSON("a" << 50)));
+
+    int count = 0;
+    splitChunkMap.forEachOverlappingChunk(
+        BSON("a" << -50), BSON("a" << 50), false, [&](const auto& chunk) {
+            count++;
+            return true;
+        });
+    ASSERT_EQ(count, 2);
+}
+
+TEST_F(ChunkMapTest, TestMergeIntoLargeChunkMap) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    const int nChunks = 1000;
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    for (int i = 0; i < nChunks; ++i) {
+        auto min = i == 0 ? getShardKeyPattern().globalMin() : BSON("a" << i * 10);
+        auto max = i == nChunks - 1 ? getShardKeyPattern().globalMax() : BSON("a" << (i + 1) * 10);
+        chunks.push_back(std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{min, max}, version, kThisShard}));
+    }
+    auto newChunkMap = chunkMap.createMerged(chunks);
+    ASSERT_EQ(newChunkMap.size(), nChunks);
+
+    // Split one chunk in the middle and merge two chunks further on.
+    ChunkVersion splitVersion{2, 0, epoch, boost::none /* timestamp */};
+    ChunkVersion mergeVersion{2, 1, epoch, boost::none /* timestamp */};
+    auto updatedChunkMap = newChunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(ChunkType{
+             kNss, ChunkRange{BSON("a" << 5000), BSON("a" << 5005)}, splitVersion, kThisShard}),
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss, ChunkRange{BSON("a" << 5005), BSON("a" << 5010)}, splitVersion, kThisShard}),
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss, ChunkRange{BSON("a" << 7000), BSON("a" << 7020)}, mergeVersion, kThisShard})});
+    ASSERT_EQ(updatedChunkMap.size(), nChunks);
+    ASSERT_EQ(updatedChunkMap.getVersion(), mergeVersion);
+
+    auto lastMax = getShardKeyPattern().globalMin();
+    updatedChunkMap.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), lastMax);
+        lastMax = chunkInfo->getMax();
+        return true;
+    });
+    ASSERT_BSONOBJ_EQ(lastMax, getShardKeyPattern().globalMax());
+
+    for (int key : {0, 4999, 5000, 5004, 5005, 5010, 7000, 7015, 7020, 9999}) {
+        auto chunk = updatedChunkMap.findIntersectingChunk(BSON("a" << key));
+        ASSERT(chunk);
+        ASSERT(chunk->containsKey(BSON("a" << key)));
+    }
+    ASSERT_EQ(updatedChunkMap.findIntersectingChunk(BSON("a" << 7015))->getLastmod(),
+              mergeVersion);
+}
+
 }  // namespace mongo
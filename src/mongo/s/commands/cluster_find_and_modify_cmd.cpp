@@ -52,10 +52,12 @@
 #include "mongo/s/commands/strategy.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
+#include "mongo/s/query/cluster_find_result_cache.h"
 #include "mongo/s/session_catalog_router.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/s/transaction_router.h"
 #include "mongo/s/would_change_owning_shard_exception.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -316,6 +318,10 @@ public:
         // Append mongoS' runtime constants to the command object before forwarding it to the shard.
         auto cmdObjForShard = appendLegacyRuntimeConstantsToCommandObject(opCtx, cmdObj);
 
+        // Queries against the namespace which start after this point must not be answered from
+        // find results cached before the write.
+        ON_BLOCK_EXIT([&] { ClusterFindResultCache::get(opCtx)->onWrite(nss); });
+
         const auto cm = uassertStatusOK(getCollectionRoutingInfoForTxnCmd(opCtx, nss));
         if (cm.isSharded()) {
             const BSONObj query = cmdObjForShard.getObjectField("query");
@@ -56,11 +56,13 @@
 #include "mongo/s/commands/document_shard_key_update_util.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
+#include "mongo/s/query/cluster_find_result_cache.h"
 #include "mongo/s/session_catalog_router.h"
 #include "mongo/s/transaction_router.h"
 #include "mongo/s/would_change_owning_shard_exception.h"
 #include "mongo/s/write_ops/batched_command_request.h"
 #include "mongo/s/write_ops/batched_command_response.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -468,6 +470,11 @@ private:
             batchedRequest.unsetWriteConcern();
         }
 
+        // Queries against the namespace which start after this point must not be answered from
+        // find results cached before the write.
+        ON_BLOCK_EXIT(
+            [&] { ClusterFindResultCache::get(opCtx)->onWrite(batchedRequest.getNS()); });
+
         cluster::write(opCtx, batchedRequest, &stats, &response);
 
         bool updatedShardKey = false;
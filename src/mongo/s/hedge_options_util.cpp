@@ -57,8 +57,8 @@ boost::optional<executor::RemoteCommandRequestOnAny::HedgeOptions> extractHedgeO
     auto cmdName(cmdObj.firstElement().fieldNameStringData().toString());
 
     if (supportedCmds.count(cmdName)) {
-        return executor::RemoteCommandRequestOnAny::HedgeOptions{1,
-                                                                 gMaxTimeMSForHedgedReads.load()};
+        return executor::RemoteCommandRequestOnAny::HedgeOptions{
+            1, gMaxTimeMSForHedgedReads.load(), gHedgedReadsWaitForSlowResponse.load()};
     }
     return boost::none;
 }
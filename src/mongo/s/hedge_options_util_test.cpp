@@ -93,10 +93,13 @@ protected:
     static inline const std::string kReadHedgingModeFieldName = "readHedgingMode";
     static inline const std::string kMaxTimeMSForHedgedReadsFieldName = "maxTimeMSForHedgedReads";
     static inline const int kMaxTimeMSForHedgedReadsDefault = 10;
+    static inline const std::string kHedgedReadsWaitForSlowResponseFieldName =
+        "hedgedReadsWaitForSlowResponse";
 
     static inline const BSONObj kDefaultParameters =
         BSON(kReadHedgingModeFieldName << "on" << kMaxTimeMSForHedgedReadsFieldName
-                                       << kMaxTimeMSForHedgedReadsDefault);
+                                       << kMaxTimeMSForHedgedReadsDefault
+                                       << kHedgedReadsWaitForSlowResponseFieldName << false);
 
 private:
     ServiceContext::UniqueServiceContext _serviceCtx = ServiceContext::make();
@@ -191,5 +194,21 @@ TEST_F(HedgeOptionsUtilTestFixture, MaxTimeMSForHedgedReads) {
     checkHedgeOptions(parameters, cmdObj, rspObj, true, 100);
 }
 
+TEST_F(HedgeOptionsUtilTestFixture, HedgedReadsWaitForSlowResponse) {
+    const auto cmdObj = BSON("find" << kCollName);
+    const auto rspObj = BSON("mode"
+                             << "nearest");
+    const auto readPref = uassertStatusOK(ReadPreferenceSetting::fromInnerBSON(rspObj));
+
+    auto hedgeOptions = extractHedgeOptions(cmdObj, readPref);
+    ASSERT_TRUE(hedgeOptions.has_value());
+    ASSERT_FALSE(hedgeOptions->delayUntilSlow);
+
+    setParameters(BSON(kHedgedReadsWaitForSlowResponseFieldName << true));
+    hedgeOptions = extractHedgeOptions(cmdObj, readPref);
+    ASSERT_TRUE(hedgeOptions.has_value());
+    ASSERT_TRUE(hedgeOptions->delayUntilSlow);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -88,6 +88,7 @@
 #include "mongo/s/query/cluster_cursor_cleanup_job.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
 #include "mongo/s/read_write_concern_defaults_cache_lookup_mongos.h"
+#include "mongo/s/routing_table_change_listener.h"
 #include "mongo/s/service_entry_point_mongos.h"
 #include "mongo/s/session_catalog_router.h"
 #include "mongo/s/sessions_collection_sharded.h"
@@ -148,6 +149,7 @@ const ntservice::NtServiceDefaultStrings defaultServiceStrings = {
 constexpr auto kSignKeysRetryInterval = Seconds{1};
 
 boost::optional<ShardingUptimeReporter> shardingUptimeReporter;
+boost::optional<RoutingTableChangeListener> routingTableChangeListener;
 
 Status waitForSigningKeys(OperationContext* opCtx) {
     auto const shardRegistry = Grid::get(opCtx)->shardRegistry();
@@ -752,6 +754,11 @@ ExitCode runMongosServer(ServiceContext* serviceContext) {
     shardingUptimeReporter.emplace();
     shardingUptimeReporter->startPeriodicThread();
 
+    if (gRoutingTableChangeListenerEnabled) {
+        routingTableChangeListener.emplace();
+        routingTableChangeListener->startThread();
+    }
+
     clusterCursorCleanupJob.go();
 
     UserCacheInvalidator::start(serviceContext, opCtx);
@@ -76,6 +76,25 @@ public:
      */
     virtual ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const = 0;
 
+    /**
+     * Returns the ShardEndpoint for each document in 'docs', in the same order, as targetInsert()
+     * would. Instead of throwing, the entry for a document which cannot be targeted holds the
+     * error. Implementations may override this to target all the documents in one pass.
+     */
+    virtual std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+        std::vector<StatusWith<ShardEndpoint>> endpoints;
+        endpoints.reserve(docs.size());
+        for (const auto& doc : docs) {
+            try {
+                endpoints.emplace_back(targetInsert(opCtx, doc));
+            } catch (const DBException& ex) {
+                endpoints.emplace_back(ex.toStatus());
+            }
+        }
+        return endpoints;
+    }
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update or throws
      * ShardKeyNotFound if 'updateOp' misses a shard key, but the type of update requires it.
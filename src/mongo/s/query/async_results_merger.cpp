@@ -41,6 +41,7 @@
 #include "mongo/db/query/getmore_command_gen.h"
 #include "mongo/db/query/kill_cursors_gen.h"
 #include "mongo/db/query/query_feature_flags_gen.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/s/catalog/type_shard.h"
@@ -95,6 +96,37 @@ int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPa
     return leftSortKey.woCompare(rightSortKey, sortKeyPattern, rules);
 }
 
+/**
+ * Returns the ordering with which sort keys for 'sort' are encoded as KeyString, or boost::none if
+ * the sort pattern cannot be represented as an Ordering.
+ */
+boost::optional<Ordering> makeSortKeyOrdering(const boost::optional<BSONObj>& sort) {
+    if (!sort || static_cast<size_t>(sort->nFields()) > Ordering::kMaxCompoundIndexKeys) {
+        return boost::none;
+    }
+    return Ordering::make(*sort);
+}
+
+/**
+ * Returns the KeyString encoding of 'sortKey' under 'ordering', or an empty string if the encoding
+ * would not order 'sortKey' the same way as compareSortKeys(). KeyString orders scalars exactly as
+ * the BSON comparison does but, unlike it, takes field names into account when comparing nested
+ * objects, so only sort keys made up entirely of scalars are encoded.
+ */
+std::string encodeSortKey(const BSONObj& sortKey, const boost::optional<Ordering>& ordering) {
+    if (!ordering) {
+        return {};
+    }
+    for (auto&& elem : sortKey) {
+        if (elem.type() == BSONType::Object || elem.type() == BSONType::Array) {
+            return {};
+        }
+    }
+
+    KeyString::Builder builder(KeyString::Version::V1, sortKey, *ordering);
+    return std::string(builder.getBuffer(), builder.getSize());
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
@@ -107,6 +139,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
+      _sortKeyOrdering(makeSortKeyOrdering(_params.getSort())),
       _mergeQueue(MergingComparator(
           _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
@@ -379,6 +412,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    _remotes[smallestRemote].encodedSortKeyBuffer.pop();
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
@@ -736,6 +770,8 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<std::string> emptySortKeyBuffer;
+        std::swap(remote.encodedSortKeyBuffer, emptySortKeyBuffer);
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -808,6 +844,8 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                          << "' was not of type Object in document: " << obj);
                 return false;
             }
+            remote.encodedSortKeyBuffer.push(encodeSortKey(
+                extractSortKey(obj, _params.getCompareWholeSortKey()), _sortKeyOrdering));
         }
 
         ClusterQueryResult result(obj);
@@ -925,6 +963,14 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 //
 
 bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
+    // Compare the pre-computed encodings where both are available, since this avoids walking the
+    // BSON of each sort key for every operation on the merge queue.
+    const auto& leftKey = _remotes[lhs].encodedSortKeyBuffer.front();
+    const auto& rightKey = _remotes[rhs].encodedSortKeyBuffer.front();
+    if (!leftKey.empty() && !rightKey.empty()) {
+        return leftKey.compare(rightKey) > 0;
+    }
+
     const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
     const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
 
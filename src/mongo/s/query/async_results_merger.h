@@ -35,6 +35,7 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
@@ -306,6 +307,13 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // Only populated for sorted merges, in which case it holds one entry per document in
+        // 'docBuffer'. Each entry is the KeyString encoding of the document's sort key, computed
+        // once when the batch arrives so that the merge queue can order remotes with a byte-wise
+        // comparison. An empty entry means the sort key could not be encoded in a way which
+        // preserves the $sortKey comparison semantics, and must be compared as BSON instead.
+        std::queue<std::string> encodedSortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -493,6 +501,11 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
+    // The ordering used to build the KeyString encoded sort keys in each remote's
+    // 'encodedSortKeyBuffer'. Not set if there is no sort, or if the sort pattern has more fields
+    // than an Ordering can represent, in which case sort keys are always compared as BSON.
+    const boost::optional<Ordering> _sortKeyOrdering;
+
     // The top of this priority queue is the index into '_remotes' for the remote host that has the
     // next document to return, according to the sort order. Used only if there is a sort.
     std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
@@ -440,6 +440,59 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortKeysOfMixedTypesAreMergedInBSONOrder) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[2], kTestShardHosts[2], CursorResponse(kTestNss, 7, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    // Mix numeric types, strings and nested objects, so that remotes whose sort keys can be
+    // compared through their encoded form are merged with those which must be compared as BSON.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [{y: 1}, 1]}"),
+                                   fromjson("{$sortKey: ['b', 1]}"),
+                                   fromjson("{$sortKey: [5, {x: 1}]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: ['a', 2]}"),
+                                   fromjson("{$sortKey: [5.5, 1]}"),
+                                   fromjson("{$sortKey: [{$numberLong: '5'}, 3]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: [{x: 2}, 0]}"),
+                                   fromjson("{$sortKey: [{$numberDecimal: '5.0'}, 2]}"),
+                                   fromjson("{$sortKey: [4, 1]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    // Nested objects sort after strings, which sort after numbers. Numbers of different types
+    // compare by value, and nested objects are compared without regard to their field names.
+    std::vector<BSONObj> expected = {fromjson("{$sortKey: [{x: 2}, 0]}"),
+                                     fromjson("{$sortKey: [{y: 1}, 1]}"),
+                                     fromjson("{$sortKey: ['b', 1]}"),
+                                     fromjson("{$sortKey: ['a', 2]}"),
+                                     fromjson("{$sortKey: [5.5, 1]}"),
+                                     fromjson("{$sortKey: [{$numberDecimal: '5.0'}, 2]}"),
+                                     fromjson("{$sortKey: [{$numberLong: '5'}, 3]}"),
+                                     fromjson("{$sortKey: [5, {x: 1}]}"),
+                                     fromjson("{$sortKey: [4, 1]}")};
+    for (const auto& expectedObj : expected) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(expectedObj, *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source_project.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/query/sharded_agg_test_fixture.h"
 #include "mongo/unittest/unittest.h"
@@ -609,5 +610,76 @@ TEST_F(ClusterExchangeTest, CompoundShardKeyThreeShards) {
     future.default_timed_get();
 }
 
+
+TEST_F(ClusterExchangeTest, MergingGroupIsNotEligibleForGroupExchangeByDefault) {
+    setupNShards(2);
+    const std::set<ShardId> shardIds{ShardId("0"), ShardId("1")};
+    auto mergePipe = Pipeline::create(
+        {parseStage("{$group: {_id: '$x', $doingMerge: true, count: {$sum: '$count'}}}")},
+        expCtx());
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), shardIds));
+}
+
+TEST_F(ClusterExchangeTest, MergingGroupIsEligibleForGroupExchange) {
+    RAIIServerParameterControllerForTest controller("internalQueryEnableGroupExchange", true);
+    setupNShards(3);
+    const std::set<ShardId> shardIds{ShardId("0"), ShardId("1"), ShardId("2")};
+    auto mergePipe = Pipeline::create(
+        {parseStage("{$group: {_id: '$x', $doingMerge: true, count: {$sum: '$count'}}}"),
+         parseStage("{$match: {count: {$gt: 1}}}"),
+         parseStage("{$project: {count: 1}}")},
+        expCtx());
+
+    auto exchangeSpec = sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), shardIds);
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumers(), 3);
+    ASSERT_EQ(exchangeSpec->consumerShards.size(), 3UL);
+
+    // The hashed key space is split into one range per shard.
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    ASSERT_EQ(boundaries.size(), 4UL);
+    ASSERT_BSONOBJ_EQ(boundaries[0], BSON("_id" << MINKEY));
+    ASSERT_LT(boundaries[1]["_id"].numberLong(), boundaries[2]["_id"].numberLong());
+    ASSERT_BSONOBJ_EQ(boundaries[3], BSON("_id" << MAXKEY));
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumerIds()->size(), 3UL);
+}
+
+TEST_F(ClusterExchangeTest, GroupExchangeRequiresEveryLaterStageToBePerDocument) {
+    RAIIServerParameterControllerForTest controller("internalQueryEnableGroupExchange", true);
+    setupNShards(2);
+    const std::set<ShardId> shardIds{ShardId("0"), ShardId("1")};
+
+    // A $sort or $limit after the $group needs to see the groups of every partition.
+    auto mergePipe =
+        Pipeline::create({parseStage("{$group: {_id: '$x', $doingMerge: true}}"),
+                          parseStage("{$sort: {_id: 1}}")},
+                         expCtx());
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), shardIds));
+
+    mergePipe = Pipeline::create({parseStage("{$group: {_id: '$x', $doingMerge: true}}"),
+                                  DocumentSourceLimit::create(expCtx(), 1)},
+                                 expCtx());
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), shardIds));
+
+    // The pipeline must begin with the merging half of a $group.
+    mergePipe = Pipeline::create({parseStage("{$match: {a: 1}}")}, expCtx());
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), shardIds));
+
+    // A single shard has nothing to exchange with.
+    mergePipe =
+        Pipeline::create({parseStage("{$group: {_id: '$x', $doingMerge: true}}")}, expCtx());
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), {ShardId("0")}));
+}
+
 }  // namespace
 }  // namespace mongo
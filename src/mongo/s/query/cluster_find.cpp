@@ -64,6 +64,8 @@
 #include "mongo/s/query/async_results_merger.h"
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
+#include "mongo/s/query/cluster_find_result_cache.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/establish_cursors.h"
 #include "mongo/s/query/store_possible_cursor.h"
 #include "mongo/s/stale_exception.h"
@@ -535,9 +537,38 @@ CursorId ClusterFind::runQuery(OperationContext* opCtx,
 
         const auto cm = uassertStatusOK(std::move(swCM));
 
+        auto resultCache = ClusterFindResultCache::get(opCtx);
+        const auto resultCacheKey = resultCache->makeKey(opCtx, query, readPref, cm);
+        if (resultCacheKey) {
+            const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+            const auto maxStaleness =
+                Milliseconds(internalQueryFindResultCacheMaxStalenessMS.load());
+            if (auto cachedResults = resultCache->lookup(*resultCacheKey, now, maxStaleness)) {
+                *results = std::move(*cachedResults);
+                CurOp::get(opCtx)->debug().nShards = 0;
+                CurOp::get(opCtx)->debug().nreturned = results->size();
+                CurOp::get(opCtx)->debug().cursorExhausted = true;
+                return CursorId(0);
+            }
+        }
+
         try {
-            return runQueryWithoutRetrying(
-                opCtx, query, readPref, cm, results, partialResultsReturned);
+            bool partialResults = false;
+            const auto cursorId =
+                runQueryWithoutRetrying(opCtx, query, readPref, cm, results, &partialResults);
+            if (partialResultsReturned) {
+                *partialResultsReturned = partialResults;
+            }
+
+            // Only results which were returned in their entirety can be served from the cache.
+            if (resultCacheKey && cursorId == CursorId(0) && !partialResults) {
+                resultCache->insert(*resultCacheKey,
+                                    *results,
+                                    opCtx->getServiceContext()->getFastClockSource()->now(),
+                                    internalQueryFindResultCacheMaxSizeBytes.load());
+            }
+
+            return cursorId;
         } catch (ExceptionFor<ErrorCodes::StaleDbVersion>& ex) {
             if (retries >= kMaxRetries) {
                 // Check if there are no retries remaining, so the last received error can be
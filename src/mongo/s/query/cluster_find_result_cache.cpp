@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_find_result_cache.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/client/read_preference.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context.h"
+#include "mongo/s/chunk_manager.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
+#include "mongo/s/transaction_router.h"
+
+namespace mongo {
+namespace {
+
+const auto getClusterFindResultCache =
+    ServiceContext::declareDecoration<ClusterFindResultCache>();
+
+/**
+ * Returns true if the read concern of the operation allows it to observe results which other
+ * mongos may already consider stale.
+ */
+bool readConcernAllowsCachedResults(const repl::ReadConcernArgs& readConcernArgs) {
+    const auto level = readConcernArgs.getLevel();
+    if (level != repl::ReadConcernLevel::kLocalReadConcern &&
+        level != repl::ReadConcernLevel::kAvailableReadConcern) {
+        return false;
+    }
+
+    // Causally consistent reads must observe the writes they are ordered after.
+    return !readConcernArgs.getArgsAfterClusterTime() &&
+        !readConcernArgs.getArgsAtClusterTime() && !readConcernArgs.getArgsOpTime();
+}
+
+}  // namespace
+
+ClusterFindResultCache::ClusterFindResultCache()
+    : _entries(std::numeric_limits<std::size_t>::max()) {}
+
+ClusterFindResultCache* ClusterFindResultCache::get(ServiceContext* serviceContext) {
+    return &getClusterFindResultCache(serviceContext);
+}
+
+ClusterFindResultCache* ClusterFindResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+boost::optional<std::string> ClusterFindResultCache::makeKey(OperationContext* opCtx,
+                                                             const CanonicalQuery& query,
+                                                             const ReadPreferenceSetting& readPref,
+                                                             const ChunkManager& cm) const {
+    if (internalQueryFindResultCacheMaxStalenessMS.load() <= 0) {
+        return boost::none;
+    }
+
+    if (TransactionRouter::get(opCtx) ||
+        !readConcernAllowsCachedResults(repl::ReadConcernArgs::get(opCtx))) {
+        return boost::none;
+    }
+
+    const auto& findCommand = query.getFindCommandRequest();
+    if (findCommand.getTailable() || findCommand.getAllowPartialResults()) {
+        return boost::none;
+    }
+
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("find", findCommand.toBSON(BSONObj()));
+    keyBuilder.append("readPreference", readPref.toInnerBSON());
+    keyBuilder.append("dbVersion", cm.dbVersion().toBSON());
+    if (cm.isSharded()) {
+        cm.getVersion().appendWithField(&keyBuilder, "shardVersion");
+    }
+    keyBuilder.append("writeGeneration",
+                      static_cast<long long>(getWriteGeneration(query.nss())));
+
+    const auto key = keyBuilder.done();
+    return std::string(key.objdata(), key.objsize());
+}
+
+boost::optional<std::vector<BSONObj>> ClusterFindResultCache::lookup(const std::string& key,
+                                                                     Date_t now,
+                                                                     Milliseconds maxStaleness) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return boost::none;
+    }
+
+    if (now - it->second.cachedAt >= maxStaleness) {
+        _erase(lk, it);
+        return boost::none;
+    }
+
+    return _entries.promote(it)->second.results;
+}
+
+void ClusterFindResultCache::insert(const std::string& key,
+                                    std::vector<BSONObj> results,
+                                    Date_t now,
+                                    long long maxSizeBytes) {
+    long long entrySizeBytes = key.size();
+    for (auto& result : results) {
+        result = result.getOwned();
+        entrySizeBytes += result.objsize();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        _erase(lk, it);
+    }
+
+    if (entrySizeBytes > maxSizeBytes) {
+        return;
+    }
+
+    while (!_entries.empty() && _sizeBytes + entrySizeBytes > maxSizeBytes) {
+        _erase(lk, std::prev(_entries.end()));
+    }
+
+    _entries.add(key, Entry{std::move(results), entrySizeBytes, now});
+    _sizeBytes += entrySizeBytes;
+}
+
+void ClusterFindResultCache::onWrite(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    ++_writeGenerations[nss.ns()];
+}
+
+uint64_t ClusterFindResultCache::getWriteGeneration(const NamespaceString& nss) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _writeGenerations.find(nss.ns());
+    return it == _writeGenerations.end() ? 0 : it->second;
+}
+
+size_t ClusterFindResultCache::numEntries() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+long long ClusterFindResultCache::sizeBytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sizeBytes;
+}
+
+void ClusterFindResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _sizeBytes = 0;
+}
+
+void ClusterFindResultCache::_erase(WithLock, LRUCache<std::string, Entry>::iterator it) {
+    _sizeBytes -= it->second.sizeBytes;
+    _entries.erase(it);
+}
+
+}  // namespace mongo
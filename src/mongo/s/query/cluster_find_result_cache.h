@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class CanonicalQuery;
+class ChunkManager;
+class OperationContext;
+struct ReadPreferenceSetting;
+class ServiceContext;
+
+/**
+ * Caches the results of find commands which mongos returned in a single batch, so that identical
+ * queries against read-mostly collections can be answered without contacting the shards again.
+ *
+ * The cache is disabled unless 'internalQueryFindResultCacheMaxStalenessMS' is set. Entries are
+ * keyed by the find command, the read preference and the routing information the query was
+ * targeted with, so that chunk migrations and movePrimary naturally stop hitting older entries. A
+ * write routed through this mongos to a namespace stops hitting the entries for that namespace.
+ * Writes routed through other mongos are only reflected once the entries they affect expire,
+ * which is why only queries with readConcern level "local" or "available" may be cached.
+ */
+class ClusterFindResultCache {
+    ClusterFindResultCache(const ClusterFindResultCache&) = delete;
+    ClusterFindResultCache& operator=(const ClusterFindResultCache&) = delete;
+
+public:
+    ClusterFindResultCache();
+
+    static ClusterFindResultCache* get(ServiceContext* serviceContext);
+    static ClusterFindResultCache* get(OperationContext* opCtx);
+
+    /**
+     * Returns the key under which the results of 'query' can be cached when it is targeted using
+     * the routing information in 'cm', or boost::none if they must not be cached.
+     */
+    boost::optional<std::string> makeKey(OperationContext* opCtx,
+                                         const CanonicalQuery& query,
+                                         const ReadPreferenceSetting& readPref,
+                                         const ChunkManager& cm) const;
+
+    /**
+     * Returns the results cached under 'key', provided they were cached less than 'maxStaleness'
+     * before 'now'.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const std::string& key,
+                                                 Date_t now,
+                                                 Milliseconds maxStaleness);
+
+    /**
+     * Caches 'results' under 'key', evicting the least recently used entries until the cache
+     * takes up no more than 'maxSizeBytes'. Results larger than 'maxSizeBytes' are not cached.
+     */
+    void insert(const std::string& key,
+                std::vector<BSONObj> results,
+                Date_t now,
+                long long maxSizeBytes);
+
+    /**
+     * Notifies the cache that a write to 'nss' was routed through this mongos, so that keys
+     * generated afterwards for queries against 'nss' differ from the ones generated before.
+     */
+    void onWrite(const NamespaceString& nss);
+
+    /**
+     * Returns the number of writes to 'nss' that this cache has been notified of.
+     */
+    uint64_t getWriteGeneration(const NamespaceString& nss) const;
+
+    size_t numEntries() const;
+    long long sizeBytes() const;
+
+    void clear();
+
+private:
+    struct Entry {
+        std::vector<BSONObj> results;
+        long long sizeBytes;
+        Date_t cachedAt;
+    };
+
+    void _erase(WithLock, LRUCache<std::string, Entry>::iterator it);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterFindResultCache::_mutex");
+
+    // The size is only bounded by '_sizeBytes', which is checked on every insert.
+    LRUCache<std::string, Entry> _entries;
+    long long _sizeBytes{0};
+
+    StringMap<uint64_t> _writeGenerations;
+};
+
+}  // namespace mongo
@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_find_result_cache.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const Date_t kNow = Date_t::fromMillisSinceEpoch(1000000);
+const Milliseconds kMaxStaleness{100};
+const long long kMaxSizeBytes = 1024 * 1024;
+
+std::vector<BSONObj> makeResults(int numResults) {
+    std::vector<BSONObj> results;
+    for (int i = 0; i < numResults; ++i) {
+        results.push_back(BSON("_id" << i));
+    }
+    return results;
+}
+
+void assertResultsEqual(const std::vector<BSONObj>& expected,
+                        const std::vector<BSONObj>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(expected[i], actual[i]);
+    }
+}
+
+TEST(ClusterFindResultCacheTest, LookupReturnsCachedResults) {
+    ClusterFindResultCache cache;
+    ASSERT_FALSE(cache.lookup("key", kNow, kMaxStaleness));
+
+    cache.insert("key", makeResults(3), kNow, kMaxSizeBytes);
+    ASSERT_EQ(1U, cache.numEntries());
+
+    auto results = cache.lookup("key", kNow + Milliseconds(10), kMaxStaleness);
+    ASSERT(results);
+    assertResultsEqual(makeResults(3), *results);
+
+    ASSERT_FALSE(cache.lookup("otherKey", kNow, kMaxStaleness));
+}
+
+TEST(ClusterFindResultCacheTest, LookupDropsExpiredResults) {
+    ClusterFindResultCache cache;
+    cache.insert("key", makeResults(3), kNow, kMaxSizeBytes);
+
+    ASSERT_FALSE(cache.lookup("key", kNow + kMaxStaleness, kMaxStaleness));
+    ASSERT_EQ(0U, cache.numEntries());
+    ASSERT_EQ(0, cache.sizeBytes());
+}
+
+TEST(ClusterFindResultCacheTest, InsertReplacesExistingEntry) {
+    ClusterFindResultCache cache;
+    cache.insert("key", makeResults(3), kNow, kMaxSizeBytes);
+    const auto sizeBytes = cache.sizeBytes();
+
+    cache.insert("key", makeResults(1), kNow, kMaxSizeBytes);
+    ASSERT_EQ(1U, cache.numEntries());
+    ASSERT_LT(cache.sizeBytes(), sizeBytes);
+
+    auto results = cache.lookup("key", kNow, kMaxStaleness);
+    ASSERT(results);
+    assertResultsEqual(makeResults(1), *results);
+}
+
+TEST(ClusterFindResultCacheTest, InsertEvictsLeastRecentlyUsedEntries) {
+    ClusterFindResultCache cache;
+    cache.insert("a", makeResults(10), kNow, kMaxSizeBytes);
+    const auto entrySizeBytes = cache.sizeBytes();
+    const auto maxSizeBytes = 2 * entrySizeBytes + entrySizeBytes / 2;
+
+    cache.insert("b", makeResults(10), kNow, maxSizeBytes);
+    ASSERT(cache.lookup("a", kNow, kMaxStaleness));
+
+    // Entry "b" is now the least recently used one, so it makes room for entry "c".
+    cache.insert("c", makeResults(10), kNow, maxSizeBytes);
+    ASSERT_EQ(2U, cache.numEntries());
+    ASSERT_LTE(cache.sizeBytes(), maxSizeBytes);
+    ASSERT(cache.lookup("a", kNow, kMaxStaleness));
+    ASSERT_FALSE(cache.lookup("b", kNow, kMaxStaleness));
+    ASSERT(cache.lookup("c", kNow, kMaxStaleness));
+}
+
+TEST(ClusterFindResultCacheTest, ResultsLargerThanTheCacheAreNotCached) {
+    ClusterFindResultCache cache;
+    cache.insert("small", makeResults(1), kNow, kMaxSizeBytes);
+
+    cache.insert("large", makeResults(1000), kNow, 1024);
+    ASSERT_FALSE(cache.lookup("large", kNow, kMaxStaleness));
+    ASSERT(cache.lookup("small", kNow, kMaxStaleness));
+}
+
+TEST(ClusterFindResultCacheTest, WritesAdvanceTheWriteGenerationOfTheirNamespace) {
+    ClusterFindResultCache cache;
+    const NamespaceString nss("test.coll");
+    const NamespaceString otherNss("test.otherColl");
+    ASSERT_EQ(0U, cache.getWriteGeneration(nss));
+
+    cache.onWrite(nss);
+    cache.onWrite(nss);
+    ASSERT_EQ(2U, cache.getWriteGeneration(nss));
+    ASSERT_EQ(0U, cache.getWriteGeneration(otherNss));
+}
+
+TEST(ClusterFindResultCacheTest, ClearDropsAllEntries) {
+    ClusterFindResultCache cache;
+    cache.insert("a", makeResults(1), kNow, kMaxSizeBytes);
+    cache.insert("b", makeResults(1), kNow, kMaxSizeBytes);
+
+    cache.clear();
+    ASSERT_EQ(0U, cache.numEntries());
+    ASSERT_EQ(0, cache.sizeBytes());
+    ASSERT_FALSE(cache.lookup("a", kNow, kMaxStaleness));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,222 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kShardingCatalogRefresh
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/routing_table_change_listener.h"
+
+#include <map>
+
+#include "mongo/db/client.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/catalog/type_collection.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/grid.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
+
+namespace mongo {
+namespace {
+
+const Seconds kRetryInterval(1);
+
+/**
+ * Returns the change stream pipeline, which only keeps the fields of each committed chunk needed to
+ * know which collection it belongs to and its version.
+ */
+std::vector<BSONObj> makePipeline(const boost::optional<BSONObj>& resumeToken) {
+    BSONObjBuilder changeStreamSpec;
+    changeStreamSpec.append("allowToRunOnConfigDB", true);
+    changeStreamSpec.append("fullDocument", "updateLookup");
+    if (resumeToken) {
+        changeStreamSpec.append("resumeAfter", *resumeToken);
+    }
+
+    BSONObjBuilder projection;
+    for (const auto& field : {ChunkType::ns.name(),
+                              ChunkType::collectionUUID.name(),
+                              ChunkType::lastmod.name(),
+                              ChunkType::lastmod.name() + "Epoch",
+                              ChunkType::lastmod.name() + "Timestamp"}) {
+        projection.append("fullDocument." + field, 1);
+    }
+
+    return {BSON("$changeStream" << changeStreamSpec.obj()),
+            BSON("$match" << BSON("operationType"
+                                  << BSON("$in" << BSON_ARRAY("insert"
+                                                              << "update"
+                                                              << "replace")))),
+            BSON("$project" << projection.obj())};
+}
+
+}  // namespace
+
+RoutingTableChangeListener::RoutingTableChangeListener() = default;
+
+RoutingTableChangeListener::~RoutingTableChangeListener() {
+    // The thread must not be running when this object is destroyed
+    invariant(!_thread.joinable());
+}
+
+void RoutingTableChangeListener::startThread() {
+    invariant(!_thread.joinable());
+
+    _thread = stdx::thread([this] {
+        Client::initThread("RoutingTableChangeListener");
+
+        while (!globalInShutdownDeprecated()) {
+            Status status = [&] {
+                try {
+                    auto opCtx = cc().makeOperationContext();
+                    return _listen(opCtx.get());
+                } catch (const DBException& ex) {
+                    return ex.toStatus();
+                }
+            }();
+            if (globalInShutdownDeprecated()) {
+                break;
+            }
+
+            // Without the events since the last one processed, the routing tables they changed are
+            // left to be found stale through StaleConfig, as they were before this listener.
+            if (ErrorCodes::isNonResumableChangeStreamError(status.code()) ||
+                status == ErrorCodes::InvalidResumeToken) {
+                _resumeToken.reset();
+            }
+            LOGV2_WARNING(6114400,
+                          "The routing table change stream stopped and will be reopened",
+                          "error"_attr = redact(status),
+                          "resuming"_attr = static_cast<bool>(_resumeToken));
+
+            MONGO_IDLE_THREAD_BLOCK;
+            sleepFor(kRetryInterval);
+        }
+    });
+}
+
+Status RoutingTableChangeListener::_listen(OperationContext* opCtx) {
+    AggregateCommandRequest aggRequest(ChunkType::ConfigNS, makePipeline(_resumeToken));
+
+    // Change streams never exhaust their cursor, so this only returns once the stream fails or the
+    // callback stops it.
+    const auto configShard = Grid::get(opCtx)->shardRegistry()->getConfigShard();
+    return configShard->runAggregation(
+        opCtx, aggRequest, [this](const std::vector<BSONObj>& batch) {
+            _processBatch(batch);
+            return !globalInShutdownDeprecated();
+        });
+}
+
+void RoutingTableChangeListener::_processBatch(const std::vector<BSONObj>& batch) {
+    if (batch.empty()) {
+        return;
+    }
+
+    // A balancer round commits many chunks of the same collections, and only the version of the
+    // last one committed matters for each.
+    std::map<NamespaceString, ChunkVersion> versions;
+    stdx::unordered_map<UUID, Timestamp, UUID::Hash> lastmodsByUUID;
+    for (const auto& event : batch) {
+        const auto chunk = event["fullDocument"];
+        if (chunk.type() != Object) {
+            continue;
+        }
+        const auto chunkObj = chunk.Obj();
+
+        // Chunks of collections sharded before 5.0 name their collection and carry its epoch,
+        // while the others only have its UUID.
+        if (const auto ns = chunkObj[ChunkType::ns.name()]; ns.type() == String) {
+            auto swVersion =
+                ChunkVersion::parseLegacyWithField(chunkObj, ChunkType::lastmod.name());
+            if (swVersion.isOK()) {
+                versions[NamespaceString(ns.valueStringData())] = swVersion.getValue();
+            }
+        } else if (const auto lastmod = chunkObj[ChunkType::lastmod.name()];
+                   lastmod.type() == bsonTimestamp) {
+            auto swUUID = UUID::parse(chunkObj[ChunkType::collectionUUID.name()]);
+            if (swUUID.isOK()) {
+                lastmodsByUUID[swUUID.getValue()] = lastmod.timestamp();
+            }
+        }
+    }
+
+    // Fetcher callbacks run on the executor's threads, which have no Client of their own.
+    ThreadClient tc("RoutingTableChangeListener-process", getGlobalServiceContext());
+    if (!lastmodsByUUID.empty()) {
+        auto opCtx = tc->makeOperationContext();
+        const auto configShard = Grid::get(opCtx.get())->shardRegistry()->getConfigShard();
+        for (const auto& [uuid, lastmod] : lastmodsByUUID) {
+            try {
+                auto response = uassertStatusOK(configShard->exhaustiveFindOnConfig(
+                    opCtx.get(),
+                    ReadPreferenceSetting{ReadPreference::Nearest},
+                    repl::ReadConcernLevel::kMajorityReadConcern,
+                    CollectionType::ConfigNS,
+                    BSON(CollectionType::kUuidFieldName << uuid),
+                    BSONObj(),
+                    1));
+                if (response.docs.empty()) {
+                    // The collection has been dropped since.
+                    continue;
+                }
+                const CollectionType coll(response.docs.front());
+                versions[coll.getNss()] = ChunkVersion(
+                    lastmod.getSecs(), lastmod.getInc(), coll.getEpoch(), coll.getTimestamp());
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(6114401,
+                            1,
+                            "Failed to look up the collection of a changed chunk",
+                            "collectionUUID"_attr = uuid,
+                            "error"_attr = redact(ex));
+            }
+        }
+    }
+
+    auto catalogCache = Grid::get(tc.get()->getServiceContext())->catalogCache();
+    for (const auto& [nss, version] : versions) {
+        if (catalogCache->onRoutingTableChangeNotification(nss, version)) {
+            LOGV2_DEBUG(6114402,
+                        1,
+                        "Refreshing a routing table after one of its chunks changed",
+                        "namespace"_attr = nss,
+                        "version"_attr = version);
+        }
+    }
+
+    // Only advanced once the batch is processed, so that a stream reopened after a failure
+    // replays whatever was not.
+    _resumeToken = batch.back()["_id"].Obj().getOwned();
+}
+
+}  // namespace mongo
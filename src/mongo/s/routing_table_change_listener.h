@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Follows a change stream on the config server's config.chunks collection and tells the catalog
+ * cache of every chunk committed by a migration, split or merge, so that the routing tables which
+ * this router caches are refreshed in the background as soon as they change, rather than after a
+ * request has failed with StaleConfig. Routing correctness does not depend on it: whatever it
+ * misses, for example while the config server cannot be reached, is still found through
+ * StaleConfig errors.
+ *
+ * NOTE: Not thread-safe, so it should not be used from more than one thread at a time.
+ */
+class RoutingTableChangeListener {
+    RoutingTableChangeListener(const RoutingTableChangeListener&) = delete;
+    RoutingTableChangeListener& operator=(const RoutingTableChangeListener&) = delete;
+
+public:
+    RoutingTableChangeListener();
+    ~RoutingTableChangeListener();
+
+    /**
+     * Starts the thread which follows the change stream until shutdown.
+     */
+    void startThread();
+
+private:
+    /**
+     * Follows the change stream from '_resumeToken', or from now if there is none, until it fails
+     * or the server shuts down.
+     */
+    Status _listen(OperationContext* opCtx);
+
+    /**
+     * Notifies the catalog cache of the latest chunk version of each collection in 'batch'.
+     */
+    void _processBatch(const std::vector<BSONObj>& batch);
+
+    // The background listener thread (if started)
+    stdx::thread _thread;
+
+    // The resume token of the last event processed, from which the change stream is reopened
+    boost::optional<BSONObj> _resumeToken;
+};
+
+}  // namespace mongo
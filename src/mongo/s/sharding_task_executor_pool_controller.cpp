@@ -223,8 +223,12 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     const size_t minConns = gParameters.minConnections.load();
     const size_t maxConns = gParameters.maxConnections.load();
 
-    // Update the target for just the pool first
-    poolData.target = stats.requests + stats.active;
+    // Update the target for just the pool first. Requests up to the configured slack wait for an
+    // in-use connection to be returned, if there is one, rather than each opening a new one.
+    const size_t queueSlack =
+        stats.active ? static_cast<size_t>(gParameters.queuedRequestsBeforeGrowing.load()) : 0;
+    poolData.target =
+        stats.active + (stats.requests > queueSlack ? stats.requests - queueSlack : 0);
 
     if (poolData.target < minConns) {
         poolData.target = minConns;
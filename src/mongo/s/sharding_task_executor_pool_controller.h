@@ -95,6 +95,7 @@ public:
         AtomicWord<int> minConnections;
         AtomicWord<int> maxConnections;
         AtomicWord<int> maxConnecting;
+        AtomicWord<int> queuedRequestsBeforeGrowing;
 
         AtomicWord<int> hostTimeoutMS;
         AtomicWord<int> pendingTimeoutMS;
@@ -60,6 +60,10 @@ struct WriteErrorDetailComp {
 const int kEstUpdateOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 const int kEstDeleteOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 
+// Number of documents of an ordered insert batch which are targeted together before any of them
+// is added to a batch.
+const size_t kMinOrderedInsertTargetingWindow = 16;
+
 /**
  * Returns a new write concern that has the copy of every field from the original
  * document but with a w set to 1. This is intended for upgrading { w: 0 } write
@@ -310,6 +314,18 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // Inserts are targeted a window of documents at a time, which lets the targeter resolve their
+    // shard keys together rather than one by one. An ordered batch stops at the first document
+    // which goes to a different shard, so its window starts small and doubles on every refill.
+    // This bounds the number of documents targeted but left for a later round by roughly the number
+    // sent.
+    const bool targetInsertsInWindows =
+        _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+    size_t insertWindowSize = ordered ? kMinOrderedInsertTargetingWindow : numWriteOps;
+    std::vector<size_t> windowOpIndexes;
+    std::vector<StatusWith<ShardEndpoint>> windowEndpoints;
+    size_t nextInWindow = 0;
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -317,6 +333,20 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         if (writeOp.getWriteState() != WriteOpState_Ready)
             continue;
 
+        if (targetInsertsInWindows && nextInWindow == windowOpIndexes.size()) {
+            windowOpIndexes.clear();
+            std::vector<BSONObj> docs;
+            for (size_t j = i; j < numWriteOps && windowOpIndexes.size() < insertWindowSize; ++j) {
+                if (_writeOps[j].getWriteState() == WriteOpState_Ready) {
+                    windowOpIndexes.push_back(j);
+                    docs.push_back(_writeOps[j].getWriteItem().getDocument());
+                }
+            }
+            windowEndpoints = targeter.targetInserts(_opCtx, docs);
+            nextInWindow = 0;
+            insertWindowSize *= 2;
+        }
+
         //
         // Get TargetedWrites from the targeter for the write operation
         //
@@ -327,7 +357,13 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (targetInsertsInWindows) {
+                invariant(windowOpIndexes[nextInWindow] == i);
+                auto& endpoint = windowEndpoints[nextInWindow++];
+                writeOp.targetInsert(_opCtx, uassertStatusOK(std::move(endpoint)), &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
@@ -400,6 +400,61 @@ TEST_F(BatchWriteOpTest, MultiOpSameShardUnordered) {
     ASSERT_EQUALS(clientResponse.getN(), 2);
 }
 
+// Ordered inserts spanning several targeting windows, followed by inserts to alternating shards
+TEST_F(BatchWriteOpTest, MultiInsertOrderedAcrossTargetingWindows) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED(), boost::none);
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED(), boost::none);
+
+    auto targeter = initTargeterSplitRange(nss, endpointA, endpointB);
+
+    const int numDocsOnA = 100;
+    BatchedCommandRequest request([&] {
+        write_ops::InsertCommandRequest insertOp(nss);
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < numDocsOnA; i++) {
+            docs.push_back(BSON("x" << -1 - i));
+        }
+        docs.push_back(BSON("x" << 1));
+        docs.push_back(BSON("x" << -1));
+        insertOp.setDocuments(docs);
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    // The first round contains every document up to the first one for the other shard.
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), size_t(numDocsOnA));
+    assertEndpointsEqual(targeted.begin()->second->getEndpoint(), endpointA);
+
+    BatchedCommandResponse response;
+    buildResponse(numDocsOnA, &response);
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, nullptr);
+    ASSERT(!batchOp.isFinished());
+
+    // Each of the remaining documents goes to a different shard than the one before it.
+    for (const auto& expectedEndpoint : {endpointB, endpointA}) {
+        targetedOwned.clear();
+        ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+        ASSERT_EQUALS(targeted.size(), 1u);
+        ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 1u);
+        assertEndpointsEqual(targeted.begin()->second->getEndpoint(), expectedEndpoint);
+
+        buildResponse(1, &response);
+        batchOp.noteBatchResponse(*targeted.begin()->second, response, nullptr);
+    }
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), numDocsOnA + 2);
+}
+
 // Multi-op, multi-endpoing targeting test (ordered). There should be two sets of single batches
 // (one to each shard, one-by-one)
 TEST_F(BatchWriteOpTest, MultiOpTwoShardsOrdered) {
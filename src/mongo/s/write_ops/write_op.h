@@ -123,6 +123,15 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as targetWrites(), but for an insert whose ShardEndpoint has already been determined,
+     * for example by targeting the documents of a whole batch at once with
+     * NSTargeter::targetInserts().
+     */
+    void targetInsert(OperationContext* opCtx,
+                      ShardEndpoint endpoint,
+                      std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -166,6 +175,14 @@ private:
      */
     void _updateOpState();
 
+    /**
+     * Creates a TargetedWrite and a pending child op for each of 'endpoints' on which this write
+     * has not already succeeded.
+     */
+    void _addChildWrites(OperationContext* opCtx,
+                         std::vector<ShardEndpoint> endpoints,
+                         std::vector<TargetedWrite*>* targetedWrites);
+
     // Owned elsewhere, reference to a batch with a write item
     const BatchItemRef _itemRef;
 
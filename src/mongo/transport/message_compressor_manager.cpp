@@ -33,6 +33,8 @@
 
 #include "mongo/transport/message_compressor_manager.h"
 
+#include <algorithm>
+
 #include "mongo/base/data_range_cursor.h"
 #include "mongo/base/data_type_endian.h"
 #include "mongo/bson/bsonobj.h"
@@ -41,6 +43,7 @@
 #include "mongo/rpc/message.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/session.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -131,7 +134,9 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
     compressionHeader.serialize(&output);
     ConstDataRange input(inputHeader.data(), inputHeader.data() + inputHeader.dataLen());
 
+    Timer timer;
     auto sws = compressor->compressData(input, output);
+    compressor->recordCompressTime(Microseconds{timer.micros()});
 
     if (!sws.isOK())
         return sws.getStatus();
@@ -189,7 +194,9 @@ StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& m
 
     DataRangeCursor output(outMessage.data(), outMessage.data() + outMessage.dataLen());
 
+    Timer timer;
     auto sws = compressor->decompressData(input, output);
+    compressor->recordDecompressTime(Microseconds{timer.micros()});
 
     if (!sws.isOK())
         return sws.getStatus();
@@ -213,8 +220,21 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     if (compressorList.size() == 0)
         return;
 
+    std::vector<std::string> offered;
+    for (const auto& e : _clientPreferred) {
+        if (std::find(compressorList.begin(), compressorList.end(), e) != compressorList.end() &&
+            std::find(offered.begin(), offered.end(), e) == offered.end()) {
+            offered.push_back(e);
+        }
+    }
+    for (const auto& e : compressorList) {
+        if (std::find(offered.begin(), offered.end(), e) == offered.end()) {
+            offered.push_back(e);
+        }
+    }
+
     BSONArrayBuilder sub(output->subarrayStart("compression"));
-    for (const auto& e : _registry->getCompressorNames()) {
+    for (const auto& e : offered) {
         LOGV2_DEBUG(22929,
                     3,
                     "Offering {compressor} compressor to server",
@@ -225,6 +245,11 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     sub.doneFast();
 }
 
+void MessageCompressorManager::setClientPreferredCompressors(
+    std::vector<std::string> compressorNames) {
+    _clientPreferred = std::move(compressorNames);
+}
+
 void MessageCompressorManager::clientFinish(const BSONObj& input) {
     auto elem = input.getField("compression");
     LOGV2_DEBUG(22930, 3, "Finishing client-side compression negotiation");
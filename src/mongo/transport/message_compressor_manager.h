@@ -33,6 +33,7 @@
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/session.h"
 
+#include <string>
 #include <vector>
 
 namespace mongo {
@@ -68,6 +69,14 @@ public:
      */
     void clientBegin(BSONObjBuilder* output);
 
+    /*
+     * Sets the compressors which clientBegin() offers to the server ahead of the others, in order
+     * of preference. Since the first compressor supported by both sides is used for the messages
+     * of the connection, this picks the compressor used for it. Compressors which are not in
+     * _registry->getCompressorNames() are ignored.
+     */
+    void setClientPreferredCompressors(std::vector<std::string> compressorNames);
+
     /*
      * Called by a client that has received an isMaster response (received after calling
      * clientBegin) and wants to finish negotiating compression.
@@ -125,6 +134,7 @@ public:
 
 private:
     std::vector<MessageCompressorBase*> _negotiated;
+    std::vector<std::string> _clientPreferred;
     MessageCompressorRegistry* _registry;
 };
 
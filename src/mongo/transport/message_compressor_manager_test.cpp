@@ -131,6 +131,12 @@ void checkFidelity(const Message& msg, std::unique_ptr<MessageCompressorBase> co
     ASSERT_EQ(decompressedMsgView.getLen(), originalView.getLen());
 
     ASSERT_EQ(memcmp(decompressedMsgView.data(), originalView.data(), originalView.dataLen()), 0);
+
+    const auto registeredCompressor = registry.getCompressor(compressorName);
+    ASSERT_EQ(registeredCompressor->getCompressorMessages(), 1);
+    ASSERT_EQ(registeredCompressor->getDecompressorMessages(), 1);
+    ASSERT_EQ(registeredCompressor->getCompressorBytesIn(), originalView.dataLen());
+    ASSERT_EQ(registeredCompressor->getDecompressorBytesOut(), originalView.dataLen());
 }
 
 void checkOverflow(std::unique_ptr<MessageCompressorBase> compressor) {
@@ -241,6 +247,35 @@ TEST(MessageCompressorManager, FullNormalCompression) {
     clientManager.clientFinish(serverObj);
 }
 
+TEST(MessageCompressorManager, ClientPreferredCompressorsAreOfferedFirst) {
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({"noop", "snappy", "zstd"});
+    registry.registerImplementation(std::make_unique<NoopMessageCompressor>());
+    registry.registerImplementation(std::make_unique<SnappyMessageCompressor>());
+    registry.registerImplementation(std::make_unique<ZstdMessageCompressor>());
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+
+    MessageCompressorManager clientManager(&registry);
+    clientManager.setClientPreferredCompressors({"zstd", "fakecompressor"});
+
+    BSONObjBuilder clientOutput;
+    clientManager.clientBegin(&clientOutput);
+    auto clientObj = clientOutput.done();
+    checkNegotiationResult(clientObj, {"zstd", "noop", "snappy"});
+
+    MessageCompressorManager serverManager(&registry);
+    BSONObjBuilder serverOutput;
+    serverManager.serverNegotiate(parseBSON(clientObj), &serverOutput);
+    auto serverObj = serverOutput.done();
+    checkNegotiationResult(serverObj, {"zstd", "noop", "snappy"});
+
+    clientManager.clientFinish(serverObj);
+    auto compressedMsg = assertOk(clientManager.compressMessage(buildMessage()));
+    MessageCompressorId compressorId;
+    assertOk(serverManager.decompressMessage(compressedMsg, &compressorId));
+    ASSERT_EQ(compressorId, registry.getCompressor("zstd")->getId());
+}
+
 TEST(NoopMessageCompressor, Fidelity) {
     auto testMessage = buildMessage();
     checkFidelity(testMessage, std::make_unique<NoopMessageCompressor>());
@@ -261,6 +296,13 @@ TEST(ZstdMessageCompressor, Fidelity) {
     checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, FidelityReusingContexts) {
+    auto testMessage = buildMessage();
+    for (int i = 0; i < 3; i++) {
+        checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
+    }
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<SnappyMessageCompressor>());
 }
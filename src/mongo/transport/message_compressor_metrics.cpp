@@ -36,6 +36,8 @@ namespace mongo {
 namespace {
 const auto kBytesIn = "bytesIn"_sd;
 const auto kBytesOut = "bytesOut"_sd;
+const auto kNumMessages = "numMessages"_sd;
+const auto kTimeMicros = "timeMicros"_sd;
 }  // namespace
 
 void appendMessageCompressionStats(BSONObjBuilder* b) {
@@ -52,12 +54,16 @@ void appendMessageCompressionStats(BSONObjBuilder* b) {
 
         BSONObjBuilder compressorSection(base.subobjStart("compressor"));
         compressorSection << kBytesIn << compressor->getCompressorBytesIn() << kBytesOut
-                          << compressor->getCompressorBytesOut();
+                          << compressor->getCompressorBytesOut() << kNumMessages
+                          << compressor->getCompressorMessages() << kTimeMicros
+                          << durationCount<Microseconds>(compressor->getCompressorTime());
         compressorSection.doneFast();
 
         BSONObjBuilder decompressorSection(base.subobjStart("decompressor"));
         decompressorSection << kBytesIn << compressor->getDecompressorBytesIn() << kBytesOut
-                            << compressor->getDecompressorBytesOut();
+                            << compressor->getDecompressorBytesOut() << kNumMessages
+                            << compressor->getDecompressorMessages() << kTimeMicros
+                            << durationCount<Microseconds>(compressor->getDecompressorTime());
         decompressorSection.doneFast();
         base.doneFast();
     }
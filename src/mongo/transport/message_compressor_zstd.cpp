@@ -38,6 +38,26 @@
 #include "mongo/transport/message_compressor_zstd.h"
 
 namespace mongo {
+namespace {
+
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+// Creating a context allocates and initializes several hundred KB of state, which costs more than
+// compressing a typical small message. Each thread keeps its contexts around for reuse instead.
+thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> compressionContext;
+thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> decompressionContext;
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +67,20 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    if (!compressionContext) {
+        compressionContext.reset(ZSTD_createCCtx());
+        if (!compressionContext) {
+            return Status{ErrorCodes::ExceededMemoryLimit,
+                          "Could not allocate a zstd compression context"};
+        }
+    }
+
+    size_t ret = ZSTD_compressCCtx(compressionContext.get(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +92,19 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    if (!decompressionContext) {
+        decompressionContext.reset(ZSTD_createDCtx());
+        if (!decompressionContext) {
+            return Status{ErrorCodes::ExceededMemoryLimit,
+                          "Could not allocate a zstd decompression context"};
+        }
+    }
+
+    size_t ret = ZSTD_decompressDCtx(decompressionContext.get(),
+                                     const_cast<char*>(output.data()),
+                                     output.length(),
+                                     input.data(),
+                                     input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -52,6 +52,8 @@ namespace {
 constexpr auto kExecutorName = "fixed"_sd;
 
 constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kThreadsIdle = "threadsIdle"_sd;
+constexpr auto kTasksQueued = "tasksQueued"_sd;
 constexpr auto kClientsInTotal = "clientsInTotal"_sd;
 constexpr auto kClientsRunning = "clientsRunning"_sd;
 constexpr auto kClientsWaiting = "clientsWaitingForData"_sd;
@@ -456,6 +458,12 @@ void ServiceExecutorFixed::appendStats(BSONObjBuilder* bob) const {
     subbob.append(kClientsInTotal, static_cast<int>(_tasksTotal()));
     subbob.append(kClientsRunning, static_cast<int>(_tasksRunning()));
     subbob.append(kClientsWaiting, static_cast<int>(_tasksWaiting()));
+
+    // Tasks queue up behind busy threads until the pool either frees or spawns a thread, so a
+    // persistently non-zero queue with no idle threads indicates the executor is saturated.
+    const auto poolStats = _threadPool->getStats();
+    subbob.append(kThreadsIdle, static_cast<int>(poolStats.numIdleThreads));
+    subbob.append(kTasksQueued, static_cast<int>(poolStats.numPendingTasks));
 }
 
 int ServiceExecutorFixed::getRecursionDepthForExecutorThread() const {
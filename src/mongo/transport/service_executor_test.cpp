@@ -381,6 +381,41 @@ TEST_F(ServiceExecutorFixedFixture, RunTaskAfterWaitingForData) {
     ASSERT(ranOnDataAvailable.load());
 }
 
+TEST_F(ServiceExecutorFixedFixture, ReportsQueuedTasks) {
+    auto executorHandle = ServiceExecutorHandle();
+    executorHandle.start();
+
+    auto getStats = [&] {
+        BSONObjBuilder bob;
+        executorHandle->appendStats(&bob);
+        return bob.obj()["fixed"].Obj().getOwned();
+    };
+
+    // Occupy every executor thread so that the next task has to wait in the queue.
+    auto started = std::make_shared<unittest::Barrier>(kNumExecutorThreads + 1);
+    auto barrier = std::make_shared<unittest::Barrier>(kNumExecutorThreads + 1);
+    for (auto i = 0; i < kNumExecutorThreads; i++) {
+        ASSERT_OK(executorHandle->scheduleTask(
+            [started, barrier] {
+                started->countDownAndWait();
+                barrier->countDownAndWait();
+            },
+            {}));
+    }
+    started->countDownAndWait();
+
+    auto queuedTaskRan = std::make_shared<unittest::Barrier>(2);
+    ASSERT_OK(
+        executorHandle->scheduleTask([queuedTaskRan] { queuedTaskRan->countDownAndWait(); }, {}));
+
+    auto stats = getStats();
+    ASSERT_EQ(stats["threadsIdle"].numberInt(), 0) << stats;
+    ASSERT_EQ(stats["tasksQueued"].numberInt(), 1) << stats;
+
+    barrier->countDownAndWait();
+    queuedTaskRan->countDownAndWait();
+}
+
 TEST_F(ServiceExecutorFixedFixture, StartAndShutdownAreDeterministic) {
     auto handle = ServiceExecutorHandle();
 
@@ -51,6 +51,7 @@
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
@@ -117,6 +118,10 @@ Message makeLegacyExhaustMessage(Message* m, const DbResponse& dbresponse) {
  * allowed, produces the subsequent request message, and modifies the response message to indicate
  * it is part of an exhaust stream. Returns the subsequent request message, which is known as a
  * 'synthetic' exhaust request. Returns an empty message if exhaust is not allowed.
+ *
+ * The response must not have a checksum yet, since setting its flags would invalidate it. It is up
+ * to the caller to checksum the response afterwards, so that a large batch is only checksummed
+ * once.
  */
 Message makeExhaustMessage(Message requestMsg, DbResponse* dbresponse) {
     if (requestMsg.operation() == dbQuery) {
@@ -154,15 +159,12 @@ Message makeExhaustMessage(Message requestMsg, DbResponse* dbresponse) {
         OpMsg::appendChecksum(&exhaustMessage);
     }
 
-    OpMsg::removeChecksum(&dbresponse->response);
     // Indicate that the response is part of an exhaust stream (unless the 'doNotSetMoreToCome'
-    // failpoint is set). Re-checksum if needed.
+    // failpoint is set).
+    invariant(!OpMsg::isFlagSet(dbresponse->response, OpMsg::kChecksumPresent));
     if (!MONGO_unlikely(doNotSetMoreToCome.shouldFail())) {
         OpMsg::setFlag(&dbresponse->response, OpMsg::kMoreToCome);
     }
-    if (checksumPresent) {
-        OpMsg::appendChecksum(&dbresponse->response);
-    }
 
     return exhaustMessage;
 }
@@ -236,6 +238,13 @@ public:
     Future<void> sourceMessage();
     Future<void> sinkMessage();
 
+    /*
+     * Waits for the exhaust response being sent in the background, if any, to reach the client.
+     * Any other use of the session must wait for it first, since responses must arrive in order
+     * and the session can only do one thing at a time.
+     */
+    Status waitForPipelinedSink();
+
     /*
      * Releases all the resources associated with the session and call the cleanupHook.
      */
@@ -293,6 +302,9 @@ private:
     Message _inMessage;
     Message _outMessage;
 
+    // The exhaust response being sent while the next one is produced, see sinkMessage().
+    boost::optional<Future<void>> _pipelinedSink;
+
     ServiceContext::UniqueOperationContext _opCtx;
 };
 
@@ -334,8 +346,20 @@ Future<void> ServiceStateMachine::Impl::sinkMessage() {
     _state.store(State::SinkWait);
     auto toSink = std::exchange(_outMessage, {});
 
-    auto sinkMsgImpl = [&] {
+    auto sinkMsgImpl = [&]() -> Future<void> {
+        if (auto status = waitForPipelinedSink(); !status.isOK()) {
+            return status;
+        }
+
         const auto& transportMode = executor()->transportMode();
+        if (transportMode == transport::Mode::kSynchronous && _inExhaust &&
+            toSink.size() <= gExhaustResponsePipelineMaxBytes.load()) {
+            // More exhaust responses follow: let the transport layer's reactor send this one while
+            // this thread goes on to produce the next.
+            _pipelinedSink.emplace(session()->asyncSinkMessage(std::move(toSink)));
+            return Status::OK();
+        }
+
         if (transportMode == transport::Mode::kSynchronous) {
             // We don't consider ourselves idle while sending the reply since we are still doing
             // work on behalf of the client. Contrast that with sourceMessage() where we are waiting
@@ -353,6 +377,13 @@ Future<void> ServiceStateMachine::Impl::sinkMessage() {
     });
 }
 
+Status ServiceStateMachine::Impl::waitForPipelinedSink() {
+    if (!_pipelinedSink) {
+        return Status::OK();
+    }
+    return std::exchange(_pipelinedSink, boost::none)->getNoThrow();
+}
+
 void ServiceStateMachine::Impl::sourceCallback(Status status) {
     invariant(state() == State::SourceWait);
 
@@ -471,15 +502,8 @@ Future<void> ServiceStateMachine::Impl::processMessage() {
                 // Update the header for the response message.
                 toSink.header().setId(nextMessageId());
                 toSink.header().setResponseToMsgId(_inMessage.header().getId());
-                if (OpMsg::isFlagSet(_inMessage, OpMsg::kChecksumPresent)) {
-#ifdef MONGO_CONFIG_SSL
-                    if (!SSLPeerInfo::forSession(session()).isTLS) {
-                        OpMsg::appendChecksum(&toSink);
-                    }
-#else
-                    OpMsg::appendChecksum(&toSink);
-#endif
-                }
+                const bool requestHasChecksum =
+                    OpMsg::isFlagSet(_inMessage, OpMsg::kChecksumPresent);
 
                 // If the incoming message has the exhaust flag set, then we bypass the normal RPC
                 // behavior. We will sink the response to the network, but we also synthesize a new
@@ -489,6 +513,18 @@ Future<void> ServiceStateMachine::Impl::processMessage() {
                 _inMessage = makeExhaustMessage(_inMessage, &dbresponse);
                 _inExhaust = !_inMessage.empty();
 
+                // Checksum the response only once its flags are final. Responses that are part of
+                // an exhaust stream are always checksummed if requested, others only outside TLS.
+                if (requestHasChecksum) {
+#ifdef MONGO_CONFIG_SSL
+                    if (_inExhaust || !SSLPeerInfo::forSession(session()).isTLS) {
+                        OpMsg::appendChecksum(&toSink);
+                    }
+#else
+                    OpMsg::appendChecksum(&toSink);
+#endif
+                }
+
                 networkCounter.hitLogicalOut(toSink.size());
 
                 beforeCompressingExhaustResponse.executeIf(
@@ -534,6 +570,9 @@ void ServiceStateMachine::Impl::scheduleNewLoop(Status status) try {
     _opCtx.reset();
 
     uassertStatusOK(status);
+    if (!_inExhaust) {
+        uassertStatusOK(waitForPipelinedSink());
+    }
 
     auto cb = [this, anchor = shared_from_this()](Status executorStatus) {
         _clientStrand->run([&] { startNewLoop(executorStatus); });
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <utility>
+#include <vector>
 
 #include "mongo/base/system_error.h"
 #include "mongo/config.h"
@@ -38,6 +39,7 @@
 #include "mongo/transport/baton.h"
 #include "mongo/transport/ssl_connection_context.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -112,6 +114,7 @@ public:
 
         _local = HostAndPort(_localAddr.toString(true));
         _remote = HostAndPort(_remoteAddr.toString(true));
+        _readAheadBuffer.resize(gSessionReadAheadBufferSizeBytes);
 #ifdef MONGO_CONFIG_SSL
         _sslContext = transientSSLContext ? transientSSLContext : *tl->_sslContext;
         if (transientSSLContext) {
@@ -186,6 +189,10 @@ public:
 
     Status waitForData() noexcept override try {
         ensureSync();
+        if (readAheadBytesAvailable()) {
+            return Status::OK();
+        }
+
         asio::error_code ec;
         getSocket().wait(asio::ip::tcp::socket::wait_read, ec);
         return errorCodeToStatus(ec);
@@ -195,6 +202,10 @@ public:
 
     Future<void> asyncWaitForData() noexcept override try {
         ensureAsync();
+        if (readAheadBytesAvailable()) {
+            return Future<void>::makeReady();
+        }
+
         return getSocket().async_wait(asio::ip::tcp::socket::wait_read, UseFuture{});
     } catch (const DBException& ex) {
         return ex.toStatus();
@@ -515,9 +526,65 @@ private:
                 });
         }
 #endif
+        if (!_readAheadBuffer.empty()) {
+            return readAhead(buffers, baton);
+        }
+
         return opportunisticRead(_socket, buffers, baton);
     }
 
+    size_t readAheadBytesAvailable() const {
+        return _readAheadEnd - _readAheadBegin;
+    }
+
+    /**
+     * Copies as many of the bytes left over by a previous read ahead as fit into 'buffer' and
+     * returns how many were copied.
+     */
+    size_t consumeReadAhead(const asio::mutable_buffer& buffer) {
+        const auto size = std::min(buffer.size(), readAheadBytesAvailable());
+        memcpy(buffer.data(), _readAheadBuffer.data() + _readAheadBegin, size);
+        _readAheadBegin += size;
+        return size;
+    }
+
+    /**
+     * Fills 'buffers' from the read ahead buffer first. If more bytes are needed, reads as many as
+     * the socket has available, up to the size of the read ahead buffer, with a single system call
+     * and consumes them. Anything still missing after that, such as the rest of a message larger
+     * than the read ahead buffer, is read with an opportunistic read straight into 'buffers'.
+     */
+    template <typename MutableBufferSequence>
+    Future<void> readAhead(const MutableBufferSequence& buffers, const BatonHandle& baton) {
+        asio::mutable_buffer buffer = buffers;
+        buffer += consumeReadAhead(buffer);
+        if (!buffer.size()) {
+            return Future<void>::makeReady();
+        }
+
+        if (MONGO_likely(!transportLayerASIOshortOpportunisticReadWrite.shouldFail())) {
+            std::error_code ec;
+            size_t size;
+            do {
+                size = _socket.read_some(asio::buffer(_readAheadBuffer), ec);
+            } while (ec == asio::error::interrupted);  // retry syscall EINTR
+
+            if (!ec) {
+                _readAheadBegin = 0;
+                _readAheadEnd = size;
+                buffer += consumeReadAhead(buffer);
+                if (!buffer.size()) {
+                    return Future<void>::makeReady();
+                }
+            } else if (((ec != asio::error::would_block) && (ec != asio::error::try_again)) ||
+                       (_blockingMode != Async)) {
+                return futurize(ec);
+            }
+        }
+
+        return opportunisticRead(_socket, buffer, baton);
+    }
+
     template <typename ConstBufferSequence>
     Future<void> write(const ConstBufferSequence& buffers, const BatonHandle& baton = nullptr) {
         // TODO SERVER-47229 Guard active ops for cancellation here.
@@ -852,6 +919,14 @@ private:
     boost::optional<Milliseconds> _socketTimeout;
 
     GenericSocket _socket;
+
+    // Bytes read from the socket ahead of the messages being sourced. Only the bytes in the range
+    // [_readAheadBegin, _readAheadEnd) have not been consumed yet. Empty if reading ahead is
+    // disabled.
+    std::vector<char> _readAheadBuffer;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
+
 #ifdef MONGO_CONFIG_SSL
     boost::optional<asio::ssl::stream<decltype(_socket)>> _sslSocket;
     bool _ranHandshake = false;
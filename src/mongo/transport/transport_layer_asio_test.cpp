@@ -36,9 +36,11 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/op_msg.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/net/sock.h"
+#include "mongo/util/scopeguard.h"
 
 #include "asio.hpp"
 
@@ -272,9 +274,9 @@ public:
         }
     }
 
-    void sendMessage() {
+    void sendMessage(const BSONObj& body = BSON("ping" << 1)) {
         OpMsgBuilder builder;
-        builder.setBody(BSON("ping" << 1));
+        builder.setBody(body);
         Message msg = builder.finish();
         msg.header().setResponseToMsgId(0);
         msg.header().setId(0);
@@ -382,5 +384,52 @@ TEST(TransportLayerASIO, SwitchTimeoutModes) {
     tla->shutdown();
 }
 
+/* check that messages read ahead of time are sourced intact and in order */
+class ReadAheadSEP : public TimeoutSEP {
+public:
+    explicit ReadAheadSEP(std::vector<BSONObj> expectedBodies)
+        : _expectedBodies(std::move(expectedBodies)) {}
+
+    void startSession(transport::SessionHandle session) override {
+        LOGV2(6105100, "Accepted connection", "remote"_attr = session->remote());
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            for (const auto& expectedBody : _expectedBodies) {
+                auto swMessage = session->sourceMessage();
+                ASSERT_OK(swMessage.getStatus());
+                ASSERT_BSONOBJ_EQ(OpMsg::parse(swMessage.getValue()).body, expectedBody);
+            }
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+
+private:
+    std::vector<BSONObj> _expectedBodies;
+};
+
+TEST(TransportLayerASIO, SourceMessagesThroughReadAheadBuffer) {
+    // Small enough that messages straddle the read ahead buffer and some are larger than it
+    const auto oldReadAheadBufferSize = transport::gSessionReadAheadBufferSizeBytes;
+    transport::gSessionReadAheadBufferSizeBytes = 64;
+    ON_BLOCK_EXIT([&] { transport::gSessionReadAheadBufferSizeBytes = oldReadAheadBufferSize; });
+
+    std::vector<BSONObj> bodies;
+    for (int i = 0; i < 10; i++) {
+        bodies.push_back(BSON("ping" << i << "padding" << std::string(i * 20, 'x')));
+    }
+
+    ReadAheadSEP sep(bodies);
+    auto tla = makeAndStartTL(&sep);
+
+    TimeoutConnector connector(tla->listenerPort(), false);
+    for (const auto& body : bodies) {
+        connector.sendMessage(body);
+    }
+
+    ASSERT_TRUE(sep.waitForTimeout());
+    tla->shutdown();
+}
+
 }  // namespace
 }  // namespace mongo
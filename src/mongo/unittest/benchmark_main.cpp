@@ -39,6 +39,63 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/signal_handlers_synchronous.h"
 
+#ifdef MONGO_CONFIG_ALLOCATOR_INSTRUMENTATION
+#include <gperftools/malloc_extension.h>
+#include <gperftools/malloc_hook.h>
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+namespace {
+
+AtomicWord<long long> numAllocs;
+AtomicWord<long long> bytesInUse;
+AtomicWord<long long> maxBytesInUse;
+
+/**
+ * Counts the allocations made while Google Benchmark measures the memory use of a benchmark,
+ * which it does with a separate run of a few iterations, and reports as 'allocs_per_iter' and
+ * 'max_bytes_used' in its JSON output. 'max_bytes_used' is the peak growth in the bytes allocated
+ * over the start of that run.
+ */
+class AllocationCountingMemoryManager : public benchmark::MemoryManager {
+public:
+    void Start() override {
+        numAllocs.store(0);
+        bytesInUse.store(0);
+        maxBytesInUse.store(0);
+        invariant(MallocHook::AddNewHook(&_onNew));
+        invariant(MallocHook::AddDeleteHook(&_onDelete));
+    }
+
+    void Stop(Result* result) override {
+        invariant(MallocHook::RemoveNewHook(&_onNew));
+        invariant(MallocHook::RemoveDeleteHook(&_onDelete));
+        result->num_allocs = numAllocs.load();
+        result->max_bytes_used = maxBytesInUse.load();
+    }
+
+private:
+    static void _onNew(const void* ptr, size_t) {
+        numAllocs.fetchAndAddRelaxed(1);
+        const long long inUse =
+            bytesInUse.addAndFetch(MallocExtension::instance()->GetAllocatedSize(ptr));
+        long long maxInUse = maxBytesInUse.loadRelaxed();
+        while (inUse > maxInUse && !maxBytesInUse.compareAndSwap(&maxInUse, inUse)) {
+        }
+    }
+
+    static void _onDelete(const void* ptr) {
+        if (ptr) {
+            bytesInUse.subtractAndFetch(MallocExtension::instance()->GetAllocatedSize(ptr));
+        }
+    }
+};
+
+}  // namespace
+}  // namespace mongo
+#endif
+
 
 int main(int argc, char** argv) {
     ::mongo::clearSignalMask();
@@ -52,6 +109,11 @@ int main(int argc, char** argv) {
     if (::benchmark::ReportUnrecognizedArguments(argc, argv))
         return 1;
 
+#ifdef MONGO_CONFIG_ALLOCATOR_INSTRUMENTATION
+    ::mongo::AllocationCountingMemoryManager memoryManager;
+    ::benchmark::RegisterMemoryManager(&memoryManager);
+#endif
+
 #ifndef MONGO_CONFIG_OPTIMIZED_BUILD
     LOGV2(23049,
           "***WARNING*** MongoDB was built with --opt=off. Function timings may be "
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "mongo/platform/atomic_word.h"
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+namespace mongo {
+
+/**
+ * A fixed size Bloom filter over byte strings. mayContain() never returns false for a string that
+ * was inserted, and returns true for other strings with a probability that depends on the number
+ * of bits per inserted string: about 1% at 10 bits and 0.1% at 15 bits. Strings cannot be removed,
+ * so a filter over a changing set only ever becomes less selective.
+ *
+ * Inserts and lookups may run concurrently. A lookup is guaranteed to observe an insert that
+ * happened before it, for instance because the inserting thread committed a transaction the
+ * looking thread can see.
+ */
+class BloomFilter {
+public:
+    /**
+     * Creates a filter sized for 'expectedItems' strings at 'bitsPerItem' bits each.
+     */
+    BloomFilter(std::size_t expectedItems, int bitsPerItem)
+        : _numWords(std::max<std::size_t>(1, (expectedItems * bitsPerItem + 63) / 64)),
+          // The optimal number of hash functions is ln(2) times the number of bits per item.
+          _numHashes(std::max(1, std::min(16, bitsPerItem * 69 / 100))),
+          _words(std::make_unique<AtomicWord<std::uint64_t>[]>(_numWords)) {}
+
+    void insert(const char* data, std::size_t size) {
+        _forEachBit(data, size, [&](std::size_t word, std::uint64_t mask) {
+            // Skip the write when the bit is set to avoid contending on the cache line.
+            if (!(_words[word].loadRelaxed() & mask)) {
+                _words[word].fetchAndBitOr(mask);
+            }
+            return true;
+        });
+    }
+
+    bool mayContain(const char* data, std::size_t size) const {
+        bool found = true;
+        _forEachBit(data, size, [&](std::size_t word, std::uint64_t mask) {
+            found = _words[word].load() & mask;
+            return found;
+        });
+        return found;
+    }
+
+    std::size_t sizeInBytes() const {
+        return _numWords * sizeof(std::uint64_t);
+    }
+
+private:
+    /**
+     * Calls 'fn' with the word index and mask of each bit 'data' maps to, until 'fn' returns false.
+     */
+    template <typename Fn>
+    void _forEachBit(const char* data, std::size_t size, Fn&& fn) const {
+        std::uint64_t hash[2];
+        MurmurHash3_x64_128(data, static_cast<int>(size), 0, hash);
+
+        // Derives the bit positions from two hashes, as described in "Less Hashing, Same
+        // Performance: Building a Better Bloom Filter" by Kirsch and Mitzenmacher.
+        const std::uint64_t numBits = _numWords * 64;
+        for (int i = 0; i < _numHashes; ++i) {
+            const std::uint64_t bit = (hash[0] + i * hash[1]) % numBits;
+            if (!fn(bit / 64, std::uint64_t{1} << (bit % 64))) {
+                return;
+            }
+        }
+    }
+
+    const std::size_t _numWords;
+    const int _numHashes;
+    std::unique_ptr<AtomicWord<std::uint64_t>[]> _words;
+};
+
+}  // namespace mongo
@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/bloom_filter.h"
+
+namespace mongo {
+namespace {
+
+TEST(BloomFilterTest, ContainsInsertedStrings) {
+    BloomFilter filter(1000, 10);
+    for (int i = 0; i < 1000; ++i) {
+        auto str = std::to_string(i);
+        filter.insert(str.data(), str.size());
+    }
+    for (int i = 0; i < 1000; ++i) {
+        auto str = std::to_string(i);
+        ASSERT(filter.mayContain(str.data(), str.size())) << str;
+    }
+}
+
+TEST(BloomFilterTest, RejectsMostOtherStrings) {
+    BloomFilter filter(10000, 10);
+    for (int i = 0; i < 10000; ++i) {
+        auto str = std::to_string(i);
+        filter.insert(str.data(), str.size());
+    }
+
+    int falsePositives = 0;
+    for (int i = 10000; i < 20000; ++i) {
+        auto str = std::to_string(i);
+        falsePositives += filter.mayContain(str.data(), str.size());
+    }
+    // The expected rate is about 1%.
+    ASSERT_LT(falsePositives, 300);
+}
+
+TEST(BloomFilterTest, EmptyFilter) {
+    BloomFilter filter(0, 10);
+    ASSERT_EQ(filter.sizeInBytes(), 8U);
+    ASSERT_FALSE(filter.mayContain("a", 1));
+    filter.insert("a", 1);
+    ASSERT(filter.mayContain("a", 1));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -40,6 +40,45 @@
 
 namespace mongo {
 
+class TicketHolder::QueuedWaitGuard {
+    QueuedWaitGuard(const QueuedWaitGuard&) = delete;
+    QueuedWaitGuard& operator=(const QueuedWaitGuard&) = delete;
+
+public:
+    explicit QueuedWaitGuard(TicketHolder* holder) : _holder(holder) {
+        _holder->_queued.fetchAndAdd(1);
+    }
+
+    ~QueuedWaitGuard() {
+        _holder->_queued.subtractAndFetch(1);
+        _holder->_totalQueuedWaits.fetchAndAdd(1);
+        _holder->_totalQueuedMicros.fetchAndAdd(_timer.micros());
+        if (!_acquired) {
+            _holder->_totalAbandonedWaits.fetchAndAdd(1);
+        }
+    }
+
+    /**
+     * Records the outcome of the wait and passes it through.
+     */
+    bool acquired(bool acquired) {
+        _acquired = acquired;
+        return acquired;
+    }
+
+private:
+    TicketHolder* const _holder;
+    Timer _timer;
+    bool _acquired = false;
+};
+
+void TicketHolder::appendQueueStats(BSONObjBuilder* b) const {
+    b->append("queued", queued());
+    b->append("totalQueuedWaits", _totalQueuedWaits.load());
+    b->append("totalQueuedMicros", _totalQueuedMicros.load());
+    b->append("totalAbandonedWaits", _totalAbandonedWaits.load());
+}
+
 #if defined(__linux__)
 namespace {
 
@@ -99,23 +138,37 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
         return true;
     }
 
+    // An operation which is already past its deadline would only acquire a ticket to fail
+    // immediately afterwards, so shed it before it joins the queue.
+    if (opCtx)
+        opCtx->checkForInterrupt();
+
+    QueuedWaitGuard guard(this);
+
     const Milliseconds intervalMs(500);
     struct timespec ts;
 
+    // Waking up at the operation's own deadline, rather than up to an interval later, lets an
+    // operation whose maxTimeMS expires while queued give up its place promptly.
+    const Date_t opDeadline = opCtx ? opCtx->getDeadline() : Date_t::max();
+    auto nextDeadline = [&] {
+        return std::min({until, opDeadline, Date_t::now() + intervalMs});
+    };
+
     // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
     // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
+    // The wait period interval is the smallest of the default interval, the operation's deadline
+    // and the provided deadline.
+    Date_t deadline = nextDeadline();
     tsFromDate(deadline, ts);
 
     while (0 != sem_timedwait(&_sem, &ts)) {
         if (errno == ETIMEDOUT) {
             // If we reached the deadline without being interrupted, we have completely timed out.
             if (deadline == until)
-                return false;
+                return guard.acquired(false);
 
-            deadline = std::min(until, Date_t::now() + intervalMs);
+            deadline = nextDeadline();
             tsFromDate(deadline, ts);
         } else if (errno != EINTR) {
             failWithErrno(errno);
@@ -126,7 +179,7 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
         if (opCtx)
             opCtx->checkForInterrupt();
     }
-    return true;
+    return guard.acquired(true);
 }
 
 void TicketHolder::release() {
@@ -186,23 +239,32 @@ bool TicketHolder::tryAcquire() {
 
 void TicketHolder::waitForTicket(OperationContext* opCtx) {
     stdx::unique_lock<Latch> lk(_mutex);
+    if (_tryAcquire()) {
+        return;
+    }
 
+    QueuedWaitGuard guard(this);
     if (opCtx) {
         opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
     } else {
         _newTicket.wait(lk, [this] { return _tryAcquire(); });
     }
+    guard.acquired(true);
 }
 
 bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     stdx::unique_lock<Latch> lk(_mutex);
+    if (_tryAcquire()) {
+        return true;
+    }
 
+    QueuedWaitGuard guard(this);
     if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
+        return guard.acquired(opCtx->waitForConditionOrInterruptUntil(
+            _newTicket, lk, until, [this] { return _tryAcquire(); }));
     } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+        return guard.acquired(_newTicket.wait_until(
+            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); }));
     }
 }
 
@@ -32,12 +32,14 @@
 #include <semaphore.h>
 #endif
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -82,7 +84,42 @@ public:
 
     int outof() const;
 
+    /**
+     * The number of callers currently blocked waiting for a ticket.
+     */
+    int queued() const {
+        return _queued.load();
+    }
+
+    /**
+     * The number of acquisitions so far that had to wait for a ticket, and how long they waited in
+     * total.
+     */
+    long long totalQueuedWaits() const {
+        return _totalQueuedWaits.load();
+    }
+    long long totalQueuedMicros() const {
+        return _totalQueuedMicros.load();
+    }
+
+    /**
+     * Appends the queueing statistics of this holder: the number of acquisitions that had to wait,
+     * how long they waited in total, and how many gave up without a ticket, either by timing out
+     * or by being interrupted.
+     */
+    void appendQueueStats(BSONObjBuilder* b) const;
+
 private:
+    /**
+     * Keeps '_queued' and the wait statistics up to date for the lifetime of one blocking wait.
+     */
+    class QueuedWaitGuard;
+
+    AtomicWord<int> _queued{0};
+    AtomicWord<long long> _totalQueuedWaits{0};
+    AtomicWord<long long> _totalQueuedMicros{0};
+    AtomicWord<long long> _totalAbandonedWaits{0};
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
@@ -32,12 +32,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/service_context_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
 
 namespace {
 using namespace mongo;
 
+class TicketholderServiceContextTest : public ServiceContextTest {};
+
 TEST(TicketholderTest, BasicTimeout) {
     TicketHolder holder(1);
     ASSERT_EQ(holder.used(), 0);
@@ -72,4 +75,53 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, ReportsQueueStats) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    ASSERT_FALSE(holder.waitForTicketUntil(Date_t::now() + Milliseconds(10)));
+    ASSERT_EQ(holder.queued(), 0);
+
+    BSONObjBuilder bob;
+    holder.appendQueueStats(&bob);
+    auto stats = bob.obj();
+    ASSERT_EQ(stats["queued"].numberInt(), 0);
+    ASSERT_EQ(stats["totalQueuedWaits"].numberLong(), 1);
+    ASSERT_GTE(stats["totalQueuedMicros"].numberLong(), 0);
+    ASSERT_EQ(stats["totalAbandonedWaits"].numberLong(), 1);
+
+    holder.release();
+
+    // Acquisitions which do not have to wait are not counted as queued.
+    ASSERT(holder.waitForTicketUntil(Date_t::now() + Milliseconds(10)));
+    BSONObjBuilder afterAcquire;
+    holder.appendQueueStats(&afterAcquire);
+    ASSERT_EQ(afterAcquire.obj()["totalQueuedWaits"].numberLong(), 1);
+    holder.release();
+}
+
+TEST_F(TicketholderServiceContextTest, WaitEndsAtOperationDeadline) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto opCtx = makeOperationContext();
+    opCtx->setDeadlineAfterNowBy(Milliseconds(20), ErrorCodes::ExceededTimeLimit);
+
+    // The operation's deadline is well before the interval at which interrupts are otherwise
+    // checked, so the wait must give up at the deadline rather than at the interval.
+    Timer timer;
+    ASSERT_THROWS_CODE(holder.waitForTicket(opCtx.get()),
+                       AssertionException,
+                       ErrorCodes::ExceededTimeLimit);
+    ASSERT_LT(timer.millis(), 400);
+    ASSERT_EQ(holder.queued(), 0);
+
+    // An operation which is already past its deadline does not wait at all.
+    ASSERT_THROWS_CODE(holder.waitForTicketUntil(opCtx.get(), Date_t::max()),
+                       AssertionException,
+                       ErrorCodes::ExceededTimeLimit);
+
+    holder.release();
+}
 }  // namespace
@@ -0,0 +1,194 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+
+namespace mongo {
+
+/**
+ * A map split into a fixed number of partitions, each held through a shared pointer, so that
+ * copying the map only copies the pointers. The copy and the original share all partitions until
+ * one of them is modified, at which point only the partition being modified is cloned. A map that
+ * is copied, modified in a few places and then published as read-only, as the CollectionCatalog
+ * is, pays for the data it changes rather than for everything it holds.
+ *
+ * 'PartitionHasher' chooses the partition of a key. Keys must be assigned to partitions so that
+ * lookups that 'Map' answers for a group of keys, such as range queries on an ordered map, only
+ * need one partition.
+ *
+ * A map that is shared with copies must not be modified while another thread reads a copy. Each
+ * instance is otherwise only as thread safe as 'Map'.
+ */
+template <typename Map,
+          typename PartitionHasher = typename Map::hasher,
+          std::size_t kNumPartitions = 64>
+class CopyOnWritePartitionedMap {
+public:
+    using key_type = typename Map::key_type;
+    using mapped_type = typename Map::mapped_type;
+    using value_type = typename Map::value_type;
+
+    CopyOnWritePartitionedMap() {
+        for (auto& partition : _partitions) {
+            partition = std::make_shared<Map>();
+        }
+        _owned.set();
+    }
+
+    CopyOnWritePartitionedMap(const CopyOnWritePartitionedMap& other)
+        : _partitions(other._partitions), _size(other._size) {}
+
+    CopyOnWritePartitionedMap& operator=(const CopyOnWritePartitionedMap& other) {
+        _partitions = other._partitions;
+        _owned.reset();
+        _size = other._size;
+        return *this;
+    }
+
+    /**
+     * Returns the partition that 'key' belongs to, for lookups that 'Map' supports beyond find().
+     */
+    const Map& partition(const key_type& key) const {
+        return *_partitions[_partitionIndex(key)];
+    }
+
+    /**
+     * Returns a pointer to the value mapped to 'key', or nullptr if there is none.
+     */
+    const mapped_type* find(const key_type& key) const {
+        const auto& map = partition(key);
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+
+    bool contains(const key_type& key) const {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * Maps 'key' to 'value', replacing any value already mapped to it.
+     */
+    template <typename V>
+    void set(const key_type& key, V&& value) {
+        auto& map = _writablePartition(key);
+        auto it = map.find(key);
+        if (it == map.end()) {
+            map.emplace(key, std::forward<V>(value));
+            ++_size;
+        } else {
+            it->second = std::forward<V>(value);
+        }
+    }
+
+    /**
+     * Removes 'key' and returns true if it was present.
+     */
+    bool erase(const key_type& key) {
+        if (!contains(key)) {
+            return false;
+        }
+        _writablePartition(key).erase(key);
+        --_size;
+        return true;
+    }
+
+    void clear() {
+        for (auto& partition : _partitions) {
+            partition = std::make_shared<Map>();
+        }
+        _owned.set();
+        _size = 0;
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Calls 'fn' with each entry, one partition after another.
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        forEachPartition([&](const Map& map) {
+            for (const auto& entry : map) {
+                fn(entry);
+            }
+        });
+    }
+
+    /**
+     * Calls 'fn' with each partition.
+     */
+    template <typename Fn>
+    void forEachPartition(Fn&& fn) const {
+        for (const auto& partition : _partitions) {
+            fn(*partition);
+        }
+    }
+
+private:
+    static std::size_t _partitionIndex(const key_type& key) {
+        // The hash is likely used by the partitions as well, so take the partition from the high
+        // bits of the mixed hash to keep the keys of each partition spread out within it.
+        static_assert(kNumPartitions > 0 && (kNumPartitions & (kNumPartitions - 1)) == 0);
+        const std::uint64_t hash = PartitionHasher()(key);
+        return (hash * 0x9E3779B97F4A7C15ULL) >> (64 - _log2(kNumPartitions));
+    }
+
+    static constexpr int _log2(std::size_t n) {
+        return n <= 1 ? 0 : 1 + _log2(n / 2);
+    }
+
+    Map& _writablePartition(const key_type& key) {
+        const auto index = _partitionIndex(key);
+        if (!_owned[index]) {
+            _partitions[index] = std::make_shared<Map>(*_partitions[index]);
+            _owned.set(index);
+        }
+        return *_partitions[index];
+    }
+
+    std::array<std::shared_ptr<Map>, kNumPartitions> _partitions;
+
+    // Partitions that are not shared with any copy of this map and can be modified in place.
+    std::bitset<kNumPartitions> _owned;
+
+    std::size_t _size = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/copy_on_write_partitioned_map.h"
+
+namespace mongo {
+namespace {
+
+using UnorderedMap = CopyOnWritePartitionedMap<stdx::unordered_map<int, std::string>>;
+
+// Puts every key with the same tens digit in the same partition.
+struct TensHasher {
+    std::size_t operator()(int key) const {
+        return key / 10;
+    }
+};
+using OrderedMap = CopyOnWritePartitionedMap<std::map<int, std::string>, TensHasher>;
+
+TEST(CopyOnWritePartitionedMapTest, SetFindErase) {
+    UnorderedMap map;
+    ASSERT(map.empty());
+    ASSERT_FALSE(map.find(1));
+
+    map.set(1, "one");
+    map.set(2, "two");
+    ASSERT_EQ(map.size(), 2U);
+    ASSERT_EQ(*map.find(1), "one");
+    ASSERT_EQ(*map.find(2), "two");
+
+    map.set(1, "uno");
+    ASSERT_EQ(map.size(), 2U);
+    ASSERT_EQ(*map.find(1), "uno");
+
+    ASSERT(map.erase(1));
+    ASSERT_FALSE(map.erase(1));
+    ASSERT_FALSE(map.contains(1));
+    ASSERT(map.contains(2));
+    ASSERT_EQ(map.size(), 1U);
+
+    map.clear();
+    ASSERT(map.empty());
+    ASSERT_FALSE(map.contains(2));
+}
+
+TEST(CopyOnWritePartitionedMapTest, CopiesAreIndependent) {
+    UnorderedMap original;
+    for (int i = 0; i < 1000; ++i) {
+        original.set(i, std::to_string(i));
+    }
+
+    UnorderedMap copy(original);
+    copy.set(0, "zero");
+    copy.erase(1);
+    copy.set(1000, "1000");
+
+    ASSERT_EQ(original.size(), 1000U);
+    ASSERT_EQ(*original.find(0), "0");
+    ASSERT_EQ(*original.find(1), "1");
+    ASSERT_FALSE(original.contains(1000));
+
+    ASSERT_EQ(copy.size(), 1000U);
+    ASSERT_EQ(*copy.find(0), "zero");
+    ASSERT_FALSE(copy.contains(1));
+    ASSERT_EQ(*copy.find(1000), "1000");
+
+    // Modifying the original after the copy has cloned a partition must not affect the copy.
+    original.set(0, "cero");
+    ASSERT_EQ(*copy.find(0), "zero");
+
+    copy.clear();
+    ASSERT_EQ(original.size(), 1000U);
+}
+
+TEST(CopyOnWritePartitionedMapTest, UnmodifiedPartitionsAreShared) {
+    UnorderedMap original;
+    for (int i = 0; i < 1000; ++i) {
+        original.set(i, std::to_string(i));
+    }
+
+    UnorderedMap copy(original);
+    copy.set(0, "zero");
+
+    // Only the partition holding the modified key was cloned.
+    std::size_t shared = 0;
+    for (int i = 0; i < 1000; ++i) {
+        shared += &original.partition(i) == &copy.partition(i);
+    }
+    ASSERT_EQ(shared, 1000U - original.partition(0).size());
+}
+
+TEST(CopyOnWritePartitionedMapTest, ForEachVisitsEveryEntry) {
+    UnorderedMap map;
+    for (int i = 0; i < 100; ++i) {
+        map.set(i, std::to_string(i));
+    }
+
+    std::vector<bool> seen(100);
+    map.forEach([&](const auto& entry) {
+        ASSERT_EQ(entry.second, std::to_string(entry.first));
+        ASSERT_FALSE(seen[entry.first]);
+        seen[entry.first] = true;
+    });
+    for (int i = 0; i < 100; ++i) {
+        ASSERT(seen[i]);
+    }
+}
+
+TEST(CopyOnWritePartitionedMapTest, RangeLookupWithinPartition) {
+    OrderedMap map;
+    for (int i = 0; i < 100; ++i) {
+        map.set(i, std::to_string(i));
+    }
+
+    const auto& partition = map.partition(42);
+    std::vector<int> keys;
+    for (auto it = partition.lower_bound(40); it != partition.end() && it->first < 50; ++it) {
+        keys.push_back(it->first);
+    }
+    ASSERT(keys == std::vector<int>({40, 41, 42, 43, 44, 45, 46, 47, 48, 49}));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/util/read_through_cache.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/stdx/condition_variable.h"
 
 namespace mongo {
@@ -42,6 +43,27 @@ ReadThroughCacheBase::ReadThroughCacheBase(Mutex& mutex,
 
 ReadThroughCacheBase::~ReadThroughCacheBase() = default;
 
+ReadThroughCacheBase::Stats ReadThroughCacheBase::getStats() const {
+    Stats stats;
+    stats.hits = _stats.hits.load();
+    stats.misses = _stats.misses.load();
+    stats.joinedLookups = _stats.joinedLookups.load();
+    stats.negativeHits = _stats.negativeHits.load();
+    stats.lookups = _stats.lookups.load();
+    stats.totalLookupMicros = _stats.totalLookupMicros.load();
+    return stats;
+}
+
+void ReadThroughCacheBase::appendStats(BSONObjBuilder* builder) const {
+    const auto stats = getStats();
+    builder->append("hits", stats.hits);
+    builder->append("misses", stats.misses);
+    builder->append("joinedLookups", stats.joinedLookups);
+    builder->append("negativeHits", stats.negativeHits);
+    builder->append("lookups", stats.lookups);
+    builder->append("totalLookupMicros", stats.totalLookupMicros);
+}
+
 struct ReadThroughCacheBase::CancelToken::TaskInfo {
     TaskInfo(ServiceContext* service, Mutex& mutex) : service(service), mutex(mutex) {}
 
@@ -33,11 +33,14 @@
 
 #include "mongo/bson/oid.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/thread_pool_interface.h"
 #include "mongo/util/functional.h"
 #include "mongo/util/future.h"
 #include "mongo/util/invalidating_lru_cache.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -48,6 +51,38 @@ class ReadThroughCacheBase {
     ReadThroughCacheBase(const ReadThroughCacheBase&) = delete;
     ReadThroughCacheBase& operator=(const ReadThroughCacheBase&) = delete;
 
+public:
+    /**
+     * Point-in-time snapshot of the access counters of a cache.
+     */
+    struct Stats {
+        // Acquisitions which were satisfied from the cached values
+        long long hits{0};
+
+        // Acquisitions which had to wait for a lookup, either by scheduling one or by joining one
+        // which was already in progress
+        long long misses{0};
+
+        // The subset of 'misses' which joined an already in-progress lookup instead of scheduling
+        // a new one
+        long long joinedLookups{0};
+
+        // Acquisitions which were satisfied from a cached 'not found' result (see
+        // 'setNegativeCacheTTL')
+        long long negativeHits{0};
+
+        // Number of invocations of the 'LookupFn' and the total time spent in them
+        long long lookups{0};
+        long long totalLookupMicros{0};
+    };
+
+    Stats getStats() const;
+
+    /**
+     * Appends the fields of 'getStats' to 'builder'.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 protected:
     ReadThroughCacheBase(Mutex& mutex, ServiceContext* service, ThreadPoolInterface& threadPool);
 
@@ -95,6 +130,16 @@ protected:
     // Used to protect calls to 'tryCancel' above. Has a lock level of 2, meaning what while held,
     // it is only allowed to take the Client lock.
     Mutex _cancelTokenMutex = MONGO_MAKE_LATCH("ReadThroughCacheBase::_cancelTokenMutex");
+
+    // Counters backing 'getStats'. They are only incremented and never reset.
+    struct AtomicStats {
+        AtomicWord<long long> hits;
+        AtomicWord<long long> misses;
+        AtomicWord<long long> joinedLookups;
+        AtomicWord<long long> negativeHits;
+        AtomicWord<long long> lookups;
+        AtomicWord<long long> totalLookupMicros;
+    } _stats;
 };
 
 template <typename Result, typename Key, typename Value, typename Time>
@@ -257,18 +302,36 @@ public:
         CacheCausalConsistency causalConsistency = CacheCausalConsistency::kLatestCached) {
 
         // Fast path
-        if (auto cachedValue = _cache.get(key, causalConsistency))
+        if (auto cachedValue = _cache.get(key, causalConsistency)) {
+            _stats.hits.fetchAndAddRelaxed(1);
             return {std::move(cachedValue)};
+        }
 
         stdx::unique_lock ul(_mutex);
 
         // Re-check the cache under a mutex, before kicking-off the asynchronous lookup
-        if (auto cachedValue = _cache.get(key, causalConsistency))
+        if (auto cachedValue = _cache.get(key, causalConsistency)) {
+            _stats.hits.fetchAndAddRelaxed(1);
             return {std::move(cachedValue)};
+        }
+
+        // The store recently reported that 'key' does not exist. Any call to 'advanceTimeInStore'
+        // or 'invalidate' for it removes the negative entry, so this cannot hide a newer version.
+        if (auto it = _negativeEntries.find(key); it != _negativeEntries.end()) {
+            if (it->second > _now()) {
+                _stats.negativeHits.fetchAndAddRelaxed(1);
+                return {ValueHandle()};
+            }
+            _negativeEntries.erase(it);
+        }
+
+        _stats.misses.fetchAndAddRelaxed(1);
 
         // Join an in-progress lookup if one has already been scheduled
-        if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
+        if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end()) {
+            _stats.joinedLookups.fetchAndAddRelaxed(1);
             return it->second->addWaiter(ul);
+        }
 
         // Schedule an asynchronous lookup for the key
         auto [cachedValue, timeInStore] = _cache.getCachedValueAndTimeInStore(key);
@@ -325,6 +388,7 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->invalidateAndCancelCurrentLookupRound(lg);
+        _negativeEntries.erase(key);
         _cache.insertOrAssign(key, {std::move(newValue), updateWallClockTime});
     }
 
@@ -335,6 +399,7 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->invalidateAndCancelCurrentLookupRound(lg);
+        _negativeEntries.erase(key);
         _cache.insertOrAssign(key, {std::move(newValue), updateWallClockTime}, time);
     }
 
@@ -349,6 +414,7 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->invalidateAndCancelCurrentLookupRound(lg);
+        _negativeEntries.erase(key);
         return _cache.insertOrAssignAndGet(key, {std::move(newValue), updateWallClockTime});
     }
 
@@ -359,6 +425,7 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->invalidateAndCancelCurrentLookupRound(lg);
+        _negativeEntries.erase(key);
         return _cache.insertOrAssignAndGet(key, {std::move(newValue), updateWallClockTime}, time);
     }
 
@@ -380,6 +447,8 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->advanceTimeInStore(lg, newTime);
+        if (auto it = _negativeEntries.find(key); it != _negativeEntries.end())
+            _negativeEntries.erase(it);
         return _cache.advanceTimeInStore(key, newTime);
     }
 
@@ -399,6 +468,8 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->invalidateAndCancelCurrentLookupRound(lg);
+        if (auto it = _negativeEntries.find(key); it != _negativeEntries.end())
+            _negativeEntries.erase(it);
         _cache.invalidate(key);
     }
 
@@ -412,6 +483,12 @@ public:
             if (predicate(entry.first))
                 entry.second->invalidateAndCancelCurrentLookupRound(lg);
         }
+        for (auto it = _negativeEntries.begin(); it != _negativeEntries.end();) {
+            if (predicate(it->first))
+                _negativeEntries.erase(it++);
+            else
+                ++it;
+        }
         _cache.invalidateIf([&](const Key& key, const StoredValue*) { return predicate(key); });
     }
 
@@ -436,6 +513,23 @@ public:
         return _cache.getCacheInfo();
     }
 
+    /**
+     * Enables caching of lookups which did not find the key in the store for 'ttl', so that
+     * repeated acquisitions of a missing key do not each go to the store. A 'ttl' of zero (the
+     * default) disables negative caching.
+     *
+     * Negative entries are dropped by 'invalidate', 'advanceTimeInStore' and 'insertOrAssign' for
+     * their key and their number is bounded by the size of the cache. Because of this, caches
+     * which are not told about new keys being added to the store may return 'not found' for up to
+     * 'ttl' after the key was created.
+     */
+    void setNegativeCacheTTL(Milliseconds ttl) {
+        stdx::lock_guard lg(_mutex);
+        _negativeCacheTTL = ttl;
+        if (_negativeCacheTTL <= Milliseconds(0))
+            _negativeEntries.clear();
+    }
+
     /**
      * ReadThroughCache constructor.
      *
@@ -461,6 +555,7 @@ public:
                      int cacheSize)
         : ReadThroughCacheBase(mutex, service, threadPool),
           _lookupFn(std::move(lookupFn)),
+          _cacheSize(cacheSize),
           _cache(cacheSize) {}
 
     ~ReadThroughCache() {
@@ -473,6 +568,33 @@ private:
                                                      LruKeyHasher<Key>,
                                                      LruKeyComparator<Key>>;
 
+    using NegativeEntriesMap =
+        stdx::unordered_map<Key, Date_t, LruKeyHasher<Key>, LruKeyComparator<Key>>;
+
+    /**
+     * Records that the store does not contain 'key' as of now, if negative caching is enabled.
+     * Expired entries are pruned once the map reaches the size of the cache and if that doesn't
+     * free up space, the result is not cached.
+     */
+    void _recordNegativeEntry(WithLock, const Key& key) {
+        if (_negativeCacheTTL <= Milliseconds(0))
+            return;
+
+        const auto now = _now();
+        if (_negativeEntries.size() >= size_t(_cacheSize)) {
+            for (auto it = _negativeEntries.begin(); it != _negativeEntries.end();) {
+                if (it->second <= now)
+                    _negativeEntries.erase(it++);
+                else
+                    ++it;
+            }
+            if (_negativeEntries.size() >= size_t(_cacheSize))
+                return;
+        }
+
+        _negativeEntries[key] = now + _negativeCacheTTL;
+    }
+
     /**
      * This method implements an asynchronous "while (!valid)" loop over 'key', which must be on the
      * in-progress map.
@@ -521,6 +643,7 @@ private:
                 }
 
                 _cache.invalidate(key);
+                _recordNegativeEntry(ul, key);
                 return ValueHandle();
             }();
 
@@ -557,6 +680,9 @@ private:
     // Blocking function which will be invoked to retrieve entries from the backing store
     const LookupFn _lookupFn;
 
+    // The maximum number of entries in '_cache', which is also used to bound '_negativeEntries'
+    const int _cacheSize;
+
     // Contains all the currently cached keys. This structure is self-synchronising and doesn't
     // require a mutex. However, on cache miss it is accessed under '_mutex', which is safe, because
     // _cache's mutex itself is at level 0.
@@ -572,6 +698,14 @@ private:
     //
     // This map is protected by '_mutex'.
     InProgressLookupsMap _inProgressLookups;
+
+    // How long a lookup which did not find its key in the store is remembered for. Protected by
+    // '_mutex'.
+    Milliseconds _negativeCacheTTL{0};
+
+    // Keys which were recently looked up and not found in the store, mapped to the time at which
+    // they expire. A key is never present both here and in '_cache'. Protected by '_mutex'.
+    NegativeEntriesMap _negativeEntries;
 };
 
 /**
@@ -616,6 +750,11 @@ public:
             OperationContext * opCtx, const Status& status) mutable noexcept {
             promise.setWith([&] {
                 uassertStatusOK(status);
+                Timer timer;
+                _cache._stats.lookups.fetchAndAddRelaxed(1);
+                ON_BLOCK_EXIT([&] {
+                    _cache._stats.totalLookupMicros.fetchAndAddRelaxed(timer.micros());
+                });
                 if constexpr (std::is_same_v<Time, CacheNotCausallyConsistent>) {
                     return _cache._lookupFn(opCtx, _key, _cachedValue);
                 } else {
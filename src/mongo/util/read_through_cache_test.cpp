@@ -35,6 +35,7 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/read_through_cache.h"
 #include "mongo/util/scopeguard.h"
@@ -338,6 +339,72 @@ TEST_F(ReadThroughCacheTest, KeyDoesNotExist) {
         }));
 }
 
+TEST_F(ReadThroughCacheTest, NegativeCaching) {
+    auto clockSource = std::make_unique<ClockSourceMock>();
+    auto mockClock = clockSource.get();
+    getServiceContext()->setFastClockSource(std::move(clockSource));
+
+    CacheWithThreadPool<Cache> cache(
+        getServiceContext(),
+        1,
+        [&](OperationContext*, const std::string& key, const Cache::ValueHandle&) {
+            return Cache::LookupResult(boost::none);
+        });
+    cache.setNegativeCacheTTL(Seconds(10));
+
+    ASSERT(!cache.acquire(_opCtx, "TestKey"));
+    ASSERT(!cache.acquire(_opCtx, "TestKey"));
+    ASSERT_EQ(1, cache.countLookups);
+
+    // Invalidation drops the negative entry
+    cache.invalidate("TestKey");
+    ASSERT(!cache.acquire(_opCtx, "TestKey"));
+    ASSERT_EQ(2, cache.countLookups);
+
+    // So does the passage of time
+    mockClock->advance(Seconds(11));
+    ASSERT(!cache.acquire(_opCtx, "TestKey"));
+    ASSERT_EQ(3, cache.countLookups);
+
+    // Inserting a value replaces the negative entry
+    cache.insertOrAssign("TestKey", CachedValue(5), mockClock->now());
+    auto value = cache.acquire(_opCtx, "TestKey");
+    ASSERT(value);
+    ASSERT_EQ(5, value->counter);
+    ASSERT_EQ(3, cache.countLookups);
+
+    const auto stats = cache.getStats();
+    ASSERT_EQ(1, stats.hits);
+    ASSERT_EQ(3, stats.misses);
+    ASSERT_EQ(1, stats.negativeHits);
+    ASSERT_EQ(3, stats.lookups);
+}
+
+TEST_F(ReadThroughCacheTest, NegativeCachingDroppedByAdvanceTimeInStore) {
+    boost::optional<CausallyConsistentCache::LookupResult> nextToReturn;
+    CacheWithThreadPool<CausallyConsistentCache> cache(
+        getServiceContext(),
+        1,
+        [&](OperationContext*,
+            const std::string& key,
+            const CausallyConsistentCache::ValueHandle&,
+            const Timestamp& timeInStore) { return std::move(*nextToReturn); });
+    cache.setNegativeCacheTTL(Hours(1));
+
+    nextToReturn.emplace(boost::none, Timestamp(10));
+    ASSERT(!cache.acquire(_opCtx, "TestKey", CacheCausalConsistency::kLatestKnown));
+    ASSERT(!cache.acquire(_opCtx, "TestKey", CacheCausalConsistency::kLatestKnown));
+    ASSERT_EQ(1, cache.countLookups);
+
+    // The key was created in the store, so a negative result must not be returned anymore
+    ASSERT(cache.advanceTimeInStore("TestKey", Timestamp(20)));
+    nextToReturn.emplace(CachedValue(20), Timestamp(20));
+    auto value = cache.acquire(_opCtx, "TestKey", CacheCausalConsistency::kLatestKnown);
+    ASSERT(value);
+    ASSERT_EQ(20, value->counter);
+    ASSERT_EQ(2, cache.countLookups);
+}
+
 TEST_F(ReadThroughCacheTest, CausalConsistency) {
     boost::optional<CausallyConsistentCache::LookupResult> nextToReturn;
     CacheWithThreadPool<CausallyConsistentCache> cache(
@@ -30,6 +30,8 @@
 
 #include "mongo/util/regex_util.h"
 
+#include <cctype>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/util/str.h"
 
@@ -64,5 +66,124 @@ pcrecpp::RE_Options flagsToPcreOptions(StringData optionFlags, StringData opName
     }
     return opt;
 }
+
+std::string requiredLiteral(StringData pattern, StringData optionFlags) {
+    // Case-insensitive and extended (whitespace-ignoring) patterns do not match their literal
+    // characters byte for byte.
+    if (optionFlags.find('i') != std::string::npos || optionFlags.find('x') != std::string::npos) {
+        return "";
+    }
+
+    std::string best;
+    std::string run;
+    const auto endRun = [&] {
+        if (run.size() > best.size()) {
+            best = run;
+        }
+        run.clear();
+    };
+
+    // Skips the character class starting at 'pattern[i]', returning the index of its closing ']'.
+    // A ']' right after the opening '[' or '[^' is part of the class.
+    const auto skipClass = [&](size_t i) {
+        ++i;
+        if (i < pattern.size() && pattern[i] == '^') {
+            ++i;
+        }
+        if (i < pattern.size() && pattern[i] == ']') {
+            ++i;
+        }
+        for (; i < pattern.size() && pattern[i] != ']'; ++i) {
+            if (pattern[i] == '\\') {
+                ++i;
+            }
+        }
+        return i;
+    };
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        switch (c) {
+            case '|':
+                // Any alternative may match, none of them is required.
+                return "";
+            case '\\': {
+                if (i + 1 == pattern.size()) {
+                    return "";
+                }
+                const char escaped = pattern[++i];
+                if (escaped == 'Q' || escaped == 'E') {
+                    // Quoted sequences are rare enough not to be worth interpreting.
+                    return "";
+                }
+                if (std::isalnum(static_cast<unsigned char>(escaped)) ||
+                    static_cast<unsigned char>(escaped) >= 0x80) {
+                    // A character type, assertion, back reference or coded character.
+                    endRun();
+                } else {
+                    run.push_back(escaped);
+                }
+                break;
+            }
+            case '(': {
+                if (i + 1 < pattern.size() && (pattern[i + 1] == '?' || pattern[i + 1] == '*')) {
+                    // Inline options and verbs may change how the rest of the pattern matches.
+                    return "";
+                }
+                // The group may be optional or repeated, so skip over it as a whole.
+                endRun();
+                int depth = 1;
+                while (depth > 0 && ++i < pattern.size()) {
+                    if (pattern[i] == '\\') {
+                        ++i;
+                    } else if (pattern[i] == '[') {
+                        i = skipClass(i);
+                    } else if (pattern[i] == '(') {
+                        ++depth;
+                    } else if (pattern[i] == ')') {
+                        --depth;
+                    }
+                }
+                break;
+            }
+            case '[':
+                endRun();
+                i = skipClass(i);
+                break;
+            case '+':
+                // The previous character is required once, but what follows it is not adjacent.
+                endRun();
+                break;
+            case '*':
+            case '?':
+            case '{':
+                // The previous character need not appear. A multi-byte character is dropped from
+                // the run altogether.
+                if (!run.empty() && static_cast<unsigned char>(run.back()) >= 0x80) {
+                    run.clear();
+                } else if (!run.empty()) {
+                    run.pop_back();
+                }
+                endRun();
+                if (c == '{') {
+                    // Skip the repetition counts.
+                    while (i < pattern.size() && pattern[i] != '}') {
+                        ++i;
+                    }
+                }
+                break;
+            case '.':
+            case '^':
+            case '$':
+            case ')':
+                endRun();
+                break;
+            default:
+                run.push_back(c);
+        }
+    }
+    endRun();
+    return best;
+}
 }  // namespace regex_util
 }  // namespace mongo
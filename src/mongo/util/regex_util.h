@@ -40,5 +40,14 @@ namespace regex_util {
  * throws uassert on invalid flags.
  */
 pcrecpp::RE_Options flagsToPcreOptions(StringData optionFlags, StringData opName = "");
+
+/**
+ * Returns a string which every string matched by the regex 'pattern' with options 'optionFlags'
+ * must contain, or an empty string if no such literal could be determined. Checking for it is far
+ * cheaper than running the regex, so strings without it can be rejected up front. Only the
+ * longest run of literal characters outside of any group or character class is considered, and
+ * none for patterns with alternations, inline options or case insensitivity.
+ */
+std::string requiredLiteral(StringData pattern, StringData optionFlags);
 }  // namespace regex_util
 }  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#ifdef _WIN32
+#define NVALGRIND
+#endif
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/tcmalloc_background_release.h"
+
+#include <gperftools/malloc_extension.h>
+#include <valgrind/valgrind.h>
+
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/background.h"
+#include "mongo/util/tcmalloc_parameters_gen.h"
+
+namespace mongo {
+namespace {
+
+AtomicWord<long long> numBackgroundReleases;
+AtomicWord<long long> totalBackgroundReleasedBytes;
+
+/**
+ * Returns free page heap memory above the configured threshold to the operating system. tcmalloc
+ * only releases memory on its own as spans are freed, at a pace set by tcmallocReleaseRate, so a
+ * burst of allocations followed by an idle period can leave the heap at its peak for a long time.
+ */
+class TCMallocBackgroundReleaseTask : public PeriodicTask {
+public:
+    std::string taskName() const override {
+        return "TCMallocBackgroundRelease";
+    }
+
+    void taskDoWork() override {
+        const long long threshold = gTCMallocBackgroundReleaseThresholdBytes.load();
+        if (threshold <= 0 || RUNNING_ON_VALGRIND) {
+            return;
+        }
+
+        size_t freeBytes;
+        if (!MallocExtension::instance()->GetNumericProperty("tcmalloc.pageheap_free_bytes",
+                                                             &freeBytes) ||
+            freeBytes <= static_cast<size_t>(threshold)) {
+            return;
+        }
+
+        const size_t toRelease = freeBytes - threshold;
+        MallocExtension::instance()->ReleaseToSystem(toRelease);
+
+        numBackgroundReleases.fetchAndAdd(1);
+        totalBackgroundReleasedBytes.fetchAndAdd(toRelease);
+        LOGV2_DEBUG(6106700,
+                    1,
+                    "Released free tcmalloc page heap memory to the operating system",
+                    "freeBytes"_attr = freeBytes,
+                    "releasedBytes"_attr = toRelease);
+    }
+} tcmallocBackgroundReleaseTask;
+
+}  // namespace
+
+void appendTCMallocBackgroundReleaseStats(BSONObjBuilder* builder) {
+    BSONObjBuilder sub(builder->subobjStart("background_release"));
+    sub.appendNumber("threshold_bytes", gTCMallocBackgroundReleaseThresholdBytes.load());
+    sub.appendNumber("num_releases", numBackgroundReleases.load());
+    sub.appendNumber("total_released_bytes", totalBackgroundReleasedBytes.load());
+}
+
+}  // namespace mongo
@@ -42,6 +42,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/service_context.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/util/tcmalloc_background_release.h"
 #include "mongo/util/tcmalloc_parameters_gen.h"
 
 namespace mongo {
@@ -147,6 +148,9 @@ public:
 
             auto tcmallocReleaseRate = MallocExtension::instance()->GetMemoryReleaseRate();
             sub.appendNumber("release_rate", tcmallocReleaseRate);
+            if (gTCMallocBackgroundReleaseThresholdBytes.load() > 0) {
+                appendTCMallocBackgroundReleaseStats(&sub);
+            }
 
 #if MONGO_HAVE_GPERFTOOLS_SIZE_CLASS_STATS
             if (verbosity >= 2) {